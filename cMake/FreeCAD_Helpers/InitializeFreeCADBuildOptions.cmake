@@ -141,6 +141,7 @@ macro(InitializeFreeCADBuildOptions)
     option(BUILD_VR "Build the FreeCAD Oculus Rift support (need Oculus SDK 4.x or higher)" OFF)
     option(BUILD_CLOUD "Build the FreeCAD cloud module" OFF)
     option(ENABLE_DEVELOPER_TESTS "Build the FreeCAD unit tests suit" ON)
+    option(ENABLE_DEVELOPER_BENCHMARKS "Build the FreeCAD microbenchmarks (requires Google Benchmark)" OFF)
 
     if(MSVC OR APPLE)
         set(FREECAD_3DCONNEXION_SUPPORT "NavLib" CACHE STRING "Select version of the 3Dconnexion device integration")
@@ -64,6 +64,12 @@ void ZipOutputStream::putNextEntry(const std::string& entryName) {
 }
 
 
+void ZipOutputStream::putRawEntry( const ZipCDirEntry &entry, const char *data,
+                                   uint32 compressed_size ) {
+  ozf->putRawEntry( entry, data, compressed_size ) ;
+}
+
+
 void ZipOutputStream::setComment( const std::string &comment ) {
   ozf->setComment( comment ) ;
 }
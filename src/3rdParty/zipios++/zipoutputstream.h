@@ -10,6 +10,10 @@
 #include "ziphead.h"
 #include "zipoutputstreambuf.h"
 
+// Lets users detect ZipOutputStream::putRawEntry(), which is not available
+// with an external zipios++
+#define ZIPIOS_HAVE_RAW_ENTRY
+
 namespace zipios {
 
 /** \anchor ZipOutputStream_anchor
@@ -54,6 +58,12 @@ public:
   */
   void putNextEntry(const std::string& entryName);
 
+  /** Closes the current entry (if one is open) and appends an entry
+      whose data was already compressed by the caller.
+      \see ZipOutputStreambuf::putRawEntry
+  */
+  void putRawEntry( const ZipCDirEntry &entry, const char *data, uint32 compressed_size ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const std::string& comment ) ;
 
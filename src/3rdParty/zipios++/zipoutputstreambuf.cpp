@@ -81,6 +81,25 @@ void ZipOutputStreambuf::putNextEntry( const ZipCDirEntry &entry ) {
 }
 
 
+void ZipOutputStreambuf::putRawEntry( const ZipCDirEntry &entry, const char *data,
+                                      uint32 compressed_size ) {
+  if ( _open_entry )
+    closeEntry() ;
+
+  _entries.push_back( entry ) ;
+  ZipCDirEntry &ent = _entries.back() ;
+
+  ostream os( _outbuf ) ;
+
+  ent.setLocalHeaderOffset( os.tellp() ) ;
+  ent.setCompressedSize( compressed_size ) ;
+  ent.setTime( currentDosTime() ) ;
+
+  os << static_cast< ZipLocalEntry >( ent ) ;
+  os.write( data, compressed_size ) ;
+}
+
+
 void ZipOutputStreambuf::setComment( const string &comment ) {
   _zip_comment = comment ;
 }
@@ -146,14 +165,7 @@ void ZipOutputStreambuf::updateEntryHeaderInfo() {
   entry.setCompressedSize( curr_pos - entry.getLocalHeaderOffset() 
 			   - entry.getLocalHeaderSize() ) ;
 
-  // Mark Donszelmann: added current date and time
-  time_t ltime;
-  time( &ltime );
-  struct tm *now;
-  now = localtime( &ltime );
-  int dosTime = (now->tm_year - 80) << 25 | (now->tm_mon + 1) << 21 | now->tm_mday << 16 |
-              now->tm_hour << 11 | now->tm_min << 5 | now->tm_sec >> 1;
-  entry.setTime(dosTime);
+  entry.setTime( currentDosTime() );
 
   // write ZipLocalEntry header to header position
   os.seekp( entry.getLocalHeaderOffset() ) ;
@@ -162,6 +174,17 @@ void ZipOutputStreambuf::updateEntryHeaderInfo() {
 }
 
 
+int ZipOutputStreambuf::currentDosTime() {
+  // Mark Donszelmann: added current date and time
+  time_t ltime;
+  time( &ltime );
+  struct tm *now;
+  now = localtime( &ltime );
+  return (now->tm_year - 80) << 25 | (now->tm_mon + 1) << 21 | now->tm_mday << 16 |
+         now->tm_hour << 11 | now->tm_min << 5 | now->tm_sec >> 1;
+}
+
+
 void ZipOutputStreambuf::writeCentralDirectory( const vector< ZipCDirEntry > &entries, 
 						EndOfCentralDirectory eocd, 
 						ostream &os ) {
@@ -49,6 +49,14 @@ public:
       entry. */
   void putNextEntry( const ZipCDirEntry &entry ) ;
 
+  /** Closes the current entry (if one is open) and appends an entry whose
+      data has already been compressed by the caller. The size, crc32 and
+      method of entry must describe data, which is written as is.
+      @param entry the header information of the entry.
+      @param data the (possibly compressed) entry data.
+      @param compressed_size the number of bytes in data. */
+  void putRawEntry( const ZipCDirEntry &entry, const char *data, uint32 compressed_size ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const string &comment ) ;
 
@@ -68,6 +76,7 @@ protected:
 
   void setEntryClosedState() ;
   void updateEntryHeaderInfo() ;
+  static int currentDosTime() ;
 
   // Should/could be moved to zipheadio.h ?!
   static void writeCentralDirectory( const vector< ZipCDirEntry > &entries, 
@@ -256,6 +256,11 @@ init_image_module()
 }
 // clang-format on
 
+bool ApplicationProgressIndicator::userBreak()
+{
+    return Document::isAnyRecomputeCanceled();
+}
+
 Application::Application(std::map<std::string,std::string> &mConfig)
   : _mConfig(mConfig)
 {
@@ -485,6 +490,7 @@ Document* Application::newDocument(const char * proposedName, const char * propo
     doc->signalDeletedObject.connect(std::bind(&Application::slotDeletedObject, this, sp::_1));
     doc->signalBeforeChangeObject.connect(std::bind(&Application::slotBeforeChangeObject, this, sp::_1, sp::_2));
     doc->signalChangedObject.connect(std::bind(&Application::slotChangedObject, this, sp::_1, sp::_2));
+    doc->signalBatchChangedObject.connect(std::bind(&Application::slotBatchChangedObject, this, sp::_1, sp::_2));
     doc->signalRelabelObject.connect(std::bind(&Application::slotRelabelObject, this, sp::_1));
     doc->signalActivatedObject.connect(std::bind(&Application::slotActivatedObject, this, sp::_1));
     doc->signalUndo.connect(std::bind(&Application::slotUndoDocument, this, sp::_1));
@@ -1590,6 +1596,11 @@ void Application::slotChangedObject(const DocumentObject& obj, const Property& p
     this->signalChangedObject(obj, prop);
 }
 
+void Application::slotBatchChangedObject(const DocumentObject& obj, const std::vector<const Property*>& props)
+{
+    this->signalBatchChangedObject(obj, props);
+}
+
 void Application::slotRelabelObject(const DocumentObject& obj)
 {
     this->signalRelabelObject(obj);
@@ -2238,6 +2249,7 @@ void parseProgramOptions(int ac, char ** av, const std::string& exe, boost::prog
     ("disable-addon", boost::program_options::value< std::vector<std::string> >()->composing(),"Disable a given addon.")
     ("single-instance", "Allow to run a single instance of the application")
     ("safe-mode", "Force enable safe mode")
+    ("startup-report", "Print the time spent in the phases of the GUI startup")
     ("pass", boost::program_options::value< std::vector<std::string> >()->multitoken(), "Ignores the following arguments and pass them through to be used by a script")
     ;
 
@@ -2573,6 +2585,10 @@ void Application::initConfig(int argc, char ** argv)
         mConfig["SafeMode"] = "1";
     }
 
+    if (vm.contains("startup-report")) {
+        mConfig["StartupReport"] = "1";
+    }
+
     // extract home paths
     _appDirs = std::make_unique<ApplicationDirectories>(mConfig);
 
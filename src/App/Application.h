@@ -81,6 +81,13 @@ struct DocumentInitFlags {
     bool temporary {false};
 };
 
+/// The progress indicator of the application, it breaks the operations of a cancelled recompute
+class AppExport ApplicationProgressIndicator: public Base::ProgressIndicator
+{
+public:
+    bool userBreak() override;
+};
+
 /** The Application
  *  The root of the whole application
  *  @see App::Document
@@ -282,6 +289,8 @@ public:
     boost::signals2::signal<void (const App::DocumentObject&, const App::Property&)> signalBeforeChangeObject;
     /// signal on changed Object
     boost::signals2::signal<void (const App::DocumentObject&, const App::Property&)> signalChangedObject;
+    /// signal once per changed Object at the end of a ChangeSignalBatch
+    boost::signals2::signal<void (const App::DocumentObject&, const std::vector<const App::Property*>&)> signalBatchChangedObject;
     /// signal on relabeled Object
     boost::signals2::signal<void (const App::DocumentObject&)> signalRelabelObject;
     /// signal on activated Object
@@ -501,6 +510,7 @@ protected:
     void slotDeletedObject(const App::DocumentObject& obj);
     void slotBeforeChangeObject(const App::DocumentObject& obj, const App::Property& prop);
     void slotChangedObject(const App::DocumentObject& obj, const App::Property& prop);
+    void slotBatchChangedObject(const App::DocumentObject& obj, const std::vector<const App::Property*>& props);
     void slotRelabelObject(const App::DocumentObject& obj);
     void slotActivatedObject(const App::DocumentObject& obj);
     void slotUndoDocument(const App::Document& doc);
@@ -674,7 +684,7 @@ private:
     int _activeTransactionGuard{0};
     bool _activeTransactionTmpName{false};
 
-    Base::ProgressIndicator _progressIndicator;
+    ApplicationProgressIndicator _progressIndicator;
 
     static Base::ConsoleObserverStd  *_pConsoleObserverStd;
     static Base::ConsoleObserverFile *_pConsoleObserverFile;
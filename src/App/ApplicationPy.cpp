@@ -197,7 +197,10 @@ PyMethodDef Application::Methods[] = {
      (PyCFunction)Application::sAddDocObserver,
      METH_VARARGS,
      "addDocumentObserver() -> None\n\n"
-     "Add an observer to get notified about changes on documents."},
+     "Add an observer to get notified about changes on documents.\n"
+     "The events of objects can be restricted with the attributes ObservedTypes and\n"
+     "ObservedProperties of the observer, lists of type and property names. The method\n"
+     "slotChangedObjects(changes) gets the changes made during a recompute at its end."},
     {"removeDocumentObserver",
      (PyCFunction)Application::sRemoveDocObserver,
      METH_VARARGS,
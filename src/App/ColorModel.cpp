@@ -20,6 +20,7 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
 #include <cstdlib>
 
 #include <Base/Exception.h>
@@ -272,6 +273,76 @@ void ColorGradient::rebuild()
             break;
         }
     }
+
+    rebuildPackedColors();
+}
+
+void ColorGradient::rebuildPackedColors()
+{
+    constexpr const std::size_t tableSize = 4096;
+    bool split = (profile.tStyle == ColorBarStyle::ZERO_BASED) && (profile.fMin < 0.0F)
+        && (profile.fMax > 0.0F);
+    std::array<const ColorField*, 2> fields {&colorField1, split ? &colorField2 : &colorField1};
+
+    packedColors.resize(split ? 2 * tableSize : tableSize);
+    for (std::size_t i = 0; i < fields.size(); i++) {
+        float fMin = fields[i]->getMinValue();
+        float fMax = fields[i]->getMaxValue();
+        float step = (fMax - fMin) / float(tableSize);
+        std::size_t offset = split ? i * tableSize : 0;
+        for (std::size_t j = 0; j < tableSize; j++) {
+            float value = fMin + (float(j) + 0.5F) * step;
+            packedColors[offset + j] = fields[i]->getColor(value).getPackedValue();
+        }
+
+        // Index := Constant + Ascent * Value
+        packedAscent[i] = float(tableSize) / (fMax - fMin);
+        packedConstant[i] = float(offset) - packedAscent[i] * fMin;
+        packedFirst[i] = float(offset);
+        packedLast[i] = float(offset + tableSize - 1);
+    }
+}
+
+void ColorGradient::getPackedColors(const float* values, std::size_t count, uint32_t* colors) const
+{
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    constexpr const std::size_t blockSize = 256;
+    constexpr const uint32_t alphaMask = 0xff;
+    const uint32_t gray = Base::Color(0.5F, 0.5F, 0.5F).getPackedValue();
+    const uint32_t alpha = Base::Color(0.0F, 0.0F, 0.0F, 0.2F).getPackedValue() & alphaMask;
+    const bool grayed = isOutsideGrayed();
+    const bool invisible = isOutsideInvisible();
+    const float fMin = profile.fMin;
+    const float fMax = profile.fMax;
+
+    std::array<uint32_t, blockSize> index {};
+    for (std::size_t start = 0; start < count; start += blockSize) {
+        const std::size_t num = std::min(blockSize, count - start);
+        const float* block = values + start;
+        uint32_t* out = colors + start;
+
+        // the table positions, a NaN goes to the first color of its field
+        for (std::size_t i = 0; i < num; i++) {
+            const float value = block[i];
+            const bool below = value < 0.0F;
+            const float ascent = below ? packedAscent[0] : packedAscent[1];
+            const float constant = below ? packedConstant[0] : packedConstant[1];
+            const float first = below ? packedFirst[0] : packedFirst[1];
+            const float last = below ? packedLast[0] : packedLast[1];
+            const float pos = std::min(last, std::max(first, constant + ascent * value));
+            index[i] = static_cast<uint32_t>(pos);
+        }
+
+        for (std::size_t i = 0; i < num; i++) {
+            const float value = block[i];
+            const bool outside = (value < fMin) || (value > fMax);
+            uint32_t color = packedColors[index[i]];
+            color = (grayed && outside) ? gray : color;
+            color = (invisible && outside) ? ((color & ~alphaMask) | alpha) : color;
+            out[i] = color;
+        }
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
 }
 
 std::size_t ColorGradient::getMinColors() const
@@ -28,6 +28,7 @@
 #include <Base/Bitmask.h>
 
 #include <algorithm>
+#include <array>
 #include <deque>
 #include <string>
 #include <vector>
@@ -485,9 +486,16 @@ public:
 
     inline Base::Color getColor(float fVal) const;
     inline std::size_t getColorIndex(float fVal) const;
+    /**
+     * Converts the \a count values into colors packed as 0xRRGGBBAA, like \ref getColor does.
+     * The colors are taken from a table, so the values are mapped without branches in loops
+     * that the compiler can vectorize.
+     */
+    void getPackedColors(const float* values, std::size_t count, uint32_t* colors) const;
 
 private:
     inline Base::Color _getColor(float fVal) const;
+    void rebuildPackedColors();
 
 protected:
     void createStandardPacks();
@@ -497,6 +505,13 @@ protected:
     ColorField colorField1, colorField2;
     ColorModelPack currentModelPack;
     std::vector<ColorModelPack> modelPacks;
+    // the colors of both color fields in equal steps, the ones of the second field follow
+    // the ones of the first field which is used for the values below zero
+    std::vector<uint32_t> packedColors;
+    std::array<float, 2> packedAscent {};
+    std::array<float, 2> packedConstant {};
+    std::array<float, 2> packedFirst {};
+    std::array<float, 2> packedLast {};
 
     void rebuild();
     void setColorModel();
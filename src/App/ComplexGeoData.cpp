@@ -305,6 +305,7 @@ ComplexGeoData::getElementMappedNames(const IndexedName& element, bool needUnmap
 
 ElementMapPtr ComplexGeoData::resetElementMap(ElementMapPtr elementMap)
 {
+    _sharedElementMapChildren.clear();
     _elementMap.swap(elementMap);
     // We expect that if the ComplexGeoData ( TopoShape ) has a hasher, then its elementMap will
     // have the same one.  Make sure that happens.
@@ -333,6 +334,7 @@ ElementMapPtr ComplexGeoData::elementMap(bool flush) const
 
 ElementMapPtr ComplexGeoData::ensureElementMap(bool flush)
 {
+    unshareElementMap();
     if (!_elementMap) {
         resetElementMap(std::make_shared<Data::ElementMap>());
     }
@@ -681,12 +683,31 @@ void ComplexGeoData::setMappedChildElements(
 {
     // DO NOT reset element map if there is one. Because we allow mixing child
     // mapping and normal mapping
+    unshareElementMap();
     if (!_elementMap) {
         resetElementMap(std::make_shared<Data::ElementMap>());
     }
     _elementMap->addChildElements(Tag, children);
 }
 
+void ComplexGeoData::shareMappedChildElements(
+    ElementMapPtr elementMap,
+    std::vector<Data::ElementMap::MappedChildElements> children)
+{
+    resetElementMap(std::move(elementMap));
+    _sharedElementMapChildren = std::move(children);
+}
+
+void ComplexGeoData::unshareElementMap()
+{
+    if (_sharedElementMapChildren.empty()) {
+        return;
+    }
+    auto children = std::move(_sharedElementMapChildren);
+    resetElementMap(std::make_shared<Data::ElementMap>());
+    _elementMap->addChildElements(Tag, children);
+}
+
 std::vector<Data::ElementMap::MappedChildElements> ComplexGeoData::getMappedChildElements() const
 {
     if (!_elementMap) {
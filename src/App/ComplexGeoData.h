@@ -276,6 +276,7 @@ public:
                               const ElementIDRefs* sid = nullptr,
                               bool overwrite = false)
     {
+        unshareElementMap();
         return _elementMap->setElementName(element, name, masterTag, sid, overwrite);
     }
 
@@ -323,6 +324,20 @@ public:
     };
 
     void setMappedChildElements(const std::vector<Data::ElementMap::MappedChildElements>& children);
+
+    /** Borrow an element map instead of copying it through child elements
+     *
+     * @param elementMap: the element map to share
+     * @param children: child elements that would map every element of this
+     * geometry to the same name in \c elementMap, i.e. without tag or postfix.
+     *
+     * The map is shared until the first modification through ensureElementMap(),
+     * setElementName() or setMappedChildElements(), which expands \c children
+     * into a private map just like setMappedChildElements() would have done.
+     */
+    void shareMappedChildElements(ElementMapPtr elementMap,
+                                  std::vector<Data::ElementMap::MappedChildElements> children);
+
     std::vector<Data::ElementMap::MappedChildElements> getMappedChildElements() const;
 
     char elementType(const Data::MappedName&) const;
@@ -508,7 +523,11 @@ protected:
     ElementMapPtr ensureElementMap(bool flush = true);
 
 private:
+    /// Replace a map borrowed through shareMappedChildElements() with a private copy
+    void unshareElementMap();
+
     ElementMapPtr _elementMap;
+    std::vector<Data::ElementMap::MappedChildElements> _sharedElementMapChildren;
 
 protected:
     mutable std::string _persistenceName;
@@ -32,7 +32,9 @@
 #include <vector>
 #include <list>
 #include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <thread>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/bimap.hpp>
@@ -76,6 +78,8 @@
 #include "StringHasher.h"
 #include "Transactions.h"
 
+#include <json.hpp>
+
 #ifdef _MSC_VER
 #include <zipios++/zipios-config.h>
 #endif
@@ -185,6 +189,7 @@ bool Document::undo(const int id)
             mUndoTransactions.back()->apply(*this, false);
 
             // save the redo
+            d->activeUndoTransaction->compactPropertyChanges();
             mRedoMap[d->activeUndoTransaction->getID()] = d->activeUndoTransaction;
             mRedoTransactions.push_back(d->activeUndoTransaction);
             d->activeUndoTransaction = nullptr;
@@ -237,6 +242,7 @@ bool Document::redo(const int id)
             Base::FlagToggler<bool> flag(d->undoing);
             mRedoTransactions.back()->apply(*this, true);
 
+            d->activeUndoTransaction->compactPropertyChanges();
             mUndoMap[d->activeUndoTransaction->getID()] = d->activeUndoTransaction;
             mUndoTransactions.push_back(d->activeUndoTransaction);
             d->activeUndoTransaction = nullptr;
@@ -492,6 +498,7 @@ void Document::_commitTransaction(const bool notify)
         Base::FlagToggler<> flag(d->committing);
         Application::TransactionSignaller signaller(false, true);
         const int id = d->activeUndoTransaction->getID();
+        d->activeUndoTransaction->compactPropertyChanges();
         mUndoTransactions.push_back(d->activeUndoTransaction);
         d->activeUndoTransaction = nullptr;
         // check the stack for the limits
@@ -500,6 +507,16 @@ void Document::_commitTransaction(const bool notify)
             delete mUndoTransactions.front();
             mUndoTransactions.pop_front();
         }
+        // and for the memory limit, always keeping the latest transaction
+        if (d->UndoMemSize != 0) {
+            unsigned int size = getUndoMemSize();
+            while (mUndoTransactions.size() > 1 && size > d->UndoMemSize) {
+                size -= std::min(size, mUndoTransactions.front()->getMemSize());
+                mUndoMap.erase(mUndoTransactions.front()->getID());
+                delete mUndoTransactions.front();
+                mUndoTransactions.pop_front();
+            }
+        }
         signalCommitTransaction(*this);
 
         // closeActiveTransaction() may call again _commitTransaction()
@@ -606,6 +623,8 @@ void Document::clearDocument() // NOLINT
     d->objectMap.clear();
     d->objectNameManager.clear();
     d->objectIdMap.clear();
+    d->objectLabelMap.clear();
+    d->objectTypeMap.clear();
     d->lastObjectId = 0;
 }
 
@@ -700,6 +719,18 @@ int Document::getUndoMode() const
 }
 
 unsigned int Document::getUndoMemSize() const
+{
+    unsigned int size = 0;
+    for (const auto* transaction : mUndoTransactions) {
+        size += transaction->getMemSize();
+    }
+    for (const auto* transaction : mRedoTransactions) {
+        size += transaction->getMemSize();
+    }
+    return size;
+}
+
+unsigned int Document::getUndoLimit() const
 {
     return d->UndoMemSize;
 }
@@ -729,7 +760,13 @@ void Document::onBeforeChange(const Property* prop)
 
 void Document::onChanged(const Property* prop)
 {
-    signalChanged(*this, *prop);
+    if (!ChangeSignalBatch::isActive()) {
+        signalChanged(*this, *prop);
+    }
+    else if (std::find(d->pendingDocChanges.begin(), d->pendingDocChanges.end(), prop)
+             == d->pendingDocChanges.end()) {
+        d->pendingDocChanges.push_back(prop);
+    }
 
     // the Name property is a label for display purposes
     if (prop == &Label) {
@@ -792,9 +829,20 @@ void Document::onChanged(const Property* prop)
 void Document::onBeforeChangeProperty(const TransactionalObject* Who, const Property* What)
 {
     if (Who->isDerivedFrom<DocumentObject>()) {
-        signalBeforeChangeObject(*static_cast<const DocumentObject*>(Who), *What);
+        auto obj = static_cast<const DocumentObject*>(Who);
+        if (!deferSignal(obj, [this, obj, What]() {
+                signalBeforeChangeObject(*obj, *What);
+            })) {
+            signalBeforeChangeObject(*obj, *What);
+        }
     }
     if (!d->rollback && !globalIsRelabeling) {
+        // The undo record must be taken before the change, so it cannot be
+        // deferred. Serialize the access if called from a recompute worker.
+        std::unique_lock<std::mutex> lock(d->recomputeMutex, std::defer_lock);
+        if (d->concurrentRecompute) {
+            lock.lock();
+        }
         _checkTransaction(nullptr, What, __LINE__);
         if (d->activeUndoTransaction) {
             d->activeUndoTransaction->addObjectChange(Who, What);
@@ -804,7 +852,116 @@ void Document::onBeforeChangeProperty(const TransactionalObject* Who, const Prop
 
 void Document::onChangedProperty(const DocumentObject* Who, const Property* What)
 {
-    signalChangedObject(*Who, *What);
+    if (!ChangeSignalBatch::isActive()) {
+        signalChangedObject(*Who, *What);
+        return;
+    }
+    auto res = d->pendingChangeIndex.emplace(Who->getID(), d->pendingChanges.size());
+    if (res.second) {
+        d->pendingChanges.push_back({Who->getID(), {}, {}});
+    }
+    auto& change = d->pendingChanges[res.first->second];
+    if (change.seen.insert(What).second) {
+        change.props.push_back(What);
+    }
+}
+
+void Document::flushChangeSignals()
+{
+    auto docChanges = std::move(d->pendingDocChanges);
+    auto changes = std::move(d->pendingChanges);
+    d->pendingDocChanges.clear();
+    d->pendingChanges.clear();
+    d->pendingChangeIndex.clear();
+
+    for (auto prop : docChanges) {
+        if (getPropertyName(prop)) {
+            signalChanged(*this, *prop);
+        }
+    }
+    for (auto& change : changes) {
+        // the object may have been deleted by a slot or during the batch
+        auto obj = getObjectByID(change.id);
+        if (!obj) {
+            continue;
+        }
+        std::vector<const Property*> props;
+        props.reserve(change.props.size());
+        for (auto prop : change.props) {
+            // dynamic properties may have been removed in the meantime
+            if (getObjectByID(change.id) != obj || !obj->getPropertyName(prop)) {
+                continue;
+            }
+            props.push_back(prop);
+            signalChangedObject(*obj, *prop);
+        }
+        if (!props.empty() && getObjectByID(change.id) == obj) {
+            signalBatchChangedObject(*obj, props);
+        }
+    }
+}
+
+namespace
+{
+thread_local int changeSignalBatchDepth = 0;
+}
+
+ChangeSignalBatch::ChangeSignalBatch()
+{
+    ++changeSignalBatchDepth;
+}
+
+ChangeSignalBatch::~ChangeSignalBatch()
+{
+    if (--changeSignalBatchDepth != 0) {
+        return;
+    }
+    for (auto doc : GetApplication().getDocuments()) {
+        try {
+            doc->flushChangeSignals();
+        }
+        catch (Base::Exception& e) {
+            e.reportException();
+        }
+        catch (std::exception& e) {
+            FC_ERR("Exception on flushing change signals: " << e.what());
+        }
+        catch (...) {
+            FC_ERR("Unknown exception on flushing change signals");
+        }
+    }
+}
+
+bool ChangeSignalBatch::isActive()
+{
+    return changeSignalBatchDepth > 0;
+}
+
+void Document::trackChangedProperty(const DocumentObject* Who, const Property* What)
+{
+    if (!testStatus(Document::Recomputing)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(d->recomputeMutex);
+    if (testStatus(Document::ProfileRecompute)) {
+        ++d->getRecomputeTiming(Who).changedProperties;
+    }
+    if (What->testStatus(Property::SameValue)) {
+        d->sameOnRecompute.insert(Who);
+    }
+    else {
+        d->changedOnRecompute.insert(Who);
+    }
+}
+
+bool Document::deferSignal(const DocumentObject* obj, std::function<void()>&& func)
+{
+    if (!d->concurrentRecompute || std::this_thread::get_id() == d->recomputeThread) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(d->recomputeMutex);
+    d->deferredSignals[obj].push_back(std::move(func));
+    return true;
 }
 
 void Document::setTransactionMode(const int iMode) // NOLINT
@@ -990,7 +1147,11 @@ void Document::Save(Base::Writer& writer) const
                     << Application::Config()["BuildVersionMajor"] << "."
                     << Application::Config()["BuildVersionMinor"] << "R"
                     << Application::Config()["BuildRevision"] << "\" FileVersion=\""
-                    << writer.getFileVersion() << "\" StringHasher=\"1\">\n";
+                    << writer.getFileVersion() << "\" StringHasher=\"1\"";
+    if (writer.hasBinaryData()) {
+        writer.Stream() << " BinaryData=\"1\"";
+    }
+    writer.Stream() << ">\n";
 
     writer.incInd();
 
@@ -1008,6 +1169,11 @@ void Document::Save(Base::Writer& writer) const
 
     // writing the features types
     writeObjects(d->objectArray, writer);
+    if (writer.hasBinaryData()) {
+        // Only the data of this file is stored, e.g. not the one of the Gui document
+        writer.Stream() << "<BinaryData file=\""
+                        << writer.addBinaryDataFile("PropertyData.bin") << "\"/>\n";
+    }
     writer.Stream() << "</Document>" << '\n';
 }
 
@@ -1034,6 +1200,8 @@ void Document::Restore(Base::XMLReader& reader)
         reader.FileVersion = 0;
     }
 
+    const bool binaryData = reader.getAttribute<bool>("BinaryData", false);
+
     if (reader.hasAttribute("StringHasher")) {
         d->Hasher->Restore(reader);
     }
@@ -1101,6 +1269,11 @@ void Document::Restore(Base::XMLReader& reader)
         Tip.setValue(getObject(TipName.getValue()));
     }
 
+    if (binaryData) {
+        reader.readElement("BinaryData");
+        reader.addBinaryDataFile(reader.getAttribute<const char*>("file"));
+    }
+
     reader.readEndElement("Document");
 }
 
@@ -1668,6 +1841,62 @@ unsigned int Document::getMemSize() const
     return size;
 }
 
+std::string Document::getMemoryReport() const
+{
+    auto bySize = [](const nlohmann::json& a, const nlohmann::json& b) {
+        return a["size"].get<std::size_t>() > b["size"].get<std::size_t>();
+    };
+    auto propertySizes = [&](const PropertyContainer* container, std::size_t& size) {
+        std::vector<Property*> props;
+        container->getPropertyList(props);
+        nlohmann::json properties = nlohmann::json::array();
+        size = 0;
+        for (auto prop : props) {
+            std::size_t propSize = prop->getMemSize();
+            size += propSize;
+            properties.push_back({{"name", prop->getName()}, {"size", propSize}});
+        }
+        std::sort(properties.begin(), properties.end(), bySize);
+        return properties;
+    };
+
+    std::size_t total = 0;
+    nlohmann::json objects = nlohmann::json::array();
+    for (auto obj : d->objectArray) {
+        std::size_t size = 0;
+        auto properties = propertySizes(obj, size);
+        total += size;
+        objects.push_back({{"name", obj->getNameInDocument()},
+                           {"label", obj->Label.getValue()},
+                           {"type", obj->getTypeId().getName()},
+                           {"size", size},
+                           {"properties", properties}});
+    }
+    std::sort(objects.begin(), objects.end(), bySize);
+
+    std::size_t undo = 0;
+    for (const auto* transaction : mUndoTransactions) {
+        undo += transaction->getMemSize();
+    }
+    std::size_t redo = 0;
+    for (const auto* transaction : mRedoTransactions) {
+        redo += transaction->getMemSize();
+    }
+    std::size_t hasher = d->Hasher->getMemSize();
+    std::size_t own = 0;
+    auto properties = propertySizes(this, own);
+    total += undo + redo + hasher + own;
+
+    nlohmann::json report = {{"document", getName()},
+                             {"total", total},
+                             {"undo", undo},
+                             {"redo", redo},
+                             {"hasher", hasher},
+                             {"properties", properties},
+                             {"objects", objects}};
+    return report.dump();
+}
+
 static std::string checkFileName(const char* file)
 {
     std::string fn(file);
@@ -1815,6 +2044,12 @@ bool Document::saveToFile(const char* filename) const
 
         writer.setComment("FreeCAD Document");
         writer.setLevel(compression);
+        int threads = static_cast<int>(hGrp->GetInt("SaveThreads", 0));
+        if (threads <= 0) {
+            threads = static_cast<int>(std::thread::hardware_concurrency());
+        }
+        writer.setThreads(static_cast<unsigned int>(std::max(threads, 1)));
+        writer.setBinaryData(hGrp->GetBool("SaveBinaryProperties", false));
         writer.putNextEntry("Document.xml");
 
         if (hGrp->GetBool("SaveBinaryBrep", false)) {
@@ -1941,6 +2176,8 @@ void Document::restore(const char* filename,
     d->objectNameManager.clear();
     d->objectMap.clear();
     d->objectIdMap.clear();
+    d->objectLabelMap.clear();
+    d->objectTypeMap.clear();
     d->lastObjectId = 0;
 
     if (signal) {
@@ -2629,6 +2866,14 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
     // delete recompute log
     d->clearRecomputeLog();
 
+    bool profile = testStatus(Document::ProfileRecompute);
+    if (profile) {
+        d->recomputeProfile.clear();
+        d->recomputeProfileOrder.clear();
+        d->recomputeProfileTotal = 0.0;
+    }
+    Base::TimeElapsed profileStart;
+
     FC_TIME_INIT(t);
 
     Base::ObjectStatusLocker<Document::Status, Document> exe(Document::Recomputing, this);
@@ -2660,8 +2905,8 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
    */
 
     // alt:
-    auto topoSortedObjects =
-        getDependencyList(objs.empty() ? d->objectArray : objs, DepSort | options);
+    auto topoSortedObjects = objs.empty() ? getCachedDependencyList(DepSort | options)
+                                          : getDependencyList(objs, DepSort | options);
 
     for (auto obj : topoSortedObjects) {
         obj->setStatus(ObjectStatus::PendingRecompute, true);
@@ -2670,11 +2915,36 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
     ParameterGrp::handle hGrp =
         GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
     bool canAbort = hGrp->GetBool("CanAbortRecompute", true);
+    // Stop propagating the recompute past an object that only recomputed
+    // because of its dependencies and reproduced an identical output
+    bool earlyCutoff = hGrp->GetBool("RecomputeEarlyCutoff", true);
+    std::unordered_set<DocumentObject*> initiallyTouched;
+    if (earlyCutoff) {
+        for (auto obj : topoSortedObjects) {
+            if (obj->isTouched() || obj->mustRecompute()) {
+                initiallyTouched.insert(obj);
+            }
+        }
+    }
+    d->changedOnRecompute.clear();
+    d->sameOnRecompute.clear();
+    // Cancel the recompute once it took longer than this, checked between objects
+    double timeBudget = hGrp->GetFloat("RecomputeTimeBudget", 0.0);
+    Base::TimeElapsed recomputeStart;
+    int threads = 1;
+    if (hGrp->GetBool("ParallelRecompute", false)) {
+        threads = static_cast<int>(hGrp->GetInt("RecomputeThreads", 0));
+        if (threads <= 0) {
+            threads = static_cast<int>(std::thread::hardware_concurrency());
+        }
+    }
 
     FC_TIME_INIT(t2);
 
     try {
         std::set<DocumentObject*> filter;
+        // results of objects already recomputed concurrently in a batch
+        std::unordered_map<DocumentObject*, int> batchResults;
         size_t idx = 0;
         // maximum two passes to allow some form of dependency inversion
         for (int passes = 0; passes < 2 && idx < topoSortedObjects.size(); ++passes) {
@@ -2685,6 +2955,17 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
             }
             FC_LOG("Recompute pass " << passes);
             for (; idx < topoSortedObjects.size(); ++idx) {
+                if (timeBudget > 0.0
+                    && Base::TimeElapsed::diffTimeF(recomputeStart) > timeBudget) {
+                    FC_WARN("Recompute of " << getName() << " exceeded its time budget of "
+                                            << timeBudget << " s");
+                    cancelRecompute();
+                }
+                if (isRecomputeCanceled()) {
+                    FC_WARN("Recompute of " << getName() << " cancelled");
+                    passes = 2;
+                    break;
+                }
                 auto obj = topoSortedObjects[idx];
                 if (!obj->isAttachedToDocument() || filter.find(obj) != filter.end()) {
                     continue;
@@ -2694,7 +2975,47 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
                 if (obj->mustRecompute()) {
                     doRecompute = true;
                     ++objectCount;
-                    int res = _recomputeFeature(obj);
+                    if (threads > 1 && !batchResults.contains(obj)
+                        && obj->canRecomputeConcurrently()) {
+                        // Collect the following objects that can run at the same
+                        // time, i.e. the ones that do not depend on each other.
+                        // Stop at the first one that cannot, so that the
+                        // observable order stays the same as the serial recompute.
+                        std::vector<DocumentObject*> batch {obj};
+                        std::set<DocumentObject*> members {obj};
+                        for (size_t j = idx + 1; j < topoSortedObjects.size(); ++j) {
+                            auto next = topoSortedObjects[j];
+                            if (!next->isAttachedToDocument() || filter.contains(next)
+                                || !next->canRecomputeConcurrently() || !next->mustRecompute()) {
+                                break;
+                            }
+                            const auto& deps = next->getOutList();
+                            if (std::any_of(deps.begin(), deps.end(), [&](DocumentObject* dep) {
+                                    return members.contains(dep);
+                                })) {
+                                break;
+                            }
+                            batch.push_back(next);
+                            members.insert(next);
+                        }
+                        if (batch.size() > 1) {
+                            FC_LOG("Recompute " << batch.size() << " objects concurrently");
+                            auto results = _recomputeConcurrently(batch, threads);
+                            for (size_t j = 0; j < batch.size(); ++j) {
+                                batchResults[batch[j]] = results[j];
+                            }
+                        }
+                    }
+                    int res = 0;
+                    auto batchIt = batchResults.find(obj);
+                    if (batchIt != batchResults.end()) {
+                        res = batchIt->second;
+                        batchResults.erase(batchIt);
+                        d->flushDeferredSignals(obj);
+                    }
+                    else {
+                        res = _recomputeFeature(obj);
+                    }
                     if (res != 0) {
                         if (hasError) {
                             *hasError = true;
@@ -2713,11 +3034,19 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
                 if (obj->isTouched() || doRecompute) {
                     signalRecomputedObject(*obj);
                     obj->purgeTouched();
-                    // set all dependent object touched to force recompute
-                    for (auto inObjIt : obj->getInList()) {
-                        inObjIt->enforceRecompute();
+                    if (earlyCutoff && doRecompute && !initiallyTouched.contains(obj)
+                        && d->sameOnRecompute.contains(obj)
+                        && !d->changedOnRecompute.contains(obj)) {
+                        FC_LOG("Skip dependents of unchanged " << obj->getFullName());
+                    }
+                    else {
+                        // set all dependent object touched to force recompute
+                        for (auto inObjIt : obj->getInList()) {
+                            inObjIt->enforceRecompute();
+                        }
                     }
                 }
+                signalRecomputeProgress(*obj, idx + 1, topoSortedObjects.size());
                 if (seq) {
                     seq->next(true);
                 }
@@ -2746,6 +3075,15 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
         e.reportException();
     }
 
+    if (d->recomputeCanceled.exchange(false)) {
+        --canceledRecomputes;
+    }
+
+    // deliver what is left over from an interrupted concurrent batch
+    for (auto obj : topoSortedObjects) {
+        d->flushDeferredSignals(obj);
+    }
+
     FC_TIME_LOG(t2, "Recompute");
 
     for (auto obj : topoSortedObjects) {
@@ -2756,6 +3094,10 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
         obj->setStatus(ObjectStatus::Recompute2, false);
     }
 
+    if (profile) {
+        d->recomputeProfileTotal = Base::TimeElapsed::diffTimeF(profileStart);
+    }
+
     signalRecomputed(*this, topoSortedObjects);
 
     FC_TIME_LOG(t, "Recompute total");
@@ -2975,9 +3317,70 @@ const char* Document::getErrorDescription(const DocumentObject* Obj) const
     return d->findRecomputeLog(Obj);
 }
 
+namespace
+{
+// The number of running recomputes that are cancelled, OCC operations break while there is any
+std::atomic<int> canceledRecomputes {0};
+}  // namespace
+
+void Document::cancelRecompute()
+{
+    if (testStatus(Document::Recomputing) && !d->recomputeCanceled.exchange(true)) {
+        ++canceledRecomputes;
+    }
+}
+
+bool Document::isRecomputeCanceled() const
+{
+    return d->recomputeCanceled.load();
+}
+
+bool Document::isAnyRecomputeCanceled()
+{
+    return canceledRecomputes.load() > 0;
+}
+
+std::string Document::getRecomputeProfile() const
+{
+    nlohmann::json objects = nlohmann::json::array();
+    for (auto obj : d->recomputeProfileOrder) {
+        const auto& timing = d->recomputeProfile[obj];
+        objects.push_back({{"name", timing.name},
+                           {"label", timing.label},
+                           {"type", timing.type},
+                           {"time", timing.seconds},
+                           {"changedProperties", timing.changedProperties},
+                           {"error", timing.error}});
+    }
+    nlohmann::json profile = {{"document", getName()},
+                              {"total", d->recomputeProfileTotal},
+                              {"objects", objects}};
+    return profile.dump(2);
+}
+
 // call the recompute of the Feature and handle the exceptions and errors.
 int Document::_recomputeFeature(DocumentObject* Feat) // NOLINT
 {
+    if (!testStatus(Document::ProfileRecompute)) {
+        return _executeFeature(Feat);
+    }
+
+    Base::TimeElapsed start;
+    int res = _executeFeature(Feat);
+    float seconds = Base::TimeElapsed::diffTimeF(start);
+
+    std::lock_guard<std::mutex> lock(d->recomputeMutex);
+    auto& timing = d->getRecomputeTiming(Feat);
+    timing.seconds += seconds;
+    timing.error = res != 0;
+    return res;
+}
+
+int Document::_executeFeature(DocumentObject* Feat) // NOLINT
+{
+    ZoneScoped;
+    ZoneTextF("%s", Feat->getFullName().c_str());
+
     FC_LOG("Recomputing " << Feat->getFullName());
 
     DocumentObjectExecReturn* returnCode = nullptr;
@@ -3033,6 +3436,45 @@ int Document::_recomputeFeature(DocumentObject* Feat) // NOLINT
     return 0;
 }
 
+std::vector<int> Document::_recomputeConcurrently(const std::vector<DocumentObject*>& objs,
+                                                  int threads)
+{
+    std::vector<int> results(objs.size(), 0);
+    std::atomic<size_t> next {0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < objs.size(); i = next++) {
+            try {
+                results[i] = _recomputeFeature(objs[i]);
+            }
+            catch (...) {
+                d->addRecomputeLog("Unknown exception!", objs[i]);
+                results[i] = 1;
+            }
+        }
+    };
+
+    d->recomputeThread = std::this_thread::get_id();
+    d->concurrentRecompute = true;
+    {
+        // The workers may need the GIL, e.g. for expressions calling into Python
+        std::unique_ptr<Base::PyGILStateRelease> release;
+        if (Py_IsInitialized() && PyGILState_Check()) {
+            release = std::make_unique<Base::PyGILStateRelease>();
+        }
+        std::vector<std::thread> pool;
+        size_t count = std::min(objs.size(), static_cast<size_t>(threads));
+        pool.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            pool.emplace_back(worker);
+        }
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+    d->concurrentRecompute = false;
+    return results;
+}
+
 bool Document::recomputeFeature(DocumentObject* feature, bool recursive)
 {
     // delete recompute log
@@ -3090,25 +3532,46 @@ DocumentObject* Document::addObject(const char* sType,
 std::vector<DocumentObject*>
 Document::addObjects(const char* sType, const std::vector<std::string>& objectNames, bool isNew)
 {
-    Base::Type type =
-        Base::Type::getTypeIfDerivedFrom(sType, DocumentObject::getClassTypeId(), true);
-    if (type.isBad()) {
-        std::stringstream str;
-        str << "'" << sType << "' is not a document object type";
-        throw Base::TypeError(str.str());
+    return addObjects(std::vector<std::string> {sType}, objectNames, isNew);
+}
+
+std::vector<DocumentObject*> Document::addObjects(const std::vector<std::string>& types,
+                                                  const std::vector<std::string>& objectNames,
+                                                  bool isNew)
+{
+    if (types.size() != 1 && types.size() != objectNames.size()) {
+        throw Base::ValueError("The number of types must be one or the number of names");
+    }
+
+    // the types are checked first, so either all objects are created or none
+    std::vector<Base::Type> objectTypes;
+    objectTypes.reserve(types.size());
+    for (const auto& sType : types) {
+        Base::Type type =
+            Base::Type::getTypeIfDerivedFrom(sType.c_str(), DocumentObject::getClassTypeId(), true);
+        if (type.isBad()) {
+            std::stringstream str;
+            str << "'" << sType << "' is not a document object type";
+            throw Base::TypeError(str.str());
+        }
+        if (!type.canInstantiate()) {
+            return {};
+        }
+        objectTypes.push_back(type);
     }
 
     std::vector<DocumentObject*> objects;
-    objects.resize(objectNames.size());
-    std::generate(objects.begin(), objects.end(), [&] {
-        return static_cast<DocumentObject*>(type.createInstance());
-    });
-    // the type instance could be a null pointer, it is enough to check the first element
-    if (!objects.empty() && !objects[0]) {
-        objects.clear();
-        return objects;
+    objects.reserve(objectNames.size());
+    for (std::size_t i = 0; i < objectNames.size(); ++i) {
+        const Base::Type& type = objectTypes[objectTypes.size() == 1 ? 0 : i];
+        objects.push_back(static_cast<DocumentObject*>(type.createInstance()));
     }
 
+    // room for all objects at once instead of growing the maps while adding them
+    d->objectArray.reserve(d->objectArray.size() + objects.size());
+    d->objectMap.reserve(d->objectMap.size() + objects.size());
+    d->objectIdMap.reserve(d->objectIdMap.size() + objects.size());
+
     for (auto it = objects.begin(); it != objects.end(); ++it) {
         size_t index = std::distance(objects.begin(), it);
         DocumentObject* pcObject = *it;
@@ -3163,6 +3626,9 @@ void Document::_addObject(DocumentObject* pcObject, const char* pObjectName, Add
     }
     d->objectIdMap[pcObject->_Id] = pcObject;
     d->objectArray.push_back(pcObject);
+    d->objectLabelMap[pcObject->Label.getStrValue()].push_back(pcObject);
+    d->objectTypeMap[pcObject->getTypeId().getKey()].emplace_back(++d->lastObjectOrder, pcObject);
+    DocumentObject::_touchDependencyGeneration();
      
      // do no transactions if we do a rollback!
     if (!d->rollback) {
@@ -3318,6 +3784,20 @@ void Document::_removeObject(DocumentObject* pcObject, RemoveObjectOptions optio
             break;
         }
     }
+    if (auto it = d->objectLabelMap.find(pcObject->Label.getStrValue());
+        it != d->objectLabelMap.end()) {
+        std::erase(it->second, pcObject);
+        if (it->second.empty()) {
+            d->objectLabelMap.erase(it);
+        }
+    }
+    if (auto it = d->objectTypeMap.find(pcObject->getTypeId().getKey());
+        it != d->objectTypeMap.end()) {
+        std::erase_if(it->second, [pcObject](const auto& entry) {
+            return entry.second == pcObject;
+        });
+    }
+    DocumentObject::_touchDependencyGeneration();
     
     // In case the object gets deleted the pointer must be nullified
     if (tobedestroyed) {
@@ -3329,6 +3809,17 @@ void Document::_removeObject(DocumentObject* pcObject, RemoveObjectOptions optio
     d->objectMap.erase(pos);
 }
 
+void Document::_relabelObject(DocumentObject* pcObject, const std::string& oldLabel)
+{
+    if (auto it = d->objectLabelMap.find(oldLabel); it != d->objectLabelMap.end()) {
+        std::erase(it->second, pcObject);
+        if (it->second.empty()) {
+            d->objectLabelMap.erase(it);
+        }
+    }
+    d->objectLabelMap[pcObject->Label.getStrValue()].push_back(pcObject);
+}
+
 void Document::breakDependency(DocumentObject* pcObject, const bool clear) // NOLINT
 {
     // Nullify all dependent objects
@@ -3610,7 +4101,19 @@ std::string Document::getStandardObjectLabel(const char* modelName, int digitCou
 
 std::vector<DocumentObject*> Document::getDependingObjects() const
 {
-    return getDependencyList(d->objectArray);
+    return getCachedDependencyList();
+}
+
+std::vector<DocumentObject*> Document::getCachedDependencyList(int options) const
+{
+    const auto generation = DocumentObject::getDependencyGeneration();
+    auto it = d->dependencyListCache.find(options);
+    if (it != d->dependencyListCache.end() && it->second.generation == generation) {
+        return it->second.objects;
+    }
+    auto objs = getDependencyList(d->objectArray, options);
+    d->dependencyListCache[options] = {generation, objs};
+    return objs;
 }
 
 const std::vector<DocumentObject*>& Document::getObjects() const
@@ -3620,25 +4123,61 @@ const std::vector<DocumentObject*>& Document::getObjects() const
 
 std::vector<DocumentObject*> Document::getObjectsOfType(const Base::Type& typeId) const
 {
-    std::vector<DocumentObject*> Objects;
-    for (auto it : d->objectArray) {
-        if (it->isDerivedFrom(typeId)) {
-            Objects.push_back(it);
+    return getObjectsOfType(std::vector<Base::Type> {typeId});
+}
+
+std::vector<DocumentObject*> Document::getObjectsOfType(const std::vector<Base::Type>& types) const
+{
+    // Only the buckets of the types in the document are checked, each object is in one of them.
+    std::vector<std::pair<std::size_t, DocumentObject*>> found;
+    const std::vector<std::pair<std::size_t, DocumentObject*>>* single = nullptr;
+    std::size_t buckets = 0;
+    for (const auto& [key, objects] : d->objectTypeMap) {
+        const Base::Type type = Base::Type::fromKey(key);
+        if (objects.empty() || std::none_of(types.begin(), types.end(), [type](auto typeId) {
+                return type.isDerivedFrom(typeId);
+            })) {
+            continue;
+        }
+        if (++buckets == 1) {
+            single = &objects;
+            continue;
+        }
+        if (buckets == 2) {
+            found.insert(found.end(), single->begin(), single->end());
         }
+        found.insert(found.end(), objects.begin(), objects.end());
+    }
+    if (buckets == 1) {
+        found = *single;
+    }
+    else {
+        // in the order the objects were added, as in getObjects()
+        std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+    }
+
+    std::vector<DocumentObject*> Objects;
+    Objects.reserve(found.size());
+    for (const auto& entry : found) {
+        Objects.push_back(entry.second);
     }
     return Objects;
 }
 
-std::vector<DocumentObject*> Document::getObjectsOfType(const std::vector<Base::Type>& types) const
+std::vector<DocumentObject*> Document::getObjectsByLabel(const std::string& label) const
 {
     std::vector<DocumentObject*> Objects;
-    for (auto it : d->objectArray) {
-        for (auto& typeId : types) {
-            if (it->isDerivedFrom(typeId)) {
-                Objects.push_back(it);
-                break; // Prevent adding several times the same object.
-            }
-        }
+    auto it = d->objectLabelMap.find(label);
+    if (it != d->objectLabelMap.end()) {
+        // on the safe side, in case a Label was changed without notifying the document
+        std::copy_if(it->second.begin(),
+                     it->second.end(),
+                     std::back_inserter(Objects),
+                     [&label](DocumentObject* obj) {
+                         return obj->Label.getStrValue() == label;
+                     });
     }
     return Objects;
 }
@@ -3696,9 +4235,13 @@ Document::findObjects(const Base::Type& typeId, const char* objname, const char*
 
 int Document::countObjectsOfType(const Base::Type& typeId) const
 {
-    return std::count_if(d->objectMap.begin(), d->objectMap.end(), [&](const auto& it) {
-        return it.second->isDerivedFrom(typeId);
-    });
+    std::size_t count = 0;
+    for (const auto& [key, objects] : d->objectTypeMap) {
+        if (Base::Type::fromKey(key).isDerivedFrom(typeId)) {
+            count += objects.size();
+        }
+    }
+    return static_cast<int>(count);
 }
 
 int Document::countObjectsOfType(const char* typeName) const
@@ -112,7 +112,8 @@ public:
         LinkStampChanged = 11,        // Indicates during restore time if any linked document's time stamp has changed
         IgnoreErrorOnRecompute = 12,  // Don't report errors if the recompute failed
         RecomputeOnRestore = 13,      // Mark pending recompute on restore for migration purposes
-        MigrateLCS = 14               // Migrate local coordinate system of older versions
+        MigrateLCS = 14,              // Migrate local coordinate system of older versions
+        ProfileRecompute = 15         // Record per object timings on recompute, see getRecomputeProfile()
     };
     // clang-format on
 
@@ -174,6 +175,8 @@ public:
     boost::signals2::signal<void(const DocumentObject&, const Property&)> signalBeforeChangeObject;
     /// signal on changed Object
     boost::signals2::signal<void(const DocumentObject&, const Property&)> signalChangedObject;
+    /// signal once per changed Object at the end of a ChangeSignalBatch
+    boost::signals2::signal<void(const DocumentObject&, const std::vector<const Property*>&)> signalBatchChangedObject;
     /// signal on manually called DocumentObject::touch()
     boost::signals2::signal<void(const DocumentObject&)> signalTouchedObject;
     /// signal on relabeled Object
@@ -208,6 +211,9 @@ public:
     boost::signals2::signal<void(const Document&)> signalBeforeRecompute;
     boost::signals2::signal<void(const Document&, const std::vector<DocumentObject*>&)> signalRecomputed;
     boost::signals2::signal<void(const DocumentObject&)> signalRecomputedObject;
+    // signal after each object visited by a recompute, with the objects done and their total
+    boost::signals2::signal<void(const DocumentObject&, std::size_t, std::size_t)>
+        signalRecomputeProgress;
     // signal a new opened transaction
     boost::signals2::signal<void(const Document&, std::string)> signalOpenTransaction;
     // signal a committed transaction
@@ -289,6 +295,16 @@ public:
     /// returns the complete document memory consumption, including all managed DocObjects and Undo
     /// Redo.
     unsigned int getMemSize() const override;
+    /** Return the memory consumption of the document in detail
+     *
+     * The result is a JSON object with the total size in bytes, the sizes of
+     * the undo and redo transactions, the string hasher and the document
+     * properties, and a list of the objects, largest first, each with the
+     * sizes of its properties. The sizes are the estimates of
+     * Property::getMemSize(), e.g. a shape includes its tessellation and its
+     * element map.
+     */
+    std::string getMemoryReport() const;
 
     /** @name Object handling  */
     //@{
@@ -331,6 +347,15 @@ public:
      */
     std::vector<DocumentObject*>
     addObjects(const char* sType, const std::vector<std::string>& objectNames, bool isNew = true);
+    /** Add an array of features of the given types and names.
+     * @param types       The type of each created object, or a single type for all of them
+     * @param objectNames A list of object names
+     * @param isNew       If false don't call the \c DocumentObject::setupObject() callback (default
+     * is true)
+     */
+    std::vector<DocumentObject*> addObjects(const std::vector<std::string>& types,
+                                            const std::vector<std::string>& objectNames,
+                                            bool isNew = true);
     /// Remove a feature out of the document
     void removeObject(const char* sName);
     /** Add an existing feature with sName (ASCII) to this document and set it active.
@@ -391,6 +416,8 @@ public:
     const std::vector<DocumentObject*>& getObjects() const;
     std::vector<DocumentObject*> getObjectsOfType(const Base::Type& typeId) const;
     std::vector<DocumentObject*> getObjectsOfType(const std::vector<Base::Type>& types) const;
+    /// Returns all objects with the given Label, normally at most one
+    std::vector<DocumentObject*> getObjectsByLabel(const std::string& label) const;
     /// Returns all object with given extensions. If derived=true also all objects with extensions
     /// derived from the given one
     std::vector<DocumentObject*> getObjectsWithExtension(const Base::Type& typeId,
@@ -440,8 +467,29 @@ public:
                   int options = 0);
     /// Recompute only one feature
     bool recomputeFeature(DocumentObject* Feat, bool recursive = false);
+    /** Cancel the running recompute of this document
+     *
+     * The recompute stops before the next object, and the OCC operations of
+     * the objects being recomputed are asked to break through the progress
+     * indicator of the application. It can be called from any thread. The
+     * recompute is also cancelled when it takes longer than the parameter
+     * RecomputeTimeBudget in seconds, if it is set.
+     */
+    void cancelRecompute();
+    /// Check if the running recompute of this document is cancelled
+    bool isRecomputeCanceled() const;
+    /// Check if the running recompute of any document is cancelled
+    static bool isAnyRecomputeCanceled();
     /// get the text of the error of a specified object
     const char* getErrorDescription(const DocumentObject*) const;
+    /** Return the timings of the last recompute done with status ProfileRecompute set
+     *
+     * The result is a JSON object with the total time and a list of the
+     * recomputed objects in recompute order, each with its execution time in
+     * seconds, the number of its properties changed during the recompute and
+     * whether it failed.
+     */
+    std::string getRecomputeProfile() const;
     /// return the status bits
     bool testStatus(Status pos) const;
     /// set the status bits
@@ -494,8 +542,10 @@ public:
     /// Check if a transaction is open and its list is empty.
     /// If no transaction is open true is returned.
     bool isTransactionEmpty() const;
-    /// Set the Undo limit in Byte!
+    /// Set the Undo limit in Byte! Zero means no limit.
     void setUndoLimit(unsigned int UndoMemSize = 0);
+    /// Returns the Undo limit in Byte
+    unsigned int getUndoLimit() const;
     /// Returns the actual memory consumption of the Undo redo stuff.
     unsigned int getUndoMemSize() const;
     /// Set the Undo limit as stack size
@@ -554,6 +604,14 @@ public:
      */
     static std::vector<DocumentObject*>
     getDependencyList(const std::vector<DocumentObject*>& objs, int options = 0);
+    /** Get the dependency list of all objects in this document
+     *
+     * Same as getDependencyList(getObjects(), options), except that the
+     * result is cached until the object dependencies change.
+     *
+     * @param options: See DependencyOption
+     */
+    std::vector<DocumentObject*> getCachedDependencyList(int options = 0) const;
 
     std::vector<Document*> getDependentDocuments(bool sort = true);
     static std::vector<Document*> getDependentDocuments(std::vector<Document*> docs,
@@ -651,6 +709,7 @@ public:
     friend class DocumentObject;
     friend class Transaction;
     friend class TransactionDocumentObject;
+    friend class ChangeSignalBatch;
 
     /// Destruction
     ~Document() override;
@@ -661,6 +720,8 @@ protected:
 
     void _removeObject(DocumentObject* pcObject, RemoveObjectOptions options = RemoveObjectOption::DestroyOnRollback | RemoveObjectOption::PreserveChildrenVisibility);
     void _addObject(DocumentObject* pcObject, const char* pObjectName, AddObjectOptions options = AddObjectOption::ActivateObject, const char* viewType = nullptr);
+    /// moves the object in the label index after its Label changed
+    void _relabelObject(DocumentObject* pcObject, const std::string& oldLabel);
     /// checks if a valid transaction is open
     void _checkTransaction(DocumentObject* pcDelObj, const Property* What, int line);
     void breakDependency(DocumentObject* pcObject, bool clear);
@@ -675,9 +736,29 @@ protected:
     void onBeforeChangeProperty(const TransactionalObject* Who, const Property* What);
     /// callback from the Document objects after property was changed
     void onChangedProperty(const DocumentObject* Who, const Property* What);
+    /// callback from the Document objects after property was changed, not deferred on recompute
+    void trackChangedProperty(const DocumentObject* Who, const Property* What);
     /// helper which Recompute only this feature
     /// @return 0 if succeeded, 1 if failed, -1 if aborted by user.
     int _recomputeFeature(DocumentObject* Feat);
+    /// helper of _recomputeFeature() doing the actual work
+    int _executeFeature(DocumentObject* Feat);
+    /** Recompute a batch of mutually independent features on worker threads
+     *
+     * @param objs: features that do not depend on each other
+     * @param threads: maximum number of worker threads to use
+     *
+     * @return Return the _recomputeFeature() result of each feature.
+     */
+    std::vector<int> _recomputeConcurrently(const std::vector<DocumentObject*>& objs, int threads);
+    /** Queue a notification raised by an object recomputed on a worker thread
+     *
+     * @return Return false if the caller is not a recompute worker thread and
+     * should invoke the notification directly.
+     */
+    bool deferSignal(const DocumentObject* obj, std::function<void()>&& func);
+    /// emit the change signals collected during a ChangeSignalBatch
+    void flushChangeSignals();
     void _clearRedos();
 
     /// refresh the internal dependency graph
@@ -742,6 +823,28 @@ inline int Document::countObjectsOfType() const
     return this->countObjectsOfType(T::getClassTypeId());
 }
 
+/** Coalesce property change notifications
+ *
+ * While an instance is alive, signalChanged() and signalChangedObject() of
+ * all documents are not emitted by the current thread. Instead, each changed
+ * property is remembered once, and when the outermost batch ends the signals
+ * are emitted once per property, followed by one signalBatchChangedObject()
+ * per changed object. Properties of objects deleted in the meantime are
+ * dropped.
+ */
+class AppExport ChangeSignalBatch
+{
+public:
+    ChangeSignalBatch();
+    ~ChangeSignalBatch();
+
+    ChangeSignalBatch(const ChangeSignalBatch&) = delete;
+    ChangeSignalBatch& operator=(const ChangeSignalBatch&) = delete;
+
+    /// Check if a batch is active in the current thread
+    static bool isActive();
+};
+
 template<typename T>
 T* Document::addObject(const char* pObjectName, bool isNew, const char* viewType, bool isPartial)
 {
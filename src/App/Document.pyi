@@ -1,6 +1,6 @@
 from PropertyContainer import PropertyContainer
 from DocumentObject import DocumentObject
-from typing import Final, List, Tuple, Sequence
+from typing import Final, List, Tuple, Sequence, Union
 
 
 class Document(PropertyContainer):
@@ -205,6 +205,19 @@ class Document(PropertyContainer):
         """
         ...
 
+    def addObjects(
+        self, types: Union[str, Sequence[str]], names: Sequence[str]
+    ) -> List[DocumentObject]:
+        """
+        addObjects(types, names) -> list
+
+        Add several objects to the document at once, which is faster than adding them one by one.
+
+        types (String or list of Strings): the type of all objects, or the type of each object.
+        names (list of Strings): the names of the new objects.
+        """
+        ...
+
     def addProperty(
         self,
         *,
@@ -326,9 +339,43 @@ class Document(PropertyContainer):
         """
         ...
 
-    def recompute(self, objs: Sequence[DocumentObject] = None) -> int:
+    def recompute(
+        self,
+        objs: Sequence[DocumentObject] = None,
+        force: bool = False,
+        checkCycle: bool = False,
+        *,
+        profile: bool = False,
+    ) -> int:
+        """
+        recompute(objs=None, force=False, checkCycle=False, profile=False):
+        Recompute the document and returns the amount of recomputed features.
+        If profile is True, per object timings are recorded and can be
+        retrieved with getRecomputeProfile().
+        """
+        ...
+
+    def getRecomputeProfile(self) -> str:
+        """
+        getRecomputeProfile() -> str
+        Return the per object timings of the last profiled recompute as JSON.
+        """
+        ...
+
+    def getMemoryReport(self) -> str:
+        """
+        getMemoryReport() -> str
+        Return the estimated memory consumption of the document as JSON, in
+        total and per object and property, including the undo and redo
+        transactions.
+        """
+        ...
+
+    def cancelRecompute(self) -> None:
         """
-        recompute(objs=None): Recompute the document and returns the amount of recomputed features
+        cancelRecompute()
+        Cancel the running recompute of the document, e.g. from an observer
+        of the recomputed objects. The recompute stops before the next object.
         """
         ...
 
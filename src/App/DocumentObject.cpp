@@ -21,10 +21,13 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <atomic>
 #include <stack>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -82,6 +85,7 @@ DocumentObject::DocumentObject()
 
 DocumentObject::~DocumentObject()
 {
+    _touchDependencyGeneration();
     if (!PythonObject.is(Py::_None())) {
         Base::PyGILStateLocker lock;
         // Remark: The API of Py::Object has been changed to set whether the wrapper owns the passed
@@ -216,7 +220,9 @@ void DocumentObject::touch(bool noRecompute)
         StatusBits.set(ObjectStatus::Enforce);
     }
     StatusBits.set(ObjectStatus::Touch);
-    if (_pDoc) {
+    if (_pDoc && !_pDoc->deferSignal(this, [this]() {
+            _pDoc->signalTouchedObject(*this);
+        })) {
         _pDoc->signalTouchedObject(*this);
     }
 }
@@ -463,9 +469,32 @@ std::vector<App::DocumentObject*> DocumentObject::getOutListOfProperty(App::Prop
 
 const std::vector<App::DocumentObject*>& DocumentObject::getInList() const
 {
+    _compactInList();
     return _inList;
 }
 
+void DocumentObject::_compactInList() const
+{
+    if (_inListRemoved == 0) {
+        return;
+    }
+    _inListRemoved = 0;
+
+    // Each removal used to erase the first matching entry, so keep the last
+    // remaining occurrences of each object.
+    auto remaining = _inListCount;
+    std::vector<App::DocumentObject*> inList;
+    inList.reserve(_inList.size());
+    for (auto it = _inList.rbegin(); it != _inList.rend(); ++it) {
+        auto iter = remaining.find(*it);
+        if (iter != remaining.end() && iter->second > 0) {
+            --iter->second;
+            inList.push_back(*it);
+        }
+    }
+    _inList.assign(inList.rbegin(), inList.rend());
+}
+
 // The original algorithm is highly inefficient in some special case.
 // Considering an object is linked by every other objects. After excluding this
 // object, there is another object linked by every other of the remaining
@@ -491,9 +520,10 @@ void DocumentObject::getInListEx(std::set<App::DocumentObject*>& inSet,
                                  std::vector<App::DocumentObject*>* inList) const
 {
     if (!recursive) {
-        inSet.insert(_inList.begin(), _inList.end());
+        const auto& objs = getInList();
+        inSet.insert(objs.begin(), objs.end());
         if (inList) {
-            *inList = _inList;
+            *inList = objs;
         }
         return;
     }
@@ -583,12 +613,7 @@ bool DocumentObject::isInInListRecursive(DocumentObject* linkTo) const
 
 bool DocumentObject::isInInList(DocumentObject* linkTo) const
 {
-    if (std::ranges::find(_inList, linkTo) != _inList.end()) {
-        return true;
-    }
-    else {
-        return false;
-    }
+    return _inListCount.contains(linkTo);
 }
 
 // helper for isInOutListRecursive()
@@ -770,6 +795,11 @@ void DocumentObject::onBeforeChange(const Property* prop)
 
     if (_pDoc){
         onBeforeChangeProperty(_pDoc, prop);
+        if (_pDoc->deferSignal(this, [this, prop]() {
+                signalBeforeChange(*this, *prop);
+            })) {
+            return;
+        }
     }
 
     signalBeforeChange(*this, *prop);
@@ -860,9 +890,12 @@ void DocumentObject::onEarlyChange(const Property* prop)
 /// get called by the container when a Property was changed
 void DocumentObject::onChanged(const Property* prop)
 {
+    ++changeGeneration;
+
     if (prop == &Label && _pDoc && _pDoc->containsObject(this) && oldLabel != Label.getStrValue()) {
         _pDoc->unregisterLabel(oldLabel);
         _pDoc->registerLabel(Label.getStrValue());
+        _pDoc->_relabelObject(this, oldLabel);
     }
 
     if (isFreezed() && prop != &Visibility) {
@@ -910,6 +943,13 @@ void DocumentObject::onChanged(const Property* prop)
 
     // Now signal the view provider
     if (_pDoc) {
+        _pDoc->trackChangedProperty(this, prop);
+        if (_pDoc->deferSignal(this, [this, prop]() {
+                _pDoc->onChangedProperty(this, prop);
+                signalChanged(*this, *prop);
+            })) {
+            return;
+        }
         _pDoc->onChangedProperty(this, prop);
     }
 
@@ -932,11 +972,136 @@ PyObject* DocumentObject::getPyObject()
     return Py::new_reference_to(PythonObject);
 }
 
+namespace
+{
+// The objects resolved by getSubObject() and getLinkedObject() from the outside, which the
+// selection, the tree and the link view providers resolve over and over in nested assemblies.
+// Any change of an object or of the dependencies drops the whole cache, so an entry never
+// outlives a change of an object in its path. The matrix is the one accumulated from the
+// identity, and the caller's matrix is multiplied with it.
+class SubObjectCache
+{
+public:
+    struct Key
+    {
+        const DocumentObject* obj;
+        std::string subname;
+        bool linked;
+        bool recurse;
+        bool transform;
+        bool hasMatrix;
+
+        bool operator==(const Key& other) const
+        {
+            return obj == other.obj && linked == other.linked && recurse == other.recurse
+                && transform == other.transform && hasMatrix == other.hasMatrix
+                && subname == other.subname;
+        }
+    };
+    struct Entry
+    {
+        DocumentObject* obj;
+        Base::Matrix4D matrix;
+    };
+
+    static SubObjectCache& instance()
+    {
+        static SubObjectCache cache;
+        return cache;
+    }
+
+    static bool canCache(const DocumentObject* obj)
+    {
+        auto doc = obj->getDocument();
+        return doc && !doc->testStatus(Document::Restoring);
+    }
+
+    bool get(const Key& key, Entry& entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        validate();
+        auto it = entries.find(key);
+        if (it == entries.end()) {
+            return false;
+        }
+        entry = it->second;
+        return true;
+    }
+
+    void set(Key key, const Entry& entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        validate();
+        if (entries.size() >= maxEntries) {
+            entries.clear();
+        }
+        entries.emplace(std::move(key), entry);
+    }
+
+private:
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const
+        {
+            std::size_t hash = std::hash<const void*> {}(key.obj);
+            std::size_t name = std::hash<std::string> {}(key.subname);
+            hash ^= name + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            return hash ^ (std::size_t(key.linked) << 1) ^ (std::size_t(key.recurse) << 2)
+                ^ (std::size_t(key.transform) << 3) ^ (std::size_t(key.hasMatrix) << 4);
+        }
+    };
+
+    // the caller holds the mutex
+    void validate()
+    {
+        auto changes = DocumentObject::getChangeGeneration();
+        auto dependencies = DocumentObject::getDependencyGeneration();
+        if (changes != changeGeneration || dependencies != dependencyGeneration) {
+            entries.clear();
+            changeGeneration = changes;
+            dependencyGeneration = dependencies;
+        }
+    }
+
+    static constexpr std::size_t maxEntries = 10000;
+    std::mutex mutex;
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    std::size_t changeGeneration {0};
+    std::size_t dependencyGeneration {0};
+};
+}  // namespace
+
 DocumentObject* DocumentObject::getSubObject(const char* subname,
                                              PyObject** pyObj,
                                              Base::Matrix4D* mat,
                                              bool transform,
                                              int depth) const
+{
+    // Only the paths are cached, the Python objects of the sub-elements are made for each call,
+    // and the calls of the resolution itself go deeper.
+    if (pyObj || depth != 0 || !subname || !strchr(subname, '.')
+        || !SubObjectCache::canCache(this)) {
+        return _getSubObject(subname, pyObj, mat, transform, depth);
+    }
+
+    auto& cache = SubObjectCache::instance();
+    SubObjectCache::Key key {this, subname, false, false, transform, mat != nullptr};
+    SubObjectCache::Entry entry;
+    if (!cache.get(key, entry)) {
+        entry.obj = _getSubObject(subname, nullptr, mat ? &entry.matrix : nullptr, transform, 0);
+        cache.set(std::move(key), entry);
+    }
+    if (mat) {
+        *mat *= entry.matrix;
+    }
+    return entry.obj;
+}
+
+DocumentObject* DocumentObject::_getSubObject(const char* subname,
+                                              PyObject** pyObj,
+                                              Base::Matrix4D* mat,
+                                              bool transform,
+                                              int depth) const
 {
     DocumentObject* ret = nullptr;
     auto exts = getExtensionsDerivedFromType<App::DocumentObjectExtension>();
@@ -1151,6 +1316,29 @@ DocumentObject* DocumentObject::getLinkedObject(bool recursive,
                                                 Base::Matrix4D* mat,
                                                 bool transform,
                                                 int depth) const
+{
+    // an object without extensions is linked to itself, which is cheaper than the cache
+    if (depth != 0 || !hasExtensions() || !SubObjectCache::canCache(this)) {
+        return _getLinkedObject(recursive, mat, transform, depth);
+    }
+
+    auto& cache = SubObjectCache::instance();
+    SubObjectCache::Key key {this, {}, true, recursive, transform, mat != nullptr};
+    SubObjectCache::Entry entry;
+    if (!cache.get(key, entry)) {
+        entry.obj = _getLinkedObject(recursive, mat ? &entry.matrix : nullptr, transform, 0);
+        cache.set(std::move(key), entry);
+    }
+    if (mat) {
+        *mat *= entry.matrix;
+    }
+    return entry.obj;
+}
+
+DocumentObject* DocumentObject::_getLinkedObject(bool recursive,
+                                                 Base::Matrix4D* mat,
+                                                 bool transform,
+                                                 int depth) const
 {
     DocumentObject* ret = nullptr;
     auto exts = getExtensionsDerivedFromType<App::DocumentObjectExtension>();
@@ -1291,12 +1479,16 @@ void DocumentObject::unsetupObject()
 
 void App::DocumentObject::_removeBackLink(DocumentObject* rmvObj)
 {
-    // do not use erase-remove idom, as this erases ALL entries that match. we only want to remove a
-    // single one.
-    auto it = std::ranges::find(_inList, rmvObj);
-    if (it != _inList.end()) {
-        _inList.erase(it);
+    // only remove a single entry, the object may link to us through several properties
+    auto it = _inListCount.find(rmvObj);
+    if (it == _inListCount.end()) {
+        return;
     }
+    if (--it->second == 0) {
+        _inListCount.erase(it);
+    }
+    ++_inListRemoved;
+    _touchDependencyGeneration();
 }
 
 void App::DocumentObject::_addBackLink(DocumentObject* newObj)
@@ -1305,7 +1497,33 @@ void App::DocumentObject::_addBackLink(DocumentObject* newObj)
     // the removal: If a link loses this object it removes the backlink. If we would have added it
     // only once this removal would clear the object from the inlist, even though there may be other
     // link properties from this object that link to us.
+    if (_inListRemoved > _inList.size() / 2) {
+        _compactInList();
+    }
     _inList.push_back(newObj);
+    ++_inListCount[newObj];
+    _touchDependencyGeneration();
+}
+
+namespace
+{
+std::atomic<std::size_t> dependencyGeneration {0};
+std::atomic<std::size_t> changeGeneration {0};
+}
+
+std::size_t DocumentObject::getChangeGeneration()
+{
+    return changeGeneration.load();
+}
+
+std::size_t DocumentObject::getDependencyGeneration()
+{
+    return dependencyGeneration.load();
+}
+
+void DocumentObject::_touchDependencyGeneration()
+{
+    ++dependencyGeneration;
 }
 
 int DocumentObject::setElementVisible(const char* element, bool visible)
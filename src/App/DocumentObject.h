@@ -50,6 +50,7 @@ class Document;
 class DocumentObjectGroup;
 class DocumentObjectPy;
 class Expression;
+class Range;
 
 // clang-format off
 enum ObjectStatus
@@ -331,6 +332,19 @@ public:
     void _removeBackLink(DocumentObject*);
     /// internal, used by PropertyLink to maintain DAG back links
     void _addBackLink(DocumentObject*);
+    /** Return a counter that changes whenever the object dependency graph changes
+     *
+     * It is bumped on any link change and any object added to or removed from
+     * a document, so that dependency queries spanning several documents can be
+     * cached.
+     */
+    static std::size_t getDependencyGeneration();
+    /** Return a counter that changes whenever a property of any object changes
+     *
+     * Together with getDependencyGeneration() it tells if results computed from
+     * the objects, like resolved shapes, are still valid.
+     */
+    static std::size_t getChangeGeneration();
     //@}
 
     /**
@@ -377,6 +391,22 @@ public:
      */
     virtual short mustExecute() const;
 
+    /** Check if execute() may run on a worker thread
+     *
+     * When parallel recompute is enabled in the preferences, the document
+     * recomputes consecutive objects that do not depend on each other at the
+     * same time if all of them return true here. execute() must then only
+     * read from its dependencies and write to its own properties, must not
+     * touch the GUI and must not run Python code. Property change signals are
+     * delayed and delivered in the usual order once the batch is finished.
+     *
+     * The default implementation returns false.
+     */
+    virtual bool canRecomputeConcurrently() const
+    {
+        return false;
+    }
+
     /** Recompute only this feature
      *
      * @param recursive: set to true to recompute any dependent objects as well
@@ -512,6 +542,24 @@ public:
         return false;
     }
 
+    /** Get the properties of the cells in a range
+     *
+     * Objects made of cells, like a spreadsheet, resolve a whole range at once
+     * instead of each cell by its name.
+     *
+     * @param range: the cells, the properties are appended in the order
+     * Range::next() visits them, with nullptr for an empty cell.
+     * @param props: receives the properties
+     *
+     * @return false if the object has no cells
+     */
+    virtual bool getCellProperties(const Range& range, std::vector<Property*>& props) const
+    {
+        (void)range;
+        (void)props;
+        return false;
+    }
+
     /* Return true to bypass duplicate label checking */
     virtual bool allowDuplicateLabel() const
     {
@@ -793,7 +841,22 @@ private:
 private:
     // Back pointer to all the fathers in a DAG of the document
     // this is used by the document (via friend) to have a effective DAG handling
-    std::vector<App::DocumentObject*> _inList;
+    mutable std::vector<App::DocumentObject*> _inList;
+    // Number of back links of each object in _inList. Removing a back link
+    // only updates this map, and _inList is compacted on the next access, so
+    // that removing many links to an object does not scan _inList every time.
+    std::unordered_map<App::DocumentObject*, int> _inListCount;
+    mutable std::size_t _inListRemoved = 0;
+    void _compactInList() const;
+    static void _touchDependencyGeneration();
+    // the uncached resolution of getSubObject() and getLinkedObject()
+    DocumentObject* _getSubObject(const char* subname,
+                                  PyObject** pyObj,
+                                  Base::Matrix4D* mat,
+                                  bool transform,
+                                  int depth) const;
+    DocumentObject*
+    _getLinkedObject(bool recurse, Base::Matrix4D* mat, bool transform, int depth) const;
     mutable std::vector<App::DocumentObject*> _outList;
     mutable std::unordered_map<const char*, App::DocumentObject*, CStringHasher, CStringHasher>
         _outListMap;
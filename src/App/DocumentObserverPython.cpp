@@ -20,6 +20,7 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
 #include <functional>
 
 #include <CXX/Objects.hxx>
@@ -59,6 +60,8 @@ void DocumentObserverPython::removeObserver(const Py::Object& obj)
 DocumentObserverPython::DocumentObserverPython(const Py::Object& obj)
     : inst(obj)
 {
+    readFilters(obj);
+
 #define FC_PY_ELEMENT_ARG0(_name1, _name2)                                                         \
     do {                                                                                           \
         FC_PY_GetCallable(obj.ptr(), "slot" #_name1, py##_name1.py);                               \
@@ -114,11 +117,68 @@ DocumentObserverPython::DocumentObserverPython(const Py::Object& obj)
     FC_PY_ELEMENT_ARG2(ChangePropertyEditor, ChangePropertyEditor)
     FC_PY_ELEMENT_ARG2(BeforeAddingDynamicExtension, BeforeAddingDynamicExtension)
     FC_PY_ELEMENT_ARG2(AddedDynamicExtension, AddedDynamicExtension)
+
+    FC_PY_GetCallable(obj.ptr(), "slotChangedObjects", pyChangedObjects.py);
+    if (!pyChangedObjects.py.isNone()) {
+        auto& app = App::GetApplication();
+        pyChangedObjects.slot = app.signalChangedObject.connect(
+            std::bind(&DocumentObserverPython::slotChangedObjects, this, sp::_1, sp::_2));
+        connectChangesRecomputed = app.signalRecomputed.connect(
+            std::bind(&DocumentObserverPython::flushChangedObjects, this, sp::_1));
+        connectChangesDeleted = app.signalDeleteDocument.connect([this](const App::Document& doc) {
+            changes.erase(&doc);
+        });
+    }
     // NOLINTEND
 }
 
 DocumentObserverPython::~DocumentObserverPython() = default;
 
+void DocumentObserverPython::readFilters(const Py::Object& obj)
+{
+    if (obj.hasAttr("ObservedTypes")) {
+        Py::Sequence types(obj.getAttr("ObservedTypes"));
+        for (const auto& it : types) {
+            std::string name = Py::String(it).as_std_string("utf-8");
+            Base::Type type = Base::Type::fromName(name.c_str());
+            if (type.isBad()) {
+                throw Py::ValueError("Unknown type of ObservedTypes: " + name);
+            }
+            observedTypes.push_back(type);
+        }
+    }
+    if (obj.hasAttr("ObservedProperties")) {
+        Py::Sequence props(obj.getAttr("ObservedProperties"));
+        for (const auto& it : props) {
+            observedProperties.insert(Py::String(it).as_std_string("utf-8"));
+        }
+    }
+}
+
+bool DocumentObserverPython::isObserved(const App::DocumentObject& Obj) const
+{
+    if (observedTypes.empty()) {
+        return true;
+    }
+    Base::Type type = Obj.getTypeId();
+    return std::ranges::any_of(observedTypes, [type](Base::Type observed) {
+        return type.isDerivedFrom(observed);
+    });
+}
+
+const char* DocumentObserverPython::observedPropertyName(const App::DocumentObject& Obj,
+                                                         const App::Property& Prop) const
+{
+    if (!isObserved(Obj)) {
+        return nullptr;
+    }
+    const char* name = Obj.getPropertyName(&Prop);
+    if (name && !observedProperties.empty() && !observedProperties.contains(name)) {
+        return nullptr;
+    }
+    return name;
+}
+
 void DocumentObserverPython::slotCreatedDocument(const App::Document& Doc)
 {
     Base::PyGILStateLocker lock;
@@ -300,6 +360,9 @@ void DocumentObserverPython::slotChangedDocument(const App::Document& Doc,
 
 void DocumentObserverPython::slotCreatedObject(const App::DocumentObject& Obj)
 {
+    if (!isObserved(Obj)) {
+        return;
+    }
     Base::PyGILStateLocker lock;
     try {
         Py::Tuple args(1);
@@ -314,6 +377,9 @@ void DocumentObserverPython::slotCreatedObject(const App::DocumentObject& Obj)
 
 void DocumentObserverPython::slotDeletedObject(const App::DocumentObject& Obj)
 {
+    if (!isObserved(Obj)) {
+        return;
+    }
     Base::PyGILStateLocker lock;
     try {
         Py::Tuple args(1);
@@ -329,17 +395,18 @@ void DocumentObserverPython::slotDeletedObject(const App::DocumentObject& Obj)
 void DocumentObserverPython::slotBeforeChangeObject(const App::DocumentObject& Obj,
                                                     const App::Property& Prop)
 {
+    // If a property is touched but not part of a document object then its name is null.
+    // In this case the slot function must not be called.
+    const char* prop_name = observedPropertyName(Obj, Prop);
+    if (!prop_name) {
+        return;
+    }
     Base::PyGILStateLocker lock;
     try {
         Py::Tuple args(2);
         args.setItem(0, Py::asObject(const_cast<App::DocumentObject&>(Obj).getPyObject()));
-        // If a property is touched but not part of a document object then its name is null.
-        // In this case the slot function must not be called.
-        const char* prop_name = Obj.getPropertyName(&Prop);
-        if (prop_name) {
-            args.setItem(1, Py::String(prop_name));
-            Base::pyCall(pyBeforeChangeObject.ptr(), args.ptr());
-        }
+        args.setItem(1, Py::String(prop_name));
+        Base::pyCall(pyBeforeChangeObject.ptr(), args.ptr());
     }
     catch (Py::Exception&) {
         Base::PyException e;  // extract the Python error text
@@ -350,16 +417,69 @@ void DocumentObserverPython::slotBeforeChangeObject(const App::DocumentObject& O
 void DocumentObserverPython::slotChangedObject(const App::DocumentObject& Obj,
                                                const App::Property& Prop)
 {
+    // If a property is touched but not part of a document object then its name is null.
+    // In this case the slot function must not be called.
+    const char* prop_name = observedPropertyName(Obj, Prop);
+    if (!prop_name) {
+        return;
+    }
     Base::PyGILStateLocker lock;
     try {
         Py::Tuple args(2);
         args.setItem(0, Py::asObject(const_cast<App::DocumentObject&>(Obj).getPyObject()));
-        // If a property is touched but not part of a document object then its name is null.
-        // In this case the slot function must not be called.
-        const char* prop_name = Obj.getPropertyName(&Prop);
-        if (prop_name) {
-            args.setItem(1, Py::String(prop_name));
-            Base::pyCall(pyChangedObject.ptr(), args.ptr());
+        args.setItem(1, Py::String(prop_name));
+        Base::pyCall(pyChangedObject.ptr(), args.ptr());
+    }
+    catch (Py::Exception&) {
+        Base::PyException e;  // extract the Python error text
+        e.reportException();
+    }
+}
+
+void DocumentObserverPython::slotChangedObjects(const App::DocumentObject& Obj,
+                                                const App::Property& Prop)
+{
+    const char* prop_name = observedPropertyName(Obj, Prop);
+    const App::Document* doc = Obj.getDocument();
+    if (!prop_name || !doc || !Obj.getNameInDocument()) {
+        return;
+    }
+
+    auto& pending = changes[doc];
+    std::pair<std::string, std::string> change(Obj.getNameInDocument(), prop_name);
+    if (pending.unique.insert(change).second) {
+        pending.list.push_back(std::move(change));
+    }
+    if (!doc->testStatus(App::Document::Recomputing)) {
+        flushChangedObjects(*doc);
+    }
+}
+
+void DocumentObserverPython::flushChangedObjects(const App::Document& Doc)
+{
+    auto it = changes.find(&Doc);
+    if (it == changes.end()) {
+        return;
+    }
+    Changes pending = std::move(it->second);
+    changes.erase(it);
+
+    Base::PyGILStateLocker lock;
+    try {
+        Py::List list;
+        for (const auto& [name, prop] : pending.list) {
+            // objects removed in the meantime are skipped
+            if (auto obj = Doc.getObject(name.c_str())) {
+                Py::Tuple change(2);
+                change.setItem(0, Py::asObject(obj->getPyObject()));
+                change.setItem(1, Py::String(prop));
+                list.append(change);
+            }
+        }
+        if (list.length() > 0) {
+            Py::Tuple args(1);
+            args.setItem(0, list);
+            Base::pyCall(pyChangedObjects.ptr(), args.ptr());
         }
     }
     catch (Py::Exception&) {
@@ -370,6 +490,9 @@ void DocumentObserverPython::slotChangedObject(const App::DocumentObject& Obj,
 
 void DocumentObserverPython::slotRecomputedObject(const App::DocumentObject& Obj)
 {
+    if (!isObserved(Obj)) {
+        return;
+    }
     Base::PyGILStateLocker lock;
     try {
         Py::Tuple args(1);
@@ -27,7 +27,11 @@
 #include <FCGlobal.h>
 #include <boost/signals2.hpp>
 #include <CXX/Objects.hxx>
+#include <Base/Type.h>
+#include <map>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace App
@@ -43,6 +47,13 @@ class Property;
  * whenever something happens to a document, like creation, destruction, adding or
  * removing objects or when property changes.
  *
+ * An observer may restrict the events of objects to the ones it is interested in with the
+ * attributes ObservedTypes, a list of the type names of the objects, and ObservedProperties, a
+ * list of property names. The other events are dropped before the GIL is taken. An observer
+ * with the method slotChangedObjects(changes) gets the property changes made during a
+ * recompute in one call after the recompute, as a list of unique (object, property name)
+ * tuples. Changes outside of a recompute are delivered right away.
+ *
  * @author Werner Mayer
  */
 class AppExport DocumentObserverPython
@@ -77,6 +88,10 @@ private:
     void slotBeforeChangeObject(const App::DocumentObject& Obj, const App::Property& Prop);
     /** The property of an observed object has changed */
     void slotChangedObject(const App::DocumentObject& Obj, const App::Property& Prop);
+    /** The property of an observed object has changed, collected until the recompute ends */
+    void slotChangedObjects(const App::DocumentObject& Obj, const App::Property& Prop);
+    /** Delivers the collected changes of the objects of the document */
+    void flushChangedObjects(const App::Document& Doc);
     /** Undoes the last transaction of the document */
     void slotUndoDocument(const App::Document& Doc);
     /** Redoes the last undone transaction of the document */
@@ -117,10 +132,32 @@ private:
     void slotAddedDynamicExtension(const App::ExtensionContainer&, std::string extension);
 
 
+private:
+    void readFilters(const Py::Object& obj);
+    /** Whether the type of the object passes the ObservedTypes filter */
+    bool isObserved(const App::DocumentObject& Obj) const;
+    /** The name of the property if it passes the filters, or else null */
+    const char* observedPropertyName(const App::DocumentObject& Obj,
+                                     const App::Property& Prop) const;
+
 private:
     Py::Object inst;
     static std::vector<DocumentObserverPython*> _instances;
 
+    // The filters of the observer, empty to observe all objects and properties
+    std::vector<Base::Type> observedTypes;
+    std::set<std::string, std::less<>> observedProperties;
+
+    struct Changes
+    {
+        // names of the object and of the property in the order of the changes
+        std::vector<std::pair<std::string, std::string>> list;
+        std::set<std::pair<std::string, std::string>> unique;
+    };
+    std::map<const App::Document*, Changes> changes;
+    boost::signals2::scoped_connection connectChangesRecomputed;
+    boost::signals2::scoped_connection connectChangesDeleted;
+
     using Connection = struct PythonObject
     {
         boost::signals2::scoped_connection slot;
@@ -143,6 +180,7 @@ private:
     Connection pyDeletedObject;
     Connection pyBeforeChangeObject;
     Connection pyChangedObject;
+    Connection pyChangedObjects;
     Connection pyRecomputedObject;
     Connection pyBeforeRecomputeDocument;
     Connection pyRecomputedDocument;
@@ -678,18 +678,24 @@ PyObject *DocumentPy::isAutoCreated(PyObject *args)
     return Py::new_reference_to(Py::Boolean(ok));
 }
 
-PyObject* DocumentPy::recompute(PyObject* args)
+PyObject* DocumentPy::recompute(PyObject* args, PyObject* kwd)
 {
     PyObject* pyobjs = Py_None;
     PyObject* force = Py_False;
     PyObject* checkCycle = Py_False;
-    if (!PyArg_ParseTuple(args,
-                          "|OO!O!",
-                          &pyobjs,
-                          &PyBool_Type,
-                          &force,
-                          &PyBool_Type,
-                          &checkCycle)) {
+    PyObject* profile = Py_False;
+    static const std::array<const char*, 5> kwlist {"objs", "force", "checkCycle", "profile", nullptr};
+    if (!Base::Wrapped_ParseTupleAndKeywords(args,
+                                             kwd,
+                                             "|OO!O!O!",
+                                             kwlist,
+                                             &pyobjs,
+                                             &PyBool_Type,
+                                             &force,
+                                             &PyBool_Type,
+                                             &checkCycle,
+                                             &PyBool_Type,
+                                             &profile)) {
         return nullptr;
     }
 
@@ -719,8 +725,13 @@ PyObject* DocumentPy::recompute(PyObject* args)
             options = Document::DepNoCycle;
         }
 
-        int objectCount =
-            getDocumentPtr()->recompute(objs, Base::asBoolean(force), nullptr, options);
+        auto doc = getDocumentPtr();
+        bool profiling = doc->testStatus(Document::ProfileRecompute);
+        if (Base::asBoolean(profile)) {
+            doc->setStatus(Document::ProfileRecompute, true);
+        }
+        int objectCount = doc->recompute(objs, Base::asBoolean(force), nullptr, options);
+        doc->setStatus(Document::ProfileRecompute, profiling);
 
         // Document::recompute() hides possibly raised Python exceptions by its features
         // So, check if an error is set and return null if yes
@@ -733,6 +744,31 @@ PyObject* DocumentPy::recompute(PyObject* args)
     PY_CATCH;
 }
 
+PyObject* DocumentPy::getRecomputeProfile(PyObject* args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+    return Py::new_reference_to(Py::String(getDocumentPtr()->getRecomputeProfile()));
+}
+
+PyObject* DocumentPy::cancelRecompute(PyObject* args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+    getDocumentPtr()->cancelRecompute();
+    Py_Return;
+}
+
+PyObject* DocumentPy::getMemoryReport(PyObject* args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+    return Py::new_reference_to(Py::String(getDocumentPtr()->getMemoryReport()));
+}
+
 PyObject* DocumentPy::mustExecute(PyObject* args)
 {
     if (!PyArg_ParseTuple(args, "")) {
@@ -789,6 +825,45 @@ PyObject* DocumentPy::getObject(PyObject* args)
     Py_Return;
 }
 
+PyObject* DocumentPy::addObjects(PyObject* args)
+{
+    PyObject* pyTypes = nullptr;
+    PyObject* pyNames = nullptr;
+    if (!PyArg_ParseTuple(args, "OO", &pyTypes, &pyNames)) {
+        return nullptr;
+    }
+
+    auto toStrings = [](PyObject* value, const char* what) {
+        std::vector<std::string> strings;
+        if (PyUnicode_Check(value)) {
+            strings.emplace_back(PyUnicode_AsUTF8(value));
+            return strings;
+        }
+        Py::Sequence seq(value);
+        strings.reserve(seq.size());
+        for (Py::Sequence::iterator it = seq.begin(); it != seq.end(); ++it) {
+            if (!PyUnicode_Check((*it).ptr())) {
+                throw Py::TypeError(std::string(what) + " must be strings");
+            }
+            strings.push_back(Py::String(*it).as_std_string("utf-8"));
+        }
+        return strings;
+    };
+
+    std::vector<std::string> types = toStrings(pyTypes, "types");
+    std::vector<std::string> names = toStrings(pyNames, "names");
+    std::vector<DocumentObject*> objs = getDocumentPtr()->addObjects(types, names);
+    if (objs.size() != names.size()) {
+        throw Py::TypeError("Not all types can be created");
+    }
+
+    Py::List list;
+    for (auto obj : objs) {
+        list.append(Py::asObject(obj->getPyObject()));
+    }
+    return Py::new_reference_to(list);
+}
+
 PyObject* DocumentPy::getObjectsByLabel(PyObject* args)
 {
     char* sName;
@@ -797,12 +872,8 @@ PyObject* DocumentPy::getObjectsByLabel(PyObject* args)
     }
 
     Py::List list;
-    std::string name = sName;
-    std::vector<DocumentObject*> objs = getDocumentPtr()->getObjects();
-    for (auto obj : objs) {
-        if (name == obj->Label.getValue()) {
-            list.append(Py::asObject(obj->getPyObject()));
-        }
+    for (auto obj : getDocumentPtr()->getObjectsByLabel(sName)) {
+        list.append(Py::asObject(obj->getPyObject()));
     }
 
     return Py::new_reference_to(list);
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <unordered_map>
 #ifndef FC_DEBUG
 #include <random>
@@ -383,6 +384,7 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
         stream >> std::hex;
 
         indices.names.resize(outerCount);
+        this->mappedNames.reserve(this->mappedNames.size() + outerCount);
         for (int j = 0; j < outerCount; ++j) {
             idx.setIndex(j);
             auto* ref = &indices.names[j];
@@ -1075,8 +1077,9 @@ void ElementMap::collectChildMaps(std::map<const ElementMap*, int>& childMapSet,
         }
     }
 
-    for (auto& mappedName : this->mappedNames) {
-        addPostfix(mappedName.first.constPostfix(), postfixMap, postfixes);
+    // Postfix numbering ends up in the saved file, so visit the names in a stable order.
+    for (auto* mappedName : sortedMappedNames()) {
+        addPostfix(mappedName->first.constPostfix(), postfixMap, postfixes);
     }
 
     childMaps.push_back(this);
@@ -1298,12 +1301,25 @@ std::vector<ElementMap::MappedChildElements> ElementMap::getChildElements() cons
     return res;
 }
 
+std::vector<const std::pair<const MappedName, IndexedName>*> ElementMap::sortedMappedNames() const
+{
+    std::vector<const std::pair<const MappedName, IndexedName>*> res;
+    res.reserve(this->mappedNames.size());
+    for (auto& mappedName : this->mappedNames) {
+        res.push_back(&mappedName);
+    }
+    std::sort(res.begin(), res.end(), [](const auto* left, const auto* right) {
+        return left->first < right->first;
+    });
+    return res;
+}
+
 std::vector<MappedElement> ElementMap::getAll() const
 {
     std::vector<MappedElement> ret;
     ret.reserve(size());
-    for (auto& mappedName : this->mappedNames) {
-        ret.emplace_back(mappedName.first, mappedName.second);
+    for (auto* mappedName : sortedMappedNames()) {
+        ret.emplace_back(mappedName->first, mappedName->second);
     }
     for (auto& childElement : this->childElements) {
         auto& child = *childElement.childMap;
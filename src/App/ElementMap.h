@@ -32,11 +32,14 @@
 #include "MappedElement.h"
 #include "StringHasher.h"
 
+#include <cstdint>
 #include <cstring>
 #include <deque>
 #include <functional>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 
 namespace Data
@@ -303,7 +306,31 @@ private:
 
     std::map<const char*, IndexedElements, CStringComp> indexedNames;
 
-    std::map<MappedName, IndexedName, std::less<>> mappedNames;
+    /// Hash a MappedName as one continuous byte array, consistent with MappedName::operator==.
+    /// MappedName::hash() depends on how the bytes are split between data and postfix, which
+    /// compact() may change after insertion, so it cannot be used here.
+    struct MappedNameHash
+    {
+        std::size_t operator()(const MappedName& name) const
+        {
+            std::uint64_t hash = 14695981039346656037ULL;  // FNV-1a offset basis
+            auto feed = [&hash](const QByteArray& bytes) {
+                for (char byte : bytes) {
+                    hash ^= static_cast<unsigned char>(byte);
+                    hash *= 1099511628211ULL;  // FNV-1a prime
+                }
+            };
+            feed(name.dataBytes());
+            feed(name.postfixBytes());
+            return static_cast<std::size_t>(hash);
+        }
+    };
+
+    /// Unordered for cheap lookup and insertion. Use sortedMappedNames() wherever the iteration
+    /// order is observable (saving, getAll()).
+    std::unordered_map<MappedName, IndexedName, MappedNameHash> mappedNames;
+
+    std::vector<const std::pair<const MappedName, IndexedName>*> sortedMappedNames() const;
 
     struct ChildMapInfo
     {
@@ -2052,9 +2052,14 @@ Py::Object FunctionExpression::evalAggregate(
     for (auto &arg : args) {
         if (arg->isDerivedFrom<RangeExpression>()) {
             Range range(static_cast<const RangeExpression&>(*arg).getRange());
+            std::vector<Property*> props;
+            if (!owner->getOwner()->getCellProperties(range, props)) {
+                do {
+                    props.push_back(owner->getOwner()->getPropertyByName(range.address().c_str()));
+                } while (range.next());
+            }
 
-            do {
-                Property * p = owner->getOwner()->getPropertyByName(range.address().c_str());
+            for (Property *p : props) {
                 PropertyQuantity * qp;
                 PropertyFloat * fp;
                 PropertyInteger * ip;
@@ -2070,7 +2075,7 @@ Py::Object FunctionExpression::evalAggregate(
                     c->collect(Quantity(ip->getValue()));
                 else
                     _EXPR_THROW("Invalid property type for aggregate.", owner);
-            } while (range.next());
+            }
         }
         else {
             Quantity q;
@@ -3518,6 +3523,371 @@ void RangeExpression::_offsetCells(int rowOffset, int colOffset, ExpressionVisit
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////////
+
+// Incremented whenever a resolved property of an ExpressionProgram may have
+// become invalid
+static unsigned long _ProgramEpoch;
+
+static void bumpProgramEpoch()
+{
+    ++_ProgramEpoch;
+}
+
+static void initProgramEpoch()
+{
+    static bool inited;
+    if (!inited) {
+        inited = true;
+        auto &app = GetApplication();
+        app.signalNewObject.connect([](const DocumentObject &) { bumpProgramEpoch(); });
+        app.signalDeletedObject.connect([](const DocumentObject &) { bumpProgramEpoch(); });
+        app.signalRelabelObject.connect([](const DocumentObject &) { bumpProgramEpoch(); });
+        app.signalAppendDynamicProperty.connect([](const Property &) { bumpProgramEpoch(); });
+        app.signalRemoveDynamicProperty.connect([](const Property &) { bumpProgramEpoch(); });
+        app.signalRenameDynamicProperty.connect(
+            [](const Property &, const char *) { bumpProgramEpoch(); });
+        app.signalNewDocument.connect([](const Document &, bool) { bumpProgramEpoch(); });
+        app.signalDeleteDocument.connect([](const Document &) { bumpProgramEpoch(); });
+        app.signalRelabelDocument.connect([](const Document &) { bumpProgramEpoch(); });
+        app.signalRenameDocument.connect([](const Document &) { bumpProgramEpoch(); });
+    }
+}
+
+namespace {
+
+/** Value on the ExpressionProgram stack, mirroring the Python object that the
+  * generic evaluation would produce, i.e. int, float or Quantity.
+  */
+struct ProgramValue {
+    enum Kind {
+        Int,
+        Float,
+        QuantityValue,
+    };
+    Kind kind{Int};
+    long l{0};
+    double d{0.0};
+    Quantity q;
+
+    // Same as pyFromQuantity()
+    explicit ProgramValue(const Quantity &quantity = Quantity())
+    {
+        if (!quantity.isDimensionless()) {
+            kind = QuantityValue;
+            q = quantity;
+            return;
+        }
+        double v = quantity.getValue();
+        int i;
+        switch(essentiallyInteger(v,l,i)) {
+        case 1:
+        case 2:
+            kind = Int;
+            break;
+        default:
+            kind = Float;
+            d = v;
+        }
+    }
+
+    double toDouble() const {
+        return kind == Int ? static_cast<double>(l) : d;
+    }
+
+    // Same as the conversion done by the number handlers of QuantityPy
+    Quantity toQuantity() const {
+        switch(kind) {
+        case Int:
+            return Quantity(static_cast<double>(l));
+        case Float:
+            return Quantity(d);
+        default:
+            return q;
+        }
+    }
+};
+
+// Python integers are unbounded, only take shortcuts where double and long are exact
+constexpr double programIntLimit = 9007199254740992.0; // 2^53
+
+// Integer results below 2^53 are exact in double as well, so the estimate tells if it fits
+bool programIntFits(double estimate)
+{
+    return std::fabs(estimate) < programIntLimit
+        && estimate <= static_cast<double>(std::numeric_limits<long>::max())
+        && estimate >= static_cast<double>(std::numeric_limits<long>::min());
+}
+
+/** Apply \a op the same way as calc() does with Python objects
+  * @return false to fall back to the generic evaluation
+  */
+bool programCalc(int op, ProgramValue &l, const ProgramValue &r)
+{
+    if (l.kind == ProgramValue::QuantityValue || r.kind == ProgramValue::QuantityValue) {
+        Quantity ql = l.toQuantity();
+        Quantity qr = r.toQuantity();
+        switch(op) {
+        case OperatorExpression::ADD:
+            // Unit mismatch throws, the generic evaluation reports it
+            if (ql.getUnit() != qr.getUnit())
+                return false;
+            l.q = ql + qr;
+            break;
+        case OperatorExpression::SUB:
+            if (ql.getUnit() != qr.getUnit())
+                return false;
+            l.q = ql - qr;
+            break;
+        case OperatorExpression::MUL:
+        case OperatorExpression::UNIT:
+            l.q = ql * qr;
+            break;
+        case OperatorExpression::DIV:
+            l.q = ql / qr;
+            break;
+        default:
+            return false;
+        }
+        l.kind = ProgramValue::QuantityValue;
+        return true;
+    }
+
+    if (l.kind == ProgramValue::Int && r.kind == ProgramValue::Int) {
+        double a = static_cast<double>(l.l);
+        double b = static_cast<double>(r.l);
+        switch(op) {
+        case OperatorExpression::ADD:
+            if (!programIntFits(a + b))
+                return false;
+            l.l = static_cast<long>(static_cast<long long>(l.l) + r.l);
+            return true;
+        case OperatorExpression::SUB:
+            if (!programIntFits(a - b))
+                return false;
+            l.l = static_cast<long>(static_cast<long long>(l.l) - r.l);
+            return true;
+        case OperatorExpression::MUL:
+        case OperatorExpression::UNIT:
+            if (!programIntFits(a * b))
+                return false;
+            l.l = static_cast<long>(static_cast<long long>(l.l) * r.l);
+            return true;
+        case OperatorExpression::DIV:
+            // True division, raises ZeroDivisionError for zero
+            if (r.l == 0 || std::fabs(a) >= programIntLimit || std::fabs(b) >= programIntLimit)
+                return false;
+            l.kind = ProgramValue::Float;
+            l.d = a / b;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    double a = l.toDouble();
+    double b = r.toDouble();
+    switch(op) {
+    case OperatorExpression::ADD:
+        l.d = a + b;
+        break;
+    case OperatorExpression::SUB:
+        l.d = a - b;
+        break;
+    case OperatorExpression::MUL:
+    case OperatorExpression::UNIT:
+        l.d = a * b;
+        break;
+    case OperatorExpression::DIV:
+        if (b == 0.0)
+            return false;
+        l.d = a / b;
+        break;
+    default:
+        return false;
+    }
+    l.kind = ProgramValue::Float;
+    return true;
+}
+
+} // anonymous namespace
+
+struct ExpressionProgram::Instruction {
+    enum Code {
+        Push,
+        Load,
+        Negate,
+        Calc,
+    };
+    Code code;
+    ProgramValue value;                     /**< Constant for Push */
+    const App::Property *prop{nullptr};     /**< Resolved property for Load */
+    int op{OperatorExpression::NONE};       /**< Operator for Calc */
+};
+
+ExpressionProgram::ExpressionProgram(const Expression *expr)
+    : epoch(getEpoch())
+{
+    if (!compile(expr, 1)) {
+        code.clear();
+        stackSize = 0;
+    }
+}
+
+ExpressionProgram::~ExpressionProgram() = default;
+
+bool ExpressionProgram::isUpToDate() const
+{
+    return epoch == _ProgramEpoch;
+}
+
+unsigned long ExpressionProgram::getEpoch()
+{
+    initProgramEpoch();
+    return _ProgramEpoch;
+}
+
+bool ExpressionProgram::compile(const Expression *expr, std::size_t depth)
+{
+    if (!expr || expr->hasComponent())
+        return false;
+    stackSize = std::max(stackSize, depth);
+
+    Base::Type type = expr->getTypeId();
+    if (type == ConstantExpression::getClassTypeId()) {
+        // None, True and False are not numbers in Python
+        auto name = static_cast<const ConstantExpression*>(expr)->getName();
+        if (name == "None" || name == "True" || name == "False")
+            return false;
+        type = NumberExpression::getClassTypeId();
+    }
+
+    if (type == NumberExpression::getClassTypeId() || type == UnitExpression::getClassTypeId()) {
+        auto &instr = code.emplace_back();
+        instr.code = Instruction::Push;
+        instr.value = ProgramValue(static_cast<const UnitExpression*>(expr)->getQuantity());
+        return true;
+    }
+
+    if (type == VariableExpression::getClassTypeId()) {
+        ObjectIdentifier path = static_cast<const VariableExpression*>(expr)->getPath();
+        int ptype = 0;
+        Property *prop = path.getProperty(&ptype);
+        // Only a plain property, no pseudo property or sub path like Placement.Base.x
+        if (!prop || ptype != 0 || !path.verify(*prop, true))
+            return false;
+        if (!prop->isDerivedFrom<PropertyInteger>() && !prop->isDerivedFrom<PropertyFloat>())
+            return false;
+        auto &instr = code.emplace_back();
+        instr.code = Instruction::Load;
+        instr.prop = prop;
+        return true;
+    }
+
+    if (type == OperatorExpression::getClassTypeId()) {
+        auto opExpr = static_cast<const OperatorExpression*>(expr);
+        int op = opExpr->getOperator();
+        switch(op) {
+        case OperatorExpression::NEG:
+        case OperatorExpression::POS:
+            if (!compile(opExpr->getLeft(), depth))
+                return false;
+            if (op == OperatorExpression::NEG) {
+                auto &instr = code.emplace_back();
+                instr.code = Instruction::Negate;
+            }
+            return true;
+        case OperatorExpression::ADD:
+        case OperatorExpression::SUB:
+        case OperatorExpression::MUL:
+        case OperatorExpression::DIV:
+        case OperatorExpression::UNIT: {
+            if (!compile(opExpr->getLeft(), depth)
+                    || !compile(opExpr->getRight(), depth + 1))
+                return false;
+            auto &instr = code.emplace_back();
+            instr.code = Instruction::Calc;
+            instr.op = op;
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    return false;
+}
+
+bool ExpressionProgram::eval(App::any &value) const
+{
+    if (code.empty())
+        return false;
+
+    std::vector<ProgramValue> stack;
+    stack.reserve(stackSize);
+    for (const auto &instr : code) {
+        switch(instr.code) {
+        case Instruction::Push:
+            stack.push_back(instr.value);
+            break;
+        case Instruction::Load: {
+            auto &v = stack.emplace_back();
+            if (auto propQuantity = freecad_cast<PropertyQuantity*>(instr.prop)) {
+                v.kind = ProgramValue::QuantityValue;
+                v.q = propQuantity->getQuantityValue();
+            }
+            else if (auto propFloat = freecad_cast<PropertyFloat*>(instr.prop)) {
+                v.kind = ProgramValue::Float;
+                v.d = propFloat->getValue();
+            }
+            else {
+                v.kind = ProgramValue::Int;
+                v.l = static_cast<const PropertyInteger*>(instr.prop)->getValue();
+            }
+            break;
+        }
+        case Instruction::Negate: {
+            auto &v = stack.back();
+            switch(v.kind) {
+            case ProgramValue::Int:
+                if (v.l == std::numeric_limits<long>::min())
+                    return false;
+                v.l = -v.l;
+                break;
+            case ProgramValue::Float:
+                v.d = -v.d;
+                break;
+            default:
+                // Same as QuantityPy::number_negative_handler()
+                v.q = v.q * -1.0;
+            }
+            break;
+        }
+        case Instruction::Calc: {
+            ProgramValue r = std::move(stack.back());
+            stack.pop_back();
+            if (!programCalc(instr.op, stack.back(), r))
+                return false;
+            break;
+        }
+        }
+    }
+
+    assert(stack.size() == 1);
+    const auto &res = stack.back();
+    switch(res.kind) {
+    case ProgramValue::Int:
+        value = res.l;
+        break;
+    case ProgramValue::Float:
+        value = res.d;
+        break;
+    default:
+        value = res.q;
+    }
+    return true;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////
 
@@ -227,6 +227,47 @@ public:
     // clang-format on
 };
 
+/**
+  * @brief Flat, pre-resolved form of a numeric expression.
+  *
+  * @details Expressions made of numbers, units, the arithmetic operators and
+  * references to integer, float or quantity properties are lowered into a
+  * postfix instruction list, with the referenced properties resolved once.
+  * Evaluating it avoids the path resolution and the Python objects of
+  * Expression::getValueAsAny() and gives the same result.
+  *
+  * The resolved properties are invalidated by any object or dynamic property
+  * being added, removed or renamed, see isUpToDate(). Modifying the expression
+  * itself requires compiling a new program.
+  */
+class AppExport ExpressionProgram {
+public:
+    explicit ExpressionProgram(const Expression *expr);
+    ~ExpressionProgram();
+
+    /// Returns true if the resolved properties are still valid
+    bool isUpToDate() const;
+
+    /// Counter incremented whenever what an expression resolves to may have changed
+    static unsigned long getEpoch();
+
+    /** Evaluate the program
+      * @param value: receives the result, same as Expression::getValueAsAny()
+      * @return false if the expression could not be compiled, or the result
+      * requires the generic evaluation, e.g. to report an error.
+      */
+    bool eval(App::any &value) const;
+
+private:
+    /// Append the instructions of \a expr, returns false if it contains anything unsupported
+    bool compile(const Expression *expr, std::size_t depth);
+
+    struct Instruction;
+    std::vector<Instruction> code;
+    std::size_t stackSize{0};
+    unsigned long epoch;
+};
+
 }
 
 #endif // EXPRESSION_H
@@ -30,6 +30,27 @@
 
 using namespace App;
 
+namespace
+{
+// Whether the type or one of its bases has the attribute, without raising an AttributeError
+// as a failed PyObject_GenericGetAttr() does
+bool hasTypeAttribute(PyTypeObject* tp, PyObject* name)
+{
+    PyObject* mro = tp->tp_mro;
+    if (!mro || !PyTuple_Check(mro)) {
+        return true;
+    }
+    for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(mro); ++i) {
+        auto base = reinterpret_cast<PyTypeObject*>(PyTuple_GET_ITEM(mro, i));
+        if (base->tp_dict && PyDict_GetItemWithError(base->tp_dict, name)) {
+            return true;
+        }
+    }
+    PyErr_Clear();
+    return false;
+}
+}  // namespace
+
 // returns a string which represent the object e.g. when printed in python
 std::string ExtensionContainerPy::representation() const
 {
@@ -143,13 +164,21 @@ PyObject* ExtensionContainerPy::getCustomAttributes(const char* attr) const
     // be called for the correct instance.
     PyObject* func = nullptr;
     ExtensionContainer::ExtensionIterator it = this->getExtensionContainerPtr()->extensionBegin();
+    if (it == this->getExtensionContainerPtr()->extensionEnd()) {
+        return nullptr;
+    }
+    // Most attributes are properties of the container, so the types of the extensions are
+    // checked first instead of failing in PyObject_GenericGetAttr() for each extension.
+    Py::String nameobj(attr);
     for (; it != this->getExtensionContainerPtr()->extensionEnd(); ++it) {
         // The PyTypeObject is shared by all instances of this type and therefore
         // we have to add new methods only once.
         PyObject* obj = (*it).second->getExtensionPyObject();
-        PyObject* nameobj = PyUnicode_FromString(attr);
-        func = PyObject_GenericGetAttr(obj, nameobj);
-        Py_DECREF(nameobj);
+        if (!hasTypeAttribute(Py_TYPE(obj), nameobj.ptr())) {
+            Py_DECREF(obj);
+            continue;
+        }
+        func = PyObject_GenericGetAttr(obj, nameobj.ptr());
         Py_DECREF(obj);
         if (func && PyCFunction_Check(func)) {
             PyCFunctionObject* cfunc = reinterpret_cast<PyCFunctionObject*>(func);
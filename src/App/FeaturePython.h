@@ -196,6 +196,11 @@ public:
         }
         return imp->mustExecute() ? 1 : 0;
     }
+    /// Python code must not run on a recompute worker thread
+    bool canRecomputeConcurrently() const override
+    {
+        return false;
+    }
     /// recalculate the Feature
     DocumentObjectExecReturn* execute() override
     {
@@ -386,3 +386,15 @@ Base::Placement GeoFeature::getGlobalPlacement(const DocumentObject* obj)
     return placementProperty->getValue();
 }
 
+std::vector<Base::Placement>
+GeoFeature::getGlobalPlacements(const std::vector<DocumentObject*>& objs)
+{
+    // the placements of the groups are computed once for all objects in them
+    std::vector<Base::Placement> placements;
+    placements.reserve(objs.size());
+    for (auto obj : objs) {
+        placements.push_back(obj ? getGlobalPlacement(obj) : Base::Placement());
+    }
+    return placements;
+}
+
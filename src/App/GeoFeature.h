@@ -199,6 +199,9 @@ public:
     getGlobalPlacement(DocumentObject* targetObj, DocumentObject* rootObj, const std::string& sub);
     static Base::Placement getGlobalPlacement(DocumentObject* targetObj, PropertyXLinkSub* prop);
     static Base::Placement getGlobalPlacement(const DocumentObject* obj);
+    /// The global placements of many objects, see getGlobalPlacement(const DocumentObject*)
+    static std::vector<Base::Placement>
+    getGlobalPlacements(const std::vector<DocumentObject*>& objs);
 
 protected:
     void onChanged(const Property* prop) override;
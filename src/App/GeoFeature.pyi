@@ -1,6 +1,6 @@
 from DocumentObject import DocumentObject
 from Base import Placement
-from typing import Any, Final, Optional
+from typing import Any, Final, List, Optional, Sequence
 
 
 class GeoFeature(DocumentObject):
@@ -55,6 +55,16 @@ class GeoFeature(DocumentObject):
         """
         ...
 
+    @staticmethod
+    def getGlobalPlacements(objects: Sequence[Any]) -> List[Placement]:
+        """
+        getGlobalPlacements(objects) -> list of Base.Placement
+
+        Returns the global placements of the objects as getGlobalPlacement() does, but the
+        placements of their groups are computed only once.
+        """
+        ...
+
     def getPropertyNameOfGeometry(self) -> Optional[str]:
         """
         getPropertyNameOfGeometry() -> str or None
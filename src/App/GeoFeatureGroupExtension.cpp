@@ -21,6 +21,9 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <mutex>
+#include <unordered_map>
+
 #include <App/Document.h>
 #include <Base/Tools.h>
 
@@ -108,6 +111,59 @@ DocumentObject* GeoFeatureGroupExtension::getGroupOfObject(const DocumentObject*
     return nullptr;
 }
 
+namespace
+{
+// The global placements of the groups, which are shared by all objects in a group and by all
+// nested groups. Any change of an object or of the dependencies, like a Placement or the
+// membership of a group, drops the whole cache.
+class GroupPlacementCache
+{
+public:
+    static GroupPlacementCache& instance()
+    {
+        static GroupPlacementCache cache;
+        return cache;
+    }
+
+    bool get(const GeoFeatureGroupExtension* group, Base::Placement& placement)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        validate();
+        auto it = placements.find(group);
+        if (it == placements.end()) {
+            return false;
+        }
+        placement = it->second;
+        return true;
+    }
+
+    void set(const GeoFeatureGroupExtension* group, const Base::Placement& placement)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        validate();
+        placements[group] = placement;
+    }
+
+private:
+    // the caller holds the mutex
+    void validate()
+    {
+        auto changes = DocumentObject::getChangeGeneration();
+        auto dependencies = DocumentObject::getDependencyGeneration();
+        if (changes != changeGeneration || dependencies != dependencyGeneration) {
+            placements.clear();
+            changeGeneration = changes;
+            dependencyGeneration = dependencies;
+        }
+    }
+
+    std::mutex mutex;
+    std::unordered_map<const GeoFeatureGroupExtension*, Base::Placement> placements;
+    std::size_t changeGeneration {0};
+    std::size_t dependencyGeneration {0};
+};
+}  // namespace
+
 Base::Placement GeoFeatureGroupExtension::globalGroupPlacement()
 {
     if (getExtendedObject()->isRecomputing()) {
@@ -124,8 +180,15 @@ Base::Placement GeoFeatureGroupExtension::recursiveGroupPlacement(
     GeoFeatureGroupExtension* group,
     std::unordered_set<GeoFeatureGroupExtension*>& history)
 {
-    history.insert(this);
+    history.insert(group);
+
+    auto& cache = GroupPlacementCache::instance();
+    Base::Placement placement;
+    if (cache.get(group, placement)) {
+        return placement;
+    }
 
+    placement = group->placement().getValue();
     auto inList = group->getExtendedObject()->getInList();
     for (auto* link : inList) {
         auto parent = link->getExtensionByType<GeoFeatureGroupExtension>(true);
@@ -134,11 +197,13 @@ Base::Placement GeoFeatureGroupExtension::recursiveGroupPlacement(
             if (history.contains(parent)) {
                 break;
             }
-            return recursiveGroupPlacement(parent, history) * group->placement().getValue();
+            placement = recursiveGroupPlacement(parent, history) * placement;
+            break;
         }
     }
 
-    return group->placement().getValue();
+    cache.set(group, placement);
+    return placement;
 }
 
 std::vector<DocumentObject*>
@@ -78,6 +78,41 @@ PyObject* GeoFeaturePy::getGlobalPlacementOf(PyObject* args)
     }
 }
 
+PyObject* GeoFeaturePy::getGlobalPlacements(PyObject* args)
+{
+    PyObject* pyObjs {nullptr};
+    if (!PyArg_ParseTuple(args, "O", &pyObjs)) {
+        return nullptr;
+    }
+
+    if (!PySequence_Check(pyObjs)) {
+        PyErr_SetString(PyExc_TypeError, "Expect a sequence of document objects");
+        return nullptr;
+    }
+
+    std::vector<DocumentObject*> objs;
+    Py::Sequence seq(pyObjs);
+    for (Py_ssize_t i = 0; i < seq.size(); ++i) {
+        if (!PyObject_TypeCheck(seq[i].ptr(), &DocumentObjectPy::Type)) {
+            PyErr_SetString(PyExc_TypeError,
+                            "Expect element in sequence to be of type document object");
+            return nullptr;
+        }
+        objs.push_back(static_cast<DocumentObjectPy*>(seq[i].ptr())->getDocumentObjectPtr());
+    }
+
+    try {
+        Py::List list;
+        for (const auto& p : GeoFeature::getGlobalPlacements(objs)) {
+            list.append(Py::asObject(new Base::PlacementPy(new Base::Placement(p))));
+        }
+        return Py::new_reference_to(list);
+    }
+    catch (const Base::Exception& e) {
+        throw Py::RuntimeError(e.what());
+    }
+}
+
 PyObject* GeoFeaturePy::getPropertyNameOfGeometry(PyObject* args)
 {
     if (!PyArg_ParseTuple(args, "")) {
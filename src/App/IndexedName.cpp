@@ -24,7 +24,11 @@
 
 // NOLINTNEXTLINE
 
+#include <array>
+#include <charconv>
 #include <cstdlib>
+#include <cstring>
+#include <string_view>
 #include <unordered_set>
 
 #include "IndexedName.h"
@@ -65,6 +69,33 @@ std::pair<int, int> getIntegerSuffix(const char* name, int nameLength)
     return std::make_pair(suffix, suffixPosition);
 }
 
+/// The element types of nearly all names. Their storage is shared by all names of that type,
+/// so they are neither looked up nor inserted in the storage of the other names.
+constexpr std::array<std::string_view, 6> commonTypes {
+    "Edge", "Face", "Wire", "Shell", "Solid", "Vertex"};
+
+/// The common type of the first \a length characters of \a name, or nullptr
+inline const char* getCommonType(const char* name, int length)
+{
+    // The length and one letter pick the only candidate, which is then compared in one go
+    std::size_t candidate {};
+    switch (length) {
+        case 4:
+            candidate = name[0] == 'E' ? 0 : (name[0] == 'F' ? 1 : 2);
+            break;
+        case 5:
+            candidate = name[1] == 'h' ? 3 : 4;
+            break;
+        case 6:
+            candidate = 5;
+            break;
+        default:
+            return nullptr;
+    }
+    const std::string_view& type = commonTypes[candidate];
+    return std::memcmp(name, type.data(), length) == 0 ? type.data() : nullptr;
+}
+
 void IndexedName::set(const char* name,
                       int length,
                       const std::vector<const char*>& allowedNames,
@@ -76,20 +107,30 @@ void IndexedName::set(const char* name,
     if (length < 0) {
         length = static_cast<int>(std::strlen(name));
     }
-    // Name typically ends with an integer: find that integer
-    auto [suffix, suffixPosition] = getIntegerSuffix(name, length);
-    if (suffixPosition < length) {
-        this->index = suffix;
-    }
-
-    // Make sure that every character is either an ASCII letter (upper or lowercase), or an
-    // underscore. If any other character appears, reject the entire string.
+    // Names are letters followed by an optional integer, which is parsed in one pass.
     // When we support C++20 we can use std::span<> to eliminate the clang-tidy warning
-    // NOLINTNEXTLINE cppcoreguidelines-pro-bounds-pointer-arithmetic
-    if (std::any_of(name, name + suffixPosition, isInvalidChar)) {
+    // NOLINTBEGIN cppcoreguidelines-pro-bounds-pointer-arithmetic
+    int suffixPosition {0};
+    while (suffixPosition < length && !isInvalidChar(name[suffixPosition])) {
+        ++suffixPosition;
+    }
+    int end {suffixPosition};
+    while (end < length && name[end] >= '0' && name[end] <= '9') {
+        ++end;
+    }
+    if (end < length) {
+        // Any other character rejects the type, but a trailing integer is still the index
+        auto [suffix, position] = getIntegerSuffix(name, length);
+        if (position < length) {
+            this->index = suffix;
+        }
         this->type = "";
         return;
     }
+    if (suffixPosition < length) {
+        std::from_chars(name + suffixPosition, name + length, this->index);
+    }
+    // NOLINTEND cppcoreguidelines-pro-bounds-pointer-arithmetic
 
     // If a list of allowedNames was provided, see if our set name matches one of those
     // allowedNames: if it does, reference that memory location and return.
@@ -103,6 +144,10 @@ void IndexedName::set(const char* name,
     // If the type was NOT in the list of allowedNames, but the caller has set the allowOthers flag
     // to true, then add the new type to the static NameSet (if it is not already there).
     if (allowOthers) {
+        if (const char* commonType = getCommonType(name, suffixPosition)) {
+            this->type = commonType;
+            return;
+        }
         auto res = NameSet.insert(ByteArray(QByteArray::fromRawData(name, suffixPosition)));
         if (res.second /*The insert succeeded (the type was new)*/) {
             // Make sure that the data in the set is a unique (unshared) copy of the text
@@ -74,6 +74,7 @@ public:
         funcs;
 
     bool CopyOnChangeApplyToAll;  // Auto generated code. See class document of LinkParams.
+    long MaxShownElements;        // Auto generated code. See class document of LinkParams.
 
     // Auto generated code. See class document of LinkParams.
     LinkParamsP()
@@ -84,6 +85,8 @@ public:
 
         CopyOnChangeApplyToAll = handle->GetBool("CopyOnChangeApplyToAll", true);
         funcs["CopyOnChangeApplyToAll"] = &LinkParamsP::updateCopyOnChangeApplyToAll;
+        MaxShownElements = handle->GetInt("MaxShownElements", 1000);
+        funcs["MaxShownElements"] = &LinkParamsP::updateMaxShownElements;
     }
 
     // Auto generated code. See class document of LinkParams.
@@ -108,6 +111,11 @@ public:
     {
         self->CopyOnChangeApplyToAll = self->handle->GetBool("CopyOnChangeApplyToAll", true);
     }
+    // Auto generated code. See class document of LinkParams.
+    static void updateMaxShownElements(LinkParamsP* self)
+    {
+        self->MaxShownElements = self->handle->GetInt("MaxShownElements", 1000);
+    }
 };
 
 // Auto generated code. See class document of LinkParams.
@@ -159,6 +167,41 @@ void LinkParams::removeCopyOnChangeApplyToAll()
 {
     instance()->handle->RemoveBool("CopyOnChangeApplyToAll");
 }
+
+// Auto generated code. See class document of LinkParams.
+const char* LinkParams::docMaxShownElements()
+{
+    return QT_TRANSLATE_NOOP(
+        "LinkParams",
+        "The largest element count of a link array that shows its elements as objects.\n"
+        "A larger array keeps its elements in its own lists, like with ShowElement off");
+}
+
+// Auto generated code. See class document of LinkParams.
+const long& LinkParams::getMaxShownElements()
+{
+    return instance()->MaxShownElements;
+}
+
+// Auto generated code. See class document of LinkParams.
+const long& LinkParams::defaultMaxShownElements()
+{
+    static const long def = 1000;
+    return def;
+}
+
+// Auto generated code. See class document of LinkParams.
+void LinkParams::setMaxShownElements(const long& v)
+{
+    instance()->handle->SetInt("MaxShownElements", v);
+    instance()->MaxShownElements = v;
+}
+
+// Auto generated code. See class document of LinkParams.
+void LinkParams::removeMaxShownElements()
+{
+    instance()->handle->RemoveInt("MaxShownElements");
+}
 //[[[end]]]
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1937,6 +1980,17 @@ void LinkBaseExtension::update(App::DocumentObject* parent, const Property* prop
             }
         }
 
+        // a large array keeps its elements in the lists instead of as document objects, the
+        // elements are still reached by their index as sub-objects
+        auto propShowElement = _getShowElementProperty();
+        long maxShown = LinkParams::getMaxShownElements();
+        if (propShowElement && propShowElement->getValue() && maxShown >= 0
+            && elementCount > static_cast<size_t>(maxShown)) {
+            FC_WARN(parent->getFullName() << " has more than " << maxShown
+                                          << " elements, turning off ShowElement");
+            propShowElement->setValue(false);
+        }
+
         if (!_getShowElementValue()) {
             if (getScaleListProperty()) {
                 auto scales = getScaleListValue();
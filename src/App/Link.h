@@ -814,6 +814,19 @@ public:
     static const char* docCopyOnChangeApplyToAll();
     //@}
 
+    // Auto generated code. See class document of LinkParams.
+    //@{
+    /// Accessor for parameter MaxShownElements
+    ///
+    /// The largest element count of a link array that shows its elements as objects.
+    /// A larger array keeps its elements in its own lists, like with ShowElement off
+    static const long& getMaxShownElements();
+    static const long& defaultMaxShownElements();
+    static void removeMaxShownElements();
+    static void setMaxShownElements(const long& v);
+    static const char* docMaxShownElements();
+    //@}
+
     // Auto generated code. See class document of LinkParams.
 };
 }  // namespace App
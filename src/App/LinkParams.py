@@ -24,6 +24,13 @@ Params = [
 Stores the last user choice of whether to apply CopyOnChange setup to all link
 that links to the same configurable object""",
     ),
+    ParamInt(
+        "MaxShownElements",
+        1000,
+        """\
+The largest element count of a link array that shows its elements as objects.
+A larger array keeps its elements in its own lists, like with ShowElement off""",
+    ),
 ]
 
 
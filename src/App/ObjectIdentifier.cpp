@@ -804,17 +804,15 @@ App::DocumentObject* ObjectIdentifier::getDocumentObject(const App::Document* do
         }
     }
 
-    std::vector<DocumentObject*> docObjects = doc->getObjects();
-    for (auto docObject : docObjects) {
-        if (strcmp(docObject->Label.getValue(), static_cast<const char*>(name)) == 0) {
-            // Found object with matching label
-            if (objectByLabel) {
-                FC_WARN("duplicate object label " << doc->getName() << '#'
-                                                  << static_cast<const char*>(name));
-                return nullptr;
-            }
-            objectByLabel = docObject;
-        }
+    std::vector<DocumentObject*> docObjects = doc->getObjectsByLabel(name.getString());
+    if (docObjects.size() > 1) {
+        FC_WARN("duplicate object label " << doc->getName() << '#'
+                                          << static_cast<const char*>(name));
+        return nullptr;
+    }
+    if (!docObjects.empty()) {
+        // Found object with matching label
+        objectByLabel = docObjects.front();
     }
 
     if (!objectByLabel && !objectById) {  // Not found at all
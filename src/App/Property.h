@@ -29,7 +29,9 @@
 #include <boost/any.hpp>
 #include <boost/signals2.hpp>
 #include <bitset>
+#include <memory>
 #include <string>
+#include <vector>
 #include <FCGlobal.h>
 
 #include "ElementNamingUtils.h"
@@ -43,6 +45,29 @@ namespace App
 
 class PropertyContainer;
 class ObjectIdentifier;
+class Property;
+
+/**
+ * @brief Undo record holding only the changed part of a property value.
+ *
+ * @see Property::getChanges()
+ */
+class PropertyChanges
+{
+public:
+    virtual ~PropertyChanges() = default;
+
+    /**
+     * @brief Bring a property back to the recorded value.
+     *
+     * @param[in,out] prop The property the record was made from, holding the
+     * value it had when the record was made.
+     */
+    virtual void restore(Property& prop) const = 0;
+
+    /// Approximate memory used by the record in bytes
+    virtual unsigned int getMemSize() const = 0;
+};
 
 /**
  * @brief %Base class of all properties.
@@ -108,6 +133,9 @@ public:
         CopyOnChange = 16,
         /// Whether the property editor should create a button for user defined editing.
         UserEdit = 17,
+        /// Set by a property while signaling a change that assigned a value
+        /// identical to the previous one.
+        SameValue = 18,
 
         // The following bits are corresponding to PropertyType set when the
         // property added. These types are meant to be static, and cannot be
@@ -478,6 +506,21 @@ public:
      */
     virtual void Paste(const Property& from) = 0;
 
+    /**
+     * @brief Get an undo record of the changes made since a copy.
+     *
+     * Transactions use it to replace the full Copy() taken before a change
+     * with a smaller record once the change is done.
+     *
+     * @param[in] saved A Copy() of this property taken before it was changed.
+     * @return A record that restores the value of @p saved into this property,
+     * or nullptr if keeping @p saved is cheaper.
+     */
+    virtual std::unique_ptr<PropertyChanges> getChanges([[maybe_unused]] const Property& saved) const
+    {
+        return {};
+    }
+
     /**
      * @brief Callback for when a child property has changed value.
      *
@@ -1070,6 +1113,38 @@ public:
      * @param[in] value  The new element value.
      * @throw Base::RuntimeError if @p index is out of bounds (< -1 or > size).
      */
+    /**
+     * @brief Get an undo record of the elements changed since a copy.
+     *
+     * Only the indices and previous values of the changed elements are
+     * recorded, unless more than half of the list has changed.
+     *
+     * @param[in] saved A Copy() of this property taken before it was changed.
+     * @return The record, or nullptr if keeping @p saved is cheaper.
+     */
+    std::unique_ptr<PropertyChanges> getChanges(const Property& saved) const override
+    {
+        if (saved.getTypeId() != this->getTypeId()) {
+            return {};
+        }
+        const auto& oldValues = static_cast<const PropertyListsT&>(saved)._lValueList;
+        int oldSize = static_cast<int>(oldValues.size());
+        int newSize = getSize();
+        auto changes = std::make_unique<ListChanges>();
+        changes->size = oldSize;
+        for (int i = 0; i < oldSize; ++i) {
+            if (i < newSize && oldValues[i] == _lValueList[i]) {
+                continue;
+            }
+            if (static_cast<int>(changes->indices.size() + 1) * 2 > oldSize) {
+                return {};
+            }
+            changes->indices.push_back(i);
+            changes->values.push_back(oldValues[i]);
+        }
+        return changes;
+    }
+
     virtual void set1Value(int index, const_reference value)
     {
         int size = getSize();
@@ -1122,6 +1197,31 @@ protected:
 
 protected:
     ListT _lValueList;
+
+private:
+    /// Undo record of the elements changed in a list, see getChanges()
+    struct ListChanges: PropertyChanges
+    {
+        int size {0};
+        std::vector<int> indices;
+        ListT values;
+
+        void restore(Property& prop) const override
+        {
+            auto& list = static_cast<PropertyListsT&>(prop);
+            ListT restored = list.getValues();
+            restored.resize(size);
+            for (std::size_t i = 0; i < indices.size(); ++i) {
+                restored[indices[i]] = values[i];
+            }
+            list.setValues(restored);
+        }
+
+        unsigned int getMemSize() const override
+        {
+            return static_cast<unsigned int>(indices.size() * (sizeof(int) + sizeof(T)));
+        }
+    };
 };
 
 }  // namespace App
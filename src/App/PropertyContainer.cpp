@@ -265,10 +265,28 @@ void PropertyContainer::Save (Base::Writer &writer) const
         auto status = it.second->getStatus();
         if(status)
             writer.Stream() << "\" status=\"" << status;
+
+        bool transient = it.second->testStatus(Property::Transient)
+                || it.second->getType() & Prop_Transient;
+
+        // Save into the compact binary data if possible, otherwise fall back to XML
+        if (!transient && writer.hasBinaryData() && it.second->canSaveBinary(writer)) {
+            try {
+                auto index = writer.saveBinary(it.second);
+                writer.Stream() << "\" binary=\"" << index << "\"></Property>" << std::endl;
+                writer.decInd();
+                continue;
+            }
+            catch (const Base::Exception &e) {
+                Base::Console().error("%s\n", e.what());
+            }
+            catch (const std::exception &e) {
+                Base::Console().error("%s\n", e.what());
+            }
+        }
         writer.Stream() << "\">";
 
-        if(it.second->testStatus(Property::Transient)
-                || it.second->getType() & Prop_Transient)
+        if(transient)
         {
             writer.decInd();
             writer.Stream() << "</Property>" << std::endl;
@@ -330,6 +348,8 @@ void PropertyContainer::Restore(Base::XMLReader &reader)
         reader.readElement("Property");
         std::string PropName = reader.getAttribute<const char*>("name");
         std::string TypeName = reader.getAttribute<const char*>("type");
+        // index of the record in the compact binary data, see Save()
+        long binary = reader.getAttribute<long>("binary", -1);
         // NOTE: We must also check the type of the current property because a
         // subclass of PropertyContainer might change the type of a property but
         // not its name. In this case we would force to read-in a wrong property
@@ -354,10 +374,17 @@ void PropertyContainer::Restore(Base::XMLReader &reader)
                         && !prop->testStatus(Property::PropTransient))
                 {
                     FC_TRACE("restore property '" << prop->getName() << "'");
-                    prop->Restore(reader);
+                    if (binary >= 0)
+                        reader.addBinary(static_cast<unsigned int>(binary), prop);
+                    else
+                        prop->Restore(reader);
                 }else
                     FC_TRACE("skip transient '" << prop->getName() << "'");
             }
+            // the binary data can only be restored by the same type
+            else if (binary >= 0) {
+                FC_WARN("skip binary data of property '" << PropName << "' of type " << TypeName);
+            }
             // name matches but not the type
             else if (prop) {
                 handleChangedPropertyType(reader, TypeName.c_str(), prop);
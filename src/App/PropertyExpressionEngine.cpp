@@ -21,11 +21,14 @@
  ***************************************************************************/
 
 
+#include <algorithm>
+
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObject.h>
 #include <App/DocumentObserver.h>
 #include <Base/Reader.h>
+#include <Base/Stream.h>
 #include <Base/Tools.h>
 #include <Base/Writer.h>
 #include <CXX/Objects.hxx>
@@ -91,6 +94,15 @@ struct PropertyExpressionEngine::Private
     // defined in header, hence the private structure here.
     std::vector<boost::signals2::scoped_connection> conns;
     std::unordered_map<std::string, std::vector<ObjectIdentifier>> propMap;
+
+    // Bindings to mark dirty on change of an input property, see trackInputs().
+    // An empty property name stands for any property of the object.
+    std::vector<boost::signals2::scoped_connection> inputConns;
+    std::unordered_map<App::DocumentObject*,
+                       std::unordered_map<std::string, std::vector<ObjectIdentifier>>>
+        inputMap;
+    bool inputsValid = false;
+    unsigned long inputsEpoch = 0;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -143,6 +155,15 @@ Property* PropertyExpressionEngine::Copy() const
 
 void PropertyExpressionEngine::hasSetValue()
 {
+    // The expressions may have been modified in place
+    for (auto& e : expressions) {
+        e.second.program.reset();
+        e.second.dirty = true;
+    }
+    if (pimpl) {
+        pimpl->inputsValid = false;
+    }
+
     App::DocumentObject* owner = dynamic_cast<App::DocumentObject*>(getContainer());
     if (!owner || !owner->isAttachedToDocument() || owner->isRestoring()
         || testFlag(LinkDetached)) {
@@ -270,6 +291,80 @@ void PropertyExpressionEngine::updateHiddenReference(const std::string& key)
     }
 }
 
+/**
+ * @brief Track the inputs of the bindings to only evaluate those with a changed input.
+ *
+ * The inputs are the properties that the expressions depend on, plus the bound
+ * property itself, so that a binding still overrides any value set directly.
+ *
+ * @return false if tracking is not possible, i.e. all bindings must be evaluated.
+ */
+bool PropertyExpressionEngine::trackInputs()
+{
+    auto owner = freecad_cast<DocumentObject*>(getContainer());
+    if (!owner || !owner->isAttachedToDocument() || owner->isRestoring()
+        || testFlag(LinkDetached)) {
+        return false;
+    }
+    if (!pimpl) {
+        pimpl = std::make_unique<Private>();
+    }
+    // Any object or property added, removed or renamed may change what the
+    // expressions resolve to
+    if (pimpl->inputsValid && pimpl->inputsEpoch == ExpressionProgram::getEpoch()) {
+        return true;
+    }
+
+    pimpl->inputConns.clear();
+    pimpl->inputMap.clear();
+    for (auto& e : expressions) {
+        e.second.dirty = true;
+        if (!e.second.expression) {
+            continue;
+        }
+        pimpl->inputMap[owner][e.first.getPropertyName()].push_back(e.first);
+        for (auto& [obj, props] : e.second.expression->getDeps(Expression::DepAll)) {
+            auto& objInputs = pimpl->inputMap[obj];
+            for (auto& prop : props) {
+                objInputs[prop.first].push_back(e.first);
+            }
+        }
+    }
+    for (auto& v : pimpl->inputMap) {
+        // NOLINTBEGIN
+        pimpl->inputConns.emplace_back(v.first->signalChanged.connect(
+            std::bind(&PropertyExpressionEngine::slotInputChanged, this, sp::_1, sp::_2)));
+        // NOLINTEND
+    }
+    pimpl->inputsValid = true;
+    pimpl->inputsEpoch = ExpressionProgram::getEpoch();
+    return true;
+}
+
+void PropertyExpressionEngine::slotInputChanged(const App::DocumentObject& obj,
+                                                const App::Property& prop)
+{
+    auto it = pimpl->inputMap.find(const_cast<App::DocumentObject*>(&obj));
+    if (it == pimpl->inputMap.end()) {
+        return;
+    }
+    for (const char* name : {prop.getName(), ""}) {
+        if (!name) {
+            continue;
+        }
+        auto itProp = it->second.find(name);
+        if (itProp == it->second.end()) {
+            continue;
+        }
+        for (auto& path : itProp->second) {
+            auto itExpr = expressions.find(path);
+            if (itExpr != expressions.end()) {
+                itExpr->second.dirty = true;
+            }
+        }
+    }
+}
+
 void PropertyExpressionEngine::slotChangedObject(const App::DocumentObject& obj,
                                                  const App::Property&)
 {
@@ -358,6 +453,45 @@ void PropertyExpressionEngine::Restore(Base::XMLReader& reader)
     reader.readEndElement("ExpressionEngine");
 }
 
+bool PropertyExpressionEngine::canSaveBinary(const Base::Writer& /*writer*/) const
+{
+    // External links are still saved as XML
+    return PropertyExpressionContainer::_XLinks.empty();
+}
+
+void PropertyExpressionEngine::saveBinary(Base::Writer& /*writer*/, Base::OutputStream& str) const
+{
+    str << static_cast<uint32_t>(expressions.size());
+    static const std::string empty;
+    for (const auto& it : expressions) {
+        str.writeString(it.first.toString());
+        if (it.second.expression) {
+            str.writeString(it.second.expression->toString(true));
+            str.writeString(it.second.expression->comment);
+        }
+        else {
+            str.writeString(empty);
+            str.writeString(empty);
+        }
+    }
+}
+
+void PropertyExpressionEngine::restoreBinary(Base::XMLReader& /*reader*/, Base::InputStream& str)
+{
+    uint32_t count = 0;
+    str >> count;
+
+    // Same as Restore(), the expressions are parsed in afterRestore()
+    restoredExpressions = std::make_unique<std::vector<RestoredExpression>>();
+    restoredExpressions->reserve(count);
+    for (uint32_t i = 0; i < count && str; ++i) {
+        auto& info = restoredExpressions->emplace_back();
+        str.readString(info.path);
+        str.readString(info.expr);
+        str.readString(info.comment);
+    }
+}
+
 /**
  * @brief Update graph structure with given path and expression.
  * @param path Path
@@ -729,6 +863,15 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
 
     resetter r(running);
 
+    // Only evaluate the bindings with a changed input if the inputs are tracked
+    const bool incremental = option != ExecuteOnRestore && trackInputs();
+    if (incremental
+        && std::none_of(expressions.begin(), expressions.end(), [](const auto& e) {
+               return e.second.dirty;
+           })) {
+        return DocumentObject::StdReturn;
+    }
+
     // Compute evaluation order
     std::vector<App::ObjectIdentifier> evaluationOrder = computeEvaluationOrder(option);
     std::vector<ObjectIdentifier>::const_iterator it = evaluationOrder.begin();
@@ -758,9 +901,18 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
         App::any value;
         try {
             // Evaluate expression
-            std::shared_ptr<App::Expression> expression = expressions[*it].expression;
+            auto& info = expressions[*it];
+            if (incremental && !info.dirty) {
+                continue;
+            }
+            std::shared_ptr<App::Expression> expression = info.expression;
             if (expression) {
-                value = expression->getValueAsAny();
+                if (!info.program || !info.program->isUpToDate()) {
+                    info.program = std::make_shared<ExpressionProgram>(expression.get());
+                }
+                if (!info.program->eval(value)) {
+                    value = expression->getValueAsAny();
+                }
 
                 // Enable value comparison for all expression bindings to reduce
                 // unnecessary touch and recompute.
@@ -776,6 +928,7 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
                 // if (option == ExecuteOnRestore && prop->testStatus(Property::EvalOnRestore))
                 {
                     if (isAnyEqual(value, prop->getPathValue(*it))) {
+                        info.dirty = false;
                         continue;
                     }
                     if (touched) {
@@ -783,6 +936,11 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
                     }
                 }
                 prop->setPathValue(*it, value);
+                // Cleared after setting, which marks the binding itself dirty
+                auto itInfo = expressions.find(*it);
+                if (itInfo != expressions.end()) {
+                    itInfo->second.dirty = false;
+                }
             }
         }
         catch (Base::Exception& e) {
@@ -49,6 +49,7 @@ class DocumentObject;
 class DocumentObjectExecReturn;
 class ObjectIdentifier;
 class Expression;
+class ExpressionProgram;
 using ExpressionPtr = std::unique_ptr<Expression>;
 
 class AppExport PropertyExpressionContainer: public App::PropertyXLinkContainer
@@ -102,13 +103,16 @@ public:
     struct ExpressionInfo
     {
         std::shared_ptr<App::Expression> expression; /**< The actual expression tree */
+        std::shared_ptr<App::ExpressionProgram> program; /**< Compiled form of the expression */
         bool busy;
+        bool dirty; /**< Whether an input changed since the last evaluation */
 
         explicit ExpressionInfo(
             std::shared_ptr<App::Expression> expression = std::shared_ptr<App::Expression>())
         {
             this->expression = expression;
             this->busy = false;
+            this->dirty = true;
         }
 
         ExpressionInfo(const ExpressionInfo&) = default;
@@ -137,6 +141,12 @@ public:
 
     void Restore(Base::XMLReader& reader) override;
 
+    bool canSaveBinary(const Base::Writer& writer) const override;
+
+    void saveBinary(Base::Writer& writer, Base::OutputStream& str) const override;
+
+    void restoreBinary(Base::XMLReader& reader, Base::InputStream& str) override;
+
     void setValue(const App::ObjectIdentifier& path, std::shared_ptr<App::Expression> expr);
 
     const boost::any getPathValue(const App::ObjectIdentifier& path) const override;
@@ -225,6 +235,8 @@ private:
     void slotChangedObject(const App::DocumentObject& obj, const App::Property& prop);
     void slotChangedProperty(const App::DocumentObject& obj, const App::Property& prop);
     void updateHiddenReference(const std::string& key);
+    bool trackInputs();
+    void slotInputChanged(const App::DocumentObject& obj, const App::Property& prop);
 
     bool running = false; /**< Boolean used to avoid loops */
     bool restoring = false;
@@ -27,6 +27,7 @@
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/Reader.h>
+#include <Base/Stream.h>
 #include <Base/Writer.h>
 #include <Base/Tools.h>
 
@@ -2914,6 +2915,104 @@ void PropertyLinkSubList::Restore(Base::XMLReader& reader)
     _mapped.swap(mapped);
 }
 
+bool PropertyLinkSubList::canSaveBinary(const Base::Writer& /*writer*/) const
+{
+    // The sub-element names are rewritten on export, see Save()
+    auto owner = freecad_cast<DocumentObject*>(getContainer());
+    return !owner || !owner->isExporting();
+}
+
+void PropertyLinkSubList::saveBinary(Base::Writer& /*writer*/, Base::OutputStream& str) const
+{
+    assert(_lSubList.size() == _ShadowSubList.size());
+
+    uint32_t count = 0;
+    for (auto obj : _lValueList) {
+        if (obj && obj->isAttachedToDocument()) {
+            ++count;
+        }
+    }
+    str << count;
+    for (int i = 0; i < getSize(); i++) {
+        auto obj = _lValueList[i];
+        if (!obj || !obj->isAttachedToDocument()) {
+            continue;
+        }
+        // Same content as the attributes written by Save()
+        const auto& shadow = _ShadowSubList[i];
+        const auto& sub = shadow.oldName.empty() ? _lSubList[i] : shadow.oldName;
+        str.writeString(obj->getExportName());
+        str.writeString(sub);
+        if (!_lSubList[i].empty() && sub != _lSubList[i]) {
+            str << static_cast<uint8_t>(1);  // ATTR_SHADOWED
+            str.writeString(_lSubList[i]);
+        }
+        else if (!_lSubList[i].empty() && !shadow.newName.empty()) {
+            str << static_cast<uint8_t>(2);  // ATTR_SHADOW
+            str.writeString(shadow.newName);
+        }
+        else {
+            str << static_cast<uint8_t>(0);
+        }
+    }
+}
+
+void PropertyLinkSubList::restoreBinary(Base::XMLReader& reader, Base::InputStream& str)
+{
+    uint32_t count = 0;
+    str >> count;
+
+    std::vector<DocumentObject*> values;
+    values.reserve(count);
+    std::vector<std::string> SubNames;
+    SubNames.reserve(count);
+    std::vector<ShadowSub> shadows;
+    shadows.reserve(count);
+    DocumentObject* father = freecad_cast<DocumentObject*>(getContainer());
+    App::Document* document = father ? father->getDocument() : nullptr;
+    bool restoreLabel = false;
+    // buffers reused for all links
+    std::string name;
+    std::string sub;
+    std::string shadowName;
+    for (uint32_t i = 0; i < count && str; i++) {
+        uint8_t shadowType = 0;
+        str.readString(name);
+        str.readString(sub);
+        str >> shadowType;
+        if (shadowType != 0) {
+            str.readString(shadowName);
+        }
+
+        // Same as Restore()
+        DocumentObject* child = document ? document->getObject(reader.getName(name.c_str())) : nullptr;
+        if (child) {
+            values.push_back(child);
+            auto& shadow = shadows.emplace_back();
+            shadow.oldName = importSubName(reader, sub.c_str(), restoreLabel);
+            if (shadowType == 1 && !IGNORE_SHADOW) {
+                shadow.newName = importSubName(reader, shadowName.c_str(), restoreLabel);
+                SubNames.push_back(shadow.newName);
+            }
+            else {
+                SubNames.push_back(shadow.oldName);
+                if (shadowType == 2 && !IGNORE_SHADOW) {
+                    shadow.newName = importSubName(reader, shadowName.c_str(), restoreLabel);
+                }
+            }
+        }
+        else if (reader.isVerbose()) {
+            Base::Console().warning("Lost link to '%s' while loading, maybe "
+                                    "an object was not loaded correctly\n",
+                                    name.c_str());
+        }
+    }
+    setFlag(LinkRestoreLabel, restoreLabel);
+
+    setValues(values, SubNames, std::move(shadows));
+    _mapped.clear();
+}
+
 bool PropertyLinkSubList::upgrade(Base::XMLReader& reader, const char* typeName)
 {
     Base::Type type = Base::Type::fromName(typeName);
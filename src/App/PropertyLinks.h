@@ -1143,6 +1143,10 @@ public:
     void Restore(Base::XMLReader& reader) override;
     bool upgrade(Base::XMLReader& reader, const char* typeName);
 
+    bool canSaveBinary(const Base::Writer& writer) const override;
+    void saveBinary(Base::Writer& writer, Base::OutputStream& str) const override;
+    void restoreBinary(Base::XMLReader& reader, Base::InputStream& str) override;
+
     Property* Copy() const override;
     void Paste(const Property& from) override;
 
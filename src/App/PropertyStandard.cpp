@@ -1030,7 +1030,7 @@ double PropertyFloat::getValue() const
 
 PyObject* PropertyFloat::getPyObject()
 {
-    return Py_BuildValue("d", _dValue);
+    return PyFloat_FromDouble(_dValue);
 }
 
 void PropertyFloat::setPyObject(PyObject* value)
@@ -3253,6 +3253,17 @@ void PropertyMaterialList::Restore(Base::XMLReader& reader)
 void PropertyMaterialList::SaveDocFile(Base::Writer& writer) const
 {
     Base::OutputStream str(writer.Stream());
+    saveBinary(writer, str);
+}
+
+bool PropertyMaterialList::canSaveBinary(const Base::Writer& writer) const
+{
+    // Same condition as for writing the file in Save()
+    return !writer.isForceXML() && getSize() > 0;
+}
+
+void PropertyMaterialList::saveBinary(Base::Writer& /*writer*/, Base::OutputStream& str) const
+{
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
     for (const auto& it : _lValueList) {
@@ -3336,6 +3347,18 @@ void PropertyMaterialList::RestoreDocFileV0(uint32_t count, Base::Reader& reader
 void PropertyMaterialList::RestoreDocFileV3(Base::Reader& reader)
 {
     Base::InputStream str(reader);
+    restoreV3(str);
+}
+
+void PropertyMaterialList::restoreBinary(Base::XMLReader& /*reader*/, Base::InputStream& str)
+{
+    // The binary data is always saved in the latest format
+    formatVersion = Version_3;
+    restoreV3(str);
+}
+
+void PropertyMaterialList::restoreV3(Base::InputStream& str)
+{
     uint32_t count = 0;
     str >> count;
     std::vector<Material> values(count);
@@ -1267,6 +1267,10 @@ public:
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
 
+    bool canSaveBinary(const Base::Writer& writer) const override;
+    void saveBinary(Base::Writer& writer, Base::OutputStream& str) const override;
+    void restoreBinary(Base::XMLReader& reader, Base::InputStream& str) override;
+
     const char* getEditorName() const override;
 
     Property* Copy() const override;
@@ -1287,6 +1291,7 @@ private:
 
     void RestoreDocFileV0(uint32_t count, Base::Reader& reader);
     void RestoreDocFileV3(Base::Reader& reader);
+    void restoreV3(Base::InputStream& str);
 
     void writeString(Base::OutputStream& str, const std::string& value) const;
     void readString(Base::InputStream& str, std::string& value);
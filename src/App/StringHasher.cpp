@@ -24,6 +24,7 @@
 #include <QCryptographicHash>
 #include <QHash>
 #include <deque>
+#include <mutex>
 
 #include <Base/Console.h>
 #include <Base/Reader.h>
@@ -82,8 +83,13 @@ class StringHasher::HashMap: public HashMapBase
 public:
     bool SaveAll = false;
     int Threshold = 0;
+    /// Guards the table. Recursive because getID() may call itself for the postfix and index of
+    /// an element name, and a StringID released while holding the lock erases its own entry.
+    mutable std::recursive_mutex Mutex;
 };
 
+using HashLock = std::lock_guard<std::recursive_mutex>;
+
 ///////////////////////////////////////////////////////////
 
 TYPESYSTEM_SOURCE_ABSTRACT(App::StringID, Base::BaseClass)
@@ -91,6 +97,7 @@ TYPESYSTEM_SOURCE_ABSTRACT(App::StringID, Base::BaseClass)
 StringID::~StringID()
 {
     if (_hasher) {
+        HashLock lock(_hasher->_hashes->Mutex);
         _hasher->_hashes->right.erase(_id);
     }
 }
@@ -182,6 +189,7 @@ StringHasher::~StringHasher()
 
 void StringHasher::setSaveAll(bool enable)
 {
+    HashLock lock(_hashes->Mutex);
     if (_hashes->SaveAll == enable) {
         return;
     }
@@ -191,6 +199,7 @@ void StringHasher::setSaveAll(bool enable)
 
 void StringHasher::compact()
 {
+    HashLock lock(_hashes->Mutex);
     if (_hashes->SaveAll) {
         return;
     }
@@ -243,6 +252,7 @@ int StringHasher::getThreshold() const
 
 long StringHasher::lastID() const
 {
+    HashLock lock(_hashes->Mutex);
     if (_hashes->right.empty()) {
         return 0;
     }
@@ -259,8 +269,21 @@ StringIDRef StringHasher::getID(const char* text, int len, bool hashable)
     return getID(QByteArray::fromRawData(text, len), hashable ? Option::Hashable : Option::None);
 }
 
+std::vector<StringIDRef> StringHasher::getIDs(const std::vector<QByteArray>& data,
+                                              Options options)
+{
+    std::vector<StringIDRef> res;
+    res.reserve(data.size());
+    HashLock lock(_hashes->Mutex);
+    for (const auto& item : data) {
+        res.push_back(getID(item, options));
+    }
+    return res;
+}
+
 StringIDRef StringHasher::getID(const QByteArray& data, Options options)
 {
+    HashLock lock(_hashes->Mutex);
     bool binary = options.testFlag(Option::Binary);
     bool hashable = options.testFlag(Option::Hashable);
     bool nocopy = options.testFlag(Option::NoCopy);
@@ -300,6 +323,7 @@ StringIDRef StringHasher::getID(const QByteArray& data, Options options)
 
 StringIDRef StringHasher::getID(const Data::MappedName& name, const QVector<StringIDRef>& sids)
 {
+    HashLock lock(_hashes->Mutex);
     StringID tempID;
     tempID._postfix = name.postfixBytes();
 
@@ -437,6 +461,7 @@ StringIDRef StringHasher::getID(long id, int index) const
     if (id <= 0) {
         return {};
     }
+    HashLock lock(_hashes->Mutex);
     auto it = _hashes->right.find(id);
     if (it == _hashes->right.end()) {
         return {};
@@ -496,6 +521,7 @@ void StringHasher::SaveDocFile(Base::Writer& writer) const
 
 void StringHasher::saveStream(std::ostream& stream) const
 {
+    HashLock lock(_hashes->Mutex);
     Base::TextOutputStream textStreamWrapper(stream);
     boost::io::ios_flags_saver ifs(stream);
     stream << std::hex;
@@ -597,6 +623,7 @@ void StringHasher::RestoreDocFile(Base::Reader& reader)
     std::string ver;
     reader >> marker;
     std::size_t count = 0;
+    HashLock lock(_hashes->Mutex);
     _hashes->clear();
     if (marker == "StringTableStart") {
         reader >> ver >> count;
@@ -613,6 +640,7 @@ void StringHasher::RestoreDocFile(Base::Reader& reader)
 void StringHasher::restoreStreamNew(std::istream& stream, std::size_t count)
 {
     Base::TextInputStream asciiStream(stream);
+    HashLock lock(_hashes->Mutex);
     _hashes->clear();
     std::string content;
     boost::io::ios_flags_saver ifs(stream);
@@ -729,6 +757,7 @@ void StringHasher::restoreStreamNew(std::istream& stream, std::size_t count)
 StringID* StringHasher::insert(const StringIDRef& sid)
 {
     assert(sid && sid._sid->_hasher == nullptr);
+    HashLock lock(_hashes->Mutex);
     auto& hasher = *sid._sid;
     hasher._hasher = this;
     hasher.ref();
@@ -743,6 +772,7 @@ StringID* StringHasher::insert(const StringIDRef& sid)
 
 void StringHasher::restoreStream(std::istream& stream, std::size_t count)
 {
+    HashLock lock(_hashes->Mutex);
     _hashes->clear();
     std::string content;
     for (uint32_t i = 0; i < count; ++i) {
@@ -762,6 +792,7 @@ void StringHasher::restoreStream(std::istream& stream, std::size_t count)
 
 void StringHasher::clear()
 {
+    HashLock lock(_hashes->Mutex);
     for (auto& hasher : _hashes->right) {
         hasher.second->_hasher = nullptr;
         hasher.second->unref();
@@ -771,11 +802,13 @@ void StringHasher::clear()
 
 size_t StringHasher::size() const
 {
+    HashLock lock(_hashes->Mutex);
     return _hashes->size();
 }
 
 size_t StringHasher::count() const
 {
+    HashLock lock(_hashes->Mutex);
     size_t count = 0;
     for (auto& hasher : _hashes->right) {
         if (hasher.second->isMarked() || hasher.second->isPersistent()) {
@@ -854,6 +887,7 @@ PyObject* StringHasher::getPyObject()
 std::map<long, StringIDRef> StringHasher::getIDMap() const
 {
     std::map<long, StringIDRef> ret;
+    HashLock lock(_hashes->Mutex);
     for (auto& hasher : _hashes->right) {
         ret.emplace_hint(ret.end(), hasher.first, StringIDRef(hasher.second));
     }
@@ -862,6 +896,7 @@ std::map<long, StringIDRef> StringHasher::getIDMap() const
 
 void StringHasher::clearMarks() const
 {
+    HashLock lock(_hashes->Mutex);
     for (auto& hasher : _hashes->right) {
         hasher.second->_flags.setFlag(StringID::Flag::Marked, false);
     }
@@ -27,6 +27,7 @@
 
 #include <bitset>
 #include <memory>
+#include <vector>
 
 #include <QByteArray>
 #include <QVector>
@@ -630,6 +631,9 @@ private:
 /// If the string is longer than a given threshold, instead of storing the string, its SHA1 hash is
 /// stored (and the original string discarded). This allows an upper threshold on the length of a
 /// stored string, while still effectively guaranteeing uniqueness in the table.
+///
+/// The table is guarded by an internal lock, so IDs can be obtained from several threads at once,
+/// e.g. while building element maps in parallel.
 class AppExport StringHasher: public Base::Persistence, public Base::Handled
 {
 
@@ -703,6 +707,18 @@ public:
      */
     StringIDRef getID(const QByteArray& data, Options options = Option::Hashable);
 
+    /** Map a batch of text or binary data to integers
+     *
+     * @param data: input data.
+     * @param options: options describing how to store the data.
+     * @return The StringID of each input, in the same order.
+     *
+     * Same as calling getID(const QByteArray&, Options) for each input, but the table is locked
+     * only once, so worker threads can merge the names they collected in one go.
+     */
+    std::vector<StringIDRef> getIDs(const std::vector<QByteArray>& data,
+                                    Options options = Option::Hashable);
+
     /** Map geometry element name to an integer */
     StringIDRef getID(const Data::MappedName& name, const QVector<StringIDRef>& sids);
 
@@ -111,7 +111,15 @@ int Transaction::getLastID()
 
 unsigned int Transaction::getMemSize() const
 {
-    return 0;
+    unsigned int size = 0;
+    for (auto& info : _Objects.get<0>()) {
+        size += info.second->getMemSize();
+        if (info.second->status == TransactionObject::New) {
+            // the transaction owns the removed object until it is undone
+            size += info.first->getMemSize();
+        }
+    }
+    return size;
 }
 
 void Transaction::Save(Base::Writer& /*writer*/) const
@@ -280,6 +288,13 @@ void Transaction::addObjectChange(const TransactionalObject* Obj, const Property
     To->setProperty(Prop);
 }
 
+void Transaction::compactPropertyChanges()
+{
+    for (auto& info : _Objects.get<0>()) {
+        info.second->compactPropertyChanges(info.first);
+    }
+}
+
 
 //**************************************************************************
 //**************************************************************************
@@ -390,7 +405,17 @@ void TransactionObject::applyChn(Document& /*Doc*/, TransactionalObject* pcObj,
             //     continue;
             // }
             try {
-                prop->Paste(*data.property);
+                if (data.changes) {
+                    if (prop != data.propertyOrig) {
+                        // The record only holds the difference to the original property
+                        FC_WARN("Cannot restore " << prop->getFullName() << " after recreation");
+                        continue;
+                    }
+                    data.changes->restore(*prop);
+                }
+                else {
+                    prop->Paste(*data.property);
+                }
             }
             catch (Base::Exception& e) {
                 e.reportException();
@@ -453,6 +478,7 @@ void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
         delete data.property;
         data.property = nullptr;
     }
+    data.changes.reset();
     data.propertyOrig = pcProp;
     static_cast<DynamicProperty::PropData&>(data) =
         pcProp->getContainer()->getDynamicPropertyData(pcProp);
@@ -466,9 +492,51 @@ void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
     }
 }
 
+void TransactionObject::compactPropertyChanges(const TransactionalObject* pcObj)
+{
+    if (status != Chn) {
+        return;
+    }
+    for (auto& v : _PropChangeMap) {
+        auto& data = v.second;
+        if (!data.nameOrig.empty() || !data.property || data.changes) {
+            continue;
+        }
+        // Same check as in applyChn(), the property may have been removed
+        // without being recorded.
+        auto prop = data.propertyOrig;
+        auto name = pcObj->getPropertyName(prop);
+        if (!name || (!data.name.empty() && data.name != name)
+            || data.propertyType != prop->getTypeId()) {
+            continue;
+        }
+        data.changes = prop->getChanges(*data.property);
+        if (data.changes) {
+            auto placeholder = static_cast<Property*>(data.propertyType.createInstance());
+            if (!placeholder) {
+                data.changes.reset();
+                continue;
+            }
+            placeholder->setStatusValue(data.property->getStatus());
+            delete data.property;
+            data.property = placeholder;
+        }
+    }
+}
+
 unsigned int TransactionObject::getMemSize() const
 {
-    return 0;
+    unsigned int size = 0;
+    for (auto& v : _PropChangeMap) {
+        auto& data = v.second;
+        if (data.changes) {
+            size += data.changes->getMemSize();
+        }
+        else if (data.property && data.nameOrig.empty()) {
+            size += data.property->getMemSize();
+        }
+    }
+    return size;
 }
 
 void TransactionObject::Save(Base::Writer& /*writer*/) const
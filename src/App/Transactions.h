@@ -25,6 +25,7 @@
 #ifndef APP_TRANSACTION_H
 #define APP_TRANSACTION_H
 
+#include <memory>
 #include <unordered_map>
 #include <Base/Factory.h>
 #include <Base/Persistence.h>
@@ -88,6 +89,9 @@ public:
     void addObjectDel(const TransactionalObject* Obj);
     void addObjectChange(const TransactionalObject* Obj, const Property* Prop);
 
+    /// Replace the saved property copies with records of the actual changes where smaller
+    void compactPropertyChanges();
+
 private:
     void changeProperty(TransactionalObject* Obj,
                         std::function<void(TransactionObject* to)> changeFunc);
@@ -122,6 +126,7 @@ public:
     void setProperty(const Property* pcProp);
     void renameProperty(const Property* pcProp, const char* newName);
     void addOrRemoveProperty(const Property* pcProp, bool add);
+    void compactPropertyChanges(const TransactionalObject* pcObj);
 
     unsigned int getMemSize() const override;
     void Save(Base::Writer& writer) const override;
@@ -144,6 +149,8 @@ protected:
         const Property* propertyOrig = nullptr;
         // for property renaming
         std::string nameOrig;
+        // changes since the saved property, which then only keeps type and status
+        std::unique_ptr<PropertyChanges> changes;
     };
     std::unordered_map<int64_t, PropData> _PropChangeMap;
 
@@ -27,9 +27,13 @@
 #pragma warning(disable : 4834)
 #endif
 
+#include <atomic>
+#include <functional>
 #include <map>
+#include <mutex>
 #include <string>
 #include <memory>
+#include <thread>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -76,6 +80,14 @@ struct DocumentP
     Base::UniqueNameManager objectNameManager;
     Base::UniqueNameManager objectLabelManager;
     std::unordered_map<long, DocumentObject*> objectIdMap;
+    // The objects by Label, kept up to date on add, remove and relabel. Labels are normally
+    // unique, but some objects allow duplicates.
+    std::unordered_map<std::string, std::vector<DocumentObject*>> objectLabelMap;
+    // The objects by their exact type with the order they were added in, so the objects derived
+    // from a type are found without looking at all objects
+    std::unordered_map<Base::Type::TypeId, std::vector<std::pair<std::size_t, DocumentObject*>>>
+        objectTypeMap;
+    std::size_t lastObjectOrder {};
     std::unordered_map<std::string, bool> partialLoadObjects;
     std::vector<DocumentObjectT> pendingRemove;
     long lastObjectId {};
@@ -102,6 +114,57 @@ struct DocumentP
 
     Document::PreRecomputeHook _preRecomputeHook;
 
+    // Objects that changed any of their properties during the current
+    // recompute, split by whether the new value was identical to the old one
+    std::unordered_set<const App::DocumentObject*> changedOnRecompute;
+    std::unordered_set<const App::DocumentObject*> sameOnRecompute;
+
+    // Per object timings recorded while the ProfileRecompute status is set
+    struct RecomputeTiming
+    {
+        std::string name;
+        std::string label;
+        std::string type;
+        double seconds {0.0};
+        int changedProperties {0};
+        bool error {false};
+    };
+    std::vector<const App::DocumentObject*> recomputeProfileOrder;
+    std::unordered_map<const App::DocumentObject*, RecomputeTiming> recomputeProfile;
+    double recomputeProfileTotal {0.0};
+
+    // Set while a batch of objects is recomputed on worker threads. Signals
+    // raised by those objects are queued per object and replayed on
+    // recomputeThread in the order of the serial recompute.
+    bool concurrentRecompute {false};
+    // Set by Document::cancelRecompute() for the running recompute
+    std::atomic<bool> recomputeCanceled {false};
+    std::thread::id recomputeThread;
+    std::mutex recomputeMutex;
+    std::unordered_map<const App::DocumentObject*, std::vector<std::function<void()>>>
+        deferredSignals;
+
+    // Changes collected while a ChangeSignalBatch is active, in the order
+    // they first happened. Objects are kept by ID to detect deletion.
+    struct PendingChange
+    {
+        long id;
+        std::vector<const App::Property*> props;
+        std::unordered_set<const App::Property*> seen;
+    };
+    std::vector<PendingChange> pendingChanges;
+    std::unordered_map<long, std::size_t> pendingChangeIndex;
+    std::vector<const App::Property*> pendingDocChanges;
+
+    // Results of Document::getCachedDependencyList() by options, together
+    // with the DocumentObject::getDependencyGeneration() they were built at
+    struct DependencyListCache
+    {
+        std::size_t generation;
+        std::vector<App::DocumentObject*> objects;
+    };
+    std::map<int, DependencyListCache> dependencyListCache;
+
     DocumentP();
 
     void addRecomputeLog(const char* why, App::DocumentObject* obj)
@@ -120,6 +183,7 @@ struct DocumentP
             delete returnCode;
             return;
         }
+        std::lock_guard<std::mutex> lock(recomputeMutex);
         _RecomputeLog.emplace(returnCode->Which,
                               std::unique_ptr<DocumentObjectExecReturn>(returnCode));
         returnCode->Which->setStatus(ObjectStatus::Error, true);
@@ -149,6 +213,33 @@ struct DocumentP
         objectIdMap.clear();
     }
 
+    RecomputeTiming& getRecomputeTiming(const App::DocumentObject* obj)
+    {
+        auto res = recomputeProfile.try_emplace(obj);
+        if (res.second) {
+            recomputeProfileOrder.push_back(obj);
+            if (auto name = obj->getNameInDocument()) {
+                res.first->second.name = name;
+            }
+            res.first->second.label = obj->Label.getStrValue();
+            res.first->second.type = obj->getTypeId().getName();
+        }
+        return res.first->second;
+    }
+
+    void flushDeferredSignals(const App::DocumentObject* obj)
+    {
+        auto it = deferredSignals.find(obj);
+        if (it == deferredSignals.end()) {
+            return;
+        }
+        auto funcs = std::move(it->second);
+        deferredSignals.erase(it);
+        for (auto& func : funcs) {
+            func();
+        }
+    }
+
     const char* findRecomputeLog(const App::DocumentObject* obj)
     {
         auto range = _RecomputeLog.equal_range(obj);
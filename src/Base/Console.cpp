@@ -28,8 +28,10 @@
 #elif defined(FC_OS_LINUX) || defined(FC_OS_MACOSX)
 #include <unistd.h>
 #endif
+#include <cstdint>
 #include <cstring>
 #include <functional>
+#include <thread>
 
 #include "Console.h"
 #include "PyObjectBase.h"
@@ -139,6 +141,211 @@ private:
 
 ConsoleOutput* ConsoleOutput::instance = nullptr;  // NOLINT
 
+/**
+ * Delivers the messages of ConsoleSingleton::Async mode.
+ *
+ * Senders push to a bounded lock-free multi-producer queue, and a single
+ * consumer thread drains it in batches. Consecutive duplicates are coalesced
+ * into a single repeat note. When the queue is full, log messages are dropped
+ * and counted, while other messages wait for room so that no warning or
+ * error gets lost.
+ */
+class ConsoleAsyncSink
+{
+public:
+    explicit ConsoleAsyncSink(std::size_t capacity)
+        : slots(new Slot[capacity])
+        , mask(capacity - 1)
+    {
+        assert((capacity & mask) == 0);
+        for (std::size_t i = 0; i < capacity; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        consumer = std::thread([this] { run(); });
+    }
+
+    ~ConsoleAsyncSink()
+    {
+        stop = true;
+        wakeup();
+        consumer.join();
+    }
+
+    ConsoleAsyncSink(const ConsoleAsyncSink&) = delete;
+    ConsoleAsyncSink(ConsoleAsyncSink&&) = delete;
+    ConsoleAsyncSink& operator=(const ConsoleAsyncSink&) = delete;
+    ConsoleAsyncSink& operator=(ConsoleAsyncSink&&) = delete;
+
+    void push(LogStyle category,
+              IntendedRecipient recipient,
+              ContentType content,
+              const std::string& notifier,
+              const std::string& msg)
+    {
+        Entry entry {category, recipient, content, notifier, msg};
+        // an observer logging from the consumer thread would wait for itself
+        if (isConsumerThread) {
+            dispatch(entry);
+            return;
+        }
+        while (!tryPush(entry)) {
+            if (category == LogStyle::Log) {
+                ++dropped;
+                return;
+            }
+            std::this_thread::yield();
+        }
+        ++pushed;
+        wakeup();
+    }
+
+    void flush()
+    {
+        if (isConsumerThread) {
+            return;
+        }
+        const auto target = pushed.load();
+        for (auto done = processed.load(); done < target; done = processed.load()) {
+            processed.wait(done);
+        }
+    }
+
+private:
+    struct Entry
+    {
+        LogStyle category {LogStyle::Message};
+        IntendedRecipient recipient {IntendedRecipient::All};
+        ContentType content {ContentType::Untranslated};
+        std::string notifier;
+        std::string msg;
+
+        bool operator==(const Entry& other) const = default;
+    };
+
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence {0};
+        Entry entry;
+    };
+
+    bool tryPush(Entry& entry)
+    {
+        auto pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[pos & mask];
+            const auto seq = slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.entry = std::move(entry);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(Entry& entry)
+    {
+        Slot& slot = slots[dequeuePos & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+            return false;
+        }
+        entry = std::move(slot.entry);
+        slot.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+        ++dequeuePos;
+        return true;
+    }
+
+    void wakeup()
+    {
+        ++wakeups;
+        wakeups.notify_one();
+    }
+
+    void run()
+    {
+        isConsumerThread = true;
+        Entry entry;
+        Entry last;
+        bool hasLast = false;
+        std::size_t repeats = 0;
+        for (;;) {
+            const auto ticket = wakeups.load();
+            std::size_t count = 0;
+            while (tryPop(entry)) {
+                ++count;
+                if (hasLast && entry == last) {
+                    ++repeats;
+                    continue;
+                }
+                reportRepeats(last, repeats);
+                dispatch(entry);
+                last = std::move(entry);
+                hasLast = true;
+            }
+            reportRepeats(last, repeats);
+            if (auto n = dropped.exchange(0)) {
+                dispatch({LogStyle::Warning,
+                          IntendedRecipient::Developer,
+                          ContentType::Untranslatable,
+                          std::string(),
+                          std::to_string(n) + " log messages dropped, console output is too slow\n"});
+            }
+            if (count != 0) {
+                processed += count;
+                processed.notify_all();
+            }
+            else if (stop) {
+                break;
+            }
+            else {
+                wakeups.wait(ticket);
+            }
+        }
+    }
+
+    static void reportRepeats(const Entry& last, std::size_t& repeats)
+    {
+        if (repeats == 0) {
+            return;
+        }
+        Entry note {last};
+        note.msg = "(last message repeated " + std::to_string(repeats) + " times)\n";
+        repeats = 0;
+        dispatch(note);
+    }
+
+    static void dispatch(const Entry& entry)
+    {
+        Console().notifyPrivate(entry.category,
+                                entry.recipient,
+                                entry.content,
+                                entry.notifier,
+                                entry.msg);
+    }
+
+    std::unique_ptr<Slot[]> slots;  // NOLINT
+    const std::size_t mask;
+    alignas(64) std::atomic<std::size_t> enqueuePos {0};
+    alignas(64) std::size_t dequeuePos {0};
+    std::atomic<std::size_t> pushed {0};
+    std::atomic<std::size_t> processed {0};
+    std::atomic<std::size_t> dropped {0};
+    std::atomic<unsigned> wakeups {0};
+    std::atomic<bool> stop {false};
+    std::thread consumer;
+    static thread_local bool isConsumerThread;
+};
+
+thread_local bool ConsoleAsyncSink::isConsumerThread = false;
+
 }  // namespace Base
 
 //**************************************************************************
@@ -155,6 +362,7 @@ ConsoleSingleton::ConsoleSingleton()
 
 ConsoleSingleton::~ConsoleSingleton()
 {
+    asyncSink.reset();
     ConsoleOutput::destruct();
     for (ILogger* Iter : _aclObservers) {  // NOLINT
         delete Iter;
@@ -259,12 +467,30 @@ bool ConsoleSingleton::isMsgTypeEnabled(const char* sObs, const FreeCAD_ConsoleM
 
 void ConsoleSingleton::setConnectionMode(const ConnectionMode mode)
 {
+    // The sink is kept once created, so that threads still pushing to it
+    // when the mode changes are safe.
+    if (mode == Async && !asyncSink) {
+        constexpr std::size_t queueSize = 4096;
+        asyncSink = std::make_unique<ConsoleAsyncSink>(queueSize);
+    }
+
     connectionMode = mode;
 
     // make sure this method gets called from the main thread
-    if (connectionMode == Queued) {
+    if (mode == Queued) {
         ConsoleOutput::getInstance();
     }
+    // keep the order with messages now delivered in another way
+    if (mode != Async) {
+        flush();
+    }
+}
+
+void ConsoleSingleton::flush()
+{
+    if (asyncSink) {
+        asyncSink->flush();
+    }
 }
 
 //**************************************************************************
@@ -278,6 +504,7 @@ void ConsoleSingleton::setConnectionMode(const ConnectionMode mode)
  */
 void ConsoleSingleton::attachObserver(ILogger* pcObserver)
 {
+    std::lock_guard<std::recursive_mutex> lock(_observerMutex);
     // double insert !!
     assert(!_aclObservers.contains(pcObserver));
 
@@ -291,6 +518,7 @@ void ConsoleSingleton::attachObserver(ILogger* pcObserver)
  */
 void ConsoleSingleton::detachObserver(ILogger* pcObserver)
 {
+    std::lock_guard<std::recursive_mutex> lock(_observerMutex);
     _aclObservers.erase(pcObserver);
 }
 
@@ -300,6 +528,7 @@ void ConsoleSingleton::notifyPrivate(const LogStyle category,
                                      const std::string& notifiername,
                                      const std::string& msg) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_observerMutex);
     for (ILogger* Iter : _aclObservers) {
         if (Iter->isActive(category)) {
             Iter->sendLog(notifiername,
@@ -321,8 +550,18 @@ void ConsoleSingleton::postEvent(const FreeCAD_ConsoleMsgType type,
                                 new ConsoleEvent(type, recipient, content, notifiername, msg));
 }
 
+void ConsoleSingleton::postAsync(const LogStyle category,
+                                 const IntendedRecipient recipient,
+                                 const ContentType content,
+                                 const std::string& notifiername,
+                                 const std::string& msg)
+{
+    asyncSink->push(category, recipient, content, notifiername, msg);
+}
+
 ILogger* ConsoleSingleton::get(const char* Name) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_observerMutex);
     const char* OName {};
     for (ILogger* Iter : _aclObservers) {
         OName = Iter->name();  // get the name
@@ -804,6 +1043,7 @@ PyObject* ConsoleSingleton::sPyGetObservers(PyObject* /*self*/, PyObject* args)
     PY_TRY
     {
         Py::List list;
+        std::lock_guard<std::recursive_mutex> lock(instance()._observerMutex);
         for (const auto i : instance()._aclObservers) {
             list.append(Py::String(i->name() ? i->name() : ""));
         }
@@ -26,9 +26,12 @@
 
 // Std. configurations
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <sstream>
@@ -612,6 +615,8 @@ public:
 };
 
 
+class ConsoleAsyncSink;
+
 /** The console class
  *  This class manage all the stdio stuff. This includes
  *  Messages, Warnings, Log entries, Errors, Criticals, Notifications. The incoming Messages are
@@ -794,10 +799,19 @@ public:
     {
         Verbose = 1,  // suppress Log messages
     };
+    /** How messages are delivered to the observers
+     *
+     * Direct calls the observers in the sending thread, Queued posts the
+     * messages to the Qt event loop of the main thread. Async pushes the
+     * messages to a lock-free queue which a consumer thread delivers in
+     * batches, so that slow observers do not throttle the senders. Messages
+     * sent by the same thread keep their order.
+     */
     enum ConnectionMode
     {
         Direct = 0,
-        Queued = 1
+        Queued = 1,
+        Async = 2
     };
 
     enum FreeCAD_ConsoleMsgType
@@ -815,6 +829,8 @@ public:
     /// Checks if message types of a certain console observer are enabled
     bool isMsgTypeEnabled(const char* sObs, FreeCAD_ConsoleMsgType type) const;
     void setConnectionMode(ConnectionMode mode);
+    /// Wait until all messages sent in Async mode are delivered to the observers
+    void flush();
 
     int* getLogLevel(const char* tag, bool create = true);
 
@@ -862,7 +878,8 @@ private:
     static PyObject* sPyGetObservers(PyObject* self, PyObject* args);
 
     bool _bCanRefresh {true};
-    ConnectionMode connectionMode {Direct};
+    std::atomic<ConnectionMode> connectionMode {Direct};
+    std::unique_ptr<ConsoleAsyncSink> asyncSink;
 
     // Singleton!
     ConsoleSingleton();
@@ -880,6 +897,11 @@ private:
                    ContentType content,
                    const std::string& notifiername,
                    const std::string& msg);
+    void postAsync(LogStyle category,
+                   IntendedRecipient recipient,
+                   ContentType content,
+                   const std::string& notifiername,
+                   const std::string& msg);
     void notifyPrivate(LogStyle category,
                        IntendedRecipient recipient,
                        ContentType content,
@@ -890,13 +912,15 @@ private:
     static void Destruct();
     static ConsoleSingleton* _pcSingleton;  // NOLINT
 
-    // observer list
+    // observer list, locked because Async mode calls the observers from another thread
     std::set<ILogger*> _aclObservers;
+    mutable std::recursive_mutex _observerMutex;
 
     std::map<std::string, int> _logLevels;
     int _defaultLogLevel;
 
     friend class ConsoleOutput;
+    friend class ConsoleAsyncSink;
 };
 
 /** Access to the Console
@@ -1193,9 +1217,13 @@ void Base::ConsoleSingleton::send(const std::string& notifiername, const char* p
         format += e.what();
     }
 
-    if (connectionMode == Direct) {
+    const auto mode = connectionMode.load();
+    if (mode == Direct) {
         notify<category, recipient, contenttype>(notifiername, format);
     }
+    else if (mode == Async) {
+        postAsync(category, recipient, contenttype, notifiername, format);
+    }
     else {
 
         const auto type = getConsoleMsg(category);
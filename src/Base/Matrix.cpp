@@ -612,6 +612,41 @@ void Matrix_gauss(Matrix a, Matrix b)
 }
 // NOLINTEND
 
+namespace
+{
+template<typename Float>
+void multVecArray(const Matrix4D& mat,
+                  const Vector3<Float>* src,
+                  Vector3<Float>* dst,
+                  std::size_t count)
+{
+    // Hoist the coefficients, as the compiler cannot prove that dst does not
+    // alias the matrix, and would otherwise reload them for every point and
+    // not vectorize the loop.
+    const double m00 = mat[0][0], m01 = mat[0][1], m02 = mat[0][2], m03 = mat[0][3];
+    const double m10 = mat[1][0], m11 = mat[1][1], m12 = mat[1][2], m13 = mat[1][3];
+    const double m20 = mat[2][0], m21 = mat[2][1], m22 = mat[2][2], m23 = mat[2][3];
+    for (std::size_t i = 0; i < count; ++i) {
+        const double x = static_cast<double>(src[i].x);
+        const double y = static_cast<double>(src[i].y);
+        const double z = static_cast<double>(src[i].z);
+        dst[i].x = static_cast<Float>(m00 * x + m01 * y + m02 * z + m03);
+        dst[i].y = static_cast<Float>(m10 * x + m11 * y + m12 * z + m13);
+        dst[i].z = static_cast<Float>(m20 * x + m21 * y + m22 * z + m23);
+    }
+}
+}  // namespace
+
+void Matrix4D::multVec(const Vector3d* src, Vector3d* dst, std::size_t count) const
+{
+    multVecArray(*this, src, dst, count);
+}
+
+void Matrix4D::multVec(const Vector3f* src, Vector3f* dst, std::size_t count) const
+{
+    multVecArray(*this, src, dst, count);
+}
+
 void Matrix4D::inverseOrthogonal()
 {
     Base::Vector3d vec(dMtrx4D[0][3], dMtrx4D[1][3], dMtrx4D[2][3]);
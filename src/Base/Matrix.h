@@ -26,6 +26,7 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <string>
 
 #include "Vector3D.h"
@@ -99,6 +100,9 @@ public:
     inline Vector3d operator*(const Vector3d& vec) const;
     inline void multVec(const Vector3d& src, Vector3d& dst) const;
     inline void multVec(const Vector3f& src, Vector3f& dst) const;
+    /// Multiplication matrix with an array of \a count vectors, \a src and \a dst may be equal
+    void multVec(const Vector3d* src, Vector3d* dst, std::size_t count) const;
+    void multVec(const Vector3f* src, Vector3f* dst, std::size_t count) const;
     inline Matrix4D operator*(double scalar) const;
     inline Matrix4D& operator*=(double scalar);
     /// Comparison
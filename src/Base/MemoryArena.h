@@ -0,0 +1,76 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association <www.freecad.org>      *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef BASE_MEMORYARENA_H
+#define BASE_MEMORYARENA_H
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+
+namespace Base
+{
+
+/*!
+ The memory of the temporary containers of an algorithm.
+ The nodes of the containers are taken one after the other from a buffer, first from the one
+ inside the arena and then from blocks of the heap, and are only given back all at once when
+ the arena goes out of scope. This avoids an allocation per node of sets, maps and lists that
+ are filled and thrown away in one go. The containers must not outlive the arena.
+ @code
+ Base::MemoryArena arena;
+ std::pmr::set<FacetIndex> visited(arena.resource());
+ std::pmr::map<PointIndex, int> degree(arena.resource());
+ @endcode
+ */
+template<std::size_t InlineSize = 4096>
+class MemoryArena
+{
+public:
+    MemoryArena() = default;
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena(MemoryArena&&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+    MemoryArena& operator=(MemoryArena&&) = delete;
+    ~MemoryArena() = default;
+
+    /// The resource to construct the std::pmr containers with
+    std::pmr::memory_resource* resource()
+    {
+        return &arena;
+    }
+
+    /// Gives back all memory taken so far, the containers using it must be gone
+    void release()
+    {
+        arena.release();
+    }
+
+private:
+    alignas(std::max_align_t) std::array<std::byte, InlineSize> buffer {};
+    std::pmr::monotonic_buffer_resource arena {buffer.data(), buffer.size()};
+};
+
+}  // namespace Base
+
+#endif  // BASE_MEMORYARENA_H
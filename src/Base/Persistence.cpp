@@ -73,6 +73,21 @@ void Persistence::SaveDocFile(Writer& /*writer*/) const
 void Persistence::RestoreDocFile(Reader& /*reader*/)
 {}
 
+std::function<void()> Persistence::parseDocFile(Reader& /*reader*/)
+{
+    throw Base::NotImplementedError("Persistence::parseDocFile");
+}
+
+void Persistence::saveBinary(Writer& /*writer*/, OutputStream& /*str*/) const
+{
+    throw Base::NotImplementedError("Persistence::saveBinary");
+}
+
+void Persistence::restoreBinary(XMLReader& /*reader*/, InputStream& /*str*/)
+{
+    throw Base::NotImplementedError("Persistence::restoreBinary");
+}
+
 std::string Persistence::encodeAttribute(const std::string& str)
 {
     std::string tmp;
@@ -24,10 +24,14 @@
 #ifndef APP_PERSISTENCE_H
 #define APP_PERSISTENCE_H
 
+#include <functional>
+
 #include "BaseClass.h"
 
 namespace Base
 {
+class InputStream;
+class OutputStream;
 class Reader;
 class Writer;
 class XMLReader;
@@ -145,6 +149,43 @@ public:
      * @see Base::Reader,Base::XMLReader
      */
     virtual void RestoreDocFile(Reader& /*reader*/);
+    /** Check if the file data of RestoreDocFile() can be parsed on a worker thread
+     *
+     * If true, XMLReader::readFiles() reads the file into memory and calls
+     * parseDocFile() on a worker thread instead of RestoreDocFile(). This
+     * method is called on the main thread. The default implementation
+     * returns false.
+     */
+    virtual bool canParseDocFileConcurrently() const
+    {
+        return false;
+    }
+    /** Parse the data of a file on a worker thread
+     *
+     * The implementation must only parse the data and must not modify this
+     * object, nor use a local XMLReader.
+     *
+     * @return Return a function that applies the parsed data to this object.
+     * It is called on the main thread in the order the files were added,
+     * after all files have been read and before the document finishes its
+     * restore. The default implementation throws an exception.
+     */
+    virtual std::function<void()> parseDocFile(Reader& reader);
+    /** Check if the object can be saved into the binary data of the writer
+     *
+     * If the writer has binary data enabled, see Writer::setBinaryData(), the
+     * owner of this object may call saveBinary() instead of Save(). On restore
+     * restoreBinary() is called with the saved data once the XML is read. The
+     * default implementation returns false.
+     */
+    virtual bool canSaveBinary(const Writer& /*writer*/) const
+    {
+        return false;
+    }
+    /// Save into the binary data of the writer, the default implementation throws an exception
+    virtual void saveBinary(Writer& writer, OutputStream& str) const;
+    /// Restore from the binary data of the reader, the default implementation throws an exception
+    virtual void restoreBinary(XMLReader& reader, InputStream& str);
     /// Encodes an attribute upon saving.
     static std::string encodeAttribute(const std::string&);
     /// Replaces all characters with '_' that are not allowed in XML
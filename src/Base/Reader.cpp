@@ -20,7 +20,12 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
 #include <vector>
 #include <iostream>
 #include <string>
@@ -55,6 +60,68 @@ XERCES_CPP_NAMESPACE_USE
 
 using namespace std;
 
+/*!
+ * \brief The XMLReader::BinaryData class
+ * Restores the objects registered with XMLReader::addBinary() from the records
+ * written by Writer::saveBinary().
+ */
+class Base::XMLReader::BinaryData: public Base::Persistence
+{
+public:
+    explicit BinaryData(Base::XMLReader& reader)
+        : reader(reader)
+    {}
+
+    unsigned int getMemSize() const override
+    {
+        return 0;
+    }
+    void Save(Base::Writer& /*writer*/) const override
+    {}
+    void Restore(Base::XMLReader& /*reader*/) override
+    {}
+    void RestoreDocFile(Base::Reader& file) override
+    {
+        std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        std::istringstream buffer(std::move(data));
+        Base::InputStream str(buffer);
+        uint32_t version {};
+        str >> version;
+        if (!buffer || version != 1) {
+            Base::Console().error("Unsupported binary data in %s\n", file.getFileName().c_str());
+            return;
+        }
+
+        for (unsigned int index = 0; index < objects.size(); ++index) {
+            uint32_t size {};
+            str >> size;
+            if (!buffer) {
+                break;
+            }
+            auto start = buffer.tellg();
+            if (Base::Persistence* object = objects[index]) {
+                try {
+                    object->restoreBinary(reader, str);
+                }
+                catch (const Base::Exception& e) {
+                    Base::Console().error("%s\n", e.what());
+                }
+                catch (const std::exception& e) {
+                    Base::Console().error("%s\n", e.what());
+                }
+                buffer.clear();
+            }
+            // Continue with the next record no matter how much was read
+            buffer.seekg(start + static_cast<std::streamoff>(size));
+        }
+    }
+
+    std::vector<Base::Persistence*> objects;
+
+private:
+    Base::XMLReader& reader;
+};
+
 
 // ---------------------------------------------------------------------------
 //  Base::XMLReader: Constructors and Destructor
@@ -433,6 +500,113 @@ void Base::XMLReader::readBinFile(const char* filename)
     to.close();
 }
 
+namespace
+{
+
+/// Parses the data of files read by XMLReader::readFiles() on worker threads
+class DocFileParser
+{
+public:
+    struct Job
+    {
+        std::string fileName;
+        Base::Persistence* object {nullptr};
+        std::string data;
+        std::function<void()> apply;
+        bool failed {false};
+    };
+
+    DocFileParser(int fileVersion, unsigned int threads)
+        : fileVersion(fileVersion)
+        , threads(threads)
+    {}
+
+    DocFileParser(const DocFileParser&) = delete;
+    DocFileParser& operator=(const DocFileParser&) = delete;
+
+    ~DocFileParser()
+    {
+        join();
+    }
+
+    void add(const std::string& fileName, Base::Persistence* object, std::string&& data)
+    {
+        Job& job = jobs.emplace_back();
+        job.fileName = fileName;
+        job.object = object;
+        job.data = std::move(data);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(&job);
+        }
+        cond.notify_one();
+        if (pool.size() < threads) {
+            pool.emplace_back(&DocFileParser::work, this);
+        }
+    }
+
+    /// Wait for all jobs and return them in the order they were added
+    std::deque<Job>& finish()
+    {
+        join();
+        return jobs;
+    }
+
+private:
+    void join()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+        }
+        cond.notify_all();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        pool.clear();
+    }
+
+    void work()
+    {
+        for (;;) {
+            Job* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [this]() {
+                    return done || !pending.empty();
+                });
+                if (pending.empty()) {
+                    return;
+                }
+                job = pending.front();
+                pending.pop_front();
+            }
+            try {
+                std::istringstream str(job->data);
+                Base::Reader reader(str, job->fileName, fileVersion);
+                job->apply = job->object->parseDocFile(reader);
+            }
+            catch (...) {
+                job->failed = true;
+            }
+            std::string().swap(job->data);
+        }
+    }
+
+private:
+    int fileVersion;
+    unsigned int threads;
+    // deque to keep the job addresses stable while adding
+    std::deque<Job> jobs;
+    std::deque<Job*> pending;
+    std::vector<std::thread> pool;
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool done {false};
+};
+
+}  // namespace
+
 void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
 {
     // It's possible that not all objects inside the document could be created, e.g. if a module
@@ -454,6 +628,15 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
     }
     std::vector<FileEntry>::const_iterator it = FileList.begin();
     Base::SequencerLauncher seq("Importing project files...", FileList.size());
+
+    // Files of objects supporting it are inflated here and parsed on worker
+    // threads while reading continues with the next entries
+    unsigned int threads = std::thread::hardware_concurrency();
+    std::unique_ptr<DocFileParser> parser;
+    if (threads > 1) {
+        parser = std::make_unique<DocFileParser>(FileVersion, threads - 1);
+    }
+
     while (entry->isValid() && it != FileList.end()) {
         std::vector<FileEntry>::const_iterator jt = it;
         // Check if the current entry is registered, otherwise check the next registered files as
@@ -465,10 +648,17 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
         // no file name for the current entry in the zip was registered.
         if (jt != FileList.end()) {
             try {
-                Base::Reader reader(zipstream, jt->FileName, FileVersion);
-                jt->Object->RestoreDocFile(reader);
-                if (reader.getLocalReader()) {
-                    reader.getLocalReader()->readFiles(zipstream);
+                if (parser && jt->Object->canParseDocFileConcurrently()) {
+                    std::string data((std::istreambuf_iterator<char>(zipstream)),
+                                     std::istreambuf_iterator<char>());
+                    parser->add(jt->FileName, jt->Object, std::move(data));
+                }
+                else {
+                    Base::Reader reader(zipstream, jt->FileName, FileVersion);
+                    jt->Object->RestoreDocFile(reader);
+                    if (reader.getLocalReader()) {
+                        reader.getLocalReader()->readFiles(zipstream);
+                    }
                 }
             }
             catch (...) {
@@ -496,6 +686,22 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
             break;
         }
     }
+
+    if (!parser) {
+        return;
+    }
+    for (auto& job : parser->finish()) {
+        try {
+            if (!job.failed && job.apply) {
+                job.apply();
+                continue;
+            }
+        }
+        catch (...) {
+        }
+        Base::Console().error("Reading failed from embedded file: %s\n", job.fileName.c_str());
+        FailedFiles.push_back(job.fileName);
+    }
 }
 
 const char* Base::XMLReader::addFile(const char* Name, Base::Persistence* Object)
@@ -509,6 +715,24 @@ const char* Base::XMLReader::addFile(const char* Name, Base::Persistence* Object
     return Name;
 }
 
+void Base::XMLReader::addBinary(unsigned int index, Base::Persistence* object)
+{
+    if (!binaryData) {
+        binaryData = std::make_unique<BinaryData>(*this);
+    }
+    if (binaryData->objects.size() <= index) {
+        binaryData->objects.resize(index + 1);
+    }
+    binaryData->objects[index] = object;
+}
+
+void Base::XMLReader::addBinaryDataFile(const char* name)
+{
+    if (binaryData) {
+        addFile(name, binaryData.get());
+    }
+}
+
 bool Base::XMLReader::hasFilenames() const
 {
     return !FileList.empty();
@@ -295,6 +295,14 @@ public:
     virtual bool doNameMapping() const;
     //@}
 
+    /** @name compact binary data */
+    //@{
+    /// Restore the object from the record of the binary data, see Writer::saveBinary()
+    void addBinary(unsigned int index, Base::Persistence* object);
+    /// Add the file that stores the binary data, see Writer::addBinaryDataFile()
+    void addBinaryDataFile(const char* name);
+    //@}
+
     /// Schema Version of the document
     int DocumentSchema {0};
     /// Version of FreeCAD that wrote this document
@@ -403,6 +411,9 @@ private:
     std::bitset<32> StatusBits;
 
     std::unique_ptr<std::istream> CharStream;
+
+    class BinaryData;
+    std::unique_ptr<BinaryData> binaryData;
 };
 
 class BaseExport Reader: public std::istream
@@ -149,6 +149,13 @@ OutputStream& OutputStream::write(const char* s, int n)
     return *this;
 }
 
+OutputStream& OutputStream::writeString(const std::string& str)
+{
+    *this << static_cast<uint32_t>(str.size());
+    _out.write(str.data(), static_cast<std::streamsize>(str.size()));
+    return *this;
+}
+
 InputStream::InputStream(std::istream& rin)
     : _in(rin)
 {}
@@ -251,6 +258,15 @@ InputStream& InputStream::read(char* s, int n)
     return *this;
 }
 
+InputStream& InputStream::readString(std::string& str)
+{
+    uint32_t size {};
+    *this >> size;
+    str.resize(_in ? size : 0);
+    _in.read(str.data(), static_cast<std::streamsize>(str.size()));
+    return *this;
+}
+
 // ----------------------------------------------------------------------
 
 ByteArrayOStreambuf::ByteArrayOStreambuf(QByteArray& ba)
@@ -95,6 +95,8 @@ public:
     OutputStream& operator<<(double d);
 
     OutputStream& write(const char* s, int n);
+    /// Write a string with its length as 32 bit prefix
+    OutputStream& writeString(const std::string& str);
 
     OutputStream(const OutputStream&) = delete;
     OutputStream(OutputStream&&) = delete;
@@ -128,6 +130,8 @@ public:
     InputStream& operator>>(double& d);
 
     InputStream& read(char* s, int n);
+    /// Read a string written by OutputStream::writeString(), the capacity of \a str is reused
+    InputStream& readString(std::string& str);
 
     explicit operator bool() const
     {
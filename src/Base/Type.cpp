@@ -55,6 +55,9 @@ struct Base::TypeData
     const Type parent;
     const Type type;
     const Type::instantiationMethod instMethod;
+    // The type and its parents, the root type first, so a type is derived from another one if
+    // it has it at the same depth. The types are registered after their parents.
+    std::vector<Type::TypeId> ancestors;
 };
 
 namespace
@@ -62,7 +65,7 @@ namespace
 constexpr const char* BadTypeName = "BadType";
 }
 
-std::map<std::string, unsigned int> Type::typemap;
+std::unordered_map<std::string, Type::TypeId, Type::NameHash, std::equal_to<>> Type::typemap;
 std::vector<TypeData*> Type::typedata;
 std::set<std::string> Type::loadModuleSet;
 
@@ -142,7 +145,12 @@ const Type Type::createType(const Type parent, const char* name, instantiationMe
 
     Type newType;
     newType.index = static_cast<unsigned int>(Type::typedata.size());
-    Type::typedata.emplace_back(new TypeData(name, newType, parent, method));
+    auto data = new TypeData(name, newType, parent, method);
+    if (!parent.isBad() && parent.index < Type::typedata.size()) {
+        data->ancestors = Type::typedata[parent.index]->ancestors;
+    }
+    data->ancestors.push_back(newType.index);
+    Type::typedata.emplace_back(data);
 
     // add to dictionary for fast lookup
     Type::typemap.emplace(name, newType.getKey());
@@ -155,6 +163,7 @@ void Type::init()
 {
     assert(Type::typedata.size() == 0 && "Type::init() should only be called once");
     typedata.emplace_back(new TypeData(BadTypeName, BadType, BadType, nullptr));
+    typedata.back()->ancestors.push_back(BadTypeIndex);
     typemap[BadTypeName] = 0;
 }
 
@@ -170,7 +179,7 @@ void Type::destruct()
 
 const Type Type::fromName(const char* name)
 {
-    const auto pos = typemap.find(name);
+    const auto pos = typemap.find(std::string_view(name));
     if (pos == typemap.end()) {
         return Type::BadType;
     }
@@ -203,15 +212,12 @@ const Type Type::getParent() const
 
 bool Type::isDerivedFrom(const Type type) const
 {
-    Type temp(*this);
-    do {
-        if (temp == type) {
-            return true;
-        }
-        temp = temp.getParent();
-    } while (!temp.isBad());
-
-    return false;
+    if (index >= typedata.size() || type.index >= typedata.size()) {
+        return false;
+    }
+    const auto& ancestors = typedata[index]->ancestors;
+    const std::size_t depth = typedata[type.index]->ancestors.size() - 1;
+    return depth < ancestors.size() && ancestors[depth] == type.index;
 }
 
 int Type::getAllDerivedFrom(const Type type, std::vector<Type>& list)
@@ -27,8 +27,10 @@
 // Std. configurations
 
 #include <string>
+#include <string_view>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
 #ifndef FC_GLOBAL_H
 #include <FCGlobal.h>
@@ -145,7 +147,17 @@ private:
 
     TypeId index {BadTypeIndex};
 
-    static std::map<std::string, TypeId> typemap;
+    // transparent, so the names are looked up without creating a string
+    struct NameHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept
+        {
+            return std::hash<std::string_view> {}(name);
+        }
+    };
+
+    static std::unordered_map<std::string, TypeId, NameHash, std::equal_to<>> typemap;
     static std::vector<TypeData*> typedata;  // use pointer to hide implementation details
     static std::set<std::string> loadModuleSet;
 
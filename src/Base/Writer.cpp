@@ -21,14 +21,19 @@
  ***************************************************************************/
 
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <thread>
 #include <vector>
 #include <string>
 
 #include <limits>
 #include <locale>
 #include <iomanip>
+#include <zlib.h>
 
 #include "Writer.h"
 #include "Base64.h"
@@ -41,6 +46,7 @@
 
 #include <boost/iostreams/filtering_stream.hpp>
 #include <zipios++/zipinputstream.h>
+#include <zipios++/zipoutputstream.h>
 
 using namespace Base;
 
@@ -79,6 +85,63 @@ struct cdata_filter
     int state = 0;
 };
 
+/*!
+ * \brief The Writer::BinaryData class
+ * Collects the records of Writer::saveBinary(). Each record is prefixed with its size
+ * so that the reader can skip records it cannot restore.
+ */
+class Writer::BinaryData: public Persistence
+{
+public:
+    BinaryData()
+        : outputStream(buffer)
+    {
+        outputStream << static_cast<uint32_t>(1);  // format version
+    }
+
+    unsigned int getMemSize() const override
+    {
+        return 0;
+    }
+    void Save(Writer& /*writer*/) const override
+    {}
+    void Restore(XMLReader& /*reader*/) override
+    {}
+    void SaveDocFile(Writer& writer) const override
+    {
+        writer.Stream() << buffer.view();
+    }
+
+    unsigned int save(Writer& writer, const Persistence* object)
+    {
+        auto start = buffer.tellp();
+        outputStream << static_cast<uint32_t>(0);
+        auto finish = [&]() {
+            auto end = buffer.tellp();
+            buffer.seekp(start);
+            outputStream << static_cast<uint32_t>(end - start - sizeof(uint32_t));
+            buffer.seekp(end);
+            return count++;
+        };
+        try {
+            object->saveBinary(writer, outputStream);
+        }
+        catch (...) {
+            // the incomplete record is skipped by the reader as its index is not used
+            finish();
+            throw;
+        }
+        return finish();
+    }
+
+    bool closed {false};
+
+private:
+    std::ostringstream buffer;
+    OutputStream outputStream;
+    unsigned int count {0};
+};
+
 // ---------------------------------------------------------------------------
 //  Writer: Constructors and Destructor
 // ---------------------------------------------------------------------------
@@ -311,6 +374,38 @@ void Writer::putNextEntry(const char* file, const char* obj)
     ObjectName = obj ? obj : file;
 }
 
+void Writer::setBinaryData(bool on)
+{
+    if (on) {
+        binaryData = std::make_unique<BinaryData>();
+    }
+    else {
+        binaryData.reset();
+    }
+}
+
+bool Writer::hasBinaryData() const
+{
+    return binaryData && !binaryData->closed;
+}
+
+unsigned int Writer::saveBinary(const Base::Persistence* object)
+{
+    if (!hasBinaryData()) {
+        throw Base::RuntimeError("Writer::saveBinary: binary data not enabled");
+    }
+    return binaryData->save(*this, object);
+}
+
+std::string Writer::addBinaryDataFile(const char* name)
+{
+    if (!hasBinaryData()) {
+        throw Base::RuntimeError("Writer::addBinaryDataFile: binary data not enabled");
+    }
+    binaryData->closed = true;
+    return addFile(name, binaryData.get());
+}
+
 // ----------------------------------------------------------------------------
 
 ZipWriter::ZipWriter(const char* FileName)
@@ -346,8 +441,179 @@ void ZipWriter::putNextEntry(const char* file, const char* obj)
     Writer::checkErrNo();
 }
 
+#ifdef ZIPIOS_HAVE_RAW_ENTRY
+namespace
+{
+
+/*!
+ * \brief The DocFileCompressor class
+ * Compresses the serialized files of a ZipWriter on a pool of worker threads.
+ * The jobs are handed back in the order they were added.
+ */
+class DocFileCompressor
+{
+public:
+    struct Job
+    {
+        std::string fileName;
+        std::string data;
+        std::string compressed;
+        std::size_t size {0};
+        uLong crc {0};
+        bool stored {false};
+        bool done {false};
+    };
+
+    DocFileCompressor(int level, unsigned int threads)
+        : level(level)
+        , threads(threads)
+    {}
+
+    DocFileCompressor(const DocFileCompressor&) = delete;
+    DocFileCompressor& operator=(const DocFileCompressor&) = delete;
+
+    ~DocFileCompressor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+        }
+        cond.notify_all();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+
+    void add(const std::string& fileName, std::string&& data)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            Job& job = jobs.emplace_back();
+            job.fileName = fileName;
+            job.data = std::move(data);
+            pending.push_back(&job);
+        }
+        cond.notify_all();
+        if (pool.size() < threads) {
+            pool.emplace_back(&DocFileCompressor::work, this);
+        }
+    }
+
+    /// Number of jobs that have not been taken yet
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return jobs.size();
+    }
+
+    /** Take the oldest job
+     * Returns false if there is no job or, unless \a wait is true,
+     * the oldest job is not compressed yet.
+     */
+    bool take(Job& job, bool wait)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (jobs.empty()) {
+            return false;
+        }
+        if (wait) {
+            finished.wait(lock, [this]() {
+                return jobs.front().done;
+            });
+        }
+        else if (!jobs.front().done) {
+            return false;
+        }
+        job = std::move(jobs.front());
+        jobs.pop_front();
+        return true;
+    }
+
+private:
+    void work()
+    {
+        for (;;) {
+            Job* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [this]() {
+                    return quit || !pending.empty();
+                });
+                if (pending.empty()) {
+                    return;
+                }
+                job = pending.front();
+                pending.pop_front();
+            }
+            compress(*job);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                job->done = true;
+            }
+            finished.notify_all();
+        }
+    }
+
+    void compress(Job& job) const
+    {
+        const auto* data = reinterpret_cast<const Bytef*>(job.data.data());  // NOLINT
+        auto size = static_cast<uInt>(job.data.size());
+        job.size = job.data.size();
+        job.crc = crc32(crc32(0L, Z_NULL, 0), data, size);
+        job.stored = true;
+        if (level == Z_NO_COMPRESSION) {
+            return;
+        }
+
+        z_stream zs {};
+        // raw deflate stream as expected inside a zip archive
+        if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return;
+        }
+        job.compressed.resize(deflateBound(&zs, size));
+        zs.next_in = const_cast<Bytef*>(data);  // NOLINT
+        zs.avail_in = size;
+        zs.next_out = reinterpret_cast<Bytef*>(job.compressed.data());  // NOLINT
+        zs.avail_out = static_cast<uInt>(job.compressed.size());
+        if (deflate(&zs, Z_FINISH) == Z_STREAM_END) {
+            job.compressed.resize(zs.total_out);
+            job.stored = false;
+        }
+        deflateEnd(&zs);
+        if (job.stored) {
+            // fall back to store the data uncompressed
+            std::string().swap(job.compressed);
+        }
+        else {
+            std::string().swap(job.data);
+        }
+    }
+
+private:
+    int level;
+    unsigned int threads;
+    // deque to keep the job addresses stable while adding
+    std::deque<Job> jobs;
+    std::deque<Job*> pending;
+    std::vector<std::thread> pool;
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+    std::condition_variable finished;
+    bool quit {false};
+};
+
+}  // namespace
+#endif
+
 void ZipWriter::writeFiles()
 {
+#ifdef ZIPIOS_HAVE_RAW_ENTRY
+    if (Threads > 1) {
+        writeFilesConcurrently();
+        return;
+    }
+#endif
+
     // use a while loop because it is possible that while
     // processing the files new ones can be added
     size_t index = 0;
@@ -361,6 +627,65 @@ void ZipWriter::writeFiles()
     }
 }
 
+void ZipWriter::writeFilesConcurrently()
+{
+#ifdef ZIPIOS_HAVE_RAW_ENTRY
+    DocFileCompressor compressor(Level, Threads);
+
+    auto writeEntry = [this](DocFileCompressor::Job& job) {
+        const std::string& data = job.stored ? job.data : job.compressed;
+        if (job.size > std::numeric_limits<zipios::uint32>::max()) {
+            addError(job.fileName + ": file too large");
+            return;
+        }
+        zipios::ZipCDirEntry entry(job.fileName);
+        entry.setMethod(job.stored ? zipios::STORED : zipios::DEFLATED);
+        entry.setSize(static_cast<zipios::uint32>(job.size));
+        entry.setCrc(static_cast<zipios::uint32>(job.crc));
+        ZipStream.putRawEntry(entry, data.data(), static_cast<zipios::uint32>(data.size()));
+        Writer::checkErrNo();
+    };
+
+    // Limit the number of serialized files kept in memory
+    const std::size_t maxPending = 2 * static_cast<std::size_t>(Threads);
+
+    // use a while loop because it is possible that while
+    // processing the files new ones can be added
+    size_t index = 0;
+    while (index < FileList.size()) {
+        FileEntry entry = FileList[index];
+        Writer::putNextEntry(entry.FileName.c_str());
+        indent = 0;
+        indBuf[0] = 0;
+
+        EntryStream = std::make_unique<std::ostringstream>();
+        EntryStream->imbue(ZipStream.getloc());
+        EntryStream->precision(ZipStream.precision());
+        EntryStream->setf(std::ios::fixed, std::ios::floatfield);
+        try {
+            entry.Object->SaveDocFile(*this);
+        }
+        catch (...) {
+            EntryStream.reset();
+            throw;
+        }
+        compressor.add(entry.FileName, std::move(*EntryStream).str());
+        EntryStream.reset();
+
+        DocFileCompressor::Job job;
+        while (compressor.take(job, compressor.size() >= maxPending)) {
+            writeEntry(job);
+        }
+        index++;
+    }
+
+    DocFileCompressor::Job job;
+    while (compressor.take(job, true)) {
+        writeEntry(job);
+    }
+#endif
+}
+
 ZipWriter::~ZipWriter()
 {
     ZipStream.close();
@@ -111,6 +111,22 @@ public:
     void clearModes();
     //@}
 
+    /** @name compact binary data */
+    //@{
+    /** Enable the binary data
+     * Objects supporting it are then saved with Persistence::saveBinary() into
+     * a compact binary stream instead of XML. The stream is written as one
+     * additional file, see addBinaryDataFile().
+     */
+    void setBinaryData(bool on);
+    /// Check if objects can still be saved into the binary data
+    bool hasBinaryData() const;
+    /// Save the object into the binary data, returns the index of its record
+    unsigned int saveBinary(const Base::Persistence* object);
+    /// Add the file that stores the binary data, no record can be saved afterwards
+    std::string addBinaryDataFile(const char* name);
+    //@}
+
     /** @name Error handling */
     //@{
     void addError(const std::string&);
@@ -187,8 +203,10 @@ public:
     Writer& operator=(Writer&&) = delete;
 
 private:
+    class BinaryData;
     std::unique_ptr<std::ostream> CharStream;
     CharStreamFormat charStreamFormat;
+    std::unique_ptr<BinaryData> binaryData;
 };
 
 
@@ -209,17 +227,28 @@ public:
 
     std::ostream& Stream() override
     {
-        return ZipStream;
+        return EntryStream ? *EntryStream : ZipStream;
     }
 
     void setComment(const char* str)
     {
         ZipStream.setComment(str);
     }
+    /// Set the compression level, 0 stores the additional files uncompressed
     void setLevel(int level)
     {
+        Level = level;
         ZipStream.setLevel(level);
     }
+    /** Set the number of threads used to compress the additional files
+     * With more than one thread writeFiles() serializes each file into memory and
+     * compresses it on a worker thread while the next one is serialized. The entries
+     * are still written in the order they were added.
+     */
+    void setThreads(unsigned int threads)
+    {
+        Threads = threads;
+    }
     void putNextEntry(const char* filename, const char* objName = nullptr) override;
 
     ZipWriter(const ZipWriter&) = delete;
@@ -227,8 +256,14 @@ public:
     ZipWriter& operator=(const ZipWriter&) = delete;
     ZipWriter& operator=(ZipWriter&&) = delete;
 
+private:
+    void writeFilesConcurrently();
+
 private:
     zipios::ZipOutputStream ZipStream;
+    std::unique_ptr<std::ostringstream> EntryStream;
+    int Level {6};
+    unsigned int Threads {1};
 };
 
 /** The StringWriter class
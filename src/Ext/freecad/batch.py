@@ -0,0 +1,123 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+__title__ = "FreeCAD batch processing"
+__url__ = "https://www.freecad.org"
+__doc__ = "Recompute and export many documents in several FreeCADCmd processes"
+
+
+import importlib
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+import FreeCAD
+
+# The job of a worker process is passed in this environment variable
+JOB_VARIABLE = "FREECAD_BATCH_JOB"
+
+
+def find_executable():
+    """find_executable() -> str
+
+    The FreeCADCmd executable next to the running FreeCAD, or None."""
+
+    bin_path = FreeCAD.ConfigGet("BinPath")
+    names = ["FreeCADCmd", "freecadcmd"]
+    if sys.platform == "win32":
+        names = [name + ".exe" for name in names]
+    for name in names:
+        path = os.path.join(bin_path, name)
+        if os.path.isfile(path):
+            return path
+    return None
+
+
+def run(files, task=None, processes=None, executable=None):
+    """run(files, task=None, processes=None, executable=None) -> dict
+
+    Opens, recomputes and optionally processes the documents in several FreeCADCmd processes.
+
+    files: the paths of the documents. Neighbouring files go to the same process, so
+        documents of one project share the external documents their links load.
+    task: "module:function" called with each recomputed document, e.g. to export it.
+    processes: the number of worker processes, by default one per CPU.
+    executable: the FreeCADCmd to run, by default the one of this installation.
+
+    Returns a dict with the file as key and a dict with the keys "error" (None on success)
+    and "invalid" (the names of the objects that failed to recompute)."""
+
+    files = [os.path.abspath(f) for f in files]
+    if not files:
+        return {}
+    if executable is None:
+        executable = find_executable()
+    if executable is None:
+        raise RuntimeError("FreeCADCmd not found, pass the executable")
+    if processes is None:
+        processes = os.cpu_count() or 1
+    processes = max(1, min(processes, len(files)))
+
+    results = {}
+    workers = []
+    with tempfile.TemporaryDirectory() as tmp:
+        size, extra = divmod(len(files), processes)
+        start = 0
+        for i in range(processes):
+            end = start + size + (1 if i < extra else 0)
+            job = os.path.join(tmp, "job{}.json".format(i))
+            result = os.path.join(tmp, "result{}.json".format(i))
+            with open(job, "w", encoding="utf-8") as f:
+                json.dump({"files": files[start:end], "task": task, "result": result}, f)
+            env = dict(os.environ)
+            env[JOB_VARIABLE] = job
+            cmd = [executable, "import freecad.batch; freecad.batch.work()"]
+            workers.append((subprocess.Popen(cmd, env=env), files[start:end], result))
+            start = end
+
+        for process, chunk, result in workers:
+            process.wait()
+            try:
+                with open(result, encoding="utf-8") as f:
+                    results.update(json.load(f))
+            except (OSError, ValueError):
+                pass
+            for name in chunk:
+                if name not in results:
+                    error = "worker exited with code {}".format(process.returncode)
+                    results[name] = {"error": error, "invalid": []}
+    return results
+
+
+def work():
+    """work() ... runs the job of a worker process started by run()."""
+
+    with open(os.environ[JOB_VARIABLE], encoding="utf-8") as f:
+        job = json.load(f)
+
+    function = None
+    if job["task"]:
+        module, name = job["task"].split(":")
+        function = getattr(importlib.import_module(module), name)
+
+    results = {}
+    for name in job["files"]:
+        result = {"error": None, "invalid": []}
+        doc = None
+        try:
+            doc = FreeCAD.openDocument(name)
+            doc.recompute()
+            result["invalid"] = [obj.Name for obj in doc.Objects if "Invalid" in obj.State]
+            if function:
+                function(doc)
+        except Exception as e:
+            result["error"] = str(e)
+        finally:
+            # The external documents loaded by the links stay open for the next documents
+            if doc and doc.Name in FreeCAD.listDocuments():
+                FreeCAD.closeDocument(doc.Name)
+        results[name] = result
+
+    with open(job["result"], "w", encoding="utf-8") as f:
+        json.dump(results, f)
@@ -1677,6 +1677,18 @@ bool Application::activateWorkbench(const char* name)
     try {
         std::string type;
         Py::Object handler(pcWorkbench);
+        // A workbench that is loaded on demand is registered with a placeholder
+        // that replaces itself with the real handler on first activation
+        if (handler.hasAttr(std::string("__DeferredInit__"))) {
+            Py::Callable init(handler.getAttr(std::string("__DeferredInit__")));
+            init.apply(Py::Tuple());
+            pcWorkbench = PyDict_GetItemString(_pcWorkbenchDictionary, name);
+            if (!pcWorkbench) {
+                return false;
+            }
+            handler = Py::Object(pcWorkbench);
+        }
+
         if (!handler.hasAttr(std::string("__Workbench__"))) {
             // call its GetClassName method if possible
             Py::Callable method(handler.getAttr(std::string("GetClassName")));
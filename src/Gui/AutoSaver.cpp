@@ -20,11 +20,15 @@
  *                                                                         *
  ***************************************************************************/
 
+# include <algorithm>
+# include <memory>
+# include <sstream>
 # include <QApplication>
 # include <QFile>
 # include <QDir>
 # include <QRunnable>
 # include <QTextStream>
+# include <QThread>
 # include <QThreadPool>
 
 #include <App/Application.h>
@@ -132,6 +136,11 @@ void AutoSaver::slotDeleteDocument(const App::Document& Doc)
 
 void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
 {
+    // nothing to recover since the last auto-save
+    if (saver.touched.empty()) {
+        return;
+    }
+
     Gui::WaitCursor wc;
     App::Document* doc = App::GetApplication().getDocument(name.c_str());
     if (doc && !doc->testStatus(App::Document::PartialDoc)
@@ -180,7 +189,8 @@ void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
                 // is not reentrant. See PropertyPartShape::SaveDocFile
                 writer.setMode("BinaryBrep");
 
-                writer.putNextEntry("Document.xml");
+                // replace the document file only once it's complete
+                writer.putNextEntry("Document.xml.tmp");
 
                 doc->Save(writer);
 
@@ -189,21 +199,32 @@ void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
 
                 // write additional files
                 writer.writeFiles();
+
+                renameFile(QString::fromUtf8(dirName.c_str()),
+                           QStringLiteral("Document.xml"),
+                           QStringLiteral("Document.xml.tmp"));
             }
-            // only create the file if something has changed
-            else if (!saver.touched.empty()) {
-                std::string fn = doc->TransientDir.getValue();
-                fn += "/fc_recovery_file.fcstd";
-                Base::FileInfo tmp(fn);
-                Base::ofstream file(tmp, std::ios::out | std::ios::binary);
-                if (file.is_open())
+            else {
+                // The archive is created in memory from the current state of the document,
+                // writing it to the disk doesn't block the GUI. A previous write that is still
+                // running is finished first so that the renames keep their order.
+                if (saver.pendingWrite.valid()) {
+                    saver.pendingWrite.wait();
+                }
+
+                auto buffer =
+                    std::make_shared<std::ostringstream>(std::ios::out | std::ios::binary);
                 {
-                    Base::ZipWriter writer(file);
+                    Base::ZipWriter writer(*buffer);
                     if (hGrp->GetBool("SaveBinaryBrep", true))
                         writer.setMode("BinaryBrep");
 
                     writer.setComment("AutoRecovery file");
-                    writer.setLevel(1); // apparently the fastest compression
+                    // level 1 is apparently the fastest compression, 0 stores the files
+                    // uncompressed for the lowest latency
+                    int level = static_cast<int>(hGrp->GetInt("AutoSaveCompressionLevel", 1));
+                    writer.setLevel(std::clamp(level, 0, 9));
+                    writer.setThreads(static_cast<unsigned int>(std::max(QThread::idealThreadCount(), 1)));
                     writer.putNextEntry("Document.xml");
 
                     doc->Save(writer);
@@ -214,6 +235,25 @@ void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
                     // write additional files
                     writer.writeFiles();
                 }
+
+                QString dir = QString::fromUtf8(doc->TransientDir.getValue());
+                QString tmpName = QStringLiteral("fc_recovery_file.fcstd.tmp%1").arg(rand());
+                saver.pendingWrite = std::async(std::launch::async, [buffer, dir, tmpName]() {
+                    QFile file(QDir(dir).absoluteFilePath(tmpName));
+                    if (!file.open(QFile::WriteOnly)) {
+                        Base::Console().warning("Failed to write auto-recovery file\n");
+                        return;
+                    }
+                    std::string data = std::move(*buffer).str();
+                    file.write(data.data(), static_cast<qint64>(data.size()));
+                    file.close();
+
+                    // the file is replaced in the main thread, see RecoveryRunnable
+                    QMetaObject::invokeMethod(AutoSaver::instance(), "renameFile",
+                            Qt::QueuedConnection, Q_ARG(QString,dir)
+                            ,Q_ARG(QString,QStringLiteral("fc_recovery_file.fcstd"))
+                            ,Q_ARG(QString,tmpName));
+                });
             }
         }
 
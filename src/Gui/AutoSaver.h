@@ -26,6 +26,7 @@
 
 #include <QObject>
 
+#include <future>
 #include <map>
 #include <set>
 #include <string>
@@ -50,6 +51,8 @@ public:
     std::set<std::string> touched;
     std::string dirName;
     std::map<std::string, std::string> fileMap;
+    /// writes the last compressed recovery file to disk
+    std::future<void> pendingWrite;
 
 private:
     void slotNewObject(const App::DocumentObject&);
@@ -22,6 +22,8 @@
 
 # include <QApplication>
 # include <QBitmap>
+# include <QCryptographicHash>
+# include <QDateTime>
 # include <QDir>
 # include <QFile>
 # include <QFileInfo>
@@ -29,6 +31,7 @@
 # include <QImageReader>
 # include <QPainter>
 # include <QPalette>
+# include <QSaveFile>
 # include <QScreen>
 # include <QString>
 # include <QSvgRenderer>
@@ -50,8 +53,26 @@ class BitmapFactoryInstP
 {
 public:
     QMap<std::string, QPixmap> xpmCache;
+    // directory of the rasterized SVG files, empty if disabled
+    QString diskCachePath;
 
     bool useIconTheme;
+
+    QString diskCacheFile(const QFileInfo& fi, const QSize& size, const ColorMap& colorMapping) const
+    {
+        // The modification time is part of the key so that a changed file is
+        // rasterized again
+        QByteArray key = fi.absoluteFilePath().toUtf8();
+        key += QByteArray::number(fi.lastModified().toMSecsSinceEpoch());
+        key += QByteArray::number(size.width()) + 'x' + QByteArray::number(size.height());
+        for (const auto& it : colorMapping) {
+            key += ';' + QByteArray::number(qulonglong(it.first))
+                 + '=' + QByteArray::number(qulonglong(it.second));
+        }
+
+        QByteArray hash = QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex();
+        return diskCachePath + QString::fromLatin1(hash) + QLatin1String(".png");
+    }
 };
 }
 
@@ -94,6 +115,7 @@ BitmapFactoryInst::BitmapFactoryInst()
 
     restoreCustomPaths();
     configureUseIconTheme();
+    configureDiskCache();
 }
 
 BitmapFactoryInst::~BitmapFactoryInst()
@@ -119,6 +141,20 @@ void Gui::BitmapFactoryInst::configureUseIconTheme()
     d->useIconTheme = group->GetBool("UseIconTheme", group->GetBool("ThemeSearchPaths", false));
 }
 
+void BitmapFactoryInst::configureDiskCache()
+{
+    Base::Reference<ParameterGrp> group = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Bitmaps");
+
+    d->diskCachePath.clear();
+    if (group->GetBool("DiskCache", true)) {
+        QDir dir(QString::fromStdString(App::Application::getUserCachePath()));
+        if (dir.mkpath(QLatin1String("IconCache"))) {
+            d->diskCachePath = dir.filePath(QLatin1String("IconCache")) + QLatin1Char('/');
+        }
+    }
+}
+
 void BitmapFactoryInst::addPath(const QString& path)
 {
     QDir::addSearchPath(QStringLiteral("icons"), path);
@@ -198,11 +234,7 @@ bool BitmapFactoryInst::loadPixmap(const QString& filename, QPixmap& icon) const
     if (fi.exists()) {
         // first check if it's an SVG because Qt's qsvg4 module shouldn't be used therefore
         if (fi.suffix().toLower() == QLatin1String("svg")) {
-            QFile svgFile(fi.filePath());
-            if (svgFile.open(QFile::ReadOnly | QFile::Text)) {
-                QByteArray content = svgFile.readAll();
-                icon = pixmapFromSvg(content, QSize(64,64));
-            }
+            icon = pixmapFromSvgFile(fi.filePath(), QSize(64,64), ColorMap());
         }
         else {
             // try with Qt plugins
@@ -300,11 +332,7 @@ QPixmap BitmapFactoryInst::pixmapFromSvg(const char* name, const QSizeF& size,
     }
 
     if (!iconPath.isEmpty()) {
-        QFile file(iconPath);
-        if (file.open(QFile::ReadOnly | QFile::Text)) {
-            QByteArray content = file.readAll();
-            icon = pixmapFromSvg(content, size * dpr, colorMapping);
-        }
+        icon = pixmapFromSvgFile(iconPath, size * dpr, colorMapping);
     }
 
     if (!icon.isNull()) {
@@ -314,6 +342,37 @@ QPixmap BitmapFactoryInst::pixmapFromSvg(const char* name, const QSizeF& size,
     return icon;
 }
 
+QPixmap BitmapFactoryInst::pixmapFromSvgFile(const QString& path, const QSizeF& size,
+                                             const ColorMap& colorMapping) const
+{
+    QFileInfo fi(path);
+    QString cacheFile;
+    if (!d->diskCachePath.isEmpty()) {
+        cacheFile = d->diskCacheFile(fi, size.toSize(), colorMapping);
+        QPixmap icon;
+        if (icon.load(cacheFile, "PNG")) {
+            return icon;
+        }
+    }
+
+    QPixmap icon;
+    QFile file(fi.filePath());
+    if (file.open(QFile::ReadOnly | QFile::Text)) {
+        QByteArray content = file.readAll();
+        icon = pixmapFromSvg(content, size, colorMapping);
+    }
+
+    // Write to a temporary file first, another instance might read the cache
+    if (!icon.isNull() && !cacheFile.isEmpty()) {
+        QSaveFile cache(cacheFile);
+        if (cache.open(QIODevice::WriteOnly) && icon.save(&cache, "PNG")) {
+            cache.commit();
+        }
+    }
+
+    return icon;
+}
+
 QPixmap BitmapFactoryInst::pixmapFromSvg(const QByteArray& originalContents, const QSizeF& size,
                                          const ColorMap& colorMapping) const
 {
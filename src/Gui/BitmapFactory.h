@@ -150,8 +150,12 @@ public:
 
 private:
     bool loadPixmap(const QString& path, QPixmap&) const;
+    /// Rasterize an SVG file, or take the pixmap from the disk cache
+    QPixmap pixmapFromSvgFile(const QString& path, const QSizeF& size,
+                              const ColorMap& colorMapping) const;
     void restoreCustomPaths();
     void configureUseIconTheme();
+    void configureDiskCache();
 
     static BitmapFactoryInst* _pcSingleton;
     BitmapFactoryInst();
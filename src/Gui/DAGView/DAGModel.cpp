@@ -22,6 +22,8 @@
 
 #include <boost/graph/topological_sort.hpp>
 #include <boost_graph_reverse_graph.hpp>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <QBrush>
 #include <QColor>
@@ -221,8 +223,6 @@ void Model::slotNewObject(const ViewProviderDocumentObject &VPDObjectIn)
 {
   Vertex virginVertex = boost::add_vertex(*theGraph);
 
-  addVertexItemsToScene(virginVertex);
-
   GraphLinkRecord virginRecord;
   virginRecord.DObject = VPDObjectIn.getObject();
   virginRecord.VPDObject = &VPDObjectIn;
@@ -245,6 +245,8 @@ void Model::slotNewObject(const ViewProviderDocumentObject &VPDObjectIn)
           std::bind(&Model::slotChangeIcon, this, boost::cref(VPDObjectIn), icon));
   //NOLINTEND
 
+  //items are added to the scene once the vertex has a row in the visible area.
+  dirtyVertices.insert(virginVertex);
   graphDirty = true;
   lastAddedVertex = Graph::null_vertex();
 }
@@ -263,15 +265,17 @@ void Model::slotDeleteObject(const ViewProviderDocumentObject &VPDObjectIn)
   removeVertexItemsFromScene(vertex);
 
   //remove connector items
-  auto outRange = boost::out_edges(vertex, *theGraph);
-  for (auto outEdgeIt = outRange.first; outEdgeIt != outRange.second; ++outEdgeIt)
-    this->removeItem((*theGraph)[*outEdgeIt].connector.get());
+  removeOutConnectorsFromScene(vertex);
   auto inRange = boost::in_edges(vertex, *theGraph);
   for (auto inEdgeIt = inRange.first; inEdgeIt != inRange.second; ++inEdgeIt)
-    this->removeItem((*theGraph)[*inEdgeIt].connector.get());
+  {
+    if ((*theGraph)[*inEdgeIt].connector->scene())
+      this->removeItem((*theGraph)[*inEdgeIt].connector.get());
+  }
 
   if (vertex == lastAddedVertex)
     lastAddedVertex = Graph::null_vertex();
+  dirtyVertices.erase(vertex);
 
   (*theGraph)[vertex].connChangeIcon.disconnect();
 
@@ -302,14 +306,24 @@ void Model::slotChangeObject(const ViewProviderDocumentObject &VPDObjectIn, cons
       const GraphLinkRecord &record = findRecord(&VPDObjectIn, *graphLink);
       auto text = (*theGraph)[record.vertex].text.get();
       text->setPlainText(QString::fromUtf8(record.DObject->Label.getValue()));
+      (*theGraph)[record.vertex].textWidth = text->boundingRect().width();
+      (*theGraph)[record.vertex].textDirty = false;
+      graphDirty = true; //row width follows the longest text.
     }
   }
   else if (propertyIn.isDerivedFrom<App::PropertyLinkBase>())
   {
     if (hasRecord(&VPDObjectIn, *graphLink))
     {
+      //only the links of this object changed, the edges into it are still valid.
       const GraphLinkRecord &record = findRecord(&VPDObjectIn, *graphLink);
-      boost::clear_vertex(record.vertex, *theGraph);
+      removeOutConnectorsFromScene(record.vertex);
+      auto outRange = boost::out_edges(record.vertex, *theGraph);
+      std::vector<Edge> outEdges(outRange.first, outRange.second);
+      for (const auto &currentEdge : outEdges)
+        boost::remove_edge(currentEdge, *theGraph);
+      (*theGraph)[record.vertex].placementDirty = true;
+      dirtyVertices.insert(record.vertex);
       graphDirty = true;
     }
   }
@@ -451,49 +465,39 @@ void Model::updateSlot()
   //empty outList means it is a root.
   //empty inList means it is a leaf.
 
-  //NOTE: some of the following loops can/should be combined
-  //for speed. Not doing yet, as I want a simple algorithm until
-  //a more complete picture is formed.
-
   Base::TimeElapsed startTime;
 
-  //here we will cycle through the graph updating edges.
+  //here we will cycle through the changed vertices updating edges.
   //we have to do this first and in isolation because everything is dependent on an up to date graph.
-  BGL_FORALL_VERTICES(currentVertex, *theGraph, Graph)
+  //only new and relinked vertices are visited, the edges of the others are still valid.
+  auto addConnection = [this](const Vertex &sourceIn, const Vertex &targetIn)
   {
-    const App::DocumentObject *currentDObject = findRecord(currentVertex, *graphLink).DObject;
-    std::vector<App::DocumentObject *> otherDObjects = currentDObject->getOutList();
-    for (auto &currentOtherDObject : otherDObjects)
+    bool result;
+    Edge edge;
+    boost::tie(edge, result) = boost::add_edge(sourceIn, targetIn, *theGraph);
+    if (result)
     {
-      if (!hasRecord(currentOtherDObject, *graphLink))
-          continue;
-      Vertex otherVertex = findRecord(currentOtherDObject, *graphLink).vertex;
-      bool result;
-      Edge edge;
-      boost::tie(edge, result) = boost::add_edge(currentVertex, otherVertex, *theGraph);
-      if (result)
-      {
-        (*theGraph)[edge].connector = std::make_shared<QGraphicsPathItem>();
-        (*theGraph)[edge].connector->setZValue(0.0);
-      }
+      (*theGraph)[edge].connector = std::make_shared<QGraphicsPathItem>();
+      (*theGraph)[edge].connector->setZValue(0.0);
+      (*theGraph)[sourceIn].placementDirty = true; //connectors are drawn from the source.
     }
-  }
-
-  BGL_FORALL_VERTICES(currentVertex, *theGraph, Graph)
-  {
-    if (!(*theGraph)[currentVertex].rectangle->scene())
-      addVertexItemsToScene(currentVertex);
-  }
-
-  //sync scene items for graph edge.
-  BGL_FORALL_EDGES(currentEdge, *theGraph, Graph)
+  };
+  for (const auto &currentVertex : dirtyVertices)
   {
-    Vertex source = boost::source(currentEdge, *theGraph);
-    Vertex target = boost::target(currentEdge, *theGraph);
-
-    if (!(*theGraph)[currentEdge].connector->scene())
-      this->addItem((*theGraph)[currentEdge].connector.get());
+    const App::DocumentObject *currentDObject = findRecord(currentVertex, *graphLink).DObject;
+    for (auto &currentOtherDObject : currentDObject->getOutList())
+    {
+      if (hasRecord(currentOtherDObject, *graphLink))
+        addConnection(currentVertex, findRecord(currentOtherDObject, *graphLink).vertex);
+    }
+    //objects already linking to a new object.
+    for (auto &currentOtherDObject : currentDObject->getInList())
+    {
+      if (hasRecord(currentOtherDObject, *graphLink))
+        addConnection(findRecord(currentOtherDObject, *graphLink).vertex, currentVertex);
+    }
   }
+  dirtyVertices.clear();
 
   indexVerticesEdges();
   Path sorted;
@@ -516,7 +520,8 @@ void Model::updateSlot()
     tempIndex++;
   }
 
-  //draw graph(nodes and connectors).
+  //assign rows and columns. this is cheap and done for the whole graph, the items
+  //are only touched below for the vertices that moved or got new connections.
   int currentRow = 0;
   int currentColumn = -1; //we know first column is going to be root so will be kicked up to 0.
   int maxColumn = currentColumn; //used for determining offset of icons and text.
@@ -535,8 +540,6 @@ void Model::updateSlot()
       boost::tie(it, itEnd) = boost::out_edges(currentVertex, *theGraph);
       for (;it != itEnd; ++it)
       {
-//         std::cout << std::endl << "name: " << findRecord(currentVertex, *graphLink).DObject->Label.getValue() << std::endl;
-
         Vertex target = boost::target(*it, *theGraph);
         parentVertices.push_back(target);
         int currentParentIndex = (*theGraph)[target].topoSortIndex;
@@ -546,22 +549,11 @@ void Model::updateSlot()
           Path::const_iterator end = sorted.begin() + (*theGraph)[currentVertex].topoSortIndex; // 1 before
           Path::const_iterator it;
           for (it = start; it != end; ++it)
-          {
-//             std::cout << "    parent: " << findRecord(*it, *graphLink).DObject->Label.getValue() << std::endl;
-
             columnMask |= (*theGraph)[*it].column;
-          }
           farthestParentIndex = currentParentIndex;
         }
       }
 
-      //have to create a smaller subset to get through std::cout.
-//       std::bitset<8> testSet;
-//       for (unsigned int index = 0; index < testSet.size(); ++index)
-//         testSet[index]= columnMask[index];
-//       std::cout << "mask for " << findRecord(currentVertex, *graphLink).DObject->Label.getValue() << "      " <<
-//         testSet.to_string() << std::endl;
-
       //now we should have a mask representing the columns that are being used.
       //this is from the lowest parent, in the topo sort, to last entry.
 
@@ -595,132 +587,218 @@ void Model::updateSlot()
     assert(currentColumn < static_cast<int>(ColumnMask().size())); //temp limitation.
 
     maxColumn = std::max(currentColumn, maxColumn);
-    QBrush currentBrush(forgroundBrushes.at(currentColumn % forgroundBrushes.size()));
 
-    auto rectangle = (*theGraph)[currentVertex].rectangle.get();
-    rectangle->setRect(-rowPadding, 0.0, rowPadding, rowHeight); //calculate actual length later.
-    rectangle->setTransform(QTransform::fromTranslate(0, rowHeight * currentRow));
-    rectangle->setBackgroundBrush(backgroundBrushes[currentRow % backgroundBrushes.size()]);
+    VertexProperty &property = (*theGraph)[currentVertex];
+    if (property.textDirty)
+    {
+      auto text = property.text.get();
+      text->setPlainText(QString::fromUtf8(findRecord(currentVertex, *graphLink).DObject->Label.getValue()));
+      property.textWidth = text->boundingRect().width();
+      property.textDirty = false;
+    }
+    maxTextLength = std::max(maxTextLength, property.textWidth);
 
-    auto point = (*theGraph)[currentVertex].point.get();
-    point->setRect(0.0, 0.0, pointSize, pointSize);
-    point->setTransform(QTransform::fromTranslate(pointSpacing * static_cast<qreal>(currentColumn),
-      rowHeight * currentRow + rowHeight / 2.0 - pointSize / 2.0));
-    point->setBrush(currentBrush);
+    //store column and row int the graph. use for connectors later.
+    ColumnMask currentMask;
+    currentMask.set(currentColumn);
+    if (property.row != currentRow || property.column != currentMask)
+      property.placementDirty = true;
+    property.row = currentRow;
+    property.column = currentMask;
 
-    qreal cheat = 0.0;
-    if (direction == -1)
-      cheat = rowHeight;
+    currentRow++;
+  }
 
-    auto visiblePixmap = (*theGraph)[currentVertex].visibleIcon.get();
-    visiblePixmap->setTransform(QTransform::fromTranslate(0.0, rowHeight * currentRow + cheat)); //calculate x location later.
+  //more columns move the icons and text of every row. a longer text widens every row.
+  bool placeAll = (maxColumn != lastMaxColumn) || (maxTextLength != lastMaxTextLength);
+  lastMaxColumn = maxColumn;
+  lastMaxTextLength = maxTextLength;
 
-    auto statePixmap = (*theGraph)[currentVertex].stateIcon.get();
-    statePixmap->setTransform(QTransform::fromTranslate(0.0, rowHeight * currentRow + cheat)); //calculate x location later.
+  qreal columnSpacing = (maxColumn * pointSpacing);
+  qreal rowWidth = columnSpacing + pointToIcon + 3.0 * iconSize + 2.0 * iconToIcon + iconToText
+    + maxTextLength + 2.0 * rowPadding;
 
-    auto pixmap = (*theGraph)[currentVertex].icon.get();
-    pixmap->setTransform(QTransform::fromTranslate(0.0, rowHeight * currentRow + cheat)); //calculate x location later.
+  //our list is topo sorted so all dependents are placed before their connectors are built.
+  std::vector<bool> moved(sorted.size(), false);
+  for (const auto &currentVertex : sorted)
+  {
+    VertexProperty &property = (*theGraph)[currentVertex];
+    bool placeItems = placeAll || property.placementDirty;
+    bool placeLinks = placeItems;
+    OutEdgeIterator it, itEnd;
+    for (boost::tie(it, itEnd) = boost::out_edges(currentVertex, *theGraph); it != itEnd && !placeLinks; ++it)
+      placeLinks = moved[(*theGraph)[boost::target(*it, *theGraph)].topoSortIndex];
+
+    if (placeItems)
+      placeVertexItems(currentVertex, columnSpacing, rowWidth);
+    if (placeLinks)
+      placeConnectors(currentVertex);
+    moved[property.topoSortIndex] = placeItems;
+    property.placementDirty = false;
+  }
 
-    auto text = (*theGraph)[currentVertex].text.get();
-    text->setPlainText(QString::fromUtf8(findRecord(currentVertex, *graphLink).DObject->Label.getValue()));
-    text->setDefaultTextColor(currentBrush.color());
-    maxTextLength = std::max(maxTextLength, text->boundingRect().width());
-    text->setTransform(QTransform::fromTranslate
-      (0.0, rowHeight * currentRow - verticalSpacing * 2.0 + cheat)); //calculate x location later.
-    (*theGraph)[currentVertex].lastVisibleState = VisibilityState::None; //force visual update for color.
+  //only the visible rows are in the scene, so the scene can't size itself from the items.
+  this->setSceneRect(QRectF(-rowPadding, 0.0, rowWidth, rowHeight * currentRow).normalized());
 
-    //store column and row int the graph. use for connectors later.
-    (*theGraph)[currentVertex].row = currentRow;
-    (*theGraph)[currentVertex].column.reset().set((currentColumn));
+  //Modeling_Challenge_Casting_ta4 with 59 features: "Initialize DAG View time: 0.007"
+  //keeping algo simple with extra loops only added 0.002 to above number.
+//   std::cout << "Initialize DAG View time: " << Base::TimeElapsed::diffTimeF(startTime, Base::TimeElapsed()) << std::endl;
 
-    //our list is topo sorted so all dependents should be located, so we can build the connectors.
-    //will have some more logic for connector path, simple for now.
-    qreal currentX = pointSpacing * currentColumn + pointSize / 2.0;
-    qreal currentY = rowHeight * currentRow + rowHeight / 2.0;
-    OutEdgeIterator it, itEnd;
-    boost::tie(it, itEnd) = boost::out_edges(currentVertex, *theGraph);
-    for (; it != itEnd; ++it)
+//   outputGraphviz<Graph>(*theGraph, "./graphviz.dot");
+  graphDirty = false;
+  syncVisibleItems();
+}
+
+void Model::placeVertexItems(const Vertex &vertexIn, qreal columnSpacing, qreal rowWidth)
+{
+  VertexProperty &property = (*theGraph)[vertexIn];
+  int currentRow = property.row;
+  int currentColumn = static_cast<int>(columnFromMask(property.column));
+  QBrush currentBrush(forgroundBrushes.at(currentColumn % forgroundBrushes.size()));
+
+  auto rectangle = property.rectangle.get();
+  rectangle->setRect(-rowPadding, 0.0, rowWidth, rowHeight);
+  rectangle->setTransform(QTransform::fromTranslate(0, rowHeight * currentRow));
+  rectangle->setBackgroundBrush(backgroundBrushes[currentRow % backgroundBrushes.size()]);
+
+  auto point = property.point.get();
+  point->setRect(0.0, 0.0, pointSize, pointSize);
+  point->setTransform(QTransform::fromTranslate(pointSpacing * static_cast<qreal>(currentColumn),
+    rowHeight * currentRow + rowHeight / 2.0 - pointSize / 2.0));
+  point->setBrush(currentBrush);
+
+  qreal cheat = 0.0;
+  if (direction == -1)
+    cheat = rowHeight;
+  qreal currentY = rowHeight * currentRow + cheat;
+
+  qreal localCurrentX = columnSpacing;
+  localCurrentX += pointToIcon;
+  property.visibleIcon->setTransform(QTransform::fromTranslate(localCurrentX, currentY));
+
+  localCurrentX += iconSize + iconToIcon;
+  property.stateIcon->setTransform(QTransform::fromTranslate(localCurrentX, currentY));
+
+  localCurrentX += iconSize + iconToIcon;
+  property.icon->setTransform(QTransform::fromTranslate(localCurrentX, currentY));
+
+  localCurrentX += iconSize + iconToText;
+  auto text = property.text.get();
+  text->setDefaultTextColor(currentBrush.color());
+  text->setTransform(QTransform::fromTranslate(localCurrentX, currentY - verticalSpacing * 2.0));
+  property.lastVisibleState = VisibilityState::None; //force visual update for color.
+}
+
+void Model::placeConnectors(const Vertex &vertexIn)
+{
+  //will have some more logic for connector path, simple for now.
+  int currentColumn = static_cast<int>(columnFromMask((*theGraph)[vertexIn].column));
+  qreal currentX = pointSpacing * currentColumn + pointSize / 2.0;
+  qreal currentY = rowHeight * (*theGraph)[vertexIn].row + rowHeight / 2.0;
+  OutEdgeIterator it, itEnd;
+  boost::tie(it, itEnd) = boost::out_edges(vertexIn, *theGraph);
+  for (; it != itEnd; ++it)
+  {
+    Vertex target = boost::target(*it, *theGraph);
+    int dependentColumn = static_cast<int>(columnFromMask((*theGraph)[target].column));
+    qreal dependentX = pointSpacing * dependentColumn + pointSize / 2.0; //on center.
+    qreal dependentY = rowHeight * (*theGraph)[target].row + rowHeight / 2.0;
+
+    QGraphicsPathItem *pathItem = (*theGraph)[*it].connector.get();
+    pathItem->setBrush(Qt::NoBrush);
+    QPainterPath path;
+    path.moveTo(currentX, currentY);
+    if (currentColumn == dependentColumn)
+      path.lineTo(currentX, dependentY); //straight connector in y.
+    else
     {
-      Vertex target = boost::target(*it, *theGraph);
-      qreal dependentX = pointSpacing * static_cast<int>(columnFromMask((*theGraph)[target].column)) + pointSize / 2.0; //on center.
-      columnFromMask((*theGraph)[target].column);
-      qreal dependentY = rowHeight * (*theGraph)[target].row + rowHeight / 2.0;
-
-      QGraphicsPathItem *pathItem = (*theGraph)[*it].connector.get();
-      pathItem->setBrush(Qt::NoBrush);
-      QPainterPath path;
-      path.moveTo(currentX, currentY);
-      if (currentColumn == static_cast<int>(columnFromMask((*theGraph)[target].column)))
-        path.lineTo(currentX, dependentY); //straight connector in y.
-      else
-      {
-        //connector with bend.
-        qreal radius = pointSpacing / 1.9; //no zero length line.
+      //connector with bend.
+      qreal radius = pointSpacing / 1.9; //no zero length line.
 
-        path.lineTo(currentX, dependentY + radius * direction);
+      path.lineTo(currentX, dependentY + radius * direction);
 
-        qreal yPosition;
-        if (direction == -1.0)
-          yPosition = dependentY - 2.0 * radius;
-        else
-          yPosition = dependentY;
-        qreal width = 2.0 * radius;
-        qreal height = width;
-        if (dependentX > currentX) //radius to the right.
-        {
-          QRectF arcRect(currentX, yPosition, width, height);
-          path.arcTo(arcRect, 180.0, 90.0 * -direction);
-        }
-        else //radius to the left.
-        {
-          QRectF arcRect(currentX - 2.0 * radius, yPosition, width, height);
-          path.arcTo(arcRect, 0.0, 90.0 * direction);
-        }
-        path.lineTo(dependentX, dependentY);
+      qreal yPosition;
+      if (direction == -1.0)
+        yPosition = dependentY - 2.0 * radius;
+      else
+        yPosition = dependentY;
+      qreal width = 2.0 * radius;
+      qreal height = width;
+      if (dependentX > currentX) //radius to the right.
+      {
+        QRectF arcRect(currentX, yPosition, width, height);
+        path.arcTo(arcRect, 180.0, 90.0 * -direction);
+      }
+      else //radius to the left.
+      {
+        QRectF arcRect(currentX - 2.0 * radius, yPosition, width, height);
+        path.arcTo(arcRect, 0.0, 90.0 * direction);
       }
-      pathItem->setPath(path);
+      path.lineTo(dependentX, dependentY);
     }
-
-    currentRow++;
+    pathItem->setPath(path);
   }
+}
 
-  //now that we have the graph drawn we know where to place icons and text.
-  qreal columnSpacing = (maxColumn * pointSpacing);
-  for (const auto &currentVertex : sorted)
+void Model::setVisibleRect(const QRectF &rectIn)
+{
+  visibleRect = rectIn;
+  auto rows = visibleRows();
+  //scrolling inside the rows already in the scene.
+  if (rows.first >= firstSceneRow && rows.second <= lastSceneRow)
+    return;
+  syncVisibleItems();
+}
+
+std::pair<int, int> Model::visibleRows() const
+{
+  if (visibleRect.isNull())
+    return std::make_pair(0, std::numeric_limits<int>::max());
+  qreal top = visibleRect.top() / rowHeight;
+  qreal bottom = visibleRect.bottom() / rowHeight;
+  return std::make_pair(static_cast<int>(std::floor(std::min(top, bottom))),
+                        static_cast<int>(std::ceil(std::max(top, bottom))));
+}
+
+void Model::syncVisibleItems()
+{
+  //rows are assigned on the next update.
+  if (graphDirty)
+    return;
+
+  //keep a page of rows before and after the view, so scrolling doesn't touch the scene every step.
+  auto rows = visibleRows();
+  if (!visibleRect.isNull())
   {
-    qreal localCurrentX = columnSpacing;
-    localCurrentX += pointToIcon;
-    auto visiblePixmap = (*theGraph)[currentVertex].visibleIcon.get();
-    QTransform visibleIconTransform = QTransform::fromTranslate(localCurrentX, 0.0);
-    visiblePixmap->setTransform(visiblePixmap->transform() * visibleIconTransform);
-
-    localCurrentX += iconSize + iconToIcon;
-    auto statePixmap = (*theGraph)[currentVertex].stateIcon.get();
-    QTransform stateIconTransform = QTransform::fromTranslate(localCurrentX, 0.0);
-    statePixmap->setTransform(statePixmap->transform() * stateIconTransform);
-
-    localCurrentX += iconSize + iconToIcon;
-    auto pixmap = (*theGraph)[currentVertex].icon.get();
-    QTransform iconTransform = QTransform::fromTranslate(localCurrentX, 0.0);
-    pixmap->setTransform(pixmap->transform() * iconTransform);
-
-    localCurrentX += iconSize + iconToText;
-    auto text = (*theGraph)[currentVertex].text.get();
-    QTransform textTransform = QTransform::fromTranslate(localCurrentX, 0.0);
-    text->setTransform(text->transform() * textTransform);
-
-    auto rectangle = (*theGraph)[currentVertex].rectangle.get();
-    QRectF rect = rectangle->rect();
-    rect.setWidth(localCurrentX + maxTextLength + 2.0 * rowPadding);
-    rectangle->setRect(rect);
+    int pageRows = rows.second - rows.first + 1;
+    rows.first -= pageRows;
+    rows.second += pageRows;
   }
+  firstSceneRow = rows.first;
+  lastSceneRow = rows.second;
 
-  //Modeling_Challenge_Casting_ta4 with 59 features: "Initialize DAG View time: 0.007"
-  //keeping algo simple with extra loops only added 0.002 to above number.
-//   std::cout << "Initialize DAG View time: " << Base::TimeElapsed::diffTimeF(startTime, Base::TimeElapsed()) << std::endl;
+  BGL_FORALL_VERTICES(currentVertex, *theGraph, Graph)
+  {
+    int row = (*theGraph)[currentVertex].row;
+    if (row >= firstSceneRow && row <= lastSceneRow)
+      addVertexItemsToScene(currentVertex);
+    else
+      removeVertexItemsFromScene(currentVertex);
+  }
 
-//   outputGraphviz<Graph>(*theGraph, "./graphviz.dot");
-  graphDirty = false;
+  //connectors are needed as long as they cross the rows in the scene.
+  BGL_FORALL_EDGES(currentEdge, *theGraph, Graph)
+  {
+    int sourceRow = (*theGraph)[boost::source(currentEdge, *theGraph)].row;
+    int targetRow = (*theGraph)[boost::target(currentEdge, *theGraph)].row;
+    bool visible = std::max(sourceRow, targetRow) >= firstSceneRow &&
+      std::min(sourceRow, targetRow) <= lastSceneRow;
+    auto connector = (*theGraph)[currentEdge].connector.get();
+    if (visible && !connector->scene())
+      this->addItem(connector);
+    else if (!visible && connector->scene())
+      this->removeItem(connector);
+  }
 }
 
 void Model::indexVerticesEdges()
@@ -773,6 +851,16 @@ void Model::addVertexItemsToScene(const Gui::DAG::Vertex& vertexIn)
   this->addItem((*theGraph)[vertexIn].text.get());
 }
 
+void Model::removeOutConnectorsFromScene(const Gui::DAG::Vertex& vertexIn)
+{
+  auto outRange = boost::out_edges(vertexIn, *theGraph);
+  for (auto outEdgeIt = outRange.first; outEdgeIt != outRange.second; ++outEdgeIt)
+  {
+    if ((*theGraph)[*outEdgeIt].connector->scene())
+      this->removeItem((*theGraph)[*outEdgeIt].connector.get());
+  }
+}
+
 void Model::removeVertexItemsFromScene(const Gui::DAG::Vertex& vertexIn)
 {
   //these are either all in or all out. so just test rectangle.
@@ -793,6 +881,10 @@ void Model::updateStates()
 
   BGL_FORALL_VERTICES(currentVertex, *theGraph, Graph)
   {
+    //rows outside of the scene are updated when they are scrolled in.
+    if (!(*theGraph)[currentVertex].rectangle->scene())
+      continue;
+
     const GraphLinkRecord &record = findRecord(currentVertex, *graphLink);
 
     auto visiblePixmap = (*theGraph)[currentVertex].visibleIcon.get();
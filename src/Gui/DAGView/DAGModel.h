@@ -24,6 +24,8 @@
 #define DAGMODEL_H
 
 #include <memory>
+#include <set>
+#include <utility>
 #include <vector>
 
 #include <boost/signals2.hpp>
@@ -67,6 +69,7 @@ namespace Gui
       ~Model() override;
       void awake(); //!< hooked up to event dispatcher for update when idle.
       void selectionChanged(const SelectionChanges& msg);
+      void setVisibleRect(const QRectF &rectIn); //!< only rows near this scene area get items.
 
     protected:
       void mouseMoveEvent(QGraphicsSceneMouseEvent* event) override;
@@ -105,11 +108,23 @@ namespace Gui
       std::shared_ptr<GraphLinkContainer> graphLink;
       std::shared_ptr<Graph> theGraph;
       bool graphDirty;
+      std::set<Vertex> dirtyVertices; //!< new or relinked vertices, their edges are rebuilt.
+      int lastMaxColumn = -1; //!< column count of the last layout.
+      qreal lastMaxTextLength = 0.0; //!< text length of the last layout.
+
+      QRectF visibleRect; //!< scene area of the view. null means all rows.
+      int firstSceneRow = 0; //!< first row with items in the scene.
+      int lastSceneRow = -1; //!< last row with items in the scene.
+      std::pair<int, int> visibleRows() const; //!< first and last row in visibleRect.
+      void syncVisibleItems(); //!< add and remove items following the visible rows.
 
       void indexVerticesEdges();
       void removeAllItems();
       void addVertexItemsToScene(const Vertex &vertexIn);
       void removeVertexItemsFromScene(const Vertex &vertexIn);
+      void removeOutConnectorsFromScene(const Vertex &vertexIn);
+      void placeVertexItems(const Vertex &vertexIn, qreal columnSpacing, qreal rowWidth);
+      void placeConnectors(const Vertex &vertexIn);
       void updateStates();
       std::size_t columnFromMask(const ColumnMask&);
 
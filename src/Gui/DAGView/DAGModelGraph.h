@@ -85,6 +85,9 @@ namespace Gui
       int row = 0; //!< row for this entry.
       ColumnMask column = 0; //!< column number containing the point.
       int topoSortIndex = 0;
+      qreal textWidth = 0.0; //!< width of text, kept for the layout.
+      bool textDirty = true; //!< text has to be set from the label.
+      bool placementDirty = true; //!< items have to be placed again.
       VisibilityState lastVisibleState = VisibilityState::None; //!< visibility test.
       FeatureState lastFeatureState = FeatureState::None; //!< feature state test.
     };
@@ -68,11 +68,11 @@ void View::slotActiveDocument(const Document &documentIn)
   {
     ModelMap::value_type entry(std::make_pair(&documentIn, std::make_shared<Model>(this, documentIn)));
     modelMap.insert(entry);
-    this->setScene(entry.second.get());
+    setModel(entry.second.get());
   }
   else
   {
-    this->setScene(it->second.get());
+    setModel(it->second.get());
   }
 }
 
@@ -83,6 +83,36 @@ void View::slotDeleteDocument(const Document &documentIn)
     modelMap.erase(it);
 }
 
+void View::setModel(Model *modelIn)
+{
+  if (this->scene() == modelIn)
+    return;
+  this->setScene(modelIn);
+  //the model only keeps items for the rows around the view.
+  connect(modelIn, &QGraphicsScene::sceneRectChanged, this, &View::updateVisibleRect,
+          Qt::UniqueConnection);
+  updateVisibleRect();
+}
+
+void View::updateVisibleRect()
+{
+  Model *model = dynamic_cast<Model *>(this->scene());
+  if (model)
+    model->setVisibleRect(this->mapToScene(this->viewport()->rect()).boundingRect());
+}
+
+void View::scrollContentsBy(int dx, int dy)
+{
+  QGraphicsView::scrollContentsBy(dx, dy);
+  updateVisibleRect();
+}
+
+void View::resizeEvent(QResizeEvent *event)
+{
+  QGraphicsView::resizeEvent(event);
+  updateVisibleRect();
+}
+
 void View::awakeSlot()
 {
   Model *model = dynamic_cast<Model *>(this->scene());
@@ -116,7 +146,7 @@ void View::onSelectionChanged(const SelectionChanges& msg)
   auto &model = modelMap[doc];
   if(!model)
     model = std::make_shared<Model>(this, *doc);
-  this->setScene(model.get());
+  setModel(model.get());
   model->selectionChanged(msg);
 }
 
@@ -49,8 +49,14 @@ namespace Gui
     public Q_SLOTS:
       void awakeSlot(); //!< hooked up to event dispatcher for update when idle.
 
+    protected:
+      void scrollContentsBy(int dx, int dy) override;
+      void resizeEvent(QResizeEvent *event) override;
+
     private:
       void onSelectionChanged(const SelectionChanges& msg) override;
+      void updateVisibleRect(); //!< tell the model which rows are shown.
+      void setModel(Model *modelIn);
 
       void slotActiveDocument(const Gui::Document &documentIn);
       void slotDeleteDocument(const Gui::Document &documentIn);
@@ -20,6 +20,7 @@
  *                                                                         *
  ***************************************************************************/
 
+# include <algorithm>
 # include <tuple>
 # include <memory>
 # include <list>
@@ -515,6 +516,9 @@ Document::Document(App::Document* pcDocument,Application * app)
         d->_pcDocument->setUndoMode(1);
         // set the maximum stack size
         d->_pcDocument->setMaxUndoStackSize(hGrp->GetInt("MaxUndoSize",20));
+        // and the memory budget in MB, zero for no limit
+        long limit = std::clamp<long>(hGrp->GetInt("UndoMemoryLimit", 0), 0, 4095);
+        d->_pcDocument->setUndoLimit(static_cast<unsigned int>(limit) * 1024U * 1024U);
     }
 
     d->_changeViewTouchDocument = hGrp->GetBool("ChangeViewProviderTouchDocument", true);
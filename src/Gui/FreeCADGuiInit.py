@@ -188,7 +188,7 @@ Gui.InputHint = InputHint
 Gui.HintManager = HintManager()
 
 def InitApplications():
-    import sys,os,traceback
+    import sys,os,time,traceback
     import io as cStringIO
   
     # Searching modules dirs +++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -200,6 +200,7 @@ def InitApplications():
     def RunInitGuiPy(Dir) -> bool:
         InstallFile = os.path.join(Dir,"InitGui.py")
         if os.path.exists(InstallFile):
+            start = time.perf_counter()
             try:
                 with open(InstallFile, 'rt', encoding='utf-8') as f:
                     exec(compile(f.read(), InstallFile, 'exec'))
@@ -223,12 +224,42 @@ def InitApplications():
                     Err(f"A fallback module was found for module '{mod_name}': {new_path}\n")
                     Err(f"Rename or remove {os.path.normpath(Dir)} to use the fallback module\n")
             else:
-                Log('Init:      Initializing ' + Dir + '... done\n')
+                elapsed = (time.perf_counter() - start) * 1000
+                Log(f'Init:      Initializing {Dir}... done ({elapsed:.1f} ms)\n')
                 return True
         else:
             Log('Init:      Initializing ' + Dir + '(InitGui.py not found)... ignore\n')
         return False
 
+    # Workbenches described by a package.xml can be registered from their metadata
+    # and only run their InitGui.py when they are activated for the first time
+    DeferLoading = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/General")\
+        .GetBool("DeferredWorkbenchLoading", False)
+
+    def addDeferredWorkbench(Dir, subdirectory, workbench_metadata):
+        classname = workbench_metadata.Classname
+
+        def deferredInit(self):
+            # the real handler is registered under the same name by InitGui.py
+            FreeCAD.Gui.removeWorkbench(classname)
+            if RunInitGuiPy(subdirectory):
+                try:
+                    wb_handle = FreeCAD.Gui.getWorkbench(classname)
+                except Exception:
+                    Log(f"Failed to get handle to {classname} -- no icon\
+                        can be generated,\n check classname in package.xml\n")
+                else:
+                    GeneratePackageIcon(Dir, subdirectory, workbench_metadata, wb_handle)
+
+        placeholder = type(classname, (Workbench,), {
+            "MenuText": workbench_metadata.Name,
+            "ToolTip": workbench_metadata.Description,
+            "__DeferredInit__": deferredInit,
+        })()
+        GeneratePackageIcon(Dir, subdirectory, workbench_metadata, placeholder)
+        FreeCAD.Gui.addWorkbench(placeholder)
+        Log('Init:      Deferring ' + subdirectory + '\n')
+
     def processMetadataFile(Dir, MetadataFile):
         meta = FreeCAD.Metadata(MetadataFile)
         if not meta.supportsCurrentFreeCAD():
@@ -245,6 +276,10 @@ def InitApplications():
                     else workbench_metadata.Subdirectory
                 subdirectory = subdirectory.replace("/",os.path.sep)
                 subdirectory = os.path.join(Dir, subdirectory)
+                if DeferLoading and workbench_metadata.Classname and\
+                        os.path.exists(os.path.join(subdirectory, "InitGui.py")):
+                    addDeferredWorkbench(Dir, subdirectory, workbench_metadata)
+                    continue
                 ran_init = RunInitGuiPy(subdirectory)
 
                 if ran_init:
@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include <Inventor/actions/SoGLRenderAction.h>
+#include <Inventor/actions/SoSearchAction.h>
+#include <Inventor/elements/SoModelMatrixElement.h>
+#include <Inventor/misc/SoChildList.h>
+#include <Inventor/misc/SoState.h>
+
+#include "SoFCInstancedArray.h"
+
+
+using namespace Gui;
+
+SO_ELEMENT_SOURCE(SoFCInstancedElement)
+
+void SoFCInstancedElement::initClass()
+{
+    SO_ELEMENT_INIT_CLASS(SoFCInstancedElement, inherited);
+    SO_ENABLE(SoGLRenderAction, SoFCInstancedElement);
+}
+
+void SoFCInstancedElement::init(SoState * state)
+{
+    inherited::init(state);
+    this->data = 0;
+}
+
+SoFCInstancedElement::~SoFCInstancedElement() = default;
+
+void SoFCInstancedElement::set(SoState * state, SoNode * node, SbBool instanced)
+{
+    inherited::set(classStackIndex, state, node, instanced ? 1 : 0);
+}
+
+SbBool SoFCInstancedElement::get(SoState * state)
+{
+    return inherited::get(classStackIndex, state) != 0;
+}
+
+// ---------------------------------------------------------------------------
+
+SO_NODE_SOURCE(SoFCInstancedArray)
+
+void SoFCInstancedArray::initClass()
+{
+    SO_NODE_INIT_CLASS(SoFCInstancedArray, SoGroup, "Group");
+}
+
+void SoFCInstancedArray::finish()
+{
+    atexit_cleanup();
+}
+
+SoFCInstancedArray::SoFCInstancedArray()
+{
+    SO_NODE_CONSTRUCTOR(SoFCInstancedArray);
+}
+
+SoFCInstancedArray::~SoFCInstancedArray() = default;
+
+void SoFCInstancedArray::setInstances(SoNode * node, const std::vector<SbMatrix> &mats)
+{
+    // Called right before rendering, so do not notify. Callers are
+    // expected to touch() this node when the instances become outdated.
+    SbBool notify = this->enableNotify(FALSE);
+    this->removeAllChildren();
+    this->matrices.clear();
+    if (node) {
+        this->matrices = mats;
+        for (std::size_t i = 0; i < mats.size(); ++i) {
+            this->addChild(node);
+        }
+    }
+    this->enableNotify(notify);
+}
+
+void SoFCInstancedArray::setPrepareFunction(std::function<bool()> func)
+{
+    this->prepare = std::move(func);
+}
+
+void SoFCInstancedArray::GLRender(SoGLRenderAction * action)
+{
+    int numIndices = 0;
+    const int * indices = nullptr;
+    SoAction::PathCode pathcode = action->getPathCode(numIndices, indices);
+    if (pathcode == SoAction::OFF_PATH) {
+        return;
+    }
+    SoState * state = action->getState();
+    if (this->prepare && !this->prepare()) {
+        // Reset in case this array is itself rendered as an instance
+        SoFCInstancedElement::set(state, this, FALSE);
+        return;
+    }
+    SoFCInstancedElement::set(state, this, TRUE);
+
+    auto render = [&](int index) {
+        if (index < 0 || index >= static_cast<int>(this->matrices.size())) {
+            return;
+        }
+        state->push();
+        SoModelMatrixElement::mult(state, this, this->matrices[index]);
+        this->children->traverse(action, index);
+        state->pop();
+    };
+
+    if (pathcode == SoAction::IN_PATH) {
+        for (int i = 0; i < numIndices && !action->hasTerminated(); ++i) {
+            render(indices[i]);
+        }
+    }
+    else {
+        int num = this->getNumChildren();
+        for (int i = 0; i < num && !action->hasTerminated(); ++i) {
+            render(i);
+        }
+    }
+}
+
+// The instances are only rendered, all other actions are handled by the
+// regular scene graph
+
+void SoFCInstancedArray::doAction(SoAction * /*action*/)
+{
+}
+
+void SoFCInstancedArray::callback(SoCallbackAction * /*action*/)
+{
+}
+
+void SoFCInstancedArray::getBoundingBox(SoGetBoundingBoxAction * /*action*/)
+{
+}
+
+void SoFCInstancedArray::getMatrix(SoGetMatrixAction * /*action*/)
+{
+}
+
+void SoFCInstancedArray::handleEvent(SoHandleEventAction * /*action*/)
+{
+}
+
+void SoFCInstancedArray::pick(SoPickAction * /*action*/)
+{
+}
+
+void SoFCInstancedArray::rayPick(SoRayPickAction * /*action*/)
+{
+}
+
+void SoFCInstancedArray::search(SoSearchAction * action)
+{
+    // Allow to find this node but not its children
+    SoNode::search(action);
+}
+
+void SoFCInstancedArray::getPrimitiveCount(SoGetPrimitiveCountAction * /*action*/)
+{
+}
+
+// ---------------------------------------------------------------------------
+
+SO_NODE_SOURCE(SoFCInstanceSwitch)
+
+void SoFCInstanceSwitch::initClass()
+{
+    SO_NODE_INIT_CLASS(SoFCInstanceSwitch, SoSwitch, "Switch");
+}
+
+void SoFCInstanceSwitch::finish()
+{
+    atexit_cleanup();
+}
+
+SoFCInstanceSwitch::SoFCInstanceSwitch()
+{
+    SO_NODE_CONSTRUCTOR(SoFCInstanceSwitch);
+}
+
+SoFCInstanceSwitch::~SoFCInstanceSwitch() = default;
+
+void SoFCInstanceSwitch::GLRender(SoGLRenderAction * action)
+{
+    if (this->instanced && SoFCInstancedElement::get(action->getState())) {
+        return;
+    }
+    inherited::GLRender(action);
+}
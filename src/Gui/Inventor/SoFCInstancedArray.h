@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef GUI_INVENTOR_SOFCINSTANCEDARRAY_H
+#define GUI_INVENTOR_SOFCINSTANCEDARRAY_H
+
+#include <functional>
+#include <vector>
+
+#include <Inventor/SbMatrix.h>
+#include <Inventor/elements/SoInt32Element.h>
+#include <Inventor/nodes/SoGroup.h>
+#include <Inventor/nodes/SoSwitch.h>
+#include <FCGlobal.h>
+
+namespace Gui
+{
+
+/**
+ * @class SoFCInstancedElement
+ * @brief Tells SoFCInstanceSwitch nodes that their content was already
+ * rendered by a preceding SoFCInstancedArray.
+ */
+class GuiExport SoFCInstancedElement : public SoInt32Element
+{
+    using inherited = SoInt32Element;
+
+    SO_ELEMENT_HEADER(SoFCInstancedElement);
+
+public:
+    static void initClass();
+
+    void init(SoState * state) override;
+
+    static void set(SoState * state, SoNode * node, SbBool instanced);
+    static SbBool get(SoState * state);
+
+protected:
+    ~SoFCInstancedElement() override;
+};
+
+/**
+ * @class SoFCInstancedArray
+ * @brief Renders one sub-graph many times with different transformations.
+ *
+ * The node only takes part in GL rendering. Each child is the same instance
+ * node, so that a path recorded for delayed transparency rendering still
+ * identifies the instance through its child index. All other actions, e.g.
+ * picking or bounding box calculation, skip this node and go through the
+ * regular scene graph that follows it, where SoFCInstanceSwitch nodes skip
+ * rendering of the instanced content.
+ */
+class GuiExport SoFCInstancedArray : public SoGroup
+{
+    using inherited = SoGroup;
+
+    SO_NODE_HEADER(Gui::SoFCInstancedArray);
+
+public:
+    static void initClass();
+    static void finish();
+    SoFCInstancedArray();
+
+    /// Render \a node once for every given transformation
+    void setInstances(SoNode * node, const std::vector<SbMatrix> &matrices);
+    /** Set a function called before rendering
+     * The function may update the instances and returns false if the
+     * regular scene graph should be rendered instead.
+     */
+    void setPrepareFunction(std::function<bool()> func);
+
+    void GLRender(SoGLRenderAction * action) override;
+    void doAction(SoAction * action) override;
+    void callback(SoCallbackAction * action) override;
+    void getBoundingBox(SoGetBoundingBoxAction * action) override;
+    void getMatrix(SoGetMatrixAction * action) override;
+    void handleEvent(SoHandleEventAction * action) override;
+    void pick(SoPickAction * action) override;
+    void rayPick(SoRayPickAction * action) override;
+    void search(SoSearchAction * action) override;
+    void getPrimitiveCount(SoGetPrimitiveCountAction * action) override;
+
+protected:
+    ~SoFCInstancedArray() override;
+
+private:
+    std::vector<SbMatrix> matrices;
+    std::function<bool()> prepare;
+};
+
+/**
+ * @class SoFCInstanceSwitch
+ * @brief A switch that skips GL rendering if its content was rendered by a
+ * SoFCInstancedArray.
+ */
+class GuiExport SoFCInstanceSwitch : public SoSwitch
+{
+    using inherited = SoSwitch;
+
+    SO_NODE_HEADER(Gui::SoFCInstanceSwitch);
+
+public:
+    static void initClass();
+    static void finish();
+    SoFCInstanceSwitch();
+
+    void GLRender(SoGLRenderAction * action) override;
+
+    /// Set if the content of this switch is part of an instanced array
+    bool instanced = false;
+
+protected:
+    ~SoFCInstanceSwitch() override;
+};
+
+} // namespace Gui
+
+#endif // GUI_INVENTOR_SOFCINSTANCEDARRAY_H
@@ -0,0 +1,470 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include <FCConfig.h>
+
+#ifdef FC_OS_WIN32
+# include <windows.h>
+#endif
+#ifdef FC_OS_MACOSX
+# include <OpenGL/gl.h>
+#else
+# include <GL/gl.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <Inventor/C/glue/gl.h>
+#include <Inventor/SbVec4f.h>
+#include <Inventor/actions/SoGLRenderAction.h>
+#include <Inventor/actions/SoGetBoundingBoxAction.h>
+#include <Inventor/actions/SoGetPrimitiveCountAction.h>
+#include <Inventor/bundles/SoMaterialBundle.h>
+#include <Inventor/elements/SoCacheElement.h>
+#include <Inventor/elements/SoCullElement.h>
+#include <Inventor/elements/SoGLCacheContextElement.h>
+#include <Inventor/elements/SoLazyElement.h>
+#include <Inventor/elements/SoMaterialBindingElement.h>
+#include <Inventor/elements/SoModelMatrixElement.h>
+#include <Inventor/elements/SoProjectionMatrixElement.h>
+#include <Inventor/elements/SoViewVolumeElement.h>
+#include <Inventor/elements/SoViewingMatrixElement.h>
+#include <Inventor/misc/SoState.h>
+#include <Inventor/nodes/SoNode.h>
+
+#include "SoFCRenderCuller.h"
+#include "SoFCRenderStatistics.h"
+
+#ifndef GL_SAMPLES_PASSED
+# define GL_SAMPLES_PASSED 0x8914
+#endif
+#ifndef GL_QUERY_RESULT
+# define GL_QUERY_RESULT 0x8866
+#endif
+#ifndef GL_QUERY_RESULT_AVAILABLE
+# define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+
+
+using namespace Gui;
+
+SoFCRenderCuller * SoFCRenderCuller::current = nullptr;
+
+namespace {
+
+void query_delete(void * closure, uint32_t contextid)
+{
+    const cc_glglue * glue = cc_glglue_instance(static_cast<int>(contextid));
+    auto id = static_cast<GLuint>(reinterpret_cast<uintptr_t>(closure));
+    cc_glglue_glDeleteQueries(glue, 1, &id);
+}
+
+// Check if the box reaches behind the near plane, in which case the
+// occlusion query of its faces would not be reliable
+bool crossesNearPlane(const SbBox3f & box, const SbMatrix & matrix)
+{
+    const SbVec3f & min = box.getMin();
+    const SbVec3f & max = box.getMax();
+    for (int i = 0; i < 8; ++i) {
+        SbVec4f corner((i & 1) ? max[0] : min[0],
+                       (i & 2) ? max[1] : min[1],
+                       (i & 4) ? max[2] : min[2],
+                       1.0F);
+        SbVec4f clip;
+        matrix.multVecMatrix(corner, clip);
+        if (clip[3] <= 0.0F || clip[2] < -clip[3]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void drawBox(const SbBox3f & box)
+{
+    const SbVec3f & a = box.getMin();
+    const SbVec3f & b = box.getMax();
+    glBegin(GL_QUADS);
+    glVertex3f(a[0], a[1], a[2]); glVertex3f(a[0], b[1], a[2]);
+    glVertex3f(b[0], b[1], a[2]); glVertex3f(b[0], a[1], a[2]);
+
+    glVertex3f(a[0], a[1], b[2]); glVertex3f(b[0], a[1], b[2]);
+    glVertex3f(b[0], b[1], b[2]); glVertex3f(a[0], b[1], b[2]);
+
+    glVertex3f(a[0], a[1], a[2]); glVertex3f(b[0], a[1], a[2]);
+    glVertex3f(b[0], a[1], b[2]); glVertex3f(a[0], a[1], b[2]);
+
+    glVertex3f(a[0], b[1], a[2]); glVertex3f(a[0], b[1], b[2]);
+    glVertex3f(b[0], b[1], b[2]); glVertex3f(b[0], b[1], a[2]);
+
+    glVertex3f(a[0], a[1], a[2]); glVertex3f(a[0], a[1], b[2]);
+    glVertex3f(a[0], b[1], b[2]); glVertex3f(a[0], b[1], a[2]);
+
+    glVertex3f(b[0], a[1], a[2]); glVertex3f(b[0], b[1], a[2]);
+    glVertex3f(b[0], b[1], b[2]); glVertex3f(b[0], a[1], b[2]);
+    glEnd();
+}
+
+void drawBoxEdges(const SbBox3f & box)
+{
+    const SbVec3f & a = box.getMin();
+    const SbVec3f & b = box.getMax();
+    glBegin(GL_LINES);
+    for (int i = 0; i < 4; ++i) {
+        const SbVec3f & p = (i & 1) ? b : a;
+        const SbVec3f & q = (i & 2) ? b : a;
+        glVertex3f(a[0], p[1], q[2]); glVertex3f(b[0], p[1], q[2]);
+        glVertex3f(p[0], a[1], q[2]); glVertex3f(p[0], b[1], q[2]);
+        glVertex3f(p[0], q[1], a[2]); glVertex3f(p[0], q[1], b[2]);
+    }
+    glEnd();
+}
+
+}
+
+SoFCRenderCuller::SoFCRenderCuller()
+    : bboxAction(new SoGetBoundingBoxAction(SbViewportRegion()))
+{
+}
+
+SoFCRenderCuller::~SoFCRenderCuller()
+{
+    clear();
+    delete bboxAction;
+    delete countAction;
+}
+
+void SoFCRenderCuller::setTriangleBudget(int budget)
+{
+    triangleBudget = std::max(budget, 0);
+}
+
+int SoFCRenderCuller::getTriangleBudget() const
+{
+    return triangleBudget;
+}
+
+bool SoFCRenderCuller::isRefining() const
+{
+    return refining;
+}
+
+void SoFCRenderCuller::beginFrame(SoGLRenderAction * action, bool frustum, bool occlusion, bool interactive)
+{
+    this->action = action;
+    this->frustumCulling = frustum;
+    this->occlusionCulling = false;
+
+    uint32_t context = action->getCacheContext();
+    if (context != contextId) {
+        clear();
+        contextId = context;
+    }
+
+    if (occlusion) {
+        const cc_glglue * glue = cc_glglue_instance(static_cast<int>(contextId));
+        this->occlusionCulling = glue && cc_glglue_has_occlusion_query(glue);
+    }
+
+    // With a budget the culler stays active to keep the primitive counts
+    if (!frustumCulling && !occlusionCulling && triangleBudget <= 0) {
+        if (!entries.empty()) {
+            clear();
+        }
+        refineLevel = -1;
+        refining = false;
+        return;
+    }
+
+    ++frame;
+    current = this;
+    assignProxies(interactive);
+}
+
+void SoFCRenderCuller::assignProxies(bool interactive)
+{
+    refining = false;
+    if (triangleBudget <= 0 || (!interactive && refineLevel < 0)) {
+        refineLevel = -1;
+        for (auto & v : entries) {
+            v.second.proxy = false;
+        }
+        return;
+    }
+
+    double limit = triangleBudget;
+    if (interactive) {
+        refineLevel = 0;
+    }
+    else {
+        ++refineLevel;
+        limit = std::ldexp(limit, std::min(refineLevel, 30));
+    }
+
+    // Spend the budget on the objects that appeared largest in the last frame
+    std::vector<Entry*> sorted;
+    sorted.reserve(entries.size());
+    for (auto & v : entries) {
+        sorted.push_back(&v.second);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Entry * a, const Entry * b) {
+        return a->screenSize > b->screenSize;
+    });
+
+    double total = 0.0;
+    bool hasProxy = false;
+    for (Entry * entry : sorted) {
+        entry->proxy = entry->primitives > 0 && total + entry->primitives > limit;
+        if (entry->proxy) {
+            hasProxy = true;
+        }
+        else if (entry->primitives > 0) {
+            total += entry->primitives;
+        }
+    }
+
+    if (!interactive) {
+        refining = hasProxy;
+        if (!hasProxy) {
+            refineLevel = -1;
+        }
+    }
+}
+
+void SoFCRenderCuller::endFrame()
+{
+    if (current != this) {
+        return;
+    }
+    current = nullptr;
+
+    if (occlusionCulling) {
+        issueQueries();
+    }
+
+    // Forget about objects that were not rendered in this frame
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.frame != frame) {
+            deleteQuery(it->second);
+            it->first->unref();
+            it = entries.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void SoFCRenderCuller::clear()
+{
+    if (current == this) {
+        current = nullptr;
+    }
+    for (auto & v : entries) {
+        deleteQuery(v.second);
+        v.first->unref();
+    }
+    entries.clear();
+}
+
+void SoFCRenderCuller::deleteQuery(Entry & entry)
+{
+    if (entry.query) {
+        void * ptr = reinterpret_cast<void*>(static_cast<uintptr_t>(entry.query));
+        SoGLCacheContextElement::scheduleDeleteCallback(contextId, query_delete, ptr);
+        entry.query = 0;
+        entry.queryPending = false;
+    }
+}
+
+bool SoFCRenderCuller::cull(SoGLRenderAction * action, SoNode * node)
+{
+    if (action->isRenderingDelayedPaths()) {
+        return false;
+    }
+    if (!current || current->action != action) {
+        SoFCRenderStatistics::addObject(SoFCRenderStatistics::Object::Rendered);
+        return false;
+    }
+    return current->cullNode(action, node);
+}
+
+bool SoFCRenderCuller::cullNode(SoGLRenderAction * action, SoNode * node)
+{
+    auto res = entries.emplace(node, Entry());
+    Entry & entry = res.first->second;
+    if (res.second) {
+        node->ref();
+    }
+    entry.frame = frame;
+    entry.testOcclusion = false;
+
+    // The result depends on the camera and on the last frame, so it must
+    // not be recorded in the render cache of a parent node
+    SoState * state = action->getState();
+    SoCacheElement::invalidate(state);
+
+    // The node id changes whenever anything below the node is modified
+    if (res.second || entry.nodeId != node->getNodeId()) {
+        bboxAction->setViewportRegion(action->getViewportRegion());
+        bboxAction->apply(node);
+        entry.box = bboxAction->getBoundingBox();
+        entry.nodeId = node->getNodeId();
+        entry.primitives = -1;
+        entry.visible = true;
+        entry.queryPending = false;
+    }
+
+    if (triangleBudget > 0 && entry.primitives < 0) {
+        if (!countAction) {
+            countAction = new SoGetPrimitiveCountAction();
+        }
+        countAction->apply(node);
+        entry.primitives = countAction->getTriangleCount()
+                         + countAction->getLineCount()
+                         + countAction->getPointCount();
+    }
+
+    // Nothing to cull, e.g. a hidden object or one with screen space
+    // geometry only
+    if (entry.box.isEmpty()) {
+        SoFCRenderStatistics::addObject(SoFCRenderStatistics::Object::Rendered);
+        return false;
+    }
+
+    if (frustumCulling && SoCullElement::cullTest(state, entry.box, TRUE)) {
+        // Render the object when it enters the view frustum again
+        entry.visible = true;
+        entry.queryPending = false;
+        entry.screenSize = 0.0F;
+        SoFCRenderStatistics::addObject(SoFCRenderStatistics::Object::Culled);
+        return true;
+    }
+
+    if (triangleBudget > 0) {
+        SbBox3f box = entry.box;
+        box.transform(SoModelMatrixElement::get(state));
+        SbVec2f size = SoViewVolumeElement::get(state).projectBox(box);
+        entry.screenSize = std::max(size[0], size[1]);
+    }
+
+    if (occlusionCulling && !testOcclusion(state, entry)) {
+        SoFCRenderStatistics::addObject(SoFCRenderStatistics::Object::Culled);
+        return true;
+    }
+
+    if (entry.proxy) {
+        renderProxy(action, entry);
+        SoFCRenderStatistics::addObject(SoFCRenderStatistics::Object::Proxy);
+        return true;
+    }
+    SoFCRenderStatistics::addObject(SoFCRenderStatistics::Object::Rendered);
+    return false;
+}
+
+bool SoFCRenderCuller::testOcclusion(SoState * state, Entry & entry)
+{
+    if (entry.queryPending) {
+        const cc_glglue * glue = cc_glglue_instance(static_cast<int>(contextId));
+        GLuint available = 0;
+        cc_glglue_glGetQueryObjectuiv(glue, entry.query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available) {
+            GLuint samples = 0;
+            cc_glglue_glGetQueryObjectuiv(glue, entry.query, GL_QUERY_RESULT, &samples);
+            entry.visible = samples > 0;
+            entry.queryPending = false;
+        }
+    }
+
+    entry.matrix = SoModelMatrixElement::get(state);
+    entry.matrix.multRight(SoViewingMatrixElement::get(state));
+    entry.matrix.multRight(SoProjectionMatrixElement::get(state));
+    entry.testOcclusion = true;
+    return entry.visible;
+}
+
+void SoFCRenderCuller::renderProxy(SoGLRenderAction * action, const Entry & entry)
+{
+    SoState * state = action->getState();
+    state->push();
+    SoLazyElement::setLightModel(state, SoLazyElement::BASE_COLOR);
+    SoMaterialBindingElement::set(state, SoMaterialBindingElement::OVERALL);
+    SoMaterialBundle mb(action);
+    mb.sendFirst();
+    drawBoxEdges(entry.box);
+    state->pop();
+}
+
+void SoFCRenderCuller::issueQueries()
+{
+    const cc_glglue * glue = cc_glglue_instance(static_cast<int>(contextId));
+
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_POLYGON_BIT);
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LEQUAL);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_TEXTURE_2D);
+    glDisable(GL_BLEND);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    for (auto & v : entries) {
+        Entry & entry = v.second;
+        if (entry.frame != frame || !entry.testOcclusion) {
+            continue;
+        }
+        if (crossesNearPlane(entry.box, entry.matrix)) {
+            entry.visible = true;
+            entry.queryPending = false;
+            continue;
+        }
+        if (!entry.query) {
+            GLuint id = 0;
+            cc_glglue_glGenQueries(glue, 1, &id);
+            if (!id) {
+                continue;
+            }
+            entry.query = id;
+        }
+        glLoadMatrixf(entry.matrix[0]);
+        cc_glglue_glBeginQuery(glue, GL_SAMPLES_PASSED, entry.query);
+        drawBox(entry.box);
+        cc_glglue_glEndQuery(glue, GL_SAMPLES_PASSED);
+        entry.queryPending = true;
+    }
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopAttrib();
+}
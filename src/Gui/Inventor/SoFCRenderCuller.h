@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef GUI_INVENTOR_SOFCRENDERCULLER_H
+#define GUI_INVENTOR_SOFCRENDERCULLER_H
+
+#include <cstdint>
+#include <unordered_map>
+
+#include <Inventor/SbBox3f.h>
+#include <Inventor/SbMatrix.h>
+#include <FCGlobal.h>
+
+class SoGetBoundingBoxAction;
+class SoGetPrimitiveCountAction;
+class SoGLRenderAction;
+class SoNode;
+class SoState;
+
+namespace Gui
+{
+
+/**
+ * @class SoFCRenderCuller
+ * @brief Skips rendering of objects that are outside the view frustum or
+ * were hidden behind other objects in the previous frame.
+ *
+ * A viewer activates its culler around the rendering of its scene. Every
+ * top level SoFCSelectionRoot, i.e. the root node of a view provider, asks
+ * the active culler whether it can be skipped. The bounding box of a root is
+ * cached until the node id of the root changes.
+ *
+ * After the scene is rendered, an occlusion query is issued for the bounding
+ * box of every object inside the view frustum against the complete depth
+ * buffer. Its result decides whether the object is rendered in the next
+ * frame, so an object that becomes visible may appear one frame late.
+ *
+ * With a triangle budget, objects are drawn as bounding boxes during
+ * interaction once the budget is used up, starting with the objects that
+ * covered the smallest part of the view in the previous frame. When the
+ * interaction ends, the budget is doubled on each frame until all objects
+ * are drawn in full detail again.
+ */
+class GuiExport SoFCRenderCuller
+{
+public:
+    SoFCRenderCuller();
+    ~SoFCRenderCuller();
+
+    /// Set the number of primitives drawn per frame during interaction, 0 to disable
+    void setTriangleBudget(int budget);
+    int getTriangleBudget() const;
+    /// Check if objects are still drawn as boxes after an interaction
+    bool isRefining() const;
+
+    /// Activate the culler for the scene rendered by \a action
+    void beginFrame(SoGLRenderAction * action, bool frustum, bool occlusion, bool interactive);
+    /// Issue the occlusion queries and deactivate the culler
+    void endFrame();
+    /// Deactivate the culler and forget all cached data
+    void clear();
+
+    /// Check if \a node can be skipped by the active culler
+    static bool cull(SoGLRenderAction * action, SoNode * node);
+
+private:
+    struct Entry {
+        SbBox3f box;
+        // model view projection matrix of the last cull test
+        SbMatrix matrix;
+        uint32_t nodeId = 0;
+        uint32_t query = 0;
+        int frame = 0;
+        int primitives = -1;
+        // projected size of the box in the last frame
+        float screenSize = 0.0F;
+        bool proxy = false;
+        bool queryPending = false;
+        bool testOcclusion = false;
+        bool visible = true;
+    };
+
+    bool cullNode(SoGLRenderAction * action, SoNode * node);
+    void assignProxies(bool interactive);
+    /// Return false if the object was hidden in the last frame
+    bool testOcclusion(SoState * state, Entry & entry);
+    void renderProxy(SoGLRenderAction * action, const Entry & entry);
+    void issueQueries();
+    void deleteQuery(Entry & entry);
+
+private:
+    static SoFCRenderCuller * current;
+
+    std::unordered_map<SoNode*, Entry> entries;
+    SoGetBoundingBoxAction * bboxAction;
+    SoGetPrimitiveCountAction * countAction = nullptr;
+    SoGLRenderAction * action = nullptr;
+    uint32_t contextId = 0;
+    int frame = 0;
+    int triangleBudget = 0;
+    // number of times the budget was doubled after an interaction, -1 if not refining
+    int refineLevel = -1;
+    bool refining = false;
+    bool frustumCulling = false;
+    bool occlusionCulling = false;
+};
+
+} // namespace Gui
+
+#endif // GUI_INVENTOR_SOFCRENDERCULLER_H
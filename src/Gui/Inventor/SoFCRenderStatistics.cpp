@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#include <Inventor/SoType.h>
+#include <Inventor/nodes/SoNode.h>
+
+#include "SoFCRenderStatistics.h"
+
+
+using namespace Gui;
+
+SoFCRenderStatistics * SoFCRenderStatistics::current = nullptr;
+
+SoFCRenderStatistics::NodeTimer::NodeTimer(const SoNode * node)
+    : node(current ? node : nullptr)
+{
+    if (this->node) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+SoFCRenderStatistics::NodeTimer::~NodeTimer()
+{
+    // The collector may have been deactivated while rendering the node
+    if (!node || !current) {
+        return;
+    }
+
+    std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+    NodeType & type = current->types[node->getTypeId().getKey()];
+    ++type.count;
+    type.time += time.count();
+}
+
+void SoFCRenderStatistics::beginFrame()
+{
+    frame = Frame();
+    types.clear();
+    start = std::chrono::steady_clock::now();
+    current = this;
+}
+
+void SoFCRenderStatistics::endFrame()
+{
+    if (current != this) {
+        return;
+    }
+    current = nullptr;
+
+    std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+    frame.renderTime = time.count();
+    for (const auto & it : types) {
+        SoType type = SoType::fromKey(static_cast<uint16_t>(it.first));
+        frame.nodeTypes[type.getName().getString()] = it.second;
+    }
+    last = frame;
+}
+
+const SoFCRenderStatistics::Frame & SoFCRenderStatistics::lastFrame() const
+{
+    return last;
+}
+
+bool SoFCRenderStatistics::isActive()
+{
+    return current != nullptr;
+}
+
+void SoFCRenderStatistics::addObject(Object state)
+{
+    if (!current) {
+        return;
+    }
+
+    ++current->frame.objects;
+    if (state == Object::Culled) {
+        ++current->frame.culledObjects;
+    }
+    else if (state == Object::Proxy) {
+        ++current->frame.proxyObjects;
+    }
+}
+
+void SoFCRenderStatistics::addPrimitives(std::int64_t triangles, std::int64_t lines, std::int64_t points)
+{
+    if (current) {
+        current->frame.triangles += triangles;
+        current->frame.lines += lines;
+        current->frame.points += points;
+    }
+}
+
+void SoFCRenderStatistics::addBufferUpload(std::size_t bytes)
+{
+    if (current) {
+        ++current->frame.bufferUploads;
+        current->frame.uploadedBytes += bytes;
+    }
+}
+
+void SoFCRenderStatistics::addBufferHit()
+{
+    if (current) {
+        ++current->frame.bufferHits;
+    }
+}
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#ifndef GUI_INVENTOR_SOFCRENDERSTATISTICS_H
+#define GUI_INVENTOR_SOFCRENDERSTATISTICS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include <FCGlobal.h>
+
+class SoNode;
+
+namespace Gui
+{
+
+/**
+ * @class SoFCRenderStatistics
+ * @brief Collects what was rendered in a frame of a viewer.
+ *
+ * A viewer activates its collector around the rendering of its scene. While
+ * it is active, the top level objects, the shape nodes and the vertex buffers
+ * report to it through the static methods, which do nothing otherwise. The
+ * numbers of the last complete frame can be queried with lastFrame().
+ *
+ * Only the nodes that use NodeTimer are listed per node type. The time of a
+ * node type is the time spent in GLRender() of its nodes, including the time
+ * the driver needs to accept the draw calls.
+ */
+class GuiExport SoFCRenderStatistics
+{
+public:
+    enum class Object {
+        Rendered,
+        Culled,
+        Proxy,
+    };
+
+    struct NodeType {
+        int count = 0;
+        /// time in milliseconds
+        double time = 0.0;
+    };
+
+    struct Frame {
+        /// time in milliseconds to traverse the scene
+        double renderTime = 0.0;
+        int objects = 0;
+        int culledObjects = 0;
+        int proxyObjects = 0;
+        std::int64_t triangles = 0;
+        std::int64_t lines = 0;
+        std::int64_t points = 0;
+        int bufferUploads = 0;
+        std::size_t uploadedBytes = 0;
+        /// number of vertex buffers that were drawn without upload
+        int bufferHits = 0;
+        std::map<std::string, NodeType> nodeTypes;
+    };
+
+    /// Measures the time spent in the GLRender() of a node
+    class GuiExport NodeTimer
+    {
+    public:
+        explicit NodeTimer(const SoNode * node);
+        ~NodeTimer();
+
+        NodeTimer(const NodeTimer&) = delete;
+        NodeTimer& operator=(const NodeTimer&) = delete;
+
+    private:
+        const SoNode * node;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    void beginFrame();
+    void endFrame();
+    const Frame& lastFrame() const;
+
+    /// Check if a collector is active
+    static bool isActive();
+    static void addObject(Object state);
+    static void addPrimitives(std::int64_t triangles, std::int64_t lines, std::int64_t points);
+    static void addBufferUpload(std::size_t bytes);
+    static void addBufferHit();
+
+private:
+    static SoFCRenderStatistics * current;
+
+    Frame frame;
+    Frame last;
+    // per node type, keyed by SoType::getKey()
+    std::unordered_map<int, NodeType> types;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace Gui
+
+#endif // GUI_INVENTOR_SOFCRENDERSTATISTICS_H
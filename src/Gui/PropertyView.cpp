@@ -181,6 +181,7 @@ void PropertyView::setShowAll(bool enable) {
 void PropertyView::hideEvent(QHideEvent *ev) {
     this->timer->stop();
     this->detachSelection();
+    clearPendingProperties();
     // clear the properties before hiding.
     propertyEditorData->buildUp();
     propertyEditorView->buildUp();
@@ -212,10 +213,26 @@ void PropertyView::slotRollback() {
     clearPropertyItemSelection();
 }
 
+static bool isRecomputing(const App::Property& prop)
+{
+    App::Document* doc = nullptr;
+    auto container = prop.getContainer();
+    if (auto obj = freecad_cast<App::DocumentObject*>(container)) {
+        doc = obj->getDocument();
+    }
+    else if (auto vp = freecad_cast<ViewProviderDocumentObject*>(container)) {
+        doc = vp->getObject() ? vp->getObject()->getDocument() : nullptr;
+    }
+    return doc && doc->testStatus(App::Document::Recomputing);
+}
+
 void PropertyView::slotChangePropertyData(const App::Property& prop)
 {
     if (propertyEditorData->propOwners.contains(prop.getContainer())) {
-        propertyEditorData->updateProperty(prop);
+        if (isRecomputing(prop))
+            pendingDataProps.insert(&prop);
+        else
+            propertyEditorData->updateProperty(prop);
         timer->start(ViewParams::instance()->getPropertyViewTimer());
     }
 }
@@ -223,11 +240,31 @@ void PropertyView::slotChangePropertyData(const App::Property& prop)
 void PropertyView::slotChangePropertyView(const Gui::ViewProvider&, const App::Property& prop)
 {
     if (propertyEditorView->propOwners.contains(prop.getContainer())) {
-        propertyEditorView->updateProperty(prop);
+        if (isRecomputing(prop))
+            pendingViewProps.insert(&prop);
+        else
+            propertyEditorView->updateProperty(prop);
         timer->start(ViewParams::instance()->getPropertyViewTimer());
     }
 }
 
+void PropertyView::updatePendingProperties()
+{
+    auto dataProps = std::move(pendingDataProps);
+    auto viewProps = std::move(pendingViewProps);
+    clearPendingProperties();
+    for (auto prop : dataProps)
+        propertyEditorData->updateProperty(*prop);
+    for (auto prop : viewProps)
+        propertyEditorView->updateProperty(*prop);
+}
+
+void PropertyView::clearPendingProperties()
+{
+    pendingDataProps.clear();
+    pendingViewProps.clear();
+}
+
 bool PropertyView::isPropertyHidden(const App::Property *prop) {
     return prop && !showAll() &&
         ((prop->getType() & App::Prop_Hidden) || prop->testStatus(App::Property::Hidden));
@@ -248,6 +285,9 @@ void PropertyView::slotAppendDynamicProperty(const App::Property& prop)
 
 void PropertyView::slotRemoveDynamicProperty(const App::Property& prop)
 {
+    pendingDataProps.erase(&prop);
+    pendingViewProps.erase(&prop);
+
     App::PropertyContainer* parent = prop.getContainer();
     if(propertyEditorData->propOwners.contains(parent))
         propertyEditorData->removeProperty(prop);
@@ -285,6 +325,7 @@ void PropertyView::slotChangePropertyEditor(const App::Document &, const App::Pr
 
 void PropertyView::slotDeleteDocument(const Gui::Document &doc) {
     if(propertyEditorData->propOwners.contains(doc.getDocument())) {
+        clearPendingProperties();
         propertyEditorView->buildUp();
         propertyEditorData->buildUp();
         clearPropertyItemSelection();
@@ -294,6 +335,7 @@ void PropertyView::slotDeleteDocument(const Gui::Document &doc) {
 
 void PropertyView::slotDeletedViewObject(const Gui::ViewProvider &vp) {
     if(propertyEditorView->propOwners.contains(&vp)) {
+        clearPendingProperties();
         propertyEditorView->buildUp();
         propertyEditorData->buildUp();
         clearPropertyItemSelection();
@@ -303,6 +345,7 @@ void PropertyView::slotDeletedViewObject(const Gui::ViewProvider &vp) {
 
 void PropertyView::slotDeletedObject(const App::DocumentObject &obj) {
     if(propertyEditorData->propOwners.contains(&obj)) {
+        clearPendingProperties();
         propertyEditorView->buildUp();
         propertyEditorData->buildUp();
         clearPropertyItemSelection();
@@ -332,16 +375,6 @@ struct PropertyView::PropInfo
     std::vector<App::Property*> propList;
 };
 
-struct PropertyView::PropFind {
-    const PropInfo& item;
-    explicit PropFind(const PropInfo& item) : item(item) {}
-    bool operator () (const PropInfo& elem) const
-    {
-        return (elem.propId == item.propId) &&
-               (elem.propName == item.propName);
-    }
-};
-
 void PropertyView::onSelectionChanged(const SelectionChanges& msg)
 {
     if (msg.Type != SelectionChanges::AddSelection &&
@@ -365,6 +398,8 @@ void PropertyView::onTimer()
 
     timer->stop();
 
+    updatePendingProperties();
+
     if(!this->isSelectionAttached()) {
         propertyEditorData->buildUp();
         propertyEditorView->buildUp();
@@ -399,6 +434,23 @@ void PropertyView::onTimer()
     // group the properties by <name,id>
     std::vector<PropInfo> propDataMap;
     std::vector<PropInfo> propViewMap;
+    // position of each <name,id> in the above lists, so that selecting many
+    // objects doesn't search the lists for every property
+    using PropKey = std::pair<std::string, int>;
+    std::map<PropKey, std::size_t> propDataIndex;
+    std::map<PropKey, std::size_t> propViewIndex;
+    auto addProp = [](std::vector<PropInfo> &propMap, std::map<PropKey, std::size_t> &propIndex,
+                      const char *name, App::Property *prop) {
+        int propId = prop->getTypeId().getKey();
+        auto res = propIndex.emplace(PropKey(name, propId), propMap.size());
+        if (res.second) {
+            PropInfo nameType;
+            nameType.propName = name;
+            nameType.propId = propId;
+            propMap.push_back(std::move(nameType));
+        }
+        propMap[res.first->second].propList.push_back(prop);
+    };
     bool checkLink = true;
     ViewProviderDocumentObject *vpLast = nullptr;
     auto sels = Gui::Selection().getSelectionEx("*");
@@ -438,18 +490,7 @@ void PropertyView::onTimer()
                 if (isPropertyHidden(prop))
                     continue;
 
-                PropInfo nameType;
-                nameType.propName = prop->getName();
-                nameType.propId = prop->getTypeId().getKey();
-
-                auto pi = std::find_if(propDataMap.begin(), propDataMap.end(), PropFind(nameType));
-                if (pi != propDataMap.end()) {
-                    pi->propList.push_back(prop);
-                }
-                else {
-                    nameType.propList.push_back(prop);
-                    propDataMap.push_back(nameType);
-                }
+                addProp(propDataMap, propDataIndex, prop->getName(), prop);
             }
         }
         // the same for the view properties
@@ -459,18 +500,7 @@ void PropertyView::onTimer()
                 if (isPropertyHidden(pt->second))
                     continue;
 
-                PropInfo nameType;
-                nameType.propName = pt->first;
-                nameType.propId = pt->second->getTypeId().getKey();
-
-                auto pi = std::find_if(propViewMap.begin(), propViewMap.end(), PropFind(nameType));
-                if (pi != propViewMap.end()) {
-                    pi->propList.push_back(pt->second);
-                }
-                else {
-                    nameType.propList.push_back(pt->second);
-                    propViewMap.push_back(nameType);
-                }
+                addProp(propViewMap, propViewIndex, pt->first.c_str(), pt->second);
             }
         }
     }
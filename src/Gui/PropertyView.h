@@ -23,6 +23,8 @@
 #ifndef GUI_DOCKWND_PROPERTYVIEW_H
 #define GUI_DOCKWND_PROPERTYVIEW_H
 
+#include <set>
+
 #include "DockWindow.h"
 #include "Selection.h"
 
@@ -91,10 +93,11 @@ private:
     void slotDeletedObject(const App::DocumentObject&);
 
     void checkEnable(const char *doc = nullptr);
+    void updatePendingProperties();
+    void clearPendingProperties();
 
 private:
     struct PropInfo;
-    struct PropFind;
     using Connection = boost::signals2::connection;
     Connection connectPropData;
     Connection connectPropView;
@@ -112,6 +115,10 @@ private:
     QTabWidget* tabs;
     QTimer* timer;
     bool updating = false;
+    // Properties changed while their document is recomputing, the editors
+    // are updated once by the next onTimer() instead of on every change
+    std::set<const App::Property*> pendingDataProps;
+    std::set<const App::Property*> pendingViewProps;
 };
 
 namespace DockWnd {
@@ -873,6 +873,11 @@ void ReportOutput::OnChange(Base::Subject<const char*> &rCaller, const char * sR
     else if (strcmp(sReason, "LogMessageSize") == 0) {
         messageSize = rclGrp.GetInt(sReason, d->logMessageSize);
     }
+    else if (strcmp(sReason, "AsyncConsole") == 0) {
+        bool async = rclGrp.GetBool(sReason, false);
+        Base::Console().setConnectionMode(async ? Base::ConsoleSingleton::Async
+                                                : Base::ConsoleSingleton::Direct);
+    }
 }
 
 #include "moc_ReportView.cpp"
@@ -23,6 +23,7 @@
 
 
 
+# include <algorithm>
 # include <array>
 # include <set>
 # include <boost/algorithm/string/predicate.hpp>
@@ -127,6 +128,11 @@ bool SelectionObserver::isSelectionAttached() const
     return connectSelection.connected();
 }
 
+void SelectionObserver::setBatchSelection(bool enable)
+{
+    batchSelection = enable;
+}
+
 void SelectionObserver::attachSelection()
 {
     if (!connectSelection.connected()) {
@@ -151,7 +157,14 @@ void SelectionObserver::_onSelectionChanged(const SelectionChanges& msg) {
     try {
         if (blockedSelection)
             return;
-        onSelectionChanged(msg);
+        if (batchSelection) {
+            onSelectionChanged(msg);
+        }
+        else {
+            msg.forEachChange([this](const SelectionChanges &change) {
+                onSelectionChanged(change);
+            });
+        }
     } catch (Base::Exception &e) {
         e.reportException();
         FC_ERR("Unhandled Base::Exception caught in selection observer: ");
@@ -515,12 +528,22 @@ void SelectionSingleton::notify(SelectionChanges &&Chng)
     Base::FlagToggler<bool> flag(Notifying);
     NotificationQueue.push_back(std::move(Chng));
     while(!NotificationQueue.empty()) {
-        const auto &msg = NotificationQueue.front();
+        auto &msg = NotificationQueue.front();
         bool notify = false;
         switch(msg.Type) {
         case SelectionChanges::AddSelection:
             notify = isSelected(msg.pDocName, msg.pObjectName, msg.pSubName, ResolveMode::NoResolve);
             break;
+        case SelectionChanges::AddSelections: {
+            auto &subNames = msg.SubNames;
+            subNames.erase(std::remove_if(subNames.begin(), subNames.end(),
+                [this, &msg](const std::string &subName) {
+                    return !isSelected(msg.pDocName, msg.pObjectName,
+                                       subName.c_str(), ResolveMode::NoResolve);
+                }), subNames.end());
+            notify = !subNames.empty();
+            break;
+        }
         case SelectionChanges::RmvSelection:
             notify = !isSelected(msg.pDocName, msg.pObjectName, msg.pSubName, ResolveMode::NoResolve);
             break;
@@ -535,10 +558,14 @@ void SelectionSingleton::notify(SelectionChanges &&Chng)
             notify = true;
         }
         if(notify) {
-            // Notify the view provider of the object.
-            notifyDocumentObjectViewProvider(msg);
-
-            Notify(msg);
+            // Observers other than the connected SelectionObserver don't
+            // know about AddSelections, they get one message per element
+            msg.forEachChange([this](const SelectionChanges &change) {
+                // Notify the view provider of the object.
+                notifyDocumentObjectViewProvider(change);
+
+                Notify(change);
+            });
             try {
                 signalSelectionChanged(msg);
             }
@@ -667,6 +694,13 @@ unsigned int SelectionSingleton::countObjectsOfType(const char* typeName, const
 
 void SelectionSingleton::slotSelectionChanged(const SelectionChanges& msg)
 {
+    if(msg.Type == SelectionChanges::AddSelections) {
+        msg.forEachChange([this](const SelectionChanges &change) {
+            slotSelectionChanged(change);
+        });
+        return;
+    }
+
     if(msg.Type == SelectionChanges::SetPreselectSignal ||
        msg.Type == SelectionChanges::ShowSelection ||
        msg.Type == SelectionChanges::HideSelection)
@@ -1064,7 +1098,7 @@ bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectN
     if(!logDisabled)
         temp.log(false,clearPreselect);
 
-    _SelList.push_back(temp);
+    addSelEntry(temp);
     _SelStackForward.clear();
 
     if(clearPreselect)
@@ -1217,7 +1251,10 @@ bool SelectionSingleton::addSelections(const char* pDocName, const char* pObject
         notify(SelectionChanges(SelectionChanges::PickedListChanged));
     }
 
-    bool update = false;
+    // Store all elements before notifying anyone, so that observers see the
+    // complete selection and the duplicate check stays a lookup in the index.
+    // The elements are sent as AddSelections, one message for each object.
+    std::vector<SelectionChanges> changes;
     for(const auto & pSubName : pSubNames) {
         _SelObj temp;
         int ret = checkSelection(pDocName, pObjectName, pSubName.c_str(), ResolveMode::NoResolve, temp);
@@ -1228,20 +1265,28 @@ bool SelectionSingleton::addSelections(const char* pDocName, const char* pObject
         temp.y        = 0;
         temp.z        = 0;
 
-        _SelList.push_back(temp);
-        _SelStackForward.clear();
-
-        SelectionChanges Chng(SelectionChanges::AddSelection,
-                temp.DocName,temp.FeatName,temp.SubName,temp.TypeName);
+        addSelEntry(temp);
 
-        FC_LOG("Add Selection "<<Chng.pDocName<<'#'<<Chng.pObjectName<<'.'<<Chng.pSubName);
-
-        notify(std::move(Chng));
-        update = true;
+        // checkSelection() may have moved the selection to a parent object
+        if(changes.empty()
+                || changes.back().Object.getDocumentName() != temp.DocName
+                || changes.back().Object.getObjectName() != temp.FeatName)
+        {
+            changes.emplace_back(SelectionChanges::AddSelections,
+                    temp.DocName,temp.FeatName,std::string(),temp.TypeName);
+        }
+        changes.back().SubNames.push_back(temp.SubName);
     }
 
-    if(update)
+    if(!changes.empty()) {
+        _SelStackForward.clear();
+        for(auto &Chng : changes) {
+            FC_LOG("Add Selections "<<Chng.pDocName<<'#'<<Chng.pObjectName
+                    <<" ("<<Chng.SubNames.size()<<" elements)");
+            notify(std::move(Chng));
+        }
         getMainWindow()->updateActions();
+    }
     return true;
 }
 
@@ -1336,26 +1381,33 @@ void SelectionSingleton::rmvSelection(const char* pDocName, const char* pObjectN
     if (ret<0)
         return;
 
-    std::vector<SelectionChanges> changes;
-    for(auto It=_SelList.begin(),ItNext=It;It!=_SelList.end();It=ItNext) {
-        ++ItNext;
-        if(It->DocName!=temp.DocName || It->FeatName!=temp.FeatName)
-            continue;
-        // if no subname is specified, remove all subobjects of the matching object
-        if(!temp.SubName.empty()) {
-            // otherwise, match subojects with common prefix, separated by '.'
-            if(!boost::starts_with(It->SubName,temp.SubName) ||
-               (It->SubName.length()!=temp.SubName.length() && It->SubName[temp.SubName.length()-1]!='.'))
+    std::vector<std::list<_SelObj>::iterator> matches;
+    auto itIndex = _SelSubIndex.find(temp.pObject);
+    if(itIndex != _SelSubIndex.end()) {
+        auto &subs = itIndex->second;
+        // if no subname is specified, remove all subobjects of the matching object,
+        // otherwise, match subojects with common prefix, separated by '.'
+        for(auto it=subs.lower_bound(temp.SubName);
+                it!=subs.end() && boost::starts_with(it->first,temp.SubName); ++it)
+        {
+            const auto &subName = it->first;
+            if(!temp.SubName.empty()
+                    && subName.length()!=temp.SubName.length()
+                    && subName[temp.SubName.length()-1]!='.')
                 continue;
+            matches.push_back(it->second);
         }
+    }
 
+    std::vector<SelectionChanges> changes;
+    for(auto It : matches) {
         It->log(true);
 
         changes.emplace_back(SelectionChanges::RmvSelection,
                 It->DocName,It->FeatName,It->SubName,It->TypeName);
 
         // destroy the _SelObj item
-        _SelList.erase(It);
+        rmvSelEntry(It);
     }
 
     // NOTE: It can happen that there are nested calls of rmvSelection()
@@ -1493,7 +1545,7 @@ void SelectionSingleton::setSelection(const char* pDocName, const std::vector<Ap
         if (ret!=0)
             continue;
         touched = true;
-        _SelList.push_back(temp);
+        addSelEntry(temp);
     }
 
     if(touched) {
@@ -1529,7 +1581,7 @@ void SelectionSingleton::clearSelection(const char* pDocName, bool clearPreSelec
         for (auto it=_SelList.begin();it!=_SelList.end();) {
             if (it->DocName == docName) {
                 touched = true;
-                it = _SelList.erase(it);
+                it = rmvSelEntry(it);
             }
             else {
                 ++it;
@@ -1587,7 +1639,7 @@ void SelectionSingleton::clearCompleteSelection(bool clearPreSelect)
         vp->onSelectionChanged(Chng);
     }
 
-    _SelList.clear();
+    clearSelEntries();
 
     SelectionChanges Chng(SelectionChanges::ClrSelection);
 
@@ -1613,6 +1665,60 @@ bool SelectionSingleton::isSelected(App::DocumentObject* pObject, const char* pS
             pObject->getNameInDocument(), pSubName, resolve, sel, &_SelList) > 0;
 }
 
+namespace {
+
+// Key of a selection in the element index, see checkSelection() for how
+// entries with and without new style element names are matched
+std::string selElementKey(const std::string &newName, const std::string &oldName)
+{
+    if (!newName.empty())
+        return std::string("n") + newName;
+    return std::string("o") + oldName;
+}
+
+template<class IndexT, class IterT>
+void eraseSelIndex(IndexT &index, const App::DocumentObject *obj, const std::string &key, IterT it)
+{
+    auto itObj = index.find(obj);
+    if (itObj == index.end())
+        return;
+    auto range = itObj->second.equal_range(key);
+    for (auto itKey = range.first; itKey != range.second; ++itKey) {
+        if (itKey->second == it) {
+            itObj->second.erase(itKey);
+            break;
+        }
+    }
+    if (itObj->second.empty())
+        index.erase(itObj);
+}
+
+}
+
+void SelectionSingleton::addSelEntry(const _SelObj &sel)
+{
+    auto it = _SelList.insert(_SelList.end(), sel);
+    _SelSubIndex[it->pObject].emplace(it->SubName, it);
+    _SelElementIndex[it->pResolvedObject].emplace(
+            selElementKey(it->elementName.newName, it->SubName), it);
+}
+
+std::list<SelectionSingleton::_SelObj>::iterator
+SelectionSingleton::rmvSelEntry(std::list<_SelObj>::iterator it)
+{
+    eraseSelIndex(_SelSubIndex, it->pObject, it->SubName, it);
+    eraseSelIndex(_SelElementIndex, it->pResolvedObject,
+            selElementKey(it->elementName.newName, it->SubName), it);
+    return _SelList.erase(it);
+}
+
+void SelectionSingleton::clearSelEntries()
+{
+    _SelSubIndex.clear();
+    _SelElementIndex.clear();
+    _SelList.clear();
+}
+
 int SelectionSingleton::checkSelection(const char *pDocName, const char *pObjectName, const char *pSubName,
                                        ResolveMode resolve, _SelObj &sel, const std::list<_SelObj> *selList) const
 {
@@ -1670,6 +1776,37 @@ int SelectionSingleton::checkSelection(const char *pDocName, const char *pObject
     if(!pSubName)
         pSubName = "";
 
+    if (selList == &_SelList) {
+        // Same matching as the loops below, using the index
+        auto itObj = _SelSubIndex.find(sel.pObject);
+        if (itObj != _SelSubIndex.end()) {
+            const auto &subs = itObj->second;
+            if (subs.find(pSubName) != subs.end())
+                return 1;
+            if (resolve > ResolveMode::OldStyleElement) {
+                auto it = subs.lower_bound(prefix);
+                if (it != subs.end() && boost::starts_with(it->first, prefix))
+                    return 1;
+            }
+        }
+        if (resolve == ResolveMode::OldStyleElement) {
+            auto itResolved = _SelElementIndex.find(sel.pResolvedObject);
+            if (itResolved != _SelElementIndex.end()) {
+                const auto &elements = itResolved->second;
+                if (!pSubName[0])
+                    return 1;
+                if (!sel.elementName.newName.empty()
+                        && elements.find(selElementKey(sel.elementName.newName, std::string()))
+                            != elements.end())
+                    return 1;
+                if (elements.find(selElementKey(std::string(), sel.elementName.oldName))
+                        != elements.end())
+                    return 1;
+            }
+        }
+        return 0;
+    }
+
     for (auto &s : *selList) {
         if (s.DocName==pDocName && s.FeatName==sel.FeatName) {
             if(s.SubName==pSubName)
@@ -1730,7 +1867,7 @@ void SelectionSingleton::slotDeletedObject(const App::DocumentObject& Obj)
         if(it->pResolvedObject == &Obj || it->pObject==&Obj) {
             changes.emplace_back(SelectionChanges::RmvSelection,
                     it->DocName,it->FeatName,it->SubName,it->TypeName);
-            _SelList.erase(it);
+            rmvSelEntry(it);
         }
     }
     if(!changes.empty()) {
@@ -26,7 +26,9 @@
 
 #include <deque>
 #include <list>
+#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <App/DocumentObject.h>
@@ -87,6 +89,7 @@ public:
         HideSelection, // to hide a selection
         RmvPreselectSignal, // to request 3D view to remove preselect
         MovePreselect, // to signal observer the mouse movement when preselect
+        AddSelections, // to signal observer the elements in SubNames were selected at once
     };
     enum class MsgSource {
         Any = 0,
@@ -147,6 +150,7 @@ public:
         pObjectName = Object.getObjectName().c_str();
         pSubName = Object.getSubName().c_str();
         pTypeName = TypeName.c_str();
+        SubNames = other.SubNames;
         pOriginalMsg = other.pOriginalMsg;
         return *this;
     }
@@ -167,10 +171,27 @@ public:
         pObjectName = Object.getObjectName().c_str();
         pSubName = Object.getSubName().c_str();
         pTypeName = TypeName.c_str();
+        SubNames = std::move(other.SubNames);
         pOriginalMsg = other.pOriginalMsg;
         return *this;
     }
 
+    /** Call \a func with this message, or for an AddSelections message with
+     * an AddSelection message for each of its elements
+     */
+    template<class FuncT>
+    void forEachChange(FuncT &&func) const {
+        if (Type != AddSelections) {
+            func(*this);
+            return;
+        }
+        for (const auto &subName : SubNames) {
+            SelectionChanges msg(AddSelection, pDocName, pObjectName,
+                                 subName.c_str(), pTypeName, x, y, z, SubType);
+            func(msg);
+        }
+    }
+
     MsgType Type;
     MsgSource SubType;
 
@@ -185,6 +206,9 @@ public:
     App::SubObjectT Object;
     std::string TypeName;
 
+    // Sub-element names of the object for AddSelections
+    std::vector<std::string> SubNames;
+
     // Original selection message in case resolve!=0
     const SelectionChanges *pOriginalMsg = nullptr;
 };
@@ -222,6 +246,10 @@ public:
     bool blockSelection(bool block);
     bool isSelectionBlocked() const;
     bool isSelectionAttached() const;
+    /** Receive a bulk selection as one AddSelections message instead of an
+     * AddSelection message for each element
+     */
+    void setBatchSelection(bool enable);
 
     /** Attaches to the selection. */
     void attachSelection();
@@ -239,6 +267,7 @@ private:
     std::string filterObjName;
     ResolveMode resolve;
     bool blockedSelection;
+    bool batchSelection = false;
 };
 
 /** SelectionGate
@@ -681,6 +710,20 @@ protected:
     };
     mutable std::list<_SelObj> _SelList;
 
+    using _SelIndex = std::unordered_map<const App::DocumentObject*,
+                                         std::multimap<std::string, std::list<_SelObj>::iterator>>;
+    // Entries of _SelList by object and sub-name, so that checkSelection()
+    // and rmvSelection() don't have to scan the whole list
+    _SelIndex _SelSubIndex;
+    // Entries of _SelList by resolved object and element name
+    _SelIndex _SelElementIndex;
+
+    /// Append \a sel to _SelList and its index
+    void addSelEntry(const _SelObj &sel);
+    /// Remove the entry at \a it from _SelList and its index
+    std::list<_SelObj>::iterator rmvSelEntry(std::list<_SelObj>::iterator it);
+    void clearSelEntries();
+
     mutable std::list<_SelObj> _PickedList;
     bool _needPickedList{false};
 
@@ -0,0 +1,353 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include <FCConfig.h>
+
+#ifdef FC_OS_WIN32
+# include <windows.h>
+#endif
+#ifdef FC_OS_MACOSX
+# include <OpenGL/gl.h>
+#else
+# include <GL/gl.h>
+#endif
+
+#include <algorithm>
+
+#include <Inventor/SbViewportRegion.h>
+#include <Inventor/SoFullPath.h>
+#include <Inventor/SoPickedPoint.h>
+#include <Inventor/actions/SoHandleEventAction.h>
+#include <Inventor/details/SoFaceDetail.h>
+#include <Inventor/details/SoLineDetail.h>
+#include <Inventor/details/SoPointDetail.h>
+#include <Inventor/elements/SoLazyElement.h>
+#include <Inventor/elements/SoLightModelElement.h>
+#include <Inventor/elements/SoModelMatrixElement.h>
+#include <Inventor/elements/SoOverrideElement.h>
+#include <Inventor/events/SoEvent.h>
+#include <Inventor/nodes/SoShape.h>
+#include <Inventor/sensors/SoNodeSensor.h>
+
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+
+#include "SoFCIdBuffer.h"
+#include "SoFCUnifiedSelection.h"
+
+
+using namespace Gui;
+
+namespace {
+
+int getPriority(const SoType & detailType)
+{
+    if (detailType.isDerivedFrom(SoPointDetail::getClassTypeId())) {
+        return 3;
+    }
+    if (detailType.isDerivedFrom(SoLineDetail::getClassTypeId())) {
+        return 2;
+    }
+    return 1;
+}
+
+}
+
+SoFCIdBuffer::SoFCIdBuffer()
+    : sensor(new SoNodeSensor(sensorCB, this))
+{
+    // Immediate sensor, needed to know the trigger node
+    sensor->setPriority(0);
+}
+
+SoFCIdBuffer::~SoFCIdBuffer()
+{
+    delete sensor;
+    clearRanges();
+}
+
+void SoFCIdBuffer::attach(SoNode * scene)
+{
+    sensor->detach();
+    if (scene) {
+        sensor->attach(scene);
+    }
+    invalidate();
+}
+
+void SoFCIdBuffer::detach()
+{
+    sensor->detach();
+    invalidate();
+    clearRanges();
+}
+
+bool SoFCIdBuffer::needsUpdate(const SbViewportRegion & vp) const
+{
+    return !valid || vp.getViewportSizePixels() != size;
+}
+
+void SoFCIdBuffer::invalidate()
+{
+    valid = false;
+}
+
+void SoFCIdBuffer::setPickRadius(int radius)
+{
+    pickRadius = std::max(radius, 0);
+}
+
+void SoFCIdBuffer::clearRanges()
+{
+    for (auto & range : ranges) {
+        range.path->unref();
+    }
+    ranges.clear();
+}
+
+void SoFCIdBuffer::sensorCB(void * data, SoSensor * sensor)
+{
+    auto self = static_cast<SoFCIdBuffer*>(data);
+    if (self->rendering || !self->valid) {
+        return;
+    }
+
+    // Highlighting and selection touch() the affected shapes and selection
+    // roots without changing any field. That doesn't change the ids.
+    auto nodeSensor = static_cast<SoNodeSensor*>(sensor);
+    if (!nodeSensor->getTriggerField()) {
+        SoNode * node = nodeSensor->getTriggerNode();
+        if (node && (node->isOfType(SoShape::getClassTypeId())
+                     || node->isOfType(SoFCSelectionRoot::getClassTypeId())
+                     || node->isOfType(SoFCUnifiedSelection::getClassTypeId()))) {
+            return;
+        }
+    }
+    self->invalidate();
+}
+
+void SoFCIdBuffer::render(SoNode * scene, const SbViewportRegion & vp, uint32_t cacheContext)
+{
+    SbVec2s vpsize = vp.getViewportSizePixels();
+    int width = vpsize[0];
+    int height = vpsize[1];
+    if (!scene || width <= 0 || height <= 0 || !QOpenGLContext::currentContext()) {
+        return;
+    }
+
+    if (!fbo || fbo->width() != width || fbo->height() != height) {
+        QOpenGLFramebufferObjectFormat format;
+        format.setAttachment(QOpenGLFramebufferObject::Depth);
+        format.setSamples(0);
+        format.setInternalTextureFormat(GL_RGBA8);
+        fbo = std::make_unique<QOpenGLFramebufferObject>(width, height, format);
+    }
+    if (!fbo->isValid() || !fbo->bind()) {
+        return;
+    }
+
+    rendering = true;
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+
+    // Anything that mixes colors would produce wrong ids
+    glDisable(GL_DITHER);
+    glDisable(GL_BLEND);
+    glDisable(GL_FOG);
+    glDisable(GL_LINE_SMOOTH);
+    glDisable(GL_POINT_SMOOTH);
+    glDisable(GL_POLYGON_SMOOTH);
+    glEnable(GL_DEPTH_TEST);
+    glDepthRange(0.0, 1.0);
+
+    glViewport(0, 0, width, height);
+    glClearColor(0.0F, 0.0F, 0.0F, 0.0F);
+    glClearDepth(1.0);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    SbViewportRegion region(static_cast<short>(width), static_cast<short>(height));
+    region.setPixelsPerInch(vp.getPixelsPerInch());
+    SoFCIdRenderAction action(region);
+    action.setCacheContext(cacheContext);
+
+    // Shapes that don't write ids are drawn black and opaque, so that they
+    // still hide what is behind them
+    static const uint32_t black = 0x000000ff;
+    SoState * state = action.getState();
+    SoLightModelElement::set(state, scene, SoLightModelElement::BASE_COLOR);
+    SoOverrideElement::setLightModelOverride(state, scene, true);
+    SoLazyElement::setPacked(state, scene, 1, &black, false);
+    SoOverrideElement::setDiffuseColorOverride(state, scene, true);
+    SoOverrideElement::setTransparencyOverride(state, scene, true);
+
+    action.apply(scene);
+
+    std::size_t numPixels = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+    colors.resize(4 * numPixels);
+    depths.resize(numPixels);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, colors.data());
+    glReadPixels(0, 0, width, height, GL_DEPTH_COMPONENT, GL_FLOAT, depths.data());
+
+    glPopAttrib();
+    fbo->release();
+
+    clearRanges();
+    ranges = action.takeRanges();
+
+    SbMatrix affine;
+    SbMatrix proj;
+    action.getViewVolume().getMatrices(affine, proj);
+    affine.multRight(proj);
+    inverseMatrix = affine.inverse();
+
+    size = vpsize;
+    valid = true;
+    rendering = false;
+}
+
+const SoFCIdRenderAction::Range * SoFCIdBuffer::findRange(uint32_t id) const
+{
+    // The ranges are ordered by their first id
+    auto it = std::upper_bound(ranges.begin(), ranges.end(), id,
+        [](uint32_t value, const SoFCIdRenderAction::Range & range) {
+            return value < range.first;
+        });
+    if (it == ranges.begin()) {
+        return nullptr;
+    }
+    --it;
+    if (id >= it->first + static_cast<uint32_t>(it->count)) {
+        return nullptr;
+    }
+    return &(*it);
+}
+
+SoFCIdBuffer::PickResult SoFCIdBuffer::pick(SoHandleEventAction * action, SoPickedPoint *& pp) const
+{
+    pp = nullptr;
+
+    const SbViewportRegion & vp = action->getViewportRegion();
+    if (!valid || vp.getViewportSizePixels() != size) {
+        return PickResult::Unknown;
+    }
+
+    int width = size[0];
+    int height = size[1];
+    SbVec2s pos = action->getEvent()->getPosition(vp);
+    int cx = pos[0];
+    int cy = pos[1];
+    if (cx < 0 || cy < 0 || cx >= width || cy >= height) {
+        return PickResult::Unknown;
+    }
+
+    auto idAt = [&](int x, int y) {
+        const uint8_t * color = &colors[4 * (static_cast<std::size_t>(y) * width + x)];
+        return static_cast<uint32_t>(color[0])
+            | (static_cast<uint32_t>(color[1]) << 8)
+            | (static_cast<uint32_t>(color[2]) << 16);
+    };
+
+    // Something without ids is under the cursor, e.g. a marker or a dragger
+    std::size_t center = static_cast<std::size_t>(cy) * width + cx;
+    if (depths[center] < 1.0F && idAt(cx, cy) == 0) {
+        return PickResult::Unknown;
+    }
+
+    // Prefer vertices over edges within the pick radius, faces count only
+    // right under the cursor
+    const SoFCIdRenderAction::Range * best = nullptr;
+    uint32_t bestId = 0;
+    int bestPriority = 0;
+    int bestDist = 0;
+    int bx = 0;
+    int by = 0;
+    int radius = pickRadius;
+    for (int y = std::max(cy - radius, 0); y <= std::min(cy + radius, height - 1); ++y) {
+        for (int x = std::max(cx - radius, 0); x <= std::min(cx + radius, width - 1); ++x) {
+            uint32_t id = idAt(x, y);
+            if (id == 0) {
+                continue;
+            }
+            int dist = (x - cx) * (x - cx) + (y - cy) * (y - cy);
+            if (dist > radius * radius) {
+                continue;
+            }
+            const SoFCIdRenderAction::Range * range = findRange(id);
+            if (!range) {
+                continue;
+            }
+            int priority = getPriority(range->detailType);
+            if (priority == 1 && dist != 0) {
+                continue;
+            }
+            if (priority > bestPriority || (priority == bestPriority && dist < bestDist)) {
+                best = range;
+                bestId = id;
+                bestPriority = priority;
+                bestDist = dist;
+                bx = x;
+                by = y;
+            }
+        }
+    }
+
+    if (!best) {
+        return PickResult::Nothing;
+    }
+
+    // Back from window to world coordinates
+    float depth = depths[static_cast<std::size_t>(by) * width + bx];
+    SbVec3f ndc(2.0F * (static_cast<float>(bx) + 0.5F) / static_cast<float>(width) - 1.0F,
+                2.0F * (static_cast<float>(by) + 0.5F) / static_cast<float>(height) - 1.0F,
+                2.0F * depth - 1.0F);
+    SbVec3f world;
+    inverseMatrix.multVecMatrix(ndc, world);
+
+    SoState * state = action->getState();
+    SbVec3f point;
+    SoModelMatrixElement::get(state).inverse().multVecMatrix(world, point);
+
+    int index = static_cast<int>(bestId - best->first);
+    SoDetail * detail = nullptr;
+    if (bestPriority == 3) {
+        auto pointDetail = new SoPointDetail;
+        pointDetail->setCoordinateIndex(index);
+        detail = pointDetail;
+    }
+    else if (bestPriority == 2) {
+        auto lineDetail = new SoLineDetail;
+        lineDetail->setLineIndex(index);
+        lineDetail->setPartIndex(index);
+        detail = lineDetail;
+    }
+    else {
+        auto faceDetail = new SoFaceDetail;
+        faceDetail->setPartIndex(index);
+        detail = faceDetail;
+    }
+
+    auto path = static_cast<SoFullPath*>(best->path);
+    pp = new SoPickedPoint(path, state, point);
+    pp->setDetail(detail, path->getTail());
+    return PickResult::Picked;
+}
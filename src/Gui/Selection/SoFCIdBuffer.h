@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef GUI_SOFCIDBUFFER_H
+#define GUI_SOFCIDBUFFER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <Inventor/SbMatrix.h>
+#include <Inventor/SbVec2s.h>
+#include <FCGlobal.h>
+
+#include "SoFCSelectionAction.h"
+
+class QOpenGLFramebufferObject;
+class SbViewportRegion;
+class SoHandleEventAction;
+class SoNode;
+class SoNodeSensor;
+class SoPickedPoint;
+class SoSensor;
+
+namespace Gui
+{
+
+/**
+ * @class SoFCIdBuffer
+ * @brief Offscreen image of the scene where every pixel stores the id of the
+ * element drawn there.
+ *
+ * The buffer is rendered with SoFCIdRenderAction once the view has settled,
+ * and is then used to answer preselection queries with a pixel lookup instead
+ * of a ray pick through the whole scene. Any change of the scene graph other
+ * than highlighting or selection invalidates the buffer.
+ *
+ * Whenever the lookup cannot give the same answer as a ray pick, e.g. because
+ * the buffer is outdated or the cursor is over geometry that does not write
+ * ids, pick() returns Unknown and the caller must fall back to ray picking.
+ */
+class GuiExport SoFCIdBuffer
+{
+public:
+    enum class PickResult {
+        /// The buffer cannot answer, use a ray pick
+        Unknown,
+        /// There is no pickable element under the cursor
+        Nothing,
+        /// An element was found
+        Picked,
+    };
+
+    SoFCIdBuffer();
+    ~SoFCIdBuffer();
+
+    /// Watch \a scene for changes that invalidate the buffer
+    void attach(SoNode * scene);
+    void detach();
+
+    /// Check if the buffer needs to be rendered again for the viewport
+    bool needsUpdate(const SbViewportRegion & vp) const;
+    void invalidate();
+
+    /// Set the distance in pixels within which edges and vertices are picked
+    void setPickRadius(int radius);
+
+    /// Render the buffer, the GL context of the viewer must be current
+    void render(SoNode * scene, const SbViewportRegion & vp, uint32_t cacheContext);
+
+    /** Look up the element under the cursor of the event of \a action
+     * @param pp: the picked point if the result is Picked, owned by the caller
+     */
+    PickResult pick(SoHandleEventAction * action, SoPickedPoint *& pp) const;
+
+private:
+    const SoFCIdRenderAction::Range * findRange(uint32_t id) const;
+    void clearRanges();
+
+    static void sensorCB(void * data, SoSensor * sensor);
+
+private:
+    SoNodeSensor * sensor;
+    std::unique_ptr<QOpenGLFramebufferObject> fbo;
+    std::vector<SoFCIdRenderAction::Range> ranges;
+    // RGBA color and depth of every pixel
+    std::vector<uint8_t> colors;
+    std::vector<float> depths;
+    // maps normalized device coordinates back to world coordinates
+    SbMatrix inverseMatrix;
+    SbVec2s size;
+    int pickRadius = 5;
+    bool valid = false;
+    bool rendering = false;
+};
+
+} // namespace Gui
+
+#endif // GUI_SOFCIDBUFFER_H
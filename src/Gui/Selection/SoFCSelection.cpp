@@ -22,6 +22,7 @@
 
 
 
+# include <algorithm>
 # include <QString>
 # include <Inventor/SoFullPath.h>
 # include <Inventor/SoPickedPoint.h>
@@ -267,6 +268,19 @@ void SoFCSelection::doAction(SoAction *action)
                     return;
                 }
             }
+            else if (selaction->SelChange.Type == SelectionChanges::AddSelections) {
+                const auto &subNames = selaction->SelChange.SubNames;
+                if (documentName.getValue() == selaction->SelChange.pDocName &&
+                    objectName.getValue() == selaction->SelChange.pObjectName &&
+                    std::any_of(subNames.begin(), subNames.end(), [this](const std::string &sub) {
+                        return sub.empty() || subElementName.getValue() == sub.c_str();
+                    })) {
+                    if(selected.getValue() == NOTSELECTED){
+                        selected = SELECTED;
+                    }
+                    return;
+                }
+            }
             else if (selaction->SelChange.Type == SelectionChanges::ClrSelection) {
                 if (documentName.getValue() == selaction->SelChange.pDocName ||
                     strcmp(selaction->SelChange.pDocName,"") == 0){
@@ -20,8 +20,18 @@
  *                                                                         *
  ***************************************************************************/
 
-
-
+#include <FCConfig.h>
+
+#ifdef FC_OS_WIN32
+# include <windows.h>
+#endif
+#ifdef FC_OS_MACOSX
+# include <OpenGL/gl.h>
+#else
+# include <GL/gl.h>
+#endif
+
+# include <Inventor/SoPath.h>
 # include <Inventor/actions/SoSearchAction.h>
 # include <Inventor/actions/SoGetBoundingBoxAction.h>
 # include <Inventor/elements/SoComplexityElement.h>
@@ -1316,6 +1326,63 @@ SoBoxSelectionRenderAction::drawBoxes(SoPath * pathtothis, const SoPathList * pa
     thestate->pop();
 }
 
+// ---------------------------------------------------------------------------
+
+SO_ACTION_SOURCE(SoFCIdRenderAction)
+
+void SoFCIdRenderAction::initClass()
+{
+    SO_ACTION_INIT_CLASS(SoFCIdRenderAction, SoGLRenderAction);
+}
+
+SoFCIdRenderAction::SoFCIdRenderAction(const SbViewportRegion & viewportregion)
+  : inherited(viewportregion)
+{
+    SO_ACTION_CONSTRUCTOR(SoFCIdRenderAction);
+}
+
+SoFCIdRenderAction::~SoFCIdRenderAction()
+{
+    for (auto & range : ranges) {
+        range.path->unref();
+    }
+}
+
+uint32_t SoFCIdRenderAction::addShape(const SoType & detailType, int count)
+{
+    // the ids are encoded in the 24 bits of an RGB color
+    if (count <= 0 || nextId + static_cast<uint32_t>(count) > 0x1000000) {
+        return 0;
+    }
+
+    Range range;
+    range.first = nextId;
+    range.count = count;
+    range.detailType = detailType;
+    range.path = this->getCurPath()->copy();
+    range.path->ref();
+    ranges.push_back(range);
+    nextId += static_cast<uint32_t>(count);
+
+    viewVolume = SoViewVolumeElement::get(this->getState());
+    return range.first;
+}
+
+void SoFCIdRenderAction::setIdColor(uint32_t id)
+{
+    glColor3ub(static_cast<GLubyte>(id & 0xff),
+               static_cast<GLubyte>((id >> 8) & 0xff),
+               static_cast<GLubyte>((id >> 16) & 0xff));
+}
+
+std::vector<SoFCIdRenderAction::Range> SoFCIdRenderAction::takeRanges()
+{
+    std::vector<Range> res;
+    res.swap(ranges);
+    nextId = 1;
+    return res;
+}
+
 
 #undef PRIVATE
 #undef PUBLIC
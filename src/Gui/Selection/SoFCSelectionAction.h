@@ -23,13 +23,16 @@
 #ifndef _SoFCSelectionAction_h
 #define _SoFCSelectionAction_h
 
+#include <cstdint>
 #include <Inventor/SbColor.h>
+#include <Inventor/SbViewVolume.h>
 #include <Inventor/actions/SoGLRenderAction.h>
 #include <Inventor/fields/SoSFColor.h>
 #include <Inventor/fields/SoSFString.h>
 #include <vector>
 #include <FCGlobal.h>
 
+class SoPath;
 class SoSFString;
 class SoSFColor;
 
@@ -344,6 +347,53 @@ private:
     SoBoxSelectionRenderActionP * pimpl;
 };
 
+/**
+ * The SoFCIdRenderAction class renders every pickable element with its own color.
+ * Shapes that support it reserve a range of ids for their elements with addShape()
+ * and draw each element with the color set by setIdColor(). Everything else is
+ * expected to be drawn black, i.e. with id 0.
+ */
+class GuiExport SoFCIdRenderAction : public SoGLRenderAction {
+    using inherited = SoGLRenderAction;
+
+    SO_ACTION_HEADER(SoFCIdRenderAction);
+
+public:
+    /// Ids reserved by a shape
+    struct Range {
+        uint32_t first;
+        int count;
+        /// SoFaceDetail, SoLineDetail or SoPointDetail
+        SoType detailType;
+        /// Path to the shape, referenced
+        SoPath * path;
+    };
+
+    SoFCIdRenderAction(const SbViewportRegion & viewportregion);
+    ~SoFCIdRenderAction() override;
+
+    static void initClass();
+
+    /** Reserve consecutive ids for \a count elements of the current shape
+     * @return the first id or 0 if there are not enough ids left
+     */
+    uint32_t addShape(const SoType & detailType, int count);
+    /// Set the current color to encode \a id
+    static void setIdColor(uint32_t id);
+
+    /// Take the ranges reserved since the last call, sorted by id
+    std::vector<Range> takeRanges();
+    /// The view volume of the last rendered shape
+    const SbViewVolume & getViewVolume() const {
+        return viewVolume;
+    }
+
+private:
+    std::vector<Range> ranges;
+    SbViewVolume viewVolume;
+    uint32_t nextId = 1;
+};
+
 /**
  * Helper class no notify nodes to update VBO.
  * @author Werner Mayer
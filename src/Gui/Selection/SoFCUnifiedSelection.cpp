@@ -81,7 +81,9 @@
 #include "Application.h"
 #include "Document.h"
 #include "DocumentObserver.h"
+#include "Inventor/SoFCRenderCuller.h"
 #include "MainWindow.h"
+#include "SoFCIdBuffer.h"
 #include "SoFCInteractiveElement.h"
 #include "SoFCSelectionAction.h"
 #include "ViewParams.h"
@@ -311,6 +313,44 @@ SoFCUnifiedSelection::getPickedList(SoHandleEventAction* action, bool singlePick
     return ret;
 }
 
+bool SoFCUnifiedSelection::getIdPickedList(SoHandleEventAction* action,
+                                           std::unique_ptr<SoPickedPoint> &pp,
+                                           std::vector<PickedInfo> &ret) const
+{
+    if (!this->idBuffer || !this->pcDocument)
+        return false;
+
+    SoPickedPoint *point = nullptr;
+    switch (this->idBuffer->pick(action, point)) {
+    case SoFCIdBuffer::PickResult::Unknown:
+        return false;
+    case SoFCIdBuffer::PickResult::Nothing:
+        return true;
+    case SoFCIdBuffer::PickResult::Picked:
+        break;
+    }
+    pp.reset(point);
+
+    // Let the ray pick handle anything that isn't a plain element of an object
+    PickedInfo info;
+    info.pp = point;
+    auto path = static_cast<SoFullPath *>(point->getPath());
+    if (!path->containsPath(action->getCurPath()))
+        return false;
+    ViewProvider *vp = this->pcDocument->getViewProviderByPathFromHead(path);
+    if (!vp || !vp->isDerivedFrom(ViewProviderDocumentObject::getClassTypeId()))
+        return false;
+    info.vpd = static_cast<ViewProviderDocumentObject*>(vp);
+    if (!(useNewSelection.getValue() || info.vpd->useNewSelectionModel())
+            || !info.vpd->isSelectable())
+        return false;
+    if (!info.vpd->getElementPicked(info.pp, info.element))
+        return false;
+
+    ret.push_back(info);
+    return true;
+}
+
 void SoFCUnifiedSelection::doAction(SoAction *action)
 {
     if (action->getTypeId() == SoFCEnablePreselectionAction::getClassTypeId()) {
@@ -421,49 +461,24 @@ void SoFCUnifiedSelection::doAction(SoAction *action)
         auto selectionAction = static_cast<SoFCSelectionAction*>(action);
         if(selectionMode.getValue() == ON
             && (selectionAction->SelChange.Type == SelectionChanges::AddSelection
+                || selectionAction->SelChange.Type == SelectionChanges::AddSelections
                 || selectionAction->SelChange.Type == SelectionChanges::RmvSelection))
         {
             // selection changes inside the 3d view are handled in handleEvent()
-            App::Document* doc = App::GetApplication().getDocument(selectionAction->SelChange.pDocName);
-            App::DocumentObject* obj = doc->getObject(selectionAction->SelChange.pObjectName);
+            const auto &change = selectionAction->SelChange;
+            App::Document* doc = App::GetApplication().getDocument(change.pDocName);
+            App::DocumentObject* obj = doc->getObject(change.pObjectName);
             ViewProvider*vp = Application::Instance->getViewProvider(obj);
             if (vp && (useNewSelection.getValue()||vp->useNewSelectionModel()) && vp->isSelectable()) {
-                SoDetail *detail = nullptr;
-                detailPath->truncate(0);
-                auto subName = selectionAction->SelChange.pSubName;
-                App::ElementNamePair elementName;;
-                App::GeoFeature::resolveElement(obj, subName, elementName);
-                if (Data::isMappedElement(subName)
-                    && !elementName.oldName.empty()) {      // If we have a shortened element name
-                    subName = elementName.oldName.c_str();  // use it.
+                if (change.Type == SelectionChanges::AddSelections) {
+                    // all elements of a bulk selection belong to the same object
+                    for (const auto &subName : change.SubNames)
+                        applySelection(vp, obj, subName.c_str(), true);
                 }
-                if(!selectionAction->SelChange.pSubName || !selectionAction->SelChange.pSubName[0] ||
-                    vp->getDetailPath(subName,detailPath,true,detail))
-                {
-                    SoSelectionElementAction::Type type = SoSelectionElementAction::None;
-                    if (selectionAction->SelChange.Type == SelectionChanges::AddSelection) {
-                        if (detail)
-                            type = SoSelectionElementAction::Append;
-                        else
-                            type = SoSelectionElementAction::All;
-                    }
-                    else {
-                        if (detail)
-                            type = SoSelectionElementAction::Remove;
-                        else
-                            type = SoSelectionElementAction::None;
-                    }
-
-                    SoSelectionElementAction selectionAction(type);
-                    selectionAction.setColor(this->colorSelection.getValue());
-                    selectionAction.setElement(detail);
-                    if(detailPath->getLength())
-                        selectionAction.apply(detailPath);
-                    else
-                        selectionAction.apply(vp->getRoot());
+                else {
+                    applySelection(vp, obj, change.pSubName,
+                                   change.Type == SelectionChanges::AddSelection);
                 }
-                detailPath->truncate(0);
-                delete detail;
             }
         }
         else if (selectionAction->SelChange.Type == SelectionChanges::ClrSelection) {
@@ -519,6 +534,46 @@ void SoFCUnifiedSelection::doAction(SoAction *action)
     inherited::doAction( action );
 }
 
+void SoFCUnifiedSelection::applySelection(ViewProvider *vp, App::DocumentObject *obj,
+                                          const char *pSubName, bool add)
+{
+    SoDetail *detail = nullptr;
+    detailPath->truncate(0);
+    auto subName = pSubName;
+    App::ElementNamePair elementName;
+    App::GeoFeature::resolveElement(obj, subName, elementName);
+    if (Data::isMappedElement(subName)
+        && !elementName.oldName.empty()) {      // If we have a shortened element name
+        subName = elementName.oldName.c_str();  // use it.
+    }
+    if(!pSubName || !pSubName[0] || vp->getDetailPath(subName,detailPath,true,detail))
+    {
+        SoSelectionElementAction::Type type = SoSelectionElementAction::None;
+        if (add) {
+            if (detail)
+                type = SoSelectionElementAction::Append;
+            else
+                type = SoSelectionElementAction::All;
+        }
+        else {
+            if (detail)
+                type = SoSelectionElementAction::Remove;
+            else
+                type = SoSelectionElementAction::None;
+        }
+
+        SoSelectionElementAction selectionAction(type);
+        selectionAction.setColor(this->colorSelection.getValue());
+        selectionAction.setElement(detail);
+        if(detailPath->getLength())
+            selectionAction.apply(detailPath);
+        else
+            selectionAction.apply(vp->getRoot());
+    }
+    detailPath->truncate(0);
+    delete detail;
+}
+
 bool SoFCUnifiedSelection::setPreselect(const PickedInfo &info) {
     if(!info.pp)
         return setPreselect(nullptr,nullptr,nullptr,nullptr,0.0,0.0,0.0);
@@ -786,7 +841,10 @@ SoFCUnifiedSelection::handleEvent(SoHandleEventAction * action)
         // set has been selected.
         if (preselectionMode == AUTO || preselectionMode == ON) {
             // check to see if the mouse is over our geometry...
-            auto infos = this->getPickedList(action,true);
+            std::unique_ptr<SoPickedPoint> idPicked;
+            std::vector<PickedInfo> infos;
+            if (!getIdPickedList(action, idPicked, infos))
+                infos = this->getPickedList(action,true);
             if(!infos.empty())
                 setPreselect(infos[0]);
             else {
@@ -1320,6 +1378,9 @@ bool SoFCSelectionRoot::renderBBox(SoGLRenderAction *action, SoNode *node, SbCol
 static std::time_t _CyclicLastReported;
 
 void SoFCSelectionRoot::renderPrivate(SoGLRenderAction * action, bool inPath) {
+    // Only the root node of a view provider is culled
+    if(!inPath && SelStack.empty() && SoFCRenderCuller::cull(action,this))
+        return;
     if(ViewParams::instance()->getCoinCycleCheck()
             && !SelStack.nodeSet.insert(this).second)
     {
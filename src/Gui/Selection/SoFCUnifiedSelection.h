@@ -24,6 +24,7 @@
 #define GUI_SOFCUNIFIEDSELECTION_H
 
 #include <list>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -45,6 +46,7 @@ class SoDetail;
 namespace Gui {
 
 class Document;
+class SoFCIdBuffer;
 class ViewProviderDocumentObject;
 
 /**  Unified Selection node
@@ -86,6 +88,11 @@ public:
 
     static bool hasHighlight();
 
+    /// Use \a buffer to look up the preselected element, may be null
+    void setIdBuffer(SoFCIdBuffer *buffer) {
+        idBuffer = buffer;
+    }
+
     friend class View3DInventorViewer;
 
 protected:
@@ -104,10 +111,15 @@ private:
     bool setPreselect(SoFullPath *path, const SoDetail *det,
             ViewProviderDocumentObject *vpd, const char *element, float x, float y, float z);
     bool setSelection(const std::vector<PickedInfo> &, bool ctrlDown=false);
+    /// Apply an added or removed selection of \a subName to the nodes of \a vp
+    void applySelection(ViewProvider *vp, App::DocumentObject *obj, const char *subName, bool add);
 
     std::vector<PickedInfo> getPickedList(SoHandleEventAction* action, bool singlePick) const;
+    bool getIdPickedList(SoHandleEventAction* action, std::unique_ptr<SoPickedPoint> &pp,
+                         std::vector<PickedInfo> &ret) const;
 
     Gui::Document       *pcDocument{nullptr};
+    SoFCIdBuffer        *idBuffer{nullptr};
 
     static SoFullPath * currentHighlightPath;
     SoFullPath * detailPath;
@@ -82,6 +82,15 @@ void SoFCColorBarBase::setModified()
     _boxWidth = -1.0f;
 }
 
+void SoFCColorBarBase::getPackedColors(const float* values,
+                                       std::size_t count,
+                                       uint32_t* colors) const
+{
+    for (std::size_t i = 0; i < count; i++) {
+        colors[i] = getColor(values[i]).getPackedValue();  // NOLINT
+    }
+}
+
 void SoFCColorBarBase::setFormat(const SoLabelTextFormat& fmt)
 {
     format = fmt;
@@ -295,6 +304,11 @@ Base::Color SoFCColorBar::getColor( float fVal ) const
     return this->getActiveBar()->getColor( fVal );
 }
 
+void SoFCColorBar::getPackedColors(const float* values, std::size_t count, uint32_t* colors) const
+{
+    this->getActiveBar()->getPackedColors(values, count, colors);
+}
+
 void SoFCColorBar::eventCallback(void * /*userdata*/, SoEventCallback * node)
 {
     const SoEvent * event = node->getEvent();
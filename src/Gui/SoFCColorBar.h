@@ -77,6 +77,11 @@ public:
    * This method must be implemented in subclasses.
    */
   Base::Color getColor(float fVal) const override = 0;
+  /**
+   * Converts the \a count values into colors packed as 0xRRGGBBAA.
+   * The default implementation calls \ref getColor for one value after the other.
+   */
+  virtual void getPackedColors(const float* values, std::size_t count, uint32_t* colors) const;
   /**
    * Returns always true if the color bar is in mode to show colors to arbitrary values of \a fVal,
    * otherwise true is returned if \a fVal is within the specified parameter range, if not false is
@@ -192,6 +197,10 @@ public:
    * Returns the associated color to the value \a fVal of the currently active color bar.
    */
   Base::Color getColor(float fVal) const override;
+  /**
+   * Converts the values into packed colors with the currently active color bar.
+   */
+  void getPackedColors(const float* values, std::size_t count, uint32_t* colors) const override;
   /**
    * Sets whether values outside the range should be in gray,
    */
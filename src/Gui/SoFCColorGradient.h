@@ -59,6 +59,10 @@ public:
    * Returns the associated color to the value \a fVal.
    */
   Base::Color getColor (float fVal) const override { return _cColGrad.getColor(fVal); }
+  void getPackedColors(const float* values, std::size_t count, uint32_t* colors) const override
+  {
+    _cColGrad.getPackedColors(values, count, colors);
+  }
   void setOutsideGrayed (bool bVal) override { _cColGrad.setOutsideGrayed(bVal); }
   /**
    * Returns always true if the gradient is in mode to show colors to arbitrary values of \a fVal,
@@ -80,6 +80,7 @@
 #include "Inventor/SoFCBackgroundGradient.h"
 #include "Inventor/SoFCBoundingBox.h"
 #include "Inventor/SoMouseWheelEvent.h"
+#include "Inventor/SoFCInstancedArray.h"
 #include "Inventor/SoFCTransform.h"
 #include "Inventor/SoToggleSwitch.h"
 #include "propertyeditor/PropertyItem.h"
@@ -129,6 +130,7 @@ void Gui::SoFCDB::init()
     SoVisibleFaceAction             ::initClass();
     SoUpdateVBOAction               ::initClass();
     SoBoxSelectionRenderAction      ::initClass();
+    SoFCIdRenderAction              ::initClass();
     SoFCVectorizeSVGAction          ::initClass();
     SoFCVectorizeU3DAction          ::initClass();
     SoHighlightElementAction        ::initClass();
@@ -146,6 +148,9 @@ void Gui::SoFCDB::init()
     SoRegPoint                      ::initClass();
     SoDrawingGrid                   ::initClass();
     SoFCTransform                   ::initClass();
+    SoFCInstancedElement            ::initClass();
+    SoFCInstancedArray              ::initClass();
+    SoFCInstanceSwitch              ::initClass();
     SoAutoZoomTranslation           ::initClass();
     MarkerBitmaps                   ::initClass();
     SoTransformDragger              ::initClass();
@@ -262,6 +267,8 @@ void Gui::SoFCDB::finish()
     SoFCSeparator                   ::finish();
     SoFCSelectionRoot               ::finish();
     SoFCPathAnnotation              ::finish();
+    SoFCInstancedArray              ::finish();
+    SoFCInstanceSwitch              ::finish();
 
     storage->unref();
     storage = nullptr;
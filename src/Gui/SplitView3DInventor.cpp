@@ -22,6 +22,7 @@
 
 
 
+# include <QOpenGLWidget>
 # include <QSplitter>
 # include <QSurfaceFormat>
 # include <Inventor/nodes/SoDirectionalLight.h>
@@ -38,6 +39,7 @@
 #include "Document.h"
 #include "Navigation/NavigationStyle.h"
 #include "SoFCSelectionAction.h"
+#include "View3DInventor.h"
 #include "View3DInventorViewer.h"
 #include "View3DPy.h"
 #include "View3DSettings.h"
@@ -593,16 +595,33 @@ SplitView3DInventor::SplitView3DInventor(int views, Gui::Document* pcDocument, Q
     while (views < 2)
         views ++;
 
+    // Share the GL resources with the other views of the document, like Std_ViewCreate
+    // does, so that vertex buffers and display lists are not uploaded once per view
+    const QOpenGLWidget* shareWidget = nullptr;
+    if (pcDocument) {
+        std::list<MDIView*> theViews = pcDocument->getMDIViewsOfType(View3DInventor::getClassTypeId());
+        if (!theViews.empty()) {
+            auto firstView = static_cast<View3DInventor*>(theViews.front());
+            shareWidget = qobject_cast<QOpenGLWidget*>(firstView->getViewer()->getGLWidget());
+        }
+    }
+
+    auto addViewer = [&](QWidget* parent) {
+        View3DInventorViewer* viewer = glformat ? new View3DInventorViewer(f, parent, shareWidget)
+                                                : new View3DInventorViewer(parent, shareWidget);
+        if (!shareWidget) {
+            shareWidget = qobject_cast<QOpenGLWidget*>(viewer->getGLWidget());
+        }
+        _viewer.push_back(viewer);
+    };
+
     QSplitter* mainSplitter = nullptr;
 
     // if views < 3 show them as a row
     if (views <= 3) {
         mainSplitter = new QSplitter(Qt::Horizontal, this);
         for (int i=0; i < views; i++) {
-            if (glformat)
-                _viewer.push_back(new View3DInventorViewer(f, mainSplitter));
-            else
-                _viewer.push_back(new View3DInventorViewer(mainSplitter));
+            addViewer(mainSplitter);
         }
     }
     else {
@@ -610,20 +629,11 @@ SplitView3DInventor::SplitView3DInventor(int views, Gui::Document* pcDocument, Q
         auto topSplitter = new QSplitter(Qt::Horizontal, mainSplitter);
         auto botSplitter = new QSplitter(Qt::Horizontal, mainSplitter);
 
-        if (glformat) {
-            _viewer.push_back(new View3DInventorViewer(f, topSplitter));
-            _viewer.push_back(new View3DInventorViewer(f, topSplitter));
-        }
-        else {
-            _viewer.push_back(new View3DInventorViewer(topSplitter));
-            _viewer.push_back(new View3DInventorViewer(topSplitter));
-        }
+        addViewer(topSplitter);
+        addViewer(topSplitter);
 
         for (int i=2;i<views;i++) {
-            if (glformat)
-                _viewer.push_back(new View3DInventorViewer(f, botSplitter));
-            else
-                _viewer.push_back(new View3DInventorViewer(botSplitter));
+            addViewer(botSplitter);
         }
 
         topSplitter->setOpaqueResize(true);
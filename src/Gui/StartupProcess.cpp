@@ -39,9 +39,11 @@
 #include <QWindow>
 #include <Inventor/SoDB.h>
 
+#include <chrono>
 #include <set>
 #include <string>
 #include <ranges>
+#include <vector>
 
 #include "StartupProcess.h"
 #include "Application.h"
@@ -54,10 +56,80 @@
 #include "Dialogs/DlgVersionMigrator.h"
 #include <App/Application.h>
 #include <Base/Console.h>
+#include <Base/Profiler.h>
 
 
 using namespace Gui;
 
+namespace {
+
+// Time spent in the startup phases, printed with --startup-report
+class StartupTimer
+{
+public:
+    template<typename Func>
+    static void run(const char* phase, Func&& func)
+    {
+        ZoneTransientN(zone, phase, true);
+        // reserve the entry so that nested phases are listed below it
+        std::size_t index = phases().size();
+        phases().push_back({phase, 0.0, depth()});
+        auto start = std::chrono::steady_clock::now();
+        ++depth();
+        try {
+            func();
+        }
+        catch (...) {
+            --depth();
+            throw;
+        }
+        --depth();
+        std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+        phases()[index].time = time.count();
+    }
+
+    static void report()
+    {
+        if (App::Application::Config()["StartupReport"] != "1") {
+            return;
+        }
+
+        double total = 0.0;
+        Base::Console().message("Startup report:\n");
+        for (const auto& it : phases()) {
+            std::string name(2 * (it.depth + 1), ' ');
+            name += it.name;
+            Base::Console().message("%-32s %10.1f ms\n", name.c_str(), it.time);
+            if (it.depth == 0) {
+                total += it.time;
+            }
+        }
+        Base::Console().message("%-32s %10.1f ms\n", "  Total", total);
+        phases().clear();
+    }
+
+private:
+    struct Phase {
+        const char* name;
+        double time;
+        int depth;
+    };
+
+    static std::vector<Phase>& phases()
+    {
+        static std::vector<Phase> list;
+        return list;
+    }
+
+    static int& depth()
+    {
+        static int value = 0;
+        return value;
+    }
+};
+
+}
+
 
 StartupProcess::StartupProcess() = default;
 
@@ -115,12 +187,12 @@ void StartupProcess::setupApplication()
 
 void StartupProcess::execute()
 {
-    setLibraryPath();
-    setStyleSheetPaths();
-    setImagePaths();
-    registerEventType();
-    setThemePaths();
-    setupFileDialog();
+    StartupTimer::run("Library path", [this] { setLibraryPath(); });
+    StartupTimer::run("Style sheet paths", [this] { setStyleSheetPaths(); });
+    StartupTimer::run("Image paths", [this] { setImagePaths(); });
+    StartupTimer::run("Event types", [this] { registerEventType(); });
+    StartupTimer::run("Theme paths", [this] { setThemePaths(); });
+    StartupTimer::run("File dialog", [this] { setupFileDialog(); });
 }
 
 void StartupProcess::setLibraryPath()
@@ -216,21 +288,22 @@ void StartupPostProcess::setLoadFromPythonModule(bool value)
 
 void StartupPostProcess::execute()
 {
-    setWindowTitle();
-    setProcessMessages();
-    setAutoSaving();
-    setToolBarIconSize();
-    setWheelEventFilter();
-    setLocale();
-    setCursorFlashing();
-    setQtStyle();
-    checkOpenGL();
-    loadOpenInventor();
-    setBranding();
-    showMainWindow();
-    activateWorkbench();
-    checkParameters();
-    checkVersionMigration();
+    StartupTimer::run("Window title", [this] { setWindowTitle(); });
+    StartupTimer::run("Process messages", [this] { setProcessMessages(); });
+    StartupTimer::run("Auto saving", [this] { setAutoSaving(); });
+    StartupTimer::run("Tool bar icon size", [this] { setToolBarIconSize(); });
+    StartupTimer::run("Wheel event filter", [this] { setWheelEventFilter(); });
+    StartupTimer::run("Locale", [this] { setLocale(); });
+    StartupTimer::run("Cursor flashing", [this] { setCursorFlashing(); });
+    StartupTimer::run("Qt style", [this] { setQtStyle(); });
+    StartupTimer::run("OpenGL check", [this] { checkOpenGL(); });
+    StartupTimer::run("Open Inventor", [this] { loadOpenInventor(); });
+    StartupTimer::run("Branding", [this] { setBranding(); });
+    StartupTimer::run("Main window", [this] { showMainWindow(); });
+    StartupTimer::run("Workbenches", [this] { activateWorkbench(); });
+    StartupTimer::run("Parameter check", [this] { checkParameters(); });
+    StartupTimer::run("Version migration", [this] { checkVersionMigration(); });
+    StartupTimer::report();
 }
 
 void StartupPostProcess::setWindowTitle()
@@ -431,7 +504,7 @@ void StartupPostProcess::showMainWindow()
     // running the GUI init script
     try {
         Base::Console().log("Run Gui init script\n");
-        Application::runInitGuiScript();
+        StartupTimer::run("Gui init script", [] { Application::runInitGuiScript(); });
         setImportImageFormats();
     }
     catch (const Base::Exception& e) {
@@ -484,7 +557,7 @@ void StartupPostProcess::activateWorkbench()
     // Call this before showing the main window because otherwise:
     // 1. it shows a white window for a few seconds which doesn't look nice
     // 2. the layout of the toolbars is completely broken
-    guiApp.activateWorkbench(start.c_str());
+    StartupTimer::run("Start workbench", [this, &start] { guiApp.activateWorkbench(start.c_str()); });
 
     // show the main window
     if (!Application::hiddenMainWindow()) {
@@ -497,11 +570,11 @@ void StartupPostProcess::activateWorkbench()
         fcApp->initSpaceball(mainWindow);
     }
 
-    setStyleSheet();
+    StartupTimer::run("Style sheet", [this] { setStyleSheet(); });
 
     // Now run the background autoload, for workbenches that should be loaded at startup, but not
     // displayed to the user immediately
-    autoloadModules(wb);
+    StartupTimer::run("Autoload modules", [this, &wb] { autoloadModules(wb); });
 
     // Reactivate the startup workbench
     guiApp.activateWorkbench(start.c_str());
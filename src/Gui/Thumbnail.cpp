@@ -90,8 +90,12 @@ void Thumbnail::SaveDocFile (Base::Writer &writer) const
         return;
     }
 
-    QColor invalid;
-    this->viewer->imageFromFramebuffer(this->size, this->size, 4, invalid, img);
+    // Prefer the last idle frame of the view over rendering the scene again
+    img = this->viewer->imageFromLastFrame(this->size);
+    if (img.isNull()) {
+        QColor invalid;
+        this->viewer->imageFromFramebuffer(this->size, this->size, 4, invalid, img);
+    }
 
     // Get app icon and resize to half size to insert in topbottom position over the current view snapshot
     QPixmap appIcon = Gui::BitmapFactory().pixmap(App::Application::Config()["AppIcon"].c_str());
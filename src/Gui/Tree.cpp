@@ -3099,6 +3099,7 @@ void TreeWidget::onUpdateStatus()
         auto docItem = getDocumentItem(gdoc);
         if (!docItem)
             continue;
+        std::vector<ViewProviderDocumentObject*> vps;
         for (auto id : v.second) {
             auto obj = doc->getObjectByID(id);
             if (!obj)
@@ -3109,7 +3110,24 @@ void TreeWidget::onUpdateStatus()
                 continue;
             auto vpd = freecad_cast<ViewProviderDocumentObject*>(gdoc->getViewProvider(obj));
             if (vpd)
-                docItem->createNewItem(*vpd);
+                vps.push_back(vpd);
+        }
+
+        // With lazy child items, first find out which of the new objects
+        // are claimed by a group, and only create items for the others.
+        bool lazy = TreeParams::getLazyChildItems();
+        if (lazy) {
+            for (auto vpd : vps)
+                docItem->getObjectData(*vpd);
+        }
+        for (auto vpd : vps) {
+            auto obj = vpd->getObject();
+            auto it = docItem->ObjectMap.find(obj);
+            if (it != docItem->ObjectMap.end() && (!lazy || !it->second->items.empty()))
+                continue;
+            if (lazy && docItem->isClaimedFromRoot(obj))
+                continue;
+            docItem->createNewItem(*vpd);
         }
     }
 
@@ -3969,18 +3987,8 @@ bool DocumentItem::createNewItem(const Gui::ViewProviderDocumentObject& obj,
         return false;
 
     if (!data) {
-        auto& pdata = ObjectMap[obj.getObject()];
-        if (!pdata) {
-            pdata = std::make_shared<DocumentObjectData>(
-                this, const_cast<ViewProviderDocumentObject*>(&obj));
-            auto& entry = getTree()->ObjectTable[obj.getObject()];
-            if (!entry.empty())
-                pdata->updateChildren(*entry.begin());
-            else
-                pdata->updateChildren(true);
-            entry.insert(pdata);
-        }
-        else if (pdata->rootItem && !parent) {
+        auto pdata = getObjectData(obj);
+        if (pdata->rootItem && !parent) {
             Base::Console().warning("DocumentItem::slotNewObject: Cannot add view provider twice.\n");
             return false;
         }
@@ -4011,6 +4019,50 @@ bool DocumentItem::createNewItem(const Gui::ViewProviderDocumentObject& obj,
     return true;
 }
 
+DocumentObjectDataPtr DocumentItem::getObjectData(const Gui::ViewProviderDocumentObject& obj)
+{
+    auto& pdata = ObjectMap[obj.getObject()];
+    if (!pdata) {
+        pdata = std::make_shared<DocumentObjectData>(
+            this, const_cast<ViewProviderDocumentObject*>(&obj));
+        auto& entry = getTree()->ObjectTable[obj.getObject()];
+        if (!entry.empty())
+            pdata->updateChildren(*entry.begin());
+        else
+            pdata->updateChildren(true);
+        entry.insert(pdata);
+    }
+    return pdata;
+}
+
+bool DocumentItem::isClaimedFromRoot(App::DocumentObject* obj) const
+{
+    // The object is shown under its parent only if the chain of parents
+    // reaches the root, which is not the case for cyclic claims
+    std::set<App::DocumentObject*> visited;
+    std::vector<App::DocumentObject*> pending(1, obj);
+    while (!pending.empty()) {
+        auto current = pending.back();
+        pending.pop_back();
+        if (!visited.insert(current).second)
+            continue;
+        bool claimed = false;
+        auto it = _ParentMap.find(current);
+        if (it != _ParentMap.end()) {
+            for (auto parent : it->second) {
+                auto itData = ObjectMap.find(parent);
+                if (itData != ObjectMap.end() && itData->second->removeChildrenFromRoot) {
+                    claimed = true;
+                    pending.push_back(parent);
+                }
+            }
+        }
+        if (!claimed && current != obj)
+            return true;
+    }
+    return false;
+}
+
 ViewProviderDocumentObject* DocumentItem::getViewProvider(App::DocumentObject* obj) {
     return freecad_cast<ViewProviderDocumentObject*>(
             Application::Instance->getViewProvider(obj));
@@ -4091,7 +4143,9 @@ void TreeWidget::_slotDeleteObject(const Gui::ViewProviderDocumentObject& view,
             docItem->_ParentMap[child].erase(obj);
             auto cit = docItem->ObjectMap.find(child);
             if (cit == docItem->ObjectMap.end() || cit->second->items.empty()) {
-                if (docItem->createNewItem(*childVp))
+                // A lazy child item is created once its other parent is expanded
+                bool lazy = TreeParams::getLazyChildItems() && docItem->isClaimedFromRoot(child);
+                if (!lazy && docItem->createNewItem(*childVp))
                     needUpdate = true;
             }
             else {
@@ -4120,6 +4174,12 @@ bool DocumentItem::populateObject(App::DocumentObject* obj) {
     if (it == ObjectMap.end())
         return false;
     auto& items = it->second->items;
+    if (items.empty() && TreeParams::getLazyChildItems()) {
+        // The item has not been created yet, populate a parent item instead
+        std::set<App::DocumentObject*> visited;
+        if (!populateParentItem(obj, visited))
+            return false;
+    }
     if (items.empty())
         return false;
     for (auto item : items) {
@@ -4133,6 +4193,36 @@ bool DocumentItem::populateObject(App::DocumentObject* obj) {
     return true;
 }
 
+bool DocumentItem::populateParentItem(App::DocumentObject* obj,
+                                      std::set<App::DocumentObject*>& visited)
+{
+    if (!visited.insert(obj).second)
+        return false;
+    auto itParents = _ParentMap.find(obj);
+    if (itParents == _ParentMap.end())
+        return false;
+    auto it = ObjectMap.find(obj);
+    if (it == ObjectMap.end())
+        return false;
+    const auto& items = it->second->items;
+    for (auto parent : itParents->second) {
+        auto itParent = ObjectMap.find(parent);
+        if (itParent == ObjectMap.end())
+            continue;
+        if (itParent->second->items.empty() && !populateParentItem(parent, visited))
+            continue;
+        for (auto item : itParent->second->items) {
+            if (!item->populated) {
+                item->populated = true;
+                populateItem(item, true);
+            }
+        }
+        if (!items.empty())
+            return true;
+    }
+    return false;
+}
+
 void DocumentItem::populateItem(DocumentObjectItem* item, bool refresh, bool delay)
 {
     (void)delay;
@@ -4157,9 +4247,14 @@ void DocumentItem::populateItem(DocumentObjectItem* item, bool refresh, bool del
         auto linked = obj->getLinkedObject(true);
         if (linked && linked->getDocument() != obj->getDocument())
             return;
+        // With lazy child items, the items of children that are removed
+        // from the root are only created once this item is expanded
+        bool lazy = TreeParams::getLazyChildItems() && item->myData->removeChildrenFromRoot;
         for (auto child : item->myData->children) {
             auto it = ObjectMap.find(child);
             if (it == ObjectMap.end() || it->second->items.empty()) {
+                if (lazy)
+                    continue;
                 auto vp = getViewProvider(child);
                 if (!vp) continue;
                 doPopulate = true;
@@ -4732,13 +4827,15 @@ void DocumentItem::slotScrollToObject(const Gui::ViewProviderDocumentObject& obj
 {
     if (!obj.getObject() || !obj.getObject()->isAttachedToDocument())
         return;
+    getTree()->_updateStatus(false);
     auto it = ObjectMap.find(obj.getObject());
-    if (it == ObjectMap.end() || it->second->items.empty())
+    if (it == ObjectMap.end())
+        return;
+    if (it->second->items.empty() && !populateObject(obj.getObject()))
         return;
     auto item = it->second->rootItem;
     if (!item)
         item = *it->second->items.begin();
-    getTree()->_updateStatus(false);
     getTree()->scrollToItem(item);
 }
 
@@ -4991,7 +5088,9 @@ DocumentObjectItem* DocumentItem::findItemByObject(
         subname = "";
 
     auto it = ObjectMap.find(obj);
-    if (it == ObjectMap.end() || it->second->items.empty())
+    if (it == ObjectMap.end())
+        return nullptr;
+    if (it->second->items.empty() && (!sync || !populateObject(obj)))
         return nullptr;
 
     // prefer top level item of this object
@@ -5679,6 +5778,10 @@ bool DocumentObjectItem::requiredAtRoot(bool excludeSelf) const {
         checkMap = false;
     }
     if (checkMap && myOwner) {
+        // The item is created again once its parent item is expanded
+        if (TreeParams::getLazyChildItems()
+                && myOwner->isClaimedFromRoot(object()->getObject()))
+            return false;
         auto it = myOwner->_ParentMap.find(object()->getObject());
         if (it != myOwner->_ParentMap.end()) {
             // Reaching here means all items of this corresponding object is
@@ -318,6 +318,7 @@ public:
     void setData(int column, int role, const QVariant & value) override;
     void populateItem(DocumentObjectItem *item, bool refresh=false, bool delayUpdate=true);
     bool populateObject(App::DocumentObject *obj);
+    bool populateParentItem(App::DocumentObject *obj, std::set<App::DocumentObject*> &visited);
     void sortObjectItems();
     void selectAllInstances(const ViewProviderDocumentObject &vpd);
     bool showItem(DocumentObjectItem *item, bool select, bool force=false);
@@ -363,6 +364,9 @@ protected:
     bool createNewItem(const Gui::ViewProviderDocumentObject&,
                     QTreeWidgetItem *parent=nullptr, int index=-1,
                     DocumentObjectDataPtr ptrs = DocumentObjectDataPtr());
+    DocumentObjectDataPtr getObjectData(const Gui::ViewProviderDocumentObject&);
+    /// Check if the object is shown under a parent that removes it from the root
+    bool isClaimedFromRoot(App::DocumentObject *obj) const;
 
     int findRootIndex(App::DocumentObject *childObj);
 
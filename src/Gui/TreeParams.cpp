@@ -81,6 +81,7 @@ public:
     long ColumnSize3;
     bool TreeToolTipIcon;
     bool VisibilityIcon;
+    bool LazyChildItems;
 
     // Auto generated code (Tools/params_utils.py:245)
     TreeParamsP() {
@@ -165,6 +166,8 @@ public:
         funcs["TreeToolTipIcon"] = &TreeParamsP::updateTreeToolTipIcon;
         VisibilityIcon = handle->GetBool("VisibilityIcon", true);
         funcs["VisibilityIcon"] = &TreeParamsP::updateVisibilityIcon;
+        LazyChildItems = handle->GetBool("LazyChildItems", false);
+        funcs["LazyChildItems"] = &TreeParamsP::updateLazyChildItems;
     }
 
     // Auto generated code (Tools/params_utils.py:263)
@@ -419,6 +422,10 @@ public:
             TreeParams::onVisibilityIconChanged();
         }
     }
+    // Auto generated code (Tools/params_utils.py:288)
+    static void updateLazyChildItems(TreeParamsP *self) {
+        self->LazyChildItems = self->handle->GetBool("LazyChildItems", false);
+    }
 };
 
 // Auto generated code (Tools/params_utils.py:310)
@@ -1494,6 +1501,34 @@ void TreeParams::setVisibilityIcon(const bool &v) {
 void TreeParams::removeVisibilityIcon() {
     instance()->handle->RemoveBool("VisibilityIcon");
 }
+
+// Auto generated code (Tools/params_utils.py:350)
+const char *TreeParams::docLazyChildItems() {
+    return QT_TRANSLATE_NOOP("TreeParams",
+"Only create tree items for the children of a group when the group is expanded or one of the children is selected. Speeds up opening documents with many objects.");
+}
+
+// Auto generated code (Tools/params_utils.py:358)
+const bool & TreeParams::getLazyChildItems() {
+    return instance()->LazyChildItems;
+}
+
+// Auto generated code (Tools/params_utils.py:366)
+const bool & TreeParams::defaultLazyChildItems() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:375)
+void TreeParams::setLazyChildItems(const bool &v) {
+    instance()->handle->SetBool("LazyChildItems",v);
+    instance()->LazyChildItems = v;
+}
+
+// Auto generated code (Tools/params_utils.py:384)
+void TreeParams::removeLazyChildItems() {
+    instance()->handle->RemoveBool("LazyChildItems");
+}
 //[[[end]]]
 
 void TreeParams::onSyncSelectionChanged() {
@@ -493,6 +493,18 @@ public:
     static const char *docVisibilityIcon();
     static void onVisibilityIconChanged();
     //@}
+
+    // Auto generated code (Tools/params_utils.py:138)
+    //@{
+    /// Accessor for parameter LazyChildItems
+    ///
+    /// Only create tree items for the children of a group when the group is expanded or one of the children is selected. Speeds up opening documents with many objects.
+    static const bool & getLazyChildItems();
+    static const bool & defaultLazyChildItems();
+    static void removeLazyChildItems();
+    static void setLazyChildItems(const bool &v);
+    static const char *docLazyChildItems();
+    //@}
 //[[[end]]]
 
     static void refreshTreeViews();
@@ -85,6 +85,8 @@ Params = [
     ParamBool('TreeToolTipIcon', False, title='Show icon in tool tip'),
     ParamBool('VisibilityIcon', True, on_change=True, title='Show visibility icon',
         doc = "Displays an eye icon in front of the tree view items, showing the items visibility status. When clicked the visibility is toggled"),
+    ParamBool('LazyChildItems', False, title='Create child items on demand',
+        doc = "Only create tree items for the children of a group when the group is expanded or one of the children is selected. Speeds up opening documents with many objects."),
 ]
 
 def declare_begin():
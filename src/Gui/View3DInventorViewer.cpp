@@ -35,6 +35,7 @@
 # include <GL/glu.h>
 # endif
 
+# include <algorithm>
 # include <fmt/format.h>
 
 # include <Inventor/SbBox.h>
@@ -111,6 +112,8 @@
 #include "Inventor/SoAxisCrossKit.h"
 #include "Inventor/SoFCBackgroundGradient.h"
 #include "Inventor/SoFCBoundingBox.h"
+#include "Inventor/SoFCRenderCuller.h"
+#include "Inventor/SoFCRenderStatistics.h"
 #include "MainWindow.h"
 #include "Multisample.h"
 #include "NaviCube.h"
@@ -118,6 +121,7 @@
 #include "Selection.h"
 #include "SoDevicePixelRatioElement.h"
 #include "SoFCDB.h"
+#include "SoFCIdBuffer.h"
 #include "SoFCInteractiveElement.h"
 #include "SoFCOffscreenRenderer.h"
 #include "SoFCSelection.h"
@@ -398,6 +402,8 @@ void View3DInventorViewer::init()
     fpsEnabled = false;
     vboEnabled = false;
 
+    // Apply a bulk selection to the scene in one go
+    setBatchSelection(true);
     attachSelection();
 
     // Coin should not clear the pixel-buffer, so the background image
@@ -524,6 +530,18 @@ void View3DInventorViewer::init()
 #endif
 
     inventorSelection = std::make_unique<View3DInventorSelection>(selectionRoot);
+    renderCuller = std::make_unique<SoFCRenderCuller>();
+
+    // Look up the preselected element in an offscreen id image instead of
+    // ray picking the scene on every mouse move
+    if (ViewParams::instance()->getIdBufferPicking()) {
+        idBuffer = std::make_unique<SoFCIdBuffer>();
+        idBuffer->attach(getSoRenderManager()->getSceneGraph());
+        selectionRoot->setIdBuffer(idBuffer.get());
+        idBufferTimer = new QTimer(this);
+        idBufferTimer->setSingleShot(true);
+        connect(idBufferTimer, &QTimer::timeout, this, &View3DInventorViewer::renderIdBuffer);
+    }
 
     pcClipPlane = nullptr;
 
@@ -636,9 +654,13 @@ View3DInventorViewer::~View3DInventorViewer()
     this->pcBackGround->unref();
     this->pcBackGround = nullptr;
 
+    selectionRoot->setIdBuffer(nullptr);
     setSceneGraph(nullptr);
+    idBuffer.reset();
     this->pEventCallback->unref();
     this->pEventCallback = nullptr;
+    // release the view provider roots referenced by the culler
+    renderCuller->clear();
     // Note: It can happen that there is still someone who references
     // the root node but isn't destroyed when closing this viewer so
     // that it prevents all children from being deleted. To reduce this
@@ -711,6 +733,13 @@ void View3DInventorViewer::aboutToDestroyGLContext()
         naviCube = nullptr;
         naviCubeEnabled = false;
     }
+    if (lastFrame) {
+        if (auto gl = qobject_cast<QOpenGLWidget*>(this->viewport())) {
+            gl->makeCurrent();
+        }
+        lastFrame.reset();
+        lastFrameValid = false;
+    }
 }
 
 void View3DInventorViewer::setDocument(Gui::Document* pcDocument)
@@ -781,6 +810,11 @@ void View3DInventorViewer::onSelectionChanged(const SelectionChanges & reason)
     case SelectionChanges::ClrSelection:
         inventorSelection->checkGroupOnTop(Reason);
         break;
+    case SelectionChanges::AddSelections:
+        Reason.forEachChange([this](const SelectionChanges& change) {
+            inventorSelection->checkGroupOnTop(change);
+        });
+        break;
     case SelectionChanges::SetPreselectSignal:
         break;
     default:
@@ -1298,6 +1332,81 @@ bool View3DInventorViewer::isEnabledVBO() const
     return vboEnabled;
 }
 
+void View3DInventorViewer::setInteractiveTriangleBudget(int budget)
+{
+    renderCuller->setTriangleBudget(budget);
+}
+
+int View3DInventorViewer::getInteractiveTriangleBudget() const
+{
+    return renderCuller->getTriangleBudget();
+}
+
+const SoFCRenderStatistics* View3DInventorViewer::getRenderStatistics()
+{
+    if (!renderStatistics) {
+        renderStatistics = std::make_unique<SoFCRenderStatistics>();
+        getSoRenderManager()->scheduleRedraw();
+    }
+    return renderStatistics.get();
+}
+
+void View3DInventorViewer::drawRenderStatistics()
+{
+    const SoFCRenderStatistics::Frame& frame = renderStatistics->lastFrame();
+
+    std::vector<std::string> lines;
+    lines.push_back(fmt::format("Render {:.1f} ms, objects {} (culled {}, boxes {})",
+                                frame.renderTime, frame.objects,
+                                frame.culledObjects, frame.proxyObjects));
+    lines.push_back(fmt::format("Triangles {}, lines {}, points {}",
+                                frame.triangles, frame.lines, frame.points));
+    lines.push_back(fmt::format("Buffers uploaded {} ({:.1f} kB), reused {}",
+                                frame.bufferUploads, double(frame.uploadedBytes) / 1024.0,
+                                frame.bufferHits));
+
+    // the most expensive node types first
+    std::vector<std::pair<std::string, SoFCRenderStatistics::NodeType>> types(
+        frame.nodeTypes.begin(), frame.nodeTypes.end());
+    std::sort(types.begin(), types.end(), [](const auto& a, const auto& b) {
+        return a.second.time > b.second.time;
+    });
+    for (const auto& [name, type] : types) {
+        lines.push_back(fmt::format("{}: {} nodes, {:.2f} ms", name, type.count, type.time));
+    }
+
+    const SbViewportRegion& vp = getSoRenderManager()->getViewportRegion();
+    SbVec2s size = vp.getViewportSizePixels();
+    ParameterGrp::handle hGrpOverlayL = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/MainWindow/DockWindows/OverlayLeft");
+    bool overlayLeft = !hGrpOverlayL->GetASCII("Widgets", "").empty();
+    ParameterGrp::handle hGrpView = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/View");
+    unsigned long color = hGrpView->GetUnsigned("AxisLetterColor", 4294902015);  // NOLINT
+
+    // stacked upwards above the FPS counter
+    constexpr float lineHeight = 16.0F;
+    float x = size[0] * (overlayLeft ? 0.11F : 0.01F);  // NOLINT
+    float y = size[1] * 0.01F + lineHeight * float(lines.size());  // NOLINT
+    for (const auto& line : lines) {
+        draw2DString(line.c_str(), size, SbVec2f(x, y), Base::Color(static_cast<uint32_t>(color)));
+        y -= lineHeight;
+    }
+}
+
+void View3DInventorViewer::renderIdBuffer()
+{
+    const SbViewportRegion& vp = getSoRenderManager()->getViewportRegion();
+    if (!idBuffer || !idBuffer->needsUpdate(vp) || getInteractiveCount() > 0 || isAnimating()) {
+        return;
+    }
+
+    static_cast<QOpenGLWidget*>(this->viewport())->makeCurrent();  // NOLINT
+    idBuffer->setPickRadius(static_cast<int>(getPickRadius()));
+    idBuffer->render(getSoRenderManager()->getSceneGraph(), vp,
+                     getSoRenderManager()->getGLRenderAction()->getCacheContext());
+}
+
 void View3DInventorViewer::setRenderCache(int mode)
 {
     static int canAutoCache = -1;
@@ -1583,6 +1692,15 @@ void View3DInventorViewer::setSceneGraph(SoNode* root)
         }
     }
 
+    if (idBuffer) {
+        if (root) {
+            idBuffer->attach(scene);
+        }
+        else {
+            idBuffer->detach();
+        }
+    }
+
 #if (COIN_MAJOR_VERSION * 100 + COIN_MINOR_VERSION * 10 + COIN_MICRO_VERSION < 403)
     navigation->findBoundingSphere();
 #endif
@@ -2230,6 +2348,49 @@ void View3DInventorViewer::imageFromFramebuffer(int width, int height, int sampl
     }
 }
 
+void View3DInventorViewer::captureLastFrame()
+{
+    if (!QOpenGLFramebufferObject::hasOpenGLFramebufferBlit()) {
+        return;
+    }
+
+    const SbViewportRegion& vp = this->getSoRenderManager()->getViewportRegion();
+    SbVec2s origin = vp.getViewportOriginPixels();
+    SbVec2s size = vp.getViewportSizePixels();
+    int side = std::min(size[0], size[1]);
+    if (side <= 0) {
+        return;
+    }
+
+    if (!lastFrame || lastFrame->width() != side) {
+        lastFrame = std::make_unique<QOpenGLFramebufferObject>(side, side);
+    }
+
+    // A blit on the GPU is cheap, the read back only happens when saving
+    QRect source(origin[0] + (size[0] - side) / 2, origin[1] + (size[1] - side) / 2, side, side);
+    QOpenGLFramebufferObject::blitFramebuffer(lastFrame.get(), QRect(0, 0, side, side),
+                                              nullptr, source);
+    lastFrameValid = true;
+}
+
+QImage View3DInventorViewer::imageFromLastFrame(int size)
+{
+    if (!lastFrame || !lastFrameValid) {
+        return {};
+    }
+
+    static_cast<QOpenGLWidget*>(this->viewport())->makeCurrent();  // NOLINT
+    QImage img = lastFrame->toImage();
+
+    QImage image(img.width(), img.height(), QImage::Format_RGB32);
+    QPainter painter(&image);
+    painter.fillRect(image.rect(),Qt::black);
+    painter.drawImage(0, 0, img);
+    painter.end();
+
+    return image.scaled(size, size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
+
 void View3DInventorViewer::renderToFramebuffer(QOpenGLFramebufferObject* fbo)
 {
     static_cast<QOpenGLWidget*>(this->viewport())->makeCurrent();  // NOLINT
@@ -2276,6 +2437,7 @@ void View3DInventorViewer::renderToFramebuffer(QOpenGLFramebufferObject* fbo)
 
 void View3DInventorViewer::actualRedraw()
 {
+    lastFrameValid = false;
     switch (renderType) {
     case Native:
         renderScene();
@@ -2415,9 +2577,25 @@ void View3DInventorViewer::renderScene()
         SoOverrideElement::setLightModelOverride(state, selectionRoot, true);
     }
 
+    if (!renderStatistics && ViewParams::instance()->getShowRenderStatistics()) {
+        renderStatistics = std::make_unique<SoFCRenderStatistics>();
+    }
+    if (renderStatistics) {
+        renderStatistics->beginFrame();
+    }
+
     try {
         // Render normal scenegraph.
+        renderCuller->beginFrame(glra,
+                                 ViewParams::instance()->getRenderCulling(),
+                                 ViewParams::instance()->getOcclusionCulling(),
+                                 getInteractiveCount() > 0 || isAnimating());
         inherited::actualRedraw();
+        renderCuller->endFrame();
+        // Bring back the full detail after navigating over the next frames
+        if (renderCuller->isRefining()) {
+            getSoRenderManager()->scheduleRedraw();
+        }
 
         So3DAnnotation::render = true;
         glClear(GL_DEPTH_BUFFER_BIT);
@@ -2433,6 +2611,7 @@ void View3DInventorViewer::renderScene()
         So3DAnnotation::render = false;
     }
     catch (const Base::MemoryException&) {
+        renderCuller->clear();
         // FIXME: If this exception appears then the background and camera position get broken somehow. (Werner 2006-02-01)
         for (auto it : _ViewProviderSet) {
             it->hide();
@@ -2458,6 +2637,17 @@ void View3DInventorViewer::renderScene()
         glra->apply(this->foregroundroot);
     }
 
+    if (renderStatistics) {
+        renderStatistics->endFrame();
+    }
+
+    // Keep the idle frame for the document thumbnail, so that saving doesn't
+    // need to render the scene again
+    if (getInteractiveCount() == 0 && !isAnimating() && !renderCuller->isRefining()
+            && ViewParams::instance()->getThumbnailFromLastFrame()) {
+        captureLastFrame();
+    }
+
     if (this->axiscrossEnabled) {
         this->drawAxisCross();
     }
@@ -2471,6 +2661,11 @@ void View3DInventorViewer::renderScene()
     if (this->isAnimating()) {
         this->getSoRenderManager()->scheduleRedraw();
     }
+    // Update the id buffer once the view has settled
+    else if (idBuffer && getInteractiveCount() == 0
+             && idBuffer->needsUpdate(getSoRenderManager()->getViewportRegion())) {
+        idBufferTimer->start(200);
+    }
 
     printDimension();
 
@@ -2500,6 +2695,10 @@ void View3DInventorViewer::renderScene()
                      Base::Color(static_cast<uint32_t>(axisLetterColor)));  // NOLINT
     }
 
+    if (renderStatistics && ViewParams::instance()->getShowRenderStatistics()) {
+        drawRenderStatistics();
+    }
+
     if (naviCubeEnabled) {
         naviCube->drawNaviCube();
     }
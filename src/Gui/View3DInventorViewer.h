@@ -62,6 +62,7 @@
 class QOpenGLFramebufferObject;
 class QOpenGLWidget;
 class QSurfaceFormat;
+class QTimer;
 
 class SoTranslation;
 class SoTransform;
@@ -93,6 +94,9 @@ class ViewProvider;
 class SoFCBackgroundGradient;
 class NavigationStyle;
 class SoFCUnifiedSelection;
+class SoFCIdBuffer;
+class SoFCRenderCuller;
+class SoFCRenderStatistics;
 class Document;
 class GLGraphicsItem;
 class SoShapeScale;
@@ -200,6 +204,10 @@ public:
     QImage grabFramebuffer();
     void imageFromFramebuffer(int width, int height, int samples,
                               const QColor& bgcolor, QImage& img);
+    /** Get a square image of the last frame that was rendered while the view was idle,
+     * without overlays. Returns a null image if the view has changed since.
+     */
+    QImage imageFromLastFrame(int size);
 
     void setViewing(bool enable) override;
     virtual void setCursorEnabled(bool enable);
@@ -460,6 +468,13 @@ public:
     void setEnabledVBO(bool on);
     bool isEnabledVBO() const;
     void setRenderCache(int);
+    /// Set the number of primitives drawn per frame while navigating, 0 to disable
+    void setInteractiveTriangleBudget(int budget);
+    int getInteractiveTriangleBudget() const;
+    /** Get the rendering statistics of the last frame. The collector is created
+     * on the first call and then collects the numbers of every frame.
+     */
+    const SoFCRenderStatistics* getRenderStatistics();
 
     //! Update colors of axis in corner to match preferences
     void updateColors();
@@ -512,6 +527,9 @@ private:
     static void drawSingleBackground(const QColor&);
     void setCursorRepresentation(int mode);
     void aboutToDestroyGLContext();
+    void renderIdBuffer();
+    void captureLastFrame();
+    void drawRenderStatistics();
     void createStandardCursors();
 
 private:
@@ -536,6 +554,13 @@ private:
     SoGroup* objectGroup;
 
     std::unique_ptr<View3DInventorSelection> inventorSelection;
+    std::unique_ptr<SoFCRenderCuller> renderCuller;
+    std::unique_ptr<SoFCRenderStatistics> renderStatistics;
+    std::unique_ptr<SoFCIdBuffer> idBuffer;
+    QTimer* idBufferTimer = nullptr;
+    // center square of the last idle frame, used for the document thumbnail
+    std::unique_ptr<QOpenGLFramebufferObject> lastFrame;
+    bool lastFrameValid = false;
 
     SoSeparator * pcEditingRoot;
     SoTransform * pcEditingTransform;
@@ -51,6 +51,7 @@
 
 #include "Camera.h"
 #include "Document.h"
+#include "Inventor/SoFCRenderStatistics.h"
 #include "Inventor/SoMouseWheelEvent.h"
 #include "Navigation/NavigationStyle.h"
 #include "PythonWrapper.h"
@@ -228,6 +229,11 @@ void View3DInventorPy::init_type()
         "setCornerCrossSize(int): Defines corner axis cross size");
     add_noargs_method("getCornerCrossSize",&View3DInventorPy::getCornerCrossSize,
         "getCornerCrossSize(): Returns current corner axis cross size");
+    add_noargs_method("getRenderStats",&View3DInventorPy::getRenderStats,
+        "getRenderStats() -> dict\n"
+        "Returns the rendering statistics of the last frame.\n"
+        "The statistics are collected from the first call on, so the first call\n"
+        "may return an empty frame.");
     add_noargs_method("cast_to_base", &View3DInventorPy::cast_to_base, "cast_to_base() cast to MDIView class");
 }
 
@@ -2565,6 +2571,34 @@ Py::Object View3DInventorPy::getCornerCrossSize()
     return Py::Long(size);
 }
 
+Py::Object View3DInventorPy::getRenderStats()
+{
+    const SoFCRenderStatistics* stats = getView3DInventorPtr()->getViewer()->getRenderStatistics();
+    const SoFCRenderStatistics::Frame& frame = stats->lastFrame();
+
+    Py::Dict nodeTypes;
+    for (const auto& [name, type] : frame.nodeTypes) {
+        Py::Dict item;
+        item.setItem("count", Py::Long(type.count));
+        item.setItem("time", Py::Float(type.time));
+        nodeTypes.setItem(name, item);
+    }
+
+    Py::Dict dict;
+    dict.setItem("renderTime", Py::Float(frame.renderTime));
+    dict.setItem("objects", Py::Long(frame.objects));
+    dict.setItem("culledObjects", Py::Long(frame.culledObjects));
+    dict.setItem("proxyObjects", Py::Long(frame.proxyObjects));
+    dict.setItem("triangles", Py::Long(static_cast<long>(frame.triangles)));
+    dict.setItem("lines", Py::Long(static_cast<long>(frame.lines)));
+    dict.setItem("points", Py::Long(static_cast<long>(frame.points)));
+    dict.setItem("bufferUploads", Py::Long(frame.bufferUploads));
+    dict.setItem("uploadedBytes", Py::Long(static_cast<unsigned long>(frame.uploadedBytes)));
+    dict.setItem("bufferHits", Py::Long(frame.bufferHits));
+    dict.setItem("nodeTypes", nodeTypes);
+    return dict;
+}
+
 Py::Object View3DInventorPy::cast_to_base()
 {
     return Gui::MDIViewPy::create(getView3DInventorPtr());
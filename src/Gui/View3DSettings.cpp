@@ -97,6 +97,7 @@ void View3DSettings::applySettings()
     OnChange(*hGrp,"AxisZColor");
     OnChange(*hGrp,"UseVBO");
     OnChange(*hGrp,"RenderCache");
+    OnChange(*hGrp,"InteractiveTriangleBudget");
     OnChange(*hGrp,"Orthographic");
 
     auto lightSourcesGrp = hGrp->GetGroup("LightSources");
@@ -450,6 +451,11 @@ void View3DSettings::OnChange(ParameterGrp::SubjectType &rCaller,ParameterGrp::M
             }
         }
     }
+    else if (strcmp(Reason,"InteractiveTriangleBudget") == 0) {
+        for (auto _viewer : _viewers) {
+            _viewer->setInteractiveTriangleBudget(rGrp.GetInt("InteractiveTriangleBudget", 0));
+        }
+    }
     else if (strcmp(Reason,"Orthographic") == 0) {
         // check whether a perspective or orthogrphic camera should be set
         if (rGrp.GetBool("Orthographic", true)) {
@@ -74,6 +74,13 @@ public:
     FC_VIEW_PARAM(DatumPlaneSize,double,Float,62.0) \
     FC_VIEW_PARAM(DatumLineSize,double,Float,70.0) \
     FC_VIEW_PARAM(DatumTemporaryScaleFactor,double,Float,2.0) \
+    FC_VIEW_PARAM(LinkInstancing,bool,Bool,false) \
+    FC_VIEW_PARAM(LinkInstancingMinSize,int,Int,16) \
+    FC_VIEW_PARAM(RenderCulling,bool,Bool,false) \
+    FC_VIEW_PARAM(OcclusionCulling,bool,Bool,false) \
+    FC_VIEW_PARAM(IdBufferPicking,bool,Bool,false) \
+    FC_VIEW_PARAM(ThumbnailFromLastFrame,bool,Bool,true) \
+    FC_VIEW_PARAM(ShowRenderStatistics,bool,Bool,false) \
 
 #undef FC_VIEW_PARAM
 #define FC_VIEW_PARAM(_name,_ctype,_type,_def) \
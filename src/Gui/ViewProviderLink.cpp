@@ -71,6 +71,7 @@
 #include "BitmapFactory.h"
 #include "Control.h"
 #include "Inventor/Draggers/SoTransformDragger.h"
+#include "Inventor/SoFCInstancedArray.h"
 #include "LinkViewPy.h"
 #include "Selection.h"
 #include "SoFCUnifiedSelection.h"
@@ -843,7 +844,7 @@ class LinkView::Element : public LinkOwner {
 public:
     LinkInfoPtr linkInfo;
     LinkView &handle;
-    CoinPtr<SoSwitch> pcSwitch;
+    CoinPtr<SoFCInstanceSwitch> pcSwitch;
     CoinPtr<SoFCSelectionRoot> pcRoot;
     CoinPtr<SoTransform> pcTransform;
     int groupIndex = -1;
@@ -854,7 +855,7 @@ public:
     Element(LinkView &handle):handle(handle) {
         pcTransform = new SoTransform;
         pcRoot = new SoFCSelectionRoot(true);
-        pcSwitch = new SoSwitch;
+        pcSwitch = new SoFCInstanceSwitch;
         pcSwitch->addChild(pcRoot);
         pcSwitch->whichChild = 0;
     }
@@ -901,9 +902,14 @@ LinkView::LinkView()
     ,childType((SnapshotType)-1),autoSubLink(true)
 {
     pcLinkRoot = new SoFCSelectionRoot;
+    pcInstances = new SoFCInstancedArray;
+    pcInstances->setPrepareFunction([this]() { return prepareInstances(); });
 }
 
 LinkView::~LinkView() {
+    // The node may outlive us if the scene graph is still referenced
+    pcInstances->setPrepareFunction({});
+    pcInstances->setInstances(nullptr, {});
     unlink(linkInfo);
     unlink(linkOwner);
 }
@@ -1024,6 +1030,7 @@ void LinkView::setMaterial(int index, const App::Material *material) {
         LINK_THROW(Base::ValueError,"LinkView: material index out of range");
     else {
         auto &info = *nodeArray[index];
+        touchInstances();
         if(!material) {
             info.pcRoot->removeColorOverride();
             return;
@@ -1094,6 +1101,9 @@ void LinkView::setSize(int _size) {
             nodeMap.erase(nodeArray[i]->pcSwitch);
         nodeArray.resize(size);
     }
+    // Must come before the element switches, see SoFCInstanceSwitch
+    pcLinkRoot->addChild(pcInstances);
+    touchInstances();
     for(const auto &info : nodeArray)
         pcLinkRoot->addChild(info->pcSwitch);
 
@@ -1203,11 +1213,14 @@ void LinkView::setTransform(int index, const Base::Matrix4D &mat) {
     if(index<0 || index>=(int)nodeArray.size())
         LINK_THROW(Base::ValueError,"LinkView: index out of range");
     setTransform(nodeArray[index]->pcTransform,mat);
+    touchInstances();
 }
 
 void LinkView::setElementVisible(int idx, bool visible) {
-    if(idx>=0 && idx<(int)nodeArray.size())
+    if(idx>=0 && idx<(int)nodeArray.size()) {
         nodeArray[idx]->pcSwitch->whichChild = visible?0:SO_SWITCH_NONE;
+        touchInstances();
+    }
 }
 
 bool LinkView::isElementVisible(int idx) const {
@@ -1281,10 +1294,98 @@ void LinkView::replaceLinkedRoot(SoSeparator *root) {
             for(const auto &info : nodeArray)
                 info->pcRoot->removeChild(pcLinkedRoot);
         }
+        touchInstances();
     }
     pcLinkedRoot = root;
 }
 
+void LinkView::setInstancing(bool enable) {
+    if(instanceEnabled == enable)
+        return;
+    instanceEnabled = enable;
+    touchInstances();
+}
+
+void LinkView::touchInstances() {
+    instanceDirty = true;
+    pcInstances->touch();
+}
+
+bool LinkView::isInstanceSelected() const {
+    auto owner = getOwner();
+    if(!owner || !owner->getObject() || !owner->getObject()->isAttachedToDocument())
+        return false;
+    auto obj = owner->getObject();
+    const char *name = obj->getNameInDocument();
+    auto involved = [&](const char *objName, const char *subname) {
+        if(!objName || !objName[0])
+            return false;
+        if(strcmp(objName, name) == 0)
+            return true;
+        // The link may be selected through any of its parents
+        for(const char *sub = subname; sub && sub[0];) {
+            const char *dot = strchr(sub,'.');
+            if(!dot)
+                break;
+            if(boost::equals(CharRange(sub,dot),name))
+                return true;
+            sub = dot+1;
+        }
+        return false;
+    };
+    if(Selection().hasPreselection()) {
+        const auto &pre = Selection().getPreselection();
+        if(involved(pre.pObjectName,pre.pSubName))
+            return true;
+    }
+    for(const auto &sel : Selection().getCompleteSelection(ResolveMode::NoResolve)) {
+        if(involved(sel.FeatName,sel.SubName))
+            return true;
+    }
+    return false;
+}
+
+bool LinkView::prepareInstances() {
+    if(!instanceEnabled || childType>=0 || !pcLinkedRoot || nodeArray.empty()
+            || !ViewParams::instance()->getLinkInstancing())
+    {
+        if(pcInstances->getNumChildren())
+            pcInstances->setInstances(nullptr, {});
+        instanceDirty = true;
+        return false;
+    }
+
+    if(instanceDirty) {
+        instanceDirty = false;
+        std::vector<SbMatrix> matrices;
+        matrices.reserve(nodeArray.size());
+        for(const auto &info : nodeArray) {
+            // Hidden elements and the ones with their own color are
+            // rendered through the regular scene graph
+            info->pcSwitch->instanced = info->pcSwitch->whichChild.getValue()>=0
+                && !info->pcRoot->hasColorOverride();
+            if(!info->pcSwitch->instanced)
+                continue;
+            const auto &trans = *info->pcTransform;
+            SbMatrix matrix;
+            matrix.setTransform(trans.translation.getValue(),
+                                trans.rotation.getValue(),
+                                trans.scaleFactor.getValue(),
+                                trans.scaleOrientation.getValue(),
+                                trans.center.getValue());
+            matrices.push_back(matrix);
+        }
+        pcInstances->setInstances(pcLinkedRoot, matrices);
+    }
+
+    if(pcInstances->getNumChildren() < ViewParams::instance()->getLinkInstancingMinSize())
+        return false;
+
+    // Selection and pre-selection highlight need the per-element context of
+    // the regular scene graph
+    return !isInstanceSelected();
+}
+
 void LinkView::onLinkedIconChange(LinkInfoPtr info) {
     if(info==linkInfo && info!=linkOwner && linkOwner && linkOwner->isLinked())
         linkOwner->pcLinked->signalChangeIcon();
@@ -3255,6 +3356,8 @@ void ViewProviderLink::applyColors() {
         else
             colorMap[std::string(subname,element-subname)][element] = v.second;
     }
+    // Element colors are kept in per-element contexts
+    linkView->setInstancing(colorMap.empty() && hideList.empty());
 
     SoTempPath path(10);
     path.ref();
@@ -44,6 +44,7 @@ class SoPickStyle;
 namespace Gui {
 
 class LinkInfo;
+class SoFCInstancedArray;
 using LinkInfoPtr = boost::intrusive_ptr<LinkInfo>;
 
 #if defined(_MSC_VER)
@@ -118,6 +119,13 @@ public:
     void renderDoubleSide(bool);
     void setSize(int size);
 
+    /** Allow rendering the array elements as instances of the linked object
+     * Instancing is only used if enabled by the LinkInstancing view parameter,
+     * for plain element arrays without per-element colors, and as long as
+     * none of the elements is selected or pre-selected.
+     */
+    void setInstancing(bool enable);
+
     int getSize() const { return nodeArray.size(); }
 
     static void setTransform(SoTransform *pcTransform, const Base::Matrix4D &mat);
@@ -166,6 +174,9 @@ protected:
     void replaceLinkedRoot(SoSeparator *);
     void resetRoot();
     bool getGroupHierarchy(int index, SoFullPath *path) const;
+    bool prepareInstances();
+    bool isInstanceSelected() const;
+    void touchInstances();
 
 protected:
     LinkInfoPtr linkOwner;
@@ -187,6 +198,10 @@ protected:
     std::vector<std::unique_ptr<Element> > nodeArray;
     std::unordered_map<SoNode*,int> nodeMap;
 
+    CoinPtr<SoFCInstancedArray> pcInstances;
+    bool instanceDirty = true;
+    bool instanceEnabled = true;
+
     Py::Object PythonObject;
 };
 
@@ -69,6 +69,15 @@ namespace
 {
 constexpr const int lowPrec = 2;
 constexpr const int highPrec = 16;
+// Number of entries shown by the list items
+constexpr const int listPreviewSize = 10;
+
+// Number of entries of a list with \a size entries to convert for display,
+// one more than shown so that toString() can tell that the list is longer
+int listPreviewCount(std::size_t size)
+{
+    return static_cast<int>(std::min<std::size_t>(size, listPreviewSize + 1));
+}
 }  // namespace
 
 
@@ -373,6 +382,11 @@ QVariant PropertyItem::toolTip(const App::Property* prop) const
     return {str};
 }
 
+QVariant PropertyItem::displayValue(const App::Property* prop) const
+{
+    return value(prop);
+}
+
 QVariant PropertyItem::decoration(const QVariant& value) const
 {
     Q_UNUSED(value)
@@ -730,10 +744,10 @@ QVariant PropertyItem::dataValue(int role) const
         return value(propertyItems[0]);
     }
     if (role == Qt::DecorationRole) {
-        return decoration(value(propertyItems[0]));
+        return decoration(displayValue(propertyItems[0]));
     }
     if (role == Qt::DisplayRole) {
-        return toString(value(propertyItems[0]));
+        return toString(displayValue(propertyItems[0]));
     }
     if (role == Qt::ToolTipRole) {
         return toolTip(propertyItems[0]);
@@ -1704,6 +1718,20 @@ QVariant PropertyVectorListItem::value(const App::Property* prop) const
     return QVariant::fromValue<QList<Base::Vector3d>>(list);
 }
 
+QVariant PropertyVectorListItem::displayValue(const App::Property* prop) const
+{
+    assert(prop && prop->isDerivedFrom<App::PropertyVectorList>());
+
+    // toString() only shows the first vector, don't copy a list of thousands
+    const std::vector<Base::Vector3d>& value =
+        static_cast<const App::PropertyVectorList*>(prop)->getValue();
+    QList<Base::Vector3d> list;
+    if (!value.empty()) {
+        list << value.front();
+    }
+    return QVariant::fromValue<QList<Base::Vector3d>>(list);
+}
+
 void PropertyVectorListItem::setValue(const QVariant& value)
 {
     if (!value.canConvert<QList<Base::Vector3d>>()) {
@@ -3192,9 +3220,8 @@ QVariant PropertyStringListItem::editorData(QWidget* editor) const
 QString PropertyStringListItem::toString(const QVariant& prop) const
 {
     QStringList list = prop.toStringList();
-    const int size = 10;
-    if (list.size() > size) {
-        list = list.mid(0, size);
+    if (list.size() > listPreviewSize) {
+        list = list.mid(0, listPreviewSize);
         list.append(QStringLiteral("..."));
     }
 
@@ -3214,6 +3241,20 @@ QVariant PropertyStringListItem::value(const App::Property* prop) const
     return {list};
 }
 
+QVariant PropertyStringListItem::displayValue(const App::Property* prop) const
+{
+    assert(prop && prop->isDerivedFrom<App::PropertyStringList>());
+
+    QStringList list;
+    const std::vector<std::string>& value =
+        static_cast<const App::PropertyStringList*>(prop)->getValues();
+    for (int i = 0, count = listPreviewCount(value.size()); i < count; ++i) {
+        list << QString::fromUtf8(value[i].c_str());
+    }
+
+    return {list};
+}
+
 void PropertyStringListItem::setValue(const QVariant& value)
 {
     if (hasExpression() || !value.canConvert<QStringList>()) {
@@ -3267,9 +3308,8 @@ QVariant PropertyFloatListItem::editorData(QWidget* editor) const
 QString PropertyFloatListItem::toString(const QVariant& prop) const
 {
     QStringList list = prop.toStringList();
-    const int size = 10;
-    if (list.size() > size) {
-        list = list.mid(0, size);
+    if (list.size() > listPreviewSize) {
+        list = list.mid(0, listPreviewSize);
         list.append(QStringLiteral("..."));
     }
     return QStringLiteral("[%1]").arg(list.join(QLatin1Char(',')));
@@ -3289,6 +3329,20 @@ QVariant PropertyFloatListItem::value(const App::Property* prop) const
     return {list};
 }
 
+QVariant PropertyFloatListItem::displayValue(const App::Property* prop) const
+{
+    assert(prop && prop->isDerivedFrom<App::PropertyFloatList>());
+
+    QStringList list;
+    const std::vector<double>& value =
+        static_cast<const App::PropertyFloatList*>(prop)->getValues();
+    for (int i = 0, count = listPreviewCount(value.size()); i < count; ++i) {
+        list << QString::number(value[i], 'f', decimals());
+    }
+
+    return {list};
+}
+
 void PropertyFloatListItem::setValue(const QVariant& value)
 {
     if (hasExpression() || !value.canConvert<QStringList>()) {
@@ -3344,9 +3398,8 @@ QVariant PropertyIntegerListItem::editorData(QWidget* editor) const
 QString PropertyIntegerListItem::toString(const QVariant& prop) const
 {
     QStringList list = prop.toStringList();
-    const int size = 10;
-    if (list.size() > size) {
-        list = list.mid(0, size);
+    if (list.size() > listPreviewSize) {
+        list = list.mid(0, listPreviewSize);
         list.append(QStringLiteral("..."));
     }
     QString text = QStringLiteral("[%1]").arg(list.join(QLatin1Char(',')));
@@ -3368,6 +3421,20 @@ QVariant PropertyIntegerListItem::value(const App::Property* prop) const
     return {list};
 }
 
+QVariant PropertyIntegerListItem::displayValue(const App::Property* prop) const
+{
+    assert(prop && prop->isDerivedFrom<App::PropertyIntegerList>());
+
+    QStringList list;
+    const std::vector<long>& value =
+        static_cast<const App::PropertyIntegerList*>(prop)->getValues();
+    for (int i = 0, count = listPreviewCount(value.size()); i < count; ++i) {
+        list << QString::number(value[i]);
+    }
+
+    return {list};
+}
+
 void PropertyIntegerListItem::setValue(const QVariant& value)
 {
     if (hasExpression() || !value.canConvert<QStringList>()) {
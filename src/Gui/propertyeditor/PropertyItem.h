@@ -222,6 +222,8 @@ protected:
     virtual QVariant toolTip(const App::Property*) const;
     virtual QString toString(const QVariant&) const;
     virtual QVariant value(const App::Property*) const;
+    /// The value passed to toString() and decoration(), by default value()
+    virtual QVariant displayValue(const App::Property*) const;
     virtual void setValue(const QVariant&);
     virtual void initialize();
 
@@ -662,6 +664,7 @@ class GuiExport PropertyVectorListItem: public PropertyItem
 protected:
     QString toString(const QVariant&) const override;
     QVariant value(const App::Property*) const override;
+    QVariant displayValue(const App::Property*) const override;
     void setValue(const QVariant&) override;
 
 protected:
@@ -1009,6 +1012,7 @@ class GuiExport PropertyStringListItem: public PropertyItem
 protected:
     QString toString(const QVariant&) const override;
     QVariant value(const App::Property*) const override;
+    QVariant displayValue(const App::Property*) const override;
     void setValue(const QVariant&) override;
 
 protected:
@@ -1033,6 +1037,7 @@ class GuiExport PropertyFloatListItem: public PropertyItem
 protected:
     QString toString(const QVariant&) const override;
     QVariant value(const App::Property*) const override;
+    QVariant displayValue(const App::Property*) const override;
     void setValue(const QVariant&) override;
 
 protected:
@@ -1057,6 +1062,7 @@ class GuiExport PropertyIntegerListItem: public PropertyItem
 protected:
     QString toString(const QVariant&) const override;
     QVariant value(const App::Property*) const override;
+    QVariant displayValue(const App::Property*) const override;
     void setValue(const QVariant&) override;
 
 protected:
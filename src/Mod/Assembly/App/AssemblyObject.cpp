@@ -144,6 +144,103 @@ int AssemblyObject::solve(bool enableRedo, bool updateJCS)
 
     ensureIdentityPlacements();
 
+    if (bundleFixed) {
+        // the dragging works on the model of the whole assembly
+        return solveAll(enableRedo, updateJCS);
+    }
+
+    objectPartMap.clear();
+    motions.clear();
+
+    auto groundedObjs = getGroundedParts();
+    if (groundedObjs.empty()) {
+        // If no part fixed we can't solve.
+        return -6;
+    }
+
+    std::vector<App::DocumentObject*> joints = getJoints(updateJCS);
+
+    removeUnconnectedJoints(joints, groundedObjs);
+
+    // Only the components that changed since their last solve are solved again. Their results
+    // are applied once all of them are solved, so a failing solve moves no part.
+    struct Component
+    {
+        std::vector<App::DocumentObject*> joints;
+        std::vector<App::DocumentObject*> parts;
+        std::shared_ptr<ASMTAssembly> assembly;
+        std::unordered_map<App::DocumentObject*, MbDPartData> partMap;
+    };
+    std::vector<Component> changed;
+    std::vector<SolvedComponent> unchanged;
+
+    for (auto& componentJoints : getJointComponents(joints, groundedObjs)) {
+        std::vector<App::DocumentObject*> parts = getComponentParts(componentJoints);
+        auto solved = std::ranges::find_if(solvedComponents, [&](const SolvedComponent& c) {
+            return isComponentSolved(c, componentJoints, parts);
+        });
+        if (solved != solvedComponents.end()) {
+            unchanged.push_back(std::move(*solved));
+            solvedComponents.erase(solved);
+            continue;
+        }
+
+        mbdAssembly = makeMbdAssembly();
+        objectPartMap.clear();
+        for (auto* part : parts) {
+            if (groundedObjs.contains(part)) {
+                Base::Placement plc = getPlacementFromProp(part, "Placement");
+                std::string str = part->getFullName();
+                fixGroundedPart(part, plc, str);
+            }
+        }
+        jointParts(componentJoints);
+
+        try {
+            mbdAssembly->runKINEMATIC();
+        }
+        catch (const std::exception& e) {
+            FC_ERR("Solve failed: " << e.what());
+            return -1;
+        }
+        catch (...) {
+            FC_ERR("Solve failed: unhandled exception");
+            return -1;
+        }
+
+        changed.push_back(
+            {std::move(componentJoints), std::move(parts), mbdAssembly, objectPartMap});
+    }
+
+    if (enableRedo) {
+        previousPositions.clear();
+        for (auto& component : changed) {
+            objectPartMap = component.partMap;
+            addPlacementsForUndo();
+        }
+    }
+
+    solvedComponents = std::move(unchanged);
+    for (auto& component : changed) {
+        mbdAssembly = component.assembly;
+        objectPartMap = component.partMap;
+        setNewPlacements();
+
+        redrawJointPlacements(component.joints);
+
+        solvedComponents.push_back(makeSolvedComponent(component.joints, component.parts));
+    }
+
+    signalSolverUpdate();
+
+    return 0;
+}
+
+int AssemblyObject::solveAll(bool enableRedo, bool updateJCS)
+{
+    // the states of the components are not tracked by the solve of the whole assembly
+    solvedComponents.clear();
+
     mbdAssembly = makeMbdAssembly();
     objectPartMap.clear();
     motions.clear();
@@ -217,9 +314,38 @@ int AssemblyObject::generateSimulation(App::DocumentObject* sim)
 
     motions.clear();
 
+    cacheSimulationFrames();
+
     return 0;
 }
 
+void AssemblyObject::cacheSimulationFrames()
+{
+    simulationObjs.clear();
+    simulationPlacements.clear();
+    for (auto& pair : objectPartMap) {
+        if (pair.first && pair.second.part
+            && dynamic_cast<App::PropertyPlacement*>(pair.first->getPropertyByName("Placement"))) {
+            simulationObjs.push_back(pair.first);
+        }
+    }
+
+    size_t nfrms = mbdAssembly->numberOfFrames();
+    simulationPlacements.reserve(nfrms * simulationObjs.size());
+    for (size_t i = 0; i < nfrms; ++i) {
+        mbdAssembly->updateForFrame(i);
+        for (auto* obj : simulationObjs) {
+            const MbDPartData& data = objectPartMap[obj];
+            Base::Placement plc = getMbdPlacement(data.part);
+            if (!data.offsetPlc.isIdentity()) {
+                plc = plc * data.offsetPlc;
+            }
+            simulationPlacements.push_back(plc);
+        }
+    }
+    simulationAssembly = mbdAssembly;
+}
+
 std::vector<App::DocumentObject*> AssemblyObject::getMotionsFromSimulation(App::DocumentObject* sim)
 {
     if (!sim) {
@@ -245,8 +371,22 @@ int Assembly::AssemblyObject::updateForFrame(size_t index, bool updateJCS)
         return -1;
     }
 
-    mbdAssembly->updateForFrame(index);
-    setNewPlacements();
+    if (simulationAssembly == mbdAssembly) {
+        const Base::Placement* plc = simulationPlacements.data() + index * simulationObjs.size();
+        for (auto* obj : simulationObjs) {
+            auto* propPlacement =
+                static_cast<App::PropertyPlacement*>(obj->getPropertyByName("Placement"));
+            if (!propPlacement->getValue().isSame(*plc)) {
+                propPlacement->setValue(*plc);
+                obj->purgeTouched();
+            }
+            ++plc;
+        }
+    }
+    else {
+        mbdAssembly->updateForFrame(index);
+        setNewPlacements();
+    }
     auto jointDocs = getJoints(updateJCS);
     redrawJointPlacements(jointDocs);
     return 0;
@@ -289,6 +429,14 @@ void AssemblyObject::preDrag(std::vector<App::DocumentObject*> dragParts)
         draggedParts.push_back(part);
     }
 
+    dragGroundedParts = getGroundedParts();
+    dragJoints.clear();
+    for (auto* joint : getJoints(false)) {
+        dragJoints.push_back({joint,
+                              getMovingPartFromRef(this, joint, "Reference1"),
+                              getMovingPartFromRef(this, joint, "Reference2")});
+    }
+
     mbdAssembly->runPreDrag();
 }
 
@@ -328,13 +476,16 @@ void AssemblyObject::doDragStep()
 
         // Timing the validation and placement setting
         if (validateNewPlacements()) {
-            setNewPlacements();
+            std::unordered_set<App::DocumentObject*> movedObjs;
+            setNewPlacements(&movedObjs);
 
-            auto joints = getJoints(false);
-            for (auto* joint : joints) {
-                if (joint->Visibility.getValue()) {
+            for (auto& dragJoint : dragJoints) {
+                if (!dragJoint.joint->Visibility.getValue()) {
+                    continue;
+                }
+                if (movedObjs.contains(dragJoint.part1) || movedObjs.contains(dragJoint.part2)) {
                     // redraw only the moving joint as its quite slow as its python code.
-                    redrawJointPlacement(joint);
+                    redrawJointPlacement(dragJoint.joint);
                 }
             }
         }
@@ -364,7 +515,11 @@ Base::Placement AssemblyObject::getMbdPlacement(std::shared_ptr<ASMTPart> mbdPar
 bool AssemblyObject::validateNewPlacements()
 {
     // First we check if a grounded object has moved. It can happen that they flip.
-    auto groundedParts = getGroundedParts();
+    std::unordered_set<App::DocumentObject*> grounded;
+    if (dragGroundedParts.empty()) {
+        grounded = getGroundedParts();
+    }
+    const auto& groundedParts = dragGroundedParts.empty() ? grounded : dragGroundedParts;
     for (auto* obj : groundedParts) {
         auto* propPlacement =
             dynamic_cast<App::PropertyPlacement*>(obj->getPropertyByName("Placement"));
@@ -397,12 +552,19 @@ bool AssemblyObject::validateNewPlacements()
 void AssemblyObject::postDrag()
 {
     mbdAssembly->runPostDrag();  // Do this after last drag
+
+    dragJoints.clear();
+    dragGroundedParts.clear();
 }
 
 void AssemblyObject::savePlacementsForUndo()
 {
     previousPositions.clear();
+    addPlacementsForUndo();
+}
 
+void AssemblyObject::addPlacementsForUndo()
+{
     for (auto& pair : objectPartMap) {
         App::DocumentObject* obj = pair.first;
         if (!obj) {
@@ -468,7 +630,7 @@ void AssemblyObject::exportAsASMT(std::string fileName)
     mbdAssembly->outputFile(fileName);
 }
 
-void AssemblyObject::setNewPlacements()
+void AssemblyObject::setNewPlacements(std::unordered_set<App::DocumentObject*>* movedObjs)
 {
     for (auto& pair : objectPartMap) {
         App::DocumentObject* obj = pair.first;
@@ -493,6 +655,9 @@ void AssemblyObject::setNewPlacements()
         if (!propPlacement->getValue().isSame(newPlacement)) {
             propPlacement->setValue(newPlacement);
             obj->purgeTouched();
+            if (movedObjs) {
+                movedObjs->insert(obj);
+            }
         }
     }
 }
@@ -965,6 +1130,131 @@ void AssemblyObject::removeUnconnectedJoints(std::vector<App::DocumentObject*>&
                  joints.end());
 }
 
+std::vector<std::vector<App::DocumentObject*>>
+AssemblyObject::getJointComponents(const std::vector<App::DocumentObject*>& joints,
+                                   const std::unordered_set<App::DocumentObject*>& groundedObjs)
+{
+    // Union-find over the moving parts, the grounded parts do not connect the components as the
+    // solver does not move them. A joint between two grounded parts is a component of its own.
+    std::unordered_map<App::DocumentObject*, std::size_t> partIndex;
+    std::vector<std::size_t> parent;
+    auto find = [&parent](std::size_t i) {
+        while (parent[i] != i) {
+            i = parent[i] = parent[parent[i]];
+        }
+        return i;
+    };
+    auto indexOf = [&](App::DocumentObject* part) {
+        auto [it, inserted] = partIndex.try_emplace(part, parent.size());
+        if (inserted) {
+            parent.push_back(parent.size());
+        }
+        return it->second;
+    };
+
+    std::vector<std::size_t> jointIndex;
+    jointIndex.reserve(joints.size());
+    for (auto* joint : joints) {
+        std::vector<std::size_t> indexes;
+        for (const char* ref : {"Reference1", "Reference2"}) {
+            App::DocumentObject* part = getMovingPartFromRef(this, joint, ref);
+            if (part && !groundedObjs.contains(part)) {
+                indexes.push_back(find(indexOf(part)));
+            }
+        }
+        if (indexes.empty()) {
+            parent.push_back(parent.size());
+            indexes.push_back(parent.size() - 1);
+        }
+        for (std::size_t index : indexes) {
+            parent[index] = indexes.front();
+        }
+        jointIndex.push_back(indexes.front());
+    }
+
+    std::vector<std::vector<App::DocumentObject*>> components;
+    std::unordered_map<std::size_t, std::size_t> componentOf;
+    for (std::size_t i = 0; i < joints.size(); ++i) {
+        auto [it, inserted] = componentOf.try_emplace(find(jointIndex[i]), components.size());
+        if (inserted) {
+            components.emplace_back();
+        }
+        components[it->second].push_back(joints[i]);
+    }
+    return components;
+}
+
+std::vector<App::DocumentObject*>
+AssemblyObject::getComponentParts(const std::vector<App::DocumentObject*>& joints)
+{
+    std::vector<App::DocumentObject*> parts;
+    for (auto* joint : joints) {
+        for (const char* ref : {"Reference1", "Reference2"}) {
+            App::DocumentObject* part = getMovingPartFromRef(this, joint, ref);
+            if (part && std::ranges::find(parts, part) == parts.end()) {
+                parts.push_back(part);
+            }
+        }
+    }
+    return parts;
+}
+
+// The properties of a joint that can change its solve, the proxy and the display ones are ignored
+static std::vector<App::Property*> solverProperties(App::DocumentObject* joint)
+{
+    std::vector<App::Property*> props;
+    joint->getPropertyList(props);
+    std::erase_if(props, [joint](App::Property* prop) {
+        return prop->isDerivedFrom<App::PropertyPythonObject>() || prop == &joint->Label
+            || prop == &joint->Label2 || prop == &joint->Visibility;
+    });
+    return props;
+}
+
+AssemblyObject::SolvedComponent
+AssemblyObject::makeSolvedComponent(const std::vector<App::DocumentObject*>& joints,
+                                    const std::vector<App::DocumentObject*>& parts)
+{
+    SolvedComponent solved;
+    solved.joints = joints;
+    for (auto* joint : joints) {
+        for (auto* prop : solverProperties(joint)) {
+            solved.jointProperties.emplace_back(prop->Copy());
+        }
+    }
+    for (auto* part : parts) {
+        solved.placements.emplace_back(part, getPlacementFromProp(part, "Placement"));
+    }
+    return solved;
+}
+
+bool AssemblyObject::isComponentSolved(const SolvedComponent& solved,
+                                       const std::vector<App::DocumentObject*>& joints,
+                                       const std::vector<App::DocumentObject*>& parts)
+{
+    if (solved.joints != joints || solved.placements.size() != parts.size()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < parts.size(); ++i) {
+        if (solved.placements[i].first != parts[i]
+            || !solved.placements[i].second.isSame(getPlacementFromProp(parts[i], "Placement"))) {
+            return false;
+        }
+    }
+
+    std::size_t i = 0;
+    for (auto* joint : joints) {
+        for (auto* prop : solverProperties(joint)) {
+            if (i >= solved.jointProperties.size() || !prop->isSame(*solved.jointProperties[i])) {
+                return false;
+            }
+            ++i;
+        }
+    }
+    return i == solved.jointProperties.size();
+}
+
 void AssemblyObject::traverseAndMarkConnectedParts(App::DocumentObject* currentObj,
                                                    std::vector<ObjRef>& connectedParts,
                                                    const std::vector<App::DocumentObject*>& joints)
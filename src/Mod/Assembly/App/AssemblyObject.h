@@ -100,6 +100,7 @@ public:
     void doDragStep();
     void postDrag();
     void savePlacementsForUndo();
+    void addPlacementsForUndo();
     void undoSolve();
     void clearUndo();
 
@@ -107,7 +108,8 @@ public:
 
     Base::Placement getMbdPlacement(std::shared_ptr<MbD::ASMTPart> mbdPart);
     bool validateNewPlacements();
-    void setNewPlacements();
+    // movedObjs receives the objects whose placement changed
+    void setNewPlacements(std::unordered_set<App::DocumentObject*>* movedObjs = nullptr);
     static void recomputeJointPlacements(std::vector<App::DocumentObject*> joints);
     static void redrawJointPlacements(std::vector<App::DocumentObject*> joints);
     static void redrawJointPlacement(App::DocumentObject* joint);
@@ -240,14 +242,54 @@ public:
     boost::signals2::signal<void()> signalSolverUpdate;
 
 private:
+    // The joints of the assembly split into groups that share no moving part, each is an
+    // independent system of the solver.
+    std::vector<std::vector<App::DocumentObject*>>
+    getJointComponents(const std::vector<App::DocumentObject*>& joints,
+                       const std::unordered_set<App::DocumentObject*>& groundedObjs);
+    std::vector<App::DocumentObject*>
+    getComponentParts(const std::vector<App::DocumentObject*>& joints);
+
+    // The state of a component after it was solved, to skip it while nothing changed.
+    struct SolvedComponent
+    {
+        std::vector<App::DocumentObject*> joints;
+        std::vector<std::unique_ptr<App::Property>> jointProperties;
+        std::vector<std::pair<App::DocumentObject*, Base::Placement>> placements;
+    };
+    SolvedComponent makeSolvedComponent(const std::vector<App::DocumentObject*>& joints,
+                                        const std::vector<App::DocumentObject*>& parts);
+    bool isComponentSolved(const SolvedComponent& solved,
+                           const std::vector<App::DocumentObject*>& joints,
+                           const std::vector<App::DocumentObject*>& parts);
+    int solveAll(bool enableRedo, bool updateJCS);
+    void cacheSimulationFrames();
+
     std::shared_ptr<MbD::ASMTAssembly> mbdAssembly;
 
     std::unordered_map<App::DocumentObject*, MbDPartData> objectPartMap;
     std::vector<std::pair<App::DocumentObject*, double>> objMasses;
     std::vector<App::DocumentObject*> draggedParts;
+
+    // What the steps of a drag need from the document, it does not change during the drag.
+    struct DragJoint
+    {
+        App::DocumentObject* joint;
+        App::DocumentObject* part1;
+        App::DocumentObject* part2;
+    };
+    std::vector<DragJoint> dragJoints;
+    std::unordered_set<App::DocumentObject*> dragGroundedParts;
     std::vector<App::DocumentObject*> motions;
 
     std::vector<std::pair<App::DocumentObject*, Base::Placement>> previousPositions;
+    std::vector<SolvedComponent> solvedComponents;
+
+    // The placements of the simulated objects of all frames of simulationAssembly, the frames
+    // follow each other, so that the playback does not need the solver.
+    std::shared_ptr<MbD::ASMTAssembly> simulationAssembly;
+    std::vector<App::DocumentObject*> simulationObjs;
+    std::vector<Base::Placement> simulationPlacements;
 
     bool bundleFixed;
 
@@ -213,3 +213,42 @@ class TestCore(unittest.TestCase):
         joint.Proxy.setJointConnectors(joint, refs)
 
         self.assertTrue(box.Placement.isSame(box2.Placement, 1e-6), "'{}'".format(operation))
+
+    def test_solve_independent_components(self):
+        """Test solving an assembly with parts that are connected only by the grounded part."""
+        operation = "Solve independent components"
+        _msg("  Test '{}'".format(operation))
+
+        base = self.assembly.newObject("Part::Box", "Base")
+        base.Length = 30
+        base.Width = 10
+        base.Height = 10
+
+        ground = self.jointgroup.newObject("App::FeaturePython", "GroundedJoint")
+        JointObject.GroundedJoint(ground, base)
+
+        boxes = []
+        joints = []
+        for i, vertex in enumerate(("Vertex7", "Vertex8")):
+            box = self.assembly.newObject("Part::Box", "Box")
+            box.Placement = App.Placement(App.Vector(40 * i, 50, 60), App.Rotation(45, 55, 65))
+            joint = self.jointgroup.newObject("App::FeaturePython", "testJoint")
+            JointObject.Joint(joint, 0)
+            refs = [
+                [self.assembly, [base.Name + ".Face6", base.Name + "." + vertex]],
+                [self.assembly, [box.Name + ".Face6", box.Name + ".Vertex7"]],
+            ]
+            joint.Proxy.setJointConnectors(joint, refs)
+            boxes.append(box)
+            joints.append(joint)
+
+        self.assembly.solve()
+        first = boxes[0].Placement
+        second = boxes[1].Placement
+
+        # only the component of the second box changed
+        joints[1].Offset2 = App.Placement(App.Vector(0, 0, 5), App.Rotation())
+        self.assembly.solve()
+
+        self.assertTrue(boxes[0].Placement.isSame(first, 1e-6), "'{}'".format(operation))
+        self.assertFalse(boxes[1].Placement.isSame(second, 1e-6), "'{}'".format(operation))
@@ -26,7 +26,9 @@
 #define BOOST_GEOMETRY_DISABLE_DEPRECATED_03_WARNING
 
 #ifndef _PreComp_
+#include <algorithm>
 #include <limits>
+#include <set>
 
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/register/point.hpp>
@@ -1888,6 +1890,66 @@ std::vector<shared_ptr<Area>> Area::makeSections(PARAM_ARGS(PARAM_FARG, AREA_PAR
     bool can_retry = fabs(tolerance) > Precision::Confusion();
     TopLoc_Location locInverse(loc.Inverted());
 
+    // the solids of the shapes in the coordinates of the section plane
+    std::vector<std::vector<TopoDS_Shape>> shapeSolids;
+    std::vector<TopoDS_Shape> solids;
+    if (!project) {
+        for (const auto& s : myShapes) {
+            shapeSolids.emplace_back();
+            for (TopExp_Explorer xp(s.shape.Moved(loc), TopAbs_SOLID); xp.More(); xp.Next()) {
+                shapeSolids.back().push_back(xp.Current());
+                solids.push_back(xp.Current());
+            }
+        }
+    }
+    auto& cache = mySectionCache;
+    if (!std::equal(solids.begin(),
+                    solids.end(),
+                    cache.solids.begin(),
+                    cache.solids.end(),
+                    [](const TopoDS_Shape& s1, const TopoDS_Shape& s2) {
+                        return s1.IsEqual(s2);
+                    })) {
+        cache.solids = solids;
+        cache.wires.clear();
+    }
+
+    // Slices all solids at the given heights that are not cached yet. The heights are sliced in
+    // parallel and the section of each one is independent of the others.
+    auto sliceSolids = [&cache](const std::vector<double>& zs) {
+        std::vector<double> missing;
+        for (double z : zs) {
+            if (!cache.wires.contains(z)) {
+                missing.push_back(z);
+            }
+        }
+        if (missing.empty()) {
+            return;
+        }
+        std::vector<std::vector<std::list<TopoDS_Wire>>> slices;
+        slices.reserve(cache.solids.size());
+        Part::FuzzyHelper::withBooleanFuzzy(.0, [&]() {
+            // Workaround for https://github.com/FreeCAD/FreeCAD/issues/17748
+            // needed to make finish pass work.
+            // This fix might be better to move into Part::CrossSection but it is kept
+            // here for now to be on the safe side.
+            for (const auto& solid : cache.solids) {
+                slices.push_back(Part::CrossSection(0.0, 0.0, 1.0, solid).slices(missing));
+            }
+        });
+        for (std::size_t k = 0; k < missing.size(); ++k) {
+            auto& wires = cache.wires[missing[k]];
+            wires.reserve(slices.size());
+            for (auto& solidSlices : slices) {
+                wires.push_back(std::move(solidSlices[k]));
+            }
+        }
+    };
+    if (!project) {
+        sliceSolids(heights);
+    }
+    std::set<double> usedHeights;
+
     for (size_t i = 0; i < heights.size(); ++i) {
         double z = heights[i];
         bool retried = !can_retry;
@@ -1913,23 +1975,20 @@ std::vector<shared_ptr<Area>> Area::makeSections(PARAM_ARGS(PARAM_FARG, AREA_PAR
                 break;
             }
 
-            for (auto it = myShapes.begin(); it != myShapes.end(); ++it) {
+            sliceSolids({z});
+            usedHeights.insert(z);
+            const auto& sectionWires = cache.wires[z];
+            std::size_t solidIndex = 0;
+            auto itSolids = shapeSolids.begin();
+            for (auto it = myShapes.begin(); it != myShapes.end(); ++it, ++itSolids) {
                 const auto& s = *it;
                 BRep_Builder builder;
                 TopoDS_Compound comp;
                 builder.MakeCompound(comp);
 
-                for (TopExp_Explorer xp(s.shape.Moved(loc), TopAbs_SOLID); xp.More(); xp.Next()) {
-                    showShape(xp.Current(), nullptr, "section_%zu_shape", i);
-                    std::list<TopoDS_Wire> wires;
-                    Part::CrossSection section(a, b, c, xp.Current());
-                    Part::FuzzyHelper::withBooleanFuzzy(.0, [&]() {
-                        // Workaround for https://github.com/FreeCAD/FreeCAD/issues/17748
-                        // needed to make finish pass work.
-                        // This fix might be better to move into Part::CrossSection but it is kept
-                        // here for now to be on the safe side.
-                        wires = section.slice(-d);
-                    });
+                for (const TopoDS_Shape& solid : *itSolids) {
+                    showShape(solid, nullptr, "section_%zu_shape", i);
+                    std::list<TopoDS_Wire> wires = sectionWires[solidIndex++];
                     showShapes(wires, nullptr, "section_%zu_wire", i);
                     if (wires.empty()) {
                         AREA_LOG("Section returns no wires");
@@ -2008,6 +2067,10 @@ std::vector<shared_ptr<Area>> Area::makeSections(PARAM_ARGS(PARAM_FARG, AREA_PAR
             }
         }
     }
+    // only the sections at the heights of this build are kept
+    std::erase_if(cache.wires, [&usedHeights](const auto& entry) {
+        return !usedHeights.contains(entry.first);
+    });
     FC_TIME_LOG(t, "makeSection count: " << sections.size() << ", total");
     return sections;
 }
@@ -2869,19 +2932,28 @@ struct ShapeParams
     int k;
     short orientation;
     short direction;
+    bool refine;
+    std::chrono::steady_clock::time_point refine_deadline;
     FC_DURATION_DECLARE(qd);  // rtree query duration
     FC_DURATION_DECLARE(bd);  // rtree build duration
     FC_DURATION_DECLARE(rd);  // rtree remove duration
     FC_DURATION_DECLARE(xd);  // BRepExtrema_DistShapeShape duration
 
-    ShapeParams(double _a, int _k, short o, short d)
+    ShapeParams(double _a, int _k, short o, short d, double refine_time)
         : abscissa(_a)
         , k(_k)
         , orientation(o)
         , direction(d)
+        , refine(refine_time > 0.0)
     {
         FC_DURATION_INIT3(qd, bd, rd);
         FC_DURATION_INIT(xd);
+        if (refine) {
+            // the time budget is shared by all the layers of one sort
+            refine_deadline = std::chrono::steady_clock::now()
+                + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                  std::chrono::duration<double>(refine_time));
+        }
     }
 };
 
@@ -2894,11 +2966,11 @@ using RResults = std::map<Wires::iterator, size_t>;
 struct GetWires
 {
     Wires& wires;
-    RTree& rtree;
+    std::vector<RValue>& values;
     ShapeParams& params;
-    GetWires(std::list<WireInfo>& ws, RTree& rt, ShapeParams& rp)
+    GetWires(std::list<WireInfo>& ws, std::vector<RValue>& vs, ShapeParams& rp)
         : wires(ws)
-        , rtree(rt)
+        , values(vs)
         , params(rp)
     {}
     void operator()(const TopoDS_Shape& shape, int type)
@@ -2992,12 +3064,80 @@ struct GetWires
         auto it = wires.end();
         --it;
         for (size_t i = 0, count = it->points.size(); i < count; ++i) {
-            rtree.insert(RValue(it, i));
+            values.emplace_back(it, i);
         }
         FC_DURATION_PLUS(params.bd, t);
     }
 };
 
+// A sorted wire with the points where the tool enters and leaves it
+struct SortedWire
+{
+    TopoDS_Shape wire;
+    gp_Pnt pstart;
+    gp_Pnt pend;
+};
+
+// Shortens the travel between the sorted wires with the Or-opt heuristic, which moves a single
+// wire or a run of up to three wires to the position where it adds the least travel, until no
+// move improves or the deadline passes. Reversing runs as 2-opt does is not done, because the
+// wires must keep their direction to keep the cut direction and the rebased start points.
+static void refineWires(std::vector<SortedWire>& wires,
+                        const gp_Pnt& pstart,
+                        std::chrono::steady_clock::time_point deadline)
+{
+    const std::size_t count = wires.size();
+    // the point from where the tool travels to the wire at the given position
+    auto from = [&](std::size_t pos) -> const gp_Pnt& {
+        return pos ? wires[pos - 1].pend : pstart;
+    };
+    // the travel from the given point to the wire at the given position, if there is one
+    auto travel = [&](const gp_Pnt& pt, std::size_t pos) {
+        return pos < count ? pt.Distance(wires[pos].pstart) : 0.0;
+    };
+
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        for (std::size_t length = 1; length <= 3 && length < count; ++length) {
+            for (std::size_t i = 0; i + length <= count; ++i) {
+                if (std::chrono::steady_clock::now() > deadline) {
+                    return;
+                }
+                std::size_t last = i + length;
+                const gp_Pnt& runStart = wires[i].pstart;
+                const gp_Pnt& runEnd = wires[last - 1].pend;
+                double gain = travel(from(i), i) + travel(runEnd, last) - travel(from(i), last);
+                if (gain <= Precision::Confusion()) {
+                    continue;
+                }
+                // find the wire before which the run is best inserted
+                std::size_t best = i;
+                double bestGain = Precision::Confusion();
+                for (std::size_t j = 0; j <= count; ++j) {
+                    if (j >= i && j <= last) {
+                        continue;
+                    }
+                    double cost =
+                        from(j).Distance(runStart) + travel(runEnd, j) - travel(from(j), j);
+                    if (gain - cost > bestGain) {
+                        bestGain = gain - cost;
+                        best = j;
+                    }
+                }
+                if (best < i) {
+                    std::rotate(wires.begin() + best, wires.begin() + i, wires.begin() + last);
+                    improved = true;
+                }
+                else if (best > last) {
+                    std::rotate(wires.begin() + i, wires.begin() + last, wires.begin() + best);
+                    improved = true;
+                }
+            }
+        }
+    }
+}
+
 struct ShapeInfo
 {
     gp_Pln myPln;
@@ -3042,7 +3182,13 @@ struct ShapeInfo
         myStartPt = pt;
 
         if (myWires.empty()) {
-            foreachSubshape(myShape, GetWires(myWires, myRTree, myParams), TopAbs_WIRE);
+            std::vector<RValue> values;
+            foreachSubshape(myShape, GetWires(myWires, values, myParams), TopAbs_WIRE);
+            // Bulk loading packs the tree, which is faster to build and to query than a tree
+            // grown by inserting the points one by one.
+            FC_TIME_INIT(t);
+            myRTree = RTree(values.begin(), values.end());
+            FC_DURATION_PLUS(myParams.bd, t);
         }
 
         // Now find the true nearest point among the wires returned. Currently
@@ -3289,18 +3435,21 @@ struct ShapeInfo
         if (min_dist < 0.01) {
             min_dist = 0.01;
         }
+        std::vector<SortedWire> sorted;
         while (true) {
             if (myRebase) {
                 pend = myBestPt;
-                wires.push_back(rebaseWire(pend, min_dist));
+                TopoDS_Shape wire = rebaseWire(pend, min_dist);
+                // the rebased wire is closed and starts where it ends
+                sorted.push_back({wire, pend, pend});
             }
             else if (!myStart) {
-                wires.push_back(myBestWire->wire.Reversed());
                 pend = myBestWire->pstart();
+                sorted.push_back({myBestWire->wire.Reversed(), myBestWire->pend(), pend});
             }
             else {
-                wires.push_back(myBestWire->wire);
                 pend = myBestWire->pend();
+                sorted.push_back({myBestWire->wire, myBestWire->pstart(), pend});
             }
             FC_TIME_INIT(t);
             for (size_t i = 0, count = myBestWire->points.size(); i < count; ++i) {
@@ -3316,6 +3465,18 @@ struct ShapeInfo
                 break;
             }
         }
+        if (myParams.refine && sorted.size() > 1) {
+            FC_TIME_INIT(t);
+            refineWires(sorted, pstart, myParams.refine_deadline);
+            FC_TIME_LOG(t, "refine " << sorted.size() << " wires");
+            pend = sorted.back().pend;
+            if (pentry) {
+                *pentry = sorted.front().pstart;
+            }
+        }
+        for (auto& info : sorted) {
+            wires.push_back(info.wire);
+        }
         return wires;
     }
 };
@@ -3566,7 +3727,11 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape>& shapes,
         return wires;
     }
 
-    ShapeParams rparams(abscissa, nearest_k > 0 ? nearest_k : 1, orientation, direction);
+    ShapeParams rparams(abscissa,
+                        nearest_k > 0 ? nearest_k : 1,
+                        orientation,
+                        direction,
+                        refine_time);
     std::list<ShapeInfo> shape_list;
 
     FC_TIME_INIT2(t, t1);
@@ -3810,15 +3975,21 @@ static inline void addParameter(bool verbose,
     }
 }
 
-static inline void
-addGCode(bool verbose, Toolpath& path, const gp_Pnt& last, const gp_Pnt& next, const char* name)
+static inline Command
+makeGCode(bool verbose, const gp_Pnt& last, const gp_Pnt& next, const char* name)
 {
     Command cmd;
     cmd.Name = name;
     addParameter(verbose, cmd, "X", last.X(), next.X());
     addParameter(verbose, cmd, "Y", last.Y(), next.Y());
     addParameter(verbose, cmd, "Z", last.Z(), next.Z());
-    path.addCommand(cmd);
+    return cmd;
+}
+
+static inline void
+addGCode(bool verbose, Toolpath& path, const gp_Pnt& last, const gp_Pnt& next, const char* name)
+{
+    path.addCommand(makeGCode(verbose, last, next, name));
     return;
 }
 
@@ -3829,12 +4000,12 @@ static inline void addG1(bool verbose,
                          double f,
                          double& last_f)
 {
-    addGCode(verbose, path, last, next, "G1");
+    Command cmd = makeGCode(verbose, last, next, "G1");
     if (f > Precision::Confusion()) {
-        Command* cmd = path.getCommands().back();
-        addParameter(verbose, *cmd, "F", last_f, f);
+        addParameter(verbose, cmd, "F", last_f, f);
         last_f = f;
     }
+    path.addCommand(cmd);
     return;
 }
 
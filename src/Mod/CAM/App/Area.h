@@ -25,10 +25,12 @@
 
 #include <chrono>
 #include <list>
+#include <map>
 #include <memory>
 #include <vector>
 
 #include <TopoDS.hxx>
+#include <TopoDS_Wire.hxx>
 
 #include <Mod/CAM/PathGlobal.h>
 #include <Mod/Part/App/PartPyCXX.h>
@@ -141,6 +143,17 @@ protected:
     bool myProjecting;
     mutable int mySkippedShapes;
 
+    /** The section wires of the solids by their height
+     *
+     * It is kept by clean() so that a rebuild with the same solids only slices at new heights.
+     */
+    struct SectionCache
+    {
+        std::vector<TopoDS_Shape> solids;
+        std::map<double, std::vector<std::list<TopoDS_Wire>>> wires;
+    };
+    SectionCache mySectionCache;
+
     static bool s_aborting;
     static AreaStaticParams s_params;
 
@@ -396,7 +396,15 @@
              "If two wire's end points are separated within this threshold, they are consider\n"   \
              "as connected. You may want to set this to the tool diameter to keep the tool down.", \
              App::PropertyLength))(                                                                \
-            (enum, retract_axis, RetractAxis, 2, "Tool retraction axis", (X)(Y)(Z)))
+            (enum, retract_axis, RetractAxis, 2, "Tool retraction axis", (X)(Y)(Z)))(              \
+            (double,                                                                               \
+             refine_time,                                                                          \
+             SortRefineTime,                                                                       \
+             0.0,                                                                                  \
+             "Maximum time in seconds spent on shortening the travel between the sorted wires\n"   \
+             "of a layer, by moving single wires or short runs of them to a better position.\n"    \
+             "Set to zero to disable the refinement.",                                             \
+             App::PropertyFloat))
 
 /** Area path generation parameters */
 #define AREA_PARAMS_PATH                                                                           \
@@ -22,8 +22,12 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
+#include <bit>
+#include <charconv>
 #include <cinttypes>
-#include <iomanip>
+#include <cmath>
+#include <string_view>
 #include <boost/algorithm/string.hpp>
 #endif
 
@@ -39,6 +43,180 @@
 using namespace Base;
 using namespace Path;
 
+// CommandParameters
+
+CommandParameters::CommandParameters(const std::map<std::string, double>& parameters)
+{
+    for (const auto& param : parameters) {
+        (*this)[param.first] = param.second;
+    }
+}
+
+int CommandParameters::slotOf(const std::string& name)
+{
+    if (name.size() != 1) {
+        return -1;
+    }
+    auto it = std::find(SlotNames.begin(), SlotNames.end(), name[0]);
+    return it == SlotNames.end() ? -1 : static_cast<int>(it - SlotNames.begin());
+}
+
+int CommandParameters::nextSlot(int slot) const
+{
+    unsigned int rest = static_cast<unsigned int>(mask) >> slot;
+    return rest ? slot + std::countr_zero(rest) : NumSlots;
+}
+
+double& CommandParameters::operator[](const std::string& name)
+{
+    int slot = slotOf(name);
+    if (slot >= 0) {
+        if (!(mask & (1U << slot))) {
+            mask |= 1U << slot;
+            values[slot] = 0.0;
+        }
+        return values[slot];
+    }
+    auto it = std::lower_bound(extras.begin(),
+                               extras.end(),
+                               name,
+                               [](const value_type& entry, const std::string& key) {
+                                   return entry.first < key;
+                               });
+    if (it == extras.end() || it->first != name) {
+        it = extras.emplace(it, name, 0.0);
+    }
+    return it->second;
+}
+
+CommandParameters::const_iterator CommandParameters::find(const std::string& name) const
+{
+    auto it = std::lower_bound(extras.begin(),
+                               extras.end(),
+                               name,
+                               [](const value_type& entry, const std::string& key) {
+                                   return entry.first < key;
+                               });
+    std::size_t extra = it - extras.begin();
+    int slot = slotOf(name);
+    if (slot >= 0) {
+        if (mask & (1U << slot)) {
+            return {this, slot, extra};
+        }
+    }
+    else if (it != extras.end() && it->first == name) {
+        // the first slot after the name
+        int next = 0;
+        while (next < NumSlots && std::string_view(&SlotNames[next], 1) < name) {
+            ++next;
+        }
+        return {this, nextSlot(next), extra};
+    }
+    return end();
+}
+
+bool CommandParameters::contains(const std::string& name) const
+{
+    int slot = slotOf(name);
+    if (slot >= 0) {
+        return mask & (1U << slot);
+    }
+    return std::any_of(extras.begin(), extras.end(), [&name](const value_type& entry) {
+        return entry.first == name;
+    });
+}
+
+double CommandParameters::get(const std::string& name, double fallback) const
+{
+    int slot = slotOf(name);
+    if (slot >= 0) {
+        return (mask & (1U << slot)) ? values[slot] : fallback;
+    }
+    for (const auto& entry : extras) {
+        if (entry.first == name) {
+            return entry.second;
+        }
+    }
+    return fallback;
+}
+
+void CommandParameters::erase(const std::string& name)
+{
+    int slot = slotOf(name);
+    if (slot >= 0) {
+        mask &= ~(1U << slot);
+        return;
+    }
+    std::erase_if(extras, [&name](const value_type& entry) {
+        return entry.first == name;
+    });
+}
+
+void CommandParameters::clear()
+{
+    mask = 0;
+    extras.clear();
+}
+
+std::size_t CommandParameters::size() const
+{
+    return std::popcount(static_cast<unsigned int>(mask)) + extras.size();
+}
+
+CommandParameters::const_iterator CommandParameters::begin() const
+{
+    return {this, nextSlot(0), 0};
+}
+
+CommandParameters::const_iterator::const_iterator(const CommandParameters* params,
+                                                  int slot,
+                                                  std::size_t extra)
+    : params(params)
+    , slot(slot)
+    , extra(extra)
+{
+    update();
+}
+
+bool CommandParameters::const_iterator::isSlot() const
+{
+    if (slot == NumSlots) {
+        return false;
+    }
+    if (extra == params->extras.size()) {
+        return true;
+    }
+    return std::string_view(&SlotNames[slot], 1) < params->extras[extra].first;
+}
+
+void CommandParameters::const_iterator::update()
+{
+    if (slot == NumSlots && extra == params->extras.size()) {
+        return;
+    }
+    if (isSlot()) {
+        current.first.assign(1, SlotNames[slot]);
+        current.second = params->values[slot];
+    }
+    else {
+        current = params->extras[extra];
+    }
+}
+
+CommandParameters::const_iterator& CommandParameters::const_iterator::operator++()
+{
+    if (isSlot()) {
+        slot = params->nextSlot(slot + 1);
+    }
+    else {
+        ++extra;
+    }
+    update();
+    return *this;
+}
+
+// Command
+
 TYPESYSTEM_SOURCE(Path::Command, Base::Persistence)
 
 // Constructors & destructors
@@ -96,31 +274,46 @@ bool Command::has(const std::string& attr) const
 
 std::string Command::toGCode(int precision, bool padzero) const
 {
-    std::stringstream str;
-    str.fill('0');
-    str << Name;
+    std::string str;
+    appendGCode(str, precision, padzero);
+    return str;
+}
+
+static void appendInteger(std::string& buffer, std::int64_t value, int width = 0)
+{
+    char digits[24];
+    auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+    int length = static_cast<int>(result.ptr - digits);
+    if (width > length) {
+        buffer.append(width - length, '0');
+    }
+    buffer.append(digits, length);
+}
+
+void Command::appendGCode(std::string& buffer, int precision, bool padzero) const
+{
+    buffer += Name;
     if (precision < 0) {
         precision = 0;
     }
     double scale = std::pow(10.0, precision + 1);
     std::int64_t iscale = static_cast<std::int64_t>(scale) / 10;
-    for (std::map<std::string, double>::const_iterator i = Parameters.begin();
-         i != Parameters.end();
-         ++i) {
-        if (i->first == "N") {
+    for (const auto& param : Parameters) {
+        if (param.first == "N") {
             continue;
         }
 
-        str << " " << i->first;
+        buffer += ' ';
+        buffer += param.first;
 
-        std::int64_t v = static_cast<std::int64_t>(i->second * scale);
+        std::int64_t v = static_cast<std::int64_t>(param.second * scale);
         if (v < 0) {
             v = -v;
-            str << '-';  // shall we allow -0 ?
+            buffer += '-';  // shall we allow -0 ?
         }
         v += 5;
         v /= 10;
-        str << (v / iscale);
+        appendInteger(buffer, v / iscale);
         if (!precision) {
             continue;
         }
@@ -136,82 +329,114 @@ std::string Command::toGCode(int precision, bool padzero) const
                 --width;
             }
         }
-        str << '.' << std::setw(width) << std::right << digits;
+        buffer += '.';
+        appendInteger(buffer, digits, width);
+    }
+}
+
+namespace
+{
+
+inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline bool isAlpha(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+inline char toUpper(char c)
+{
+    return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+// like atof() the longest valid prefix is converted and 0 is returned if there is none
+double toDouble(const std::string& value)
+{
+    double result = 0.0;
+    if (std::from_chars(value.data(), value.data() + value.size(), result).ec != std::errc()) {
+        result = 0.0;
     }
-    return str.str();
+    return result;
 }
 
-void Command::setFromGCode(const std::string& str)
+}  // namespace
+
+void Command::setFromGCode(std::string_view str)
 {
+    enum class Mode
+    {
+        None,
+        Command,
+        Argument,
+        Comment
+    };
+
     Parameters.clear();
-    std::string mode = "none";
-    std::string key;
+    Mode mode = Mode::None;
+    char key = 0;
+    // the value is collected as the digits may be separated by spaces
     std::string value;
-    for (unsigned int i = 0; i < str.size(); i++) {
-        if ((isdigit(str[i])) || (str[i] == '-') || (str[i] == '.')) {
-            value += str[i];
+    for (char c : str) {
+        if (isDigit(c) || (c == '-') || (c == '.')) {
+            value += c;
         }
-        else if (isalpha(str[i])) {
-            if (mode == "command") {
-                if (!key.empty() && !value.empty()) {
-                    std::string cmd = key + value;
-                    boost::to_upper(cmd);
-                    Name = cmd;
-                    key = "";
-                    value = "";
-                    mode = "argument";
+        else if (isAlpha(c)) {
+            if (mode == Mode::Command) {
+                if (key && !value.empty()) {
+                    Name.assign(1, toUpper(key));
+                    Name += value;
+                    value.clear();
                 }
                 else {
                     throw Base::BadFormatError("Badly formatted GCode command");
                 }
-                mode = "argument";
+                mode = Mode::Argument;
             }
-            else if (mode == "none") {
-                mode = "command";
+            else if (mode == Mode::None) {
+                mode = Mode::Command;
             }
-            else if (mode == "argument") {
-                if (!key.empty() && !value.empty()) {
-                    double val = std::atof(value.c_str());
-                    boost::to_upper(key);
-                    Parameters[key] = val;
-                    key = "";
-                    value = "";
+            else if (mode == Mode::Argument) {
+                if (key && !value.empty()) {
+                    Parameters[std::string(1, toUpper(key))] = toDouble(value);
+                    value.clear();
                 }
                 else {
                     throw Base::BadFormatError("Badly formatted GCode argument");
                 }
             }
-            else if (mode == "comment") {
-                value += str[i];
+            else if (mode == Mode::Comment) {
+                value += c;
             }
-            key = str[i];
+            key = c;
         }
-        else if (str[i] == '(') {
-            mode = "comment";
+        else if (c == '(') {
+            mode = Mode::Comment;
         }
-        else if (str[i] == ')') {
-            key = "(";
-            value += ")";
+        else if (c == ')') {
+            key = '(';
+            value += ')';
         }
         else {
             // add non-ascii characters only if this is a comment
-            if (mode == "comment") {
-                value += str[i];
+            if (mode == Mode::Comment) {
+                value += c;
             }
         }
     }
-    if (!key.empty() && !value.empty()) {
-        if ((mode == "command") || (mode == "comment")) {
-            std::string cmd = key + value;
-            if (mode == "command") {
-                boost::to_upper(cmd);
-            }
-            Name = cmd;
+    if (key && !value.empty()) {
+        if (mode == Mode::Command) {
+            Name.assign(1, toUpper(key));
+            Name += value;
+        }
+        else if (mode == Mode::Comment) {
+            Name.assign(1, key);
+            Name += value;
         }
         else {
-            double val = std::atof(value.c_str());
-            boost::to_upper(key);
-            Parameters[key] = val;
+            Parameters[std::string(1, toUpper(key))] = toDouble(value);
         }
     }
     else {
@@ -274,7 +499,7 @@ void Command::setCenter(const Base::Vector3d& pos, bool clockwise)
     Parameters[k] = kval;
 }
 
-Command Command::transform(const Base::Placement& other)
+Command Command::transform(const Base::Placement& other) const
 {
     Base::Placement plac = getPlacement();
     plac *= other;
@@ -285,9 +510,7 @@ Command Command::transform(const Base::Placement& other)
     plac.getRotation().getYawPitchRoll(aval, bval, cval);
     Command c = Command();
     c.Name = Name;
-    for (std::map<std::string, double>::const_iterator i = Parameters.begin();
-         i != Parameters.end();
-         ++i) {
+    for (auto i = Parameters.begin(); i != Parameters.end(); ++i) {
         std::string k = i->first;
         double v = i->second;
         if (k == "X") {
@@ -315,10 +538,9 @@ Command Command::transform(const Base::Placement& other)
 
 void Command::scaleBy(double factor)
 {
-    for (std::map<std::string, double>::const_iterator i = Parameters.begin();
-         i != Parameters.end();
-         ++i) {
-        switch (i->first[0]) {
+    CommandParameters scaled;
+    for (const auto& param : Parameters) {
+        switch (param.first[0]) {
             case 'X':
             case 'Y':
             case 'Z':
@@ -327,17 +549,21 @@ void Command::scaleBy(double factor)
             case 'R':
             case 'Q':
             case 'F':
-                Parameters[i->first] = i->second * factor;
+                scaled[param.first] = param.second * factor;
+                break;
+            default:
+                scaled[param.first] = param.second;
                 break;
         }
     }
+    Parameters = std::move(scaled);
 }
 
 // Reimplemented from base class
 
 unsigned int Command::getMemSize() const
 {
-    return toGCode().size();
+    return sizeof(Command) + Parameters.size() * sizeof(CommandParameters::value_type);
 }
 
 void Command::Save(Writer& writer) const
@@ -24,8 +24,14 @@
 #ifndef PATH_COMMAND_H
 #define PATH_COMMAND_H
 
+#include <array>
+#include <cstdint>
+#include <iterator>
 #include <map>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include <Base/Persistence.h>
 #include <Base/Placement.h>
 #include <Base/Vector3D.h>
@@ -33,6 +39,98 @@
 
 namespace Path
 {
+/** The parameters of a cnc command, the values of its words by their upper case names
+ *
+ * The words of the axes, the arc center, the radius and the feed rate are kept in fixed slots with
+ * a mask of the present ones, all others in a small table sorted by name. So the parameters of a
+ * move don't allocate any memory. Like a std::map the parameters are iterated sorted by name.
+ */
+class PathExport CommandParameters
+{
+public:
+    using value_type = std::pair<std::string, double>;
+
+    class PathExport const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = CommandParameters::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() = default;
+
+        reference operator*() const
+        {
+            return current;
+        }
+        pointer operator->() const
+        {
+            return &current;
+        }
+        const_iterator& operator++();
+        const_iterator operator++(int)
+        {
+            const_iterator it(*this);
+            ++*this;
+            return it;
+        }
+        bool operator==(const const_iterator& other) const
+        {
+            return slot == other.slot && extra == other.extra;
+        }
+
+    private:
+        friend class CommandParameters;
+        const_iterator(const CommandParameters* params, int slot, std::size_t extra);
+        bool isSlot() const;
+        void update();
+
+        const CommandParameters* params = nullptr;
+        // the next present slot and the next entry of the table, the current one is the smaller
+        int slot = 0;
+        std::size_t extra = 0;
+        value_type current;
+    };
+    using iterator = const_iterator;
+
+    CommandParameters() = default;
+    CommandParameters(const std::map<std::string, double>& parameters);
+
+    /// Returns the value of \a name, it is added with a value of 0 if not present
+    double& operator[](const std::string& name);
+    const_iterator find(const std::string& name) const;
+    bool contains(const std::string& name) const;
+    /// Returns the value of \a name or \a fallback if not present
+    double get(const std::string& name, double fallback = 0.0) const;
+    void erase(const std::string& name);
+    void clear();
+    std::size_t size() const;
+    bool empty() const
+    {
+        return mask == 0 && extras.empty();
+    }
+
+    const_iterator begin() const;
+    const_iterator end() const
+    {
+        return {this, NumSlots, extras.size()};
+    }
+
+private:
+    static constexpr int NumSlots = 11;
+    static constexpr std::array<char, NumSlots> SlotNames {
+        'A', 'B', 'C', 'F', 'I', 'J', 'K', 'R', 'X', 'Y', 'Z'};
+
+    static int slotOf(const std::string& name);
+    int nextSlot(int slot) const;
+
+    std::array<double, NumSlots> values {};
+    std::uint16_t mask = 0;
+    std::vector<value_type> extras;
+};
+
 /** The representation of a cnc command in a path */
 class PathExport Command: public Base::Persistence
 {
@@ -42,7 +140,12 @@ public:
     // constructors
     Command();
     Command(const char* name, const std::map<std::string, double>& parameters);
+    Command(const Command&) = default;
+    Command(Command&&) = default;
     ~Command() override;
+
+    Command& operator=(const Command&) = default;
+    Command& operator=(Command&&) = default;
     // from base class
     unsigned int getMemSize() const override;
     void Save(Base::Writer& /*writer*/) const override;
@@ -57,26 +160,28 @@ public:
     std::string
     toGCode(int precision = 6,
             bool padzero = true) const;  // returns a GCode string representation of the command
+    void appendGCode(std::string& buffer,
+                     int precision = 6,
+                     bool padzero = true) const;  // appends the GCode string to the buffer
     void setFromGCode(
-        const std::string&);  // sets the parameters from the contents of the given GCode string
+        std::string_view);  // sets the parameters from the contents of the given GCode string
     void setFromPlacement(
         const Base::Placement&);  // sets the parameters from the contents of the given placement
     bool
     has(const std::string&) const;  // returns true if the given string exists in the parameters
-    Command transform(const Base::Placement&);       // returns a transformed copy of this command
+    Command transform(const Base::Placement&) const;  // returns a transformed copy of this command
     double getValue(const std::string& name) const;  // returns the value of a given parameter
     void scaleBy(double factor);  // scales the receiver - use for imperial/metric conversions
 
     // this assumes the name is upper case
     inline double getParam(const std::string& name, double fallback = 0.0) const
     {
-        auto it = Parameters.find(name);
-        return it == Parameters.end() ? fallback : it->second;
+        return Parameters.get(name, fallback);
     }
 
     // attributes
     std::string Name;
-    std::map<std::string, double> Parameters;
+    CommandParameters Parameters;
 };
 
 }  // namespace Path
@@ -21,6 +21,15 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <future>
+#include <iterator>
+#include <string_view>
+#include <thread>
+#endif
 
 #include <App/Application.h>
 #include <Base/Console.h>
@@ -41,17 +50,13 @@ Toolpath::Toolpath()
 {}
 
 Toolpath::Toolpath(const Toolpath& otherPath)
-    : vpcCommands(otherPath.vpcCommands.size())
+    : commands(otherPath.commands)
     , center(otherPath.center)
 {
-    *this = otherPath;
     recalculate();
 }
 
-Toolpath::~Toolpath()
-{
-    clear();
-}
+Toolpath::~Toolpath() = default;
 
 Toolpath& Toolpath::operator=(const Toolpath& otherPath)
 {
@@ -59,14 +64,7 @@ Toolpath& Toolpath::operator=(const Toolpath& otherPath)
         return *this;
     }
 
-    clear();
-    vpcCommands.resize(otherPath.vpcCommands.size());
-    int i = 0;
-    for (std::vector<Command*>::const_iterator it = otherPath.vpcCommands.begin();
-         it != otherPath.vpcCommands.end();
-         ++it, i++) {
-        vpcCommands[i] = new Command(**it);
-    }
+    commands = otherPath.commands;
     center = otherPath.center;
     recalculate();
     return *this;
@@ -74,17 +72,13 @@ Toolpath& Toolpath::operator=(const Toolpath& otherPath)
 
 void Toolpath::clear()
 {
-    for (std::vector<Command*>::iterator it = vpcCommands.begin(); it != vpcCommands.end(); ++it) {
-        delete (*it);
-    }
-    vpcCommands.clear();
+    commands.clear();
     recalculate();
 }
 
 void Toolpath::addCommand(const Command& Cmd)
 {
-    Command* tmp = new Command(Cmd);
-    vpcCommands.push_back(tmp);
+    commands.push_back(Cmd);
     recalculate();
 }
 
@@ -93,9 +87,8 @@ void Toolpath::insertCommand(const Command& Cmd, int pos)
     if (pos == -1) {
         addCommand(Cmd);
     }
-    else if (pos <= static_cast<int>(vpcCommands.size())) {
-        Command* tmp = new Command(Cmd);
-        vpcCommands.insert(vpcCommands.begin() + pos, tmp);
+    else if (pos <= static_cast<int>(commands.size())) {
+        commands.insert(commands.begin() + pos, Cmd);
     }
     else {
         throw Base::IndexError("Index not in range");
@@ -106,11 +99,10 @@ void Toolpath::insertCommand(const Command& Cmd, int pos)
 void Toolpath::deleteCommand(int pos)
 {
     if (pos == -1) {
-        // delete(*vpcCommands.rbegin()); // causes crash
-        vpcCommands.pop_back();
+        commands.pop_back();
     }
-    else if (pos <= static_cast<int>(vpcCommands.size())) {
-        vpcCommands.erase(vpcCommands.begin() + pos);
+    else if (pos < static_cast<int>(commands.size())) {
+        commands.erase(commands.begin() + pos);
     }
     else {
         throw Base::IndexError("Index not in range");
@@ -120,16 +112,15 @@ void Toolpath::deleteCommand(int pos)
 
 double Toolpath::getLength()
 {
-    if (vpcCommands.empty()) {
+    if (commands.empty()) {
         return 0;
     }
     double l = 0;
     Vector3d last(0, 0, 0);
     Vector3d next;
-    for (std::vector<Command*>::const_iterator it = vpcCommands.begin(); it != vpcCommands.end();
-         ++it) {
-        std::string name = (*it)->Name;
-        next = (*it)->getPlacement(last).getPosition();
+    for (const Command& cmd : commands) {
+        const std::string& name = cmd.Name;
+        next = cmd.getPlacement(last).getPosition();
         if ((name == "G0") || (name == "G00") || (name == "G1") || (name == "G01")) {
             // straight line
             l += (next - last).Length();
@@ -137,7 +128,7 @@ double Toolpath::getLength()
         }
         else if ((name == "G2") || (name == "G02") || (name == "G3") || (name == "G03")) {
             // arc
-            Vector3d center = (*it)->getCenter();
+            Vector3d center = cmd.getCenter();
             double radius = (last - center).Length();
             double angle = (next - center).GetAngle(last - center);
             l += angle * radius;
@@ -167,7 +158,7 @@ double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double
         vRapid = vFeed;
     }
 
-    if (vpcCommands.empty()) {
+    if (commands.empty()) {
         return 0;
     }
     double l = 0;
@@ -175,15 +166,14 @@ double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double
     bool verticalMove = false;
     Vector3d last(0, 0, 0);
     Vector3d next;
-    for (std::vector<Command*>::const_iterator it = vpcCommands.begin(); it != vpcCommands.end();
-         ++it) {
-        std::string name = (*it)->Name;
-        float feedrate = (*it)->getParam("F");
+    for (const Command& cmd : commands) {
+        const std::string& name = cmd.Name;
+        float feedrate = cmd.getParam("F");
 
         l = 0;
         verticalMove = false;
         feedrate = hFeed;
-        next = (*it)->getPlacement(last).getPosition();
+        next = cmd.getPlacement(last).getPosition();
 
         if (last.z != next.z) {
             verticalMove = true;
@@ -204,7 +194,7 @@ double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double
         }
         else if ((name == "G2") || (name == "G02") || (name == "G3") || (name == "G03")) {
             // Arc Move
-            Vector3d center = (*it)->getCenter();
+            Vector3d center = cmd.getCenter();
             double radius = (last - center).Length();
             double angle = (next - center).GetAngle(last - center);
             l += angle * radius;
@@ -304,76 +294,91 @@ Base::BoundBox3d Toolpath::getBoundBox() const
     return visitor.bb;
 }
 
-static void
-bulkAddCommand(const std::string& gcodestr, std::vector<Command*>& commands, bool& inches)
-{
-    Command* cmd = new Command();
-    cmd->setFromGCode(gcodestr);
-    if ("G20" == cmd->Name) {
-        inches = true;
-        delete cmd;
-    }
-    else if ("G21" == cmd->Name) {
-        inches = false;
-        delete cmd;
-    }
-    else {
-        if (inches) {
-            cmd->scaleBy(25.4);
-        }
-        commands.push_back(cmd);
-    }
-}
-
-void Toolpath::setFromGCode(const std::string instr)
+// Splits the GCode string into the strings of the commands and the comments
+static std::vector<std::string_view> splitGCode(std::string_view str)
 {
-    clear();
-
-    // remove comments
-    // boost::regex e("\\(.*?\\)");
-    // std::string str = boost::regex_replace(instr, e, "");
-    std::string str(instr);
-
-    // split input string by () or G or M commands
-    std::string mode = "command";
+    std::vector<std::string_view> result;
+    bool comment = false;
     std::size_t found = str.find_first_of("(gGmM");
-    int last = -1;
-    bool inches = false;
-    while (found != std::string::npos) {
+    std::size_t last = std::string_view::npos;
+    while (found != std::string_view::npos) {
         if (str[found] == '(') {
             // start of comment
-            if ((last > -1) && (mode == "command")) {
+            if (last != std::string_view::npos && !comment) {
                 // before opening a comment, add the last found command
-                std::string gcodestr = str.substr(last, found - last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
+                result.push_back(str.substr(last, found - last));
             }
-            mode = "comment";
+            comment = true;
             last = found;
             found = str.find_first_of(')', found + 1);
         }
         else if (str[found] == ')') {
             // end of comment
-            std::string gcodestr = str.substr(last, found - last + 1);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
-            last = -1;
+            result.push_back(str.substr(last, found - last + 1));
+            last = std::string_view::npos;
             found = str.find_first_of("(gGmM", found + 1);
-            mode = "command";
+            comment = false;
         }
-        else if (mode == "command") {
+        else {
             // command
-            if (last > -1) {
-                std::string gcodestr = str.substr(last, found - last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
+            if (last != std::string_view::npos) {
+                result.push_back(str.substr(last, found - last));
             }
             last = found;
             found = str.find_first_of("(gGmM", found + 1);
         }
     }
-    // add the last command found, if any
-    if (last > -1) {
-        if (mode == "command") {
-            std::string gcodestr = str.substr(last, std::string::npos);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
+    // add the last command found, if any, an unterminated comment is dropped
+    if (last != std::string_view::npos && !comment) {
+        result.push_back(str.substr(last));
+    }
+    return result;
+}
+
+void Toolpath::setFromGCode(const std::string& str)
+{
+    clear();
+
+    // the commands are independent of each other, so large files are parsed on all cores
+    std::vector<std::string_view> gcodes = splitGCode(str);
+    std::vector<Command> parsed(gcodes.size());
+    auto parse = [&gcodes, &parsed](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            parsed[i].setFromGCode(gcodes[i]);
+        }
+    };
+
+    const std::size_t minChunk = 10000;
+    const std::size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+    std::size_t numTasks = std::clamp<std::size_t>(gcodes.size() / minChunk, 1, threads);
+    std::size_t chunk = (gcodes.size() + numTasks - 1) / numTasks;
+    std::vector<std::future<void>> futures;
+    for (std::size_t task = 1; task < numTasks; task++) {
+        futures.push_back(std::async(std::launch::async,
+                                     parse,
+                                     task * chunk,
+                                     std::min(gcodes.size(), (task + 1) * chunk)));
+    }
+    parse(0, std::min(gcodes.size(), chunk));
+    for (auto& it : futures) {
+        it.get();
+    }
+
+    // the unit commands are removed and the moves after a G20 are converted to mm
+    bool inches = false;
+    commands.reserve(parsed.size());
+    for (Command& cmd : parsed) {
+        if ("G20" == cmd.Name) {
+            inches = true;
+        }
+        else if ("G21" == cmd.Name) {
+            inches = false;
+        }
+        else {
+            if (inches) {
+                cmd.scaleBy(25.4);
+            }
+            commands.push_back(std::move(cmd));
         }
     }
     recalculate();
@@ -382,10 +387,12 @@ void Toolpath::setFromGCode(const std::string instr)
 std::string Toolpath::toGCode() const
 {
     std::string result;
-    for (std::vector<Command*>::const_iterator it = vpcCommands.begin(); it != vpcCommands.end();
-         ++it) {
-        result += (*it)->toGCode();
-        result += "\n";
+    // a rough estimate of the length of a command line
+    const std::size_t lineLength = 32;
+    result.reserve(commands.size() * lineLength);
+    for (const Command& cmd : commands) {
+        cmd.appendGCode(result);
+        result += '\n';
     }
     return result;
 }
@@ -393,7 +400,7 @@ std::string Toolpath::toGCode() const
 void Toolpath::recalculate()  // recalculates the path cache
 {
 
-    if (vpcCommands.empty()) {
+    if (commands.empty()) {
         return;
     }
 
@@ -458,7 +465,39 @@ void Toolpath::recalculate()  // recalculates the path cache
 
 unsigned int Toolpath::getMemSize() const
 {
-    return toGCode().size();
+    unsigned int size = sizeof(Toolpath);
+    for (const Command& cmd : commands) {
+        size += cmd.getMemSize();
+    }
+    return size;
+}
+
+bool Toolpath::remapParameter(const std::string& name,
+                              const std::vector<std::pair<double, double>>& values,
+                              double tolerance)
+{
+    // find the replacement of every value first so that a failed lookup leaves the path intact
+    std::vector<std::pair<std::size_t, double>> replacements;
+    for (std::size_t i = 0; i < commands.size(); i++) {
+        const CommandParameters& params = commands[i].Parameters;
+        if (!params.contains(name)) {
+            continue;
+        }
+        double value = params.get(name);
+        auto it = std::find_if(values.begin(), values.end(), [value](const auto& entry) {
+            return std::fabs(value - entry.first) <= tolerance;
+        });
+        if (it == values.end()) {
+            return false;
+        }
+        if (it->second != value) {
+            replacements.emplace_back(i, it->second);
+        }
+    }
+    for (const auto& [index, value] : replacements) {
+        commands[index].Parameters[name] = value;
+    }
+    return true;
 }
 
 void Toolpath::setCenter(const Base::Vector3d& c)
@@ -481,7 +520,7 @@ void Toolpath::Save(Writer& writer) const
         writer.incInd();
         saveCenter(writer, center);
         for (unsigned int i = 0; i < getSize(); i++) {
-            vpcCommands[i]->Save(writer);
+            commands[i].Save(writer);
         }
         writer.decInd();
     }
@@ -498,10 +537,19 @@ void Toolpath::Save(Writer& writer) const
 
 void Toolpath::SaveDocFile(Base::Writer& writer) const
 {
-    if (toGCode().empty()) {
-        return;
+    // the lines are written in blocks through a reused buffer
+    const std::size_t blockSize = 1 << 20;
+    std::string buffer;
+    buffer.reserve(blockSize + 1024);
+    for (const Command& cmd : commands) {
+        cmd.appendGCode(buffer);
+        buffer += '\n';
+        if (buffer.size() >= blockSize) {
+            writer.Stream().write(buffer.data(), std::streamsize(buffer.size()));
+            buffer.clear();
+        }
     }
-    writer.Stream() << toGCode();
+    writer.Stream().write(buffer.data(), std::streamsize(buffer.size()));
 }
 
 void Toolpath::Restore(XMLReader& reader)
@@ -517,11 +565,22 @@ void Toolpath::Restore(XMLReader& reader)
 
 void Toolpath::RestoreDocFile(Base::Reader& reader)
 {
+    // the whitespace between the words is collapsed to single spaces
     std::string gcode;
-    std::string line;
-    while (reader >> line) {
-        gcode += line;
-        gcode += " ";
-    }
+    bool space = false;
+    std::for_each(std::istreambuf_iterator<char>(reader),
+                  std::istreambuf_iterator<char>(),
+                  [&gcode, &space](char c) {
+                      if (std::isspace(static_cast<unsigned char>(c))) {
+                          space = !gcode.empty();
+                      }
+                      else {
+                          if (space) {
+                              gcode += ' ';
+                              space = false;
+                          }
+                          gcode += c;
+                      }
+                  });
     setFromGCode(gcode);
 }
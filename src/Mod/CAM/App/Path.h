@@ -61,23 +61,28 @@ public:
     double getLength();                                   // return the Length (mm) of the Path
     double getCycleTime(double, double, double, double);  // return the Cycle Time (s) of the Path
     void recalculate();                                   // recalculates the points
-    void
-    setFromGCode(const std::string);  // sets the path from the contents of the given GCode string
-    std::string toGCode() const;      // gets a gcode string representation from the Path
+    void setFromGCode(
+        const std::string&);      // sets the path from the contents of the given GCode string
+    std::string toGCode() const;  // gets a gcode string representation from the Path
     Base::BoundBox3d getBoundBox() const;
+    // replaces each value of the parameter \a name by its counterpart in \a values, the path is
+    // left unchanged and false is returned if a value matches none of them within \a tolerance
+    bool remapParameter(const std::string& name,
+                        const std::vector<std::pair<double, double>>& values,
+                        double tolerance);
 
     // shortcut functions
     unsigned int getSize() const
     {
-        return vpcCommands.size();
+        return commands.size();
     }
-    const std::vector<Command*>& getCommands() const
+    const std::vector<Command>& getCommands() const
     {
-        return vpcCommands;
+        return commands;
     }
     const Command& getCommand(unsigned int pos) const
     {
-        return *vpcCommands[pos];
+        return commands[pos];
     }
 
     // support for rotation
@@ -90,7 +95,8 @@ public:
     static const int SchemaVersion = 2;
 
 protected:
-    std::vector<Command*> vpcCommands;
+    // the commands are stored by value so that a path of many moves is a single allocation
+    std::vector<Command> commands;
     Base::Vector3d center;
     // KDL::Path_Composite *pcPath;
 
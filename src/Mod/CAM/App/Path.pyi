@@ -52,6 +52,13 @@ class Path(Persistence):
     def getCycleTime(self) -> Any:
         """return the cycle time estimation for this path in s"""
         ...
+
+    def remapParameter(self) -> Any:
+        """remapParameter(name, [(value, replacement), ...], [tolerance]):
+        replaces each value of the given parameter, F for example, by the replacement of the
+        matching value. Returns False and leaves the path unchanged if a value of the parameter
+        does not match any of the given values within the tolerance (default 1e-6)"""
+        ...
     Length: Final[float]
     """the total length of this path in mm"""
 
@@ -21,6 +21,9 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#ifndef _PreComp_
+#include <boost/algorithm/string.hpp>
+#endif
 
 #include "Base/GeometryPyCXX.h"
 
@@ -201,6 +204,34 @@ PyObject* PathPy::getCycleTime(PyObject* args) const
     return nullptr;
 }
 
+PyObject* PathPy::remapParameter(PyObject* args)
+{
+    char* name = nullptr;
+    PyObject* o;
+    double tolerance = 1e-6;
+    if (!PyArg_ParseTuple(args, "sO|d", &name, &o, &tolerance)) {
+        return nullptr;
+    }
+    std::vector<std::pair<double, double>> values;
+    try {
+        for (const auto& item : Py::Sequence(o)) {
+            Py::Sequence entry(item);
+            if (entry.size() != 2) {
+                throw Py::TypeError("Expected a list of (value, replacement) pairs");
+            }
+            values.emplace_back(static_cast<double>(Py::Float(entry[0])),
+                                static_cast<double>(Py::Float(entry[1])));
+        }
+    }
+    catch (const Py::Exception&) {
+        return nullptr;
+    }
+    std::string param(name);
+    boost::to_upper(param);
+    return Py::new_reference_to(
+        Py::Boolean(getToolpathPtr()->remapParameter(param, values, tolerance)));
+}
+
 // GCode methods
 
 PyObject* PathPy::toGCode(PyObject* args) const
@@ -22,6 +22,12 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <mutex>
+#include <numeric>
+#include <thread>
 #endif
 
 #include <Base/Vector3D.h>
@@ -228,7 +234,12 @@ void Voronoi::colorExterior(const Voronoi::diagram_type::edge_type* edge, std::s
 
 void Voronoi::colorExterior(Voronoi::color_type color)
 {
-    for (diagram_type::const_edge_iterator it = vd->edges().begin(); it != vd->edges().end();
+    colorExterior(*vd, color);
+}
+
+void Voronoi::colorExterior(const Voronoi::diagram_type& dia, Voronoi::color_type color)
+{
+    for (diagram_type::const_edge_iterator it = dia.edges().begin(); it != dia.edges().end();
          ++it) {
         if (it->is_infinite()) {
             colorExterior(&(*it), color);
@@ -290,21 +301,28 @@ bool Voronoi::diagram_type::segmentsAreConnected(int i, int j) const
 }
 
 void Voronoi::colorColinear(Voronoi::color_type color, double degree)
+{
+    colorColinear(*vd, color, degree);
+}
+
+void Voronoi::colorColinear(const Voronoi::diagram_type& dia,
+                            Voronoi::color_type color,
+                            double degree)
 {
     using std::numbers::pi;
     double rad = Base::toRadians(degree);
 
     Voronoi::diagram_type::angle_map_t angle;
-    int psize = vd->points.size();
+    int psize = dia.points.size();
 
-    for (diagram_type::const_edge_iterator it = vd->edges().begin(); it != vd->edges().end();
+    for (diagram_type::const_edge_iterator it = dia.edges().begin(); it != dia.edges().end();
          ++it) {
         int i0 = it->cell()->source_index() - psize;
         int i1 = it->twin()->cell()->source_index() - psize;
         if (it->color() == 0 && it->cell()->contains_segment()
-            && it->twin()->cell()->contains_segment() && vd->segmentsAreConnected(i0, i1)) {
-            double a0 = vd->angleOfSegment(i0, &angle);
-            double a1 = vd->angleOfSegment(i1, &angle);
+            && it->twin()->cell()->contains_segment() && dia.segmentsAreConnected(i0, i1)) {
+            double a0 = dia.angleOfSegment(i0, &angle);
+            double a1 = dia.angleOfSegment(i1, &angle);
             double a = a0 - a1;
             if (a > pi / 2) {
                 a -= pi;
@@ -338,3 +356,380 @@ void Voronoi::resetColor(Voronoi::color_type color)
         }
     }
 }
+
+// Medial axis
+
+namespace
+{
+
+// Tests on which side of the closed wires of an island points are, with the even-odd rule. The
+// segments are sorted into horizontal bands so that a test only visits the segments in the band
+// of the point.
+class InsideTester
+{
+public:
+    explicit InsideTester(const std::vector<Voronoi::segment_type>& segments)
+        : segments(segments)
+    {
+        minY = std::numeric_limits<double>::max();
+        double maxY = std::numeric_limits<double>::lowest();
+        for (const auto& s : segments) {
+            minY = std::min({minY, low(s).y(), high(s).y()});
+            maxY = std::max({maxY, low(s).y(), high(s).y()});
+            endPoints.push_back(low(s));
+            endPoints.push_back(high(s));
+        }
+        std::sort(endPoints.begin(), endPoints.end());
+        int count = std::max(1, int(std::sqrt(double(segments.size()))));
+        bandHeight = std::max((maxY - minY) / count, 1e-9);
+        bands.resize(count);
+        for (std::size_t i = 0; i < segments.size(); ++i) {
+            auto range = bandRange(low(segments[i]).y(), high(segments[i]).y());
+            for (int b = range.first; b <= range.second; ++b) {
+                bands[b].push_back(i);
+            }
+        }
+    }
+
+    bool isEndPoint(double x, double y, double tolerance) const
+    {
+        auto it = std::lower_bound(endPoints.begin(),
+                                   endPoints.end(),
+                                   Voronoi::point_type(x - tolerance, y - tolerance));
+        for (; it != endPoints.end() && it->x() <= x + tolerance; ++it) {
+            if (std::hypot(it->x() - x, it->y() - y) <= tolerance) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool isOutside(double x, double y) const
+    {
+        auto range = bandRange(y, y);
+        bool inside = false;
+        for (std::size_t i : bands[range.first]) {
+            const auto& s = segments[i];
+            double y0 = low(s).y();
+            double y1 = high(s).y();
+            if ((y0 > y) != (y1 > y)) {
+                double xi = low(s).x() + (y - y0) * (high(s).x() - low(s).x()) / (y1 - y0);
+                if (xi > x) {
+                    inside = !inside;
+                }
+            }
+        }
+        return !inside;
+    }
+
+private:
+    std::pair<int, int> bandRange(double y0, double y1) const
+    {
+        int last = int(bands.size()) - 1;
+        int b0 = std::clamp(int((std::min(y0, y1) - minY) / bandHeight), 0, last);
+        int b1 = std::clamp(int((std::max(y0, y1) - minY) / bandHeight), 0, last);
+        return {b0, b1};
+    }
+
+    const std::vector<Voronoi::segment_type>& segments;
+    std::vector<Voronoi::point_type> endPoints;
+    std::vector<std::vector<std::size_t>> bands;
+    double minY;
+    double bandHeight;
+};
+
+// the distance of the point from the sources of the edge's cells
+double distanceToSource(const Voronoi::diagram_type& dia,
+                        const Voronoi::diagram_type::edge_type* edge,
+                        double x,
+                        double y)
+{
+    const Voronoi::diagram_type::cell_type* cell = edge->cell();
+    if (!cell->contains_point() && edge->twin()->cell()->contains_point()) {
+        cell = edge->twin()->cell();
+    }
+    if (cell->contains_point()) {
+        Voronoi::point_type p = dia.retrievePoint(cell);
+        return std::hypot(x - p.x(), y - p.y());
+    }
+    Voronoi::segment_type s = dia.retrieveSegment(cell);
+    double dx = high(s).x() - low(s).x();
+    double dy = high(s).y() - low(s).y();
+    double len = std::hypot(dx, dy);
+    if (len == 0) {
+        return std::hypot(x - low(s).x(), y - low(s).y());
+    }
+    return std::fabs((x - low(s).x()) * dy - (y - low(s).y()) * dx) / len;
+}
+
+// Appends the points of the edge after its first vertex, the parabola of a curved edge is
+// discretized so that the polyline deviates from it by no more than the given deviation.
+void addEdgePoints(const Voronoi::diagram_type& dia,
+                   const Voronoi::diagram_type::edge_type* edge,
+                   double deviation,
+                   Voronoi::medial_wire_type& wire)
+{
+    const auto* v1 = edge->vertex1();
+    if (edge->is_curved()) {
+        const auto* pointCell =
+            edge->cell()->contains_point() ? edge->cell() : edge->twin()->cell();
+        const auto* segmentCell =
+            edge->cell()->contains_point() ? edge->twin()->cell() : edge->cell();
+        Voronoi::point_type p = dia.retrievePoint(pointCell);
+        Voronoi::segment_type s = dia.retrieveSegment(segmentCell);
+        double dx = high(s).x() - low(s).x();
+        double dy = high(s).y() - low(s).y();
+        double len = std::hypot(dx, dy);
+        if (len > 0) {
+            // the parabola in the coordinates along the segment (t) and away from it (h), where
+            // the point is at (pt, ph)
+            dx /= len;
+            dy /= len;
+            auto along = [&](double x, double y) {
+                return (x - low(s).x()) * dx + (y - low(s).y()) * dy;
+            };
+            double pt = along(p.x(), p.y());
+            double ph = (p.y() - low(s).y()) * dx - (p.x() - low(s).x()) * dy;
+            double side = ph < 0 ? -1 : 1;
+            ph = std::fabs(ph);
+            double t0 = along(edge->vertex0()->x(), edge->vertex0()->y());
+            double t1 = along(v1->x(), v1->y());
+            if (ph > 0 && deviation > 0) {
+                // the curvature is largest at the apex, where its radius is ph
+                double step = std::sqrt(8 * ph * deviation * dia.getScale());
+                int count = std::clamp(int(std::ceil(std::fabs(t1 - t0) / step)), 1, 1000);
+                for (int i = 1; i < count; ++i) {
+                    double t = t0 + (t1 - t0) * i / count;
+                    double h = ((t - pt) * (t - pt) + ph * ph) / (2 * ph);
+                    double x = low(s).x() + t * dx - side * h * dy;
+                    double y = low(s).y() + t * dy + side * h * dx;
+                    wire.push_back(dia.scaledVector(x, y, h / dia.getScale()));
+                }
+            }
+        }
+    }
+    double r = distanceToSource(dia, edge, v1->x(), v1->y());
+    wire.push_back(dia.scaledVector(*v1, r / dia.getScale()));
+}
+
+}  // namespace
+
+void Voronoi::medialAxisOfIsland(Voronoi::diagram_type& dia,
+                                 double degree,
+                                 double deviation,
+                                 std::vector<Voronoi::medial_wire_type>& wires)
+{
+    using edge_type = diagram_type::edge_type;
+    const color_type excluded = 1;
+    // the tolerance of matching points, as VoronoiEdge.isBorderline() uses
+    const double tolerance = 1e-6 * dia.getScale();
+    construct_voronoi(dia.segments.begin(),
+                      dia.segments.end(),
+                      static_cast<voronoi_diagram_type*>(&dia));
+    if (dia.num_edges() == 0) {
+        return;
+    }
+
+    // drop the secondary edges and the curved ones that end on their own segment
+    InsideTester tester(dia.segments);
+    for (const auto& e : dia.edges()) {
+        if (!e.is_primary()) {
+            e.color(excluded);
+        }
+        else if (e.is_curved()) {
+            const auto* pointCell = e.cell()->contains_point() ? e.cell() : e.twin()->cell();
+            Voronoi::point_type p = dia.retrievePoint(pointCell);
+            Voronoi::segment_type s =
+                dia.retrieveSegment(e.cell()->contains_point() ? e.twin()->cell() : e.cell());
+            if (std::hypot(p.x() - low(s).x(), p.y() - low(s).y()) < tolerance
+                || std::hypot(p.x() - high(s).x(), p.y() - high(s).y()) < tolerance) {
+                e.color(excluded);
+            }
+        }
+    }
+    colorColinear(dia, excluded, degree);
+    colorExterior(dia, excluded);
+    auto isOutside = [&](const vertex_type* v) {
+        return v->color() == 0 && tester.isOutside(v->x(), v->y());
+    };
+    for (const auto& e : dia.edges()) {
+        if (e.is_finite() && e.color() == 0) {
+            const vertex_type* v0 = e.vertex0();
+            const vertex_type* v1 = e.vertex1();
+            if ((isOutside(v0) && isOutside(v1))
+                || (isOutside(v1) && tester.isEndPoint(v0->x(), v0->y(), tolerance))) {
+                colorExterior(&e, excluded);
+            }
+        }
+    }
+
+    // chain the remaining edges at the vertices where exactly two of them meet
+    const auto* first = &dia.edges().front();
+    std::vector<bool> used(dia.num_edges(), false);
+    auto isAxis = [&](const edge_type* e) {
+        return e->is_finite() && e->color() == 0 && !used[e - first];
+    };
+    auto degreeOf = [&](const vertex_type* v) {
+        int count = 0;
+        const edge_type* e = v->incident_edge();
+        do {
+            if (e->is_finite() && e->color() == 0) {
+                ++count;
+            }
+            e = e->rot_next();
+        } while (e != v->incident_edge());
+        return count;
+    };
+    auto nextEdge = [&](const vertex_type* v) -> const edge_type* {
+        const edge_type* e = v->incident_edge();
+        do {
+            if (isAxis(e)) {
+                return e;
+            }
+            e = e->rot_next();
+        } while (e != v->incident_edge());
+        return nullptr;
+    };
+    auto traverse = [&](const edge_type* e) {
+        medial_wire_type wire;
+        const vertex_type* v0 = e->vertex0();
+        double r = distanceToSource(dia, e, v0->x(), v0->y());
+        wire.push_back(dia.scaledVector(*v0, r / dia.getScale()));
+        while (e) {
+            used[e - first] = true;
+            used[e->twin() - first] = true;
+            addEdgePoints(dia, e, deviation, wire);
+            const vertex_type* v = e->vertex1();
+            e = degreeOf(v) == 2 ? nextEdge(v) : nullptr;
+        }
+        wires.push_back(std::move(wire));
+    };
+    for (const auto& v : dia.vertices()) {
+        if (degreeOf(&v) != 2) {
+            while (const edge_type* e = nextEdge(&v)) {
+                traverse(e);
+            }
+        }
+    }
+    // what is left are closed loops
+    for (const auto& e : dia.edges()) {
+        if (isAxis(&e)) {
+            traverse(&e);
+        }
+    }
+}
+
+std::vector<Voronoi::medial_wire_type> Voronoi::getMedialAxis(double degree,
+                                                              double deviation) const
+{
+    const auto& segments = vd->segments;
+
+    // connect the segments that share an end point to wires
+    std::vector<std::size_t> parent(segments.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto root = [&](std::size_t i) {
+        while (parent[i] != i) {
+            i = parent[i] = parent[parent[i]];
+        }
+        return i;
+    };
+    auto join = [&](std::size_t i, std::size_t j) {
+        parent[root(i)] = root(j);
+    };
+    std::vector<std::pair<point_type, std::size_t>> ends;
+    ends.reserve(segments.size() * 2);
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+        ends.emplace_back(low(segments[i]), i);
+        ends.emplace_back(high(segments[i]), i);
+    }
+    std::sort(ends.begin(), ends.end());
+    for (std::size_t i = 1; i < ends.size(); ++i) {
+        if (ends[i].first == ends[i - 1].first) {
+            join(ends[i].second, ends[i - 1].second);
+        }
+    }
+
+    // join the wires with overlapping bounding boxes to islands, a hole is always inside the
+    // bounding box of the wire around it
+    struct Box
+    {
+        double minX, minY, maxX, maxY;
+        std::size_t wire;
+    };
+    std::map<std::size_t, Box> wireBoxes;
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+        const auto& s = segments[i];
+        std::size_t r = root(i);
+        auto it = wireBoxes.find(r);
+        if (it == wireBoxes.end()) {
+            it = wireBoxes.emplace(r, Box {low(s).x(), low(s).y(), low(s).x(), low(s).y(), r})
+                     .first;
+        }
+        Box& box = it->second;
+        box.minX = std::min({box.minX, low(s).x(), high(s).x()});
+        box.minY = std::min({box.minY, low(s).y(), high(s).y()});
+        box.maxX = std::max({box.maxX, low(s).x(), high(s).x()});
+        box.maxY = std::max({box.maxY, low(s).y(), high(s).y()});
+    }
+    std::vector<Box> boxes;
+    for (const auto& entry : wireBoxes) {
+        boxes.push_back(entry.second);
+    }
+    std::sort(boxes.begin(), boxes.end(), [](const Box& b0, const Box& b1) {
+        return b0.minX < b1.minX;
+    });
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        for (std::size_t j = i + 1; j < boxes.size() && boxes[j].minX <= boxes[i].maxX; ++j) {
+            if (boxes[j].minY <= boxes[i].maxY && boxes[i].minY <= boxes[j].maxY) {
+                join(boxes[i].wire, boxes[j].wire);
+            }
+        }
+    }
+
+    // islands in the order of their first segment
+    std::map<std::size_t, std::size_t> islandIndex;
+    std::vector<std::vector<segment_type>> islands;
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+        auto it = islandIndex.emplace(root(i), islands.size()).first;
+        if (it->second == islands.size()) {
+            islands.emplace_back();
+        }
+        islands[it->second].push_back(segments[i]);
+    }
+
+    std::vector<std::vector<medial_wire_type>> islandWires(islands.size());
+    std::size_t next = 0;
+    std::mutex mutex;
+    auto work = [&]() {
+        while (true) {
+            std::size_t i;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (next >= islands.size()) {
+                    return;
+                }
+                i = next++;
+            }
+            diagram_type dia;
+            dia.setScale(vd->getScale());
+            dia.segments = std::move(islands[i]);
+            medialAxisOfIsland(dia, degree, deviation, islandWires[i]);
+        }
+    };
+    std::size_t numThreads =
+        std::min<std::size_t>(islands.size(), std::max(1U, std::thread::hardware_concurrency()));
+    std::vector<std::future<void>> futures;
+    for (std::size_t i = 1; i < numThreads; ++i) {
+        futures.push_back(std::async(std::launch::async, work));
+    }
+    work();
+    for (auto& f : futures) {
+        f.get();
+    }
+
+    std::vector<medial_wire_type> wires;
+    for (auto& w : islandWires) {
+        std::move(w.begin(), w.end(), std::back_inserter(wires));
+    }
+    return wires;
+}
@@ -110,6 +110,20 @@ public:
     void colorTwins(color_type color);
     void colorColinear(color_type color, double degree);
 
+    /** A polyline of the medial axis, the z value of each point is its distance to the input. */
+    using medial_wire_type = std::vector<Base::Vector3d>;
+
+    /** Returns the medial axis of the area enclosed by the input segments
+     *
+     * The segments are split into islands of wires whose bounding boxes do not overlap, and the
+     * diagram of each island is constructed on its own, in parallel. The medial axis inside an
+     * island only depends on its own wires. The edges are filtered as V-carving does: secondary
+     * and exterior edges and edges between segments that are colinear within the given degree
+     * are dropped. Curved edges are discretized with the given deviation. The diagram of this
+     * object is neither constructed nor changed.
+     */
+    std::vector<medial_wire_type> getMedialAxis(double degree, double deviation) const;
+
     template<typename T>
     T* create(int index)
     {
@@ -128,7 +142,14 @@ public:
 private:
     Base::Reference<diagram_type> vd;
     friend class VoronoiPy;
-    void colorExterior(const Voronoi::diagram_type::edge_type* edge, std::size_t colorValue);
+    static void colorExterior(const Voronoi::diagram_type::edge_type* edge,
+                              std::size_t colorValue);
+    static void colorExterior(const diagram_type& dia, color_type color);
+    static void colorColinear(const diagram_type& dia, color_type color, double degree);
+    static void medialAxisOfIsland(diagram_type& dia,
+                                   double degree,
+                                   double deviation,
+                                   std::vector<medial_wire_type>& wires);
 };
 
 }  // namespace Path
@@ -60,6 +60,14 @@ class Voronoi(BaseClass):
         """assign color 0 to all elements with the given color"""
         ...
 
+    @constmethod
+    def getMedialAxis(self) -> Any:
+        """getMedialAxis([degree=10, deviation=0.01]) return the medial axis of the area enclosed by the input segments
+        as a list of polylines, the z value of each point is its distance to the segments.
+        Edges between segments within degree of being colinear are dropped and curved edges are discretized with
+        the deviation. Separate islands of wires are processed in parallel, the diagram itself is not changed."""
+        ...
+
     @constmethod
     def getPoints(self) -> Any:
         """Get list of all input points."""
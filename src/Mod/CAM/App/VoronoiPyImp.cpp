@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 
 #include "Base/GeometryPyCXX.h"
+#include "Base/Interpreter.h"
 #include "Base/Vector3D.h"
 #include "Base/VectorPy.h"
 
@@ -297,6 +298,30 @@ PyObject* VoronoiPy::resetColor(PyObject* args)
     return Py_None;
 }
 
+PyObject* VoronoiPy::getMedialAxis(PyObject* args) const
+{
+    double degree = 10.;
+    double deviation = 0.01;
+    if (!PyArg_ParseTuple(args, "|dd", &degree, &deviation)) {
+        throw Py::RuntimeError("getMedialAxis accepts optionally a derivation in degrees for "
+                               "colinear segments (default 10) and a deviation (default 0.01)");
+    }
+    std::vector<Voronoi::medial_wire_type> wires;
+    {
+        Base::PyGILStateRelease release;
+        wires = getVoronoiPtr()->getMedialAxis(degree, deviation);
+    }
+    Py::List list;
+    for (const auto& wire : wires) {
+        Py::List points;
+        for (const auto& pt : wire) {
+            points.append(Py::asObject(new Base::VectorPy(new Base::Vector3d(pt))));
+        }
+        list.append(points);
+    }
+    return Py::new_reference_to(list);
+}
+
 PyObject* VoronoiPy::getPoints(PyObject* args) const
 {
     double z = 0;
@@ -134,3 +134,19 @@ G0 Z0.500000
         path = Path.Path(commands)
 
         self.assertEqual(path.Length, 2)
+
+    def test60(self):
+        """Test Path.remapParameter"""
+        commands = []
+        commands.append(Path.Command("G0", {"Z": 5}))
+        commands.append(Path.Command("G1", {"Z": 0, "F": 2}))
+        commands.append(Path.Command("G1", {"X": 1, "F": 10}))
+        path = Path.Path(commands)
+
+        # swapping two feed rates must not feed the result of one replacement into the other
+        self.assertTrue(path.remapParameter("f", [(2, 10), (10, 2)]))
+        self.assertEqual([c.Parameters.get("F") for c in path.Commands], [None, 10, 2])
+
+        # an unknown value leaves the whole path unchanged
+        self.assertFalse(path.remapParameter("F", [(10, 20)]))
+        self.assertEqual([c.Parameters.get("F") for c in path.Commands], [None, 10, 2])
@@ -188,3 +188,35 @@ class TestPathVoronoi(PathTestUtils.PathTestBase):
         )
         self.assertRoughly(e.valueAt(e.FirstParameter).z, 2.37)
         self.assertRoughly(e.valueAt(e.LastParameter).z, 5.14)
+
+    def test70(self):
+        """Check medial axis of separate islands"""
+
+        md = Path.Voronoi.Diagram()
+        for pts in [
+            [(0, 0), (10, 0), (10, 2), (0, 2)],
+            [(20, 0), (30, 0), (30, 10), (20, 10)],
+            [(22, 2), (22, 8), (28, 8), (28, 2)],
+        ]:
+            ptv = [FreeCAD.Vector(p[0], p[1]) for p in pts]
+            for i in range(len(ptv)):
+                md.addSegment(ptv[i], ptv[(i + 1) % len(ptv)])
+
+        wires = md.getMedialAxis()
+        self.assertEqual(md.numEdges(), 0)
+        self.assertEqual(len(wires), 13)
+
+        # the center line of the bar is 1 away from its long sides
+        center = [w for w in wires if all(Path.Geom.isRoughly(p.y, 1) for p in w)]
+        self.assertEqual(len(center), 1)
+        self.assertRoughly(min(p.x for p in center[0]), 1)
+        self.assertRoughly(max(p.x for p in center[0]), 9)
+        for p in center[0]:
+            self.assertRoughly(p.z, 1)
+
+        # along the sides of the hole the axis of the ring runs in the middle between its wires
+        ring = [p for w in wires for p in w if 20 < p.x < 30 and 2 <= p.y <= 8]
+        self.assertNotEqual(len(ring), 0)
+        for p in ring:
+            self.assertTrue(Path.Geom.isRoughly(p.x, 21) or Path.Geom.isRoughly(p.x, 29))
+            self.assertRoughly(p.z, 1)
@@ -23,7 +23,11 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <algorithm>
+#include <future>
 #include <limits>
+#include <mutex>
+#include <thread>
 #include <boost/algorithm/string/replace.hpp>
 
 #include <Inventor/SbVec3f.h>
@@ -41,6 +45,7 @@
 
 #include <App/Application.h>
 #include <App/DocumentObject.h>
+#include <Base/BoundBox.h>
 #include <Base/Parameter.h>
 #include <Base/Stream.h>
 #include <Gui/Application.h>
@@ -59,6 +64,33 @@ using namespace PathGui;
 using namespace Path;
 using namespace PartGui;
 
+namespace
+{
+
+/// Runs \a func on chunks [begin, end) of [0, count) on all cores, paths of surfacing
+/// operations have millions of points
+template<typename Func>
+void forChunks(std::size_t count, Func func)
+{
+    const std::size_t minChunk = 100000;
+    const std::size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+    std::size_t numTasks = std::clamp<std::size_t>(count / minChunk, 1, threads);
+    std::size_t chunk = (count + numTasks - 1) / numTasks;
+    std::vector<std::future<void>> futures;
+    for (std::size_t task = 1; task < numTasks; task++) {
+        futures.push_back(std::async(std::launch::async,
+                                     func,
+                                     task * chunk,
+                                     std::min(count, (task + 1) * chunk)));
+    }
+    func(0, std::min(count, chunk));
+    for (auto& it : futures) {
+        it.get();
+    }
+}
+
+}  // namespace
+
 namespace PathGui
 {
 
@@ -721,18 +753,24 @@ void ViewProviderPath::updateVisual(bool rebuild)
 
 
         if (!edgeIndices.empty()) {
+            // the fields are filled in one go, setting single values notifies the scene each time
             pcLineCoords->point.setNum(points.size());
             SbVec3f* verts = pcLineCoords->point.startEditing();
-            int i = 0;
-            for (const auto& pt : points) {
-                verts[i++].setValue(pt.x, pt.y, pt.z);
-            }
+            forChunks(points.size(), [&points, verts](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    verts[i].setValue(points[i].x, points[i].y, points[i].z);
+                }
+            });
             pcLineCoords->point.finishEditing();
 
             pcMarkerCoords->point.setNum(markers.size());
-            for (unsigned int i = 0; i < markers.size(); i++) {
-                pcMarkerCoords->point.set1Value(i, markers[i].x, markers[i].y, markers[i].z);
-            }
+            SbVec3f* marks = pcMarkerCoords->point.startEditing();
+            forChunks(markers.size(), [&markers, marks](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    marks[i].setValue(markers[i].x, markers[i].y, markers[i].z);
+                }
+            });
+            pcMarkerCoords->point.finishEditing();
 
             recomputeBoundingBox();
         }
@@ -799,31 +837,31 @@ void ViewProviderPath::recomputeBoundingBox()
     MaxZ = -999999999.0;
     Path::Feature* pcPathObj = static_cast<Path::Feature*>(pcObject);
     Base::Placement pl = *(&pcPathObj->Placement.getValue());
-    Base::Vector3d pt;
-    for (int i = 1; i < pcLineCoords->point.getNum(); i++) {
-        pt.x = pcLineCoords->point[i].getValue()[0];
-        pt.y = pcLineCoords->point[i].getValue()[1];
-        pt.z = pcLineCoords->point[i].getValue()[2];
-        pl.multVec(pt, pt);
-        if (pt.x < MinX) {
-            MinX = pt.x;
-        }
-        if (pt.y < MinY) {
-            MinY = pt.y;
-        }
-        if (pt.z < MinZ) {
-            MinZ = pt.z;
-        }
-        if (pt.x > MaxX) {
-            MaxX = pt.x;
-        }
-        if (pt.y > MaxY) {
-            MaxY = pt.y;
-        }
-        if (pt.z > MaxZ) {
-            MaxZ = pt.z;
+    const SbVec3f* verts = pcLineCoords->point.getValues(0);
+    std::size_t count = pcLineCoords->point.getNum();
+    std::mutex mutex;
+    auto bound = [&](std::size_t begin, std::size_t end) {
+        Base::BoundBox3d box;
+        Base::Vector3d pt;
+        for (std::size_t i = std::max<std::size_t>(begin, 1); i < end; i++) {
+            pt.x = verts[i][0];
+            pt.y = verts[i][1];
+            pt.z = verts[i][2];
+            pl.multVec(pt, pt);
+            box.Add(pt);
+        }
+        if (!box.IsValid()) {
+            return;
         }
-    }
+        std::lock_guard<std::mutex> lock(mutex);
+        MinX = std::min(MinX, box.MinX);
+        MinY = std::min(MinY, box.MinY);
+        MinZ = std::min(MinZ, box.MinZ);
+        MaxX = std::max(MaxX, box.MaxX);
+        MaxY = std::max(MaxY, box.MaxY);
+        MaxZ = std::max(MaxZ, box.MaxZ);
+    };
+    forChunks(count, bound);
     pcBoundingBox->minBounds.setValue(MinX, MinY, MinZ);
     pcBoundingBox->maxBounds.setValue(MaxX, MaxY, MaxZ);
 }
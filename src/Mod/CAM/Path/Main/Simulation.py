@@ -0,0 +1,84 @@
+# -*- coding: utf-8 -*-
+# ***************************************************************************
+# *   This program is free software; you can redistribute it and/or modify  *
+# *   it under the terms of the GNU Lesser General Public License (LGPL)    *
+# *   as published by the Free Software Foundation; either version 2 of     *
+# *   the License, or (at your option) any later version.                   *
+# *   for detail see the LICENCE text file.                                 *
+# *                                                                         *
+# *   This program is distributed in the hope that it will be useful,       *
+# *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+# *   GNU Library General Public License for more details.                  *
+# *                                                                         *
+# *   You should have received a copy of the GNU Library General Public     *
+# *   License along with this program; if not, write to the Free Software   *
+# *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+# *   USA                                                                   *
+# *                                                                         *
+# ***************************************************************************
+
+"""Headless simulation of the material removal of a job, for batch verification of jobs."""
+
+import FreeCAD
+import Path
+import Path.Base.Util as PathUtil
+import Path.Dressup.Utils as PathDressup
+import PathScripts.PathUtils as PathUtils
+
+# lazily loaded modules
+from lazy_loader.lazy_loader import LazyLoader
+
+Part = LazyLoader("Part", globals(), "Part")
+PathSimulator = LazyLoader("PathSimulator", globals(), "PathSimulator")
+
+if False:
+    Path.Log.setLevel(Path.Log.Level.DEBUG, Path.Log.thisModule())
+    Path.Log.trackModule(Path.Log.thisModule())
+else:
+    Path.Log.setLevel(Path.Log.Level.INFO, Path.Log.thisModule())
+
+
+def simulate(job, resolution, tolerance=None, operations=None):
+    """simulate(job, resolution, tolerance=None, operations=None) ... simulate the job without GUI.
+
+    The active operations of the job, or the given operations, are cut from the stock on a height
+    field with cells of the given resolution. The result is a dict with the simulated stock as the
+    meshes Stock (its outer faces) and StockInner (the faces that were cut), and the deviation of
+    the stock from the job's models as returned by PathSimulator.PathSim.GetDeviation(). The
+    tolerance defaults to the resolution."""
+
+    if tolerance is None:
+        tolerance = resolution
+    if operations is None:
+        operations = [op for op in job.Operations.OutList if PathUtil.opProperty(op, "Active")]
+
+    stock = job.Stock.Shape
+    sim = PathSimulator.PathSim()
+    sim.BeginSimulation(stock, resolution)
+    initialPos = FreeCAD.Vector(0, 0, stock.BoundBox.ZMax)
+
+    for op in operations:
+        try:
+            tool = PathDressup.toolController(op).Tool
+        except Exception:
+            tool = None
+        if tool is None or tool.Shape.isNull() or not tool.Shape.isValid():
+            Path.Log.warning("{}: no valid tool, operation is not simulated".format(op.Label))
+            continue
+        sim.SetToolShape(tool.Shape, resolution)
+        pos = FreeCAD.Placement(initialPos, FreeCAD.Rotation())
+        sim.ApplyPath(pos, PathUtils.getPathWithPlacement(op))
+
+    result = sim.GetDeviation(Part.makeCompound([m.Shape for m in job.Model.Group]), tolerance)
+    result["Stock"], result["StockInner"] = sim.GetResultMesh()
+    Path.Log.info(
+        "{}: gouges {:.3f} mm3 (max {:.3f} mm), leftover stock {:.3f} mm3 (max {:.3f} mm)".format(
+            job.Label,
+            result["GougeVolume"],
+            result["MaxGouge"],
+            result["LeftoverVolume"],
+            result["MaxLeftover"],
+        )
+    )
+    return result
@@ -67,6 +67,48 @@ FeatureDiameters = 0x4000  # Turning Diameters
 FeatureBaseGeometry = FeatureBaseVertexes | FeatureBaseFaces | FeatureBaseEdges
 
 
+# properties that are results of an operation or do not change the commands it generates
+PathOutputProperties = ["Path", "CycleTime", "ToolController", "Label2", "Visibility"]
+
+# tool controller properties that are not used to generate the commands of an operation
+ToolControllerAnnotationProperties = [
+    "Path",
+    "Label",
+    "Label2",
+    "Visibility",
+    "ToolNumber",
+    "SpindleSpeed",
+    "SpindleDir",
+    "VertFeed",
+    "HorizFeed",
+    "VertRapid",
+    "HorizRapid",
+]
+
+
+def _valueSignature(value):
+    if isinstance(value, FreeCAD.DocumentObject):
+        return value.Name
+    if isinstance(value, (list, tuple)):
+        return tuple(_valueSignature(v) for v in value)
+    if isinstance(value, Path.Path):
+        return (value.Size, value.Length, str(value.BoundBox))
+    if hasattr(value, "hashCode"):
+        # shapes are identified by their topology rather than their content
+        return value.hashCode()
+    return repr(value)
+
+
+def _objectSignature(obj, skip):
+    """_objectSignature(obj, skip) ... returns a comparable value of all properties of obj except
+    the ones listed in skip."""
+    return tuple(
+        (name, _valueSignature(obj.getPropertyByName(name)))
+        for name in obj.PropertiesList
+        if name not in skip
+    )
+
+
 class PathNoTCException(Exception):
     """PathNoTCException is raised when no TC was selected or matches the input
     criteria. This can happen intentionally by the user when they cancel the TC
@@ -506,6 +548,13 @@ class ObjectOp(object):
         Can safely be overwritten by subclass."""
         pass
 
+    def opAnnotationProperties(self, obj):
+        """opAnnotationProperties(obj) ... returns the names of the properties which don't change
+        the commands generated by opExecute(). For properties like these and for the feed rates
+        of the tool controller the generated path is kept and only its feed rates are updated.
+        Can safely be overwritten by subclasses."""
+        return []
+
     def opExecute(self, obj):
         """opExecute(obj) ... called whenever the receiver needs to be recalculated.
         See documentation of execute() for a list of base functionality provided.
@@ -741,6 +790,7 @@ class ObjectOp(object):
         if not obj.Active:
             path = Path.Path("(inactive operation)")
             obj.Path = path
+            self.pathSignature = None
             return
 
         if not self._setBaseAndStock(obj):
@@ -782,6 +832,11 @@ class ObjectOp(object):
         # in case they still have an expression referencing any op values
         obj.recompute()
 
+        if self._updateFeedRates(obj):
+            obj.CycleTime = getCycleTimeEstimate(obj)
+            self.job.Proxy.getCycleTime()
+            return None
+
         self.commandlist = []
         self.commandlist.append(Path.Command("(%s)" % obj.Label))
         if obj.Comment:
@@ -797,8 +852,55 @@ class ObjectOp(object):
         obj.Path = path
         obj.CycleTime = getCycleTimeEstimate(obj)
         self.job.Proxy.getCycleTime()
+        if FeatureTool & self.opFeatures(obj):
+            self.pathSignature = self._pathSignature(obj)
+            self.pathFeedRates = self._feedRates()
         return result
 
+    def _pathSignature(self, obj):
+        """_pathSignature(obj) ... returns a comparable value of everything the commands of the
+        receiver depend on, except the feed rates of its tool controller. The objects linked by
+        the receiver are included, so the tool controller can be swapped for one with the same
+        tool."""
+        skip = PathOutputProperties + self.opAnnotationProperties(obj)
+        deps = [o for o in obj.OutListRecursive if o != obj.ToolController]
+        deps += [o for o in [self.stock] + list(self.model) if o is not None]
+        deps = sorted(set(deps), key=lambda o: o.Name)
+        return (
+            _objectSignature(obj, skip),
+            _objectSignature(obj.ToolController, ToolControllerAnnotationProperties),
+            tuple((o.Name, _objectSignature(o, ["Label2", "Visibility"])) for o in deps),
+            self.job.GeometryTolerance.Value,
+        )
+
+    def _feedRates(self):
+        return (self.horizFeed, self.vertFeed, self.horizRapid, self.vertRapid)
+
+    def _updateFeedRates(self, obj):
+        """_updateFeedRates(obj) ... if nothing but the feed rates of the tool controller or an
+        annotation changed since the last execution, the feed rates of the current path are updated
+        and True is returned. Otherwise the path has to be generated again."""
+        if not FeatureTool & self.opFeatures(obj):
+            return False
+        signature = getattr(self, "pathSignature", None)
+        if signature is None or signature != self._pathSignature(obj):
+            return False
+
+        rates = list(zip(self.pathFeedRates, self._feedRates()))
+        for old, new in rates:
+            if any(o == old and n != new for o, n in rates):
+                # two feed rates were the same, there is no telling which one a move got
+                return False
+
+        path = obj.Path
+        if not path.remapParameter("F", rates):
+            # the operation generated other feed rates than the ones of the tool controller
+            return False
+        Path.Log.debug("{}: updated feed rates of the path".format(obj.Label))
+        obj.Path = path
+        self.pathFeedRates = self._feedRates()
+        return True
+
     def addBase(self, obj, base, sub):
         Path.Log.track(obj, base, sub)
         base = PathUtil.getPublicObject(base)
@@ -53,29 +53,99 @@ void PathSim::SetToolShape(const TopoDS_Shape& toolShape, float resolution)
     m_tool = std::make_unique<cSimTool>(toolShape, resolution);
 }
 
-Base::Placement* PathSim::ApplyCommand(Base::Placement* pos, Command* cmd)
+Point3D PathSim::ApplyMove(const Point3D& fromPos, const Command& cmd)
 {
-    Point3D fromPos(*pos);
-    Point3D toPos(*pos);
-    toPos.UpdateCmd(*cmd);
+    Point3D startPos(fromPos);
+    Point3D toPos(fromPos);
+    toPos.UpdateCmd(cmd);
     if (m_tool) {
-        if (cmd->Name == "G0" || cmd->Name == "G1") {
-            m_stock->ApplyLinearTool(fromPos, toPos, *m_tool);
+        if (cmd.Name == "G0" || cmd.Name == "G1") {
+            m_stock->ApplyLinearTool(startPos, toPos, *m_tool);
         }
-        else if (cmd->Name == "G2") {
-            Vector3d vcent = cmd->getCenter();
+        else if (cmd.Name == "G2") {
+            Vector3d vcent = cmd.getCenter();
             Point3D cent(vcent);
-            m_stock->ApplyCircularTool(fromPos, toPos, cent, *m_tool, false);
+            m_stock->ApplyCircularTool(startPos, toPos, cent, *m_tool, false);
         }
-        else if (cmd->Name == "G3") {
-            Vector3d vcent = cmd->getCenter();
+        else if (cmd.Name == "G3") {
+            Vector3d vcent = cmd.getCenter();
             Point3D cent(vcent);
-            m_stock->ApplyCircularTool(fromPos, toPos, cent, *m_tool, true);
+            m_stock->ApplyCircularTool(startPos, toPos, cent, *m_tool, true);
         }
     }
+    return toPos;
+}
+
+Base::Placement* PathSim::ApplyCommand(Base::Placement* pos, Command* cmd)
+{
+    Point3D toPos = ApplyMove(Point3D(*pos), *cmd);
 
     Base::Placement* plc = new Base::Placement();
     Vector3d vec(toPos.x, toPos.y, toPos.z);
     plc->setPosition(vec);
     return plc;
 }
+
+Base::Placement PathSim::ApplyPath(const Base::Placement& pos, const Toolpath& path)
+{
+    Base::Placement start(pos);
+    Point3D curPos(start);
+    bool firstDrill = true;
+    for (const Command& cmd : path.getCommands()) {
+        if (cmd.Name == "G0" || cmd.Name == "G1" || cmd.Name == "G2" || cmd.Name == "G3") {
+            firstDrill = true;
+            curPos = ApplyMove(curPos, cmd);
+        }
+        else if (cmd.Name == "G80") {
+            firstDrill = true;
+        }
+        else if (cmd.Name == "G73" || cmd.Name == "G81" || cmd.Name == "G82"
+                 || cmd.Name == "G83") {
+            // the cycle retracts to the R plane, moves above the hole, drills and retracts
+            float retract = cmd.getParam("R", curPos.z);
+            Point3D hole(curPos);
+            hole.UpdateCmd(cmd);
+            Point3D above(hole.x, hole.y, retract);
+            if (firstDrill) {
+                Point3D up(curPos.x, curPos.y, retract);
+                if (m_tool) {
+                    m_stock->ApplyLinearTool(curPos, up, *m_tool);
+                }
+                curPos = up;
+                firstDrill = false;
+            }
+            if (m_tool) {
+                m_stock->ApplyLinearTool(curPos, above, *m_tool);
+                m_stock->ApplyLinearTool(above, hole, *m_tool);
+                m_stock->ApplyLinearTool(hole, above, *m_tool);
+            }
+            curPos = above;
+        }
+    }
+
+    Base::Placement plc;
+    plc.setPosition(Vector3d(curPos.x, curPos.y, curPos.z));
+    return plc;
+}
+
+void PathSim::GetDeviation(const Part::TopoShape& model,
+                           float tolerance,
+                           cStockDeviation& deviation)
+{
+    std::vector<Base::Vector3d> points;
+    std::vector<Data::ComplexGeoData::Facet> faces;
+    model.getFaces(points, faces, m_stock->GetResolution());
+
+    std::vector<MeshCore::MeshGeomFacet> facets;
+    facets.reserve(faces.size());
+    for (const auto& face : faces) {
+        MeshCore::MeshGeomFacet facet;
+        uint32_t indices[3] = {face.I1, face.I2, face.I3};
+        for (int i = 0; i < 3; i++) {
+            const Base::Vector3d& pnt = points[indices[i]];
+            facet._aclPoints[i].Set((float)pnt.x, (float)pnt.y, (float)pnt.z);
+        }
+        facets.push_back(facet);
+    }
+    m_stock->GetDeviation(facets, tolerance, deviation);
+}
@@ -27,6 +27,7 @@
 #include <TopoDS_Shape.hxx>
 
 #include <Mod/CAM/App/Command.h>
+#include <Mod/CAM/App/Path.h>
 #include <Mod/Part/App/TopoShape.h>
 #include <Mod/CAM/PathGlobal.h>
 
@@ -51,6 +52,13 @@ public:
     void BeginSimulation(Part::TopoShape* stock, float resolution);
     void SetToolShape(const TopoDS_Shape& toolShape, float resolution);
     Base::Placement* ApplyCommand(Base::Placement* pos, Command* cmd);
+    /// Apply all commands of the path, including drilling cycles, and return the end position
+    Base::Placement ApplyPath(const Base::Placement& pos, const Toolpath& path);
+    /// Compare the simulated stock with the model
+    void GetDeviation(const Part::TopoShape& model, float tolerance, cStockDeviation& deviation);
+
+private:
+    Point3D ApplyMove(const Point3D& fromPos, const Command& cmd);
 
 public:
     std::unique_ptr<cStock> m_stock;
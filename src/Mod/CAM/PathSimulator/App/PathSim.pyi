@@ -47,5 +47,24 @@ class PathSim(BaseClass):
 
                   Apply a single path command on the stock starting from placement."""
         ...
+    def ApplyPath(self, **kwargs) -> Any:
+        """
+        ApplyPath(position, path):
+
+                  Apply all commands of a path, including drilling cycles, on the stock starting
+                  from position and return the end position. Python is not blocked meanwhile."""
+        ...
+
+    def GetDeviation(self, **kwargs) -> Any:
+        """
+        GetDeviation(model, tolerance=0.01):
+
+                  Compare the stock with the top of the model shape. Returns a dict with the
+                  deviation of each stock cell as Field (stock height minus model height, indexed
+                  by x and then y, starting at Origin with cells of size Resolution), and the
+                  count, volume and maximum depth of the gouges (GougeCells, GougeVolume,
+                  MaxGouge) and of the leftover stock (LeftoverCells, LeftoverVolume, MaxLeftover).
+                  Deviations within the tolerance are ignored."""
+        ...
     Tool: Final[Any]
     """Return current simulation tool."""
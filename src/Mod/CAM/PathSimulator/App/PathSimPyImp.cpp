@@ -22,11 +22,13 @@
 
 #include "PreCompiled.h"
 
+#include <Base/Interpreter.h>
 #include <Base/PlacementPy.h>
 #include <Base/PyWrapParseTupleAndKeywords.h>
 
 #include <Mod/Mesh/App/MeshPy.h>
 #include <Mod/CAM/App/CommandPy.h>
+#include <Mod/CAM/App/PathPy.h>
 #include <Mod/Part/App/TopoShapePy.h>
 
 #include "PathSim.h"
@@ -140,6 +142,86 @@ PyObject* PathSimPy::ApplyCommand(PyObject* args, PyObject* kwds)
     return newposPy;
 }
 
+PyObject* PathSimPy::ApplyPath(PyObject* args, PyObject* kwds)
+{
+    static const std::array<const char*, 3> kwlist {"position", "path", nullptr};
+    PyObject* pObjPlace;
+    PyObject* pObjPath;
+    if (!Base::Wrapped_ParseTupleAndKeywords(args,
+                                             kwds,
+                                             "O!O!",
+                                             kwlist,
+                                             &(Base::PlacementPy::Type),
+                                             &pObjPlace,
+                                             &(Path::PathPy::Type),
+                                             &pObjPath)) {
+        return nullptr;
+    }
+    PathSim* sim = getPathSimPtr();
+    if (!sim->m_stock) {
+        PyErr_SetString(PyExc_RuntimeError, "Simulation has no stock object");
+        return nullptr;
+    }
+    Base::Placement* pos = static_cast<Base::PlacementPy*>(pObjPlace)->getPlacementPtr();
+    Path::Toolpath* path = static_cast<Path::PathPy*>(pObjPath)->getToolpathPtr();
+    Base::Placement newpos;
+    {
+        Base::PyGILStateRelease release;
+        newpos = sim->ApplyPath(*pos, *path);
+    }
+    return new Base::PlacementPy(new Base::Placement(newpos));
+}
+
+PyObject* PathSimPy::GetDeviation(PyObject* args, PyObject* kwds)
+{
+    static const std::array<const char*, 3> kwlist {"model", "tolerance", nullptr};
+    PyObject* pObjModel;
+    float tolerance = 0.01F;
+    if (!Base::Wrapped_ParseTupleAndKeywords(args,
+                                             kwds,
+                                             "O!|f",
+                                             kwlist,
+                                             &(Part::TopoShapePy::Type),
+                                             &pObjModel,
+                                             &tolerance)) {
+        return nullptr;
+    }
+    PathSim* sim = getPathSimPtr();
+    cStock* stock = sim->m_stock.get();
+    if (!stock) {
+        PyErr_SetString(PyExc_RuntimeError, "Simulation has no stock object");
+        return nullptr;
+    }
+    const Part::TopoShape* model = static_cast<Part::TopoShapePy*>(pObjModel)->getTopoShapePtr();
+    cStockDeviation deviation;
+    {
+        Base::PyGILStateRelease release;
+        sim->GetDeviation(*model, tolerance, deviation);
+    }
+
+    Py::List field(deviation.sizeX);
+    for (int x = 0; x < deviation.sizeX; x++) {
+        Py::Tuple column(deviation.sizeY);
+        const float* values = &deviation.field[x * deviation.sizeY];
+        for (int y = 0; y < deviation.sizeY; y++) {
+            column.setItem(y, Py::Float(values[y]));
+        }
+        field.setItem(x, column);
+    }
+    Point3D origin = stock->GetPosition();
+    Py::Dict result;
+    result.setItem("Field", field);
+    result.setItem("Origin", Py::TupleN(Py::Float(origin.x), Py::Float(origin.y)));
+    result.setItem("Resolution", Py::Float(stock->GetResolution()));
+    result.setItem("GougeCells", Py::Long(deviation.gougeCells));
+    result.setItem("GougeVolume", Py::Float(deviation.gougeVolume));
+    result.setItem("MaxGouge", Py::Float(deviation.maxGouge));
+    result.setItem("LeftoverCells", Py::Long(deviation.leftoverCells));
+    result.setItem("LeftoverVolume", Py::Float(deviation.leftoverVolume));
+    result.setItem("MaxLeftover", Py::Float(deviation.maxLeftover));
+    return Py::new_reference_to(result);
+}
+
 Py::Object PathSimPy::getTool() const
 {
     // return Py::Object();
@@ -23,6 +23,9 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <cfloat>
+#include <future>
+#include <thread>
 #endif
 
 #include <BRepBndLib.hxx>
@@ -57,6 +60,12 @@ cStock::cStock(float px, float py, float pz, float lx, float ly, float lz, float
             m_attr[x][y] = 0;
         }
     }
+    m_bx0 = m_by0 = 0;
+    m_bx1 = m_x;
+    m_by1 = m_y;
+    m_tilesX = (m_x + SIM_TILE_SIZE - 1) / SIM_TILE_SIZE;
+    m_tilesY = (m_y + SIM_TILE_SIZE - 1) / SIM_TILE_SIZE;
+    m_tiles.resize(m_tilesX * m_tilesY);
 }
 
 cStock::~cStock()
@@ -76,7 +85,7 @@ float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanH
         // sweep right x direction
         if (xr_ok) {
             int tx = xp + x_size;
-            if (tx >= m_x) {
+            if (tx >= m_bx1) {
                 xr_ok = false;
             }
             else {
@@ -95,7 +104,7 @@ float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanH
         // sweep left x direction
         if (xl_ok) {
             int tx = xp - 1;
-            if (tx < 0) {
+            if (tx < m_bx0) {
                 xl_ok = false;
             }
             else {
@@ -115,7 +124,7 @@ float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanH
         // sweep up y direction
         if (yu_ok) {
             int ty = yp + y_size;
-            if (ty >= m_y) {
+            if (ty >= m_by1) {
                 yu_ok = false;
             }
             else {
@@ -134,7 +143,7 @@ float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanH
         // sweep down y direction
         if (yd_ok) {
             int ty = yp - 1;
-            if (ty < 0) {
+            if (ty < m_by0) {
                 yd_ok = false;
             }
             else {
@@ -212,7 +221,7 @@ void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHo
         // sweep right x direction
         if (xr_ok) {
             int tx = xp + x_size;
-            if (tx >= m_x) {
+            if (tx >= m_bx1) {
                 xr_ok = false;
             }
             else {
@@ -231,7 +240,7 @@ void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHo
         // sweep left x direction
         if (xl_ok) {
             int tx = xp - 1;
-            if (tx < 0) {
+            if (tx < m_bx0) {
                 xl_ok = false;
             }
             else {
@@ -251,7 +260,7 @@ void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHo
         // sweep up y direction
         if (yu_ok) {
             int ty = yp + y_size;
-            if (ty >= m_y) {
+            if (ty >= m_by1) {
                 yu_ok = false;
             }
             else {
@@ -270,7 +279,7 @@ void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHo
         // sweep down y direction
         if (yd_ok) {
             int ty = yp - 1;
-            if (ty < 0) {
+            if (ty < m_by0) {
                 yd_ok = false;
             }
             else {
@@ -333,11 +342,11 @@ int cStock::TesselSidesX(int yp)
 {
     float lastz1 = m_pz;
     if (yp < m_y) {
-        lastz1 = std::max(m_stock[0][yp], m_pz);
+        lastz1 = std::max(m_stock[m_bx0][yp], m_pz);
     }
     float lastz2 = m_pz;
     if (yp > 0) {
-        lastz2 = std::max(m_stock[0][yp - 1], m_pz);
+        lastz2 = std::max(m_stock[m_bx0][yp - 1], m_pz);
     }
 
     std::vector<MeshCore::MeshGeomFacet>* facets = &facetsInner;
@@ -346,8 +355,8 @@ int cStock::TesselSidesX(int yp)
     }
 
     // bool lastzclip = (lastz - m_pz) < m_res;
-    int lastpoint = 0;
-    for (int x = 1; x <= m_x; x++) {
+    int lastpoint = m_bx0;
+    for (int x = m_bx0 + 1; x <= m_bx1; x++) {
         float newz1 = m_pz;
         if (yp < m_y && x < m_x) {
             newz1 = std::max(m_stock[x][yp], m_pz);
@@ -358,7 +367,8 @@ int cStock::TesselSidesX(int yp)
         }
 
         if (fabs(lastz1 - lastz2) > m_res) {
-            if (fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res) {
+            // the side is closed at the end of the tile
+            if (x < m_bx1 && fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res) {
                 continue;
             }
             Point3D pbl(lastpoint, yp, lastz1);
@@ -378,11 +388,11 @@ int cStock::TesselSidesY(int xp)
 {
     float lastz1 = m_pz;
     if (xp < m_x) {
-        lastz1 = std::max(m_stock[xp][0], m_pz);
+        lastz1 = std::max(m_stock[xp][m_by0], m_pz);
     }
     float lastz2 = m_pz;
     if (xp > 0) {
-        lastz2 = std::max(m_stock[xp - 1][0], m_pz);
+        lastz2 = std::max(m_stock[xp - 1][m_by0], m_pz);
     }
 
     std::vector<MeshCore::MeshGeomFacet>* facets = &facetsInner;
@@ -391,8 +401,8 @@ int cStock::TesselSidesY(int xp)
     }
 
     // bool lastzclip = (lastz - m_pz) < m_res;
-    int lastpoint = 0;
-    for (int y = 1; y <= m_y; y++) {
+    int lastpoint = m_by0;
+    for (int y = m_by0 + 1; y <= m_by1; y++) {
         float newz1 = m_pz;
         if (xp < m_x && y < m_y) {
             newz1 = std::max(m_stock[xp][y], m_pz);
@@ -403,7 +413,8 @@ int cStock::TesselSidesY(int xp)
         }
 
         if (fabs(lastz1 - lastz2) > m_res) {
-            if (fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res) {
+            // the side is closed at the end of the tile
+            if (y < m_by1 && fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res) {
                 continue;
             }
             Point3D pbr(xp, lastpoint, lastz1);
@@ -448,9 +459,33 @@ void cStock::AddQuad(Point3D& p1,
 
 void cStock::Tessellate(Mesh::MeshObject& meshOuter, Mesh::MeshObject& meshInner)
 {
+    // only the tiles that were cut since the last tessellation are tessellated again
+    std::vector<MeshCore::MeshGeomFacet> outer;
+    std::vector<MeshCore::MeshGeomFacet> inner;
+    for (int ty = 0; ty < m_tilesY; ty++) {
+        for (int tx = 0; tx < m_tilesX; tx++) {
+            cStockTile& tile = m_tiles[ty * m_tilesX + tx];
+            if (tile.dirty) {
+                TessellateTile(tile, tx, ty);
+            }
+            outer.insert(outer.end(), tile.facetsOuter.begin(), tile.facetsOuter.end());
+            inner.insert(inner.end(), tile.facetsInner.begin(), tile.facetsInner.end());
+        }
+    }
+    meshOuter.addFacets(outer);
+    meshInner.addFacets(inner);
+}
+
+void cStock::TessellateTile(cStockTile& tile, int tx, int ty)
+{
+    m_bx0 = tx * SIM_TILE_SIZE;
+    m_by0 = ty * SIM_TILE_SIZE;
+    m_bx1 = std::min(m_bx0 + SIM_TILE_SIZE, m_x);
+    m_by1 = std::min(m_by0 + SIM_TILE_SIZE, m_y);
+
     // reset attribs
-    for (int y = 0; y < m_y; y++) {
-        for (int x = 0; x < m_x; x++) {
+    for (int y = m_by0; y < m_by1; y++) {
+        for (int x = m_bx0; x < m_bx1; x++) {
             m_attr[x][y] = 0;
         }
     }
@@ -458,16 +493,16 @@ void cStock::Tessellate(Mesh::MeshObject& meshOuter, Mesh::MeshObject& meshInner
     facetsOuter.clear();
     facetsInner.clear();
 
-    for (int y = 0; y < m_y; y++) {
-        for (int x = 0; x < m_x; x++) {
+    for (int y = m_by0; y < m_by1; y++) {
+        for (int x = m_bx0; x < m_bx1; x++) {
             int attr = m_attr[x][y];
             if ((attr & SIM_TESSEL_TOP) == 0) {
                 x += TesselTop(x, y);
             }
         }
     }
-    for (int y = 0; y < m_y; y++) {
-        for (int x = 0; x < m_x; x++) {
+    for (int y = m_by0; y < m_by1; y++) {
+        for (int x = m_bx0; x < m_bx1; x++) {
             if ((m_stock[x][y] - m_pz) < m_res) {
                 m_attr[x][y] |= SIM_TESSEL_BOT;
             }
@@ -476,18 +511,79 @@ void cStock::Tessellate(Mesh::MeshObject& meshOuter, Mesh::MeshObject& meshInner
             }
         }
     }
-    for (int y = 0; y <= m_y; y++) {
+
+    // the last tiles also close the far sides of the stock
+    int endY = m_by1 == m_y ? m_y : m_by1 - 1;
+    for (int y = m_by0; y <= endY; y++) {
         TesselSidesX(y);
     }
-    for (int x = 0; x <= m_x; x++) {
+    int endX = m_bx1 == m_x ? m_x : m_bx1 - 1;
+    for (int x = m_bx0; x <= endX; x++) {
         TesselSidesY(x);
     }
-    meshOuter.addFacets(facetsOuter);
-    meshInner.addFacets(facetsInner);
+
+    tile.facetsOuter.swap(facetsOuter);
+    tile.facetsInner.swap(facetsInner);
     facetsOuter.clear();
     facetsInner.clear();
+    tile.dirty = false;
+
+    m_bx0 = m_by0 = 0;
+    m_bx1 = m_x;
+    m_by1 = m_y;
 }
 
+void cStock::MarkDirty(int xs, int xe, int ys, int ye)
+{
+    // the sides between the cells also depend on the cells before them
+    int tx1 = std::max(xs, 0) / SIM_TILE_SIZE;
+    int tx2 = std::min(xe + 1, m_x - 1) / SIM_TILE_SIZE;
+    int ty1 = std::max(ys, 0) / SIM_TILE_SIZE;
+    int ty2 = std::min(ye + 1, m_y - 1) / SIM_TILE_SIZE;
+    for (int ty = ty1; ty <= ty2; ty++) {
+        for (int tx = tx1; tx <= tx2; tx++) {
+            m_tiles[ty * m_tilesX + tx].dirty = true;
+        }
+    }
+}
+
+// Calls run(from, to) for ranges of the columns from xs to xe, which together hold the given
+// number of cells. Large ranges are split into parts that are run in parallel.
+template<class Func>
+void cStock::ParallelColumns(int xs, int xe, int cells, Func run)
+{
+    int numColumns = xe - xs + 1;
+    int numTasks = std::clamp(cells / SIM_PARALLEL_CELLS,
+                              1,
+                              std::max((int)std::thread::hardware_concurrency(), 1));
+    int chunk = (numColumns + numTasks - 1) / numTasks;
+    std::vector<std::future<void>> futures;
+    for (int task = 1; task < numTasks; task++) {
+        int from = xs + task * chunk;
+        int to = std::min(from + chunk, xe + 1);
+        futures.push_back(std::async(std::launch::async, run, from, to));
+    }
+    run(xs, std::min(xs + chunk, xe + 1));
+    for (auto& it : futures) {
+        it.get();
+    }
+}
+
+// Runs the kernel on each stock column from xs to xe, which lowers the cells from ys to ye of
+// the column.
+template<class Kernel>
+void cStock::ApplyColumns(int xs, int xe, int ys, int ye, Kernel kernel)
+{
+    if (xs > xe || ys > ye) {
+        return;
+    }
+    ParallelColumns(xs, xe, (xe - xs + 1) * (ye - ys + 1), [&](int from, int to) {
+        for (int x = from; x < to; x++) {
+            kernel(x, m_stock[x]);
+        }
+    });
+    MarkDirty(xs, xe, ys, ye);
+}
 
 void cStock::CreatePocket(float cxf, float cyf, float radf, float height)
 {
@@ -508,6 +604,7 @@ void cStock::CreatePocket(float cxf, float cyf, float radf, float height)
             }
         }
     }
+    MarkDirty(xs, xe, ys, ye);
 }
 
 void cStock::ApplyLinearTool(Point3D& p1, Point3D& p2, cSimTool& tool)
@@ -517,63 +614,37 @@ void cStock::ApplyLinearTool(Point3D& p1, Point3D& p2, cSimTool& tool)
     Point3D pi2 = ToInner(p2);
     float rad = tool.radius;
     rad /= m_res;
-    float cupAngle = 180;
-
-    // strait motion
-    float perpDirX = 1;
-    float perpDirY = 0;
-    cLineSegment path(pi1, pi2);
-    if (path.lenXY > SIM_EPSILON)  // only if moving along xy
-    {
-        perpDirX = -path.pDirXY.y;
-        perpDirY = path.pDirXY.x;
-        Point3D start(perpDirX * rad + pi1.x, perpDirY * rad + pi1.y, pi1.z);
-        Point3D mainWay = path.pDir * SIM_WALK_RES;
-        Point3D sideWay(-perpDirX * SIM_WALK_RES, -perpDirY * SIM_WALK_RES, 0);
-        int lenSteps = (int)(path.len / SIM_WALK_RES) + 1;
-        int radSteps = (int)(rad * 2 / SIM_WALK_RES) + 1;
-        float zstep = (pi2.z - pi1.z) / radSteps;
-        float tstep = 2.0 / radSteps;
-        float t = -1;
-        for (int j = 0; j < radSteps; j++) {
-            float z = pi1.z + tool.GetToolProfileAt(t);
-            Point3D p = start;
-            for (int i = 0; i < lenSteps; i++) {
-                int x = (int)p.x;
-                int y = (int)p.y;
-                if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                    if (m_stock[x][y] > z) {
-                        m_stock[x][y] = z;
-                    }
-                }
-                p.Add(mainWay);
-                z += zstep;
-            }
-            t += tstep;
-            start.Add(sideWay);
-        }
-    }
-    else {
-        cupAngle = 360;
-    }
-
-    // end cup
-    for (float r = 0.5f; r <= rad; r += (float)SIM_WALK_RES) {
-        Point3D cupCirc(perpDirX * r, perpDirY * r, pi2.z);
-        float rotang = 180 * SIM_WALK_RES / (pi * r);
-        cupCirc.SetRotationAngle(-rotang);
-        float z = pi2.z + tool.GetToolProfileAt(r / rad);
-        for (float a = 0; a < cupAngle; a += rotang) {
-            int x = (int)(pi2.x + cupCirc.x);
-            int y = (int)(pi2.y + cupCirc.y);
-            if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                if (m_stock[x][y] > z) {
-                    m_stock[x][y] = z;
-                }
-            }
-            cupCirc.Rotate();
-        }
-    }
+    if (rad <= 0) {
+        return;
+    }
+
+    // each cell of the swept footprint is lowered to the tool profile at its distance from the
+    // path, at the height of the nearest point on the path
+    float dx = pi2.x - pi1.x;
+    float dy = pi2.y - pi1.y;
+    float dz = pi2.z - pi1.z;
+    float lenSq = dx * dx + dy * dy;
+    float invLenSq = lenSq > SIM_EPSILON ? 1.0f / lenSq : 0.0f;
+    float radSq = rad * rad;
+    float invRad = 1.0f / rad;
+    int xs = std::max(0, (int)std::floor(std::min(pi1.x, pi2.x) - rad));
+    int xe = std::min(m_x - 1, (int)std::floor(std::max(pi1.x, pi2.x) + rad));
+    int ys = std::max(0, (int)std::floor(std::min(pi1.y, pi2.y) - rad));
+    int ye = std::min(m_y - 1, (int)std::floor(std::max(pi1.y, pi2.y) + rad));
+
+    ApplyColumns(xs, xe, ys, ye, [&](int x, float* column) {
+        float cx = (float)x + 0.5f - pi1.x;
+        // the loop has no branches, so that it can be vectorized
+        for (int y = ys; y <= ye; y++) {
+            float cy = (float)y + 0.5f - pi1.y;
+            float t = std::clamp((cx * dx + cy * dy) * invLenSq, 0.0f, 1.0f);
+            float ex = cx - t * dx;
+            float ey = cy - t * dy;
+            float distSq = ex * ex + ey * ey;
+            float z = pi1.z + t * dz + tool.GetToolProfileTable(std::sqrt(distSq) * invRad);
+            column[y] = std::min(column[y], distSq <= radSq ? z : FLT_MAX);
+        }
+    });
 }
 
 void cStock::ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool& tool, bool isCCW)
@@ -584,14 +655,13 @@ void cStock::ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool
     Point3D centi(cent.x / m_res, cent.y / m_res, cent.z);
     float rad = tool.radius;
     rad /= m_res;
+    if (rad <= 0) {
+        return;
+    }
     float cpx = centi.x;
     float cpy = centi.y;
 
-    Point3D xynorm = unit(Point3D(-cpx, -cpy, 0));
     float crad = sqrt(cpx * cpx + cpy * cpy);
-    float crad1 = std::max((float)0.5, crad - rad);
-    float crad2 = crad + rad;
-
     float sang = atan2(-cpy, -cpx);  // start angle
 
     cpx += pi1.x;
@@ -607,56 +677,131 @@ void cStock::ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool
     }
     ang = fabs(ang);
 
-    // apply path
-    Point3D cupCirc;
-    float tstep = (float)SIM_WALK_RES / rad;
-    float t = -1;
-    for (float r = crad1; r <= crad2; r += (float)SIM_WALK_RES) {
-        cupCirc.x = xynorm.x * r;
-        cupCirc.y = xynorm.y * r;
-        float rotang = (float)SIM_WALK_RES / r;
-        int ndivs = (int)(ang / rotang) + 1;
-        if (!isCCW) {
-            rotang = -rotang;
-        }
-        cupCirc.SetRotationAngleRad(rotang);
-        float z = pi1.z + tool.GetToolProfileAt(t);
-        float zstep = (pi2.z - pi1.z) / ndivs;
-        for (int i = 0; i < ndivs; i++) {
-            int x = (int)(cpx + cupCirc.x);
-            int y = (int)(cpy + cupCirc.y);
-            if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                if (m_stock[x][y] > z) {
-                    m_stock[x][y] = z;
-                }
+    // bounds of the arc, including the axis extremes it passes
+    float minX = std::min(pi1.x, pi2.x);
+    float maxX = std::max(pi1.x, pi2.x);
+    float minY = std::min(pi1.y, pi2.y);
+    float maxY = std::max(pi1.y, pi2.y);
+    for (int quadrant = 0; quadrant < 4; quadrant++) {
+        double axisAng = quadrant * pi / 2;
+        double rel = isCCW ? axisAng - sang : sang - axisAng;
+        rel = rel - 2 * pi * std::floor(rel / (2 * pi));
+        if (rel <= ang) {
+            float px = cpx + crad * (float)cos(axisAng);
+            float py = cpy + crad * (float)sin(axisAng);
+            minX = std::min(minX, px);
+            maxX = std::max(maxX, px);
+            minY = std::min(minY, py);
+            maxY = std::max(maxY, py);
+        }
+    }
+    int xs = std::max(0, (int)std::floor(minX - rad));
+    int xe = std::min(m_x - 1, (int)std::floor(maxX + rad));
+    int ys = std::max(0, (int)std::floor(minY - rad));
+    int ye = std::min(m_y - 1, (int)std::floor(maxY + rad));
+
+    // each cell of the swept footprint is lowered to the tool profile at its distance from the
+    // arc, at the height of the nearest point on the arc, or to the tool at the arc ends
+    float dz = pi2.z - pi1.z;
+    float radSq = rad * rad;
+    float invRad = 1.0f / rad;
+    float sweep = (float)ang;
+    float invSweep = sweep > SIM_EPSILON ? 1.0f / sweep : 0.0f;
+    float start = sang;
+    float dir = isCCW ? 1.0f : -1.0f;
+    float twoPi = (float)(2 * pi);
+    ApplyColumns(xs, xe, ys, ye, [&](int x, float* column) {
+        float px = (float)x + 0.5f;
+        for (int y = ys; y <= ye; y++) {
+            float py = (float)y + 0.5f;
+            float vx = px - cpx;
+            float vy = py - cpy;
+            float rel = (std::atan2(vy, vx) - start) * dir;
+            rel -= twoPi * std::floor(rel / twoPi);
+            float distSq;
+            float t;
+            if (rel <= sweep) {
+                float d = std::sqrt(vx * vx + vy * vy) - crad;
+                distSq = d * d;
+                t = rel * invSweep;
+            }
+            else {
+                float d1 = (px - pi1.x) * (px - pi1.x) + (py - pi1.y) * (py - pi1.y);
+                float d2 = (px - pi2.x) * (px - pi2.x) + (py - pi2.y) * (py - pi2.y);
+                distSq = std::min(d1, d2);
+                t = d1 < d2 ? 0.0f : 1.0f;
+            }
+            if (distSq <= radSq) {
+                float z = pi1.z + t * dz + tool.GetToolProfileTable(std::sqrt(distSq) * invRad);
+                column[y] = std::min(column[y], z);
             }
-            z += zstep;
-            cupCirc.Rotate();
-        }
-        t += tstep;
-    }
-
-    // apply end cup
-    xynorm.SetRotationAngleRad(ang);
-    xynorm.Rotate();
-    for (float r = 0.5f; r <= rad; r += (float)SIM_WALK_RES) {
-        Point3D cupCirc(xynorm.x * r, xynorm.y * r, 0);
-        float rotang = (float)SIM_WALK_RES / r;
-        int ndivs = (int)(pi / rotang) + 1;
-        if (!isCCW) {
-            rotang = -rotang;
-        }
-        cupCirc.SetRotationAngleRad(rotang);
-        float z = pi2.z + tool.GetToolProfileAt(r / rad);
-        for (int i = 0; i < ndivs; i++) {
-            int x = (int)(pi2.x + cupCirc.x);
-            int y = (int)(pi2.y + cupCirc.y);
-            if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                if (m_stock[x][y] > z) {
-                    m_stock[x][y] = z;
+        }
+    });
+}
+
+void cStock::GetDeviation(const std::vector<MeshCore::MeshGeomFacet>& model,
+                          float tolerance,
+                          cStockDeviation& deviation)
+{
+    deviation = cStockDeviation();
+    deviation.sizeX = m_x;
+    deviation.sizeY = m_y;
+    std::vector<float>& field = deviation.field;
+
+    // find the top of the model above each cell center, or the stock bottom where there is none
+    field.assign(m_x * m_y, m_pz);
+    ParallelColumns(0, m_x - 1, m_x * m_y, [&](int from, int to) {
+        for (const MeshCore::MeshGeomFacet& facet : model) {
+            Point3D p[3];
+            for (int i = 0; i < 3; i++) {
+                p[i].set((facet._aclPoints[i][0] - m_px) / m_res,
+                         (facet._aclPoints[i][1] - m_py) / m_res,
+                         facet._aclPoints[i][2]);
+            }
+            float area = (p[1].x - p[0].x) * (p[2].y - p[0].y)
+                - (p[2].x - p[0].x) * (p[1].y - p[0].y);
+            if (fabs(area) < SIM_EPSILON) {
+                continue;  // vertical facet
+            }
+            int xs = std::max(from, (int)std::ceil(std::min({p[0].x, p[1].x, p[2].x}) - 0.5f));
+            int xe = std::min(to - 1, (int)std::floor(std::max({p[0].x, p[1].x, p[2].x}) - 0.5f));
+            int ys = std::max(0, (int)std::ceil(std::min({p[0].y, p[1].y, p[2].y}) - 0.5f));
+            int ye = std::min(m_y - 1, (int)std::floor(std::max({p[0].y, p[1].y, p[2].y}) - 0.5f));
+            for (int x = xs; x <= xe; x++) {
+                float* column = &field[x * m_y];
+                float cx = (float)x + 0.5f;
+                for (int y = ys; y <= ye; y++) {
+                    // barycentric coordinates of the cell center
+                    float dx = cx - p[0].x;
+                    float dy = (float)y + 0.5f - p[0].y;
+                    float w1 = (dx * (p[2].y - p[0].y) - (p[2].x - p[0].x) * dy) / area;
+                    float w2 = ((p[1].x - p[0].x) * dy - dx * (p[1].y - p[0].y)) / area;
+                    float w0 = 1.0f - w1 - w2;
+                    if (w0 < -SIM_EPSILON || w1 < -SIM_EPSILON || w2 < -SIM_EPSILON) {
+                        continue;
+                    }
+                    float z = w0 * p[0].z + w1 * p[1].z + w2 * p[2].z;
+                    column[y] = std::max(column[y], z);
                 }
             }
-            cupCirc.Rotate();
+        }
+    });
+
+    float cellArea = m_res * m_res;
+    for (int x = 0; x < m_x; x++) {
+        for (int y = 0; y < m_y; y++) {
+            float& dev = field[x * m_y + y];
+            dev = std::max(m_stock[x][y], m_pz) - dev;
+            if (dev < -tolerance) {
+                deviation.gougeCells++;
+                deviation.gougeVolume -= dev * cellArea;
+                deviation.maxGouge = std::max(deviation.maxGouge, -dev);
+            }
+            else if (dev > tolerance) {
+                deviation.leftoverCells++;
+                deviation.leftoverVolume += dev * cellArea;
+                deviation.maxLeftover = std::max(deviation.maxLeftover, dev);
+            }
         }
     }
 }
@@ -700,7 +845,7 @@ void Point3D::SetRotationAngle(float angle)
     SetRotationAngleRad(angle * 2 * pi / 360);
 }
 
-void Point3D::UpdateCmd(Path::Command& cmd)
+void Point3D::UpdateCmd(const Path::Command& cmd)
 {
     if (cmd.has("X")) {
         x = cmd.getPlacement().getPosition()[0];
@@ -772,6 +917,8 @@ cSimTool::cSimTool(const TopoDS_Shape& toolShape, float res)
         }
     }
 
+    InitProfileTable();
+
     // Report the performance of the profile extraction
     // auto stop = std::chrono::high_resolution_clock::now();
     // auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
@@ -779,6 +926,14 @@ cSimTool::cSimTool(const TopoDS_Shape& toolShape, float res)
     // duration.count() / 1000);
 }
 
+void cSimTool::InitProfileTable()
+{
+    m_profileTable.resize(SIM_PROFILE_SAMPLES);
+    for (int i = 0; i < SIM_PROFILE_SAMPLES; i++) {
+        m_profileTable[i] = GetToolProfileAt((float)i / (SIM_PROFILE_SAMPLES - 1));
+    }
+}
+
 float cSimTool::GetToolProfileAt(
     float pos)  // pos is -1..1 location along the radius of the tool (0 is center)
 {
@@ -25,6 +25,8 @@
 #ifndef PATHSIMULATOR_VolSim_H
 #define PATHSIMULATOR_VolSim_H
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 #include <Mod/Mesh/App/Mesh.h>
@@ -36,6 +38,9 @@
 #define SIM_TESSEL_BOT 2
 #define SIM_WALK_RES                                                                               \
     0.6  // step size in pixel units (to make sure all pixels in the path are visited)
+#define SIM_TILE_SIZE 64  // size of the stock tiles that are tessellated separately
+#define SIM_PROFILE_SAMPLES 256  // size of the tool profile lookup table
+#define SIM_PARALLEL_CELLS 65536  // tool footprint size from which it is applied in parallel
 
 struct toolShapePoint
 {
@@ -99,7 +104,7 @@ struct Point3D
         x = x * cosa - y * sina;
         y = tx * sina + y * cosa;
     }
-    void UpdateCmd(Path::Command& cmd);
+    void UpdateCmd(const Path::Command& cmd);
     void SetRotationAngle(float angle);
     void SetRotationAngleRad(float angle);
     float x, y, z;
@@ -177,11 +182,19 @@ public:
     {}
 
     float GetToolProfileAt(float pos);
+    // pos is 0..1 location along the radius of the tool, looked up in a table
+    inline float GetToolProfileTable(float pos)
+    {
+        int idx = (int)std::ceil(pos * (SIM_PROFILE_SAMPLES - 1));
+        return m_profileTable[std::min(idx, SIM_PROFILE_SAMPLES - 1)];
+    }
     bool isInside(const TopoDS_Shape& toolShape, Base::Vector3d pnt, float res);
+    void InitProfileTable();
 
     /* m_toolShape has to be populated with linearly increased
        radiusPos to get the tool profile at given position */
     std::vector<toolShapePoint> m_toolShape;
+    std::vector<float> m_profileTable;
     float radius;
     float length;
 };
@@ -218,6 +231,21 @@ private:
     int height;
 };
 
+/* Difference between the simulated stock and the model, per stock cell. Cells where the stock is
+   below the model are gouges and cells where it is above are leftover stock. */
+struct cStockDeviation
+{
+    std::vector<float> field;  // stock height minus model height, x major like the stock array
+    int sizeX = 0;
+    int sizeY = 0;
+    int gougeCells = 0;
+    float gougeVolume = 0;
+    float maxGouge = 0;
+    int leftoverCells = 0;
+    float leftoverVolume = 0;
+    float maxLeftover = 0;
+};
+
 class cStock
 {
 public:
@@ -227,12 +255,39 @@ public:
     void CreatePocket(float x, float y, float rad, float height);
     void ApplyLinearTool(Point3D& p1, Point3D& p2, cSimTool& tool);
     void ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool& tool, bool isCCW);
+    /* Compare the stock with the top of the model given as triangles. Deviations within the
+       tolerance are neither counted as gouges nor as leftover stock. */
+    void GetDeviation(const std::vector<MeshCore::MeshGeomFacet>& model,
+                      float tolerance,
+                      cStockDeviation& deviation);
+    float GetResolution() const
+    {
+        return m_res;
+    }
+    /// Position of the corner of the first cell
+    Point3D GetPosition() const
+    {
+        return Point3D(m_px, m_py, m_pz);
+    }
     inline Point3D ToInner(Point3D& p)
     {
         return Point3D((p.x - m_px) / m_res, (p.y - m_py) / m_res, p.z);
     }
 
 private:
+    struct cStockTile
+    {
+        bool dirty = true;
+        std::vector<MeshCore::MeshGeomFacet> facetsOuter;
+        std::vector<MeshCore::MeshGeomFacet> facetsInner;
+    };
+
+    template<class Func>
+    void ParallelColumns(int xs, int xe, int cells, Func run);
+    template<class Kernel>
+    void ApplyColumns(int xs, int xe, int ys, int ye, Kernel kernel);
+    void MarkDirty(int xs, int xe, int ys, int ye);
+    void TessellateTile(cStockTile& tile, int tx, int ty);
     float FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanHoriz);
     void FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHoriz);
     void SetFacetPoints(MeshCore::MeshGeomFacet& facet, Point3D& p1, Point3D& p2, Point3D& p3);
@@ -252,6 +307,10 @@ private:
     float m_res;             // resoulution
     float m_plane;           // stock plane height
     int m_x, m_y;            // stock array size
+    int m_bx0, m_by0;        // bounds of the tile being tessellated
+    int m_bx1, m_by1;
+    int m_tilesX, m_tilesY;  // number of tiles
+    std::vector<cStockTile> m_tiles;
     std::vector<MeshCore::MeshGeomFacet> facetsOuter;
     std::vector<MeshCore::MeshGeomFacet> facetsInner;
 };
@@ -23,6 +23,8 @@
 #include "EndMill.h"
 #include "OpenGlWrapper.h"
 #include "SimShapes.h"
+#include <algorithm>
+#include <cfloat>
 
 using namespace MillSim;
 
@@ -64,6 +66,7 @@ EndMill::EndMill(const std::vector<float>& toolProfile, int toolid, float diamet
     }
 
     MirrorPointBuffer();
+    GenerateBottomProfile();
 }
 
 EndMill::~EndMill()
@@ -117,3 +120,68 @@ void EndMill::MirrorPointBuffer()
         profilePoints[j + 1] = profilePoints[i + 1];
     }
 }
+
+void EndMill::GenerateBottomProfile()
+{
+    float maxRadius = 0;
+    float minRadius = FLT_MAX;
+    float centerHeight = FLT_MAX;
+    for (int i = 0; i < nPoints; i++) {
+        float r = fabsf(profilePoints[i * 2]);
+        maxRadius = std::max(maxRadius, r);
+        if (r < minRadius - 0.0001f) {
+            minRadius = r;
+            centerHeight = profilePoints[i * 2 + 1];
+        }
+        else if (r < minRadius + 0.0001f) {
+            centerHeight = std::min(centerHeight, profilePoints[i * 2 + 1]);
+        }
+    }
+    mBottomProfile.assign(BOTTOM_PROFILE_SIZE, FLT_MAX);
+    if (maxRadius < 0.0001f) {
+        return;
+    }
+
+    // sample the lowest point of the profile at regular distances from the axis
+    mBottomProfileStep = maxRadius / (BOTTOM_PROFILE_SIZE - 1);
+    for (int k = 0; k < BOTTOM_PROFILE_SIZE; k++) {
+        float dist = k * mBottomProfileStep;
+        // the profile ends slightly off the axis, as it was widened
+        if (dist < minRadius) {
+            mBottomProfile[k] = centerHeight;
+        }
+        for (int i = 1; i < nPoints; i++) {
+            float r1 = fabsf(profilePoints[i * 2 - 2]);
+            float z1 = profilePoints[i * 2 - 1];
+            float r2 = fabsf(profilePoints[i * 2]);
+            float z2 = profilePoints[i * 2 + 1];
+            if (dist < std::min(r1, r2) - 0.0001f || dist > std::max(r1, r2) + 0.0001f) {
+                continue;
+            }
+            float z = fabsf(r2 - r1) < 0.0001f ? std::min(z1, z2)
+                                               : z1 + (z2 - z1) * (dist - r1) / (r2 - r1);
+            mBottomProfile[k] = std::min(mBottomProfile[k], z);
+        }
+    }
+}
+
+float EndMill::GetBottomHeight(float distance)
+{
+    if (mBottomProfileStep <= 0) {
+        return FLT_MAX;
+    }
+    float pos = distance / mBottomProfileStep;
+    if (pos > BOTTOM_PROFILE_SIZE - 1) {
+        return FLT_MAX;
+    }
+    int k = (int)pos;
+    if (k == BOTTOM_PROFILE_SIZE - 1) {
+        return mBottomProfile[k];
+    }
+    float z1 = mBottomProfile[k];
+    float z2 = mBottomProfile[k + 1];
+    if (z1 == FLT_MAX || z2 == FLT_MAX) {
+        return std::min(z1, z2);
+    }
+    return z1 + (z2 - z1) * (pos - k);
+}
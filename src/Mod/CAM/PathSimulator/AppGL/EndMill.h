@@ -29,6 +29,7 @@
 #define PROFILE_BUFFER_POINTS(npoints) ((npoints) * 2 - 1)
 #define PROFILE_BUFFER_SIZE(npoints) (PROFILE_BUFFER_POINTS(npoints) * 2)
 #define MILL_HEIGHT 10
+#define BOTTOM_PROFILE_SIZE 65
 
 namespace MillSim
 {
@@ -50,9 +51,17 @@ public:
     virtual ~EndMill();
     void GenerateDisplayLists(float quality);
     unsigned int GenerateArcSegmentDL(float radius, float angleRad, float zShift, Shape* retShape);
+    /// Height of the lower outline of the tool above its tip at the given distance from its
+    /// axis, FLT_MAX beyond the outline
+    float GetBottomHeight(float distance);
 
 protected:
     void MirrorPointBuffer();
+    void GenerateBottomProfile();
+
+protected:
+    std::vector<float> mBottomProfile;
+    float mBottomProfileStep = 0;
 };
 }  // namespace MillSim
 
@@ -0,0 +1,399 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include "HeightMapStock.h"
+#include "GlUtils.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// number of dexels along each side of a tile. Keeps the vertices of a tile within 16 bit indices
+#define TILE_SIZE 64
+// the material a cut must remove to show the cut color
+#define CUT_TOLERANCE 0.001f
+
+using namespace MillSim;
+
+HeightMapStock::HeightMapStock()
+{}
+
+HeightMapStock::~HeightMapStock()
+{
+    Clear();
+}
+
+void HeightMapStock::Clear()
+{
+    mTiles.clear();
+    mTop.clear();
+    mBottom.clear();
+    mInitialTop.clear();
+    mNumX = mNumY = 0;
+    mNumTilesX = mNumTilesY = 0;
+    isValid = false;
+}
+
+void HeightMapStock::InitGrid(float x, float y, float l, float w, float quality)
+{
+    Clear();
+
+    // the finer the quality the more dexels, up to 600 along the longer side of the stock
+    float cellsPerSide = std::clamp(quality * 60.0f, 100.0f, 600.0f);
+    mCellSize = std::max(std::max(l, w) / cellsPerSide, EPSILON);
+    mNumX = std::max((int)ceilf(l / mCellSize), 2);
+    mNumY = std::max((int)ceilf(w / mCellSize), 2);
+    // the dexels are at the centers of the cells
+    mPosX = x + (l - (mNumX - 1) * mCellSize) / 2;
+    mPosY = y + (w - (mNumY - 1) * mCellSize) / 2;
+
+    mTop.assign(mNumX * mNumY, -FLT_MAX);
+    mBottom.assign(mNumX * mNumY, FLT_MAX);
+
+    mNumTilesX = (mNumX - 2) / TILE_SIZE + 1;
+    mNumTilesY = (mNumY - 2) / TILE_SIZE + 1;
+    mTiles = std::vector<Tile>(mNumTilesX * mNumTilesY);
+}
+
+void HeightMapStock::GenerateBoxStock(float x,
+                                      float y,
+                                      float z,
+                                      float l,
+                                      float w,
+                                      float h,
+                                      float quality)
+{
+    InitGrid(x, y, l, w, quality);
+    std::fill(mTop.begin(), mTop.end(), z + h);
+    std::fill(mBottom.begin(), mBottom.end(), z);
+    mInitialTop = mTop;
+    isValid = true;
+}
+
+void HeightMapStock::GenerateFromMesh(std::vector<Vertex>& verts,
+                                      std::vector<GLushort>& indices,
+                                      float quality)
+{
+    if (verts.empty()) {
+        Clear();
+        return;
+    }
+
+    float minX = FLT_MAX, minY = FLT_MAX;
+    float maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (auto& vert : verts) {
+        minX = std::fminf(minX, vert.x);
+        minY = std::fminf(minY, vert.y);
+        maxX = std::fmaxf(maxX, vert.x);
+        maxY = std::fmaxf(maxY, vert.y);
+    }
+    InitGrid(minX, minY, maxX - minX, maxY - minY, quality);
+
+    // rasterize the triangles into the grid, the material of a dexel spans from the lowest to
+    // the highest triangle above it
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const Vertex& v1 = verts[indices[i]];
+        const Vertex& v2 = verts[indices[i + 1]];
+        const Vertex& v3 = verts[indices[i + 2]];
+        float area = (v2.x - v1.x) * (v3.y - v1.y) - (v3.x - v1.x) * (v2.y - v1.y);
+        if (fabsf(area) < EPSILON) {
+            // vertical triangles do not cover any dexel
+            continue;
+        }
+        float fromX = std::fminf(v1.x, std::fminf(v2.x, v3.x));
+        float toX = std::fmaxf(v1.x, std::fmaxf(v2.x, v3.x));
+        float fromY = std::fminf(v1.y, std::fminf(v2.y, v3.y));
+        float toY = std::fmaxf(v1.y, std::fmaxf(v2.y, v3.y));
+        int ix1 = std::max((int)ceilf((fromX - mPosX) / mCellSize), 0);
+        int ix2 = std::min((int)floorf((toX - mPosX) / mCellSize), mNumX - 1);
+        int iy1 = std::max((int)ceilf((fromY - mPosY) / mCellSize), 0);
+        int iy2 = std::min((int)floorf((toY - mPosY) / mCellSize), mNumY - 1);
+        for (int iy = iy1; iy <= iy2; iy++) {
+            float py = mPosY + iy * mCellSize;
+            for (int ix = ix1; ix <= ix2; ix++) {
+                float px = mPosX + ix * mCellSize;
+                // barycentric coordinates of the dexel in the triangle
+                float b2 = ((px - v1.x) * (v3.y - v1.y) - (v3.x - v1.x) * (py - v1.y)) / area;
+                float b3 = ((v2.x - v1.x) * (py - v1.y) - (px - v1.x) * (v2.y - v1.y)) / area;
+                float b1 = 1.0f - b2 - b3;
+                if (b1 < -EPSILON || b2 < -EPSILON || b3 < -EPSILON) {
+                    continue;
+                }
+                float pz = b1 * v1.z + b2 * v2.z + b3 * v3.z;
+                int idx = iy * mNumX + ix;
+                mTop[idx] = std::fmaxf(mTop[idx], pz);
+                mBottom[idx] = std::fminf(mBottom[idx], pz);
+            }
+        }
+    }
+    mInitialTop = mTop;
+    isValid = true;
+}
+
+void HeightMapStock::Reset()
+{
+    if (!isValid) {
+        return;
+    }
+    mTop = mInitialTop;
+    MarkDirty(0, 0, mNumX - 1, mNumY - 1);
+}
+
+void HeightMapStock::Cut(EndMill* tool, vec3 toolPos)
+{
+    if (!isValid) {
+        return;
+    }
+    // the tool profile is slightly wider than the tool itself
+    float radius = tool->radius * 1.05f;
+    int ix1 = std::max((int)ceilf((toolPos[0] - radius - mPosX) / mCellSize), 0);
+    int ix2 = std::min((int)floorf((toolPos[0] + radius - mPosX) / mCellSize), mNumX - 1);
+    int iy1 = std::max((int)ceilf((toolPos[1] - radius - mPosY) / mCellSize), 0);
+    int iy2 = std::min((int)floorf((toolPos[1] + radius - mPosY) / mCellSize), mNumY - 1);
+    if (ix1 > ix2 || iy1 > iy2) {
+        return;
+    }
+
+    bool changed = false;
+    for (int iy = iy1; iy <= iy2; iy++) {
+        float dy = mPosY + iy * mCellSize - toolPos[1];
+        for (int ix = ix1; ix <= ix2; ix++) {
+            int idx = iy * mNumX + ix;
+            if (mTop[idx] <= mBottom[idx]) {
+                continue;
+            }
+            float dx = mPosX + ix * mCellSize - toolPos[0];
+            float height = tool->GetBottomHeight(sqrtf(dx * dx + dy * dy));
+            if (height == FLT_MAX) {
+                continue;
+            }
+            height += toolPos[2];
+            if (height < mTop[idx]) {
+                mTop[idx] = height;
+                changed = true;
+            }
+        }
+    }
+    if (changed) {
+        MarkDirty(ix1, iy1, ix2, iy2);
+    }
+}
+
+void HeightMapStock::MarkDirty(int fromX, int fromY, int toX, int toY)
+{
+    // the normals of a dexel depend on its neighbors, and the dexels on the tile borders are
+    // shared with the neighbor tiles
+    int tx1 = std::max(fromX - 2, 0) / TILE_SIZE;
+    int tx2 = std::min(toX + 1, mNumX - 2) / TILE_SIZE;
+    int ty1 = std::max(fromY - 2, 0) / TILE_SIZE;
+    int ty2 = std::min(toY + 1, mNumY - 2) / TILE_SIZE;
+    for (int ty = ty1; ty <= ty2 && ty < mNumTilesY; ty++) {
+        for (int tx = tx1; tx <= tx2 && tx < mNumTilesX; tx++) {
+            mTiles[ty * mNumTilesX + tx].dirty = true;
+        }
+    }
+}
+
+bool HeightMapStock::IsQuadFilled(int ix, int iy)
+{
+    if (ix < 0 || iy < 0 || ix >= mNumX - 1 || iy >= mNumY - 1) {
+        return false;
+    }
+    return IsFilled(ix, iy) && IsFilled(ix + 1, iy) && IsFilled(ix, iy + 1)
+        && IsFilled(ix + 1, iy + 1);
+}
+
+void HeightMapStock::UpdateTiles()
+{
+    for (int ty = 0; ty < mNumTilesY; ty++) {
+        for (int tx = 0; tx < mNumTilesX; tx++) {
+            if (mTiles[ty * mNumTilesX + tx].dirty) {
+                GenerateTile(tx, ty);
+            }
+        }
+    }
+}
+
+void HeightMapStock::GenerateTile(int tx, int ty)
+{
+    Tile& tile = mTiles[ty * mNumTilesX + tx];
+    tile.dirty = false;
+    tile.stockShape.FreeResources();
+    tile.cutShape.FreeResources();
+    tile.stockShape.numIndices = 0;
+    tile.cutShape.numIndices = 0;
+
+    // the tile has the quads between its dexels, and the last tile in each direction also
+    // has the walls on the far border of the grid
+    int ix1 = tx * TILE_SIZE;
+    int iy1 = ty * TILE_SIZE;
+    int ix2 = std::min(ix1 + TILE_SIZE, mNumX - 1);
+    int iy2 = std::min(iy1 + TILE_SIZE, mNumY - 1);
+    int wallX2 = tx == mNumTilesX - 1 ? ix2 : ix2 - 1;
+    int wallY2 = ty == mNumTilesY - 1 ? iy2 : iy2 - 1;
+    int width = ix2 - ix1 + 1;
+    int nDexels = width * (iy2 - iy1 + 1);
+
+    std::vector<Vertex> vbuffer;
+    std::vector<GLushort> stockIndices;
+    std::vector<GLushort> cutIndices;
+    vbuffer.reserve(nDexels * 2);
+
+    // top and bottom vertices of each dexel
+    for (int iy = iy1; iy <= iy2; iy++) {
+        for (int ix = ix1; ix <= ix2; ix++) {
+            float x = mPosX + ix * mCellSize;
+            float y = mPosY + iy * mCellSize;
+            // normal from the slope to the neighbor dexels
+            int xl = ix > 0 && IsFilled(ix - 1, iy) ? ix - 1 : ix;
+            int xr = ix < mNumX - 1 && IsFilled(ix + 1, iy) ? ix + 1 : ix;
+            int yl = iy > 0 && IsFilled(ix, iy - 1) ? iy - 1 : iy;
+            int yr = iy < mNumY - 1 && IsFilled(ix, iy + 1) ? iy + 1 : iy;
+            float nx = 0, ny = 0;
+            if (xr != xl) {
+                nx = (mTop[iy * mNumX + xl] - mTop[iy * mNumX + xr]) / ((xr - xl) * mCellSize);
+            }
+            if (yr != yl) {
+                ny = (mTop[yl * mNumX + ix] - mTop[yr * mNumX + ix]) / ((yr - yl) * mCellSize);
+            }
+            float len = sqrtf(nx * nx + ny * ny + 1);
+            vbuffer.emplace_back(x, y, mTop[iy * mNumX + ix], nx / len, ny / len, 1 / len);
+        }
+    }
+    for (int iy = iy1; iy <= iy2; iy++) {
+        for (int ix = ix1; ix <= ix2; ix++) {
+            float x = mPosX + ix * mCellSize;
+            float y = mPosY + iy * mCellSize;
+            vbuffer.emplace_back(x, y, mBottom[iy * mNumX + ix], 0, 0, -1);
+        }
+    }
+
+    auto top = [&](int ix, int iy) {
+        return (GLushort)((iy - iy1) * width + ix - ix1);
+    };
+    auto bottom = [&](int ix, int iy) {
+        return (GLushort)(nDexels + (iy - iy1) * width + ix - ix1);
+    };
+    auto addTriangle = [](std::vector<GLushort>& indices, int v1, int v2, int v3) {
+        indices.push_back((GLushort)v1);
+        indices.push_back((GLushort)v2);
+        indices.push_back((GLushort)v3);
+    };
+    auto isCutTop = [&](int ix, int iy) {
+        return mTop[iy * mNumX + ix] < mInitialTop[iy * mNumX + ix] - CUT_TOLERANCE;
+    };
+
+    // top and bottom faces of the quads between the dexels
+    for (int iy = iy1; iy < iy2; iy++) {
+        for (int ix = ix1; ix < ix2; ix++) {
+            if (!IsQuadFilled(ix, iy)) {
+                continue;
+            }
+            bool isCut = isCutTop(ix, iy) || isCutTop(ix + 1, iy) || isCutTop(ix, iy + 1)
+                || isCutTop(ix + 1, iy + 1);
+            std::vector<GLushort>& topIndices = isCut ? cutIndices : stockIndices;
+            GLushort v00 = top(ix, iy), v10 = top(ix + 1, iy);
+            GLushort v01 = top(ix, iy + 1), v11 = top(ix + 1, iy + 1);
+            addTriangle(topIndices, v00, v10, v11);
+            addTriangle(topIndices, v00, v11, v01);
+            v00 = bottom(ix, iy);
+            v10 = bottom(ix + 1, iy);
+            v01 = bottom(ix, iy + 1);
+            v11 = bottom(ix + 1, iy + 1);
+            addTriangle(stockIndices, v00, v11, v10);
+            addTriangle(stockIndices, v00, v01, v11);
+        }
+    }
+
+    // walls along the edges between a filled and an empty quad
+    auto addWall = [&](int ix1, int iy1, int ix2, int iy2, float nx, float ny, bool flip) {
+        GLushort vidx = (GLushort)vbuffer.size();
+        int idx1 = iy1 * mNumX + ix1;
+        int idx2 = iy2 * mNumX + ix2;
+        float x1 = mPosX + ix1 * mCellSize, y1 = mPosY + iy1 * mCellSize;
+        float x2 = mPosX + ix2 * mCellSize, y2 = mPosY + iy2 * mCellSize;
+        vbuffer.emplace_back(x1, y1, mBottom[idx1], nx, ny, 0);
+        vbuffer.emplace_back(x2, y2, mBottom[idx2], nx, ny, 0);
+        vbuffer.emplace_back(x2, y2, mTop[idx2], nx, ny, 0);
+        vbuffer.emplace_back(x1, y1, mTop[idx1], nx, ny, 0);
+        bool isCut = isCutTop(ix1, iy1) || isCutTop(ix2, iy2);
+        std::vector<GLushort>& indices = isCut ? cutIndices : stockIndices;
+        if (flip) {
+            addTriangle(indices, vidx, vidx + 2, vidx + 1);
+            addTriangle(indices, vidx, vidx + 3, vidx + 2);
+        }
+        else {
+            addTriangle(indices, vidx, vidx + 1, vidx + 2);
+            addTriangle(indices, vidx, vidx + 2, vidx + 3);
+        }
+    };
+    for (int iy = iy1; iy < iy2; iy++) {
+        for (int ix = ix1; ix <= wallX2; ix++) {
+            bool left = IsQuadFilled(ix - 1, iy);
+            bool right = IsQuadFilled(ix, iy);
+            if (left != right) {
+                addWall(ix, iy, ix, iy + 1, left ? 1.0f : -1.0f, 0, !left);
+            }
+        }
+    }
+    for (int iy = iy1; iy <= wallY2; iy++) {
+        for (int ix = ix1; ix < ix2; ix++) {
+            bool front = IsQuadFilled(ix, iy - 1);
+            bool back = IsQuadFilled(ix, iy);
+            if (front != back) {
+                addWall(ix, iy, ix + 1, iy, 0, front ? 1.0f : -1.0f, front);
+            }
+        }
+    }
+
+    if (!stockIndices.empty()) {
+        tile.stockShape.SetModelData(vbuffer, stockIndices);
+    }
+    if (!cutIndices.empty()) {
+        tile.cutShape.SetModelData(vbuffer, cutIndices);
+    }
+}
+
+void HeightMapStock::Render()
+{
+    if (!isValid) {
+        return;
+    }
+    UpdateTiles();
+    for (auto& tile : mTiles) {
+        if (tile.stockShape.numIndices > 0) {
+            tile.stockShape.Render(identityMat, identityMat);
+        }
+    }
+}
+
+void HeightMapStock::RenderCuts()
+{
+    if (!isValid) {
+        return;
+    }
+    UpdateTiles();
+    for (auto& tile : mTiles) {
+        if (tile.cutShape.numIndices > 0) {
+            tile.cutShape.Render(identityMat, identityMat);
+        }
+    }
+}
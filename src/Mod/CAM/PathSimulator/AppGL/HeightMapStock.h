@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef __height_map_stock_h__
+#define __height_map_stock_h__
+
+#include "EndMill.h"
+#include "SimShapes.h"
+#include "linmath.h"
+#include <vector>
+
+namespace MillSim
+{
+
+/// <summary>
+/// Stock made of vertical columns of material (dexels) on a regular grid, which the tools cut
+/// from above. The path segments are carved into the grid once as the simulation proceeds, and
+/// the grid is drawn in tiles of which only the changed ones are regenerated. So unlike the CSG
+/// rendering of the swept tool volumes the cost of a frame does not grow with the path length.
+/// </summary>
+class HeightMapStock
+{
+public:
+    HeightMapStock();
+    ~HeightMapStock();
+
+    void GenerateBoxStock(float x, float y, float z, float l, float w, float h, float quality);
+    void GenerateFromMesh(std::vector<Vertex>& verts,
+                          std::vector<GLushort>& indices,
+                          float quality);
+    void Clear();
+    /// Restore the uncut stock
+    void Reset();
+    /// Remove the material below the given tool tip position
+    void Cut(EndMill* tool, vec3 toolPos);
+    /// Render the uncut faces of the stock
+    void Render();
+    /// Render the faces of the stock that were cut
+    void RenderCuts();
+    float GetCellSize()
+    {
+        return mCellSize;
+    }
+
+public:
+    bool isValid = false;
+
+protected:
+    struct Tile
+    {
+        Shape stockShape;
+        Shape cutShape;
+        bool dirty = true;
+    };
+
+    void InitGrid(float x, float y, float l, float w, float quality);
+    void UpdateTiles();
+    void GenerateTile(int tx, int ty);
+    void MarkDirty(int fromX, int fromY, int toX, int toY);
+    bool IsFilled(int ix, int iy)
+    {
+        return mTop[iy * mNumX + ix] > mBottom[iy * mNumX + ix];
+    }
+    bool IsQuadFilled(int ix, int iy);
+
+protected:
+    std::vector<float> mTop;
+    std::vector<float> mBottom;
+    std::vector<float> mInitialTop;
+    std::vector<Tile> mTiles;
+    int mNumX = 0;
+    int mNumY = 0;
+    int mNumTilesX = 0;
+    int mNumTilesY = 0;
+    float mPosX = 0;
+    float mPosY = 0;
+    float mCellSize = 1;
+};
+
+}  // namespace MillSim
+
+#endif
@@ -25,6 +25,7 @@
 #include "SimShapes.h"
 #include "linmath.h"
 #include "GlUtils.h"
+#include "HeightMapStock.h"
 #include <iostream>
 
 constexpr auto pi = std::numbers::pi_v<float>;
@@ -233,6 +234,55 @@ void MillPathSegment::GetHeadPosition(vec3 headPos)
     }
     vec3_dup(headPos, mHeadPos);
 }
+void MillPathSegment::GetPositionAtStep(vec3 pos, float step)
+{
+    if (mMotionType == MTCurved) {
+        // the last step of a large radius arc renders the tool at the end of the arc
+        int nArcSteps = mSmallRad ? numSimSteps : numSimSteps - 1;
+        if (step > nArcSteps) {
+            step = (float)nArcSteps;
+        }
+        float angRad = mStartAngRad - step * mStepAngRad;
+        vec3_set(pos,
+                 -mRadius * sinf(angRad),
+                 mRadius * cosf(angRad),
+                 mDiff[PZ] * step / nArcSteps);
+        vec3_add(pos, pos, mCenter);
+    }
+    else {
+        vec3_dup(pos, mStepLength);
+        vec3_scale(pos, pos, step);
+        vec3_add(pos, pos, mStartPos);
+    }
+}
+
+void MillPathSegment::CarveHeightMap(HeightMapStock& stock, int fromStep, int toStep)
+{
+    if (toStep <= fromStep) {
+        return;
+    }
+    vec3 from, to;
+    GetPositionAtStep(from, (float)fromStep);
+    GetPositionAtStep(to, (float)toStep);
+    float length;
+    if (mMotionType == MTCurved) {
+        length = fabsf((toStep - fromStep) * mStepAngRad) * mRadius + fabsf(to[PZ] - from[PZ]);
+    }
+    else {
+        vec3 diff;
+        vec3_sub(diff, to, from);
+        length = vec3_len(diff);
+    }
+
+    // the tool is placed at about every dexel along the way
+    int nSamples = (int)(length / stock.GetCellSize()) + 1;
+    vec3 pos;
+    for (int i = 0; i <= nSamples; i++) {
+        GetPositionAtStep(pos, fromStep + (float)(toStep - fromStep) * i / nSamples);
+        stock.Cut(endmill, pos);
+    }
+}
+
 float MillPathSegment::SetQuality(float quality, float maxStockDimension)
 {
     mResolution = maxStockDimension * 0.05 / quality;
@@ -32,6 +32,8 @@
 namespace MillSim
 {
 
+class HeightMapStock;
+
 enum MotionType
 {
     MTVertical = 0,
@@ -58,8 +60,13 @@ public:
     virtual void AppendPathPoints(std::vector<MillPathPosition>& pointsBuffer);
     virtual void render(int substep);
     virtual void GetHeadPosition(vec3 headPos);
+    /// Cut the stock along the segment, from one simulation step up to another
+    virtual void CarveHeightMap(HeightMapStock& stock, int fromStep, int toStep);
     static float SetQuality(float quality, float maxStockDimension);  // 1 minimum, 10 maximum
 
+protected:
+    void GetPositionAtStep(vec3 pos, float step);
+
 public:
     EndMill* endmill = nullptr;
     bool isMultyPart;
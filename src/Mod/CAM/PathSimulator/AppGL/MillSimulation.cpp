@@ -57,6 +57,7 @@ void MillSimulation::Clear()
     }
     ClearMillPathSegments();
     mStockObject.~StockObject();
+    mHeightMap.Clear();
     mToolTable.clear();
     guiDisplay.ResetGui();
     simDisplay.CleanGL();
@@ -100,6 +101,10 @@ void MillSimulation::InitSimulation(float quality)
     mNTotalSteps = 0;
     mSimPlaying = false;
     mSimSpeed = 1;
+    mQuality = quality;
+    mHeightMap.Reset();
+    mHeightMapPathStep = 0;
+    mHeightMapSubStep = 0;
     MillPathSegment::SetQuality(quality, simDisplay.maxFar);
     int nOperations = (int)mCodeParser.Operations.size();
     int segId = 0;
@@ -267,12 +272,57 @@ void MillSimulation::CalcSegmentPositions()
     }
 }
 
+bool MillSimulation::UseHeightMap()
+{
+    // the CSG rendering is exact, but its cost grows with the number of simulated steps
+    return mHeightMap.isValid && mNTotalSteps >= HEIGHTMAP_MIN_SIM_STEPS;
+}
+
+void MillSimulation::UpdateHeightMap()
+{
+    if (mPathStep < 0) {
+        return;
+    }
+
+    // going back in the simulation starts over from the uncut stock
+    if (mPathStep < mHeightMapPathStep
+        || (mPathStep == mHeightMapPathStep && mSubStep < mHeightMapSubStep)) {
+        mHeightMap.Reset();
+        mHeightMapPathStep = 0;
+        mHeightMapSubStep = 0;
+    }
+
+    // only the steps that were simulated since the last update are carved
+    for (int i = mHeightMapPathStep; i <= mPathStep; i++) {
+        MillSim::MillPathSegment* p = MillPathSegments.at(i);
+        int fromStep = i == mHeightMapPathStep ? mHeightMapSubStep : 0;
+        int toStep = i == mPathStep ? mSubStep : p->numSimSteps;
+        p->CarveHeightMap(mHeightMap, fromStep, toStep);
+    }
+    mHeightMapPathStep = mPathStep;
+    mHeightMapSubStep = mSubStep;
+}
+
+void MillSimulation::RenderHeightMap()
+{
+    UpdateHeightMap();
+    simDisplay.StartGeometryPass(stockColor, false);
+    mHeightMap.Render();
+    simDisplay.StartGeometryPass(cutColor, false);
+    mHeightMap.RenderCuts();
+}
+
 void MillSimulation::RenderSimulation()
 {
     if ((mViewItems & VIEWITEM_SIMULATION) == 0) {
         return;
     }
 
+    if (UseHeightMap()) {
+        RenderHeightMap();
+        return;
+    }
+
     simDisplay.StartDepthPass();
 
     GlsimStart();
@@ -544,12 +594,18 @@ void MillSimulation::InitDisplay(float quality)
 void MillSimulation::SetBoxStock(float x, float y, float z, float l, float w, float h)
 {
     mStockObject.GenerateBoxStock(x, y, z, l, w, h);
+    mHeightMap.GenerateBoxStock(x, y, z, l, w, h, mQuality);
+    mHeightMapPathStep = 0;
+    mHeightMapSubStep = 0;
     simDisplay.ScaleViewToStock(&mStockObject);
 }
 
 void MillSimulation::SetArbitraryStock(std::vector<Vertex>& verts, std::vector<GLushort>& indices)
 {
     mStockObject.GenerateSolid(verts, indices);
+    mHeightMap.GenerateFromMesh(verts, indices, mQuality);
+    mHeightMapPathStep = 0;
+    mHeightMapSubStep = 0;
     simDisplay.ScaleViewToStock(&mStockObject);
 }
 
@@ -34,6 +34,7 @@
 #include "GuiDisplay.h"
 #include "MillPathLine.h"
 #include "SolidObject.h"
+#include "HeightMapStock.h"
 #include <sstream>
 #include <vector>
 
@@ -41,6 +42,10 @@
 #define VIEWITEM_BASE_SHAPE 2
 #define VIEWITEM_MAX 4
 
+// from this number of steps on the stock is simulated with a height map instead of rendering
+// all the swept tool volumes in each frame
+#define HEIGHTMAP_MIN_SIM_STEPS 5000
+
 namespace MillSim
 {
 
@@ -94,6 +99,9 @@ protected:
     void renderSegmentForward(int iSeg);
     void renderSegmentReversed(int iSeg);
     void CalcSegmentPositions();
+    bool UseHeightMap();
+    void UpdateHeightMap();
+    void RenderHeightMap();
     EndMill* GetTool(int tool);
     void RemoveTool(int toolId);
 
@@ -115,6 +123,7 @@ protected:
 
     StockObject mStockObject;
     SolidObject mBaseShape;
+    HeightMapStock mHeightMap;
 
     vec3 bgndColor = {0.1f, 0.2f, 0.3f};
     vec3 stockColor = {0.5f, 0.55f, 0.9f};
@@ -131,6 +140,10 @@ protected:
     int mDebug1 = 0;
     int mDebug2 = 12;
     int mSimSpeed = 1;
+    // the last simulated position that was carved into the height map
+    int mHeightMapPathStep = 0;
+    int mHeightMapSubStep = 0;
+    float mQuality = 1;
     int mViewItems = VIEWITEM_SIMULATION;
 
     int mLastMouseX = 0, mLastMouseY = 0;
@@ -26,7 +26,10 @@
 #include <cstring>
 #include <ctime>
 #include <algorithm>
+#include <chrono>
+#include <future>
 #include <numbers>
+#include <random>
 
 namespace ClipperLib
 {
@@ -1158,7 +1161,9 @@ public:
 
     double getRandomAngle()
     {
-        return MIN_ANGLE + (MAX_ANGLE - MIN_ANGLE) * double(rand()) / double(RAND_MAX);
+        return MIN_ANGLE
+            + (MAX_ANGLE - MIN_ANGLE) * double(random() - random.min())
+            / double(random.max() - random.min());
     }
     size_t getPointCount()
     {
@@ -1168,6 +1173,8 @@ public:
 private:
     vector<double> angles;
     vector<double> areas;
+    // an own generator per region, so that the results don't depend on the order of the threads
+    std::minstd_rand random;
 };
 
 //***************************************
@@ -1743,6 +1750,8 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths& stockPaths,
     progressCallback = &progressCallbackFn;
     lastProgressTime = clock();
     stopProcessing = false;
+    executeThread = std::this_thread::get_id();
+    pendingProgress.clear();
 
     if (helixRampDiameter < NTOL) {
         helixRampDiameter = 0.75 * toolDiameter;
@@ -1825,6 +1834,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths& stockPaths,
     //***************************************
     //	Resolve hierarchy and run processing
     //***************************************
+    std::vector<Region> regions;
     double cornerRoundingOffset = 0.15 * toolRadiusScaled / 2;
     if (opType == OperationType::otClearingInside || opType == OperationType::otClearingOutside) {
 
@@ -1877,7 +1887,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths& stockPaths,
                 clipof.Clear();
                 clipof.AddPaths(toolBoundPaths, JoinType::jtRound, EndType::etClosedPolygon);
                 clipof.Execute(boundPaths, toolRadiusScaled + finishPassOffsetScaled);
-                ProcessPolyNode(boundPaths, toolBoundPaths);
+                regions.push_back({boundPaths, toolBoundPaths, ++current_region, {}});
             }
         }
     }
@@ -1934,14 +1944,56 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths& stockPaths,
                     clipof.AddPaths(toolBoundPaths, JoinType::jtRound, EndType::etClosedPolygon);
                     clipof.Execute(boundPaths, toolRadiusScaled + finishPassOffsetScaled);
 
-                    ProcessPolyNode(boundPaths, toolBoundPaths);
+                    regions.push_back({boundPaths, toolBoundPaths, ++current_region, {}});
                 }
             }
         }
     }
+    ProcessRegions(regions);
     return results;
 }
 
+void Adaptive2d::ProcessRegions(std::vector<Region>& regions)
+{
+    // the regions don't share any state, so they are cleared concurrently
+#ifdef DEV_MODE
+    size_t threads = 1;  // the performance counters and the drawing aren't thread safe
+#else
+    size_t threads = std::min<size_t>(regions.size(), std::thread::hardware_concurrency());
+#endif
+    if (threads <= 1) {
+        for (auto& region : regions) {
+            ProcessPolyNode(region);
+        }
+    }
+    else {
+        std::atomic<size_t> next = 0;
+        auto work = [this, &regions, &next]() {
+            for (size_t i = next++; i < regions.size(); i = next++) {
+                ProcessPolyNode(regions[i]);
+            }
+        };
+        std::vector<std::future<void>> futures;
+        for (size_t i = 0; i < threads; i++) {
+            futures.push_back(std::async(std::launch::async, work));
+        }
+        // the progress callback may run python code, so it is only called on this thread
+        for (auto& future : futures) {
+            while (future.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready) {
+                ReportPendingProgress();
+            }
+        }
+        ReportPendingProgress();
+        for (auto& future : futures) {
+            future.get();
+        }
+    }
+
+    for (auto& region : regions) {
+        results.splice(results.end(), region.results);
+    }
+}
+
 bool Adaptive2d::FindEntryPoint(TPaths& progressPaths,
                                 const Paths& toolBoundPaths,
                                 const Paths& boundPaths,
@@ -2645,14 +2697,23 @@ void Adaptive2d::AppendToolPath(TPaths& progressPaths,
 
 void Adaptive2d::CheckReportProgress(TPaths& progressPaths, bool force)
 {
-    if (!force && (clock() - lastProgressTime < PROGRESS_TICKS)) {
-        return;  // not yet
-    }
-    lastProgressTime = clock();
-    if (progressPaths.empty()) {
-        return;
+    bool executeThreadReports = std::this_thread::get_id() == executeThread;
+    {
+        std::lock_guard<std::mutex> lock(progressMutex);
+        if (!force && (clock() - lastProgressTime < PROGRESS_TICKS)) {
+            return;  // not yet
+        }
+        lastProgressTime = clock();
+        if (progressPaths.empty()) {
+            return;
+        }
+        if (!executeThreadReports) {
+            pendingProgress.insert(pendingProgress.end(),
+                                   progressPaths.begin(),
+                                   progressPaths.end());
+        }
     }
-    if (progressCallback) {
+    if (executeThreadReports && progressCallback) {
         if ((*progressCallback)(progressPaths)) {
             stopProcessing = true;  // call python function, if returns true signal stop processing
         }
@@ -2674,6 +2735,20 @@ void Adaptive2d::CheckReportProgress(TPaths& progressPaths, bool force)
     progressPaths.front().second.push_back(next);
 }
 
+void Adaptive2d::ReportPendingProgress()
+{
+    TPaths progressPaths;
+    {
+        std::lock_guard<std::mutex> lock(progressMutex);
+        progressPaths.swap(pendingProgress);
+    }
+    if (!progressPaths.empty() && progressCallback) {
+        if ((*progressCallback)(progressPaths)) {
+            stopProcessing = true;
+        }
+    }
+}
+
 void Adaptive2d::AddPathsToProgress(TPaths& progressPaths, Paths paths, MotionType mt)
 {
     for (const auto& pth : paths) {
@@ -2702,11 +2777,15 @@ void Adaptive2d::AddPathToProgress(TPaths& progressPaths, const Path pth, Motion
     }
 }
 
-void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
+void Adaptive2d::ProcessPolyNode(Region& region)
 {
     Perf_ProcessPolyNode.Start();
-    current_region++;
-    cout << "** Processing region: " << current_region << endl;
+    {
+        std::lock_guard<std::mutex> lock(progressMutex);
+        cout << "** Processing region: " << region.index << endl;
+    }
+    Paths& boundPaths = region.boundPaths;
+    Paths& toolBoundPaths = region.toolBoundPaths;
 
     // node paths are already constrained to tool boundary path for adaptive path before finishing
     // pass
@@ -3297,7 +3376,7 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
                  << "Hint: try to modify accuracy and/or step-over." << endl;
         }
     }
-    results.push_back(output);
+    region.results.push_back(output);
 }
 
 }  // namespace AdaptivePath
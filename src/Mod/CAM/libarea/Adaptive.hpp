@@ -21,6 +21,9 @@
  ***************************************************************************/
 
 #include "clipper.hpp"
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <list>
 #include <time.h>
@@ -78,7 +81,7 @@ struct AdaptiveOutput
     int ReturnMotionType;  // MotionType enum, problem with serialization if enum is used
 };
 
-// used to isolate state -> enable potential adding of multi-threaded processing of separate regions
+// used to isolate state -> the separate regions are processed on multiple threads
 
 class Adaptive2d
 {
@@ -106,6 +109,15 @@ public:
 #endif
 
 private:
+    // a separate area that is cleared on its own, its results are collected in order
+    struct Region
+    {
+        Paths boundPaths;
+        Paths toolBoundPaths;
+        int index;
+        std::list<AdaptiveOutput> results;
+    };
+
     std::list<AdaptiveOutput> results;
     Paths inputPaths;
     Paths stockInputPaths;
@@ -117,14 +129,19 @@ private:
     long helixRampRadiusScaled = 0;
     double referenceCutArea = 0;
     double optimalCutAreaPD = 0;
-    bool stopProcessing = false;
+    std::atomic<bool> stopProcessing = false;
     int current_region = 0;
     clock_t lastProgressTime = 0;
 
     std::function<bool(TPaths)>* progressCallback = NULL;
+    // the progress of the worker threads, reported by the thread that runs Execute
+    std::mutex progressMutex;
+    TPaths pendingProgress;
+    std::thread::id executeThread;
     Path toolGeometry;  // tool geometry at coord 0,0, should not be modified
 
-    void ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths);
+    void ProcessRegions(std::vector<Region>& regions);
+    void ProcessPolyNode(Region& region);
     bool FindEntryPoint(TPaths& progressPaths,
                         const Paths& toolBoundPaths,
                         const Paths& bound,
@@ -173,6 +190,7 @@ private:
     friend class EngagePoint;  // for CalcCutArea
 
     void CheckReportProgress(TPaths& progressPaths, bool force = false);
+    void ReportPendingProgress();
     void AddPathsToProgress(TPaths& progressPaths,
                             const Paths paths,
                             MotionType mt = MotionType::mtCutting);
@@ -24,6 +24,12 @@
 
 #include <SMESH_Version.h>
 
+#ifdef FC_USE_VTK
+#include <vtkSMPTools.h>
+#include <vtkVersionMacros.h>
+#endif
+
+#include <App/Application.h>
 #include <Base/Console.h>
 #include <Base/Interpreter.h>
 #include <CXX/Extensions.hxx>
@@ -74,6 +80,28 @@ namespace Fem
 extern PyObject* initModule();
 }
 
+#ifdef FC_USE_VTK
+// the VTK filters of the post-processing distribute their work with vtkSMPTools, which does
+// nothing in parallel with the sequential backend that VTK uses by default
+static void initPostThreads()
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Fem/General");
+    int threads = static_cast<int>(hGrp->GetInt("PostThreads", 0));  // 0 uses all cores
+    if (threads == 1) {
+        return;
+    }
+
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 1, 0)
+    // the thread backend is built by VTK unless it was disabled, then the call does nothing
+    if (std::string(vtkSMPTools::GetBackend()) == "Sequential") {
+        vtkSMPTools::SetBackend("STDThread");
+    }
+#endif
+    vtkSMPTools::Initialize(threads);
+}
+#endif
+
 /* Python entry */
 PyMOD_INIT_FUNC(Fem)
 {
@@ -207,6 +235,8 @@ PyMOD_INIT_FUNC(Fem)
     Fem::PropertyPostDataObject               ::init();
 
     Fem::PostFilterPython                     ::init();
+
+    initPostThreads();
 #endif
     // clang-format on
 
@@ -21,14 +21,20 @@
  ***************************************************************************/
 
 #include <Python.h>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
 #include <cstdlib>
 #include <memory>
+#include <numeric>
+#include <unordered_map>
 
 #include <BRepBndLib.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRep_Tool.hxx>
 #include <Bnd_Box.hxx>
+#include <Precision.hxx>
 #include <SMDS_MeshGroup.hxx>
 #include <SMESHDS_Group.hxx>
 #include <SMESHDS_GroupBase.hxx>
@@ -138,6 +144,7 @@ FemMesh& FemMesh::operator=(const FemMesh& mesh)
 void FemMesh::copyMeshData(const FemMesh& mesh)
 {
     _Mtrx = mesh._Mtrx;
+    resetNodeIndex();
 
     // 1. Get source mesh
     SMESHDS_Mesh* srcMeshDS = mesh.myMesh->GetMeshDS();
@@ -262,6 +269,66 @@ void FemMesh::copyMeshData(const FemMesh& mesh)
     newMeshDS->Modified();
 }
 
+void FemMesh::appendMesh(const FemMesh& mesh)
+{
+    resetNodeIndex();
+
+    SMESHDS_Mesh* srcMeshDS = mesh.myMesh->GetMeshDS();
+    SMESHDS_Mesh* newMeshDS = this->myMesh->GetMeshDS();
+    SMESH_MeshEditor editor(this->myMesh);
+
+    // the nodes get the next free IDs of this mesh, in the order of the source
+    std::unordered_map<int, const SMDS_MeshNode*> nodeMap;
+    nodeMap.reserve(srcMeshDS->NbNodes());
+    SMDS_NodeIteratorPtr srcNodeIt = srcMeshDS->nodesIterator();
+    while (srcNodeIt->more()) {
+        const SMDS_MeshNode* nSrc = srcNodeIt->next();
+        nodeMap[nSrc->GetID()] = newMeshDS->AddNode(nSrc->X(), nSrc->Y(), nSrc->Z());
+    }
+
+    std::vector<const SMDS_MeshNode*> nodes;
+    SMDS_ElemIteratorPtr srcElemIt = srcMeshDS->elementsIterator();
+    while (srcElemIt->more()) {
+        const SMDS_MeshElement* elem = srcElemIt->next();
+        if (elem->GetType() == SMDSAbs_Node) {
+            continue;
+        }
+
+        nodes.resize(elem->NbNodes());
+        SMDS_ElemIteratorPtr nIt = elem->nodesIterator();
+        for (int iN = 0; nIt->more(); ++iN) {
+            nodes[iN] = nodeMap.at(nIt->next()->GetID());
+        }
+
+        switch (elem->GetEntityType()) {
+            case SMDSEntity_Polyhedra:
+#if SMESH_VERSION_MAJOR >= 9
+                newMeshDS->AddPolyhedralVolume(
+                    nodes,
+                    static_cast<const SMDS_MeshVolume*>(elem)->GetQuantities());
+#else
+                newMeshDS->AddPolyhedralVolume(
+                    nodes,
+                    static_cast<const SMDS_VtkVolume*>(elem)->GetQuantities());
+#endif
+                break;
+            case SMDSEntity_Ball: {
+                SMESH_MeshEditor::ElemFeatures elemFeat;
+                elemFeat.Init(static_cast<const SMDS_BallElement*>(elem)->GetDiameter());
+                editor.AddElement(nodes, elemFeat);
+                break;
+            }
+            default: {
+                SMESH_MeshEditor::ElemFeatures elemFeat(elem->GetType(), elem->IsPoly());
+                editor.AddElement(nodes, elemFeat);
+                break;
+            }
+        }
+    }
+
+    newMeshDS->Modified();
+}
+
 const SMESH_Mesh* FemMesh::getSMesh() const
 {
     return myMesh;
@@ -328,6 +395,7 @@ void FemMesh::setStandardHypotheses()
 
 void FemMesh::compute()
 {
+    resetNodeIndex();
     getGenerator()->Compute(*myMesh, myMesh->GetShapeToMesh());
 }
 
@@ -342,7 +410,7 @@ std::set<long> FemMesh::getSurfaceNodes(long /*ElemId*/, short /*FaceId*/, float
 std::list<std::pair<int, int>> FemMesh::getVolumesByFace(const TopoDS_Face& face) const
 {
     std::list<std::pair<int, int>> result;
-    std::set<int> nodes_on_face = getNodesByFace(face);
+    std::vector<int> nodes_on_face = getNodesByFace(face);
 
     // SMDS_MeshVolume::facesIterator() is broken with SMESH7 as it is impossible
     // to iterate volume faces
@@ -410,7 +478,7 @@ std::list<int> FemMesh::getFacesByFace(const TopoDS_Face& face) const
 {
     // TODO: This function is broken with SMESH7 as it is impossible to iterate volume faces
     std::list<int> result;
-    std::set<int> nodes_on_face = getNodesByFace(face);
+    std::vector<int> nodes_on_face = getNodesByFace(face);
 
     SMDS_FaceIteratorPtr face_iter = myMesh->GetMeshDS()->facesIterator();
     while (face_iter->more()) {
@@ -442,7 +510,7 @@ std::list<int> FemMesh::getFacesByFace(const TopoDS_Face& face) const
 std::list<int> FemMesh::getEdgesByEdge(const TopoDS_Edge& edge) const
 {
     std::list<int> result;
-    std::set<int> nodes_on_edge = getNodesByEdge(edge);
+    std::vector<int> nodes_on_edge = getNodesByEdge(edge);
 
     SMDS_EdgeIteratorPtr edge_iter = myMesh->GetMeshDS()->edgesIterator();
     while (edge_iter->more()) {
@@ -477,7 +545,7 @@ std::list<int> FemMesh::getEdgesByEdge(const TopoDS_Edge& edge) const
 std::map<int, int> FemMesh::getccxVolumesByFace(const TopoDS_Face& face) const
 {
     std::map<int, int> result;
-    std::set<int> nodes_on_face = getNodesByFace(face);
+    std::vector<int> nodes_on_face = getNodesByFace(face);
 
     static std::map<int, std::vector<int>> elem_order;
     if (elem_order.empty()) {
@@ -557,200 +625,247 @@ std::map<int, int> FemMesh::getccxVolumesByFace(const TopoDS_Face& face) const
     return result;
 }
 
-std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid& solid) const
+/*!
+ * The nodes of the mesh in absolute space, sorted into the cells of a regular grid so that the
+ * geometric queries only visit the nodes in the cells overlapped by the box of a shape.
+ */
+struct FemMesh::NodeIndex
 {
-    std::set<int> result;
+    NodeIndex(SMESHDS_Mesh* meshDS, const Base::Matrix4D& matrix);
 
-    Bnd_Box box;
-    BRepBndLib::Add(solid, box);
+    bool isValid(int nodes, const Base::Matrix4D& matrix) const
+    {
+        return numNodes == nodes && transform == matrix;
+    }
 
-    // limit where the mesh node belongs to the solid
-    TopAbs_ShapeEnum shapetype = TopAbs_SHAPE;
-    ShapeAnalysis_ShapeTolerance analysis;
-    double limit = analysis.Tolerance(solid, 1, shapetype);
-    Base::Console().log("The limit if a node is in or out: %.12lf in scientific: %.4e \n",
-                        limit,
-                        limit);
+    /// The positions in ids and points of the nodes inside of the box
+    std::vector<std::size_t> inside(const Bnd_Box& box) const;
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
+    std::vector<int> ids;
+    std::vector<gp_Pnt> points;
 
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
+private:
+    std::size_t cellAt(int axis, double value) const
+    {
+        double cell = std::floor((value - origin[axis]) / cellSize);
+        return static_cast<std::size_t>(std::clamp(cell, 0.0, double(cells[axis] - 1)));
+    }
+
+    int numNodes;
+    Base::Matrix4D transform;
+    double origin[3] {};
+    double cellSize {1.0};
+    std::size_t cells[3] {1, 1, 1};
+    // the nodes of cell c are at cellStart[c] to cellStart[c + 1], x varies fastest
+    std::vector<std::size_t> cellStart;
+};
+
+FemMesh::NodeIndex::NodeIndex(SMESHDS_Mesh* meshDS, const Base::Matrix4D& matrix)
+    : numNodes(meshDS->NbNodes())
+    , transform(matrix)
+{
+    std::vector<int> nodeIds;
+    std::vector<gp_Pnt> nodePoints;
+    nodeIds.reserve(numNodes);
+    nodePoints.reserve(numNodes);
+    Bnd_Box bounds;
+    SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
     while (aNodeIter->more()) {
         const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
+        // Apply the matrix to hold the nodes in absolute space.
+        Base::Vector3d vec = matrix * Base::Vector3d(aNode->X(), aNode->Y(), aNode->Z());
+        nodeIds.push_back(aNode->GetID());
+        nodePoints.emplace_back(vec.x, vec.y, vec.z);
+        bounds.Add(nodePoints.back());
+    }
+
+    // about four nodes per cell, the flat directions of planar meshes get a single cell
+    double extent[3] {};
+    if (!bounds.IsVoid()) {
+        double max[3];
+        bounds.Get(origin[0], origin[1], origin[2], max[0], max[1], max[2]);
+        double volume = 1.0;
+        int dimensions = 0;
+        for (int axis = 0; axis < 3; ++axis) {
+            extent[axis] = max[axis] - origin[axis];
+            if (extent[axis] > Precision::Confusion()) {
+                volume *= extent[axis];
+                ++dimensions;
+            }
+        }
+        if (dimensions > 0) {
+            cellSize = std::pow(volume * 4.0 / double(nodeIds.size()), 1.0 / dimensions);
+        }
+    }
+    std::size_t numCells = 1;
+    for (int axis = 0; axis < 3; ++axis) {
+        double count = std::ceil(extent[axis] / cellSize);
+        double maxCount = double(std::max<std::size_t>(nodeIds.size(), 1));
+        cells[axis] = static_cast<std::size_t>(std::clamp(count, 1.0, maxCount));
+        numCells *= cells[axis];
     }
 
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(solid, s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1) {
-                continue;
-            }
+    // sort the nodes by their cell
+    std::vector<std::size_t> cellOfNode(nodeIds.size());
+    cellStart.assign(numCells + 1, 0);
+    for (std::size_t i = 0; i < nodePoints.size(); ++i) {
+        const gp_Pnt& pnt = nodePoints[i];
+        cellOfNode[i] = cellAt(0, pnt.X())
+            + cells[0] * (cellAt(1, pnt.Y()) + cells[1] * cellAt(2, pnt.Z()));
+        ++cellStart[cellOfNode[i] + 1];
+    }
+    std::partial_sum(cellStart.begin(), cellStart.end(), cellStart.begin());
 
-            if (measure.Value() < limit)
-#pragma omp critical
-            {
-                result.insert(aNode->GetID());
+    std::vector<std::size_t> next(cellStart.begin(), cellStart.end() - 1);
+    ids.resize(nodeIds.size());
+    points.resize(nodePoints.size());
+    for (std::size_t i = 0; i < nodeIds.size(); ++i) {
+        std::size_t pos = next[cellOfNode[i]]++;
+        ids[pos] = nodeIds[i];
+        points[pos] = nodePoints[i];
+    }
+}
+
+std::vector<std::size_t> FemMesh::NodeIndex::inside(const Bnd_Box& box) const
+{
+    std::vector<std::size_t> result;
+    if (box.IsVoid() || ids.empty()) {
+        return result;
+    }
+
+    double min[3], max[3];
+    box.Get(min[0], min[1], min[2], max[0], max[1], max[2]);
+    std::size_t first[3], last[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        first[axis] = cellAt(axis, min[axis]);
+        last[axis] = cellAt(axis, max[axis]);
+    }
+
+    for (std::size_t z = first[2]; z <= last[2]; ++z) {
+        for (std::size_t y = first[1]; y <= last[1]; ++y) {
+            std::size_t row = cells[0] * (y + cells[1] * z);
+            for (std::size_t pos = cellStart[row + first[0]]; pos < cellStart[row + last[0] + 1];
+                 ++pos) {
+                if (!box.IsOut(points[pos])) {
+                    result.push_back(pos);
+                }
             }
         }
     }
     return result;
 }
 
-std::set<int> FemMesh::getNodesByFace(const TopoDS_Face& face) const
+std::shared_ptr<const FemMesh::NodeIndex> FemMesh::getNodeIndex() const
 {
-    std::set<int> result;
-
-    Bnd_Box box;
-    BRepBndLib::Add(
-        face,
-        box,
-        Standard_False);  // https://forum.freecad.org/viewtopic.php?f=18&t=21571&start=70#p221591
-    // limit where the mesh node belongs to the face:
-    double limit = BRep_Tool::Tolerance(face);
-    box.Enlarge(limit);
+    std::lock_guard<std::mutex> lock(nodeIndexMutex);
+    SMESHDS_Mesh* meshDS = myMesh->GetMeshDS();
+    if (!nodeIndex || !nodeIndex->isValid(meshDS->NbNodes(), _Mtrx)) {
+        nodeIndex = std::make_shared<const NodeIndex>(meshDS, _Mtrx);
+    }
+    return nodeIndex;
+}
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
+void FemMesh::resetNodeIndex()
+{
+    std::lock_guard<std::mutex> lock(nodeIndexMutex);
+    nodeIndex.reset();
+}
 
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
-    }
+std::vector<int>
+FemMesh::getNodesByShape(const TopoDS_Shape& shape, const Bnd_Box& box, double limit) const
+{
+    std::shared_ptr<const NodeIndex> index = getNodeIndex();
+    const std::vector<std::size_t> candidates = index->inside(box);
 
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(face, s);
+    std::vector<int> result;
+#pragma omp parallel
+    {
+        // the shape is loaded once per thread and not for every node
+        BRepExtrema_DistShapeShape measure;
+        measure.LoadS1(shape);
+        std::vector<int> found;
+
+#pragma omp for schedule(dynamic) nowait
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            std::size_t pos = candidates[i];
+            // measure the distance to a vertex at the node
+            measure.LoadS2(BRepBuilderAPI_MakeVertex(index->points[pos]).Vertex());
             measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1) {
-                continue;
+            if (measure.IsDone() && measure.NbSolution() > 0 && measure.Value() < limit) {
+                found.push_back(index->ids[pos]);
             }
+        }
 
-            if (measure.Value() < limit)
 #pragma omp critical
-            {
-                result.insert(aNode->GetID());
-            }
+        {
+            result.insert(result.end(), found.begin(), found.end());
         }
     }
 
+    std::ranges::sort(result);
     return result;
 }
 
-std::set<int> FemMesh::getNodesByEdge(const TopoDS_Edge& edge) const
+std::vector<int> FemMesh::getNodesBySolid(const TopoDS_Solid& solid) const
 {
-    std::set<int> result;
+    Bnd_Box box;
+    BRepBndLib::Add(solid, box);
+
+    // limit where the mesh node belongs to the solid
+    TopAbs_ShapeEnum shapetype = TopAbs_SHAPE;
+    ShapeAnalysis_ShapeTolerance analysis;
+    double limit = analysis.Tolerance(solid, 1, shapetype);
+    Base::Console().log("The limit if a node is in or out: %.12lf in scientific: %.4e \n",
+                        limit,
+                        limit);
+
+    return getNodesByShape(solid, box, limit);
+}
+
+std::vector<int> FemMesh::getNodesByFace(const TopoDS_Face& face) const
+{
+    Bnd_Box box;
+    BRepBndLib::Add(
+        face,
+        box,
+        Standard_False);  // https://forum.freecad.org/viewtopic.php?f=18&t=21571&start=70#p221591
+    // limit where the mesh node belongs to the face:
+    double limit = BRep_Tool::Tolerance(face);
+    box.Enlarge(limit);
+
+    return getNodesByShape(face, box, limit);
+}
 
+std::vector<int> FemMesh::getNodesByEdge(const TopoDS_Edge& edge) const
+{
     Bnd_Box box;
     BRepBndLib::Add(edge, box);
     // limit where the mesh node belongs to the edge:
     double limit = BRep_Tool::Tolerance(edge);
     box.Enlarge(limit);
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
-    }
-
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(edge, s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1) {
-                continue;
-            }
-
-            if (measure.Value() < limit)
-#pragma omp critical
-            {
-                result.insert(aNode->GetID());
-            }
-        }
-    }
-
-    return result;
+    return getNodesByShape(edge, box, limit);
 }
 
-std::set<int> FemMesh::getNodesByVertex(const TopoDS_Vertex& vertex) const
+std::vector<int> FemMesh::getNodesByVertex(const TopoDS_Vertex& vertex) const
 {
-    std::set<int> result;
+    std::vector<int> result;
 
     double limit = BRep_Tool::Tolerance(vertex);
-    limit *= limit;  // use square to improve speed
     gp_Pnt pnt = BRep_Tool::Pnt(vertex);
-    Base::Vector3d node(pnt.X(), pnt.Y(), pnt.Z());
-
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
-    }
+    Bnd_Box box;
+    box.Add(pnt);
+    box.Enlarge(limit);
 
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        vec = Mtrx * vec;
-
-        if (Base::DistanceP2(node, vec) <= limit)
-#pragma omp critical
-        {
-            result.insert(aNode->GetID());
+    std::shared_ptr<const NodeIndex> index = getNodeIndex();
+    limit *= limit;  // use square to improve speed
+    for (std::size_t pos : index->inside(box)) {
+        if (pnt.SquareDistance(index->points[pos]) <= limit) {
+            result.push_back(index->ids[pos]);
         }
     }
 
+    std::ranges::sort(result);
     return result;
 }
 
@@ -1603,6 +1718,7 @@ void FemMesh::read(const char* FileName)
 {
     Base::FileInfo File(FileName);
     _Mtrx = Base::Matrix4D();
+    resetNodeIndex();
 
     // checking on the file
     if (!File.isReadable()) {
@@ -1656,6 +1772,58 @@ void FemMesh::writeVTK(const std::string& fileName, bool highest) const
 #endif
 }
 
+static void appendNumber(std::string& buffer, int value)
+{
+    char digits[16];
+    auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+    buffer.append(digits, result.ptr);
+}
+
+// https://forum.freecad.org/viewtopic.php?f=18&t=22759#p176669
+// ccx reads only F20.0, so the coordinates are written with 13 significant digits
+static void appendNumber(std::string& buffer, double value)
+{
+    char digits[32];
+    auto result = std::to_chars(std::begin(digits),
+                                std::end(digits),
+                                value,
+                                std::chars_format::general,
+                                13);
+    buffer.append(digits, result.ptr);
+}
+
+/*!
+ * Writes \a count lines to \a out where \a format(i, buffer) appends the line \a i to the
+ * buffer. The lines are formatted in parallel into chunks which are written in their order,
+ * a batch of chunks at a time to keep the memory bounded for big meshes.
+ */
+template<typename Format>
+static void writeLines(std::ostream& out, std::size_t count, Format format)
+{
+    constexpr std::size_t linesPerChunk = 4096;
+    constexpr std::size_t chunksPerBatch = 64;
+    std::vector<std::string> chunks(chunksPerBatch);
+    for (std::size_t start = 0; start < count; start += linesPerChunk * chunksPerBatch) {
+        std::size_t end = std::min(count, start + linesPerChunk * chunksPerBatch);
+        int numChunks = static_cast<int>((end - start + linesPerChunk - 1) / linesPerChunk);
+
+#pragma omp parallel for schedule(dynamic)
+        for (int chunk = 0; chunk < numChunks; ++chunk) {
+            std::string& buffer = chunks[chunk];
+            buffer.clear();
+            std::size_t first = start + chunk * linesPerChunk;
+            std::size_t last = std::min(end, first + linesPerChunk);
+            for (std::size_t i = first; i < last; ++i) {
+                format(i, buffer);
+            }
+        }
+
+        for (int chunk = 0; chunk < numChunks; ++chunk) {
+            out.write(chunks[chunk].data(), static_cast<std::streamsize>(chunks[chunk].size()));
+        }
+    }
+}
+
 void FemMesh::writeABAQUS(const std::string& Filename,
                           int elemParam,
                           bool groupParam,
@@ -1887,20 +2055,23 @@ void FemMesh::writeABAQUS(const std::string& Filename,
 
 
     // get all data --> Extract Nodes and Elements of the current SMESH datastructure
-    using VertexMap = std::map<int, Base::Vector3d>;
-    using NodesMap = std::map<int, std::vector<int>>;
-    using ElementsMap = std::map<std::string, NodesMap>;
+    // the lists are sorted by ID before they are written
+    using VertexList = std::vector<std::pair<int, Base::Vector3d>>;
+    using NodesList = std::vector<std::pair<int, std::vector<int>>>;
+    using ElementsMap = std::map<std::string, NodesList>;
 
     // get nodes
-    VertexMap vertexMap;  // empty nodes map
+    VertexList vertexList;  // empty nodes list
+    vertexList.reserve(myMesh->GetMeshDS()->NbNodes());
     SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
     Base::Vector3d current_node;
     while (aNodeIter->more()) {
         const SMDS_MeshNode* aNode = aNodeIter->next();
         current_node.Set(aNode->X(), aNode->Y(), aNode->Z());
         current_node = _Mtrx * current_node;
-        vertexMap[aNode->GetID()] = current_node;
+        vertexList.emplace_back(aNode->GetID(), current_node);
     }
+    std::ranges::sort(vertexList, {}, &VertexList::value_type::first);
 
     // get volumes
     ElementsMap elementsMapVol;  // empty volumes map
@@ -1916,7 +2087,7 @@ void FemMesh::writeABAQUS(const std::string& Filename,
             for (int jt : order) {
                 apair.second.push_back(aVol->GetNode(jt)->GetID());
             }
-            elementsMapVol[it->second].insert(apair);
+            elementsMapVol[it->second].push_back(std::move(apair));
         }
     }
 
@@ -1938,7 +2109,7 @@ void FemMesh::writeABAQUS(const std::string& Filename,
                 for (int jt : order) {
                     apair.second.push_back(aFace->GetNode(jt)->GetID());
                 }
-                elementsMapFac[it->second].insert(apair);
+                elementsMapFac[it->second].push_back(std::move(apair));
             }
         }
     }
@@ -1956,7 +2127,7 @@ void FemMesh::writeABAQUS(const std::string& Filename,
                 for (int jt : order) {
                     apair.second.push_back(aFace->GetNode(jt)->GetID());
                 }
-                elementsMapFac[it->second].insert(apair);
+                elementsMapFac[it->second].push_back(std::move(apair));
             }
         }
     }
@@ -1979,7 +2150,7 @@ void FemMesh::writeABAQUS(const std::string& Filename,
                 for (int jt : order) {
                     apair.second.push_back(aEdge->GetNode(jt)->GetID());
                 }
-                elementsMapEdg[it->second].insert(apair);
+                elementsMapEdg[it->second].push_back(std::move(apair));
             }
         }
     }
@@ -1997,18 +2168,22 @@ void FemMesh::writeABAQUS(const std::string& Filename,
                 for (int jt : order) {
                     apair.second.push_back(aEdge->GetNode(jt)->GetID());
                 }
-                elementsMapEdg[it->second].insert(apair);
+                elementsMapEdg[it->second].push_back(std::move(apair));
             }
         }
     }
 
+    for (ElementsMap* elementsMap : {&elementsMapVol, &elementsMapFac, &elementsMapEdg}) {
+        for (auto& it : *elementsMap) {
+            std::ranges::sort(it.second, {}, &NodesList::value_type::first);
+        }
+    }
+
     // write all data to file
     // take also care of special characters in path
     // https://forum.freecad.org/viewtopic.php?f=10&t=37436
     Base::FileInfo fi(Filename);
     Base::ofstream anABAQUS_Output(fi);
-    // https://forum.freecad.org/viewtopic.php?f=18&t=22759#p176669
-    anABAQUS_Output.precision(13);
 
     // add some text and make sure one of the known elemParam values is used
     anABAQUS_Output << "** written by FreeCAD inp file writer for CalculiX,Abaqus meshes"
@@ -2047,11 +2222,14 @@ void FemMesh::writeABAQUS(const std::string& Filename,
         case ABAQUS_FaceVariant::Axisymmetric:
         case ABAQUS_FaceVariant::Axisymmetric_Reduced:
             for (const auto& elMap : elementsMapFac) {
-                const NodesMap& nodeMap = elMap.second;
-                for (const auto& nodes : nodeMap) {
+                const NodesList& nodeList = elMap.second;
+                for (const auto& nodes : nodeList) {
                     for (int n : nodes.second) {
-                        Base::Vector3d& vertex = vertexMap[n];
-                        vertex.z = 0.0;
+                        auto vertex = std::ranges::lower_bound(vertexList,
+                                                               n,
+                                                               {},
+                                                               &VertexList::value_type::first);
+                        vertex->second.z = 0.0;
                     }
                 }
             }
@@ -2062,12 +2240,32 @@ void FemMesh::writeABAQUS(const std::string& Filename,
 
     // This way we get sorted output.
     // See https://forum.freecad.org/viewtopic.php?f=18&t=12646&start=40#p103004
-    for (const auto& it : vertexMap) {
-        anABAQUS_Output << it.first << ", " << it.second.x << ", " << it.second.y << ", "
-                        << it.second.z << std::endl;
-    }
+    writeLines(anABAQUS_Output, vertexList.size(), [&vertexList](std::size_t i, std::string& line) {
+        const auto& [id, vertex] = vertexList[i];
+        appendNumber(line, id);
+        line += ", ";
+        appendNumber(line, vertex.x);
+        line += ", ";
+        appendNumber(line, vertex.y);
+        line += ", ";
+        appendNumber(line, vertex.z);
+        line += '\n';
+    });
     anABAQUS_Output << std::endl << std::endl;
-    ;
+
+    // the element ID followed by its nodes
+    auto writeElements = [&anABAQUS_Output](const NodesList& elements) {
+        writeLines(anABAQUS_Output, elements.size(), [&elements](std::size_t i, std::string& line) {
+            const auto& [id, nodes] = elements[i];
+            appendNumber(line, id);
+            // Calculix allows max 16 entries in one line, a hexa20 has more !
+            for (std::size_t ct = 0; ct < nodes.size(); ++ct) {
+                line += ct == 15 ? ",\n" : ", ";
+                appendNumber(line, nodes[ct]);
+            }
+            line += '\n';
+        });
+    };
 
 
     // write volumes to file
@@ -2076,27 +2274,7 @@ void FemMesh::writeABAQUS(const std::string& Filename,
         for (const auto& it : elementsMapVol) {
             anABAQUS_Output << "** Volume elements" << std::endl;
             anABAQUS_Output << "*Element, TYPE=" << it.first << ", ELSET=Evolumes" << std::endl;
-            for (const auto& jt : it.second) {
-                anABAQUS_Output << jt.first;
-                // Calculix allows max 16 entries in one line, a hexa20 has more !
-                int ct = 0;  // counter
-                bool first_line = true;
-                for (auto kt = jt.second.begin(); kt != jt.second.end(); ++kt, ++ct) {
-                    if (ct < 15) {
-                        anABAQUS_Output << ", " << *kt;
-                    }
-                    else {
-                        if (first_line) {
-                            anABAQUS_Output << "," << std::endl << *kt;
-                            first_line = false;
-                        }
-                        else {
-                            anABAQUS_Output << ", " << *kt;
-                        }
-                    }
-                }
-                anABAQUS_Output << std::endl;
-            }
+            writeElements(it.second);
         }
         elsetname += "Evolumes";
         anABAQUS_Output << std::endl;
@@ -2107,13 +2285,7 @@ void FemMesh::writeABAQUS(const std::string& Filename,
         for (const auto& it : elementsMapFac) {
             anABAQUS_Output << "** Face elements" << std::endl;
             anABAQUS_Output << "*Element, TYPE=" << it.first << ", ELSET=Efaces" << std::endl;
-            for (const auto& jt : it.second) {
-                anABAQUS_Output << jt.first;
-                for (int kt : jt.second) {
-                    anABAQUS_Output << ", " << kt;
-                }
-                anABAQUS_Output << std::endl;
-            }
+            writeElements(it.second);
         }
         if (elsetname.empty()) {
             elsetname += "Efaces";
@@ -2129,13 +2301,7 @@ void FemMesh::writeABAQUS(const std::string& Filename,
         for (const auto& it : elementsMapEdg) {
             anABAQUS_Output << "** Edge elements" << std::endl;
             anABAQUS_Output << "*Element, TYPE=" << it.first << ", ELSET=Eedges" << std::endl;
-            for (const auto& jt : it.second) {
-                anABAQUS_Output << jt.first;
-                for (int kt : jt.second) {
-                    anABAQUS_Output << ", " << kt;
-                }
-                anABAQUS_Output << std::endl;
-            }
+            writeElements(it.second);
         }
         if (elsetname.empty()) {
             elsetname += "Eedges";
@@ -2205,15 +2371,18 @@ void FemMesh::writeABAQUS(const std::string& Filename,
             }
 
             // get and write group elements
-            std::set<int> ids;
+            std::vector<int> ids;
             SMDS_ElemIteratorPtr aElemIter = myMesh->GetGroup(it)->GetGroupDS()->GetElements();
             while (aElemIter->more()) {
                 const SMDS_MeshElement* aElement = aElemIter->next();
-                ids.insert(aElement->GetID());
-            }
-            for (int it : ids) {
-                anABAQUS_Output << it << std::endl;
+                ids.push_back(aElement->GetID());
             }
+            std::ranges::sort(ids);
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+            writeLines(anABAQUS_Output, ids.size(), [&ids](std::size_t i, std::string& line) {
+                appendNumber(line, ids[i]);
+                line += '\n';
+            });
 
             // write newline after each group
             anABAQUS_Output << std::endl;
@@ -2410,6 +2579,7 @@ void FemMesh::RestoreDocFile(Base::Reader& reader)
     file.close();
 
     // read the shape from the temp file
+    resetNodeIndex();
     myMesh->UNVToMesh(fi.filePath().c_str());
 
     // delete the temp file
@@ -2428,6 +2598,7 @@ void FemMesh::transformGeometry(const Base::Matrix4D& rclTrf)
         current_node = clMatrix * current_node;
         myMesh->GetMeshDS()->MoveNode(aNode, current_node.x, current_node.y, current_node.z);
     }
+    resetNodeIndex();
 }
 
 void FemMesh::setTransform(const Base::Matrix4D& rclTrf)
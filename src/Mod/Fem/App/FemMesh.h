@@ -25,6 +25,7 @@
 
 #include <list>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <SMDSAbs_ElementType.hxx>
@@ -38,6 +39,7 @@
 class SMESH_Gen;
 class SMESH_Mesh;
 class SMESH_Hypothesis;
+class Bnd_Box;
 class TopoDS_Shape;
 class TopoDS_Face;
 class TopoDS_Edge;
@@ -99,6 +101,8 @@ public:
     SMESH_HypothesisPtr createHypothesis(int hypId);
 
     void compute();
+    /// adds the nodes and elements of \a mesh with new IDs, its groups are not added
+    void appendMesh(const FemMesh& mesh);
 
     // from base class
     unsigned int getMemSize() const override;
@@ -128,14 +132,14 @@ public:
     //@{
     /// retrieving by region growing
     std::set<long> getSurfaceNodes(long ElemId, short FaceId, float Angle = 360) const;
-    /// retrieving by solid
-    std::set<int> getNodesBySolid(const TopoDS_Solid& solid) const;
-    /// retrieving by face
-    std::set<int> getNodesByFace(const TopoDS_Face& face) const;
-    /// retrieving by edge
-    std::set<int> getNodesByEdge(const TopoDS_Edge& edge) const;
-    /// retrieving by vertex
-    std::set<int> getNodesByVertex(const TopoDS_Vertex& vertex) const;
+    /// retrieving by solid, the node IDs are sorted
+    std::vector<int> getNodesBySolid(const TopoDS_Solid& solid) const;
+    /// retrieving by face, the node IDs are sorted
+    std::vector<int> getNodesByFace(const TopoDS_Face& face) const;
+    /// retrieving by edge, the node IDs are sorted
+    std::vector<int> getNodesByEdge(const TopoDS_Edge& edge) const;
+    /// retrieving by vertex, the node IDs are sorted
+    std::vector<int> getNodesByVertex(const TopoDS_Vertex& vertex) const;
     /// retrieving node IDs by element ID
     std::list<int> getElementNodes(int id) const;
     /// retrieving elements IDs by node ID
@@ -220,6 +224,15 @@ private:
     void readZ88(const std::string& Filename);
     void readAbaqus(const std::string& Filename);
 
+    struct NodeIndex;
+    /// The grid of the transformed nodes, built on first use and after the mesh has changed
+    std::shared_ptr<const NodeIndex> getNodeIndex() const;
+    /// Drops the grid of the nodes, to be called when nodes are moved or the mesh is replaced
+    void resetNodeIndex();
+    /// The IDs of the nodes within \a limit of \a shape, the box is checked before the distance
+    std::vector<int>
+    getNodesByShape(const TopoDS_Shape& shape, const Bnd_Box& box, double limit) const;
+
 private:
     /// positioning matrix
     Base::Matrix4D _Mtrx;
@@ -230,6 +243,9 @@ private:
 
     std::list<SMESH_HypothesisPtr> hypoth;
     static SMESH_Gen* _mesh_gen;
+
+    mutable std::shared_ptr<const NodeIndex> nodeIndex;
+    mutable std::mutex nodeIndexMutex;
 };
 
 
@@ -23,8 +23,18 @@
 #include <SMESH_Version.h>
 
 #include <Python.h>
+#include <numeric>
+#include <vector>
+
+#include <BRep_Builder.hxx>
 #include <SMESHDS_Mesh.hxx>
 #include <SMESH_Mesh.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
 
 #ifdef FCWithNetgen
 #include <NETGENPlugin_Hypothesis.hxx>
@@ -73,10 +83,94 @@ FemMeshShapeNetgenObject::FemMeshShapeNetgenObject()
         Prop_None,
         "allows defining the minimum number of mesh segments in which radii will be split");
     ADD_PROPERTY_TYPE(Optimize, (true), "MeshParams", Prop_None, "Optimize the resulting mesh");
+    ADD_PROPERTY_TYPE(SeparateSolids,
+                      (false),
+                      "MeshParams",
+                      Prop_None,
+                      "Mesh the groups of solids that share no faces with other solids one by "
+                      "one and merge their meshes");
 }
 
 FemMeshShapeNetgenObject::~FemMeshShapeNetgenObject() = default;
 
+#ifdef FCWithNetgen
+namespace
+{
+
+void meshShape(const FemMeshShapeNetgenObject& obj, Fem::FemMesh& mesh, const TopoDS_Shape& shape)
+{
+    NETGENPlugin_Mesher myNetGenMesher(mesh.getSMesh(), shape, true);
+#if SMESH_VERSION_MAJOR >= 9
+    NETGENPlugin_Hypothesis* tet = new NETGENPlugin_Hypothesis(0, mesh.getGenerator());
+#else
+    NETGENPlugin_Hypothesis* tet = new NETGENPlugin_Hypothesis(0, 0, mesh.getGenerator());
+#endif
+    tet->SetMaxSize(obj.MaxSize.getValue());
+    tet->SetMinSize(obj.MinSize.getValue());
+    tet->SetSecondOrder(obj.SecondOrder.getValue());
+    tet->SetOptimize(obj.Optimize.getValue());
+    int iFineness = obj.Fineness.getValue();
+    tet->SetFineness((NETGENPlugin_Hypothesis::Fineness)iFineness);
+    if (iFineness == 5) {
+        tet->SetGrowthRate(obj.GrowthRate.getValue());
+        tet->SetNbSegPerEdge(obj.NbSegsPerEdge.getValue());
+        tet->SetNbSegPerRadius(obj.NbSegsPerRadius.getValue());
+    }
+    myNetGenMesher.SetParameters(tet);
+    mesh.getSMesh()->ShapeToMesh(shape);
+
+    myNetGenMesher.Compute();
+}
+
+// The groups of solids that are connected by shared faces, the meshes of different groups
+// have no common nodes. Empty if the shape has faces or edges outside of its solids.
+std::vector<TopoDS_Shape> independentSolids(const TopoDS_Shape& shape)
+{
+    if (TopExp_Explorer(shape, TopAbs_FACE, TopAbs_SOLID).More()
+        || TopExp_Explorer(shape, TopAbs_EDGE, TopAbs_FACE).More()) {
+        return {};
+    }
+
+    TopTools_IndexedMapOfShape solids;
+    TopExp::MapShapes(shape, TopAbs_SOLID, solids);
+    TopTools_IndexedDataMapOfShapeListOfShape faceSolids;
+    TopExp::MapShapesAndAncestors(shape, TopAbs_FACE, TopAbs_SOLID, faceSolids);
+
+    std::vector<int> parent(solids.Extent());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](int i) {
+        while (parent[i] != i) {
+            i = parent[i] = parent[parent[i]];
+        }
+        return i;
+    };
+    for (int i = 1; i <= faceSolids.Extent(); ++i) {
+        const TopTools_ListOfShape& ancestors = faceSolids(i);
+        int first = find(solids.FindIndex(ancestors.First()) - 1);
+        for (const TopoDS_Shape& solid : ancestors) {
+            parent[find(solids.FindIndex(solid) - 1)] = first;
+        }
+    }
+
+    std::vector<TopoDS_Shape> groups;
+    std::vector<int> groupOf(solids.Extent(), -1);
+    BRep_Builder builder;
+    for (int i = 0; i < solids.Extent(); ++i) {
+        int& group = groupOf[find(i)];
+        if (group < 0) {
+            group = static_cast<int>(groups.size());
+            TopoDS_Compound compound;
+            builder.MakeCompound(compound);
+            groups.push_back(compound);
+        }
+        builder.Add(groups[group], solids(i + 1));
+    }
+    return groups;
+}
+
+}  // namespace
+#endif
+
 App::DocumentObjectExecReturn* FemMeshShapeNetgenObject::execute()
 {
 #ifdef FCWithNetgen
@@ -90,27 +184,24 @@ App::DocumentObjectExecReturn* FemMeshShapeNetgenObject::execute()
 
     TopoDS_Shape shape = feat->Shape.getValue();
 
-    NETGENPlugin_Mesher myNetGenMesher(newMesh.getSMesh(), shape, true);
-#if SMESH_VERSION_MAJOR >= 9
-    NETGENPlugin_Hypothesis* tet = new NETGENPlugin_Hypothesis(0, newMesh.getGenerator());
-#else
-    NETGENPlugin_Hypothesis* tet = new NETGENPlugin_Hypothesis(0, 0, newMesh.getGenerator());
-#endif
-    tet->SetMaxSize(MaxSize.getValue());
-    tet->SetMinSize(MinSize.getValue());
-    tet->SetSecondOrder(SecondOrder.getValue());
-    tet->SetOptimize(Optimize.getValue());
-    int iFineness = Fineness.getValue();
-    tet->SetFineness((NETGENPlugin_Hypothesis::Fineness)iFineness);
-    if (iFineness == 5) {
-        tet->SetGrowthRate(GrowthRate.getValue());
-        tet->SetNbSegPerEdge(NbSegsPerEdge.getValue());
-        tet->SetNbSegPerRadius(NbSegsPerRadius.getValue());
+    std::vector<TopoDS_Shape> groups;
+    if (SeparateSolids.getValue()) {
+        groups = independentSolids(shape);
     }
-    myNetGenMesher.SetParameters(tet);
-    newMesh.getSMesh()->ShapeToMesh(shape);
 
-    myNetGenMesher.Compute();
+    if (groups.size() > 1) {
+        // Netgen keeps its parameters in global variables and all meshes share the generator,
+        // so the groups are meshed one after the other
+        newMesh.getSMesh()->ShapeToMesh(shape);
+        for (const TopoDS_Shape& group : groups) {
+            Fem::FemMesh groupMesh;
+            meshShape(*this, groupMesh, group);
+            newMesh.appendMesh(groupMesh);
+        }
+    }
+    else {
+        meshShape(*this, newMesh, shape);
+    }
 
     SMESHDS_Mesh* data = const_cast<SMESH_Mesh*>(newMesh.getSMesh())->GetMeshDS();
     const SMDS_MeshInfo& info = data->GetMeshInfo();
@@ -0,0 +1,161 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association <www.freecad.org>      *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <chrono>
+
+#include <Base/Console.h>
+#include <Base/Exception.h>
+
+#include "FemPostFrameCache.h"
+
+
+using namespace Fem;
+
+FemPostFrameCache::FemPostFrameCache(std::vector<std::string> files,
+                                     std::size_t budget,
+                                     Loader loader)
+    : m_files(std::move(files))
+    , m_budget(budget)
+    , m_loader(std::move(loader))
+{}
+
+FemPostFrameCache::~FemPostFrameCache()
+{
+    // the background reads use this cache
+    std::map<std::size_t, std::shared_future<void>> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pending = m_pending;
+    }
+    for (auto& it : pending) {
+        it.second.wait();
+    }
+}
+
+vtkSmartPointer<vtkDataObject> FemPostFrameCache::frame(std::size_t idx)
+{
+    if (idx >= m_files.size()) {
+        return {};
+    }
+
+    std::shared_future<void> reading;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_active = idx;
+        auto it = m_frames.find(idx);
+        if (it != m_frames.end()) {
+            m_used.splice(m_used.begin(), m_used, it->second.used);
+        }
+        else if (auto jt = m_pending.find(idx); jt != m_pending.end()) {
+            reading = jt->second;
+        }
+    }
+
+    if (reading.valid()) {
+        reading.wait();
+    }
+
+    vtkSmartPointer<vtkDataObject> data;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_frames.find(idx);
+        if (it != m_frames.end()) {
+            data = it->second.data;
+        }
+    }
+
+    if (!data) {
+        data = m_loader(m_files[idx]);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        insert(idx, data);
+    }
+
+    if (idx > 0) {
+        prefetch(idx - 1);
+    }
+    prefetch(idx + 1);
+
+    return data;
+}
+
+void FemPostFrameCache::prefetch(std::size_t idx)
+{
+    if (idx >= m_files.size()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // drop the finished reads, their frames are in memory already
+    std::erase_if(m_pending, [](const auto& it) {
+        return it.second.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+    if (m_frames.contains(idx) || m_pending.contains(idx)) {
+        return;
+    }
+
+    auto read = [this, idx]() {
+        vtkSmartPointer<vtkDataObject> data;
+        try {
+            data = m_loader(m_files[idx]);
+        }
+        catch (const Base::Exception& e) {
+            Base::Console().warning("Reading frame %s failed: %s\n",
+                                    m_files[idx].c_str(),
+                                    e.what());
+        }
+
+        if (data) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            insert(idx, data);
+        }
+    };
+    m_pending[idx] = std::async(std::launch::async, read).share();
+}
+
+void FemPostFrameCache::insert(std::size_t idx, vtkSmartPointer<vtkDataObject> data)
+{
+    if (m_frames.contains(idx)) {
+        return;
+    }
+
+    m_used.push_front(idx);
+    std::size_t size = data->GetActualMemorySize();
+    m_frames[idx] = Entry {data, size, m_used.begin()};
+    m_memory += size;
+    evict();
+}
+
+void FemPostFrameCache::evict()
+{
+    // the least recently used frames go first, but never the active one
+    auto it = m_used.end();
+    while (m_memory > m_budget && it != m_used.begin()) {
+        --it;
+        if (*it == m_active) {
+            continue;
+        }
+        auto entry = m_frames.find(*it);
+        m_memory -= entry->second.size;
+        m_frames.erase(entry);
+        it = m_used.erase(it);
+    }
+}
@@ -0,0 +1,98 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association <www.freecad.org>      *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef Fem_FemPostFrameCache_H
+#define Fem_FemPostFrameCache_H
+
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <vtkDataObject.h>
+#include <vtkSmartPointer.h>
+
+
+namespace Fem
+{
+
+/** The frames of a pipeline which are kept in their result files.
+ * A frame is read when it is asked for. The neighbouring frames are read in the background,
+ * and the least recently used frames are dropped when the frames in memory exceed the budget.
+ */
+class FemPostFrameCache
+{
+public:
+    using Loader = std::function<vtkSmartPointer<vtkDataObject>(const std::string&)>;
+
+    /// \a budget is the memory in KiB for the frames, the active frame is always kept
+    FemPostFrameCache(std::vector<std::string> files, std::size_t budget, Loader loader);
+    ~FemPostFrameCache();
+
+    FemPostFrameCache(const FemPostFrameCache&) = delete;
+    FemPostFrameCache& operator=(const FemPostFrameCache&) = delete;
+
+    std::size_t size() const
+    {
+        return m_files.size();
+    }
+    const std::vector<std::string>& files() const
+    {
+        return m_files;
+    }
+
+    /// the data of frame \a idx, read now if it isn't in memory, and starts reading its neighbours
+    vtkSmartPointer<vtkDataObject> frame(std::size_t idx);
+
+private:
+    struct Entry
+    {
+        vtkSmartPointer<vtkDataObject> data;
+        std::size_t size;
+        std::list<std::size_t>::iterator used;
+    };
+
+    void prefetch(std::size_t idx);
+    // the caller holds the mutex
+    void insert(std::size_t idx, vtkSmartPointer<vtkDataObject> data);
+    void evict();
+
+    std::vector<std::string> m_files;
+    std::size_t m_budget;
+    Loader m_loader;
+
+    std::mutex m_mutex;
+    std::map<std::size_t, Entry> m_frames;
+    // the frames in memory, the most recently used first
+    std::list<std::size_t> m_used;
+    std::size_t m_memory = 0;
+    std::size_t m_active = 0;
+    std::map<std::size_t, std::shared_future<void>> m_pending;
+};
+
+}  // namespace Fem
+
+
+#endif  // Fem_FemPostFrameCache_H
@@ -20,6 +20,7 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
 #include <cmath>
 
 #include <Python.h>
@@ -44,11 +45,13 @@
 #include <vtkInformation.h>
 #include <vtkInformationVector.h>
 
+#include <App/Application.h>
 #include <Base/Console.h>
 
 #include "FemMesh.h"
 #include "FemMeshObject.h"
 #include "FemPostFilter.h"
+#include "FemPostFrameCache.h"
 #include "FemPostPipeline.h"
 #include "FemPostPipelinePy.h"
 #include "FemVTKTools.h"
@@ -78,6 +81,12 @@ void FemFrameSourceAlgorithm::setDataObject(vtkSmartPointer<vtkDataObject> data)
     Update();
 }
 
+void FemFrameSourceAlgorithm::setFrameCache(std::shared_ptr<FemPostFrameCache> frames)
+{
+    m_frames = frames;
+    Modified();
+}
+
 bool FemFrameSourceAlgorithm::isValid()
 {
     return m_data.GetPointer() != nullptr;
@@ -193,6 +202,27 @@ int FemFrameSourceAlgorithm::RequestData(vtkInformation*,
     }
 
     auto block = multiblock->GetBlock(idx);
+    if (m_frames && m_frames->size() == multiblock->GetNumberOfBlocks()) {
+        // the block only holds the frame information, the data is in the file of the frame
+        vtkSmartPointer<vtkDataObject> data;
+        try {
+            data = m_frames->frame(idx);
+        }
+        catch (const Base::Exception& e) {
+            Base::Console().error("Reading frame %s failed: %s\n",
+                                  m_frames->files()[idx].c_str(),
+                                  e.what());
+        }
+        if (data) {
+            output->ShallowCopy(data);
+            vtkFieldData* info = block->GetFieldData();
+            for (int i = 0; i < info->GetNumberOfArrays(); ++i) {
+                output->GetFieldData()->AddArray(info->GetAbstractArray(i));
+            }
+            return 1;
+        }
+    }
+
     output->ShallowCopy(block);
     return 1;
 }
@@ -210,6 +240,13 @@ FemPostPipeline::FemPostPipeline()
                       App::Prop_None,
                       "The frame used to calculate the data in the pipeline processing (read only, "
                       "set via pipeline object).");
+    ADD_PROPERTY_TYPE(FrameFiles,
+                      (),
+                      "Pipeline",
+                      App::PropertyType(App::Prop_ReadOnly | App::Prop_Output),
+                      "The result files of the frames which are read on demand. The files are not "
+                      "saved with the document, and scaling or renaming arrays does not change "
+                      "them.");
 
     // create our source algorithm
     m_source_algorithm = vtkSmartPointer<FemFrameSourceAlgorithm>::New();
@@ -303,6 +340,18 @@ vtkSmartPointer<vtkDataObject> FemPostPipeline::dataObjectFromFile(Base::FileInf
 void FemPostPipeline::read(Base::FileInfo File)
 {
     Data.setValue(dataObjectFromFile(File));
+    if (!FrameFiles.getValues().empty()) {
+        FrameFiles.setValues({});
+    }
+}
+
+// the memory in KiB for the frames of a pipeline, results bigger than that are read on demand
+static std::size_t frameMemoryBudget()
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Fem/General");
+    long budget = hGrp->GetInt("FrameMemoryBudget", 0);  // in MB, 0 keeps all frames in memory
+    return static_cast<std::size_t>(std::max(budget, 0L)) * 1024;
 }
 
 void FemPostPipeline::read(std::vector<Base::FileInfo>& files,
@@ -334,6 +383,16 @@ void FemPostPipeline::read(std::vector<Base::FileInfo>& files,
     TimeInfo->InsertNextValue(frame_type);
     TimeInfo->InsertNextValue(unit.getString());
 
+    // files bigger than the budget stay on disk, only their frame information is kept in the
+    // data and the frames are read when the pipeline asks for them
+    std::size_t budget = frameMemoryBudget();
+    std::size_t fileSize = 0;
+    for (const auto& File : files) {
+        fileSize += File.size() / 1024;
+    }
+    bool onDemand = budget > 0 && fileSize > budget;
+    std::vector<std::string> frameFiles;
+
     auto multiblock = vtkSmartPointer<vtkMultiBlockDataSet>::New();
     for (ulong i = 0; i < files.size(); i++) {
 
@@ -350,7 +409,14 @@ void FemPostPipeline::read(std::vector<Base::FileInfo>& files,
             throw Base::FileException("File to load not existing or not readable", File);
         }
 
-        auto data = dataObjectFromFile(File);
+        vtkSmartPointer<vtkDataObject> data;
+        if (onDemand) {
+            data = vtkSmartPointer<vtkUnstructuredGrid>::New();
+            frameFiles.push_back(File.filePath());
+        }
+        else {
+            data = dataObjectFromFile(File);
+        }
         data->GetFieldData()->AddArray(TimeValue);
         data->GetFieldData()->AddArray(TimeInfo);
 
@@ -359,6 +425,23 @@ void FemPostPipeline::read(std::vector<Base::FileInfo>& files,
 
     multiblock->GetFieldData()->AddArray(TimeInfo);
     Data.setValue(multiblock);
+    if (FrameFiles.getValues() != frameFiles) {
+        FrameFiles.setValues(frameFiles);
+    }
+}
+
+void FemPostPipeline::updateFrameCache()
+{
+    std::shared_ptr<FemPostFrameCache> frames;
+    if (!FrameFiles.getValues().empty()) {
+        frames = std::make_shared<FemPostFrameCache>(FrameFiles.getValues(),
+                                                     frameMemoryBudget(),
+                                                     [](const std::string& file) {
+                                                         return dataObjectFromFile(
+                                                             Base::FileInfo(file));
+                                                     });
+    }
+    m_source_algorithm->setFrameCache(frames);
 }
 
 void FemPostPipeline::scale(double s)
@@ -461,6 +544,16 @@ void FemPostPipeline::onChanged(const Property* prop)
         recomputeChildren();
     }
 
+    // the frames are read from other files now
+    if (prop == &FrameFiles) {
+        updateFrameCache();
+        if (Data.getValue()) {
+            m_transform_filter->Update();
+            updateData();
+            recomputeChildren();
+        }
+    }
+
     if (prop == &Frame && !m_block_property) {
 
         // Update all children with the new frame
@@ -648,6 +741,9 @@ void FemPostPipeline::load(FemResultObject* res)
     FemVTKTools::exportFreeCADResult(res, grid);
 
     Data.setValue(grid);
+    if (!FrameFiles.getValues().empty()) {
+        FrameFiles.setValues({});
+    }
 }
 
 // set multiple result objects as frames for one pipeline
@@ -711,6 +807,9 @@ void FemPostPipeline::load(std::vector<FemResultObject*>& res,
 
     multiblock->GetFieldData()->AddArray(TimeInfo);
     Data.setValue(multiblock);
+    if (!FrameFiles.getValues().empty()) {
+        FrameFiles.setValues({});
+    }
 }
 
 void FemPostPipeline::handleChangedPropertyName(Base::XMLReader& reader,
@@ -23,6 +23,8 @@
 #ifndef Fem_FemPostPipeline_H
 #define Fem_FemPostPipeline_H
 
+#include <memory>
+
 #include "Base/Unit.h"
 #include "FemPostGroupExtension.h"
 
@@ -41,6 +43,8 @@ class vtkInformationVector;
 namespace Fem
 {
 
+class FemPostFrameCache;
+
 // algorithm that allows multi frame handling: if data is stored in MultiBlock dataset
 // this source enables the downstream filters to query the blocks as different time frames
 class FemFrameSourceAlgorithm: public vtkUnstructuredGridAlgorithm
@@ -51,6 +55,8 @@ public:
 
     bool isValid();
     void setDataObject(vtkSmartPointer<vtkDataObject> data);
+    /// the frames of the data are read from the files of the cache, if it has one for each block
+    void setFrameCache(std::shared_ptr<FemPostFrameCache> frames);
     std::vector<double> getFrameValues();
 
 protected:
@@ -58,6 +64,7 @@ protected:
     ~FemFrameSourceAlgorithm() override;
 
     vtkSmartPointer<vtkDataObject> m_data;
+    std::shared_ptr<FemPostFrameCache> m_frames;
 
     int RequestInformation(vtkInformation* reqInfo,
                            vtkInformationVector** inVector,
@@ -77,6 +84,7 @@ public:
     FemPostPipeline();
 
     App::PropertyEnumeration Frame;
+    App::PropertyStringList FrameFiles;
 
 
     virtual vtkDataSet* getDataSet() override;
@@ -141,10 +149,11 @@ private:
     bool m_block_property = false;
     bool m_data_updated = false;
     void updateData();
+    void updateFrameCache();
 
 
     template<class TReader>
-    vtkSmartPointer<vtkDataObject> readXMLFile(std::string file)
+    static vtkSmartPointer<vtkDataObject> readXMLFile(std::string file)
     {
 
         vtkSmartPointer<TReader> reader = vtkSmartPointer<TReader>::New();
@@ -152,7 +161,7 @@ private:
         reader->Update();
         return reader->GetOutput();
     }
-    vtkSmartPointer<vtkDataObject> dataObjectFromFile(Base::FileInfo File);
+    static vtkSmartPointer<vtkDataObject> dataObjectFromFile(Base::FileInfo File);
 };
 
 }  // namespace Fem
@@ -23,11 +23,13 @@
 
 
 #include <Python.h>
+#include <algorithm>
 #include <charconv>
 #include <cmath>
 #include <cstdlib>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 #include <SMESHDS_Mesh.hxx>
 #include <SMESH_Mesh.hxx>
@@ -1118,97 +1120,115 @@ size_t getFirstNotBlankPos(const std::string_view& view)
     return pos;
 }
 
-// get n-digits value from string_view
-// not used until libc++ std::from_chars supports double values
-// template<typename T>
-// void valueFromLine(const std::string_view::const_iterator& it, int digits, T& value)
-//{
-//    std::string_view sub(it, digits);
-//    auto pos = getFirstNotBlankPos(sub);
-//    std::from_chars(sub.data() + pos, sub.data() + digits, value, 10);
-//}
+// get n-digits value from string_view, the value ends at the field width
 template<typename T>
 void valueFromLine(const std::string_view::iterator& it, int digits, T& value)
 {
     std::string_view sub(&*it, digits);
-    value = std::strtol(sub.data(), nullptr, 10);
+    auto pos = getFirstNotBlankPos(sub);
+    value = 0;
+    std::from_chars(sub.data() + pos, sub.data() + digits, value, 10);
 }
+// libc++ std::from_chars doesn't support double values, so the field is copied for strtod
 template<>
 void valueFromLine<double>(const std::string_view::iterator& it, int digits, double& value)
 {
-    std::string_view sub(&*it, digits);
-    value = std::strtof(sub.data(), nullptr);
+    char field[32];
+    std::size_t size = std::min<std::size_t>(digits, sizeof(field) - 1);
+    std::copy_n(&*it, size, field);
+    field[size] = '\0';
+    value = std::strtod(field, nullptr);
 }
 
-// add cell from sorted nodes
-template<typename T>
-void addCell(vtkSmartPointer<vtkCellArray>& cellArray, const std::vector<int>& topoElem)
+// frd node numbers to point ids, CalculiX numbers the nodes densely but not necessarily
+// starting from zero
+class NodeMap
 {
-    vtkSmartPointer<T> cell = vtkSmartPointer<T>::New();
-    cell->GetPointIds()->SetNumberOfIds(topoElem.size());
-    int type = cell->GetCellType();
-    for (size_t i = 0; i < topoElem.size(); ++i) {
-        cell->GetPointIds()->SetId(i, topoElem[mapCcxToVtk[type][i]]);
+public:
+    void reserve(std::size_t numNodes)
+    {
+        dense.reserve(numNodes + 1);
+        denseLimit = 2 * numNodes + 1024;
+    }
+    void add(int node, vtkIdType id)
+    {
+        if (node >= 0 && std::size_t(node) < denseLimit) {
+            if (std::size_t(node) >= dense.size()) {
+                dense.resize(node + 1, -1);
+            }
+            count += dense[node] < 0 ? 1 : 0;
+            dense[node] = id;
+        }
+        else {
+            count += sparse.insert_or_assign(node, id).second ? 1 : 0;
+        }
+    }
+    // throws std::out_of_range for unknown nodes
+    vtkIdType at(int node) const
+    {
+        if (node >= 0 && std::size_t(node) < dense.size() && dense[node] >= 0) {
+            return dense[node];
+        }
+        return sparse.at(node);
+    }
+    std::size_t size() const
+    {
+        return count;
     }
-    cellArray->InsertNextCell(cell);
-}
 
-// fill cell array
-void fillCell(vtkSmartPointer<vtkCellArray>& cellArray,
-              std::vector<int>& topoElem,
-              std::vector<int>& vtkType,
-              ElementType elemType)
+private:
+    std::vector<vtkIdType> dense;
+    std::unordered_map<int, vtkIdType> sparse;
+    std::size_t denseLimit = 1024;
+    std::size_t count = 0;
+};
+
+// the vtk cell type of a CalculiX element type
+int vtkCellType(ElementType elemType)
 {
     switch (elemType) {
         case ElementType::Hexa:
-            addCell<vtkHexahedron>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_HEXAHEDRON);
-            break;
+            return VTK_HEXAHEDRON;
         case ElementType::Penta:
-            addCell<vtkWedge>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_WEDGE);
-            break;
+            return VTK_WEDGE;
         case ElementType::Tetra:
-            addCell<vtkTetra>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_TETRA);
-            break;
+            return VTK_TETRA;
         case ElementType::QuadHexa:
-            addCell<vtkQuadraticHexahedron>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_QUADRATIC_HEXAHEDRON);
-            break;
+            return VTK_QUADRATIC_HEXAHEDRON;
         case ElementType::QuadPenta:
-            addCell<vtkQuadraticWedge>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_QUADRATIC_WEDGE);
-            break;
+            return VTK_QUADRATIC_WEDGE;
         case ElementType::QuadTetra:
-            addCell<vtkQuadraticTetra>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_QUADRATIC_TETRA);
-            break;
+            return VTK_QUADRATIC_TETRA;
         case ElementType::Triangle:
-            addCell<vtkTriangle>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_TRIANGLE);
-            break;
+            return VTK_TRIANGLE;
         case ElementType::QuadTriangle:
-            addCell<vtkQuadraticTriangle>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_QUADRATIC_TRIANGLE);
-            break;
+            return VTK_QUADRATIC_TRIANGLE;
         case ElementType::Quadrangle:
-            addCell<vtkQuad>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_QUAD);
-            break;
+            return VTK_QUAD;
         case ElementType::QuadQuadrangle:
-            addCell<vtkQuadraticQuad>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_QUADRATIC_QUAD);
-            break;
+            return VTK_QUADRATIC_QUAD;
         case ElementType::Edge:
-            addCell<vtkLine>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_LINE);
-            break;
+            return VTK_LINE;
         case ElementType::QuadEdge:
-            addCell<vtkQuadraticEdge>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_QUADRATIC_EDGE);
-            break;
+            return VTK_QUADRATIC_EDGE;
+    }
+    return VTK_EMPTY_CELL;
+}
+
+// fill cell array from sorted nodes, without creating a vtkCell for each element
+void fillCell(vtkSmartPointer<vtkCellArray>& cellArray,
+              std::vector<vtkIdType>& topoElem,
+              std::vector<int>& vtkType,
+              ElementType elemType)
+{
+    int type = vtkCellType(elemType);
+    const std::vector<int>& order = mapCcxToVtk[type];
+    vtkIdType ids[20];
+    for (size_t i = 0; i < topoElem.size(); ++i) {
+        ids[i] = topoElem[order[i]];
     }
+    cellArray->InsertNextCell(static_cast<vtkIdType>(topoElem.size()), ids);
+    vtkType.emplace_back(type);
 }
 
 struct FRDResultInfo
@@ -1257,7 +1277,7 @@ int getDigits(Indicator indicator)
 }
 
 // get position of scalar entities in line result vector
-std::vector<size_t> identifyScalarEntities(const std::vector<std::vector<int>> entities)
+std::vector<size_t> identifyScalarEntities(const std::vector<std::vector<int>>& entities)
 {
     std::vector<size_t> pos;
     for (auto it = entities.begin(); it != entities.end(); ++it) {
@@ -1270,7 +1290,7 @@ std::vector<size_t> identifyScalarEntities(const std::vector<std::vector<int>> e
 }
 
 // read nodes and fill vtkPoints object
-std::map<int, int>
+NodeMap
 readNodes(std::ifstream& ifstr, const std::string& lines, vtkSmartPointer<vtkPoints>& points)
 {
     std::string keyCode = "    2C";
@@ -1282,7 +1302,7 @@ readNodes(std::ifstream& ifstr, const std::string& lines, vtkSmartPointer<vtkPoi
 
     // frd file might have nodes that are not numbered starting from zero.
     // Use the map to identify them
-    std::map<int, int> mapNodes;
+    NodeMap mapNodes;
 
     std::string_view view {lines};
     std::string_view sub = view.substr(keyCode.length() + 18);
@@ -1294,25 +1314,24 @@ readNodes(std::ifstream& ifstr, const std::string& lines, vtkSmartPointer<vtkPoi
     int digits = getDigits(static_cast<Indicator>(indicator));
 
     points->SetNumberOfPoints(numNodes);
+    mapNodes.reserve(numNodes);
 
     std::string line;
     while (nodeID < numNodes && std::getline(ifstr, line)) {
-        std::vector<double> coords;
+        double coords[3] {};
         std::string_view view {line};
         if (view.rfind(keyCodeCoord, 0) == 0) {
             std::string_view v(line.data() + keyCodeCoord.length(), digits);
             valueFromLine(v.begin(), digits, node);
 
             std::string_view vi = view.substr(keyCodeCoord.length() + digits);
-            double value;
-            for (auto it = vi.begin(); it != vi.end(); it += 12) {
-                valueFromLine(it, 12, value);
-                coords.emplace_back(value);
+            for (size_t i = 0; i < 3 && 12 * (i + 1) <= vi.size(); ++i) {
+                valueFromLine(vi.begin() + 12 * i, 12, coords[i]);
             }
         }
 
-        points->SetPoint(nodeID, coords.data());
-        mapNodes[node] = nodeID++;
+        points->SetPoint(nodeID, coords);
+        mapNodes.add(node, nodeID++);
     }
 
     return mapNodes;
@@ -1321,7 +1340,7 @@ readNodes(std::ifstream& ifstr, const std::string& lines, vtkSmartPointer<vtkPoi
 // fill elements and fill cell array
 std::vector<int> readElements(std::ifstream& ifstr,
                               const std::string& lines,
-                              const std::map<int, int>& mapNodes,
+                              const NodeMap& mapNodes,
                               vtkSmartPointer<vtkCellArray>& cellArray)
 {
     std::string line;
@@ -1334,8 +1353,7 @@ std::vector<int> readElements(std::ifstream& ifstr,
     long elemID = 0;
     // element info: {type, group, material}
     std::vector<int> info(3);
-    std::map<int, int> mapElem;
-    std::vector<int> topoElem;
+    std::vector<vtkIdType> topoElem;
     std::vector<int> vtkType;
 
     std::string_view view {lines};
@@ -1346,6 +1364,7 @@ std::vector<int> readElements(std::ifstream& ifstr,
     sub = sub.substr(12 + 37);
     valueFromLine(sub.begin(), 1, indicator);
     int digits = getDigits(static_cast<Indicator>(indicator));
+    vtkType.reserve(numElem);
     while (elemID < numElem && std::getline(ifstr, line)) {
         std::string_view view {line};
         if (view.rfind(keyCodeType, 0) == 0) {
@@ -1362,8 +1381,8 @@ std::vector<int> readElements(std::ifstream& ifstr,
         if (view.rfind(keyCodeNodes, 0) == 0) {
             std::string_view vi = view.substr(keyCodeNodes.length());
             int node;
-            for (auto it = vi.begin(); it != vi.end(); it += digits) {
-                valueFromLine(it, digits, node);
+            for (size_t pos = 0; pos + digits <= vi.size(); pos += digits) {
+                valueFromLine(vi.begin() + pos, digits, node);
                 topoElem.emplace_back(mapNodes.at(node));
             }
 
@@ -1371,7 +1390,7 @@ std::vector<int> readElements(std::ifstream& ifstr,
             if (topoElem.size() == mapCcxTypeNodes[static_cast<ElementType>(info[0])]) {
                 fillCell(cellArray, topoElem, vtkType, static_cast<ElementType>(info[0]));
                 topoElem.clear();
-                mapElem[elem] = elemID++;
+                ++elemID;
             }
         }
     }
@@ -1417,7 +1436,7 @@ void readResultInfo(std::ifstream& ifstr, const std::string& lines, FRDResultInf
 // read result from nodal result block and add result array to grid
 void readResults(std::ifstream& ifstr,
                  const std::string& lines,
-                 const std::map<int, int>& mapNodes,
+                 const NodeMap& mapNodes,
                  const FRDResultInfo& info,
                  vtkSmartPointer<vtkUnstructuredGrid>& grid)
 {
@@ -1458,7 +1477,7 @@ void readResults(std::ifstream& ifstr,
             std::vector<int>::iterator it2;
             for (it1 = sub.begin(), it2 = et.begin(); it1 != sub.end() && it2 != et.end();
                  (it1 += 5), ++it2) {
-                valueFromLine(it1, digits, *it2);
+                valueFromLine(it1, 5, *it2);
             }
 
             if (et[3] == 0) {
@@ -1473,16 +1492,6 @@ void readResults(std::ifstream& ifstr,
     // used components
     numComps = entityNames.size();
 
-    // enter in node values block
-    std::string code1 = " -1";
-    std::string code2 = " -2";
-    int node {-1};
-    double value {0.0};
-    std::vector<double> vecValues;
-    std::vector<double> scaValues;
-    std::vector<int> nodes;
-    int countNodes = 0;
-    size_t countScaPos {0};
     // result block could have both vector/matrix and scalar components
     // save each scalars entity in his own array
     auto scalarPos = identifyScalarEntities(entityTypes);
@@ -1494,89 +1503,83 @@ void readResults(std::ifstream& ifstr,
         scaArrays.emplace_back(vtkSmartPointer<vtkDoubleArray>::New());
     }
 
-    vecArray->SetNumberOfComponents(numComps - scalarPos.size());
-    vecArray->SetNumberOfTuples(mapNodes.size());
+    const vtkIdType numTuples = static_cast<vtkIdType>(mapNodes.size());
+    const int numVecComps = static_cast<int>(numComps - scalarPos.size());
+    vecArray->SetNumberOfComponents(numVecComps);
+    vecArray->SetNumberOfTuples(numTuples);
     vecArray->SetName(dataSetName.c_str());
-    // set all values to zero
-    for (int i = 0; i < vecArray->GetNumberOfComponents(); ++i) {
-        vecArray->FillComponent(i, 0.0);
-    }
-    //    vecArray->Fill(0.0);
     for (size_t i = 0; i < scaArrays.size(); ++i) {
         scaArrays[i]->SetNumberOfComponents(1);
-        scaArrays[i]->SetNumberOfTuples(mapNodes.size());
+        scaArrays[i]->SetNumberOfTuples(numTuples);
         std::string name = entityNames[scalarPos[i]];
         scaArrays[i]->SetName(name.c_str());
-        //        scaArrays[i]->Fill(0.0);
-        for (int j = 0; j < scaArrays[i]->GetNumberOfComponents(); ++j) {
-            scaArrays[i]->FillComponent(j, 0.0);
+    }
+
+    // the values are written in place into the arrays: the destination of each component of a
+    // node line is its array and the offset in the tuple of the node
+    std::vector<double*> destData(numComps);
+    std::vector<vtkIdType> destStride(numComps);
+    int vecComp = 0;
+    for (size_t comp = 0; comp < numComps; ++comp) {
+        auto pos = std::ranges::find(scalarPos, comp);
+        if (pos == scalarPos.end()) {
+            destData[comp] = vecArray->GetPointer(0) + vecComp++;
+            destStride[comp] = numVecComps;
+        }
+        else {
+            destData[comp] = scaArrays[pos - scalarPos.begin()]->GetPointer(0);
+            destStride[comp] = 1;
         }
     }
+    // set all values to zero
+    std::fill_n(vecArray->GetPointer(0), numTuples * numVecComps, 0.0);
+    for (auto& s : scaArrays) {
+        std::fill_n(s->GetPointer(0), numTuples, 0.0);
+    }
+
+    // enter in node values block
+    std::string code1 = " -1";
+    std::string code2 = " -2";
+    int node {-1};
+    vtkIdType tuple {-1};
+    double value {0.0};
+    int countNodes = 0;
+    size_t countScaPos {0};
+    auto readValues = [&](std::string_view values) {
+        for (size_t pos = 0; pos + 12 <= values.size(); pos += 12, ++countScaPos) {
+            if (countScaPos >= numComps) {
+                break;
+            }
+            if (node == -1) {
+                throw Base::FileException("File to load not readable");
+            }
+            valueFromLine(values.begin() + pos, 12, value);
+            if (tuple >= 0) {
+                destData[countScaPos][tuple * destStride[countScaPos]] = value;
+            }
+        }
+    };
 
     while (countNodes < info.numNodes && std::getline(ifstr, line)) {
         std::string_view view {line};
         if (view.rfind(code1, 0) == 0) {
             sub = view.substr(code1.length());
             valueFromLine(sub.begin(), digits, node);
-            // clear values vector for each node result block
-            vecValues.clear();
-            scaValues.clear();
             countScaPos = 0;
             try {
                 // result nodes could not exist in .frd file due to element expansion
                 // so mapNodes.at() could throw an exception
-                nodes.emplace_back(mapNodes.at(node));
-                sub = sub.substr(digits);
-                for (auto it = sub.begin(); it != sub.end(); it += 12, ++countScaPos) {
-                    valueFromLine(it, 12, value);
-                    // search if value is scalar or vector/matrix component
-                    auto pos = std::ranges::find(scalarPos, countScaPos);
-                    if (pos == scalarPos.end()) {
-                        vecValues.emplace_back(value);
-                    }
-                    else {
-                        scaValues.emplace_back(value);
-                    }
-                }
+                tuple = mapNodes.at(node);
             }
             catch (const std::out_of_range&) {
                 Base::Console().warning("Invalid node: %d\n", node);
+                tuple = -1;
             }
+            readValues(sub.substr(digits));
             ++countNodes;
         }
         else if (view.rfind(code2, 0) == 0) {
-            sub = view.substr(code2.length() + digits);
-            for (auto it = sub.begin(); it != sub.end(); it += 12) {
-                valueFromLine(it, 12, value);
-                // search if value is scalar or vector/matrix component
-                auto pos = std::ranges::find(scalarPos, countScaPos);
-                if (pos == scalarPos.end()) {
-                    vecValues.emplace_back(value);
-                }
-                else {
-                    scaValues.emplace_back(value);
-                }
-            }
-        }
-        if ((vecValues.size() + scaValues.size()) == numComps) {
-            if (!vecValues.empty()) {
-                if (node == -1) {
-                    throw Base::FileException("File to load not readable");
-                }
-                vecArray->SetTuple(mapNodes.at(node), vecValues.data());
-            }
-            if (!scaValues.empty()) {
-                if (node == -1) {
-                    throw Base::FileException("File to load not readable");
-                }
-                std::vector<vtkSmartPointer<vtkDoubleArray>>::iterator it1;
-                std::vector<double>::iterator it2;
-                for (it1 = scaArrays.begin(), it2 = scaValues.begin();
-                     it1 != scaArrays.end() && it2 != scaValues.end();
-                     ++it1, ++it2) {
-                    (*it1)->SetTuple1(mapNodes.at(node), *it2);
-                }
-            }
+            readValues(view.substr(code2.length() + digits));
         }
     }
 
@@ -1618,7 +1621,7 @@ vtkSmartPointer<vtkMultiBlockDataSet> readFRD(std::ifstream& ifstr)
     std::map<FRDResultInfo, vtkSmartPointer<vtkUnstructuredGrid>> grids;
     std::map<AnalysisType, vtkSmartPointer<vtkMultiBlockDataSet>> blocks;
     std::string line;
-    std::map<int, int> mapNodes;
+    NodeMap mapNodes;
     std::vector<int> cellTypes;
 
     while (std::getline(ifstr, line)) {
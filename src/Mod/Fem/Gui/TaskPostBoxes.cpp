@@ -214,6 +214,12 @@ TaskPostWidget::TaskPostWidget(Gui::ViewProviderDocumentObject* view,
                                                     this,
                                                     boost::placeholders::_1,
                                                     boost::placeholders::_2));
+
+    m_recomputeTimer.setSingleShot(true);
+    m_recomputeTimer.setInterval(0);
+    connect(&m_recomputeTimer, &QTimer::timeout, this, [this]() {
+        recompute();
+    });
 }
 
 TaskPostWidget::~TaskPostWidget()
@@ -242,6 +248,13 @@ void TaskPostWidget::recompute()
     }
 }
 
+void TaskPostWidget::recomputeDeferred()
+{
+    if (autoApply()) {
+        m_recomputeTimer.start();
+    }
+}
+
 void TaskPostWidget::updateEnumerationList(App::PropertyEnumeration& prop, QComboBox* box)
 {
     QStringList list;
@@ -1964,7 +1977,7 @@ void TaskPostScalarClip::onSliderValueChanged(int v)
         + double(v) / 100. * value.getConstraints()->UpperBound;
 
     value.setValue(val);
-    recompute();
+    recomputeDeferred();
 
     // don't forget to sync the spinbox
     ui->Value->blockSignals(true);
@@ -1976,7 +1989,7 @@ void TaskPostScalarClip::onValueValueChanged(double v)
 {
     App::PropertyFloatConstraint& value = getObject<Fem::FemPostScalarClipFilter>()->Value;
     value.setValue(v);
-    recompute();
+    recomputeDeferred();
 
     // don't forget to sync the slider
     ui->Slider->blockSignals(true);
@@ -2085,7 +2098,7 @@ void TaskPostWarpVector::onSliderValueChanged(int slider_value)
     double warp_factor =
         ui->Min->value() + ((ui->Max->value() - ui->Min->value()) / 100.) * slider_value;
     getObject<Fem::FemPostWarpVectorFilter>()->Factor.setValue(warp_factor);
-    recompute();
+    recomputeDeferred();
 
     // sync the spinbox
     ui->Value->blockSignals(true);
@@ -2101,7 +2114,7 @@ void TaskPostWarpVector::onValueValueChanged(double warp_factor)
     // TODO warp factor should not be smaller than min and greater than max,
     // but problems on automate change of warp_factor, see on_Max_valueChanged
     getObject<Fem::FemPostWarpVectorFilter>()->Factor.setValue(warp_factor);
-    recompute();
+    recomputeDeferred();
 
     // sync the slider, see above for formula
     ui->Slider->blockSignals(true);
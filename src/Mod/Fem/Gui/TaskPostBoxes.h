@@ -23,6 +23,8 @@
 #ifndef GUI_TASKVIEW_TaskPostDisplay_H
 #define GUI_TASKVIEW_TaskPostDisplay_H
 
+#include <QTimer>
+
 #include <Gui/DocumentObserver.h>
 #include <Gui/TaskView/TaskDialog.h>
 #include <Gui/TaskView/TaskView.h>
@@ -191,6 +193,9 @@ protected:
 
     bool autoApply();
     void recompute();
+    // like recompute(), but merges the calls until the events are processed, so that only the
+    // last of fast changes like slider moves is computed
+    void recomputeDeferred();
 
     static void updateEnumerationList(App::PropertyEnumeration&, QComboBox* box);
 
@@ -203,6 +208,7 @@ private:
     App::DocumentObjectWeakPtrT m_object;
     Gui::ViewProviderWeakPtrT m_view;
     boost::signals2::connection m_connection;
+    QTimer m_recomputeTimer;
 };
 
 
@@ -732,8 +732,7 @@ void ViewProviderFemPostObject::WriteColorData(bool ResetColorBarRange)
     m_matPlainEdges->transparency.setNum(numPts);
     float* transp = m_material->transparency.startEditing();
     float* edgeTransp = m_matPlainEdges->transparency.startEditing();
-    Base::Color c;
-    Base::Color cEdge = EdgeColor.getValue();
+    std::vector<float> values(numPts);
     for (int i = 0; i < numPts; i++) {
 
         double value = 0;
@@ -748,9 +747,17 @@ void ViewProviderFemPostObject::WriteColorData(bool ResetColorBarRange)
             value = std::sqrt(value);
         }
 
-        c = m_colorBar->getColor(value);
-        diffcol[i].setValue(c.r, c.g, c.b);
-        transp[i] = std::max(c.transparency(), overallTransp);
+        values[i] = static_cast<float>(value);
+    }
+
+    std::vector<uint32_t> colors(numPts);
+    m_colorBar->getPackedColors(values.data(), values.size(), colors.data());
+
+    Base::Color cEdge = EdgeColor.getValue();
+    for (int i = 0; i < numPts; i++) {
+        float transparency {};
+        diffcol[i].setPackedValue(colors[i], transparency);
+        transp[i] = std::max(transparency, overallTransp);
         edgeDiffcol[i].setValue(cEdge.r, cEdge.g, cEdge.b);
         edgeTransp[i] = std::max(cEdge.transparency(), overallTransp);
     }
@@ -1125,7 +1132,8 @@ void ViewProviderFemPostObject::onSelectionChanged(const Gui::SelectionChanges&
     // color bar.
     // But don't do this if the object is invisible because other objects with a
     // color bar might be visible and the color bar is then wrong.
-    if (sel.Type == Gui::SelectionChanges::AddSelection) {
+    if (sel.Type == Gui::SelectionChanges::AddSelection
+        || sel.Type == Gui::SelectionChanges::AddSelections) {
         if (this->getObject()->Visibility.getValue()) {
             updateMaterial();
         }
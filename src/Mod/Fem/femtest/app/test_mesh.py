@@ -31,6 +31,7 @@ from os.path import join
 import FreeCAD
 
 import Fem
+import Part
 from . import support_utils as testtools
 from .support_utils import fcc_print
 
@@ -192,6 +193,40 @@ class TestMeshCommon(unittest.TestCase):
             f"Problem in test_writeAbaqus_precision, \n{read_node_line}\n{expected}",
         )
 
+    # ********************************************************************************************
+    def test_nodes_by_shape(self):
+        # nodes on a grid of 5 x 5 x 2 points with a spacing of 1 mm
+        grid = Fem.FemMesh()
+        for k in range(2):
+            for j in range(5):
+                for i in range(5):
+                    grid.addNode(i, j, k, 1 + i + 5 * j + 25 * k)
+
+        face = Part.makePlane(2, 2)
+        edge = Part.makeLine(FreeCAD.Vector(0, 0, 0), FreeCAD.Vector(4, 0, 0))
+        vertex = Part.Vertex(4, 4, 1)
+        self.assertEqual(
+            grid.getNodesByFace(face),
+            [1, 2, 3, 6, 7, 8, 11, 12, 13],
+            "Nodes by face are unexpected",
+        )
+        self.assertEqual(grid.getNodesByEdge(edge), [1, 2, 3, 4, 5], "Nodes by edge are unexpected")
+        self.assertEqual(grid.getNodesByVertex(vertex), [50], "Nodes by vertex are unexpected")
+
+        # the nodes are found at their new position after adding nodes and moving the mesh
+        grid.addNode(1.5, 1.5, 0, 51)
+        self.assertEqual(
+            grid.getNodesByFace(face),
+            [1, 2, 3, 6, 7, 8, 11, 12, 13, 51],
+            "Nodes by face of the extended mesh are unexpected",
+        )
+        grid.Placement = FreeCAD.Placement(FreeCAD.Vector(0, 0, -1), FreeCAD.Rotation())
+        self.assertEqual(
+            grid.getNodesByFace(face),
+            [26, 27, 28, 31, 32, 33, 36, 37, 38],
+            "Nodes by face of the moved mesh are unexpected",
+        )
+
 
 # ************************************************************************************************
 # ************************************************************************************************
@@ -241,11 +241,15 @@ void ExportOCAF2::setupObject(TDF_Label label,
         childName += '.';
     }
     for (auto key : keys) {
-        for (auto& v : getShapeColors(obj, key)) {
+        const auto& shapeColors = getColors(obj, key);
+        // the colors of an element are sorted after its name
+        auto it = name ? shapeColors.lower_bound(childName) : shapeColors.begin();
+        for (; it != shapeColors.end(); ++it) {
+            const auto& v = *it;
             const char* subname = v.first.c_str();
             if (name) {
                 if (!boost::starts_with(v.first, childName)) {
-                    continue;
+                    break;
                 }
                 subname += childName.size();
             }
@@ -335,6 +339,16 @@ void ExportOCAF2::setupObject(TDF_Label label,
     }
 }
 
+const std::map<std::string, Base::Color>& ExportOCAF2::getColors(App::DocumentObject* obj,
+                                                                 const char* key)
+{
+    auto [it, inserted] = myColors.try_emplace(std::make_pair(obj, std::string(key)));
+    if (inserted) {
+        it->second = getShapeColors(obj, key);
+    }
+    return it->second;
+}
+
 void ExportOCAF2::exportObjects(std::vector<App::DocumentObject*>& objs, const char* name)
 {
     if (objs.empty()) {
@@ -343,6 +357,7 @@ void ExportOCAF2::exportObjects(std::vector<App::DocumentObject*>& objs, const c
     myObjects.clear();
     myNames.clear();
     mySetups.clear();
+    myColors.clear();
     if (objs.size() == 1) {
         exportObject(objs.front(), nullptr, TDF_Label());
     }
@@ -373,6 +388,7 @@ void ExportOCAF2::exportObjects(std::vector<App::DocumentObject*>& objs, const c
     // Update is not performed automatically anymore:
     // https://tracker.dev.opencascade.org/view.php?id=28055
     aShapeTool->UpdateAssemblies();
+    myColors.clear();
 }
 
 TDF_Label ExportOCAF2::exportObject(App::DocumentObject* parentObj,
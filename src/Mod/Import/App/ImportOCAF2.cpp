@@ -25,6 +25,9 @@
 #define WNT  // avoid conflict with GUID
 #endif
 #ifndef _PreComp_
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <Interface_Static.hxx>
 #include <Quantity_ColorRGBA.hxx>
 #include <Standard_Failure.hxx>
@@ -288,81 +291,22 @@ bool ImportOCAF2::createObject(App::Document* doc,
     }
 
     getColor(shape, info);
-    bool hasFaceColors = false;
-    bool hasEdgeColors = false;
 
-    Part::TopoShape tshape(shape);
-    std::vector<Base::Color> faceColors;
-    std::vector<Base::Color> edgeColors;
-
-    TDF_LabelSequence seq;
-    if (!label.IsNull() && aShapeTool->GetSubShapes(label, seq)) {
-
-        TopTools_IndexedMapOfShape faceMap, edgeMap;
-        TopExp::MapShapes(tshape.getShape(), TopAbs_FACE, faceMap);
-        TopExp::MapShapes(tshape.getShape(), TopAbs_EDGE, edgeMap);
-
-        faceColors.assign(faceMap.Extent(), info.faceColor);
-        edgeColors.assign(edgeMap.Extent(), info.edgeColor);
-        // Two passes to get sub shape colors. First pass, look for solid, and
-        // second pass look for face and edges. This allows lower level
-        // subshape to override color of higher level ones.
-        for (int j = 0; j < 2; ++j) {
-            for (int i = 1; i <= seq.Length(); ++i) {
-                TDF_Label l = seq.Value(i);
-                TopoDS_Shape subShape = aShapeTool->GetShape(l);
-                if (subShape.IsNull()) {
-                    continue;
-                }
-                if (subShape.ShapeType() == TopAbs_FACE || subShape.ShapeType() == TopAbs_EDGE) {
-                    if (j == 0) {
-                        continue;
-                    }
-                }
-                else if (j != 0) {
-                    continue;
-                }
-
-                bool foundFaceColor = false, foundEdgeColor = false;
-                Base::Color faceColor, edgeColor;
-                Quantity_ColorRGBA aColor;
-                if (aColorTool->GetColor(l, XCAFDoc_ColorSurf, aColor)
-                    || aColorTool->GetColor(l, XCAFDoc_ColorGen, aColor)) {
-                    faceColor = Tools::convertColor(aColor);
-                    foundFaceColor = true;
-                }
-                if (aColorTool->GetColor(l, XCAFDoc_ColorCurv, aColor)) {
-                    edgeColor = Tools::convertColor(aColor);
-                    foundEdgeColor = true;
-                    if (j == 0 && foundFaceColor && !faceColors.empty() && edgeColor == faceColor) {
-                        // Do not set edge the same color as face
-                        foundEdgeColor = false;
-                    }
-                }
-
-                if (foundFaceColor) {
-                    for (TopExp_Explorer exp(subShape, TopAbs_FACE); exp.More(); exp.Next()) {
-                        int idx = faceMap.FindIndex(exp.Current()) - 1;
-                        if (idx >= 0 && idx < (int)faceColors.size()) {
-                            faceColors[idx] = faceColor;
-                            hasFaceColors = true;
-                            info.hasFaceColor = true;
-                        }
-                    }
-                }
-                if (foundEdgeColor) {
-                    for (TopExp_Explorer exp(subShape, TopAbs_EDGE); exp.More(); exp.Next()) {
-                        int idx = edgeMap.FindIndex(exp.Current()) - 1;
-                        if (idx >= 0 && idx < (int)edgeColors.size()) {
-                            edgeColors[idx] = edgeColor;
-                            hasEdgeColors = true;
-                            info.hasEdgeColor = true;
-                        }
-                    }
-                }
-            }
-        }
+    // the colors of the parts are usually mapped in advance by prepareShapeColors()
+    ShapeColors colors;
+    auto it = myColors.find(label);
+    if (it != myColors.end() && it->second.shape.IsEqual(shape)) {
+        colors = std::move(it->second);
+        myColors.erase(it);
     }
+    else if (!label.IsNull()) {
+        colors.shape = shape;
+        mapSubShapeColors(colors, info, getSubShapeColors(label));
+    }
+    info.hasFaceColor = info.hasFaceColor || colors.hasFaceColors;
+    info.hasEdgeColor = info.hasEdgeColor || colors.hasEdgeColors;
+
+    Part::TopoShape tshape(shape);
 
     Part::Feature* feature;
 
@@ -382,11 +326,11 @@ bool ImportOCAF2::createObject(App::Document* doc,
     }
     applyFaceColors(feature, {info.faceColor});
     applyEdgeColors(feature, {info.edgeColor});
-    if (hasFaceColors) {
-        applyFaceColors(feature, faceColors);
+    if (colors.hasFaceColors) {
+        applyFaceColors(feature, colors.faceColors);
     }
-    if (hasEdgeColors) {
-        applyEdgeColors(feature, edgeColors);
+    if (colors.hasEdgeColors) {
+        applyEdgeColors(feature, colors.edgeColors);
     }
 
     info.propPlacement = &feature->Placement;
@@ -394,6 +338,150 @@ bool ImportOCAF2::createObject(App::Document* doc,
     return true;
 }
 
+std::vector<ImportOCAF2::SubShapeColor> ImportOCAF2::getSubShapeColors(TDF_Label label)
+{
+    std::vector<SubShapeColor> subColors;
+    TDF_LabelSequence seq;
+    if (label.IsNull() || !aShapeTool->GetSubShapes(label, seq)) {
+        return subColors;
+    }
+
+    // Two passes to get sub shape colors. First pass, look for solid, and
+    // second pass look for face and edges. This allows lower level
+    // subshape to override color of higher level ones.
+    for (int j = 0; j < 2; ++j) {
+        for (int i = 1; i <= seq.Length(); ++i) {
+            TDF_Label l = seq.Value(i);
+            SubShapeColor subColor;
+            subColor.shape = aShapeTool->GetShape(l);
+            if (subColor.shape.IsNull()) {
+                continue;
+            }
+            subColor.isShapeColor = subColor.shape.ShapeType() != TopAbs_FACE
+                && subColor.shape.ShapeType() != TopAbs_EDGE;
+            if (subColor.isShapeColor != (j == 0)) {
+                continue;
+            }
+
+            Quantity_ColorRGBA aColor;
+            if (aColorTool->GetColor(l, XCAFDoc_ColorSurf, aColor)
+                || aColorTool->GetColor(l, XCAFDoc_ColorGen, aColor)) {
+                subColor.faceColor = Tools::convertColor(aColor);
+                subColor.hasFaceColor = true;
+            }
+            if (aColorTool->GetColor(l, XCAFDoc_ColorCurv, aColor)) {
+                subColor.edgeColor = Tools::convertColor(aColor);
+                subColor.hasEdgeColor = true;
+            }
+            if (subColor.hasFaceColor || subColor.hasEdgeColor) {
+                subColors.push_back(subColor);
+            }
+        }
+    }
+    return subColors;
+}
+
+void ImportOCAF2::mapSubShapeColors(ShapeColors& colors,
+                                    const Info& info,
+                                    const std::vector<SubShapeColor>& subColors)
+{
+    if (subColors.empty()) {
+        return;
+    }
+
+    TopTools_IndexedMapOfShape faceMap, edgeMap;
+    TopExp::MapShapes(colors.shape, TopAbs_FACE, faceMap);
+    TopExp::MapShapes(colors.shape, TopAbs_EDGE, edgeMap);
+
+    colors.faceColors.assign(faceMap.Extent(), info.faceColor);
+    colors.edgeColors.assign(edgeMap.Extent(), info.edgeColor);
+    for (const auto& subColor : subColors) {
+        if (subColor.hasFaceColor) {
+            for (TopExp_Explorer exp(subColor.shape, TopAbs_FACE); exp.More(); exp.Next()) {
+                int idx = faceMap.FindIndex(exp.Current()) - 1;
+                if (idx >= 0 && idx < (int)colors.faceColors.size()) {
+                    colors.faceColors[idx] = subColor.faceColor;
+                    colors.hasFaceColors = true;
+                }
+            }
+        }
+        // Do not set edge the same color as face
+        bool sameColor = subColor.isShapeColor && subColor.hasFaceColor
+            && !colors.faceColors.empty() && subColor.edgeColor == subColor.faceColor;
+        if (subColor.hasEdgeColor && !sameColor) {
+            for (TopExp_Explorer exp(subColor.shape, TopAbs_EDGE); exp.More(); exp.Next()) {
+                int idx = edgeMap.FindIndex(exp.Current()) - 1;
+                if (idx >= 0 && idx < (int)colors.edgeColors.size()) {
+                    colors.edgeColors[idx] = subColor.edgeColor;
+                    colors.hasEdgeColors = true;
+                }
+            }
+        }
+    }
+}
+
+void ImportOCAF2::prepareShapeColors()
+{
+    // The color attributes are read here, mapping them to the faces and edges of large parts
+    // takes much longer and is done concurrently as it only reads the shapes.
+    struct Job
+    {
+        TDF_Label label;
+        Info info;
+        std::vector<SubShapeColor> subColors;
+        ShapeColors colors;
+    };
+    std::vector<Job> jobs;
+
+    TDF_LabelSequence labels;
+    aShapeTool->GetShapes(labels);
+    for (Standard_Integer i = 1; i <= labels.Length(); i++) {
+        Job job;
+        job.label = labels.Value(i);
+        if (aShapeTool->IsAssembly(job.label)) {
+            continue;
+        }
+        job.colors.shape = aShapeTool->GetShape(job.label).Located(TopLoc_Location());
+        if (job.colors.shape.IsNull()) {
+            continue;
+        }
+        job.subColors = getSubShapeColors(job.label);
+        if (!job.subColors.empty()) {
+            getColor(job.colors.shape, job.info);
+            jobs.push_back(std::move(job));
+        }
+    }
+
+    std::atomic<std::size_t> next {0};
+    auto work = [&]() {
+        for (std::size_t i = next++; i < jobs.size(); i = next++) {
+            try {
+                mapSubShapeColors(jobs[i].colors, jobs[i].info, jobs[i].subColors);
+            }
+            catch (Standard_Failure&) {
+                // createObject() maps the colors again and reports the error
+                jobs[i].colors.shape.Nullify();
+            }
+        }
+    };
+    const std::size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < std::min(threads, jobs.size()); i++) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& it : workers) {
+        it.join();
+    }
+
+    myColors.clear();
+    for (auto& job : jobs) {
+        if (!job.colors.shape.IsNull()) {
+            myColors.emplace(job.label, std::move(job.colors));
+        }
+    }
+}
+
 App::Document* ImportOCAF2::getDocument(App::Document* doc, TDF_Label label)
 {
     if (filePath.empty() || options.mode == SingleDoc || options.merge) {
@@ -520,6 +608,7 @@ App::DocumentObject* ImportOCAF2::loadShapes()
     myShapes.clear();
     myNames.clear();
     myCollapsedObjects.clear();
+    prepareShapeColors();
 
     std::vector<App::DocumentObject*> objs;
     aShapeTool->GetFreeShapes(labels);
@@ -576,6 +665,7 @@ App::DocumentObject* ImportOCAF2::loadShapes()
         ret = feature;
         ret->recomputeFeature(true);
     }
+    myColors.clear();
     sequencer = nullptr;
     return ret;
 }
@@ -136,6 +136,28 @@ private:
         int free = true;
     };
 
+    /// The colors of a sub shape label of a part
+    struct SubShapeColor
+    {
+        TopoDS_Shape shape;
+        Base::Color faceColor;
+        Base::Color edgeColor;
+        bool hasFaceColor = false;
+        bool hasEdgeColor = false;
+        /// true if the label is neither a face nor an edge
+        bool isShapeColor = false;
+    };
+
+    /// The face and edge colors of a part
+    struct ShapeColors
+    {
+        TopoDS_Shape shape;
+        std::vector<Base::Color> faceColors;
+        std::vector<Base::Color> edgeColors;
+        bool hasFaceColors = false;
+        bool hasEdgeColors = false;
+    };
+
     App::DocumentObject* loadShape(App::Document* doc,
                                    TDF_Label label,
                                    const TopoDS_Shape& shape,
@@ -162,6 +184,11 @@ private:
     getColor(const TopoDS_Shape& shape, Info& info, bool check = false, bool noDefault = false);
     void
     getSHUOColors(TDF_Label label, std::map<std::string, Base::Color>& colors, bool appendFirst);
+    std::vector<SubShapeColor> getSubShapeColors(TDF_Label label);
+    static void mapSubShapeColors(ShapeColors& colors,
+                                  const Info& info,
+                                  const std::vector<SubShapeColor>& subColors);
+    void prepareShapeColors();
     void setObjectName(Info& info, TDF_Label label);
     std::string getLabelName(TDF_Label label);
     App::DocumentObject*
@@ -207,6 +234,7 @@ private:
     std::unordered_map<TopoDS_Shape, Info, ShapeHasher> myShapes;
     std::unordered_map<TDF_Label, std::string, LabelHasher> myNames;
     std::unordered_map<App::DocumentObject*, App::PropertyPlacement*> myCollapsedObjects;
+    std::unordered_map<TDF_Label, ShapeColors, LabelHasher> myColors;
 
     Base::SequencerLauncher* sequencer {nullptr};
 };
@@ -267,6 +295,7 @@ private:
                      bool force = false);
     void setName(TDF_Label label, App::DocumentObject* obj, const char* name = nullptr);
     TDF_Label findComponent(const char* subname, TDF_Label label, TDF_LabelSequence& labels);
+    const std::map<std::string, Base::Color>& getColors(App::DocumentObject* obj, const char* key);
 
 private:
     Handle(TDocStd_Document) pDoc;
@@ -279,6 +308,10 @@ private:
 
     std::set<std::pair<App::DocumentObject*, std::string>> mySetups;
 
+    /// The results of getShapeColors(), a link array is asked once and not for every element
+    std::map<std::pair<App::DocumentObject*, std::string>, std::map<std::string, Base::Color>>
+        myColors;
+
     std::vector<App::DocumentObject*> groupLinks;
 
     GetShapeColorsFunc getShapeColors;
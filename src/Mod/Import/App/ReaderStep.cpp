@@ -24,29 +24,65 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <mutex>
+#include <sstream>
+#include <BinXCAFDrivers.hxx>
+#include <Interface_Static.hxx>
+#include <Standard_Failure.hxx>
 #include <Standard_Version.hxx>
 #include <STEPCAFControl_Reader.hxx>
 #include <Transfer_TransientProcess.hxx>
+#include <XCAFApp_Application.hxx>
 #include <XSControl_TransferReader.hxx>
 #include <XSControl_WorkSession.hxx>
+#include <QCryptographicHash>
+#include <QFile>
 #endif
 
 #include "ReaderStep.h"
+#include <App/Application.h>
+#include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Mod/Part/App/encodeFilename.h>
+#include <Mod/Part/App/OCAF/ImportExportSettings.h>
 
 using namespace Import;
 
+namespace
+{
+
+/// The application with the binary XCAF format of the import cache
+Handle(XCAFApp_Application) getCacheApplication()
+{
+    Handle(XCAFApp_Application) app = XCAFApp_Application::GetApplication();
+    static std::once_flag defineFormat;
+    std::call_once(defineFormat, [app]() {
+        BinXCAFDrivers::DefineFormat(app);
+    });
+    return app;
+}
+
+}  // namespace
+
 ReaderStep::ReaderStep(const Base::FileInfo& file)  // NOLINT
     : file {file}
 {
 #if OCC_VERSION_HEX >= 0x070800
     codePage = Resource_FormatType_UTF8;
 #endif
+    useCache = Part::OCAF::ImportExportSettings().getUseImportCache();
 }
 
-void ReaderStep::read(Handle(TDocStd_Document) hDoc)  // NOLINT
+void ReaderStep::read(Handle(TDocStd_Document)& hDoc)  // NOLINT
 {
+    std::string cacheName;
+    if (useCache) {
+        cacheName = cacheFileName();
+        if (!cacheName.empty() && readCache(cacheName, hDoc)) {
+            return;
+        }
+    }
+
     std::string utf8Name = file.filePath();
     std::string name8bit = Part::encodeFilename(utf8Name);
     STEPCAFControl_Reader aReader;
@@ -66,4 +102,105 @@ void ReaderStep::read(Handle(TDocStd_Document) hDoc)  // NOLINT
     }
 
     aReader.Transfer(hDoc);
+
+    if (!cacheName.empty()) {
+        writeCache(cacheName, hDoc);
+    }
+}
+
+std::string ReaderStep::cacheFileName() const
+{
+    QFile input(QString::fromStdString(file.filePath()));
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!input.open(QIODevice::ReadOnly) || !hash.addData(&input)) {
+        return {};
+    }
+
+    // the kernel version and the reader options that change the transferred document
+    std::ostringstream str;
+    str << OCC_VERSION_STRING_EXT << ' ' << static_cast<int>(codePage);
+    for (const char* name : {"read.precision.mode",
+                             "read.precision.val",
+                             "read.maxprecision.mode",
+                             "read.maxprecision.val",
+                             "read.surfacecurve.mode",
+                             "read.encoderegularity.angle",
+                             "read.step.product.mode",
+                             "read.step.product.context",
+                             "read.step.shape.repr",
+                             "read.step.assembly.level",
+                             "read.step.shape.relationship",
+                             "read.step.shape.aspect",
+                             "read.step.constructivegeom.relationship",
+                             "read.step.ideas",
+                             "read.step.nonmanifold",
+                             "read.step.resource.name",
+                             "read.step.sequence"}) {
+        if (Interface_Static::IsPresent(name)) {
+            str << ' ' << name << '=' << Interface_Static::CVal(name);
+        }
+    }
+    hash.addData(QByteArray::fromStdString(str.str()));
+
+    return App::Application::getUserCachePath() + "StepImport" + PATHSEP
+        + hash.result().toHex().toStdString() + ".xbf";
+}
+
+bool ReaderStep::readCache(const std::string& fileName, Handle(TDocStd_Document)& hDoc) const
+{
+    if (!Base::FileInfo(fileName).isReadable()) {
+        return false;
+    }
+
+    try {
+        Handle(XCAFApp_Application) app = getCacheApplication();
+
+        Handle(TDocStd_Document) cached;
+        if (app->Open(TCollection_ExtendedString(fileName.c_str(), Standard_True), cached)
+            != PCDM_RS_OK) {
+            Base::Console().warning("Cannot read STEP import cache %s\n", fileName.c_str());
+            return false;
+        }
+        // the documents of the importers belong to the same application
+        if (!hDoc.IsNull() && hDoc->IsOpened()) {
+            app->Close(hDoc);
+        }
+        hDoc = cached;
+        return true;
+    }
+    catch (Standard_Failure& e) {
+        Base::Console().warning("Cannot read STEP import cache %s: %s\n",
+                                fileName.c_str(),
+                                e.GetMessageString());
+        return false;
+    }
+}
+
+void ReaderStep::writeCache(const std::string& fileName, Handle(TDocStd_Document) hDoc) const
+{
+    Base::FileInfo dir(Base::FileInfo(fileName).dirPath());
+    if (!dir.exists() && !dir.createDirectories()) {
+        return;
+    }
+
+    // the document is written to a temporary file first so that a concurrent import never reads
+    // an incomplete one
+    Base::FileInfo temp(Base::FileInfo::getTempFileName("StepImport", dir.filePath().c_str()));
+    TCollection_ExtendedString format = hDoc->StorageFormat();
+    try {
+        Handle(XCAFApp_Application) app = getCacheApplication();
+
+        hDoc->ChangeStorageFormat("BinXCAF");
+        PCDM_StoreStatus status =
+            app->SaveAs(hDoc, TCollection_ExtendedString(temp.filePath().c_str(), Standard_True));
+        hDoc->ChangeStorageFormat(format);
+        if (status == PCDM_SS_OK && temp.renameFile(fileName.c_str())) {
+            return;
+        }
+    }
+    catch (Standard_Failure& e) {
+        hDoc->ChangeStorageFormat(format);
+        Base::Console().warning("Cannot write STEP import cache: %s\n", e.GetMessageString());
+    }
+    temp.deleteFile();
 }
@@ -42,11 +42,25 @@ public:
     {
         codePage = cp;
     }
-    void read(Handle(TDocStd_Document) hDoc);
+    /// Keep the transferred documents in the user cache directory, see
+    /// Part::OCAF::ImportExportSettings::getUseImportCache()
+    void setUseCache(bool on)
+    {
+        useCache = on;
+    }
+    /// Transfers the file to \a hDoc. If the cache is used and the same file was imported with
+    /// the same reader options before \a hDoc is closed and replaced by the cached document.
+    void read(Handle(TDocStd_Document)& hDoc);
+
+private:
+    std::string cacheFileName() const;
+    bool readCache(const std::string& fileName, Handle(TDocStd_Document)& hDoc) const;
+    void writeCache(const std::string& fileName, Handle(TDocStd_Document) hDoc) const;
 
 private:
     Base::FileInfo file;
     Resource_FormatType codePage {};
+    bool useCache = false;
 };
 
 }  // namespace Import
@@ -24,19 +24,83 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <boost/core/ignore_unused.hpp>
+#include <BRep_Tool.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <IMeshTools_Parameters.hxx>
+#include <Precision.hxx>
 #include <Standard_Version.hxx>
 #include <TColStd_IndexedDataMapOfStringString.hxx>
+#include <TDF_LabelSequence.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
 #include <Message_ProgressRange.hxx>
 #include <RWGltf_CafWriter.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+#if OCC_VERSION_HEX >= 0x070700
+#include <RWGltf_DracoParameters.hxx>
+#endif
 #endif
 
 #include "WriterGltf.h"
+#include <App/Application.h>
 #include <Base/Exception.h>
+#include <Base/Tools.h>
+#include <Mod/Part/App/Tools.h>
 #include <Mod/Part/App/encodeFilename.h>
 
 using namespace Import;
 
+namespace
+{
+
+bool hasTriangulation(const TopoDS_Shape& shape)
+{
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        TopLoc_Location loc;
+        if (BRep_Tool::Triangulation(TopoDS::Face(xp.Current()), loc).IsNull()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// The writer only exports existing triangulations. Shapes that have been displayed already have
+/// the one of their view provider, the others are meshed with the same parameters.
+void meshShapes(Handle(TDocStd_Document) hDoc)
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part");
+    double deviation = hGrp->GetFloat("MeshDeviation", 0.2);                    // NOLINT
+    double angularDeflection = hGrp->GetFloat("MeshAngularDeflection", 28.65);  // NOLINT
+
+    Handle(XCAFDoc_ShapeTool) shapeTool = XCAFDoc_DocumentTool::ShapeTool(hDoc->Main());
+    TDF_LabelSequence labels;
+    shapeTool->GetShapes(labels);
+    for (Standard_Integer i = 1; i <= labels.Length(); i++) {
+        if (shapeTool->IsAssembly(labels.Value(i))) {
+            continue;
+        }
+        TopoDS_Shape shape = shapeTool->GetShape(labels.Value(i));
+        if (shape.IsNull() || hasTriangulation(shape)) {
+            continue;
+        }
+
+        IMeshTools_Parameters meshParams;
+        meshParams.Deflection =
+            std::max(Part::Tools::getDeflection(shape, deviation), Precision::Confusion());
+        meshParams.Relative = Standard_False;
+        meshParams.Angle = Base::toRadians(angularDeflection);
+        meshParams.InParallel = Standard_True;
+        meshParams.AllowQualityDecrease = Standard_True;
+        BRepMesh_IncrementalMesh(shape, meshParams);
+    }
+}
+
+}  // namespace
+
 WriterGltf::WriterGltf(const Base::FileInfo& file)  // NOLINT
     : file {file}
 {}
@@ -45,6 +109,14 @@ void WriterGltf::write(Handle(TDocStd_Document) hDoc) const  // NOLINT
 {
     std::string utf8Name = file.filePath();
     std::string name8bit = Part::encodeFilename(utf8Name);
+    meshShapes(hDoc);
+
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication()
+                                             .GetUserParameter()
+                                             .GetGroup("BaseApp")
+                                             ->GetGroup("Preferences")
+                                             ->GetGroup("Mod/Import")
+                                             ->GetGroup("glTF");
 
     TColStd_IndexedDataMapOfStringString aMetadata;
     RWGltf_CafWriter aWriter(name8bit.c_str(), file.hasExtension("glb"));
@@ -52,8 +124,19 @@ void WriterGltf::write(Handle(TDocStd_Document) hDoc) const  // NOLINT
     // https://github.com/KhronosGroup/glTF/blob/master/specification/2.0/README.md#coordinate-system-and-units
     aWriter.ChangeCoordinateSystemConverter().SetInputLengthUnit(0.001);  // NOLINT
     aWriter.ChangeCoordinateSystemConverter().SetInputCoordinateSystem(RWMesh_CoordinateSystem_Zup);
+#if OCC_VERSION_HEX >= 0x070600
+    // one primitive per part and style instead of one per face, repeated parts are written as
+    // nodes referring to the same mesh
+    aWriter.SetMergeFaces(hGrp->GetBool("MergeFaces", true));
+#endif
 #if OCC_VERSION_HEX >= 0x070700
     aWriter.SetParallel(true);
+    if (hGrp->GetBool("DracoCompression", false)) {
+        // requires an OCCT built with Draco, otherwise the writer fails
+        RWGltf_DracoParameters draco;
+        draco.DracoCompression = true;
+        aWriter.SetCompressionParameters(draco);
+    }
 #endif
     Standard_Boolean ret = aWriter.Perform(hDoc, aMetadata, Message_ProgressRange());
     if (!ret) {
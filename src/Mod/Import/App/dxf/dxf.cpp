@@ -5,7 +5,9 @@
 
 #include "PreCompiled.h"
 
+#include <charconv>
 #include <cmath>
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -1856,19 +1858,23 @@ void CDxfWrite::writeObjectsSection()
 const DxfUnits DxfUnits::Instance;
 
 CDxfRead::CDxfRead(const std::string& filepath)
-    : m_ifs(new ifstream(filepath))
 {
-    if (!(*m_ifs)) {
+    // The whole file is read at once, the records are then cut from the buffer without copying
+    // each line through a stream.
+    Base::FileInfo fi(filepath);
+    Base::ifstream ifs(fi, std::ios::in | std::ios::binary);
+    if (!ifs) {
         m_fail = true;
         ImportError("DXF file didn't load\n");
         return;
     }
-    m_ifs->imbue(std::locale("C"));
+    std::ostringstream content;
+    content << ifs.rdbuf();
+    m_buffer = std::move(content).str();
 }
 
 CDxfRead::~CDxfRead()
 {
-    delete m_ifs;
     // Delete the Layer objects which are referenced by pointer from the Layers table.
     for (auto& pair : Layers) {
         delete pair.second;
@@ -1924,49 +1930,78 @@ void CDxfRead::SetupValueAttribute(eDXFGroupCode_t record_type, T& destination)
 
 //
 // Static processing helpers for ProcessCommonEntityAttribute
-void CDxfRead::ProcessScaledDouble(CDxfRead* object, void* target)
+namespace
 {
-    std::istringstream ss;
-    ss.imbue(std::locale("C"));
+// Converts the number at the start of text like the "C" locale stream did, ignoring any leading
+// white space and anything after the number, but without the cost of a stream per value.
+template<typename T>
+bool ParseNumber(std::string_view text, T& value)
+{
+    auto first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string_view::npos) {
+        return false;
+    }
+    text.remove_prefix(first);
+    // from_chars doesn't accept an explicit plus sign
+    if (text.front() == '+') {
+        text.remove_prefix(1);
+    }
+    if constexpr (std::is_same_v<T, bool>) {
+        // noboolalpha streams read a bool as 0 or 1
+        int number = 0;
+        if (!ParseNumber(text, number) || (number != 0 && number != 1)) {
+            return false;
+        }
+        value = number != 0;
+        return true;
+    }
+    else if constexpr (std::is_floating_point_v<T>) {
+        // libc++ std::from_chars doesn't support double values, so the record is copied for strtod
+        char field[64];
+        std::size_t size = std::min(text.size(), sizeof(field) - 1);
+        std::copy_n(text.data(), size, field);
+        field[size] = '\0';
+        char* end = nullptr;
+        value = static_cast<T>(std::strtod(field, &end));
+        return end != field;
+    }
+    else {
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc();
+    }
+}
+}  // namespace
 
-    ss.str(object->m_record_data);
+void CDxfRead::ProcessScaledDouble(CDxfRead* object, void* target)
+{
     double value = 0;
-    ss >> value;
-    if (ss.fail()) {
+    if (!ParseNumber(object->m_record_data, value)) {
         object->ImportError("Unable to parse value '%s', using zero as its value\n",
                             object->m_record_data);
+        value = 0;
     }
     *static_cast<double*>(target) = object->mm(value);
 }
 void CDxfRead::ProcessScaledDoubleIntoList(CDxfRead* object, void* target)
 {
-    std::istringstream ss;
-    ss.imbue(std::locale("C"));
-
-    ss.str(object->m_record_data);
     double value = 0;
-    ss >> value;
-    if (ss.fail()) {
+    if (!ParseNumber(object->m_record_data, value)) {
         object->ImportError("Unable to parse value '%s', using zero as its value\n",
                             object->m_record_data);
+        value = 0;
     }
     static_cast<std::list<double>*>(target)->push_back(object->mm(value));
 }
 template<typename T>
 bool CDxfRead::ParseValue(CDxfRead* object, void* target)
 {
-    std::istringstream ss;
-    ss.imbue(std::locale("C"));
-
-    ss.str(object->m_record_data);
-    ss >> *static_cast<T*>(target);
-    if (ss.fail()) {
+    if (!ParseNumber(object->m_record_data, *static_cast<T*>(target))) {
         object->ImportError("Unable to parse value '%s', using zero as its value\n",
                             object->m_record_data);
         *static_cast<T*>(target) = 0;
         return false;
     }
-    // TODO: Verify nothing it left but whitespace in ss.
+    // TODO: Verify nothing it left but whitespace in the record.
     return true;
 }
 void CDxfRead::ProcessStdString(CDxfRead* object, void* target)
@@ -2406,6 +2441,18 @@ void CDxfRead::UnsupportedFeature(const char* format, args&&... argValuess)
                                                                m_current_entity_handle);
 }
 
+std::string_view CDxfRead::next_line()
+{
+    std::size_t end = m_buffer.find('\n', m_position);
+    if (end == std::string::npos) {
+        end = m_buffer.size();
+    }
+    std::string_view line(m_buffer.data() + m_position, end - m_position);
+    m_position = std::min(end + 1, m_buffer.size());
+    ++m_line;
+    return line;
+}
+
 bool CDxfRead::get_next_record()
 {
     if (m_repeat_last_record) {
@@ -2414,26 +2461,26 @@ bool CDxfRead::get_next_record()
     }
 
     do {
-        if ((*m_ifs).eof()) {
+        if (m_position >= m_buffer.size()) {
             m_not_eof = false;
             return false;
         }
 
-        std::getline(*m_ifs, m_record_data);
-        ++m_line;
+        std::string_view line = next_line();
         int temp = 0;
-        if (!ParseValue<int>(this, &temp)) {
+        if (!ParseNumber(line, temp)) {
+            m_record_data.assign(line);
             ImportError("CDxfRead::get_next_record() Failed to get integer record type from '%s'\n",
                         m_record_data);
             return false;
         }
         m_record_type = (eDXFGroupCode_t)temp;
-        if ((*m_ifs).eof()) {
+        if (m_position >= m_buffer.size()) {
             return false;
         }
 
-        std::getline(*m_ifs, m_record_data);
-        ++m_line;
+        // assigning keeps the capacity of the record, so it is rarely allocated again
+        m_record_data.assign(next_line());
     } while (m_record_type == eComment);
 
     // Remove any carriage return at the end of m_str which may occur because of inconsistent
@@ -19,6 +19,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <Base/Interpreter.h>
@@ -458,7 +459,9 @@ class ImportExport CDxfRead
 {
 private:
     // Low-level reader members
-    std::ifstream* m_ifs;  // TODO: gsl::owner<ifstream>
+    // The whole file, read by the constructor, and the start of the next line in it
+    std::string m_buffer;
+    std::size_t m_position = 0;
     // https://stackoverflow.com/questions/41167119/how-to-fix-a-wsubobject-linkage-warning
     eDXFGroupCode_t m_record_type = eObjectType;
     std::string m_record_data;
@@ -687,6 +690,7 @@ private:
     bool ResolveEncoding();
 
     bool get_next_record();
+    std::string_view next_line();
     void repeat_last_record();
 
     bool (CDxfRead::*stringToUTF8)(std::string&) const = &CDxfRead::UTF8ToUTF8;
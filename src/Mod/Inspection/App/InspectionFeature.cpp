@@ -26,15 +26,19 @@
 #include <boost/core/ignore_unused.hpp>
 #include <numeric>
 #include <limits>
+#include <mutex>
 
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepGProp_Face.hxx>
 #include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Shape.hxx>
 #include <gp_Pnt.hxx>
 
+#include <QElapsedTimer>
 #include <QEventLoop>
 #include <QFuture>
 #include <QFutureWatcher>
@@ -47,13 +51,14 @@
 #include <Base/Stream.h>
 
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 #include <Mod/Part/App/PartFeature.h>
 #include <Mod/Points/App/PointsFeature.h>
-#include <Mod/Points/App/PointsGrid.h>
+#include <Mod/Points/App/PointsOctree.h>
 
 #include "InspectionFeature.h"
 
@@ -283,14 +288,27 @@ private:
 
 InspectNominalMesh::InspectNominalMesh(const Mesh::MeshObject& rMesh, float offset)
     : _mesh(rMesh.getKernel())
+    , _pGrid(nullptr)
 {
     Base::Matrix4D tmp;
     _clTrf = rMesh.getTransform();
     _bApply = _clTrf != tmp;
 
+    Base::BoundBox3f box = _mesh.GetBoundBox().Transformed(rMesh.getTransform());
+    _box = box;
+    _box.Enlarge(offset);
+
+    // A rigid placement doesn't change distances, so the shared hierarchy of the mesh can be
+    // searched with the point moved into the local system of the mesh
+    if (_clTrf.hasScale() == Base::ScaleType::NoScaling) {
+        _pBVH = rMesh.getFacetBVH();
+        _clInv = _clTrf;
+        _clInv.inverse();
+        return;
+    }
+
     // Max. limit of grid elements
     float fMaxGridElements = 8000000.0f;
-    Base::BoundBox3f box = _mesh.GetBoundBox().Transformed(rMesh.getTransform());
 
     // estimate the minimum allowed grid length
     float fMinGridLen =
@@ -305,8 +323,6 @@ InspectNominalMesh::InspectNominalMesh(const Mesh::MeshObject& rMesh, float offs
 
     // build up grid structure to speed up algorithms
     _pGrid = new MeshInspectGrid(_mesh, fGridLen, rMesh.getTransform());
-    _box = box;
-    _box.Enlarge(offset);
 }
 
 InspectNominalMesh::~InspectNominalMesh()
@@ -321,8 +337,17 @@ float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
     }
 
     std::vector<unsigned long> indices;
-    //_pGrid->GetElements(point, indices);
-    if (indices.empty()) {
+    if (_pBVH) {
+        MeshCore::FacetIndex index {};
+        Base::Vector3f nearest;
+        if (_pBVH->NearestFacetToPoint(_clInv * point,
+                                       std::numeric_limits<float>::max(),
+                                       index,
+                                       nearest)) {
+            indices.push_back(index);
+        }
+    }
+    else {
         std::set<unsigned long> inds;
         _pGrid->MeshGrid::SearchNearestFromPoint(point, inds);
         indices.insert(indices.begin(), inds.begin(), inds.end());
@@ -438,36 +463,23 @@ float InspectNominalFastMesh::getDistance(const Base::Vector3f& point) const
 // ----------------------------------------------------------------
 
 InspectNominalPoints::InspectNominalPoints(const Points::PointKernel& Kernel, float /*offset*/)
-    : _rKernel(Kernel)
-{
-    int uGridPerAxis = 50;  // totally 125.000 grid elements
-    this->_pGrid = new Points::PointsGrid(Kernel, uGridPerAxis);
-}
+    : _pOctree(new Points::PointsOctree(Kernel))
+{}
 
 InspectNominalPoints::~InspectNominalPoints()
 {
-    delete this->_pGrid;
+    delete this->_pOctree;
 }
 
 float InspectNominalPoints::getDistance(const Base::Vector3f& point) const
 {
-    // TODO: Make faster
-    std::set<unsigned long> indices;
-    unsigned long x, y, z;
-    Base::Vector3d pointd(point.x, point.y, point.z);
-    _pGrid->Position(pointd, x, y, z);
-    _pGrid->GetElements(x, y, z, indices);
-
-    double fMinDist = std::numeric_limits<double>::max();
-    for (unsigned long it : indices) {
-        Base::Vector3d pt = _rKernel.getPoint(it);
-        double fDist = Base::Distance(pointd, pt);
-        if (fDist < fMinDist) {
-            fMinDist = fDist;
-        }
+    unsigned long index {};
+    float fMinDist {};
+    if (!_pOctree->NearestPoint(point, std::numeric_limits<float>::max(), index, fMinDist)) {
+        return std::numeric_limits<float>::max();
     }
 
-    return (float)fMinDist;
+    return fMinDist;
 }
 
 // ----------------------------------------------------------------
@@ -556,6 +568,96 @@ bool InspectNominalShape::isBelowFace(const gp_Pnt& pnt3d) const
 
 // ----------------------------------------------------------------
 
+InspectNominalFastShape::InspectNominalFastShape(const TopoDS_Shape& shape, float offset)
+    : _mesh(std::make_unique<MeshCore::MeshKernel>())
+    , _radius(offset)
+{
+    Part::TopoShape topo(shape);
+    _deflection = static_cast<float>(topo.getAccuracy());
+
+    // Tessellate face by face to know the face of each triangle
+    TopTools_IndexedMapOfShape mapOfFaces;
+    TopExp::MapShapes(shape, TopAbs_FACE, mapOfFaces);
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    for (int i = 1; i <= mapOfFaces.Extent(); i++) {
+        std::vector<Base::Vector3d> pts;
+        std::vector<Data::ComplexGeoData::Facet> tria;
+        Part::TopoShape(mapOfFaces(i)).getFaces(pts, tria, _deflection);
+
+        auto offsetPoint = static_cast<MeshCore::PointIndex>(points.size());
+        for (const auto& it : pts) {
+            points.push_back(MeshCore::MeshPoint(Base::toVector<float>(it)));
+        }
+        for (const auto& it : tria) {
+            facets.push_back(MeshCore::MeshFacet(offsetPoint + it.I1,
+                                                 offsetPoint + it.I2,
+                                                 offsetPoint + it.I3));
+            _facetToFace.push_back(_faces.size());
+        }
+        _faces.push_back(mapOfFaces(i));
+    }
+    _mesh->Adopt(points, facets, false);
+
+    _pBVH = std::make_unique<MeshCore::MeshFacetBVH>(*_mesh);
+    _box = _mesh->GetBoundBox();
+    _box.Enlarge(offset);
+}
+
+InspectNominalFastShape::~InspectNominalFastShape() = default;
+
+bool InspectNominalFastShape::canInspect(const TopoDS_Shape& shape)
+{
+    if (shape.IsNull()) {
+        return false;
+    }
+    TopExp_Explorer xp(shape, TopAbs_FACE);
+    return xp.More();
+}
+
+float InspectNominalFastShape::getDistance(const Base::Vector3f& point) const
+{
+    if (!_box.IsInBox(point)) {
+        return std::numeric_limits<float>::max();  // must be inside bbox
+    }
+
+    MeshCore::FacetIndex index {};
+    Base::Vector3f nearest;
+    if (!_pBVH->NearestFacetToPoint(point, std::numeric_limits<float>::max(), index, nearest)) {
+        return std::numeric_limits<float>::max();
+    }
+
+    // the triangles have the orientation of their faces, so the points below have a negative
+    // distance like with InspectNominalShape
+    MeshCore::MeshGeomFacet geomFace = _mesh->GetFacet(index);
+    float fDist = Base::Distance(point, nearest);
+    if (point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) < 0) {
+        fDist = -fDist;
+    }
+
+    // The tessellation is off by up to its deflection, that only matters if it decides whether
+    // the point is inside of the search radius
+    if (std::fabs(std::fabs(fDist) - _radius) <= _deflection) {
+        fDist = getExactDistance(point, index, fDist);
+    }
+    return fDist;
+}
+
+float InspectNominalFastShape::getExactDistance(const Base::Vector3f& point,
+                                                unsigned long facet,
+                                                float approx) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    BRepBuilderAPI_MakeVertex mkVert(gp_Pnt(point.x, point.y, point.z));
+    BRepExtrema_DistShapeShape distss(_faces[_facetToFace[facet]], mkVert.Vertex());
+    if (distss.IsDone() && distss.NbSolution() > 0) {
+        return std::copysign(static_cast<float>(distss.Value()), approx);
+    }
+    return approx;
+}
+
+// ----------------------------------------------------------------
+
 TYPESYSTEM_SOURCE(Inspection::PropertyDistanceList, App::PropertyLists)
 
 PropertyDistanceList::PropertyDistanceList() = default;
@@ -697,6 +799,16 @@ unsigned int PropertyDistanceList::getMemSize() const
 
 // ----------------------------------------------------------------
 
+namespace
+{
+// only changes of the geometry or its placement change the distances
+bool isGeometryChange(const App::Property& prop)
+{
+    return prop.isDerivedFrom<App::PropertyComplexGeoData>()
+        || prop.isDerivedFrom<App::PropertyPlacement>();
+}
+}  // namespace
+
 namespace Inspection
 {
 // helper class to use Qt's concurrent framework
@@ -761,6 +873,16 @@ public:
 };
 }  // namespace Inspection
 
+struct Feature::NominalCache
+{
+    App::DocumentObject* object {nullptr};
+    /// the distances of all points to the nominal, empty for unsupported geometries
+    std::vector<float> distances;
+    /// set when the geometry of the nominal has changed since the distances were computed
+    bool changed {true};
+    boost::signals2::scoped_connection connection;
+};
+
 PROPERTY_SOURCE(Inspection::Feature, App::DocumentObject)
 
 Feature::Feature()
@@ -774,6 +896,16 @@ Feature::Feature()
 
 Feature::~Feature() = default;
 
+void Feature::onChanged(const App::Property* prop)
+{
+    // the cached distances depend on the search radius and the actual geometry
+    if (prop == &SearchRadius || prop == &Actual) {
+        nominalCache.clear();
+        actualChanged = true;
+    }
+    App::DocumentObject::onChanged(prop);
+}
+
 short Feature::mustExecute() const
 {
     if (SearchRadius.isTouched()) {
@@ -818,11 +950,74 @@ App::DocumentObjectExecReturn* Feature::execute()
         throw Base::TypeError("Unknown geometric type");
     }
 
-    // clang-format off
-    // get a list of nominals
-    std::vector<InspectNominalGeometry*> inspectNominal;
+    // A changed actual geometry invalidates all cached distances
+    unsigned long count = actual->countPoints();
+    if (actualChanged || nearestDistance.size() != count) {
+        nominalCache.clear();
+        actualChanged = false;
+    }
+    connectActual = pcActual->signalChanged.connect(
+        [this](const App::DocumentObject&, const App::Property& prop) {
+            if (isGeometryChange(prop)) {
+                actualChanged = true;
+            }
+        });
+
+    // Keep the distances of the nominals that are still linked and only compute the distances
+    // of the new nominals and of those whose geometry has changed since the last run
     const std::vector<App::DocumentObject*>& nominals = Nominals.getValues();
-    for (auto it : nominals) {
+    std::vector<std::unique_ptr<NominalCache>> caches;
+    bool fullMerge = nominalCache.empty();
+    for (std::size_t i = 0; i < nominals.size(); i++) {
+        App::DocumentObject* obj = nominals[i];
+        auto it = std::find_if(nominalCache.begin(), nominalCache.end(), [obj](const auto& cache) {
+            return cache && cache->object == obj;
+        });
+        if (it != nominalCache.end()) {
+            // the cached index of the nearest nominal refers to the old order
+            fullMerge = fullMerge || std::size_t(it - nominalCache.begin()) != i;
+            caches.push_back(std::move(*it));
+            continue;
+        }
+
+        auto cache = std::make_unique<NominalCache>();
+        NominalCache* ptr = cache.get();
+        cache->object = obj;
+        cache->connection = obj->signalChanged.connect(
+            [ptr](const App::DocumentObject&, const App::Property& prop) {
+                if (isGeometryChange(prop)) {
+                    ptr->changed = true;
+                }
+            });
+        caches.push_back(std::move(cache));
+    }
+    // also the nominals that aren't linked anymore may be the nearest ones
+    fullMerge = fullMerge
+        || std::any_of(nominalCache.begin(), nominalCache.end(), [](const auto& cache) {
+               return cache != nullptr;
+           });
+    nominalCache = std::move(caches);
+    if (fullMerge) {
+        nearestDistance.assign(count, std::numeric_limits<float>::max());
+        nearestNominal.assign(count, -1);
+    }
+
+    // clang-format off
+    // get a list of the nominals to compute
+    std::vector<std::pair<std::size_t, std::unique_ptr<InspectNominalGeometry>>> inspectNominal;
+    std::vector<char> changedNominal(nominalCache.size());
+    for (std::size_t i = 0; i < nominalCache.size(); i++) {
+        NominalCache& cache = *nominalCache[i];
+        if (!cache.changed && !fullMerge) {
+            continue;
+        }
+        if (!cache.changed) {
+            // only the merge has to be done again
+            changedNominal[i] = 1;
+            continue;
+        }
+
+        App::DocumentObject* it = cache.object;
         InspectNominalGeometry* nominal = nullptr;
         if (it->isDerivedFrom<Mesh::Feature>()) {
             Mesh::Feature* mesh = static_cast<Mesh::Feature*>(it);
@@ -833,13 +1028,23 @@ App::DocumentObjectExecReturn* Feature::execute()
             nominal = new InspectNominalPoints(pts->Points.getValue(), this->SearchRadius.getValue());
         }
         else if (it->isDerivedFrom<Part::Feature>()) {
-            useMultithreading = false;
             Part::Feature* part = static_cast<Part::Feature*>(it);
-            nominal = new InspectNominalShape(part->Shape.getValue(), this->SearchRadius.getValue());
+            const TopoDS_Shape& shape = part->Shape.getValue();
+            if (InspectNominalFastShape::canInspect(shape)) {
+                nominal = new InspectNominalFastShape(shape, this->SearchRadius.getValue());
+            }
+            else {
+                useMultithreading = false;
+                nominal = new InspectNominalShape(shape, this->SearchRadius.getValue());
+            }
         }
 
+        cache.changed = false;
+        cache.distances.clear();
+        changedNominal[i] = 1;
         if (nominal) {
-            inspectNominal.push_back(nominal);
+            cache.distances.resize(count);
+            inspectNominal.emplace_back(i, nominal);
         }
     }
     // clang-format on
@@ -899,19 +1104,35 @@ App::DocumentObjectExecReturn* Feature::execute()
     Base::Console().message("RMS value for '%s' with search radius [%.4f,%.4f] is: %.4f\n",
         this->Label.getValue(), -this->SearchRadius.getValue(), this->SearchRadius.getValue(), fRMS);
 #else
-    unsigned long count = actual->countPoints();
     std::vector<float> vals(count);
     std::function<DistanceInspectionRMS(int)> fMap = [&](unsigned int index) {
         DistanceInspectionRMS res;
-        Base::Vector3f pnt = actual->getPoint(index);
+        if (!inspectNominal.empty()) {
+            Base::Vector3f pnt = actual->getPoint(index);
+            for (const auto& [pos, nominal] : inspectNominal) {
+                nominalCache[pos]->distances[index] = nominal->getDistance(pnt);
+            }
+        }
 
-        float fMinDist = std::numeric_limits<float>::max();
-        for (auto it : inspectNominal) {
-            float fDist = it->getDistance(pnt);
+        // If the nearest nominal hasn't changed only the changed nominals can be nearer now,
+        // otherwise all nominals have to be compared
+        int nearest = nearestNominal[index];
+        bool reuse = nearest < 0 || !changedNominal[nearest];
+        float fMinDist = reuse ? nearestDistance[index] : std::numeric_limits<float>::max();
+        nearest = reuse ? nearest : -1;
+        for (std::size_t i = 0; i < nominalCache.size(); i++) {
+            const std::vector<float>& distances = nominalCache[i]->distances;
+            if ((reuse && !changedNominal[i]) || distances.empty()) {
+                continue;
+            }
+            float fDist = distances[index];
             if (fabs(fDist) < fabs(fMinDist)) {
                 fMinDist = fDist;
+                nearest = static_cast<int>(i);
             }
         }
+        nearestDistance[index] = fMinDist;
+        nearestNominal[index] = nearest;
 
         if (fMinDist > this->SearchRadius.getValue()) {
             fMinDist = std::numeric_limits<float>::max();
@@ -931,20 +1152,46 @@ App::DocumentObjectExecReturn* Feature::execute()
     DistanceInspectionRMS res;
 
     if (useMultithreading) {
-        // Build vector of increasing indices
-        std::vector<unsigned long> index(count);
-        std::iota(index.begin(), index.end(), 0);
-        // Perform map-reduce operation : compute distances and update sum of squares for RMS
-        // computation
-        QFuture<DistanceInspectionRMS> future =
-            QtConcurrent::mappedReduced(index, fMap, &DistanceInspectionRMS::operator+=);
+        // Compute the distances in chunks of points, so the finished chunks can be shown while
+        // the others are still computed
+        const unsigned long chunkSize = 65536;
+        std::vector<std::pair<unsigned long, unsigned long>> chunks;
+        for (unsigned long first = 0; first < count; first += chunkSize) {
+            chunks.emplace_back(first, std::min(first + chunkSize, count));
+        }
+        std::function<DistanceInspectionRMS(const std::pair<unsigned long, unsigned long>&)>
+            fChunk = [&](const std::pair<unsigned long, unsigned long>& range) {
+                DistanceInspectionRMS sum;
+                for (unsigned long index = range.first; index < range.second; index++) {
+                    sum += fMap(index);
+                }
+                return sum;
+            };
+        QFuture<DistanceInspectionRMS> future = QtConcurrent::mapped(chunks, fChunk);
         // Setup progress bar
-        Base::FutureWatcherProgress progress("Inspecting...", actual->countPoints());
+        Base::FutureWatcherProgress progress("Inspecting...", chunks.size());
         QFutureWatcher<DistanceInspectionRMS> watcher;
         QObject::connect(&watcher,
                          &QFutureWatcher<DistanceInspectionRMS>::progressValueChanged,
                          &progress,
                          &Base::FutureWatcherProgress::progressValueChanged);
+        // The distances of a chunk are written before its result is reported, so they can be
+        // read from here. Show the finished chunks at most twice a second.
+        std::vector<float> partial(count, std::numeric_limits<float>::max());
+        QElapsedTimer timer;
+        timer.start();
+        QObject::connect(&watcher,
+                         &QFutureWatcher<DistanceInspectionRMS>::resultReadyAt,
+                         [&](int index) {
+                             const auto& range = chunks[index];
+                             std::copy(vals.begin() + range.first,
+                                       vals.begin() + range.second,
+                                       partial.begin() + range.first);
+                             if (timer.elapsed() > 500) {
+                                 Distances.setValues(partial);
+                                 timer.restart();
+                             }
+                         });
         // Keep UI responsive during computation
         QEventLoop loop;
         QObject::connect(&watcher,
@@ -953,7 +1200,9 @@ App::DocumentObjectExecReturn* Feature::execute()
                          &QEventLoop::quit);
         watcher.setFuture(future);
         loop.exec();
-        res = future.result();
+        for (const auto& it : future.results()) {
+            res += it;
+        }
     }
     else {
         // Single-threaded operation
@@ -975,9 +1224,6 @@ App::DocumentObjectExecReturn* Feature::execute()
 #endif
 
     delete actual;
-    for (auto it : inspectNominal) {
-        delete it;
-    }
 
     return nullptr;
 }
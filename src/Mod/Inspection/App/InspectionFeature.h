@@ -23,6 +23,10 @@
 #ifndef INSPECTION_FEATURE_H
 #define INSPECTION_FEATURE_H
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <App/DocumentObject.h>
 #include <App/DocumentObjectGroup.h>
 
@@ -38,6 +42,7 @@ namespace MeshCore
 {
 class MeshKernel;
 class MeshGrid;
+class MeshFacetBVH;
 }  // namespace MeshCore
 
 namespace Mesh
@@ -46,7 +51,7 @@ class MeshObject;
 }
 namespace Points
 {
-class PointsGrid;
+class PointsOctree;
 }
 namespace Part
 {
@@ -126,9 +131,11 @@ public:
 private:
     const MeshCore::MeshKernel& _mesh;
     MeshCore::MeshGrid* _pGrid;
+    std::shared_ptr<const MeshCore::MeshFacetBVH> _pBVH;
     Base::BoundBox3f _box;
     bool _bApply;
     Base::Matrix4D _clTrf;
+    Base::Matrix4D _clInv;
 };
 
 class InspectionExport InspectNominalFastMesh: public InspectNominalGeometry
@@ -155,8 +162,7 @@ public:
     float getDistance(const Base::Vector3f&) const override;
 
 private:
-    const Points::PointKernel& _rKernel;
-    Points::PointsGrid* _pGrid;
+    Points::PointsOctree* _pOctree;
 };
 
 class InspectionExport InspectNominalShape: public InspectNominalGeometry
@@ -176,6 +182,38 @@ private:
     bool isSolid {false};
 };
 
+/**
+ * Like InspectNominalShape but the faces of the shape are tessellated once and the nearest
+ * triangle is searched with a bounding volume hierarchy. Only points whose distance is close to
+ * the limits of the search radius get the exact distance to the face of their triangle, so they
+ * are classified like with the exact shape. Unlike InspectNominalShape it can be used from
+ * several threads.
+ */
+class InspectionExport InspectNominalFastShape: public InspectNominalGeometry
+{
+public:
+    InspectNominalFastShape(const TopoDS_Shape&, float offset);
+    ~InspectNominalFastShape() override;
+    float getDistance(const Base::Vector3f&) const override;
+    /// Returns true if the shape has faces to tessellate
+    static bool canInspect(const TopoDS_Shape&);
+
+private:
+    float getExactDistance(const Base::Vector3f&, unsigned long facet, float approx) const;
+
+private:
+    std::unique_ptr<MeshCore::MeshKernel> _mesh;
+    std::unique_ptr<MeshCore::MeshFacetBVH> _pBVH;
+    /// the faces of the shape and the face of each triangle
+    std::vector<TopoDS_Shape> _faces;
+    std::vector<unsigned long> _facetToFace;
+    Base::BoundBox3f _box;
+    float _radius;
+    float _deflection;
+    /// BRepExtrema isn't used from several threads at once
+    mutable std::mutex _mutex;
+};
+
 class InspectionExport PropertyDistanceList: public App::PropertyLists
 {
     TYPESYSTEM_HEADER_WITH_OVERRIDE();
@@ -269,6 +307,20 @@ public:
     {
         return "InspectionGui::ViewProviderInspection";
     }
+
+protected:
+    void onChanged(const App::Property* prop) override;
+
+private:
+    /// The distances to each nominal, so that only changed nominals are computed again
+    struct NominalCache;
+    std::vector<std::unique_ptr<NominalCache>> nominalCache;
+    /// The shortest distance of each point before it's limited by the search radius and the
+    /// index of the nominal it belongs to, -1 if there is none
+    std::vector<float> nearestDistance;
+    std::vector<int> nearestNominal;
+    bool actualChanged {true};
+    boost::signals2::scoped_connection connectActual;
 };
 
 class InspectionExport Group: public App::DocumentObjectGroup
@@ -28,6 +28,7 @@
 #ifdef _PreComp_
 
 // STL
+#include <mutex>
 #include <numeric>
 
 // OCC
@@ -36,13 +37,16 @@
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepGProp_Face.hxx>
 #include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Shape.hxx>
 #include <gp_Pnt.hxx>
 
 // boost
 #include <boost/core/ignore_unused.hpp>
 
 // Qt
+#include <QElapsedTimer>
 #include <QEventLoop>
 #include <QFuture>
 #include <QFutureWatcher>
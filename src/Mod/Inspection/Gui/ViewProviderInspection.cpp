@@ -424,10 +424,13 @@ void ViewProviderInspection::setDistances()
     SbColor* cols = pcColorMat->diffuseColor.startEditing();
     float* tran = pcColorMat->transparency.startEditing();
 
+    std::vector<uint32_t> colors(fValues.size());
+    pcColorBar->getPackedColors(fValues.data(), fValues.size(), colors.data());
+
     unsigned long j = 0;
     for (std::vector<float>::const_iterator jt = fValues.begin(); jt != fValues.end(); ++jt, j++) {
-        Base::Color col = pcColorBar->getColor(*jt);
-        cols[j] = SbColor(col.r, col.g, col.b);
+        float transparency {};
+        cols[j].setPackedValue(colors[j], transparency);
         if (pcColorBar->isVisible(*jt)) {
             tran[j] = 0.0f;
         }
@@ -25,6 +25,8 @@
 #include <QMetaType>
 #include <QRegularExpression>
 #include <QString>
+#include <QStringList>
+#include <QtConcurrentMap>
 
 
 #include <App/Application.h>
@@ -538,31 +540,93 @@ void MaterialLoader::dereference(const std::shared_ptr<Material>& material)
     dereference(_materialMap, material);
 }
 
+namespace
+{
+// A material card as read by one of the threads of MaterialLoader::loadLibrary()
+struct MaterialFile
+{
+    QString path;
+    bool configStyle {false};
+    bool opened {true};
+    YAML::Node yamlroot;
+    std::string error;
+};
+
+// Only reads and parses the file, so it can run for many cards at once. Errors are logged
+// afterwards by the caller.
+MaterialFile readMaterialFile(const QString& path)
+{
+    MaterialFile result;
+    result.path = path;
+    if (MaterialConfigLoader::isConfigStyle(path)) {
+        result.configStyle = true;
+        return result;
+    }
+
+    Base::FileInfo info(path.toStdString());
+    Base::ifstream fin(info);
+    if (!fin) {
+        result.opened = false;
+        return result;
+    }
+    try {
+        result.yamlroot = YAML::Load(fin);
+    }
+    catch (YAML::Exception const& e) {
+        result.error = e.what();
+    }
+    return result;
+}
+}  // namespace
+
 void MaterialLoader::loadLibrary(const std::shared_ptr<MaterialLibraryLocal>& library)
 {
     if (_materialEntryMap == nullptr) {
         _materialEntryMap = std::make_unique<std::map<QString, std::shared_ptr<MaterialEntry>>>();
     }
 
+    QStringList paths;
     QDirIterator it(library->getDirectory(), QDirIterator::Subdirectories);
     while (it.hasNext()) {
         auto pathname = it.next();
         QFileInfo file(pathname);
         if (file.isFile()) {
             if (file.suffix().toStdString() == "FCMat") {
-                try {
-                    auto model = getMaterialFromPath(library, file.canonicalFilePath());
-                    if (model) {
-                        (*_materialEntryMap)[model->getUUID()] = model;
-                    }
-                }
-                catch (const MaterialReadError&) {
-                    // Ignore the file. Error messages should have already been logged
-                }
+                paths.push_back(file.canonicalFilePath());
             }
         }
     }
 
+    // Reading and parsing the cards takes most of the time for big libraries and the cards are
+    // independent of each other. Adding them to the library stays in this thread.
+    auto files = QtConcurrent::blockingMapped<QList<MaterialFile>>(paths, readMaterialFile);
+    for (auto& file : files) {
+        try {
+            std::shared_ptr<MaterialEntry> model;
+            if (file.configStyle) {
+                model = getMaterialFromPath(library, file.path);
+            }
+            else if (!file.opened) {
+                Base::Console().error("YAML file open error: '%s'\n",
+                                      file.path.toStdString().c_str());
+            }
+            else if (!file.error.empty()) {
+                Base::Console().error("YAML parsing error: '%s'\n",
+                                      file.path.toStdString().c_str());
+                Base::Console().error("\t'%s'\n", file.error.c_str());
+            }
+            else {
+                model = getMaterialFromYAML(library, file.yamlroot, file.path);
+            }
+            if (model) {
+                (*_materialEntryMap)[model->getUUID()] = model;
+            }
+        }
+        catch (const MaterialReadError&) {
+            // Ignore the file. Error messages should have already been logged
+        }
+    }
+
     for (auto& it : *_materialEntryMap) {
         it.second->addToTree(_materialMap);
     }
@@ -256,3 +256,18 @@ std::vector<App::DocumentObject*> MeasureAngle::getSubject() const
 {
     return {Element1.getValue()};
 }
+
+//! Return the elements we are measuring
+std::vector<App::SubObjectT> MeasureAngle::getMeasuredElements() const
+{
+    std::vector<App::SubObjectT> elements;
+    for (const App::PropertyLinkSub* prop : {&Element1, &Element2}) {
+        const App::DocumentObject* object = prop->getValue();
+        const std::vector<std::string>& subElements = prop->getSubValues();
+        if (!object || subElements.empty()) {
+            return {};
+        }
+        elements.emplace_back(object, subElements.front().c_str());
+    }
+    return elements;
+}
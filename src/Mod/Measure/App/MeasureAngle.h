@@ -77,6 +77,9 @@ public:
     // Return the object we are measuring
     std::vector<App::DocumentObject*> getSubject() const override;
 
+    // Return the elements we are measuring
+    std::vector<App::SubObjectT> getMeasuredElements() const override;
+
 
     static bool getVec(App::DocumentObject& ob, std::string& subName, Base::Vector3d& vecOut);
     Base::Vector3d getLoc(App::DocumentObject& ob, std::string& subName);
@@ -167,3 +167,16 @@ std::vector<App::DocumentObject*> MeasureArea::getSubject() const
 {
     return Elements.getValues();
 }
+
+//! Return the elements we are measuring
+std::vector<App::SubObjectT> MeasureArea::getMeasuredElements() const
+{
+    const std::vector<App::DocumentObject*>& objects = Elements.getValues();
+    const std::vector<std::string>& subElements = Elements.getSubValues();
+
+    std::vector<App::SubObjectT> elements;
+    for (std::vector<App::DocumentObject*>::size_type i = 0; i < objects.size(); i++) {
+        elements.emplace_back(objects.at(i), subElements.at(i).c_str());
+    }
+    return elements;
+}
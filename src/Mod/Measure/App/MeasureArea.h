@@ -77,6 +77,9 @@ public:
     // Return the object we are measuring
     std::vector<App::DocumentObject*> getSubject() const override;
 
+    // Return the elements we are measuring
+    std::vector<App::SubObjectT> getMeasuredElements() const override;
+
 
 private:
     static bool isSupported(App::MeasureElementType type);
@@ -199,6 +199,22 @@ Base::Placement MeasureBase::getPlacement()
     return this->Placement.getValue();
 }
 
+std::vector<TopoDS_Shape>
+MeasureBase::getElementShapes(const std::vector<App::SubObjectT>& elements)
+{
+    std::vector<TopoDS_Shape> shapes;
+    shapes.reserve(elements.size());
+    for (const auto& element : elements) {
+        // resolved through the shape cache of Part, as the handlers will do
+        TopoDS_Shape shape = Part::MeasureClient::getLocatedShape(element);
+        if (shape.IsNull()) {
+            return {};
+        }
+        shapes.push_back(shape);
+    }
+    return shapes;
+}
+
 
 // Python Drawing feature ---------------------------------------------------------
 
@@ -25,7 +25,9 @@
 
 #include <Mod/Measure/MeasureGlobal.h>
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <QString>
 
 #include <App/DocumentObject.h>
@@ -77,6 +79,15 @@ public:
     // Return the objects that are measured
     virtual std::vector<App::DocumentObject*> getSubject() const;
 
+    // Return the elements that are measured, a recompute is skipped while their shapes stay
+    virtual std::vector<App::SubObjectT> getMeasuredElements() const
+    {
+        return {};
+    }
+
+    // Return the located shapes of the elements, nothing if one of them has no shape
+    static std::vector<TopoDS_Shape> getElementShapes(const std::vector<App::SubObjectT>& elements);
+
 private:
     Py::Object getProxyObject() const;
 
@@ -103,16 +114,27 @@ public:
 
     static GeometryHandler getGeometryHandler(const std::string& module)
     {
-
-        if (!hasGeometryHandler(module)) {
+        auto it = _mGeometryHandlers.find(module);
+        if (it == _mGeometryHandlers.end()) {
             return {};
         }
 
-        return _mGeometryHandlers[module];
+        return it->second;
     }
 
     static Part::MeasureInfoPtr getMeasureInfo(App::SubObjectT& subObjT)
     {
+        // Measurements of the same element share the result of the handler as long as the
+        // element keeps its shape and placement
+        TopoDS_Shape shape = Part::MeasureClient::getLocatedShape(subObjT);
+        InfoKey key {subObjT.getObject(), subObjT.getSubName()};
+        if (!shape.IsNull()) {
+            std::lock_guard<std::mutex> lock(_mInfoMutex);
+            auto it = _mInfoCache.find(key);
+            if (it != _mInfoCache.end() && it->second.first.IsEqual(shape)) {
+                return it->second.second;
+            }
+        }
 
         // Resolve App::Link
         App::DocumentObject* sub = subObjT.getSubObject();
@@ -136,7 +158,16 @@ public:
             return nullptr;
         }
 
-        return handler(subObjT);
+        auto info = handler(subObjT);
+        if (!shape.IsNull() && info && info->valid) {
+            std::lock_guard<std::mutex> lock(_mInfoMutex);
+            if (_mInfoCache.size() >= maxInfoEntries) {
+                _mInfoCache.clear();
+            }
+            // the cache holds the shape, so a later shape can't take its place in memory
+            _mInfoCache[key] = {shape, info};
+        }
+        return info;
     }
 
     static void addGeometryHandlers(const std::vector<std::string>& modules,
@@ -155,8 +186,39 @@ public:
         return (_mGeometryHandlers.count(module) > 0);
     }
 
+    // Keep the last result while the measured elements keep their shapes
+    App::DocumentObjectExecReturn* recompute() override
+    {
+        std::vector<TopoDS_Shape> shapes = getElementShapes(getMeasuredElements());
+        if (!shapes.empty() && shapes == _executedShapes) {
+            return App::DocumentObject::StdReturn;
+        }
+
+        auto ret = MeasureBase::recompute();
+        _executedShapes.clear();
+        if (ret == App::DocumentObject::StdReturn) {
+            _executedShapes = std::move(shapes);
+        }
+        return ret;
+    }
+
+    // Only reads the shapes of the measured elements, so the measurements of a document are
+    // evaluated together by the parallel recompute
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
+
 private:
+    using InfoKey = std::pair<const App::DocumentObject*, std::string>;
+    using InfoCache = std::map<InfoKey, std::pair<TopoDS_Shape, Part::MeasureInfoPtr>>;
+    static constexpr std::size_t maxInfoEntries = 1000;
+
     inline static HandlerMap _mGeometryHandlers = MeasureBaseExtendable<T>::HandlerMap();
+    inline static InfoCache _mInfoCache;
+    inline static std::mutex _mInfoMutex;
+
+    std::vector<TopoDS_Shape> _executedShapes;
 };
 
 
@@ -101,6 +101,9 @@ public:
     // Return the object we are measuring
     std::vector<App::DocumentObject*> getSubject() const override;
 
+    // Return the elements we are measuring
+    std::vector<App::SubObjectT> getMeasuredElements() const override;
+
 
 private:
     bool distanceCircleCircle(const TopoDS_Shape& shape1, const TopoDS_Shape& shape2);
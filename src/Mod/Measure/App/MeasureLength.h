@@ -74,6 +74,9 @@ public:
     // Return the object we are measuring
     std::vector<App::DocumentObject*> getSubject() const override;
 
+    // Return the elements we are measuring
+    std::vector<App::SubObjectT> getMeasuredElements() const override;
+
 
 private:
     void onChanged(const App::Property* prop) override;
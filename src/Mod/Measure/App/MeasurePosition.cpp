@@ -160,3 +160,15 @@ std::vector<App::DocumentObject*> MeasurePosition::getSubject() const
 {
     return {Element.getValue()};
 }
+
+//! Return the elements we are measuring
+std::vector<App::SubObjectT> MeasurePosition::getMeasuredElements() const
+{
+    const App::DocumentObject* object = Element.getValue();
+    const std::vector<std::string>& subElements = Element.getSubValues();
+    if (!object || subElements.empty()) {
+        return {};
+    }
+
+    return {App::SubObjectT(object, subElements.front().c_str())};
+}
@@ -188,3 +188,15 @@ std::vector<App::DocumentObject*> MeasureRadius::getSubject() const
 {
     return {Element.getValue()};
 }
+
+//! Return the elements we are measuring
+std::vector<App::SubObjectT> MeasureRadius::getMeasuredElements() const
+{
+    const App::DocumentObject* object = Element.getValue();
+    const std::vector<std::string>& subElements = Element.getSubValues();
+    if (!object || subElements.empty()) {
+        return {};
+    }
+
+    return {App::SubObjectT(object, subElements.front().c_str())};
+}
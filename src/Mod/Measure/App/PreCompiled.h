@@ -35,6 +35,7 @@
 // STL
 #include <algorithm>
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include <atomic>
+#include <iterator>
+#include <set>
+
+#include "Adjacency.h"
+#include "Algorithm.h"
+#include "Approximation.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+void MeshAdjacency::clear()
+{
+    _offsets.clear();
+    _values.clear();
+}
+
+template<class Emit>
+void MeshAdjacency::Build(std::size_t numRows, std::size_t numItems, const Emit& emit)
+{
+    clear();
+
+    // starting threads for small meshes costs more than it saves
+    const std::size_t minChunk = 10000;
+
+    // Pass 1: count the entries of every row
+    std::vector<std::size_t> counts(numRows, 0);
+    parallel_for(numItems, minChunk, [&](std::size_t begin, std::size_t end) {
+        auto add = [&counts](ElementIndex row, ElementIndex) {
+            std::atomic_ref<std::size_t>(counts[row]).fetch_add(1, std::memory_order_relaxed);
+        };
+        for (std::size_t item = begin; item < end; ++item) {
+            emit(item, add);
+        }
+    });
+
+    _offsets.resize(numRows + 1);
+    _offsets[0] = 0;
+    for (std::size_t row = 0; row < numRows; ++row) {
+        _offsets[row + 1] = _offsets[row] + counts[row];
+    }
+
+    // Pass 2: fill the rows, the counts become the write positions
+    _values.resize(_offsets.back());
+    std::copy(_offsets.begin(), _offsets.end() - 1, counts.begin());
+    parallel_for(numItems, minChunk, [&](std::size_t begin, std::size_t end) {
+        auto add = [this, &counts](ElementIndex row, ElementIndex index) {
+            std::size_t pos = std::atomic_ref<std::size_t>(counts[row])
+                                  .fetch_add(1, std::memory_order_relaxed);
+            _values[pos] = index;
+        };
+        for (std::size_t item = begin; item < end; ++item) {
+            emit(item, add);
+        }
+    });
+
+    // Sort every row and remove duplicates, counts become the unique sizes
+    parallel_for(numRows, minChunk, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t row = begin; row < end; ++row) {
+            auto first = _values.begin() + static_cast<std::ptrdiff_t>(_offsets[row]);
+            auto last = _values.begin() + static_cast<std::ptrdiff_t>(_offsets[row + 1]);
+            std::sort(first, last);
+            counts[row] = static_cast<std::size_t>(std::unique(first, last) - first);
+        }
+    });
+
+    // Close the gaps left by the duplicates
+    std::size_t pos = 0;
+    for (std::size_t row = 0; row < numRows; ++row) {
+        auto first = _values.begin() + static_cast<std::ptrdiff_t>(_offsets[row]);
+        _offsets[row] = pos;
+        std::copy(first,
+                  first + static_cast<std::ptrdiff_t>(counts[row]),
+                  _values.begin() + static_cast<std::ptrdiff_t>(pos));
+        pos += counts[row];
+    }
+    _offsets[numRows] = pos;
+    _values.resize(pos);
+    _values.shrink_to_fit();
+}
+
+// ----------------------------------------------------
+
+void MeshCompactPointToFacets::Rebuild()
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    Build(_rclMesh.CountPoints(), rFacets.size(), [&rFacets](std::size_t index, const auto& add) {
+        for (PointIndex ptIndex : rFacets[index]._aulPoints) {
+            add(ptIndex, index);
+        }
+    });
+}
+
+std::vector<FacetIndex> MeshCompactPointToFacets::GetIndices(PointIndex pos1, PointIndex pos2) const
+{
+    std::vector<FacetIndex> intersection;
+    Range set1 = (*this)[pos1];
+    Range set2 = (*this)[pos2];
+    std::set_intersection(set1.begin(),
+                          set1.end(),
+                          set2.begin(),
+                          set2.end(),
+                          std::back_inserter(intersection));
+    return intersection;
+}
+
+std::vector<FacetIndex>
+MeshCompactPointToFacets::GetIndices(PointIndex pos1, PointIndex pos2, PointIndex pos3) const
+{
+    std::vector<FacetIndex> intersection;
+    std::vector<FacetIndex> set1 = GetIndices(pos1, pos2);
+    Range set2 = (*this)[pos3];
+    std::set_intersection(set1.begin(),
+                          set1.end(),
+                          set2.begin(),
+                          set2.end(),
+                          std::back_inserter(intersection));
+    return intersection;
+}
+
+std::vector<PointIndex> MeshCompactPointToFacets::NeighbourPoints(PointIndex pos) const
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::vector<PointIndex> points;
+    for (FacetIndex it : (*this)[pos]) {
+        for (PointIndex ptIndex : rFacets[it]._aulPoints) {
+            if (ptIndex != pos) {
+                points.push_back(ptIndex);
+            }
+        }
+    }
+
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    return points;
+}
+
+void MeshCompactPointToFacets::Neighbours(FacetIndex ulFacetInd,
+                                          float fMaxDist,
+                                          MeshCollector& collect) const
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    Base::Vector3f clCenter = _rclMesh.GetFacet(ulFacetInd).GetGravityPoint();
+    float fMaxDist2 = fMaxDist * fMaxDist;
+
+    // Iterative flood fill, the regions can be too big for a recursion
+    std::set<FacetIndex> visited;
+    std::vector<FacetIndex> stack;
+    stack.push_back(ulFacetInd);
+    while (!stack.empty()) {
+        FacetIndex index = stack.back();
+        stack.pop_back();
+        if (visited.find(index) != visited.end()) {
+            continue;
+        }
+
+        const MeshFacet& face = rFacets[index];
+        if (Base::DistanceP2(clCenter, _rclMesh.GetFacet(face).GetGravityPoint()) > fMaxDist2) {
+            continue;
+        }
+
+        visited.insert(index);
+        collect.Append(_rclMesh, index);
+        for (PointIndex ptIndex : face._aulPoints) {
+            for (FacetIndex it : (*this)[ptIndex]) {
+                if (visited.find(it) == visited.end()) {
+                    stack.push_back(it);
+                }
+            }
+        }
+    }
+}
+
+Base::Vector3f MeshCompactPointToFacets::GetNormal(PointIndex pos) const
+{
+    Base::Vector3f normal;
+    for (FacetIndex it : (*this)[pos]) {
+        MeshGeomFacet f = _rclMesh.GetFacet(it);
+        normal += f.Area() * f.GetNormal();
+    }
+
+    normal.Normalize();
+    return normal;
+}
+
+//----------------------------------------------------------------------------
+
+void MeshCompactFacetToFacets::Rebuild()
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    MeshCompactPointToFacets vertexFace(_rclMesh);
+    Build(rFacets.size(), rFacets.size(), [&](std::size_t index, const auto& add) {
+        for (PointIndex ptIndex : rFacets[index]._aulPoints) {
+            for (FacetIndex face : vertexFace[ptIndex]) {
+                add(index, face);
+            }
+        }
+    });
+}
+
+std::vector<FacetIndex> MeshCompactFacetToFacets::GetIndices(FacetIndex pos1, FacetIndex pos2) const
+{
+    std::vector<FacetIndex> intersection;
+    Range set1 = (*this)[pos1];
+    Range set2 = (*this)[pos2];
+    std::set_intersection(set1.begin(),
+                          set1.end(),
+                          set2.begin(),
+                          set2.end(),
+                          std::back_inserter(intersection));
+    return intersection;
+}
+
+//----------------------------------------------------------------------------
+
+void MeshCompactPointToPoints::Rebuild()
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    Build(_rclMesh.CountPoints(), rFacets.size(), [&rFacets](std::size_t index, const auto& add) {
+        const MeshFacet& rFacet = rFacets[index];
+        PointIndex ulP0 = rFacet._aulPoints[0];
+        PointIndex ulP1 = rFacet._aulPoints[1];
+        PointIndex ulP2 = rFacet._aulPoints[2];
+
+        add(ulP0, ulP1);
+        add(ulP0, ulP2);
+        add(ulP1, ulP0);
+        add(ulP1, ulP2);
+        add(ulP2, ulP0);
+        add(ulP2, ulP1);
+    });
+}
+
+Base::Vector3f MeshCompactPointToPoints::GetNormal(PointIndex pos) const
+{
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    MeshCore::PlaneFit pf;
+    pf.AddPoint(rPoints[pos]);
+    for (PointIndex it : (*this)[pos]) {
+        pf.AddPoint(rPoints[it]);
+    }
+
+    pf.Fit();
+
+    Base::Vector3f normal = pf.GetNormal();
+    normal.Normalize();
+    return normal;
+}
+
+float MeshCompactPointToPoints::GetAverageEdgeLength(PointIndex index) const
+{
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    float len = 0.0F;
+    Range n = (*this)[index];
+    const Base::Vector3f& p = rPoints[index];
+    for (PointIndex it : n) {
+        len += Base::Distance(p, rPoints[it]);
+    }
+    return (len / static_cast<float>(n.size()));
+}
@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#ifndef MESH_ADJACENCY_H
+#define MESH_ADJACENCY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <Base/Vector3D.h>
+
+#include "Definitions.h"
+
+
+namespace MeshCore
+{
+
+class MeshCollector;
+class MeshKernel;
+
+/**
+ * The MeshAdjacency class stores for every element of a mesh the sorted indices of the
+ * adjacent elements in one contiguous array (compressed sparse row).
+ * Compared to a std::vector<std::set<>> it needs a fraction of the memory and is built
+ * without any per element allocation. The structure cannot be modified after it is built.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshAdjacency
+{
+public:
+    /// The sorted and unique indices adjacent to one element
+    class Range
+    {
+    public:
+        using value_type = ElementIndex;
+        using const_iterator = const ElementIndex*;
+
+        Range(const_iterator first, const_iterator last)
+            : first(first)
+            , last(last)
+        {}
+        const_iterator begin() const
+        {
+            return first;
+        }
+        const_iterator end() const
+        {
+            return last;
+        }
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(last - first);
+        }
+        bool empty() const
+        {
+            return first == last;
+        }
+        ElementIndex operator[](std::size_t pos) const
+        {
+            return first[pos];
+        }
+        /// Returns end() if \a index is not in the range
+        const_iterator find(ElementIndex index) const
+        {
+            const_iterator it = std::lower_bound(first, last, index);
+            return (it != last && *it == index) ? it : last;
+        }
+        std::size_t count(ElementIndex index) const
+        {
+            return find(index) != last ? 1 : 0;
+        }
+
+    private:
+        const_iterator first;
+        const_iterator last;
+    };
+
+    Range operator[](ElementIndex pos) const
+    {
+        return {_values.data() + _offsets[pos], _values.data() + _offsets[pos + 1]};
+    }
+    /// Returns the number of elements
+    std::size_t size() const
+    {
+        return _offsets.empty() ? 0 : _offsets.size() - 1;
+    }
+    void clear();
+
+protected:
+    MeshAdjacency() = default;
+
+    /** Builds up the structure for \a numRows elements in two passes over \a numItems items.
+     * For every item \a emit(item, add) must call add(row, index) for each adjacency it
+     * contributes. It is called twice per item from several threads and therefore must not
+     * have any side effects.
+     */
+    template<class Emit>
+    void Build(std::size_t numRows, std::size_t numItems, const Emit& emit);
+
+private:
+    std::vector<std::size_t> _offsets;
+    std::vector<ElementIndex> _values;
+};
+
+/**
+ * The MeshCompactPointToFacets gives access to all facets indexing a point.
+ * It is the compact replacement of MeshRefPointToFacets.
+ */
+class MeshExport MeshCompactPointToFacets: public MeshAdjacency
+{
+public:
+    /// Construction
+    explicit MeshCompactPointToFacets(const MeshKernel& rclM)
+        : _rclMesh(rclM)
+    {
+        Rebuild();
+    }
+
+    /// Rebuilds up data structure
+    void Rebuild();
+    /// Returns the facets indexing both points, i.e. the facets of an edge.
+    std::vector<FacetIndex> GetIndices(PointIndex, PointIndex) const;
+    /// Returns the facets indexing all three points.
+    std::vector<FacetIndex> GetIndices(PointIndex, PointIndex, PointIndex) const;
+    /// Returns the points of the facets around a point without the point itself.
+    std::vector<PointIndex> NeighbourPoints(PointIndex) const;
+    /// Collects all facets connected to \a ulFacetInd whose center is closer than
+    /// \a fMaxDist to the center of this facet.
+    void Neighbours(FacetIndex ulFacetInd, float fMaxDist, MeshCollector& collect) const;
+    /// Returns the area weighted normal of the facets around a point.
+    Base::Vector3f GetNormal(PointIndex) const;
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+};
+
+/**
+ * The MeshCompactFacetToFacets gives access to all facets sharing at least one point with
+ * a facet, including the facet itself.
+ * It is the compact replacement of MeshRefFacetToFacets.
+ */
+class MeshExport MeshCompactFacetToFacets: public MeshAdjacency
+{
+public:
+    /// Construction
+    explicit MeshCompactFacetToFacets(const MeshKernel& rclM)
+        : _rclMesh(rclM)
+    {
+        Rebuild();
+    }
+
+    /// Rebuilds up data structure
+    void Rebuild();
+    /// Returns an array of common facets of the passed facet indexes.
+    std::vector<FacetIndex> GetIndices(FacetIndex, FacetIndex) const;
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+};
+
+/**
+ * The MeshCompactPointToPoints gives access to all neighbour points of a point. Two points
+ * are neighbours if there is an edge indexing both points.
+ * It is the compact replacement of MeshRefPointToPoints.
+ */
+class MeshExport MeshCompactPointToPoints: public MeshAdjacency
+{
+public:
+    /// Construction
+    explicit MeshCompactPointToPoints(const MeshKernel& rclM)
+        : _rclMesh(rclM)
+    {
+        Rebuild();
+    }
+
+    /// Rebuilds up data structure
+    void Rebuild();
+    /// Returns the normal of the plane fitted through a point and its neighbours.
+    Base::Vector3f GetNormal(PointIndex) const;
+    float GetAverageEdgeLength(PointIndex) const;
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+};
+
+}  // namespace MeshCore
+
+#endif  // MESH_ADJACENCY_H
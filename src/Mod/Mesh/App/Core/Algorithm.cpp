@@ -25,10 +25,12 @@
 #include <limits>
 
 #include <Base/Console.h>
+#include <Base/MemoryArena.h>
 #include <Base/Sequencer.h>
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "BVH.h"
 #include "Elements.h"
 #include "Grid.h"
 #include "Iterator.h"
@@ -140,6 +142,15 @@ bool MeshAlgorithm::NearestFacetOnRay(const Base::Vector3f& rclPt,
     return false;
 }
 
+bool MeshAlgorithm::NearestFacetOnRay(const Base::Vector3f& rclPt,
+                                      const Base::Vector3f& rclDir,
+                                      const MeshFacetBVH& rclBVH,
+                                      Base::Vector3f& rclRes,
+                                      FacetIndex& rulFacet) const
+{
+    return rclBVH.NearestFacetOnRay(rclPt, rclDir, Mathf::PI, rclRes, rulFacet);
+}
+
 bool MeshAlgorithm::NearestFacetOnRay(const Base::Vector3f& rclPt,
                                       const Base::Vector3f& rclDir,
                                       float fMaxSearchArea,
@@ -603,7 +614,8 @@ void MeshAlgorithm::SplitBoundaryFromOpenEdges(
 void MeshAlgorithm::SplitBoundaryLoops(std::list<std::vector<PointIndex>>& aBorders)
 {
     // Count the number of open edges for each point
-    std::map<PointIndex, int> openPointDegree;
+    Base::MemoryArena arena;
+    std::pmr::map<PointIndex, int> openPointDegree(arena.resource());
     for (const auto& jt : _rclMesh._aclFacetArray) {
         for (int i = 0; i < 3; i++) {
             if (jt._aulNeighbours[i] == FACET_INDEX_MAX) {
@@ -639,7 +651,8 @@ void MeshAlgorithm::SplitBoundaryLoops(std::list<std::vector<PointIndex>>& aBord
 void MeshAlgorithm::SplitBoundaryLoops(const std::vector<PointIndex>& rBound,
                                        std::list<std::vector<PointIndex>>& aBorders)
 {
-    std::map<PointIndex, int> aPtDegree;
+    Base::MemoryArena arena;
+    std::pmr::map<PointIndex, int> aPtDegree(arena.resource());
     std::vector<PointIndex> cBound;
     for (PointIndex it : rBound) {
         int deg = (aPtDegree[it]++);
@@ -1339,7 +1352,8 @@ void MeshAlgorithm::SearchFacetsFromPolyline(const std::vector<Base::Vector3f>&
         return;  // no polygon defined
     }
 
-    std::set<FacetIndex> aclFacets;
+    Base::MemoryArena arena;
+    std::pmr::set<FacetIndex> aclFacets(arena.resource());
     for (auto pV = rclPolyline.begin(); pV < (rclPolyline.end() - 1); ++pV) {
         const Base::Vector3f &rclP0 = *pV, &rclP1 = *(pV + 1);
 
@@ -1371,7 +1385,8 @@ void MeshAlgorithm::CutBorderFacets(std::vector<FacetIndex>& raclFacetIndices,
 
     // alle gefunden "Rand"-Facetsindizes" aus dem Array loeschen
     std::vector<FacetIndex> aclResult;
-    std::set<FacetIndex> aclTmp(aclToDelete.begin(), aclToDelete.end());
+    Base::MemoryArena arena;
+    std::pmr::set<FacetIndex> aclTmp(aclToDelete.begin(), aclToDelete.end(), arena.resource());
 
     for (FacetIndex facetIndex : raclFacetIndices) {
         if (aclTmp.find(facetIndex) == aclTmp.end()) {
@@ -1515,6 +1530,17 @@ bool MeshAlgorithm::NearestPointFromPoint(const Base::Vector3f& rclPt,
     return true;
 }
 
+bool MeshAlgorithm::NearestPointFromPoint(const Base::Vector3f& rclPt,
+                                          const MeshFacetBVH& rclBVH,
+                                          FacetIndex& rclResFacetIndex,
+                                          Base::Vector3f& rclResPoint) const
+{
+    return rclBVH.NearestFacetToPoint(rclPt,
+                                      std::numeric_limits<float>::max(),
+                                      rclResFacetIndex,
+                                      rclResPoint);
+}
+
 bool MeshAlgorithm::CutWithPlane(const Base::Vector3f& clBase,
                                  const Base::Vector3f& clNormal,
                                  const MeshFacetGrid& rclGrid,
@@ -1774,7 +1800,8 @@ void MeshAlgorithm::PointsFromFacetsIndices(const std::vector<FacetIndex>& rvecI
     const MeshFacetArray& rclFAry = _rclMesh._aclFacetArray;
     const MeshPointArray& rclPAry = _rclMesh._aclPointArray;
 
-    std::set<PointIndex> setPoints;
+    Base::MemoryArena arena;
+    std::pmr::set<PointIndex> setPoints(arena.resource());
 
     for (FacetIndex facetIndex : rvecIndices) {
         for (PointIndex pointIndex : rclFAry[facetIndex]._aulPoints) {
@@ -1861,12 +1888,14 @@ Base::Vector3f MeshRefPointToFacets::GetNormal(PointIndex pos) const
 std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(const std::vector<PointIndex>& pt,
                                                            int level) const
 {
-    std::set<PointIndex> cp, nb, lp;
-    cp.insert(pt.begin(), pt.end());
-    lp.insert(pt.begin(), pt.end());
+    // the sets of each level are thrown away, only the result outlives the arena
+    Base::MemoryArena arena;
+    std::pmr::set<PointIndex> cp(pt.begin(), pt.end(), arena.resource());
+    std::pmr::set<PointIndex> lp(pt.begin(), pt.end(), arena.resource());
+    std::set<PointIndex> nb;
     auto f_it = _rclMesh.GetFacets().begin();
     for (int i = 0; i < level; i++) {
-        std::set<PointIndex> cur;
+        std::pmr::set<PointIndex> cur(arena.resource());
         for (PointIndex it : lp) {
             const std::set<FacetIndex>& ft = (*this)[it];
             for (FacetIndex jt : ft) {
@@ -1879,7 +1908,7 @@ std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(const std::vector<Poi
             }
         }
 
-        lp = cur;
+        lp.swap(cur);
         if (lp.empty()) {
             break;
         }
@@ -1912,7 +1941,8 @@ void MeshRefPointToFacets::Neighbours(FacetIndex ulFacetInd,
                                       float fMaxDist,
                                       MeshCollector& collect) const
 {
-    std::set<FacetIndex> visited;
+    Base::MemoryArena arena;
+    std::pmr::set<FacetIndex> visited(arena.resource());
     Base::Vector3f clCenter = _rclMesh.GetFacet(ulFacetInd).GetGravityPoint();
 
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
@@ -1923,7 +1953,7 @@ void MeshRefPointToFacets::SearchNeighbours(const MeshFacetArray& rFacets,
                                             FacetIndex index,
                                             const Base::Vector3f& rclCenter,
                                             float fMaxDist2,
-                                            std::set<FacetIndex>& visited,
+                                            std::pmr::set<FacetIndex>& visited,
                                             MeshCollector& collect) const
 {
     if (visited.find(index) != visited.end()) {
@@ -24,6 +24,7 @@
 #define MESHALGORITHM_H
 
 #include <map>
+#include <memory_resource>
 #include <set>
 #include <vector>
 
@@ -46,6 +47,7 @@ class MeshGeomFacet;
 class MeshGeomEdge;
 class MeshKernel;
 class MeshFacetGrid;
+class MeshFacetBVH;
 class MeshFacetArray;
 class MeshRefPointToFacets;
 class AbstractPolygonTriangulator;
@@ -99,6 +101,19 @@ public:
                            const MeshFacetGrid& rclGrid,
                            Base::Vector3f& rclRes,
                            FacetIndex& rulFacet) const;
+    /**
+     * Searches for the nearest facet to the ray defined by
+     * (\a rclPt, \a rclDir).
+     * The point \a rclRes holds the intersection point with the ray and the
+     * nearest facet with index \a rulFacet.
+     * \note This method is optimized by using a bounding volume hierarchy. Unlike a
+     * grid it keeps its efficiency for meshes with very different facet sizes.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& rclPt,
+                           const Base::Vector3f& rclDir,
+                           const MeshFacetBVH& rclBVH,
+                           Base::Vector3f& rclRes,
+                           FacetIndex& rulFacet) const;
     /**
      * Searches for the nearest facet to the ray defined by
      * (\a rclPt, \a rclDir).
@@ -356,6 +371,10 @@ public:
                                float fMaxSearchArea,
                                FacetIndex& rclResFacetIndex,
                                Base::Vector3f& rclResPoint) const;
+    bool NearestPointFromPoint(const Base::Vector3f& rclPt,
+                               const MeshFacetBVH& rclBVH,
+                               FacetIndex& rclResFacetIndex,
+                               Base::Vector3f& rclResPoint) const;
     /** Cuts the mesh with a plane. The result is a list of polylines. */
     bool CutWithPlane(const Base::Vector3f& clBase,
                       const Base::Vector3f& clNormal,
@@ -500,7 +519,7 @@ protected:
                           FacetIndex index,
                           const Base::Vector3f& rclCenter,
                           float fMaxDist,
-                          std::set<FacetIndex>& visit,
+                          std::pmr::set<FacetIndex>& visit,
                           MeshCollector& collect) const;
 
 private:
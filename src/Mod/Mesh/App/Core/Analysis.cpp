@@ -0,0 +1,416 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <boost/math/special_functions/fpclassify.hpp>
+
+#include "Adjacency.h"
+#include "Analysis.h"
+#include "BVH.h"
+#include "Definitions.h"
+#include "Functional.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+int CheckPosition(MeshAnalysis::Check check)
+{
+    int pos = 0;
+    while ((check >> pos) > 1) {
+        pos++;
+    }
+    return pos;
+}
+
+// Returns true if the facet has the directed edge p0 -> p1
+bool HasDirectedEdge(const MeshFacet& rFace, PointIndex p0, PointIndex p1)
+{
+    for (int i = 0; i < 3; i++) {
+        if (rFace._aulPoints[i] == p0 && rFace._aulPoints[(i + 1) % 3] == p1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Collects the indices found by the parallel chunks in their order
+class ChunkResults
+{
+public:
+    explicit ChunkResults(std::size_t count)
+        : count(count)
+    {}
+    template<class Pred>
+    void Collect(std::vector<ElementIndex>& result, const Pred& pred)
+    {
+        parallel_for(count, 10000, [&](std::size_t begin, std::size_t end) {
+            std::vector<ElementIndex> local;
+            for (std::size_t i = begin; i < end; i++) {
+                if (pred(i)) {
+                    local.push_back(i);
+                }
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            chunks.emplace_back(begin, std::move(local));
+        });
+        std::sort(chunks.begin(), chunks.end(), [](const auto& x, const auto& y) {
+            return x.first < y.first;
+        });
+        for (const auto& it : chunks) {
+            result.insert(result.end(), it.second.begin(), it.second.end());
+        }
+        chunks.clear();
+    }
+
+private:
+    std::size_t count;
+    std::mutex mutex;
+    std::vector<std::pair<std::size_t, std::vector<ElementIndex>>> chunks;
+};
+}  // namespace
+
+MeshAnalysis::MeshAnalysis(const MeshKernel& rclM, int checks)
+    : MeshEvaluation(rclM)
+    , fEpsilon(MeshDefinitions::_fMinPointDistanceP2)
+    , checks(checks)
+{}
+
+std::vector<ElementIndex>& MeshAnalysis::Result(Check check)
+{
+    return results[CheckPosition(check)];
+}
+
+const std::vector<ElementIndex>& MeshAnalysis::GetIndices(Check check) const
+{
+    return results[CheckPosition(check)];
+}
+
+bool MeshAnalysis::Evaluate()
+{
+    for (auto& it : results) {
+        it.clear();
+    }
+    intersections.clear();
+    orientationFlip = false;
+    validNeighbourhood = true;
+
+    // Stage 1: the checks that every other check relies on
+    CheckIndices();
+    if (HasDefects(RangeFacet) || HasDefects(RangePoint)) {
+        return false;
+    }
+
+    const bool geometry = !HasDefects(NaNPoints);
+    const bool edgeChecks = IsSelected(NonManifoldEdges) || IsSelected(InvalidNeighbourhood)
+        || IsSelected(Orientation);
+
+    // Stage 2: build the shared structures concurrently
+    std::vector<Edge_Index> edges;
+    std::unique_ptr<MeshCompactPointToFacets> pointFacets;
+    std::unique_ptr<MeshCompactPointToPoints> pointPoints;
+    std::unique_ptr<MeshFacetBVH> bvh;
+
+    std::vector<std::future<void>> build;
+    if (edgeChecks) {
+        build.push_back(std::async(std::launch::async, [&]() {
+            edges = GetSortedEdges(_rclMesh.GetFacets(), 0);
+        }));
+    }
+    if (IsSelected(NonManifoldPoints)) {
+        build.push_back(std::async(std::launch::async, [&]() {
+            pointFacets = std::make_unique<MeshCompactPointToFacets>(_rclMesh);
+        }));
+        build.push_back(std::async(std::launch::async, [&]() {
+            pointPoints = std::make_unique<MeshCompactPointToPoints>(_rclMesh);
+        }));
+    }
+    if (geometry && IsSelected(SelfIntersections)) {
+        build.push_back(std::async(std::launch::async, [&]() {
+            bvh = std::make_unique<MeshFacetBVH>(_rclMesh);
+        }));
+    }
+    for (auto& it : build) {
+        it.get();
+    }
+
+    // Stage 3: the checks are independent of each other and only read the mesh
+    std::vector<std::future<void>> tasks;
+    if (edgeChecks) {
+        tasks.push_back(std::async(std::launch::async, [&]() {
+            CheckEdges(edges);
+        }));
+    }
+    if (IsSelected(NonManifoldPoints)) {
+        tasks.push_back(std::async(std::launch::async, [&]() {
+            // for an inner point the number of adjacent points is equal to the number of
+            // shared facets, for a boundary point it's higher by one
+            ChunkResults chunks(_rclMesh.CountPoints());
+            chunks.Collect(Result(NonManifoldPoints), [&](std::size_t index) {
+                return (*pointPoints)[index].size() > (*pointFacets)[index].size() + 1;
+            });
+        }));
+    }
+    if (geometry && IsSelected(DuplicatedPoints)) {
+        tasks.push_back(std::async(std::launch::async, [this]() {
+            CheckDuplicatedPoints();
+        }));
+    }
+    if (IsSelected(DuplicatedFacets)) {
+        tasks.push_back(std::async(std::launch::async, [this]() {
+            CheckDuplicatedFacets();
+        }));
+    }
+    if (geometry && IsSelected(DegeneratedFacets)) {
+        tasks.push_back(std::async(std::launch::async, [this]() {
+            CheckDegeneratedFacets();
+        }));
+    }
+    if (geometry && IsSelected(SelfIntersections)) {
+        CheckSelfIntersections(*bvh);
+    }
+    for (auto& it : tasks) {
+        it.get();
+    }
+
+    // The wrongly oriented facets are searched by a region growing over the neighbours
+    // which is only meaningful if the neighbourhood is valid. It sets facet flags, so
+    // it must not run concurrently with the other checks.
+    if (orientationFlip) {
+        if (!validNeighbourhood) {
+            std::sort(Result(Orientation).begin(), Result(Orientation).end());
+            Result(Orientation).erase(
+                std::unique(Result(Orientation).begin(), Result(Orientation).end()),
+                Result(Orientation).end());
+        }
+        else {
+            MeshEvalOrientation eval(_rclMesh);
+            Result(Orientation) = eval.GetIndices();
+        }
+    }
+
+    return std::all_of(results.begin(), results.end(), [](const auto& it) {
+        return it.empty();
+    });
+}
+
+void MeshAnalysis::CheckIndices()
+{
+    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    const FacetIndex ctFacets = rFaces.size();
+    const PointIndex ctPoints = rPoints.size();
+
+    // all other checks rely on valid indices, so these checks are always done
+    ChunkResults neighbours(ctFacets);
+    neighbours.Collect(Result(RangeFacet), [&](std::size_t index) {
+        const MeshFacet& rFace = rFaces[index];
+        return std::any_of(rFace._aulNeighbours,
+                           rFace._aulNeighbours + 3,
+                           [ctFacets](FacetIndex nb) {
+                               return nb >= ctFacets && nb < FACET_INDEX_MAX;
+                           });
+    });
+
+    ChunkResults range(ctFacets);
+    range.Collect(Result(RangePoint), [&](std::size_t index) {
+        const MeshFacet& rFace = rFaces[index];
+        return std::any_of(rFace._aulPoints, rFace._aulPoints + 3, [ctPoints](PointIndex pt) {
+            return pt >= ctPoints;
+        });
+    });
+
+    if (IsSelected(CorruptedFacets)) {
+        ChunkResults chunks(ctFacets);
+        chunks.Collect(Result(CorruptedFacets), [&](std::size_t index) {
+            return rFaces[index].IsDegenerated();
+        });
+    }
+
+    ChunkResults nan(ctPoints);
+    nan.Collect(Result(NaNPoints), [&](std::size_t index) {
+        const MeshPoint& rPoint = rPoints[index];
+        return boost::math::isnan(rPoint.x) || boost::math::isnan(rPoint.y)
+            || boost::math::isnan(rPoint.z);
+    });
+}
+
+void MeshAnalysis::CheckEdges(const std::vector<Edge_Index>& edges)
+{
+    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
+    std::vector<ElementIndex>& nonManifolds = Result(NonManifoldEdges);
+    std::vector<ElementIndex>& neighbourhood = Result(InvalidNeighbourhood);
+    std::vector<ElementIndex>& orientation = Result(Orientation);
+
+    // handles the facets sharing the edge [first, last)
+    auto checkEdge = [&](const Edge_Index* first, const Edge_Index* last) {
+        const std::size_t count = last - first;
+        const PointIndex p0 = first->p0;
+        const PointIndex p1 = first->p1;
+        if (count > 2) {
+            if (IsSelected(NonManifoldEdges)) {
+                for (const Edge_Index* it = first; it != last; ++it) {
+                    nonManifolds.push_back(it->f);
+                }
+            }
+        }
+        else if (count == 2) {
+            FacetIndex f0 = first->f;
+            FacetIndex f1 = (first + 1)->f;
+            const MeshFacet& rFace0 = rFaces[f0];
+            const MeshFacet& rFace1 = rFaces[f1];
+            if (rFace0._aulNeighbours[rFace0.Side(p0, p1)] != f1
+                || rFace1._aulNeighbours[rFace1.Side(p0, p1)] != f0) {
+                neighbourhood.push_back(f0);
+                neighbourhood.push_back(f1);
+            }
+            // adjacent facets with the same orientation traverse the edge in opposite direction
+            if (HasDirectedEdge(rFace0, p0, p1) == HasDirectedEdge(rFace1, p0, p1)) {
+                orientationFlip = true;
+                orientation.push_back(f0);
+                orientation.push_back(f1);
+            }
+        }
+        else {
+            const MeshFacet& rFace = rFaces[first->f];
+            if (rFace._aulNeighbours[rFace.Side(p0, p1)] != FACET_INDEX_MAX) {
+                neighbourhood.push_back(first->f);
+            }
+        }
+    };
+
+    const Edge_Index* data = edges.data();
+    const Edge_Index* end = data + edges.size();
+    for (const Edge_Index* first = data; first != end;) {
+        const Edge_Index* last = first + 1;
+        while (last != end && last->p0 == first->p0 && last->p1 == first->p1) {
+            ++last;
+        }
+        checkEdge(first, last);
+        first = last;
+    }
+
+    for (auto* it : {&nonManifolds, &neighbourhood}) {
+        std::sort(it->begin(), it->end());
+        it->erase(std::unique(it->begin(), it->end()), it->end());
+    }
+    validNeighbourhood = neighbourhood.empty();
+    if (!IsSelected(InvalidNeighbourhood)) {
+        neighbourhood.clear();
+    }
+    if (!IsSelected(Orientation)) {
+        orientation.clear();
+        orientationFlip = false;
+    }
+}
+
+void MeshAnalysis::CheckDuplicatedPoints()
+{
+    // Sort the point indices by the points and then by the index, so that from every group
+    // of equal points all but the one with the lowest index are reported. The '<' operator of
+    // MeshPoint is used as MeshBuilder and MeshEvalDuplicatePoints do.
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    std::vector<PointIndex> indices(rPoints.size());
+    for (PointIndex i = 0; i < indices.size(); i++) {
+        indices[i] = i;
+    }
+
+    const int threads = MeshDefinitions::GetMaxThreadCount();
+    auto less = [&rPoints](PointIndex x, PointIndex y) {
+        if (rPoints[x] < rPoints[y]) {
+            return true;
+        }
+        if (rPoints[y] < rPoints[x]) {
+            return false;
+        }
+        return x < y;
+    };
+    parallel_sort(indices.begin(), indices.end(), less, threads);
+
+    std::vector<ElementIndex>& result = Result(DuplicatedPoints);
+    for (std::size_t i = 1; i < indices.size(); i++) {
+        const MeshPoint& prev = rPoints[indices[i - 1]];
+        const MeshPoint& curr = rPoints[indices[i]];
+        if (!(prev < curr) && !(curr < prev)) {
+            result.push_back(indices[i]);
+        }
+    }
+    std::sort(result.begin(), result.end());
+}
+
+void MeshAnalysis::CheckDuplicatedFacets()
+{
+    // Two facets are duplicates if they reference the same three points in any order
+    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
+    using Key = std::array<PointIndex, 3>;
+    std::vector<std::pair<Key, FacetIndex>> keys(rFaces.size());
+    parallel_for(rFaces.size(), 10000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& rFace = rFaces[i];
+            Key key {rFace._aulPoints[0], rFace._aulPoints[1], rFace._aulPoints[2]};
+            std::sort(key.begin(), key.end());
+            keys[i] = std::make_pair(key, FacetIndex(i));
+        }
+    });
+
+    const int threads = MeshDefinitions::GetMaxThreadCount();
+    parallel_sort(keys.begin(), keys.end(), std::less<>(), threads);
+
+    std::vector<ElementIndex>& result = Result(DuplicatedFacets);
+    for (std::size_t i = 1; i < keys.size(); i++) {
+        if (keys[i - 1].first == keys[i].first) {
+            result.push_back(keys[i].second);
+        }
+    }
+    std::sort(result.begin(), result.end());
+}
+
+void MeshAnalysis::CheckDegeneratedFacets()
+{
+    ChunkResults chunks(_rclMesh.CountFacets());
+    chunks.Collect(Result(DegeneratedFacets), [this](std::size_t index) {
+        return _rclMesh.GetFacet(FacetIndex(index)).IsDegenerated(fEpsilon);
+    });
+}
+
+void MeshAnalysis::CheckSelfIntersections(const MeshFacetBVH& bvh)
+{
+    MeshEvalSelfIntersection eval(_rclMesh);
+    eval.GetIntersections(bvh, intersections);
+
+    std::vector<ElementIndex>& result = Result(SelfIntersections);
+    for (const auto& it : intersections) {
+        result.push_back(it.first);
+        result.push_back(it.second);
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+}
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#ifndef MESH_ANALYSIS_H
+#define MESH_ANALYSIS_H
+
+#include <array>
+#include <vector>
+
+#include "Evaluation.h"
+
+
+namespace MeshCore
+{
+
+class MeshFacetBVH;
+
+/**
+ * The MeshAnalysis class runs several evaluations in one go and shares the acceleration
+ * structures between them. Instead of building the sorted edge list, the adjacencies and
+ * the bounding volume hierarchy once per check they are built once, concurrently, and the
+ * independent checks run as concurrent tasks.
+ *
+ * The range checks and the check for NaN points are always done. The other checks rely on
+ * valid indices and are only done if the range checks passed, the geometric checks are
+ * skipped if there are NaN points. The results are point indices for
+ * NaNPoints, DuplicatedPoints and NonManifoldPoints and facet indices for all other checks.
+ * Folds and points on edges are not covered, use the classes of Degeneration.h for them.
+ */
+class MeshExport MeshAnalysis: public MeshEvaluation
+{
+public:
+    enum Check
+    {
+        RangeFacet = 1 << 0,
+        RangePoint = 1 << 1,
+        CorruptedFacets = 1 << 2,
+        NaNPoints = 1 << 3,
+        DuplicatedPoints = 1 << 4,
+        DuplicatedFacets = 1 << 5,
+        DegeneratedFacets = 1 << 6,
+        NonManifoldEdges = 1 << 7,
+        NonManifoldPoints = 1 << 8,
+        InvalidNeighbourhood = 1 << 9,
+        Orientation = 1 << 10,
+        SelfIntersections = 1 << 11,
+        All = (1 << 12) - 1
+    };
+
+    explicit MeshAnalysis(const MeshKernel& rclM, int checks = All);
+
+    /// Sets the tolerance for the degenerated facets, see MeshEvalDegeneratedFacets
+    void SetEpsilonDegenerated(float eps)
+    {
+        fEpsilon = eps;
+    }
+    /// Runs all selected checks and returns false if any of them found a defect
+    bool Evaluate() override;
+    /// Returns the defective elements of \a check found by the last run of Evaluate()
+    const std::vector<ElementIndex>& GetIndices(Check check) const;
+    bool HasDefects(Check check) const
+    {
+        return !GetIndices(check).empty();
+    }
+    /// Returns the pairs of intersecting facets found by the last run of Evaluate()
+    const std::vector<std::pair<FacetIndex, FacetIndex>>& GetSelfIntersections() const
+    {
+        return intersections;
+    }
+
+private:
+    bool IsSelected(Check check) const
+    {
+        return (checks & check) != 0;
+    }
+    std::vector<ElementIndex>& Result(Check check);
+    void CheckIndices();
+    void CheckEdges(const std::vector<Edge_Index>& edges);
+    void CheckDuplicatedPoints();
+    void CheckDuplicatedFacets();
+    void CheckDegeneratedFacets();
+    void CheckSelfIntersections(const MeshFacetBVH& bvh);
+
+private:
+    static constexpr int numChecks = 12;
+    std::array<std::vector<ElementIndex>, numChecks> results;
+    std::vector<std::pair<FacetIndex, FacetIndex>> intersections;
+    float fEpsilon;
+    int checks;
+    bool orientationFlip = false;
+    bool validNeighbourhood = true;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_ANALYSIS_H
@@ -144,29 +144,32 @@ float PlaneFit::Fit()
         return std::numeric_limits<float>::max();
     }
 
-    double sxx {0.0};
-    double sxy {0.0};
-    double sxz {0.0};
-    double syy {0.0};
-    double syz {0.0};
-    double szz {0.0};
-    double mx {0.0};
-    double my {0.0};
-    double mz {0.0};
-
+    Moments moments;
     for (const auto& vPoint : _vPoints) {
-        sxx += double(vPoint.x * vPoint.x);
-        sxy += double(vPoint.x * vPoint.y);
-        sxz += double(vPoint.x * vPoint.z);
-        syy += double(vPoint.y * vPoint.y);
-        syz += double(vPoint.y * vPoint.z);
-        szz += double(vPoint.z * vPoint.z);
-        mx += double(vPoint.x);
-        my += double(vPoint.y);
-        mz += double(vPoint.z);
-    }
-
-    size_t nSize = _vPoints.size();
+        moments.Add(vPoint);
+    }
+
+    return Fit(moments);
+}
+
+float PlaneFit::Fit(const Moments& moments)
+{
+    _bIsFitted = true;
+    if (moments.count < 3) {
+        return std::numeric_limits<float>::max();
+    }
+
+    double sxx = moments.sxx;
+    double sxy = moments.sxy;
+    double sxz = moments.sxz;
+    double syy = moments.syy;
+    double syz = moments.syz;
+    double szz = moments.szz;
+    double mx = moments.mx;
+    double my = moments.my;
+    double mz = moments.mz;
+
+    size_t nSize = moments.count;
     sxx = sxx - mx * mx / (double(nSize));
     sxy = sxy - mx * my / (double(nSize));
     sxz = sxz - mx * mz / (double(nSize));
@@ -215,6 +215,32 @@ protected:
 class MeshExport PlaneFit: public Approximation
 {
 public:
+    /**
+     * The running sums of a set of points. They allow to refit the plane after adding
+     * further points without iterating over all points again.
+     */
+    struct Moments
+    {
+        double sxx {0.0}, sxy {0.0}, sxz {0.0};
+        double syy {0.0}, syz {0.0}, szz {0.0};
+        double mx {0.0}, my {0.0}, mz {0.0};
+        std::size_t count {0};
+
+        void Add(const Base::Vector3f& pnt)
+        {
+            sxx += double(pnt.x * pnt.x);
+            sxy += double(pnt.x * pnt.y);
+            sxz += double(pnt.x * pnt.z);
+            syy += double(pnt.y * pnt.y);
+            syz += double(pnt.y * pnt.z);
+            szz += double(pnt.z * pnt.z);
+            mx += double(pnt.x);
+            my += double(pnt.y);
+            mz += double(pnt.z);
+            count++;
+        }
+    };
+
     PlaneFit();
     Base::Vector3f GetBase() const;
     Base::Vector3f GetDirU() const;
@@ -229,6 +255,11 @@ public:
      * to succeed. If the fit fails FLOAT_MAX is returned.
      */
     float Fit() override;
+    /**
+     * Fit a plane into the points whose sums are given by \a moments instead of the
+     * added points. The result is the same as of Fit() for these points.
+     */
+    float Fit(const Moments& moments);
     /**
      * Returns the distance from the point \a rcPoint to the fitted plane. If Fit() has not been
      * called FLOAT_MAX is returned.
@@ -0,0 +1,534 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <numeric>
+
+#include "BVH.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+constexpr int numBins = 16;
+// the node pairs below this depth are distributed to the threads
+constexpr int splitDepth = 8;
+
+float SurfaceArea(const Base::BoundBox3f& box)
+{
+    float dx = box.LengthX();
+    float dy = box.LengthY();
+    float dz = box.LengthZ();
+    return 2.0F * (dx * dy + dy * dz + dz * dx);
+}
+
+// Computes the parameter range of the line rclPt + t * rclDir inside the box
+bool LineInBox(const Base::BoundBox3f& box,
+               const Base::Vector3f& rclPt,
+               const Base::Vector3f& rclDir,
+               float& tmin,
+               float& tmax)
+{
+    const std::array<float, 3> pnt {rclPt.x, rclPt.y, rclPt.z};
+    const std::array<float, 3> dir {rclDir.x, rclDir.y, rclDir.z};
+    const std::array<float, 3> low {box.MinX, box.MinY, box.MinZ};
+    const std::array<float, 3> high {box.MaxX, box.MaxY, box.MaxZ};
+
+    tmin = -std::numeric_limits<float>::max();
+    tmax = std::numeric_limits<float>::max();
+    for (int i = 0; i < 3; i++) {
+        if (dir[i] == 0.0F) {
+            if (pnt[i] < low[i] || pnt[i] > high[i]) {
+                return false;
+            }
+            continue;
+        }
+        float t1 = (low[i] - pnt[i]) / dir[i];
+        float t2 = (high[i] - pnt[i]) / dir[i];
+        tmin = std::max(tmin, std::min(t1, t2));
+        tmax = std::min(tmax, std::max(t1, t2));
+    }
+    return tmin <= tmax;
+}
+
+// Computes the squared distance of the point to the box, 0 if it's inside
+float DistanceP2(const Base::BoundBox3f& box, const Base::Vector3f& rclPt)
+{
+    float dx = std::max({box.MinX - rclPt.x, 0.0F, rclPt.x - box.MaxX});
+    float dy = std::max({box.MinY - rclPt.y, 0.0F, rclPt.y - box.MaxY});
+    float dz = std::max({box.MinZ - rclPt.z, 0.0F, rclPt.z - box.MaxZ});
+    return dx * dx + dy * dy + dz * dz;
+}
+}  // namespace
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& rclM, unsigned int leafSize)
+    : _rclMesh(rclM)
+    , _leafSize(std::max(leafSize, 1U))
+{
+    Rebuild();
+}
+
+void MeshFacetBVH::Rebuild()
+{
+    const std::size_t count = _rclMesh.CountFacets();
+    _nodes.clear();
+    _facets.resize(count);
+    _boxes.resize(count);
+    std::iota(_facets.begin(), _facets.end(), FacetIndex(0));
+    if (count == 0) {
+        return;
+    }
+
+    std::vector<Base::Vector3f> centers(count);
+    parallel_for(count, 10000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            _boxes[i] = _rclMesh.GetFacet(FacetIndex(i)).GetBoundBox();
+            centers[i] = _boxes[i].GetCenter();
+        }
+    });
+
+    _nodes.reserve(2 * count / _leafSize + 1);
+    _nodes.emplace_back();
+    Build(0, 0, static_cast<uint32_t>(count), centers);
+}
+
+void MeshFacetBVH::Build(uint32_t node,
+                         uint32_t first,
+                         uint32_t count,
+                         std::vector<Base::Vector3f>& centers)
+{
+    auto begin = _facets.begin() + first;
+    auto end = begin + count;
+
+    Base::BoundBox3f box;
+    Base::BoundBox3f centerBox;
+    for (auto it = begin; it != end; ++it) {
+        box.Add(_boxes[*it]);
+        centerBox.Add(centers[*it]);
+    }
+    _nodes[node].box = box;
+
+    auto makeLeaf = [&]() {
+        _nodes[node].first = first;
+        _nodes[node].count = count;
+    };
+    if (count <= _leafSize) {
+        makeLeaf();
+        return;
+    }
+
+    // split along the longest axis of the facet centers
+    const std::array<float, 3> extent {centerBox.LengthX(),
+                                       centerBox.LengthY(),
+                                       centerBox.LengthZ()};
+    const int axis = int(std::max_element(extent.begin(), extent.end()) - extent.begin());
+    const float low = axis == 0 ? centerBox.MinX : (axis == 1 ? centerBox.MinY : centerBox.MinZ);
+    if (extent[axis] <= 0.0F) {
+        // all centers coincide
+        makeLeaf();
+        return;
+    }
+
+    const float scale = float(numBins) / extent[axis];
+    auto binOf = [&](FacetIndex index) {
+        const Base::Vector3f& center = centers[index];
+        float value = axis == 0 ? center.x : (axis == 1 ? center.y : center.z);
+        return std::min(int((value - low) * scale), numBins - 1);
+    };
+
+    std::array<Base::BoundBox3f, numBins> binBoxes;
+    std::array<uint32_t, numBins> binCounts {};
+    for (auto it = begin; it != end; ++it) {
+        int bin = binOf(*it);
+        binBoxes[bin].Add(_boxes[*it]);
+        binCounts[bin]++;
+    }
+
+    // sweep from the right to get the cost of all right sides
+    std::array<float, numBins> rightCost {};
+    Base::BoundBox3f accum;
+    uint32_t accumCount = 0;
+    for (int i = numBins - 1; i > 0; i--) {
+        if (binCounts[i] > 0) {
+            accum.Add(binBoxes[i]);
+            accumCount += binCounts[i];
+        }
+        rightCost[i] = accumCount > 0 ? SurfaceArea(accum) * float(accumCount) : 0.0F;
+    }
+
+    int bestSplit = 0;
+    float bestCost = std::numeric_limits<float>::max();
+    accum = Base::BoundBox3f();
+    accumCount = 0;
+    for (int i = 1; i < numBins; i++) {
+        if (binCounts[i - 1] > 0) {
+            accum.Add(binBoxes[i - 1]);
+            accumCount += binCounts[i - 1];
+        }
+        if (accumCount == 0 || accumCount == count) {
+            continue;
+        }
+        float cost = SurfaceArea(accum) * float(accumCount) + rightCost[i];
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestSplit = i;
+        }
+    }
+
+    // a split must be cheaper than testing all facets, unless the leaf gets too big
+    const float leafCost = SurfaceArea(box) * float(count);
+    if (bestSplit == 0 || (bestCost >= leafCost && count <= 4 * _leafSize)) {
+        makeLeaf();
+        return;
+    }
+
+    auto mid = std::partition(begin, end, [&](FacetIndex index) {
+        return binOf(index) < bestSplit;
+    });
+    const auto leftCount = static_cast<uint32_t>(mid - begin);
+
+    uint32_t left = static_cast<uint32_t>(_nodes.size());
+    _nodes.emplace_back();
+    Build(left, first, leftCount, centers);
+
+    uint32_t right = static_cast<uint32_t>(_nodes.size());
+    _nodes.emplace_back();
+    _nodes[node].first = right;
+    Build(right, first + leftCount, count - leftCount, centers);
+}
+
+Base::BoundBox3f MeshFacetBVH::GetBoundBox() const
+{
+    return _nodes.empty() ? Base::BoundBox3f() : _nodes.front().box;
+}
+
+void MeshFacetBVH::Inside(const Base::BoundBox3f& rclBB, std::vector<FacetIndex>& raulFacets) const
+{
+    Collect(
+        [&rclBB](const Base::BoundBox3f& box) {
+            return box && rclBB;
+        },
+        raulFacets);
+}
+
+void MeshFacetBVH::Collect(const BoxFilter& filter, std::vector<FacetIndex>& raulFacets) const
+{
+    if (_nodes.empty()) {
+        return;
+    }
+
+    std::vector<uint32_t> stack {0};
+    while (!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        uint32_t index = stack.back();
+        stack.pop_back();
+        if (!filter(node.box)) {
+            continue;
+        }
+        if (node.IsLeaf()) {
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                if (filter(_boxes[_facets[i]])) {
+                    raulFacets.push_back(_facets[i]);
+                }
+            }
+        }
+        else {
+            stack.push_back(node.first);
+            stack.push_back(index + 1);
+        }
+    }
+}
+
+bool MeshFacetBVH::NearestFacetOnRay(const Base::Vector3f& rclPt,
+                                     const Base::Vector3f& rclDir,
+                                     float fMaxAngle,
+                                     Base::Vector3f& rclRes,
+                                     FacetIndex& rulFacet) const
+{
+    // Foraminate() intersects the whole line, so the distance to the point is minimized
+    // in both directions
+    const float length = rclDir.Length();
+    auto lowerBound = [&](const Base::BoundBox3f& box, float& dist) {
+        float tmin {}, tmax {};
+        if (!LineInBox(box, rclPt, rclDir, tmin, tmax)) {
+            return false;
+        }
+        dist = (tmin <= 0.0F && tmax >= 0.0F) ? 0.0F
+                                               : std::min(std::fabs(tmin), std::fabs(tmax)) * length;
+        return true;
+    };
+
+    float nodeDist {};
+    if (_nodes.empty() || !lowerBound(_nodes.front().box, nodeDist)) {
+        return false;
+    }
+
+    bool found = false;
+    float bestDist = std::numeric_limits<float>::max();
+    std::vector<std::pair<float, uint32_t>> stack {{nodeDist, 0}};
+    while (!stack.empty()) {
+        auto [dist, index] = stack.back();
+        stack.pop_back();
+        if (dist > bestDist) {
+            continue;
+        }
+
+        const Node& node = _nodes[index];
+        if (node.IsLeaf()) {
+            Base::Vector3f res;
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                FacetIndex facet = _facets[i];
+                if (_rclMesh.GetFacet(facet).Foraminate(rclPt, rclDir, res, fMaxAngle)) {
+                    float len = (res - rclPt).Length();
+                    // for equal distances the lowest index wins as with a linear search
+                    if (!found || len < bestDist || (len == bestDist && facet < rulFacet)) {
+                        found = true;
+                        bestDist = len;
+                        rclRes = res;
+                        rulFacet = facet;
+                    }
+                }
+            }
+        }
+        else {
+            // visit the closer child first
+            float distL {}, distR {};
+            bool hitL = lowerBound(_nodes[index + 1].box, distL);
+            bool hitR = lowerBound(_nodes[node.first].box, distR);
+            if (hitL && hitR && distL < distR) {
+                stack.emplace_back(distR, node.first);
+                stack.emplace_back(distL, index + 1);
+            }
+            else {
+                if (hitL) {
+                    stack.emplace_back(distL, index + 1);
+                }
+                if (hitR) {
+                    stack.emplace_back(distR, node.first);
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+std::vector<MeshFacetBVH::RayHit>
+MeshFacetBVH::NearestFacetsOnRays(const std::vector<Ray>& rays, float fMaxAngle) const
+{
+    std::vector<RayHit> hits(rays.size(), RayHit(FACET_INDEX_MAX, Base::Vector3f()));
+    parallel_for(rays.size(), 64, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            RayHit& hit = hits[i];
+            if (!NearestFacetOnRay(rays[i].first, rays[i].second, fMaxAngle, hit.second, hit.first)) {
+                hit.first = FACET_INDEX_MAX;
+            }
+        }
+    });
+    return hits;
+}
+
+bool MeshFacetBVH::NearestFacetToPoint(const Base::Vector3f& rclPt,
+                                       float fMaxDist,
+                                       FacetIndex& rulFacet,
+                                       Base::Vector3f& rclRes) const
+{
+    if (_nodes.empty()) {
+        return false;
+    }
+
+    // compare squared distances of the boxes and exact distances of the facets
+    bool found = false;
+    float bestDist = fMaxDist;
+    float bestDistP2 = fMaxDist < std::sqrt(std::numeric_limits<float>::max())
+        ? fMaxDist * fMaxDist
+        : std::numeric_limits<float>::max();
+    std::vector<std::pair<float, uint32_t>> stack {{DistanceP2(_nodes.front().box, rclPt), 0}};
+    while (!stack.empty()) {
+        auto [distP2, index] = stack.back();
+        stack.pop_back();
+        if (distP2 > bestDistP2) {
+            continue;
+        }
+
+        const Node& node = _nodes[index];
+        if (node.IsLeaf()) {
+            Base::Vector3f res;
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                FacetIndex facet = _facets[i];
+                if (DistanceP2(_boxes[facet], rclPt) > bestDistP2) {
+                    continue;
+                }
+                float dist = _rclMesh.GetFacet(facet).DistanceToPoint(rclPt, res);
+                // for equal distances the lowest index wins as with a linear search
+                if (dist < bestDist || (found && dist == bestDist && facet < rulFacet)) {
+                    found = true;
+                    bestDist = dist;
+                    bestDistP2 = dist * dist;
+                    rclRes = res;
+                    rulFacet = facet;
+                }
+            }
+        }
+        else {
+            // visit the closer child first
+            float distL = DistanceP2(_nodes[index + 1].box, rclPt);
+            float distR = DistanceP2(_nodes[node.first].box, rclPt);
+            if (distL < distR) {
+                stack.emplace_back(distR, node.first);
+                stack.emplace_back(distL, index + 1);
+            }
+            else {
+                stack.emplace_back(distL, index + 1);
+                stack.emplace_back(distR, node.first);
+            }
+        }
+    }
+
+    return found;
+}
+
+void MeshFacetBVH::GetOverlappingPairs(std::vector<std::pair<FacetIndex, FacetIndex>>& pairs,
+                                       const PairFilter& filter) const
+{
+    CollectPairs(*this, true, filter, pairs);
+}
+
+void MeshFacetBVH::GetOverlappingPairs(const MeshFacetBVH& other,
+                                       std::vector<std::pair<FacetIndex, FacetIndex>>& pairs,
+                                       const PairFilter& filter) const
+{
+    CollectPairs(other, false, filter, pairs);
+}
+
+void MeshFacetBVH::CollectPairs(const MeshFacetBVH& other,
+                                bool self,
+                                const PairFilter& filter,
+                                PairList& pairs) const
+{
+    if (_nodes.empty() || other._nodes.empty()) {
+        return;
+    }
+
+    // traverse the upper levels here and the node pairs below on all threads
+    NodePairs deferred;
+    PairList result;
+    Overlaps(other, 0, 0, self, 0, filter, result, &deferred);
+
+    std::mutex mutex;
+    parallel_for(deferred.size(), 1, [&](std::size_t begin, std::size_t end) {
+        PairList local;
+        for (std::size_t i = begin; i < end; i++) {
+            Overlaps(other,
+                     deferred[i].first,
+                     deferred[i].second,
+                     self,
+                     0,
+                     filter,
+                     local,
+                     nullptr);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        result.insert(result.end(), local.begin(), local.end());
+    });
+
+    std::sort(result.begin(), result.end());
+    pairs.insert(pairs.end(), result.begin(), result.end());
+}
+
+void MeshFacetBVH::Overlaps(const MeshFacetBVH& other,
+                            uint32_t nodeA,
+                            uint32_t nodeB,
+                            bool self,
+                            int depth,
+                            const PairFilter& filter,
+                            PairList& pairs,
+                            NodePairs* deferred) const
+{
+    const Node& na = _nodes[nodeA];
+    const Node& nb = other._nodes[nodeB];
+    const bool same = self && nodeA == nodeB;
+    if (!same && !(na.box && nb.box)) {
+        return;
+    }
+    if (deferred && depth >= splitDepth) {
+        deferred->emplace_back(nodeA, nodeB);
+        return;
+    }
+
+    auto addPair = [&](FacetIndex fa, FacetIndex fb) {
+        if (self && fb < fa) {
+            std::swap(fa, fb);
+        }
+        if (!filter || filter(fa, fb)) {
+            pairs.emplace_back(fa, fb);
+        }
+    };
+
+    if (same) {
+        // the pairs inside the subtree
+        if (na.IsLeaf()) {
+            for (uint32_t i = na.first; i < na.first + na.count; i++) {
+                for (uint32_t j = i + 1; j < na.first + na.count; j++) {
+                    if (_boxes[_facets[i]] && _boxes[_facets[j]]) {
+                        addPair(_facets[i], _facets[j]);
+                    }
+                }
+            }
+        }
+        else {
+            Overlaps(other, nodeA + 1, nodeA + 1, self, depth + 1, filter, pairs, deferred);
+            Overlaps(other, na.first, na.first, self, depth + 1, filter, pairs, deferred);
+            Overlaps(other, nodeA + 1, na.first, self, depth + 1, filter, pairs, deferred);
+        }
+        return;
+    }
+
+    if (na.IsLeaf() && nb.IsLeaf()) {
+        for (uint32_t i = na.first; i < na.first + na.count; i++) {
+            const Base::BoundBox3f& box = _boxes[_facets[i]];
+            for (uint32_t j = nb.first; j < nb.first + nb.count; j++) {
+                if (box && other._boxes[other._facets[j]]) {
+                    addPair(_facets[i], other._facets[j]);
+                }
+            }
+        }
+    }
+    else if (nb.IsLeaf() || (!na.IsLeaf() && SurfaceArea(na.box) >= SurfaceArea(nb.box))) {
+        Overlaps(other, nodeA + 1, nodeB, self, depth + 1, filter, pairs, deferred);
+        Overlaps(other, na.first, nodeB, self, depth + 1, filter, pairs, deferred);
+    }
+    else {
+        Overlaps(other, nodeA, nodeB + 1, self, depth + 1, filter, pairs, deferred);
+        Overlaps(other, nodeA, nb.first, self, depth + 1, filter, pairs, deferred);
+    }
+}
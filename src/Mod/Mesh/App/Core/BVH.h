@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <Base/BoundBox.h>
+
+#include "Definitions.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshFacetBVH class is a bounding volume hierarchy over the facets of a mesh. Unlike
+ * MeshFacetGrid it adapts to the distribution and size of the facets, so that it keeps its
+ * efficiency for meshes with very different facet sizes.
+ *
+ * The tree is built with the surface area heuristic over binned facet centers. The nodes are
+ * stored in depth-first order, the left child of an inner node directly follows its parent.
+ * The structure doesn't change after construction, so it can be queried from several
+ * threads at once.
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    /// Decides whether a pair of facets with intersecting bounding boxes is collected
+    using PairFilter = std::function<bool(FacetIndex, FacetIndex)>;
+    /// Decides whether the facets inside a bounding box are of interest
+    using BoxFilter = std::function<bool(const Base::BoundBox3f&)>;
+    /// A ray given by its base point and direction
+    using Ray = std::pair<Base::Vector3f, Base::Vector3f>;
+    /// The facet hit by a ray and the intersection point, FACET_INDEX_MAX if nothing was hit
+    using RayHit = std::pair<FacetIndex, Base::Vector3f>;
+
+    explicit MeshFacetBVH(const MeshKernel& rclM, unsigned int leafSize = 4);
+
+    /// Builds up the tree again after the mesh has changed
+    void Rebuild();
+    /// Returns the bounding box of the whole mesh
+    Base::BoundBox3f GetBoundBox() const;
+    /// Returns the bounding box of a facet
+    const Base::BoundBox3f& GetBoundBox(FacetIndex index) const
+    {
+        return _boxes[index];
+    }
+
+    /// Collects the facets whose bounding box intersects \a rclBB
+    void Inside(const Base::BoundBox3f& rclBB, std::vector<FacetIndex>& raulFacets) const;
+    /**
+     * Collects the facets for which \a filter accepts their bounding box. A subtree is only
+     * visited if \a filter accepts its bounding box, so the filter must accept every box that
+     * contains an accepted box.
+     */
+    void Collect(const BoxFilter& filter, std::vector<FacetIndex>& raulFacets) const;
+    /**
+     * Searches for the facet with the shortest distance to \a rclPt, like
+     * MeshAlgorithm::NearestPointFromPoint(). Only facets closer than \a fMaxDist are
+     * considered. \a rclRes is the nearest point on the facet.
+     */
+    bool NearestFacetToPoint(const Base::Vector3f& rclPt,
+                             float fMaxDist,
+                             FacetIndex& rulFacet,
+                             Base::Vector3f& rclRes) const;
+    /**
+     * Searches for the nearest facet hit by the line through \a rclPt with direction \a rclDir,
+     * like MeshAlgorithm::NearestFacetOnRay(). The angle between the line and the facet normal
+     * must not exceed \a fMaxAngle.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& rclPt,
+                           const Base::Vector3f& rclDir,
+                           float fMaxAngle,
+                           Base::Vector3f& rclRes,
+                           FacetIndex& rulFacet) const;
+    /**
+     * Casts a whole batch of rays, see NearestFacetOnRay(). The rays are distributed to
+     * several threads, the hits are returned in the order of \a rays.
+     */
+    std::vector<RayHit> NearestFacetsOnRays(const std::vector<Ray>& rays, float fMaxAngle) const;
+    /**
+     * Collects all pairs of different facets whose bounding boxes intersect and that pass
+     * \a filter. Every pair is reported once with the lower index first and the pairs are
+     * sorted. The tree is traversed on several threads, so \a filter must be thread-safe.
+     */
+    void GetOverlappingPairs(std::vector<std::pair<FacetIndex, FacetIndex>>& pairs,
+                             const PairFilter& filter = {}) const;
+    /**
+     * Collects all pairs of a facet of this mesh and a facet of the mesh of \a other whose
+     * bounding boxes intersect and that pass \a filter. The first index of a pair refers to
+     * this mesh, the pairs are sorted.
+     */
+    void GetOverlappingPairs(const MeshFacetBVH& other,
+                             std::vector<std::pair<FacetIndex, FacetIndex>>& pairs,
+                             const PairFilter& filter = {}) const;
+
+private:
+    struct Node
+    {
+        Base::BoundBox3f box;
+        /// first facet of a leaf or the right child of an inner node
+        uint32_t first = 0;
+        /// number of facets of a leaf, 0 for inner nodes
+        uint32_t count = 0;
+
+        bool IsLeaf() const
+        {
+            return count > 0;
+        }
+    };
+
+    using PairList = std::vector<std::pair<FacetIndex, FacetIndex>>;
+    using NodePairs = std::vector<std::pair<uint32_t, uint32_t>>;
+
+    void Build(uint32_t node, uint32_t first, uint32_t count, std::vector<Base::Vector3f>& centers);
+    void Overlaps(const MeshFacetBVH& other,
+                  uint32_t nodeA,
+                  uint32_t nodeB,
+                  bool self,
+                  int depth,
+                  const PairFilter& filter,
+                  PairList& pairs,
+                  NodePairs* deferred) const;
+    void CollectPairs(const MeshFacetBVH& other,
+                      bool self,
+                      const PairFilter& filter,
+                      PairList& pairs) const;
+
+private:
+    const MeshKernel& _rclMesh;
+    std::vector<Node> _nodes;
+    std::vector<FacetIndex> _facets;
+    std::vector<Base::BoundBox3f> _boxes;
+    unsigned int _leafSize;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_BVH_H
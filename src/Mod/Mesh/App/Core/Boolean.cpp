@@ -0,0 +1,912 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <tuple>
+
+#include "BVH.h"
+#include "Boolean.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+using Base::Vector3d;
+using Base::Vector3f;
+
+namespace
+{
+// Exact orientation predicates in the style of J. R. Shewchuk, "Adaptive Precision
+// Floating-Point Arithmetic and Fast Robust Geometric Predicates". A plain floating-point
+// evaluation is used whenever its error bound proves the sign right, otherwise the
+// determinant is evaluated exactly with floating-point expansions.
+using Expansion = std::vector<double>;
+
+constexpr double epsilon = std::numeric_limits<double>::epsilon() * 0.5;
+constexpr double orient2dBound = (3.0 + 16.0 * epsilon) * epsilon;
+constexpr double orient3dBound = (7.0 + 56.0 * epsilon) * epsilon;
+
+void twoSum(double a, double b, double& x, double& y)
+{
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+void twoProduct(double a, double b, double& x, double& y)
+{
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+// adds a number to a non-overlapping expansion and removes zero components
+void grow(Expansion& e, double b)
+{
+    Expansion h;
+    h.reserve(e.size() + 1);
+    double q = b;
+    for (double x : e) {
+        double s {}, t {};
+        twoSum(q, x, s, t);
+        if (t != 0.0) {
+            h.push_back(t);
+        }
+        q = s;
+    }
+    h.push_back(q);
+    e.swap(h);
+}
+
+Expansion difference(double a, double b)
+{
+    Expansion e;
+    grow(e, a);
+    grow(e, -b);
+    return e;
+}
+
+Expansion product(const Expansion& e, const Expansion& f)
+{
+    Expansion h;
+    for (double a : e) {
+        for (double b : f) {
+            double p {}, err {};
+            twoProduct(a, b, p, err);
+            grow(h, err);
+            grow(h, p);
+        }
+    }
+    return h;
+}
+
+void add(Expansion& e, const Expansion& f, double sign)
+{
+    for (double x : f) {
+        grow(e, sign * x);
+    }
+}
+
+int sign(const Expansion& e)
+{
+    // the largest component of a non-overlapping expansion decides
+    for (auto it = e.rbegin(); it != e.rend(); ++it) {
+        if (*it > 0.0) {
+            return 1;
+        }
+        if (*it < 0.0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int sign(double value)
+{
+    return (value > 0.0) - (value < 0.0);
+}
+
+struct Point2
+{
+    double x;
+    double y;
+};
+
+int orient2d(const Point2& a, const Point2& b, const Point2& c)
+{
+    double left = (a.x - c.x) * (b.y - c.y);
+    double right = (a.y - c.y) * (b.x - c.x);
+    double det = left - right;
+    if (std::fabs(det) > orient2dBound * (std::fabs(left) + std::fabs(right))) {
+        return sign(det);
+    }
+
+    Expansion e = product(difference(a.x, c.x), difference(b.y, c.y));
+    add(e, product(difference(a.y, c.y), difference(b.x, c.x)), -1.0);
+    return sign(e);
+}
+
+// The sign of the determinant |a-d, b-d, c-d|, \a value gets its floating-point approximation
+int orient3d(const Vector3d& a,
+             const Vector3d& b,
+             const Vector3d& c,
+             const Vector3d& d,
+             double& value)
+{
+    Vector3d ad = a - d;
+    Vector3d bd = b - d;
+    Vector3d cd = c - d;
+    double bc = bd.y * cd.z - bd.z * cd.y;
+    double ca = cd.y * ad.z - cd.z * ad.y;
+    double ab = ad.y * bd.z - ad.z * bd.y;
+    value = ad.x * bc + bd.x * ca + cd.x * ab;
+
+    double permanent = std::fabs(ad.x) * (std::fabs(bd.y * cd.z) + std::fabs(bd.z * cd.y))
+        + std::fabs(bd.x) * (std::fabs(cd.y * ad.z) + std::fabs(cd.z * ad.y))
+        + std::fabs(cd.x) * (std::fabs(ad.y * bd.z) + std::fabs(ad.z * bd.y));
+    if (std::fabs(value) > orient3dBound * permanent) {
+        return sign(value);
+    }
+
+    Expansion adx = difference(a.x, d.x), ady = difference(a.y, d.y), adz = difference(a.z, d.z);
+    Expansion bdx = difference(b.x, d.x), bdy = difference(b.y, d.y), bdz = difference(b.z, d.z);
+    Expansion cdx = difference(c.x, d.x), cdy = difference(c.y, d.y), cdz = difference(c.z, d.z);
+
+    Expansion ebc = product(bdy, cdz);
+    add(ebc, product(bdz, cdy), -1.0);
+    Expansion eca = product(cdy, adz);
+    add(eca, product(cdz, ady), -1.0);
+    Expansion eab = product(ady, bdz);
+    add(eab, product(adz, bdy), -1.0);
+
+    Expansion det = product(adx, ebc);
+    add(det, product(bdx, eca), 1.0);
+    add(det, product(cdx, eab), 1.0);
+    return sign(det);
+}
+
+int orient3d(const Vector3d& a, const Vector3d& b, const Vector3d& c, const Vector3d& d)
+{
+    double value {};
+    return orient3d(a, b, c, d, value);
+}
+
+// A point exactly on a plane is treated as if it was slightly on its positive side. This
+// simple symbolic perturbation keeps the decisions of neighbouring facets consistent.
+int perturbed(int orientation)
+{
+    return orientation == 0 ? 1 : orientation;
+}
+
+Vector3d toDouble(const Vector3f& v)
+{
+    return Base::toVector<double>(v);
+}
+
+int threadCount()
+{
+    return MeshDefinitions::GetMaxThreadCount();
+}
+
+// one step of the ray parity test, returns false if the ray hits an edge or a vertex
+bool countHit(const Vector3d& orig,
+              const Vector3d& dir,
+              const Vector3d& v0,
+              const Vector3d& v1,
+              const Vector3d& v2,
+              int& hits)
+{
+    constexpr double eps = 1e-10;
+    Vector3d e1 = v1 - v0;
+    Vector3d e2 = v2 - v0;
+    Vector3d pvec = dir % e2;
+    double det = e1 * pvec;
+    if (det == 0.0) {
+        return true;
+    }
+
+    double inv = 1.0 / det;
+    Vector3d tvec = orig - v0;
+    double u = (tvec * pvec) * inv;
+    Vector3d qvec = tvec % e1;
+    double v = (dir * qvec) * inv;
+    if (u < -eps || v < -eps || u + v > 1.0 + eps) {
+        return true;
+    }
+
+    double t = (e2 * qvec) * inv;
+    if (t < -eps) {
+        return true;
+    }
+    if (u < eps || v < eps || u + v > 1.0 - eps || t < eps) {
+        return false;
+    }
+
+    hits++;
+    return true;
+}
+
+bool rayHitsBox(const Vector3d& orig, const Vector3d& dir, const Base::BoundBox3f& box)
+{
+    double tmin = 0.0;
+    double tmax = std::numeric_limits<double>::max();
+    const double lo[3] = {box.MinX, box.MinY, box.MinZ};
+    const double hi[3] = {box.MaxX, box.MaxY, box.MaxZ};
+    const double o[3] = {orig.x, orig.y, orig.z};
+    const double d[3] = {dir.x, dir.y, dir.z};
+    for (int i = 0; i < 3; i++) {
+        if (d[i] == 0.0) {
+            if (o[i] < lo[i] || o[i] > hi[i]) {
+                return false;
+            }
+            continue;
+        }
+        double t1 = (lo[i] - o[i]) / d[i];
+        double t2 = (hi[i] - o[i]) / d[i];
+        if (t1 > t2) {
+            std::swap(t1, t2);
+        }
+        tmin = std::max(tmin, t1);
+        tmax = std::min(tmax, t2);
+        if (tmin > tmax) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+bool MeshBoolean::Crossing::operator<(const Crossing& c) const
+{
+    return std::tie(side, p0, p1, facet) < std::tie(c.side, c.p0, c.p1, c.facet);
+}
+
+bool MeshBoolean::Crossing::operator==(const Crossing& c) const
+{
+    return std::tie(side, p0, p1, facet) == std::tie(c.side, c.p0, c.p1, c.facet);
+}
+
+MeshBoolean::MeshBoolean(const MeshKernel& mesh1,
+                         const MeshKernel& mesh2,
+                         MeshKernel& result,
+                         SetOperations::OperationType opType)
+    : _mesh1(mesh1)
+    , _mesh2(mesh2)
+    , _result(result)
+    , _operationType(opType)
+{}
+
+PointIndex MeshBoolean::GlobalIndex(int side, PointIndex index) const
+{
+    return side == 0 ? index : _mesh1.CountPoints() + index;
+}
+
+bool MeshBoolean::Crosses(const Crossing& crossing) const
+{
+    const int other = 1 - crossing.side;
+    const MeshFacet& facet = Mesh(other).GetFacets()[crossing.facet];
+    Vector3d p = toDouble(Mesh(crossing.side).GetPoint(crossing.p0));
+    Vector3d q = toDouble(Mesh(crossing.side).GetPoint(crossing.p1));
+    std::array<Vector3d, 3> corner;
+    for (int i = 0; i < 3; i++) {
+        corner[i] = toDouble(Mesh(other).GetPoint(facet._aulPoints[i]));
+    }
+
+    // the edge must cross the plane of the facet...
+    if (perturbed(orient3d(corner[0], corner[1], corner[2], p))
+        == perturbed(orient3d(corner[0], corner[1], corner[2], q))) {
+        return false;
+    }
+
+    // ...and its line must pass through the facet. The sides of a facet edge are evaluated
+    // with its points in ascending order so that both facets of the edge agree.
+    int first = 0;
+    for (int i = 0; i < 3; i++) {
+        int j = (i + 1) % 3;
+        int side {};
+        if (facet._aulPoints[i] < facet._aulPoints[j]) {
+            side = perturbed(orient3d(p, q, corner[i], corner[j]));
+        }
+        else {
+            side = -perturbed(orient3d(p, q, corner[j], corner[i]));
+        }
+        if (i == 0) {
+            first = side;
+        }
+        else if (side != first) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+Vector3f MeshBoolean::CrossingPoint(const Crossing& crossing) const
+{
+    const int other = 1 - crossing.side;
+    const MeshFacet& facet = Mesh(other).GetFacets()[crossing.facet];
+    Vector3d p = toDouble(Mesh(crossing.side).GetPoint(crossing.p0));
+    Vector3d q = toDouble(Mesh(crossing.side).GetPoint(crossing.p1));
+    Vector3d a = toDouble(Mesh(other).GetPoint(facet._aulPoints[0]));
+    Vector3d b = toDouble(Mesh(other).GetPoint(facet._aulPoints[1]));
+    Vector3d c = toDouble(Mesh(other).GetPoint(facet._aulPoints[2]));
+
+    double dp {}, dq {};
+    orient3d(a, b, c, p, dp);
+    orient3d(a, b, c, q, dq);
+    double t = dp != dq ? dp / (dp - dq) : 0.5;
+    t = std::clamp(t, 0.0, 1.0);
+    Vector3d pnt = p + (q - p) * t;
+    return Base::toVector<float>(pnt);
+}
+
+int MeshBoolean::Intersect(FacetIndex facet1,
+                           FacetIndex facet2,
+                           std::array<Crossing, 6>& ends) const
+{
+    int count = 0;
+    const FacetIndex facets[2] = {facet1, facet2};
+    for (int side = 0; side < 2; side++) {
+        const MeshFacet& facet = Mesh(side).GetFacets()[facets[side]];
+        for (int i = 0; i < 3; i++) {
+            PointIndex p0 = facet._aulPoints[i];
+            PointIndex p1 = facet._aulPoints[(i + 1) % 3];
+            Crossing crossing {side, std::min(p0, p1), std::max(p0, p1), facets[1 - side]};
+            if (Crosses(crossing)) {
+                ends[count++] = crossing;
+            }
+        }
+    }
+
+    return count;
+}
+
+bool MeshBoolean::Retriangulate(int side,
+                                FacetIndex facet,
+                                const std::vector<Segment>& segments,
+                                std::vector<Triangle>& triangles) const
+{
+    const MeshFacet& face = Mesh(side).GetFacets()[facet];
+    const PointIndex base = _mesh1.CountPoints() + _mesh2.CountPoints();
+
+    std::vector<PointIndex> ids;
+    for (PointIndex index : face._aulPoints) {
+        ids.push_back(GlobalIndex(side, index));
+    }
+    auto localIndex = [&ids](PointIndex index) {
+        auto it = std::find(ids.begin(), ids.end(), index);
+        if (it != ids.end()) {
+            return int(it - ids.begin());
+        }
+        ids.push_back(index);
+        return int(ids.size() - 1);
+    };
+
+    std::vector<std::pair<int, int>> constraints;
+    for (const auto& segment : segments) {
+        int a = localIndex(segment.first);
+        int b = localIndex(segment.second);
+        if (a != b) {
+            constraints.emplace_back(a, b);
+        }
+    }
+
+    // project into the plane of the facet so that the corners are counter-clockwise
+    Vector3d c0 = toDouble(_points[ids[0]]);
+    Vector3d normal = (toDouble(_points[ids[1]]) - c0) % (toDouble(_points[ids[2]]) - c0);
+    const double n[3] = {std::fabs(normal.x), std::fabs(normal.y), std::fabs(normal.z)};
+    int axis = int(std::max_element(n, n + 3) - n);
+    int u = (axis + 1) % 3;
+    int v = (axis + 2) % 3;
+    std::vector<Point2> uv;
+    uv.reserve(ids.size());
+    for (PointIndex index : ids) {
+        const Vector3f& pnt = _points[index];
+        const float c[3] = {pnt.x, pnt.y, pnt.z};
+        uv.push_back({double(c[u]), double(c[v])});
+    }
+    int orientation = orient2d(uv[0], uv[1], uv[2]);
+    if (orientation == 0) {
+        triangles.push_back({ids[0], ids[1], ids[2]});
+        return false;
+    }
+    if (orientation < 0) {
+        for (auto& pnt : uv) {
+            std::swap(pnt.x, pnt.y);
+        }
+    }
+
+    std::vector<std::array<int, 3>> tris {{0, 1, 2}};
+    auto findEdge = [&tris](int a, int b, int& rot) {
+        for (std::size_t i = 0; i < tris.size(); i++) {
+            for (rot = 0; rot < 3; rot++) {
+                if (tris[i][rot] == a && tris[i][(rot + 1) % 3] == b) {
+                    return int(i);
+                }
+            }
+        }
+        return -1;
+    };
+
+    // the crossings of the own edges split the border, the others lie inside
+    std::array<std::vector<std::pair<double, int>>, 3> onEdge;
+    std::vector<int> interior;
+    for (int i = 3; i < int(ids.size()); i++) {
+        const Crossing& crossing = _crossings[ids[i] - base];
+        if (crossing.side != side) {
+            interior.push_back(i);
+            continue;
+        }
+        for (int k = 0; k < 3; k++) {
+            PointIndex p0 = face._aulPoints[k];
+            PointIndex p1 = face._aulPoints[(k + 1) % 3];
+            if (std::min(p0, p1) == crossing.p0 && std::max(p0, p1) == crossing.p1) {
+                const Point2& a = uv[k];
+                const Point2& b = uv[(k + 1) % 3];
+                double dx = b.x - a.x;
+                double dy = b.y - a.y;
+                double t = ((uv[i].x - a.x) * dx + (uv[i].y - a.y) * dy) / (dx * dx + dy * dy);
+                onEdge[k].emplace_back(t, i);
+                break;
+            }
+        }
+    }
+
+    bool ok = true;
+    for (int k = 0; k < 3; k++) {
+        std::sort(onEdge[k].begin(), onEdge[k].end());
+        int prev = k;
+        int next = (k + 1) % 3;
+        for (const auto& it : onEdge[k]) {
+            int rot {};
+            int t = findEdge(prev, next, rot);
+            if (t < 0) {
+                ok = false;
+                break;
+            }
+            int w = tris[t][(rot + 2) % 3];
+            tris[t] = {prev, it.second, w};
+            tris.push_back({it.second, next, w});
+            prev = it.second;
+        }
+    }
+
+    for (int p : interior) {
+        // locate the triangle that contains the point, a point that ended up slightly
+        // outside due to rounding goes to the nearest triangle
+        int best = -1;
+        int onSide = -1;
+        double bestValue = -std::numeric_limits<double>::max();
+        for (std::size_t i = 0; i < tris.size(); i++) {
+            const auto& tri = tris[i];
+            int zero = -1;
+            bool inside = true;
+            for (int k = 0; k < 3 && inside; k++) {
+                int o = orient2d(uv[tri[k]], uv[tri[(k + 1) % 3]], uv[p]);
+                if (o < 0) {
+                    inside = false;
+                }
+                else if (o == 0) {
+                    zero = k;
+                }
+            }
+            if (inside) {
+                best = int(i);
+                onSide = zero;
+                break;
+            }
+
+            const Point2& a = uv[tri[0]];
+            const Point2& b = uv[tri[1]];
+            const Point2& c = uv[tri[2]];
+            double value = std::numeric_limits<double>::max();
+            const Point2* corners[4] = {&a, &b, &c, &a};
+            for (int k = 0; k < 3; k++) {
+                const Point2& s = *corners[k];
+                const Point2& e = *corners[k + 1];
+                double len = std::hypot(e.x - s.x, e.y - s.y);
+                double dist = (s.x - uv[p].x) * (e.y - uv[p].y) - (s.y - uv[p].y) * (e.x - uv[p].x);
+                value = std::min(value, len > 0.0 ? dist / len : dist);
+            }
+            if (value > bestValue) {
+                bestValue = value;
+                best = int(i);
+            }
+        }
+
+        if (onSide < 0) {
+            auto tri = tris[best];
+            tris[best] = {tri[0], tri[1], p};
+            tris.push_back({tri[1], tri[2], p});
+            tris.push_back({tri[2], tri[0], p});
+            continue;
+        }
+
+        auto tri = tris[best];
+        int a = tri[onSide];
+        int b = tri[(onSide + 1) % 3];
+        int c = tri[(onSide + 2) % 3];
+        int rot {};
+        int neighbour = findEdge(b, a, rot);
+        tris[best] = {a, p, c};
+        tris.push_back({p, b, c});
+        if (neighbour >= 0) {
+            int x = tris[neighbour][(rot + 2) % 3];
+            tris[neighbour] = {b, p, x};
+            tris.push_back({p, a, x});
+        }
+    }
+
+    // insert the intersection segments by flipping the edges that cross them
+    const int maxFlips = 100 + 10 * int(ids.size() * ids.size());
+    for (const auto& it : constraints) {
+        int a = it.first;
+        int b = it.second;
+        int rot {};
+        for (int flips = 0;; flips++) {
+            if (findEdge(a, b, rot) >= 0 || findEdge(b, a, rot) >= 0) {
+                break;
+            }
+            if (flips > maxFlips) {
+                ok = false;
+                break;
+            }
+
+            bool flipped = false;
+            for (std::size_t i = 0; i < tris.size() && !flipped; i++) {
+                for (int k = 0; k < 3 && !flipped; k++) {
+                    int c = tris[i][k];
+                    int d = tris[i][(k + 1) % 3];
+                    if (c == a || c == b || d == a || d == b) {
+                        continue;
+                    }
+                    if (orient2d(uv[a], uv[b], uv[c]) * orient2d(uv[a], uv[b], uv[d]) >= 0
+                        || orient2d(uv[c], uv[d], uv[a]) * orient2d(uv[c], uv[d], uv[b]) >= 0) {
+                        continue;
+                    }
+                    int j = findEdge(d, c, rot);
+                    if (j < 0) {
+                        continue;
+                    }
+                    int x = tris[i][(k + 2) % 3];
+                    int y = tris[j][(rot + 2) % 3];
+                    if (orient2d(uv[y], uv[d], uv[x]) <= 0 || orient2d(uv[x], uv[c], uv[y]) <= 0) {
+                        continue;
+                    }
+                    tris[i] = {y, d, x};
+                    tris[j] = {x, c, y};
+                    flipped = true;
+                }
+            }
+            if (!flipped) {
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    for (const auto& tri : tris) {
+        triangles.push_back({ids[tri[0]], ids[tri[1]], ids[tri[2]]});
+    }
+    return ok;
+}
+
+bool MeshBoolean::IsInside(int side, const MeshFacetBVH& other, const Vector3d& point) const
+{
+    const MeshKernel& mesh = Mesh(1 - side);
+    const Vector3d directions[3] = {Vector3d(1.0, 2.1, 3.2),
+                                    Vector3d(-3.1, 1.2, 2.3),
+                                    Vector3d(2.2, -3.3, 1.1)};
+
+    bool inside = false;
+    std::vector<FacetIndex> facets;
+    for (const auto& dir : directions) {
+        facets.clear();
+        other.Collect(
+            [&](const Base::BoundBox3f& box) {
+                return rayHitsBox(point, dir, box);
+            },
+            facets);
+
+        // a ray through an edge or vertex is ambiguous, so try the next direction
+        int hits = 0;
+        bool valid = true;
+        for (FacetIndex index : facets) {
+            const MeshFacet& facet = mesh.GetFacets()[index];
+            valid &= countHit(point,
+                              dir,
+                              toDouble(mesh.GetPoint(facet._aulPoints[0])),
+                              toDouble(mesh.GetPoint(facet._aulPoints[1])),
+                              toDouble(mesh.GetPoint(facet._aulPoints[2])),
+                              hits);
+        }
+        inside = (hits % 2) == 1;
+        if (valid) {
+            break;
+        }
+    }
+
+    return inside;
+}
+
+std::vector<bool> MeshBoolean::Classify(int side,
+                                        const std::vector<Triangle>& triangles,
+                                        const std::vector<Segment>& constraints,
+                                        const MeshFacetBVH& other) const
+{
+    // parts of the mesh that are connected without crossing the intersection curve
+    std::vector<std::tuple<PointIndex, PointIndex, std::size_t>> edges;
+    edges.reserve(3 * triangles.size());
+    for (std::size_t i = 0; i < triangles.size(); i++) {
+        for (int k = 0; k < 3; k++) {
+            PointIndex p0 = triangles[i][k];
+            PointIndex p1 = triangles[i][(k + 1) % 3];
+            edges.emplace_back(std::min(p0, p1), std::max(p0, p1), i);
+        }
+    }
+    parallel_sort(edges.begin(), edges.end(), std::less<>(), threadCount());
+
+    std::vector<Segment> curve;
+    curve.reserve(constraints.size());
+    for (const auto& it : constraints) {
+        curve.emplace_back(std::min(it.first, it.second), std::max(it.first, it.second));
+    }
+    std::sort(curve.begin(), curve.end());
+
+    std::vector<std::size_t> parent(triangles.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto root = [&parent](std::size_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    for (std::size_t i = 0; i < edges.size();) {
+        std::size_t j = i + 1;
+        Segment edge(std::get<0>(edges[i]), std::get<1>(edges[i]));
+        while (j < edges.size() && std::get<0>(edges[j]) == edge.first
+               && std::get<1>(edges[j]) == edge.second) {
+            j++;
+        }
+        if (!std::binary_search(curve.begin(), curve.end(), edge)) {
+            std::size_t first = root(std::get<2>(edges[i]));
+            for (std::size_t k = i + 1; k < j; k++) {
+                parent[root(std::get<2>(edges[k]))] = first;
+            }
+        }
+        i = j;
+    }
+
+    // the largest triangle of a part is the most reliable one to test
+    std::vector<double> area(triangles.size(), -1.0);
+    std::vector<std::size_t> probe(triangles.size());
+    for (std::size_t i = 0; i < triangles.size(); i++) {
+        Vector3d p0 = toDouble(_points[triangles[i][0]]);
+        Vector3d p1 = toDouble(_points[triangles[i][1]]);
+        Vector3d p2 = toDouble(_points[triangles[i][2]]);
+        double value = ((p1 - p0) % (p2 - p0)).Length();
+        std::size_t r = root(i);
+        if (value > area[r]) {
+            area[r] = value;
+            probe[r] = i;
+        }
+    }
+
+    std::vector<std::size_t> parts;
+    for (std::size_t i = 0; i < triangles.size(); i++) {
+        if (parent[i] == i) {
+            parts.push_back(i);
+        }
+    }
+
+    std::vector<char> partInside(triangles.size(), 0);
+    parallel_for(parts.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const Triangle& tri = triangles[probe[parts[i]]];
+            Vector3d center = (toDouble(_points[tri[0]]) + toDouble(_points[tri[1]])
+                               + toDouble(_points[tri[2]]))
+                / 3.0;
+            partInside[parts[i]] = IsInside(side, other, center) ? 1 : 0;
+        }
+    });
+
+    std::vector<bool> inside(triangles.size());
+    for (std::size_t i = 0; i < triangles.size(); i++) {
+        inside[i] = partInside[root(i)] != 0;
+    }
+    return inside;
+}
+
+bool MeshBoolean::Do()
+{
+    _points.clear();
+    _points.reserve(_mesh1.CountPoints() + _mesh2.CountPoints());
+    for (const auto& pnt : _mesh1.GetPoints()) {
+        _points.push_back(pnt);
+    }
+    for (const auto& pnt : _mesh2.GetPoints()) {
+        _points.push_back(pnt);
+    }
+
+    const MeshFacetBVH bvh1(_mesh1);
+    const MeshFacetBVH bvh2(_mesh2);
+    std::vector<std::pair<FacetIndex, FacetIndex>> pairs;
+    bvh1.GetOverlappingPairs(bvh2, pairs);
+
+    // the ends of the intersection segment of each pair of facets
+    std::vector<std::array<Crossing, 6>> ends(pairs.size());
+    std::vector<int> counts(pairs.size());
+    parallel_for(pairs.size(), 256, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            counts[i] = Intersect(pairs[i].first, pairs[i].second, ends[i]);
+        }
+    });
+
+    bool consistent = true;
+    std::vector<std::size_t> cut;
+    _crossings.clear();
+    for (std::size_t i = 0; i < pairs.size(); i++) {
+        if (counts[i] == 2) {
+            cut.push_back(i);
+            _crossings.push_back(ends[i][0]);
+            _crossings.push_back(ends[i][1]);
+        }
+        else if (counts[i] != 0) {
+            consistent = false;
+        }
+    }
+
+    // every crossing becomes one point that is shared by both meshes
+    parallel_sort(_crossings.begin(), _crossings.end(), std::less<>(), threadCount());
+    _crossings.erase(std::unique(_crossings.begin(), _crossings.end()), _crossings.end());
+    const PointIndex base = _points.size();
+    _points.resize(base + _crossings.size());
+    parallel_for(_crossings.size(), 256, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            _points[base + i] = CrossingPoint(_crossings[i]);
+        }
+    });
+
+    auto indexOf = [&](const Crossing& crossing) {
+        auto it = std::lower_bound(_crossings.begin(), _crossings.end(), crossing);
+        return base + PointIndex(it - _crossings.begin());
+    };
+    std::vector<Segment> segments(cut.size());
+    for (std::size_t i = 0; i < cut.size(); i++) {
+        segments[i] = {indexOf(ends[cut[i]][0]), indexOf(ends[cut[i]][1])};
+    }
+
+    std::array<std::vector<Triangle>, 2> triangles;
+    std::array<std::vector<bool>, 2> inside;
+    for (int side = 0; side < 2; side++) {
+        std::vector<std::pair<FacetIndex, std::size_t>> byFacet(cut.size());
+        for (std::size_t i = 0; i < cut.size(); i++) {
+            const auto& pair = pairs[cut[i]];
+            byFacet[i] = {side == 0 ? pair.first : pair.second, i};
+        }
+        std::sort(byFacet.begin(), byFacet.end());
+
+        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+        for (std::size_t i = 0; i < byFacet.size();) {
+            std::size_t j = i + 1;
+            while (j < byFacet.size() && byFacet[j].first == byFacet[i].first) {
+                j++;
+            }
+            ranges.emplace_back(i, j);
+            i = j;
+        }
+
+        std::vector<std::vector<Triangle>> parts(ranges.size());
+        std::vector<char> valid(ranges.size(), 1);
+        parallel_for(ranges.size(), 16, [&](std::size_t begin, std::size_t end) {
+            std::vector<Segment> facetSegments;
+            for (std::size_t i = begin; i < end; i++) {
+                facetSegments.clear();
+                for (std::size_t j = ranges[i].first; j < ranges[i].second; j++) {
+                    facetSegments.push_back(segments[byFacet[j].second]);
+                }
+                FacetIndex facet = byFacet[ranges[i].first].first;
+                valid[i] = Retriangulate(side, facet, facetSegments, parts[i]) ? 1 : 0;
+            }
+        });
+
+        const MeshFacetArray& facets = Mesh(side).GetFacets();
+        std::vector<bool> isCut(facets.size());
+        for (const auto& range : ranges) {
+            isCut[byFacet[range.first].first] = true;
+        }
+        for (FacetIndex i = 0; i < facets.size(); i++) {
+            if (!isCut[i]) {
+                const MeshFacet& facet = facets[i];
+                triangles[side].push_back({GlobalIndex(side, facet._aulPoints[0]),
+                                           GlobalIndex(side, facet._aulPoints[1]),
+                                           GlobalIndex(side, facet._aulPoints[2])});
+            }
+        }
+        for (std::size_t i = 0; i < parts.size(); i++) {
+            triangles[side].insert(triangles[side].end(), parts[i].begin(), parts[i].end());
+            consistent &= valid[i] != 0;
+        }
+
+        inside[side] = Classify(side, triangles[side], segments, side == 0 ? bvh2 : bvh1);
+    }
+
+    // which parts to keep, the second mesh is flipped for the difference
+    bool use[2] = {true, true};
+    bool keepInside[2] = {false, false};
+    switch (_operationType) {
+        case SetOperations::Union:
+            break;
+        case SetOperations::Intersect:
+            keepInside[0] = keepInside[1] = true;
+            break;
+        case SetOperations::Difference:
+            keepInside[1] = true;
+            break;
+        case SetOperations::Inner:
+            keepInside[0] = true;
+            use[1] = false;
+            break;
+        case SetOperations::Outer:
+            use[1] = false;
+            break;
+    }
+
+    std::vector<PointIndex> remap(_points.size(), POINT_INDEX_MAX);
+    MeshPointArray points;
+    MeshFacetArray facets;
+    for (int side = 0; side < 2; side++) {
+        if (!use[side]) {
+            continue;
+        }
+        for (std::size_t i = 0; i < triangles[side].size(); i++) {
+            Triangle tri = triangles[side][i];
+            if (inside[side][i] != keepInside[side] || tri[0] == tri[1] || tri[1] == tri[2]
+                || tri[2] == tri[0]) {
+                continue;
+            }
+            if (side == 1 && _operationType == SetOperations::Difference) {
+                std::swap(tri[0], tri[1]);
+            }
+            for (PointIndex& index : tri) {
+                if (remap[index] == POINT_INDEX_MAX) {
+                    remap[index] = points.size();
+                    points.push_back(MeshPoint(_points[index]));
+                }
+                index = remap[index];
+            }
+            facets.push_back(MeshFacet(tri[0], tri[1], tri[2]));
+        }
+    }
+
+    _result.Adopt(points, facets, true);
+    return consistent;
+}
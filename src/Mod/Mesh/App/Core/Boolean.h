@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+
+#ifndef MESH_BOOLEAN_H
+#define MESH_BOOLEAN_H
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "Definitions.h"
+#include "SetOperations.h"
+
+
+namespace MeshCore
+{
+
+class MeshFacetBVH;
+class MeshKernel;
+
+/**
+ * The MeshBoolean class is an alternative to SetOperations for closed, consistently oriented
+ * meshes. The facet pairs to intersect are taken from bounding volume hierarchies, and all
+ * decisions about which edge crosses which facet are made with exact orientation predicates,
+ * so that the intersection curve is topologically consistent on both meshes. The cut facets
+ * are retriangulated independently of each other and every part of a mesh that is bounded
+ * by the intersection curve is classified as a whole as inside or outside of the other mesh.
+ * All stages work on flat arrays and run on several threads.
+ */
+class MeshExport MeshBoolean
+{
+public:
+    MeshBoolean(const MeshKernel& mesh1,
+                const MeshKernel& mesh2,
+                MeshKernel& result,
+                SetOperations::OperationType opType);
+
+    /**
+     * Computes the result mesh. Returns false if a degenerate configuration, e.g. coplanar
+     * overlapping facets, could not be resolved. The result is still written in this case
+     * but may contain holes.
+     */
+    bool Do();
+
+private:
+    /// An edge of one mesh, given by its sorted point indices, crossing a facet of the other
+    struct Crossing
+    {
+        int side;
+        PointIndex p0;
+        PointIndex p1;
+        FacetIndex facet;
+
+        bool operator<(const Crossing& c) const;
+        bool operator==(const Crossing& c) const;
+    };
+    using Triangle = std::array<PointIndex, 3>;
+    using Segment = std::pair<PointIndex, PointIndex>;
+
+    const MeshKernel& Mesh(int side) const
+    {
+        return side == 0 ? _mesh1 : _mesh2;
+    }
+    PointIndex GlobalIndex(int side, PointIndex index) const;
+    bool Crosses(const Crossing& crossing) const;
+    Base::Vector3f CrossingPoint(const Crossing& crossing) const;
+    int Intersect(FacetIndex facet1, FacetIndex facet2, std::array<Crossing, 6>& ends) const;
+    bool Retriangulate(int side,
+                       FacetIndex facet,
+                       const std::vector<Segment>& segments,
+                       std::vector<Triangle>& triangles) const;
+    std::vector<bool> Classify(int side,
+                               const std::vector<Triangle>& triangles,
+                               const std::vector<Segment>& constraints,
+                               const MeshFacetBVH& other) const;
+    bool IsInside(int side, const MeshFacetBVH& other, const Base::Vector3d& point) const;
+
+private:
+    const MeshKernel& _mesh1;
+    const MeshKernel& _mesh2;
+    MeshKernel& _result;
+    SetOperations::OperationType _operationType;
+    /// the points of both meshes followed by the crossing points
+    std::vector<Base::Vector3f> _points;
+    std::vector<Crossing> _crossings;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_BOOLEAN_H
@@ -24,10 +24,6 @@
 #include <functional>
 #include <limits>
 
-#include <QFuture>
-#include <QFutureWatcher>
-#include <QtConcurrentMap>
-
 #include <Base/Sequencer.h>
 #include <Base/Tools.h>
 
@@ -35,18 +31,20 @@
 #ifdef OPTIMIZE_CURVATURE
 #include <Eigen/Eigenvalues>
 #else
-#include <Mod/Mesh/App/WildMagic4/Wm4MeshCurvature.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4Matrix2.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4Matrix3.h>
 #endif
 
+#include "Adjacency.h"
 #include "Approximation.h"
 #include "Curvature.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
 #include "Tools.h"
 
 
 using namespace MeshCore;
-namespace sp = std::placeholders;
 
 MeshCurvature::MeshCurvature(const MeshKernel& kernel)
     : myKernel(kernel)
@@ -67,28 +65,27 @@ MeshCurvature::MeshCurvature(const MeshKernel& kernel, std::vector<FacetIndex> s
 void MeshCurvature::ComputePerFace(bool parallel)
 {
     myCurvature.clear();
-    MeshRefPointToFacets search(myKernel);
+    MeshCompactPointToFacets search(myKernel);
     FacetCurvature face(myKernel, search, myRadius, myMinPoints);
 
     if (!parallel) {
         Base::SequencerLauncher seq("Curvature estimation", mySegment.size());
+        FacetCurvature::Scratch scratch;
         for (FacetIndex it : mySegment) {
-            CurvatureInfo info = face.Compute(it);
+            CurvatureInfo info = face.Compute(it, scratch);
             myCurvature.push_back(info);
             seq.next();
         }
     }
     else {
-        // NOLINTBEGIN
-        QFuture<CurvatureInfo> future =
-            QtConcurrent::mapped(mySegment, std::bind(&FacetCurvature::Compute, &face, sp::_1));
-        // NOLINTEND
-        QFutureWatcher<CurvatureInfo> watcher;
-        watcher.setFuture(future);
-        watcher.waitForFinished();
-        for (const auto& it : future) {
-            myCurvature.push_back(it);
-        }
+        // each chunk writes into its own part of the result and has its own buffers
+        myCurvature.resize(mySegment.size());
+        parallel_for(mySegment.size(), 256, [&](std::size_t begin, std::size_t end) {
+            FacetCurvature::Scratch scratch;
+            for (std::size_t i = begin; i < end; i++) {
+                myCurvature[i] = face.Compute(mySegment[i], scratch);
+            }
+        });
     }
 }
 
@@ -127,8 +124,8 @@ void MeshCurvature::ComputePerVertex()
     // get all points
     const MeshPointArray& pts = myKernel.GetPoints();
 
-    MeshCore::MeshRefPointToFacets pt2f(myKernel);
-    MeshCore::MeshRefPointToPoints pt2p(myKernel);
+    MeshCore::MeshCompactPointToFacets pt2f(myKernel);
+    MeshCore::MeshCompactPointToPoints pt2p(myKernel);
     unsigned long numPoints = myKernel.CountPoints();
 
     myCurvature.clear();
@@ -162,8 +159,8 @@ void MeshCurvature::ComputePerVertex()
 
         int iV0 = i;
         int iV1;
-        const std::set<unsigned long>& nb = pt2p[i];
-        for (std::set<unsigned long>::const_iterator it = nb.begin(); it != nb.end(); ++it) {
+        MeshAdjacency::Range nb = pt2p[i];
+        for (MeshAdjacency::Range::const_iterator it = nb.begin(); it != nb.end(); ++it) {
             iV1 = *it;
 
             // Compute edge from V0 to V1, project to tangent plane of vertex,
@@ -291,86 +288,130 @@ void MeshCurvature::ComputePerVertex()
 {
     myCurvature.clear();
 
-    // get all points
-    std::vector<Wm4::Vector3<double>> aPnts;
-    aPnts.reserve(myKernel.CountPoints());
-    MeshPointIterator cPIt(myKernel);
-    for (cPIt.Init(); cPIt.More(); cPIt.Next()) {
-        Wm4::Vector3<double> cP(cPIt->x, cPIt->y, cPIt->z);
-        aPnts.push_back(cP);
-    }
-
-    // get all point connections
-    std::vector<int> aIdx;
-    aIdx.reserve(3 * myKernel.CountFacets());
-    const MeshFacetArray& raFts = myKernel.GetFacets();
-    for (const auto& it : raFts) {
-        for (PointIndex point : it._aulPoints) {
-            aIdx.push_back(int(point));
-        }
-    }
-
     // in case of an empty mesh no curvature can be calculated
     if (myKernel.CountPoints() == 0 || myKernel.CountFacets() == 0) {
         return;
     }
 
-    // compute vertex based curvatures
-    Wm4::MeshCurvature<double> meshCurv(myKernel.CountPoints(),
-                                        aPnts.data(),
-                                        myKernel.CountFacets(),
-                                        aIdx.data());
-
-    // get curvature information now
-    const Wm4::Vector3<double>* aMaxCurvDir = meshCurv.GetMaxDirections();
-    const Wm4::Vector3<double>* aMinCurvDir = meshCurv.GetMinDirections();
-    const double* aMaxCurv = meshCurv.GetMaxCurvatures();
-    const double* aMinCurv = meshCurv.GetMinCurvatures();
+    // This is the algorithm of Wm4::MeshCurvature. Instead of scattering the terms of each
+    // facet to its corners every point gathers them from its facets. As they are visited
+    // in the same order the results are identical but the points can be handled in parallel.
+    using Vector3 = Wm4::Vector3<double>;
+    using Matrix3 = Wm4::Matrix3<double>;
+    using Matrix2 = Wm4::Matrix2<double>;
+    using Vector2 = Wm4::Vector2<double>;
+
+    const MeshPointArray& points = myKernel.GetPoints();
+    const MeshFacetArray& facets = myKernel.GetFacets();
+    MeshCompactPointToFacets pt2f(myKernel);
+    const std::size_t numPoints = points.size();
+    auto vertex = [&points](PointIndex index) {
+        const MeshPoint& pnt = points[index];
+        return Vector3(double(pnt.x), double(pnt.y), double(pnt.z));
+    };
+
+    // compute normal vectors, the length of a facet normal provides a weighted sum
+    std::vector<Vector3> normals(numPoints);
+    parallel_for(numPoints, 4096, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            Vector3 normal(0, 0, 0);
+            for (FacetIndex index : pt2f[i]) {
+                const MeshFacet& facet = facets[index];
+                Vector3 p0 = vertex(facet._aulPoints[0]);
+                Vector3 edge1 = vertex(facet._aulPoints[1]) - p0;
+                Vector3 edge2 = vertex(facet._aulPoints[2]) - p0;
+                normal += edge1.Cross(edge2);
+            }
+            normal.Normalize();
+            normals[i] = normal;
+        }
+    });
+
+    myCurvature.resize(numPoints);
+    parallel_for(numPoints, 4096, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const Vector3 v0 = vertex(i);
+            const Vector3& n0 = normals[i];
+
+            // compute the matrix of normal derivatives
+            Matrix3 wwTrn(0, 0, 0, 0, 0, 0, 0, 0, 0);
+            Matrix3 dwTrn(0, 0, 0, 0, 0, 0, 0, 0, 0);
+            auto addEdge = [&](PointIndex index) {
+                // Compute edge from V0 to V1, project to tangent plane of vertex,
+                // and compute difference of adjacent normals.
+                Vector3 e = vertex(index) - v0;
+                Vector3 w = e - (e.Dot(n0)) * n0;
+                Vector3 d = normals[index] - n0;
+                for (int row = 0; row < 3; row++) {
+                    for (int col = 0; col < 3; col++) {
+                        wwTrn[row][col] += w[row] * w[col];
+                        dwTrn[row][col] += d[row] * w[col];
+                    }
+                }
+            };
+            for (FacetIndex index : pt2f[i]) {
+                const MeshFacet& facet = facets[index];
+                for (int j = 0; j < 3; j++) {
+                    if (facet._aulPoints[j] == i) {
+                        addEdge(facet._aulPoints[(j + 1) % 3]);
+                        addEdge(facet._aulPoints[(j + 2) % 3]);
+                    }
+                }
+            }
 
-    myCurvature.reserve(myKernel.CountPoints());
-    for (unsigned long i = 0; i < myKernel.CountPoints(); i++) {
-        CurvatureInfo ci;
-        ci.cMaxCurvDir = Base::Vector3f((float)aMaxCurvDir[i].X(),
-                                        (float)aMaxCurvDir[i].Y(),
-                                        (float)aMaxCurvDir[i].Z());
-        ci.cMinCurvDir = Base::Vector3f((float)aMinCurvDir[i].X(),
-                                        (float)aMinCurvDir[i].Y(),
-                                        (float)aMinCurvDir[i].Z());
-        ci.fMaxCurvature = (float)aMaxCurv[i];
-        ci.fMinCurvature = (float)aMinCurv[i];
-        myCurvature.push_back(ci);
-    }
+            // Add in N*N^T to W*W^T for numerical stability.
+            for (int row = 0; row < 3; row++) {
+                for (int col = 0; col < 3; col++) {
+                    wwTrn[row][col] = 0.5 * wwTrn[row][col] + n0[row] * n0[col];
+                    dwTrn[row][col] *= 0.5;
+                }
+            }
+            Matrix3 dNormal = dwTrn * wwTrn.Inverse();
+
+            // compute U and V given N
+            Vector3 u, v;
+            Vector3::GenerateComplementBasis(u, v, n0);
+
+            // Compute S = J^T * dN/dX * J.  In theory S is symmetric, but
+            // because we have estimated dN/dX, we must slightly adjust our
+            // calculations to make sure S is symmetric.
+            double s01 = u.Dot(dNormal * v);
+            double s10 = v.Dot(dNormal * u);
+            double sAvr = 0.5 * (s01 + s10);
+            Matrix2 shape(u.Dot(dNormal * u), sAvr, sAvr, v.Dot(dNormal * v));
+
+            // compute the eigenvalues of S (min and max curvatures)
+            double trace = shape[0][0] + shape[1][1];
+            double det = shape[0][0] * shape[1][1] - shape[0][1] * shape[1][0];
+            double discr = trace * trace - 4.0 * det;
+            double rootDiscr = std::sqrt(std::fabs(discr));
+            double minCurvature = 0.5 * (trace - rootDiscr);
+            double maxCurvature = 0.5 * (trace + rootDiscr);
+
+            // compute the eigenvectors of S
+            auto direction = [&](double curvature) {
+                Vector2 w0(shape[0][1], curvature - shape[0][0]);
+                Vector2 w1(curvature - shape[1][1], shape[1][0]);
+                Vector2& w = w0.SquaredLength() >= w1.SquaredLength() ? w0 : w1;
+                w.Normalize();
+                Vector3 dir = w.X() * u + w.Y() * v;
+                return Base::Vector3f(float(dir.X()), float(dir.Y()), float(dir.Z()));
+            };
+
+            CurvatureInfo& ci = myCurvature[i];
+            ci.cMaxCurvDir = direction(maxCurvature);
+            ci.cMinCurvDir = direction(minCurvature);
+            ci.fMaxCurvature = float(maxCurvature);
+            ci.fMinCurvature = float(minCurvature);
+        }
+    });
 }
 #endif  // OPTIMIZE_CURVATURE
 
 // --------------------------------------------------------
 
-namespace MeshCore
-{
-class FitPointCollector: public MeshCollector
-{
-public:
-    explicit FitPointCollector(std::set<PointIndex>& ind)
-        : indices(ind)
-    {}
-    void Append(const MeshCore::MeshKernel& kernel, FacetIndex index) override
-    {
-        PointIndex ulP1 {}, ulP2 {}, ulP3 {};
-        kernel.GetFacetPoints(index, ulP1, ulP2, ulP3);
-        indices.insert(ulP1);
-        indices.insert(ulP2);
-        indices.insert(ulP3);
-    }
-
-private:
-    std::set<PointIndex>& indices;
-};
-}  // namespace MeshCore
-
-// --------------------------------------------------------
-
 FacetCurvature::FacetCurvature(const MeshKernel& kernel,
-                               const MeshRefPointToFacets& search,
+                               const MeshCompactPointToFacets& search,
                                float r,
                                unsigned long pt)
     : myKernel(kernel)
@@ -379,7 +420,56 @@ FacetCurvature::FacetCurvature(const MeshKernel& kernel,
     , myRadius(r)
 {}
 
+void FacetCurvature::CollectPoints(FacetIndex index, float radius, Scratch& scratch) const
+{
+    // This is the flood fill of MeshCompactPointToFacets::Neighbours. Instead of sets the
+    // visited facets and points get the stamp of the current search.
+    const MeshFacetArray& facets = myKernel.GetFacets();
+    scratch.facetStamp.resize(facets.size(), 0);
+    scratch.pointStamp.resize(myKernel.CountPoints(), 0);
+    const unsigned long stamp = ++scratch.stamp;
+
+    Base::Vector3f center = myKernel.GetFacet(index).GetGravityPoint();
+    float radius2 = radius * radius;
+
+    scratch.points.clear();
+    scratch.stack.clear();
+    scratch.stack.push_back(index);
+    scratch.facetStamp[index] = stamp;
+    while (!scratch.stack.empty()) {
+        FacetIndex current = scratch.stack.back();
+        scratch.stack.pop_back();
+
+        // the distance doesn't depend on the path, so a rejected facet needn't be tested again
+        const MeshFacet& face = facets[current];
+        if (Base::DistanceP2(center, myKernel.GetFacet(face).GetGravityPoint()) > radius2) {
+            continue;
+        }
+
+        for (PointIndex point : face._aulPoints) {
+            if (scratch.pointStamp[point] != stamp) {
+                scratch.pointStamp[point] = stamp;
+                scratch.points.push_back(point);
+            }
+            for (FacetIndex it : mySearch[point]) {
+                if (scratch.facetStamp[it] != stamp) {
+                    scratch.facetStamp[it] = stamp;
+                    scratch.stack.push_back(it);
+                }
+            }
+        }
+    }
+
+    std::sort(scratch.points.begin(), scratch.points.end());
+}
+
 CurvatureInfo FacetCurvature::Compute(FacetIndex index) const
+{
+    Scratch scratch;
+    return Compute(index, scratch);
+}
+
+CurvatureInfo FacetCurvature::Compute(FacetIndex index, Scratch& scratch) const
 {
     Base::Vector3f rkDir0, rkDir1;
     Base::Vector3f rkNormal;
@@ -387,13 +477,13 @@ CurvatureInfo FacetCurvature::Compute(FacetIndex index) const
     MeshGeomFacet face = myKernel.GetFacet(index);
     Base::Vector3f face_gravity = face.GetGravityPoint();
     Base::Vector3f face_normal = face.GetNormal();
-    std::set<PointIndex> point_indices;
-    FitPointCollector collect(point_indices);
+    const std::vector<PointIndex>& point_indices = scratch.points;
 
+    // a bigger radius always collects a superset of the points
     float searchDist = myRadius;
     int attempts = 0;
     do {
-        mySearch.Neighbours(index, searchDist, collect);
+        CollectPoints(index, searchDist, scratch);
         if (point_indices.empty()) {
             break;
         }
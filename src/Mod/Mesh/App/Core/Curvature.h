@@ -31,7 +31,7 @@ namespace MeshCore
 {
 
 class MeshKernel;
-class MeshRefPointToFacets;
+class MeshCompactPointToFacets;
 
 /** Curvature information. */
 struct MeshExport CurvatureInfo
@@ -43,15 +43,29 @@ struct MeshExport CurvatureInfo
 class MeshExport FacetCurvature
 {
 public:
+    /// The buffers one thread re-uses for all the facets it computes
+    struct Scratch
+    {
+        std::vector<FacetIndex> stack;
+        std::vector<PointIndex> points;
+        std::vector<unsigned long> facetStamp;
+        std::vector<unsigned long> pointStamp;
+        unsigned long stamp {0};
+    };
+
     FacetCurvature(const MeshKernel& kernel,
-                   const MeshRefPointToFacets& search,
+                   const MeshCompactPointToFacets& search,
                    float,
                    unsigned long);
     CurvatureInfo Compute(FacetIndex index) const;
+    CurvatureInfo Compute(FacetIndex index, Scratch& scratch) const;
 
 private:
+    /// Collects the sorted corner points of the facets around \a index within \a radius
+    void CollectPoints(FacetIndex index, float radius, Scratch& scratch) const;
+
     const MeshKernel& myKernel;
-    const MeshRefPointToFacets& mySearch;
+    const MeshCompactPointToFacets& mySearch;
     unsigned long myMinPoints;
     float myRadius;
 };
@@ -69,7 +83,10 @@ public:
     {
         myRadius = r;
     }
+    /// Fits a surface to the points around each facet of the segment, on all cores if
+    /// \a parallel is true
     void ComputePerFace(bool parallel);
+    /// Computes the curvature at each point from the derivatives of the point normals
     void ComputePerVertex();
     const std::vector<CurvatureInfo>& GetCurvature() const
     {
@@ -20,35 +20,40 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
 #include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
 
+#include "BVH.h"
 #include "Decimation.h"
+#include "Functional.h"
 #include "MeshKernel.h"
 #include "Simplify.h"
 
 
 using namespace MeshCore;
 
-MeshSimplify::MeshSimplify(MeshKernel& mesh)
-    : myKernel(mesh)
-{}
-
-void MeshSimplify::simplify(float tolerance, float reduction)
+namespace
 {
-    Simplify alg;
-
-    const MeshPointArray& points = myKernel.GetPoints();
+void fillSimplify(const MeshKernel& kernel, Simplify& alg)
+{
+    const MeshPointArray& points = kernel.GetPoints();
+    alg.vertices.reserve(points.size());
     for (std::size_t i = 0; i < points.size(); i++) {
         Simplify::Vertex v;
         v.tstart = 0;
         v.tcount = 0;
         v.border = 0;
         v.p = points[i];
+        v.origin = static_cast<int>(i);
         alg.vertices.push_back(v);
     }
 
-    const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
+    const MeshFacetArray& facets = kernel.GetFacets();
+    alg.triangles.reserve(facets.size());
+    for (const auto& facet : facets) {
         Simplify::Triangle t;
         t.deleted = 0;
         t.dirty = 0;
@@ -56,18 +61,14 @@ void MeshSimplify::simplify(float tolerance, float reduction)
             j = 0.0;
         }
         for (int j = 0; j < 3; j++) {
-            t.v[j] = facets[i]._aulPoints[j];
+            t.v[j] = static_cast<int>(facet._aulPoints[j]);
         }
         alg.triangles.push_back(t);
     }
+}
 
-    int target_count = static_cast<int>(static_cast<float>(facets.size()) * (1.0F - reduction));
-
-    // Simplification starts
-    alg.simplify_mesh(target_count, tolerance);
-
-    // Simplification done
-    MeshPointArray new_points;
+void readSimplify(const Simplify& alg, MeshPointArray& new_points, MeshFacetArray& new_facets)
+{
     new_points.reserve(alg.vertices.size());
     for (const auto& vertex : alg.vertices) {
         new_points.push_back(vertex.p);
@@ -79,7 +80,6 @@ void MeshSimplify::simplify(float tolerance, float reduction)
             numFacets++;
         }
     }
-    MeshFacetArray new_facets;
     new_facets.reserve(numFacets);
     for (const auto& triangle : alg.triangles) {
         if (!triangle.deleted) {
@@ -90,65 +90,268 @@ void MeshSimplify::simplify(float tolerance, float reduction)
             new_facets.push_back(face);
         }
     }
-
-    myKernel.Adopt(new_points, new_facets, true);
 }
 
-void MeshSimplify::simplify(int targetSize)
+// Splits the facets recursively at the median of their centers along the longest axis
+void splitFacets(const std::vector<Base::Vector3f>& centers,
+                 std::vector<FacetIndex>::iterator begin,
+                 std::vector<FacetIndex>::iterator end,
+                 unsigned int parts,
+                 std::vector<std::pair<std::size_t, std::size_t>>& ranges,
+                 std::size_t offset)
 {
-    Simplify alg;
+    const auto count = static_cast<std::size_t>(end - begin);
+    if (parts < 2 || count < 2) {
+        ranges.emplace_back(offset, offset + count);
+        return;
+    }
 
-    const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.tstart = 0;
-        v.tcount = 0;
-        v.border = 0;
-        v.p = points[i];
-        alg.vertices.push_back(v);
+    Base::BoundBox3f box;
+    for (auto it = begin; it != end; ++it) {
+        box.Add(centers[*it]);
     }
+    float lx = box.LengthX();
+    float ly = box.LengthY();
+    float lz = box.LengthZ();
+    int axis = (lx >= ly && lx >= lz) ? 0 : (ly >= lz ? 1 : 2);
 
-    const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
-        t.deleted = 0;
-        t.dirty = 0;
-        for (double& j : t.err) {
-            j = 0.0;
-        }
-        for (int j = 0; j < 3; j++) {
-            t.v[j] = facets[i]._aulPoints[j];
+    unsigned int left = parts / 2;
+    auto mid = begin + static_cast<std::ptrdiff_t>(count * left / parts);
+    std::nth_element(begin, mid, end, [&](FacetIndex f1, FacetIndex f2) {
+        const Base::Vector3f& c1 = centers[f1];
+        const Base::Vector3f& c2 = centers[f2];
+        float v1 = axis == 0 ? c1.x : (axis == 1 ? c1.y : c1.z);
+        float v2 = axis == 0 ? c2.x : (axis == 1 ? c2.y : c2.z);
+        return v1 < v2 || (v1 == v2 && f1 < f2);
+    });
+
+    auto leftCount = static_cast<std::size_t>(mid - begin);
+    splitFacets(centers, begin, mid, left, ranges, offset);
+    splitFacets(centers, mid, end, parts - left, ranges, offset + leftCount);
+}
+
+// Returns the largest distance of the points of \a points to the facets of \a bvh
+float maximumDistance(const MeshPointArray& points, const MeshFacetBVH& bvh)
+{
+    float maxDist = 0.0F;
+    std::mutex mutex;
+    parallel_for(points.size(), 4096, [&](std::size_t begin, std::size_t end) {
+        float dist = 0.0F;
+        for (std::size_t i = begin; i < end; i++) {
+            FacetIndex facet {};
+            Base::Vector3f res;
+            if (bvh.NearestFacetToPoint(points[i],
+                                        std::numeric_limits<float>::max(),
+                                        facet,
+                                        res)) {
+                dist = std::max(dist, Base::Distance(points[i], res));
+            }
         }
-        alg.triangles.push_back(t);
-    }
+        std::lock_guard<std::mutex> lock(mutex);
+        maxDist = std::max(maxDist, dist);
+    });
+    return maxDist;
+}
+}  // namespace
+
+MeshSimplify::MeshSimplify(MeshKernel& mesh)
+    : myKernel(mesh)
+{}
+
+void MeshSimplify::simplify(float tolerance, float reduction)
+{
+    Simplify alg;
+    fillSimplify(myKernel, alg);
+
+    const std::size_t numFacets = myKernel.CountFacets();
+    int target_count = static_cast<int>(static_cast<float>(numFacets) * (1.0F - reduction));
+
+    // Simplification starts
+    alg.simplify_mesh(target_count, tolerance);
+
+    // Simplification done
+    MeshPointArray new_points;
+    MeshFacetArray new_facets;
+    readSimplify(alg, new_points, new_facets);
+    myKernel.Adopt(new_points, new_facets, true);
+}
+
+void MeshSimplify::simplify(int targetSize)
+{
+    Simplify alg;
+    fillSimplify(myKernel, alg);
 
     // Simplification starts
     alg.simplify_mesh(targetSize, std::numeric_limits<float>::max());
 
     // Simplification done
     MeshPointArray new_points;
-    new_points.reserve(alg.vertices.size());
-    for (const auto& vertex : alg.vertices) {
-        new_points.push_back(vertex.p);
+    MeshFacetArray new_facets;
+    readSimplify(alg, new_points, new_facets);
+    myKernel.Adopt(new_points, new_facets, true);
+}
+
+float MeshSimplify::simplifyPartitioned(int targetSize, float tolerance, unsigned int partitions)
+{
+    const MeshPointArray& points = myKernel.GetPoints();
+    const MeshFacetArray& facets = myKernel.GetFacets();
+    const std::size_t numFacets = facets.size();
+    if (numFacets == 0) {
+        return 0.0F;
     }
 
-    std::size_t numFacets = 0;
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            numFacets++;
+    if (partitions == 0) {
+        partitions = unsigned(MeshDefinitions::GetMaxThreadCount());
+    }
+    // too small parts aren't worth the effort
+    const std::size_t minPartition = 10000;
+    partitions = static_cast<unsigned int>(
+        std::max<std::size_t>(std::min<std::size_t>(partitions, numFacets / minPartition), 1));
+
+    Simplify alg;
+    if (partitions < 2) {
+        fillSimplify(myKernel, alg);
+    }
+    else {
+        // split the facets into compact parts of about the same size
+        std::vector<Base::Vector3f> centers(numFacets);
+        parallel_for(numFacets, 10000, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                const MeshFacet& facet = facets[i];
+                centers[i] = (points[facet._aulPoints[0]] + points[facet._aulPoints[1]]
+                              + points[facet._aulPoints[2]])
+                    / 3.0F;
+            }
+        });
+
+        std::vector<FacetIndex> order(numFacets);
+        std::iota(order.begin(), order.end(), FacetIndex(0));
+        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+        splitFacets(centers, order.begin(), order.end(), partitions, ranges, 0);
+        centers.clear();
+
+        // the vertices used by facets of several parts must stay where they are
+        const int shared = -1;
+        const int unused = -2;
+        std::vector<int> owner(points.size(), unused);
+        for (std::size_t part = 0; part < ranges.size(); part++) {
+            for (std::size_t i = ranges[part].first; i < ranges[part].second; i++) {
+                for (PointIndex index : facets[order[i]]._aulPoints) {
+                    int& value = owner[index];
+                    if (value == unused) {
+                        value = static_cast<int>(part);
+                    }
+                    else if (value != static_cast<int>(part)) {
+                        value = shared;
+                    }
+                }
+            }
+        }
+
+        // decimate the parts independently
+        std::vector<Simplify> parts(ranges.size());
+        parallel_for(ranges.size(), 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t part = begin; part < end; part++) {
+                auto first = order.begin() + static_cast<std::ptrdiff_t>(ranges[part].first);
+                auto last = order.begin() + static_cast<std::ptrdiff_t>(ranges[part].second);
+
+                std::vector<PointIndex> vertices;
+                vertices.reserve(3 * (ranges[part].second - ranges[part].first));
+                for (auto it = first; it != last; ++it) {
+                    const MeshFacet& facet = facets[*it];
+                    vertices.insert(vertices.end(),
+                                    std::begin(facet._aulPoints),
+                                    std::end(facet._aulPoints));
+                }
+                std::sort(vertices.begin(), vertices.end());
+                vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+                Simplify& local = parts[part];
+                local.vertices.reserve(vertices.size());
+                for (PointIndex index : vertices) {
+                    Simplify::Vertex v;
+                    v.tstart = 0;
+                    v.tcount = 0;
+                    v.border = 0;
+                    v.p = points[index];
+                    v.locked = owner[index] == shared ? 1 : 0;
+                    v.origin = static_cast<int>(index);
+                    local.vertices.push_back(v);
+                }
+
+                local.triangles.reserve(ranges[part].second - ranges[part].first);
+                for (auto it = first; it != last; ++it) {
+                    Simplify::Triangle t;
+                    t.deleted = 0;
+                    t.dirty = 0;
+                    for (double& j : t.err) {
+                        j = 0.0;
+                    }
+                    for (int j = 0; j < 3; j++) {
+                        auto pos = std::lower_bound(vertices.begin(),
+                                                    vertices.end(),
+                                                    facets[*it]._aulPoints[j]);
+                        t.v[j] = static_cast<int>(pos - vertices.begin());
+                    }
+                    local.triangles.push_back(t);
+                }
+
+                auto target = static_cast<int>(static_cast<double>(targetSize)
+                                               * static_cast<double>(local.triangles.size())
+                                               / static_cast<double>(numFacets));
+                local.simplify_mesh(target, tolerance);
+            }
+        });
+
+        // merge the parts, the shared vertices are the same in all parts
+        std::vector<int> mergedIndex(points.size(), -1);
+        for (auto& local : parts) {
+            std::vector<int> localIndex(local.vertices.size());
+            for (std::size_t i = 0; i < local.vertices.size(); i++) {
+                Simplify::Vertex& v = local.vertices[i];
+                int& merged = mergedIndex[v.origin];
+                if (!v.locked || merged < 0) {
+                    v.locked = 0;
+                    v.tstart = 0;
+                    v.tcount = 0;
+                    v.border = 0;
+                    merged = static_cast<int>(alg.vertices.size());
+                    alg.vertices.push_back(v);
+                }
+                localIndex[i] = merged;
+            }
+            for (auto& t : local.triangles) {
+                for (int& j : t.v) {
+                    j = localIndex[j];
+                }
+                t.deleted = 0;
+                t.dirty = 0;
+                alg.triangles.push_back(t);
+            }
+            local = Simplify();
         }
     }
+
+    // decimate the whole mesh, this also removes the edges at the borders of the parts
+    alg.simplify_mesh(targetSize, tolerance);
+
+    MeshPointArray new_points;
     MeshFacetArray new_facets;
-    new_facets.reserve(numFacets);
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            MeshFacet face;
-            face._aulPoints[0] = triangle.v[0];
-            face._aulPoints[1] = triangle.v[1];
-            face._aulPoints[2] = triangle.v[2];
-            new_facets.push_back(face);
-        }
+    readSimplify(alg, new_points, new_facets);
+    alg = Simplify();
+
+    MeshKernel result;
+    result.Adopt(new_points, new_facets, true);
+
+    // measure the deviation in both directions
+    float hausdorff = 0.0F;
+    if (result.CountFacets() > 0) {
+        MeshFacetBVH original(myKernel);
+        MeshFacetBVH decimated(result);
+        hausdorff = std::max(maximumDistance(myKernel.GetPoints(), decimated),
+                             maximumDistance(result.GetPoints(), original));
     }
 
-    myKernel.Adopt(new_points, new_facets, true);
+    myKernel.Swap(result);
+    return hausdorff;
 }
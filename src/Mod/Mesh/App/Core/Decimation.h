@@ -24,6 +24,8 @@
 #ifndef MESH_DECIMATION_H
 #define MESH_DECIMATION_H
 
+#include <limits>
+
 #include <Mod/Mesh/MeshGlobal.h>
 
 namespace MeshCore
@@ -36,6 +38,18 @@ public:
     explicit MeshSimplify(MeshKernel&);
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
+    /**
+     * Decimates the mesh to \a targetSize facets on several threads. The mesh is split into
+     * \a partitions spatial parts, 0 means one per thread, that are decimated independently
+     * while the vertices shared by several parts are kept. A final pass over the whole mesh
+     * then removes the remaining edges at the borders of the parts. As with simplify() the
+     * decimation stops earlier if no edge with a quadric error below \a tolerance is left.
+     * \return the Hausdorff distance between the original and the decimated mesh, measured
+     * at the vertices of both meshes.
+     */
+    float simplifyPartitioned(int targetSize,
+                              float tolerance = std::numeric_limits<float>::max(),
+                              unsigned int partitions = 0);
 
 private:
     MeshKernel& myKernel;
@@ -21,7 +21,9 @@
  ***************************************************************************/
 
 
+#include <algorithm>
 #include <cmath>
+#include <thread>
 
 #include "Definitions.h"
 #include <Base/Tools.h>
@@ -42,6 +44,8 @@ float MeshDefinitions::_fMinEdgeLength = MESH_MIN_EDGE_LEN;
 bool MeshDefinitions::_bRemoveMinLength = MESH_REMOVE_MIN_LEN;
 float MeshDefinitions::_fMinEdgeAngle = Base::toRadians<float>(MESH_MIN_EDGE_ANGLE);
 
+int MeshDefinitions::_iMaxThreadCount = 0;
+
 MeshDefinitions::MeshDefinitions() = default;
 
 void MeshDefinitions::SetMinPointDistance(float fMin)
@@ -51,4 +55,17 @@ void MeshDefinitions::SetMinPointDistance(float fMin)
     _fMinPointDistanceD1 = float(std::sqrt((fMin * fMin) / 3.0F));
 }
 
+void MeshDefinitions::SetMaxThreadCount(int count)
+{
+    _iMaxThreadCount = std::max(count, 0);
+}
+
+int MeshDefinitions::GetMaxThreadCount()
+{
+    if (_iMaxThreadCount > 0) {
+        return _iMaxThreadCount;
+    }
+    return std::max(int(std::thread::hardware_concurrency()), 1);
+}
+
 }  // namespace MeshCore
@@ -76,6 +76,17 @@ public:
     static float _fMinEdgeAngle;
 
     static void SetMinPointDistance(float fMin);
+
+    /**
+     * Limits the number of threads the mesh algorithms use, 0 means one thread per core.
+     * This is mainly meant for measuring how the algorithms scale.
+     */
+    static void SetMaxThreadCount(int count);
+    /// Returns the number of threads the mesh algorithms use, at least one
+    static int GetMaxThreadCount();
+
+private:
+    static int _iMaxThreadCount;
 };
 
 }  // namespace MeshCore
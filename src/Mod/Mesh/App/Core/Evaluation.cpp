@@ -22,6 +22,10 @@
 
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <thread>
 #include <vector>
 
 
@@ -30,9 +34,9 @@
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "BVH.h"
 #include "Evaluation.h"
 #include "Functional.h"
-#include "Grid.h"
 #include "Iterator.h"
 #include "TopoAlgorithm.h"
 
@@ -303,12 +307,6 @@ bool MeshEvalSolid::Evaluate()
 namespace MeshCore
 {
 
-struct Edge_Index
-{
-    PointIndex p0, p1;
-    FacetIndex f;
-};
-
 struct Edge_Less
 {
     bool operator()(const Edge_Index& x, const Edge_Index& y) const
@@ -329,33 +327,63 @@ struct Edge_Less
     }
 };
 
+std::vector<Edge_Index> GetSortedEdges(const MeshFacetArray& rFacets, FacetIndex index)
+{
+    const std::size_t numFacets = rFacets.size() - index;
+    const int threads = MeshDefinitions::GetMaxThreadCount();
+    std::vector<Edge_Index> edges(3 * numFacets);
+
+    // build up an array of edges, every task returns the highest point index it has seen
+    std::size_t numTasks =
+        std::clamp<std::size_t>(numFacets / 100000, 1, static_cast<std::size_t>(threads));
+    std::size_t chunk = (numFacets + numTasks - 1) / numTasks;
+    auto collect = [&](std::size_t task) {
+        PointIndex maxIndex = 0;
+        std::size_t last = std::min(numFacets, (task + 1) * chunk);
+        for (std::size_t i = task * chunk; i < last; i++) {
+            const MeshFacet& rFacet = rFacets[index + i];
+            for (int j = 0; j < 3; j++) {
+                Edge_Index& item = edges[3 * i + j];
+                item.p0 = std::min<PointIndex>(rFacet._aulPoints[j], rFacet._aulPoints[(j + 1) % 3]);
+                item.p1 = std::max<PointIndex>(rFacet._aulPoints[j], rFacet._aulPoints[(j + 1) % 3]);
+                item.f = index + i;
+                maxIndex = std::max(maxIndex, item.p1);
+            }
+        }
+        return maxIndex;
+    };
+
+    std::vector<std::future<PointIndex>> futures;
+    for (std::size_t task = 1; task < numTasks; task++) {
+        futures.push_back(std::async(std::launch::async, collect, task));
+    }
+    PointIndex maxIndex = collect(0);
+    for (auto& it : futures) {
+        maxIndex = std::max(maxIndex, it.get());
+    }
+
+    // both point indices fit into one radix key for all practical meshes
+    const int bits = std::bit_width(maxIndex);
+    if (2 * bits <= 64) {
+        auto key = [bits](const Edge_Index& edge) {
+            return (std::uint64_t(edge.p0) << bits) | std::uint64_t(edge.p1);
+        };
+        MeshCore::parallel_radix_sort(edges, key, 2 * bits, threads);
+    }
+    else {
+        MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
+    }
+
+    return edges;
+}
+
 }  // namespace MeshCore
 
 bool MeshEvalTopology::Evaluate()
 {
     // Using and sorting a vector seems to be faster and more memory-efficient
     // than a map.
-    const MeshFacetArray& rclFAry = _rclMesh.GetFacets();
-    std::vector<Edge_Index> edges;
-    edges.reserve(3 * rclFAry.size());
-
-    // build up an array of edges
-    MeshFacetArray::_TConstIterator pI;
-    Base::SequencerLauncher seq("Checking topology...", rclFAry.size());
-    for (pI = rclFAry.begin(); pI != rclFAry.end(); ++pI) {
-        for (int i = 0; i < 3; i++) {
-            Edge_Index item {};
-            item.p0 = std::min<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.p1 = std::max<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.f = pI - rclFAry.begin();
-            edges.push_back(item);
-        }
-
-        seq.next();
-    }
-
-    // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
+    std::vector<Edge_Index> edges = GetSortedEdges(_rclMesh.GetFacets(), 0);
 
     // search for non-manifold edges
     PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
@@ -595,81 +623,45 @@ bool MeshFixSingleFacet::Fixup()
 
 // ----------------------------------------------------------------
 
-bool MeshEvalSelfIntersection::Evaluate()
+namespace
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next();
-        if (aulGridElements.empty()) {
-            continue;
+// If the facets share a common vertex we do not check for self-intersections because they
+// could but usually do not intersect each other and the algorithm below would detect
+// false-positives, otherwise
+bool IsSelfIntersection(const MeshKernel& rMesh, FacetIndex index1, FacetIndex index2)
+{
+    const MeshFacetArray& rFaces = rMesh.GetFacets();
+    const MeshFacet& rface1 = rFaces[index1];
+    const MeshFacet& rface2 = rFaces[index2];
+    for (PointIndex pnt : rface1._aulPoints) {
+        if (rface2.HasPoint(pnt)) {
+            return false;  // ignore facets sharing a common vertex
         }
+    }
 
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
-                // If the facets share a common vertex we do not check for self-intersections
-                // because they could but usually do not intersect each other and the algorithm
-                // below would detect false-positives, otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
+    Base::Vector3f pt1, pt2;
+    MeshGeomFacet facet1 = rMesh.GetFacet(rface1);
+    MeshGeomFacet facet2 = rMesh.GetFacet(rface2);
+    return facet1.IntersectWithFacet(facet2, pt1, pt2) == 2;
+}
+}  // namespace
 
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
-                    }
-                }
-            }
+bool MeshEvalSelfIntersection::Evaluate()
+{
+    // The bounding volume hierarchy splits the mesh for speeding up the calculation
+    MeshFacetBVH bvh(_rclMesh);
+    std::atomic<bool> found {false};
+    std::vector<std::pair<FacetIndex, FacetIndex>> intersection;
+    bvh.GetOverlappingPairs(intersection, [&](FacetIndex index1, FacetIndex index2) {
+        // abort after the first detected self-intersection
+        if (found || !IsSelfIntersection(_rclMesh, index1, index2)) {
+            return false;
         }
-    }
+        found = true;
+        return true;
+    });
 
-    return true;
+    return !found;
 }
 
 void MeshEvalSelfIntersection::GetIntersections(
@@ -700,77 +692,19 @@ void MeshEvalSelfIntersection::GetIntersections(
 void MeshEvalSelfIntersection::GetIntersections(
     std::vector<std::pair<FacetIndex, FacetIndex>>& intersection) const
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-    // intersection.clear();
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next(true);
-        if (aulGridElements.empty()) {
-            continue;
-        }
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
-                // If the facets share a common vertex we do not check for self-intersections
-                // because they could but usually do not intersect each other and the algorithm
-                // below would detect false-positives, otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
+    MeshFacetBVH bvh(_rclMesh);
+    GetIntersections(bvh, intersection);
+}
 
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.emplace_back(*it, *jt);
-                    }
-                }
-            }
-        }
-    }
+void MeshEvalSelfIntersection::GetIntersections(
+    const MeshFacetBVH& bvh,
+    std::vector<std::pair<FacetIndex, FacetIndex>>& intersection) const
+{
+    // Only the pairs of facets with intersecting bounding boxes are tested, the bounding
+    // volume hierarchy adapts to the facet sizes unlike a regular grid
+    bvh.GetOverlappingPairs(intersection, [this](FacetIndex index1, FacetIndex index2) {
+        return IsSelfIntersection(_rclMesh, index1, index2);
+    });
 }
 
 std::vector<FacetIndex> MeshFixSelfIntersection::GetFacets() const
@@ -823,26 +757,7 @@ bool MeshEvalNeighbourhood::Evaluate()
     // Using and sorting a vector seems to be faster and more memory-efficient
     // than a map.
     const MeshFacetArray& rclFAry = _rclMesh.GetFacets();
-    std::vector<Edge_Index> edges;
-    edges.reserve(3 * rclFAry.size());
-
-    // build up an array of edges
-    MeshFacetArray::_TConstIterator pI;
-    Base::SequencerLauncher seq("Checking indices...", rclFAry.size());
-    for (pI = rclFAry.begin(); pI != rclFAry.end(); ++pI) {
-        for (int i = 0; i < 3; i++) {
-            Edge_Index item {};
-            item.p0 = std::min<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.p1 = std::max<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.f = pI - rclFAry.begin();
-            edges.push_back(item);
-        }
-
-        seq.next();
-    }
-
-    // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
+    std::vector<Edge_Index> edges = GetSortedEdges(rclFAry, 0);
 
     PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
     PointIndex f0 = FACET_INDEX_MAX, f1 = FACET_INDEX_MAX;
@@ -890,26 +805,7 @@ std::vector<FacetIndex> MeshEvalNeighbourhood::GetIndices() const
 {
     std::vector<FacetIndex> inds;
     const MeshFacetArray& rclFAry = _rclMesh.GetFacets();
-    std::vector<Edge_Index> edges;
-    edges.reserve(3 * rclFAry.size());
-
-    // build up an array of edges
-    MeshFacetArray::_TConstIterator pI;
-    Base::SequencerLauncher seq("Checking indices...", rclFAry.size());
-    for (pI = rclFAry.begin(); pI != rclFAry.end(); ++pI) {
-        for (int i = 0; i < 3; i++) {
-            Edge_Index item {};
-            item.p0 = std::min<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.p1 = std::max<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.f = pI - rclFAry.begin();
-            edges.push_back(item);
-        }
-
-        seq.next();
-    }
-
-    // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
+    std::vector<Edge_Index> edges = GetSortedEdges(rclFAry, 0);
 
     PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
     PointIndex f0 = FACET_INDEX_MAX, f1 = FACET_INDEX_MAX;
@@ -966,73 +862,67 @@ bool MeshFixNeighbourhood::Fixup()
 
 void MeshKernel::RebuildNeighbours(FacetIndex index)
 {
-    std::vector<Edge_Index> edges;
-    edges.reserve(3 * (this->_aclFacetArray.size() - index));
-
-    // build up an array of edges
-    auto pB = this->_aclFacetArray.begin();
-    for (auto pI = pB + index; pI != this->_aclFacetArray.end(); ++pI) {
-        for (int i = 0; i < 3; i++) {
-            Edge_Index item {};
-            item.p0 = std::min<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.p1 = std::max<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.f = pI - pB;
-            edges.push_back(item);
+    std::vector<Edge_Index> edges = GetSortedEdges(this->_aclFacetArray, index);
+
+    // Link the facets of every run of equal edges. We handle only the cases
+    // for 1 and 2, for all higher values we have a non-manifold that is ignored here.
+    auto linkEdge = [this](const Edge_Index* first, const Edge_Index* last) {
+        PointIndex p0 = first->p0;
+        PointIndex p1 = first->p1;
+        if (last - first == 2) {
+            FacetIndex f0 = first[0].f;
+            FacetIndex f1 = first[1].f;
+            MeshFacet& rFace0 = this->_aclFacetArray[f0];
+            MeshFacet& rFace1 = this->_aclFacetArray[f1];
+            unsigned short side0 = rFace0.Side(p0, p1);
+            unsigned short side1 = rFace1.Side(p0, p1);
+            rFace0._aulNeighbours[side0] = f1;
+            rFace1._aulNeighbours[side1] = f0;
         }
-    }
-
-    // sort the edges
-    // std::sort(edges.begin(), edges.end(), Edge_Less());
-    int threads = int(std::thread::hardware_concurrency());
-    MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
-
-    PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
-    PointIndex f0 = FACET_INDEX_MAX, f1 = FACET_INDEX_MAX;
-    int count = 0;
-    std::vector<Edge_Index>::iterator pE;
-    for (pE = edges.begin(); pE != edges.end(); ++pE) {
-        if (p0 == pE->p0 && p1 == pE->p1) {
-            f1 = pE->f;
-            count++;
+        else if (last - first == 1) {
+            MeshFacet& rFace = this->_aclFacetArray[first->f];
+            unsigned short side = rFace.Side(p0, p1);
+            rFace._aulNeighbours[side] = FACET_INDEX_MAX;
         }
-        else {
-            // we handle only the cases for 1 and 2, for all higher
-            // values we have a non-manifold that is ignored here
-            if (count == 2) {
-                MeshFacet& rFace0 = this->_aclFacetArray[f0];
-                MeshFacet& rFace1 = this->_aclFacetArray[f1];
-                unsigned short side0 = rFace0.Side(p0, p1);
-                unsigned short side1 = rFace1.Side(p0, p1);
-                rFace0._aulNeighbours[side0] = f1;
-                rFace1._aulNeighbours[side1] = f0;
-            }
-            else if (count == 1) {
-                MeshFacet& rFace = this->_aclFacetArray[f0];
-                unsigned short side = rFace.Side(p0, p1);
-                rFace._aulNeighbours[side] = FACET_INDEX_MAX;
+    };
+
+    // Every run touches only the sides of its own facets, so the runs can be
+    // linked concurrently as long as no run is split between two tasks.
+    const Edge_Index* data = edges.data();
+    const std::size_t numEdges = edges.size();
+    auto sameEdge = [data](std::size_t i, std::size_t j) {
+        return data[i].p0 == data[j].p0 && data[i].p1 == data[j].p1;
+    };
+    auto linkRange = [&](std::size_t begin, std::size_t end) {
+        while (begin < end) {
+            std::size_t next = begin + 1;
+            while (next < end && sameEdge(begin, next)) {
+                ++next;
             }
-
-            p0 = pE->p0;
-            p1 = pE->p1;
-            f0 = pE->f;
-            count = 1;
+            linkEdge(data + begin, data + next);
+            begin = next;
+        }
+    };
+
+    std::size_t numTasks = std::clamp<std::size_t>(
+        numEdges / 300000, 1, std::size_t(MeshDefinitions::GetMaxThreadCount()));
+    std::vector<std::size_t> bounds {0};
+    for (std::size_t task = 1; task < numTasks; task++) {
+        std::size_t pos = std::max(bounds.back(), task * numEdges / numTasks);
+        while (pos > 0 && pos < numEdges && sameEdge(pos - 1, pos)) {
+            ++pos;
         }
+        bounds.push_back(pos);
     }
+    bounds.push_back(numEdges);
 
-    // we handle only the cases for 1 and 2, for all higher
-    // values we have a non-manifold that is ignored here
-    if (count == 2) {
-        MeshFacet& rFace0 = this->_aclFacetArray[f0];
-        MeshFacet& rFace1 = this->_aclFacetArray[f1];
-        unsigned short side0 = rFace0.Side(p0, p1);
-        unsigned short side1 = rFace1.Side(p0, p1);
-        rFace0._aulNeighbours[side0] = f1;
-        rFace1._aulNeighbours[side1] = f0;
+    std::vector<std::future<void>> futures;
+    for (std::size_t task = 1; task + 1 < bounds.size(); task++) {
+        futures.push_back(std::async(std::launch::async, linkRange, bounds[task], bounds[task + 1]));
     }
-    else if (count == 1) {
-        MeshFacet& rFace = this->_aclFacetArray[f0];
-        unsigned short side = rFace.Side(p0, p1);
-        rFace._aulNeighbours[side] = FACET_INDEX_MAX;
+    linkRange(bounds[0], bounds[1]);
+    for (auto& it : futures) {
+        it.get();
     }
 }
 
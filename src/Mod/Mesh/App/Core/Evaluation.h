@@ -33,6 +33,8 @@
 namespace MeshCore
 {
 
+class MeshFacetBVH;
+
 /**
  * The MeshEvaluation class checks the mesh kernel for correctness with respect to a
  * certain criterion, such as manifoldness, self-intersections, etc.
@@ -337,6 +339,9 @@ public:
                           std::vector<std::pair<Base::Vector3f, Base::Vector3f>>&) const;
     /// collect the index of all facets with self intersections
     void GetIntersections(std::vector<std::pair<FacetIndex, FacetIndex>>&) const;
+    /// collect the index of all facets with self intersections using the hierarchy \a bvh
+    void GetIntersections(const MeshFacetBVH& bvh,
+                          std::vector<std::pair<FacetIndex, FacetIndex>>&) const;
 };
 
 /**
@@ -390,6 +395,23 @@ public:
 
 // ----------------------------------------------------
 
+/**
+ * An edge of a facet with the lower point index first.
+ */
+struct Edge_Index
+{
+    PointIndex p0, p1;
+    FacetIndex f;
+};
+
+/**
+ * Collects the edges of all facets from \a index on and sorts them by their points,
+ * so that the edges shared by several facets are adjacent.
+ */
+MeshExport std::vector<Edge_Index> GetSortedEdges(const MeshFacetArray& rFacets, FacetIndex index);
+
+// ----------------------------------------------------
+
 /**
  * The MeshEigensystem class actually does not try to check for or fix errors but
  * it provides methods to calculate the mesh's local coordinate system with the center
@@ -24,7 +24,12 @@
 #define MESH_FUNCTIONAL_H
 
 #include <algorithm>
+#include <cstdint>
 #include <future>
+#include <thread>
+#include <vector>
+
+#include "Definitions.h"
 
 
 namespace MeshCore
@@ -62,6 +67,101 @@ static void parallel_sort(Iter begin, Iter end, Pred comp, int threads)
     }
 }
 
+/**
+ * Calls \a func(begin, end) for consecutive chunks of [0, \a count) on all cores, see
+ * MeshDefinitions::GetMaxThreadCount().
+ * A chunk has at least \a minChunk elements, so that small inputs stay on the calling thread.
+ */
+template<class Func>
+static void parallel_for(std::size_t count, std::size_t minChunk, const Func& func)
+{
+    auto threads = std::size_t(MeshDefinitions::GetMaxThreadCount());
+    threads = std::min<std::size_t>(threads, count / std::max<std::size_t>(minChunk, 1));
+    if (threads < 2) {
+        func(std::size_t(0), count);
+        return;
+    }
+
+    std::size_t chunk = (count + threads - 1) / threads;
+    std::vector<std::future<void>> futures;
+    for (std::size_t begin = chunk; begin < count; begin += chunk) {
+        futures.push_back(std::async(std::launch::async,
+                                     std::cref(func),
+                                     begin,
+                                     std::min(begin + chunk, count)));
+    }
+    func(std::size_t(0), chunk);
+    for (auto& it : futures) {
+        it.get();
+    }
+}
+
+/**
+ * Sorts \a values by the unsigned integer returned by \a key, of which only the lowest
+ * \a keyBits bits are used. This is a stable LSD radix sort, each pass distributes the
+ * elements with per thread histograms.
+ */
+template<class T, class Key>
+static void parallel_radix_sort(std::vector<T>& values, Key key, int keyBits, int threads)
+{
+    constexpr int digitBits = 11;
+    constexpr std::size_t radix = std::size_t(1) << digitBits;
+    const std::size_t count = values.size();
+
+    // a thread should at least have a few histograms worth of elements
+    std::size_t numThreads = std::max<std::size_t>(threads, 1);
+    numThreads = std::max<std::size_t>(std::min<std::size_t>(numThreads, count / (16 * radix)), 1);
+    std::size_t chunk = (count + numThreads - 1) / numThreads;
+
+    auto runChunks = [&](auto func) {
+        std::vector<std::future<void>> futures;
+        for (std::size_t t = 1; t < numThreads; t++) {
+            futures.push_back(std::async(std::launch::async, func, t));
+        }
+        func(std::size_t(0));
+        for (auto& it : futures) {
+            it.get();
+        }
+    };
+
+    std::vector<T> buffer(count);
+    std::vector<std::size_t> offsets(numThreads * radix);
+    for (int shift = 0; shift < keyBits; shift += digitBits) {
+        auto digit = [&key, shift](const T& value) {
+            return static_cast<std::size_t>((std::uint64_t(key(value)) >> shift) & (radix - 1));
+        };
+
+        std::fill(offsets.begin(), offsets.end(), 0);
+        runChunks([&](std::size_t t) {
+            std::size_t* hist = offsets.data() + t * radix;
+            std::size_t last = std::min(count, (t + 1) * chunk);
+            for (std::size_t i = t * chunk; i < last; i++) {
+                hist[digit(values[i])]++;
+            }
+        });
+
+        // the elements of a digit go in the order of the chunks
+        std::size_t sum = 0;
+        for (std::size_t d = 0; d < radix; d++) {
+            for (std::size_t t = 0; t < numThreads; t++) {
+                std::size_t num = offsets[t * radix + d];
+                offsets[t * radix + d] = sum;
+                sum += num;
+            }
+        }
+
+        runChunks([&](std::size_t t) {
+            std::size_t* pos = offsets.data() + t * radix;
+            std::size_t last = std::min(count, (t + 1) * chunk);
+            for (std::size_t i = t * chunk; i < last; i++) {
+                buffer[pos[digit(values[i])]++] = values[i];
+            }
+        });
+
+        values.swap(buffer);
+    }
+}
+
 }  // namespace MeshCore
 
 
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <iterator>
+
+#include "AsciiParser.h"
+
+
+using namespace MeshCore;
+
+bool AsciiParser::ReadAll(std::istream& input, std::string& buffer)
+{
+    buffer.clear();
+    if (!input || input.bad()) {
+        return false;
+    }
+
+    std::streambuf* buf = input.rdbuf();
+    if (!buf) {
+        return false;
+    }
+
+    std::streamoff curr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+    std::streamoff end = buf->pubseekoff(0, std::ios::end, std::ios::in);
+    if (curr >= 0 && end >= curr) {
+        buf->pubseekoff(curr, std::ios::beg, std::ios::in);
+        buffer.resize(static_cast<std::size_t>(end - curr));
+        input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.resize(static_cast<std::size_t>(input.gcount()));
+    }
+    else {
+        // not seekable
+        buffer.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+
+    return true;
+}
+
+std::vector<std::string_view> AsciiParser::SplitLines(std::string_view text,
+                                                      std::size_t blockSize)
+{
+    std::vector<std::string_view> blocks;
+    blockSize = std::max<std::size_t>(blockSize, 1);
+    while (!text.empty()) {
+        std::size_t pos = text.size() > blockSize ? text.find('\n', blockSize) : text.size();
+        pos = pos == std::string_view::npos ? text.size() : std::min(pos + 1, text.size());
+        blocks.push_back(text.substr(0, pos));
+        text.remove_prefix(pos);
+    }
+    return blocks;
+}
+
+std::size_t AsciiParser::CountLines(std::string_view text)
+{
+    std::size_t count = 0;
+    const char* ptr = text.data();
+    const char* end = ptr + text.size();
+    while (ptr < end) {
+        const void* pos = std::memchr(ptr, '\n', static_cast<std::size_t>(end - ptr));
+        count++;
+        if (!pos) {
+            break;
+        }
+        ptr = static_cast<const char*>(pos) + 1;
+    }
+    return count;
+}
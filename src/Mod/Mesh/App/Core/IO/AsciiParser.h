@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#ifndef MESH_IO_ASCII_PARSER_H
+#define MESH_IO_ASCII_PARSER_H
+
+#include <charconv>
+#include <cstdlib>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <Mod/Mesh/MeshGlobal.h>
+
+
+namespace MeshCore
+{
+
+/**
+ * The AsciiParser class provides the building blocks to parse line based text formats on
+ * several threads. The whole input is read into memory and split into blocks that end at a
+ * line break, so that every block can be parsed independently.
+ */
+class MeshExport AsciiParser
+{
+public:
+    /// Reads the rest of \a input into \a buffer
+    static bool ReadAll(std::istream& input, std::string& buffer);
+    /// Splits \a text into blocks of about \a blockSize characters that end after a line break
+    static std::vector<std::string_view> SplitLines(std::string_view text, std::size_t blockSize);
+    /// Returns the number of lines of \a text, a last line without line break is counted
+    static std::size_t CountLines(std::string_view text);
+
+    /// Returns the next line without the line break and removes it from \a text
+    static std::string_view NextLine(std::string_view& text)
+    {
+        std::size_t pos = text.find('\n');
+        std::string_view line = text.substr(0, pos);
+        text.remove_prefix(pos == std::string_view::npos ? text.size() : pos + 1);
+        return Trim(line);
+    }
+    /// Removes leading and trailing white space
+    static std::string_view Trim(std::string_view text)
+    {
+        std::size_t first = text.find_first_not_of(" \t\r\f\v");
+        if (first == std::string_view::npos) {
+            return {};
+        }
+        std::size_t last = text.find_last_not_of(" \t\r\f\v");
+        return text.substr(first, last - first + 1);
+    }
+    /// Returns the next token delimited by one of \a separators and removes it from \a text
+    static std::string_view NextToken(std::string_view& text, std::string_view separators)
+    {
+        std::size_t first = text.find_first_not_of(separators);
+        if (first == std::string_view::npos) {
+            text = {};
+            return {};
+        }
+        std::size_t last = text.find_first_of(separators, first);
+        std::string_view token = text.substr(first, last - first);
+        text.remove_prefix(last == std::string_view::npos ? text.size() : last);
+        return token;
+    }
+    /// Converts the whole \a token to a number
+    template<class T>
+    static bool ToNumber(std::string_view token, T& value)
+    {
+        // from_chars doesn't accept an explicit plus sign
+        if (!token.empty() && token.front() == '+') {
+            token.remove_prefix(1);
+        }
+        const char* end = token.data() + token.size();
+#if defined(__cpp_lib_to_chars)
+        auto result = std::from_chars(token.data(), end, value);
+        return result.ec == std::errc() && result.ptr == end;
+#else
+        // older libc++ only converts integers
+        if constexpr (std::is_floating_point_v<T>) {
+            std::string str(token);
+            char* last = nullptr;
+            value = static_cast<T>(std::strtod(str.c_str(), &last));
+            return !str.empty() && last == str.c_str() + str.size();
+        }
+        else {
+            auto result = std::from_chars(token.data(), end, value);
+            return result.ec == std::errc() && result.ptr == end;
+        }
+#endif
+    }
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_IO_ASCII_PARSER_H
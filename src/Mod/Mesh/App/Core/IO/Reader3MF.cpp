@@ -20,12 +20,23 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
+#include <array>
 #include <boost/tokenizer.hpp>
+#include <cctype>
+#include <charconv>
 #include <memory>
 #include <ostream>
+#include <set>
 #include <sstream>
-#include <xercesc/dom/DOM.hpp>
-#include <xercesc/parsers/XercesDOMParser.hpp>
+#include <stdexcept>
+#include <xercesc/sax/SAXException.hpp>
+#include <xercesc/sax2/Attributes.hpp>
+#include <xercesc/sax2/DefaultHandler.hpp>
+#include <xercesc/sax2/SAX2XMLReader.hpp>
+#include <xercesc/sax2/XMLReaderFactory.hpp>
+#include <xercesc/util/XMLString.hpp>
+#include <xercesc/util/XMLUni.hpp>
 
 
 #include "Core/MeshIO.h"
@@ -41,6 +52,194 @@
 using namespace MeshCore;
 using namespace XERCES_CPP_NAMESPACE;
 
+namespace
+{
+
+bool isElement(const XMLCh* const qname, const XMLCh* const name)
+{
+    return XMLString::equals(qname, name);
+}
+
+std::string readString(const XMLCh* const value)
+{
+    return value ? std::string(StrX(value).c_str()) : std::string();
+}
+
+/// Reads the number of an attribute without transcoding it, and regardless of the locale
+template<typename T>
+T readNumber(const XMLCh* const value)
+{
+    constexpr const std::size_t maxLength = 64;
+    constexpr const XMLCh maxChar = 127;
+    std::array<char, maxLength> buffer {};
+    std::size_t length = 0;
+    for (; value && value[length] != 0; length++) {
+        if (length == maxLength || value[length] > maxChar) {
+            throw std::invalid_argument("Invalid number in 3MF model");
+        }
+        buffer[length] = static_cast<char>(value[length]);
+    }
+
+    const char* first = buffer.data();
+    const char* last = first + length;
+    while (first != last && std::isspace(static_cast<unsigned char>(*first))) {
+        ++first;
+    }
+    if (first != last && *first == '+') {
+        ++first;
+    }
+    T number {};
+    if (std::from_chars(first, last, number).ec != std::errc()) {
+        throw std::invalid_argument("Invalid number in 3MF model");
+    }
+    return number;
+}
+
+}  // namespace
+
+/// Reads a model file element by element, the vertices and triangles go right into the arrays
+class Reader3MF::ModelHandler: public DefaultHandler
+{
+public:
+    ModelHandler(Reader3MF& reader, const Component& comp)
+        : reader(reader)
+        , comp(comp)
+    {}
+
+    void startElement(const XMLCh* const uri,
+                      const XMLCh* const localname,
+                      const XMLCh* const qname,
+                      const Attributes& attrs) override
+    {
+        (void)uri;
+        (void)localname;
+        if (inMesh) {
+            if (isElement(qname, XStrLiteral("vertex").unicodeForm())) {
+                const XMLCh* x = attrs.getValue(XStrLiteral("x").unicodeForm());
+                const XMLCh* y = attrs.getValue(XStrLiteral("y").unicodeForm());
+                const XMLCh* z = attrs.getValue(XStrLiteral("z").unicodeForm());
+                if (x && y && z) {
+                    points.emplace_back(readNumber<float>(x),
+                                        readNumber<float>(y),
+                                        readNumber<float>(z));
+                }
+            }
+            else if (isElement(qname, XStrLiteral("triangle").unicodeForm())) {
+                const XMLCh* v1 = attrs.getValue(XStrLiteral("v1").unicodeForm());
+                const XMLCh* v2 = attrs.getValue(XStrLiteral("v2").unicodeForm());
+                const XMLCh* v3 = attrs.getValue(XStrLiteral("v3").unicodeForm());
+                if (v1 && v2 && v3) {
+                    facets.emplace_back(readNumber<PointIndex>(v1),
+                                        readNumber<PointIndex>(v2),
+                                        readNumber<PointIndex>(v3));
+                }
+            }
+        }
+        else if (isElement(qname, XStrLiteral("resources").unicodeForm())) {
+            inResources = true;
+            hasResources = true;
+        }
+        else if (inResources && isElement(qname, XStrLiteral("object").unicodeForm())) {
+            objectId = -1;
+            if (const XMLCh* id = attrs.getValue(XStrLiteral("id").unicodeForm())) {
+                objectId = readNumber<int>(id);
+            }
+            hasMesh = false;
+            objectComponents.clear();
+        }
+        else if (objectId >= 0 && isElement(qname, XStrLiteral("mesh").unicodeForm())) {
+            inMesh = !hasMesh;
+            points.clear();
+            facets.clear();
+        }
+        else if (objectId >= 0 && isElement(qname, XStrLiteral("component").unicodeForm())) {
+            Component component;
+            component.id = objectId;
+            component.path = readString(attrs.getValue(XStrLiteral("p:path").unicodeForm()));
+            if (const XMLCh* id = attrs.getValue(XStrLiteral("objectid").unicodeForm())) {
+                component.objectId = readNumber<int>(id);
+            }
+            std::optional<Base::Matrix4D> mat =
+                ReadTransform(readString(attrs.getValue(XStrLiteral("transform").unicodeForm())));
+            if (mat) {
+                component.transform = mat.value();
+            }
+            if (component.id > 0 && component.objectId >= 0 && !component.path.empty()) {
+                objectComponents.push_back(component);
+            }
+        }
+        else if (isElement(qname, XStrLiteral("build").unicodeForm())) {
+            inBuild = true;
+            hasBuild = true;
+        }
+        else if (inBuild && isElement(qname, XStrLiteral("item").unicodeForm())) {
+            if (const XMLCh* id = attrs.getValue(XStrLiteral("objectid").unicodeForm())) {
+                Item item;
+                item.objectId = readNumber<int>(id);
+                item.transform = ReadTransform(
+                    readString(attrs.getValue(XStrLiteral("transform").unicodeForm())));
+                items.push_back(item);
+            }
+        }
+    }
+
+    void endElement(const XMLCh* const uri,
+                    const XMLCh* const localname,
+                    const XMLCh* const qname) override
+    {
+        (void)uri;
+        (void)localname;
+        if (inMesh) {
+            if (isElement(qname, XStrLiteral("mesh").unicodeForm())) {
+                inMesh = false;
+                hasMesh = true;
+                reader.AddMesh(objectId, points, facets, comp);
+            }
+        }
+        else if (isElement(qname, XStrLiteral("object").unicodeForm())) {
+            // the components are only used by objects without a mesh
+            if (!hasMesh) {
+                for (const auto& it : objectComponents) {
+                    reader.AddComponent(it);
+                }
+            }
+            objectId = -1;
+        }
+        else if (isElement(qname, XStrLiteral("resources").unicodeForm())) {
+            inResources = false;
+        }
+        else if (isElement(qname, XStrLiteral("build").unicodeForm())) {
+            inBuild = false;
+        }
+    }
+
+    bool hasResourcesAndBuild() const
+    {
+        return hasResources && hasBuild;
+    }
+    const std::vector<Item>& getItems() const
+    {
+        return items;
+    }
+
+private:
+    Reader3MF& reader;
+    const Component& comp;
+
+    bool inResources = false;
+    bool inBuild = false;
+    bool inMesh = false;
+    bool hasResources = false;
+    bool hasBuild = false;
+
+    int objectId = -1;
+    bool hasMesh = false;
+    std::vector<Component> objectComponents;
+    MeshPointArray points;
+    MeshFacetArray facets;
+    std::vector<Item> items;
+};
+
 Reader3MF::Reader3MF(std::istream& str)
 {
     file = std::make_unique<zipios::ZipHeader>(str);
@@ -105,138 +304,88 @@ bool Reader3MF::LoadModel(std::istream& str, const Component& comp)
     catch (const XMLException&) {
         return false;
     }
-    catch (const DOMException&) {
+    catch (const SAXException&) {
         return false;
     }
 }
 
-std::unique_ptr<XercesDOMParser> Reader3MF::makeDomParser()
-{
-    std::unique_ptr<XercesDOMParser> parser(new XercesDOMParser);
-    parser->setValidationScheme(XercesDOMParser::Val_Auto);
-    parser->setDoNamespaces(false);
-    parser->setDoSchema(false);
-    parser->setValidationSchemaFullChecking(false);
-    parser->setCreateEntityReferenceNodes(false);
-    return parser;
-}
-
 bool Reader3MF::TryLoadModel(std::istream& str, const Component& comp)
 {
     if (!str) {
         return false;
     }
 
+    ModelHandler handler(*this, comp);
+    std::unique_ptr<SAX2XMLReader> parser(XMLReaderFactory::createXMLReader());
+    parser->setFeature(XMLUni::fgSAX2CoreNameSpaces, false);
+    parser->setFeature(XMLUni::fgSAX2CoreValidation, false);
+    parser->setContentHandler(&handler);
+    parser->setErrorHandler(&handler);
+
     Base::StdInputSource inputSource(str, comp.path.c_str());
-    std::unique_ptr<XercesDOMParser> parser = makeDomParser();
     parser->parse(inputSource);
-    std::unique_ptr<DOMDocument> xmlDocument(parser->adoptDocument());
-    return LoadModel(*xmlDocument, comp);
+    LoadItems(handler.getItems());
+    return handler.hasResourcesAndBuild() && !meshes.empty();
 }
 
-bool Reader3MF::LoadModel(DOMDocument& xmlDocument, const Component& comp)
+void Reader3MF::AddMesh(int id,
+                        MeshPointArray& points,
+                        MeshFacetArray& facets,
+                        const Component& comp)
 {
-    DOMNodeList* nodes = xmlDocument.getElementsByTagName(XStrLiteral("model").unicodeForm());
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* node = nodes->item(i);
-        if (node->getNodeType() == DOMNode::ELEMENT_NODE) {
-            return LoadResourcesAndBuild(static_cast<DOMElement*>(node), comp);
-        }
+    if (meshes.contains(id)) {
+        return;
     }
 
-    return false;
-}
+    MeshCleanup meshCleanup(points, facets);
+    meshCleanup.RemoveInvalids();
+    MeshPointFacetAdjacency meshAdj(points.size(), facets);
+    meshAdj.SetFacetNeighbourhood();
 
-bool Reader3MF::LoadResourcesAndBuild(DOMElement* node, const Component& comp)
-{
-    bool resource =
-        LoadResources(node->getElementsByTagName(XStrLiteral("resources").unicodeForm()), comp);
-    bool build = LoadBuild(node->getElementsByTagName(XStrLiteral("build").unicodeForm()));
-    return (resource && build);
+    auto it = meshes.emplace(id, MeshKernelAndTransform(MeshKernel(), comp.transform)).first;
+    it->second.first.Adopt(points, facets);
 }
 
-bool Reader3MF::LoadResources(DOMNodeList* nodes, const Component& comp)
+void Reader3MF::AddComponent(const Component& comp)
 {
-    if (!nodes) {
-        return false;
-    }
-
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* node = nodes->item(i);
-        if (node->getNodeType() == DOMNode::ELEMENT_NODE) {
-            auto elem = static_cast<DOMElement*>(node);
-            DOMNodeList* objectList =
-                elem->getElementsByTagName(XStrLiteral("object").unicodeForm());
-            return LoadObject(objectList, comp);
-        }
-    }
-
-    return false;
+    components.push_back(comp);
 }
 
-bool Reader3MF::LoadBuild(DOMNodeList* nodes)
+void Reader3MF::LoadItems(const std::vector<Item>& items)
 {
-    if (!nodes) {
-        return false;
+    // an object placed by several items is loaded once more for each further item
+    std::set<int> placed;
+    int nextId = 0;
+    for (const auto& it : meshes) {
+        nextId = std::max(nextId, it.first + 1);
     }
 
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* node = nodes->item(i);
-        if (node->getNodeType() == DOMNode::ELEMENT_NODE) {
-            auto elem = static_cast<DOMElement*>(node);
-            DOMNodeList* objectList = elem->getElementsByTagName(XStrLiteral("item").unicodeForm());
-            return LoadItems(objectList);
+    for (const auto& item : items) {
+        auto it = meshes.find(item.objectId);
+        if (it != meshes.end()) {
+            if (!placed.insert(item.objectId).second) {
+                MeshKernelAndTransform instance(it->second.first, Base::Matrix4D());
+                it = meshes.emplace(nextId++, std::move(instance)).first;
+            }
+            if (item.transform) {
+                it->second.second = item.transform.value();
+            }
         }
-    }
-
-    return false;
-}
-
-bool Reader3MF::LoadItems(DOMNodeList* nodes)
-{
-    if (!nodes) {
-        return false;
-    }
 
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* itemNode = nodes->item(i);
-        DOMNamedNodeMap* nodeMap = itemNode->getAttributes();
-        LoadItem(nodeMap);
-    }
-
-    return true;
-}
-
-void Reader3MF::LoadItem(DOMNamedNodeMap* nodeMap)
-{
-    DOMNode* idAttr = nodeMap->getNamedItem(XStrLiteral("objectid").unicodeForm());
-    if (idAttr) {
-        std::string id = StrX(idAttr->getNodeValue()).c_str();
-        int idValue = std::stoi(id);
-
-        DOMNode* transformAttr = nodeMap->getNamedItem(XStrLiteral("transform").unicodeForm());
-        if (transformAttr) {
-            std::optional<Base::Matrix4D> mat = ReadTransform(transformAttr);
-            if (mat) {
-                auto it = meshes.find(idValue);
-                if (it != meshes.end()) {
-                    it->second.second = mat.value();
-                }
-
-                auto jt = std::find_if(components.begin(),
-                                       components.end(),
-                                       [idValue](const Component& comp) {
-                                           return comp.id == idValue;
-                                       });
-                if (jt != components.end()) {
-                    jt->transform = mat.value();
-                }
+        if (item.transform) {
+            auto jt = std::find_if(components.begin(),
+                                   components.end(),
+                                   [&item](const Component& comp) {
+                                       return comp.id == item.objectId;
+                                   });
+            if (jt != components.end()) {
+                jt->transform = item.transform.value();
             }
         }
     }
 }
 
-std::optional<Base::Matrix4D> Reader3MF::ReadTransform(DOMNode* transformAttr)
+std::optional<Base::Matrix4D> Reader3MF::ReadTransform(const std::string& transform)
 {
     constexpr const std::size_t numEntries = 12;
     using Pos2d = std::array<std::array<int, 2>, numEntries>;
@@ -249,58 +398,24 @@ std::optional<Base::Matrix4D> Reader3MF::ReadTransform(DOMNode* transformAttr)
     }};
     // clang-format on
 
-    if (transformAttr) {
-        std::string transform = StrX(transformAttr->getNodeValue()).c_str();
-        boost::char_separator<char> sep(" ,");
-        boost::tokenizer<boost::char_separator<char>> tokens(transform, sep);
-        std::vector<std::string> token_results;
-        token_results.assign(tokens.begin(), tokens.end());
-        if (token_results.size() == numEntries) {
-            Base::Matrix4D mat;
-            // NOLINTBEGIN
-            int index = 0;
-            for (const auto& it : pos) {
-                auto [r, c] = it;
-                mat[r][c] = std::stod(token_results[index++]);
-            }
-            // NOLINTEND
-            return mat;
+    boost::char_separator<char> sep(" ,");
+    boost::tokenizer<boost::char_separator<char>> tokens(transform, sep);
+    std::vector<std::string> token_results;
+    token_results.assign(tokens.begin(), tokens.end());
+    if (token_results.size() == numEntries) {
+        Base::Matrix4D mat;
+        // NOLINTBEGIN
+        int index = 0;
+        for (const auto& it : pos) {
+            auto [r, c] = it;
+            mat[r][c] = std::stod(token_results[index++]);
         }
+        // NOLINTEND
+        return mat;
     }
     return {};
 }
 
-bool Reader3MF::LoadObject(DOMNodeList* nodes, const Component& comp)
-{
-    if (!nodes) {
-        return false;
-    }
-
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* objectNode = nodes->item(i);
-        if (objectNode->getNodeType() == DOMNode::ELEMENT_NODE) {
-            DOMNode* idAttr =
-                objectNode->getAttributes()->getNamedItem(XStrLiteral("id").unicodeForm());
-            auto elem = static_cast<DOMElement*>(objectNode);
-            if (idAttr) {
-                int id = std::stoi(StrX(idAttr->getNodeValue()).c_str());
-                DOMNodeList* meshNode =
-                    elem->getElementsByTagName(XStrLiteral("mesh").unicodeForm());
-                if (meshNode->getLength() > 0) {
-                    LoadMesh(meshNode, id, comp);
-                }
-                else {
-                    DOMNodeList* compNode =
-                        elem->getElementsByTagName(XStrLiteral("components").unicodeForm());
-                    LoadComponents(compNode, id);
-                }
-            }
-        }
-    }
-
-    return (!meshes.empty());
-}
-
 bool Reader3MF::LoadMeshFromComponents()
 {
     for (const auto& it : components) {
@@ -311,174 +426,3 @@ bool Reader3MF::LoadMeshFromComponents()
 
     return (!meshes.empty());
 }
-
-void Reader3MF::LoadComponents(DOMNodeList* nodes, int id)
-{
-    if (!nodes) {
-        return;
-    }
-
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* objectNode = nodes->item(i);
-        if (objectNode->getNodeType() == DOMNode::ELEMENT_NODE) {
-            auto elem = static_cast<DOMElement*>(objectNode);
-            DOMNodeList* compNode =
-                elem->getElementsByTagName(XStrLiteral("component").unicodeForm());
-            if (compNode->getLength() > 0) {
-                LoadComponent(compNode, id);
-            }
-        }
-    }
-}
-
-void Reader3MF::LoadComponent(DOMNodeList* nodes, int id)
-{
-    if (!nodes) {
-        return;
-    }
-
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* compNode = nodes->item(i);
-        if (compNode->getNodeType() == DOMNode::ELEMENT_NODE) {
-            if (DOMNamedNodeMap* attr = compNode->getAttributes()) {
-                LoadComponent(attr, id);
-            }
-        }
-    }
-}
-
-void Reader3MF::LoadComponent(DOMNamedNodeMap* attr, int id)
-{
-    auto validComponent = [](const Component& comp) {
-        return (comp.id > 0 && comp.objectId >= 0 && !comp.path.empty());
-    };
-
-    Component component;
-    component.id = id;
-    if (DOMNode* pathAttr = attr->getNamedItem(XStrLiteral("p:path").unicodeForm())) {
-        component.path = StrX(pathAttr->getNodeValue()).c_str();
-    }
-    if (DOMNode* idAttr = attr->getNamedItem(XStrLiteral("objectid").unicodeForm())) {
-        component.objectId = std::stoi(StrX(idAttr->getNodeValue()).c_str());
-    }
-    if (DOMNode* transformAttr = attr->getNamedItem(XStrLiteral("transform").unicodeForm())) {
-        std::optional<Base::Matrix4D> mat = ReadTransform(transformAttr);
-        if (mat) {
-            component.transform = mat.value();
-        }
-    }
-    if (validComponent(component)) {
-        components.push_back(component);
-    }
-}
-
-void Reader3MF::LoadMesh(DOMNodeList* nodes, int id, const Component& comp)
-{
-    if (!nodes) {
-        return;
-    }
-
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* node = nodes->item(i);
-        if (node->getNodeType() == DOMNode::ELEMENT_NODE) {
-            auto elem = static_cast<DOMElement*>(node);
-            MeshPointArray points;
-            MeshFacetArray facets;
-            LoadVertices(elem->getElementsByTagName(XStrLiteral("vertices").unicodeForm()), points);
-            LoadTriangles(elem->getElementsByTagName(XStrLiteral("triangles").unicodeForm()),
-                          facets);
-
-            MeshCleanup meshCleanup(points, facets);
-            meshCleanup.RemoveInvalids();
-            MeshPointFacetAdjacency meshAdj(points.size(), facets);
-            meshAdj.SetFacetNeighbourhood();
-
-            Base::Matrix4D mat = comp.transform;
-            MeshKernel kernel;
-            kernel.Adopt(points, facets);
-            meshes.emplace(id, std::make_pair(kernel, mat));
-        }
-    }
-}
-
-void Reader3MF::LoadVertices(DOMNodeList* nodes, MeshPointArray& points)
-{
-    if (!nodes) {
-        return;
-    }
-
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* node = nodes->item(i);
-        if (node->getNodeType() == DOMNode::ELEMENT_NODE) {
-            auto elem = static_cast<DOMElement*>(node);
-            DOMNodeList* vertexList =
-                elem->getElementsByTagName(XStrLiteral("vertex").unicodeForm());
-            if (vertexList) {
-                ReadVertices(vertexList, points);
-            }
-        }
-    }
-}
-
-void Reader3MF::ReadVertices(DOMNodeList* vertexList, MeshPointArray& points)
-{
-    XMLSize_t numVertices = vertexList->getLength();
-    points.reserve(numVertices);
-    for (XMLSize_t j = 0; j < numVertices; j++) {
-        DOMNode* vertexNode = vertexList->item(j);
-        DOMNamedNodeMap* attr = vertexNode->getAttributes();
-        if (attr) {
-            DOMNode* xAttr = attr->getNamedItem(XStrLiteral("x").unicodeForm());
-            DOMNode* yAttr = attr->getNamedItem(XStrLiteral("y").unicodeForm());
-            DOMNode* zAttr = attr->getNamedItem(XStrLiteral("z").unicodeForm());
-            if (xAttr && yAttr && zAttr) {
-                // NOLINTBEGIN
-                float x = std::stof(StrX(xAttr->getNodeValue()).c_str());
-                float y = std::stof(StrX(yAttr->getNodeValue()).c_str());
-                float z = std::stof(StrX(zAttr->getNodeValue()).c_str());
-                points.emplace_back(x, y, z);
-                // NOLINTEND
-            }
-        }
-    }
-}
-
-void Reader3MF::LoadTriangles(DOMNodeList* nodes, MeshFacetArray& facets)
-{
-    if (!nodes) {
-        return;
-    }
-
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* node = nodes->item(i);
-        if (node->getNodeType() == DOMNode::ELEMENT_NODE) {
-            auto elem = static_cast<DOMElement*>(node);
-            DOMNodeList* triangleList =
-                elem->getElementsByTagName(XStrLiteral("triangle").unicodeForm());
-            if (triangleList) {
-                ReadTriangles(triangleList, facets);
-            }
-        }
-    }
-}
-
-void Reader3MF::ReadTriangles(DOMNodeList* triangleList, MeshFacetArray& facets)
-{
-    XMLSize_t numTriangles = triangleList->getLength();
-    facets.reserve(numTriangles);
-    for (XMLSize_t j = 0; j < numTriangles; j++) {
-        DOMNode* triangleNode = triangleList->item(j);
-        DOMNamedNodeMap* attr = triangleNode->getAttributes();
-        if (attr) {
-            DOMNode* v1Attr = attr->getNamedItem(XStrLiteral("v1").unicodeForm());
-            DOMNode* v2Attr = attr->getNamedItem(XStrLiteral("v2").unicodeForm());
-            DOMNode* v3Attr = attr->getNamedItem(XStrLiteral("v3").unicodeForm());
-            if (v1Attr && v2Attr && v3Attr) {
-                PointIndex v1 = std::stoul(StrX(v1Attr->getNodeValue()).c_str());
-                PointIndex v2 = std::stoul(StrX(v2Attr->getNodeValue()).c_str());
-                PointIndex v3 = std::stoul(StrX(v3Attr->getNodeValue()).c_str());
-                facets.emplace_back(v1, v2, v3);
-            }
-        }
-    }
-}
@@ -30,17 +30,7 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
-#include <xercesc/util/XercesDefs.hpp>
-
-namespace XERCES_CPP_NAMESPACE
-{
-class DOMDocument;
-class DOMElement;
-class DOMNode;
-class DOMNodeList;
-class DOMNamedNodeMap;
-class XercesDOMParser;
-}  // namespace XERCES_CPP_NAMESPACE
+#include <vector>
 
 namespace zipios
 {
@@ -71,6 +61,8 @@ public:
     explicit Reader3MF(const std::string& filename);
     /*!
      * \brief Load the mesh from the input stream or file
+     * The model is parsed as a stream, so that the vertices and triangles go right into the
+     * mesh arrays. An object placed by several build items is loaded once per item.
      * \return true on success and false otherwise
      */
     bool Load();
@@ -92,28 +84,21 @@ private:
         std::string path;
         Base::Matrix4D transform;
     };
-    static std::unique_ptr<XERCES_CPP_NAMESPACE::XercesDOMParser> makeDomParser();
+    struct Item
+    {
+        int objectId = -1;
+        std::optional<Base::Matrix4D> transform;
+    };
+    class ModelHandler;
     bool TryLoad();
     bool LoadModel(std::istream&);
     bool LoadModel(std::istream&, const Component&);
     bool TryLoadModel(std::istream&, const Component&);
-    bool LoadModel(XERCES_CPP_NAMESPACE::DOMDocument&, const Component&);
-    bool LoadResourcesAndBuild(XERCES_CPP_NAMESPACE::DOMElement*, const Component&);
-    bool LoadResources(XERCES_CPP_NAMESPACE::DOMNodeList*, const Component&);
-    bool LoadBuild(XERCES_CPP_NAMESPACE::DOMNodeList*);
-    bool LoadItems(XERCES_CPP_NAMESPACE::DOMNodeList*);
-    void LoadItem(XERCES_CPP_NAMESPACE::DOMNamedNodeMap*);
-    bool LoadObject(XERCES_CPP_NAMESPACE::DOMNodeList*, const Component&);
-    void LoadComponents(XERCES_CPP_NAMESPACE::DOMNodeList*, int id);
-    void LoadComponent(XERCES_CPP_NAMESPACE::DOMNodeList*, int id);
-    void LoadComponent(XERCES_CPP_NAMESPACE::DOMNamedNodeMap*, int id);
-    void LoadMesh(XERCES_CPP_NAMESPACE::DOMNodeList*, int id, const Component&);
-    void LoadVertices(XERCES_CPP_NAMESPACE::DOMNodeList*, MeshPointArray&);
-    void ReadVertices(XERCES_CPP_NAMESPACE::DOMNodeList*, MeshPointArray&);
-    void LoadTriangles(XERCES_CPP_NAMESPACE::DOMNodeList*, MeshFacetArray&);
-    void ReadTriangles(XERCES_CPP_NAMESPACE::DOMNodeList*, MeshFacetArray&);
+    void AddMesh(int id, MeshPointArray& points, MeshFacetArray& facets, const Component&);
+    void AddComponent(const Component&);
+    void LoadItems(const std::vector<Item>&);
     bool LoadMeshFromComponents();
-    std::optional<Base::Matrix4D> ReadTransform(XERCES_CPP_NAMESPACE::DOMNode*);
+    static std::optional<Base::Matrix4D> ReadTransform(const std::string&);
 
 private:
     std::vector<Component> components;
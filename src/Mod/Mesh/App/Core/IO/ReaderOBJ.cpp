@@ -20,12 +20,12 @@
  *                                                                         *
  ***************************************************************************/
 
-#include <boost/algorithm/string.hpp>
-#include <boost/lexical_cast.hpp>
 #include <boost/tokenizer.hpp>
+#include <array>
 #include <istream>
 #include <map>
 
+#include "Core/Functional.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
 #include <Base/Color.h>
@@ -33,6 +33,7 @@
 #include <Base/Stream.h>
 #include <Base/Tools.h>
 
+#include "AsciiParser.h"
 #include "ReaderOBJ.h"
 
 
@@ -41,121 +42,128 @@ using namespace MeshCore;
 namespace
 {
 
-class ReaderOBJImp
+/// A statement changing the group or material of the faces that follow it
+struct StatementOBJ
 {
-public:
-    using string_list = std::vector<std::string>;
-
-    explicit ReaderOBJImp(Material* material)
-        : _material {material}
-    {}
-
-    void Load(const std::string& line)
+    enum Type
     {
-        if (Ignore(line)) {
-            return;
-        }
-
-        boost::char_separator<char> sep(" /\t");
-        boost::tokenizer<boost::char_separator<char>> tokens(line, sep);
-        token_results.assign(tokens.begin(), tokens.end());
-        if (token_results.size() < 2) {
-            return;
-        }
+        Group,
+        Library,
+        UseMaterial
+    };
 
-        if (MatchVertex(token_results)) {
-            LoadVertex(token_results);
-        }
-        else if (MatchVertexWithColor(token_results)) {
-            LoadVertexWithColor(token_results);
-        }
-        else if (MatchGroup(token_results)) {
-            LoadGroup(token_results);
-        }
-        else if (MatchLibrary(token_results)) {
-            LoadLibrary(token_results);
-        }
-        else if (MatchUseMaterial(token_results)) {
-            LoadUseMaterial(token_results);
-        }
-        else if (MatchFace(token_results)) {
-            LoadFace(token_results);
-        }
-        else if (MatchQuad(token_results)) {
-            LoadQuad(token_results);
-        }
-    }
+    Type type;
+    std::size_t facet;  // number of faces of the block before the statement
+    std::string name;
+};
 
-    void SetupMaterial()
+/**
+ * Parses a part of the file that ends at a line break. Negative vertex indices refer to the
+ * vertices before the face and are resolved when the number of vertices of the previous
+ * blocks is known.
+ */
+class BlockOBJ
+{
+public:
+    bool Load(std::string_view text)
     {
-        // Add the last added material name
-        if (!materialName.empty()) {
-            _materialNames.emplace_back(materialName, countMaterialFacets);
-        }
-
-        // now get back the colors from the vertex property
-        if (rgb_value == MeshIO::PER_VERTEX) {
-            if (_material) {
-                _material->binding = MeshIO::PER_VERTEX;
-                _material->diffuseColor.reserve(meshPoints.size());
-
-                for (const auto& it : meshPoints) {
-                    unsigned long prop = it._ulProp;
-                    Base::Color c;
-                    c.setPackedValue(static_cast<uint32_t>(prop));
-                    _material->diffuseColor.push_back(c);
-                }
-            }
-        }
-        else if (!materialName.empty()) {
-            // At this point the materials from the .mtl file are not known and will be read-in by
-            // the calling instance but the color list is pre-filled with a default value
-            if (_material) {
-                _material->binding = MeshIO::PER_FACE;
-                const float rgb = 0.8F;
-                _material->diffuseColor.resize(meshFacets.size(), Base::Color(rgb, rgb, rgb));
+        while (!text.empty()) {
+            std::string_view line = AsciiParser::NextLine(text);
+            if (!Ignore(line) && !LoadLine(line)) {
+                return false;
             }
         }
+        return true;
     }
 
 private:
-    bool Ignore(const std::string& line) const
+    bool Ignore(std::string_view line) const
     {
         // clang-format off
-        return boost::starts_with(line, "vn ") ||
-               boost::starts_with(line, "vt ") ||
-               boost::starts_with(line, "s ") ||
-               boost::starts_with(line, "o ") ||
-               boost::starts_with(line, "#");
+        return line.starts_with("vn ") ||
+               line.starts_with("vt ") ||
+               line.starts_with("s ") ||
+               line.starts_with("o ") ||
+               line.starts_with("#");
         // clang-format on
     }
 
-    bool MatchVertex(const string_list& tokens) const
+    bool LoadLine(std::string_view line)
     {
-        return tokens[0] == "v" && tokens.size() == 4;
-    }
+        // a quad with texture and normal indices has the most tokens
+        constexpr std::size_t maxTokens = 14;
+        std::array<std::string_view, maxTokens> tokens;
+        std::size_t num = 0;
+        while (num < maxTokens) {
+            std::string_view token = AsciiParser::NextToken(line, " /\t");
+            if (token.empty()) {
+                break;
+            }
+            tokens[num++] = token;
+        }
 
-    void LoadVertex(const string_list& tokens)
-    {
-        float x = std::stof(tokens[1]);
-        float y = std::stof(tokens[2]);
-        float z = std::stof(tokens[3]);
-        meshPoints.push_back(MeshPoint(Base::Vector3f(x, y, z)));
+        if (num < 2) {
+            return true;
+        }
+
+        // NOLINTBEGIN
+        if (tokens[0] == "v") {
+            if (num == 4) {
+                return LoadVertex(tokens);
+            }
+            if (num == 7) {
+                return LoadVertexWithColor(tokens);
+            }
+        }
+        else if (tokens[0] == "f") {
+            if (num == 4 || num == 7 || num == 10) {
+                return LoadFace(tokens, (num - 1) / 3);
+            }
+            if (num == 5 || num == 9 || num == 13) {
+                return LoadQuad(tokens, (num - 1) / 4);
+            }
+        }
+        else if (num == 2) {
+            if (tokens[0] == "g") {
+                AddStatement(StatementOBJ::Group, tokens[1]);
+            }
+            else if (tokens[0] == "mtllib") {
+                AddStatement(StatementOBJ::Library, tokens[1]);
+            }
+            else if (tokens[0] == "usemtl") {
+                AddStatement(StatementOBJ::UseMaterial, tokens[1]);
+            }
+        }
+        // NOLINTEND
+
+        return true;
     }
 
-    bool MatchVertexWithColor(const string_list& tokens) const
+    template<class Tokens>
+    bool LoadVertex(const Tokens& tokens)
     {
-        return tokens[0] == "v" && tokens.size() == 7;  // NOLINT
+        Base::Vector3f pnt;
+        if (!AsciiParser::ToNumber(tokens[1], pnt.x) || !AsciiParser::ToNumber(tokens[2], pnt.y)
+            || !AsciiParser::ToNumber(tokens[3], pnt.z)) {
+            return false;
+        }
+        meshPoints.push_back(MeshPoint(pnt));
+        return true;
     }
 
-    void LoadVertexWithColor(const string_list& tokens)
+    template<class Tokens>
+    bool LoadVertexWithColor(const Tokens& tokens)
     {
-        LoadVertex(tokens);
+        if (!LoadVertex(tokens)) {
+            return false;
+        }
 
         // NOLINTBEGIN
-        float r = std::stof(tokens[4]);
-        float g = std::stof(tokens[5]);
-        float b = std::stof(tokens[6]);
+        float r {}, g {}, b {};
+        if (!AsciiParser::ToNumber(tokens[4], r) || !AsciiParser::ToNumber(tokens[5], g)
+            || !AsciiParser::ToNumber(tokens[6], b)) {
+            return false;
+        }
         if (r > 1.0F || g > 1.0F || b > 1.0F) {
             r /= 255.0F;
             g /= 255.0F;
@@ -163,131 +171,203 @@ private:
         }
         // NOLINTEND
 
-        SetVertexColor(Base::Color(r, g, b));
+        unsigned long prop = static_cast<uint32_t>(Base::Color(r, g, b).getPackedValue());
+        meshPoints.back().SetProperty(prop);
+        hasColors = true;
+        return true;
     }
 
-    void SetVertexColor(const Base::Color& c)
+    template<class Tokens>
+    bool LoadFace(const Tokens& tokens, std::size_t stride)
     {
-        unsigned long prop = static_cast<uint32_t>(c.getPackedValue());
-        meshPoints.back().SetProperty(prop);
-        rgb_value = MeshIO::PER_VERTEX;
+        // 3-vertex face
+        std::array<long, 3> index {};
+        for (std::size_t i = 0; i < index.size(); i++) {
+            if (!AsciiParser::ToNumber(tokens[1 + i * stride], index[i])) {
+                return false;
+            }
+        }
+
+        AddFace(index[0], index[1], index[2]);
+        return true;
     }
 
-    bool MatchGroup(const string_list& tokens) const
+    template<class Tokens>
+    bool LoadQuad(const Tokens& tokens, std::size_t stride)
     {
-        return tokens[0] == "g" && tokens.size() == 2;
+        // 4-vertex face
+        std::array<long, 4> index {};
+        for (std::size_t i = 0; i < index.size(); i++) {
+            if (!AsciiParser::ToNumber(tokens[1 + i * stride], index[i])) {
+                return false;
+            }
+        }
+
+        AddFace(index[0], index[1], index[2]);
+        AddFace(index[2], index[3], index[0]);
+        return true;
     }
 
-    void LoadGroup(const string_list& tokens)
+    /// Adds a face of one-based or relative indices
+    void AddFace(long i, long j, long k)
     {
-        new_segment = true;
-        groupName = Base::Tools::escapedUnicodeToUtf8(tokens[1]);
+        MeshFacet item;
+        int corner = 0;
+        for (long index : {i, j, k}) {
+            if (index > 0) {
+                item._aulPoints[corner] = static_cast<PointIndex>(index - 1);
+            }
+            else {
+                // relative to the last vertex, which may be in a previous block
+                relative.push_back(
+                    {meshFacets.size(), corner, index + static_cast<long>(meshPoints.size())});
+            }
+            corner++;
+        }
+        meshFacets.push_back(item);
     }
 
-    bool MatchLibrary(const string_list& tokens) const
+    void AddStatement(StatementOBJ::Type type, std::string_view name)
     {
-        return tokens[0] == "mtllib" && tokens.size() == 2;
+        statements.push_back({type, meshFacets.size(), std::string(name)});
     }
 
-    void LoadLibrary(const string_list& tokens)
+public:
+    struct RelativeIndex
     {
-        if (_material) {
-            _material->library = Base::Tools::escapedUnicodeToUtf8(tokens[1]);
-        }
-    }
+        std::size_t facet;
+        int corner;
+        long index;
+    };
 
-    bool MatchUseMaterial(const string_list& tokens) const
+    // NOLINTBEGIN
+    MeshPointArray meshPoints;
+    MeshFacetArray meshFacets;
+    std::vector<RelativeIndex> relative;
+    std::vector<StatementOBJ> statements;
+    bool hasColors = false;
+    // NOLINTEND
+};
+
+/**
+ * Joins the blocks and resolves the groups and materials in the order of the file.
+ */
+class ReaderOBJImp
+{
+public:
+    explicit ReaderOBJImp(Material* material)
+        : _material {material}
+    {}
+
+    void Load(std::vector<BlockOBJ>& blocks)
     {
-        return tokens[0] == "usemtl" && tokens.size() == 2;
+        std::vector<std::size_t> pointOffsets(blocks.size() + 1, 0);
+        std::vector<std::size_t> facetOffsets(blocks.size() + 1, 0);
+        for (std::size_t i = 0; i < blocks.size(); i++) {
+            pointOffsets[i + 1] = pointOffsets[i] + blocks[i].meshPoints.size();
+            facetOffsets[i + 1] = facetOffsets[i] + blocks[i].meshFacets.size();
+            if (blocks[i].hasColors) {
+                rgb_value = MeshIO::PER_VERTEX;
+            }
+        }
+
+        meshPoints.resize(pointOffsets.back());
+        meshFacets.resize(facetOffsets.back());
+        parallel_for(blocks.size(), 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                BlockOBJ& block = blocks[i];
+                const auto offset = static_cast<long>(pointOffsets[i]);
+                MeshFacet* facets = meshFacets.data() + facetOffsets[i];
+                std::copy(block.meshPoints.begin(),
+                          block.meshPoints.end(),
+                          meshPoints.begin() + static_cast<std::ptrdiff_t>(pointOffsets[i]));
+                std::copy(block.meshFacets.begin(), block.meshFacets.end(), facets);
+                for (const auto& it : block.relative) {
+                    facets[it.facet]._aulPoints[it.corner] =
+                        static_cast<PointIndex>(it.index + offset);
+                }
+                block.meshPoints.clear();
+                block.meshFacets.clear();
+            }
+        });
+
+        for (std::size_t i = 0; i < blocks.size(); i++) {
+            std::size_t first = facetOffsets[i];
+            for (const auto& it : blocks[i].statements) {
+                AddFaces(first, facetOffsets[i] + it.facet);
+                first = facetOffsets[i] + it.facet;
+                LoadStatement(it);
+            }
+            AddFaces(first, facetOffsets[i + 1]);
+        }
     }
 
-    void LoadUseMaterial(const string_list& tokens)
+    void SetupMaterial()
     {
+        // Add the last added material name
         if (!materialName.empty()) {
             _materialNames.emplace_back(materialName, countMaterialFacets);
         }
-        materialName = Base::Tools::escapedUnicodeToUtf8(tokens[1]);
-        countMaterialFacets = 0;
-    }
 
-    bool MatchFace(const string_list& tokens) const
-    {
-        // NOLINTBEGIN
-        const auto num = tokens.size();
-        return tokens[0] == "f" && (num == 4 || num == 7 || num == 10);
-        // NOLINTEND
-    }
-
-    void LoadFace(const string_list& tokens)
-    {
-        StartNewSegment();
+        // now get back the colors from the vertex property
+        if (rgb_value == MeshIO::PER_VERTEX) {
+            if (_material) {
+                _material->binding = MeshIO::PER_VERTEX;
+                _material->diffuseColor.reserve(meshPoints.size());
 
-        // NOLINTBEGIN
-        int index1 = 1;
-        int index2 = 2;
-        int index3 = 3;
-        if (tokens.size() == 7) {
-            index2 = 3;
-            index3 = 5;
+                for (const auto& it : meshPoints) {
+                    unsigned long prop = it._ulProp;
+                    Base::Color c;
+                    c.setPackedValue(static_cast<uint32_t>(prop));
+                    _material->diffuseColor.push_back(c);
+                }
+            }
         }
-        else if (tokens.size() == 10) {
-            index2 = 4;
-            index3 = 7;
+        else if (!materialName.empty()) {
+            // At this point the materials from the .mtl file are not known and will be read-in by
+            // the calling instance but the color list is pre-filled with a default value
+            if (_material) {
+                _material->binding = MeshIO::PER_FACE;
+                const float rgb = 0.8F;
+                _material->diffuseColor.resize(meshFacets.size(), Base::Color(rgb, rgb, rgb));
+            }
         }
-        // NOLINTEND
-
-        // 3-vertex face
-        int i1 = std::stoi(tokens[index1]);
-        i1 = i1 > 0 ? i1 - 1 : i1 + static_cast<int>(meshPoints.size());
-        int i2 = std::stoi(tokens[index2]);
-        i2 = i2 > 0 ? i2 - 1 : i2 + static_cast<int>(meshPoints.size());
-        int i3 = std::stoi(tokens[index3]);
-        i3 = i3 > 0 ? i3 - 1 : i3 + static_cast<int>(meshPoints.size());
-
-        AddFace(i1, i2, i3);
     }
 
-    bool MatchQuad(const string_list& tokens) const
+private:
+    void LoadStatement(const StatementOBJ& statement)
     {
-        // NOLINTBEGIN
-        const auto num = tokens.size();
-        return tokens[0] == "f" && (num == 5 || num == 9 || num == 13);
-        // NOLINTEND
+        switch (statement.type) {
+            case StatementOBJ::Group:
+                new_segment = true;
+                groupName = Base::Tools::escapedUnicodeToUtf8(statement.name);
+                break;
+            case StatementOBJ::Library:
+                if (_material) {
+                    _material->library = Base::Tools::escapedUnicodeToUtf8(statement.name);
+                }
+                break;
+            case StatementOBJ::UseMaterial:
+                if (!materialName.empty()) {
+                    _materialNames.emplace_back(materialName, countMaterialFacets);
+                }
+                materialName = Base::Tools::escapedUnicodeToUtf8(statement.name);
+                countMaterialFacets = 0;
+                break;
+        }
     }
 
-    void LoadQuad(const string_list& tokens)
+    void AddFaces(std::size_t first, std::size_t last)
     {
-        StartNewSegment();
-
-        // NOLINTBEGIN
-        int index1 = 1;
-        int index2 = 2;
-        int index3 = 3;
-        int index4 = 4;
-        if (tokens.size() == 9) {
-            index2 = 3;
-            index3 = 5;
-            index4 = 7;
-        }
-        else if (tokens.size() == 13) {
-            index2 = 4;
-            index3 = 7;
-            index4 = 10;
+        if (first == last) {
+            return;
         }
-        // NOLINTEND
 
-        // 4-vertex face
-        int i1 = std::stoi(tokens[index1]);
-        i1 = i1 > 0 ? i1 - 1 : i1 + static_cast<int>(meshPoints.size());
-        int i2 = std::stoi(tokens[index2]);
-        i2 = i2 > 0 ? i2 - 1 : i2 + static_cast<int>(meshPoints.size());
-        int i3 = std::stoi(tokens[index3]);
-        i3 = i3 > 0 ? i3 - 1 : i3 + static_cast<int>(meshPoints.size());
-        int i4 = std::stoi(tokens[index4]);
-        i4 = i4 > 0 ? i4 - 1 : i4 + static_cast<int>(meshPoints.size());
-
-        AddFace(i1, i2, i3);
-        AddFace(i3, i4, i1);
+        StartNewSegment();
+        for (std::size_t i = first; i < last; i++) {
+            meshFacets[i].SetProperty(segment);
+        }
+        countMaterialFacets += last - first;
     }
 
     void StartNewSegment()
@@ -303,15 +383,6 @@ private:
         }
     }
 
-    void AddFace(int i, int j, int k)
-    {
-        MeshFacet item;
-        item.SetVertices(i, j, k);
-        item.SetProperty(segment);
-        meshFacets.push_back(item);
-        countMaterialFacets++;
-    }
-
 public:
     // NOLINTBEGIN
     MeshPointArray meshPoints;
@@ -325,7 +396,6 @@ public:
     }
 
 private:
-    string_list token_results;
     MeshIO::Binding rgb_value = MeshIO::OVERALL;
     unsigned long countMaterialFacets = 0;
     unsigned long segment = 0;
@@ -354,21 +424,31 @@ bool ReaderOBJ::Load(const std::string& file)
 
 bool ReaderOBJ::Load(std::istream& str)
 {
-    if (!str || str.bad()) {
+    std::string buffer;
+    if (!AsciiParser::ReadAll(str, buffer)) {
         return false;
     }
 
-    std::streambuf* buf = str.rdbuf();
-    if (!buf) {
+    // Parse blocks of lines on all cores, small files are a single block
+    const std::size_t blockSize = 1 << 20;
+    std::vector<std::string_view> text = AsciiParser::SplitLines(buffer, blockSize);
+    std::vector<BlockOBJ> blocks(text.size());
+    std::vector<char> success(text.size(), 0);
+    parallel_for(blocks.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            success[i] = blocks[i].Load(text[i]) ? 1 : 0;
+        }
+    });
+    if (std::find(success.begin(), success.end(), 0) != success.end()) {
         return false;
     }
 
+    buffer.clear();
+    buffer.shrink_to_fit();
+
     ReaderOBJImp reader(_material);
-    std::string line;
-    while (std::getline(str, line)) {
-        boost::trim(line);
-        reader.Load(line);
-    }
+    reader.Load(blocks);
+    blocks.clear();
     reader.SetupMaterial();
     _materialNames = reader.GetMaterialNames();
 
@@ -22,14 +22,18 @@
  **************************************************************************/
 
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
 #include <istream>
+#include <numeric>
 
 
+#include "Core/Functional.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
 #include <Base/Stream.h>
 #include <Base/Tools.h>
 
+#include "AsciiParser.h"
 #include "ReaderPLY.h"
 
 
@@ -403,82 +407,95 @@ void ReaderPLY::CleanupMesh()
     _kernel.Adopt(meshPoints, meshFacets);
 }
 
-bool ReaderPLY::ReadVertexes(std::istream& input)
+bool ReaderPLY::ReadVertex(std::string_view line, std::size_t index)
 {
-    std::string line;
-    for (std::size_t i = 0; i < v_count && std::getline(input, line); i++) {
-        std::istringstream str(line);
-        str.unsetf(std::ios_base::skipws);
-        str >> std::ws;
-
-        // go through the vertex properties
-        PropertyArray prop_values {};
-        std::size_t count_props = vertex_props.size();
-        for (const auto& it : vertex_props) {
-            switch (it.second) {
-                case int8:
-                case int16:
-                case int32: {
-                    int vt {};
-                    str >> vt >> std::ws;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                case uint8:
-                case uint16:
-                case uint32: {
-                    unsigned int vt {};
-                    str >> vt >> std::ws;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                case float32: {
-                    float vt {};
-                    str >> vt >> std::ws;
-                    prop_values[it.first] = vt;
-                } break;
-                case float64: {
-                    double vt {};
-                    str >> vt >> std::ws;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                default:
-                    return false;
-            }
-
-            // does line contain all properties
-            if (--count_props > 0 && str.eof()) {
+    // go through the vertex properties
+    PropertyArray prop_values {};
+    for (const auto& it : vertex_props) {
+        std::string_view token = AsciiParser::NextToken(line, " \t");
+        bool ok = false;
+        switch (it.second) {
+            case int8:
+            case int16:
+            case int32: {
+                long vt {};
+                ok = AsciiParser::ToNumber(token, vt);
+                prop_values[it.first] = static_cast<float>(vt);
+            } break;
+            case uint8:
+            case uint16:
+            case uint32: {
+                unsigned long vt {};
+                ok = AsciiParser::ToNumber(token, vt);
+                prop_values[it.first] = static_cast<float>(vt);
+            } break;
+            case float32: {
+                float vt {};
+                ok = AsciiParser::ToNumber(token, vt);
+                prop_values[it.first] = vt;
+            } break;
+            case float64: {
+                double vt {};
+                ok = AsciiParser::ToNumber(token, vt);
+                prop_values[it.first] = static_cast<float>(vt);
+            } break;
+            default:
                 return false;
-            }
         }
 
-        addVertexProperty(prop_values);
+        // does line contain all properties
+        if (!ok) {
+            return false;
+        }
+    }
+
+    meshPoints[index].Set(prop_values[coord_x], prop_values[coord_y], prop_values[coord_z]);
+    if (_material && _material->binding == MeshIO::PER_VERTEX) {
+        // NOLINTBEGIN
+        float r = (prop_values[color_r]) / 255.0F;
+        float g = (prop_values[color_g]) / 255.0F;
+        float b = (prop_values[color_b]) / 255.0F;
+        // NOLINTEND
+        _material->diffuseColor[index] = Base::Color(r, g, b);
     }
 
     return true;
 }
 
-bool ReaderPLY::ReadFaces(std::istream& input)
+bool ReaderPLY::ReadFace(std::string_view line, std::size_t index)
 {
     constexpr const std::size_t count_props = 4;
-    std::string line;
-    for (std::size_t i = 0; i < f_count && std::getline(input, line); i++) {
-        std::istringstream str(line);
-        str.unsetf(std::ios_base::skipws);
-        str >> std::ws;
+    std::array<long, count_props> v_indices {};
+    for (long& vt : v_indices) {
+        if (!AsciiParser::ToNumber(AsciiParser::NextToken(line, " \t"), vt)) {
+            return false;
+        }
+    }
 
-        std::array<int, count_props> v_indices {};
-        std::size_t index = count_props;
-        for (int& vt : v_indices) {
-            str >> vt >> std::ws;
-            if (--index > 0 && str.eof()) {
+    if (v_indices[0] != 3) {
+        return false;
+    }
+
+    meshFacets[index] = MeshFacet(static_cast<PointIndex>(v_indices[1]),
+                                  static_cast<PointIndex>(v_indices[2]),
+                                  static_cast<PointIndex>(v_indices[3]));
+    return true;
+}
+
+bool ReaderPLY::ReadLines(std::string_view text, std::size_t line)
+{
+    const std::size_t numPoints = meshPoints.size();
+    const std::size_t numLines = numPoints + meshFacets.size();
+    for (; line < numLines && !text.empty(); line++) {
+        std::string_view str = AsciiParser::NextLine(text);
+        if (line < numPoints) {
+            if (!ReadVertex(str, line)) {
                 return false;
             }
         }
-
-        if (v_indices[0] != 3) {
+        else if (!ReadFace(str, line - numPoints)) {
             return false;
         }
-
-        meshFacets.push_back(MeshFacet(v_indices[1], v_indices[2], v_indices[3]));
     }
 
     return true;
@@ -486,11 +503,39 @@ bool ReaderPLY::ReadFaces(std::istream& input)
 
 bool ReaderPLY::LoadAscii(std::istream& input)
 {
-    if (!ReadVertexes(input)) {
+    std::string buffer;
+    if (!AsciiParser::ReadAll(input, buffer)) {
         return false;
     }
 
-    if (!ReadFaces(input)) {
+    // Every vertex and face is on its own line, so the first line of a block gives the
+    // position of its elements and all blocks can be parsed in parallel
+    const std::size_t blockSize = 1 << 20;
+    std::vector<std::string_view> blocks = AsciiParser::SplitLines(buffer, blockSize);
+    std::vector<std::size_t> firstLine(blocks.size() + 1, 0);
+    parallel_for(blocks.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            firstLine[i + 1] = AsciiParser::CountLines(blocks[i]);
+        }
+    });
+    std::partial_sum(firstLine.begin(), firstLine.end(), firstLine.begin());
+
+    // a file with less lines is read as far as it goes
+    std::size_t numPoints = std::min(v_count, firstLine.back());
+    std::size_t numFacets = std::min(f_count, firstLine.back() - numPoints);
+    meshPoints.resize(numPoints);
+    meshFacets.resize(numFacets);
+    if (_material && _material->binding == MeshIO::PER_VERTEX) {
+        _material->diffuseColor.resize(numPoints);
+    }
+
+    std::vector<char> success(blocks.size(), 0);
+    parallel_for(blocks.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            success[i] = ReadLines(blocks[i], firstLine[i]) ? 1 : 0;
+        }
+    });
+    if (std::find(success.begin(), success.end(), 0) != success.end()) {
         return false;
     }
 
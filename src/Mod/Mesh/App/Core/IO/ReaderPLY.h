@@ -28,6 +28,7 @@
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/MeshGlobal.h>
 #include <iosfwd>
+#include <string_view>
 
 namespace Base
 {
@@ -64,8 +65,9 @@ private:
     bool ReadProperty(std::istream& str, const std::string& element);
     bool ReadVertexProperty(std::istream& str);
     bool ReadFaceProperty(std::istream& str);
-    bool ReadVertexes(std::istream& input);
-    bool ReadFaces(std::istream& input);
+    bool ReadVertex(std::string_view line, std::size_t index);
+    bool ReadFace(std::string_view line, std::size_t index);
+    bool ReadLines(std::string_view text, std::size_t line);
     bool ReadVertexes(Base::InputStream& is);
     bool ReadFaces(Base::InputStream& is);
     bool LoadAscii(std::istream& input);
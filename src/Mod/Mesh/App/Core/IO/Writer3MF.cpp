@@ -20,8 +20,11 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <array>
+#include <charconv>
 #include <ostream>
 #include <sstream>
+#include <string_view>
 
 
 #include "Core/Evaluation.h"
@@ -33,6 +36,70 @@
 
 using namespace MeshCore;
 
+namespace
+{
+
+/// Formats the vertices and triangles into a buffer that is written out in large blocks
+class ChunkWriter
+{
+public:
+    explicit ChunkWriter(std::ostream& str)
+        : str(str)
+    {
+        buffer.reserve(chunkSize + chunkSize / 4);
+    }
+    ChunkWriter(const ChunkWriter&) = delete;
+    ChunkWriter(ChunkWriter&&) = delete;
+    ChunkWriter& operator=(const ChunkWriter&) = delete;
+    ChunkWriter& operator=(ChunkWriter&&) = delete;
+    ~ChunkWriter()
+    {
+        flush();
+    }
+
+    void append(std::string_view text)
+    {
+        buffer.append(text);
+    }
+    void append(float value)
+    {
+        // the same output as the default of std::ostream
+        constexpr const int precision = 6;
+        std::array<char, 32> number {};  // NOLINT
+        auto res = std::to_chars(number.data(),
+                                 number.data() + number.size(),
+                                 value,
+                                 std::chars_format::general,
+                                 precision);
+        buffer.append(number.data(), res.ptr);
+    }
+    void append(PointIndex value)
+    {
+        std::array<char, 16> number {};  // NOLINT
+        auto res = std::to_chars(number.data(), number.data() + number.size(), value);
+        buffer.append(number.data(), res.ptr);
+    }
+    /// Writes the buffer out once it's full, to be called after each element
+    void next()
+    {
+        if (buffer.size() >= chunkSize) {
+            flush();
+        }
+    }
+    void flush()
+    {
+        str.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+
+private:
+    static constexpr std::size_t chunkSize = 1 << 20;
+    std::ostream& str;
+    std::string buffer;
+};
+
+}  // namespace
+
 Writer3MF::Writer3MF(std::ostream& str)
     : zip(str)
 {
@@ -74,7 +141,15 @@ void Writer3MF::Finish(std::ostream& str)
 
 bool Writer3MF::AddMesh(const MeshKernel& mesh, const Base::Matrix4D& mat)
 {
+    // a mesh added once more is only placed by a further build item
+    auto it = objectIds.find(&mesh);
+    if (it != objectIds.end()) {
+        SaveBuildItem(it->second, mat);
+        return true;
+    }
+
     int id = ++objectIndex;
+    objectIds[&mesh] = id;
     SaveBuildItem(id, mat);
     return SaveObject(zip, id, mesh);
 }
@@ -122,22 +197,37 @@ bool Writer3MF::SaveObject(std::ostream& str, int id, const MeshKernel& mesh) co
     str << Base::blanks(2) << "<object id=\"" << id << "\" type=\"" << GetType(mesh) << "\">\n";
     str << Base::blanks(3) << "<mesh>\n";
 
-    // vertices
-    str << Base::blanks(4) << "<vertices>\n";
-    std::size_t index = 0;
-    for (auto it = rPoints.begin(); it != rPoints.end(); ++it, ++index) {
-        str << Base::blanks(5) << "<vertex x=\"" << it->x << "\" y=\"" << it->y << "\" z=\""
-            << it->z << "\" />\n";
-    }
-    str << Base::blanks(4) << "</vertices>\n";
+    {
+        ChunkWriter writer(str);
+
+        // vertices
+        writer.append("    <vertices>\n");
+        for (const auto& it : rPoints) {
+            writer.append("     <vertex x=\"");
+            writer.append(it.x);
+            writer.append("\" y=\"");
+            writer.append(it.y);
+            writer.append("\" z=\"");
+            writer.append(it.z);
+            writer.append("\" />\n");
+            writer.next();
+        }
+        writer.append("    </vertices>\n");
 
-    // facet indices
-    str << Base::blanks(4) << "<triangles>\n";
-    for (const auto& it : rFacets) {
-        str << Base::blanks(5) << "<triangle v1=\"" << it._aulPoints[0] << "\" v2=\""
-            << it._aulPoints[1] << "\" v3=\"" << it._aulPoints[2] << "\" />\n";
+        // facet indices
+        writer.append("    <triangles>\n");
+        for (const auto& it : rFacets) {
+            writer.append("     <triangle v1=\"");
+            writer.append(it._aulPoints[0]);
+            writer.append("\" v2=\"");
+            writer.append(it._aulPoints[1]);
+            writer.append("\" v3=\"");
+            writer.append(it._aulPoints[2]);
+            writer.append("\" />\n");
+            writer.next();
+        }
+        writer.append("    </triangles>\n");
     }
-    str << Base::blanks(4) << "</triangles>\n";
 
     str << Base::blanks(3) << "</mesh>\n";
     str << Base::blanks(2) << "</object>\n";
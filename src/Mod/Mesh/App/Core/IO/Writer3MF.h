@@ -26,6 +26,7 @@
 
 #include <Mod/Mesh/MeshGlobal.h>
 #include <iosfwd>
+#include <map>
 #include <zipios++/zipoutputstream.h>
 
 namespace Base
@@ -74,6 +75,8 @@ public:
      * \brief Add a mesh object resource to the 3MF file.
      * \param mesh The mesh object to be written
      * \param mat The placement of the mesh object
+     * If the same mesh object is added again it's only written once and placed by a further
+     * build item, so it must not be changed in between.
      * \return true if the added mesh could be written successfully, false otherwise.
      */
     bool AddMesh(const MeshKernel& mesh, const Base::Matrix4D& mat);
@@ -103,6 +106,7 @@ private:
     zipios::ZipOutputStream zip;
     int objectIndex = 0;
     std::vector<std::string> items;
+    std::map<const MeshKernel*, int> objectIds;
     std::vector<Resource3MF> resources;
     bool forceModel = true;
 };
@@ -0,0 +1,313 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+#include "Functional.h"
+#include "LevelOfDetail.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+using Base::Vector3f;
+
+namespace
+{
+constexpr unsigned int maxLevels = 20;
+// bits per axis of a grid cell key
+constexpr int cellBits = 21;
+
+int threadCount()
+{
+    return MeshDefinitions::GetMaxThreadCount();
+}
+}  // namespace
+
+MeshLevelOfDetail::MeshLevelOfDetail(const MeshKernel& mesh, unsigned int clusterSize)
+    : _box(mesh.GetBoundBox())
+    , _clusterSize(std::max(clusterSize, 1U))
+{
+    const MeshPointArray& points = mesh.GetPoints();
+    std::vector<Vector3f> original(points.begin(), points.end());
+    _points.push_back(std::move(original));
+
+    const MeshFacetArray& facets = mesh.GetFacets();
+    _facets.reserve(3 * facets.size());
+    for (const auto& facet : facets) {
+        for (PointIndex index : facet._aulPoints) {
+            _facets.push_back(static_cast<uint32_t>(index));
+        }
+    }
+}
+
+void MeshLevelOfDetail::MakeClusters(std::vector<uint32_t>& order)
+{
+    const std::vector<Vector3f>& points = _points[0];
+    const std::size_t numFacets = _facets.size() / 3;
+    std::vector<Vector3f> centers(numFacets);
+    parallel_for(numFacets, 4096, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            centers[i] = (points[_facets[3 * i]] + points[_facets[3 * i + 1]]
+                          + points[_facets[3 * i + 2]])
+                / 3.0F;
+        }
+    });
+
+    // split at the median of the longest side until the clusters are small enough
+    order.resize(numFacets);
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<std::pair<std::size_t, std::size_t>> stack;
+    if (numFacets > 0) {
+        stack.emplace_back(0, numFacets);
+    }
+    while (!stack.empty()) {
+        auto [first, count] = stack.back();
+        stack.pop_back();
+        if (count <= _clusterSize) {
+            _clusters.emplace_back(first, count);
+            continue;
+        }
+
+        Base::BoundBox3f box;
+        for (std::size_t i = first; i < first + count; i++) {
+            box.Add(centers[order[i]]);
+        }
+        int axis = 0;
+        if (box.LengthY() > box.LengthX()) {
+            axis = 1;
+        }
+        if (box.LengthZ() > std::max(box.LengthX(), box.LengthY())) {
+            axis = 2;
+        }
+
+        std::size_t half = count / 2;
+        std::nth_element(order.begin() + first,
+                         order.begin() + first + half,
+                         order.begin() + first + count,
+                         [&centers, axis](uint32_t a, uint32_t b) {
+                             return centers[a][axis] < centers[b][axis];
+                         });
+        stack.emplace_back(first + half, count - half);
+        stack.emplace_back(first, half);
+    }
+
+    _boxes.resize(_clusters.size());
+    parallel_for(_clusters.size(), 16, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            auto [first, count] = _clusters[i];
+            for (std::size_t j = first; j < first + count; j++) {
+                for (int k = 0; k < 3; k++) {
+                    _boxes[i].Add(points[_facets[3 * order[j] + k]]);
+                }
+            }
+        }
+    });
+}
+
+float MeshLevelOfDetail::InitialCellSize() const
+{
+    // twice the average edge length of a sample of facets
+    const std::vector<Vector3f>& points = _points[0];
+    const std::size_t numFacets = _facets.size() / 3;
+    const std::size_t step = std::max<std::size_t>(numFacets / 10000, 1);
+    double length = 0.0;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < numFacets; i += step) {
+        for (int k = 0; k < 3; k++) {
+            const Vector3f& p0 = points[_facets[3 * i + k]];
+            const Vector3f& p1 = points[_facets[3 * i + (k + 1) % 3]];
+            length += Base::Distance(p0, p1);
+            count++;
+        }
+    }
+
+    float cellSize = count > 0 ? float(2.0 * length / double(count)) : 1.0F;
+    // the cells must be addressable by the grid keys
+    float minSize = std::max({_box.LengthX(), _box.LengthY(), _box.LengthZ()})
+        / float((1 << cellBits) - 1);
+    return std::max({cellSize, minSize, std::numeric_limits<float>::min()});
+}
+
+void MeshLevelOfDetail::AddLevel(float cellSize, const std::vector<uint32_t>& order)
+{
+    // merge all points of a grid cell into their mean
+    const std::vector<Vector3f>& original = _points[0];
+    const std::size_t numPoints = original.size();
+    std::vector<std::pair<uint64_t, uint32_t>> keys(numPoints);
+    parallel_for(numPoints, 4096, [&](std::size_t begin, std::size_t end) {
+        const uint64_t mask = (uint64_t(1) << cellBits) - 1;
+        for (std::size_t i = begin; i < end; i++) {
+            const Vector3f& p = original[i];
+            auto x = uint64_t((p.x - _box.MinX) / cellSize) & mask;
+            auto y = uint64_t((p.y - _box.MinY) / cellSize) & mask;
+            auto z = uint64_t((p.z - _box.MinZ) / cellSize) & mask;
+            keys[i] = {(x << (2 * cellBits)) | (y << cellBits) | z, uint32_t(i)};
+        }
+    });
+    parallel_sort(keys.begin(), keys.end(), std::less<>(), threadCount());
+
+    std::vector<uint32_t> mapping(numPoints);
+    std::vector<Vector3f> points;
+    for (std::size_t i = 0; i < numPoints;) {
+        std::size_t j = i;
+        double x = 0.0, y = 0.0, z = 0.0;
+        for (; j < numPoints && keys[j].first == keys[i].first; j++) {
+            const Vector3f& p = original[keys[j].second];
+            x += p.x;
+            y += p.y;
+            z += p.z;
+            mapping[keys[j].second] = uint32_t(points.size());
+        }
+        double n = double(j - i);
+        points.emplace_back(float(x / n), float(y / n), float(z / n));
+        i = j;
+    }
+
+    // the remaining triangles of each cluster and the distance of the merged points
+    const std::vector<Range>& finer = _ranges.back();
+    std::vector<std::vector<std::array<uint32_t, 3>>> parts(_clusters.size());
+    std::vector<Range> ranges(_clusters.size());
+    parallel_for(_clusters.size(), 4, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; c++) {
+            auto [first, count] = _clusters[c];
+            float error = 0.0F;
+            auto& tria = parts[c];
+            for (std::size_t j = first; j < first + count; j++) {
+                std::array<uint32_t, 3> t {};
+                for (int k = 0; k < 3; k++) {
+                    uint32_t index = _facets[3 * order[j] + k];
+                    t[k] = mapping[index];
+                    error = std::max(error, Base::Distance(original[index], points[t[k]]));
+                }
+                if (t[0] == t[1] || t[1] == t[2] || t[2] == t[0]) {
+                    continue;
+                }
+                // start with the lowest index to find duplicates
+                std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+                tria.push_back(t);
+            }
+            std::sort(tria.begin(), tria.end());
+            tria.erase(std::unique(tria.begin(), tria.end()), tria.end());
+            ranges[c].count = tria.size();
+            ranges[c].error = std::max(error, finer[c].error);
+        }
+    });
+
+    std::vector<uint32_t> indices;
+    for (std::size_t c = 0; c < _clusters.size(); c++) {
+        ranges[c].first = indices.size() / 3;
+        for (const auto& t : parts[c]) {
+            indices.insert(indices.end(), t.begin(), t.end());
+        }
+    }
+
+    _points.push_back(std::move(points));
+    _indices.push_back(std::move(indices));
+    _ranges.push_back(std::move(ranges));
+    CalcNormals(CountLevels() - 1);
+}
+
+void MeshLevelOfDetail::CalcNormals(unsigned int level)
+{
+    const std::vector<Vector3f>& points = _points[level];
+    const std::vector<uint32_t>& indices = _indices[level];
+    std::vector<Vector3f> normals(points.size());
+    for (std::size_t i = 0; i < indices.size(); i += 3) {
+        const Vector3f& p0 = points[indices[i]];
+        const Vector3f& p1 = points[indices[i + 1]];
+        const Vector3f& p2 = points[indices[i + 2]];
+        Vector3f normal = (p1 - p0) % (p2 - p0);
+        normals[indices[i]] += normal;
+        normals[indices[i + 1]] += normal;
+        normals[indices[i + 2]] += normal;
+    }
+    for (auto& normal : normals) {
+        normal.Normalize();
+    }
+
+    if (_normals.size() <= level) {
+        _normals.resize(level + 1);
+    }
+    _normals[level] = std::move(normals);
+}
+
+void MeshLevelOfDetail::Build()
+{
+    std::vector<uint32_t> order;
+    MakeClusters(order);
+
+    // level 0 holds the original facets in the order of the clusters
+    std::vector<uint32_t> indices;
+    indices.reserve(_facets.size());
+    std::vector<Range> ranges(_clusters.size());
+    for (std::size_t c = 0; c < _clusters.size(); c++) {
+        auto [first, count] = _clusters[c];
+        ranges[c].first = first;
+        ranges[c].count = count;
+        for (std::size_t j = first; j < first + count; j++) {
+            for (int k = 0; k < 3; k++) {
+                indices.push_back(_facets[3 * order[j] + k]);
+            }
+        }
+    }
+    _indices.push_back(std::move(indices));
+    _ranges.push_back(std::move(ranges));
+    CalcNormals(0);
+
+    // coarser levels until the mesh cannot be reduced any further
+    float cellSize = InitialCellSize();
+    std::size_t count = _facets.size() / 3;
+    for (unsigned int level = 1; level < maxLevels && count > _clusters.size(); level++) {
+        AddLevel(cellSize, order);
+        std::size_t reduced = _indices.back().size() / 3;
+        if (reduced == count) {
+            _points.pop_back();
+            _normals.pop_back();
+            _indices.pop_back();
+            _ranges.pop_back();
+        }
+        count = reduced;
+        cellSize *= 2.0F;
+    }
+
+    _facets.clear();
+    _facets.shrink_to_fit();
+    _ready.store(true, std::memory_order_release);
+}
+
+unsigned int MeshLevelOfDetail::SelectLevel(std::size_t cluster, float maxError) const
+{
+    for (unsigned int level = CountLevels() - 1; level > 0; level--) {
+        if (_ranges[level][cluster].error <= maxError) {
+            return level;
+        }
+    }
+    return 0;
+}
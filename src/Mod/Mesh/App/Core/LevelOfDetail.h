@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+
+#ifndef MESH_LEVELOFDETAIL_H
+#define MESH_LEVELOFDETAIL_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <Base/BoundBox.h>
+
+#include "Definitions.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshLevelOfDetail class builds a multiresolution representation of a mesh to display
+ * very large meshes at interactive rates. The facets are grouped into spatially compact
+ * clusters and every cluster gets a series of levels, level 0 being the original facets.
+ * The coarser levels are made by clustering vertices on grids of doubling cell size that are
+ * shared by all clusters, so that neighbouring clusters of the same level fit together.
+ * Each level of a cluster stores the maximum distance of its original points to the points
+ * they were merged into, which allows selecting a level by its screen-space error.
+ */
+class MeshExport MeshLevelOfDetail
+{
+public:
+    /// A range of triangles in the index array of a level
+    struct Range
+    {
+        std::size_t first = 0;
+        std::size_t count = 0;
+        float error = 0.0F;
+    };
+
+    /**
+     * Copies the data of \a mesh that is needed. The hierarchy itself is made by Build(),
+     * the mesh can be modified or destroyed in the meantime.
+     */
+    explicit MeshLevelOfDetail(const MeshKernel& mesh, unsigned int clusterSize = 4096);
+
+    /// Builds the hierarchy, this can be done in a separate thread
+    void Build();
+    /// Returns true once Build() has finished
+    bool IsReady() const
+    {
+        return _ready.load(std::memory_order_acquire);
+    }
+
+    unsigned int CountLevels() const
+    {
+        return static_cast<unsigned int>(_points.size());
+    }
+    std::size_t CountClusters() const
+    {
+        return _boxes.size();
+    }
+    const Base::BoundBox3f& GetBoundBox(std::size_t cluster) const
+    {
+        return _boxes[cluster];
+    }
+    const std::vector<Base::Vector3f>& GetPoints(unsigned int level) const
+    {
+        return _points[level];
+    }
+    const std::vector<Base::Vector3f>& GetNormals(unsigned int level) const
+    {
+        return _normals[level];
+    }
+    /// Returns three point indices per triangle of the given level
+    const std::vector<uint32_t>& GetIndices(unsigned int level) const
+    {
+        return _indices[level];
+    }
+    const Range& GetRange(std::size_t cluster, unsigned int level) const
+    {
+        return _ranges[level][cluster];
+    }
+    /// Returns the coarsest level of \a cluster whose error does not exceed \a maxError
+    unsigned int SelectLevel(std::size_t cluster, float maxError) const;
+
+private:
+    void MakeClusters(std::vector<uint32_t>& order);
+    void AddLevel(float cellSize, const std::vector<uint32_t>& order);
+    float InitialCellSize() const;
+    void CalcNormals(unsigned int level);
+
+private:
+    /// three point indices per facet of the original mesh
+    std::vector<uint32_t> _facets;
+    Base::BoundBox3f _box;
+    unsigned int _clusterSize;
+    /// the facet ranges of the clusters in the sorted facet order
+    std::vector<std::pair<std::size_t, std::size_t>> _clusters;
+    std::vector<Base::BoundBox3f> _boxes;
+    std::vector<std::vector<Base::Vector3f>> _points;
+    std::vector<std::vector<Base::Vector3f>> _normals;
+    std::vector<std::vector<uint32_t>> _indices;
+    std::vector<std::vector<Range>> _ranges;
+    std::atomic<bool> _ready {false};
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_LEVELOFDETAIL_H
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <string_view>
@@ -34,6 +35,9 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/regex.hpp>
 
+#include <QFile>
+#include <QString>
+
 #include "IO/Reader3MF.h"
 #include "IO/ReaderOBJ.h"
 #include "IO/ReaderPLY.h"
@@ -56,6 +60,7 @@
 #include "Builder.h"
 #include "Definitions.h"
 #include "Degeneration.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshIO.h"
 #include "MeshKernel.h"
@@ -66,6 +71,14 @@ using namespace MeshCore;
 namespace MeshCore
 {
 
+/// Checks for keywords of an ASCII STL in the bytes from position 84 on
+static bool hasAsciiSTLKeywords(char* szBuf)
+{
+    boost::algorithm::to_upper(szBuf);
+    return strstr(szBuf, "SOLID") || strstr(szBuf, "FACET") || strstr(szBuf, "NORMAL")
+        || strstr(szBuf, "VERTEX") || strstr(szBuf, "ENDFACET") || strstr(szBuf, "ENDLOOP");
+}
+
 std::string& ltrim(std::string& str)
 {
     std::string::size_type pos = 0;
@@ -239,7 +252,7 @@ bool MeshInput::LoadAny(const char* FileName)
     // read file
     bool ok = false;
     if (fi.hasExtension({"stl", "ast"})) {
-        ok = LoadSTL(str);
+        ok = LoadMappedBinarySTL(FileName) || LoadSTL(str);
     }
     else if (fi.hasExtension("iv")) {
         ok = LoadInventor(str);
@@ -343,12 +356,9 @@ bool MeshInput::LoadSTL(std::istream& input)
         return (ulCt == 0);
     }
     szBuf[ulBytes] = 0;
-    boost::algorithm::to_upper(szBuf);
 
     try {
-        if (!strstr(szBuf, "SOLID") && !strstr(szBuf, "FACET") && !strstr(szBuf, "NORMAL")
-            && !strstr(szBuf, "VERTEX") && !strstr(szBuf, "ENDFACET")
-            && !strstr(szBuf, "ENDLOOP")) {
+        if (!hasAsciiSTLKeywords(szBuf)) {
             // probably binary STL
             buf->pubseekoff(0, std::ios::beg, std::ios::in);
             return LoadBinarySTL(input);
@@ -856,6 +866,145 @@ bool MeshInput::LoadBinarySTL(std::istream& input)
     return true;
 }
 
+bool MeshInput::LoadMappedBinarySTL(const char* FileName)
+{
+    QFile file(QString::fromUtf8(FileName));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    // Same check as LoadSTL(), empty or single facet files are left to it
+    auto size = static_cast<std::size_t>(file.size());
+    if (size < 84 + 100) {
+        return false;
+    }
+    const uchar* data = file.map(0, file.size());
+    if (!data) {
+        return false;
+    }
+
+    char szBuf[101];
+    std::memcpy(szBuf, data + 84, 100);
+    szBuf[100] = 0;
+    if (hasAsciiSTLKeywords(szBuf)) {
+        return false;
+    }
+
+    // the mapping is released when the file is closed
+    return LoadBinarySTL(reinterpret_cast<const char*>(data), size);
+}
+
+bool MeshInput::LoadBinarySTL(const char* data, std::size_t size)
+{
+    uint32_t ulCt = 0;
+    std::memcpy(&ulCt, data + 80, sizeof(ulCt));
+    if (std::size_t(ulCt) * 50 > size - 84) {
+        return false;  // not a valid STL file
+    }
+
+    struct Vertex
+    {
+        float x, y, z;
+        std::size_t i;
+
+        bool operator!=(const Vertex& rhs) const
+        {
+            return x != rhs.x || y != rhs.y || z != rhs.z;
+        }
+        bool operator<(const Vertex& rhs) const
+        {
+            if (x != rhs.x) {
+                return x < rhs.x;
+            }
+            if (y != rhs.y) {
+                return y < rhs.y;
+            }
+            return z < rhs.z;
+        }
+    };
+
+    // Parse the 50 byte facet records, a record is the normal, three points
+    // and two bytes attribute. Keep the point order of the stream reader.
+    const std::size_t numVerts = 3 * std::size_t(ulCt);
+    std::vector<Vertex> verts(numVerts);
+    MeshCore::parallel_for(ulCt, 100000, [&](std::size_t begin, std::size_t end) {
+        const int order[3] = {3, 1, 2};
+        for (std::size_t i = begin; i < end; i++) {
+            const char* record = data + 84 + 50 * i;
+            for (int j = 0; j < 3; j++) {
+                float xyz[3];
+                std::memcpy(xyz, record + 12 * order[j], sizeof(xyz));
+                verts[3 * i + j] = {xyz[0], xyz[1], xyz[2], 3 * i + j};
+            }
+        }
+    });
+
+    // Weld equal points. After sorting, every chunk counts the points that
+    // differ from their predecessor and then numbers them from its offset.
+    int threads = MeshDefinitions::GetMaxThreadCount();
+    MeshCore::parallel_sort(verts.begin(), verts.end(), std::less<>(), threads);
+
+    std::size_t numTasks =
+        std::clamp<std::size_t>(numVerts / 300000, 1, std::max<std::size_t>(threads, 1));
+    std::size_t chunk = (numVerts + numTasks - 1) / numTasks;
+    auto runTasks = [numTasks](const auto& func) {
+        std::vector<std::future<void>> futures;
+        for (std::size_t task = 1; task < numTasks; task++) {
+            futures.push_back(std::async(std::launch::async, std::cref(func), task));
+        }
+        func(std::size_t(0));
+        for (auto& it : futures) {
+            it.get();
+        }
+    };
+    auto isNewPoint = [&verts](std::size_t i) {
+        return i == 0 || verts[i] != verts[i - 1];
+    };
+
+    std::vector<std::size_t> firstPoint(numTasks + 1, 0);
+    runTasks([&](std::size_t task) {
+        std::size_t count = 0;
+        std::size_t last = std::min(numVerts, (task + 1) * chunk);
+        for (std::size_t i = task * chunk; i < last; i++) {
+            if (isNewPoint(i)) {
+                count++;
+            }
+        }
+        firstPoint[task + 1] = count;
+    });
+    for (std::size_t task = 0; task < numTasks; task++) {
+        firstPoint[task + 1] += firstPoint[task];
+    }
+
+    MeshPointArray rPoints(static_cast<PointIndex>(firstPoint.back()));
+    std::vector<PointIndex> indices(numVerts);
+    runTasks([&](std::size_t task) {
+        std::size_t next = firstPoint[task];
+        std::size_t last = std::min(numVerts, (task + 1) * chunk);
+        for (std::size_t i = task * chunk; i < last; i++) {
+            const Vertex& v = verts[i];
+            if (isNewPoint(i)) {
+                rPoints[next++].Set(v.x, v.y, v.z);
+            }
+            indices[v.i] = next - 1;
+        }
+    });
+    verts.clear();
+    verts.shrink_to_fit();
+
+    MeshFacetArray rFacets(static_cast<FacetIndex>(ulCt));
+    MeshCore::parallel_for(ulCt, 100000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            rFacets[i]._aulPoints[0] = indices[3 * i];
+            rFacets[i]._aulPoints[1] = indices[3 * i + 1];
+            rFacets[i]._aulPoints[2] = indices[3 * i + 2];
+        }
+    });
+
+    _rclMesh.Adopt(rPoints, rFacets, true);
+    return true;
+}
+
 /** Loads the mesh object from an XML file. */
 void MeshInput::LoadXML(Base::XMLReader& reader)
 {
@@ -1260,6 +1409,11 @@ void MeshOutput::SetSTLHeaderData(const std::string& header)
     }
 }
 
+const std::string& MeshOutput::GetSTLHeaderData()
+{
+    return stl_header;
+}
+
 std::string MeshOutput::asyWidth = "500";
 std::string MeshOutput::asyHeight = "500";
 
@@ -157,6 +157,12 @@ public:
     static std::vector<std::string> supportedMeshFormats();
     static MeshIO::Format getFormat(const char* FileName);
 
+private:
+    /** Loads a binary STL file from memory. */
+    bool LoadBinarySTL(const char* data, std::size_t size);
+    /** Loads a binary STL file through a memory mapping, returns false if it's not binary. */
+    bool LoadMappedBinarySTL(const char* FileName);
+
 private:
     MeshKernel& _rclMesh; /**< reference to mesh data structure */
     Material* _material;
@@ -196,6 +202,8 @@ public:
      * automatically filled up with spaces.
      */
     static void SetSTLHeaderData(const std::string&);
+    /// Returns the 80 characters written to the header of a binary STL.
+    static const std::string& GetSTLHeaderData();
     /**
      * Change the image size of the asymptote output.
      */
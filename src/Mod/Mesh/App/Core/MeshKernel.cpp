@@ -22,7 +22,9 @@
 
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <map>
 #include <queue>
@@ -36,6 +38,7 @@
 #include "Algorithm.h"
 #include "Builder.h"
 #include "Evaluation.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshIO.h"
 #include "MeshKernel.h"
@@ -44,6 +47,166 @@
 
 using namespace MeshCore;
 
+namespace
+{
+// Version of the stream format that stores the point and facet arrays as blocks
+constexpr uint32_t BlockVersion = 0x020000;
+// The blocks are delta encoded
+constexpr uint32_t CompressedBlock = 0x1;
+// value to mark an open edge
+constexpr uint32_t OpenEdge = 0xffffffff;
+
+void writeVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t readVarint(const std::vector<uint8_t>& in, std::size_t& pos)
+{
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= in.size()) {
+            throw Base::BadFormatError("Invalid data structure");
+        }
+        uint8_t byte = in[pos++];
+        value |= uint64_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw Base::BadFormatError("Invalid data structure");
+}
+
+uint64_t zigzag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/*
+ * The point coordinates are XOR'ed with the same coordinate of the previous point and
+ * split into byte planes. Neighbouring points share most of their high bytes so that
+ * these planes mainly consist of zeros which are run-length encoded.
+ */
+std::vector<uint8_t> encodePoints(const std::vector<uint32_t>& coords)
+{
+    const std::size_t count = coords.size();
+    std::vector<uint8_t> planes(4 * count);
+    for (std::size_t i = 0; i < count; i++) {
+        uint32_t value = i < 3 ? coords[i] : coords[i] ^ coords[i - 3];
+        for (std::size_t j = 0; j < 4; j++) {
+            planes[j * count + i] = static_cast<uint8_t>(value >> (8 * j));
+        }
+    }
+
+    std::vector<uint8_t> out;
+    out.reserve(planes.size() / 2);
+    for (std::size_t i = 0; i < planes.size();) {
+        if (planes[i] != 0) {
+            out.push_back(planes[i++]);
+            continue;
+        }
+        std::size_t run = i;
+        while (run < planes.size() && planes[run] == 0) {
+            run++;
+        }
+        out.push_back(0);
+        writeVarint(out, run - i);
+        i = run;
+    }
+    return out;
+}
+
+std::vector<uint32_t> decodePoints(const std::vector<uint8_t>& in, std::size_t count)
+{
+    std::vector<uint8_t> planes(4 * count);
+    std::size_t index = 0;
+    for (std::size_t pos = 0; pos < in.size();) {
+        uint8_t byte = in[pos++];
+        if (byte != 0) {
+            if (index >= planes.size()) {
+                throw Base::BadFormatError("Invalid data structure");
+            }
+            planes[index++] = byte;
+            continue;
+        }
+        uint64_t run = readVarint(in, pos);
+        if (run > planes.size() - index) {
+            throw Base::BadFormatError("Invalid data structure");
+        }
+        index += run;  // the planes are zero-initialized
+    }
+    if (index != planes.size()) {
+        throw Base::BadFormatError("Invalid data structure");
+    }
+
+    std::vector<uint32_t> coords(count);
+    for (std::size_t i = 0; i < count; i++) {
+        uint32_t value = 0;
+        for (std::size_t j = 0; j < 4; j++) {
+            value |= uint32_t(planes[j * count + i]) << (8 * j);
+        }
+        coords[i] = i < 3 ? value : value ^ coords[i - 3];
+    }
+    return coords;
+}
+
+/*
+ * The corner points are stored as differences to the previous corner and the neighbours
+ * as differences to the facet index. Both are small for a mesh with a sensible ordering.
+ */
+std::vector<uint8_t> encodeFacets(const std::vector<uint32_t>& facets)
+{
+    std::vector<uint8_t> out;
+    out.reserve(facets.size() * 2);
+    int64_t prev = 0;
+    for (std::size_t i = 0; i < facets.size(); i += 6) {
+        for (std::size_t j = 0; j < 3; j++) {
+            int64_t point = facets[i + j];
+            writeVarint(out, zigzag(point - prev));
+            prev = point;
+        }
+        const int64_t facet = int64_t(i / 6);
+        for (std::size_t j = 3; j < 6; j++) {
+            uint32_t neighbour = facets[i + j];
+            writeVarint(out, neighbour == OpenEdge ? 0 : zigzag(neighbour - facet) + 1);
+        }
+    }
+    return out;
+}
+
+std::vector<uint32_t> decodeFacets(const std::vector<uint8_t>& in, std::size_t count)
+{
+    std::vector<uint32_t> facets(6 * count);
+    std::size_t pos = 0;
+    int64_t prev = 0;
+    for (std::size_t i = 0; i < facets.size(); i += 6) {
+        for (std::size_t j = 0; j < 3; j++) {
+            prev += unzigzag(readVarint(in, pos));
+            facets[i + j] = static_cast<uint32_t>(prev);
+        }
+        const int64_t facet = int64_t(i / 6);
+        for (std::size_t j = 3; j < 6; j++) {
+            uint64_t value = readVarint(in, pos);
+            facets[i + j] = value == 0 ? OpenEdge
+                                       : static_cast<uint32_t>(facet + unzigzag(value - 1));
+        }
+    }
+    if (pos != in.size()) {
+        throw Base::BadFormatError("Invalid data structure");
+    }
+    return facets;
+}
+}  // namespace
+
 MeshKernel::MeshKernel()
 {
     _clBoundBox.SetVoid();
@@ -873,7 +1036,7 @@ MeshFacetArray MeshKernel::GetFacets(const std::vector<FacetIndex>& indices) con
     return ary;
 }
 
-void MeshKernel::Write(std::ostream& rclOut) const
+void MeshKernel::Write(std::ostream& rclOut, bool compress) const
 {
     if (!rclOut || rclOut.bad()) {
         return;
@@ -883,41 +1046,58 @@ void MeshKernel::Write(std::ostream& rclOut) const
 
     // Write a header with a "magic number" and a version
     str << static_cast<uint32_t>(0xA0B0C0D0);
-    str << static_cast<uint32_t>(0x010000);
-
-    char szInfo[257];  // needs an additional byte for zero-termination
-    strcpy(szInfo,
-           "MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-"
-           "MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-"
-           "MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-"
-           "MESH-MESH-MESH-\n");
-    rclOut.write(szInfo, 256);
+    str << BlockVersion;
+    str << (compress ? CompressedBlock : uint32_t(0));
 
     // write the number of points and facets
     str << static_cast<uint32_t>(CountPoints()) << static_cast<uint32_t>(CountFacets());
 
-    // write the data
-    for (const auto& it : _aclPointArray) {
-        str << it.x << it.y << it.z;
-    }
-
-    for (const auto& it : _aclFacetArray) {
-        str << static_cast<uint32_t>(it._aulPoints[0]) << static_cast<uint32_t>(it._aulPoints[1])
-            << static_cast<uint32_t>(it._aulPoints[2]);
-        str << static_cast<uint32_t>(it._aulNeighbours[0])
-            << static_cast<uint32_t>(it._aulNeighbours[1])
-            << static_cast<uint32_t>(it._aulNeighbours[2]);
-    }
-
     str << _clBoundBox.MinX << _clBoundBox.MaxX;
     str << _clBoundBox.MinY << _clBoundBox.MaxY;
     str << _clBoundBox.MinZ << _clBoundBox.MaxZ;
+
+    // pack the data into plain blocks of 32-bit values
+    std::vector<uint32_t> coords(3 * _aclPointArray.size());
+    parallel_for(_aclPointArray.size(), 65536, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            std::memcpy(&coords[3 * i], &_aclPointArray[i].x, 3 * sizeof(float));
+        }
+    });
+
+    std::vector<uint32_t> facets(6 * _aclFacetArray.size());
+    parallel_for(_aclFacetArray.size(), 65536, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& facet = _aclFacetArray[i];
+            for (std::size_t j = 0; j < 3; j++) {
+                facets[6 * i + j] = static_cast<uint32_t>(facet._aulPoints[j]);
+                facets[6 * i + j + 3] = facet._aulNeighbours[j] == FACET_INDEX_MAX
+                    ? OpenEdge
+                    : static_cast<uint32_t>(facet._aulNeighbours[j]);
+            }
+        }
+    });
+
+    if (compress) {
+        std::vector<uint8_t> pointBlock = encodePoints(coords);
+        std::vector<uint8_t> facetBlock = encodeFacets(facets);
+        str << static_cast<uint64_t>(pointBlock.size()) << static_cast<uint64_t>(facetBlock.size());
+        rclOut.write(reinterpret_cast<const char*>(pointBlock.data()),
+                     std::streamsize(pointBlock.size()));
+        rclOut.write(reinterpret_cast<const char*>(facetBlock.data()),
+                     std::streamsize(facetBlock.size()));
+    }
+    else {
+        rclOut.write(reinterpret_cast<const char*>(coords.data()),
+                     std::streamsize(coords.size() * sizeof(uint32_t)));
+        rclOut.write(reinterpret_cast<const char*>(facets.data()),
+                     std::streamsize(facets.size() * sizeof(uint32_t)));
+    }
 }
 
-void MeshKernel::Read(std::istream& rclIn)
+bool MeshKernel::Read(std::istream& rclIn)
 {
     if (!rclIn || rclIn.bad()) {
-        return;
+        return false;
     }
 
     // get header
@@ -932,8 +1112,14 @@ void MeshKernel::Read(std::istream& rclIn)
     Base::SwapEndian(swap_version);
     uint32_t open_edge = 0xffffffff;  // value to mark an open edge
 
-    // is it the new or old format?
+    // is it the block, the new or the old format?
     bool new_format = false;
+    if (magic == 0xA0B0C0D0 && version == BlockVersion) {
+        return ReadBlocks(rclIn, false);
+    }
+    if (swap_magic == 0xA0B0C0D0 && swap_version == BlockVersion) {
+        return ReadBlocks(rclIn, true);
+    }
     if (magic == 0xA0B0C0D0 && version == 0x010000) {
         new_format = true;
     }
@@ -1101,6 +1287,123 @@ void MeshKernel::Read(std::istream& rclIn)
         _aclPointArray.swap(pointArray);
         _aclFacetArray.swap(facetArray);
     }
+
+    return false;
+}
+
+bool MeshKernel::ReadBlocks(std::istream& rclIn, bool swap)
+{
+    Base::InputStream str(rclIn);
+    if (swap) {
+        str.setByteOrder(Base::Stream::BigEndian);
+    }
+
+    uint32_t flags {}, uCtPts {}, uCtFts {};
+    str >> flags >> uCtPts >> uCtFts;
+
+    // Sanity checks so we don't over-allocate below
+    if (uCtPts > 1e9 || uCtFts > 1e9) {
+        throw Base::BadFormatError("Mesh seems to have over a billion points or facets");
+    }
+
+    Base::BoundBox3f box;
+    str >> box.MinX >> box.MaxX;
+    str >> box.MinY >> box.MaxY;
+    str >> box.MinZ >> box.MaxZ;
+
+    std::vector<uint32_t> coords;
+    std::vector<uint32_t> facets;
+    try {
+        if (flags & CompressedBlock) {
+            uint64_t pointSize {}, facetSize {};
+            str >> pointSize >> facetSize;
+            // the blocks cannot be bigger than their worst-case encoding
+            if (pointSize > 24 * uint64_t(uCtPts) || facetSize > 30 * uint64_t(uCtFts)) {
+                throw Base::BadFormatError("Invalid data structure");
+            }
+            std::vector<uint8_t> pointBlock(pointSize);
+            std::vector<uint8_t> facetBlock(facetSize);
+            rclIn.read(reinterpret_cast<char*>(pointBlock.data()), std::streamsize(pointSize));
+            rclIn.read(reinterpret_cast<char*>(facetBlock.data()), std::streamsize(facetSize));
+            if (!rclIn) {
+                throw Base::BadFormatError("Reading from stream failed");
+            }
+            coords = decodePoints(pointBlock, 3 * std::size_t(uCtPts));
+            facets = decodeFacets(facetBlock, std::size_t(uCtFts));
+        }
+        else {
+            coords.resize(3 * std::size_t(uCtPts));
+            facets.resize(6 * std::size_t(uCtFts));
+            rclIn.read(reinterpret_cast<char*>(coords.data()),
+                       std::streamsize(coords.size() * sizeof(uint32_t)));
+            rclIn.read(reinterpret_cast<char*>(facets.data()),
+                       std::streamsize(facets.size() * sizeof(uint32_t)));
+            if (!rclIn) {
+                throw Base::BadFormatError("Reading from stream failed");
+            }
+            if (swap) {
+                std::for_each(coords.begin(), coords.end(), Base::SwapEndian<uint32_t>);
+                std::for_each(facets.begin(), facets.end(), Base::SwapEndian<uint32_t>);
+            }
+        }
+    }
+    catch (const std::bad_alloc&) {
+        throw Base::BadFormatError("Reading from stream failed");
+    }
+
+    MeshPointArray pointArray(uCtPts);
+    parallel_for(pointArray.size(), 65536, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            std::memcpy(&pointArray[i].x, &coords[3 * i], 3 * sizeof(float));
+        }
+    });
+
+    // unpack the facets and check that the neighbours reference each other
+    MeshFacetArray facetArray(uCtFts);
+    std::atomic<bool> valid {true};
+    std::atomic<bool> consistent {true};
+    parallel_for(facetArray.size(), 65536, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            MeshFacet& facet = facetArray[i];
+            for (std::size_t j = 0; j < 3; j++) {
+                uint32_t point = facets[6 * i + j];
+                uint32_t neighbour = facets[6 * i + j + 3];
+                if (point >= uCtPts || (neighbour >= uCtFts && neighbour != OpenEdge)) {
+                    valid = false;
+                    return;
+                }
+                facet._aulPoints[j] = point;
+                facet._aulNeighbours[j] = neighbour == OpenEdge ? FACET_INDEX_MAX : neighbour;
+            }
+        }
+    });
+    if (!valid) {
+        throw Base::BadFormatError("Invalid data structure");
+    }
+
+    parallel_for(facetArray.size(), 65536, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end && consistent; i++) {
+            const MeshFacet& facet = facetArray[i];
+            for (unsigned short j = 0; j < 3; j++) {
+                FacetIndex neighbour = facet._aulNeighbours[j];
+                if (neighbour == FACET_INDEX_MAX) {
+                    continue;
+                }
+                const MeshFacet& other = facetArray[neighbour];
+                unsigned short side =
+                    other.Side(facet._aulPoints[j], facet._aulPoints[(j + 1) % 3]);
+                if (side > 2 || other._aulNeighbours[side] != i) {
+                    consistent = false;
+                    return;
+                }
+            }
+        }
+    });
+
+    _clBoundBox = box;
+    _aclPointArray.swap(pointArray);
+    _aclFacetArray.swap(facetArray);
+    return consistent;
 }
 
 void MeshKernel::operator*=(const Base::Matrix4D& rclMat)
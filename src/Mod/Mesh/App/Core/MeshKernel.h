@@ -77,9 +77,15 @@ public:
 
     /** @name I/O methods */
     //@{
-    /// Binary streaming of data
-    void Write(std::ostream& rclOut) const;
-    void Read(std::istream& rclIn);
+    /** Binary streaming of data. The points and facets including their neighbours are
+     * written as blocks that are delta encoded if \a compress is true.
+     */
+    void Write(std::ostream& rclOut, bool compress = false) const;
+    /** Reads the mesh written by Write() or an older version of it. Returns true if the
+     * stream contained the neighbourhood of the facets and it is consistent, so that
+     * it needn't be checked or rebuilt.
+     */
+    bool Read(std::istream& rclIn);
     //@}
 
     /** @name Querying */
@@ -473,6 +479,8 @@ protected:
      * doesn't get deleted but marked as invalid.
      */
     void ErasePoint(PointIndex ulIndex, FacetIndex ulFacetIndex, bool bOnlySetInvalid = false);
+    /** Reads the blocks of the current stream format after its header. */
+    bool ReadBlocks(std::istream& rclIn, bool swap);
 
     /** Adjusts the facet's orierntation to the given normal direction. */
     inline void AdjustNormal(MeshFacet& rclFacet, const Base::Vector3f& rclNormal);
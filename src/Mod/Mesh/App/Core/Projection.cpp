@@ -26,6 +26,7 @@
 #include <map>
 
 
+#include "BVH.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
@@ -138,14 +139,6 @@ bool MeshProjection::projectLineOnMesh(const MeshFacetGrid& grid,
                                        const Base::Vector3f& vd,
                                        std::vector<Base::Vector3f>& polyline)
 {
-    Base::Vector3f dir(v2 - v1);
-    Base::Vector3f base(v1), normal(vd % dir);
-    normal.Normalize();
-    dir.Normalize();
-
-
-    std::vector<FacetIndex> facets;
-
     // special case: start and endpoint inside same facet
     if (f1 == f2) {
         polyline.push_back(v1);
@@ -153,6 +146,8 @@ bool MeshProjection::projectLineOnMesh(const MeshFacetGrid& grid,
         return true;
     }
 
+    std::vector<FacetIndex> facets;
+
     // cut all facets between the two endpoints
     MeshGridIterator gridIter(grid);
     for (gridIter.Init(); gridIter.More(); gridIter.Next()) {
@@ -165,6 +160,52 @@ bool MeshProjection::projectLineOnMesh(const MeshFacetGrid& grid,
     std::sort(facets.begin(), facets.end());
     facets.erase(std::unique(facets.begin(), facets.end()), facets.end());
 
+    return projectLineOnFacets(facets, v1, f1, v2, f2, vd, polyline);
+}
+
+bool MeshProjection::projectLineOnMesh(const MeshFacetBVH& bvh,
+                                       const Base::Vector3f& v1,
+                                       FacetIndex f1,
+                                       const Base::Vector3f& v2,
+                                       FacetIndex f2,
+                                       const Base::Vector3f& vd,
+                                       std::vector<Base::Vector3f>& polyline)
+{
+    // special case: start and endpoint inside same facet
+    if (f1 == f2) {
+        polyline.push_back(v1);
+        polyline.push_back(v2);
+        return true;
+    }
+
+    // cut all facets between the two endpoints, only the boxes cut by the plane are visited
+    Base::Vector3f normal(vd % (v2 - v1));
+    normal.Normalize();
+
+    std::vector<FacetIndex> facets;
+    bvh.Collect(
+        [&](const Base::BoundBox3f& box) {
+            return box.IsCutPlane(v1, normal);
+        },
+        facets);
+    std::sort(facets.begin(), facets.end());
+
+    return projectLineOnFacets(facets, v1, f1, v2, f2, vd, polyline);
+}
+
+bool MeshProjection::projectLineOnFacets(const std::vector<FacetIndex>& facets,
+                                         const Base::Vector3f& v1,
+                                         FacetIndex f1,
+                                         const Base::Vector3f& v2,
+                                         FacetIndex f2,
+                                         const Base::Vector3f& vd,
+                                         std::vector<Base::Vector3f>& polyline) const
+{
+    Base::Vector3f dir(v2 - v1);
+    Base::Vector3f base(v1), normal(vd % dir);
+    normal.Normalize();
+    dir.Normalize();
+
     // cut all facets with plane
     std::list<std::pair<Base::Vector3f, Base::Vector3f>> cutLine;
     for (FacetIndex facet : facets) {
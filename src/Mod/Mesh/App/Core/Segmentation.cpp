@@ -21,11 +21,13 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <limits>
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "Functional.h"
 #include "Segmentation.h"
 
 using namespace MeshCore;
@@ -76,19 +78,22 @@ MeshDistancePlanarSegment::~MeshDistancePlanarSegment()
 void MeshDistancePlanarSegment::Initialize(FacetIndex index)
 {
     fitter->Clear();
+    moments = PlaneFit::Moments();
 
     MeshGeomFacet triangle = kernel.GetFacet(index);
     basepoint = triangle.GetGravityPoint();
     normal = triangle.GetNormal();
-    fitter->AddPoint(triangle._aclPoints[0]);
-    fitter->AddPoint(triangle._aclPoints[1]);
-    fitter->AddPoint(triangle._aclPoints[2]);
+    for (const auto& pnt : triangle._aclPoints) {
+        fitter->AddPoint(pnt);
+        moments.Add(pnt);
+    }
 }
 
 bool MeshDistancePlanarSegment::TestFacet(const MeshFacet& face) const
 {
     if (!fitter->Done()) {
-        fitter->Fit();
+        // refit from the running sums instead of all points of the segment
+        fitter->Fit(moments);
     }
     MeshGeomFacet triangle = kernel.GetFacet(face);
     for (auto pnt : triangle._aclPoints) {
@@ -103,7 +108,9 @@ bool MeshDistancePlanarSegment::TestFacet(const MeshFacet& face) const
 void MeshDistancePlanarSegment::AddFacet(const MeshFacet& face)
 {
     MeshGeomFacet triangle = kernel.GetFacet(face);
-    fitter->AddPoint(triangle.GetGravityPoint());
+    Base::Vector3f center = triangle.GetGravityPoint();
+    fitter->AddPoint(center);
+    moments.Add(center);
 }
 
 // --------------------------------------------------------
@@ -130,11 +137,13 @@ void PlaneSurfaceFit::Initialize(const MeshCore::MeshGeomFacet& tria)
         normal = tria.GetNormal();
 
         fitter->Clear();
+        moments = PlaneFit::Moments();
 
-        fitter->AddPoint(tria._aclPoints[0]);
-        fitter->AddPoint(tria._aclPoints[1]);
-        fitter->AddPoint(tria._aclPoints[2]);
-        fitter->Fit();
+        for (const auto& pnt : tria._aclPoints) {
+            fitter->AddPoint(pnt);
+            moments.Add(pnt);
+        }
+        fitter->Fit(moments);
     }
 }
 
@@ -146,7 +155,9 @@ bool PlaneSurfaceFit::TestTriangle(const MeshGeomFacet&) const
 void PlaneSurfaceFit::AddTriangle(const MeshCore::MeshGeomFacet& tria)
 {
     if (fitter) {
-        fitter->AddPoint(tria.GetGravityPoint());
+        Base::Vector3f center = tria.GetGravityPoint();
+        fitter->AddPoint(center);
+        moments.Add(center);
     }
 }
 
@@ -165,7 +176,7 @@ float PlaneSurfaceFit::Fit()
         return 0;
     }
 
-    return fitter->Fit();
+    return fitter->Fit(moments);
 }
 
 float PlaneSurfaceFit::GetDistanceToSurface(const Base::Vector3f& pnt) const
@@ -536,6 +547,10 @@ bool MeshSurfaceVisitor::AllowVisit(const MeshFacet& face,
                                     unsigned long,
                                     unsigned short)
 {
+    // a visited facet is rejected anyway, so don't let it trigger a refit
+    if (face.IsFlag(MeshFacet::VISIT)) {
+        return false;
+    }
     return segm.TestFacet(face);
 }
 
@@ -571,6 +586,11 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
         cAlgo.ResetFacetsFlag(resetVisited, MeshCore::MeshFacet::VISIT);
         resetVisited.clear();
 
+        if (it->IsStateless()) {
+            FindStatelessSegments(*it, resetVisited);
+            continue;
+        }
+
         MeshCore::MeshIsNotFlag<MeshCore::MeshFacet> flag;
         iCur = std::find_if(iBeg, iEnd, [flag](const MeshFacet& f) {
             return flag(f, MeshFacet::VISIT);
@@ -612,3 +632,127 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
         }
     }
 }
+
+void MeshSegmentAlgorithm::FindStatelessSegments(MeshSurfaceSegment& segm,
+                                                 std::vector<FacetIndex>& resetVisited)
+{
+    const MeshFacetArray& facets = myKernel.GetFacets();
+    const std::size_t count = facets.size();
+
+    // test all facets that are not part of a segment yet
+    std::vector<char> accepted(count);
+    parallel_for(count, 4096, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            accepted[i] = !facets[i].IsFlag(MeshFacet::VISIT) && segm.TestFacet(facets[i]);
+        }
+    });
+
+    // Merge neighboured accepted facets with a lock-free union-find. A root is always
+    // linked to a smaller index, so that the root of a component is its smallest facet.
+    std::vector<std::atomic<FacetIndex>> parent(count);
+    for (std::size_t i = 0; i < count; i++) {
+        parent[i].store(i, std::memory_order_relaxed);
+    }
+    auto root = [&parent](FacetIndex index) {
+        for (;;) {
+            FacetIndex up = parent[index].load();
+            if (up == index) {
+                return index;
+            }
+            FacetIndex next = parent[up].load();
+            parent[index].compare_exchange_weak(up, next);
+            index = next;
+        }
+    };
+    parallel_for(count, 4096, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            if (!accepted[i]) {
+                continue;
+            }
+            for (FacetIndex nb : facets[i]._aulNeighbours) {
+                if (nb >= count || !accepted[nb]) {
+                    continue;
+                }
+                FacetIndex a = i;
+                FacetIndex b = nb;
+                for (;;) {
+                    a = root(a);
+                    b = root(b);
+                    if (a == b) {
+                        break;
+                    }
+                    if (a < b) {
+                        std::swap(a, b);
+                    }
+                    FacetIndex expected = a;
+                    if (parent[a].compare_exchange_strong(expected, b)) {
+                        break;
+                    }
+                }
+            }
+        }
+    });
+
+    // the facets of each component, sorted by their index
+    std::vector<FacetIndex> offsets(count + 1, 0);
+    std::vector<FacetIndex> roots(count);
+    for (std::size_t i = 0; i < count; i++) {
+        if (accepted[i]) {
+            roots[i] = root(i);
+            offsets[roots[i] + 1]++;
+        }
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+    std::vector<FacetIndex> members(offsets[count]);
+    std::vector<FacetIndex> fill(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < count; i++) {
+        if (accepted[i]) {
+            members[fill[roots[i]]++] = i;
+        }
+    }
+
+    // Take the start facets in the same order as the flood fill. A start facet that is
+    // rejected itself still connects the components of its neighbours.
+    auto addComponent = [&](FacetIndex index, std::vector<FacetIndex>& indices) {
+        FacetIndex comp = roots[index];
+        for (FacetIndex pos = offsets[comp]; pos < offsets[comp + 1]; pos++) {
+            FacetIndex member = members[pos];
+            if (!facets[member].IsFlag(MeshFacet::VISIT)) {
+                facets[member].SetFlag(MeshFacet::VISIT);
+                indices.push_back(member);
+            }
+        }
+    };
+    for (FacetIndex start = 0; start < count; start++) {
+        if (facets[start].IsFlag(MeshFacet::VISIT)) {
+            continue;
+        }
+
+        std::vector<FacetIndex> indices;
+        segm.Initialize(start);
+        if (segm.TestInitialFacet(start)) {
+            indices.push_back(start);
+        }
+        facets[start].SetFlag(MeshFacet::VISIT);
+        if (accepted[start]) {
+            addComponent(start, indices);
+        }
+        else {
+            for (FacetIndex nb : facets[start]._aulNeighbours) {
+                if (nb < count && accepted[nb]) {
+                    addComponent(nb, indices);
+                }
+            }
+        }
+
+        // add or discard the segment
+        if (indices.size() <= 1) {
+            resetVisited.push_back(start);
+        }
+        else {
+            segm.AddSegment(indices);
+        }
+    }
+}
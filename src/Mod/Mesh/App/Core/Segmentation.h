@@ -26,6 +26,7 @@
 #include <memory>
 #include <vector>
 
+#include "Approximation.h"
 #include "Curvature.h"
 #include "MeshKernel.h"
 #include "Visitor.h"
@@ -34,9 +35,6 @@
 namespace MeshCore
 {
 
-class PlaneFit;
-class CylinderFit;
-class SphereFit;
 class MeshFacet;
 using MeshSegment = std::vector<FacetIndex>;
 
@@ -54,6 +52,12 @@ public:
     MeshSurfaceSegment& operator=(MeshSurfaceSegment&&) = delete;
 
     virtual bool TestFacet(const MeshFacet& rclFacet) const = 0;
+    /// Returns true if TestFacet() doesn't depend on the facets added so far. All facets
+    /// can be tested in parallel then.
+    virtual bool IsStateless() const
+    {
+        return false;
+    }
     virtual const char* GetType() const = 0;
     virtual void Initialize(FacetIndex);
     virtual bool TestInitialFacet(FacetIndex) const;
@@ -112,6 +116,7 @@ private:
     Base::Vector3f basepoint;
     Base::Vector3f normal;
     PlaneFit* fitter;
+    PlaneFit::Moments moments;
 };
 
 class MeshExport AbstractSurfaceFit
@@ -163,6 +168,7 @@ private:
     Base::Vector3f basepoint;
     Base::Vector3f normal;
     PlaneFit* fitter;
+    PlaneFit::Moments moments;
 };
 
 class MeshExport CylinderSurfaceFit: public AbstractSurfaceFit
@@ -270,6 +276,10 @@ public:
     {
         return info.at(pos);
     }
+    bool IsStateless() const override
+    {
+        return true;
+    }
 
 private:
     const std::vector<CurvatureInfo>& info;
@@ -393,6 +403,10 @@ public:
     void FindSegments(std::vector<MeshSurfaceSegmentPtr>&);
 
 private:
+    /// Finds the segments of a stateless surface type from connected components of the
+    /// accepted facets. The result is the same as of the flood fill.
+    void FindStatelessSegments(MeshSurfaceSegment&, std::vector<FacetIndex>& resetVisited);
+
     const MeshKernel& myKernel;
 };
 
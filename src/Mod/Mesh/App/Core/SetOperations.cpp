@@ -21,6 +21,7 @@
  ***************************************************************************/
 
 
+#include <atomic>
 #include <fstream>
 #include <ios>
 
@@ -29,10 +30,11 @@
 #include <Base/Sequencer.h>
 
 #include "Algorithm.h"
+#include "BVH.h"
 #include "Builder.h"
 #include "Definitions.h"
 #include "Elements.h"
-#include "Grid.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "SetOperations.h"
 #include "Triangulation.h"
@@ -172,115 +174,109 @@ void SetOperations::Do()
 void SetOperations::Cut(std::set<FacetIndex>& facetsCuttingEdge0,
                         std::set<FacetIndex>& facetsCuttingEdge1)
 {
-    MeshFacetGrid grid1(_cutMesh0, 20);
-    MeshFacetGrid grid2(_cutMesh1, 20);
-
-    unsigned long ctGx1 {}, ctGy1 {}, ctGz1 {};
-    grid1.GetCtGrids(ctGx1, ctGy1, ctGz1);
-
-    for (auto gx1 = 0UL; gx1 < ctGx1; gx1++) {
-        for (auto gy1 = 0UL; gy1 < ctGy1; gy1++) {
-            for (auto gz1 = 0UL; gz1 < ctGz1; gz1++) {
-                if (grid1.GetCtElements(gx1, gy1, gz1) > 0) {
-                    std::vector<FacetIndex> vecFacets2;
-                    grid2.Inside(grid1.GetBoundBox(gx1, gy1, gz1), vecFacets2);
-
-                    if (!vecFacets2.empty()) {
-                        std::set<FacetIndex> vecFacets1;
-                        grid1.GetElements(gx1, gy1, gz1, vecFacets1);
-
-                        std::set<FacetIndex>::iterator it1;
-                        for (it1 = vecFacets1.begin(); it1 != vecFacets1.end(); ++it1) {
-                            FacetIndex fidx1 = *it1;
-                            MeshGeomFacet f1 = _cutMesh0.GetFacet(*it1);
-
-                            std::vector<FacetIndex>::iterator it2;
-                            for (it2 = vecFacets2.begin(); it2 != vecFacets2.end(); ++it2) {
-                                FacetIndex fidx2 = *it2;
-                                MeshGeomFacet f2 = _cutMesh1.GetFacet(fidx2);
-
-                                MeshPoint p0, p1;
-
-                                int isect = f1.IntersectWithFacet(f2, p0, p1);
-                                if (isect > 0) {
-                                    // optimize cut line if distance to nearest point is too small
-                                    float minDist1 = _minDistanceToPoint,
-                                          minDist2 = _minDistanceToPoint;
-                                    MeshPoint np0 = p0, np1 = p1;
-                                    for (int i = 0; i < 3; i++)  // NOLINT
-                                    {
-                                        float d1 = (f1._aclPoints[i] - p0).Length();
-                                        float d2 = (f1._aclPoints[i] - p1).Length();
-                                        if (d1 < minDist1) {
-                                            minDist1 = d1;
-                                            np0 = f1._aclPoints[i];
-                                        }
-                                        if (d2 < minDist2) {
-                                            minDist2 = d2;
-                                            p1 = f1._aclPoints[i];
-                                        }
-                                    }  // for (int i = 0; i < 3; i++)
-
-                                    // optimize cut line if distance to nearest point is too small
-                                    for (int i = 0; i < 3; i++)  // NOLINT
-                                    {
-                                        float d1 = (f2._aclPoints[i] - p0).Length();
-                                        float d2 = (f2._aclPoints[i] - p1).Length();
-                                        if (d1 < minDist1) {
-                                            minDist1 = d1;
-                                            np0 = f2._aclPoints[i];
-                                        }
-                                        if (d2 < minDist2) {
-                                            minDist2 = d2;
-                                            np1 = f2._aclPoints[i];
-                                        }
-                                    }  // for (int i = 0; i < 3; i++)
-
-                                    MeshPoint mp0 = np0;
-                                    MeshPoint mp1 = np1;
-
-                                    if (mp0 != mp1) {
-                                        facetsCuttingEdge0.insert(fidx1);
-                                        facetsCuttingEdge1.insert(fidx2);
-
-                                        _cutPoints.insert(mp0);
-                                        _cutPoints.insert(mp1);
-
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit0 =
-                                            _cutPoints.insert(mp0);
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit1 =
-                                            _cutPoints.insert(mp1);
-
-                                        _edges[Edge(mp0, mp1)] = EdgeInfo();
-
-                                        _facet2points[0][fidx1].push_back(pit0.first);
-                                        _facet2points[0][fidx1].push_back(pit1.first);
-                                        _facet2points[1][fidx2].push_back(pit0.first);
-                                        _facet2points[1][fidx2].push_back(pit1.first);
-                                    }
-                                    else {
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit =
-                                            _cutPoints.insert(mp0);
-
-                                        // do not insert a facet when only one corner point cuts the
-                                        // edge if (!((mp0 == f1._aclPoints[0]) || (mp0 ==
-                                        // f1._aclPoints[1]) || (mp0 == f1._aclPoints[2])))
-                                        {
-                                            facetsCuttingEdge0.insert(fidx1);
-                                            _facet2points[0][fidx1].push_back(pit.first);
-                                        }
-
-                                        // if (!((mp0 == f2._aclPoints[0]) || (mp0 ==
-                                        // f2._aclPoints[1]) || (mp0 == f2._aclPoints[2])))
-                                        {
-                                            facetsCuttingEdge1.insert(fidx2);
-                                            _facet2points[1][fidx2].push_back(pit.first);
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
+    // Only the facets with intersecting bounding boxes can cut each other
+    MeshFacetBVH bvh1(_cutMesh0);
+    MeshFacetBVH bvh2(_cutMesh1);
+    std::vector<std::pair<FacetIndex, FacetIndex>> candidates;
+    bvh1.GetOverlappingPairs(bvh2, candidates);
+
+    // intersect the candidates on all threads and merge the results in their order
+    struct Intersection
+    {
+        int isect = 0;
+        MeshPoint p0, p1;
+    };
+    std::vector<Intersection> intersections(candidates.size());
+    parallel_for(candidates.size(), 1000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            MeshGeomFacet f1 = _cutMesh0.GetFacet(candidates[i].first);
+            MeshGeomFacet f2 = _cutMesh1.GetFacet(candidates[i].second);
+            Intersection& cut = intersections[i];
+            cut.isect = f1.IntersectWithFacet(f2, cut.p0, cut.p1);
+        }
+    });
+
+    for (std::size_t i = 0; i < candidates.size(); i++) {
+        if (intersections[i].isect > 0) {
+            FacetIndex fidx1 = candidates[i].first;
+            FacetIndex fidx2 = candidates[i].second;
+            MeshGeomFacet f1 = _cutMesh0.GetFacet(fidx1);
+            MeshGeomFacet f2 = _cutMesh1.GetFacet(fidx2);
+            MeshPoint p0 = intersections[i].p0;
+            MeshPoint p1 = intersections[i].p1;
+
+            // optimize cut line if distance to nearest point is too small
+            float minDist1 = _minDistanceToPoint,
+                  minDist2 = _minDistanceToPoint;
+            MeshPoint np0 = p0, np1 = p1;
+            for (int i = 0; i < 3; i++)  // NOLINT
+            {
+                float d1 = (f1._aclPoints[i] - p0).Length();
+                float d2 = (f1._aclPoints[i] - p1).Length();
+                if (d1 < minDist1) {
+                    minDist1 = d1;
+                    np0 = f1._aclPoints[i];
+                }
+                if (d2 < minDist2) {
+                    minDist2 = d2;
+                    p1 = f1._aclPoints[i];
+                }
+            }  // for (int i = 0; i < 3; i++)
+
+            // optimize cut line if distance to nearest point is too small
+            for (int i = 0; i < 3; i++)  // NOLINT
+            {
+                float d1 = (f2._aclPoints[i] - p0).Length();
+                float d2 = (f2._aclPoints[i] - p1).Length();
+                if (d1 < minDist1) {
+                    minDist1 = d1;
+                    np0 = f2._aclPoints[i];
+                }
+                if (d2 < minDist2) {
+                    minDist2 = d2;
+                    np1 = f2._aclPoints[i];
+                }
+            }  // for (int i = 0; i < 3; i++)
+
+            MeshPoint mp0 = np0;
+            MeshPoint mp1 = np1;
+
+            if (mp0 != mp1) {
+                facetsCuttingEdge0.insert(fidx1);
+                facetsCuttingEdge1.insert(fidx2);
+
+                _cutPoints.insert(mp0);
+                _cutPoints.insert(mp1);
+
+                std::pair<std::set<MeshPoint>::iterator, bool> pit0 =
+                    _cutPoints.insert(mp0);
+                std::pair<std::set<MeshPoint>::iterator, bool> pit1 =
+                    _cutPoints.insert(mp1);
+
+                _edges[Edge(mp0, mp1)] = EdgeInfo();
+
+                _facet2points[0][fidx1].push_back(pit0.first);
+                _facet2points[0][fidx1].push_back(pit1.first);
+                _facet2points[1][fidx2].push_back(pit0.first);
+                _facet2points[1][fidx2].push_back(pit1.first);
+            }
+            else {
+                std::pair<std::set<MeshPoint>::iterator, bool> pit =
+                    _cutPoints.insert(mp0);
+
+                // do not insert a facet when only one corner point cuts the
+                // edge if (!((mp0 == f1._aclPoints[0]) || (mp0 ==
+                // f1._aclPoints[1]) || (mp0 == f1._aclPoints[2])))
+                {
+                    facetsCuttingEdge0.insert(fidx1);
+                    _facet2points[0][fidx1].push_back(pit.first);
+                }
+
+                // if (!((mp0 == f2._aclPoints[0]) || (mp0 ==
+                // f2._aclPoints[1]) || (mp0 == f2._aclPoints[2])))
+                {
+                    facetsCuttingEdge1.insert(fidx2);
+                    _facet2points[1][fidx2].push_back(pit.first);
                 }
             }
         }
@@ -625,107 +621,57 @@ bool MeshIntersection::hasIntersection() const
 
 void MeshIntersection::getIntersection(std::list<MeshIntersection::Tuple>& intsct) const
 {
-    const MeshKernel& k1 = kernel1;
-    const MeshKernel& k2 = kernel2;
-
-    // Contains bounding boxes for every facet of 'k1'
-    std::vector<Base::BoundBox3f> boxes1;
-    MeshFacetIterator cMFI1(k1);
-    for (cMFI1.Begin(); cMFI1.More(); cMFI1.Next()) {
-        boxes1.push_back((*cMFI1).GetBoundBox());
-    }
-
-    // Contains bounding boxes for every facet of 'k2'
-    std::vector<Base::BoundBox3f> boxes2;
-    MeshFacetIterator cMFI2(k2);
-    for (cMFI2.Begin(); cMFI2.More(); cMFI2.Next()) {
-        boxes2.push_back((*cMFI2).GetBoundBox());
-    }
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(k1);
-
-    const MeshFacetArray& rFaces2 = k2.GetFacets();
-    Base::SequencerLauncher seq("Checking for intersections...", rFaces2.size());
-    int index = 0;
-    MeshGeomFacet facet1, facet2;
-    Base::Vector3f pt1, pt2;
-
-    // Iterate over the facets of the 2nd mesh and find the grid elements of the 1st mesh
-    for (auto it = rFaces2.begin(); it != rFaces2.end(); ++it, index++) {
-        seq.next();
-        std::vector<FacetIndex> elements;
-        cMeshFacetGrid.Inside(boxes2[index], elements, true);
-
-        cMFI2.Set(index);
-        facet2 = *cMFI2;
-
-        for (FacetIndex element : elements) {
-            if (boxes2[index] && boxes1[element]) {
-                cMFI1.Set(element);
-                facet1 = *cMFI1;
-                int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                if (ret == 2) {
-                    Tuple d;
-                    d.p1 = pt1;
-                    d.p2 = pt2;
-                    d.f1 = element;
-                    d.f2 = index;
-                    intsct.push_back(d);
-                }
+    // Splits the meshes using bounding volume hierarchies for speeding up the calculation
+    MeshFacetBVH bvh1(kernel1);
+    MeshFacetBVH bvh2(kernel2);
+    std::vector<std::pair<FacetIndex, FacetIndex>> candidates;
+    bvh1.GetOverlappingPairs(bvh2, candidates);
+
+    // intersect the candidates on all threads and keep the results in their order
+    std::vector<Tuple> lines(candidates.size());
+    std::vector<char> found(candidates.size(), 0);
+    parallel_for(candidates.size(), 1000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            MeshGeomFacet facet1 = kernel1.GetFacet(candidates[i].first);
+            MeshGeomFacet facet2 = kernel2.GetFacet(candidates[i].second);
+            Tuple& d = lines[i];
+            if (facet1.IntersectWithFacet(facet2, d.p1, d.p2) == 2) {
+                d.f1 = candidates[i].first;
+                d.f2 = candidates[i].second;
+                found[i] = 1;
             }
         }
+    });
+
+    for (std::size_t i = 0; i < candidates.size(); i++) {
+        if (found[i]) {
+            intsct.push_back(lines[i]);
+        }
     }
 }
 
 bool MeshIntersection::testIntersection(const MeshKernel& k1, const MeshKernel& k2)
 {
-    // Contains bounding boxes for every facet of 'k1'
-    std::vector<Base::BoundBox3f> boxes1;
-    MeshFacetIterator cMFI1(k1);
-    for (cMFI1.Begin(); cMFI1.More(); cMFI1.Next()) {
-        boxes1.push_back((*cMFI1).GetBoundBox());
-    }
-
-    // Contains bounding boxes for every facet of 'k2'
-    std::vector<Base::BoundBox3f> boxes2;
-    MeshFacetIterator cMFI2(k2);
-    for (cMFI2.Begin(); cMFI2.More(); cMFI2.Next()) {
-        boxes2.push_back((*cMFI2).GetBoundBox());
-    }
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(k1);
-
-    const MeshFacetArray& rFaces2 = k2.GetFacets();
-    Base::SequencerLauncher seq("Checking for intersections...", rFaces2.size());
-    int index = 0;
-    MeshGeomFacet facet1, facet2;
-    Base::Vector3f pt1, pt2;
-
-    // Iterate over the facets of the 2nd mesh and find the grid elements of the 1st mesh
-    for (auto it = rFaces2.begin(); it != rFaces2.end(); ++it, index++) {
-        seq.next();
-        std::vector<FacetIndex> elements;
-        cMeshFacetGrid.Inside(boxes2[index], elements, true);
-
-        cMFI2.Set(index);
-        facet2 = *cMFI2;
-
-        for (FacetIndex element : elements) {
-            if (boxes2[index] && boxes1[element]) {
-                cMFI1.Set(element);
-                facet1 = *cMFI1;
-                int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                if (ret == 2) {
-                    // abort after the first detected self-intersection
-                    return true;
-                }
-            }
+    // Splits the meshes using bounding volume hierarchies for speeding up the calculation
+    MeshFacetBVH bvh1(k1);
+    MeshFacetBVH bvh2(k2);
+    std::atomic<bool> found {false};
+    std::vector<std::pair<FacetIndex, FacetIndex>> candidates;
+    bvh1.GetOverlappingPairs(bvh2, candidates, [&](FacetIndex index1, FacetIndex index2) {
+        // abort after the first detected intersection
+        if (found) {
+            return false;
         }
-    }
+        Base::Vector3f pt1, pt2;
+        MeshGeomFacet facet1 = k1.GetFacet(index1);
+        MeshGeomFacet facet2 = k2.GetFacet(index2);
+        if (facet1.IntersectWithFacet(facet2, pt1, pt2) == 2) {
+            found = true;
+        }
+        return false;
+    });
 
-    return false;
+    return found;
 }
 
 void MeshIntersection::connectLines(bool onlyclosed,
@@ -10,6 +10,7 @@
 // * Comment out printf statements
 // * Fix compiler warnings
 // * Remove macros loop,i,j,k
+// * Add locked vertices that are never moved and keep the original index of the vertices
 
 #include <vector>
 
@@ -80,7 +81,7 @@ class Simplify
 {
 public:
     struct Triangle { int v[3];double err[4];int deleted,dirty;vec3f n; };
-    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;};
+    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;int locked=0;int origin=0;};
     struct Ref { int tid,tvertex; };
     std::vector<Triangle> triangles;
     std::vector<Vertex> vertices;
@@ -193,6 +194,8 @@ void Simplify::simplify_mesh(int target_count, double tolerance, double aggressi
                     // Border check
                     if (v0.border != v1.border)
                         continue;
+                    if (v0.locked || v1.locked)
+                        continue;
 
                     // Compute vertex to collapse to
                     vec3f p;
@@ -474,6 +477,8 @@ void Simplify::compact_mesh()
         {
             vertices[i].tstart=dst;
             vertices[dst].p=vertices[i].p;
+            vertices[dst].locked=vertices[i].locked;
+            vertices[dst].origin=vertices[i].origin;
             dst++;
         }
     }
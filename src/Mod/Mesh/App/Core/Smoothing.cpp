@@ -25,8 +25,9 @@
 
 #include <Base/Tools.h>
 
-#include "Algorithm.h"
+#include "Adjacency.h"
 #include "Approximation.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
 #include "Smoothing.h"
@@ -57,7 +58,7 @@ void PlaneFitSmoothing::Smooth(unsigned int iterations)
     MeshCore::MeshPointArray PointArray = kernel.GetPoints();
 
     MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel);
     MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
 
     for (unsigned int i = 0; i < iterations; i++) {
@@ -66,12 +67,12 @@ void PlaneFitSmoothing::Smooth(unsigned int iterations)
             MeshCore::PlaneFit pf;
             pf.AddPoint(*v_it);
             center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
+            MeshAdjacency::Range cv = vv_it[v_it.Position()];
             if (cv.size() < 3) {
                 continue;
             }
 
-            std::set<PointIndex>::const_iterator cv_it;
+            MeshAdjacency::Range::const_iterator cv_it;
             for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
                 pf.AddPoint(v_beg[*cv_it]);
                 center += v_beg[*cv_it];
@@ -113,7 +114,7 @@ void PlaneFitSmoothing::SmoothPoints(unsigned int iterations,
     MeshCore::MeshPointArray PointArray = kernel.GetPoints();
 
     MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel);
     MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
 
     for (unsigned int i = 0; i < iterations; i++) {
@@ -123,12 +124,12 @@ void PlaneFitSmoothing::SmoothPoints(unsigned int iterations,
             MeshCore::PlaneFit pf;
             pf.AddPoint(*v_it);
             center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
+            MeshAdjacency::Range cv = vv_it[v_it.Position()];
             if (cv.size() < 3) {
                 continue;
             }
 
-            std::set<PointIndex>::const_iterator cv_it;
+            MeshAdjacency::Range::const_iterator cv_it;
             for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
                 pf.AddPoint(v_beg[*cv_it]);
                 center += v_beg[*cv_it];
@@ -167,84 +168,78 @@ LaplaceSmoothing::LaplaceSmoothing(MeshKernel& m)
     : AbstractSmoothing(m)
 {}
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
+void LaplaceSmoothing::Umbrella(const MeshCompactPointToPoints& vv_it,
+                                const MeshCompactPointToFacets& vf_it,
                                 double stepsize)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it, v_beg = points.begin(), v_end = points.end();
-
-    PointIndex pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it, ++pos) {
-        const std::set<PointIndex>& cv = vv_it[pos];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[pos].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
-
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - v_it->x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - v_it->y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - v_it->z);
-        }
-
-        float x = static_cast<float>(static_cast<double>(v_it->x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z) + stepsize * delz);
-        kernel.SetPoint(pos, x, y, z);
-    }
+    Umbrella(vv_it, vf_it, stepsize, kernel.CountPoints(), [](std::size_t pos) {
+        return PointIndex(pos);
+    });
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
+void LaplaceSmoothing::Umbrella(const MeshCompactPointToPoints& vv_it,
+                                const MeshCompactPointToFacets& vf_it,
                                 double stepsize,
                                 const std::vector<PointIndex>& point_indices)
 {
+    Umbrella(vv_it, vf_it, stepsize, point_indices.size(), [&point_indices](std::size_t pos) {
+        return point_indices[pos];
+    });
+}
+
+void LaplaceSmoothing::Umbrella(const MeshCompactPointToPoints& vv_it,
+                                const MeshCompactPointToFacets& vf_it,
+                                double stepsize,
+                                std::size_t count,
+                                const std::function<PointIndex(std::size_t)>& indexOf)
+{
+    // All new positions are computed from the old ones before any point is moved. So, every
+    // point can be handled independently and the result doesn't depend on the number of
+    // threads or the order of the points.
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
+    std::vector<Base::Vector3f> moved(count);
+    std::vector<char> movable(count, 0);
 
-    for (PointIndex it : point_indices) {
-        const std::set<PointIndex>& cv = vv_it[it];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[it].size()) {
-            // do nothing for border points
-            continue;
-        }
+    parallel_for(count, 4096, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            PointIndex pos = indexOf(i);
+            MeshAdjacency::Range cv = vv_it[pos];
+            if (cv.size() < 3) {
+                continue;
+            }
+            if (cv.size() != vf_it[pos].size()) {
+                // do nothing for border points
+                continue;
+            }
 
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
+            const MeshPoint& pnt = points[pos];
+            double sumx = 0.0, sumy = 0.0, sumz = 0.0;
+            for (ElementIndex index : cv) {
+                const MeshPoint& neighbour = points[index];
+                sumx += static_cast<double>(neighbour.x - pnt.x);
+                sumy += static_cast<double>(neighbour.y - pnt.y);
+                sumz += static_cast<double>(neighbour.z - pnt.z);
+            }
 
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - (v_beg[it]).x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - (v_beg[it]).y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - (v_beg[it]).z);
+            double w = stepsize / double(cv.size());
+            moved[i].Set(static_cast<float>(static_cast<double>(pnt.x) + w * sumx),
+                         static_cast<float>(static_cast<double>(pnt.y) + w * sumy),
+                         static_cast<float>(static_cast<double>(pnt.z) + w * sumz));
+            movable[i] = 1;
         }
+    });
 
-        float x = static_cast<float>(static_cast<double>((v_beg[it]).x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[it]).y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[it]).z) + stepsize * delz);
-        kernel.SetPoint(it, x, y, z);
+    for (std::size_t i = 0; i < count; i++) {
+        if (movable[i]) {
+            kernel.SetPoint(indexOf(i), moved[i]);
+        }
     }
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
 
     for (unsigned int i = 0; i < iterations; i++) {
         Umbrella(vv_it, vf_it, lambda);
@@ -254,8 +249,8 @@ void LaplaceSmoothing::Smooth(unsigned int iterations)
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations,
                                     const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
 
     for (unsigned int i = 0; i < iterations; i++) {
         Umbrella(vv_it, vf_it, lambda, point_indices);
@@ -268,8 +263,8 @@ TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
@@ -282,8 +277,8 @@ void TaubinSmoothing::Smooth(unsigned int iterations)
 void TaubinSmoothing::SmoothPoints(unsigned int iterations,
                                    const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
@@ -327,8 +322,8 @@ void MedianFilterSmoothing::Smooth(unsigned int iterations)
 {
     std::vector<unsigned long> point_indices(kernel.CountPoints());
     std::generate(point_indices.begin(), point_indices.end(), Base::iotaGen<unsigned long>(0));
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactFacetToFacets ff_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
 
     for (unsigned int i = 0; i < iterations; i++) {
         UpdatePoints(ff_it, vf_it, point_indices);
@@ -338,16 +333,16 @@ void MedianFilterSmoothing::Smooth(unsigned int iterations)
 void MedianFilterSmoothing::SmoothPoints(unsigned int iterations,
                                          const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactFacetToFacets ff_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
 
     for (unsigned int i = 0; i < iterations; i++) {
         UpdatePoints(ff_it, vf_it, point_indices);
     }
 }
 
-void MedianFilterSmoothing::UpdatePoints(const MeshRefFacetToFacets& ff_it,
-                                         const MeshRefPointToFacets& vf_it,
+void MedianFilterSmoothing::UpdatePoints(const MeshCompactFacetToFacets& ff_it,
+                                         const MeshCompactPointToFacets& vf_it,
                                          const std::vector<PointIndex>& point_indices)
 {
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
@@ -365,7 +360,7 @@ void MedianFilterSmoothing::UpdatePoints(const MeshRefFacetToFacets& ff_it,
     for (FacetIndex pos = 0; pos < facets.size(); pos++) {
         iter.Set(pos);
         Base::Vector3d refNormal = Base::toVector<double>(iter->GetNormal());
-        const std::set<FacetIndex>& cv = ff_it[pos];
+        MeshAdjacency::Range cv = ff_it[pos];
         const MeshCore::MeshFacet& facet = facets[pos];
 
         std::vector<AngleNormal> anglesWithFaces;
@@ -394,7 +389,7 @@ void MedianFilterSmoothing::UpdatePoints(const MeshRefFacetToFacets& ff_it,
     // Step 2: move vertices
     for (auto pos : point_indices) {
         Base::Vector3d P = Base::toVector<double>(points[pos]);
-        const std::set<FacetIndex>& cv = vf_it[pos];
+        MeshAdjacency::Range cv = vf_it[pos];
 
         double totalArea = 0.0;
         Base::Vector3d totalvT;
@@ -23,6 +23,7 @@
 #ifndef MESH_SMOOTHING_H
 #define MESH_SMOOTHING_H
 
+#include <functional>
 #include <limits>
 #include <vector>
 
@@ -32,9 +33,9 @@
 namespace MeshCore
 {
 class MeshKernel;
-class MeshRefPointToPoints;
-class MeshRefPointToFacets;
-class MeshRefFacetToFacets;
+class MeshCompactPointToPoints;
+class MeshCompactPointToFacets;
+class MeshCompactFacetToFacets;
 
 /** Base class for smoothing algorithms. */
 class MeshExport AbstractSmoothing
@@ -107,12 +108,19 @@ public:
     }
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&, const MeshRefPointToFacets&, double);
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&,
+    void Umbrella(const MeshCompactPointToPoints&, const MeshCompactPointToFacets&, double);
+    void Umbrella(const MeshCompactPointToPoints&,
+                  const MeshCompactPointToFacets&,
                   double,
                   const std::vector<PointIndex>&);
 
+private:
+    void Umbrella(const MeshCompactPointToPoints&,
+                  const MeshCompactPointToFacets&,
+                  double,
+                  std::size_t,
+                  const std::function<PointIndex(std::size_t)>&);
+
 private:
     double lambda {0.6307};
 };
@@ -149,8 +157,8 @@ public:
     void SmoothPoints(unsigned int, const std::vector<PointIndex>&) override;
 
 private:
-    void UpdatePoints(const MeshRefFacetToFacets&,
-                      const MeshRefPointToFacets&,
+    void UpdatePoints(const MeshCompactFacetToFacets&,
+                      const MeshCompactPointToFacets&,
                       const std::vector<PointIndex>&);
 
 private:
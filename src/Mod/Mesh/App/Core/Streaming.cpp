@@ -0,0 +1,410 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <Base/Converter.h>
+
+#include "MeshIO.h"
+#include "Streaming.h"
+#include "TrimByPlane.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+constexpr std::streamoff stlHeaderSize = 84;
+constexpr std::streamoff stlFacetSize = 50;
+
+bool isKeyword(const std::string& token, const char* keyword)
+{
+    if (token.size() != std::strlen(keyword)) {
+        return false;
+    }
+    return std::equal(token.begin(), token.end(), keyword, [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == b;
+    });
+}
+
+bool readVector(std::istream& input, Base::Vector3f& vec)
+{
+    return static_cast<bool>(input >> vec.x >> vec.y >> vec.z);
+}
+}  // namespace
+
+MeshStreamReader::MeshStreamReader(std::istream& input)
+    : input(input)
+{}
+
+bool MeshStreamReader::Open()
+{
+    if (!input || input.bad()) {
+        return false;
+    }
+
+    start = input.tellg();
+    std::streambuf* buf = input.rdbuf();
+    std::streamoff size = buf->pubseekoff(0, std::ios::end, std::ios::in) - start;
+    buf->pubseekoff(start, std::ios::beg, std::ios::in);
+
+    char header[stlHeaderSize] {};
+    input.read(header, stlHeaderSize);
+    if (input.gcount() == stlHeaderSize) {
+        std::memcpy(&numFacets, header + 80, sizeof(numFacets));
+    }
+
+    // An ASCII file starts with 'solid' but so do some binary files written by other tools.
+    // A binary file whose size matches the number of facets in its header is taken as such.
+    bool sizeMatches = size == stlHeaderSize + stlFacetSize * std::streamoff(numFacets);
+    std::string first(header, header + std::min<std::streamoff>(input.gcount(), 80));
+    first.erase(0, first.find_first_not_of(" \t\r\n"));
+    bool solid = isKeyword(first.substr(0, 5), "solid");
+
+    input.clear();
+    if (sizeMatches || (!solid && size >= stlHeaderSize)) {
+        binary = true;
+        if (size < stlHeaderSize + stlFacetSize * std::streamoff(numFacets)) {
+            return false;  // not a valid STL file
+        }
+    }
+    else if (solid) {
+        binary = false;
+    }
+    else {
+        return false;
+    }
+
+    return Rewind();
+}
+
+bool MeshStreamReader::Rewind()
+{
+    input.clear();
+    input.seekg(binary ? start + stlHeaderSize : start);
+    numRead = 0;
+    return !input.fail();
+}
+
+bool MeshStreamReader::Read(std::vector<MeshGeomFacet>& facets, std::size_t maxFacets)
+{
+    facets.clear();
+    if (maxFacets == 0) {
+        return false;
+    }
+    return binary ? ReadBinary(facets, maxFacets) : ReadAscii(facets, maxFacets);
+}
+
+bool MeshStreamReader::ReadBinary(std::vector<MeshGeomFacet>& facets, std::size_t maxFacets)
+{
+    std::size_t count = std::min<std::size_t>(maxFacets, numFacets - numRead);
+    std::vector<char> data(count * stlFacetSize);
+    input.read(data.data(), static_cast<std::streamsize>(data.size()));
+    count = static_cast<std::size_t>(input.gcount()) / stlFacetSize;
+
+    facets.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        float values[12];
+        std::memcpy(values, data.data() + i * stlFacetSize, sizeof(values));
+        MeshGeomFacet& facet = facets[i];
+        facet._aclPoints[0].Set(values[3], values[4], values[5]);
+        facet._aclPoints[1].Set(values[6], values[7], values[8]);
+        facet._aclPoints[2].Set(values[9], values[10], values[11]);
+        facet.SetNormal(Base::Vector3f(values[0], values[1], values[2]));
+    }
+
+    numRead += static_cast<uint32_t>(count);
+    return count > 0;
+}
+
+bool MeshStreamReader::ReadAscii(std::vector<MeshGeomFacet>& facets, std::size_t maxFacets)
+{
+    std::string token;
+    MeshGeomFacet facet;
+    Base::Vector3f normal;
+    int numPoints = 0;
+    while (facets.size() < maxFacets && input >> token) {
+        if (isKeyword(token, "normal")) {
+            if (!readVector(input, normal)) {
+                return false;
+            }
+        }
+        else if (isKeyword(token, "vertex")) {
+            if (!readVector(input, facet._aclPoints[numPoints++])) {
+                return false;
+            }
+            if (numPoints == 3) {
+                numPoints = 0;
+                facet.SetNormal(normal);
+                facets.push_back(facet);
+            }
+        }
+    }
+
+    numRead += static_cast<uint32_t>(facets.size());
+    return !facets.empty();
+}
+
+// ----------------------------------------------------------------------------
+
+MeshStreamWriter::MeshStreamWriter(std::ostream& output)
+    : output(output)
+{}
+
+bool MeshStreamWriter::Begin()
+{
+    if (!output || output.bad()) {
+        return false;
+    }
+
+    start = output.tellp();
+    numFacets = 0;
+
+    // stl_header has a length of 80
+    const std::string& header = MeshOutput::GetSTLHeaderData();
+    output.write(header.c_str(), 80);
+    output.write(reinterpret_cast<const char*>(&numFacets), sizeof(numFacets));
+    return !output.fail();
+}
+
+void MeshStreamWriter::Write(const std::vector<MeshGeomFacet>& facets)
+{
+    std::vector<char> data(facets.size() * stlFacetSize, 0);
+    char* ptr = data.data();
+    for (const auto& facet : facets) {
+        Base::Vector3f normal = facet.GetNormal();
+        float values[12] = {normal.x,
+                            normal.y,
+                            normal.z,
+                            facet._aclPoints[0].x,
+                            facet._aclPoints[0].y,
+                            facet._aclPoints[0].z,
+                            facet._aclPoints[1].x,
+                            facet._aclPoints[1].y,
+                            facet._aclPoints[1].z,
+                            facet._aclPoints[2].x,
+                            facet._aclPoints[2].y,
+                            facet._aclPoints[2].z};
+        // the attribute of two bytes stays zero
+        std::memcpy(ptr, values, sizeof(values));
+        ptr += stlFacetSize;
+    }
+
+    output.write(data.data(), static_cast<std::streamsize>(data.size()));
+    numFacets += static_cast<uint32_t>(facets.size());
+}
+
+bool MeshStreamWriter::Finish()
+{
+    std::streamoff end = output.tellp();
+    output.seekp(start + 80);
+    output.write(reinterpret_cast<const char*>(&numFacets), sizeof(numFacets));
+    output.seekp(end);
+    return !output.fail();
+}
+
+// ----------------------------------------------------------------------------
+
+namespace
+{
+/// Packs the 21 low bits of the cell coordinates of a point into one key
+class CellGrid
+{
+public:
+    explicit CellGrid(float size)
+        : size(size)
+    {}
+
+    uint64_t Key(const Base::Vector3f& pnt) const
+    {
+        return (Coord(pnt.x) << 42) | (Coord(pnt.y) << 21) | Coord(pnt.z);
+    }
+
+private:
+    uint64_t Coord(float value) const
+    {
+        constexpr int64_t offset = int64_t(1) << 20;
+        auto cell = static_cast<int64_t>(std::floor(value / size)) + offset;
+        return static_cast<uint64_t>(std::clamp<int64_t>(cell, 0, 2 * offset - 1));
+    }
+
+private:
+    float size;
+};
+
+struct CellPoint
+{
+    Base::Vector3d sum;
+    uint32_t count = 0;
+};
+
+struct CellTriangleHash
+{
+    std::size_t operator()(const std::array<uint64_t, 3>& key) const
+    {
+        std::hash<uint64_t> hasher;
+        std::size_t seed = hasher(key[0]);
+        seed ^= hasher(key[1]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed ^= hasher(key[2]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+};
+}  // namespace
+
+void MeshStreamProcessor::SetTransform(const Base::Matrix4D& mat)
+{
+    transform = mat;
+    hasTransform = mat != Base::Matrix4D();
+}
+
+void MeshStreamProcessor::SetTrimPlane(const Base::Vector3f& base, const Base::Vector3f& normal)
+{
+    trimBase = base;
+    trimNormal = normal;
+    hasTrimPlane = true;
+}
+
+void MeshStreamProcessor::SetClusterSize(float size)
+{
+    clusterSize = std::max(size, 0.0F);
+}
+
+void MeshStreamProcessor::SetChunkSize(std::size_t size)
+{
+    chunkSize = std::max<std::size_t>(size, 1);
+}
+
+void MeshStreamProcessor::Prepare(std::vector<MeshGeomFacet>& facets) const
+{
+    if (hasTransform) {
+        for (auto& facet : facets) {
+            facet.Transform(transform);
+        }
+    }
+
+    if (hasTrimPlane) {
+        std::vector<MeshGeomFacet> kept;
+        kept.reserve(facets.size());
+        for (const auto& facet : facets) {
+            if (facet.IntersectWithPlane(trimBase, trimNormal)) {
+                MeshTrimByPlane::TrimFacet(facet, trimBase, trimNormal, kept);
+            }
+            else if (facet._aclPoints[0].DistanceToPlane(trimBase, trimNormal) <= 0.0F) {
+                kept.push_back(facet);
+            }
+        }
+        facets.swap(kept);
+    }
+}
+
+bool MeshStreamProcessor::Process(std::istream& input, std::ostream& output)
+{
+    numFacets = 0;
+    MeshStreamReader reader(input);
+    if (!reader.Open()) {
+        return false;
+    }
+
+    MeshStreamWriter writer(output);
+    if (!writer.Begin()) {
+        return false;
+    }
+
+    std::vector<MeshGeomFacet> facets;
+    if (clusterSize <= 0.0F) {
+        while (reader.Read(facets, chunkSize)) {
+            Prepare(facets);
+            writer.Write(facets);
+        }
+    }
+    else {
+        CellGrid grid(clusterSize);
+
+        // First pass: the mean of the points in each cell
+        std::unordered_map<uint64_t, CellPoint> cells;
+        while (reader.Read(facets, chunkSize)) {
+            Prepare(facets);
+            for (const auto& facet : facets) {
+                for (const auto& pnt : facet._aclPoints) {
+                    CellPoint& cell = cells[grid.Key(pnt)];
+                    cell.sum += Base::convertTo<Base::Vector3d>(pnt);
+                    cell.count++;
+                }
+            }
+        }
+
+        std::unordered_map<uint64_t, Base::Vector3f> points;
+        points.reserve(cells.size());
+        for (const auto& it : cells) {
+            points[it.first] =
+                Base::convertTo<Base::Vector3f>(it.second.sum / double(it.second.count));
+        }
+        cells.clear();
+
+        // Second pass: replace the points and drop degenerated and duplicated facets
+        if (!reader.Rewind()) {
+            return false;
+        }
+
+        std::unordered_set<std::array<uint64_t, 3>, CellTriangleHash> triangles;
+        std::vector<MeshGeomFacet> clustered;
+        while (reader.Read(facets, chunkSize)) {
+            Prepare(facets);
+            clustered.clear();
+            for (const auto& facet : facets) {
+                std::array<uint64_t, 3> keys = {grid.Key(facet._aclPoints[0]),
+                                                grid.Key(facet._aclPoints[1]),
+                                                grid.Key(facet._aclPoints[2])};
+                if (keys[0] == keys[1] || keys[1] == keys[2] || keys[2] == keys[0]) {
+                    continue;
+                }
+
+                std::array<uint64_t, 3> sorted = keys;
+                std::sort(sorted.begin(), sorted.end());
+                if (!triangles.insert(sorted).second) {
+                    continue;
+                }
+
+                MeshGeomFacet face;
+                for (int i = 0; i < 3; i++) {
+                    face._aclPoints[i] = points[keys[i]];
+                }
+                face.CalcNormal();
+                clustered.push_back(face);
+            }
+            writer.Write(clustered);
+        }
+    }
+
+    numFacets = writer.CountFacets();
+    return writer.Finish();
+}
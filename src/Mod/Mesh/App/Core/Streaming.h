@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#ifndef MESH_STREAMING_H
+#define MESH_STREAMING_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include <Base/Matrix.h>
+
+#include "Elements.h"
+
+
+namespace MeshCore
+{
+
+/**
+ * The MeshStreamReader class reads the facets of an STL file in chunks, so that files that
+ * don't fit into memory can be processed. No mesh kernel is built up and equal points of
+ * adjacent facets are not merged.
+ */
+class MeshExport MeshStreamReader
+{
+public:
+    explicit MeshStreamReader(std::istream& input);
+
+    /// Checks the header and decides whether the input is a binary or ASCII STL
+    bool Open();
+    /// Reads up to \a maxFacets facets into \a facets, returns false if there are none left
+    bool Read(std::vector<MeshGeomFacet>& facets, std::size_t maxFacets);
+    /// Continues with the first facet, for operations that need several passes
+    bool Rewind();
+    bool IsBinary() const
+    {
+        return binary;
+    }
+
+private:
+    bool ReadBinary(std::vector<MeshGeomFacet>& facets, std::size_t maxFacets);
+    bool ReadAscii(std::vector<MeshGeomFacet>& facets, std::size_t maxFacets);
+
+private:
+    std::istream& input;
+    std::streamoff start = 0;
+    uint32_t numFacets = 0;
+    uint32_t numRead = 0;
+    bool binary = false;
+};
+
+/**
+ * The MeshStreamWriter class writes facets to a binary STL as they come in. The number of
+ * facets in the header is set by Finish(), so the output must be seekable.
+ */
+class MeshExport MeshStreamWriter
+{
+public:
+    explicit MeshStreamWriter(std::ostream& output);
+
+    /// Writes the header with the data of MeshOutput::SetSTLHeaderData()
+    bool Begin();
+    void Write(const std::vector<MeshGeomFacet>& facets);
+    /// Sets the number of written facets in the header
+    bool Finish();
+    uint32_t CountFacets() const
+    {
+        return numFacets;
+    }
+
+private:
+    std::ostream& output;
+    std::streamoff start = 0;
+    uint32_t numFacets = 0;
+};
+
+/**
+ * The MeshStreamProcessor class applies a sequence of operations to an STL file chunk by
+ * chunk and writes the result to a binary STL. The memory needed depends on the chunk size
+ * and, when decimating, on the size of the result but not on the size of the input.
+ *
+ * The operations are applied in the order transform, trim and decimate. Decimation clusters
+ * the points in a regular grid of cubic cells, every cell is replaced by the mean of its
+ * points and facets collapsing to an edge or a point are removed. This needs two passes over
+ * the input, the first one computes the cell points.
+ */
+class MeshExport MeshStreamProcessor
+{
+public:
+    MeshStreamProcessor() = default;
+
+    void SetTransform(const Base::Matrix4D& mat);
+    /// Removes the parts of the mesh above the plane, like MeshTrimByPlane does
+    void SetTrimPlane(const Base::Vector3f& base, const Base::Vector3f& normal);
+    /// Sets the edge length of the clustering cells, 0 disables decimation
+    void SetClusterSize(float size);
+    /// Sets the number of facets held in memory at once
+    void SetChunkSize(std::size_t size);
+
+    /// Processes the STL \a input and writes the result as binary STL to \a output
+    bool Process(std::istream& input, std::ostream& output);
+    /// Returns the number of facets of the result
+    uint32_t CountFacets() const
+    {
+        return numFacets;
+    }
+
+private:
+    /// Applies transform and trim to a chunk
+    void Prepare(std::vector<MeshGeomFacet>& facets) const;
+
+private:
+    Base::Matrix4D transform;
+    Base::Vector3f trimBase;
+    Base::Vector3f trimNormal;
+    std::size_t chunkSize = 1000000;
+    float clusterSize = 0.0F;
+    uint32_t numFacets = 0;
+    bool hasTransform = false;
+    bool hasTrimPlane = false;
+};
+
+}  // namespace MeshCore
+
+#endif  // MESH_STREAMING_H
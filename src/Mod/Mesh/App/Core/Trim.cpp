@@ -24,8 +24,7 @@
 #include <cmath>
 
 
-#include <Base/Sequencer.h>
-
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "Trim.h"
@@ -33,6 +32,37 @@
 
 using namespace MeshCore;
 
+namespace
+{
+
+// Calls func(index, result) for all indices of [0, count) in blocks on several threads, the
+// results of the blocks are then appended to \a result in the order of the indices
+template<class T, class Func>
+void forEachBlock(std::size_t count, std::vector<T>& result, const Func& func)
+{
+    constexpr std::size_t blockSize = 1024;
+    std::vector<std::vector<T>> blocks((count + blockSize - 1) / blockSize);
+    parallel_for(blocks.size(), 4, [&](std::size_t first, std::size_t last) {
+        for (std::size_t block = first; block < last; block++) {
+            std::size_t end = std::min(count, (block + 1) * blockSize);
+            for (std::size_t i = block * blockSize; i < end; i++) {
+                func(i, blocks[block]);
+            }
+        }
+    });
+
+    std::size_t size = result.size();
+    for (const auto& it : blocks) {
+        size += it.size();
+    }
+    result.reserve(size);
+    for (const auto& it : blocks) {
+        result.insert(result.end(), it.begin(), it.end());
+    }
+}
+
+}  // namespace
+
 MeshTrimming::MeshTrimming(MeshKernel& mesh,
                            const Base::ViewProjMethod* proj,
                            const Base::Polygon2d& poly)
@@ -56,9 +86,6 @@ void MeshTrimming::SetInnerOrOuter(TMode tMode)
 void MeshTrimming::CheckFacets(const MeshFacetGrid& rclGrid,
                                std::vector<FacetIndex>& raulFacets) const
 {
-    std::vector<FacetIndex>::iterator it;
-    MeshFacetIterator clIter(myMesh, 0);
-
     // cut inner: use grid to accelerate search
     if (myInner) {
         Base::BoundBox3f clBBox3d;
@@ -83,25 +110,23 @@ void MeshTrimming::CheckFacets(const MeshFacetGrid& rclGrid,
         aulAllElements.erase(std::unique(aulAllElements.begin(), aulAllElements.end()),
                              aulAllElements.end());
 
-        Base::SequencerLauncher seq("Check facets for intersection...", aulAllElements.size());
-
-        for (it = aulAllElements.begin(); it != aulAllElements.end(); ++it) {
-            MeshGeomFacet clFacet = myMesh.GetFacet(*it);
-            if (HasIntersection(clFacet)) {
-                raulFacets.push_back(*it);
-            }
-            seq.next();
-        }
+        forEachBlock(aulAllElements.size(),
+                     raulFacets,
+                     [&](std::size_t index, std::vector<FacetIndex>& facets) {
+                         if (HasIntersection(myMesh.GetFacet(aulAllElements[index]))) {
+                             facets.push_back(aulAllElements[index]);
+                         }
+                     });
     }
     // cut outer
     else {
-        Base::SequencerLauncher seq("Check facets for intersection...", myMesh.CountFacets());
-        for (clIter.Init(); clIter.More(); clIter.Next()) {
-            if (HasIntersection(*clIter)) {
-                raulFacets.push_back(clIter.Position());
-            }
-            seq.next();
-        }
+        forEachBlock(myMesh.CountFacets(),
+                     raulFacets,
+                     [&](std::size_t index, std::vector<FacetIndex>& facets) {
+                         if (HasIntersection(myMesh.GetFacet(index))) {
+                             facets.push_back(index);
+                         }
+                     });
     }
 }
 
@@ -160,7 +185,7 @@ bool MeshTrimming::PolygonContainsCompleteFacet(bool bInner, FacetIndex ulIndex)
     return true;
 }
 
-bool MeshTrimming::IsPolygonPointInFacet(FacetIndex ulIndex, Base::Vector3f& clPoint)
+bool MeshTrimming::IsPolygonPointInFacet(FacetIndex ulIndex, Base::Vector3f& clPoint) const
 {
     Base::Vector2d A, B, C, P;
     float u {}, v {}, w {}, fDetPAC {}, fDetPBC {}, fDetPAB {}, fDetABC {};
@@ -770,31 +795,32 @@ bool MeshTrimming::CreateFacets(FacetIndex ulFacetPos,
 void MeshTrimming::TrimFacets(const std::vector<FacetIndex>& raulFacets,
                               std::vector<MeshGeomFacet>& aclNewFacets)
 {
-    Base::Vector3f clP;
-    std::vector<Base::Vector3f> clIntsct;
-    int iSide {};
-
-    Base::SequencerLauncher seq("trimming facets...", raulFacets.size());
-    for (FacetIndex index : raulFacets) {
-        clIntsct.clear();
-        if (!IsPolygonPointInFacet(index, clP)) {
-            // facet must be trimmed
-            if (!PolygonContainsCompleteFacet(myInner, index)) {
-                // generate new facets
-                if (GetIntersectionPointsOfPolygonAndFacet(index, iSide, clIntsct)) {
-                    CreateFacets(index, iSide, clIntsct, myTriangles);
-                }
-            }
-        }
-        // facet contains a polygon point
-        else {
-            // generate new facets
-            if (GetIntersectionPointsOfPolygonAndFacet(index, iSide, clIntsct)) {
-                CreateFacets(index, iSide, clIntsct, clP, myTriangles);
-            }
-        }
-        seq.next();
-    }
+    // A facet is only rotated by the facet that is trimmed, so the facets can be handled on
+    // several threads
+    forEachBlock(raulFacets.size(),
+                 myTriangles,
+                 [&](std::size_t pos, std::vector<MeshGeomFacet>& triangles) {
+                     FacetIndex index = raulFacets[pos];
+                     Base::Vector3f clP;
+                     std::vector<Base::Vector3f> clIntsct;
+                     int iSide {};
+                     if (!IsPolygonPointInFacet(index, clP)) {
+                         // facet must be trimmed
+                         if (!PolygonContainsCompleteFacet(myInner, index)) {
+                             // generate new facets
+                             if (GetIntersectionPointsOfPolygonAndFacet(index, iSide, clIntsct)) {
+                                 CreateFacets(index, iSide, clIntsct, triangles);
+                             }
+                         }
+                     }
+                     // facet contains a polygon point
+                     else {
+                         // generate new facets
+                         if (GetIntersectionPointsOfPolygonAndFacet(index, iSide, clIntsct)) {
+                             CreateFacets(index, iSide, clIntsct, clP, triangles);
+                         }
+                     }
+                 });
 
     aclNewFacets = myTriangles;
 }
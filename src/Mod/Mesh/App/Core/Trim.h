@@ -48,14 +48,15 @@ public:
 
 public:
     /**
-     * Checks all facets for intersection with the polygon and writes all touched facets into the
-     * vector
+     * Checks all facets for intersection with the polygon on several threads and writes all
+     * touched facets into the vector
      */
     void CheckFacets(const MeshFacetGrid& rclGrid, std::vector<FacetIndex>& raulFacets) const;
 
     /**
      * The facets from raulFacets will be trimmed or deleted and aclNewFacets gives the new
-     * generated facets
+     * generated facets. The facets are handled on several threads, so every index must occur
+     * only once in raulFacets.
      */
     void TrimFacets(const std::vector<FacetIndex>& raulFacets,
                     std::vector<MeshGeomFacet>& aclNewFacets);
@@ -96,7 +97,7 @@ private:
     /**
      * Checks if a polygon point lies within a facet
      */
-    bool IsPolygonPointInFacet(FacetIndex ulIndex, Base::Vector3f& clPoint);
+    bool IsPolygonPointInFacet(FacetIndex ulIndex, Base::Vector3f& clPoint) const;
 
     /**
      * Calculates the two intersection points between polygonline and facet in 2D
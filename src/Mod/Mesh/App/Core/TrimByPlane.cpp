@@ -21,8 +21,10 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <array>
 
 
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "TrimByPlane.h"
@@ -83,7 +85,7 @@ void MeshTrimByPlane::CreateOneFacet(const Base::Vector3f& base,
                                      const Base::Vector3f& normal,
                                      unsigned short shift,
                                      const MeshGeomFacet& facet,
-                                     std::vector<MeshGeomFacet>& trimmedFacets) const
+                                     std::vector<MeshGeomFacet>& trimmedFacets)
 {
     unsigned short nul = shift % 3;
     unsigned short one = (shift + 1) % 3;
@@ -111,7 +113,7 @@ void MeshTrimByPlane::CreateTwoFacet(const Base::Vector3f& base,
                                      const Base::Vector3f& normal,
                                      unsigned short shift,
                                      const MeshGeomFacet& facet,
-                                     std::vector<MeshGeomFacet>& trimmedFacets) const
+                                     std::vector<MeshGeomFacet>& trimmedFacets)
 {
     unsigned short nul = shift % 3;
     unsigned short one = (shift + 1) % 3;
@@ -147,30 +149,270 @@ void MeshTrimByPlane::TrimFacets(const std::vector<FacetIndex>& trimFacets,
 {
     trimmedFacets.reserve(2 * trimFacets.size());
     for (FacetIndex index : trimFacets) {
-        MeshGeomFacet facet = myMesh.GetFacet(index);
-        float dist1 = facet._aclPoints[0].DistanceToPlane(base, normal);
-        float dist2 = facet._aclPoints[1].DistanceToPlane(base, normal);
-        float dist3 = facet._aclPoints[2].DistanceToPlane(base, normal);
-
-        // only one point below
-        if (dist1 < 0.0F && dist2 > 0.0F && dist3 > 0.0F) {
-            CreateOneFacet(base, normal, 0, facet, trimmedFacets);
+        TrimFacet(myMesh.GetFacet(index), base, normal, trimmedFacets);
+    }
+}
+
+void MeshTrimByPlane::TrimFacet(const MeshGeomFacet& facet,
+                                const Base::Vector3f& base,
+                                const Base::Vector3f& normal,
+                                std::vector<MeshGeomFacet>& trimmedFacets)
+{
+    float dist1 = facet._aclPoints[0].DistanceToPlane(base, normal);
+    float dist2 = facet._aclPoints[1].DistanceToPlane(base, normal);
+    float dist3 = facet._aclPoints[2].DistanceToPlane(base, normal);
+
+    // only one point below
+    if (dist1 < 0.0F && dist2 > 0.0F && dist3 > 0.0F) {
+        CreateOneFacet(base, normal, 0, facet, trimmedFacets);
+    }
+    else if (dist1 > 0.0F && dist2 < 0.0F && dist3 > 0.0F) {
+        CreateOneFacet(base, normal, 1, facet, trimmedFacets);
+    }
+    else if (dist1 > 0.0F && dist2 > 0.0F && dist3 < 0.0F) {
+        CreateOneFacet(base, normal, 2, facet, trimmedFacets);
+    }
+    // two points below
+    else if (dist1 < 0.0F && dist2 < 0.0F && dist3 > 0.0F) {
+        CreateTwoFacet(base, normal, 0, facet, trimmedFacets);
+    }
+    else if (dist1 > 0.0F && dist2 < 0.0F && dist3 < 0.0F) {
+        CreateTwoFacet(base, normal, 1, facet, trimmedFacets);
+    }
+    else if (dist1 < 0.0F && dist2 > 0.0F && dist3 < 0.0F) {
+        CreateTwoFacet(base, normal, 2, facet, trimmedFacets);
+    }
+}
+
+void MeshTrimByPlane::Trim(const Base::Vector3f& base,
+                           const Base::Vector3f& normal,
+                           std::vector<FacetIndex>& removedFacets)
+{
+    enum : unsigned char
+    {
+        Keep,
+        Remove,
+        Split
+    };
+    using Edge = std::pair<PointIndex, PointIndex>;
+
+    const MeshPointArray& points = myMesh.GetPoints();
+    const MeshFacetArray& facets = myMesh.GetFacets();
+    const std::size_t numPoints = points.size();
+    const std::size_t numFacets = facets.size();
+
+    // points on the plane belong to the kept part
+    std::vector<float> dists(numPoints);
+    parallel_for(numPoints, 10000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            dists[i] = points[i].DistanceToPlane(base, normal);
         }
-        else if (dist1 > 0.0F && dist2 < 0.0F && dist3 > 0.0F) {
-            CreateOneFacet(base, normal, 1, facet, trimmedFacets);
+    });
+    auto crosses = [&dists](PointIndex p, PointIndex q) {
+        return (dists[p] < 0.0F && dists[q] > 0.0F) || (dists[p] > 0.0F && dists[q] < 0.0F);
+    };
+
+    // Classify the facets in blocks and collect the edges crossing the plane. Each block
+    // counts its output facets so that the blocks can fill the new arrays independently.
+    constexpr std::size_t blockSize = 4096;
+    const std::size_t numBlocks = (numFacets + blockSize - 1) / blockSize;
+    std::vector<unsigned char> states(numFacets);
+    std::vector<unsigned char> counts(numFacets);
+    std::vector<std::vector<Edge>> blockEdges(numBlocks);
+    std::vector<std::size_t> blockKept(numBlocks + 1);
+    std::vector<std::size_t> blockSplit(numBlocks + 1);
+    parallel_for(numBlocks, 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t block = first; block < last; block++) {
+            std::size_t end = std::min(numFacets, (block + 1) * blockSize);
+            for (std::size_t i = block * blockSize; i < end; i++) {
+                const MeshFacet& facet = facets[i];
+                int below = 0;
+                int above = 0;
+                int crossing = 0;
+                for (int j = 0; j < 3; j++) {
+                    PointIndex p = facet._aulPoints[j];
+                    PointIndex q = facet._aulPoints[(j + 1) % 3];
+                    below += dists[p] <= 0.0F ? 1 : 0;
+                    above += dists[p] > 0.0F ? 1 : 0;
+                    if (crosses(p, q)) {
+                        crossing++;
+                        blockEdges[block].emplace_back(std::min(p, q), std::max(p, q));
+                    }
+                }
+
+                if (above == 0) {
+                    states[i] = Keep;
+                    counts[i] = 1;
+                    blockKept[block + 1]++;
+                }
+                else if (crossing == 0) {
+                    // no point below the plane, the remaining ones lie on it
+                    states[i] = Remove;
+                    counts[i] = 0;
+                }
+                else {
+                    // the clipped polygon has the points below and the crossing points
+                    states[i] = Split;
+                    counts[i] = static_cast<unsigned char>(below + crossing - 2);
+                    blockSplit[block + 1] += counts[i];
+                }
+            }
+        }
+    });
+
+    // Every crossing edge gets one new point. The sorted table maps an edge to its point, so
+    // that both facets of an edge use the same point without any locking.
+    std::vector<Edge> edges;
+    for (auto& it : blockEdges) {
+        edges.insert(edges.end(), it.begin(), it.end());
+        std::vector<Edge>().swap(it);
+    }
+    parallel_sort(edges.begin(), edges.end(), std::less<>(), MeshDefinitions::GetMaxThreadCount());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    // keep the points that are still used
+    std::vector<PointIndex> pointMap(numPoints, POINT_INDEX_MAX);
+    for (std::size_t i = 0; i < numFacets; i++) {
+        if (states[i] != Remove) {
+            for (PointIndex p : facets[i]._aulPoints) {
+                if (dists[p] <= 0.0F) {
+                    pointMap[p] = 0;
+                }
+            }
+        }
+    }
+    MeshPointArray newPoints;
+    std::size_t numKeptPoints = std::count(pointMap.begin(), pointMap.end(), PointIndex(0));
+    newPoints.reserve(numKeptPoints + edges.size());
+    for (std::size_t i = 0; i < numPoints; i++) {
+        if (pointMap[i] == 0) {
+            pointMap[i] = newPoints.size();
+            newPoints.push_back(points[i]);
         }
-        else if (dist1 > 0.0F && dist2 > 0.0F && dist3 < 0.0F) {
-            CreateOneFacet(base, normal, 2, facet, trimmedFacets);
+    }
+    newPoints.resize(numKeptPoints + edges.size());
+    parallel_for(edges.size(), 10000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const Base::Vector3f& p = points[edges[i].first];
+            const Base::Vector3f& q = points[edges[i].second];
+            float dp = dists[edges[i].first];
+            float dq = dists[edges[i].second];
+            newPoints[numKeptPoints + i] = MeshPoint(p + (q - p) * (dp / (dp - dq)));
         }
-        // two points below
-        else if (dist1 < 0.0F && dist2 < 0.0F && dist3 > 0.0F) {
-            CreateTwoFacet(base, normal, 0, facet, trimmedFacets);
+    });
+    auto cutPoint = [&](PointIndex p, PointIndex q) {
+        Edge edge(std::min(p, q), std::max(p, q));
+        auto it = std::lower_bound(edges.begin(), edges.end(), edge);
+        return PointIndex(numKeptPoints + (it - edges.begin()));
+    };
+
+    // the kept facets come first in their order, then the facets of the split ones
+    for (std::size_t block = 0; block < numBlocks; block++) {
+        blockKept[block + 1] += blockKept[block];
+        blockSplit[block + 1] += blockSplit[block];
+    }
+    const std::size_t numKeptFacets = blockKept[numBlocks];
+    std::vector<FacetIndex> firsts(numFacets);
+    MeshFacetArray newFacets(numKeptFacets + blockSplit[numBlocks]);
+    parallel_for(numBlocks, 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t block = first; block < last; block++) {
+            std::size_t kept = blockKept[block];
+            std::size_t split = numKeptFacets + blockSplit[block];
+            std::size_t end = std::min(numFacets, (block + 1) * blockSize);
+            for (std::size_t i = block * blockSize; i < end; i++) {
+                const MeshFacet& facet = facets[i];
+                if (states[i] == Keep) {
+                    firsts[i] = kept;
+                    MeshFacet& newFacet = newFacets[kept++];
+                    newFacet = facet;
+                    for (int j = 0; j < 3; j++) {
+                        newFacet._aulPoints[j] = pointMap[facet._aulPoints[j]];
+                    }
+                }
+                else if (states[i] == Split) {
+                    firsts[i] = split;
+                    // clip the facet against the plane, this keeps its orientation
+                    std::array<PointIndex, 4> polygon {};
+                    int size = 0;
+                    for (int j = 0; j < 3; j++) {
+                        PointIndex p = facet._aulPoints[j];
+                        PointIndex q = facet._aulPoints[(j + 1) % 3];
+                        if (dists[p] <= 0.0F) {
+                            polygon[size++] = pointMap[p];
+                        }
+                        if (crosses(p, q)) {
+                            polygon[size++] = cutPoint(p, q);
+                        }
+                    }
+                    for (int j = 1; j + 1 < size; j++) {
+                        MeshFacet& newFacet = newFacets[split++];
+                        newFacet._aulPoints[0] = polygon[0];
+                        newFacet._aulPoints[1] = polygon[j];
+                        newFacet._aulPoints[2] = polygon[j + 1];
+                    }
+                }
+            }
         }
-        else if (dist1 > 0.0F && dist2 < 0.0F && dist3 < 0.0F) {
-            CreateTwoFacet(base, normal, 1, facet, trimmedFacets);
+    });
+
+    // A new facet can only be adjacent to a facet from the same or a neighbouring original
+    // facet, so the neighbourhood is looked up locally instead of being rebuilt.
+    parallel_for(numFacets, 10000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& facet = facets[i];
+            if (states[i] == Keep) {
+                bool simple = true;
+                for (FacetIndex n : facet._aulNeighbours) {
+                    simple = simple && (n >= numFacets || states[n] != Split);
+                }
+                if (simple) {
+                    // the quick way if no neighbour was split
+                    MeshFacet& newFacet = newFacets[firsts[i]];
+                    for (int j = 0; j < 3; j++) {
+                        FacetIndex n = facet._aulNeighbours[j];
+                        newFacet._aulNeighbours[j] =
+                            n < numFacets && states[n] == Keep ? firsts[n] : FACET_INDEX_MAX;
+                    }
+                    continue;
+                }
+            }
+
+            for (FacetIndex t = firsts[i]; t < firsts[i] + counts[i]; t++) {
+                MeshFacet& newFacet = newFacets[t];
+                for (int j = 0; j < 3; j++) {
+                    PointIndex p = newFacet._aulPoints[j];
+                    PointIndex q = newFacet._aulPoints[(j + 1) % 3];
+                    auto findEdge = [&](FacetIndex orig) {
+                        for (FacetIndex c = firsts[orig]; c < firsts[orig] + counts[orig]; c++) {
+                            const auto& other = newFacets[c]._aulPoints;
+                            for (int k = 0; c != t && k < 3; k++) {
+                                if (other[k] == q && other[(k + 1) % 3] == p) {
+                                    return c;
+                                }
+                            }
+                        }
+                        return FACET_INDEX_MAX;
+                    };
+
+                    FacetIndex neighbour = findEdge(FacetIndex(i));
+                    for (FacetIndex n : facet._aulNeighbours) {
+                        if (neighbour == FACET_INDEX_MAX && n < numFacets) {
+                            neighbour = findEdge(n);
+                        }
+                    }
+                    newFacet._aulNeighbours[j] = neighbour;
+                }
+            }
         }
-        else if (dist1 < 0.0F && dist2 > 0.0F && dist3 < 0.0F) {
-            CreateTwoFacet(base, normal, 2, facet, trimmedFacets);
+    });
+
+    removedFacets.clear();
+    removedFacets.reserve(numFacets - numKeptFacets);
+    for (std::size_t i = 0; i < numFacets; i++) {
+        if (states[i] != Keep) {
+            removedFacets.push_back(i);
         }
     }
+
+    myMesh.Adopt(newPoints, newFacets, false);
 }
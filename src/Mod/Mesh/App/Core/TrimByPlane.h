@@ -58,17 +58,38 @@ public:
                     const Base::Vector3f& normal,
                     std::vector<MeshGeomFacet>& trimmedFacets);
 
+    /**
+     * Appends the part of \a facet below the plane to \a trimmedFacets if the facet
+     * intersects the plane
+     */
+    static void TrimFacet(const MeshGeomFacet& facet,
+                          const Base::Vector3f& base,
+                          const Base::Vector3f& normal,
+                          std::vector<MeshGeomFacet>& trimmedFacets);
+
+    /**
+     * Removes the part of the mesh above the plane in one go on several threads. Unlike
+     * CheckFacets() and TrimFacets() the split facets stay connected to the rest of the mesh:
+     * every edge crossing the plane gets exactly one new point that both facets of the edge
+     * share, and the neighbourhood is only updated around the split facets.
+     * The kept facets stay in their order and the facets of the split ones are appended.
+     *  removedFacets gets the sorted indices of the removed and split facets.
+     */
+    void Trim(const Base::Vector3f& base,
+              const Base::Vector3f& normal,
+              std::vector<FacetIndex>& removedFacets);
+
 private:
-    void CreateOneFacet(const Base::Vector3f& base,
-                        const Base::Vector3f& normal,
-                        unsigned short shift,
-                        const MeshGeomFacet& facet,
-                        std::vector<MeshGeomFacet>& trimmedFacets) const;
-    void CreateTwoFacet(const Base::Vector3f& base,
-                        const Base::Vector3f& normal,
-                        unsigned short shift,
-                        const MeshGeomFacet& facet,
-                        std::vector<MeshGeomFacet>& trimmedFacets) const;
+    static void CreateOneFacet(const Base::Vector3f& base,
+                               const Base::Vector3f& normal,
+                               unsigned short shift,
+                               const MeshGeomFacet& facet,
+                               std::vector<MeshGeomFacet>& trimmedFacets);
+    static void CreateTwoFacet(const Base::Vector3f& base,
+                               const Base::Vector3f& normal,
+                               unsigned short shift,
+                               const MeshGeomFacet& facet,
+                               std::vector<MeshGeomFacet>& trimmedFacets);
 
 private:
     MeshKernel& myMesh;
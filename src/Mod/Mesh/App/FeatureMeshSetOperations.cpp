@@ -21,6 +21,9 @@
  ***************************************************************************/
 
 
+#include <Base/Console.h>
+
+#include "Core/Boolean.h"
 #include "Core/Iterator.h"
 #include "Core/SetOperations.h"
 
@@ -30,6 +33,8 @@
 using namespace Mesh;
 using namespace std;
 
+const char* SetOperations::AlgorithmEnums[] = {"Standard", "Robust", nullptr};
+
 PROPERTY_SOURCE(Mesh::SetOperations, Mesh::Feature)
 
 
@@ -38,6 +43,12 @@ SetOperations::SetOperations()
     ADD_PROPERTY(Source1, (nullptr));
     ADD_PROPERTY(Source2, (nullptr));
     ADD_PROPERTY(OperationType, ("union"));
+    ADD_PROPERTY_TYPE(Algorithm,
+                      (long(0)),
+                      "Mesh",
+                      App::Prop_None,
+                      "Robust uses exact predicates and multiple threads but requires closed meshes");
+    Algorithm.setEnums(AlgorithmEnums);
 }
 
 short SetOperations::mustExecute() const
@@ -52,6 +63,9 @@ short SetOperations::mustExecute() const
         if (OperationType.isTouched()) {
             return 1;
         }
+        if (Algorithm.isTouched()) {
+            return 1;
+        }
     }
 
     return 0;
@@ -90,12 +104,24 @@ App::DocumentObjectExecReturn* SetOperations::execute()
                                    " or 'difference' or 'inner' or 'outer'");
         }
 
-        MeshCore::SetOperations setOp(meshKernel1.getKernel(),
-                                      meshKernel2.getKernel(),
-                                      pcKernel->getKernel(),
-                                      type,
-                                      1.0e-5F);
-        setOp.Do();
+        if (Algorithm.getValue() == 1) {
+            MeshCore::MeshBoolean boolean(meshKernel1.getKernel(),
+                                          meshKernel2.getKernel(),
+                                          pcKernel->getKernel(),
+                                          type);
+            if (!boolean.Do()) {
+                Base::Console().warning("%s: Degenerate intersections were skipped\n",
+                                        getNameInDocument());
+            }
+        }
+        else {
+            MeshCore::SetOperations setOp(meshKernel1.getKernel(),
+                                          meshKernel2.getKernel(),
+                                          pcKernel->getKernel(),
+                                          type,
+                                          1.0e-5F);
+            setOp.Do();
+        }
         Mesh.setValuePtr(pcKernel.release());
     }
     else {
@@ -36,6 +36,7 @@
 #include <Base/ViewProj.h>
 #include <Base/Writer.h>
 
+#include "Core/BVH.h"
 #include "Core/Builder.h"
 #include "Core/Decimation.h"
 #include "Core/Degeneration.h"
@@ -217,6 +218,7 @@ MeshObject& MeshObject::operator=(const MeshObject& mesh)
 {
     if (this != &mesh) {
         // copy the mesh structure
+        invalidateFacetBVH();
         setTransform(mesh._Mtrx);
         this->_kernel = mesh._kernel;
         copySegments(mesh);
@@ -229,6 +231,7 @@ MeshObject& MeshObject::operator=(MeshObject&& mesh)
 {
     if (this != &mesh) {
         // copy the mesh structure
+        invalidateFacetBVH();
         setTransform(mesh._Mtrx);
         this->_kernel = mesh._kernel;
         copySegments(mesh);
@@ -239,12 +242,14 @@ MeshObject& MeshObject::operator=(MeshObject&& mesh)
 
 void MeshObject::setKernel(const MeshCore::MeshKernel& m)
 {
+    invalidateFacetBVH();
     this->_kernel = m;
     this->_segments.clear();
 }
 
 void MeshObject::swap(MeshCore::MeshKernel& Kernel)
 {
+    invalidateFacetBVH();
     this->_kernel.Swap(Kernel);
     // clear the segments because we don't know how the new
     // topology looks like
@@ -253,6 +258,8 @@ void MeshObject::swap(MeshCore::MeshKernel& Kernel)
 
 void MeshObject::swap(MeshObject& mesh)
 {
+    invalidateFacetBVH();
+    mesh.invalidateFacetBVH();
     this->_kernel.Swap(mesh._kernel);
     swapSegments(mesh);
     Base::Matrix4D tmp = this->_Mtrx;
@@ -474,6 +481,7 @@ bool MeshObject::load(std::istream& str, MeshCore::MeshIO::Format f, MeshCore::M
 
 void MeshObject::swapKernel(MeshCore::MeshKernel& kernel, const std::vector<std::string>& g)
 {
+    invalidateFacetBVH();
     _kernel.Swap(kernel);
     // Some file formats define several objects per file (e.g. OBJ).
     // Now we mark each object as an own segment so that we can break
@@ -517,8 +525,13 @@ void MeshObject::save(std::ostream& out) const
 
 void MeshObject::load(std::istream& in)
 {
-    _kernel.Read(in);
+    invalidateFacetBVH();
+    bool consistent = _kernel.Read(in);
     this->_segments.clear();
+    if (consistent) {
+        // the neighbourhood was stored with the mesh
+        return;
+    }
 
 #ifndef FC_DEBUG
     try {
@@ -571,16 +584,19 @@ void MeshObject::writeInventor(std::ostream& str, float creaseangle) const
 
 void MeshObject::addFacet(const MeshCore::MeshGeomFacet& facet)
 {
+    invalidateFacetBVH();
     _kernel.AddFacet(facet);
 }
 
 void MeshObject::addFacets(const std::vector<MeshCore::MeshGeomFacet>& facets)
 {
+    invalidateFacetBVH();
     _kernel.AddFacets(facets);
 }
 
 void MeshObject::addFacets(const std::vector<MeshCore::MeshFacet>& facets, bool checkManifolds)
 {
+    invalidateFacetBVH();
     _kernel.AddFacets(facets, checkManifolds);
 }
 
@@ -588,6 +604,7 @@ void MeshObject::addFacets(const std::vector<MeshCore::MeshFacet>& facets,
                            const std::vector<Base::Vector3f>& points,
                            bool checkManifolds)
 {
+    invalidateFacetBVH();
     _kernel.AddFacets(facets, points, checkManifolds);
 }
 
@@ -595,6 +612,7 @@ void MeshObject::addFacets(const std::vector<Data::ComplexGeoData::Facet>& facet
                            const std::vector<Base::Vector3d>& points,
                            bool checkManifolds)
 {
+    invalidateFacetBVH();
     std::vector<MeshCore::MeshFacet> facet_v;
     facet_v.reserve(facets.size());
     for (auto facet : facets) {
@@ -617,12 +635,14 @@ void MeshObject::addFacets(const std::vector<Data::ComplexGeoData::Facet>& facet
 
 void MeshObject::setFacets(const std::vector<MeshCore::MeshGeomFacet>& facets)
 {
+    invalidateFacetBVH();
     _kernel = facets;
 }
 
 void MeshObject::setFacets(const std::vector<Data::ComplexGeoData::Facet>& facets,
                            const std::vector<Base::Vector3d>& points)
 {
+    invalidateFacetBVH();
     MeshCore::MeshFacetArray facet_v;
     facet_v.reserve(facets.size());
     for (auto facet : facets) {
@@ -645,16 +665,19 @@ void MeshObject::setFacets(const std::vector<Data::ComplexGeoData::Facet>& facet
 
 void MeshObject::addMesh(const MeshObject& mesh)
 {
+    invalidateFacetBVH();
     _kernel.Merge(mesh._kernel);
 }
 
 void MeshObject::addMesh(const MeshCore::MeshKernel& kernel)
 {
+    invalidateFacetBVH();
     _kernel.Merge(kernel);
 }
 
 void MeshObject::deleteFacets(const std::vector<FacetIndex>& removeIndices)
 {
+    invalidateFacetBVH();
     if (removeIndices.empty()) {
         return;
     }
@@ -664,6 +687,7 @@ void MeshObject::deleteFacets(const std::vector<FacetIndex>& removeIndices)
 
 void MeshObject::deletePoints(const std::vector<PointIndex>& removeIndices)
 {
+    invalidateFacetBVH();
     if (removeIndices.empty()) {
         return;
     }
@@ -673,6 +697,7 @@ void MeshObject::deletePoints(const std::vector<PointIndex>& removeIndices)
 
 void MeshObject::deletedFacets(const std::vector<FacetIndex>& remFacets)
 {
+    invalidateFacetBVH();
     if (remFacets.empty()) {
         return;  // nothing has changed
     }
@@ -713,6 +738,7 @@ void MeshObject::deletedFacets(const std::vector<FacetIndex>& remFacets)
 
 void MeshObject::deleteSelectedFacets()
 {
+    invalidateFacetBVH();
     std::vector<FacetIndex> facets;
     MeshCore::MeshAlgorithm(this->_kernel).GetFacetsFlag(facets, MeshCore::MeshFacet::SELECTED);
     deleteFacets(facets);
@@ -720,6 +746,7 @@ void MeshObject::deleteSelectedFacets()
 
 void MeshObject::deleteSelectedPoints()
 {
+    invalidateFacetBVH();
     std::vector<PointIndex> points;
     MeshCore::MeshAlgorithm(this->_kernel).GetPointsFlag(points, MeshCore::MeshPoint::SELECTED);
     deletePoints(points);
@@ -790,6 +817,21 @@ std::vector<PointIndex> MeshObject::getPointsFromFacets(const std::vector<FacetI
     return _kernel.GetFacetPoints(facets);
 }
 
+std::shared_ptr<const MeshCore::MeshFacetBVH> MeshObject::getFacetBVH() const
+{
+    std::lock_guard<std::mutex> lock(_bvhMutex);
+    if (!_bvh) {
+        _bvh = std::make_shared<MeshCore::MeshFacetBVH>(_kernel);
+    }
+    return _bvh;
+}
+
+void MeshObject::invalidateFacetBVH()
+{
+    std::lock_guard<std::mutex> lock(_bvhMutex);
+    _bvh.reset();
+}
+
 bool MeshObject::nearestFacetOnRay(const MeshObject::TRay& ray,
                                    double maxAngle,
                                    MeshObject::TFaceSection& output) const
@@ -806,9 +848,8 @@ bool MeshObject::nearestFacetOnRay(const MeshObject::TRay& ray,
 
     FacetIndex index = 0;
     Base::Vector3f res;
-    MeshCore::MeshAlgorithm alg(getKernel());
 
-    if (alg.NearestFacetOnRay(pnt, dir, static_cast<float>(maxAngle), res, index)) {
+    if (getFacetBVH()->NearestFacetOnRay(pnt, dir, static_cast<float>(maxAngle), res, index)) {
         plm.multVec(res, res);
         output.first = index;
         output.second = Base::toVector<double>(res);
@@ -890,6 +931,7 @@ unsigned long MeshObject::countComponents() const
 
 void MeshObject::removeComponents(unsigned long count)
 {
+    invalidateFacetBVH();
     std::vector<FacetIndex> removeIndices;
     MeshCore::MeshTopoAlgorithm(_kernel).FindComponents(count, removeIndices);
     _kernel.DeleteFacets(removeIndices);
@@ -927,6 +969,7 @@ void MeshObject::fillupHoles(unsigned long length,
                              int level,
                              MeshCore::AbstractPolygonTriangulator& cTria)
 {
+    invalidateFacetBVH();
     std::list<std::vector<PointIndex>> aFailed;
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.FillupHoles(length, level, cTria, aFailed);
@@ -934,6 +977,7 @@ void MeshObject::fillupHoles(unsigned long length,
 
 void MeshObject::offset(float fSize)
 {
+    invalidateFacetBVH();
     std::vector<Base::Vector3f> normals = _kernel.CalcVertexNormals();
 
     unsigned int i = 0;
@@ -947,6 +991,7 @@ void MeshObject::offset(float fSize)
 
 void MeshObject::offsetSpecial2(float fSize)
 {
+    invalidateFacetBVH();
     Base::Builder3D builder;
     std::vector<Base::Vector3f> PointNormals = _kernel.CalcVertexNormals();
     std::vector<Base::Vector3f> FaceNormals;
@@ -1013,6 +1058,7 @@ void MeshObject::offsetSpecial2(float fSize)
 
 void MeshObject::offsetSpecial(float fSize, float zmax, float zmin)
 {
+    invalidateFacetBVH();
     std::vector<Base::Vector3f> normals = _kernel.CalcVertexNormals();
 
     unsigned int i = 0;
@@ -1032,6 +1078,7 @@ void MeshObject::offsetSpecial(float fSize, float zmax, float zmin)
 
 void MeshObject::clear()
 {
+    invalidateFacetBVH();
     _kernel.Clear();
     this->_segments.clear();
     setTransform(Base::Matrix4D());
@@ -1039,6 +1086,7 @@ void MeshObject::clear()
 
 void MeshObject::transformToEigenSystem()
 {
+    invalidateFacetBVH();
     MeshCore::MeshEigensystem cMeshEval(_kernel);
     cMeshEval.Evaluate();
     this->setTransform(cMeshEval.Transform());
@@ -1055,6 +1103,7 @@ Base::Matrix4D MeshObject::getEigenSystem(Base::Vector3d& v) const
 
 void MeshObject::movePoint(PointIndex index, const Base::Vector3d& v)
 {
+    invalidateFacetBVH();
     // v is a vector, hence we must not apply the translation part
     // of the transformation to the vector
     Base::Vector3d vec(v);
@@ -1066,22 +1115,26 @@ void MeshObject::movePoint(PointIndex index, const Base::Vector3d& v)
 
 void MeshObject::setPoint(PointIndex index, const Base::Vector3d& p)
 {
+    invalidateFacetBVH();
     _kernel.SetPoint(index, transformPointToInside(p));
 }
 
 void MeshObject::smooth(int iterations, float d_max)
 {
+    invalidateFacetBVH();
     _kernel.Smooth(iterations, d_max);
 }
 
 void MeshObject::decimate(float fTolerance, float fReduction)
 {
+    invalidateFacetBVH();
     MeshCore::MeshSimplify dm(this->_kernel);
     dm.simplify(fTolerance, fReduction);
 }
 
 void MeshObject::decimate(int targetSize)
 {
+    invalidateFacetBVH();
     MeshCore::MeshSimplify dm(this->_kernel);
     dm.simplify(targetSize);
 }
@@ -1126,6 +1179,7 @@ void MeshObject::cut(const Base::Polygon2d& polygon2d,
                      const Base::ViewProjMethod& proj,
                      MeshObject::CutType type)
 {
+    invalidateFacetBVH();
     MeshCore::MeshKernel kernel(this->_kernel);
     kernel.Transform(getTransform());
 
@@ -1156,6 +1210,7 @@ void MeshObject::trim(const Base::Polygon2d& polygon2d,
                       const Base::ViewProjMethod& proj,
                       MeshObject::CutType type)
 {
+    invalidateFacetBVH();
     MeshCore::MeshKernel kernel(this->_kernel);
     kernel.Transform(getTransform());
 
@@ -1192,9 +1247,9 @@ void MeshObject::trim(const Base::Polygon2d& polygon2d,
 
 void MeshObject::trimByPlane(const Base::Vector3f& base, const Base::Vector3f& normal)
 {
+    invalidateFacetBVH();
     MeshCore::MeshTrimByPlane trim(this->_kernel);
-    std::vector<FacetIndex> trimFacets, removeFacets;
-    std::vector<MeshCore::MeshGeomFacet> triangle;
+    std::vector<FacetIndex> removeFacets;
 
     // Apply the inverted mesh placement to the plane because the trimming is done
     // on the untransformed mesh data
@@ -1204,15 +1259,9 @@ void MeshObject::trimByPlane(const Base::Vector3f& base, const Base::Vector3f& n
     meshPlacement.multVec(base, basePlane);
     meshPlacement.getRotation().multVec(normal, normalPlane);
 
-    MeshCore::MeshFacetGrid meshGrid(this->_kernel);
-    trim.CheckFacets(meshGrid, basePlane, normalPlane, trimFacets, removeFacets);
-    trim.TrimFacets(trimFacets, basePlane, normalPlane, triangle);
-    if (!removeFacets.empty()) {
-        this->deleteFacets(removeFacets);
-    }
-    if (!triangle.empty()) {
-        this->_kernel.AddFacets(triangle);
-    }
+    // the kept facets stay in their order, so the segments only need to drop the removed ones
+    trim.Trim(basePlane, normalPlane, removeFacets);
+    this->deletedFacets(removeFacets);
 }
 
 MeshObject* MeshObject::unite(const MeshObject& mesh) const
@@ -1336,6 +1385,7 @@ MeshObject::section(const MeshObject& mesh, bool connectLines, float fMinDist) c
 
 void MeshObject::refine()
 {
+    invalidateFacetBVH();
     unsigned long cnt = _kernel.CountFacets();
     MeshCore::MeshFacetIterator cF(_kernel);
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
@@ -1355,6 +1405,7 @@ void MeshObject::refine()
 
 void MeshObject::removeNeedles(float length)
 {
+    invalidateFacetBVH();
     unsigned long count = _kernel.CountFacets();
     MeshCore::MeshRemoveNeedles eval(_kernel, length);
     eval.Fixup();
@@ -1365,12 +1416,14 @@ void MeshObject::removeNeedles(float length)
 
 void MeshObject::validateCaps(float fMaxAngle, float fSplitFactor)
 {
+    invalidateFacetBVH();
     MeshCore::MeshFixCaps eval(_kernel, fMaxAngle, fSplitFactor);
     eval.Fixup();
 }
 
 void MeshObject::optimizeTopology(float fMaxAngle)
 {
+    invalidateFacetBVH();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     if (fMaxAngle > 0.0F) {
         topalg.OptimizeTopology(fMaxAngle);
@@ -1386,12 +1439,14 @@ void MeshObject::optimizeTopology(float fMaxAngle)
 
 void MeshObject::optimizeEdges()
 {
+    invalidateFacetBVH();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.AdjustEdgesToCurvatureDirection();
 }
 
 void MeshObject::splitEdges()
 {
+    invalidateFacetBVH();
     std::vector<std::pair<FacetIndex, FacetIndex>> adjacentFacet;
     MeshCore::MeshAlgorithm alg(_kernel);
     alg.ResetFacetFlag(MeshCore::MeshFacet::VISIT);
@@ -1424,24 +1479,28 @@ void MeshObject::splitEdges()
 
 void MeshObject::splitEdge(FacetIndex facet, FacetIndex neighbour, const Base::Vector3f& v)
 {
+    invalidateFacetBVH();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.SplitEdge(facet, neighbour, v);
 }
 
 void MeshObject::splitFacet(FacetIndex facet, const Base::Vector3f& v1, const Base::Vector3f& v2)
 {
+    invalidateFacetBVH();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.SplitFacet(facet, v1, v2);
 }
 
 void MeshObject::swapEdge(FacetIndex facet, FacetIndex neighbour)
 {
+    invalidateFacetBVH();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.SwapEdge(facet, neighbour);
 }
 
 void MeshObject::collapseEdge(FacetIndex facet, FacetIndex neighbour)
 {
+    invalidateFacetBVH();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.CollapseEdge(facet, neighbour);
 
@@ -1453,6 +1512,7 @@ void MeshObject::collapseEdge(FacetIndex facet, FacetIndex neighbour)
 
 void MeshObject::collapseFacet(FacetIndex facet)
 {
+    invalidateFacetBVH();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.CollapseFacet(facet);
 
@@ -1463,6 +1523,7 @@ void MeshObject::collapseFacet(FacetIndex facet)
 
 void MeshObject::collapseFacets(const std::vector<FacetIndex>& facets)
 {
+    invalidateFacetBVH();
     MeshCore::MeshTopoAlgorithm alg(_kernel);
     for (FacetIndex it : facets) {
         alg.CollapseFacet(it);
@@ -1473,12 +1534,14 @@ void MeshObject::collapseFacets(const std::vector<FacetIndex>& facets)
 
 void MeshObject::insertVertex(FacetIndex facet, const Base::Vector3f& v)
 {
+    invalidateFacetBVH();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.InsertVertex(facet, v);
 }
 
 void MeshObject::snapVertex(FacetIndex facet, const Base::Vector3f& v)
 {
+    invalidateFacetBVH();
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.SnapVertex(facet, v);
 }
@@ -1492,12 +1555,14 @@ unsigned long MeshObject::countNonUniformOrientedFacets() const
 
 void MeshObject::flipNormals()
 {
+    invalidateFacetBVH();
     MeshCore::MeshTopoAlgorithm alg(_kernel);
     alg.FlipNormals();
 }
 
 void MeshObject::harmonizeNormals()
 {
+    invalidateFacetBVH();
     MeshCore::MeshTopoAlgorithm alg(_kernel);
     alg.HarmonizeNormals();
 }
@@ -1510,6 +1575,7 @@ bool MeshObject::hasNonManifolds() const
 
 void MeshObject::removeNonManifolds()
 {
+    invalidateFacetBVH();
     MeshCore::MeshEvalTopology f_eval(_kernel);
     if (!f_eval.Evaluate()) {
         MeshCore::MeshFixTopology f_fix(_kernel, f_eval.GetFacets());
@@ -1520,6 +1586,7 @@ void MeshObject::removeNonManifolds()
 
 void MeshObject::removeNonManifoldPoints()
 {
+    invalidateFacetBVH();
     MeshCore::MeshEvalPointManifolds p_eval(_kernel);
     if (!p_eval.Evaluate()) {
         std::vector<FacetIndex> faces;
@@ -1566,6 +1633,7 @@ MeshObject::getSelfIntersections(const MeshObject::TFacePairs& facets) const
 
 void MeshObject::removeSelfIntersections()
 {
+    invalidateFacetBVH();
     std::vector<std::pair<FacetIndex, FacetIndex>> selfIntersections;
     MeshCore::MeshEvalSelfIntersection cMeshEval(_kernel);
     cMeshEval.GetIntersections(selfIntersections);
@@ -1578,6 +1646,7 @@ void MeshObject::removeSelfIntersections()
 
 void MeshObject::removeSelfIntersections(const std::vector<FacetIndex>& indices)
 {
+    invalidateFacetBVH();
     // make sure that the number of indices is even and are in range
     if (indices.size() % 2 != 0) {
         return;
@@ -1610,6 +1679,7 @@ void MeshObject::removeSelfIntersections(const std::vector<FacetIndex>& indices)
 
 void MeshObject::removeFoldsOnSurface()
 {
+    invalidateFacetBVH();
     std::vector<FacetIndex> indices;
     MeshCore::MeshEvalFoldsOnSurface s_eval(_kernel);
     MeshCore::MeshEvalFoldOversOnSurface f_eval(_kernel);
@@ -1644,6 +1714,7 @@ void MeshObject::removeFoldsOnSurface()
 
 void MeshObject::removeFullBoundaryFacets()
 {
+    invalidateFacetBVH();
     std::vector<FacetIndex> facets;
     if (!MeshCore::MeshEvalBorderFacet(_kernel, facets).Evaluate()) {
         deleteFacets(facets);
@@ -1658,6 +1729,7 @@ bool MeshObject::hasInvalidPoints() const
 
 void MeshObject::removeInvalidPoints()
 {
+    invalidateFacetBVH();
     MeshCore::MeshEvalNaNPoints nan(_kernel);
     deletePoints(nan.GetIndices());
 }
@@ -1670,12 +1742,14 @@ bool MeshObject::hasPointsOnEdge() const
 
 void MeshObject::removePointsOnEdge(bool fillBoundary)
 {
+    invalidateFacetBVH();
     MeshCore::MeshFixPointOnEdge nan(_kernel, fillBoundary);
     nan.Fixup();
 }
 
 void MeshObject::mergeFacets()
 {
+    invalidateFacetBVH();
     unsigned long count = _kernel.CountFacets();
     MeshCore::MeshFixMergeFacets merge(_kernel);
     merge.Fixup();
@@ -1686,6 +1760,7 @@ void MeshObject::mergeFacets()
 
 void MeshObject::validateIndices()
 {
+    invalidateFacetBVH();
     unsigned long count = _kernel.CountFacets();
 
     // for invalid neighbour indices we don't need to check first
@@ -1742,6 +1817,7 @@ bool MeshObject::hasCorruptedFacets() const
 
 void MeshObject::validateDeformations(float fMaxAngle, float fEps)
 {
+    invalidateFacetBVH();
     unsigned long count = _kernel.CountFacets();
     MeshCore::MeshFixDeformedFacets eval(_kernel,
                                          Base::toRadians(15.0F),
@@ -1756,6 +1832,7 @@ void MeshObject::validateDeformations(float fMaxAngle, float fEps)
 
 void MeshObject::validateDegenerations(float fEps)
 {
+    invalidateFacetBVH();
     unsigned long count = _kernel.CountFacets();
     MeshCore::MeshFixDegeneratedFacets eval(_kernel, fEps);
     eval.Fixup();
@@ -1766,6 +1843,7 @@ void MeshObject::validateDegenerations(float fEps)
 
 void MeshObject::removeDuplicatedPoints()
 {
+    invalidateFacetBVH();
     unsigned long count = _kernel.CountFacets();
     MeshCore::MeshFixDuplicatePoints eval(_kernel);
     eval.Fixup();
@@ -1776,6 +1854,7 @@ void MeshObject::removeDuplicatedPoints()
 
 void MeshObject::removeDuplicatedFacets()
 {
+    invalidateFacetBVH();
     unsigned long count = _kernel.CountFacets();
     MeshCore::MeshFixDuplicateFacets eval(_kernel);
     eval.Fixup();
@@ -25,6 +25,8 @@
 
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -58,6 +60,7 @@ class ViewProjMethod;
 namespace MeshCore
 {
 class AbstractPolygonTriangulator;
+class MeshFacetBVH;
 }
 
 namespace Mesh
@@ -176,14 +179,22 @@ public:
     //@}
 
     void setKernel(const MeshCore::MeshKernel& m);
+    /// Gives write access to the kernel, this discards the cached data of the geometry
     MeshCore::MeshKernel& getKernel()
     {
+        invalidateFacetBVH();
         return _kernel;
     }
     const MeshCore::MeshKernel& getKernel() const
     {
         return _kernel;
     }
+    /**
+     * Returns the bounding volume hierarchy of the facets in the local coordinate system of
+     * the kernel. It's built on first use and shared by all callers until the geometry
+     * changes, so it must not be used after the mesh has been modified or destroyed.
+     */
+    std::shared_ptr<const MeshCore::MeshFacetBVH> getFacetBVH() const;
 
     Base::BoundBox3d getBoundBox() const override;
     bool getCenterOfGravity(Base::Vector3d& center) const override;
@@ -463,6 +474,7 @@ private:
     void deletedFacets(const std::vector<FacetIndex>& remFacets);
     void updateMesh(const std::vector<FacetIndex>&) const;
     void updateMesh() const;
+    void invalidateFacetBVH();
     void swapKernel(MeshCore::MeshKernel& kernel, const std::vector<std::string>& g);
     void copySegments(const MeshObject&);
     void swapSegments(MeshObject&);
@@ -471,6 +483,8 @@ private:
     Base::Matrix4D _Mtrx;
     MeshCore::MeshKernel _kernel;
     std::vector<Segment> _segments;
+    mutable std::shared_ptr<const MeshCore::MeshFacetBVH> _bvh;
+    mutable std::mutex _bvhMutex;
     static const float Epsilon;
 };
 
@@ -133,7 +133,14 @@ class Mesh(ComplexGeoData):
         ...
 
     def addFacets(self) -> Any:
-        """Add a list of facets to the mesh"""
+        """
+        Add a list of facets to the mesh
+
+        addFacets((points, facets), [checkManifolds=True]) also takes an array of shape (n, 3)
+        with the points and one of shape (m, 3) with the point indices of the facets, e.g. NumPy
+        arrays. They are read through the buffer protocol without creating Python objects, so
+        Mesh.Mesh((points, facets)) is the fast way to build a mesh from arrays.
+        """
         ...
 
     def removeFacets(self) -> Any:
@@ -505,6 +512,28 @@ class Mesh(ComplexGeoData):
         The items in the list contains minimum and maximum curvature with their directions
         """
         ...
+
+    @constmethod
+    def pointBuffer(self) -> memoryview:
+        """
+        pointBuffer() -> memoryview
+
+        Return a read-only view of shape (CountPoints, 3) on the float32 coordinates of the points
+        without copying them, e.g. for numpy.asarray(). The coordinates are without the placement.
+        The view keeps the mesh object alive but any change of the mesh invalidates it.
+        """
+        ...
+
+    @constmethod
+    def facetBuffer(self) -> memoryview:
+        """
+        facetBuffer() -> memoryview
+
+        Return a read-only view of shape (CountFacets, 3) on the point indices of the facets
+        without copying them, e.g. for numpy.asarray(). The view keeps the mesh object alive
+        but any change of the mesh invalidates it.
+        """
+        ...
     Points: Final[list]
     """A collection of the mesh points
 With this attribute it is possible to get access to the points of the mesh
@@ -21,6 +21,10 @@
  ***************************************************************************/
 
 
+#include <memory>
+
+#include <App/Application.h>
+#include <Base/Console.h>
 #include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/Reader.h>
@@ -28,6 +32,7 @@
 #include <Base/VectorPy.h>
 #include <Base/Writer.h>
 
+#include "Core/Evaluation.h"
 #include "Core/Iterator.h"
 #include "Core/MeshKernel.h"
 #include "Core/MeshIO.h"
@@ -920,7 +925,9 @@ void PropertyMeshKernel::Restore(Base::XMLReader& reader)
 
 void PropertyMeshKernel::SaveDocFile(Base::Writer& writer) const
 {
-    _meshObject->save(writer.Stream());
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Mesh");
+    _meshObject->getKernel().Write(writer.Stream(), hGrp->GetBool("CompressMeshData", false));
 }
 
 void PropertyMeshKernel::RestoreDocFile(Base::Reader& reader)
@@ -930,6 +937,53 @@ void PropertyMeshKernel::RestoreDocFile(Base::Reader& reader)
     hasSetValue();
 }
 
+bool PropertyMeshKernel::canParseDocFileConcurrently() const
+{
+    return true;
+}
+
+std::function<void()> PropertyMeshKernel::parseDocFile(Base::Reader& reader)
+{
+    // Same as MeshObject::load() but the messages are deferred to the main thread
+    auto kernel = std::make_shared<MeshCore::MeshKernel>();
+    [[maybe_unused]] bool consistent = kernel->Read(reader);
+
+    bool neighbourhood = true;
+    bool topology = true;
+    bool checked = true;
+#ifndef FC_DEBUG
+    // a consistent neighbourhood was stored with the mesh, so there is nothing to rebuild
+    if (!consistent) {
+        try {
+            MeshCore::MeshEvalNeighbourhood nb(*kernel);
+            neighbourhood = nb.Evaluate();
+            if (!neighbourhood) {
+                kernel->RebuildNeighbours();
+            }
+
+            MeshCore::MeshEvalTopology eval(*kernel);
+            topology = eval.Evaluate();
+        }
+        catch (const Base::MemoryException&) {
+            checked = false;
+        }
+    }
+#endif
+
+    return [this, kernel, neighbourhood, topology, checked]() {
+        if (!neighbourhood) {
+            Base::Console().warning("Errors in neighbourhood of mesh found...fixed\n");
+        }
+        if (!topology) {
+            Base::Console().warning("The mesh data structure has some defects\n");
+        }
+        if (!checked) {
+            Base::Console().log("Check for defects in mesh data structure failed\n");
+        }
+        swapMesh(*kernel);
+    };
+}
+
 App::Property* PropertyMeshKernel::Copy() const
 {
     // Note: Copy the content, do NOT reference the same mesh object
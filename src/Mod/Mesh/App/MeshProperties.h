@@ -315,6 +315,8 @@ public:
 
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    bool canParseDocFileConcurrently() const override;
+    std::function<void()> parseDocFile(Base::Reader& reader) override;
 
     App::Property* Copy() const override;
     void Paste(const App::Property& from) override;
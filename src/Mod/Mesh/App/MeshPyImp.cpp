@@ -21,6 +21,9 @@
  ***************************************************************************/
 
 
+#include <array>
+#include <cstring>
+
 #include <Base/Converter.h>
 #include <Base/GeometryPyCXX.h>
 #include <Base/MatrixPy.h>
@@ -68,6 +71,221 @@ private:
     FC_DISABLE_COPY_MOVE(MeshPropertyLock)
 };
 
+namespace
+{
+
+// Exports the points or the point indices of the facets of a mesh through the buffer protocol.
+// The arrays of the kernel are exported in place with the size of a point or a facet as stride.
+// It holds a reference to the mesh object so that the memory stays valid as long as a view
+// uses it.
+struct MeshBuffer
+{
+    PyObject_HEAD
+    PyObject* owner;
+    const MeshCore::MeshKernel* kernel;
+    bool facets;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+};
+
+int MeshBuffer_getbuffer(PyObject* self, Py_buffer* view, int flags)
+{
+    auto buffer = reinterpret_cast<MeshBuffer*>(self);  // NOLINT
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "Mesh buffer is read-only");
+        view->obj = nullptr;
+        return -1;
+    }
+    if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES) {
+        PyErr_SetString(PyExc_BufferError, "Mesh buffer is not contiguous");
+        view->obj = nullptr;
+        return -1;
+    }
+
+    static char pointFormat[] = "f";
+    static char indexFormat[] = "L";
+    static_assert(sizeof(MeshCore::PointIndex) == sizeof(unsigned long));
+    if (buffer->facets) {
+        const auto& facets = buffer->kernel->GetFacets();
+        buffer->shape[0] = static_cast<Py_ssize_t>(facets.size());
+        buffer->strides[0] = sizeof(MeshCore::MeshFacet);
+        buffer->strides[1] = sizeof(MeshCore::PointIndex);
+        const MeshCore::PointIndex* data = facets.empty() ? nullptr : facets[0]._aulPoints;
+        view->buf = const_cast<MeshCore::PointIndex*>(data);  // NOLINT
+        view->itemsize = sizeof(MeshCore::PointIndex);
+        view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? indexFormat : nullptr;
+    }
+    else {
+        const auto& points = buffer->kernel->GetPoints();
+        buffer->shape[0] = static_cast<Py_ssize_t>(points.size());
+        buffer->strides[0] = sizeof(MeshCore::MeshPoint);
+        buffer->strides[1] = sizeof(float);
+        const float* data = points.empty() ? nullptr : &points[0].x;
+        view->buf = const_cast<float*>(data);  // NOLINT
+        view->itemsize = sizeof(float);
+        view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? pointFormat : nullptr;
+    }
+    buffer->shape[1] = 3;
+
+    Py_INCREF(self);
+    view->obj = self;
+    view->len = buffer->shape[0] * 3 * view->itemsize;
+    view->readonly = 1;
+    view->ndim = 2;
+    view->shape = buffer->shape;
+    view->strides = buffer->strides;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+void MeshBuffer_dealloc(PyObject* self)
+{
+    Py_XDECREF(reinterpret_cast<MeshBuffer*>(self)->owner);  // NOLINT
+    PyObject_Free(self);
+}
+
+PyTypeObject* MeshBuffer_type()
+{
+    static PyBufferProcs procs = {MeshBuffer_getbuffer, nullptr};
+    static PyTypeObject type = [] {
+        PyTypeObject obj = {PyVarObject_HEAD_INIT(nullptr, 0)};
+        obj.tp_name = "Mesh.MeshBuffer";
+        obj.tp_basicsize = sizeof(MeshBuffer);
+        obj.tp_dealloc = MeshBuffer_dealloc;
+        obj.tp_as_buffer = &procs;
+        obj.tp_flags = Py_TPFLAGS_DEFAULT;
+        obj.tp_doc = "Exports the points or facets of a mesh object";
+        return obj;
+    }();
+    if (PyType_Ready(&type) < 0) {
+        return nullptr;
+    }
+    return &type;
+}
+
+PyObject* createMeshBuffer(const MeshPy* mesh, bool facets)
+{
+    PyTypeObject* type = MeshBuffer_type();
+    if (!type) {
+        return nullptr;
+    }
+    MeshBuffer* exporter = PyObject_New(MeshBuffer, type);
+    if (!exporter) {
+        return nullptr;
+    }
+    exporter->owner = const_cast<MeshPy*>(mesh);  // NOLINT
+    Py_INCREF(exporter->owner);
+    exporter->kernel = &mesh->getMeshObjectPtr()->getKernel();
+    exporter->facets = facets;
+
+    // the memory view keeps the exporter and with it the mesh object alive
+    PyObject* view = PyMemoryView_FromObject(reinterpret_cast<PyObject*>(exporter));  // NOLINT
+    Py_DECREF(exporter);
+    return view;
+}
+
+// Calls func(row, values) for each row of a buffer of shape (n, 3) of a native integer or float
+// type, e.g. a NumPy array. Returns false with a Python exception set if the buffer can't be used.
+template<typename T, typename Func>
+bool readBuffer(PyObject* obj, Func&& func)
+{
+    Py_buffer view;
+    if (PyObject_GetBuffer(obj, &view, PyBUF_RECORDS_RO) < 0) {
+        return false;
+    }
+
+    std::string format(view.format ? view.format : "B");
+    if (!format.empty() && (format[0] == '@' || format[0] == '=')) {
+        format.erase(0, 1);
+    }
+    char type = format.size() == 1 ? format[0] : '\0';
+    auto value = [type](const char* data) -> T {
+        auto read = [data](auto val) {
+            std::memcpy(&val, data, sizeof(val));
+            return static_cast<T>(val);
+        };
+        // clang-format off
+        switch (type) {
+            case 'f': return read(float());
+            case 'd': return read(double());
+            case 'b': return read((signed char)0);
+            case 'B': return read((unsigned char)0);
+            case 'h': return read(short());
+            case 'H': return read((unsigned short)0);
+            case 'i': return read(int());
+            case 'I': return read(unsigned());
+            case 'l': return read(long());
+            case 'L': return read((unsigned long)0);
+            case 'q': return read((long long)0);
+            case 'Q': return read((unsigned long long)0);
+            default: return T();
+        }
+        // clang-format on
+    };
+
+    bool ok = true;
+    if (std::string("fdbBhHiIlLqQ").find(type) == std::string::npos) {
+        PyErr_Format(PyExc_TypeError, "Unsupported buffer format '%s'", format.c_str());
+        ok = false;
+    }
+    else if (view.ndim != 2 || view.shape[1] != 3) {
+        PyErr_SetString(PyExc_ValueError, "Buffer of shape (n, 3) expected");
+        ok = false;
+    }
+    else {
+        const char* base = static_cast<const char*>(view.buf);
+        for (Py_ssize_t i = 0; i < view.shape[0]; i++) {
+            const char* row = base + i * view.strides[0];
+            std::array<T, 3> values {value(row),
+                                     value(row + view.strides[1]),
+                                     value(row + 2 * view.strides[1])};
+            if (!func(std::size_t(i), values)) {
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    PyBuffer_Release(&view);
+    return ok;
+}
+
+// Adds the points of an (n, 3) buffer and the facets of an (m, 3) buffer of point indices
+bool addFacetsFromBuffers(MeshObject& mesh, PyObject* points, PyObject* facets, bool check)
+{
+    std::vector<Base::Vector3f> vertices;
+    bool ok = readBuffer<float>(points, [&vertices](std::size_t, const std::array<float, 3>& v) {
+        vertices.emplace_back(v[0], v[1], v[2]);
+        return true;
+    });
+    if (!ok) {
+        return false;
+    }
+
+    MeshCore::MeshFacetArray faces;
+    ok = readBuffer<long long>(facets, [&](std::size_t row, const std::array<long long, 3>& f) {
+        for (long long index : f) {
+            if (index < 0 || index >= static_cast<long long>(vertices.size())) {
+                PyErr_Format(PyExc_IndexError, "Point index of facet %zu out of range", row);
+                return false;
+            }
+        }
+        faces.emplace_back(MeshCore::PointIndex(f[0]),
+                           MeshCore::PointIndex(f[1]),
+                           MeshCore::PointIndex(f[2]));
+        return true;
+    });
+    if (!ok) {
+        return false;
+    }
+
+    mesh.addFacets(faces, vertices, check);
+    return true;
+}
+
+}  // namespace
+
 int MeshPy::PyInit(PyObject* args, PyObject*)
 {
     PyObject* pcObj = nullptr;
@@ -794,6 +1012,17 @@ PyObject* MeshPy::addFacets(PyObject* args)
     PyObject* check = Py_True;
     if (PyArg_ParseTuple(args, "O!|O!", &PyTuple_Type, &list, &PyBool_Type, &check)) {
         Py::Tuple tuple(list);
+        if (tuple.size() == 2 && PyObject_CheckBuffer(tuple[0].ptr())
+            && PyObject_CheckBuffer(tuple[1].ptr())) {
+            if (!addFacetsFromBuffers(*getMeshObjectPtr(),
+                                      tuple[0].ptr(),
+                                      tuple[1].ptr(),
+                                      Base::asBoolean(check))) {
+                return nullptr;
+            }
+            Py_Return;
+        }
+
         Py::List list_v(tuple.getItem(0));
         std::vector<Base::Vector3f> vertices;
         Py::Type vType(Base::getTypeAsObject(&Base::VectorPy::Type));
@@ -823,7 +1052,8 @@ PyObject* MeshPy::addFacets(PyObject* args)
     PyErr_SetString(PyExc_TypeError,
                     "either expect\n"
                     "-- [Vector] (3 of them define a facet)\n"
-                    "-- ([Vector],[(int,int,int)])");
+                    "-- ([Vector],[(int,int,int)])\n"
+                    "-- (array of shape (n, 3), array of shape (m, 3))");
     return nullptr;
 }
 
@@ -2274,6 +2504,24 @@ PyObject* MeshPy::getCurvaturePerVertex(PyObject* args) const
     return Py::new_reference_to(list);
 }
 
+PyObject* MeshPy::pointBuffer(PyObject* args) const
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+
+    return createMeshBuffer(this, false);
+}
+
+PyObject* MeshPy::facetBuffer(PyObject* args) const
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+
+    return createMeshBuffer(this, true);
+}
+
 Py::Long MeshPy::getCountPoints() const
 {
     return Py::Long((long)getMeshObjectPtr()->countPoints());
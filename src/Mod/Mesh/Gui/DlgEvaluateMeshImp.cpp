@@ -20,6 +20,9 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
+#include <memory>
+
 #include <QDockWidget>
 #include <QMessageBox>
 #include <QPointer>
@@ -35,6 +38,7 @@
 #include <Gui/View3DInventor.h>
 #include <Gui/View3DInventorViewer.h>
 #include <Mod/Mesh/App/MeshFeature.h>
+#include <Mod/Mesh/App/Core/Analysis.h>
 #include <Mod/Mesh/App/Core/Evaluation.h>
 #include <Mod/Mesh/App/Core/Degeneration.h>
 
@@ -1183,93 +1187,78 @@ void DlgEvaluateMeshImp::onRepairAllTogetherClicked()
         try {
             do {
                 run = false;
-                {
-                    MeshEvalSelfIntersection eval(rMesh);
-                    if (self && !eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").fixSelfIntersections()",
-                            docName, objName);
-                        run = true;
-                    }
-                    else {
-                        self = false; // once no self-intersections found do not repeat it later on
+
+                // All checks but the folds are done in one pass with shared data structures.
+                // Every fix modifies the mesh, so the next check analyzes it again.
+                std::unique_ptr<MeshAnalysis> analysis;
+                auto hasDefects = [&](std::initializer_list<MeshAnalysis::Check> checks) {
+                    if (!analysis) {
+                        int selected = MeshAnalysis::All & ~MeshAnalysis::NonManifoldPoints;
+                        if (!self) {
+                            selected &= ~MeshAnalysis::SelfIntersections;
+                        }
+                        analysis = std::make_unique<MeshAnalysis>(rMesh, selected);
+                        analysis->SetEpsilonDegenerated(d->epsilonDegenerated);
+                        analysis->Evaluate();
                     }
-                    qApp->processEvents();
+                    return std::any_of(checks.begin(), checks.end(), [&](MeshAnalysis::Check check) {
+                        return analysis->HasDefects(check);
+                    });
+                };
+                auto fix = [&](const char* cmd) {
+                    Gui::Command::doCommand(Gui::Command::App,
+                        "App.getDocument(\"%s\").getObject(\"%s\").%s",
+                        docName, objName, cmd);
+                    analysis.reset();
+                    run = true;
+                };
+
+                if (self && hasDefects({MeshAnalysis::SelfIntersections})) {
+                    fix("fixSelfIntersections()");
                 }
+                else {
+                    self = false; // once no self-intersections found do not repeat it later on
+                }
+                qApp->processEvents();
                 if (d->enableFoldsCheck) {
                     MeshEvalFoldsOnSurface s_eval(rMesh);
                     MeshEvalFoldsOnBoundary b_eval(rMesh);
                     MeshEvalFoldOversOnSurface f_eval(rMesh);
                     if (!s_eval.Evaluate() || !b_eval.Evaluate() || !f_eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").removeFoldsOnSurface()",
-                            docName, objName);
-                        run = true;
+                        fix("removeFoldsOnSurface()");
                     }
                     qApp->processEvents();
                 }
-                {
-                    MeshEvalOrientation eval(rMesh);
-                    if (!eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").harmonizeNormals()",
-                            docName, objName);
-                        run = true;
-                    }
-                    qApp->processEvents();
+                if (hasDefects({MeshAnalysis::Orientation})) {
+                    fix("harmonizeNormals()");
                 }
-                {
-                    MeshEvalTopology eval(rMesh);
-                    if (!eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").removeNonManifolds()",
-                            docName, objName);
-                        run = true;
-                    }
-                    qApp->processEvents();
+                qApp->processEvents();
+                if (hasDefects({MeshAnalysis::NonManifoldEdges})) {
+                    fix("removeNonManifolds()");
                 }
-                {
-                    MeshEvalRangeFacet rf(rMesh);
-                    MeshEvalRangePoint rp(rMesh);
-                    MeshEvalCorruptedFacets cf(rMesh);
-                    MeshEvalNeighbourhood nb(rMesh);
-                    if (!rf.Evaluate() || !rp.Evaluate() || !cf.Evaluate() || !nb.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").fixIndices()",
-                            docName, objName);
-                        run = true;
-                    }
+                qApp->processEvents();
+                if (hasDefects({MeshAnalysis::RangeFacet,
+                                MeshAnalysis::RangePoint,
+                                MeshAnalysis::CorruptedFacets,
+                                MeshAnalysis::InvalidNeighbourhood})) {
+                    fix("fixIndices()");
                 }
-                {
-                    MeshEvalDegeneratedFacets eval(rMesh, d->epsilonDegenerated);
-                    if (!eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").fixDegenerations(%f)",
-                            docName, objName, d->epsilonDegenerated);
-                        run = true;
-                    }
-                    qApp->processEvents();
+                if (hasDefects({MeshAnalysis::DegeneratedFacets})) {
+                    Gui::Command::doCommand(Gui::Command::App,
+                        "App.getDocument(\"%s\").getObject(\"%s\").fixDegenerations(%f)",
+                        docName, objName, d->epsilonDegenerated);
+                    analysis.reset();
+                    run = true;
                 }
-                {
-                    MeshEvalDuplicateFacets eval(rMesh);
-                    if (!eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").removeDuplicatedFacets()",
-                            docName, objName);
-                        run = true;
-                    }
-                    qApp->processEvents();
+                qApp->processEvents();
+                if (hasDefects({MeshAnalysis::DuplicatedFacets})) {
+                    fix("removeDuplicatedFacets()");
                 }
-                {
-                    MeshEvalDuplicatePoints eval(rMesh);
-                    if (!eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").removeDuplicatedPoints()",
-                            docName, objName);
-                        run = true;
-                    }
-                    qApp->processEvents();
+                qApp->processEvents();
+                if (hasDefects({MeshAnalysis::DuplicatedPoints})) {
+                    fix("removeDuplicatedPoints()");
                 }
+                qApp->processEvents();
             } while(d->ui.checkRepeatButton->isChecked() && run && (--max_iter > 0));
         }
         catch (const Base::Exception& e) {
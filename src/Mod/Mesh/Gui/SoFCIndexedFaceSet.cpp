@@ -31,6 +31,8 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <limits>
 #ifdef FC_OS_MACOSX
 #include <OpenGL/gl.h>
@@ -46,21 +48,27 @@
 #include <Inventor/bundles/SoMaterialBundle.h>
 #include <Inventor/bundles/SoTextureCoordinateBundle.h>
 #include <Inventor/elements/SoCoordinateElement.h>
+#include <Inventor/elements/SoCullElement.h>
 #include <Inventor/elements/SoGLCacheContextElement.h>
 #include <Inventor/elements/SoGLCoordinateElement.h>
 #include <Inventor/elements/SoGLLazyElement.h>
 #include <Inventor/elements/SoMaterialBindingElement.h>
+#include <Inventor/elements/SoModelMatrixElement.h>
 #include <Inventor/elements/SoNormalBindingElement.h>
 #include <Inventor/elements/SoProjectionMatrixElement.h>
+#include <Inventor/elements/SoViewVolumeElement.h>
 #include <Inventor/elements/SoViewingMatrixElement.h>
+#include <Inventor/elements/SoViewportRegionElement.h>
 #include <Inventor/errors/SoDebugError.h>
 #include <Inventor/nodes/SoCoordinate3.h>
 
 #include <Inventor/C/glue/gl.h>
+#include <QtConcurrentRun>
 
 #include <Gui/GLBuffer.h>
 #include <Gui/SoFCInteractiveElement.h>
 #include <Gui/Selection/SoFCSelectionAction.h>
+#include <Mod/Mesh/App/Core/LevelOfDetail.h>
 
 #include "SoFCIndexedFaceSet.h"
 
@@ -75,21 +83,28 @@ class MeshRenderer::Private
 {
 public:
     Gui::OpenGLMultiBuffer vertices;
+    Gui::OpenGLMultiBuffer colors;
     Gui::OpenGLMultiBuffer indices;
     const SbColor* pcolors {nullptr};
     SoMaterialBindingElement::Binding matbinding {SoMaterialBindingElement::OVERALL};
+    GLsizei numVertices {0};
+    GLsizei numIndices {0};
     bool initialized {false};
 
     Private();
     bool canRenderGLArray(SoGLRenderAction*) const;
     void generateGLArrays(SoGLRenderAction* action,
-                          SoMaterialBindingElement::Binding matbind,
-                          std::vector<float>& vertex,
+                          std::vector<MeshRenderer::Vertex>& vertex,
                           std::vector<int32_t>& index);
+    void generateGLColors(SoGLRenderAction* action,
+                          SoMaterialBindingElement::Binding matbind,
+                          std::vector<uint8_t>& color);
     void renderFacesGLArray(SoGLRenderAction*);
     void renderCoordsGLArray(SoGLRenderAction*);
     void update();
+    void updateColors();
     bool needUpdate(SoGLRenderAction*);
+    bool needColorUpdate(SoGLRenderAction*);
 
 private:
     void renderGLArray(SoGLRenderAction*, GLenum);
@@ -97,6 +112,7 @@ private:
 
 MeshRenderer::Private::Private()
     : vertices(GL_ARRAY_BUFFER)
+    , colors(GL_ARRAY_BUFFER)
     , indices(GL_ELEMENT_ARRAY_BUFFER)
 {}
 
@@ -117,11 +133,10 @@ bool MeshRenderer::Private::canRenderGLArray(SoGLRenderAction* action) const
 }
 
 void MeshRenderer::Private::generateGLArrays(SoGLRenderAction* action,
-                                             SoMaterialBindingElement::Binding matbind,
-                                             std::vector<float>& vertex,
+                                             std::vector<MeshRenderer::Vertex>& vertex,
                                              std::vector<int32_t>& index)
 {
-    if (vertex.empty() || index.empty()) {
+    if (vertex.empty()) {
         return;
     }
 
@@ -131,16 +146,35 @@ void MeshRenderer::Private::generateGLArrays(SoGLRenderAction* action,
 
     initialized = true;
     vertices.create();
-    indices.create();
-
     vertices.bind();
-    vertices.allocate(vertex.data(), vertex.size() * sizeof(float));
+    vertices.allocate(vertex.data(), vertex.size() * sizeof(MeshRenderer::Vertex));
     vertices.release();
+    numVertices = static_cast<GLsizei>(vertex.size());
+
+    // without shared vertices the index buffer is omitted
+    numIndices = static_cast<GLsizei>(index.size());
+    if (!index.empty()) {
+        indices.create();
+        indices.bind();
+        indices.allocate(index.data(), index.size() * sizeof(int32_t));
+        indices.release();
+    }
+}
 
-    indices.bind();
-    indices.allocate(index.data(), index.size() * sizeof(int32_t));
-    indices.release();
+void MeshRenderer::Private::generateGLColors(SoGLRenderAction* action,
+                                             SoMaterialBindingElement::Binding matbind,
+                                             std::vector<uint8_t>& color)
+{
     this->matbinding = matbind;
+    if (matbind == SoMaterialBindingElement::OVERALL || color.empty()) {
+        return;
+    }
+
+    colors.setCurrentContext(action->getCacheContext());
+    colors.create();
+    colors.bind();
+    colors.allocate(color.data(), color.size());
+    colors.release();
 }
 
 void MeshRenderer::Private::renderGLArray(SoGLRenderAction* action, GLenum mode)
@@ -152,25 +186,36 @@ void MeshRenderer::Private::renderGLArray(SoGLRenderAction* action, GLenum mode)
 
     vertices.setCurrentContext(action->getCacheContext());
     indices.setCurrentContext(action->getCacheContext());
+    colors.setCurrentContext(action->getCacheContext());
 
+    const GLsizei stride = sizeof(MeshRenderer::Vertex);
     glEnableClientState(GL_VERTEX_ARRAY);
     glEnableClientState(GL_NORMAL_ARRAY);
-    glEnableClientState(GL_COLOR_ARRAY);
-
-    vertices.bind();
-    indices.bind();
 
     if (matbinding != SoMaterialBindingElement::OVERALL) {
-        glInterleavedArrays(GL_C4F_N3F_V3F, 0, nullptr);
+        glEnableClientState(GL_COLOR_ARRAY);
+        colors.bind();
+        glColorPointer(4, GL_UNSIGNED_BYTE, 0, nullptr);
+    }
+
+    // signed short normals are mapped to [-1, 1] by OpenGL
+    vertices.bind();
+    glNormalPointer(GL_SHORT, stride, nullptr);
+    glVertexPointer(3,
+                    GL_FLOAT,
+                    stride,
+                    reinterpret_cast<const GLvoid*>(offsetof(MeshRenderer::Vertex, point)));
+
+    if (numIndices > 0) {
+        indices.bind();
+        glDrawElements(mode, numIndices, GL_UNSIGNED_INT, nullptr);
+        indices.release();
     }
     else {
-        glInterleavedArrays(GL_N3F_V3F, 0, nullptr);
+        glDrawArrays(mode, 0, numVertices);
     }
 
-    glDrawElements(mode, indices.size() / sizeof(uint32_t), GL_UNSIGNED_INT, nullptr);
-
     vertices.release();
-    indices.release();
 
     glDisableClientState(GL_COLOR_ARRAY);
     glDisableClientState(GL_NORMAL_ARRAY);
@@ -191,19 +236,32 @@ void MeshRenderer::Private::update()
 {
     vertices.destroy();
     indices.destroy();
+    colors.destroy();
+}
+
+void MeshRenderer::Private::updateColors()
+{
+    colors.destroy();
 }
 
 bool MeshRenderer::Private::needUpdate(SoGLRenderAction* action)
 {
     return !vertices.isCreated(action->getCacheContext())
-        || !indices.isCreated(action->getCacheContext());
+        || (numIndices > 0 && !indices.isCreated(action->getCacheContext()));
+}
+
+bool MeshRenderer::Private::needColorUpdate(SoGLRenderAction* action)
+{
+    return matbinding != SoMaterialBindingElement::OVERALL
+        && !colors.isCreated(action->getCacheContext());
 }
 #elif defined RENDER_GLARRAYS
 class MeshRenderer::Private
 {
 public:
     std::vector<int32_t> index_array;
-    std::vector<float> vertex_array;
+    std::vector<MeshRenderer::Vertex> vertex_array;
+    std::vector<uint8_t> color_array;
     const SbColor* pcolors;
     SoMaterialBindingElement::Binding matbinding;
 
@@ -214,17 +272,28 @@ public:
 
     bool canRenderGLArray(SoGLRenderAction*) const;
     void generateGLArrays(SoGLRenderAction* action,
-                          SoMaterialBindingElement::Binding matbind,
-                          std::vector<float>& vertex,
+                          std::vector<MeshRenderer::Vertex>& vertex,
                           std::vector<int32_t>& index);
+    void generateGLColors(SoGLRenderAction* action,
+                          SoMaterialBindingElement::Binding matbind,
+                          std::vector<uint8_t>& color);
     void renderFacesGLArray(SoGLRenderAction* action);
     void renderCoordsGLArray(SoGLRenderAction* action);
     void update()
     {}
+    void updateColors()
+    {}
     bool needUpdate(SoGLRenderAction*)
     {
         return false;
     }
+    bool needColorUpdate(SoGLRenderAction*)
+    {
+        return false;
+    }
+
+private:
+    void renderGLArray(GLenum mode);
 };
 
 bool MeshRenderer::Private::canRenderGLArray(SoGLRenderAction*) const
@@ -233,11 +302,10 @@ bool MeshRenderer::Private::canRenderGLArray(SoGLRenderAction*) const
 }
 
 void MeshRenderer::Private::generateGLArrays(SoGLRenderAction*,
-                                             SoMaterialBindingElement::Binding matbind,
-                                             std::vector<float>& vertex,
+                                             std::vector<MeshRenderer::Vertex>& vertex,
                                              std::vector<int32_t>& index)
 {
-    if (vertex.empty() || index.empty()) {
+    if (vertex.empty()) {
         return;
     }
 
@@ -246,46 +314,49 @@ void MeshRenderer::Private::generateGLArrays(SoGLRenderAction*,
 
     this->index_array.swap(index);
     this->vertex_array.swap(vertex);
-    this->matbinding = matbind;
 }
 
-void MeshRenderer::Private::renderFacesGLArray(SoGLRenderAction* action)
+void MeshRenderer::Private::generateGLColors(SoGLRenderAction*,
+                                             SoMaterialBindingElement::Binding matbind,
+                                             std::vector<uint8_t>& color)
 {
-    (void)action;
-    int cnt = index_array.size();
+    this->color_array.resize(0);
+    this->color_array.swap(color);
+    this->matbinding = matbind;
+}
 
+void MeshRenderer::Private::renderGLArray(GLenum mode)
+{
+    const GLsizei stride = sizeof(MeshRenderer::Vertex);
     glEnableClientState(GL_NORMAL_ARRAY);
     glEnableClientState(GL_VERTEX_ARRAY);
 
     if (matbinding != SoMaterialBindingElement::OVERALL) {
-        glInterleavedArrays(GL_C4F_N3F_V3F, 0, &(vertex_array[0]));
+        glEnableClientState(GL_COLOR_ARRAY);
+        glColorPointer(4, GL_UNSIGNED_BYTE, 0, color_array.data());
+    }
+    glNormalPointer(GL_SHORT, stride, vertex_array[0].normal);
+    glVertexPointer(3, GL_FLOAT, stride, vertex_array[0].point);
+    if (!index_array.empty()) {
+        glDrawElements(mode, index_array.size(), GL_UNSIGNED_INT, index_array.data());
     }
     else {
-        glInterleavedArrays(GL_N3F_V3F, 0, &(vertex_array[0]));
+        glDrawArrays(mode, 0, vertex_array.size());
     }
-    glDrawElements(GL_TRIANGLES, cnt, GL_UNSIGNED_INT, &(index_array[0]));
 
+    glDisableClientState(GL_COLOR_ARRAY);
     glDisableClientState(GL_VERTEX_ARRAY);
     glDisableClientState(GL_NORMAL_ARRAY);
 }
 
-void MeshRenderer::Private::renderCoordsGLArray(SoGLRenderAction*)
+void MeshRenderer::Private::renderFacesGLArray(SoGLRenderAction*)
 {
-    int cnt = index_array.size();
-
-    glEnableClientState(GL_NORMAL_ARRAY);
-    glEnableClientState(GL_VERTEX_ARRAY);
-
-    if (matbinding != SoMaterialBindingElement::OVERALL) {
-        glInterleavedArrays(GL_C4F_N3F_V3F, 0, &(vertex_array[0]));
-    }
-    else {
-        glInterleavedArrays(GL_N3F_V3F, 0, &(vertex_array[0]));
-    }
-    glDrawElements(GL_POINTS, cnt, GL_UNSIGNED_INT, &(index_array[0]));
+    renderGLArray(GL_TRIANGLES);
+}
 
-    glDisableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_NORMAL_ARRAY);
+void MeshRenderer::Private::renderCoordsGLArray(SoGLRenderAction*)
+{
+    renderGLArray(GL_POINTS);
 }
 #else
 class MeshRenderer::Private
@@ -304,20 +375,29 @@ public:
         return false;
     }
     void generateGLArrays(SoGLRenderAction*,
-                          SoMaterialBindingElement::Binding,
-                          std::vector<float>&,
+                          std::vector<MeshRenderer::Vertex>&,
                           std::vector<int32_t>&)
     {}
+    void generateGLColors(SoGLRenderAction*,
+                          SoMaterialBindingElement::Binding,
+                          std::vector<uint8_t>&)
+    {}
     void renderFacesGLArray(SoGLRenderAction*)
     {}
     void renderCoordsGLArray(SoGLRenderAction*)
     {}
     void update()
     {}
+    void updateColors()
+    {}
     bool needUpdate(SoGLRenderAction*)
     {
         return false;
     }
+    bool needColorUpdate(SoGLRenderAction*)
+    {
+        return false;
+    }
 };
 #endif
 
@@ -335,21 +415,37 @@ void MeshRenderer::update()
     p->update();
 }
 
+void MeshRenderer::updateColors()
+{
+    p->updateColors();
+}
+
 bool MeshRenderer::needUpdate(SoGLRenderAction* action)
 {
     return p->needUpdate(action);
 }
 
+bool MeshRenderer::needColorUpdate(SoGLRenderAction* action)
+{
+    return p->needColorUpdate(action);
+}
+
 void MeshRenderer::generateGLArrays(SoGLRenderAction* action,
-                                    SoMaterialBindingElement::Binding matbind,
-                                    std::vector<float>& vertex,
+                                    std::vector<Vertex>& vertex,
                                     std::vector<int32_t>& index)
+{
+    p->generateGLArrays(action, vertex, index);
+}
+
+void MeshRenderer::generateGLColors(SoGLRenderAction* action,
+                                    SoMaterialBindingElement::Binding matbind,
+                                    std::vector<uint8_t>& color)
 {
     SoGLLazyElement* gl = SoGLLazyElement::getInstance(action->getState());
     if (gl) {
         p->pcolors = gl->getDiffusePointer();
     }
-    p->generateGLArrays(action, matbind, vertex, index);
+    p->generateGLColors(action, matbind, color);
 }
 
 // Implementation                            | FPS
@@ -488,6 +584,13 @@ void SoFCIndexedFaceSet::GLRender(SoGLRenderAction* action)
         return;
     }
 
+    // during interaction very large meshes are drawn from the level of detail hierarchy
+    unsigned int numTria = this->coordIndex.getNum() / 4;
+    if (numTria > this->renderTriangleLimit && Gui::SoFCInteractiveElement::get(action->getState())
+        && renderLevelOfDetail(action)) {
+        return;
+    }
+
 #if defined(RENDER_GL_VAO)
     SoState* state = action->getState();
 
@@ -502,14 +605,25 @@ void SoFCIndexedFaceSet::GLRender(SoGLRenderAction* action)
 
     // use VBO for fast rendering if possible
     if (useVBO) {
+        // a material change only replaces the colors, the geometry is kept
+        bool colorsChanged = false;
         if (updateGLArray.getValue()) {
             updateGLArray.setValue(false);
-            render.update();
-            generateGLArrays(action);
+            if (updateGeometry) {
+                updateGeometry = false;
+                render.update();
+            }
+            else {
+                render.updateColors();
+                colorsChanged = true;
+            }
         }
-        else if (render.needUpdate(action)) {
+        if (render.needUpdate(action)) {
             generateGLArrays(action);
         }
+        else if (colorsChanged || render.needColorUpdate(action)) {
+            generateGLColors(action);
+        }
 
         if (render.matchMaterial(state)) {
             SoMaterialBundle mb(action);
@@ -715,17 +829,104 @@ void SoFCIndexedFaceSet::drawCoords(const SoGLCoordinateElement* const vertexlis
 
 void SoFCIndexedFaceSet::invalidate()
 {
+    updateGeometry = true;
     updateGLArray.setValue(true);
+    levelOfDetail.reset();
+}
+
+void SoFCIndexedFaceSet::buildLevelOfDetail(const MeshCore::MeshKernel& mesh)
+{
+    // the thread keeps its own reference, so the hierarchy can be dropped while it's built
+    auto lod = std::make_shared<MeshCore::MeshLevelOfDetail>(mesh);
+    levelOfDetail = lod;
+    (void)QtConcurrent::run([lod]() {
+        lod->Build();
+    });
+}
+
+bool SoFCIndexedFaceSet::renderLevelOfDetail(SoGLRenderAction* action)
+{
+    std::shared_ptr<const MeshCore::MeshLevelOfDetail> lod = levelOfDetail;
+    SoState* state = action->getState();
+    if (!lod || !lod->IsReady()
+        || SoMaterialBindingElement::get(state) != SoMaterialBindingElement::OVERALL) {
+        return false;
+    }
+
+    // select the coarsest level of each visible cluster whose error is below a pixel or two
+    const float maxPixelError = 1.5F;
+    const SbViewVolume& vv = SoViewVolumeElement::get(state);
+    const SbMatrix& mat = SoModelMatrixElement::get(state);
+    const SbViewportRegion& vp = SoViewportRegionElement::get(state);
+    const float width = std::max<float>(vp.getViewportSizePixels()[0], 1.0F);
+
+    std::vector<std::pair<unsigned int, std::size_t>> clusters;
+    for (std::size_t i = 0; i < lod->CountClusters(); i++) {
+        const Base::BoundBox3f& bbox = lod->GetBoundBox(i);
+        SbBox3f box(bbox.MinX, bbox.MinY, bbox.MinZ, bbox.MaxX, bbox.MaxY, bbox.MaxZ);
+        if (SoCullElement::cullBox(state, box)) {
+            continue;
+        }
+
+        SbVec3f center = box.getCenter();
+        mat.multVecMatrix(center, center);
+        float pixelSize = vv.getWorldToScreenScale(center, 1.0F) / width;
+        clusters.emplace_back(lod->SelectLevel(i, maxPixelError * pixelSize), i);
+    }
+    std::sort(clusters.begin(), clusters.end());
+
+    SoMaterialBundle mb(action);
+    mb.sendFirst();
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    unsigned int current = lod->CountLevels();
+    for (const auto& [level, cluster] : clusters) {
+        if (level != current) {
+            current = level;
+            glVertexPointer(3, GL_FLOAT, 0, lod->GetPoints(level).data());
+            glNormalPointer(GL_FLOAT, 0, lod->GetNormals(level).data());
+        }
+        const MeshCore::MeshLevelOfDetail::Range& range = lod->GetRange(cluster, level);
+        if (range.count > 0) {
+            glDrawElements(GL_TRIANGLES,
+                           static_cast<GLsizei>(3 * range.count),
+                           GL_UNSIGNED_INT,
+                           lod->GetIndices(level).data() + 3 * range.first);
+        }
+    }
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    return true;
 }
 
+namespace
+{
+MeshRenderer::Vertex makeVertex(const SbVec3f& normal, const SbVec3f& point)
+{
+    MeshRenderer::Vertex vertex {};
+    float length = normal.length();
+    float scale = length > 0.0F ? 32767.0F / length : 0.0F;
+    for (int i = 0; i < 3; i++) {
+        vertex.normal[i] = static_cast<int16_t>(std::lround(normal[i] * scale));
+        vertex.point[i] = point[i];
+    }
+    return vertex;
+}
+
+uint8_t toByte(float value)
+{
+    return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0F, 1.0F) * 255.0F));
+}
+}  // namespace
+
 void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction* action)
 {
     const SoCoordinateElement* coords = nullptr;
     const SbVec3f* normals = nullptr;
     const int32_t* cindices = nullptr;
-    const SbColor* pcolors = nullptr;
-    const float* transp = nullptr;
-    int numindices = 0, numcolors = 0, numtransp = 0;
+    int numindices = 0;
     const int32_t* nindices = nullptr;
     const int32_t* tindices = nullptr;
     const int32_t* mindices = nullptr;
@@ -747,157 +948,32 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction* action)
 
     const SbVec3f* points = coords->getArrayPtr3();
 
-    SoMaterialBindingElement::Binding matbind = SoMaterialBindingElement::get(state);
-    SoGLLazyElement* gl = SoGLLazyElement::getInstance(state);
-    if (gl) {
-        pcolors = gl->getDiffusePointer();
-        numcolors = gl->getNumDiffuse();
-        transp = gl->getTransparencyPointer();
-        numtransp = gl->getNumTransparencies();
-        (void)numtransp;
-    }
-
-    std::vector<float> face_vertices;
+    std::vector<MeshRenderer::Vertex> face_vertices;
     std::vector<int32_t> face_indices;
 
     std::size_t numTria = numindices / 4;
 
-    if (!mindices && matbind == SoMaterialBindingElement::PER_VERTEX_INDEXED) {
-        mindices = cindices;
-    }
-
     SoNormalBindingElement::Binding normbind = SoNormalBindingElement::get(state);
     if (normbind == SoNormalBindingElement::PER_VERTEX_INDEXED) {
-        if (matbind == SoMaterialBindingElement::PER_FACE) {
-            face_vertices.reserve(3 * numTria
-                                  * 10);  // duplicate each vertex (rgba, normal, vertex)
-            face_indices.resize(3 * numTria);
-
-            if (numcolors != static_cast<int>(numTria)) {
-                SoDebugError::postWarning(
-                    "SoFCIndexedFaceSet::generateGLArrays",
-                    "The number of faces (%d) does not match with the number of colors (%d).",
-                    numTria,
-                    numcolors);
-            }
+        // duplicate each vertex, the vertices are drawn in order without an index buffer
+        face_vertices.reserve(3 * numTria);
 
-            // the nindices must have the length of numindices
-            int32_t vertex = 0;
-            int index = 0;
-            float t = transp ? transp[0] : 0;
-            for (std::size_t i = 0; i < numTria; i++) {
-                const SbColor& c = pcolors[i];
-                for (int j = 0; j < 3; j++) {
-                    face_vertices.push_back(c[0]);
-                    face_vertices.push_back(c[1]);
-                    face_vertices.push_back(c[2]);
-                    face_vertices.push_back(t);
-
-                    const SbVec3f& n = normals[nindices[index]];
-                    face_vertices.push_back(n[0]);
-                    face_vertices.push_back(n[1]);
-                    face_vertices.push_back(n[2]);
-
-                    const SbVec3f& p = points[cindices[index]];
-                    face_vertices.push_back(p[0]);
-                    face_vertices.push_back(p[1]);
-                    face_vertices.push_back(p[2]);
-
-                    face_indices[vertex] = vertex;
-                    vertex++;
-                    index++;
-                }
-                index++;
-            }
-        }
-        else if (matbind == SoMaterialBindingElement::PER_VERTEX_INDEXED) {
-            face_vertices.reserve(3 * numTria
-                                  * 10);  // duplicate each vertex (rgba, normal, vertex)
-            face_indices.resize(3 * numTria);
-
-            if (numcolors != coords->getNum()) {
-                SoDebugError::postWarning(
-                    "SoFCIndexedFaceSet::generateGLArrays",
-                    "The number of points (%d) does not match with the number of colors (%d).",
-                    coords->getNum(),
-                    numcolors);
-            }
-
-            // the nindices must have the length of numindices
-            int32_t vertex = 0;
-            int index = 0;
-            float t = transp ? transp[0] : 0;
-            for (std::size_t i = 0; i < numTria; i++) {
-                for (int j = 0; j < 3; j++) {
-                    const SbColor& c = pcolors[mindices[index]];
-                    face_vertices.push_back(c[0]);
-                    face_vertices.push_back(c[1]);
-                    face_vertices.push_back(c[2]);
-                    face_vertices.push_back(t);
-
-                    const SbVec3f& n = normals[nindices[index]];
-                    face_vertices.push_back(n[0]);
-                    face_vertices.push_back(n[1]);
-                    face_vertices.push_back(n[2]);
-
-                    const SbVec3f& p = points[cindices[index]];
-                    face_vertices.push_back(p[0]);
-                    face_vertices.push_back(p[1]);
-                    face_vertices.push_back(p[2]);
-
-                    face_indices[vertex] = vertex;
-                    vertex++;
-                    index++;
-                }
-                index++;
-            }
-        }
-        else {
-            // only an overall material
-            matbind = SoMaterialBindingElement::OVERALL;
-
-            face_vertices.reserve(3 * numTria * 6);  // duplicate each vertex (normal, vertex)
-            face_indices.resize(3 * numTria);
-
-            // the nindices must have the length of numindices
-            int32_t vertex = 0;
-            int index = 0;
-            for (std::size_t i = 0; i < numTria; i++) {
-                for (int j = 0; j < 3; j++) {
-                    const SbVec3f& n = normals[nindices[index]];
-                    face_vertices.push_back(n[0]);
-                    face_vertices.push_back(n[1]);
-                    face_vertices.push_back(n[2]);
-
-                    const SbVec3f& p = points[cindices[index]];
-                    face_vertices.push_back(p[0]);
-                    face_vertices.push_back(p[1]);
-                    face_vertices.push_back(p[2]);
-
-                    face_indices[vertex] = vertex;
-                    vertex++;
-                    index++;
-                }
+        // the nindices must have the length of numindices
+        int index = 0;
+        for (std::size_t i = 0; i < numTria; i++) {
+            for (int j = 0; j < 3; j++) {
+                const SbVec3f& n = normals[nindices[index]];
+                face_vertices.push_back(makeVertex(n, points[cindices[index]]));
                 index++;
             }
+            index++;
         }
     }
     else if (normbind == SoNormalBindingElement::PER_VERTEX) {
-        // only an overall material
-        matbind = SoMaterialBindingElement::OVERALL;
-
         std::size_t numPts = coords->getNum();
-        face_vertices.reserve(6 * numPts);
+        face_vertices.reserve(numPts);
         for (std::size_t i = 0; i < numPts; i++) {
-            const SbVec3f& n = normals[i];
-            face_vertices.push_back(n[0]);
-            face_vertices.push_back(n[1]);
-            face_vertices.push_back(n[2]);
-
-            const SbVec3f& p = coords->get3(i);
-            face_vertices.push_back(p[0]);
-            face_vertices.push_back(p[1]);
-            face_vertices.push_back(p[2]);
+            face_vertices.push_back(makeVertex(normals[i], coords->get3(i)));
         }
 
         face_indices.reserve(3 * numTria);
@@ -912,7 +988,7 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction* action)
         }
     }
 
-    render.generateGLArrays(action, matbind, face_vertices, face_indices);
+    render.generateGLArrays(action, face_vertices, face_indices);
 
     // getVertexData() internally calls readLockNormalCache() that read locks
     // the normal cache. When the cache is not needed any more we must call
@@ -920,6 +996,90 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction* action)
     if (normalCacheUsed) {
         this->readUnlockNormalCache();
     }
+
+    generateGLColors(action);
+}
+
+void SoFCIndexedFaceSet::generateGLColors(SoGLRenderAction* action)
+{
+    const SbColor* pcolors = nullptr;
+    const float* transp = nullptr;
+    int numcolors = 0;
+
+    SoState* state = action->getState();
+    SoMaterialBindingElement::Binding matbind = SoMaterialBindingElement::get(state);
+    SoGLLazyElement* gl = SoGLLazyElement::getInstance(state);
+    if (gl) {
+        pcolors = gl->getDiffusePointer();
+        numcolors = gl->getNumDiffuse();
+        transp = gl->getTransparencyPointer();
+    }
+
+    // colors require a vertex per facet corner
+    if (SoNormalBindingElement::get(state) != SoNormalBindingElement::PER_VERTEX_INDEXED
+        || !pcolors || numcolors <= 0) {
+        matbind = SoMaterialBindingElement::OVERALL;
+    }
+
+    std::vector<uint8_t> face_colors;
+    const int32_t* cindices = this->coordIndex.getValues(0);
+    std::size_t numTria = this->coordIndex.getNum() / 4;
+    uint8_t alpha = toByte(transp ? transp[0] : 0);
+    auto addColor = [&face_colors, alpha](const SbColor& c) {
+        face_colors.push_back(toByte(c[0]));
+        face_colors.push_back(toByte(c[1]));
+        face_colors.push_back(toByte(c[2]));
+        face_colors.push_back(alpha);
+    };
+
+    if (matbind == SoMaterialBindingElement::PER_FACE) {
+        if (numcolors != static_cast<int>(numTria)) {
+            SoDebugError::postWarning(
+                "SoFCIndexedFaceSet::generateGLColors",
+                "The number of faces (%d) does not match with the number of colors (%d).",
+                numTria,
+                numcolors);
+        }
+
+        face_colors.reserve(12 * numTria);
+        for (std::size_t i = 0; i < numTria; i++) {
+            const SbColor& c = pcolors[std::min<std::size_t>(i, numcolors - 1)];
+            for (int j = 0; j < 3; j++) {
+                addColor(c);
+            }
+        }
+    }
+    else if (matbind == SoMaterialBindingElement::PER_VERTEX_INDEXED) {
+        const int32_t* mindices = cindices;
+        if (this->materialIndex.getNum() > 0 && this->materialIndex[0] >= 0) {
+            mindices = this->materialIndex.getValues(0);
+        }
+
+        int numPts = SoCoordinateElement::getInstance(state)->getNum();
+        if (numcolors != numPts) {
+            SoDebugError::postWarning(
+                "SoFCIndexedFaceSet::generateGLColors",
+                "The number of points (%d) does not match with the number of colors (%d).",
+                numPts,
+                numcolors);
+        }
+
+        face_colors.reserve(12 * numTria);
+        int index = 0;
+        for (std::size_t i = 0; i < numTria; i++) {
+            for (int j = 0; j < 3; j++) {
+                addColor(pcolors[std::min(mindices[index], numcolors - 1)]);
+                index++;
+            }
+            index++;
+        }
+    }
+    else {
+        // only an overall material
+        matbind = SoMaterialBindingElement::OVERALL;
+    }
+
+    render.generateGLColors(action, matbind, face_colors);
 }
 
 void SoFCIndexedFaceSet::doAction(SoAction* action)
@@ -27,6 +27,8 @@
 #include <Inventor/fields/SoMFColor.h>
 #include <Inventor/fields/SoSFBool.h>
 #include <Inventor/nodes/SoIndexedFaceSet.h>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #ifndef MESH_GLOBAL_H
 #include <Mod/Mesh/MeshGlobal.h>
@@ -36,6 +38,12 @@
 class SoGLCoordinateElement;
 class SoTextureCoordinateBundle;
 
+namespace MeshCore
+{
+class MeshKernel;
+class MeshLevelOfDetail;
+}  // namespace MeshCore
+
 using GLuint = unsigned int;
 using GLint = int;
 using GLfloat = float;
@@ -47,18 +55,31 @@ namespace MeshGui
 class MeshRenderer
 {
 public:
+    /// A vertex of the geometry buffer with a normal quantized to 16 bits per component
+    struct Vertex
+    {
+        int16_t normal[4];  // the fourth component keeps the point aligned
+        float point[3];
+    };
+
     MeshRenderer();
     ~MeshRenderer();
+    /// Uploads the geometry, an empty \a index means that no vertex is shared
     void generateGLArrays(SoGLRenderAction*,
-                          SoMaterialBindingElement::Binding binding,
-                          std::vector<float>& vertex,
+                          std::vector<Vertex>& vertex,
                           std::vector<int32_t>& index);
+    /// Uploads four bytes of RGBA per vertex, the geometry is kept
+    void generateGLColors(SoGLRenderAction*,
+                          SoMaterialBindingElement::Binding binding,
+                          std::vector<uint8_t>& color);
     void renderFacesGLArray(SoGLRenderAction* action);
     void renderCoordsGLArray(SoGLRenderAction* action);
     bool canRenderGLArray(SoGLRenderAction* action) const;
     bool matchMaterial(SoState*) const;
     void update();
+    void updateColors();
     bool needUpdate(SoGLRenderAction* action);
+    bool needColorUpdate(SoGLRenderAction* action);
     static bool shouldRenderDirectly(bool);
 
 private:
@@ -111,6 +132,9 @@ public:
     unsigned int renderTriangleLimit;
 
     void invalidate();
+    /// Builds a level of detail hierarchy of \a mesh in the background that is used during
+    /// interaction if the mesh has more than renderTriangleLimit facets
+    void buildLevelOfDetail(const MeshCore::MeshKernel& mesh);
 
 protected:
     // Force using the reference count mechanism.
@@ -139,10 +163,14 @@ private:
     void renderVisibleFaces(const SbVec3f*);
 
     void generateGLArrays(SoGLRenderAction* action);
+    void generateGLColors(SoGLRenderAction* action);
+    bool renderLevelOfDetail(SoGLRenderAction* action);
 
 private:
     MeshRenderer render;
+    std::shared_ptr<MeshCore::MeshLevelOfDetail> levelOfDetail;
     GLuint* selectBuf {nullptr};
+    bool updateGeometry {true};
 };
 // NOLINTEND
 
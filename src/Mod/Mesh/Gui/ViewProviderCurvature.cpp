@@ -369,11 +369,11 @@ void ViewProviderMeshCurvature::setVertexCurvatureMode(int mode)
     SbColor* diffcol = pcColorMat->diffuseColor.startEditing();
     float* transp = pcColorMat->transparency.startEditing();
 
-    for (auto const& value : fValues | boost::adaptors::indexed(0)) {
-        Base::Color c = pcColorBar->getColor(value.value());
+    std::vector<uint32_t> colors(fValues.size());
+    pcColorBar->getPackedColors(fValues.data(), fValues.size(), colors.data());
+    for (auto const& value : colors | boost::adaptors::indexed(0)) {
         // NOLINTBEGIN
-        diffcol[value.index()].setValue(c.r, c.g, c.b);
-        transp[value.index()] = c.transparency();
+        diffcol[value.index()].setPackedValue(value.value(), transp[value.index()]);
         // NOLINTEND
     }
 
@@ -112,6 +112,9 @@ void ViewProviderMeshFaceSet::updateData(const App::Property* prop)
             ViewProviderMeshBuilder builder;
             builder.createMesh(prop, pcMeshCoord, pcMeshFaces);
             pcMeshFaces->invalidate();
+            if (mesh->countFacets() > pcMeshFaces->renderTriangleLimit) {
+                pcMeshFaces->buildLevelOfDetail(mesh->getKernel());
+            }
         }
 
         if (direct != directRendering) {
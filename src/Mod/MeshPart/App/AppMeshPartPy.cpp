@@ -139,6 +139,24 @@ public:
             "    SegPerEdge (optional, float)\n"
             "    SegPerRadius (optional, float)\n"
         );
+        add_keyword_method("meshFromShapes",&Module::meshFromShapes,
+            "Create one surface mesh from many shapes with the standard mesher\n"
+            "\n"
+            "    meshFromShapes(Shapes, LinearDeflection,\n"
+            "                           AngularDeflection=0.5,\n"
+            "                           Relative=False,\n"
+            "                           Segments=False)\n"
+            "\n"
+            "The shapes are meshed on several threads. Shapes that only differ in\n"
+            "their placement, like the shapes of link instances, are meshed once.\n"
+            "\n"
+            "Args:\n"
+            "    Shapes (required, list of topology) - TopoShapes to create the mesh of.\n"
+            "    LinearDeflection (required, float)\n"
+            "    AngularDeflection (optional, float)\n"
+            "    Relative (optional, boolean)\n"
+            "    Segments (optional, boolean)\n"
+        );
         initialize("This module is the MeshPart module."); // register with Python
     }
 
@@ -640,6 +658,48 @@ private:
 
         throw Py::TypeError("Wrong arguments");
     }
+    Py::Object meshFromShapes(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        static const std::array<const char *, 6> kwds_shapes{"Shapes", "LinearDeflection", "AngularDeflection",
+                                                             "Relative", "Segments", nullptr};
+        PyObject* shapes;
+        double lindeflection=0;
+        double angdeflection=0.5;
+        PyObject* relative = Py_False;
+        PyObject* segment = Py_False;
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "Od|dO!O!", kwds_shapes,
+                                                 &shapes, &lindeflection, &angdeflection,
+                                                 &(PyBool_Type), &relative, &(PyBool_Type), &segment)) {
+            throw Py::Exception();
+        }
+
+        std::vector<MeshPart::Mesher::Instance> instances;
+        Py::Sequence list(shapes);
+        instances.reserve(list.size());
+        for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+            if (!PyObject_TypeCheck((*it).ptr(), &(Part::TopoShapePy::Type))) {
+                throw Py::TypeError("Shapes must be a list of shapes");
+            }
+            MeshPart::Mesher::Instance instance;
+            instance.shape = static_cast<Part::TopoShapePy*>((*it).ptr())->getTopoShapePtr()->getShape();
+            instances.push_back(instance);
+        }
+
+        MeshPart::Mesher mesher;
+        mesher.setMethod(MeshPart::Mesher::Standard);
+        mesher.setDeflection(lindeflection);
+        mesher.setAngularDeflection(angdeflection);
+        mesher.setRegular(true);
+        mesher.setRelative(Base::asBoolean(relative));
+        mesher.setSegments(Base::asBoolean(segment));
+
+        Mesh::MeshObject* mesh;
+        {
+            Base::PyGILStateRelease releaser{};
+            mesh = mesher.createMesh(instances);
+        }
+        return Py::asObject(new Mesh::MeshPy(mesh));
+    }
 };
 
 PyObject* initModule()
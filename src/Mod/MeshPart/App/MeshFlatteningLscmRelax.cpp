@@ -22,17 +22,17 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <iostream>
 #include <map>
 #include <numbers>
 #include <set>
+#include <thread>
 #include <vector>
 #endif
 
-#include <Eigen/SparseCholesky>
-
 #include "MeshFlatteningLscmRelax.h"
 
 
@@ -47,6 +47,59 @@ namespace lscmrelax
 using trip = Eigen::Triplet<double>;
 using spMat = Eigen::SparseMatrix<double>;
 
+namespace
+{
+
+// the triplets and the rhs assembled by one thread
+struct Assembly
+{
+    std::vector<trip> triplets;
+    Eigen::VectorXd rhs;
+};
+
+// Runs func(first, last, assembly) on contiguous ranges of [0, size) on several threads. Every
+// range gets its own assembly so there is no locking, the results are merged afterwards in a
+// fixed order so the outcome doesn't depend on the number of threads.
+template<typename Func>
+void assemble(long size, long rhs_size, long triplets_per_item, Func func,
+              std::vector<trip> & triplets, Eigen::VectorXd & rhs)
+{
+    const long min_chunk = 4096;
+    long threads = std::min<long>(std::max(1U, std::thread::hardware_concurrency()),
+                                  std::max<long>(1, size / min_chunk));
+    long chunk = (size + threads - 1) / threads;
+
+    std::vector<Assembly> assemblies(threads);
+    auto run = [&](long t)
+    {
+        long first = std::min(size, t * chunk);
+        long last = std::min(size, first + chunk);
+        Assembly & assembly = assemblies[t];
+        assembly.triplets.reserve((last - first) * triplets_per_item);
+        assembly.rhs.setZero(rhs_size);
+        func(first, last, assembly);
+    };
+    std::vector<std::thread> workers;
+    for (long t = 1; t < threads; t++)
+        workers.emplace_back(run, t);
+    run(0);
+    for (auto & worker : workers)
+        worker.join();
+
+    std::size_t count = triplets.size();
+    for (const auto & assembly : assemblies)
+        count += assembly.triplets.size();
+    triplets.reserve(count);
+    rhs.setZero(rhs_size);
+    for (const auto & assembly : assemblies)
+    {
+        triplets.insert(triplets.end(), assembly.triplets.begin(), assembly.triplets.end());
+        rhs += assembly.rhs;
+    }
+}
+
+}
+
 
 
 ColMat<double, 2> map_to_2D(ColMat<double, 3> points)
@@ -145,23 +198,26 @@ LscmRelax::LscmRelax(
 void LscmRelax::relax(double weight)
 {
     ColMat<double, 3> d_q_l_g = this->q_l_m - this->q_l_g;
+    Eigen::VectorXd rhs;
+    if (this->sol.size() == 0)
+        this->sol.Zero(this->vertices.cols() * 2 + 3);
+    spMat K_g(this->vertices.cols() * 2 + 3, this->vertices.cols() * 2 + 3);
+    std::vector<trip> K_g_triplets;
+
     // for every triangle
+    auto assemble_triangles = [this, &d_q_l_g](long first, long last, Assembly & assembly)
+    {
     Eigen::Matrix<double, 3, 6> B;
     Eigen::Matrix<double, 2, 2> T;
     Eigen::Matrix<double, 6, 6> K_m;
     Eigen::Matrix<double, 6, 1> u_m, rhs_m;
-    Eigen::VectorXd rhs(this->vertices.cols() * 2 + 3);
-    if (this->sol.size() == 0)
-        this->sol.Zero(this->vertices.cols() * 2 + 3);
-    spMat K_g(this->vertices.cols() * 2 + 3, this->vertices.cols() * 2 + 3);
-    std::vector<trip> K_g_triplets;
+    Eigen::VectorXd & rhs = assembly.rhs;
+    std::vector<trip> & K_g_triplets = assembly.triplets;
     Vector2 v1, v2, v3, v12, v23, v31;
     long row_pos, col_pos;
     double A;
 
-    rhs.setZero();
-
-    for (long i=0; i<this->triangles.cols(); i++)
+    for (long i=first; i<last; i++)
     {
         // 1: construct B-mat in m-system
         v1 = this->flat_vertices.col(this->triangles(0, i));
@@ -204,6 +260,9 @@ void LscmRelax::relax(double weight)
             }
         }
     }
+    };
+    assemble(this->triangles.cols(), this->vertices.cols() * 2 + 3, 36, assemble_triangles,
+             K_g_triplets, rhs);
     // FIXING SOME PINS:
     // - if there are no pins (or only one pin) selected solve the system without the nullspace solution.
     // - if there are some pins selected, delete all columns, rows that refer to this pins
@@ -283,9 +342,17 @@ void LscmRelax::relax(double weight)
     // rhs +=  K_g * Eigen::VectorXd::Ones(K_g.rows());
 
     // solve linear system (privately store the value for guess in next step)
-    Eigen::SimplicialLDLT<spMat, Eigen::Lower> solver;
-    solver.compute(K_g);
-    this->sol = solver.solve(-rhs);
+    // the sparsity pattern only depends on the triangles, so the symbolic analysis
+    // of the previous step can be reused and only the numeric factorization is redone
+    if (!this->reuse_factorization || !this->relax_solver ||
+        this->relax_solver->rows() != K_g.rows() || this->relax_non_zeros != K_g.nonZeros())
+    {
+        this->relax_solver = std::make_shared<Eigen::SimplicialLDLT<spMat, Eigen::Lower>>();
+        this->relax_solver->analyzePattern(K_g);
+        this->relax_non_zeros = K_g.nonZeros();
+    }
+    this->relax_solver->factorize(K_g);
+    this->sol = this->relax_solver->solve(-rhs);
     this->set_shift(this->sol.head(this->vertices.cols() * 2) * weight);
     this->set_q_l_m();
 }
@@ -370,12 +437,17 @@ void LscmRelax::edge_relax(double weight)
     if (this->sol.size() == 0)
         this->sol.Zero(this->vertices.cols());
 
+    std::vector<std::array<long, 2>> edge_list(edges.begin(), edges.end());
     std::vector<trip> K_g_triplets;
     spMat K_g(this->vertices.cols() * 2, this->vertices.cols() * 2);
-    Eigen::VectorXd rhs(this->vertices.cols() * 2);
-    rhs.setZero();
-    for(auto edge : edges)
+    Eigen::VectorXd rhs;
+    auto assemble_edges = [this, &edge_list](long first, long last, Assembly & assembly)
+    {
+    Eigen::VectorXd & rhs = assembly.rhs;
+    std::vector<trip> & K_g_triplets = assembly.triplets;
+    for(long i = first; i < last; i++)
     {
+	const std::array<long, 2> & edge = edge_list[i];
 // 	this goes to the right side
 	Vector3 v1_g = this->vertices.col(edge[0]);
 	Vector3 v2_g = this->vertices.col(edge[1]);
@@ -406,6 +478,9 @@ void LscmRelax::edge_relax(double weight)
 	    rhs(indices[row]) += rhs_m[row];
 	}
     }
+    };
+    assemble(static_cast<long>(edge_list.size()), this->vertices.cols() * 2, 16, assemble_edges,
+             K_g_triplets, rhs);
 
     K_g.setFromTriplets(K_g_triplets.begin(), K_g_triplets.end());
     Eigen::ConjugateGradient<spMat,Eigen::Lower, NullSpaceProjector> solver;
@@ -427,6 +502,7 @@ void LscmRelax::lscm()
     double x21, x31, y31, x32;
 
     // 1. create the triplet list (t * 2, v * 2)
+    triple_list.reserve(this->triangles.cols() * 10);
     for(i=0; i<this->triangles.cols(); i++)
     {
         x21 = this->q_l_g(i, 0);
@@ -479,10 +555,13 @@ void LscmRelax::lscm()
 
     // 6. solve the system and set the flatted coordinates
     // Eigen::SparseQR<spMat, Eigen::COLAMDOrdering<int> > solver;
-    Eigen::LeastSquaresConjugateGradient<spMat > solver;
+    // the pins make A full rank, so the normal equations are positive definite and a sparse
+    // cholesky solves them directly instead of iterating over the least squares system
+    spMat AtA = A.transpose() * A;
+    Eigen::SimplicialLDLT<spMat> solver;
     Eigen::VectorXd sol(this->vertices.size() * 2);
-    solver.compute(A);
-    sol = solver.solve(-rhs);
+    solver.compute(AtA);
+    sol = solver.solve(A.transpose() * -rhs);
 
     // TODO: create function, is needed also in the fem step
     this->set_position(sol);
@@ -698,7 +777,7 @@ std::vector<long> LscmRelax::get_fem_fixed_pins()
 Eigen::MatrixXd LscmRelax::get_nullspace()
 {
     Eigen::MatrixXd null_space;
-    null_space.setZero(this->flat_vertices.size() * 2, 3);
+    null_space.setZero(this->flat_vertices.cols() * 2, 3);
 
     for (int i=0; i<this->flat_vertices.cols(); i++)
     {
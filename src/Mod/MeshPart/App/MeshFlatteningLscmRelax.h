@@ -40,6 +40,8 @@
 #include <tuple>
 #include <vector>
 
+#include <Eigen/SparseCholesky>
+
 #include "MeshFlattening.h"
 
 
@@ -48,17 +50,26 @@ using spMat = Eigen::SparseMatrix<double>;
 namespace lscmrelax
 {
 
-class NullSpaceProjector: public Eigen::IdentityPreconditioner
+// Jacobi preconditioner that keeps the residual out of the nullspace of a singular system
+class NullSpaceProjector: public Eigen::DiagonalPreconditioner<double>
 {
   public:
     Eigen::MatrixXd null_space_1;
     Eigen::MatrixXd null_space_2;
 
     template<typename Rhs>
-    inline Rhs solve(Rhs& b) const {
+    inline Rhs project(const Rhs& b) const {
         return b - this->null_space_1 * (this->null_space_2 * b);
     }
 
+    template<typename Rhs>
+    inline Rhs solve(Rhs& b) const {
+        // project before and after the scaling to keep the preconditioner symmetric
+        Rhs x = this->project(b);
+        x = this->m_invdiag.array() * x.array();
+        return this->project(x);
+    }
+
     void setNullSpace(Eigen::MatrixXd null_space) {
         // normalize + orthogonalize the nullspace
         this->null_space_1 = null_space * ((null_space.transpose() * null_space).inverse());
@@ -86,6 +97,10 @@ private:
     Eigen::Matrix<double, 3, 3> C;
     Eigen::VectorXd sol;
 
+    // the factorization of the relax step and the number of non-zeros it was analyzed for
+    std::shared_ptr<Eigen::SimplicialLDLT<spMat, Eigen::Lower>> relax_solver;
+    long relax_non_zeros = 0;
+
     std::vector<long> get_fem_fixed_pins();
     Eigen::MatrixXd get_nullspace();
 
@@ -105,6 +120,8 @@ public:
 
     double nue=0.9;
     double elasticity=1.;
+    // reuse the symbolic factorization of the stiffness matrix between the relax steps
+    bool reuse_factorization=true;
 
     void lscm();
     void relax(double);
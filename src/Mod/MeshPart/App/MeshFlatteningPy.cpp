@@ -111,6 +111,7 @@ PYBIND11_MODULE(flatmesh, m)
         .def("relax", &lscmrelax::LscmRelax::relax)
         .def("rotate_by_min_bound_area", &lscmrelax::LscmRelax::rotate_by_min_bound_area)
         .def("transform", &lscmrelax::LscmRelax::transform)
+        .def_readwrite("reuse_factorization", &lscmrelax::LscmRelax::reuse_factorization)
         .def_readonly("rhs", &lscmrelax::LscmRelax::rhs)
         .def_readonly("MATRIX", &lscmrelax::LscmRelax::MATRIX)
         .def_property_readonly("area", &lscmrelax::LscmRelax::get_area)
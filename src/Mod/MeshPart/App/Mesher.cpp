@@ -23,11 +23,19 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <map>
+#include <memory>
+#include <numeric>
 
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <BRepTools.hxx>
+#include <BRep_Builder.hxx>
 #include <Standard_Version.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS_Compound.hxx>
 #include <TopoDS_Shape.hxx>
+
+#include <QtConcurrentMap>
 #endif
 
 #include <Base/Console.h>
@@ -215,31 +223,175 @@ public:
 
 // ----------------------------------------------------------------------------
 
+namespace
+{
+
+const TopoDS_Shape& nullShape()
+{
+    static const TopoDS_Shape shape;
+    return shape;
+}
+
+// A mesh of the batch and the placement of one of its instances
+using PlacedMesh = std::pair<const Mesh::MeshObject*, Base::Matrix4D>;
+
+Mesh::MeshObject* mergeMeshes(const std::vector<PlacedMesh>& instances)
+{
+    // the offsets of every instance in the merged arrays, so they can be filled in parallel
+    std::vector<MeshCore::PointIndex> pointOffsets(instances.size() + 1, 0);
+    std::vector<MeshCore::FacetIndex> facetOffsets(instances.size() + 1, 0);
+    for (std::size_t i = 0; i < instances.size(); i++) {
+        const MeshCore::MeshKernel& kernel = instances[i].first->getKernel();
+        pointOffsets[i + 1] = pointOffsets[i] + kernel.CountPoints();
+        facetOffsets[i + 1] = facetOffsets[i] + kernel.CountFacets();
+    }
+
+    MeshCore::MeshPointArray points(pointOffsets.back());
+    MeshCore::MeshFacetArray facets(facetOffsets.back());
+    std::vector<std::size_t> indices(instances.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    QtConcurrent::blockingMap(indices, [&](std::size_t index) {
+        const MeshCore::MeshKernel& kernel = instances[index].first->getKernel();
+        const Base::Matrix4D& mat = instances[index].second;
+        MeshCore::PointIndex pointOffset = pointOffsets[index];
+        MeshCore::FacetIndex facetOffset = facetOffsets[index];
+
+        const MeshCore::MeshPointArray& pts = kernel.GetPoints();
+        for (std::size_t i = 0; i < pts.size(); i++) {
+            points[pointOffset + i] = mat * pts[i];
+        }
+
+        // a mirroring placement turns the facets inside out
+        bool flip = mat.determinant3() < 0.0;
+        const MeshCore::MeshFacetArray& faces = kernel.GetFacets();
+        for (std::size_t i = 0; i < faces.size(); i++) {
+            MeshCore::MeshFacet face = faces[i];
+            for (int j = 0; j < 3; j++) {
+                face._aulPoints[j] += pointOffset;
+                if (face._aulNeighbours[j] != MeshCore::FACET_INDEX_MAX) {
+                    face._aulNeighbours[j] += facetOffset;
+                }
+            }
+            if (flip) {
+                face.FlipNormal();
+            }
+            facets[facetOffset + i] = face;
+        }
+    });
+
+    // the neighbourhood is already set up
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, false);
+
+    auto meshdata = new Mesh::MeshObject();
+    meshdata->swap(kernel);
+    for (std::size_t i = 0; i < instances.size(); i++) {
+        const Mesh::MeshObject* mesh = instances[i].first;
+        for (unsigned long j = 0; j < mesh->countSegments(); j++) {
+            std::vector<MeshCore::FacetIndex> segm = mesh->getSegment(j).getIndices();
+            for (auto& index : segm) {
+                index += facetOffsets[i];
+            }
+            meshdata->addSegment(segm);
+        }
+    }
+    return meshdata;
+}
+
+}  // namespace
+
+Mesher::Mesher()
+    : shape(nullShape())
+{}
+
 Mesher::Mesher(const TopoDS_Shape& s)
     : shape(s)
 {}
 
 Mesher::~Mesher() = default;
 
-Mesh::MeshObject* Mesher::createStandard() const
+Mesh::MeshObject* Mesher::createStandard(const TopoDS_Shape& part) const
 {
-    if (!shape.IsNull()) {
-        BRepTools::Clean(shape);
-        BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection);
+    if (!part.IsNull()) {
+        BRepTools::Clean(part);
+        BRepMesh_IncrementalMesh aMesh(part, deflection, relative, angularDeflection);
     }
 
     std::vector<Part::TopoShape::Domain> domains;
-    Part::TopoShape(shape).getDomains(domains);
+    Part::TopoShape(part).getDomains(domains);
 
     BrepMesh brepmesh(this->segments, this->colors);
     return brepmesh.create(domains);
 }
 
+Mesh::MeshObject* Mesher::createMesh(const std::vector<Instance>& instances) const
+{
+    // Link instances share the TShape and only differ in their location, so mesh every
+    // shape once without its location and move the location into the placement
+    std::map<std::pair<const TopoDS_TShape*, TopAbs_Orientation>, std::size_t> shapeIndex;
+    std::vector<TopoDS_Shape> shapes;
+    std::vector<std::pair<std::size_t, Base::Matrix4D>> placements;
+    for (const auto& it : instances) {
+        if (it.shape.IsNull()) {
+            continue;
+        }
+        TopoDS_Shape origin = it.shape.Located(TopLoc_Location());
+        auto key = std::make_pair(origin.TShape().get(), origin.Orientation());
+        auto inserted = shapeIndex.emplace(key, shapes.size());
+        if (inserted.second) {
+            shapes.push_back(origin);
+        }
+        Base::Matrix4D mat = Part::TopoShape::convert(it.shape.Location().Transformation());
+        placements.emplace_back(inserted.first->second, it.placement * mat);
+    }
+
+    std::vector<std::unique_ptr<Mesh::MeshObject>> meshes(shapes.size());
+    if (method == Standard) {
+        // Triangulate all shapes in one go, OCC meshes the faces in parallel and a face
+        // shared by several shapes is only meshed once
+        TopoDS_Compound comp;
+        BRep_Builder builder;
+        builder.MakeCompound(comp);
+        for (const auto& it : shapes) {
+            builder.Add(comp, it);
+        }
+        BRepTools::Clean(comp);
+        BRepMesh_IncrementalMesh aMesh(comp, deflection, relative, angularDeflection, true);
+
+        // reading the triangulations doesn't modify the shapes
+        std::vector<std::size_t> indices(shapes.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        QtConcurrent::blockingMap(indices, [&](std::size_t index) {
+            std::vector<Part::TopoShape::Domain> domains;
+            Part::TopoShape(shapes[index]).getDomains(domains);
+            BrepMesh brepmesh(this->segments, {});
+            meshes[index].reset(brepmesh.create(domains));
+        });
+    }
+    else {
+        for (std::size_t i = 0; i < shapes.size(); i++) {
+            meshes[i].reset(meshShape(shapes[i]));
+        }
+    }
+
+    std::vector<PlacedMesh> placed;
+    placed.reserve(placements.size());
+    for (const auto& it : placements) {
+        placed.emplace_back(meshes[it.first].get(), it.second);
+    }
+    return mergeMeshes(placed);
+}
+
 Mesh::MeshObject* Mesher::createMesh() const
+{
+    return meshShape(shape);
+}
+
+Mesh::MeshObject* Mesher::meshShape(const TopoDS_Shape& part) const
 {
     // OCC standard mesher
     if (method == Standard) {
-        return createStandard();
+        return createStandard(part);
     }
 
 #ifndef HAVE_SMESH
@@ -404,9 +556,9 @@ Mesh::MeshObject* Mesher::createMesh() const
     std::streambuf* oldcout = std::cout.rdbuf(&stdcout);
 
     // Apply the hypothesis and create the mesh
-    mesh->ShapeToMesh(shape);
+    mesh->ShapeToMesh(part);
     for (int i = 0; i < hyp; i++) {
-        mesh->AddHypothesis(shape, i);
+        mesh->AddHypothesis(part, i);
     }
     meshgen->Compute(*mesh, mesh->GetShapeToMesh());
 
@@ -24,14 +24,17 @@
 #define MESHPART_MESHER_H
 
 #include <sstream>
+#include <vector>
 
+#include <TopoDS_Shape.hxx>
+
+#include <Base/Matrix.h>
 #include <Base/Stream.h>
 
 #ifdef HAVE_SMESH
 #include <SMESH_Version.h>
 #endif
 
-class TopoDS_Shape;
 class SMESH_Gen;
 class SMESH_Mesh;
 
@@ -55,6 +58,15 @@ public:
         Standard = 3
     };
 
+    /// A shape of a batch and the placement of this instance of it
+    struct Instance
+    {
+        TopoDS_Shape shape;
+        Base::Matrix4D placement;
+    };
+
+    /// Creates a mesher without a shape to mesh a batch of shapes
+    Mesher();
     explicit Mesher(const TopoDS_Shape&);
     ~Mesher();
 
@@ -212,9 +224,17 @@ public:
 #endif
 
     Mesh::MeshObject* createMesh() const;
+    /**
+     * Meshes all \a instances with the settings of this mesher and merges them into one mesh.
+     * Instances of a shape that only differ in their location are meshed once. The standard
+     * mesher works on several threads, the SMESH based methods mesh one shape after the other
+     * because they share global state. Group colors are not supported for batches.
+     */
+    Mesh::MeshObject* createMesh(const std::vector<Instance>& instances) const;
 
 private:
-    Mesh::MeshObject* createStandard() const;
+    Mesh::MeshObject* meshShape(const TopoDS_Shape&) const;
+    Mesh::MeshObject* createStandard(const TopoDS_Shape&) const;
     Mesh::MeshObject* createFrom(SMESH_Mesh*) const;
 
 private:
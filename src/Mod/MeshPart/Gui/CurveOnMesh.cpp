@@ -59,7 +59,7 @@
 #include <Gui/View3DInventor.h>
 #include <Gui/View3DInventorViewer.h>
 #include <Mod/Mesh/App/Core/Algorithm.h>
-#include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/App/Core/Projection.h>
 #include <Mod/Mesh/App/MeshFeature.h>
@@ -249,7 +249,7 @@ public:
     ~Private()
     {
         delete curve;
-        delete grid;
+        delete bvh;
     }
     static void vertexCallback(void* ud, SoEventCallback* n);
     std::vector<SbVec3f> convert(const std::vector<Base::Vector3f>& points) const
@@ -261,16 +261,13 @@ public:
         }
         return pts;
     }
-    void createGrid()
+    void createBVH()
     {
         Mesh::Feature* mf = mesh->getObject<Mesh::Feature>();
         const Mesh::MeshObject& meshObject = mf->Mesh.getValue();
         kernel = meshObject.getKernel();
         kernel.Transform(meshObject.getTransform());
-
-        MeshCore::MeshAlgorithm alg(kernel);
-        float fAvgLen = alg.GetAverageEdgeLength();
-        grid = new MeshCore::MeshFacetGrid(kernel, 5.0f * fAvgLen);
+        bvh = new MeshCore::MeshFacetBVH(kernel);
     }
     bool projectLineOnMesh(const PickedPoint& pick)
     {
@@ -282,7 +279,7 @@ public:
         Base::Vector3f v2 = Base::convertTo<Base::Vector3f>(pick.point);
         Base::Vector3f vd =
             Base::convertTo<Base::Vector3f>(viewer->getViewer()->getViewDirection());
-        if (meshProjection.projectLineOnMesh(*grid, v1, last.facet, v2, pick.facet, vd, polyline)) {
+        if (meshProjection.projectLineOnMesh(*bvh, v1, last.facet, v2, pick.facet, vd, polyline)) {
             if (polyline.size() > 1) {
                 if (cutLines.empty()) {
                     cutLines.push_back(polyline);
@@ -323,7 +320,7 @@ public:
     bool approximate {true};
     ViewProviderCurveOnMesh* curve;
     Gui::ViewProviderDocumentObject* mesh {0};
-    MeshCore::MeshFacetGrid* grid {nullptr};
+    MeshCore::MeshFacetBVH* bvh {nullptr};
     MeshCore::MeshKernel kernel;
     QPointer<Gui::View3DInventor> viewer;
     QCursor editcursor;
@@ -613,10 +610,10 @@ void CurveOnMeshHandler::Private::vertexCallback(void* ud, SoEventCallback* cb)
                             static_cast<MeshGui::ViewProviderMesh*>(vp);
                         const SoDetail* detail = pp->getDetail();
                         if (detail && detail->getTypeId() == SoFaceDetail::getClassTypeId()) {
-                            // get the mesh and build a grid
+                            // get the mesh and build the search structure
                             if (!self->d_ptr->mesh) {
                                 self->d_ptr->mesh = mesh;
-                                self->d_ptr->createGrid();
+                                self->d_ptr->createBVH();
                             }
                             else if (self->d_ptr->mesh != mesh) {
                                 Gui::getMainWindow()->statusBar()->showMessage(
@@ -25,6 +25,14 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <thread>
+#include <tuple>
 #include <Precision.hxx>
 #endif
 
@@ -34,217 +42,80 @@
 using namespace Part;
 
 namespace {
-struct MeshVertex
-{
-    Base::Vector3d p;
-    std::size_t i = 0;
 
-    explicit MeshVertex(const Base::Vector3d& p)
-        : p(p)
-    {
-    }
+/// Below this number of facets the domains are merged in the calling thread only
+constexpr std::size_t minParallelFacets = 20000;
 
-    Base::Vector3d toPoint() const
-    {
-        return p;
-    }
+/// A point of a domain with the cell of the grid of the weld tolerance it is in
+struct GridVertex
+{
+    std::array<std::int64_t, 3> cell;
+    uint32_t index;
 
-    bool operator < (const MeshVertex &v) const
+    bool operator<(const GridVertex& other) const
     {
-        if (p.x != v.p.x) {
-            return p.x < v.p.x;
-        }
-        if (p.y != v.p.y) {
-            return p.y < v.p.y;
-        }
-        if (p.z != v.p.z) {
-            return p.z < v.p.z;
-        }
-
-        // points are equal
-        return false;
+        // the index decides between points of a cell so that the result doesn't depend on
+        // the number of threads
+        return std::tie(cell, index) < std::tie(other.cell, other.index);
     }
 };
 
-class MergeVertex
+template<typename Func>
+void parallelFor(std::size_t count, std::size_t threads, Func func)
 {
-public:
-    using Facet = BRepMesh::Facet;
-
-    MergeVertex(std::vector<Base::Vector3d> points,
-                std::vector<Facet> faces,
-                double tolerance)
-        : points{std::move(points)}
-        , faces{std::move(faces)}
-        , tolerance{tolerance}
-    {
-        setDefaultMap();
-        check();
-    }
-
-    bool hasDuplicatedPoints() const
-    {
-        return duplicatedPoints > 0;
-    }
-
-    void mergeDuplicatedPoints()
-    {
-        if (!hasDuplicatedPoints()) {
-            return;
-        }
-
-        redirectPointIndex();
-        auto degreeMap = getPointDegrees();
-        decrementPointIndex(degreeMap);
-        removeUnusedPoints(degreeMap);
-        reset();
-    }
-
-    std::vector<Base::Vector3d> getPoints() const
-    {
-        return points;
-    }
-
-    std::vector<Facet> getFacets() const
-    {
-        return faces;
-    }
-
-private:
-    void setDefaultMap()
-    {
-        // by default map point index to itself
-        mapPointIndex.resize(points.size());
-        std::generate(mapPointIndex.begin(),
-                      mapPointIndex.end(),
-                      Base::iotaGen<std::size_t>(0));
-    }
-
-    void reset()
-    {
-        mapPointIndex.clear();
-        duplicatedPoints = 0;
-    }
-
-    void check()
-    {
-        using VertexIterator = std::vector<Base::Vector3d>::const_iterator;
-
-        double tol3d = tolerance;
-        auto vertexLess = [tol3d](const VertexIterator& v1,
-                                  const VertexIterator& v2)
-        {
-            if (fabs(v1->x - v2->x) >= tol3d) {
-                return v1->x < v2->x;
+    std::vector<std::exception_ptr> errors(count);
+    std::atomic<std::size_t> next {0};
+    auto work = [&]() {
+        for (std::size_t i = next++; i < count; i = next++) {
+            try {
+                func(i);
             }
-            if (fabs(v1->y - v2->y) >= tol3d) {
-                return v1->y < v2->y;
-            }
-            if (fabs(v1->z - v2->z) >= tol3d) {
-                return v1->z < v2->z;
-            }
-            return false;  // points are considered to be equal
-        };
-        auto vertexEqual = [&](const VertexIterator& v1,
-                               const VertexIterator& v2)
-        {
-            if (vertexLess(v1, v2)) {
-                return false;
-            }
-            if (vertexLess(v2, v1)) {
-                return false;
-            }
-            return true;
-        };
-
-        std::vector<VertexIterator> vertices;
-        vertices.reserve(points.size());
-        for (auto it = points.cbegin(); it != points.cend(); ++it) {
-            vertices.push_back(it);
-        }
-
-        std::sort(vertices.begin(), vertices.end(), vertexLess);
-
-        auto next = vertices.begin();
-        while (next != vertices.end()) {
-            next = std::adjacent_find(next, vertices.end(), vertexEqual);
-            if (next != vertices.end()) {
-                auto first = next;
-                std::size_t first_index = *first - points.begin();
-                ++next;
-                while (next != vertices.end() && vertexEqual(*first, *next)) {
-                    std::size_t next_index = *next - points.begin();
-                    mapPointIndex[next_index] = first_index;
-                    ++duplicatedPoints;
-                    ++next;
-                }
+            catch (...) {
+                errors[i] = std::current_exception();
             }
         }
-    }
+    };
 
-    void redirectPointIndex()
-    {
-        for (auto& face : faces) {
-            face.I1 = int(mapPointIndex[face.I1]);
-            face.I2 = int(mapPointIndex[face.I2]);
-            face.I3 = int(mapPointIndex[face.I3]);
-        }
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < std::min(threads, count); i++) {
+        workers.emplace_back(work);
     }
-
-    std::vector<std::size_t> getPointDegrees() const
-    {
-        std::vector<std::size_t> degreeMap;
-        degreeMap.resize(points.size());
-        for (const auto& face : faces) {
-            degreeMap[face.I1]++;
-            degreeMap[face.I2]++;
-            degreeMap[face.I3]++;
-        }
-
-        return degreeMap;
+    work();
+    for (auto& worker : workers) {
+        worker.join();
     }
 
-    void decrementPointIndex(const std::vector<std::size_t>& degreeMap)
-    {
-        std::vector<std::size_t> decrements;
-        decrements.resize(points.size());
-
-        std::size_t decr = 0;
-        for (std::size_t pos = 0; pos < points.size(); pos++) {
-            decrements[pos] = decr;
-            if (degreeMap[pos] == 0) {
-                decr++;
-            }
-        }
-
-        for (auto& face : faces) {
-            face.I1 -= int(decrements[face.I1]);
-            face.I2 -= int(decrements[face.I2]);
-            face.I3 -= int(decrements[face.I3]);
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
         }
     }
+}
 
-    void removeUnusedPoints(const std::vector<std::size_t>& degreeMap)
-    {
-        // remove unreferenced points
-        std::vector<Base::Vector3d> new_points;
-        new_points.reserve(points.size() - duplicatedPoints);
-        for (std::size_t pos = 0; pos < points.size(); ++pos) {
-            if (degreeMap[pos] > 0) {
-                new_points.push_back(points[pos]);
-            }
-        }
-
-        points.swap(new_points);
+/// Sorts one chunk per thread and merges the sorted chunks pairwise
+void parallelSort(std::vector<GridVertex>& vertices, std::size_t threads)
+{
+    std::size_t chunks = std::max<std::size_t>(std::min(threads, vertices.size() / 1024), 1);
+    std::vector<std::size_t> bounds(chunks + 1);
+    for (std::size_t i = 0; i <= chunks; i++) {
+        bounds[i] = vertices.size() * i / chunks;
+    }
+
+    parallelFor(chunks, threads, [&](std::size_t i) {
+        std::sort(vertices.begin() + bounds[i], vertices.begin() + bounds[i + 1]);
+    });
+    for (std::size_t width = 1; width < chunks; width *= 2) {
+        std::size_t merges = (chunks + 2 * width - 1) / (2 * width);
+        parallelFor(merges, threads, [&](std::size_t i) {
+            std::size_t first = 2 * width * i;
+            std::size_t middle = std::min(first + width, chunks);
+            std::size_t last = std::min(first + 2 * width, chunks);
+            std::inplace_merge(vertices.begin() + bounds[first],
+                               vertices.begin() + bounds[middle],
+                               vertices.begin() + bounds[last]);
+        });
     }
-
-private:
-    std::vector<Base::Vector3d> points;
-    std::vector<Facet> faces;
-    double tolerance = 0.0;
-    std::size_t duplicatedPoints = 0;
-    std::vector<std::size_t> mapPointIndex;
-};
+}
 
 }
 
@@ -252,59 +123,96 @@ void BRepMesh::getFacesFromDomains(const std::vector<Domain>& domains,
                                    std::vector<Base::Vector3d>& points,
                                    std::vector<Facet>& faces)
 {
-    std::size_t numFaces = 0;
-    for (const auto& it : domains) {
-        numFaces += it.facets.size();
-    }
-    faces.reserve(numFaces);
-
-    std::set<MeshVertex> vertices;
-    auto addVertex = [&vertices](const Base::Vector3d& pnt, uint32_t& pointIndex) {
-        MeshVertex vertex(pnt);
-        vertex.i = vertices.size();
-        auto it = vertices.insert(vertex);
-        pointIndex = it.first->i;
-    };
-
-    for (const auto & domain : domains) {
-        std::size_t numDomainFaces = 0;
-        for (const Facet& df : domain.facets) {
-            Facet face;
-
-            // 1st vertex
-            addVertex(domain.points[df.I1], face.I1);
-
-            // 2nd vertex
-            addVertex(domain.points[df.I2], face.I2);
-
-            // 3rd vertex
-            addVertex(domain.points[df.I3], face.I3);
+    // The points and facets of each domain go to precomputed ranges of the arrays
+    std::vector<std::size_t> pointOffsets(domains.size() + 1);
+    std::vector<std::size_t> facetOffsets(domains.size() + 1);
+    for (std::size_t i = 0; i < domains.size(); i++) {
+        pointOffsets[i + 1] = pointOffsets[i] + domains[i].points.size();
+        facetOffsets[i + 1] = facetOffsets[i] + domains[i].facets.size();
+    }
+    const std::size_t numPoints = pointOffsets.back();
+    const std::size_t numFaces = facetOffsets.back();
+    const std::size_t threads = numFaces < minParallelFacets
+        ? 1
+        : std::max<std::size_t>(std::thread::hardware_concurrency(), 1U);
+
+    // Weld the points that are in the same cell of a grid with the confusion tolerance. All
+    // points of a cell get the first of them in the order of the domains.
+    const double tolerance = Precision::Confusion();
+    std::vector<GridVertex> vertices(numPoints);
+    parallelFor(domains.size(), threads, [&](std::size_t i) {
+        std::size_t index = pointOffsets[i];
+        for (const Base::Vector3d& pnt : domains[i].points) {
+            vertices[index] = GridVertex {{std::llround(pnt.x / tolerance),
+                                           std::llround(pnt.y / tolerance),
+                                           std::llround(pnt.z / tolerance)},
+                                          static_cast<uint32_t>(index)};
+            index++;
+        }
+    });
+    parallelSort(vertices, threads);
 
-            // make sure that we don't insert invalid facets
-            if (face.I1 != face.I2 &&
-                face.I2 != face.I3 &&
-                face.I3 != face.I1) {
-                faces.push_back(face);
-                numDomainFaces++;
+    std::vector<uint32_t> weld(numPoints);
+    for (std::size_t i = 0, first = 0; i < vertices.size(); i++) {
+        if (vertices[i].cell != vertices[first].cell) {
+            first = i;
+        }
+        weld[vertices[i].index] = vertices[first].index;
+    }
+    vertices = {};
+
+    // Map the facets to the welded points, facets that have collapsed are dropped
+    std::vector<Facet> welded(numFaces);
+    std::vector<std::size_t> validFacets(domains.size());
+    parallelFor(domains.size(), threads, [&](std::size_t i) {
+        const std::size_t offset = pointOffsets[i];
+        std::size_t index = facetOffsets[i];
+        for (const Facet& df : domains[i].facets) {
+            Facet face {weld[offset + df.I1], weld[offset + df.I2], weld[offset + df.I3]};
+            if (face.I1 != face.I2 && face.I2 != face.I3 && face.I3 != face.I1) {
+                welded[index++] = face;
             }
         }
-
-        domainSizes.push_back(numDomainFaces);
+        validFacets[i] = index - facetOffsets[i];
+    });
+
+    // Number the points that are used in the order of the domains
+    constexpr uint32_t unused = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> pointIndex(numPoints, unused);
+    for (std::size_t i = 0; i < domains.size(); i++) {
+        for (std::size_t j = facetOffsets[i]; j < facetOffsets[i] + validFacets[i]; j++) {
+            pointIndex[welded[j].I1] = 0;
+            pointIndex[welded[j].I2] = 0;
+            pointIndex[welded[j].I3] = 0;
+        }
     }
-
     std::vector<Base::Vector3d> meshPoints;
-    meshPoints.resize(vertices.size());
-    for (const auto & vertex : vertices) {
-        meshPoints[vertex.i] = vertex.toPoint();
+    for (std::size_t i = 0; i < domains.size(); i++) {
+        for (std::size_t j = 0; j < domains[i].points.size(); j++) {
+            uint32_t& index = pointIndex[pointOffsets[i] + j];
+            if (index != unused) {
+                index = static_cast<uint32_t>(meshPoints.size());
+                meshPoints.push_back(domains[i].points[j]);
+            }
+        }
     }
     points.swap(meshPoints);
 
-    MergeVertex merge(points, faces, Precision::Confusion());
-    if (merge.hasDuplicatedPoints()) {
-        merge.mergeDuplicatedPoints();
-        points = merge.getPoints();
-        faces = merge.getFacets();
-    }
+    std::vector<std::size_t> faceOffsets(domains.size() + 1);
+    for (std::size_t i = 0; i < domains.size(); i++) {
+        faceOffsets[i + 1] = faceOffsets[i] + validFacets[i];
+        domainSizes.push_back(validFacets[i]);
+    }
+    std::vector<Facet> meshFaces(faceOffsets.back());
+    parallelFor(domains.size(), threads, [&](std::size_t i) {
+        std::size_t index = faceOffsets[i];
+        for (std::size_t j = facetOffsets[i]; j < facetOffsets[i] + validFacets[i]; j++) {
+            const Facet& face = welded[j];
+            meshFaces[index++] =
+                Facet {pointIndex[face.I1], pointIndex[face.I2], pointIndex[face.I3]};
+        }
+    });
+    faces.swap(meshFaces);
 }
 
 std::vector<BRepMesh::Segment> BRepMesh::createSegments() const
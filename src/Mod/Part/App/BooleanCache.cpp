@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <list>
+# include <mutex>
+# include <sstream>
+# include <unordered_map>
+# include <QCryptographicHash>
+#endif
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/Parameter.h>
+
+#include "BooleanCache.h"
+#include "FuzzyHelper.h"
+#include "TopoShape.h"
+
+
+using namespace Part;
+
+namespace
+{
+
+class Cache
+{
+public:
+    struct Entry
+    {
+        std::string key;
+        TopoShape shape;
+        std::size_t memSize;
+    };
+
+    static Cache& instance()
+    {
+        static Cache cache;
+        return cache;
+    }
+
+    void shrink(std::size_t limit)
+    {
+        while (memSize > limit && !entries.empty()) {
+            memSize -= entries.back().memSize;
+            index.erase(entries.back().key);
+            entries.pop_back();
+        }
+    }
+
+    void removeHasher(const App::StringHasherRef& hasher)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (static_cast<App::StringHasher*>(it->shape.Hasher) == hasher) {
+                memSize -= it->memSize;
+                index.erase(it->key);
+                it = entries.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    std::mutex mutex;
+    // the most recently used entry first
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    std::size_t memSize = 0;
+    std::size_t maxMemory = 0;
+
+private:
+    Cache()
+    {
+        Base::Reference<ParameterGrp> hGrp = App::GetApplication()
+                                                 .GetUserParameter()
+                                                 .GetGroup("BaseApp")
+                                                 ->GetGroup("Preferences")
+                                                 ->GetGroup("Mod/Part/Boolean");
+        maxMemory = std::size_t(hGrp->GetUnsigned("CacheSize", 256)) * 1024 * 1024;
+
+        // the results refer to the string hasher of their document
+        connDeleteDocument = App::GetApplication().signalDeleteDocument.connect(
+            [this](const App::Document& doc) {
+                removeHasher(doc.getStringHasher());
+            });
+    }
+
+    boost::signals2::scoped_connection connDeleteDocument;
+};
+
+void addData(QCryptographicHash& hash, const std::string& data)
+{
+    // with the terminating zero so that consecutive strings can't be confused
+#if QT_VERSION < QT_VERSION_CHECK(6, 3, 0)
+    hash.addData(data.c_str(), int(data.size() + 1));
+#else
+    hash.addData(QByteArrayView(data.c_str(), qsizetype(data.size() + 1)));
+#endif
+}
+
+}  // namespace
+
+std::size_t BooleanCache::getMaxMemory()
+{
+    Cache& cache = Cache::instance();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.maxMemory;
+}
+
+void BooleanCache::setMaxMemory(std::size_t bytes)
+{
+    Cache& cache = Cache::instance();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.maxMemory = bytes;
+    cache.shrink(bytes);
+}
+
+std::string BooleanCache::makeKey(const char* op,
+                                  const std::vector<TopoShape>& shapes,
+                                  double tolerance,
+                                  const TopoShape& result)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    std::ostringstream str;
+    str.precision(17);
+    // a negative tolerance is scaled by the boolean fuzzy, which the automatic fuzzy value of the
+    // FCBRepAlgoAPI operations uses as well
+    str << op << ' ' << tolerance << ' ' << FuzzyHelper::getBooleanFuzzy() << ' ' << result.Tag
+        << ' ' << static_cast<const void*>(static_cast<App::StringHasher*>(result.Hasher));
+    addData(hash, str.str());
+
+    for (const auto& shape : shapes) {
+        // the binary format stores the exact coordinates and the locations
+        std::ostringstream brep;
+        shape.exportBinary(brep);
+        brep << ' ' << shape.Tag << ' '
+             << static_cast<const void*>(static_cast<App::StringHasher*>(shape.Hasher));
+        addData(hash, brep.str());
+
+        std::string names;
+        for (const auto& element : shape.getElementMap()) {
+            element.index.appendToStringBuffer(names);
+            names += ' ';
+            element.name.appendToBuffer(names);
+            names += '\n';
+        }
+        addData(hash, names);
+    }
+
+    return hash.result().toHex().toStdString();
+}
+
+bool BooleanCache::find(const std::string& key, TopoShape& result)
+{
+    Cache& cache = Cache::instance();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto it = cache.index.find(key);
+    if (it == cache.index.end()) {
+        return false;
+    }
+
+    cache.entries.splice(cache.entries.begin(), cache.entries, it->second);
+    result = it->second->shape;
+    return true;
+}
+
+void BooleanCache::insert(const std::string& key, const TopoShape& result)
+{
+    Cache& cache = Cache::instance();
+    // the size is computed outside of the lock as it walks the whole shape
+    std::size_t memSize = result.getMemSize();
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (memSize > cache.maxMemory) {
+        return;
+    }
+
+    auto it = cache.index.find(key);
+    if (it != cache.index.end()) {
+        cache.memSize -= it->second->memSize;
+        cache.entries.erase(it->second);
+        cache.index.erase(it);
+    }
+
+    cache.shrink(cache.maxMemory - memSize);
+    cache.entries.push_front({key, result, memSize});
+    cache.index[key] = cache.entries.begin();
+    cache.memSize += memSize;
+}
+
+void BooleanCache::clear()
+{
+    Cache& cache = Cache::instance();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.entries.clear();
+    cache.index.clear();
+    cache.memSize = 0;
+}
+
+std::size_t BooleanCache::size()
+{
+    Cache& cache = Cache::instance();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.entries.size();
+}
+
+std::size_t BooleanCache::memSize()
+{
+    Cache& cache = Cache::instance();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.memSize;
+}
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef PART_BOOLEANCACHE_H
+#define PART_BOOLEANCACHE_H
+
+#include <string>
+#include <vector>
+
+#include <Mod/Part/PartGlobal.h>
+
+namespace Part
+{
+
+class TopoShape;
+
+/**
+ * @brief The BooleanCache keeps the results of boolean operations so that a recompute with
+ * unchanged operands doesn't run the geometric kernel again.
+ *
+ * A result is looked up by a key made of the SHA-1 digest of the operand shapes and their element
+ * maps, the operation, the fuzzy values and the tag and string hasher of the result, so a cached
+ * shape has exactly the element map the operation would create. As the string hasher belongs to a
+ * document the entries are per document and are dropped when the document is closed.
+ *
+ * The cache is bounded by the memory size of the stored shapes, the least recently used entries
+ * are removed first. The limit is the parameter CacheSize in MB of the group
+ * BaseApp/Preferences/Mod/Part/Boolean, a value of 0 disables the cache.
+ */
+namespace BooleanCache
+{
+    /// The maximum memory of the cached shapes in bytes, 0 if the cache is disabled
+    std::size_t PartExport getMaxMemory();
+    void PartExport setMaxMemory(std::size_t bytes);
+    /// Returns the key of the operation \a op of \a shapes that creates \a result
+    std::string PartExport makeKey(const char* op,
+                                   const std::vector<TopoShape>& shapes,
+                                   double tolerance,
+                                   const TopoShape& result);
+    /// Sets \a result to the cached shape and returns true if there is one for \a key
+    bool PartExport find(const std::string& key, TopoShape& result);
+    void PartExport insert(const std::string& key, const TopoShape& result);
+    void PartExport clear();
+    /// The number of entries and the memory size of their shapes in bytes
+    std::size_t PartExport size();
+    std::size_t PartExport memSize();
+}
+
+}
+
+#endif // PART_BOOLEANCACHE_H
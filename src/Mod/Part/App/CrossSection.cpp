@@ -23,32 +23,187 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <algorithm>
+# include <atomic>
+# include <cmath>
+# include <exception>
+# include <map>
+# include <memory>
+# include <thread>
+# include <tuple>
 # include <BRepAdaptor_Surface.hxx>
 # include <Mod/Part/App/FCBRepAlgoAPI_Common.h>
 # include <Mod/Part/App/FCBRepAlgoAPI_Cut.h>
 # include <Mod/Part/App/FCBRepAlgoAPI_Section.h>
+# include <BRep_Tool.hxx>
+# include <BRepBndLib.hxx>
 # include <BRepBuilderAPI_MakeFace.hxx>
 # include <BRepBuilderAPI_MakeWire.hxx>
+# include <BRepCheck_Analyzer.hxx>
 # include <BRepPrimAPI_MakeHalfSpace.hxx>
+# include <Bnd_Box.hxx>
 # include <gp_Pln.hxx>
 # include <Precision.hxx>
 # include <ShapeAnalysis_FreeBounds.hxx>
 # include <ShapeFix_Wire.hxx>
+# include <Standard_ConstructionError.hxx>
 # include <TopExp.hxx>
 # include <TopExp_Explorer.hxx>
 # include <TopTools_HSequenceOfShape.hxx>
 # include <TopTools_IndexedMapOfShape.hxx>
 # include <TopoDS.hxx>
 # include <TopoDS_Edge.hxx>
+# include <TopoDS_Face.hxx>
+# include <TopoDS_Vertex.hxx>
 # include <TopoDS_Wire.hxx>
 #endif
 
+#include <Base/Console.h>
+
 #include "CrossSection.h"
 #include "TopoShapeOpCode.h"
 
 
 using namespace Part;
 
+namespace {
+
+/// The range of the distances a*x+b*y+c*z of the points of a shape
+struct SliceRange
+{
+    double min = 0.0;
+    double max = -1.0;
+
+    bool contains(double d) const
+    {
+        return min <= d && d <= max;
+    }
+};
+
+SliceRange sliceRange(const TopoDS_Shape& shape, double a, double b, double c)
+{
+    // The box includes the tolerances, as the distance is linear its extremes are at the corners
+    Bnd_Box box;
+    BRepBndLib::Add(shape, box);
+    SliceRange range;
+    if (box.IsVoid()) {
+        return range;
+    }
+    if (box.IsOpen()) {
+        range.min = -Precision::Infinite();
+        range.max = Precision::Infinite();
+        return range;
+    }
+
+    double xMin {}, yMin {}, zMin {}, xMax {}, yMax {}, zMax {};
+    box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    range.min = std::min(a * xMin, a * xMax) + std::min(b * yMin, b * yMax)
+        + std::min(c * zMin, c * zMax);
+    range.max = std::max(a * xMin, a * xMax) + std::max(b * yMin, b * yMax)
+        + std::max(c * zMin, c * zMax);
+    double tol = Precision::Confusion() * std::sqrt(a * a + b * b + c * c);
+    range.min -= tol;
+    range.max += tol;
+    return range;
+}
+
+/// Calls func(i) for 0 <= i < count on all cores and rethrows the exception of the lowest index
+template<typename Func>
+void parallelFor(std::size_t count, Func func)
+{
+    std::vector<std::exception_ptr> errors(count);
+    std::atomic<std::size_t> next {0};
+    auto work = [&]() {
+        for (std::size_t i = next++; i < count; i = next++) {
+            try {
+                func(i);
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    const std::size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < std::min(threads, count); i++) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/// The section of a shape that has been checked before, it runs in a thread of its own
+std::unique_ptr<FCBRepAlgoAPI_Section> makeSection(const TopoDS_Shape& shape, const gp_Pln& plane)
+{
+    auto mkSection = std::make_unique<FCBRepAlgoAPI_Section>();
+    mkSection->Init1(shape);
+    mkSection->Init2(plane);
+    mkSection->setAutoFuzzy();
+    mkSection->SetRunParallel(Standard_False);
+    mkSection->Build();
+    return mkSection;
+}
+
+/// The cut of a shape that has been checked before, it runs in a thread of its own
+std::unique_ptr<FCBRepAlgoAPI_Cut> makeCut(const TopoDS_Shape& shape, const TopoDS_Shape& tool)
+{
+    auto mkCut = std::make_unique<FCBRepAlgoAPI_Cut>();
+    TopTools_ListOfShape arguments;
+    arguments.Append(shape);
+    TopTools_ListOfShape tools;
+    tools.Append(tool);
+    mkCut->SetArguments(arguments);
+    mkCut->SetTools(tools);
+    mkCut->setAutoFuzzy();
+    mkCut->SetRunParallel(Standard_False);
+    mkCut->Build();
+    return mkCut;
+}
+
+/// A point off the plane a*x+b*y+c*z=d on the cut away side (fixes #0001228)
+gp_Pnt refPoint(double a, double b, double c, double d)
+{
+    gp_Vec tempVector(a, b, c);
+    tempVector.Normalize();  // just in case.
+    tempVector *= (d + 1.0);
+    gp_Pnt refPoint(0.0, 0.0, 0.0);
+    refPoint.Translate(tempVector);
+    return refPoint;
+}
+
+/// Checks the shapes that are sliced by the sections, as the constructors of the operations do
+void checkShapes(const std::vector<TopoDS_Shape>& shapes,
+                 const std::vector<SliceRange>& ranges,
+                 const std::vector<double>& d,
+                 bool solids)
+{
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        if (std::none_of(d.begin(), d.end(), [&](double dist) {
+                return ranges[i].contains(dist);
+            })) {
+            continue;
+        }
+        if (!BRepCheck_Analyzer(shapes[i]).IsValid()) {
+            if (solids) {
+                Base::Console().warning("Base shape is not valid for boolean operation");
+            }
+            else {
+                Standard_ConstructionError::Raise("Base shape is not valid for boolean operation");
+            }
+        }
+    }
+}
+
+}  // namespace
+
 CrossSection::CrossSection(double a, double b, double c, const TopoDS_Shape& s)
   : a(a), b(b), c(c), s(s)
 {
@@ -73,6 +228,52 @@ std::list<TopoDS_Wire> CrossSection::slice(double d) const
     return removeDuplicates(wires);
 }
 
+std::vector<std::list<TopoDS_Wire>> CrossSection::slices(const std::vector<double>& d) const
+{
+    // The sub-shapes of slice() are classified once against all planes using their bounding boxes
+    std::vector<TopoDS_Shape> solids;
+    std::vector<TopoDS_Shape> others;
+    TopExp_Explorer xp;
+    for (xp.Init(s, TopAbs_SOLID); xp.More(); xp.Next()) {
+        solids.push_back(xp.Current());
+    }
+    for (xp.Init(s, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next()) {
+        others.push_back(xp.Current());
+    }
+    for (xp.Init(s, TopAbs_FACE, TopAbs_SHELL); xp.More(); xp.Next()) {
+        others.push_back(xp.Current());
+    }
+
+    std::vector<TopoDS_Shape> shapes(solids);
+    shapes.insert(shapes.end(), others.begin(), others.end());
+    std::vector<SliceRange> ranges(shapes.size());
+    parallelFor(shapes.size(), [&](std::size_t i) {
+        ranges[i] = sliceRange(shapes[i], a, b, c);
+    });
+    std::vector<SliceRange> solidRanges(ranges.begin(), ranges.begin() + solids.size());
+    std::vector<SliceRange> otherRanges(ranges.begin() + solids.size(), ranges.end());
+    checkShapes(solids, solidRanges, d, true);
+    checkShapes(others, otherRanges, d, false);
+
+    std::vector<std::list<TopoDS_Wire>> result(d.size());
+    parallelFor(d.size(), [&](std::size_t i) {
+        std::list<TopoDS_Wire> wires;
+        for (std::size_t j = 0; j < shapes.size(); j++) {
+            if (!ranges[j].contains(d[i])) {
+                continue;
+            }
+            if (j < solids.size()) {
+                sliceSolid(d[i], shapes[j], wires, true);
+            }
+            else {
+                sliceNonSolid(d[i], shapes[j], wires, true);
+            }
+        }
+        result[i] = removeDuplicates(wires);
+    });
+    return result;
+}
+
 std::list<TopoDS_Wire> CrossSection::removeDuplicates(const std::list<TopoDS_Wire>& wires) const
 {
     std::list<TopoDS_Wire> wires_reduce;
@@ -107,38 +308,50 @@ std::list<TopoDS_Wire> CrossSection::removeDuplicates(const std::list<TopoDS_Wir
     return wires_reduce;
 }
 
-void CrossSection::sliceNonSolid(double d, const TopoDS_Shape& shape, std::list<TopoDS_Wire>& wires) const
+void CrossSection::sliceNonSolid(double d,
+                                 const TopoDS_Shape& shape,
+                                 std::list<TopoDS_Wire>& wires,
+                                 bool checked) const
 {
-    FCBRepAlgoAPI_Section cs(shape, gp_Pln(a,b,c,-d));
-    if (cs.IsDone()) {
+    std::unique_ptr<FCBRepAlgoAPI_Section> cs;
+    if (checked) {
+        cs = makeSection(shape, gp_Pln(a, b, c, -d));
+    }
+    else {
+        cs = std::make_unique<FCBRepAlgoAPI_Section>(shape, gp_Pln(a, b, c, -d));
+    }
+    if (cs->IsDone()) {
         std::list<TopoDS_Edge> edges;
         TopExp_Explorer xp;
-        for (xp.Init(cs.Shape(), TopAbs_EDGE); xp.More(); xp.Next())
+        for (xp.Init(cs->Shape(), TopAbs_EDGE); xp.More(); xp.Next())
             edges.push_back(TopoDS::Edge(xp.Current()));
         connectEdges(edges, wires);
     }
 }
 
-void CrossSection::sliceSolid(double d, const TopoDS_Shape& shape, std::list<TopoDS_Wire>& wires) const
+void CrossSection::sliceSolid(double d,
+                              const TopoDS_Shape& shape,
+                              std::list<TopoDS_Wire>& wires,
+                              bool checked) const
 {
     gp_Pln slicePlane(a,b,c,-d);
     BRepBuilderAPI_MakeFace mkFace(slicePlane);
     TopoDS_Face face = mkFace.Face();
 
     // Make sure to choose a point that does not lie on the plane (fixes #0001228)
-    gp_Vec tempVector(a,b,c);
-    tempVector.Normalize();//just in case.
-    tempVector *= (d+1.0);
-    gp_Pnt refPoint(0.0, 0.0, 0.0);
-    refPoint.Translate(tempVector);
-
-    BRepPrimAPI_MakeHalfSpace mkSolid(face, refPoint);
+    BRepPrimAPI_MakeHalfSpace mkSolid(face, refPoint(a, b, c, d));
     TopoDS_Solid solid = mkSolid.Solid();
-    FCBRepAlgoAPI_Cut mkCut(shape, solid);
+    std::unique_ptr<FCBRepAlgoAPI_Cut> mkCut;
+    if (checked) {
+        mkCut = makeCut(shape, solid);
+    }
+    else {
+        mkCut = std::make_unique<FCBRepAlgoAPI_Cut>(shape, solid);
+    }
 
-    if (mkCut.IsDone()) {
+    if (mkCut->IsDone()) {
         TopTools_IndexedMapOfShape mapOfFaces;
-        TopExp::MapShapes(mkCut.Shape(), TopAbs_FACE, mapOfFaces);
+        TopExp::MapShapes(mkCut->Shape(), TopAbs_FACE, mapOfFaces);
         for (int i=1; i<=mapOfFaces.Extent(); i++) {
             const TopoDS_Face& face = TopoDS::Face(mapOfFaces.FindKey(i));
             BRepAdaptor_Surface adapt(face);
@@ -159,31 +372,82 @@ void CrossSection::sliceSolid(double d, const TopoDS_Shape& shape, std::list<Top
 void CrossSection::connectEdges (const std::list<TopoDS_Edge>& edges, std::list<TopoDS_Wire>& wires) const
 {
     // Hint: Use ShapeAnalysis_FreeBounds::ConnectEdgesToWires() as an alternative
-    std::list<TopoDS_Edge> edge_list = edges;
-    while (!edge_list.empty()) {
+    // The end points of the edges are kept in a grid with cells at least as large as the vertex
+    // tolerances, so only the edges close to an open end of a wire are tried to connect to it.
+    using Cell = std::tuple<long long, long long, long long>;
+    std::vector<TopoDS_Edge> edge_list(edges.begin(), edges.end());
+    std::vector<std::vector<gp_Pnt>> ends(edge_list.size());
+    double cellSize = Precision::Confusion();
+    for (std::size_t i = 0; i < edge_list.size(); i++) {
+        TopoDS_Vertex v1, v2;
+        TopExp::Vertices(edge_list[i], v1, v2);
+        for (const auto& v : {v1, v2}) {
+            if (!v.IsNull()) {
+                ends[i].push_back(BRep_Tool::Pnt(v));
+                cellSize = std::max(cellSize, 2.0 * BRep_Tool::Tolerance(v));
+            }
+        }
+    }
+
+    auto cellOf = [cellSize](const gp_Pnt& pnt) {
+        return Cell(static_cast<long long>(std::floor(pnt.X() / cellSize)),
+                    static_cast<long long>(std::floor(pnt.Y() / cellSize)),
+                    static_cast<long long>(std::floor(pnt.Z() / cellSize)));
+    };
+    std::map<Cell, std::vector<std::size_t>> grid;
+    for (std::size_t i = 0; i < edge_list.size(); i++) {
+        for (const auto& pnt : ends[i]) {
+            grid[cellOf(pnt)].push_back(i);
+        }
+    }
+
+    std::vector<bool> used(edge_list.size(), false);
+    for (std::size_t first = 0; first < edge_list.size(); first++) {
+        if (used[first]) {
+            continue;
+        }
+
         BRepBuilderAPI_MakeWire mkWire;
-        // add and erase first edge
-        mkWire.Add(edge_list.front());
-        edge_list.erase(edge_list.begin());
+        // add and mark first edge
+        mkWire.Add(edge_list[first]);
+        used[first] = true;
 
         TopoDS_Wire new_wire = mkWire.Wire();  // current new wire
 
-        // try to connect each edge to the wire, the wire is complete if no more edges are connectible
-        bool found = false;
-        do {
-            found = false;
-            for (std::list<TopoDS_Edge>::iterator pE = edge_list.begin(); pE != edge_list.end();++pE) {
-                mkWire.Add(*pE);
-                if (mkWire.Error() != BRepBuilderAPI_DisconnectedWire) {
-                    // edge added ==> remove it from list
-                    found = true;
-                    edge_list.erase(pE);
-                    new_wire = mkWire.Wire();
-                    break;
+        // try to connect the edges at the open ends, the wire is complete if no more are left
+        std::vector<gp_Pnt> open = ends[first];
+        while (!open.empty()) {
+            gp_Pnt pnt = open.back();
+            open.pop_back();
+            auto [x, y, z] = cellOf(pnt);
+            for (long long i = x - 1; i <= x + 1; i++) {
+                for (long long j = y - 1; j <= y + 1; j++) {
+                    for (long long k = z - 1; k <= z + 1; k++) {
+                        auto it = grid.find(Cell(i, j, k));
+                        if (it == grid.end()) {
+                            continue;
+                        }
+                        for (std::size_t index : it->second) {
+                            if (used[index]
+                                || std::none_of(ends[index].begin(),
+                                                ends[index].end(),
+                                                [&](const gp_Pnt& end) {
+                                                    return end.Distance(pnt) <= cellSize;
+                                                })) {
+                                continue;
+                            }
+                            mkWire.Add(edge_list[index]);
+                            if (mkWire.Error() != BRepBuilderAPI_DisconnectedWire) {
+                                // edge added ==> its ends are open now
+                                used[index] = true;
+                                new_wire = mkWire.Wire();
+                                open.insert(open.end(), ends[index].begin(), ends[index].end());
+                            }
+                        }
+                    }
                 }
             }
         }
-        while (found);
 
         // Fix any topological issues of the wire
         wires.push_back(fixWire(new_wire));
@@ -225,23 +489,101 @@ TopoCrossSection::TopoCrossSection(double a, double b, double c, const TopoShape
 {
 }
 
-void TopoCrossSection::slice(int idx, double d, std::vector<TopoShape>& wires) const
+std::vector<TopoShape> TopoCrossSection::getSlicedShapes(bool& solids) const
 {
     // Fixes: 0001228: Cross section of Torus in Part Workbench fails or give wrong results
     // Fixes: 0001137: Incomplete slices when using Part.slice on a torus
-    bool found = false;
-    for (auto& s : shape.getSubTopoShapes(TopAbs_SOLID)) {
-        sliceSolid(idx, d, s, wires);
-        found = true;
+    solids = true;
+    auto shapes = shape.getSubTopoShapes(TopAbs_SOLID);
+    if (shapes.empty()) {
+        solids = false;
+        shapes = shape.getSubTopoShapes(TopAbs_SHELL);
+        if (shapes.empty()) {
+            shapes = shape.getSubTopoShapes(TopAbs_FACE);
+        }
     }
-    if (!found) {
-        for (auto& s : shape.getSubTopoShapes(TopAbs_SHELL)) {
+    return shapes;
+}
+
+void TopoCrossSection::slice(int idx, double d, std::vector<TopoShape>& wires) const
+{
+    bool solids = false;
+    for (auto& s : getSlicedShapes(solids)) {
+        if (solids) {
+            sliceSolid(idx, d, s, wires);
+        }
+        else {
             sliceNonSolid(idx, d, s, wires);
-            found = true;
         }
-        if (!found) {
-            for (auto& s : shape.getSubTopoShapes(TopAbs_FACE)) {
-                sliceNonSolid(idx, d, s, wires);
+    }
+}
+
+void TopoCrossSection::slices(const std::vector<double>& d, std::vector<TopoShape>& wires) const
+{
+    bool solids = false;
+    std::vector<TopoShape> shapes = getSlicedShapes(solids);
+    std::vector<TopoDS_Shape> occShapes;
+    occShapes.reserve(shapes.size());
+    for (const auto& s : shapes) {
+        occShapes.push_back(s.getShape());
+    }
+    std::vector<SliceRange> ranges(shapes.size());
+    parallelFor(shapes.size(), [&](std::size_t i) {
+        ranges[i] = sliceRange(occShapes[i], a, b, c);
+    });
+    checkShapes(occShapes, ranges, d, solids);
+
+    // The geometric operations of a number of planes run concurrently, the element maps use the
+    // string hasher and are made afterwards in the order of the planes. The operations of all
+    // planes at once could use too much memory.
+    struct Operation
+    {
+        std::size_t plane = 0;
+        std::size_t shape = 0;
+        TopoDS_Face face;
+        std::unique_ptr<BRepPrimAPI_MakeHalfSpace> mkSolid;
+        std::unique_ptr<FCBRepAlgoAPI_Cut> mkCut;
+        std::unique_ptr<FCBRepAlgoAPI_Section> mkSection;
+    };
+    const std::size_t chunkSize = 4 * std::max(std::thread::hardware_concurrency(), 1U);
+    for (std::size_t first = 0; first < d.size(); first += chunkSize) {
+        std::vector<Operation> operations;
+        for (std::size_t i = first; i < std::min(first + chunkSize, d.size()); i++) {
+            for (std::size_t j = 0; j < shapes.size(); j++) {
+                if (ranges[j].contains(d[i])) {
+                    operations.push_back({i, j});
+                }
+            }
+        }
+
+        parallelFor(operations.size(), [&](std::size_t i) {
+            Operation& operation = operations[i];
+            gp_Pln slicePlane(a, b, c, -d[operation.plane]);
+            if (solids) {
+                operation.face = BRepBuilderAPI_MakeFace(slicePlane).Face();
+                operation.mkSolid = std::make_unique<BRepPrimAPI_MakeHalfSpace>(
+                    operation.face,
+                    refPoint(a, b, c, d[operation.plane]));
+                operation.mkCut = makeCut(occShapes[operation.shape], operation.mkSolid->Solid());
+            }
+            else {
+                operation.mkSection = makeSection(occShapes[operation.shape], slicePlane);
+            }
+        });
+
+        for (auto& operation : operations) {
+            int idx = static_cast<int>(operation.plane) + 1;
+            if (solids) {
+                mapCut(idx,
+                       shapes[operation.shape],
+                       gp_Pln(a, b, c, -d[operation.plane]),
+                       operation.face,
+                       *operation.mkSolid,
+                       *operation.mkCut,
+                       wires);
+            }
+            else {
+                mapSection(idx, shapes[operation.shape], *operation.mkSection, wires);
             }
         }
     }
@@ -263,11 +605,19 @@ void TopoCrossSection::sliceNonSolid(int idx,
                                      std::vector<TopoShape>& wires) const
 {
     FCBRepAlgoAPI_Section cs(shape.getShape(), gp_Pln(a, b, c, -d));
-    if (cs.IsDone()) {
+    mapSection(idx, shape, cs, wires);
+}
+
+void TopoCrossSection::mapSection(int idx,
+                                  const TopoShape& shape,
+                                  FCBRepAlgoAPI_Section& mkSection,
+                                  std::vector<TopoShape>& wires) const
+{
+    if (mkSection.IsDone()) {
         std::string prefix(op);
         prefix += Data::indexSuffix(idx);
         auto res = TopoShape()
-                       .makeElementShape(cs, shape, prefix.c_str())
+                       .makeElementShape(mkSection, shape, prefix.c_str())
                        .makeElementWires()
                        .getSubTopoShapes(TopAbs_WIRE);
         wires.insert(wires.end(), res.begin(), res.end());
@@ -281,22 +631,28 @@ void TopoCrossSection::sliceSolid(int idx,
 {
     gp_Pln slicePlane(a, b, c, -d);
     BRepBuilderAPI_MakeFace mkFace(slicePlane);
-    TopoShape face(idx);
-    face.setShape(mkFace.Face());
+    TopoDS_Face face = mkFace.Face();
 
     // Make sure to choose a point that does not lie on the plane (fixes #0001228)
-    gp_Vec tempVector(a, b, c);
-    tempVector.Normalize();  // just in case.
-    tempVector *= (d + 1.0);
-    gp_Pnt refPoint(0.0, 0.0, 0.0);
-    refPoint.Translate(tempVector);
+    BRepPrimAPI_MakeHalfSpace mkSolid(face, refPoint(a, b, c, d));
+    FCBRepAlgoAPI_Cut mkCut(shape.getShape(), mkSolid.Solid());
+    mapCut(idx, shape, slicePlane, face, mkSolid, mkCut, wires);
+}
 
-    BRepPrimAPI_MakeHalfSpace mkSolid(TopoDS::Face(face.getShape()), refPoint);
+void TopoCrossSection::mapCut(int idx,
+                              const TopoShape& shape,
+                              const gp_Pln& slicePlane,
+                              const TopoDS_Face& planeFace,
+                              BRepPrimAPI_MakeHalfSpace& mkSolid,
+                              FCBRepAlgoAPI_Cut& mkCut,
+                              std::vector<TopoShape>& wires) const
+{
+    TopoShape faceShape(idx);
+    faceShape.setShape(planeFace);
     TopoShape solid(idx);
     std::string prefix(op);
     prefix += Data::indexSuffix(idx);
-    solid.makeElementShape(mkSolid, face, prefix.c_str());
-    FCBRepAlgoAPI_Cut mkCut(shape.getShape(), solid.getShape());
+    solid.makeElementShape(mkSolid, faceShape, prefix.c_str());
 
     if (mkCut.IsDone()) {
         TopoShape res(shape.Tag, shape.Hasher);
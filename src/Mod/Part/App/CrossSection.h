@@ -24,13 +24,19 @@
 #define PART_CROSSSECTION_H
 
 #include <list>
+#include <vector>
 #include <TopTools_IndexedMapOfShape.hxx>
 #include <Mod/Part/PartGlobal.h>
 #include "TopoShape.h"
 
 
+class BRepPrimAPI_MakeHalfSpace;
+class FCBRepAlgoAPI_Cut;
+class FCBRepAlgoAPI_Section;
+class TopoDS_Face;
 class TopoDS_Shape;
 class TopoDS_Wire;
+class gp_Pln;
 
 namespace Part {
 
@@ -39,10 +45,20 @@ class PartExport CrossSection
 public:
     CrossSection(double a, double b, double c, const TopoDS_Shape& s);
     std::list<TopoDS_Wire> slice(double d) const;
+    /// Slices at all distances \a d concurrently, the sub-shapes are classified in advance
+    std::vector<std::list<TopoDS_Wire>> slices(const std::vector<double>& d) const;
 
 private:
-    void sliceNonSolid(double d, const TopoDS_Shape&, std::list<TopoDS_Wire>& wires) const;
-    void sliceSolid(double d, const TopoDS_Shape&, std::list<TopoDS_Wire>& wires) const;
+    /// If \a checked is true the shape has been checked before and the section doesn't use the
+    /// kernel threads as it runs in a thread of slices()
+    void sliceNonSolid(double d,
+                       const TopoDS_Shape&,
+                       std::list<TopoDS_Wire>& wires,
+                       bool checked = false) const;
+    void sliceSolid(double d,
+                    const TopoDS_Shape&,
+                    std::list<TopoDS_Wire>& wires,
+                    bool checked = false) const;
     void connectEdges (const std::list<TopoDS_Edge>& edges, std::list<TopoDS_Wire>& wires) const;
     void connectWires (const TopTools_IndexedMapOfShape& wireMap, std::list<TopoDS_Wire>& wires) const;
     TopoDS_Wire fixWire(const TopoDS_Wire& wire) const;
@@ -59,10 +75,25 @@ public:
     TopoCrossSection(double a, double b, double c, const TopoShape& s, const char* op = 0);
     void slice(int idx, double d, std::vector<TopoShape>& wires) const;
     TopoShape slice(int idx, double d) const;
+    /// Slices at all distances \a d with the indices 1, 2, ..., the geometric operations run
+    /// concurrently and the element maps are made afterwards
+    void slices(const std::vector<double>& d, std::vector<TopoShape>& wires) const;
 
 private:
+    std::vector<TopoShape> getSlicedShapes(bool& solids) const;
     void sliceNonSolid(int idx, double d, const TopoShape&, std::vector<TopoShape>& wires) const;
     void sliceSolid(int idx, double d, const TopoShape&, std::vector<TopoShape>& wires) const;
+    void mapSection(int idx,
+                    const TopoShape& shape,
+                    FCBRepAlgoAPI_Section& mkSection,
+                    std::vector<TopoShape>& wires) const;
+    void mapCut(int idx,
+                const TopoShape& shape,
+                const gp_Pln& slicePlane,
+                const TopoDS_Face& planeFace,
+                BRepPrimAPI_MakeHalfSpace& mkSolid,
+                FCBRepAlgoAPI_Cut& mkCut,
+                std::vector<TopoShape>& wires) const;
 
 private:
     double a, b, c;
@@ -63,6 +63,8 @@ App::DocumentObjectExecReturn *Fillet::execute()
         TopExp::MapShapes(baseShape, TopAbs_EDGE, mapOfEdges);
         std::vector<Part::FilletElement> edges = Edges.getValues();
         std::string fullErrMsg;
+        std::vector<TopoShape> filletEdges;
+        std::vector<std::pair<double, double>> radii;
 
         const auto &vals = EdgeLinks.getSubValues(true);
         const auto &subs = EdgeLinks.getShadowSubs();
@@ -100,6 +102,8 @@ App::DocumentObjectExecReturn *Fillet::execute()
             double radius1 = info.radius1;
             double radius2 = info.radius2;
             mkFillet.Add(radius1, radius2, TopoDS::Edge(edge));
+            filletEdges.emplace_back(edge);
+            radii.emplace_back(radius1, radius2);
         }
 
         if (!fullErrMsg.empty()) {
@@ -107,9 +111,38 @@ App::DocumentObjectExecReturn *Fillet::execute()
         }
         Edges.setValues(edges);
 
-        TopoDS_Shape shape = mkFillet.Shape();
-        if (shape.IsNull())
-            return new App::DocumentObjectExecReturn("Resulting shape is null");
+        TopoDS_Shape shape;
+        std::string msg("Resulting shape is null");
+        try {
+            shape = mkFillet.Shape();
+        }
+        catch (Standard_Failure& e) {
+            msg = e.GetMessageString();
+        }
+        if (shape.IsNull()) {
+            // name the edges the fillet fails on, the groups of edges are tried concurrently
+            auto make = [&radii](const TopoShape& base,
+                                 const std::vector<TopoShape>& trialEdges,
+                                 const std::vector<int>& indices) {
+                BRepFilletAPI_MakeFillet mkTrial(base.getShape());
+                for (std::size_t k = 0; k < trialEdges.size(); ++k) {
+                    const auto& radius = radii[indices[k]];
+                    mkTrial.Add(radius.first,
+                                radius.second,
+                                TopoDS::Edge(trialEdges[k].getShape()));
+                }
+                return TopoShape(mkTrial.Shape());
+            };
+            auto failed = baseTopoShape.findFailingEdges(filletEdges, make);
+            if (!failed.empty()) {
+                msg = "Failed on edges:";
+                for (int i : failed) {
+                    int index = mapOfEdges.FindIndex(filletEdges[i].getShape());
+                    msg += " Edge" + std::to_string(index);
+                }
+            }
+            return new App::DocumentObjectExecReturn(msg);
+        }
 
         TopoShape res(0);
         this->Shape.setValue(res.makeElementShape(mkFillet, baseTopoShape, Part::OpCodes::Fillet));
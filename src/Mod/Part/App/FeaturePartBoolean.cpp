@@ -33,6 +33,7 @@
 #include <Base/Exception.h>
 #include <Base/Parameter.h>
 
+#include "BooleanCache.h"
 #include "FeaturePartBoolean.h"
 #include "TopoShapeOpCode.h"
 #include "modelRefine.h"
@@ -65,6 +66,13 @@ bool getRefineModelParameter()
     return hGrp->GetBool("RefineModel", false);
 }
 
+bool getPersistCacheParameter()
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
+    return hGrp->GetBool("PersistCache", false);
+}
+
 }
 
 PROPERTY_SOURCE_ABSTRACT(Part::Boolean, Part::Feature)
@@ -79,6 +87,8 @@ Boolean::Boolean()
     History.setSize(0);
 
     ADD_PROPERTY_TYPE(Refine,(0),"Boolean",(App::PropertyType)(App::Prop_None),"Refine shape (clean up redundant edges) after this boolean operation");
+    ADD_PROPERTY_TYPE(CacheKey,(""),"Boolean",(App::PropertyType)
+        (App::Prop_Output|App::Prop_Hidden), "Key of the operands of the saved shape");
 
     this->Refine.setValue(getRefineModelParameter());
 }
@@ -127,31 +137,49 @@ App::DocumentObjectExecReturn* Boolean::execute()
             throw NullShapeException("Tool shape is null");
         }
 
-        std::unique_ptr<BRepAlgoAPI_BooleanOperation> mkBool(makeOperation(BaseShape, ToolShape));
-        if (!mkBool->IsDone()) {
-            std::stringstream error;
-            error << "Boolean operation failed";
-            if (BaseShape.ShapeType() != TopAbs_SOLID) {
-                error << std::endl << base->Label.getValue() << " is not a solid";
-            }
-            if (ToolShape.ShapeType() != TopAbs_SOLID) {
-                error << std::endl << tool->Label.getValue() << " is not a solid";
-            }
-            return new App::DocumentObjectExecReturn(error.str());
+        TopoShape res(0);
+        std::string cacheKey;
+        if (BooleanCache::getMaxMemory() > 0 || getPersistCacheParameter()) {
+            cacheKey = BooleanCache::makeKey(getTypeId().getName(), shapes, 0.0, res);
         }
-        TopoDS_Shape resShape = mkBool->Shape();
-        if (resShape.IsNull()) {
-            return new App::DocumentObjectExecReturn("Resulting shape is null");
+
+        // the saved shape was made of the same operands
+        std::string savedKey = cacheKey + (this->Refine.getValue() ? " refined" : "");
+        if (!cacheKey.empty() && getPersistCacheParameter() && savedKey == CacheKey.getValue()
+            && !this->Shape.getValue().IsNull()) {
+            copyMaterial(base);
+            return Part::Feature::execute();
         }
 
-        throwIfInvalidIfCheckModel(resShape);
+        if (cacheKey.empty() || !BooleanCache::find(cacheKey, res)) {
+            std::unique_ptr<BRepAlgoAPI_BooleanOperation> mkBool(makeOperation(BaseShape, ToolShape));
+            if (!mkBool->IsDone()) {
+                std::stringstream error;
+                error << "Boolean operation failed";
+                if (BaseShape.ShapeType() != TopAbs_SOLID) {
+                    error << std::endl << base->Label.getValue() << " is not a solid";
+                }
+                if (ToolShape.ShapeType() != TopAbs_SOLID) {
+                    error << std::endl << tool->Label.getValue() << " is not a solid";
+                }
+                return new App::DocumentObjectExecReturn(error.str());
+            }
+            TopoDS_Shape resShape = mkBool->Shape();
+            if (resShape.IsNull()) {
+                return new App::DocumentObjectExecReturn("Resulting shape is null");
+            }
 
-        TopoShape res(0);
-        res.makeElementShape(*mkBool, shapes, opCode());
+            throwIfInvalidIfCheckModel(resShape);
+            res.makeElementShape(*mkBool, shapes, opCode());
+            if (!cacheKey.empty() && BooleanCache::getMaxMemory() > 0) {
+                BooleanCache::insert(cacheKey, res);
+            }
+        }
         if (this->Refine.getValue()) {
             res = res.makeElementRefine();
         }
         this->Shape.setValue(res);
+        CacheKey.setValue(getPersistCacheParameter() ? savedKey : std::string());
         copyMaterial(base);
         return Part::Feature::execute();
     }
@@ -43,6 +43,8 @@ public:
     App::PropertyLink Tool;
     PropertyShapeHistory History;
     App::PropertyBool Refine;
+    /// The key of the operands of the saved shape if the boolean cache is persisted
+    App::PropertyString CacheKey;
 
     /** @name methods override Feature */
     //@{
@@ -22,14 +22,25 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
+# include <atomic>
+# include <numeric>
+# include <thread>
+
 # include <Mod/Part/App/FCBRepAlgoAPI_Fuse.h>
+# include <Bnd_Box.hxx>
+# include <BRepBndLib.hxx>
 # include <BRepCheck_Analyzer.hxx>
+# include <Precision.hxx>
 # include <Standard_Failure.hxx>
 # include <TopoDS_Iterator.hxx>
 # include <TopExp.hxx>
 # include <TopTools_IndexedMapOfShape.hxx>
 #endif
 
+#include <App/Application.h>
+#include <Base/Parameter.h>
+
 #include "FeaturePartFuse.h"
 #include "TopoShape.h"
 #include "modelRefine.h"
@@ -43,6 +54,114 @@ namespace Part
 {
     extern void throwIfInvalidIfCheckModel(const TopoDS_Shape& shape);
     extern bool getRefineModelParameter();
+
+bool getParallelFuseParameter()
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
+    return hGrp->GetBool("ParallelMultiFuse", false);
+}
+}
+
+namespace
+{
+
+// A node of the fusion tree, the fused shape of some of the input shapes
+struct FuseNode
+{
+    TopoShape shape;
+    Bnd_Box box;
+    // the indices of the input shapes and the history of their faces in the fused shape
+    std::vector<std::size_t> inputs;
+    std::vector<ShapeHistory> history;
+};
+
+ShapeHistory identityHistory(const TopoDS_Shape& shape)
+{
+    ShapeHistory history;
+    history.type = TopAbs_FACE;
+    TopTools_IndexedMapOfShape faces;
+    TopExp::MapShapes(shape, TopAbs_FACE, faces);
+    for (int i = 0; i < faces.Extent(); i++) {
+        history.shapeMap[i] = {i};
+    }
+    return history;
+}
+
+std::vector<std::vector<FuseNode>> makeClusters(const std::vector<TopoShape>& shapes)
+{
+    std::vector<FuseNode> leaves(shapes.size());
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        leaves[i].shape = shapes[i];
+        BRepBndLib::Add(shapes[i].getShape(), leaves[i].box);
+        leaves[i].box.Enlarge(Precision::Confusion());
+        leaves[i].inputs.push_back(i);
+        leaves[i].history.push_back(identityHistory(shapes[i].getShape()));
+    }
+
+    // shapes with overlapping bounding boxes belong to the same cluster
+    std::vector<std::size_t> parent(leaves.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto root = [&parent](std::size_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    for (std::size_t i = 0; i < leaves.size(); i++) {
+        for (std::size_t j = i + 1; j < leaves.size(); j++) {
+            if (!leaves[i].box.IsOut(leaves[j].box)) {
+                parent[root(i)] = root(j);
+            }
+        }
+    }
+
+    std::vector<std::vector<FuseNode>> clusters;
+    std::vector<std::size_t> clusterOf(leaves.size(), leaves.size());
+    for (std::size_t i = 0; i < leaves.size(); i++) {
+        std::size_t index = root(i);
+        if (clusterOf[index] == leaves.size()) {
+            clusterOf[index] = clusters.size();
+            clusters.emplace_back();
+        }
+        clusters[clusterOf[index]].push_back(std::move(leaves[i]));
+    }
+
+    // sort along the longest side of a cluster so that neighbouring shapes are fused first
+    for (auto& cluster : clusters) {
+        Bnd_Box box;
+        for (const auto& it : cluster) {
+            box.Add(it.box);
+        }
+        if (box.IsVoid()) {
+            continue;
+        }
+        double xMin {}, yMin {}, zMin {}, xMax {}, yMax {}, zMax {};
+        box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        gp_XYZ size(xMax - xMin, yMax - yMin, zMax - zMin);
+        int axis = 1;
+        if (size.Y() > size.Coord(axis)) {
+            axis = 2;
+        }
+        if (size.Z() > size.Coord(axis)) {
+            axis = 3;
+        }
+        auto center = [axis](const FuseNode& node) {
+            return node.box.IsVoid() ? 0.0
+                                     : 0.5 * (node.box.CornerMin().Coord(axis)
+                                              + node.box.CornerMax().Coord(axis));
+        };
+        std::stable_sort(cluster.begin(),
+                         cluster.end(),
+                         [&center](const FuseNode& node1, const FuseNode& node2) {
+                             return center(node1) < center(node2);
+                         });
+    }
+
+    return clusters;
+}
+
 }
 
 PROPERTY_SOURCE(Part::Fuse, Part::Boolean)
@@ -75,17 +194,157 @@ MultiFuse::MultiFuse()
     History.setSize(0);
 
     ADD_PROPERTY_TYPE(Refine,(0),"Boolean",(App::PropertyType)(App::Prop_None),"Refine shape (clean up redundant edges) after this boolean operation");
+    ADD_PROPERTY_TYPE(ParallelFuse,(false),"Boolean",(App::PropertyType)(App::Prop_None),
+        "Fuse clusters of overlapping shapes on several threads and combine them pairwise");
 
     this->Refine.setValue(getRefineModelParameter());
+    this->ParallelFuse.setValue(getParallelFuseParameter());
 }
 
 short MultiFuse::mustExecute() const
 {
     if (Shapes.isTouched())
         return 1;
+    if (ParallelFuse.isTouched())
+        return 1;
     return 0;
 }
 
+TopoShape MultiFuse::fuseClusters(const std::vector<TopoShape>& shapes,
+                                  std::vector<ShapeHistory>& history)
+{
+    std::vector<std::vector<FuseNode>> clusters = makeClusters(shapes);
+    const std::size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+
+    for (;;) {
+        std::vector<std::pair<FuseNode*, FuseNode*>> pairs;
+        for (auto& cluster : clusters) {
+            for (std::size_t i = 0; i + 1 < cluster.size(); i += 2) {
+                pairs.emplace_back(&cluster[i], &cluster[i + 1]);
+            }
+        }
+        if (pairs.empty()) {
+            break;
+        }
+
+        // The pairs of a level are fused concurrently, the element maps are made afterwards as
+        // the string hasher isn't thread-safe
+        std::vector<std::unique_ptr<FCBRepAlgoAPI_Fuse>> makers(pairs.size());
+        std::vector<std::string> errors(pairs.size());
+        std::atomic<std::size_t> next {0};
+        auto work = [&]() {
+            for (std::size_t i = next++; i < pairs.size(); i = next++) {
+                try {
+                    auto mkFuse = std::make_unique<FCBRepAlgoAPI_Fuse>();
+                    TopTools_ListOfShape shapeArguments, shapeTools;
+                    shapeArguments.Append(pairs[i].first->shape.getShape());
+                    shapeTools.Append(pairs[i].second->shape.getShape());
+                    mkFuse->SetArguments(shapeArguments);
+                    mkFuse->SetTools(shapeTools);
+                    mkFuse->setAutoFuzzy();
+                    // the threads of the kernel are only used for the last levels
+                    mkFuse->SetRunParallel(pairs.size() < threads ? Standard_True : Standard_False);
+                    mkFuse->Build();
+                    makers[i] = std::move(mkFuse);
+                }
+                catch (Standard_Failure& e) {
+                    errors[i] = e.GetMessageString();
+                }
+                catch (...) {
+                    errors[i] = "MultiFusion failed";
+                }
+            }
+        };
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < std::min(threads, pairs.size()); i++) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (auto& it : workers) {
+            it.join();
+        }
+
+        for (std::size_t i = 0; i < pairs.size(); i++) {
+            if (!errors[i].empty()) {
+                throw Base::CADKernelError(errors[i]);
+            }
+            FCBRepAlgoAPI_Fuse& mkFuse = *makers[i];
+            if (!mkFuse.IsDone()) {
+                throw Base::RuntimeError("MultiFusion failed");
+            }
+
+            FuseNode& first = *pairs[i].first;
+            FuseNode& second = *pairs[i].second;
+            FuseNode node;
+            node.shape = TopoShape(0).makeShapeWithElementMap(mkFuse.Shape(),
+                                                              MapperMaker(mkFuse),
+                                                              {first.shape, second.shape},
+                                                              OpCodes::Fuse);
+            node.box = first.box;
+            node.box.Add(second.box);
+            for (FuseNode* it : {&first, &second}) {
+                ShapeHistory hist =
+                    buildHistory(mkFuse, TopAbs_FACE, node.shape.getShape(), it->shape.getShape());
+                for (std::size_t j = 0; j < it->inputs.size(); j++) {
+                    node.inputs.push_back(it->inputs[j]);
+                    node.history.push_back(joinHistory(it->history[j], hist));
+                }
+            }
+            first = std::move(node);
+            second.inputs.clear();
+        }
+        makers.clear();
+
+        for (auto& cluster : clusters) {
+            cluster.erase(std::remove_if(cluster.begin(),
+                                         cluster.end(),
+                                         [](const FuseNode& node) {
+                                             return node.inputs.empty();
+                                         }),
+                          cluster.end());
+        }
+    }
+
+    // a fusion of disjoint shapes is the compound of them
+    TopoShape res(0);
+    if (clusters.size() == 1) {
+        res = clusters.front().front().shape;
+    }
+    else {
+        std::vector<TopoShape> parts;
+        for (const auto& cluster : clusters) {
+            const TopoShape& shape = cluster.front().shape;
+            if (shape.shapeType(true) == TopAbs_COMPOUND) {
+                auto subShapes = shape.getSubTopoShapes();
+                parts.insert(parts.end(), subShapes.begin(), subShapes.end());
+            }
+            else {
+                parts.push_back(shape);
+            }
+        }
+        res.makeElementCompound(parts);
+    }
+
+    TopTools_IndexedMapOfShape faces;
+    TopExp::MapShapes(res.getShape(), TopAbs_FACE, faces);
+    history.assign(shapes.size(), ShapeHistory());
+    for (const auto& cluster : clusters) {
+        const FuseNode& node = cluster.front();
+        ShapeHistory hist;
+        hist.type = TopAbs_FACE;
+        TopTools_IndexedMapOfShape nodeFaces;
+        TopExp::MapShapes(node.shape.getShape(), TopAbs_FACE, nodeFaces);
+        for (int i = 1; i <= nodeFaces.Extent(); i++) {
+            hist.shapeMap[i - 1] = {faces.FindIndex(nodeFaces(i)) - 1};
+        }
+        for (std::size_t j = 0; j < node.inputs.size(); j++) {
+            history[node.inputs[j]] = joinHistory(node.history[j], hist);
+        }
+    }
+
+    return res;
+}
+
 App::DocumentObjectExecReturn *MultiFuse::execute()
 {
     std::vector<TopoShape> shapes;
@@ -116,35 +375,45 @@ App::DocumentObjectExecReturn *MultiFuse::execute()
     if (shapes.size() >= 2) {
         try {
             std::vector<ShapeHistory> history;
-            FCBRepAlgoAPI_Fuse mkFuse;
-            TopTools_ListOfShape shapeArguments, shapeTools;
-            const TopoShape& shape = shapes.front();
-            if (shape.isNull()) {
-                throw Base::RuntimeError("Input shape is null");
+            TopoShape res(0);
+            if (this->ParallelFuse.getValue() && shapes.size() > 2) {
+                for (const auto& it2 : shapes) {
+                    if (it2.isNull()) {
+                        throw Base::RuntimeError("Input shape is null");
+                    }
+                }
+                res = fuseClusters(shapes, history);
             }
-            shapeArguments.Append(shape.getShape());
-
-            for (auto it2 = shapes.begin() + 1; it2 != shapes.end(); ++it2) {
-                if (it2->isNull()) {
+            else {
+                FCBRepAlgoAPI_Fuse mkFuse;
+                TopTools_ListOfShape shapeArguments, shapeTools;
+                const TopoShape& shape = shapes.front();
+                if (shape.isNull()) {
                     throw Base::RuntimeError("Input shape is null");
                 }
-                shapeTools.Append(it2->getShape());
-            }
+                shapeArguments.Append(shape.getShape());
 
-            mkFuse.SetArguments(shapeArguments);
-            mkFuse.SetTools(shapeTools);
-            mkFuse.setAutoFuzzy();
-            mkFuse.Build();
+                for (auto it2 = shapes.begin() + 1; it2 != shapes.end(); ++it2) {
+                    if (it2->isNull()) {
+                        throw Base::RuntimeError("Input shape is null");
+                    }
+                    shapeTools.Append(it2->getShape());
+                }
 
-            if (!mkFuse.IsDone()) {
-                throw Base::RuntimeError("MultiFusion failed");
-            }
+                mkFuse.SetArguments(shapeArguments);
+                mkFuse.SetTools(shapeTools);
+                mkFuse.setAutoFuzzy();
+                mkFuse.Build();
 
-            TopoShape res(0);
-            res = res.makeShapeWithElementMap(mkFuse.Shape(), MapperMaker(mkFuse), shapes, OpCodes::Fuse);
-            for (const auto& it2 : shapes) {
-                history.push_back(
-                    buildHistory(mkFuse, TopAbs_FACE, res.getShape(), it2.getShape()));
+                if (!mkFuse.IsDone()) {
+                    throw Base::RuntimeError("MultiFusion failed");
+                }
+
+                res = res.makeShapeWithElementMap(mkFuse.Shape(), MapperMaker(mkFuse), shapes, OpCodes::Fuse);
+                for (const auto& it2 : shapes) {
+                    history.push_back(
+                        buildHistory(mkFuse, TopAbs_FACE, res.getShape(), it2.getShape()));
+                }
             }
             if (res.isNull()) {
                 throw Base::RuntimeError("Resulting shape is null");
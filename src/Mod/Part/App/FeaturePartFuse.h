@@ -55,6 +55,7 @@ public:
     App::PropertyLinkList Shapes;
     PropertyShapeHistory History;
     App::PropertyBool Refine;
+    App::PropertyBool ParallelFuse;
 
     /** @name methods override feature */
     //@{
@@ -67,6 +68,14 @@ public:
         return "PartGui::ViewProviderMultiFuse";
     }
 
+private:
+    /**
+     * Groups the shapes into clusters of overlapping bounding boxes and fuses them pairwise in a
+     * balanced tree, the pairs of a level are fused on several threads. \a history gets the face
+     * history of every shape in the result.
+     */
+    TopoShape fuseClusters(const std::vector<TopoShape>& shapes,
+                           std::vector<ShapeHistory>& history);
 };
 
 }
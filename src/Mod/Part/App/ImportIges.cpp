@@ -22,7 +22,12 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
+# include <exception>
 # include <fcntl.h>
+# include <mutex>
+# include <thread>
+# include <vector>
 # include <BRep_Builder.hxx>
 # include <IGESBasic_Group.hxx>
 # include <IGESBasic_SingularSubfigure.hxx>
@@ -51,6 +56,92 @@ FC_LOG_LEVEL_INIT("Part")
 
 using namespace Part;
 
+namespace
+{
+
+// the parser of IGES files keeps its state in globals
+std::mutex readMutex;
+
+/// Transfers the roots from \a first to \a last, a reader may only be used by one thread
+std::vector<TopoDS_Shape> transferRoots(IGESControl_Reader& reader,
+                                        Standard_Integer first,
+                                        Standard_Integer last)
+{
+    reader.ClearShapes();
+    for (Standard_Integer i = first; i <= last; i++) {
+        reader.TransferOneRoot(i);
+    }
+
+    std::vector<TopoDS_Shape> shapes;
+    for (Standard_Integer i = 1; i <= reader.NbShapes(); i++) {
+        shapes.push_back(reader.Shape(i));
+    }
+    return shapes;
+}
+
+/// Transfers the roots of a large file in several threads. Each thread reads the file into a
+/// model and a reader of its own, and the shape healing of its roots runs in the same thread.
+std::vector<TopoDS_Shape> transferAllRoots(IGESControl_Reader& aReader, const char* FileName)
+{
+    constexpr const Standard_Integer minRootsPerThread = 500;
+    const Standard_Integer nbRoots = aReader.NbRootsForTransfer();
+    const Standard_Integer threads =
+        std::min(static_cast<Standard_Integer>(std::max(std::thread::hardware_concurrency(), 1U)),
+                 nbRoots / minRootsPerThread);
+    if (threads <= 1) {
+        return transferRoots(aReader, 1, nbRoots);
+    }
+
+    std::vector<std::vector<TopoDS_Shape>> results(threads);
+    std::vector<std::exception_ptr> errors(threads);
+    auto work = [&](Standard_Integer index) {
+        try {
+            Standard_Integer first = 1 + index * nbRoots / threads;
+            Standard_Integer last = (index + 1) * nbRoots / threads;
+            if (index == 0) {
+                results[index] = transferRoots(aReader, first, last);
+                return;
+            }
+
+            IGESControl_Reader reader;
+            reader.SetReadVisible(Standard_True);
+            {
+                std::lock_guard<std::mutex> lock(readMutex);
+                if (reader.ReadFile(FileName) != IFSelect_RetDone) {
+                    throw Base::FileException("Error in reading IGES");
+                }
+            }
+            results[index] = transferRoots(reader, first, last);
+        }
+        catch (...) {
+            errors[index] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (Standard_Integer i = 1; i < threads; i++) {
+        workers.emplace_back(work, i);
+    }
+    work(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    std::vector<TopoDS_Shape> shapes;
+    for (auto& result : results) {
+        shapes.insert(shapes.end(), result.begin(), result.end());
+    }
+    return shapes;
+}
+
+}  // namespace
+
 int Part::ImportIgesParts(App::Document *pcDoc, const char* FileName)
 {
     FC_WARN("Importing IGES via 'Part' is deprecated. Use 'ImportGui' instead.");
@@ -79,9 +170,7 @@ int Part::ImportIgesParts(App::Document *pcDoc, const char* FileName)
         std::string aName = fi.fileNamePure();
 
         // make model
-        aReader.ClearShapes();
-        //Standard_Integer nbRootsForTransfer = aReader.NbRootsForTransfer();
-        aReader.TransferRoots();
+        std::vector<TopoDS_Shape> shapes = transferAllRoots(aReader, FileName);
 
         // put all other free-flying shapes into a single compound
         Standard_Boolean emptyComp = Standard_True;
@@ -89,9 +178,7 @@ int Part::ImportIgesParts(App::Document *pcDoc, const char* FileName)
         TopoDS_Compound comp;
         builder.MakeCompound(comp);
 
-        Standard_Integer nbShapes = aReader.NbShapes();
-        for (Standard_Integer i=1; i<=nbShapes; i++) {
-            TopoDS_Shape aShape = aReader.Shape(i);
+        for (const auto& aShape : shapes) {
             if (!aShape.IsNull()) {
                 if (aShape.ShapeType() == TopAbs_SOLID ||
                     aShape.ShapeType() == TopAbs_COMPOUND ||
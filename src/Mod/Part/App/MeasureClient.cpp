@@ -449,6 +449,11 @@ MeasureDistanceInfoPtr MeasureDistanceHandler(const App::SubObjectT& subject)
 }
 
 
+TopoDS_Shape Part::MeasureClient::getLocatedShape(const App::SubObjectT& subject)
+{
+    return ::getLocatedShape(subject);
+}
+
 void Part::MeasureClient::initialize() {
     App::MeasureManager::addMeasureHandler("Part", PartMeasureTypeCb);
 
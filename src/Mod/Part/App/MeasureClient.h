@@ -44,6 +44,9 @@ public:
     static CallbackRegistrationList reportAngleCB();
     static CallbackRegistrationList reportDistanceCB();
     static CallbackRegistrationList reportRadiusCB();
+
+    // The shape of the element of subject where the handlers measure it, null if it has none
+    static TopoDS_Shape getLocatedShape(const App::SubObjectT& subject);
 };
 
 
@@ -272,6 +272,16 @@ bool ImportExportSettings::getShowProgress() const
     return pGroup->GetBool("ShowProgress", true);
 }
 
+void ImportExportSettings::setUseImportCache(bool on)
+{
+    pGroup->SetBool("UseImportCache", on);
+}
+
+bool ImportExportSettings::getUseImportCache() const
+{
+    return pGroup->GetBool("UseImportCache", false);
+}
+
 void ImportExportSettings::setImportMode(ImportExportSettings::ImportMode mode)
 {
     pGroup->SetInt("ImportMode", static_cast<long>(mode));
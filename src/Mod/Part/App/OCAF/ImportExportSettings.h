@@ -95,6 +95,9 @@ public:
     void setShowProgress(bool);
     bool getShowProgress() const;
 
+    void setUseImportCache(bool);
+    bool getUseImportCache() const;
+
     void setImportMode(ImportMode);
     ImportMode getImportMode() const;
 
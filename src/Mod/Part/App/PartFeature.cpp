@@ -23,7 +23,9 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <mutex>
 # include <sstream>
+# include <unordered_map>
 # include <Bnd_Box.hxx>
 # include <BRepAdaptor_Curve.hxx>
 # include <Mod/Part/App/FCBRepAlgoAPI_Fuse.h>
@@ -82,6 +84,103 @@
 using namespace Part;
 namespace sp = std::placeholders;
 
+namespace
+{
+// The shapes resolved by Feature::getTopoShape(), which resolves the same objects repeatedly
+// within a recompute or while picking. Any change of an object or of the dependencies drops
+// the whole cache, so an entry never outlives a change of an object in its resolved path.
+class ResolvedShapeCache
+{
+public:
+    struct Key
+    {
+        const App::DocumentObject* obj;
+        long id;
+        std::string subname;
+        int options;
+        bool hasMatrix;
+        Base::Matrix4D matrix;
+
+        bool operator==(const Key& other) const
+        {
+            return obj == other.obj && id == other.id && options == other.options
+                && hasMatrix == other.hasMatrix && subname == other.subname
+                && (!hasMatrix || matrix == other.matrix);
+        }
+    };
+    struct Entry
+    {
+        TopoShape shape;
+        Base::Matrix4D matrix;
+        App::DocumentObject* owner;
+    };
+
+    static ResolvedShapeCache& instance()
+    {
+        static ResolvedShapeCache cache;
+        return cache;
+    }
+
+    bool get(const Key& key, Entry& entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        validate();
+        auto it = entries.find(key);
+        if (it == entries.end()) {
+            return false;
+        }
+        entry = it->second;
+        return true;
+    }
+
+    void set(Key key, Entry entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        validate();
+        if (entries.size() >= maxEntries) {
+            entries.clear();
+        }
+        entries.emplace(std::move(key), std::move(entry));
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+    }
+
+private:
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const
+        {
+            std::size_t hash = std::hash<const void*> {}(key.obj);
+            std::size_t name = std::hash<std::string> {}(key.subname);
+            hash ^= name + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            return hash ^ (static_cast<std::size_t>(key.options) << 1);
+        }
+    };
+
+    // the caller holds the mutex
+    void validate()
+    {
+        auto changes = App::DocumentObject::getChangeGeneration();
+        auto dependencies = App::DocumentObject::getDependencyGeneration();
+        if (changes != changeGeneration || dependencies != dependencyGeneration) {
+            entries.clear();
+            changeGeneration = changes;
+            dependencyGeneration = dependencies;
+        }
+    }
+
+    static constexpr std::size_t maxEntries = 1000;
+    std::mutex mutex;
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    std::size_t changeGeneration {0};
+    std::size_t dependencyGeneration {0};
+};
+}  // namespace
+
 FC_LOG_LEVEL_INIT("Part",true,true)
 
 PROPERTY_SOURCE(Part::Feature, App::GeoFeature)
@@ -894,7 +993,7 @@ void Feature::setMaterialAppearance(const App::Material& material)
 
 // Toponaming project March 2024:  This method should be going away when we get to the python layer.
 void Feature::clearShapeCache() {
-//    _ShapeCache.cache.clear();
+    ResolvedShapeCache::instance().clear();
 }
 
 /*
@@ -1313,14 +1412,37 @@ TopoShape Feature::getTopoShape(const App::DocumentObject* obj,
         }
     }
 
+    // Objects of a document being restored may still change without their properties changing
+    bool useCache = !obj->getDocument()->testStatus(App::Document::Restoring);
+    ResolvedShapeCache::Key key {obj,
+                                 obj->getID(),
+                                 subname ? subname : "",
+                                 static_cast<int>(options.toUnderlyingType()),
+                                 pmat != nullptr,
+                                 pmat ? *pmat : Base::Matrix4D()};
+    ResolvedShapeCache::Entry entry;
+    if (useCache && ResolvedShapeCache::instance().get(key, entry)) {
+        if (powner) {
+            *powner = entry.owner;
+        }
+        if (pmat) {
+            *pmat = entry.matrix;
+        }
+        return entry.shape;
+    }
+
+    App::DocumentObject* owner = nullptr;
     Base::Matrix4D mat;
     auto shape = _getTopoShape(obj,
                                options,
                                subname,
                                &mat,
-                               powner,
+                               &owner,
                                hiddens,
                                lastLink);
+    if (powner) {
+        *powner = owner;
+    }
     if (options.testFlag(ShapeOption::NeedSubElement) 
         && !options.testFlag(ShapeOption::DontSimplifyCompound) 
         && shape.shapeType(true) == TopAbs_COMPOUND) {
@@ -1342,6 +1464,10 @@ TopoShape Feature::getTopoShape(const App::DocumentObject* obj,
         *pmat = topMat * mat;
     }
 
+    if (useCache) {
+        ResolvedShapeCache::instance().set(std::move(key),
+                                           {shape, pmat ? *pmat : Base::Matrix4D(), owner});
+    }
     return shape;
 }
 TopoShape Feature::simplifyCompound(TopoShape compoundShape)
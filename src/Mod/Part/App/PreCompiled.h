@@ -39,6 +39,7 @@
 
 // STL
 #include <array>
+#include <charconv>
 #include <fcntl.h>
 #include <fstream>
 #include <list>
@@ -134,6 +134,21 @@ void PropertyGeometryList::set1Value(int idx, std::unique_ptr<Geometry> &&lValue
     hasSetValue();
 }
 
+void PropertyGeometryList::modifyValues(
+    const std::function<void(const std::vector<Geometry*>&)>& modify)
+{
+    aboutToSetValue();
+    try {
+        modify(_lValueList);
+    }
+    catch (...) {
+        // the geometries may be changed partially
+        hasSetValue();
+        throw;
+    }
+    hasSetValue();
+}
+
 PyObject *PropertyGeometryList::getPyObject()
 {
     Py::List list;
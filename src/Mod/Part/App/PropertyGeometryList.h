@@ -23,6 +23,7 @@
 #ifndef APP_PropertyGeometryList_H
 #define APP_PropertyGeometryList_H
 
+#include <functional>
 #include <vector>
 
 #include <App/Property.h>
@@ -77,6 +78,13 @@ public:
 
     void set1Value(int idx, std::unique_ptr<Geometry> &&);
 
+    /** Changes the geometries in place
+     * \a modify may change the geometries of the list but not the list itself. The change is
+     * recorded and notified like a setValues(), but the geometries are neither cloned nor
+     * replaced, so they keep their extensions and the pointers to them stay valid.
+     */
+    void modifyValues(const std::function<void(const std::vector<Geometry*>&)>& modify);
+
     PyObject *getPyObject() override;
     void setPyObject(PyObject *) override;
 
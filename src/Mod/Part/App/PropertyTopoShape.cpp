@@ -23,6 +23,8 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <iterator>
+# include <mutex>
 # include <sstream>
 # include <Bnd_Box.hxx>
 # include <BRepBndLib.hxx>
@@ -49,6 +51,7 @@
 #include "PartFeature.h"
 #include "PartPyCXX.h"
 #include "PropertyTopoShape.h"
+#include "ShapeFileCache.h"
 #include "TopoShapePy.h"
 #include "PartFeature.h"
 
@@ -59,13 +62,142 @@ using namespace Part;
 
 TYPESYSTEM_SOURCE(Part::PropertyPartShape , App::PropertyComplexGeoData)
 
+namespace {
+// Guards the shapes restored lazily, which may be loaded from several threads
+// during a concurrent recompute
+std::mutex& lazyMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+// The document of the object whose shape is restored by a property
+const App::Document* getContainerDocument(const App::Property* prop)
+{
+    auto obj = freecad_cast<App::DocumentObject*>(prop->getContainer());
+    return obj ? obj->getDocument() : nullptr;
+}
+}
+
 PropertyPartShape::PropertyPartShape() = default;
 
 PropertyPartShape::~PropertyPartShape() = default;
 
+bool PropertyPartShape::isSameShape(const TopoDS_Shape& shape, long tag, size_t mapSize) const
+{
+    // Same TShape, location and orientation, i.e. geometrically identical,
+    // and no change in the element map
+    return !shape.IsNull() && shape.IsEqual(_Shape.getShape()) && tag == _Shape.Tag
+        && mapSize == _Shape.getElementMapSize(false);
+}
+
+bool PropertyPartShape::isLazyRestoreEnabled()
+{
+    return App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("LazyRestore", false);
+}
+
+bool PropertyPartShape::isSaveTriangulationEnabled()
+{
+    return App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("SaveTriangulation", false);
+}
+
+bool PropertyPartShape::isLoaded() const
+{
+    return !_IsLazy.load(std::memory_order_acquire);
+}
+
+bool PropertyPartShape::isNull() const
+{
+    return _Shape.isNull() && isLoaded();
+}
+
+void PropertyPartShape::loadLazyShape() const
+{
+    if (isLoaded())
+        return;
+
+    std::lock_guard<std::mutex> lock(lazyMutex());
+    if (isLoaded())
+        return;
+
+    auto lazy = _Lazy;
+    TopoShape shape;
+    std::istringstream str(lazy->data);
+    if (lazy->binary) {
+        shape.importBinary(str);
+    }
+    else {
+        try {
+            str.exceptions(std::istream::failbit | std::istream::badbit);
+            BRep_Builder builder;
+            TopoDS_Shape sh;
+            BRepTools::Read(sh, str, builder);
+            shape.setShape(sh);
+        }
+        catch (const std::exception&) {
+            if (!str.eof())
+                Base::Console().warning("Failed to load BRep file %s\n", lazy->fileName.c_str());
+        }
+    }
+
+    // Same as RestoreDocFile() but without notification because the value
+    // is logically unchanged
+    auto self = const_cast<PropertyPartShape*>(this);
+    shape.Hasher = _Shape.Hasher;
+    shape.resetElementMap(self->_Shape.resetElementMap());
+    shape.Tag = _Shape.Tag;
+    if (auto obj = freecad_cast<App::DocumentObject*>(getContainer())) {
+        if (!shape.Tag)
+            shape.Tag = obj->getID();
+        if (!shape.Hasher && shape.hasChildElementMap()) {
+            shape.Hasher = obj->getDocument()->getStringHasher();
+            shape.hashChildMaps();
+        }
+    }
+    self->_Shape = shape;
+    self->_Lazy.reset();
+    _IsLazy.store(false, std::memory_order_release);
+}
+
+void PropertyPartShape::discardLazyShape()
+{
+    std::lock_guard<std::mutex> lock(lazyMutex());
+    _Lazy.reset();
+    _IsLazy.store(false, std::memory_order_release);
+}
+
+unsigned long PropertyPartShape::countSubShapes(TopAbs_ShapeEnum type) const
+{
+    if (!isLoaded()) {
+        std::lock_guard<std::mutex> lock(lazyMutex());
+        auto lazy = _Lazy;
+        if (lazy && lazy->hasInfo) {
+            switch (type) {
+            case TopAbs_FACE:
+                return lazy->faces;
+            case TopAbs_EDGE:
+                return lazy->edges;
+            case TopAbs_VERTEX:
+                return lazy->vertexes;
+            default:
+                break;
+            }
+        }
+    }
+    return getShape().countSubShapes(type);
+}
+
 void PropertyPartShape::setValue(const TopoShape& sh)
 {
     aboutToSetValue();
+    // The previous shape is unknown if it was never loaded
+    bool lazy = !isLoaded();
+    discardLazyShape();
+    TopoDS_Shape old = _Shape.getShape();
+    long oldTag = _Shape.Tag;
+    size_t oldMapSize = _Shape.getElementMapSize(false);
     _Shape = sh;
     auto obj = freecad_cast<App::DocumentObject*>(getContainer());
     if(obj) {
@@ -87,28 +219,39 @@ void PropertyPartShape::setValue(const TopoShape& sh)
             _Shape.hashChildMaps();
         }
     }
+    setStatus(Status::SameValue, !lazy && isSameShape(old, oldTag, oldMapSize));
     hasSetValue();
+    setStatus(Status::SameValue, false);
     _Ver.clear();
 }
 
 void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
 {
     aboutToSetValue();
+    bool lazy = !isLoaded();
+    discardLazyShape();
+    TopoDS_Shape old = _Shape.getShape();
+    long oldTag = _Shape.Tag;
+    size_t oldMapSize = _Shape.getElementMapSize(false);
     auto obj = dynamic_cast<App::DocumentObject*>(getContainer());
     if(obj)
         _Shape.Tag = obj->getID();
     _Shape.setShape(sh,resetElementMap);
+    setStatus(Status::SameValue, !lazy && isSameShape(old, oldTag, oldMapSize));
     hasSetValue();
+    setStatus(Status::SameValue, false);
     _Ver.clear();
 }
 
 const TopoDS_Shape& PropertyPartShape::getValue() const
 {
+    loadLazyShape();
     return _Shape.getShape();
 }
 
 const TopoShape& PropertyPartShape::getShape() const
 {
+    loadLazyShape();
     _Shape.initCache(-1);
     // March, 2024 Toponaming project:  There was originally an unused feature to disable
     // elementMapping that has not been kept:
@@ -125,12 +268,20 @@ const TopoShape& PropertyPartShape::getShape() const
 
 const Data::ComplexGeoData* PropertyPartShape::getComplexData() const
 {
+    loadLazyShape();
     _Shape.initCache(-1);
     return &(this->_Shape);
 }
 
 Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 {
+    if (!isLoaded()) {
+        std::lock_guard<std::mutex> lock(lazyMutex());
+        if (_Lazy && _Lazy->hasInfo)
+            return _Lazy->boundBox;
+    }
+    loadLazyShape();
+
     Base::BoundBox3d box;
     if (_Shape.getShape().IsNull())
         return box;
@@ -157,16 +308,19 @@ Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 
 void PropertyPartShape::setTransform(const Base::Matrix4D &rclTrf)
 {
+    loadLazyShape();
     _Shape.setTransform(rclTrf);
 }
 
 Base::Matrix4D PropertyPartShape::getTransform() const
 {
+    loadLazyShape();
     return _Shape.getTransform();
 }
 
 void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 {
+    loadLazyShape();
     aboutToSetValue();
     _Shape.transformGeometry(rclTrf);
     hasSetValue();
@@ -174,6 +328,7 @@ void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 
 PyObject *PropertyPartShape::getPyObject()
 {
+    loadLazyShape();
     Base::PyObjectBase* prop = static_cast<Base::PyObjectBase*>(_Shape.getPyObject());
     if (prop)
         prop->setConst();
@@ -219,8 +374,14 @@ App::Property *PropertyPartShape::Copy() const
 //        prop->_Shape = this->_Shape.makeElementCopy();
 //    } else
 //        prop->_Shape = this->_Shape;
+    // A copy, e.g. for undo, shares the content of a shape not loaded yet
+    std::lock_guard<std::mutex> lock(lazyMutex());
     prop->_Shape = this->_Shape;
     prop->_Ver = this->_Ver;
+    if (!isLoaded()) {
+        prop->_Lazy = _Lazy;
+        prop->_IsLazy.store(true, std::memory_order_release);
+    }
     return prop;
 }
 
@@ -228,6 +389,7 @@ void PropertyPartShape::Paste(const App::Property &from)
 {
     auto prop = freecad_cast<const PropertyPartShape*>(&from);
     if(prop) {
+        prop->loadLazyShape();
         setValue(prop->_Shape);
         _Ver = prop->_Ver;
     }
@@ -235,6 +397,11 @@ void PropertyPartShape::Paste(const App::Property &from)
 
 unsigned int PropertyPartShape::getMemSize () const
 {
+    if (!isLoaded()) {
+        std::lock_guard<std::mutex> lock(lazyMutex());
+        if (_Lazy)
+            return _Shape.getMemSize() + static_cast<unsigned int>(_Lazy->data.size());
+    }
     return _Shape.getMemSize();
 }
 
@@ -294,7 +461,7 @@ void PropertyPartShape::beforeSave() const
     _HasherIndex = 0;
     _SaveHasher = false;
     auto owner = freecad_cast<App::DocumentObject*>(getContainer());
-    if(owner && !_Shape.isNull() && _Shape.getElementMapSize()>0) {
+    if(owner && !isNull() && _Shape.getElementMapSize()>0) {
         auto ret = owner->getDocument()->addStringHasher(_Shape.Hasher);
         _HasherIndex = ret.second;
         _SaveHasher = ret.first;
@@ -304,9 +471,14 @@ void PropertyPartShape::beforeSave() const
 void PropertyPartShape::Save (Base::Writer &writer) const
 {
     //See SaveDocFile(), RestoreDocFile()
+    bool binary = writer.getMode("BinaryBrep");
+    bool toXML = writer.isForceXML();
+    if (toXML)
+        loadLazyShape();
+
     writer.Stream() << writer.ind() << "<Part";
     auto owner = dynamic_cast<App::DocumentObject*>(getContainer());
-    if(owner && !_Shape.isNull()
+    if(owner && !isNull()
         && _Shape.getElementMapSize()>0
         && !_Shape.Hasher.isNull()) {
         writer.Stream() << " HasherIndex=\"" << _HasherIndex << '"';
@@ -325,19 +497,33 @@ void PropertyPartShape::Save (Base::Writer &writer) const
     }
     writer.Stream() << " ElementMap=\"" << version << '"';
 
-    bool binary = writer.getMode("BinaryBrep");
-    bool toXML = writer.isForceXML();
     if(!toXML) {
+        // Metadata used until the shape is loaded when restored lazily. It is
+        // not computed for a shape that is not loaded and has none.
+        bool hasInfo = isLoaded() ? !_Shape.isNull() : (_Lazy && _Lazy->hasInfo);
+        if (hasInfo) {
+            Base::BoundBox3d box = getBoundingBox();
+            if (box.IsValid()) {
+                writer.Stream() << " BoundBox=\"" << box.MinX << ' ' << box.MinY << ' '
+                                << box.MinZ << ' ' << box.MaxX << ' ' << box.MaxY << ' '
+                                << box.MaxZ << '"';
+            }
+            writer.Stream() << " Faces=\"" << countSubShapes(TopAbs_FACE)
+                            << "\" Edges=\"" << countSubShapes(TopAbs_EDGE)
+                            << "\" Vertexes=\"" << countSubShapes(TopAbs_VERTEX) << '"';
+        }
         writer.Stream() << " file=\""
                         << writer.addFile(getFileName(binary?".bin":".brp").c_str(), this)
                         << "\"/>\n";
     } else if(binary) {
         writer.Stream() << " binary=\"1\">\n";
-        _Shape.exportBinary(writer.beginCharStream(Base::CharStreamFormat::Base64Encoded));
+        _Shape.exportBinary(writer.beginCharStream(Base::CharStreamFormat::Base64Encoded),
+                            isSaveTriangulationEnabled());
         writer.endCharStream() <<  writer.ind() << "</Part>\n";
     } else {
         writer.Stream() << " brep=\"1\">\n";
-        _Shape.exportBrep(writer.beginCharStream(Base::CharStreamFormat::Raw)<<'\n');
+        _Shape.exportBrep(writer.beginCharStream(Base::CharStreamFormat::Raw)<<'\n',
+                          isSaveTriangulationEnabled());
         writer.endCharStream() << '\n' << writer.ind() << "</Part>\n";
     }
 
@@ -378,9 +564,29 @@ void PropertyPartShape::Restore(Base::XMLReader &reader)
 
     TopoShape shape;
 
+    discardLazyShape();
     if (reader.hasAttribute("file")) {
         std::string file = reader.getAttribute<const char*>("file");
         if (!file.empty()) {
+            if (isLazyRestoreEnabled()) {
+                // RestoreDocFile() only keeps the file content
+                _Lazy = std::make_shared<LazyShape>();
+                if (reader.hasAttribute("Faces")) {
+                    _Lazy->hasInfo = true;
+                    _Lazy->faces = reader.getAttribute<unsigned long>("Faces");
+                    _Lazy->edges = reader.getAttribute<unsigned long>("Edges", 0);
+                    _Lazy->vertexes = reader.getAttribute<unsigned long>("Vertexes", 0);
+                    if (reader.hasAttribute("BoundBox")) {
+                        std::istringstream str(reader.getAttribute<const char*>("BoundBox"));
+                        str.imbue(std::locale::classic());
+                        Base::BoundBox3d& box = _Lazy->boundBox;
+                        if (!(str >> box.MinX >> box.MinY >> box.MinZ
+                                  >> box.MaxX >> box.MaxY >> box.MaxZ)) {
+                            _Lazy->hasInfo = false;
+                        }
+                    }
+                }
+            }
             // initiate a file read
             reader.addFile(file.c_str(), this);
         }
@@ -463,6 +669,20 @@ void PropertyPartShape::afterRestore()
         if (_Shape.Hasher)
             _Shape.Hasher->clear();
     }
+    if (!isLoaded()) {
+        // Same as PropertyComplexGeoData::afterRestore() but without loading
+        // the shape
+        if (_Shape.isRestoreFailed()) {
+            _Shape.resetRestoreFailure();
+            auto owner = freecad_cast<App::DocumentObject*>(getContainer());
+            if (owner && owner->getDocument()
+                && !owner->getDocument()->testStatus(App::Document::PartialDoc)) {
+                owner->getDocument()->addRecomputeObject(owner);
+            }
+        }
+        App::PropertyGeometry::afterRestore();
+        return;
+    }
     PropertyComplexGeoData::afterRestore();
 }
 
@@ -470,7 +690,8 @@ void PropertyPartShape::afterRestore()
 // to disable saving of triangulation
 //
 
-static Standard_Boolean  BRepTools_Write(const TopoDS_Shape& Sh, const Standard_CString File)
+static Standard_Boolean  BRepTools_Write(const TopoDS_Shape& Sh, const Standard_CString File,
+                                         Standard_Boolean withTriangles)
 {
   std::ofstream os;
   OSD_OpenStream(os, File, std::ios::out);
@@ -489,7 +710,7 @@ static Standard_Boolean  BRepTools_Write(const TopoDS_Shape& Sh, const Standard_
       VERSION_3 = 3
   };
 
-  BRepTools_ShapeSet SS(Standard_False);
+  BRepTools_ShapeSet SS(withTriangles);
   SS.SetFormatNb(VERSION_1);
   // SS.SetProgress(PR);
   SS.Add(Sh);
@@ -517,7 +738,8 @@ void PropertyPartShape::saveToFile(Base::Writer &writer) const
     static Base::FileInfo fi(App::Application::getTempFileName());
 
     TopoDS_Shape myShape = _Shape.getShape();
-    if (!BRepTools_Write(myShape,static_cast<Standard_CString>(fi.filePath().c_str()))) {
+    if (!BRepTools_Write(myShape,static_cast<Standard_CString>(fi.filePath().c_str()),
+                         isSaveTriangulationEnabled() ? Standard_True : Standard_False)) {
         // Note: Do NOT throw an exception here because if the tmp. file could
         // not be created we should not abort.
         // We only print an error message but continue writing the next files to the
@@ -608,6 +830,21 @@ void PropertyPartShape::loadFromStream(Base::Reader &reader)
 
 void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
 {
+    if (!isLoaded()) {
+        std::shared_ptr<LazyShape> lazy;
+        {
+            std::lock_guard<std::mutex> lock(lazyMutex());
+            lazy = _Lazy;
+        }
+        // Write back the content of a shape that was never loaded if the
+        // format is unchanged
+        if (lazy && lazy->binary == writer.getMode("BinaryBrep")) {
+            writer.Stream().write(lazy->data.data(), static_cast<std::streamsize>(lazy->data.size()));
+            return;
+        }
+        loadLazyShape();
+    }
+
     // If the shape is empty we simply store nothing. The file size will be 0 which
     // can be checked when reading in the data.
     if (_Shape.getShape().IsNull())
@@ -616,7 +853,7 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
     if (writer.getMode("BinaryBrep")) {
         TopoShape shape;
         shape.setShape(myShape);
-        shape.exportBinary(writer.Stream());
+        shape.exportBinary(writer.Stream(), isSaveTriangulationEnabled());
     }
     else {
         bool direct = App::GetApplication().GetParameterGroupByPath
@@ -627,13 +864,79 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
         else {
             TopoShape shape;
             shape.setShape(myShape);
-            shape.exportBrep(writer.Stream());
+            shape.exportBrep(writer.Stream(), isSaveTriangulationEnabled());
         }
     }
 }
 
+bool PropertyPartShape::canParseDocFileConcurrently() const
+{
+    // Nothing to parse if restored lazily
+    if (_Lazy)
+        return false;
+    // The file based fallback of RestoreDocFile() stays on the main thread
+    return App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
+}
+
+std::function<void()> PropertyPartShape::parseDocFile(Base::Reader &reader)
+{
+    // Only parse the file here, the restored shape is applied by the returned
+    // function on the main thread
+    TopoShape shape;
+    bool failed = false;
+    bool cached = false;
+    Base::FileInfo brep(reader.getFileName());
+    // A partially loaded document may have its shapes in the shared cache
+    if (ShapeFileCache::read(getContainerDocument(this), reader.getFileName(), shape)) {
+        cached = true;
+    }
+    else if (brep.hasExtension("bin")) {
+        shape.importBinary(reader);
+    }
+    else {
+        try {
+            reader.exceptions(std::istream::failbit | std::istream::badbit);
+            BRep_Builder builder;
+            TopoDS_Shape sh;
+            BRepTools::Read(sh, reader, builder);
+            shape.setShape(sh);
+        }
+        catch (const std::exception&) {
+            failed = !reader.eof();
+        }
+    }
+
+    return [this, shape, failed, cached, fileName = reader.getFileName()]() mutable {
+        if (failed) {
+            Base::Console().warning("Failed to load BRep file %s\n", fileName.c_str());
+        }
+        if (!cached) {
+            ShapeFileCache::add(getContainerDocument(this), fileName, shape.getShape());
+        }
+        auto elementMap = _Shape.resetElementMap();
+        std::string ver = _Ver;
+        shape.Hasher = _Shape.Hasher;
+        shape.resetElementMap(elementMap);
+        setValue(shape);
+        _Ver = ver;
+    };
+}
+
 void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
 {
+    if (_Lazy) {
+        // Keep the content for loadLazyShape()
+        Base::FileInfo brep(reader.getFileName());
+        _Lazy->fileName = reader.getFileName();
+        _Lazy->binary = brep.hasExtension("bin");
+        _Lazy->data.assign(std::istreambuf_iterator<char>(reader), std::istreambuf_iterator<char>());
+        if (_Lazy->data.empty())
+            _Lazy.reset();
+        else
+            _IsLazy.store(true, std::memory_order_release);
+        return;
+    }
 
     // save the element map
     auto elementMap = _Shape.resetElementMap();
@@ -651,7 +954,13 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
 
     std::string ver = _Ver;
 
-    if (brep.hasExtension("bin")) {
+    // A partially loaded document may have its shapes in the shared cache
+    auto doc = getContainerDocument(this);
+    bool cached = false;
+    if (ShapeFileCache::read(doc, reader.getFileName(), shape)) {
+        cached = true;
+    }
+    else if (brep.hasExtension("bin")) {
         shape.importBinary(reader);
     }
     else {
@@ -667,6 +976,9 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
         }
         shape = getValue();
     }
+    if (!cached) {
+        ShapeFileCache::add(doc, reader.getFileName(), shape.getShape());
+    }
 
     // restore the element map
     shape.Hasher = hasher;
@@ -23,7 +23,9 @@
 #ifndef PART_PROPERTYTOPOSHAPE_H
 #define PART_PROPERTYTOPOSHAPE_H
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <vector>
 
 #include <App/PropertyGeo.h>
@@ -57,6 +59,13 @@ public:
     const TopoDS_Shape& getValue() const;
     const TopoShape& getShape() const;
     const Data::ComplexGeoData* getComplexData() const override;
+    /// Check if the shape is loaded, see isLazyRestoreEnabled()
+    bool isLoaded() const;
+    /** Number of sub-shapes of the given type
+     * Answered from the data saved with the document as long as the shape
+     * is not loaded.
+     */
+    unsigned long countSubShapes(TopAbs_ShapeEnum type) const;
     //@}
 
     /** @name Modification */
@@ -90,6 +99,8 @@ public:
 
     void SaveDocFile (Base::Writer &writer) const override;
     void RestoreDocFile(Base::Reader &reader) override;
+    bool canParseDocFileConcurrently() const override;
+    std::function<void()> parseDocFile(Base::Reader &reader) override;
 
     App::Property *Copy() const override;
     void Paste(const App::Property &from) override;
@@ -104,18 +115,50 @@ public:
 
     void afterRestore() override;
 
+    /** Check if shapes are restored lazily
+     * If enabled, RestoreDocFile() only keeps the content of the file and the
+     * shape is loaded on first access. Until then the bounding box and the
+     * number of sub-shapes are taken from the attributes saved by Save().
+     */
+    static bool isLazyRestoreEnabled();
+
+    /** Check if the face triangulations are saved together with the shapes
+     * If enabled, a restored shape keeps its triangulation and the view
+     * provider can reuse it instead of meshing the shape again.
+     */
+    static bool isSaveTriangulationEnabled();
+
     friend class Feature;
 
 private:
+    bool isSameShape(const TopoDS_Shape &shape, long tag, size_t mapSize) const;
     void saveToFile(Base::Writer &writer) const;
     void loadFromFile(Base::Reader &reader);
     void loadFromStream(Base::Reader &reader);
+    bool isNull() const;
+    void loadLazyShape() const;
+    void discardLazyShape();
 
 private:
+    // Content and metadata of a shape that is restored but not loaded yet
+    struct LazyShape
+    {
+        std::string data;
+        std::string fileName;
+        bool binary = false;
+        bool hasInfo = false;
+        Base::BoundBox3d boundBox;
+        unsigned long faces = 0;
+        unsigned long edges = 0;
+        unsigned long vertexes = 0;
+    };
+
     TopoShape _Shape;
     std::string _Ver;
     mutable int _HasherIndex = 0;
     mutable bool _SaveHasher = false;
+    std::shared_ptr<LazyShape> _Lazy;
+    mutable std::atomic<bool> _IsLazy {false};
 };
 
 struct PartExport ShapeHistory {
@@ -28,6 +28,7 @@
 #include <Base/Reader.h>
 #include <Base/Writer.h>
 
+#include "PropertyTopoShape.h"
 #include "TopoShapePy.h"
 
 #include "PropertyTopoShapeList.h"
@@ -178,12 +179,14 @@ void PropertyTopoShapeList::Save(Writer& writer) const
         }
         else if (binary) {
             writer.Stream() << " binary=\"1\">\n";
-            _lValueList[i].exportBinary(writer.beginCharStream());
+            _lValueList[i].exportBinary(writer.beginCharStream(),
+                                        PropertyPartShape::isSaveTriangulationEnabled());
             writer.endCharStream() << writer.ind() << "</TopoShape>\n";
         }
         else {
             writer.Stream() << " brep=\"1\">\n";
-            _lValueList[i].exportBrep(writer.beginCharStream() << '\n');
+            _lValueList[i].exportBrep(writer.beginCharStream() << '\n',
+                                      PropertyPartShape::isSaveTriangulationEnabled());
             writer.endCharStream() << '\n' << writer.ind() << "</TopoShape>\n";
         }
     }
@@ -202,10 +205,10 @@ void PropertyTopoShapeList::SaveDocFile(Base::Writer& writer) const
 
     const TopoShape& shape = _lValueList[index];
     if (binary) {
-        shape.exportBinary(writer.Stream());
+        shape.exportBinary(writer.Stream(), PropertyPartShape::isSaveTriangulationEnabled());
     }
     else {
-        shape.exportBrep(writer.Stream());
+        shape.exportBrep(writer.Stream(), PropertyPartShape::isSaveTriangulationEnabled());
     }
 }
 
@@ -0,0 +1,274 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <map>
+# include <mutex>
+# include <sstream>
+# include <streambuf>
+# include <QCryptographicHash>
+# include <QFile>
+# include <QSaveFile>
+# include <Standard_Failure.hxx>
+# include <Standard_Version.hxx>
+# include <TopoDS_Shape.hxx>
+#endif
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/Console.h>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Parameter.h>
+
+#include "ShapeFileCache.h"
+#include "TopoShape.h"
+
+
+using namespace Part;
+
+namespace
+{
+
+// Reads a file mapped into memory without copying it
+class MemoryBuffer: public std::streambuf
+{
+public:
+    MemoryBuffer(const char* data, std::size_t size)
+    {
+        auto begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override
+    {
+        char* pos = gptr();
+        if (dir == std::ios_base::beg) {
+            pos = eback() + off;
+        }
+        else if (dir == std::ios_base::cur) {
+            pos += off;
+        }
+        else {
+            pos = egptr() + off;
+        }
+        if (pos < eback() || pos > egptr()) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), pos, egptr());
+        return pos_type(pos - eback());
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode mode) override
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, mode);
+    }
+};
+
+class Cache
+{
+public:
+    static Cache& instance()
+    {
+        static Cache cache;
+        return cache;
+    }
+
+    /// The directory of the files of \a doc, the caller holds the mutex
+    const std::string& directory(const App::Document* doc)
+    {
+        auto it = directories.find(doc);
+        if (it != directories.end()) {
+            return it->second;
+        }
+
+        // Only the saved state of the document is cached, which is kept here as the directory
+        // is looked up again when the document is closed
+        std::string& dir = directories[doc];
+        Base::FileInfo file(doc->FileName.getValue());
+        if (!file.exists()) {
+            return dir;
+        }
+
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        std::ostringstream str;
+        str << doc->Uid.getValueStr() << ' ' << doc->LastModifiedDate.getValue() << ' '
+            << file.size() << ' ' << OCC_VERSION_HEX;
+        hash.addData(QByteArray::fromStdString(str.str()));
+        dir = App::Application::getUserCachePath() + "LinkShapes" + PATHSEP
+            + hash.result().toHex().toStdString() + PATHSEP;
+        return dir;
+    }
+
+    std::mutex mutex;
+    std::map<const App::Document*, std::string> directories;
+    // the restored shapes by document and file name
+    std::map<const App::Document*, std::map<std::string, TopoDS_Shape>> shapes;
+
+private:
+    Cache()
+    {
+        connDeleteDocument = App::GetApplication().signalDeleteDocument.connect(
+            [](const App::Document& doc) {
+                ShapeFileCache::write(doc);
+            });
+    }
+
+    boost::signals2::scoped_connection connDeleteDocument;
+};
+
+std::string cacheFileName(const std::string& entry)
+{
+    // the shapes are always cached in the binary format
+    return Base::FileInfo(entry).fileNamePure() + ".bin";
+}
+
+}  // namespace
+
+bool ShapeFileCache::isEnabled(const App::Document* doc)
+{
+    if (!doc || !doc->testStatus(App::Document::PartialDoc)) {
+        return false;
+    }
+    return App::GetApplication()
+        .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Part/General")
+        ->GetBool("SharedLinkCache", false);
+}
+
+std::string ShapeFileCache::getDirectory(const App::Document* doc)
+{
+    if (!isEnabled(doc)) {
+        return {};
+    }
+
+    Cache& cache = Cache::instance();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.directory(doc);
+}
+
+bool ShapeFileCache::read(const App::Document* doc, const std::string& entry, TopoShape& shape)
+{
+    std::string dir = getDirectory(doc);
+    if (dir.empty()) {
+        return false;
+    }
+
+    QFile file(QString::fromStdString(dir + cacheFileName(entry)));
+    if (!file.open(QIODevice::ReadOnly) || file.size() <= 0) {
+        return false;
+    }
+    const uchar* data = file.map(0, file.size());
+    if (!data) {
+        return false;
+    }
+
+    // the mapping is released when the file is closed
+    MemoryBuffer buffer(reinterpret_cast<const char*>(data), static_cast<std::size_t>(file.size()));
+    std::istream str(&buffer);
+    TopoShape cached;
+    try {
+        cached.importBinary(str);
+    }
+    catch (const Base::Exception&) {
+        return false;
+    }
+    catch (const Standard_Failure&) {
+        return false;
+    }
+    if (cached.isNull()) {
+        return false;
+    }
+
+    shape.setShape(cached.getShape(), false);
+    return true;
+}
+
+void ShapeFileCache::add(const App::Document* doc,
+                         const std::string& entry,
+                         const TopoDS_Shape& shape)
+{
+    if (shape.IsNull() || !isEnabled(doc)) {
+        return;
+    }
+
+    Cache& cache = Cache::instance();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (!cache.directory(doc).empty()) {
+        cache.shapes[doc][entry] = shape;
+    }
+}
+
+void ShapeFileCache::write(const App::Document& doc)
+{
+    std::string dir;
+    std::map<std::string, TopoDS_Shape> shapes;
+    {
+        Cache& cache = Cache::instance();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.directories.find(&doc);
+        if (it == cache.directories.end()) {
+            return;
+        }
+        dir = it->second;
+        cache.directories.erase(it);
+        auto jt = cache.shapes.find(&doc);
+        if (jt != cache.shapes.end()) {
+            shapes = std::move(jt->second);
+            cache.shapes.erase(jt);
+        }
+    }
+    if (shapes.empty()) {
+        return;
+    }
+
+    Base::FileInfo fi(dir);
+    if (!fi.exists() && !fi.createDirectories()) {
+        Base::Console().warning("Cannot create the link cache directory %s\n", dir.c_str());
+        return;
+    }
+
+    for (const auto& it : shapes) {
+        Base::FileInfo file(dir + cacheFileName(it.first));
+        if (file.exists()) {
+            continue;
+        }
+
+        // with the triangulation made by the view
+        TopoShape shape;
+        shape.setShape(it.second, false);
+        std::ostringstream str;
+        shape.exportBinary(str, true);
+        std::string data = str.str();
+
+        // another process may read or write the same file, it's replaced only when complete
+        QSaveFile out(QString::fromStdString(file.filePath()));
+        if (!out.open(QIODevice::WriteOnly)
+            || out.write(data.data(), static_cast<qint64>(data.size()))
+                != static_cast<qint64>(data.size())
+            || !out.commit()) {
+            Base::Console().warning("Cannot write the link cache file %s\n",
+                                    file.filePath().c_str());
+        }
+    }
+}
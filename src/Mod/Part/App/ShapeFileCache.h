@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#ifndef PART_SHAPEFILECACHE_H
+#define PART_SHAPEFILECACHE_H
+
+#include <string>
+
+#include <Mod/Part/PartGlobal.h>
+
+class TopoDS_Shape;
+
+namespace App
+{
+class Document;
+}
+
+namespace Part
+{
+
+class TopoShape;
+
+/**
+ * @brief The ShapeFileCache keeps the shapes of the documents that links load partially in files
+ * of the user cache directory, shared by all FreeCAD processes.
+ *
+ * The same libraries of parts are often opened for their links by many processes, each of them
+ * inflating and parsing the shapes of their project files again. Instead, the shapes restored from
+ * a partially loaded document are written in the binary BRep format, with the triangulation the
+ * view has made in the meantime, when the document is closed. A later restore of the same saved
+ * state of the document maps these files into memory and reads the shapes from there, so the
+ * processes share the pages of the files and the view doesn't triangulate the faces again.
+ *
+ * The files of a document are in a directory named by the digest of its UUID, its last
+ * modification date and the size of its project file, so saving the library makes a new entry.
+ * The element maps are not cached, they are restored from the document as before. The cache is
+ * enabled by the parameter SharedLinkCache of the group BaseApp/Preferences/Mod/Part/General.
+ */
+namespace ShapeFileCache
+{
+    /// Returns true if the cache is enabled and \a doc is partially loaded
+    bool PartExport isEnabled(const App::Document* doc);
+    /// The directory of the cached files of \a doc, empty if its shapes are not cached
+    std::string PartExport getDirectory(const App::Document* doc);
+    /// Sets \a shape to the cached shape of the file \a entry of \a doc and returns true if any
+    bool PartExport read(const App::Document* doc, const std::string& entry, TopoShape& shape);
+    /// Keeps \a shape restored from the file \a entry of \a doc to write it when \a doc is closed
+    void PartExport add(const App::Document* doc,
+                        const std::string& entry,
+                        const TopoDS_Shape& shape);
+    /// Writes the shapes kept for \a doc that are not in the cache yet
+    void PartExport write(const App::Document& doc);
+}
+
+}
+
+#endif // PART_SHAPEFILECACHE_H
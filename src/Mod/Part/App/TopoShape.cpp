@@ -24,8 +24,10 @@
 
 #ifndef _PreComp_
 # include <array>
+# include <charconv>
 # include <cmath>
 # include <cstdlib>
+# include <cstring>
 # include <sstream>
 # include <boost/regex.hpp>
 
@@ -121,6 +123,7 @@
 # include <Law_BSpline.hxx>
 # include <Law_BSpFunc.hxx>
 # include <Law_Constant.hxx>
+# include <Poly_Triangulation.hxx>
 # include <ShapeAnalysis_FreeBoundsProperties.hxx>
 # include <ShapeExtend_Explorer.hxx>
 # include <ShapeFix_Shape.hxx>
@@ -348,6 +351,12 @@ TopoDS_Shape TopoShape::getSubShape(TopAbs_ShapeEnum type, int idx, bool silent)
     return s.getSubTopoShape(type,idx,silent).getShape();
 }
 
+TopoDS_Shape TopoShape::getSubShape(const Data::IndexedName& element, bool silent) const {
+    TopoShape s(*this);
+    s.Tag = 0;
+    return s.getSubTopoShape(element,silent).getShape();
+}
+
 
 unsigned long TopoShape::countSubShapes(const char* Type) const
 {
@@ -424,21 +433,23 @@ static void initShapeNameMap() {
     }
 }
 
+// Reads the index at the end of an element name, false if anything else follows it
+static bool readIndex(const char *str, int &idx) {
+    const char *end = str + std::strlen(str);
+    return std::from_chars(str, end, idx).ptr == end;
+}
+
 std::pair<TopAbs_ShapeEnum,int> TopoShape::shapeTypeAndIndex(const char *name) {
     int idx = 0;
     TopAbs_ShapeEnum type = TopAbs_SHAPE;
     static const std::string _subshape("SubShape");
     if(boost::starts_with(name,_subshape)) {
-        std::istringstream iss(name+_subshape.size());
-        iss >> idx;
-        if(!iss.eof())
+        if(!readIndex(name+_subshape.size(), idx))
             idx = 0;
     } else {
         type = shapeType(name,true);
         if(type != TopAbs_SHAPE) {
-            std::istringstream iss(name+shapeName(type).size());
-            iss >> idx;
-            if(!iss.eof()) {
+            if(!readIndex(name+shapeName(type).size(), idx)) {
                 idx = 0;
                 type = TopAbs_SHAPE;
             }
@@ -891,7 +902,7 @@ void TopoShape::exportBrep(const char *filename) const
 #endif
 }
 
-void TopoShape::exportBrep(std::ostream& out) const
+void TopoShape::exportBrep(std::ostream& out, bool withTriangles) const
 {
     // See TopTools_FormatVersion of OCCT 7.6
     enum {
@@ -899,14 +910,14 @@ void TopoShape::exportBrep(std::ostream& out) const
         VERSION_2 = 2,
         VERSION_3 = 3
     };
-    BRepTools_ShapeSet SS(Standard_False);
+    BRepTools_ShapeSet SS(withTriangles ? Standard_True : Standard_False);
     SS.SetFormatNb(VERSION_1);
     SS.Add(this->_Shape);
     SS.Write(out);
     SS.Write(this->_Shape, out);
 }
 
-void TopoShape::exportBinary(std::ostream& out) const
+void TopoShape::exportBinary(std::ostream& out, bool withTriangles) const
 {
     // See BinTools_FormatVersion of OCCT 7.6
     enum {
@@ -917,7 +928,12 @@ void TopoShape::exportBinary(std::ostream& out) const
     };
 
     // An example how to use BinTools_ShapeSet can be found in BinMNaming_NamedShapeDriver.cxx
+#if OCC_VERSION_HEX >= 0x070600
     BinTools_ShapeSet theShapeSet;
+    theShapeSet.SetWithTriangles(withTriangles ? Standard_True : Standard_False);
+#else
+    BinTools_ShapeSet theShapeSet(withTriangles ? Standard_True : Standard_False);
+#endif
     theShapeSet.SetFormatNb(VERSION_3);
     if (this->_Shape.IsNull()) {
         theShapeSet.Add(this->_Shape);
@@ -1230,6 +1246,18 @@ unsigned int TopoShape::getMemSize () const
                     // first, last, tolerance
                     memsize += 5*sizeof(Standard_Real);
                     const TopoDS_Face& face = TopoDS::Face(shape);
+                    // the tessellation kept in the face for the display and the export
+                    TopLoc_Location loc;
+                    Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(face, loc);
+                    if (!mesh.IsNull()) {
+                        memsize += sizeof(Poly_Triangulation);
+                        memsize += mesh->NbNodes() * sizeof(gp_Pnt);
+                        memsize += mesh->NbTriangles() * sizeof(Poly_Triangle);
+                        if (mesh->HasUVNodes())
+                            memsize += mesh->NbNodes() * sizeof(gp_Pnt2d);
+                        if (mesh->HasNormals())
+                            memsize += mesh->NbNodes() * 3 * sizeof(float);
+                    }
                     // if no geometry is attached to a face an exception is raised
                     BRepAdaptor_Surface surface;
                     try {
@@ -1342,6 +1370,9 @@ unsigned int TopoShape::getMemSize () const
             }
         }
 
+        // the element map
+        memsize += Data::ComplexGeoData::getMemSize();
+
         // estimated memory usage
         return memsize;
     }
@@ -1864,11 +1895,8 @@ std::list<TopoDS_Wire> TopoShape::slice(const Base::Vector3d& dir, double d) con
 
 TopoDS_Compound TopoShape::slices(const Base::Vector3d& dir, const std::vector<double>& d) const
 {
-    std::vector< std::list<TopoDS_Wire> > wire_list;
     CrossSection cs(dir.x, dir.y, dir.z, this->_Shape);
-    for (double jt : d) {
-        wire_list.push_back(cs.slice(jt));
-    }
+    std::vector< std::list<TopoDS_Wire> > wire_list = cs.slices(d);
 
     std::vector< std::list<TopoDS_Wire> >::const_iterator ft;
     TopoDS_Compound comp;
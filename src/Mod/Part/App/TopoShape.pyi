@@ -927,13 +927,18 @@ class TopoShape(ComplexGeoData):
         ...
 
     @constmethod
-    def distToShape(self, shape: TopoShape, tol: float = 1e-7) -> Tuple[float, List[Tuple[Vector, Vector]], List[Tuple]]:
+    def distToShape(self, shape: TopoShape, tol: float = 1e-7, *,
+                    accelerated: bool = False) -> Tuple[float, List[Tuple[Vector, Vector]], List[Tuple]]:
         """
         Find the minimum distance to another shape.
-        distToShape(shape, tol=1e-7) -> (dist, vectors, infos)
+        distToShape(shape, tol=1e-7, accelerated=False) -> (dist, vectors, infos)
         --
         dist is the minimum distance, in mm (float value).
 
+        If accelerated is True the bounding boxes of the faces, edges and vertices that
+        are kept with the shapes are used to find the closest elements first, which is
+        much faster for repeated queries of shapes with many faces.
+
         vectors is a list of pairs of App.Vector. Each pair corresponds to solution.
         Example: [(App.Vector(2.0, -1.0, 2.0), App.Vector(2.0, 0.0, 2.0)),
         (App.Vector(2.0, -1.0, 2.0), App.Vector(2.0, -1.0, 3.0))]
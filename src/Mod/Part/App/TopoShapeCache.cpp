@@ -23,10 +23,44 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#ifndef _PreComp_
+#include <BRepBndLib.hxx>
+#endif
+#include <boost/geometry.hpp>
+
 #include "TopoShapeCache.h"
 
 using namespace Part;
 
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+namespace
+{
+
+/// The shared shape maps by TopoDS_TShape and orientation
+struct TopologyRegistry
+{
+    using Key = std::pair<const Standard_Transient*, int>;
+
+    static TopologyRegistry& instance()
+    {
+        // never destroyed, the caches of static shapes may be released after it on exit
+        static auto* registry = new TopologyRegistry;
+        return *registry;
+    }
+
+    static Key key(const TopoDS_Shape& tds)
+    {
+        return {tds.TShape().get(), int(tds.Orientation())};
+    }
+
+    std::mutex mutex;
+    std::map<Key, std::weak_ptr<TopoShapeCache::Topology>> entries;
+};
+
+}  // namespace
+
 ShapeRelationKey::ShapeRelationKey(Data::MappedName name, HistoryTraceType historyTraceType)
     : name(std::move(name))
     , historyTraceType(historyTraceType)
@@ -44,7 +78,7 @@ TopoShape TopoShapeCache::Ancestry::_getTopoShape(const TopoShape& parent, int i
 {
     auto& ts = topoShapes[index - 1];
     if (ts.isNull()) {
-        ts.setShape(shapes.FindKey(index), true);
+        ts.setShape(shapes->FindKey(index), true);
         ts.initCache();
         ts._cache->subLocation = ts._Shape.Location();
     }
@@ -90,6 +124,70 @@ TopoShape TopoShapeCache::Ancestry::_getTopoShape(const TopoShape& parent, int i
 }
 
 
+TopoShapeCache::Topology::Topology(const TopoDS_Shape& tds)
+    : shape(tds)
+{}
+
+TopoShapeCache::Topology::~Topology()
+{
+    auto& registry = TopologyRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.entries.find(TopologyRegistry::key(shape));
+    // the entry may already refer to a new instance of the same shape
+    if (it != registry.entries.end() && it->second.expired()) {
+        registry.entries.erase(it);
+    }
+}
+
+std::shared_ptr<TopoShapeCache::Topology> TopoShapeCache::Topology::get(const TopoDS_Shape& tds)
+{
+    auto& registry = TopologyRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto& entry = registry.entries[TopologyRegistry::key(tds)];
+    auto topology = entry.lock();
+    if (!topology) {
+        topology = std::make_shared<Topology>(tds);
+        entry = topology;
+    }
+    return topology;
+}
+
+std::size_t TopoShapeCache::Topology::count()
+{
+    auto& registry = TopologyRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.entries.size();
+}
+
+const TopTools_IndexedMapOfShape& TopoShapeCache::Topology::getShapes(TopAbs_ShapeEnum type)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& map = shapes.at(type);
+    if (!map) {
+        map = std::make_unique<TopTools_IndexedMapOfShape>();
+        if (type == TopAbs_SHAPE) {
+            for (TopoDS_Iterator it(shape); it.More(); it.Next()) {
+                map->Add(it.Value());
+            }
+        }
+        else {
+            TopExp::MapShapes(shape, type, *map);
+        }
+    }
+    return *map;
+}
+
+const TopTools_IndexedDataMapOfShapeListOfShape&
+TopoShapeCache::Topology::getAncestors(TopAbs_ShapeEnum type, TopAbs_ShapeEnum subType)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto [it, inserted] = ancestors.try_emplace(std::make_pair(int(type), int(subType)));
+    if (inserted) {
+        TopExp::MapShapesAndAncestors(shape, subType, type, it->second);
+    }
+    return it->second;
+}
+
 void TopoShapeCache::Ancestry::clear()
 {
     topoShapes.clear();
@@ -98,16 +196,16 @@ void TopoShapeCache::Ancestry::clear()
 TopoShape TopoShapeCache::Ancestry::getTopoShape(const TopoShape& parent, int index)
 {
     TopoShape res;
-    if (index <= 0 || index > shapes.Extent()) {
+    if (index <= 0 || index > shapes->Extent()) {
         return res;
     }
-    topoShapes.resize(shapes.Extent());
+    topoShapes.resize(shapes->Extent());
     return _getTopoShape(parent, index);
 }
 
 std::vector<TopoShape> TopoShapeCache::Ancestry::getTopoShapes(const TopoShape& parent)
 {
-    int count = shapes.Extent();
+    int count = shapes->Extent();
     std::vector<TopoShape> res;
     res.reserve(count);
     topoShapes.resize(count);
@@ -130,30 +228,40 @@ TopoDS_Shape TopoShapeCache::Ancestry::stripLocation(const TopoDS_Shape& parent,
 int TopoShapeCache::Ancestry::find(const TopoDS_Shape& parent, const TopoDS_Shape& subShape)
 {
     if (parent.Location().IsIdentity()) {
-        return shapes.FindIndex(subShape);
+        return shapes->FindIndex(subShape);
     }
-    return shapes.FindIndex(stripLocation(parent, subShape));
+    return shapes->FindIndex(stripLocation(parent, subShape));
 }
 
 TopoDS_Shape TopoShapeCache::Ancestry::find(const TopoDS_Shape& parent, int index)
 {
-    if (index <= 0 || index > shapes.Extent()) {
+    if (index <= 0 || index > shapes->Extent()) {
         return {};
     }
     if (parent.Location().IsIdentity()) {
-        return shapes.FindKey(index);
+        return shapes->FindKey(index);
     }
-    return TopoShape::moved(shapes.FindKey(index), parent.Location());
+    return TopoShape::moved(shapes->FindKey(index), parent.Location());
 }
 
 int TopoShapeCache::Ancestry::count() const
 {
-    return shapes.Extent();
+    return shapes->Extent();
 }
 
 bool TopoShapeCache::Ancestry::empty() const
 {
-    return shapes.IsEmpty();
+    return shapes->IsEmpty();
+}
+
+const TopTools_IndexedDataMapOfShapeListOfShape&
+TopoShapeCache::Ancestry::getAncestors(TopAbs_ShapeEnum subType)
+{
+    auto& map = ancestors.at(subType);
+    if (!map) {
+        map = &owner->topology->getAncestors(type, subType);
+    }
+    return *map;
 }
 
 TopoShapeCache::TopoShapeCache(const TopoDS_Shape& tds)
@@ -182,15 +290,16 @@ TopoShapeCache::Ancestry& TopoShapeCache::getAncestry(TopAbs_ShapeEnum type)
     auto& ancestry = shapeAncestryCache.at(type);
     if (!ancestry.owner) {
         ancestry.owner = this;
-        if (!shape.IsNull()) {
-            if (type == TopAbs_SHAPE) {
-                for (TopoDS_Iterator it(shape); it.More(); it.Next()) {
-                    ancestry.shapes.Add(it.Value());
-                }
-            }
-            else {
-                TopExp::MapShapes(shape, type, ancestry.shapes);
+        ancestry.type = type;
+        if (shape.IsNull()) {
+            static const TopTools_IndexedMapOfShape emptyShapes;
+            ancestry.shapes = &emptyShapes;
+        }
+        else {
+            if (!topology) {
+                topology = Topology::get(shape);
             }
+            ancestry.shapes = &topology->getShapes(type);
         }
     }
     return ancestry;
@@ -232,19 +341,15 @@ TopoDS_Shape TopoShapeCache::findAncestor(const TopoDS_Shape& parent,
 
     auto& info = getAncestry(type);
 
-    auto& ancestorInfo = info.ancestors.at(subShape.ShapeType());
-    if (!ancestorInfo.initialized) {
-        ancestorInfo.initialized = true;
-        // ancestorInfo.shapes is the output variable here, storing (and caching) the actual map
-        TopExp::MapShapesAndAncestors(shape, subShape.ShapeType(), type, ancestorInfo.shapes);
-    }
+    // the map is built by the first cache of this shape that asks for it
+    const auto& ancestorMap = info.getAncestors(subShape.ShapeType());
     int index = parent.Location().IsIdentity()
-        ? ancestorInfo.shapes.FindIndex(subShape)
-        : ancestorInfo.shapes.FindIndex(info.stripLocation(parent, subShape));
+        ? ancestorMap.FindIndex(subShape)
+        : ancestorMap.FindIndex(info.stripLocation(parent, subShape));
     if (index == 0) {
         return nullShape;
     }
-    const auto& shapes = ancestorInfo.shapes.FindFromIndex(index);
+    const auto& shapes = ancestorMap.FindFromIndex(index);
     if (shapes.Extent() == 0) {
         return nullShape;
     }
@@ -257,3 +362,93 @@ TopoDS_Shape TopoShapeCache::findAncestor(const TopoDS_Shape& parent,
     }
     return TopoShape::moved(shapes.First(), parent.Location());
 }
+
+struct TopoShapeCache::BoundTree::Private
+{
+    using Point = bg::model::point<double, 3, bg::cs::cartesian>;
+    using Box = bg::model::box<Point>;
+    using Value = std::pair<Box, std::size_t>;
+
+    static Box toBox(const Bnd_Box& bound)
+    {
+        double xMin {}, yMin {}, zMin {}, xMax {}, yMax {}, zMax {};
+        bound.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        return {Point(xMin, yMin, zMin), Point(xMax, yMax, zMax)};
+    }
+
+    std::vector<TopoDS_Shape> elements;
+    std::vector<Bnd_Box> boxes;
+    bgi::rtree<Value, bgi::quadratic<16>> tree;
+};
+
+TopoShapeCache::BoundTree::BoundTree(const TopoDS_Shape& tds)
+    : d(std::make_unique<Private>())
+{
+    auto addElement = [this](const TopoDS_Shape& element) {
+        d->elements.push_back(element);
+        d->boxes.emplace_back();
+        BRepBndLib::Add(element, d->boxes.back(), Standard_True);
+    };
+    TopExp_Explorer xp;
+    for (xp.Init(tds, TopAbs_FACE); xp.More(); xp.Next()) {
+        addElement(xp.Current());
+    }
+    for (xp.Init(tds, TopAbs_EDGE, TopAbs_FACE); xp.More(); xp.Next()) {
+        addElement(xp.Current());
+    }
+    for (xp.Init(tds, TopAbs_VERTEX, TopAbs_EDGE); xp.More(); xp.Next()) {
+        addElement(xp.Current());
+    }
+
+    // the tree is packed at once, an element without geometry is never found
+    std::vector<Private::Value> values;
+    values.reserve(d->boxes.size());
+    for (std::size_t i = 0; i < d->boxes.size(); ++i) {
+        if (!d->boxes[i].IsVoid() && !d->boxes[i].IsOpen()) {
+            values.emplace_back(Private::toBox(d->boxes[i]), i);
+        }
+    }
+    d->tree = decltype(d->tree)(values);
+}
+
+TopoShapeCache::BoundTree::~BoundTree() = default;
+
+std::size_t TopoShapeCache::BoundTree::size() const
+{
+    return d->elements.size();
+}
+
+const TopoDS_Shape& TopoShapeCache::BoundTree::getElement(std::size_t index) const
+{
+    return d->elements.at(index);
+}
+
+const Bnd_Box& TopoShapeCache::BoundTree::getBox(std::size_t index) const
+{
+    return d->boxes.at(index);
+}
+
+void TopoShapeCache::BoundTree::visitNearest(
+    const Bnd_Box& box,
+    const std::function<bool(std::size_t, double)>& visit) const
+{
+    if (box.IsVoid() || box.IsOpen() || d->tree.empty()) {
+        return;
+    }
+    Private::Box query = Private::toBox(box);
+    for (auto it = d->tree.qbegin(bgi::nearest(query, static_cast<unsigned>(d->tree.size())));
+         it != d->tree.qend();
+         ++it) {
+        if (!visit(it->second, box.Distance(d->boxes[it->second]))) {
+            break;
+        }
+    }
+}
+
+const TopoShapeCache::BoundTree& TopoShapeCache::getBoundTree()
+{
+    if (!boundTree) {
+        boundTree = std::make_unique<BoundTree>(shape);
+    }
+    return *boundTree;
+}
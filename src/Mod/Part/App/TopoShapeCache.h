@@ -29,6 +29,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <Bnd_Box.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Compound.hxx>
 #include <TopoDS_Iterator.hxx>
@@ -37,7 +38,12 @@
 #include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TopTools_ListIteratorOfListOfShape.hxx>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <utility>
+#include <vector>
 #endif
 
 #include <App/ElementMap.h>
@@ -79,10 +85,35 @@ public:
     /// Inverse of location
     TopLoc_Location locationInverse;
 
-    struct PartExport AncestorInfo
+    /// The OCCT shape maps of a TopoDS_Shape stripped of its location. They only depend on the
+    /// TopoDS_TShape and the orientation, so all caches of the same shape share one instance, no
+    /// matter which TopoShape, link or property they belong to. The instances are kept in a global
+    /// registry as long as any cache refers to them.
+    class PartExport Topology
     {
-        bool initialized = false;
-        TopTools_IndexedDataMapOfShapeListOfShape shapes;
+    public:
+        explicit Topology(const TopoDS_Shape& tds);
+        ~Topology();
+        Topology(const Topology&) = delete;
+        Topology& operator=(const Topology&) = delete;
+
+        /// Returns the shared maps of \a tds, which must not have a location
+        static std::shared_ptr<Topology> get(const TopoDS_Shape& tds);
+        /// The number of shapes in the registry
+        static std::size_t count();
+
+        /// Map of the sub shapes of \a type, the direct children for TopAbs_SHAPE
+        const TopTools_IndexedMapOfShape& getShapes(TopAbs_ShapeEnum type);
+        /// Map from the sub shapes of \a subType to their ancestors of \a type
+        const TopTools_IndexedDataMapOfShapeListOfShape& getAncestors(TopAbs_ShapeEnum type,
+                                                                     TopAbs_ShapeEnum subType);
+
+    private:
+        TopoDS_Shape shape;
+        /// The maps are built on demand and may be used by several threads
+        std::mutex mutex;
+        std::array<std::unique_ptr<TopTools_IndexedMapOfShape>, TopAbs_SHAPE + 1> shapes;
+        std::map<std::pair<int, int>, TopTools_IndexedDataMapOfShapeListOfShape> ancestors;
     };
 
     /// Class for caching the ancestor and children shapes mapping
@@ -91,20 +122,23 @@ public:
     private:
         TopoShapeCache* owner = nullptr;
 
+        TopAbs_ShapeEnum type = TopAbs_SHAPE;
+
         /// OCCT map from the owner TopoShape to a list of children (i.e. lower hierarchical)
-        /// TopoDS_Shape
-        TopTools_IndexedMapOfShape shapes;
+        /// TopoDS_Shape, owned by the shared Topology of the owner
+        const TopTools_IndexedMapOfShape* shapes = nullptr;
 
         /// One-to-one corresponding TopoShape to each child TopoDS_Shape
         std::vector<TopoShape> topoShapes;
 
         /// Caches the OCCT ancestor shape maps, e.g.
         ///     Cache::shapeAncestryCache[TopAbs_FACE].ancestors[TopAbs_EDGE]
-        /// stores an OCCT TopTools_IndexedDataMapOfShapeListOfShape that can return a list of
+        /// points to an OCCT TopTools_IndexedDataMapOfShapeListOfShape that can return a list of
         /// faces containing a given edge.
-        std::array<AncestorInfo, TopAbs_SHAPE + 1> ancestors;
+        std::array<const TopTools_IndexedDataMapOfShapeListOfShape*, TopAbs_SHAPE + 1> ancestors {};
 
         TopoShape _getTopoShape(const TopoShape& parent, int index);
+        const TopTools_IndexedDataMapOfShapeListOfShape& getAncestors(TopAbs_ShapeEnum subType);
 
     public:
         void clear();
@@ -119,6 +153,30 @@ public:
         friend TopoShapeCache;
     };
 
+    /// The bounding boxes of the elements of a shape that bound it, i.e. the faces, the edges that
+    /// are not in a face and the vertices that are not in an edge, in a tree for pruning the
+    /// geometric queries. The boxes use the triangulation if there is one.
+    class PartExport BoundTree
+    {
+    public:
+        explicit BoundTree(const TopoDS_Shape& tds);
+        ~BoundTree();
+        BoundTree(const BoundTree&) = delete;
+        BoundTree& operator=(const BoundTree&) = delete;
+
+        std::size_t size() const;
+        const TopoDS_Shape& getElement(std::size_t index) const;
+        const Bnd_Box& getBox(std::size_t index) const;
+        /// Calls visit(index, distance) for the elements in the order of the distance of their
+        /// boxes to \a box as long as it returns true
+        void visitNearest(const Bnd_Box& box,
+                          const std::function<bool(std::size_t, double)>& visit) const;
+
+    private:
+        struct Private;
+        std::unique_ptr<Private> d;
+    };
+
     explicit TopoShapeCache(const TopoDS_Shape& tds);
     void insertRelation(const ShapeRelationKey& key, const QVector<Data::MappedElement>& value);
     bool isTouched(const TopoDS_Shape& tds) const;
@@ -141,6 +199,13 @@ public:
     /// compound shape.
     std::array<Ancestry, TopAbs_SHAPE + 1> shapeAncestryCache;
 
+    /// The shape maps shared with the other caches of the same shape, created on first use
+    std::shared_ptr<Topology> topology;
+
+    /// Returns the bound tree of the shape without location, it is built on first use
+    const BoundTree& getBoundTree();
+    std::unique_ptr<BoundTree> boundTree;
+
     std::map<ShapeRelationKey, QVector<Data::MappedElement>> relations;
 };
 
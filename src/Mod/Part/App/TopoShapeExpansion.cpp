@@ -25,8 +25,14 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <thread>
 
 #include <BRepAdaptor_Curve.hxx>
 #include <BRepAdaptor_CompCurve.hxx>
@@ -37,6 +43,7 @@
 
 #include <BRepBuilderAPI_MakeWire.hxx>
 #include <BRepCheck_Analyzer.hxx>
+#include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepFill.hxx>
 #include <BRepFill_Generator.hxx>
 #include <BRepTools.hxx>
@@ -87,6 +94,7 @@
 #include <OSD_Parallel.hxx>
 
 #include "modelRefine.h"
+#include "BooleanCache.h"
 #include "CrossSection.h"
 #include "TopoShape.h"
 #include "TopoShapeOpCode.h"
@@ -317,6 +325,97 @@ TopoDS_Shape TopoShape::findShape(TopAbs_ShapeEnum type, int idx) const
     return _cache->findShape(_Shape, type, idx);
 }
 
+double TopoShape::findClosestElements(const TopoShape& other,
+                                      double tol,
+                                      TopoDS_Shape& elements1,
+                                      TopoDS_Shape& elements2) const
+{
+    elements1.Nullify();
+    elements2.Nullify();
+    if (isNull() || other.isNull()) {
+        return -1;
+    }
+    initCache();
+    other.initCache();
+
+    // the trees are built of the shapes without location, the boxes of this shape are moved into
+    // the coordinate system of the other one
+    const TopLoc_Location& loc1 = _Shape.Location();
+    const TopLoc_Location& loc2 = other._Shape.Location();
+    if (std::abs(loc1.Transformation().ScaleFactor() - 1.0) > Precision::Confusion()
+        || std::abs(loc2.Transformation().ScaleFactor() - 1.0) > Precision::Confusion()) {
+        return -1;
+    }
+    gp_Trsf toOther = loc2.Transformation().Inverted() * loc1.Transformation();
+    const auto& tree1 = _cache->getBoundTree();
+    const auto& tree2 = other._cache->getBoundTree();
+
+    std::vector<Bnd_Box> boxes;
+    boxes.reserve(tree1.size());
+    std::vector<std::pair<double, std::size_t>> order;
+    for (std::size_t i = 0; i < tree1.size(); ++i) {
+        boxes.push_back(tree1.getBox(i).Transformed(toOther));
+        tree2.visitNearest(boxes.back(), [&](std::size_t, double dist) {
+            order.emplace_back(dist, i);
+            return false;
+        });
+    }
+    std::sort(order.begin(), order.end());
+
+    // the distance of the boxes is a lower bound of the distance of the elements, so the exact
+    // distance is only computed for the pairs whose boxes are close enough to beat the best one
+    double best = std::numeric_limits<double>::max();
+    std::vector<std::tuple<double, std::size_t, std::size_t>> results;
+    for (const auto& [bound, i] : order) {
+        if (bound > best + tol) {
+            break;
+        }
+        TopoDS_Shape element1 = moved(tree1.getElement(i), loc1);
+        tree2.visitNearest(boxes[i], [&](std::size_t j, double dist) {
+            if (dist > best + tol) {
+                return false;
+            }
+            BRepExtrema_DistShapeShape extss;
+            extss.SetDeflection(tol);
+            extss.LoadS1(element1);
+            extss.LoadS2(moved(tree2.getElement(j), loc2));
+            extss.Perform();
+            if (extss.IsDone() && extss.NbSolution() > 0) {
+                results.emplace_back(extss.Value(), i, j);
+                best = std::min(best, extss.Value());
+            }
+            return true;
+        });
+    }
+    if (results.empty()) {
+        return -1;
+    }
+
+    BRep_Builder builder;
+    TopoDS_Compound comp1;
+    TopoDS_Compound comp2;
+    builder.MakeCompound(comp1);
+    builder.MakeCompound(comp2);
+    std::vector<bool> used1(tree1.size());
+    std::vector<bool> used2(tree2.size());
+    for (const auto& [dist, i, j] : results) {
+        if (dist > best + tol) {
+            continue;
+        }
+        if (!used1[i]) {
+            used1[i] = true;
+            builder.Add(comp1, moved(tree1.getElement(i), loc1));
+        }
+        if (!used2[j]) {
+            used2[j] = true;
+            builder.Add(comp2, moved(tree2.getElement(j), loc2));
+        }
+    }
+    elements1 = comp1;
+    elements2 = comp2;
+    return best;
+}
+
 std::vector<TopoShape> TopoShape::findSubShapesWithSharedVertex(const TopoShape& subshape,
                                                                 std::vector<std::string>* names,
                                                                 Data::SearchOptions options,
@@ -780,8 +879,15 @@ void TopoShape::copyElementMap(const TopoShape& topoShape, const char* op)
     }
     std::vector<Data::ElementMap::MappedChildElements> children;
     std::array<TopAbs_ShapeEnum, 3> elementTypes = {TopAbs_VERTEX, TopAbs_EDGE, TopAbs_FACE};
+    // Without tag or postfix every name is copied unchanged, so the map of topoShape can be
+    // shared as long as both shapes have exactly the same sub-shapes.
+    bool passThrough = (!op || !op[0]) && (topoShape.Tag == 0 || topoShape.Tag == Tag);
     for (const auto elementType : elementTypes) {
         auto count = checkSubshapeCount(*this, topoShape, elementType);
+        if (count != static_cast<size_t>(countSubShapes(elementType))
+            || count != static_cast<size_t>(topoShape.countSubShapes(elementType))) {
+            passThrough = false;
+        }
         if (count == 0) {
             continue;
         }
@@ -793,6 +899,11 @@ void TopoShape::copyElementMap(const TopoShape& topoShape, const char* op)
     if (!Hasher) {
         Hasher = topoShape.Hasher;
     }
+    auto otherMap = topoShape.elementMap();
+    if (passThrough && otherMap && !children.empty() && Hasher == topoShape.Hasher) {
+        shareMappedChildElements(otherMap, std::move(children));
+        return;
+    }
     setMappedChildElements(children);
 }
 
@@ -2025,6 +2136,18 @@ TopoShape TopoShape::getSubTopoShape(const char* Type, bool silent) const
     return getSubTopoShape(res.first, res.second, silent);
 }
 
+TopoShape TopoShape::getSubTopoShape(const Data::IndexedName& element, bool silent) const
+{
+    auto res = shapeTypeAndIndex(element);
+    if (res.second <= 0) {
+        if (!silent) {
+            FC_THROWM(Base::ValueError, "Invalid shape name " << element);
+        }
+        return TopoShape();
+    }
+    return getSubTopoShape(res.first, res.second, silent);
+}
+
 // TODO: Can this be consolidated with getSubShape()?  We use ancestry; other uses current shape.
 TopoShape TopoShape::getSubTopoShape(TopAbs_ShapeEnum type, int idx, bool silent) const
 {
@@ -3945,10 +4068,7 @@ TopoShape& TopoShape::makeElementSlices(const TopoShape& shape,
 {
     std::vector<TopoShape> wires;
     TopoCrossSection cs(dir.x, dir.y, dir.z, shape, op);
-    int index = 0;
-    for (auto& distance : distances) {
-        cs.slice(++index, distance, wires);
-    }
+    cs.slices(distances, wires);
     return makeElementCompound(wires, op, SingleShapeCompoundCreationPolicy::returnShape);
 }
 
@@ -4024,6 +4144,123 @@ TopoShape& TopoShape::makeElementFillet(const TopoShape& shape,
     return makeElementShape(mkFillet, shape, op);
 }
 
+std::vector<int> TopoShape::findFailingEdges(const std::vector<TopoShape>& edges,
+                                             const EdgeOperation& make) const
+{
+    if (isNull()) {
+        FC_THROWM(NullShapeException, "Null shape");
+    }
+
+    // the edges sharing a vertex or a face end up in the same group
+    std::vector<int> parent(edges.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto root = [&parent](int i) {
+        while (parent[i] != i) {
+            i = parent[i] = parent[parent[i]];
+        }
+        return i;
+    };
+    std::map<std::pair<TopAbs_ShapeEnum, int>, int> owners;
+    auto join = [&](TopAbs_ShapeEnum type, const TopoDS_Shape& element, int i) {
+        auto res = owners.emplace(std::make_pair(type, findShape(element)), i);
+        if (!res.second) {
+            parent[root(i)] = root(res.first->second);
+        }
+    };
+    for (int i = 0; i < (int)edges.size(); ++i) {
+        const auto& edge = edges[i].getShape();
+        if (edge.IsNull() || edge.ShapeType() != TopAbs_EDGE || !findShape(edge)) {
+            FC_THROWM(Base::CADKernelError, "edge does not belong to the shape");
+        }
+        for (TopExp_Explorer xp(edge, TopAbs_VERTEX); xp.More(); xp.Next()) {
+            join(TopAbs_VERTEX, xp.Current(), i);
+        }
+        for (const auto& face : findAncestorsShapes(edge, TopAbs_FACE)) {
+            join(TopAbs_FACE, face, i);
+        }
+    }
+    std::map<int, std::vector<int>> groupMap;
+    for (int i = 0; i < (int)edges.size(); ++i) {
+        groupMap[root(i)].push_back(i);
+    }
+    std::vector<std::vector<int>> groups;
+    for (auto& it : groupMap) {
+        groups.push_back(std::move(it.second));
+    }
+
+    // each trial works on a copy, the copies are made one at a time
+    std::mutex mutex;
+    auto trial = [&](const std::vector<int>& batch) {
+        try {
+            std::vector<TopoShape> copies;
+            std::vector<int> indices;
+            TopoShape copy;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                BRepBuilderAPI_Copy mkCopy(getShape());
+                copy = TopoShape(mkCopy.Shape());
+                for (int group : batch) {
+                    for (int i : groups[group]) {
+                        copies.emplace_back(mkCopy.ModifiedShape(edges[i].getShape()));
+                        indices.push_back(i);
+                    }
+                }
+            }
+            return !make(copy, copies, indices).isNull();
+        }
+        catch (Standard_Failure&) {
+            return false;
+        }
+        catch (Base::Exception&) {
+            return false;
+        }
+    };
+
+    std::vector<std::vector<int>> failed(groups.size());
+    std::function<void(std::vector<int>)> check;
+    check = [&](std::vector<int> batch) {
+        if (trial(batch)) {
+            return;
+        }
+        if (batch.size() == 1) {
+            failed[batch.front()] = groups[batch.front()];
+            return;
+        }
+        std::vector<int> half(batch.begin() + batch.size() / 2, batch.end());
+        batch.resize(batch.size() / 2);
+        check(std::move(batch));
+        check(std::move(half));
+    };
+
+    const std::size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+    const std::size_t count = std::min(threads, groups.size());
+    std::vector<std::vector<int>> batches(count);
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        batches[i % count].push_back((int)i);
+    }
+    std::atomic<std::size_t> next = 0;
+    auto work = [&]() {
+        for (std::size_t i = next++; i < count; i = next++) {
+            check(batches[i]);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < count; i++) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::vector<int> res;
+    for (const auto& group : failed) {
+        res.insert(res.end(), group.begin(), group.end());
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
 TopoShape& TopoShape::makeElementChamfer(const TopoShape& shape,
                                          const std::vector<TopoShape>& edges,
                                          ChamferType chamferType,
@@ -4754,6 +4991,10 @@ public:
         : BRepBuilderAPI_RefineModel(s)
     {}
 
+    MyRefineMaker(const TopoDS_Shape& s, const TopoDS_Shape& base)
+        : BRepBuilderAPI_RefineModel(s, base)
+    {}
+
     void populate(ShapeMapper& mapper)
     {
         for (TopTools_DataMapIteratorOfDataMapOfShapeListOfShape it(this->myModified); it.More();
@@ -4766,7 +5007,10 @@ public:
     }
 };
 
-TopoShape& TopoShape::makeElementRefine(const TopoShape& shape, const char* op, RefineFail no_fail)
+TopoShape& TopoShape::makeElementRefine(const TopoShape& shape,
+                                        const char* op,
+                                        RefineFail no_fail,
+                                        const TopoShape* base)
 {
     if (shape.isNull()) {
         if (no_fail == RefineFail::throwException) {
@@ -4780,7 +5024,14 @@ TopoShape& TopoShape::makeElementRefine(const TopoShape& shape, const char* op,
     }
     bool closed = shape.isClosed();
     try {
-        MyRefineMaker mkRefine(shape.getShape());
+        std::unique_ptr<MyRefineMaker> mkRefinePtr;
+        if (base) {
+            mkRefinePtr = std::make_unique<MyRefineMaker>(shape.getShape(), base->getShape());
+        }
+        else {
+            mkRefinePtr = std::make_unique<MyRefineMaker>(shape.getShape());
+        }
+        MyRefineMaker& mkRefine = *mkRefinePtr;
         GenericShapeMapper mapper;
         mkRefine.populate(mapper);
         mapper.init(shape, mkRefine.Shape());
@@ -5827,6 +6078,18 @@ TopoShape& TopoShape::makeElementBoolean(const char* maker,
         return *this;
     }
 
+    // the result of unchanged operands is taken from the cache
+    std::string cacheKey;
+    if (BooleanCache::getMaxMemory() > 0) {
+        cacheKey = BooleanCache::makeKey((std::string(maker) + ' ' + op).c_str(),
+                                         inputs,
+                                         tolerance,
+                                         *this);
+        if (BooleanCache::find(cacheKey, *this)) {
+            return *this;
+        }
+    }
+
     std::unique_ptr<BRepAlgoAPI_BooleanOperation> mk;
     if (strcmp(maker, Part::OpCodes::Fuse) == 0) {
         mk.reset(new FCBRepAlgoAPI_Fuse);
@@ -5883,6 +6146,9 @@ TopoShape& TopoShape::makeElementBoolean(const char* maker,
     if (buildShell) {
         makeElementShell();
     }
+    if (!cacheKey.empty()) {
+        BooleanCache::insert(cacheKey, *this);
+    }
     return *this;
 }
 
@@ -2114,17 +2114,22 @@ PyObject* TopoShapePy::proximity(PyObject *args) const
 
 }
 
-PyObject* TopoShapePy::distToShape(PyObject *args) const
+PyObject* TopoShapePy::distToShape(PyObject *args, PyObject *keywds) const
 {
+    static const std::array<const char *, 4> kwlist{"shape", "tol", "accelerated", nullptr};
     PyObject* ps2;
+    PyObject* accelerated = Py_False;
     gp_Pnt P1, P2;
     BRepExtrema_SupportType supportType1, supportType2;
     TopoDS_Shape suppS1, suppS2;
     Standard_Real minDist = -1, t1, t2, u1, v1, u2, v2;
     Standard_Real tol = Precision::Confusion();
 
-    if (!PyArg_ParseTuple(args, "O!|d",&(TopoShapePy::Type), &ps2, &tol))
+    if (!Base::Wrapped_ParseTupleAndKeywords(args, keywds, "O!|dO!", kwlist,
+                                             &(TopoShapePy::Type), &ps2, &tol,
+                                             &PyBool_Type, &accelerated)) {
         return nullptr;
+    }
 
     const TopoDS_Shape& s1 = getTopoShapePtr()->getShape();
     TopoShape* ts1 = getTopoShapePtr();
@@ -2140,8 +2145,19 @@ PyObject* TopoShapePy::distToShape(PyObject *args) const
 #if OCC_VERSION_HEX >= 0x070600
     extss.SetMultiThread(true);
 #endif
-    extss.LoadS1(s1);
-    extss.LoadS2(s2);
+    TopoDS_Shape elements1, elements2;
+    if (Base::asBoolean(accelerated)) {
+        // only the closest elements of the shapes are passed to the exact computation
+        try {
+            ts1->findClosestElements(*ts2, tol, elements1, elements2);
+        }
+        catch (const Standard_Failure& e) {
+            PyErr_SetString(PyExc_RuntimeError, e.GetMessageString());
+            return nullptr;
+        }
+    }
+    extss.LoadS1(elements1.IsNull() ? s1 : elements1);
+    extss.LoadS2(elements2.IsNull() ? s2 : elements2);
     try {
         extss.Perform();
     }
@@ -57,6 +57,10 @@
 #include <BRepTools_History.hxx>
 #include <ShapeBuild_ReShape.hxx>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <deque>
@@ -665,6 +669,8 @@ public:
         }
     };
     bgi::rtree<Edges::iterator, RParameters, BoxGetter> boxMap {};
+    // the boxes of the source edges are packed into boxMap after all were added
+    bool bulkLoading = false;
 
     BRep_Builder builder;
     TopoDS_Compound compound;
@@ -720,7 +726,7 @@ public:
     {
         vmap.insert(VertexInfo(it,true));
         vmap.insert(VertexInfo(it,false));
-        if (it->queryBBox) {
+        if (it->queryBBox && !bulkLoading) {
             boxMap.insert(it);
         }
         showShape(it->edge, "add");
@@ -996,7 +1002,7 @@ public:
         }
     };
 
-    void checkSelfIntersection(const EdgeInfo &info, std::set<IntersectInfo> &params) const
+    void checkSelfIntersection(const EdgeInfo &info, std::vector<IntersectInfo> &params) const
     {
         // Early return if checking for self intersection (only for non linear spline curves)
         if (info.type <= GeomAbs_Parabola || info.isLinear) {
@@ -1028,8 +1034,8 @@ public:
 
         ENSURE(points2d.Length() == points3d.Length());
         for (int i=1; i<=points2d.Length(); ++i) {
-            params.emplace(points2d(i).ParamOnFirst(), points3d(i), info.edge);
-            params.emplace(points2d(i).ParamOnSecond(), points3d(i), info.edge);
+            params.emplace_back(points2d(i).ParamOnFirst(), points3d(i), info.edge);
+            params.emplace_back(points2d(i).ParamOnSecond(), points3d(i), info.edge);
         }
     }
 
@@ -1037,8 +1043,8 @@ public:
     // cognitive complexity
     bool checkIntersectionPlanar(const EdgeInfo& info,
                                  const EdgeInfo& other,
-                                 std::set<IntersectInfo>& params1,
-                                 std::set<IntersectInfo>& params2)
+                                 std::vector<IntersectInfo>& params1,
+                                 std::vector<IntersectInfo>& params2) const
     {
         gp_Pln pln;
         bool planar = TopoShape(info.edge).findPlane(pln);
@@ -1062,11 +1068,11 @@ public:
                     auto s2 = extss.SupportOnShape2(i);
                     if (s1.ShapeType() == TopAbs_EDGE) {
                         extss.ParOnEdgeS1(i, par);
-                        pushIntersection(params1, par, extss.PointOnShape1(i), other.edge);
+                        params1.emplace_back(par, extss.PointOnShape1(i), other.edge);
                     }
                     if (s2.ShapeType() == TopAbs_EDGE) {
                         extss.ParOnEdgeS2(i, par);
-                        pushIntersection(params2, par, extss.PointOnShape2(i), info.edge);
+                        params2.emplace_back(par, extss.PointOnShape2(i), info.edge);
                     }
                 }
                 return false;
@@ -1159,10 +1165,11 @@ public:
         return true;
     }
 
+    // The intersections are only collected as this runs in several threads, see splitEdges()
     void checkIntersection(const EdgeInfo &info,
                            const EdgeInfo &other,
-                           std::set<IntersectInfo> &params1,
-                           std::set<IntersectInfo> &params2)
+                           std::vector<IntersectInfo> &params1,
+                           std::vector<IntersectInfo> &params2) const
     {
         if(!checkIntersectionPlanar(info, other, params1, params2)){
             return;
@@ -1195,8 +1202,8 @@ public:
 
         ENSURE(points2d.Length() == points3d.Length());
         for (int i=1; i<=points2d.Length(); ++i) {
-            pushIntersection(params1, points2d(i).ParamOnFirst(), points3d(i), other.edge);
-            pushIntersection(params2, points2d(i).ParamOnSecond(), points3d(i), info.edge);
+            params1.emplace_back(points2d(i).ParamOnFirst(), points3d(i), other.edge);
+            params2.emplace_back(points2d(i).ParamOnSecond(), points3d(i), info.edge);
         }
     }
 
@@ -1282,6 +1289,52 @@ public:
         }
     }
 
+    // The intersections of an edge with itself and with the edges after it
+    struct IntersectTask {
+        EdgeInfo *info;
+        std::vector<EdgeInfo*> others;
+        std::vector<IntersectInfo> selfParams;
+        std::vector<std::vector<IntersectInfo>> params;
+        std::vector<std::vector<IntersectInfo>> otherParams;
+        std::exception_ptr error;
+    };
+
+    // This method was originally part of WireJoinerP::splitEdges(), split to reduce cognitive
+    // complexity. The intersections are found on all cores, each task only writes to itself.
+    void splitEdgesIntersect(std::vector<IntersectTask>& tasks) const
+    {
+        std::atomic<std::size_t> next {0};
+        auto work = [&]() {
+            for (std::size_t i = next++; i < tasks.size(); i = next++) {
+                auto& task = tasks[i];
+                try {
+                    checkSelfIntersection(*task.info, task.selfParams);
+                    task.params.resize(task.others.size());
+                    task.otherParams.resize(task.others.size());
+                    for (std::size_t j = 0; j < task.others.size(); ++j) {
+                        checkIntersection(*task.info,
+                                          *task.others[j],
+                                          task.params[j],
+                                          task.otherParams[j]);
+                    }
+                }
+                catch (...) {
+                    task.error = std::current_exception();
+                }
+            }
+        };
+
+        const std::size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < std::min(threads, tasks.size()); ++i) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
     // Try splitting any edges that intersects other edge
     void splitEdges()
     {
@@ -1295,20 +1348,47 @@ public:
         std::unique_ptr<Base::SequencerLauncher> seq(
                 new Base::SequencerLauncher("Splitting edges", edges.size()));
 
+        std::vector<IntersectTask> tasks;
+        tasks.reserve(edges.size());
         idx = 0;
         for (auto& info : edges) {
-            seq->next(true);
             ++idx;
-            auto &params = intersects[&info];
-            checkSelfIntersection(info, params);
-
+            tasks.push_back({&info, {}, {}, {}, {}, {}});
+            auto &others = tasks.back().others;
             for (auto vit=boxMap.qbegin(bgi::intersects(info.box)); vit!=boxMap.qend(); ++vit) {
-                const auto &other = *(*vit);
+                auto &other = *(*vit);
                 if (other.iteration <= idx) {
                     // means the edge is before us, and we've already checked intersection
                     continue;
                 }
-                checkIntersection(info, other, params, intersects[&other]);
+                others.push_back(&other);
+            }
+            // in the order of the edges, so the result doesn't depend on the layout of the tree
+            std::sort(others.begin(), others.end(), [](const EdgeInfo *a, const EdgeInfo *b) {
+                return a->iteration < b->iteration;
+            });
+        }
+
+        splitEdgesIntersect(tasks);
+
+        // the intersections are merged in the order of the edges, as close points are dropped
+        for (auto& task : tasks) {
+            seq->next(true);
+            if (task.error) {
+                std::rethrow_exception(task.error);
+            }
+            auto &params = intersects[task.info];
+            for (const auto& param : task.selfParams) {
+                params.insert(param);
+            }
+            for (std::size_t j = 0; j < task.others.size(); ++j) {
+                auto &otherParams = intersects[task.others[j]];
+                for (const auto& param : task.params[j]) {
+                    pushIntersection(params, param.param, param.point, param.intersectShape);
+                }
+                for (const auto& param : task.otherParams[j]) {
+                    pushIntersection(otherParams, param.param, param.point, param.intersectShape);
+                }
             }
         }
 
@@ -2889,9 +2969,21 @@ public:
         clear();
         sourceEdges.clear();
         sourceEdges.insert(sourceEdgeArray.begin(), sourceEdgeArray.end());
+        // The boxes are packed into the tree at once, which is much faster than inserting them
+        // one by one and gives a better tree for the queries of splitEdges()
+        bulkLoading = true;
         for (const auto& edge : sourceEdgeArray) {
             add(TopoDS::Edge(edge.getShape()), true);
         }
+        bulkLoading = false;
+        std::vector<Edges::iterator> boxes;
+        boxes.reserve(edges.size());
+        for (auto it = edges.begin(); it != edges.end(); ++it) {
+            if (it->queryBBox) {
+                boxes.push_back(it);
+            }
+        }
+        boxMap = decltype(boxMap)(boxes);
 
         if (doTightBound || doSplitEdge) {
             splitEdges();
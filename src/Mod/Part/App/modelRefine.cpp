@@ -24,8 +24,12 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <atomic>
+# include <exception>
 # include <numbers>
 # include <iterator>
+# include <set>
+# include <thread>
 # include <Bnd_Box.hxx>
 # include <BRep_Builder.hxx>
 # include <BRep_Tool.hxx>
@@ -64,6 +68,7 @@
 # include <TopExp_Explorer.hxx>
 # include <TopTools_DataMapIteratorOfDataMapOfIntegerListOfShape.hxx>
 # include <TopTools_DataMapIteratorOfDataMapOfShapeShape.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
 # include <TopTools_ListIteratorOfListOfShape.hxx>
 # include <TopTools_ListOfShape.hxx>
 #endif // _PreComp_
@@ -86,7 +91,10 @@ void ModelRefine::getFaceEdges(const TopoDS_Face &face, EdgeVectorType &edges)
 void ModelRefine::boundaryEdges(const FaceVectorType &faces, EdgeVectorType &edgesOut)
 {
     //this finds all the boundary edges. Maybe more than one boundary.
-    std::list<TopoDS_Edge> edges;
+    //an edge that is used an even number of times is an inner edge of the faces.
+    TopTools_IndexedMapOfShape edgeMap;
+    EdgeVectorType edges;
+    std::vector<int> counts;
     FaceVectorType::const_iterator faceIt;
     for (faceIt = faces.begin(); faceIt != faces.end(); ++faceIt)
     {
@@ -95,24 +103,21 @@ void ModelRefine::boundaryEdges(const FaceVectorType &faces, EdgeVectorType &edg
         getFaceEdges(*faceIt, faceEdges);
         for (faceEdgesIt = faceEdges.begin(); faceEdgesIt != faceEdges.end(); ++faceEdgesIt)
         {
-            bool foundSignal(false);
-            std::list<TopoDS_Edge>::iterator edgesIt;
-            for (edgesIt = edges.begin(); edgesIt != edges.end(); ++edgesIt)
+            std::size_t index = edgeMap.Add(*faceEdgesIt);
+            if (index > counts.size())
             {
-                if ((*edgesIt).IsSame(*faceEdgesIt))
-                {
-                    edgesIt = edges.erase(edgesIt);
-                    foundSignal = true;
-                    break;
-                }
-            }
-            if (!foundSignal)
                 edges.push_back(*faceEdgesIt);
+                counts.push_back(0);
+            }
+            counts[index - 1]++;
         }
     }
 
-    edgesOut.reserve(edges.size());
-    std::copy(edges.begin(), edges.end(), back_inserter(edgesOut));
+    for (std::size_t i = 0; i < edges.size(); ++i)
+    {
+        if (counts[i] % 2 == 1)
+            edgesOut.push_back(edges[i]);
+    }
 }
 
 TopoDS_Shell ModelRefine::removeFaces(const TopoDS_Shell &shell, const FaceVectorType &faces)
@@ -1027,6 +1032,95 @@ FaceUniter::FaceUniter(const TopoDS_Shell &shellIn) : modifiedSignal(false)
     workShell = shellIn;
 }
 
+void FaceUniter::setTouchedFaces(const TopTools_MapOfShape &faces)
+{
+    touchedFaces = faces;
+    hasTouchedFaces = true;
+}
+
+bool FaceUniter::isTouched(const FaceVectorType &faces) const
+{
+    if (!hasTouchedFaces)
+        return true;
+    return std::any_of(faces.begin(), faces.end(), [this](const TopoDS_Face &face) {
+        return touchedFaces.Contains(face);
+    });
+}
+
+void FaceUniter::buildFaces(std::vector<FaceGroup> &groups)
+{
+    // The faces of the groups are built concurrently. Building a face may update the tolerances
+    // and pcurves of the edges, so the groups that share an edge or vertex get different colors
+    // and only the groups of the same color run at the same time.
+    TopTools_IndexedMapOfShape subShapes;
+    std::vector<std::vector<std::size_t>> owners;
+    std::vector<int> colors(groups.size(), 0);
+    int colorCount = 0;
+    for (std::size_t i = 0; i < groups.size(); ++i)
+    {
+        TopTools_IndexedMapOfShape groupShapes;
+        for (const auto &face : groups[i].faces)
+        {
+            TopExp::MapShapes(face, TopAbs_EDGE, groupShapes);
+            TopExp::MapShapes(face, TopAbs_VERTEX, groupShapes);
+        }
+        std::set<int> usedColors;
+        for (int j = 1; j <= groupShapes.Extent(); ++j)
+        {
+            std::size_t index = subShapes.Add(groupShapes(j));
+            if (index > owners.size())
+                owners.resize(index);
+            for (std::size_t owner : owners[index - 1])
+                usedColors.insert(colors[owner]);
+            owners[index - 1].push_back(i);
+        }
+        int color = 0;
+        while (usedColors.count(color))
+            ++color;
+        colors[i] = color;
+        colorCount = std::max(colorCount, color + 1);
+    }
+
+    const std::size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+    std::vector<std::exception_ptr> errors(groups.size());
+    for (int color = 0; color < colorCount; ++color)
+    {
+        std::vector<std::size_t> indices;
+        for (std::size_t i = 0; i < groups.size(); ++i)
+        {
+            if (colors[i] == color)
+                indices.push_back(i);
+        }
+
+        std::atomic<std::size_t> next {0};
+        auto work = [&]() {
+            for (std::size_t i = next++; i < indices.size(); i = next++)
+            {
+                FaceGroup &group = groups[indices[i]];
+                try {
+                    group.newFace = group.object->buildFace(group.faces);
+                }
+                catch (...) {
+                    errors[indices[i]] = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < std::min(threads, indices.size()); ++i)
+            workers.emplace_back(work);
+        work();
+        for (auto &worker : workers)
+            worker.join();
+    }
+
+    for (const auto &error : errors)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
 bool FaceUniter::process()
 {
     if (workShell.IsNull())
@@ -1051,6 +1145,8 @@ bool FaceUniter::process()
 
     ModelRefine::FaceAdjacencySplitter adjacencySplitter(workShell);
 
+    // the groups are independent, their faces are built at once
+    std::vector<FaceGroup> groups;
     for(typeIt = typeObjects.begin(); typeIt != typeObjects.end(); ++typeIt)
     {
         ModelRefine::FaceVectorType typedFaces = splitter.getTypedFaceVector((*typeIt)->getType());
@@ -1063,36 +1159,40 @@ bool FaceUniter::process()
             for (std::size_t adjacentIndex(0); adjacentIndex < adjacencySplitter.getGroupCount(); ++adjacentIndex)
             {
 //                    std::cout << "         face count is: " << adjacencySplitter.getGroup(adjacentIndex).size() << std::endl;
-                TopoDS_Face newFace = (*typeIt)->buildFace(adjacencySplitter.getGroup(adjacentIndex));
-                if (!newFace.IsNull())
-                {
-                    // the created face should have the same orientation as the input faces
-                    const FaceVectorType& faces = adjacencySplitter.getGroup(adjacentIndex);
-                    if (!faces.empty() && newFace.Orientation() != faces[0].Orientation()) {
-                        checkFinalShell = true;
-                    }
-                    facesToSew.push_back(newFace);
-
-                    // This reserve is probably not actually an improvement over letting
-                    // emplace_back allocate as needed. Leaving the code here for study if someone
-                    // wants to measure it. Coverity issue 356645. - chennes, March 2025
-                    //if (facesToRemove.capacity() <= facesToRemove.size() + adjacencySplitter.getGroup(adjacentIndex).size())
-                    //    facesToRemove.reserve(facesToRemove.size() + adjacencySplitter.getGroup(adjacentIndex).size());
-
-                    FaceVectorType temp = adjacencySplitter.getGroup(adjacentIndex);
-                    facesToRemove.insert(facesToRemove.end(), temp.begin(), temp.end());
-                    // the first shape will be marked as modified, i.e. replaced by newFace, all others are marked as deleted
-                    // jrheinlaender: IMHO this is not correct because references to the deleted faces will be broken, whereas they should
-                    // be replaced by references to the new face. To achieve this all shapes should be marked as
-                    // modified, producing one single new face. This is the inverse behaviour to faces that are split e.g.
-                    // by a boolean cut, where one old shape is marked as modified, producing multiple new shapes
-                    if (!temp.empty())
-                    {
-                        for (const auto & f : temp)
-                              modifiedShapes.emplace_back(f, newFace);
-                    }
-                }
+                const FaceVectorType& faces = adjacencySplitter.getGroup(adjacentIndex);
+                if (isTouched(faces))
+                    groups.push_back({*typeIt, faces, TopoDS_Face()});
+            }
+        }
+    }
+    buildFaces(groups);
+
+    for (const auto &group : groups)
+    {
+        const TopoDS_Face &newFace = group.newFace;
+        if (!newFace.IsNull())
+        {
+            // the created face should have the same orientation as the input faces
+            const FaceVectorType& faces = group.faces;
+            if (!faces.empty() && newFace.Orientation() != faces[0].Orientation()) {
+                checkFinalShell = true;
             }
+            facesToSew.push_back(newFace);
+
+            // This reserve is probably not actually an improvement over letting
+            // emplace_back allocate as needed. Leaving the code here for study if someone
+            // wants to measure it. Coverity issue 356645. - chennes, March 2025
+            //if (facesToRemove.capacity() <= facesToRemove.size() + group.faces.size())
+            //    facesToRemove.reserve(facesToRemove.size() + group.faces.size());
+
+            facesToRemove.insert(facesToRemove.end(), faces.begin(), faces.end());
+            // the first shape will be marked as modified, i.e. replaced by newFace, all others are marked as deleted
+            // jrheinlaender: IMHO this is not correct because references to the deleted faces will be broken, whereas they should
+            // be replaced by references to the new face. To achieve this all shapes should be marked as
+            // modified, producing one single new face. This is the inverse behaviour to faces that are split e.g.
+            // by a boolean cut, where one old shape is marked as modified, producing multiple new shapes
+            for (const auto & f : faces)
+                  modifiedShapes.emplace_back(f, newFace);
         }
     }
     if (!facesToSew.empty())
@@ -1223,6 +1323,29 @@ Part::BRepBuilderAPI_RefineModel::BRepBuilderAPI_RefineModel(const TopoDS_Shape&
     Build();
 }
 
+Part::BRepBuilderAPI_RefineModel::BRepBuilderAPI_RefineModel(const TopoDS_Shape& shape,
+                                                             const TopoDS_Shape& base)
+{
+    // the faces that an operation didn't touch are the same as in its base shape
+    TopTools_IndexedMapOfShape baseFaces;
+    if (!base.IsNull())
+        TopExp::MapShapes(base, TopAbs_FACE, baseFaces);
+    TopExp_Explorer xp;
+    for (xp.Init(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        if (!baseFaces.Contains(xp.Current()))
+            myTouchedFaces.Add(xp.Current());
+    }
+    myHasTouchedFaces = true;
+    myShape = shape;
+    Build();
+}
+
+void Part::BRepBuilderAPI_RefineModel::InitUniter(ModelRefine::FaceUniter& uniter) const
+{
+    if (myHasTouchedFaces)
+        uniter.setTouchedFaces(myTouchedFaces);
+}
+
 #if OCC_VERSION_HEX >= 0x070600
 void Part::BRepBuilderAPI_RefineModel::Build(const Message_ProgressRange&)
 #else
@@ -1239,6 +1362,7 @@ void Part::BRepBuilderAPI_RefineModel::Build()
         for (it.Init(solid, TopAbs_SHELL); it.More(); it.Next()) {
             const TopoDS_Shell &currentShell = TopoDS::Shell(it.Current());
             ModelRefine::FaceUniter uniter(currentShell);
+            InitUniter(uniter);
             if (uniter.process()) {
                 if (uniter.isModified()) {
                     const TopoDS_Shell &newShell = uniter.getShell();
@@ -1258,6 +1382,7 @@ void Part::BRepBuilderAPI_RefineModel::Build()
     else if (myShape.ShapeType() == TopAbs_SHELL) {
         const TopoDS_Shell& shell = TopoDS::Shell(myShape);
         ModelRefine::FaceUniter uniter(shell);
+        InitUniter(uniter);
         if (uniter.process()) {
             // TODO: Why not check for uniter.isModified()?
             myShape = uniter.getShell();
@@ -1281,6 +1406,7 @@ void Part::BRepBuilderAPI_RefineModel::Build()
             for (it.Init(solid, TopAbs_SHELL); it.More(); it.Next()) {
                 const TopoDS_Shell &currentShell = TopoDS::Shell(it.Current());
                 ModelRefine::FaceUniter uniter(currentShell);
+                InitUniter(uniter);
                 if (uniter.process()) {
                     if (uniter.isModified()) {
                         const TopoDS_Shell &newShell = uniter.getShell();
@@ -1295,6 +1421,7 @@ void Part::BRepBuilderAPI_RefineModel::Build()
         for (xp.Init(myShape, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next()) {
             const TopoDS_Shell& shell = TopoDS::Shell(xp.Current());
             ModelRefine::FaceUniter uniter(shell);
+            InitUniter(uniter);
             if (uniter.process()) {
                 builder.Add(comp, uniter.getShell());
                 LogModifications(uniter);
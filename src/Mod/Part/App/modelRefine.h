@@ -162,6 +162,8 @@ namespace ModelRefine
         FaceUniter() = default;
     public:
         FaceUniter(const TopoDS_Shell &shellIn);
+        /// Only the groups with at least one of \a faces are united, by default all groups are
+        void setTouchedFaces(const TopTools_MapOfShape &faces);
         bool process();
         const TopoDS_Shell& getShell() const {return workShell;}
         bool isModified(){return modifiedSignal;}
@@ -171,7 +173,18 @@ namespace ModelRefine
         {return deletedShapes;}
 
     private:
+        struct FaceGroup
+        {
+            FaceTypedBase *object;
+            FaceVectorType faces;
+            TopoDS_Face newFace;
+        };
+        bool isTouched(const FaceVectorType &faces) const;
+        static void buildFaces(std::vector<FaceGroup> &groups);
+
         TopoDS_Shell workShell;
+        TopTools_MapOfShape touchedFaces;
+        bool hasTouchedFaces = false;
         std::vector<FaceTypedBase *> typeObjects;
         std::vector<ShapePairType> modifiedShapes;
         ShapeVectorType deletedShapes;
@@ -199,6 +212,9 @@ class PartExport BRepBuilderAPI_RefineModel : public BRepBuilderAPI_MakeShape
 {
 public:
     BRepBuilderAPI_RefineModel(const TopoDS_Shape&);
+    /// Only refines the faces of \a shape that are not in \a base, e.g. the faces that a boolean
+    /// operation created or modified. The faces of \a base must have been refined before.
+    BRepBuilderAPI_RefineModel(const TopoDS_Shape& shape, const TopoDS_Shape& base);
 #if OCC_VERSION_HEX >= 0x070600
     void Build(const Message_ProgressRange& theRange = Message_ProgressRange()) override;
 #else
@@ -209,8 +225,11 @@ public:
 
 private:
     void LogModifications(const ModelRefine::FaceUniter& uniter);
+    void InitUniter(ModelRefine::FaceUniter& uniter) const;
 
 protected:
+    TopTools_MapOfShape myTouchedFaces;
+    bool myHasTouchedFaces = false;
     TopTools_DataMapOfShapeListOfShape myModified;
     TopTools_ListOfShape myEmptyList;
     TopTools_ListOfShape myDeleted;
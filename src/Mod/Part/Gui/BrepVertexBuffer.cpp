@@ -0,0 +1,240 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <Inventor/actions/SoGLRenderAction.h>
+# include <Inventor/elements/SoCoordinateElement.h>
+
+# ifdef FC_OS_WIN32
+#  include <windows.h>
+#  include <GL/gl.h>
+#  include <GL/glext.h>
+# else
+#  ifdef FC_OS_MACOSX
+#   include <OpenGL/gl.h>
+#   include <OpenGL/glext.h>
+#  else
+#   include <GL/gl.h>
+#   include <GL/glext.h>
+#  endif //FC_OS_MACOSX
+# endif //FC_OS_WIN32
+#endif
+
+#include <Gui/SoFCInteractiveElement.h>
+#include <Gui/Inventor/SoFCRenderStatistics.h>
+
+#include "BrepVertexBuffer.h"
+
+
+using namespace PartGui;
+
+BrepVertexBuffer::BrepVertexBuffer()
+    : vertices(GL_ARRAY_BUFFER)
+    , lineIndices(GL_ELEMENT_ARRAY_BUFFER)
+{
+}
+
+bool BrepVertexBuffer::isEnabled(SoGLRenderAction *action)
+{
+    static bool init = false;
+    static bool vboAvailable = false;
+    if (!init) {
+        vboAvailable = Gui::OpenGLBuffer::isVBOSupported(action->getCacheContext());
+        init = true;
+    }
+    if (!vboAvailable) {
+        return false;
+    }
+
+    // get the VBO status of the viewer
+    SbBool active = false;
+    Gui::SoGLVBOActivatedElement::get(action->getState(), active);
+    return active;
+}
+
+void BrepVertexBuffer::invalidate()
+{
+    vertices.destroy();
+    lineIndices.destroy();
+}
+
+bool BrepVertexBuffer::bind(SoGLRenderAction *action,
+                            const SoCoordinateElement *coords,
+                            const int32_t *cindices,
+                            int numindices)
+{
+    if (!coords || !coords->is3D() || coords->getNum() == 0) {
+        return false;
+    }
+
+    // The coordinate node gets a new id whenever it is modified
+    if (coords->getNodeId() != coordNodeId
+            || coords->getNum() != numCoords
+            || numindices != numIndices) {
+        invalidate();
+        coordNodeId = coords->getNodeId();
+        numCoords = coords->getNum();
+        numIndices = numindices;
+    }
+
+    uint32_t context = action->getCacheContext();
+    vertices.setCurrentContext(context);
+    lineIndices.setCurrentContext(context);
+
+    bool withLines = cindices && numindices > 0;
+    if (!vertices.isCreated(context)) {
+        if (!vertices.create()) {
+            return false;
+        }
+        vertices.bind();
+        vertices.allocate(coords->getArrayPtr3(), numCoords * static_cast<int>(sizeof(SbVec3f)));
+        Gui::SoFCRenderStatistics::addBufferUpload(numCoords * sizeof(SbVec3f));
+    }
+    else {
+        vertices.bind();
+        Gui::SoFCRenderStatistics::addBufferHit();
+    }
+
+    if (withLines) {
+        if (!lineIndices.isCreated(context)) {
+            if (!lineIndices.create()) {
+                vertices.release();
+                return false;
+            }
+
+            std::vector<GLuint> segments;
+            segments.reserve(2 * numindices);
+            lineOffsets.clear();
+            lineOffsets.push_back(0);
+            int32_t prev = -1;
+            for (int i = 0; i < numindices; ++i) {
+                int32_t index = cindices[i];
+                if (index < 0) {
+                    lineOffsets.push_back(static_cast<int>(segments.size()));
+                    prev = -1;
+                    continue;
+                }
+                if (index >= numCoords) {
+                    prev = -1;
+                    continue;
+                }
+                if (prev >= 0) {
+                    segments.push_back(static_cast<GLuint>(prev));
+                    segments.push_back(static_cast<GLuint>(index));
+                }
+                prev = index;
+            }
+            if (cindices[numindices - 1] >= 0) {
+                lineOffsets.push_back(static_cast<int>(segments.size()));
+            }
+
+            lineIndices.bind();
+            lineIndices.allocate(segments.data(), static_cast<int>(segments.size() * sizeof(GLuint)));
+            Gui::SoFCRenderStatistics::addBufferUpload(segments.size() * sizeof(GLuint));
+        }
+        else {
+            lineIndices.bind();
+        }
+    }
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, nullptr);
+    return true;
+}
+
+void BrepVertexBuffer::release()
+{
+    glDisableClientState(GL_VERTEX_ARRAY);
+    vertices.release();
+    lineIndices.release();
+}
+
+void BrepVertexBuffer::drawLineRange(int first, int last) const
+{
+    if (last > first) {
+        glDrawElements(GL_LINES, last - first, GL_UNSIGNED_INT,
+                       reinterpret_cast<const GLvoid*>(first * sizeof(GLuint)));
+    }
+}
+
+void BrepVertexBuffer::drawLines() const
+{
+    if (!lineOffsets.empty()) {
+        drawLineRange(0, lineOffsets.back());
+    }
+}
+
+void BrepVertexBuffer::drawLines(const std::set<int> &polylines) const
+{
+    int numLines = static_cast<int>(lineOffsets.size()) - 1;
+    int first = -1;
+    int last = -1;
+    // Merge adjacent polylines into one draw call
+    for (int line : polylines) {
+        if (line < 0 || line >= numLines) {
+            continue;
+        }
+        if (line != last) {
+            if (first >= 0) {
+                drawLineRange(lineOffsets[first], lineOffsets[last]);
+            }
+            first = line;
+        }
+        last = line + 1;
+    }
+    if (first >= 0) {
+        drawLineRange(lineOffsets[first], lineOffsets[last]);
+    }
+}
+
+void BrepVertexBuffer::drawPointRange(int first, int last) const
+{
+    if (last > first) {
+        glDrawArrays(GL_POINTS, first, last - first);
+    }
+}
+
+void BrepVertexBuffer::drawPoints(int start) const
+{
+    drawPointRange(std::max(start, 0), numCoords);
+}
+
+void BrepVertexBuffer::drawPoints(const std::set<int> &points, int start) const
+{
+    int first = -1;
+    int last = -1;
+    for (int point : points) {
+        if (point < start || point >= numCoords) {
+            continue;
+        }
+        if (point != last) {
+            drawPointRange(first, last);
+            first = point;
+        }
+        last = point + 1;
+    }
+    drawPointRange(first, last);
+}
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef PARTGUI_BREPVERTEXBUFFER_H
+#define PARTGUI_BREPVERTEXBUFFER_H
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include <Gui/GLBuffer.h>
+
+class SoCoordinateElement;
+class SoGLRenderAction;
+
+namespace PartGui {
+
+/**
+ * Vertex buffer objects for SoBrepEdgeSet and SoBrepPointSet
+ *
+ * The coordinates and, for edges, the line segments are uploaded once per
+ * GL context. Every polyline of an edge set maps to a range of the line
+ * index buffer, so highlighted and selected edges are drawn from the same
+ * buffers without sending any data.
+ */
+class BrepVertexBuffer
+{
+public:
+    BrepVertexBuffer();
+
+    /// Check if buffer objects can be used for the given action
+    static bool isEnabled(SoGLRenderAction *action);
+
+    /// Upload the data again on the next call of bind()
+    void invalidate();
+
+    /** Bind the buffers, upload the data if outdated
+     * @param coords: the coordinates
+     * @param cindices: polyline coordinate indices separated by -1, or null
+     * if only points are drawn
+     * @param numindices: number of coordinate indices
+     * @return false if the buffers cannot be used
+     */
+    bool bind(SoGLRenderAction *action,
+              const SoCoordinateElement *coords,
+              const int32_t *cindices,
+              int numindices);
+    void release();
+
+    /// Draw all polylines
+    void drawLines() const;
+    /// Draw the given polylines
+    void drawLines(const std::set<int> &polylines) const;
+    /// Draw all points starting from \a start
+    void drawPoints(int start) const;
+    /// Draw the given points
+    void drawPoints(const std::set<int> &points, int start) const;
+
+private:
+    void drawLineRange(int first, int last) const;
+    void drawPointRange(int first, int last) const;
+
+private:
+    Gui::OpenGLMultiBuffer vertices;
+    Gui::OpenGLMultiBuffer lineIndices;
+    // offset of each polyline into the line index buffer
+    std::vector<int> lineOffsets;
+    uint32_t coordNodeId = 0;
+    int numCoords = -1;
+    int numIndices = -1;
+};
+
+} // namespace PartGui
+
+
+#endif // PARTGUI_BREPVERTEXBUFFER_H
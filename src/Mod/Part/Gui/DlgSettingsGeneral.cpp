@@ -60,6 +60,7 @@ void DlgSettingsGeneral::saveSettings()
     ui->checkBooleanCheck->onSave();
     ui->checkBooleanRefine->onSave();
     ui->checkSketchBaseRefine->onSave();
+    ui->checkRefineTouchedFacesOnly->onSave();
     ui->checkObjectNaming->onSave();
     ui->checkAllowCompoundBody->onSave();
     ui->enableGizmos->onSave();
@@ -76,6 +77,7 @@ void DlgSettingsGeneral::loadSettings()
     ui->checkBooleanCheck->onRestore();
     ui->checkBooleanRefine->onRestore();
     ui->checkSketchBaseRefine->onRestore();
+    ui->checkRefineTouchedFacesOnly->onRestore();
     ui->checkObjectNaming->onRestore();
     ui->checkAllowCompoundBody->onRestore();
     ui->enableGizmos->onRestore();
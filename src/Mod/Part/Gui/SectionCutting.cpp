@@ -28,6 +28,8 @@
 
 # include <Inventor/actions/SoGetBoundingBoxAction.h>
 # include <Inventor/nodes/SoCamera.h>
+# include <Inventor/nodes/SoClipPlane.h>
+# include <Inventor/nodes/SoGroup.h>
 # include <Inventor/nodes/SoOrthographicCamera.h>
 # include <QDialog>
 # include <QDockWidget>
@@ -390,6 +392,18 @@ void SectionCut::setupConnections()
             this, &SectionCut::onCutYHSChanged);
     connect(ui->cutZHS, &QSlider::valueChanged,
             this, &SectionCut::onCutZHSChanged);
+    connect(ui->cutXHS, &QSlider::sliderPressed,
+            this, &SectionCut::onCutHSPressed);
+    connect(ui->cutYHS, &QSlider::sliderPressed,
+            this, &SectionCut::onCutHSPressed);
+    connect(ui->cutZHS, &QSlider::sliderPressed,
+            this, &SectionCut::onCutHSPressed);
+    connect(ui->cutXHS, &QSlider::sliderReleased,
+            this, &SectionCut::onCutXHSReleased);
+    connect(ui->cutYHS, &QSlider::sliderReleased,
+            this, &SectionCut::onCutYHSReleased);
+    connect(ui->cutZHS, &QSlider::sliderReleased,
+            this, &SectionCut::onCutZHSReleased);
     connect(ui->flipX, &QPushButton::clicked,
             this, &SectionCut::onFlipXclicked);
     connect(ui->flipY, &QPushButton::clicked,
@@ -1403,6 +1417,7 @@ SectionCut* SectionCut::makeDockWidget(QWidget* parent)
 /** Destroys the object and frees any allocated resources */
 SectionCut::~SectionCut()
 {
+    finishPreview();
     // there might be no document
     if (!Gui::Application::Instance->activeDocument()) {
         noDocumentActions();
@@ -1557,6 +1572,10 @@ void SectionCut::adjustYZRanges(SbBox3f CutBoundingBox)
 void SectionCut::onCutXvalueChanged(double val)
 {
     CutValueHelper(val, ui->cutX, ui->cutXHS);
+    if (ui->cutXHS->isSliderDown()) {
+        updatePreview();
+        return;
+    }
 
     // get the cut box
     auto CutBox = findObject(BoxXName);
@@ -1678,9 +1697,36 @@ void SectionCut::onCutXHSChanged(int val)
     onCutXHSsliderMoved(val);
 }
 
+void SectionCut::onCutHSPressed()
+{
+    startPreview();
+}
+
+void SectionCut::onCutXHSReleased()
+{
+    finishPreview();
+    onCutXvalueChanged(ui->cutX->value());
+}
+
+void SectionCut::onCutYHSReleased()
+{
+    finishPreview();
+    onCutYvalueChanged(ui->cutY->value());
+}
+
+void SectionCut::onCutZHSReleased()
+{
+    finishPreview();
+    onCutZvalueChanged(ui->cutZ->value());
+}
+
 void SectionCut::onCutYvalueChanged(double val)
 {
     CutValueHelper(val, ui->cutY, ui->cutYHS);
+    if (ui->cutYHS->isSliderDown()) {
+        updatePreview();
+        return;
+    }
 
     auto CutBox = findObject(BoxYName);
     if (!CutBox) {
@@ -1803,6 +1849,10 @@ void SectionCut::onCutYHSChanged(int val)
 void SectionCut::onCutZvalueChanged(double val)
 {
     CutValueHelper(val, ui->cutZ, ui->cutZHS);
+    if (ui->cutZHS->isSliderDown()) {
+        updatePreview();
+        return;
+    }
 
     auto CutBox = findObject(BoxZName);
     if (!CutBox) {
@@ -2276,6 +2326,100 @@ void SectionCut::onRefreshCutPBclicked()
     }
 }
 
+void SectionCut::startPreview()
+{
+    if (preview.root) {
+        return;
+    }
+    auto docGui = Gui::Application::Instance->activeDocument();
+    if (!docGui || docGui->getDocument() != doc) {
+        return;
+    }
+    auto view = dynamic_cast<Gui::View3DInventor*>(docGui->getActiveView());
+    if (!view) {
+        return;
+    }
+
+    // the first cut is made of the uncut objects, the last one is the shown result
+    App::DocumentObject* base {};
+    App::DocumentObject* cut {};
+    for (const char* name : {CutXName, CutYName, CutZName}) {
+        if (auto pcCut = dynamic_cast<Part::Cut*>(findObject(name))) {
+            if (!base) {
+                base = pcCut->Base.getValue();
+            }
+            cut = pcCut;
+        }
+    }
+    if (!base || !cut) {
+        return;
+    }
+
+    // the clip planes are put in front of the scene like Gui::Clipping does
+    preview.root = static_cast<SoGroup*>(view->getViewer()->getSceneGraph());
+    preview.root->ref();
+    for (auto& plane : preview.planes) {
+        plane = new SoClipPlane();
+        plane->ref();
+        plane->on.setValue(false);
+        preview.root->insertChild(plane, 0);
+    }
+    preview.base = base;
+    preview.cut = cut;
+    cut->Visibility.setValue(false);
+    base->Visibility.setValue(true);
+    updatePreview();
+}
+
+void SectionCut::updatePreview()
+{
+    if (!preview.root) {
+        return;
+    }
+
+    // the kept side of a cut is the one the box is not on
+    auto setPlane = [](SoClipPlane* plane, const SbVec3f& normal, bool on, bool flipped,
+                       double value) {
+        plane->on.setValue(on);
+        if (flipped) {
+            plane->plane.setValue(SbPlane(-normal, -static_cast<float>(value)));
+        }
+        else {
+            plane->plane.setValue(SbPlane(normal, static_cast<float>(value)));
+        }
+    };
+    setPlane(preview.planes[0], SbVec3f(1, 0, 0), ui->groupBoxX->isChecked(),
+             ui->flipX->isChecked(), ui->cutX->value());
+    setPlane(preview.planes[1], SbVec3f(0, 1, 0), ui->groupBoxY->isChecked(),
+             ui->flipY->isChecked(), ui->cutY->value());
+    setPlane(preview.planes[2], SbVec3f(0, 0, 1), ui->groupBoxZ->isChecked(),
+             ui->flipZ->isChecked(), ui->cutZ->value());
+}
+
+void SectionCut::finishPreview()
+{
+    if (!preview.root) {
+        return;
+    }
+
+    for (auto& plane : preview.planes) {
+        preview.root->removeChild(plane);
+        plane->unref();
+        plane = nullptr;
+    }
+    preview.root->unref();
+    preview.root = nullptr;
+
+    if (auto base = preview.base.getObject()) {
+        base->Visibility.setValue(false);
+    }
+    if (auto cut = preview.cut.getObject()) {
+        cut->Visibility.setValue(true);
+    }
+    preview.base = App::DocumentObjectT();
+    preview.cut = App::DocumentObjectT();
+}
+
 SbBox3f SectionCut::getViewBoundingBox()
 {
     SbBox3f Box;
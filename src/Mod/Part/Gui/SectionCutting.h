@@ -23,6 +23,7 @@
 #ifndef PARTGUI_SECTIONCUTTING_H
 #define PARTGUI_SECTIONCUTTING_H
 
+#include <array>
 #include <functional>
 #include <Inventor/SbBox3f.h>
 #include <QDialog>
@@ -31,6 +32,8 @@
 
 class QDoubleSpinBox;
 class QSlider;
+class SoClipPlane;
+class SoGroup;
 
 namespace Gui
 {
@@ -69,6 +72,10 @@ protected Q_SLOTS:
     void onCutXHSChanged(int);
     void onCutYHSChanged(int);
     void onCutZHSChanged(int);
+    void onCutHSPressed();
+    void onCutXHSReleased();
+    void onCutYHSReleased();
+    void onCutZHSReleased();
     void onFlipXclicked();
     void onFlipYclicked();
     void onFlipZclicked();
@@ -172,7 +179,21 @@ private:
     double getPosY(Part::Box* box) const;
     double getPosZ(Part::Box* box) const;
 
+    void startPreview();
+    void updatePreview();
+    void finishPreview();
+
 private:
+    /// While a slider is dragged the uncut objects are shown clipped by the cut planes, the
+    /// boolean cut is only recomputed when the slider is released
+    struct Preview
+    {
+        SoGroup* root = nullptr;
+        std::array<SoClipPlane*, 3> planes {};
+        App::DocumentObjectT base;
+        App::DocumentObjectT cut;
+    };
+
     std::unique_ptr<Ui_SectionCut> ui;
     std::vector<App::DocumentObjectT> ObjectsListVisible;
     App::Document* doc = nullptr; // pointer to active document
@@ -187,6 +208,7 @@ private:
     const char* CutXName = "SectionCutX";
     const char* CutYName = "SectionCutY";
     const char* CutZName = "SectionCutZ";
+    Preview preview;
 };
 
 } // namespace PartGui
@@ -39,23 +39,29 @@
 # include <Inventor/actions/SoGLRenderAction.h>
 # include <Inventor/bundles/SoMaterialBundle.h>
 # include <Inventor/details/SoLineDetail.h>
+# include <Inventor/bundles/SoTextureCoordinateBundle.h>
 # include <Inventor/elements/SoCoordinateElement.h>
+# include <Inventor/elements/SoGLCacheContextElement.h>
 # include <Inventor/elements/SoGLCoordinateElement.h>
 # include <Inventor/elements/SoLineWidthElement.h>
+# include <Inventor/elements/SoMaterialBindingElement.h>
 # include <Inventor/errors/SoDebugError.h>
 # include <Inventor/misc/SoState.h>
 # include <Inventor/nodes/SoGroup.h>
 # include <Inventor/actions/SoSearchAction.h>
 #endif
 
+#include <Gui/Selection/SoFCSelectionAction.h>
 #include <Gui/Selection/SoFCUnifiedSelection.h>
 #include <Gui/Selection/Selection.h>
 #include <Base/Console.h>
+#include "BrepVertexBuffer.h"
 #include "SoBrepEdgeSet.h"
 #include "SoBrepFaceSet.h"
 #include "ViewProviderExt.h"
 
 #include <Gui/Inventor/So3DAnnotation.h>
+#include <Gui/Inventor/SoFCRenderStatistics.h>
 
 
 using namespace PartGui;
@@ -78,6 +84,8 @@ SoBrepEdgeSet::SoBrepEdgeSet()
     SO_NODE_CONSTRUCTOR(SoBrepEdgeSet);
 }
 
+SoBrepEdgeSet::~SoBrepEdgeSet() = default;
+
 void SoBrepEdgeSet::GLRender(SoGLRenderAction *action)
 {
     auto state = action->getState();
@@ -88,6 +96,24 @@ void SoBrepEdgeSet::GLRender(SoGLRenderAction *action)
     if(ctx2 && ctx2->selectionIndex.empty())
         return;
 
+    if (action->isOfType(Gui::SoFCIdRenderAction::getClassTypeId())) {
+        renderIds(static_cast<Gui::SoFCIdRenderAction*>(action));
+        return;
+    }
+
+    Gui::SoFCRenderStatistics::NodeTimer timer(this);
+    if (Gui::SoFCRenderStatistics::isActive()) {
+        // every polyline of n points has n-1 segments
+        int numindices = this->coordIndex.getNum();
+        const int32_t* cindices = this->coordIndex.getValues(0);
+        int segments = 0;
+        for (int i = 1; i < numindices; ++i) {
+            if (cindices[i] >= 0 && cindices[i - 1] >= 0) {
+                ++segments;
+            }
+        }
+        Gui::SoFCRenderStatistics::addPrimitives(0, segments, 0);
+    }
 
     bool hasContextHighlight = ctx && !ctx->hl.empty();
     bool hasFaceHighlight = viewProvider && viewProvider->isFaceHighlightActive();
@@ -168,12 +194,12 @@ void SoBrepEdgeSet::GLRender(SoGLRenderAction *action)
         glDepthMask(false);
         glDisable(GL_DEPTH_TEST);
 
-        inherited::GLRender(action);
+        renderLines(action);
 
         state->pop();
     }
     else {
-       inherited::GLRender(action);
+       renderLines(action);
     }
 
     // Workaround for #0000433
@@ -187,6 +213,56 @@ void SoBrepEdgeSet::GLRender(SoGLRenderAction *action)
 //#endif
 }
 
+void SoBrepEdgeSet::renderIds(Gui::SoFCIdRenderAction *action)
+{
+    if (!this->shouldGLRender(action))
+        return;
+
+    const SoCoordinateElement* coords = SoCoordinateElement::getInstance(action->getState());
+    int numcoords = coords->getNum();
+    const int32_t* cindices = this->coordIndex.getValues(0);
+    int numindices = this->coordIndex.getNum();
+
+    int numlines = 0;
+    for (int i = 0; i < numindices; ++i) {
+        if (cindices[i] < 0 || i + 1 == numindices)
+            ++numlines;
+    }
+    uint32_t first = action->addShape(SoLineDetail::getClassTypeId(), numlines);
+    if (!first)
+        return;
+
+    // One id per polyline, i.e. per edge of the shape
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_TEXTURE_2D);
+    glDisable(GL_BLEND);
+    glDisable(GL_LINE_STIPPLE);
+    uint32_t id = first;
+    bool open = false;
+    for (int i = 0; i < numindices; ++i) {
+        int32_t index = cindices[i];
+        if (index < 0) {
+            if (open)
+                glEnd();
+            open = false;
+            ++id;
+            continue;
+        }
+        if (index >= numcoords)
+            continue;
+        if (!open) {
+            Gui::SoFCIdRenderAction::setIdColor(id);
+            glBegin(GL_LINE_STRIP);
+            open = true;
+        }
+        glVertex3fv(coords->get3(index).getValue());
+    }
+    if (open)
+        glEnd();
+    glPopAttrib();
+}
+
 void SoBrepEdgeSet::GLRenderBelowPath(SoGLRenderAction * action)
 {
     inherited::GLRenderBelowPath(action);
@@ -250,6 +326,79 @@ void SoBrepEdgeSet::renderShape(const SoGLCoordinateElement * const coords,
     }
 }
 
+void SoBrepEdgeSet::renderLines(SoGLRenderAction *action)
+{
+    SoState * state = action->getState();
+    // Only the common case of an overall material and unlit or
+    // unshaded lines is drawn from the buffers
+    if (!BrepVertexBuffer::isEnabled(action)
+            || SoMaterialBindingElement::get(state) != SoMaterialBindingElement::OVERALL) {
+        inherited::GLRender(action);
+        return;
+    }
+
+    SoMaterialBundle mb(action);
+    SoTextureCoordinateBundle tb(action, true, false);
+    bool needNormals = !mb.isColorOnly() || tb.isFunction();
+
+    const SoCoordinateElement * coords;
+    const SbVec3f * normals;
+    const int32_t * cindices;
+    int numcindices;
+    const int32_t * nindices;
+    const int32_t * tindices;
+    const int32_t * mindices;
+    SbBool normalCacheUsed;
+
+    this->getVertexData(state, coords, normals, cindices, nindices,
+        tindices, mindices, numcindices, needNormals, normalCacheUsed);
+    if (normalCacheUsed) {
+        this->readUnlockNormalCache();
+    }
+
+    if (tb.needCoordinates() || (needNormals && normals) || numcindices <= 0) {
+        inherited::GLRender(action);
+        return;
+    }
+
+    if (!this->shouldGLRender(action)) {
+        return;
+    }
+
+    state->push();
+    if (needNormals) {
+        // no normals, so the lines are drawn without lighting
+        SoLazyElement::setLightModel(state, SoLazyElement::BASE_COLOR);
+    }
+    mb.sendFirst();
+    if (bindBuffer(action, coords, cindices, numcindices)) {
+        vbo->drawLines();
+        vbo->release();
+    }
+    else {
+        renderShape(static_cast<const SoGLCoordinateElement*>(coords), cindices, numcindices);
+    }
+    state->pop();
+}
+
+bool SoBrepEdgeSet::bindBuffer(SoGLRenderAction *action, const SoCoordinateElement *coords,
+                               const int32_t *cindices, int numcindices)
+{
+    if (!BrepVertexBuffer::isEnabled(action)) {
+        return false;
+    }
+    if (!vbo) {
+        vbo = std::make_unique<BrepVertexBuffer>();
+    }
+    if (!vbo->bind(action, coords, cindices, numcindices)) {
+        return false;
+    }
+    // buffer objects must not end up in a display list
+    SoGLCacheContextElement::shouldAutoCache(action->getState(),
+                                             SoGLCacheContextElement::DONT_AUTO_CACHE);
+    return true;
+}
+
 void SoBrepEdgeSet::renderHighlight(SoGLRenderAction *action, SelContextPtr ctx)
 {
     if(!ctx || ctx->highlightIndex<0)
@@ -279,7 +428,16 @@ void SoBrepEdgeSet::renderHighlight(SoGLRenderAction *action, SelContextPtr ctx)
     mb.sendFirst(); // make sure we have the correct material
 
     int num = (int)ctx->hl.size();
-    if (num > 0) {
+    if (num > 0 && bindBuffer(action, coords, cindices, numcindices)) {
+        if (ctx->hl[0] < 0) {
+            vbo->drawLines();
+        }
+        else {
+            vbo->drawLines({ctx->highlightIndex});
+        }
+        vbo->release();
+    }
+    else if (num > 0) {
         if (ctx->hl[0] < 0) {
             renderShape(static_cast<const SoGLCoordinateElement*>(coords), cindices, numcindices);
         }
@@ -324,7 +482,16 @@ void SoBrepEdgeSet::renderSelection(SoGLRenderAction *action, SelContextPtr ctx,
     mb.sendFirst(); // make sure we have the correct material
 
     int num = (int)ctx->sl.size();
-    if (num > 0) {
+    if (num > 0 && bindBuffer(action, coords, cindices, numcindices)) {
+        if (ctx->sl[0] < 0) {
+            vbo->drawLines();
+        }
+        else {
+            vbo->drawLines(ctx->selectionIndex);
+        }
+        vbo->release();
+    }
+    else if (num > 0) {
         if (ctx->sl[0] < 0) {
             renderShape(static_cast<const SoGLCoordinateElement*>(coords), cindices, numcindices);
         }
@@ -354,7 +521,12 @@ bool SoBrepEdgeSet::validIndexes(const SoCoordinateElement* coords, const std::v
 
 void SoBrepEdgeSet::doAction(SoAction* action)
 {
-    if (action->getTypeId() == Gui::SoHighlightElementAction::getClassTypeId()) {
+    if (action->getTypeId() == Gui::SoUpdateVBOAction::getClassTypeId()) {
+        if (vbo) {
+            vbo->invalidate();
+        }
+    }
+    else if (action->getTypeId() == Gui::SoHighlightElementAction::getClassTypeId()) {
         Gui::SoHighlightElementAction* hlaction = static_cast<Gui::SoHighlightElementAction*>(action);
         selCounter.checkAction(hlaction);
         if (!hlaction->isHighlighted()) {
@@ -34,8 +34,13 @@ class SoCoordinateElement;
 class SoGLCoordinateElement;
 class SoTextureCoordinateBundle;
 
+namespace Gui {
+class SoFCIdRenderAction;
+}
+
 namespace PartGui {
 
+class BrepVertexBuffer;
 class ViewProviderPartExt;
 
 class PartGuiExport SoBrepEdgeSet : public SoIndexedLineSet {
@@ -50,7 +55,7 @@ public:
     void setViewProvider(ViewProviderPartExt* vp) { viewProvider = vp; }
 
 protected:
-    ~SoBrepEdgeSet() override = default;
+    ~SoBrepEdgeSet() override;
     void GLRender(SoGLRenderAction *action) override;
     void GLRenderBelowPath(SoGLRenderAction * action) override;
     void doAction(SoAction* action) override;
@@ -68,6 +73,10 @@ private:
 
     void renderShape(const SoGLCoordinateElement * const vertexlist,
                      const int32_t *vertexindices, int num_vertexindices);
+    void renderLines(SoGLRenderAction *action);
+    void renderIds(Gui::SoFCIdRenderAction *action);
+    bool bindBuffer(SoGLRenderAction *action, const SoCoordinateElement *coords,
+                    const int32_t *cindices, int numcindices);
     void renderHighlight(SoGLRenderAction *action, SelContextPtr);
     void renderSelection(SoGLRenderAction *action, SelContextPtr, bool push=true);
     bool validIndexes(const SoCoordinateElement*, const std::vector<int32_t>&) const;
@@ -78,6 +87,7 @@ private:
     SelContextPtr selContext2;
     Gui::SoFCSelectionCounter selCounter;
     uint32_t packedColor{0};
+    std::unique_ptr<BrepVertexBuffer> vbo;
     
     // backreference to viewprovider that owns this node
     ViewProviderPartExt* viewProvider = nullptr;
@@ -74,6 +74,7 @@
 #include <Gui/Selection/SoFCSelectionAction.h>
 #include <Gui/Selection/SoFCUnifiedSelection.h>
 #include <Gui/Inventor/So3DAnnotation.h>
+#include <Gui/Inventor/SoFCRenderStatistics.h>
 
 #include "SoBrepFaceSet.h"
 #include "ViewProviderExt.h"
@@ -136,6 +137,9 @@ public:
                 const int mbind,
                 SbBool texture);
 
+    /// Draw a range of triangles from the uploaded buffer with the current material
+    bool renderRange(SoGLRenderAction * action, int first, int count);
+
     static void context_destruction_cb(uint32_t context, void * userdata)
     {
         VBO * self = static_cast<VBO*>(userdata);
@@ -372,6 +376,10 @@ void SoBrepFaceSet::GLRender(SoGLRenderAction *action)
     SelContextPtr ctx = Gui::SoFCSelectionRoot::getRenderContext<SelContext>(this,selContext,ctx2);
     if(ctx2 && ctx2->selectionIndex.empty())
         return;
+    if (action->isOfType(Gui::SoFCIdRenderAction::getClassTypeId())) {
+        renderIds(static_cast<Gui::SoFCIdRenderAction*>(action));
+        return;
+    }
 
     int32_t hl_idx = ctx?ctx->highlightIndex:-1;
     int32_t num_selected = ctx?ctx->selectionIndex.size():0;
@@ -524,6 +532,12 @@ void SoBrepFaceSet::GLRender(SoGLRenderAction *action)
     SelContextPtr ctx = Gui::SoFCSelectionRoot::getRenderContext(this,selContext,ctx2);
     if(ctx2 && ctx2->selectionIndex.empty())
         return;
+    if (action->isOfType(Gui::SoFCIdRenderAction::getClassTypeId())) {
+        renderIds(static_cast<Gui::SoFCIdRenderAction*>(action));
+        return;
+    }
+    Gui::SoFCRenderStatistics::NodeTimer timer(this);
+    Gui::SoFCRenderStatistics::addPrimitives(this->coordIndex.getNum() / 4, 0, 0);
     if(selContext2->checkGlobal(ctx))
         ctx = selContext2;
     if(ctx && (ctx->selectionIndex.empty() && ctx->highlightIndex<0))
@@ -909,6 +923,49 @@ bool SoBrepFaceSet::overrideMaterialBinding(SoGLRenderAction *action, SelContext
     return false;
 }
 
+void SoBrepFaceSet::renderIds(Gui::SoFCIdRenderAction *action)
+{
+    int numparts = this->partIndex.getNum();
+    if (numparts == 0 || !this->shouldGLRender(action))
+        return;
+
+    uint32_t first = action->addShape(SoFaceDetail::getClassTypeId(), numparts);
+    if (!first)
+        return;
+
+    const SoCoordinateElement* coords = SoCoordinateElement::getInstance(action->getState());
+    int numcoords = coords->getNum();
+    const int32_t* cindices = this->coordIndex.getValues(0);
+    int numindices = this->coordIndex.getNum();
+    const int32_t* pindices = this->partIndex.getValues(0);
+
+    // One id per part, i.e. per face of the shape. Every triangle takes
+    // four indices in coordIndex including the -1 separator.
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_TEXTURE_2D);
+    glDisable(GL_BLEND);
+    glDisable(GL_POLYGON_STIPPLE);
+    glBegin(GL_TRIANGLES);
+    int index = 0;
+    for (int part = 0; part < numparts; ++part) {
+        Gui::SoFCIdRenderAction::setIdColor(first + part);
+        for (int tri = 0; tri < pindices[part] && index + 2 < numindices; ++tri, index += 4) {
+            int32_t v1 = cindices[index];
+            int32_t v2 = cindices[index+1];
+            int32_t v3 = cindices[index+2];
+            if (v1 < 0 || v2 < 0 || v3 < 0
+                    || v1 >= numcoords || v2 >= numcoords || v3 >= numcoords)
+                continue;
+            glVertex3fv(coords->get3(v1).getValue());
+            glVertex3fv(coords->get3(v2).getValue());
+            glVertex3fv(coords->get3(v3).getValue());
+        }
+    }
+    glEnd();
+    glPopAttrib();
+}
+
 void SoBrepFaceSet::GLRenderBelowPath(SoGLRenderAction * action)
 {
     inherited::GLRenderBelowPath(action);
@@ -1303,8 +1360,10 @@ void SoBrepFaceSet::renderHighlight(SoGLRenderAction *action, SelContextPtr ctx)
         mbind = OVERALL;
         doTextures = false;
 
-        renderShape(action, false, static_cast<const SoGLCoordinateElement*>(coords), &(cindices[start]), length,
-            &(pindices[id]), 1, normals, nindices, &mb, mindices, &tb, tindices, nbind, mbind, doTextures);
+        if (!renderPartsFromVBO(action, start / 4, length / 4)) {
+            renderShape(action, false, static_cast<const SoGLCoordinateElement*>(coords), &(cindices[start]), length,
+                &(pindices[id]), 1, normals, nindices, &mb, mindices, &tb, tindices, nbind, mbind, doTextures);
+        }
     }
     state->pop();
 
@@ -1367,6 +1426,9 @@ void SoBrepFaceSet::renderSelection(SoGLRenderAction *action, SelContextPtr ctx,
         doTextures = false;
     }
 
+    // index of the first triangle of every part, only computed if needed
+    std::vector<int> partStart;
+
     for(auto id : ctx->selectionIndex) {
         if (id >= this->partIndex.getNum()) {
             SoDebugError::postWarning("SoBrepFaceSet::renderSelection", "selectionIndex out of range");
@@ -1384,12 +1446,22 @@ void SoBrepFaceSet::renderSelection(SoGLRenderAction *action, SelContextPtr ctx,
             length = numindices;
             id = 0;
         } else {
+            if (partStart.empty()) {
+                partStart.resize(this->partIndex.getNum());
+                int triangles = 0;
+                for (int j=0;j<this->partIndex.getNum();j++) {
+                    partStart[j] = triangles;
+                    triangles += (int)pindices[j];
+                }
+            }
             length = (int)pindices[id]*4;
-            for (int j=0;j<id;j++)
-                start+=(int)pindices[j];
-            start *= 4;
+            start = partStart[id]*4;
         }
 
+        // With the override material the uploaded buffer can be used
+        if (push && renderPartsFromVBO(action, start / 4, length / 4))
+            continue;
+
         // normals
         const SbVec3f * normals_s = normals;
         const int32_t * nindices_s = nindices;
@@ -1705,6 +1777,10 @@ void SoBrepFaceSet::VBO::render(SoGLRenderAction * action,
         buf.updateVbo = false;
         free(vertex_array);
         free(index_array);
+        Gui::SoFCRenderStatistics::addBufferUpload(sizeof(float) * indice + sizeof(GLuint) * this->indice_array);
+    }
+    else {
+        Gui::SoFCRenderStatistics::addBufferHit();
     }
 
     // This is the VBO rendering code
@@ -1737,6 +1813,55 @@ void SoBrepFaceSet::VBO::render(SoGLRenderAction * action,
     // The data is within the VBO we can clear it at application level
 }
 
+bool SoBrepFaceSet::VBO::renderRange(SoGLRenderAction * action, int first, int count)
+{
+    auto it = this->vbomap.find(action->getCacheContext());
+    if (it == this->vbomap.end() || !it->second.vboLoaded || it->second.updateVbo)
+        return false;
+    // The buffer holds one triangle after the other in the order of the parts
+    if (first < 0 || count <= 0 || (std::size_t)(first + count) * 3 > this->indice_array)
+        return false;
+
+#ifdef FC_OS_WIN32
+    const cc_glglue * glue = cc_glglue_instance(action->getCacheContext());
+    PFNGLBINDBUFFERARBPROC glBindBufferARB = (PFNGLBINDBUFFERARBPROC)cc_glglue_getprocaddress(glue, "glBindBufferARB");
+#endif
+
+    const VBO::Buffer &buf = it->second;
+    glBindBufferARB(GL_ARRAY_BUFFER_ARB, buf.myvbo[0]);
+    glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, buf.myvbo[1]);
+
+    // no color array, the highlight or selection color is the current material
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+
+    glVertexPointer(3,GL_FLOAT,10*sizeof(GLfloat),nullptr);
+    glNormalPointer(GL_FLOAT,10*sizeof(GLfloat),(GLvoid *)(3*sizeof(GLfloat)));
+
+    glDrawElements(GL_TRIANGLES, count * 3, GL_UNSIGNED_INT,
+                   (GLvoid *)((std::size_t)first * 3 * sizeof(GLuint)));
+
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0);
+    glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
+    return true;
+}
+
+bool SoBrepFaceSet::renderPartsFromVBO(SoGLRenderAction *action, int first, int count)
+{
+    if (!PRIVATE(this)->vboAvailable)
+        return false;
+
+    // get the VBO status of the viewer
+    SbBool hasVBO = false;
+    Gui::SoGLVBOActivatedElement::get(action->getState(), hasVBO);
+    if (!hasVBO)
+        return false;
+
+    return PRIVATE(this)->renderRange(action, first, count);
+}
+
 void SoBrepFaceSet::renderShape(SoGLRenderAction * action,
                                 SbBool hasVBO,
                                 const SoGLCoordinateElement * const vertexlist,
@@ -36,6 +36,10 @@ class SoGLCoordinateElement;
 class SoTextureCoordinateBundle;
 
 
+namespace Gui {
+class SoFCIdRenderAction;
+}
+
 namespace PartGui {
 
 class ViewProviderPartExt;
@@ -133,8 +137,11 @@ private:
     using SelContext = Gui::SoFCSelectionContextEx;
     using SelContextPtr = Gui::SoFCSelectionContextExPtr;
 
+    void renderIds(Gui::SoFCIdRenderAction *action);
     void renderHighlight(SoGLRenderAction *action, SelContextPtr);
     void renderSelection(SoGLRenderAction *action, SelContextPtr, bool push=true);
+    /// Draw the triangles of some parts from the buffer uploaded by the last full render
+    bool renderPartsFromVBO(SoGLRenderAction *action, int first, int count);
 
     bool overrideMaterialBinding(SoGLRenderAction *action, SelContextPtr ctx, SelContextPtr ctx2);
 
@@ -36,16 +36,22 @@
 # include <Inventor/actions/SoGetBoundingBoxAction.h>
 # include <Inventor/actions/SoGLRenderAction.h>
 # include <Inventor/bundles/SoMaterialBundle.h>
+# include <Inventor/bundles/SoTextureCoordinateBundle.h>
 # include <Inventor/details/SoPointDetail.h>
 # include <Inventor/elements/SoCoordinateElement.h>
+# include <Inventor/elements/SoGLCacheContextElement.h>
+# include <Inventor/elements/SoMaterialBindingElement.h>
 # include <Inventor/elements/SoPointSizeElement.h>
 # include <Inventor/errors/SoDebugError.h>
 # include <Inventor/misc/SoState.h>
 #endif
 
+#include <Gui/Selection/SoFCSelectionAction.h>
 #include <Gui/Selection/SoFCUnifiedSelection.h>
 #include <Gui/Inventor/So3DAnnotation.h>
+#include <Gui/Inventor/SoFCRenderStatistics.h>
 
+#include "BrepVertexBuffer.h"
 #include "ViewProviderExt.h"
 #include "SoBrepPointSet.h"
 
@@ -66,6 +72,8 @@ SoBrepPointSet::SoBrepPointSet()
     SO_NODE_CONSTRUCTOR(SoBrepPointSet);
 }
 
+SoBrepPointSet::~SoBrepPointSet() = default;
+
 void SoBrepPointSet::GLRender(SoGLRenderAction *action)
 {
     auto state = action->getState();
@@ -81,6 +89,12 @@ void SoBrepPointSet::GLRender(SoGLRenderAction *action)
     SelContextPtr ctx = Gui::SoFCSelectionRoot::getRenderContext<SelContext>(this,selContext,ctx2);
     if(ctx2 && ctx2->selectionIndex.empty())
         return;
+    if (action->isOfType(Gui::SoFCIdRenderAction::getClassTypeId())) {
+        renderIds(static_cast<Gui::SoFCIdRenderAction*>(action));
+        return;
+    }
+    Gui::SoFCRenderStatistics::NodeTimer timer(this);
+    Gui::SoFCRenderStatistics::addPrimitives(0, 0, num);
     if(selContext2->checkGlobal(ctx))
         ctx = selContext2;
     
@@ -142,11 +156,11 @@ void SoBrepPointSet::GLRender(SoGLRenderAction *action)
     else if (Gui::SoDelayedAnnotationsElement::isProcessingDelayedPaths) {
         glPushAttrib(GL_DEPTH_BUFFER_BIT);
         glDepthFunc(GL_ALWAYS);
-        inherited::GLRender(action);
+        renderPoints(action);
         glPopAttrib();
     }
     else {
-        inherited::GLRender(action);
+        renderPoints(action);
     }
 
     // Workaround for #0000433
@@ -160,6 +174,32 @@ void SoBrepPointSet::GLRender(SoGLRenderAction *action)
 //#endif
 }
 
+void SoBrepPointSet::renderIds(Gui::SoFCIdRenderAction *action)
+{
+    if (!this->shouldGLRender(action))
+        return;
+
+    // The ids cover all coordinates so that an id maps directly to the
+    // coordinate index, but only the points from startIndex are drawn
+    const SoCoordinateElement* coords = SoCoordinateElement::getInstance(action->getState());
+    int numcoords = coords->getNum();
+    uint32_t first = action->addShape(SoPointDetail::getClassTypeId(), numcoords);
+    if (!first)
+        return;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_TEXTURE_2D);
+    glDisable(GL_BLEND);
+    glBegin(GL_POINTS);
+    for (int i = std::max(this->startIndex.getValue(), 0); i < numcoords; ++i) {
+        Gui::SoFCIdRenderAction::setIdColor(first + i);
+        glVertex3fv(coords->get3(i).getValue());
+    }
+    glEnd();
+    glPopAttrib();
+}
+
 void SoBrepPointSet::GLRenderBelowPath(SoGLRenderAction * action)
 {
     inherited::GLRenderBelowPath(action);
@@ -192,6 +232,62 @@ void SoBrepPointSet::getBoundingBox(SoGetBoundingBoxAction * action) {
         action->extendBy(bbox);
 }
 
+void SoBrepPointSet::renderPoints(SoGLRenderAction *action)
+{
+    SoState * state = action->getState();
+    // Only the common case of all points with an overall material
+    // is drawn from the buffers
+    if (!BrepVertexBuffer::isEnabled(action)
+            || this->numPoints.getValue() >= 0
+            || SoMaterialBindingElement::get(state) != SoMaterialBindingElement::OVERALL) {
+        inherited::GLRender(action);
+        return;
+    }
+
+    SoMaterialBundle mb(action);
+    SoTextureCoordinateBundle tb(action, true, false);
+    bool needNormals = !mb.isColorOnly() || tb.isFunction();
+
+    const SoCoordinateElement * coords;
+    const SbVec3f * normals;
+
+    this->getVertexData(state, coords, normals, needNormals);
+
+    if (tb.needCoordinates() || (needNormals && normals) || !bindBuffer(action, coords)) {
+        inherited::GLRender(action);
+        return;
+    }
+
+    if (this->shouldGLRender(action)) {
+        state->push();
+        if (needNormals) {
+            // no normals, so the points are drawn without lighting
+            SoLazyElement::setLightModel(state, SoLazyElement::BASE_COLOR);
+        }
+        mb.sendFirst();
+        vbo->drawPoints(this->startIndex.getValue());
+        state->pop();
+    }
+    vbo->release();
+}
+
+bool SoBrepPointSet::bindBuffer(SoGLRenderAction *action, const SoCoordinateElement *coords)
+{
+    if (!BrepVertexBuffer::isEnabled(action)) {
+        return false;
+    }
+    if (!vbo) {
+        vbo = std::make_unique<BrepVertexBuffer>();
+    }
+    if (!vbo->bind(action, coords, nullptr, 0)) {
+        return false;
+    }
+    // buffer objects must not end up in a display list
+    SoGLCacheContextElement::shouldAutoCache(action->getState(),
+                                             SoGLCacheContextElement::DONT_AUTO_CACHE);
+    return true;
+}
+
 void SoBrepPointSet::renderHighlight(SoGLRenderAction *action, SelContextPtr ctx)
 {
     if(!ctx || ctx->highlightIndex<0)
@@ -216,7 +312,16 @@ void SoBrepPointSet::renderHighlight(SoGLRenderAction *action, SelContextPtr ctx
 
     int id = ctx->highlightIndex;
     const SbVec3f * coords3d = coords->getArrayPtr3();
-    if(coords3d) {
+    if (bindBuffer(action, coords)) {
+        if (id == std::numeric_limits<int>::max()) {
+            vbo->drawPoints(startIndex.getValue());
+        }
+        else {
+            vbo->drawPoints({id}, startIndex.getValue());
+        }
+        vbo->release();
+    }
+    else if(coords3d) {
         if(id == std::numeric_limits<int>::max()) {
             glBegin(GL_POINTS);
             for(int idx=startIndex.getValue();idx<coords->getNum();++idx)
@@ -258,7 +363,16 @@ void SoBrepPointSet::renderSelection(SoGLRenderAction *action, SelContextPtr ctx
     bool warn = false;
     int startIndex = this->startIndex.getValue();
     const SbVec3f * coords3d = coords->getArrayPtr3();
-    if(coords3d) {
+    if (bindBuffer(action, coords)) {
+        if (ctx->isSelectAll()) {
+            vbo->drawPoints(startIndex);
+        }
+        else {
+            vbo->drawPoints(ctx->selectionIndex, startIndex);
+        }
+        vbo->release();
+    }
+    else if(coords3d) {
         glBegin(GL_POINTS);
         if(ctx->isSelectAll()) {
             for(int idx=startIndex;idx<coords->getNum();++idx)
@@ -372,6 +486,11 @@ void SoBrepPointSet::doAction(SoAction* action)
         }
         return;
     }
+    else if (action->getTypeId() == Gui::SoUpdateVBOAction::getClassTypeId()) {
+        if (vbo) {
+            vbo->invalidate();
+        }
+    }
 
     inherited::doAction(action);
 }
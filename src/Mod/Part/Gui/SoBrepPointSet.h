@@ -34,8 +34,13 @@ class SoCoordinateElement;
 class SoGLCoordinateElement;
 class SoTextureCoordinateBundle;
 
+namespace Gui {
+class SoFCIdRenderAction;
+}
+
 namespace PartGui {
 
+class BrepVertexBuffer;
 class ViewProviderPartExt;
 
 class PartGuiExport SoBrepPointSet : public SoPointSet {
@@ -50,7 +55,7 @@ public:
     void setViewProvider(ViewProviderPartExt* vp) { viewProvider = vp; }
 
 protected:
-    ~SoBrepPointSet() override = default;
+    ~SoBrepPointSet() override;
     void GLRender(SoGLRenderAction *action) override;
     void GLRenderBelowPath(SoGLRenderAction * action) override;
     void doAction(SoAction* action) override;
@@ -60,6 +65,9 @@ protected:
 private:
     using SelContext = Gui::SoFCSelectionContext;
     using SelContextPtr = Gui::SoFCSelectionContextPtr;
+    void renderPoints(SoGLRenderAction *action);
+    void renderIds(Gui::SoFCIdRenderAction *action);
+    bool bindBuffer(SoGLRenderAction *action, const SoCoordinateElement *coords);
     void renderHighlight(SoGLRenderAction *action, SelContextPtr);
     void renderSelection(SoGLRenderAction *action, SelContextPtr, bool push=true);
 
@@ -68,6 +76,7 @@ private:
     SelContextPtr selContext2;
     Gui::SoFCSelectionCounter selCounter;
     uint32_t packedColor{0};
+    std::unique_ptr<BrepVertexBuffer> vbo;
     
     // backreference to viewprovider that owns this node
     ViewProviderPartExt* viewProvider = nullptr;
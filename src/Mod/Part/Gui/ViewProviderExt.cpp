@@ -49,14 +49,27 @@
 # include <TopTools_IndexedMapOfShape.hxx>
 
 # include <QAction>
+# include <QFutureWatcher>
 # include <QMenu>
+# include <QtConcurrentMap>
+# include <QtConcurrentRun>
+# include <algorithm>
+# include <condition_variable>
+# include <mutex>
+# include <numeric>
+# include <set>
 # include <sstream>
 
 # include <Inventor/SoPickedPoint.h>
+# include <Inventor/SbViewVolume.h>
+# include <Inventor/actions/SoGLRenderAction.h>
 # include <Inventor/details/SoFaceDetail.h>
 # include <Inventor/details/SoLineDetail.h>
 # include <Inventor/details/SoPointDetail.h>
+# include <Inventor/elements/SoModelMatrixElement.h>
+# include <Inventor/elements/SoViewVolumeElement.h>
 # include <Inventor/errors/SoDebugError.h>
+# include <Inventor/nodes/SoCallback.h>
 # include <Inventor/nodes/SoCoordinate3.h>
 # include <Inventor/nodes/SoDrawStyle.h>
 # include <Inventor/nodes/SoMaterial.h>
@@ -66,6 +79,7 @@
 # include <Inventor/nodes/SoPolygonOffset.h>
 # include <Inventor/nodes/SoSeparator.h>
 # include <Inventor/nodes/SoShapeHints.h>
+# include <Inventor/sensors/SoOneShotSensor.h>
 
 # include <boost/algorithm/string/predicate.hpp>
 #endif
@@ -118,6 +132,7 @@ ViewProviderPartExt::ViewProviderPartExt()
     VisualTouched = true;
     forceUpdateCount = 0;
     NormalsFromUV = true;
+    visualGeneration = std::make_shared<std::atomic<unsigned int>>(0);
 
     // get default line color
     unsigned long lcol = Gui::ViewParams::instance()->getDefaultShapeLineColor(); // dark grey (25,25,25)
@@ -135,6 +150,17 @@ ViewProviderPartExt::ViewProviderPartExt()
     ParameterGrp::handle hPart = App::GetApplication().GetParameterGroupByPath
         ("User parameter:BaseApp/Preferences/Mod/Part");
     NormalsFromUV = hPart->GetBool("NormalsFromUVNodes", NormalsFromUV);
+    AsyncTessellation = hPart->GetBool("AsyncTessellation", AsyncTessellation);
+    AsyncTessellationOnLoad = hPart->GetBool("AsyncTessellationOnLoad", AsyncTessellationOnLoad);
+    LevelOfDetail = hPart->GetBool("LevelOfDetail", LevelOfDetail);
+    LODCoarseFactor = std::max(1.0, hPart->GetFloat("LODCoarseFactor", LODCoarseFactor));
+    LODFineSize = hPart->GetFloat("LODFineSize", LODFineSize);
+    if (LevelOfDetail) {
+        pcLODCallback = new SoCallback();
+        pcLODCallback->ref();
+        pcLODCallback->setCallback(lodCallback, this);
+        lodSensor = std::make_unique<SoOneShotSensor>(lodSensorCallback, this);
+    }
 
     long twoside = hPart->GetBool("TwoSideRendering", true) ? 1 : 0;
 
@@ -249,6 +275,8 @@ ViewProviderPartExt::ViewProviderPartExt()
 
 ViewProviderPartExt::~ViewProviderPartExt()
 {
+    // let a pending tessellation know that its result is not needed any more
+    ++*visualGeneration;
     pcFaceBind->unref();
     pcLineBind->unref();
     pcPointBind->unref();
@@ -263,6 +291,9 @@ ViewProviderPartExt::~ViewProviderPartExt()
     normb->unref();
     lineset->unref();
     nodeset->unref();
+    if (pcLODCallback) {
+        pcLODCallback->unref();
+    }
 }
 
 PyObject* ViewProviderPartExt::getPyObject()
@@ -479,6 +510,9 @@ void ViewProviderPartExt::attach(App::DocumentObject *pcFeat)
 
     // Move 'coords' before the switch
     pcRoot->insertChild(coords,pcRoot->findChild(pcModeSwitch));
+    if (pcLODCallback) {
+        pcRoot->insertChild(pcLODCallback, pcRoot->findChild(coords));
+    }
 
     // putting all together with the switch
     addDisplayMaskMode(pcNormalRoot, "Flat Lines");
@@ -943,16 +977,110 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
                            double angularDeflection,
                            bool normalsFromUV)
 {
+    applyCoinGeometry(computeCoinGeometry(shape, deviation, angularDeflection, normalsFromUV),
+                      coords,
+                      faceset,
+                      norm,
+                      lineset,
+                      nodeset);
+}
+
+namespace
+{
+template<typename Field, typename T>
+void setFieldValues(Field& field, const std::vector<T>& values)
+{
+    field.setNum(static_cast<int>(values.size()));
+    if (!values.empty()) {
+        std::copy(values.begin(), values.end(), field.startEditing());
+        field.finishEditing();
+    }
+}
+
+/// Waits until no other tessellation uses the faces of a shape, and keeps them for itself.
+/// BRepMesh stores the mesh in the faces, which the shapes of several objects may share.
+class FaceMeshGuard
+{
+public:
+    explicit FaceMeshGuard(const TopoDS_Shape& shape)
+    {
+        TopTools_IndexedMapOfShape faceMap;
+        TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+        faces.reserve(faceMap.Extent());
+        for (int i = 1; i <= faceMap.Extent(); i++) {
+            faces.push_back(faceMap(i).TShape().get());
+        }
+
+        std::unique_lock<std::mutex> lock(mutex());
+        condition().wait(lock, [this]() {
+            return std::none_of(faces.begin(), faces.end(), [](const TopoDS_TShape* face) {
+                return busy().contains(face);
+            });
+        });
+        busy().insert(faces.begin(), faces.end());
+    }
+    ~FaceMeshGuard()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex());
+            for (auto face : faces) {
+                busy().erase(face);
+            }
+        }
+        condition().notify_all();
+    }
+    FaceMeshGuard(const FaceMeshGuard&) = delete;
+    FaceMeshGuard& operator=(const FaceMeshGuard&) = delete;
+
+private:
+    static std::mutex& mutex()
+    {
+        static std::mutex instance;
+        return instance;
+    }
+    static std::condition_variable& condition()
+    {
+        static std::condition_variable instance;
+        return instance;
+    }
+    static std::set<const TopoDS_TShape*>& busy()
+    {
+        static std::set<const TopoDS_TShape*> instance;
+        return instance;
+    }
+
+    std::vector<const TopoDS_TShape*> faces;
+};
+}  // namespace
+
+void ViewProviderPartExt::applyCoinGeometry(const CoinGeometry& geometry,
+                                            SoCoordinate3* coords,
+                                            SoBrepFaceSet* faceset,
+                                            SoNormal* norm,
+                                            SoBrepEdgeSet* lineset,
+                                            SoBrepPointSet* nodeset)
+{
+    setFieldValues(coords->point, geometry.points);
+    setFieldValues(norm->vector, geometry.normals);
+    setFieldValues(faceset->coordIndex, geometry.faceIndices);
+    setFieldValues(faceset->partIndex, geometry.partIndices);
+    setFieldValues(lineset->coordIndex, geometry.lineIndices);
+    nodeset->startIndex.setValue(geometry.pointStart);
+}
+
+ViewProviderPartExt::CoinGeometry ViewProviderPartExt::computeCoinGeometry(TopoDS_Shape shape,
+                                                                           double deviation,
+                                                                           double angularDeflection,
+                                                                           bool normalsFromUV)
+{
+    CoinGeometry geometry;
     if (Part::Tools::isShapeEmpty(shape)) {
-        coords->point.setNum(0);
-        norm->vector.setNum(0);
-        faceset->coordIndex.setNum(0);
-        faceset->partIndex.setNum(0);
-        lineset->coordIndex.setNum(0);
-        nodeset->startIndex.setValue(0);
-        return;
+        return geometry;
     }
 
+    // the faces are meshed and read only by this thread
+    FaceMeshGuard guard(shape);
+
     // time measurement and book keeping
     Base::TimeElapsed startTime;
 
@@ -992,21 +1120,33 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
     TopLoc_Location aLoc;
     shape.Location(aLoc);
 
-    // count triangles and nodes in the mesh
+    // count triangles and nodes in the mesh, and remember where each face goes
+    // in the arrays, so that the faces can be filled in independently
+    struct FaceMesh
+    {
+        Handle(Poly_Triangulation) mesh;
+        TopLoc_Location location;
+        int nodeOffset = 0;
+        int triaOffset = 0;
+    };
     TopTools_IndexedMapOfShape faceMap;
     TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+    std::vector<FaceMesh> faceMeshes(faceMap.Extent());
     for (int i = 1; i <= faceMap.Extent(); i++) {
-        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(TopoDS::Face(faceMap(i)), aLoc);
+        FaceMesh& faceMesh = faceMeshes[i - 1];
+        faceMesh.mesh = BRep_Tool::Triangulation(TopoDS::Face(faceMap(i)), faceMesh.location);
 
-        if (mesh.IsNull()) {
-            mesh = Part::Tools::triangulationOfFace(TopoDS::Face(faceMap(i)));
+        if (faceMesh.mesh.IsNull()) {
+            faceMesh.mesh = Part::Tools::triangulationOfFace(TopoDS::Face(faceMap(i)));
         }
 
         // Note: we must also count empty faces
-        if (!mesh.IsNull()) {
-            numTriangles += mesh->NbTriangles();
-            numNodes += mesh->NbNodes();
-            numNorms += mesh->NbNodes();
+        faceMesh.nodeOffset = numNodes;
+        faceMesh.triaOffset = numTriangles;
+        if (!faceMesh.mesh.IsNull()) {
+            numTriangles += faceMesh.mesh->NbTriangles();
+            numNodes += faceMesh.mesh->NbNodes();
+            numNorms += faceMesh.mesh->NbNodes();
         }
 
         TopExp_Explorer xp;
@@ -1056,47 +1196,42 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
     TopExp::MapShapes(shape, TopAbs_VERTEX, vertexMap);
     numNodes += vertexMap.Extent();
 
-    // create memory for the nodes and indexes
-    coords->point.setNum(numNodes);
-    norm->vector.setNum(numNorms);
-    faceset->coordIndex.setNum(numTriangles * 4);
-    faceset->partIndex.setNum(numFaces);
+    // create memory for the nodes and indexes, the normals are preset with null vectors
+    geometry.points.resize(numNodes);
+    geometry.normals.resize(numNorms, SbVec3f(0.0, 0.0, 0.0));
+    geometry.faceIndices.resize(numTriangles * 4);
+    geometry.partIndices.resize(numFaces);
 
     // get the raw memory for fast fill up
-    SbVec3f* verts = coords->point.startEditing();
-    SbVec3f* norms = norm->vector.startEditing();
-    int32_t* index = faceset->coordIndex.startEditing();
-    int32_t* parts = faceset->partIndex.startEditing();
-
-    // preset the normal vector with null vector
-    for (int i = 0; i < numNorms; i++) {
-        norms[i] = SbVec3f(0.0, 0.0, 0.0);
-    }
-
-    int ii = 0, faceNodeOffset = 0, faceTriaOffset = 0;
-    for (int i = 1; i <= faceMap.Extent(); i++, ii++) {
-        TopLoc_Location aLoc;
-        const TopoDS_Face& actFace = TopoDS::Face(faceMap(i));
-        // get the mesh of the shape
-        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(actFace, aLoc);
-        if (mesh.IsNull()) {
-            mesh = Part::Tools::triangulationOfFace(actFace);
-        }
+    SbVec3f* verts = geometry.points.data();
+    SbVec3f* norms = geometry.normals.data();
+    int32_t* index = geometry.faceIndices.data();
+    int32_t* parts = geometry.partIndices.data();
+
+    // Fill in the triangles, normals and points of the faces in parallel. Each
+    // face writes to its own range of the arrays.
+    std::vector<int> faceIndices(faceMap.Extent());
+    std::iota(faceIndices.begin(), faceIndices.end(), 0);
+    QtConcurrent::blockingMap(faceIndices, [&](int ii) {
+        const FaceMesh& faceMesh = faceMeshes[ii];
+        const TopoDS_Face& actFace = TopoDS::Face(faceMap(ii + 1));
+        const Handle(Poly_Triangulation)& mesh = faceMesh.mesh;
         if (mesh.IsNull()) {
             parts[ii] = 0;
-            continue;
+            return;
         }
+        const int faceNodeOffset = faceMesh.nodeOffset;
+        const int faceTriaOffset = faceMesh.triaOffset;
 
         // getting the transformation of the shape/face
         gp_Trsf myTransf;
         Standard_Boolean identity = true;
-        if (!aLoc.IsIdentity()) {
+        if (!faceMesh.location.IsIdentity()) {
             identity = false;
-            myTransf = aLoc.Transformation();
+            myTransf = faceMesh.location.Transformation();
         }
 
-        // getting size of node and triangle array of this face
-        int nbNodesInFace = mesh->NbNodes();
+        // getting size of triangle array of this face
         int nbTriInFace = mesh->NbTriangles();
         // check orientation
         TopAbs_Orientation orient = actFace.Orientation();
@@ -1185,8 +1320,26 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
         }
 
         parts[ii] = nbTriInFace;  // new part
+    });
+
+    // Handle the edges lying on the faces in order, an edge shared by several
+    // faces takes the points of the first one.
+    for (int ii = 0; ii < faceMap.Extent(); ii++) {
+        const FaceMesh& faceMesh = faceMeshes[ii];
+        const TopoDS_Face& actFace = TopoDS::Face(faceMap(ii + 1));
+        const Handle(Poly_Triangulation)& mesh = faceMesh.mesh;
+        if (mesh.IsNull()) {
+            continue;
+        }
+        const int faceNodeOffset = faceMesh.nodeOffset;
+
+        gp_Trsf myTransf;
+        Standard_Boolean identity = true;
+        if (!faceMesh.location.IsIdentity()) {
+            identity = false;
+            myTransf = faceMesh.location.Transformation();
+        }
 
-        // handling the edges lying on this face
         TopExp_Explorer Exp;
         for (Exp.Init(actFace, TopAbs_EDGE); Exp.More(); Exp.Next()) {
             const TopoDS_Edge& curEdge = TopoDS::Edge(Exp.Current());
@@ -1198,7 +1351,7 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
 
                 // this holds the indices of the edge's triangulation to the current polygon
                 Handle(Poly_PolygonOnTriangulation) aPoly =
-                    BRep_Tool::PolygonOnTriangulation(curEdge, mesh, aLoc);
+                    BRep_Tool::PolygonOnTriangulation(curEdge, mesh, faceMesh.location);
                 if (aPoly.IsNull()) {
                     continue;  // polygon does not exist
                 }
@@ -1216,7 +1369,7 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
                     // but not by any triangle. Thus, we must apply the coordinates to
                     // make sure that everything is properly set.
 #if OCC_VERSION_HEX < 0x070600
-                    gp_Pnt p(Nodes(nodeIndex));
+                    gp_Pnt p(mesh->Nodes()(nodeIndex));
 #else
                     gp_Pnt p(mesh->Node(nodeIndex));
 #endif
@@ -1232,10 +1385,14 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
         }
 
         edgeVector.push_back(-1);
+    }
 
-        // counting up the per Face offsets
-        faceNodeOffset += nbNodesInFace;
-        faceTriaOffset += nbTriInFace;
+    // the points of the free edges and vertices follow the ones of the faces
+    int faceNodeOffset = 0;
+    for (const auto& faceMesh : faceMeshes) {
+        if (!faceMesh.mesh.IsNull()) {
+            faceNodeOffset = faceMesh.nodeOffset + faceMesh.mesh->NbNodes();
+        }
     }
 
     // handling of the free edges
@@ -1274,7 +1431,7 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
         }
     }
 
-    nodeset->startIndex.setValue(faceNodeOffset);
+    geometry.pointStart = faceNodeOffset;
     for (int i = 0; i < vertexMap.Extent(); i++) {
         const TopoDS_Vertex& aVertex = TopoDS::Vertex(vertexMap(i + 1));
         gp_Pnt pnt = BRep_Tool::Pnt(aVertex);
@@ -1287,33 +1444,19 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
         norms[i].normalize();
     }
 
-    std::vector<int32_t> lineSetCoords;
+    std::vector<int32_t>& lineSetCoords = geometry.lineIndices;
     for (const auto& it : lineSetMap) {
         lineSetCoords.insert(lineSetCoords.end(), it.second.begin(), it.second.end());
         lineSetCoords.push_back(-1);
     }
-
-    // preset the index vector size
     numLines = lineSetCoords.size();
-    lineset->coordIndex.setNum(numLines);
-    int32_t* lines = lineset->coordIndex.startEditing();
-
-    int l = 0;
-    for (auto it = lineSetCoords.begin(); it != lineSetCoords.end(); ++it, l++) {
-        lines[l] = *it;
-    }
-
-    // end the editing of the nodes
-    coords->point.finishEditing();
-    norm->vector.finishEditing();
-    faceset->coordIndex.finishEditing();
-    faceset->partIndex.finishEditing();
-    lineset->coordIndex.finishEditing();
 
 #   ifdef FC_DEBUG
     Base::Console().log("ViewProvider update time: %f s\n",Base::TimeElapsed::diffTimeF(startTime,Base::TimeElapsed()));
     Base::Console().log("Shape mesh info: Faces:%d Edges:%d Nodes:%d Triangles:%d IdxVec:%d\n",numFaces,numEdges,numNodes,numTriangles,numLines);
 #   endif
+
+    return geometry;
 }
 
 void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
@@ -1334,9 +1477,97 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
 }
 
 void ViewProviderPartExt::updateVisual()
+{
+    // a tessellation still running is outdated now
+    const unsigned int generation = ++*visualGeneration;
+
+    // While a document is opened the visible objects are tessellated in parallel, so that the
+    // tree and the hidden objects don't wait for them. Their Visibility is restored while
+    // they are hidden still.
+    const bool restoring = isRestoring() && Visibility.getValue();
+    const bool async = AsyncTessellation || (AsyncTessellationOnLoad && restoring);
+    if (async && (isShow() || restoring) && !isUpdateForced()) {
+        try {
+            startTessellation(getRenderedShape().getShape(), generation);
+            // the shown geometry is kept until the new one is ready
+            VisualTouched = false;
+            return;
+        }
+        catch (...) {
+            // report the error with a synchronous update
+        }
+    }
+
+    try {
+        CoinGeometry geometry = computeCoinGeometry(getRenderedShape().getShape(),
+                                                    getTessellationDeviation(),
+                                                    AngularDeflection.getValue(),
+                                                    NormalsFromUV);
+        applyVisual(&geometry);
+    }
+    catch (const Standard_Failure& e) {
+        FC_ERR("Cannot compute Inventor representation for the shape of "
+               << pcObject->getFullName() << ": " << e.GetMessageString());
+        applyVisual(nullptr);
+    }
+    catch (...) {
+        FC_ERR("Cannot compute Inventor representation for the shape of "
+               << pcObject->getFullName());
+        applyVisual(nullptr);
+    }
+}
+
+void ViewProviderPartExt::startTessellation(const TopoDS_Shape& shape, unsigned int generation)
+{
+    // The job must not access the view provider, which may be deleted before it ends
+    auto current = visualGeneration;
+    const double deviation = getTessellationDeviation();
+    const double angularDeflection = AngularDeflection.getValue();
+    const bool normalsFromUV = NormalsFromUV;
+    const std::string name = pcObject->getFullName();
+
+    QFuture<std::shared_ptr<CoinGeometry>> future = QtConcurrent::run([=]() {
+        std::shared_ptr<CoinGeometry> geometry;
+        // skip jobs that became outdated while waiting in the pool
+        if (*current != generation) {
+            return geometry;
+        }
+        try {
+            geometry = std::make_shared<CoinGeometry>(
+                computeCoinGeometry(shape, deviation, angularDeflection, normalsFromUV));
+        }
+        catch (const Standard_Failure& e) {
+            FC_ERR("Cannot compute Inventor representation for the shape of " << name << ": "
+                                                                              << e.GetMessageString());
+        }
+        catch (...) {
+            FC_ERR("Cannot compute Inventor representation for the shape of " << name);
+        }
+        return geometry;
+    });
+
+    // replacing the watcher drops the result of an outdated job
+    tessellationWatcher = std::make_unique<QFutureWatcher<std::shared_ptr<CoinGeometry>>>();
+    auto watcher = tessellationWatcher.get();
+    QObject::connect(watcher, &QFutureWatcherBase::finished, watcher, [this, watcher, generation]() {
+        if (*visualGeneration != generation) {
+            return;
+        }
+        auto geometry = watcher->result();
+        if (!geometry) {
+            VisualTouched = true;
+        }
+        applyVisual(geometry.get());
+    });
+    watcher->setFuture(future);
+}
+
+void ViewProviderPartExt::applyVisual(const CoinGeometry* geometry)
 {
     Gui::SoUpdateVBOAction action;
     action.apply(this->faceset);
+    action.apply(this->lineset);
+    action.apply(this->nodeset);
 
     // Clear selection
     Gui::SoSelectionElementAction saction(Gui::SoSelectionElementAction::None);
@@ -1350,28 +1581,15 @@ void ViewProviderPartExt::updateVisual()
     haction.apply(this->lineset);
     haction.apply(this->nodeset);
 
-    try {
-        TopoDS_Shape cShape = getRenderedShape().getShape();
-
-        setupCoinGeometry(cShape,
-                          coords,
-                          faceset,
-                          norm,
-                          lineset,
-                          nodeset,
-                          Deviation.getValue(),
-                          AngularDeflection.getValue(),
-                          NormalsFromUV);
-
+    if (geometry) {
+        applyCoinGeometry(*geometry, coords, faceset, norm, lineset, nodeset);
         VisualTouched = false;
-    }
-    catch (const Standard_Failure& e) {
-        FC_ERR("Cannot compute Inventor representation for the shape of "
-               << pcObject->getFullName() << ": " << e.GetMessageString());
-    }
-    catch (...) {
-        FC_ERR("Cannot compute Inventor representation for the shape of "
-               << pcObject->getFullName());
+        if (pcLODCallback && !lodFine) {
+            lodBox.makeEmpty();
+            for (const auto& point : geometry->points) {
+                lodBox.extendBy(point);
+            }
+        }
     }
 
     // The material has to be checked again
@@ -1380,6 +1598,47 @@ void ViewProviderPartExt::updateVisual()
     setHighlightedPoints(PointColorArray.getValue());
 }
 
+double ViewProviderPartExt::getTessellationDeviation() const
+{
+    if (LevelOfDetail && !lodFine) {
+        return Deviation.getValue() * LODCoarseFactor;
+    }
+    return Deviation.getValue();
+}
+
+void ViewProviderPartExt::lodCallback(void* data, SoAction* action)
+{
+    if (!action->isOfType(SoGLRenderAction::getClassTypeId())) {
+        return;
+    }
+    auto self = static_cast<ViewProviderPartExt*>(data);
+    if (self->lodFine || self->lodBox.isEmpty() || self->lodSensor->isScheduled()) {
+        return;
+    }
+
+    SoState* state = action->getState();
+    SbBox3f box = self->lodBox;
+    box.transform(SoModelMatrixElement::get(state));
+    SbVec2f size = SoViewVolumeElement::get(state).projectBox(box);
+    if (std::max(size[0], size[1]) >= self->LODFineSize) {
+        // the scene graph must not be changed while it is rendered
+        self->lodSensor->schedule();
+    }
+}
+
+void ViewProviderPartExt::lodSensorCallback(void* data, SoSensor* sensor)
+{
+    (void)sensor;
+    auto self = static_cast<ViewProviderPartExt*>(data);
+    self->lodFine = true;
+    // the callback disables render caching, so it is removed once not needed
+    int index = self->pcRoot->findChild(self->pcLODCallback);
+    if (index >= 0) {
+        self->pcRoot->removeChild(index);
+    }
+    self->updateVisual();
+}
+
 void ViewProviderPartExt::forceUpdate(bool enable) {
     if(enable) {
         if(++forceUpdateCount == 1) {
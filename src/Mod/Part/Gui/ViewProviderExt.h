@@ -26,7 +26,14 @@
 #include "SoFCShapeObject.h"
 
 
+#include <atomic>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <vector>
+
+#include <Inventor/SbBox3f.h>
+#include <Inventor/SbVec3f.h>
 
 #include <App/PropertyUnits.h>
 #include <Gui/ViewProviderGeometryObject.h>
@@ -36,6 +43,12 @@
 #include <Mod/Part/PartGlobal.h>
 
 
+template<typename T>
+class QFutureWatcher;
+class SoAction;
+class SoCallback;
+class SoOneShotSensor;
+class SoSensor;
 class TopoDS_Shape;
 class TopoDS_Edge;
 class TopoDS_Wire;
@@ -183,6 +196,28 @@ public:
                                   double angularDeflection,
                                   bool normalsFromUV = false);
 
+    /// tessellation of a toposhape, ready to be set to the Coin nodes
+    struct CoinGeometry
+    {
+        std::vector<SbVec3f> points;
+        std::vector<SbVec3f> normals;
+        std::vector<int32_t> faceIndices;
+        std::vector<int32_t> partIndices;
+        std::vector<int32_t> lineIndices;
+        int pointStart = 0;
+    };
+    /// tessellates the toposhape, does not touch any Coin node and may run in any thread
+    static CoinGeometry computeCoinGeometry(TopoDS_Shape shape,
+                                            double deviation,
+                                            double angularDeflection,
+                                            bool normalsFromUV = false);
+    static void applyCoinGeometry(const CoinGeometry& geometry,
+                                  SoCoordinate3* coords,
+                                  SoBrepFaceSet* faceset,
+                                  SoNormal* norm,
+                                  SoBrepEdgeSet* lineset,
+                                  SoBrepPointSet* nodeset);
+
 protected:
     bool setEdit(int ModNum) override;
     void unsetEdit(int ModNum) override;
@@ -216,9 +251,43 @@ protected:
 
     bool VisualTouched;
     bool NormalsFromUV;
+    bool AsyncTessellation = false;
+    // tessellates the visible objects of a document being opened in the background
+    bool AsyncTessellationOnLoad = true;
     bool faceHighlightActive = false;
 
+    /** @name Level of detail
+     * With the Mod/Part/LevelOfDetail preference, a shape is first tessellated
+     * with a deviation LODCoarseFactor times larger than Deviation. The fine
+     * tessellation is only built once the shape covers LODFineSize of the view.
+     */
+    //@{
+    bool LevelOfDetail = false;
+    double LODCoarseFactor = 4.0;
+    double LODFineSize = 0.25;
+    bool lodFine = false;
+    //@}
+
 private:
+    /// tessellates the shape on a worker thread and applies it once done
+    void startTessellation(const TopoDS_Shape& shape, unsigned int generation);
+    /// sets the geometry, if any, to the Coin nodes and refreshes selection and colors
+    void applyVisual(const CoinGeometry* geometry);
+    /// the deviation of the tessellation, depending on the level of detail
+    double getTessellationDeviation() const;
+    static void lodCallback(void* data, SoAction* action);
+    static void lodSensorCallback(void* data, SoSensor* sensor);
+
+    // checks the projected size of the shape while it is coarse
+    SoCallback* pcLODCallback {nullptr};
+    std::unique_ptr<SoOneShotSensor> lodSensor;
+    SbBox3f lodBox;
+
+    // Incremented on each visual update, so that the result of an outdated
+    // tessellation is discarded. Shared with the running jobs.
+    std::shared_ptr<std::atomic<unsigned int>> visualGeneration;
+    std::unique_ptr<QFutureWatcher<std::shared_ptr<CoinGeometry>>> tessellationWatcher;
+
     Gui::ViewProviderFaceTexture texture;
     // settings stuff
     int forceUpdateCount;
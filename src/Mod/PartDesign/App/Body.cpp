@@ -397,17 +397,28 @@ App::DocumentObjectExecReturn *Body::execute()
         }
 
         // get the shape of the tip
-        tipShape = static_cast<Part::Feature *>(tip)->Shape.getShape();
+        const Part::TopoShape& source = static_cast<Part::Feature *>(tip)->Shape.getShape();
 
-        if ( tipShape.getShape().IsNull () ) {
+        if ( source.getShape().IsNull () ) {
             return new App::DocumentObjectExecReturn (QT_TRANSLATE_NOOP("Exception", "Tip shape is empty" ));
         }
 
-        // We should hide here the transformation of the baseFeature
-        tipShape.transformShape (tipShape.getTransform(), true );
+        // We should hide here the transformation of the baseFeature, which copies the whole
+        // shape, so it is skipped if the tip still has the shape of the last time
+        if (tip != lastTip || !lastTipShape.IsEqual(source.getShape())) {
+            Part::TopoShape shape(source);
+            shape.transformShape (shape.getTransform(), true );
+            lastTip = tip;
+            lastTipShape = source.getShape();
+            lastShape = shape;
+        }
+        tipShape = lastShape;
 
     } else {
         tipShape = Part::TopoShape();
+        lastTip = nullptr;
+        lastTipShape.Nullify();
+        lastShape = Part::TopoShape();
     }
 
     Shape.setValue ( tipShape );
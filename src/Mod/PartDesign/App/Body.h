@@ -154,6 +154,11 @@ protected:
 private:
     boost::signals2::scoped_connection connection;
     bool showTip = false;
+    // the tip and its shape the last shape of the body was made of, the shape is only made again
+    // when the tip gets a new shape
+    App::DocumentObject* lastTip = nullptr;
+    TopoDS_Shape lastTipShape;
+    Part::TopoShape lastShape;
 };
 
 } //namespace PartDesign
@@ -143,6 +143,16 @@ App::DocumentObjectExecReturn *Chamfer::execute()
     if ( static_cast<Part::ChamferType>(chamferType) == Part::ChamferType::distanceAngle ) {
         size2 = angle;
     }
+    auto make = [=](const TopoShape& base,
+                    const std::vector<TopoShape>& trialEdges,
+                    const std::vector<int>&) {
+        return base.makeElementChamfer(trialEdges,
+                                       static_cast<Part::ChamferType>(chamferType),
+                                       size,
+                                       size2,
+                                       nullptr,
+                                       flipDirection ? Part::Flip::flip : Part::Flip::none);
+    };
     try {
         TopoShape shape(0);
         shape.makeElementChamfer(TopShape,
@@ -153,8 +163,10 @@ App::DocumentObjectExecReturn *Chamfer::execute()
                                  nullptr,
                                  flipDirection ? Part::Flip::flip : Part::Flip::none);
         if (shape.isNull()) {
-            return new App::DocumentObjectExecReturn(
-                QT_TRANSLATE_NOOP("Exception", "Failed to create chamfer"));
+            return failedEdges(TopShape,
+                               edges,
+                               make,
+                               QT_TRANSLATE_NOOP("Exception", "Failed to create chamfer"));
         }
 
         TopTools_ListOfShape aLarg;
@@ -179,7 +191,7 @@ App::DocumentObjectExecReturn *Chamfer::execute()
         return App::DocumentObject::StdReturn;
     }
     catch (Standard_Failure& e) {
-        return new App::DocumentObjectExecReturn(e.GetMessageString());
+        return failedEdges(TopShape, edges, make, e.GetMessageString());
     }
 }
 
@@ -175,6 +175,28 @@ void DressUp::getContinuousEdges(Part::TopoShape TopShape, std::vector< std::str
     }
 }
 
+App::DocumentObjectExecReturn* DressUp::failedEdges(const TopoShape& shape,
+                                                    const std::vector<TopoShape>& edges,
+                                                    const TopoShape::EdgeOperation& make,
+                                                    const char* message)
+{
+    std::vector<int> failed;
+    try {
+        failed = shape.findFailingEdges(edges, make);
+    }
+    catch (Base::Exception& e) {
+        e.reportException();
+    }
+    if (failed.empty()) {
+        return new App::DocumentObjectExecReturn(message);
+    }
+    std::string msg("Failed on edges:");
+    for (int i : failed) {
+        msg += " Edge" + std::to_string(shape.findShape(edges[i].getShape()));
+    }
+    return new App::DocumentObjectExecReturn(msg);
+}
+
 std::vector<TopoShape> DressUp::getContinuousEdges(const TopoShape& shape)
 {
     std::vector<TopoShape> ret;
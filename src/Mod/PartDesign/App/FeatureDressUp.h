@@ -69,6 +69,13 @@ public:
 
 protected:
     void onChanged(const App::Property* prop) override;
+
+    /// The error of a fillet or chamfer of \a edges of \a shape, which names the edges it fails
+    /// on, or is \a message if the edges fail only together
+    static App::DocumentObjectExecReturn* failedEdges(const TopoShape& shape,
+                                                      const std::vector<TopoShape>& edges,
+                                                      const TopoShape::EdgeOperation& make,
+                                                      const char* message);
 };
 
 } //namespace PartDesign
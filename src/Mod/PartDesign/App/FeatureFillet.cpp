@@ -94,12 +94,20 @@ App::DocumentObjectExecReturn *Fillet::execute()
 
     this->positionByBaseFeature();
 
+    const double radius = Radius.getValue();
+    auto make = [radius](const TopoShape& base,
+                         const std::vector<TopoShape>& trialEdges,
+                         const std::vector<int>&) {
+        return base.makeElementFillet(trialEdges, radius, radius);
+    };
     try {
         TopoShape shape(0);  //,getDocument()->getStringHasher());
-        shape.makeElementFillet(baseShape, edges, Radius.getValue(), Radius.getValue());
+        shape.makeElementFillet(baseShape, edges, radius, radius);
         if (shape.isNull()) {
-            return new App::DocumentObjectExecReturn(
-                QT_TRANSLATE_NOOP("Exception", "Resulting shape is null"));
+            return failedEdges(baseShape,
+                               edges,
+                               make,
+                               QT_TRANSLATE_NOOP("Exception", "Resulting shape is null"));
         }
 
         TopTools_ListOfShape aLarg;
@@ -124,7 +132,7 @@ App::DocumentObjectExecReturn *Fillet::execute()
         return App::DocumentObject::StdReturn;
     }
     catch (Standard_Failure& e) {
-        return new App::DocumentObjectExecReturn(e.GetMessageString());
+        return failedEdges(baseShape, edges, make, e.GetMessageString());
     }
 }
 
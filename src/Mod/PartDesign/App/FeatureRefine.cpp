@@ -87,6 +87,26 @@ TopoShape FeatureRefine::refineShapeIfActive(const TopoShape& oldShape,
     }
     TopoShape shape(oldShape);
     try {
+        // A refined base doesn't need to be refined again, so by default only the faces that the
+        // feature touched are merged
+        Base::Reference<ParameterGrp> hGrp = App::GetApplication()
+                                                 .GetUserParameter()
+                                                 .GetGroup("BaseApp")
+                                                 ->GetGroup("Preferences")
+                                                 ->GetGroup("Mod/PartDesign");
+        if (hGrp->GetBool("RefineTouchedFacesOnly", true)) {
+            auto base = dynamic_cast<const FeatureRefine*>(getBaseObject(/*silent*/ true));
+            if (base && base->Refine.getValue()) {
+                TopoShape baseShape = getBaseTopoShape(/*silent*/ true);
+                if (!baseShape.isNull()) {
+                    return TopoShape(shape.Tag, shape.Hasher)
+                        .makeElementRefine(shape,
+                                           nullptr,
+                                           Part::RefineFail::throwException,
+                                           &baseShape);
+                }
+            }
+        }
         return shape.makeElementRefine();
     }
     catch (Standard_Failure& err) {
@@ -23,6 +23,8 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <Bnd_Box.hxx>
+#include <Bnd_BoundSortBox.hxx>
+#include <Bnd_HArray1OfBox.hxx>
 #include <BRep_Builder.hxx>
 #include <Mod/Part/App/FCBRepAlgoAPI_Cut.h>
 #include <Mod/Part/App/FCBRepAlgoAPI_Fuse.h>
@@ -62,6 +64,69 @@ extern bool getPDRefineModelParameter();
 
 PROPERTY_SOURCE(PartDesign::Transformed, PartDesign::FeatureRefine)
 
+namespace
+{
+
+// The transformed instances of an original and their bounding boxes
+struct PatternTools
+{
+    bool fuse = true;
+    std::vector<TopoShape> shapes;
+    std::vector<Bnd_Box> boxes;
+};
+
+// Union and difference commute as long as an additive instance doesn't overlap a subtractive
+// instance of an earlier original, then all additive instances can be fused at once and all
+// subtractive ones be cut afterwards.
+bool canCombineBooleans(const std::vector<PatternTools>& tools)
+{
+    std::size_t count = 0;
+    Bnd_Box complete;
+    for (const auto& it : tools) {
+        if (!it.fuse) {
+            count += it.boxes.size();
+            for (const auto& box : it.boxes) {
+                complete.Add(box);
+            }
+        }
+    }
+    if (count == 0 || complete.IsVoid()) {
+        return true;
+    }
+
+    // a tree of the boxes of the subtractive instances
+    Handle(Bnd_HArray1OfBox) boxes = new Bnd_HArray1OfBox(1, int(count));
+    std::vector<std::size_t> owner;
+    owner.reserve(count);
+    for (std::size_t k = 0; k < tools.size(); k++) {
+        if (!tools[k].fuse) {
+            for (const auto& box : tools[k].boxes) {
+                owner.push_back(k);
+                boxes->SetValue(int(owner.size()), box);
+            }
+        }
+    }
+    Bnd_BoundSortBox tree;
+    tree.Initialize(complete, boxes);
+
+    for (std::size_t k = 0; k < tools.size(); k++) {
+        if (!tools[k].fuse) {
+            continue;
+        }
+        for (const auto& box : tools[k].boxes) {
+            for (int index : tree.Compare(box)) {
+                if (owner[index - 1] < k) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+}  // namespace
+
 std::array<char const*, 3> transformModeEnums = {"Features",
                                                  "Whole shape",
                                                  nullptr};
@@ -74,6 +139,13 @@ Transformed::Transformed()
 
     ADD_PROPERTY(TransformMode, (static_cast<long>(Mode::Features)));
     TransformMode.setEnums(transformModeEnums.data());
+
+    ADD_PROPERTY_TYPE(CombineBooleans,
+                      (false),
+                      "Transformed",
+                      App::Prop_None,
+                      "Fuse and cut the instances of all originals at once if no additive instance "
+                      "overlaps a subtractive instance of an earlier original");
 }
 
 void Transformed::positionBySupport()
@@ -350,13 +422,14 @@ App::DocumentObjectExecReturn* Transformed::execute()
     };
 
     switch (mode) {
-        case Mode::Features:
+        case Mode::Features: {
             // NOTE: It would be possible to build a compound from all original addShapes/subShapes
             // and then transform the compounds as a whole. But we choose to apply the
             // transformations to each Original separately. This way it is easier to discover what
             // feature causes a fuse/cut to fail. The downside is that performance suffers when
             // there are many originals. But it seems safe to assume that in most cases there are
             // few originals and many transformations
+            std::vector<PatternTools> tools;
             for (auto original : originals) {
                 // Extract the original shape and determine whether to cut or to fuse
                 Part::TopoShape fuseShape;
@@ -376,28 +449,63 @@ App::DocumentObjectExecReturn* Transformed::execute()
                                           "Shape of additive/subtractive feature is empty"));
                 }
                 gp_Trsf trsf = feature->getLocation().Transformation().Multiplied(trsfInv);
-                if (!fuseShape.isNull()) {
-                    fuseShape = fuseShape.makeElementTransform(trsf);
-                }
-                if (!cutShape.isNull()) {
-                    cutShape = cutShape.makeElementTransform(trsf);
-                }
-                if (!fuseShape.isNull()) {
-                    auto shapes = getTransformedCompShape(supportShape, fuseShape);
-                    if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
-                        return new App::DocumentObjectExecReturn("User aborted");
+                for (bool fuse : {true, false}) {
+                    Part::TopoShape& shape = fuse ? fuseShape : cutShape;
+                    if (shape.isNull()) {
+                        continue;
                     }
-                    supportShape.makeElementFuse(shapes);
-                }
-                if (!cutShape.isNull()) {
-                    auto shapes = getTransformedCompShape(supportShape, cutShape);
+                    shape = shape.makeElementTransform(trsf);
+                    PatternTools tool;
+                    tool.fuse = fuse;
+                    tool.shapes = getTransformedCompShape(supportShape, shape);
                     if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
                         return new App::DocumentObjectExecReturn("User aborted");
                     }
-                    supportShape.makeElementCut(shapes);
+                    if (CombineBooleans.getValue()) {
+                        // the boxes of the instances are the transformed box of the original
+                        Bnd_Box box;
+                        BRepBndLib::Add(shape.getShape(), box);
+                        box.Enlarge(Precision::Confusion());
+                        for (auto it = std::next(transformations.cbegin());
+                             it != transformations.cend();
+                             ++it) {
+                            tool.boxes.push_back(box.Transformed(*it));
+                        }
+                    }
+                    tools.push_back(std::move(tool));
+                }
+            }
+
+            if (CombineBooleans.getValue() && tools.size() > 1 && canCombineBooleans(tools)) {
+                std::vector<TopoShape> fuseShapes;
+                std::vector<TopoShape> cutShapes;
+                for (const auto& tool : tools) {
+                    auto& shapes = tool.fuse ? fuseShapes : cutShapes;
+                    shapes.insert(shapes.end(), std::next(tool.shapes.begin()), tool.shapes.end());
+                }
+                if (!fuseShapes.empty()) {
+                    fuseShapes.insert(fuseShapes.begin(), supportShape);
+                    supportShape.makeElementFuse(fuseShapes);
+                }
+                if (!cutShapes.empty()) {
+                    cutShapes.insert(cutShapes.begin(), supportShape);
+                    supportShape.makeElementCut(cutShapes);
+                }
+                break;
+            }
+
+            // one boolean for each original in their order
+            for (auto& tool : tools) {
+                tool.shapes.front() = supportShape;
+                if (tool.fuse) {
+                    supportShape.makeElementFuse(tool.shapes);
+                }
+                else {
+                    supportShape.makeElementCut(tool.shapes);
                 }
             }
             break;
+        }
         case Mode::WholeShape: {
             auto shapes = getTransformedCompShape(supportShape, supportShape);
             if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
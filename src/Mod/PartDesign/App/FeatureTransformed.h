@@ -55,6 +55,7 @@ public:
     App::PropertyLinkList Originals;
     App::PropertyEnumeration TransformMode;
     App::PropertyBool Refine;
+    App::PropertyBool CombineBooleans;
 
     /**
      * Returns the BaseFeature property's object(if any) otherwise return first original,
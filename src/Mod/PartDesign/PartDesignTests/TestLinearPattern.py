@@ -167,6 +167,41 @@ class TestLinearPattern(unittest.TestCase):
         # self.assertEqual(len(self.LinearPattern.Shape.ElementReverseMap), 170)
         self.assertEqual(self.LinearPattern.Shape.ElementMapSize, 26)
 
+    def testCombineBooleans(self):
+        self.Body = self.Doc.addObject('PartDesign::Body','Body')
+        self.Box = self.Doc.addObject('PartDesign::AdditiveBox','Box')
+        self.Body.addObject(self.Box)
+        self.Box.Length=100.00
+        self.Box.Width=10.00
+        self.Box.Height=10.00
+        self.Boss = self.Doc.addObject('PartDesign::AdditiveBox','Boss')
+        self.Body.addObject(self.Boss)
+        self.Boss.Length=2.00
+        self.Boss.Width=2.00
+        self.Boss.Height=2.00
+        self.Boss.Placement = FreeCAD.Placement(FreeCAD.Vector(0,0,10), FreeCAD.Rotation())
+        self.Hole = self.Doc.addObject('PartDesign::SubtractiveBox','Hole')
+        self.Body.addObject(self.Hole)
+        self.Hole.Length=2.00
+        self.Hole.Width=2.00
+        self.Hole.Height=20.00
+        self.Hole.Placement = FreeCAD.Placement(FreeCAD.Vector(5,4,-5), FreeCAD.Rotation())
+        self.Doc.recompute()
+        self.LinearPattern = self.Doc.addObject("PartDesign::LinearPattern","LinearPattern")
+        self.LinearPattern.Originals = [self.Boss, self.Hole]
+        self.LinearPattern.Direction = (self.Doc.X_Axis,[""])
+        self.LinearPattern.Length = 90.0
+        self.LinearPattern.Occurrences = 10
+        self.Body.addObject(self.LinearPattern)
+        self.Doc.recompute()
+        volume = self.LinearPattern.Shape.Volume
+        self.assertAlmostEqual(volume, 1e4 + 10 * 8 - 10 * 40)
+        # the bosses and holes don't overlap, so they are fused and cut at once
+        self.LinearPattern.CombineBooleans = True
+        self.Doc.recompute()
+        self.assertAlmostEqual(self.LinearPattern.Shape.Volume, volume)
+        self.assertEqual(len(self.LinearPattern.Shape.Solids), 1)
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("PartDesignTestLinearPattern")
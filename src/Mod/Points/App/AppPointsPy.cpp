@@ -71,6 +71,18 @@ private:
 
         return std::make_tuple(useColor, checkState, minDistance);
     }
+    ReaderFilter readFilterSettings() const
+    {
+        Base::Reference<ParameterGrp> hGrp = App::GetApplication()
+                                                 .GetUserParameter()
+                                                 .GetGroup("BaseApp")
+                                                 ->GetGroup("Preferences")
+                                                 ->GetGroup("Mod/Points/Import");
+        ReaderFilter filter;
+        filter.setVoxelSize(hGrp->GetFloat("VoxelSize", 0.0));
+        filter.setSampleRatio(hGrp->GetFloat("SampleRatio", 1.0));
+        return filter;
+    }
     Py::Object open(const Py::Tuple& args)
     {
         char* Name {};
@@ -109,6 +121,7 @@ private:
                 throw Py::RuntimeError("Unsupported file extension");
             }
 
+            reader->setFilter(readFilterSettings());
             reader->read(EncodedName);
 
             App::Document* pcDoc = App::GetApplication().newDocument();
@@ -231,6 +244,7 @@ private:
                 throw Py::RuntimeError("Unsupported file extension");
             }
 
+            reader->setFilter(readFilterSettings());
             reader->read(EncodedName);
 
             App::Document* pcDoc = App::GetApplication().getDocument(DocName);
@@ -0,0 +1,379 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Base/Exception.h>
+
+#include "PointCloud.h"
+#include "Points.h"
+
+#ifdef _MSC_VER
+#include <ppl.h>
+#endif
+
+using namespace Points;
+
+namespace
+{
+
+constexpr std::size_t chunkSize = 16384;
+
+// Runs func(first, last) on chunks of chunkSize of the range [0, size), in parallel for big clouds
+template<typename Func>
+void forEachChunk(std::size_t size, Func&& func)
+{
+    if (size <= chunkSize) {
+        func(std::size_t(0), size);
+        return;
+    }
+
+    std::vector<std::size_t> chunks;
+    for (std::size_t i = 0; i < size; i += chunkSize) {
+        chunks.push_back(i);
+    }
+    auto process = [&func, size](std::size_t first) {
+        func(first, std::min(first + chunkSize, size));
+    };
+#ifdef _MSC_VER
+    Concurrency::parallel_for_each(chunks.begin(), chunks.end(), process);
+#else
+    QtConcurrent::blockingMap(chunks, process);
+#endif
+}
+
+template<typename T>
+void compact(std::vector<T>& values, const std::vector<bool>& keep)
+{
+    if (values.empty()) {
+        return;
+    }
+    std::size_t num = 0;
+    for (std::size_t i = 0; i < values.size(); i++) {
+        if (keep[i]) {
+            values[num++] = values[i];
+        }
+    }
+    values.resize(num);
+}
+
+}  // namespace
+
+PointCloud::PointCloud(const PointKernel& kernel)
+{
+    setPoints(kernel.getBasicPoints());
+    Base::Matrix4D mat = kernel.getTransform();
+    if (mat != Base::Matrix4D()) {
+        transform(mat);
+    }
+}
+
+void PointCloud::clear()
+{
+    x.clear();
+    y.clear();
+    z.clear();
+    intensity.clear();
+    rgba.clear();
+    nx.clear();
+    ny.clear();
+    nz.clear();
+    channels = 0;
+}
+
+void PointCloud::resize(std::size_t num)
+{
+    x.resize(num);
+    y.resize(num);
+    z.resize(num);
+    if (hasChannel(Intensity)) {
+        intensity.resize(num);
+    }
+    if (hasChannel(Color)) {
+        rgba.resize(num, Base::Color().getPackedValue());
+    }
+    if (hasChannel(Normal)) {
+        nx.resize(num);
+        ny.resize(num);
+        nz.resize(num);
+    }
+}
+
+bool PointCloud::hasChannel(Channel channel) const
+{
+    return (channels & channel) != 0;
+}
+
+void PointCloud::addChannel(Channel channel)
+{
+    if (hasChannel(channel)) {
+        return;
+    }
+    channels |= channel;
+    switch (channel) {
+        case Intensity:
+            intensity.assign(size(), 0.0F);
+            break;
+        case Color:
+            rgba.assign(size(), Base::Color().getPackedValue());
+            break;
+        case Normal:
+            nx.assign(size(), 0.0F);
+            ny.assign(size(), 0.0F);
+            nz.assign(size(), 0.0F);
+            break;
+    }
+}
+
+void PointCloud::removeChannel(Channel channel)
+{
+    channels &= ~channel;
+    switch (channel) {
+        case Intensity:
+            std::vector<float>().swap(intensity);
+            break;
+        case Color:
+            std::vector<uint32_t>().swap(rgba);
+            break;
+        case Normal:
+            std::vector<float>().swap(nx);
+            std::vector<float>().swap(ny);
+            std::vector<float>().swap(nz);
+            break;
+    }
+}
+
+void PointCloud::setPoints(const std::vector<Base::Vector3f>& points)
+{
+    // the attributes don't belong to the new points
+    clear();
+    x.resize(points.size());
+    y.resize(points.size());
+    z.resize(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        x[i] = points[i].x;
+        y[i] = points[i].y;
+        z[i] = points[i].z;
+    }
+}
+
+std::vector<Base::Vector3f> PointCloud::getPoints() const
+{
+    std::vector<Base::Vector3f> points;
+    points.reserve(size());
+    for (std::size_t i = 0; i < size(); i++) {
+        points.emplace_back(x[i], y[i], z[i]);
+    }
+    return points;
+}
+
+void PointCloud::setIntensities(const std::vector<float>& values)
+{
+    if (values.size() != size()) {
+        throw Base::ValueError("Number of intensities doesn't match the number of points");
+    }
+    channels |= Intensity;
+    intensity = values;
+}
+
+std::vector<float> PointCloud::getIntensities() const
+{
+    return intensity;
+}
+
+void PointCloud::setColors(const std::vector<Base::Color>& colors)
+{
+    if (colors.size() != size()) {
+        throw Base::ValueError("Number of colors doesn't match the number of points");
+    }
+    channels |= Color;
+    rgba.resize(colors.size());
+    std::transform(colors.begin(), colors.end(), rgba.begin(), [](const Base::Color& col) {
+        return col.getPackedValue();
+    });
+}
+
+std::vector<Base::Color> PointCloud::getColors() const
+{
+    std::vector<Base::Color> colors;
+    colors.reserve(rgba.size());
+    for (uint32_t value : rgba) {
+        colors.emplace_back(value);
+    }
+    return colors;
+}
+
+void PointCloud::setNormals(const std::vector<Base::Vector3f>& normals)
+{
+    if (normals.size() != size()) {
+        throw Base::ValueError("Number of normals doesn't match the number of points");
+    }
+    channels |= Normal;
+    nx.resize(normals.size());
+    ny.resize(normals.size());
+    nz.resize(normals.size());
+    for (std::size_t i = 0; i < normals.size(); i++) {
+        nx[i] = normals[i].x;
+        ny[i] = normals[i].y;
+        nz[i] = normals[i].z;
+    }
+}
+
+std::vector<Base::Vector3f> PointCloud::getNormals() const
+{
+    std::vector<Base::Vector3f> normals;
+    normals.reserve(nx.size());
+    for (std::size_t i = 0; i < nx.size(); i++) {
+        normals.emplace_back(nx[i], ny[i], nz[i]);
+    }
+    return normals;
+}
+
+void PointCloud::toKernel(PointKernel& kernel) const
+{
+    std::vector<Base::Vector3f> points = getPoints();
+    kernel.setTransform(Base::Matrix4D());
+    kernel.swap(points);
+}
+
+void PointCloud::transform(const Base::Matrix4D& mat)
+{
+    // Same arithmetic as Matrix4D::multVec but on separate arrays that vectorize
+    auto points = [this, &mat](std::size_t first, std::size_t last) {
+        float* px = x.data();
+        float* py = y.data();
+        float* pz = z.data();
+        const double m00 = mat[0][0], m01 = mat[0][1], m02 = mat[0][2], m03 = mat[0][3];
+        const double m10 = mat[1][0], m11 = mat[1][1], m12 = mat[1][2], m13 = mat[1][3];
+        const double m20 = mat[2][0], m21 = mat[2][1], m22 = mat[2][2], m23 = mat[2][3];
+        for (std::size_t i = first; i < last; i++) {
+            double sx = static_cast<double>(px[i]);
+            double sy = static_cast<double>(py[i]);
+            double sz = static_cast<double>(pz[i]);
+            px[i] = static_cast<float>(m00 * sx + m01 * sy + m02 * sz + m03);
+            py[i] = static_cast<float>(m10 * sx + m11 * sy + m12 * sz + m13);
+            pz[i] = static_cast<float>(m20 * sx + m21 * sy + m22 * sz + m23);
+        }
+    };
+    forEachChunk(size(), points);
+
+    if (!hasChannel(Normal)) {
+        return;
+    }
+
+    // Like PropertyNormalList only rotate the normals, remove the scaling of each row
+    float rot[3][3];
+    for (int i = 0; i < 3; i++) {
+        double s = std::sqrt(mat[i][0] * mat[i][0] + mat[i][1] * mat[i][1] + mat[i][2] * mat[i][2]);
+        for (int j = 0; j < 3; j++) {
+            rot[i][j] = static_cast<float>(mat[i][j] / s);
+        }
+    }
+    auto normals = [this, &rot](std::size_t first, std::size_t last) {
+        float* px = nx.data();
+        float* py = ny.data();
+        float* pz = nz.data();
+        for (std::size_t i = first; i < last; i++) {
+            float sx = px[i];
+            float sy = py[i];
+            float sz = pz[i];
+            px[i] = rot[0][0] * sx + rot[0][1] * sy + rot[0][2] * sz;
+            py[i] = rot[1][0] * sx + rot[1][1] * sy + rot[1][2] * sz;
+            pz[i] = rot[2][0] * sx + rot[2][1] * sy + rot[2][2] * sz;
+        }
+    };
+    forEachChunk(size(), normals);
+}
+
+void PointCloud::move(const Base::Vector3f& offset)
+{
+    forEachChunk(size(), [this, offset](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            x[i] += offset.x;
+        }
+        for (std::size_t i = first; i < last; i++) {
+            y[i] += offset.y;
+        }
+        for (std::size_t i = first; i < last; i++) {
+            z[i] += offset.z;
+        }
+    });
+}
+
+Base::BoundBox3f PointCloud::getBoundBox() const
+{
+    // One box per chunk, the branch-free selects let the compiler vectorize the loop
+    std::vector<Base::BoundBox3f> boxes((size() + chunkSize - 1) / chunkSize);
+    forEachChunk(size(), [this, &boxes](std::size_t first, std::size_t last) {
+        const float* px = x.data();
+        const float* py = y.data();
+        const float* pz = z.data();
+        Base::BoundBox3f box;
+        for (std::size_t i = first; i < last; i++) {
+            float vx = px[i];
+            float vy = py[i];
+            float vz = pz[i];
+            // a comparison with NaN is false, skip the point if any coordinate is NaN
+            bool valid = (vx == vx) && (vy == vy) && (vz == vz);
+            box.MinX = valid && vx < box.MinX ? vx : box.MinX;
+            box.MinY = valid && vy < box.MinY ? vy : box.MinY;
+            box.MinZ = valid && vz < box.MinZ ? vz : box.MinZ;
+            box.MaxX = valid && vx > box.MaxX ? vx : box.MaxX;
+            box.MaxY = valid && vy > box.MaxY ? vy : box.MaxY;
+            box.MaxZ = valid && vz > box.MaxZ ? vz : box.MaxZ;
+        }
+        boxes[first / chunkSize] = box;
+    });
+
+    Base::BoundBox3f bnd;
+    for (const auto& box : boxes) {
+        bnd.Add(box);
+    }
+    return bnd;
+}
+
+void PointCloud::filter(const std::vector<bool>& keep)
+{
+    if (keep.size() != size()) {
+        throw Base::ValueError("Size of the filter doesn't match the number of points");
+    }
+    compact(x, keep);
+    compact(y, keep);
+    compact(z, keep);
+    compact(intensity, keep);
+    compact(rgba, keep);
+    compact(nx, keep);
+    compact(ny, keep);
+    compact(nz, keep);
+}
+
+void PointCloud::removeInvalid()
+{
+    std::vector<bool> keep(size());
+    for (std::size_t i = 0; i < size(); i++) {
+        keep[i] = !std::isnan(x[i]) && !std::isnan(y[i]) && !std::isnan(z[i]);
+    }
+    filter(keep);
+}
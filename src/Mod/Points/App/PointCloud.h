@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef POINTS_POINTCLOUD_H
+#define POINTS_POINTCLOUD_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Color.h>
+#include <Base/Matrix.h>
+#include <Base/Vector3D.h>
+
+#include <Mod/Points/PointsGlobal.h>
+
+namespace Points
+{
+
+class PointKernel;
+
+/*! A point cloud stored as structure of arrays.
+  Every coordinate and every attribute lives in its own contiguous array so that the operations
+  on the whole cloud run over plain arrays the compiler can vectorize. Unlike the Intensity,
+  Color and Normal properties of a points feature the attribute channels are kept in sync with
+  the points: a channel is either empty or has one entry per point.
+ */
+class PointsExport PointCloud
+{
+public:
+    /// The optional attribute channels
+    enum Channel
+    {
+        Intensity = 1,
+        Color = 2,
+        Normal = 4
+    };
+
+    PointCloud() = default;
+    /// Copies the points of the kernel with its transformation applied.
+    explicit PointCloud(const PointKernel& kernel);
+
+    std::size_t size() const
+    {
+        return x.size();
+    }
+    bool empty() const
+    {
+        return x.empty();
+    }
+    void clear();
+    /// Resizes the coordinates and all channels that are present.
+    void resize(std::size_t num);
+
+    /** @name Channels */
+    //@{
+    bool hasChannel(Channel channel) const;
+    /// Adds a channel initialized with zero intensity, black color or a null normal.
+    void addChannel(Channel channel);
+    void removeChannel(Channel channel);
+    //@}
+
+    /** @name Conversion
+     * The setters of the attributes throw a Base::ValueError if the number of values differs
+     * from the number of points.
+     */
+    //@{
+    void setPoints(const std::vector<Base::Vector3f>& points);
+    std::vector<Base::Vector3f> getPoints() const;
+    void setIntensities(const std::vector<float>& values);
+    std::vector<float> getIntensities() const;
+    void setColors(const std::vector<Base::Color>& colors);
+    std::vector<Base::Color> getColors() const;
+    void setNormals(const std::vector<Base::Vector3f>& normals);
+    std::vector<Base::Vector3f> getNormals() const;
+    /// Copies the points into the kernel and resets its transformation.
+    void toKernel(PointKernel& kernel) const;
+    //@}
+
+    /** @name Raw channel access */
+    //@{
+    std::span<const float> getX() const
+    {
+        return x;
+    }
+    std::span<const float> getY() const
+    {
+        return y;
+    }
+    std::span<const float> getZ() const
+    {
+        return z;
+    }
+    /// The intensities, empty if the channel is not present
+    std::span<const float> getIntensityChannel() const
+    {
+        return intensity;
+    }
+    /// The colors packed as RGBA, empty if the channel is not present
+    std::span<const uint32_t> getColorChannel() const
+    {
+        return rgba;
+    }
+    /// The normal components, empty if the channel is not present
+    std::span<const float> getNormalX() const
+    {
+        return nx;
+    }
+    std::span<const float> getNormalY() const
+    {
+        return ny;
+    }
+    std::span<const float> getNormalZ() const
+    {
+        return nz;
+    }
+    //@}
+
+    /** @name Operations */
+    //@{
+    /// Transforms the points and rotates the normals with the rotation part of \a mat.
+    void transform(const Base::Matrix4D& mat);
+    void move(const Base::Vector3f& offset);
+    /// The bounding box of all points that are not NaN
+    Base::BoundBox3f getBoundBox() const;
+    /// Keeps the points and their attributes where \a keep is true in their order.
+    void filter(const std::vector<bool>& keep);
+    /// Removes the points with a NaN coordinate.
+    void removeInvalid();
+    //@}
+
+private:
+    std::vector<float> x, y, z;
+    std::vector<float> intensity;
+    std::vector<uint32_t> rgba;
+    std::vector<float> nx, ny, nz;
+    int channels = 0;
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_POINTCLOUD_H
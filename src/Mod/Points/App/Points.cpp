@@ -22,6 +22,7 @@
 
 #include <QtConcurrentMap>
 #include <boost/math/special_functions/fpclassify.hpp>
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -82,18 +83,24 @@ Data::Segment* PointKernel::getSubElement(const char* /*Type*/, unsigned long /*
 void PointKernel::transformGeometry(const Base::Matrix4D& rclMat)
 {
     std::vector<value_type>& kernel = getBasicPoints();
+
+    // Transform the points in chunks, each one with the batch transform
+    static constexpr std::size_t chunkSize = 4096;
+    std::vector<std::size_t> chunks;
+    for (std::size_t i = 0; i < kernel.size(); i += chunkSize) {
+        chunks.push_back(i);
+    }
+    auto transform = [&rclMat, &kernel](std::size_t first) {
+        value_type* points = kernel.data() + first;
+        rclMat.multVec(points, points, std::min(chunkSize, kernel.size() - first));
+    };
 #ifdef _MSC_VER
     // Win32-only at the moment since ppl.h is a Microsoft library. Points is not using Qt so we
-    // cannot use QtConcurrent We could also rewrite Points to leverage SIMD instructions Other
-    // option: openMP. But with VC2013 results in high CPU usage even after computation (busy-waits
-    // for >100ms)
-    Concurrency::parallel_for_each(kernel.begin(), kernel.end(), [rclMat](value_type& value) {
-        value = rclMat * value;
-    });
+    // cannot use QtConcurrent. Other option: openMP. But with VC2013 results in high CPU usage
+    // even after computation (busy-waits for >100ms)
+    Concurrency::parallel_for_each(chunks.begin(), chunks.end(), transform);
 #else
-    QtConcurrent::blockingMap(kernel, [rclMat](value_type& value) {
-        rclMat.multVec(value, value);
-    });
+    QtConcurrent::blockingMap(chunks, transform);
 #endif
 }
 
@@ -44,7 +44,12 @@ class Points(object):
         ...
 
     def addPoints(self) -> Any:
-        """add one or more (list of) points to the object"""
+        """
+        add one or more (list of) points to the object
+
+        An array of shape (n, 3) of float or double, e.g. a NumPy array, is read through the
+        buffer protocol without creating Python objects, so does Points(array).
+        """
         ...
 
     @constmethod
@@ -56,6 +61,17 @@ class Points(object):
     def fromValid(self) -> Any:
         """Get a new point object from points with valid coordinates (i.e. that are not NaN)"""
         ...
+
+    @constmethod
+    def buffer(self) -> memoryview:
+        """
+        buffer() -> memoryview
+
+        Return a read-only view of shape (CountPoints, 3) on the float32 coordinates without
+        copying them, e.g. for numpy.asarray(). The coordinates are without the placement.
+        The view keeps the points object alive but adding points invalidates it.
+        """
+        ...
     CountPoints: Final[int]
     """Return the number of vertices of the points object."""
 
@@ -25,7 +25,11 @@
 #ifdef FC_OS_LINUX
 #include <unistd.h>
 #endif
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <numeric>
 #include <sstream>
 
 #include <boost/algorithm/string.hpp>
@@ -43,6 +47,10 @@
 #include "PointsAlgos.h"
 #include <E57Format.h>
 
+#ifdef _MSC_VER
+#include <ppl.h>
+#endif
+
 
 using namespace Points;
 
@@ -123,6 +131,173 @@ void PointsAlgos::LoadAscii(PointKernel& points, const char* FileName)
 
 // ----------------------------------------------------------------------------
 
+namespace
+{
+
+template<typename Container, typename Func>
+void parallelMap(Container& items, Func&& func)
+{
+#ifdef _MSC_VER
+    Concurrency::parallel_for_each(items.begin(), items.end(), func);
+#else
+    QtConcurrent::blockingMap(items, func);
+#endif
+}
+
+// Runs func(first, last) on chunks of the range [0, size), in parallel for big blocks
+template<typename Func>
+void forEachChunk(std::size_t size, Func&& func)
+{
+    static constexpr std::size_t chunkSize = 16384;
+    if (size <= chunkSize) {
+        func(std::size_t(0), size);
+        return;
+    }
+
+    std::vector<std::size_t> chunks;
+    for (std::size_t i = 0; i < size; i += chunkSize) {
+        chunks.push_back(i);
+    }
+    parallelMap(chunks, [&func, size](std::size_t first) {
+        func(first, std::min(first + chunkSize, size));
+    });
+}
+
+// A well mixed hash of the running number of a point
+uint64_t mix(uint64_t value)
+{
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+}  // namespace
+
+ReaderFilter::ReaderFilter()
+    // the voxels are split into shards that are filled on their own threads
+    : voxels(16)
+{}
+
+void ReaderFilter::setTransform(const Base::Matrix4D& mat)
+{
+    transform = mat;
+    hasTransform = (mat != Base::Matrix4D());
+
+    // Like PropertyNormalList only rotate the normals, remove the scaling of each row
+    rotation.setToUnity();
+    for (int i = 0; i < 3; i++) {
+        double s = std::sqrt(mat[i][0] * mat[i][0] + mat[i][1] * mat[i][1] + mat[i][2] * mat[i][2]);
+        for (int j = 0; j < 3; j++) {
+            rotation[i][j] = s > 0.0 ? mat[i][j] / s : 0.0;
+        }
+    }
+}
+
+void ReaderFilter::setCropBox(const Base::BoundBox3d& box)
+{
+    cropBox = box;
+}
+
+void ReaderFilter::setSampleRatio(double ratio)
+{
+    sampleRatio = std::clamp(ratio, 0.0, 1.0);
+}
+
+void ReaderFilter::setVoxelSize(double size)
+{
+    voxelSize = std::max(size, 0.0);
+}
+
+bool ReaderFilter::isDecimating() const
+{
+    return cropBox.IsValid() || sampleRatio < 1.0 || voxelSize > 0.0;
+}
+
+void ReaderFilter::reset()
+{
+    counter = 0;
+    for (auto& it : voxels) {
+        it.clear();
+    }
+}
+
+std::size_t ReaderFilter::VoxelHash::operator()(const Voxel& voxel) const
+{
+    return static_cast<std::size_t>(
+        mix(uint64_t(voxel[0]) ^ mix(uint64_t(voxel[1]) ^ mix(uint64_t(voxel[2])))));
+}
+
+void ReaderFilter::apply(std::vector<Base::Vector3d>& points, std::vector<char>& keep)
+{
+    const std::size_t count = points.size();
+    const uint64_t first = counter;
+    counter += count;
+
+    // Transforming, cropping and sampling a point doesn't depend on the other points
+    const bool crop = cropBox.IsValid();
+    const bool sample = sampleRatio < 1.0;
+    forEachChunk(count, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            if (hasTransform) {
+                transform.multVec(points[i], points[i]);
+            }
+            if (!keep[i]) {
+                continue;
+            }
+            if (crop && !cropBox.IsInBox(points[i])) {
+                keep[i] = 0;
+            }
+            else if (sample && double(mix(first + i) >> 11) * 0x1p-53 >= sampleRatio) {
+                keep[i] = 0;
+            }
+        }
+    });
+
+    if (voxelSize <= 0.0) {
+        return;
+    }
+
+    // Keep the first point of every voxel. Each shard of voxels goes through the points in
+    // their order, so the result is the same as if all voxels were in one set.
+    std::vector<Voxel> cells(count);
+    std::vector<std::size_t> hashes(count);
+    forEachChunk(count, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const Base::Vector3d& pnt = points[i];
+            if (!std::isfinite(pnt.x) || !std::isfinite(pnt.y) || !std::isfinite(pnt.z)) {
+                continue;
+            }
+            cells[i] = {int64_t(std::floor(pnt.x / voxelSize)),
+                        int64_t(std::floor(pnt.y / voxelSize)),
+                        int64_t(std::floor(pnt.z / voxelSize))};
+            hashes[i] = VoxelHash()(cells[i]);
+        }
+    });
+
+    std::vector<std::size_t> shards(voxels.size());
+    std::iota(shards.begin(), shards.end(), 0);
+    parallelMap(shards, [&](std::size_t shard) {
+        auto& set = voxels[shard];
+        for (std::size_t i = 0; i < count; i++) {
+            if (keep[i] && hashes[i] % voxels.size() == shard) {
+                const Base::Vector3d& pnt = points[i];
+                if (std::isfinite(pnt.x) && std::isfinite(pnt.y) && std::isfinite(pnt.z)
+                    && !set.insert(cells[i]).second) {
+                    keep[i] = 0;
+                }
+            }
+        }
+    });
+}
+
+Base::Vector3f ReaderFilter::rotate(const Base::Vector3f& normal) const
+{
+    return hasTransform ? rotation * normal : normal;
+}
+
+// ----------------------------------------------------------------------------
+
 Reader::Reader() = default;
 
 Reader::~Reader() = default;
@@ -134,6 +309,35 @@ void Reader::clear()
     normals.clear();
 }
 
+void Reader::setFilter(const ReaderFilter& filter)
+{
+    this->filter = filter;
+}
+
+std::vector<Eigen::Index>
+Reader::addFilteredPoints(const Eigen::MatrixXd& data, Eigen::Index x, Eigen::Index y, Eigen::Index z)
+{
+    filter.reset();
+    Eigen::Index numPoints = data.rows();
+    std::vector<Base::Vector3d> pts(numPoints);
+    for (Eigen::Index i = 0; i < numPoints; i++) {
+        pts[i].Set(data(i, x), data(i, y), data(i, z));
+    }
+    std::vector<char> keep(numPoints, 1);
+    filter.apply(pts, keep);
+
+    std::vector<Eigen::Index> rows;
+    std::vector<Base::Vector3f> kept;
+    for (Eigen::Index i = 0; i < numPoints; i++) {
+        if (keep[i]) {
+            rows.push_back(i);
+            kept.push_back(Base::toVector<float>(pts[i]));
+        }
+    }
+    points.swap(kept);
+    return rows;
+}
+
 const PointKernel& Reader::getPoints() const
 {
     return points;
@@ -664,32 +868,37 @@ void PlyReader::read(const std::string& filename)
     bool hasIntensity = (greyvalue != max_size);
     bool hasColor = (red != max_size && green != max_size && blue != max_size);
 
+    std::vector<Eigen::Index> rows;
     if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+        rows = addFilteredPoints(data, x, y, z);
+        // an organized cloud loses its structure when points are dropped
+        if (filter.isDecimating()) {
+            this->width = int(points.size());
+            this->height = 1;
         }
     }
 
     if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+        normals.reserve(rows.size());
+        for (Eigen::Index i : rows) {
+            normals.push_back(filter.rotate(Base::Vector3f(float(data(i, normal_x)),
+                                                            float(data(i, normal_y)),
+                                                            float(data(i, normal_z)))));
         }
     }
 
     if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
+        intensity.reserve(rows.size());
+        for (Eigen::Index i : rows) {
             intensity.push_back(static_cast<float>(data(i, greyvalue)));
         }
     }
 
     if (hasData && hasColor) {
-        colors.reserve(numPoints);
+        colors.reserve(rows.size());
         float a = 1.0;
         if (types[red] == "uchar") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
+            for (Eigen::Index i : rows) {
                 float r = static_cast<float>(data(i, red));
                 float g = static_cast<float>(data(i, green));
                 float b = static_cast<float>(data(i, blue));
@@ -703,7 +912,7 @@ void PlyReader::read(const std::string& filename)
             }
         }
         else if (types[red] == "float") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
+            for (Eigen::Index i : rows) {
                 float r = static_cast<float>(data(i, red));
                 float g = static_cast<float>(data(i, green));
                 float b = static_cast<float>(data(i, blue));
@@ -1139,31 +1348,36 @@ void PcdReader::read(const std::string& filename)
     bool hasIntensity = (greyvalue != max_size);
     bool hasColor = (rgba != max_size);
 
+    std::vector<Eigen::Index> rows;
     if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+        rows = addFilteredPoints(data, x, y, z);
+        // an organized cloud loses its structure when points are dropped
+        if (filter.isDecimating()) {
+            this->width = int(points.size());
+            this->height = 1;
         }
     }
 
     if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+        normals.reserve(rows.size());
+        for (Eigen::Index i : rows) {
+            normals.push_back(filter.rotate(Base::Vector3f(float(data(i, normal_x)),
+                                                            float(data(i, normal_y)),
+                                                            float(data(i, normal_z)))));
         }
     }
 
     if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
+        intensity.reserve(rows.size());
+        for (Eigen::Index i : rows) {
             intensity.push_back(data(i, greyvalue));
         }
     }
 
     if (hasData && hasColor) {
-        colors.reserve(numPoints);
+        colors.reserve(rows.size());
         if (types[rgba] == "U") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
+            for (Eigen::Index i : rows) {
                 uint32_t packed = static_cast<uint32_t>(data(i, rgba));
                 Base::Color col;
                 col.setPackedARGB(packed);
@@ -1173,7 +1387,7 @@ void PcdReader::read(const std::string& filename)
         else if (types[rgba] == "F") {
             static_assert(sizeof(float) == sizeof(uint32_t),
                           "float and uint32_t have different sizes");
-            for (Eigen::Index i = 0; i < numPoints; i++) {
+            for (Eigen::Index i : rows) {
                 float f = static_cast<float>(data(i, rgba));
                 uint32_t packed {};
                 std::memcpy(&packed, &f, sizeof(packed));
@@ -1396,11 +1610,16 @@ namespace
 class E57ReaderImp
 {
 public:
-    E57ReaderImp(const std::string& filename, bool color, bool state, double distance)
+    E57ReaderImp(const std::string& filename,
+                 bool color,
+                 bool state,
+                 double distance,
+                 ReaderFilter& filter)
         : imfi(filename, "r")
         , useColor {color}
         , checkState {state}
         , minDistance {distance}
+        , filter {filter}
     {}
 
     void read()
@@ -1412,22 +1631,22 @@ public:
         }
     }
 
-    std::vector<Base::Color> getColors() const
+    std::vector<Base::Color>& getColors()
     {
         return colors;
     }
 
-    std::vector<float> getItensity() const
+    std::vector<float>& getItensity()
     {
         return intensity;
     }
 
-    const PointKernel& getPoints() const
+    std::vector<Base::Vector3f>& getPoints()
     {
         return points;
     }
 
-    const std::vector<Base::Vector3f>& getNormals() const
+    std::vector<Base::Vector3f>& getNormals()
     {
         return normals;
     }
@@ -1636,43 +1855,47 @@ private:
         }
         unsigned count;
         unsigned cnt_pts = 0;
-        Base::Vector3d pt, last;
+        Base::Vector3d last;
         e57::CompressedVectorReader cvr(cvn.reader(proto.sdb));
         bool hasColor = (proto.cnt_rgb == 3) && useColor;
         bool hasItensity = proto.inty;
         bool hasNormal = (proto.cnt_nor == 3);
         bool hasState = proto.inv_state && checkState;
-        bool filter = false;
 
+        // Each block is filtered as a whole before the next one is read, so only the points
+        // that survive the decimation are kept in memory
+        std::vector<Base::Vector3d> block(buf_size);
+        std::vector<char> keep(buf_size);
         while ((count = cvr.read())) {
+            block.resize(count);
+            keep.resize(count);
             for (size_t i = 0; i < count; ++i) {
-                filter = false;
-                if (hasState) {
-                    if (proto.state[i] != 0) {
-                        filter = true;
-                    }
-                }
+                block[i] = getCoord(proto, i, hasPlacement, plm);
+                keep[i] = !hasState || proto.state[i] == 0;
+            }
+            filter.apply(block, keep);
 
-                pt = getCoord(proto, i, hasPlacement, plm);
+            for (size_t i = 0; i < count; ++i) {
+                if (!keep[i]) {
+                    continue;
+                }
+                const Base::Vector3d& pt = block[i];
+                if (cnt_pts > 0 && Base::Distance(last, pt) < minDistance) {
+                    continue;
+                }
 
-                if ((!filter) && (cnt_pts > 0)) {
-                    if (Base::Distance(last, pt) < minDistance) {
-                        filter = true;
-                    }
+                cnt_pts++;
+                points.push_back(Base::toVector<float>(pt));
+                last = pt;
+                if (hasColor) {
+                    colors.push_back(getColor(proto, i));
                 }
-                if (!filter) {
-                    cnt_pts++;
-                    points.push_back(pt);
-                    last = pt;
-                    if (hasColor) {
-                        colors.push_back(getColor(proto, i));
-                    }
-                    if (hasItensity) {
-                        intensity.push_back(proto.intensity[i]);
-                    }
-                    if (hasNormal) {
-                        normals.push_back(getNormal(proto, i, hasPlacement, plm.getRotation()));
-                    }
+                if (hasItensity) {
+                    intensity.push_back(proto.intensity[i]);
+                }
+                if (hasNormal) {
+                    normals.push_back(
+                        filter.rotate(getNormal(proto, i, hasPlacement, plm.getRotation())));
                 }
             }
         }
@@ -1767,10 +1990,11 @@ private:
     bool useColor;
     bool checkState;
     double minDistance;
-    const size_t buf_size = 1024;
+    ReaderFilter& filter;
+    const size_t buf_size = 65536;
     std::vector<Base::Color> colors;
     std::vector<float> intensity;
-    PointKernel points;
+    std::vector<Base::Vector3f> points;
     std::vector<Base::Vector3f> normals;
 };
 }  // namespace
@@ -1784,12 +2008,13 @@ E57Reader::E57Reader(bool Color, bool State, double Distance)
 void E57Reader::read(const std::string& filename)
 {
     try {
-        E57ReaderImp reader(filename, useColor, checkState, minDistance);
+        filter.reset();
+        E57ReaderImp reader(filename, useColor, checkState, minDistance, filter);
         reader.read();
-        points = reader.getPoints();
-        normals = reader.getNormals();
-        colors = reader.getColors();
-        intensity = reader.getItensity();
+        points.swap(reader.getPoints());
+        normals.swap(reader.getNormals());
+        colors.swap(reader.getColors());
+        intensity.swap(reader.getItensity());
         width = points.size();
         height = 1;
     }
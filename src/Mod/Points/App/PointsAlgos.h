@@ -23,8 +23,13 @@
 #ifndef _PointsAlgos_h_
 #define _PointsAlgos_h_
 
+#include <array>
+#include <unordered_set>
 #include <Eigen/Core>
 
+#include <Base/BoundBox.h>
+#include <Base/Matrix.h>
+
 #include "Points.h"
 #include "Properties.h"
 
@@ -45,12 +50,62 @@ public:
     static void LoadAscii(PointKernel&, const char* FileName);
 };
 
+/** Crops and decimates the points while a reader reads them.
+ * The points are transformed first, then the points outside the crop box are removed and the
+ * remaining ones are decimated: at random with the sample ratio and to the first point that falls
+ * into each voxel. The decisions don't depend on how the input is split into blocks.
+ */
+class PointsExport ReaderFilter
+{
+public:
+    ReaderFilter();
+
+    void setTransform(const Base::Matrix4D& mat);
+    /// Only keep the points inside \a box, an invalid box keeps all
+    void setCropBox(const Base::BoundBox3d& box);
+    /// Keep this fraction of the points, 1 keeps all
+    void setSampleRatio(double ratio);
+    /// Keep one point per voxel with this edge length, 0 keeps all
+    void setVoxelSize(double size);
+    /// Returns true if the filter may remove points
+    bool isDecimating() const;
+    /// Forgets the voxels and restarts the random sequence for a new input
+    void reset();
+
+    /**
+     * Transforms a block of points in place and clears \a keep for the points to remove. The
+     * points whose flag is already cleared are left out of the voxel grid. The blocks are
+     * processed on several threads.
+     */
+    void apply(std::vector<Base::Vector3d>& points, std::vector<char>& keep);
+    /// Rotates a normal vector with the rotation part of the transformation
+    Base::Vector3f rotate(const Base::Vector3f& normal) const;
+
+private:
+    using Voxel = std::array<int64_t, 3>;
+    struct VoxelHash
+    {
+        std::size_t operator()(const Voxel& voxel) const;
+    };
+
+    Base::Matrix4D transform;
+    Base::Matrix4D rotation;
+    Base::BoundBox3d cropBox;
+    double sampleRatio {1.0};
+    double voxelSize {0.0};
+    bool hasTransform {false};
+    uint64_t counter {0};
+    std::vector<std::unordered_set<Voxel, VoxelHash>> voxels;
+};
+
 class PointsExport Reader
 {
 public:
     Reader();
     virtual ~Reader();
     virtual void read(const std::string& filename) = 0;
+    /// Sets the filter that is applied while reading
+    void setFilter(const ReaderFilter& filter);
 
     void clear();
     const PointKernel& getPoints() const;
@@ -70,8 +125,14 @@ public:
     Reader& operator=(const Reader&) = delete;
     Reader& operator=(Reader&&) = delete;
 
+protected:
+    /// Filters the points of the rows of \a data, adds them and returns the rows to keep
+    std::vector<Eigen::Index>
+    addFilteredPoints(const Eigen::MatrixXd& data, Eigen::Index x, Eigen::Index y, Eigen::Index z);
+
 protected:
     // NOLINTBEGIN
+    ReaderFilter filter;
     PointKernel points;
     std::vector<float> intensity;
     std::vector<Base::Color> colors;
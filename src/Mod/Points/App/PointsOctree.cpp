@@ -0,0 +1,513 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+#include <thread>
+
+#include "Points.h"
+#include "PointsOctree.h"
+
+#ifdef _MSC_VER
+#include <ppl.h>
+#endif
+
+using namespace Points;
+
+namespace
+{
+
+// 21 bits per axis fit into a 64-bit Morton code
+constexpr int maxDepth = 21;
+constexpr std::size_t chunkSize = 16384;
+
+template<typename Container, typename Func>
+void parallelMap(Container& items, Func&& func)
+{
+#ifdef _MSC_VER
+    Concurrency::parallel_for_each(items.begin(), items.end(), func);
+#else
+    QtConcurrent::blockingMap(items, func);
+#endif
+}
+
+// Runs func(first, last) on chunks of the range [0, size) on several threads
+template<typename Func>
+void forEachChunk(std::size_t size, Func&& func)
+{
+    std::vector<std::size_t> chunks;
+    for (std::size_t i = 0; i < size; i += chunkSize) {
+        chunks.push_back(i);
+    }
+    parallelMap(chunks, [&func, size](std::size_t first) {
+        func(first, std::min(first + chunkSize, size));
+    });
+}
+
+// Inserts two zero bits between each of the lower 21 bits of value
+uint64_t spreadBits(uint64_t value)
+{
+    value &= 0x1fffff;
+    value = (value | value << 32) & 0x1f00000000ffff;
+    value = (value | value << 16) & 0x1f0000ff0000ff;
+    value = (value | value << 8) & 0x100f00f00f00f00f;
+    value = (value | value << 4) & 0x10c30c30c30c30c3;
+    value = (value | value << 2) & 0x1249249249249249;
+    return value;
+}
+
+// Sorts chunks of the items on several threads and merges them pairwise
+template<typename T>
+void parallelSort(std::vector<T>& items)
+{
+    const std::size_t parts = std::max(1U, std::thread::hardware_concurrency());
+    if (parts == 1 || items.size() < 4 * chunkSize) {
+        std::sort(items.begin(), items.end());
+        return;
+    }
+
+    std::vector<std::size_t> bounds;
+    for (std::size_t i = 0; i <= parts; i++) {
+        bounds.push_back(items.size() * i / parts);
+    }
+    std::vector<std::size_t> ranges(parts);
+    std::iota(ranges.begin(), ranges.end(), 0);
+    parallelMap(ranges, [&items, &bounds](std::size_t i) {
+        std::sort(items.begin() + bounds[i], items.begin() + bounds[i + 1]);
+    });
+
+    for (std::size_t width = 1; width < parts; width *= 2) {
+        std::vector<std::size_t> merges;
+        for (std::size_t i = 0; i + width < parts; i += 2 * width) {
+            merges.push_back(i);
+        }
+        parallelMap(merges, [&items, &bounds, width, parts](std::size_t i) {
+            std::inplace_merge(items.begin() + bounds[i],
+                               items.begin() + bounds[i + width],
+                               items.begin() + bounds[std::min(i + 2 * width, parts)]);
+        });
+    }
+}
+
+float distanceSquared(const Base::BoundBox3f& box, const Base::Vector3f& pnt)
+{
+    float dx = std::max({box.MinX - pnt.x, 0.0F, pnt.x - box.MaxX});
+    float dy = std::max({box.MinY - pnt.y, 0.0F, pnt.y - box.MaxY});
+    float dz = std::max({box.MinZ - pnt.z, 0.0F, pnt.z - box.MaxZ});
+    return dx * dx + dy * dy + dz * dz;
+}
+
+float farthestSquared(const Base::BoundBox3f& box, const Base::Vector3f& pnt)
+{
+    float dx = std::max(pnt.x - box.MinX, box.MaxX - pnt.x);
+    float dy = std::max(pnt.y - box.MinY, box.MaxY - pnt.y);
+    float dz = std::max(pnt.z - box.MinZ, box.MaxZ - pnt.z);
+    return dx * dx + dy * dy + dz * dz;
+}
+
+// How a query region relates to the bounding box of a subtree
+enum class Overlap
+{
+    None,
+    Partial,
+    Full
+};
+
+}  // namespace
+
+PointsOctree::PointsOctree(const PointKernel& kernel, unsigned int leafSize)
+    : _kernel(kernel)
+    , _leafSize(std::max(leafSize, 1U))
+{
+    Rebuild();
+}
+
+void PointsOctree::Rebuild()
+{
+    _nodes.clear();
+    _points.clear();
+    _indices.clear();
+
+    std::vector<Base::Vector3f> points;
+    std::vector<unsigned long> indices;
+    const std::vector<Base::Vector3f>& basic = _kernel.getBasicPoints();
+    points.reserve(basic.size());
+    indices.reserve(basic.size());
+    for (std::size_t i = 0; i < basic.size(); i++) {
+        const Base::Vector3f& pnt = basic[i];
+        if (!std::isnan(pnt.x) && !std::isnan(pnt.y) && !std::isnan(pnt.z)) {
+            points.push_back(pnt);
+            indices.push_back(static_cast<unsigned long>(i));
+        }
+    }
+
+    Base::Matrix4D mat = _kernel.getTransform();
+    if (mat != Base::Matrix4D()) {
+        forEachChunk(points.size(), [&points, &mat](std::size_t first, std::size_t last) {
+            mat.multVec(points.data() + first, points.data() + first, last - first);
+        });
+    }
+
+    // Quantize all axes with the same scale so that the cells of the tree are cubes
+    Base::BoundBox3f bbox(points.data(), points.size());
+    float length = std::max({bbox.LengthX(), bbox.LengthY(), bbox.LengthZ()});
+    float scale = length > 0.0F ? float((1 << maxDepth) - 1) / length : 0.0F;
+    const float maxCell = float((1 << maxDepth) - 1);
+    std::vector<std::pair<uint64_t, uint32_t>> codes(points.size());
+    forEachChunk(points.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            const Base::Vector3f& pnt = points[i];
+            auto qx = uint64_t(std::min((pnt.x - bbox.MinX) * scale, maxCell));
+            auto qy = uint64_t(std::min((pnt.y - bbox.MinY) * scale, maxCell));
+            auto qz = uint64_t(std::min((pnt.z - bbox.MinZ) * scale, maxCell));
+            codes[i] = {spreadBits(qx) << 2 | spreadBits(qy) << 1 | spreadBits(qz),
+                        static_cast<uint32_t>(i)};
+        }
+    });
+    parallelSort(codes);
+
+    _points.resize(points.size());
+    _indices.resize(points.size());
+    std::vector<uint64_t> sorted(points.size());
+    forEachChunk(points.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            _points[i] = points[codes[i].second];
+            _indices[i] = indices[codes[i].second];
+            sorted[i] = codes[i].first;
+        }
+    });
+
+    _nodes.emplace_back();
+    Build(0, 0, static_cast<uint32_t>(_points.size()), 0, sorted);
+}
+
+void PointsOctree::Build(uint32_t node,
+                         uint32_t first,
+                         uint32_t last,
+                         int depth,
+                         const std::vector<uint64_t>& codes)
+{
+    _nodes[node].first = first;
+    _nodes[node].last = last;
+    if (last - first <= _leafSize || depth == maxDepth) {
+        _nodes[node].box = Base::BoundBox3f(_points.data() + first, last - first);
+        return;
+    }
+
+    // The octant of this level is given by three bits of the code. All codes of the node share
+    // the bits above, so the octants of the sorted codes are in ascending order.
+    const int shift = 3 * (maxDepth - 1 - depth);
+    std::vector<uint32_t> bounds {first};
+    auto begin = codes.begin() + first;
+    auto end = codes.begin() + last;
+    for (uint64_t octant = 1; octant < 8; octant++) {
+        auto it = std::partition_point(begin, end, [shift, octant](uint64_t code) {
+            return ((code >> shift) & 7) < octant;
+        });
+        auto pos = static_cast<uint32_t>(it - codes.begin());
+        if (pos != bounds.back() && pos != last) {
+            bounds.push_back(pos);
+        }
+    }
+    bounds.push_back(last);
+
+    auto child = static_cast<uint32_t>(_nodes.size());
+    auto children = static_cast<uint32_t>(bounds.size() - 1);
+    _nodes.resize(_nodes.size() + children);
+    _nodes[node].child = child;
+    _nodes[node].children = children;
+
+    Base::BoundBox3f box;
+    for (uint32_t i = 0; i < children; i++) {
+        Build(child + i, bounds[i], bounds[i + 1], depth + 1, codes);
+        box.Add(_nodes[child + i].box);
+    }
+    _nodes[node].box = box;
+}
+
+Base::BoundBox3f PointsOctree::GetBoundBox() const
+{
+    return _nodes.front().box;
+}
+
+bool PointsOctree::NearestPoint(const Base::Vector3f& rclPt,
+                                float fMaxDist,
+                                unsigned long& rulIndex,
+                                float& rfDist) const
+{
+    std::vector<std::pair<float, unsigned long>> nearest;
+    Nearest(rclPt, 1, fMaxDist, nearest);
+    if (nearest.empty()) {
+        return false;
+    }
+
+    rulIndex = nearest.front().second;
+    rfDist = std::sqrt(nearest.front().first);
+    return true;
+}
+
+unsigned long PointsOctree::NearestPoints(const Base::Vector3f& rclPt,
+                                          unsigned long k,
+                                          std::vector<unsigned long>& raulIndices,
+                                          float fMaxDist) const
+{
+    std::vector<std::pair<float, unsigned long>> nearest;
+    Nearest(rclPt, k, fMaxDist, nearest);
+    raulIndices.resize(nearest.size());
+    std::transform(nearest.begin(), nearest.end(), raulIndices.begin(), [](const auto& value) {
+        return value.second;
+    });
+    return static_cast<unsigned long>(raulIndices.size());
+}
+
+void PointsOctree::Nearest(const Base::Vector3f& rclPt,
+                           unsigned long k,
+                           float fMaxDist,
+                           std::vector<std::pair<float, unsigned long>>& nearest) const
+{
+    nearest.clear();
+    if (k == 0 || _points.empty()) {
+        return;
+    }
+
+    // The k best candidates so far in a max-heap. Candidates with the same distance are
+    // ordered by their index so that the result doesn't depend on the traversal order.
+    using Candidate = std::pair<float, unsigned long>;
+    std::priority_queue<Candidate> best;
+    const float maxDist2 = fMaxDist < std::sqrt(std::numeric_limits<float>::max())
+        ? fMaxDist * fMaxDist
+        : std::numeric_limits<float>::max();
+    auto bound = [&best, k, maxDist2]() {
+        return best.size() < k ? maxDist2 : best.top().first;
+    };
+
+    // Depth-first with the nearer children first, skip subtrees that can't contain a better point
+    std::vector<std::pair<float, uint32_t>> stack;
+    std::vector<std::pair<float, uint32_t>> children;
+    stack.emplace_back(distanceSquared(_nodes.front().box, rclPt), 0);
+    while (!stack.empty()) {
+        auto [dist, index] = stack.back();
+        stack.pop_back();
+        if (dist > bound()) {
+            continue;
+        }
+
+        const Node& node = _nodes[index];
+        if (node.IsLeaf()) {
+            for (uint32_t i = node.first; i < node.last; i++) {
+                Candidate cand(Base::DistanceP2(_points[i], rclPt), _indices[i]);
+                if (best.size() < k) {
+                    if (cand.first < maxDist2) {
+                        best.push(cand);
+                    }
+                }
+                else if (cand < best.top()) {
+                    best.pop();
+                    best.push(cand);
+                }
+            }
+            continue;
+        }
+
+        children.clear();
+        for (uint32_t i = node.child; i < node.child + node.children; i++) {
+            children.emplace_back(distanceSquared(_nodes[i].box, rclPt), i);
+        }
+        std::sort(children.begin(), children.end(), std::greater<>());
+        stack.insert(stack.end(), children.begin(), children.end());
+    }
+
+    nearest.resize(best.size());
+    for (auto it = nearest.rbegin(); it != nearest.rend(); ++it) {
+        *it = best.top();
+        best.pop();
+    }
+}
+
+template<typename Contains, typename Classify>
+unsigned long PointsOctree::Collect(Contains&& contains,
+                                    Classify&& classify,
+                                    std::vector<unsigned long>& raulIndices) const
+{
+    const std::size_t size = raulIndices.size();
+    if (_points.empty()) {
+        return 0;
+    }
+
+    std::vector<uint32_t> stack {0};
+    while (!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        stack.pop_back();
+
+        Overlap overlap = classify(node.box);
+        if (overlap == Overlap::None) {
+            continue;
+        }
+        // the points of a subtree lie next to each other
+        if (overlap == Overlap::Full) {
+            raulIndices.insert(raulIndices.end(),
+                               _indices.begin() + node.first,
+                               _indices.begin() + node.last);
+        }
+        else if (node.IsLeaf()) {
+            for (uint32_t i = node.first; i < node.last; i++) {
+                if (contains(_points[i])) {
+                    raulIndices.push_back(_indices[i]);
+                }
+            }
+        }
+        else {
+            for (uint32_t i = node.child; i < node.child + node.children; i++) {
+                stack.push_back(i);
+            }
+        }
+    }
+
+    return static_cast<unsigned long>(raulIndices.size() - size);
+}
+
+unsigned long PointsOctree::InSphere(const Base::Vector3f& rclCenter,
+                                     float fRadius,
+                                     std::vector<unsigned long>& raulIndices) const
+{
+    raulIndices.clear();
+    const float radius2 = fRadius * fRadius;
+    return Collect(
+        [&rclCenter, radius2](const Base::Vector3f& pnt) {
+            return Base::DistanceP2(pnt, rclCenter) <= radius2;
+        },
+        [&rclCenter, radius2](const Base::BoundBox3f& box) {
+            if (distanceSquared(box, rclCenter) > radius2) {
+                return Overlap::None;
+            }
+            return farthestSquared(box, rclCenter) <= radius2 ? Overlap::Full : Overlap::Partial;
+        },
+        raulIndices);
+}
+
+unsigned long PointsOctree::InSide(const Base::BoundBox3f& rclBB,
+                                   std::vector<unsigned long>& raulIndices) const
+{
+    raulIndices.clear();
+    return Collect(
+        [&rclBB](const Base::Vector3f& pnt) {
+            return rclBB.IsInBox(pnt);
+        },
+        [&rclBB](const Base::BoundBox3f& box) {
+            if (!rclBB.Intersect(box)) {
+                return Overlap::None;
+            }
+            bool inside = box.MinX >= rclBB.MinX && box.MaxX <= rclBB.MaxX
+                && box.MinY >= rclBB.MinY && box.MaxY <= rclBB.MaxY && box.MinZ >= rclBB.MinZ
+                && box.MaxZ <= rclBB.MaxZ;
+            return inside ? Overlap::Full : Overlap::Partial;
+        },
+        raulIndices);
+}
+
+unsigned long PointsOctree::InFrustum(const std::vector<Plane>& planes,
+                                      std::vector<unsigned long>& raulIndices) const
+{
+    raulIndices.clear();
+    return Collect(
+        [&planes](const Base::Vector3f& pnt) {
+            return std::all_of(planes.begin(), planes.end(), [&pnt](const Plane& plane) {
+                return (pnt - plane.first) * plane.second >= 0.0F;
+            });
+        },
+        [&planes](const Base::BoundBox3f& box) {
+            Overlap overlap = Overlap::Full;
+            for (const auto& [base, normal] : planes) {
+                // the corners of the box farthest inside and farthest outside of the plane
+                Base::Vector3f inner(normal.x >= 0.0F ? box.MaxX : box.MinX,
+                                     normal.y >= 0.0F ? box.MaxY : box.MinY,
+                                     normal.z >= 0.0F ? box.MaxZ : box.MinZ);
+                Base::Vector3f outer(normal.x >= 0.0F ? box.MinX : box.MaxX,
+                                     normal.y >= 0.0F ? box.MinY : box.MaxY,
+                                     normal.z >= 0.0F ? box.MinZ : box.MaxZ);
+                if ((inner - base) * normal < 0.0F) {
+                    return Overlap::None;
+                }
+                if ((outer - base) * normal < 0.0F) {
+                    overlap = Overlap::Partial;
+                }
+            }
+            return overlap;
+        },
+        raulIndices);
+}
+
+void PointsOctree::LevelOfDetail(std::vector<unsigned long>& order,
+                                 std::vector<std::size_t>& levels) const
+{
+    order.clear();
+    levels.clear();
+    if (_points.empty()) {
+        return;
+    }
+
+    // The parents are visited first, so the first point of a node that starts like its parent
+    // keeps the level of the parent
+    const unsigned int unset = std::numeric_limits<unsigned int>::max();
+    std::vector<unsigned int> level(_points.size(), unset);
+    unsigned int maxLevel = 0;
+    std::vector<std::pair<uint32_t, unsigned int>> stack {{0, 0}};
+    while (!stack.empty()) {
+        auto [index, depth] = stack.back();
+        stack.pop_back();
+        const Node& node = _nodes[index];
+        if (level[node.first] == unset) {
+            level[node.first] = depth;
+        }
+        if (node.IsLeaf()) {
+            for (uint32_t i = node.first + 1; i < node.last; i++) {
+                level[i] = depth + (i - node.first);
+            }
+            maxLevel = std::max(maxLevel, depth + (node.last - node.first - 1));
+        }
+        else {
+            for (uint32_t i = 0; i < node.children; i++) {
+                stack.emplace_back(node.child + i, depth + 1);
+            }
+        }
+    }
+
+    // A counting sort keeps the Morton order inside of each level
+    levels.assign(maxLevel + 1, 0);
+    for (unsigned int value : level) {
+        levels[value]++;
+    }
+    std::vector<std::size_t> offsets(levels.size());
+    std::size_t sum = 0;
+    for (std::size_t i = 0; i < levels.size(); i++) {
+        offsets[i] = sum;
+        sum += levels[i];
+        levels[i] = sum;
+    }
+    order.resize(_points.size());
+    for (std::size_t i = 0; i < _points.size(); i++) {
+        order[offsets[level[i]]++] = _indices[i];
+    }
+}
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef POINTS_POINTSOCTREE_H
+#define POINTS_POINTSOCTREE_H
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Vector3D.h>
+
+#include <Mod/Points/PointsGlobal.h>
+
+
+namespace Points
+{
+
+class PointKernel;
+
+/**
+ * The PointsOctree class is a linear octree over the points of a point kernel. Unlike
+ * PointsGrid it adapts to the density of the points and answers nearest neighbour queries
+ * exactly.
+ *
+ * The points are copied with the transformation of the kernel applied and sorted by their
+ * Morton code, so the points of a subtree lie next to each other in memory. Points with a NaN
+ * coordinate are left out. The codes are computed and sorted on several threads. The structure
+ * doesn't change after construction, so it can be queried from several threads at once.
+ * All query results are indices into the point kernel.
+ */
+class PointsExport PointsOctree
+{
+public:
+    /// A half-space given by a point on its plane and the normal pointing to its inside
+    using Plane = std::pair<Base::Vector3f, Base::Vector3f>;
+
+    explicit PointsOctree(const PointKernel& kernel, unsigned int leafSize = 32);
+
+    /// Builds up the tree again after the points have changed
+    void Rebuild();
+    /// Returns the number of valid points in the tree
+    std::size_t Size() const
+    {
+        return _indices.size();
+    }
+    /// Returns the bounding box of all valid points
+    Base::BoundBox3f GetBoundBox() const;
+
+    /**
+     * Searches for the point nearest to \a rclPt, only points closer than \a fMaxDist are
+     * considered. Returns false if there is no such point.
+     */
+    bool NearestPoint(const Base::Vector3f& rclPt,
+                      float fMaxDist,
+                      unsigned long& rulIndex,
+                      float& rfDist) const;
+    /**
+     * Collects the \a k points nearest to \a rclPt that are closer than \a fMaxDist sorted by
+     * their distance. Returns the number of found points.
+     */
+    unsigned long NearestPoints(const Base::Vector3f& rclPt,
+                                unsigned long k,
+                                std::vector<unsigned long>& raulIndices,
+                                float fMaxDist = std::numeric_limits<float>::max()) const;
+    /// Collects the points inside the sphere around \a rclCenter in no particular order
+    unsigned long InSphere(const Base::Vector3f& rclCenter,
+                           float fRadius,
+                           std::vector<unsigned long>& raulIndices) const;
+    /// Collects the points inside the bounding box \a rclBB in no particular order
+    unsigned long InSide(const Base::BoundBox3f& rclBB,
+                         std::vector<unsigned long>& raulIndices) const;
+    /**
+     * Collects the points inside all half-spaces of \a planes in no particular order, e.g. the
+     * six planes of a view frustum.
+     */
+    unsigned long InFrustum(const std::vector<Plane>& planes,
+                            std::vector<unsigned long>& raulIndices) const;
+    /**
+     * Orders the points in levels of detail like a multi-resolution point cloud. The first point
+     * of a node belongs to the level of the depth of the node and the further points of a leaf to
+     * the levels below, so every level refines the levels before it. \a levels gets the end of
+     * each level in \a order. Inside of a level the points keep their spatial order.
+     */
+    void LevelOfDetail(std::vector<unsigned long>& order, std::vector<std::size_t>& levels) const;
+
+private:
+    struct Node
+    {
+        Base::BoundBox3f box;
+        /// the range of the points of the subtree
+        uint32_t first = 0;
+        uint32_t last = 0;
+        /// the first child, the children of a node are stored next to each other
+        uint32_t child = 0;
+        /// number of children, 0 for leaves
+        uint32_t children = 0;
+
+        bool IsLeaf() const
+        {
+            return children == 0;
+        }
+    };
+
+    void Build(uint32_t node,
+               uint32_t first,
+               uint32_t last,
+               int depth,
+               const std::vector<uint64_t>& codes);
+    /// the squared distances and indices of the k nearest points
+    void Nearest(const Base::Vector3f& rclPt,
+                 unsigned long k,
+                 float fMaxDist,
+                 std::vector<std::pair<float, unsigned long>>& nearest) const;
+    template<typename Contains, typename Classify>
+    unsigned long
+    Collect(Contains&& contains, Classify&& classify, std::vector<unsigned long>& raulIndices) const;
+
+private:
+    const PointKernel& _kernel;
+    std::vector<Node> _nodes;
+    /// the points in Morton order
+    std::vector<Base::Vector3f> _points;
+    /// the index of each point in the kernel
+    std::vector<unsigned long> _indices;
+    unsigned int _leafSize;
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_POINTSOCTREE_H
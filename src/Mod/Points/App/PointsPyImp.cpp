@@ -20,6 +20,8 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <cstring>
+
 #include <boost/math/special_functions/fpclassify.hpp>
 
 
@@ -36,6 +38,128 @@
 
 using namespace Points;
 
+namespace
+{
+
+// Exports the coordinates of a points object through the buffer protocol. It holds a reference
+// to the points object so that the memory stays valid as long as a view uses it.
+struct PointBuffer
+{
+    PyObject_HEAD
+    PyObject* owner;
+    const PointKernel* kernel;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+};
+
+static_assert(sizeof(PointKernel::value_type) == 3 * sizeof(PointKernel::float_type),
+              "The coordinates must be tightly packed");
+
+int PointBuffer_getbuffer(PyObject* self, Py_buffer* view, int flags)
+{
+    auto buffer = reinterpret_cast<PointBuffer*>(self);  // NOLINT
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "Points buffer is read-only");
+        view->obj = nullptr;
+        return -1;
+    }
+
+    static char format[] = "f";
+    const auto& points = buffer->kernel->getBasicPoints();
+    buffer->shape[0] = static_cast<Py_ssize_t>(points.size());
+    buffer->shape[1] = 3;
+    buffer->strides[0] = sizeof(PointKernel::value_type);
+    buffer->strides[1] = sizeof(PointKernel::float_type);
+
+    view->buf = const_cast<PointKernel::value_type*>(points.data());  // NOLINT
+    Py_INCREF(self);
+    view->obj = self;
+    view->len = static_cast<Py_ssize_t>(points.size() * sizeof(PointKernel::value_type));
+    view->readonly = 1;
+    view->itemsize = sizeof(PointKernel::float_type);
+    view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? format : nullptr;
+    view->ndim = 2;
+    view->shape = (flags & PyBUF_ND) == PyBUF_ND ? buffer->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? buffer->strides : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+void PointBuffer_dealloc(PyObject* self)
+{
+    Py_XDECREF(reinterpret_cast<PointBuffer*>(self)->owner);  // NOLINT
+    PyObject_Free(self);
+}
+
+PyTypeObject* PointBuffer_type()
+{
+    static PyBufferProcs procs = {PointBuffer_getbuffer, nullptr};
+    static PyTypeObject type = [] {
+        PyTypeObject obj = {PyVarObject_HEAD_INIT(nullptr, 0)};
+        obj.tp_name = "Points.PointBuffer";
+        obj.tp_basicsize = sizeof(PointBuffer);
+        obj.tp_dealloc = PointBuffer_dealloc;
+        obj.tp_as_buffer = &procs;
+        obj.tp_flags = Py_TPFLAGS_DEFAULT;
+        obj.tp_doc = "Exports the coordinates of a points object";
+        return obj;
+    }();
+    if (PyType_Ready(&type) < 0) {
+        return nullptr;
+    }
+    return &type;
+}
+
+// Adds the points of a float or double buffer of shape (n, 3), e.g. a NumPy array. Returns false
+// with a Python exception set if the buffer can't be used.
+bool addPointsFromBuffer(PointKernel& kernel, PyObject* obj)
+{
+    Py_buffer view;
+    if (PyObject_GetBuffer(obj, &view, PyBUF_RECORDS_RO) < 0) {
+        return false;
+    }
+
+    std::string format(view.format ? view.format : "B");
+    if (!format.empty() && (format[0] == '@' || format[0] == '=')) {
+        format.erase(0, 1);
+    }
+    bool ok = true;
+    if (format != "f" && format != "d") {
+        PyErr_Format(PyExc_TypeError, "Buffer of float or double expected, not '%s'", view.format);
+        ok = false;
+    }
+    else if (view.ndim != 2 || view.shape[1] != 3) {
+        PyErr_SetString(PyExc_ValueError, "Buffer of shape (n, 3) expected");
+        ok = false;
+    }
+    else {
+        auto value = [isFloat = format == "f"](const char* data) {
+            if (isFloat) {
+                float val {};
+                std::memcpy(&val, data, sizeof(val));
+                return double(val);
+            }
+            double val {};
+            std::memcpy(&val, data, sizeof(val));
+            return val;
+        };
+        kernel.reserve(kernel.size() + std::size_t(view.shape[0]));
+        const char* base = static_cast<const char*>(view.buf);
+        for (Py_ssize_t i = 0; i < view.shape[0]; i++) {
+            const char* row = base + i * view.strides[0];
+            kernel.push_back(Base::Vector3d(value(row),
+                                            value(row + view.strides[1]),
+                                            value(row + 2 * view.strides[1])));
+        }
+    }
+
+    PyBuffer_Release(&view);
+    return ok;
+}
+
+}  // namespace
+
 // returns a string which represents the object e.g. when printed in python
 std::string PointsPy::representation() const
 {
@@ -76,8 +200,13 @@ int PointsPy::PyInit(PyObject* args, PyObject* /*kwd*/)
     else if (PyUnicode_Check(pcObj)) {
         getPointKernelPtr()->load(PyUnicode_AsUTF8(pcObj));
     }
+    else if (PyObject_CheckBuffer(pcObj)) {
+        if (!addPointsFromBuffer(*getPointKernelPtr(), pcObj)) {
+            return -1;
+        }
+    }
     else {
-        PyErr_SetString(PyExc_TypeError, "optional argument must be list, tuple or string");
+        PyErr_SetString(PyExc_TypeError, "optional argument must be list, tuple, array or string");
         return -1;
     }
 
@@ -157,6 +286,13 @@ PyObject* PointsPy::addPoints(PyObject* args)
         return nullptr;
     }
 
+    if (PyObject_CheckBuffer(obj)) {
+        if (!addPointsFromBuffer(*getPointKernelPtr(), obj)) {
+            return nullptr;
+        }
+        Py_Return;
+    }
+
     try {
         Py::Sequence list(obj);
         Py::Type vType(Base::getTypeAsObject(&Base::VectorPy::Type));
@@ -180,7 +316,8 @@ PyObject* PointsPy::addPoints(PyObject* args)
         PyErr_SetString(PyExc_TypeError,
                         "either expect\n"
                         "-- [Vector,...] \n"
-                        "-- [(x,y,z),...]");
+                        "-- [(x,y,z),...]\n"
+                        "-- array of shape (n, 3)");
         return nullptr;
     }
 
@@ -240,6 +377,30 @@ PyObject* PointsPy::fromValid(PyObject* args) const
     }
 }
 
+PyObject* PointsPy::buffer(PyObject* args) const
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+
+    PyTypeObject* type = PointBuffer_type();
+    if (!type) {
+        return nullptr;
+    }
+    PointBuffer* exporter = PyObject_New(PointBuffer, type);
+    if (!exporter) {
+        return nullptr;
+    }
+    exporter->owner = const_cast<PointsPy*>(this);  // NOLINT
+    Py_INCREF(exporter->owner);
+    exporter->kernel = getPointKernelPtr();
+
+    // the memory view keeps the exporter and with it the points object alive
+    PyObject* view = PyMemoryView_FromObject(reinterpret_cast<PyObject*>(exporter));  // NOLINT
+    Py_DECREF(exporter);
+    return view;
+}
+
 Py::Long PointsPy::getCountPoints() const
 {
     return Py::Long((long)getPointKernelPtr()->size());
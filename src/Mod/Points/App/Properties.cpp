@@ -380,17 +380,20 @@ void PropertyNormalList::transformGeometry(const Base::Matrix4D& mat)
 
     aboutToSetValue();
 
-    // Rotate the normal vectors
+    // Rotate the normal vectors in chunks, each one with the batch transform
+    static constexpr std::size_t chunkSize = 4096;
+    std::vector<std::size_t> chunks;
+    for (std::size_t i = 0; i < _lValueList.size(); i += chunkSize) {
+        chunks.push_back(i);
+    }
+    auto transform = [this, &rot](std::size_t first) {
+        Base::Vector3f* normals = _lValueList.data() + first;
+        rot.multVec(normals, normals, std::min(chunkSize, _lValueList.size() - first));
+    };
 #ifdef _MSC_VER
-    Concurrency::parallel_for_each(_lValueList.begin(),
-                                   _lValueList.end(),
-                                   [rot](Base::Vector3f& value) {
-                                       value = rot * value;
-                                   });
+    Concurrency::parallel_for_each(chunks.begin(), chunks.end(), transform);
 #else
-    QtConcurrent::blockingMap(_lValueList, [rot](Base::Vector3f& value) {
-        rot.multVec(value, value);
-    });
+    QtConcurrent::blockingMap(chunks, transform);
 #endif
 
     hasSetValue();
@@ -20,6 +20,7 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <limits>
 
@@ -41,6 +42,7 @@
 #include <Gui/Selection/SoFCSelection.h>
 #include <Gui/View3DInventorViewer.h>
 #include <Mod/Points/App/PointsFeature.h>
+#include <Mod/Points/App/PointsOctree.h>
 #include <Mod/Points/App/Properties.h>
 
 #include "ViewProvider.h"
@@ -49,6 +51,29 @@
 using namespace PointsGui;
 using namespace Points;
 
+namespace
+{
+
+// Calls func(i, index) for the i-th shown point with its index in the whole cloud and
+// returns the number of shown points
+template<typename Func>
+std::size_t forEachShown(const std::vector<unsigned long>& indices, std::size_t num, Func&& func)
+{
+    if (indices.empty()) {
+        for (std::size_t i = 0; i < num; i++) {
+            func(i, i);
+        }
+        return num;
+    }
+
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        func(i, indices[i]);
+    }
+    return indices.size();
+}
+
+}  // namespace
+
 
 PROPERTY_SOURCE_ABSTRACT(PointsGui::ViewProviderPoints, Gui::ViewProviderGeometryObject)
 
@@ -112,13 +137,13 @@ void ViewProviderPoints::setVertexColorMode(App::PropertyColorList* pcProperty)
 {
     const std::vector<Base::Color>& val = pcProperty->getValues();
 
-    pcColorMat->diffuseColor.setNum(val.size());
+    pcColorMat->diffuseColor.setNum(shownIndices.empty() ? val.size() : shownIndices.size());
     SbColor* col = pcColorMat->diffuseColor.startEditing();
 
-    std::size_t i = 0;
-    for (const auto& it : val) {
-        col[i++].setValue(it.r, it.g, it.b);
-    }
+    forEachShown(shownIndices, val.size(), [&](std::size_t i, std::size_t index) {
+        const Base::Color& it = val[index];
+        col[i].setValue(it.r, it.g, it.b);
+    });
 
     pcColorMat->diffuseColor.finishEditing();
 }
@@ -127,13 +152,13 @@ void ViewProviderPoints::setVertexGreyvalueMode(Points::PropertyGreyValueList* p
 {
     const std::vector<float>& val = pcProperty->getValues();
 
-    pcColorMat->diffuseColor.setNum(val.size());
+    pcColorMat->diffuseColor.setNum(shownIndices.empty() ? val.size() : shownIndices.size());
     SbColor* col = pcColorMat->diffuseColor.startEditing();
 
-    std::size_t i = 0;
-    for (float it : val) {
-        col[i++].setValue(it, it, it);
-    }
+    forEachShown(shownIndices, val.size(), [&](std::size_t i, std::size_t index) {
+        float it = val[index];
+        col[i].setValue(it, it, it);
+    });
 
     pcColorMat->diffuseColor.finishEditing();
 }
@@ -142,20 +167,21 @@ void ViewProviderPoints::setVertexNormalMode(Points::PropertyNormalList* pcPrope
 {
     const std::vector<Base::Vector3f>& val = pcProperty->getValues();
 
-    pcPointsNormal->vector.setNum(val.size());
+    pcPointsNormal->vector.setNum(shownIndices.empty() ? val.size() : shownIndices.size());
     SbVec3f* norm = pcPointsNormal->vector.startEditing();
 
-    std::size_t i = 0;
-    for (const auto& it : val) {
-        norm[i++].setValue(it.x, it.y, it.z);
-    }
+    forEachShown(shownIndices, val.size(), [&](std::size_t i, std::size_t index) {
+        const Base::Vector3f& it = val[index];
+        norm[i].setValue(it.x, it.y, it.z);
+    });
 
     pcPointsNormal->vector.finishEditing();
 }
 
 void ViewProviderPoints::setDisplayMode(const char* ModeName)
 {
-    int numPoints = pcPointsCoord->point.getNum();
+    // the properties belong to the whole cloud, also if only a part of it is shown
+    int numPoints = shownIndices.empty() ? pcPointsCoord->point.getNum() : int(cloudSize);
 
     if (strcmp("Color", ModeName) == 0) {
         std::map<std::string, App::Property*> Map;
@@ -363,8 +389,22 @@ void ViewProviderPoints::clipPointsCallback(void*, SoEventCallback* n)
 
 PROPERTY_SOURCE(PointsGui::ViewProviderScattered, PointsGui::ViewProviderPoints)
 
+App::PropertyIntegerConstraint::Constraints ViewProviderScattered::budgetRange = {
+    0,
+    std::numeric_limits<int>::max(),
+    1000000};
+
 ViewProviderScattered::ViewProviderScattered()
 {
+    static const char* osgroup = "Object Style";
+
+    ADD_PROPERTY_TYPE(PointBudget,
+                      (20000000),
+                      osgroup,
+                      App::Prop_None,
+                      "Maximum number of shown points, 0 shows all points");
+    PointBudget.setConstraints(&budgetRange);
+
     pcPoints = new SoPointSet();
     pcPoints->ref();
 }
@@ -420,15 +460,27 @@ void ViewProviderScattered::attach(App::DocumentObject* pcObj)
     }
 }
 
+void ViewProviderScattered::onChanged(const App::Property* prop)
+{
+    if (prop == &PointBudget) {
+        auto fea = dynamic_cast<Points::Feature*>(pcObject);
+        if (fea) {
+            updatePoints(&fea->Points);
+        }
+    }
+    else {
+        ViewProviderPoints::onChanged(prop);
+    }
+}
+
 void ViewProviderScattered::updateData(const App::Property* prop)
 {
     ViewProviderPoints::updateData(prop);
     if (prop->is<Points::PropertyPointKernel>()) {
-        ViewProviderPointsBuilder builder;
-        builder.createPoints(prop, pcPointsCoord, pcPoints);
-
-        // The number of points might have changed, so force also a resize of the Inventor internals
-        setActiveMode();
+        // the levels of detail have to be built again for the new points
+        lodOrder.clear();
+        lodLevels.clear();
+        updatePoints(static_cast<const Points::PropertyPointKernel*>(prop));
     }
     else if (prop->is<Points::PropertyNormalList>()) {
         setActiveMode();
@@ -441,6 +493,46 @@ void ViewProviderScattered::updateData(const App::Property* prop)
     }
 }
 
+void ViewProviderScattered::updatePoints(const Points::PropertyPointKernel* prop)
+{
+    selectShownPoints(prop->getValue());
+
+    ViewProviderPointsBuilder builder;
+    builder.createPoints(prop, pcPointsCoord, pcPoints, shownIndices);
+
+    // The number of points might have changed, so force also a resize of the Inventor internals
+    setActiveMode();
+}
+
+void ViewProviderScattered::selectShownPoints(const Points::PointKernel& kernel)
+{
+    shownIndices.clear();
+    cloudSize = kernel.size();
+    auto budget = static_cast<std::size_t>(PointBudget.getValue());
+    if (budget == 0 || kernel.size() <= budget) {
+        return;
+    }
+
+    if (lodOrder.empty()) {
+        Points::PointsOctree octree(kernel);
+        octree.LevelOfDetail(lodOrder, lodLevels);
+    }
+
+    // Show all levels that fit into the budget. The points of a level are sorted in space, so
+    // the budget is filled up with an even sample of the next level and not with its beginning.
+    auto level = std::upper_bound(lodLevels.begin(), lodLevels.end(), budget);
+    std::size_t full = level == lodLevels.begin() ? 0 : *(level - 1);
+    shownIndices.reserve(std::min(budget, lodOrder.size()));
+    shownIndices.assign(lodOrder.begin(), lodOrder.begin() + full);
+    if (level != lodLevels.end()) {
+        std::size_t span = *level - full;
+        std::size_t rest = budget - full;
+        for (std::size_t i = 0; i < rest; i++) {
+            shownIndices.push_back(lodOrder[full + i * span / rest]);
+        }
+    }
+}
+
 void ViewProviderScattered::cut(const std::vector<SbVec2f>& picked,
                                 Gui::View3DInventorViewer& Viewer)
 {
@@ -701,24 +793,31 @@ void ViewProviderPointsBuilder::buildNodes(const App::Property* prop,
 void ViewProviderPointsBuilder::createPoints(const App::Property* prop,
                                              SoCoordinate3* coords,
                                              SoPointSet* points) const
+{
+    createPoints(prop, coords, points, {});
+}
+
+void ViewProviderPointsBuilder::createPoints(const App::Property* prop,
+                                             SoCoordinate3* coords,
+                                             SoPointSet* points,
+                                             const std::vector<unsigned long>& indices) const
 {
     const Points::PropertyPointKernel* prop_points =
         static_cast<const Points::PropertyPointKernel*>(prop);
     const Points::PointKernel& cPts = prop_points->getValue();
+    const std::vector<Points::PointKernel::value_type>& kernel = cPts.getBasicPoints();
 
-    coords->point.setNum(cPts.size());
+    std::size_t num = indices.empty() ? kernel.size() : indices.size();
+    coords->point.setNum(num);
     SbVec3f* vec = coords->point.startEditing();
 
-    // get all points
-    std::size_t idx = 0;
-    const std::vector<Points::PointKernel::value_type>& kernel = cPts.getBasicPoints();
-    for (std::vector<Points::PointKernel::value_type>::const_iterator it = kernel.begin();
-         it != kernel.end();
-         ++it, idx++) {
-        vec[idx].setValue(it->x, it->y, it->z);
-    }
+    // get all shown points
+    forEachShown(indices, kernel.size(), [&](std::size_t i, std::size_t index) {
+        const auto& it = kernel[index];
+        vec[i].setValue(it.x, it.y, it.z);
+    });
 
-    points->numPoints = cPts.size();
+    points->numPoints = num;
     coords->point.finishEditing();
 }
 
@@ -53,6 +53,7 @@ namespace Points
 {
 class PropertyGreyValueList;
 class PropertyNormalList;
+class PropertyPointKernel;
 class PointKernel;
 class Feature;
 }  // namespace Points
@@ -67,6 +68,11 @@ public:
     ~ViewProviderPointsBuilder() override = default;
     void buildNodes(const App::Property*, std::vector<SoNode*>&) const override;
     void createPoints(const App::Property*, SoCoordinate3*, SoPointSet*) const;
+    /// Only creates the points with the given indices, or all if \a indices is empty
+    void createPoints(const App::Property*,
+                      SoCoordinate3*,
+                      SoPointSet*,
+                      const std::vector<unsigned long>& indices) const;
     void createPoints(const App::Property*, SoCoordinate3*, SoIndexedPointSet*) const;
 };
 
@@ -112,6 +118,10 @@ protected:
     SoMaterial* pcColorMat;
     SoNormal* pcPointsNormal;
     SoDrawStyle* pcPointStyle;
+    /// The indices of the shown points if only a part of the cloud is shown, otherwise empty
+    std::vector<unsigned long> shownIndices;
+    /// The number of points of the whole cloud
+    std::size_t cloudSize {0};
 
 private:
     static App::PropertyFloatConstraint::Constraints floatRange;
@@ -130,6 +140,9 @@ public:
     ViewProviderScattered();
     ~ViewProviderScattered() override;
 
+    /// The maximum number of shown points, 0 shows all
+    App::PropertyIntegerConstraint PointBudget;
+
     /**
      * Extracts the point data from the feature \a pcFeature and creates
      * an Inventor node \a SoNode with these data.
@@ -139,10 +152,22 @@ public:
     void updateData(const App::Property*) override;
 
 protected:
+    void onChanged(const App::Property* prop) override;
     void cut(const std::vector<SbVec2f>& picked, Gui::View3DInventorViewer& Viewer) override;
 
+private:
+    void updatePoints(const Points::PropertyPointKernel* prop);
+    /// Selects the coarsest levels of detail that fit into the point budget
+    void selectShownPoints(const Points::PointKernel& kernel);
+
 protected:
     SoPointSet* pcPoints;
+
+private:
+    /// The points in their levels of detail, only built for clouds above the point budget
+    std::vector<unsigned long> lodOrder;
+    std::vector<std::size_t> lodLevels;
+    static App::PropertyIntegerConstraint::Constraints budgetRange;
 };
 
 /**
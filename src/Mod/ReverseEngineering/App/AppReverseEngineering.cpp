@@ -23,7 +23,11 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <Geom_BSplineSurface.hxx>
+#include <Geom_CylindricalSurface.hxx>
+#include <Geom_Plane.hxx>
+#include <Geom_SphericalSurface.hxx>
 #include <TColgp_Array1OfPnt.hxx>
+#include <gp_Ax3.hxx>
 #endif
 
 #include <Base/Console.h>
@@ -33,6 +37,7 @@
 #include <Base/PyWrapParseTupleAndKeywords.h>
 #include <Mod/Mesh/App/MeshPy.h>
 #include <Mod/Part/App/BSplineSurfacePy.h>
+#include <Mod/Part/App/Geometry.h>
 #include <Mod/Points/App/PointsPy.h>
 #if defined(HAVE_PCL_FILTERS)
 #include <pcl/filters/passthrough.h>
@@ -42,6 +47,7 @@
 
 #include "ApproxSurface.h"
 #include "BSplineFitting.h"
+#include "PrimitiveDetection.h"
 #include "RegionGrowing.h"
 #include "SampleConsensus.h"
 #include "Segmentation.h"
@@ -95,6 +101,24 @@ public:
             "UVDirs: set the u,v parameter directions as tuple of two vectors\n"
             "        If not set then they will be determined by computing a best-fit plane\n"
         );
+        add_keyword_method("detectPrimitives",&Module::detectPrimitives,
+            "detectPrimitives(Points, Normals=None, Types=('Plane', 'Sphere', 'Cylinder'),\n"
+            "Epsilon=0.01, Angle=0.35, MinSupport=100, ClusterEpsilon=0.0, Probability=0.99,\n"
+            "MaxPrimitives=0) -> list\n\n"
+            "Points: the point cloud\n"
+            "Normals: the normals of the points, needed to detect spheres and cylinders\n"
+            "Types: the types of primitives to search for\n"
+            "Epsilon: the maximum distance of an inlier to the primitive\n"
+            "Angle: the maximum angle in radians between the normal of an inlier and the primitive\n"
+            "MinSupport: the minimum number of inliers of a primitive\n"
+            "ClusterEpsilon: if greater than zero only the biggest part of a primitive is kept\n"
+            "        whose neighbouring inliers are closer than this distance\n"
+            "Probability: the probability to not miss a bigger primitive\n"
+            "MaxPrimitives: the maximum number of primitives, 0 means no limit\n\n"
+            "Returns a dict for each primitive with the keys Type, Surface, Inliers, RMS and\n"
+            "MaxError. Surface is a Part.Plane, Part.Sphere or Part.Cylinder and Inliers are the\n"
+            "indices of the points, e.g. to fit a B-spline surface to them with approxSurface.\n"
+        );
 #if defined(HAVE_PCL_SURFACE)
         add_keyword_method("triangulate",&Module::triangulate,
             "triangulate(PointKernel,searchRadius[,mu=2.5])."
@@ -124,11 +148,15 @@ public:
         add_keyword_method("filterVoxelGrid",&Module::filterVoxelGrid,
             "filterVoxelGrid(dim)."
         );
+#endif
         add_keyword_method("normalEstimation",&Module::normalEstimation,
-            "normalEstimation(Points,[KSearch=0, SearchRadius=0]) -> Normals\n"
+            "normalEstimation(Points,[KSearch=0, SearchRadius=0, Orient=True]) -> Normals\n"
             "KSearch is an int and used to search the k-nearest neighbours in\n"
-            "the k-d tree. Alternatively, SearchRadius (a float) can be used\n"
+            "the octree. Alternatively, SearchRadius (a float) can be used\n"
             "as spatial distance to determine the neighbours of a point\n"
+            "If both are given the k-nearest neighbours inside the radius are used.\n"
+            "With Orient the normals are oriented consistently, otherwise their\n"
+            "direction is random.\n"
             "Example:\n"
             "\n"
             "import ReverseEngineering as Reen\n"
@@ -142,7 +170,6 @@ public:
             "f.ViewObject.Proxy=0\n"
             "f.ViewObject.DisplayMode=1\n"
         );
-#endif
 #if defined(HAVE_PCL_SEGMENTATION)
         add_keyword_method("regionGrowingSegmentation",&Module::regionGrowingSegmentation,
             "regionGrowingSegmentation()."
@@ -450,6 +477,126 @@ private:
             throw Py::RuntimeError("Unknown C++ exception");
         }
     }
+    Py::Object detectPrimitives(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        PyObject* pts {};
+        PyObject* vec = Py_None;
+        PyObject* types = nullptr;
+        PrimitiveDetection::Parameters params;
+        double epsilon = params.epsilon;
+        double angle = params.maxAngle;
+        int minSupport = static_cast<int>(params.minSupport);
+        double clusterEpsilon = params.clusterEpsilon;
+        double probability = params.probability;
+        int maxPrimitives = 0;
+
+        static const std::array<const char*, 10> kwds_detect {"Points", "Normals", "Types",
+                                                              "Epsilon", "Angle", "MinSupport",
+                                                              "ClusterEpsilon", "Probability",
+                                                              "MaxPrimitives", nullptr};
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!|OOddiddi", kwds_detect,
+                                                 &(Points::PointsPy::Type), &pts, &vec, &types,
+                                                 &epsilon, &angle, &minSupport, &clusterEpsilon,
+                                                 &probability, &maxPrimitives)) {
+            throw Py::Exception();
+        }
+
+        if (epsilon <= 0.0) {
+            throw Py::ValueError("Epsilon must be positive");
+        }
+        if (minSupport < 1 || maxPrimitives < 0) {
+            throw Py::ValueError("MinSupport must be positive and MaxPrimitives not negative");
+        }
+        if (probability <= 0.0 || probability >= 1.0) {
+            throw Py::ValueError("Value of Probability out of range (0,1)");
+        }
+
+        params.epsilon = static_cast<float>(epsilon);
+        params.maxAngle = static_cast<float>(angle);
+        params.minSupport = static_cast<unsigned long>(minSupport);
+        params.clusterEpsilon = static_cast<float>(clusterEpsilon);
+        params.probability = static_cast<float>(probability);
+        params.maxPrimitives = static_cast<unsigned long>(maxPrimitives);
+        if (types) {
+            params.types.clear();
+            Py::Sequence list(types);
+            for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+                std::string type = Py::String(*it).as_std_string();
+                if (type == "Plane") {
+                    params.types.push_back(PrimitiveDetection::Plane);
+                }
+                else if (type == "Sphere") {
+                    params.types.push_back(PrimitiveDetection::Sphere);
+                }
+                else if (type == "Cylinder") {
+                    params.types.push_back(PrimitiveDetection::Cylinder);
+                }
+                else {
+                    throw Py::ValueError("Unknown primitive type: " + type);
+                }
+            }
+        }
+
+        Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
+        std::vector<Base::Vector3f> normals;
+        if (vec != Py_None) {
+            Py::Sequence list(vec);
+            normals.reserve(list.size());
+            for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+                Base::Vector3d v = Py::Vector(*it).toVector();
+                normals.push_back(Base::convertTo<Base::Vector3f>(v));
+            }
+            if (normals.size() != points->size()) {
+                throw Py::ValueError("Number of normals doesn't match the number of points");
+            }
+        }
+
+        std::vector<PrimitiveDetection::Primitive> primitives;
+        try {
+            PrimitiveDetection detection(*points, normals);
+            primitives = detection.perform(params);
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        Py::List list;
+        for (const auto& it : primitives) {
+            gp_Pnt center(it.center.x, it.center.y, it.center.z);
+            Py::Dict dict;
+            switch (it.type) {
+                case PrimitiveDetection::Plane: {
+                    gp_Dir normal(it.axis.x, it.axis.y, it.axis.z);
+                    Part::GeomPlane plane(new Geom_Plane(center, normal));
+                    dict.setItem("Type", Py::String("Plane"));
+                    dict.setItem("Surface", Py::asObject(plane.getPyObject()));
+                } break;
+                case PrimitiveDetection::Sphere: {
+                    gp_Ax3 pos(center, gp_Dir(0.0, 0.0, 1.0));
+                    Part::GeomSphere sphere(new Geom_SphericalSurface(pos, it.radius));
+                    dict.setItem("Type", Py::String("Sphere"));
+                    dict.setItem("Surface", Py::asObject(sphere.getPyObject()));
+                } break;
+                case PrimitiveDetection::Cylinder: {
+                    gp_Ax3 pos(center, gp_Dir(it.axis.x, it.axis.y, it.axis.z));
+                    Part::GeomCylinder cylinder(new Geom_CylindricalSurface(pos, it.radius));
+                    dict.setItem("Type", Py::String("Cylinder"));
+                    dict.setItem("Surface", Py::asObject(cylinder.getPyObject()));
+                } break;
+            }
+
+            Py::Tuple inliers(it.inliers.size());
+            for (std::size_t i = 0; i < it.inliers.size(); i++) {
+                inliers.setItem(i, Py::Long(it.inliers[i]));
+            }
+            dict.setItem("Inliers", inliers);
+            dict.setItem("RMS", Py::Float(it.rmsError));
+            dict.setItem("MaxError", Py::Float(it.maxError));
+            list.append(dict);
+        }
+
+        return list;
+    }
 #if defined(HAVE_PCL_SURFACE)
     /*
 import ReverseEngineering as Reen
@@ -793,25 +940,31 @@ Mesh.show(m)
         return Py::asObject(new Points::PointsPy(points_sample));
     }
 #endif
-#if defined(HAVE_PCL_FILTERS)
     Py::Object normalEstimation(const Py::Tuple& args, const Py::Dict& kwds)
     {
         PyObject *pts;
         int ksearch=0;
         double searchRadius=0;
+        PyObject* orient = Py_True;
 
-        static const std::array<const char*,4> kwds_normals {"Points", "KSearch", "SearchRadius", NULL};
-        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!|id", kwds_normals,
+        static const std::array<const char*,5> kwds_normals {"Points", "KSearch", "SearchRadius",
+                                                             "Orient", NULL};
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!|idO!", kwds_normals,
                                         &(Points::PointsPy::Type), &pts,
-                                        &ksearch, &searchRadius))
+                                        &ksearch, &searchRadius, &PyBool_Type, &orient))
             throw Py::Exception();
 
+        if (ksearch <= 0 && searchRadius <= 0) {
+            throw Py::ValueError("Either KSearch or SearchRadius must be set");
+        }
+
         Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
 
         std::vector<Base::Vector3d> normals;
         NormalEstimation estimate(*points);
         estimate.setKSearch(ksearch);
         estimate.setSearchRadius(searchRadius);
+        estimate.setOrientNormals(Base::asBoolean(orient));
         estimate.perform(normals);
 
         Py::List list;
@@ -821,7 +974,6 @@ Mesh.show(m)
 
         return list;
     }
-#endif
 #if defined(HAVE_PCL_SEGMENTATION)
     Py::Object regionGrowingSegmentation(const Py::Tuple& args, const Py::Dict& kwds)
     {
@@ -22,14 +22,17 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include <QFuture>
-#include <QFutureWatcher>
+#include <QThread>
 #include <QtConcurrentMap>
 
 #include <Geom_BSplineSurface.hxx>
 #include <Precision.hxx>
 #include <math_Gauss.hxx>
-#include <math_Householder.hxx>
 #endif
 
 #include <Base/Sequencer.h>
@@ -958,15 +961,38 @@ void BSplineParameterCorrection::SetVKnots(const std::vector<double>& afKnots)
     _clVSpline.SetKnots(_vVKnots, _vVMults, _usVOrder);
 }
 
+namespace
+{
+// The largest parameter change and the smallest angle cosine between the normal and the error
+// of a chunk of points
+struct CorrectionResult
+{
+    double maxDiff = 0.0;
+    double maxScalar = 1.0;
+};
+
+// The ranges of indices of the points that are processed by one task
+std::vector<std::pair<int, int>> makeChunks(int lower, int upper, int chunkSize)
+{
+    std::vector<std::pair<int, int>> chunks;
+    for (int first = lower; first <= upper; first += chunkSize) {
+        chunks.emplace_back(first, std::min(first + chunkSize - 1, upper));
+    }
+    return chunks;
+}
+}  // namespace
+
 void BSplineParameterCorrection::DoParameterCorrection(int iIter)
 {
     int i = 0;
     double fMaxDiff = 0.0, fMaxScalar = 1.0;
     double fWeight = _fSmoothInfluence;
 
+    // The points are projected independently of each other
+    std::vector<std::pair<int, int>> chunks =
+        makeChunks(_pvcPoints->Lower(), _pvcPoints->Upper(), 1024);
     Base::SequencerLauncher seq("Calc surface...",
-                                static_cast<size_t>(iIter)
-                                    * static_cast<size_t>(_pvcPoints->Length()));
+                                static_cast<size_t>(iIter) * chunks.size());
 
     do {
         fMaxScalar = 1.0;
@@ -980,48 +1006,57 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
                                                                              _usUOrder - 1,
                                                                              _usVOrder - 1);
 
-        for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-            double fDeltaU, fDeltaV, fU, fV;
-            const gp_Pnt& pnt = (*_pvcPoints)(ii);
-            gp_Vec P(pnt.X(), pnt.Y(), pnt.Z());
-            gp_Pnt PntX;
-            gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
-            // Calculate the first two derivatives and point at (u,v)
-            gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
-            pclBSplineSurf->D2(uvValue.X(), uvValue.Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
-            gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
-            gp_Vec ErrorVec = X - P;
-
-            // Calculate Xu x Xv the normal in X(u,v)
-            gp_Dir clNormal = Xu ^ Xv;
-
-            // Check, if X = P
-            if (!(X.IsEqual(P, 0.001, 0.001))) {
-                ErrorVec.Normalize();
-                if (fabs(clNormal * ErrorVec) < fMaxScalar) {
-                    fMaxScalar = fabs(clNormal * ErrorVec);
+        auto correct = [this, &pclBSplineSurf](const std::pair<int, int>& range) {
+            CorrectionResult result;
+            for (int ii = range.first; ii <= range.second; ii++) {
+                double fDeltaU, fDeltaV, fU, fV;
+                const gp_Pnt& pnt = (*_pvcPoints)(ii);
+                gp_Vec P(pnt.X(), pnt.Y(), pnt.Z());
+                gp_Pnt PntX;
+                gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
+                // Calculate the first two derivatives and point at (u,v)
+                gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
+                pclBSplineSurf->D2(uvValue.X(), uvValue.Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
+                gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
+                gp_Vec ErrorVec = X - P;
+
+                // Calculate Xu x Xv the normal in X(u,v)
+                gp_Dir clNormal = Xu ^ Xv;
+
+                // Check, if X = P
+                if (!(X.IsEqual(P, 0.001, 0.001))) {
+                    ErrorVec.Normalize();
+                    if (fabs(clNormal * ErrorVec) < result.maxScalar) {
+                        result.maxScalar = fabs(clNormal * ErrorVec);
+                    }
                 }
-            }
 
-            fDeltaU = ((P - X) * Xu) / ((P - X) * Xuu - Xu * Xu);
-            if (fabs(fDeltaU) < Precision::Confusion()) {
-                fDeltaU = 0.0;
-            }
-            fDeltaV = ((P - X) * Xv) / ((P - X) * Xvv - Xv * Xv);
-            if (fabs(fDeltaV) < Precision::Confusion()) {
-                fDeltaV = 0.0;
-            }
+                fDeltaU = ((P - X) * Xu) / ((P - X) * Xuu - Xu * Xu);
+                if (fabs(fDeltaU) < Precision::Confusion()) {
+                    fDeltaU = 0.0;
+                }
+                fDeltaV = ((P - X) * Xv) / ((P - X) * Xvv - Xv * Xv);
+                if (fabs(fDeltaV) < Precision::Confusion()) {
+                    fDeltaV = 0.0;
+                }
 
-            // Replace old u/v values with new ones
-            fU = uvValue.X() - fDeltaU;
-            fV = uvValue.Y() - fDeltaV;
-            if (fU <= 1.0 && fU >= 0.0 && fV <= 1.0 && fV >= 0.0) {
-                uvValue.SetX(fU);
-                uvValue.SetY(fV);
-                fMaxDiff = std::max<double>(fabs(fDeltaU), fMaxDiff);
-                fMaxDiff = std::max<double>(fabs(fDeltaV), fMaxDiff);
+                // Replace old u/v values with new ones
+                fU = uvValue.X() - fDeltaU;
+                fV = uvValue.Y() - fDeltaV;
+                if (fU <= 1.0 && fU >= 0.0 && fV <= 1.0 && fV >= 0.0) {
+                    uvValue.SetX(fU);
+                    uvValue.SetY(fV);
+                    result.maxDiff = std::max<double>(fabs(fDeltaU), result.maxDiff);
+                    result.maxDiff = std::max<double>(fabs(fDeltaV), result.maxDiff);
+                }
             }
+            return result;
+        };
 
+        QFuture<CorrectionResult> future = QtConcurrent::mapped(chunks, correct);
+        for (const auto& it : future) {
+            fMaxScalar = std::min(fMaxScalar, it.maxScalar);
+            fMaxDiff = std::max(fMaxDiff, it.maxDiff);
             seq.next();
         }
 
@@ -1037,223 +1072,242 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
     } while (i < iIter && fMaxDiff > Precision::Confusion() && fMaxScalar < 0.99);
 }
 
-bool BSplineParameterCorrection::SolveWithoutSmoothing()
+namespace Reen
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim = _usUCtrlpoints * _usVCtrlpoints;
-    math_Matrix M(0, ulSize - 1, 0, ulDim - 1);
-    math_Matrix Xx(0, ulDim - 1, 0, 0);
-    math_Matrix Xy(0, ulDim - 1, 0, 0);
-    math_Matrix Xz(0, ulDim - 1, 0, 0);
-    math_Vector bx(0, ulSize - 1);
-    math_Vector by(0, ulSize - 1);
-    math_Vector bz(0, ulSize - 1);
-
-    // Determining the coefficient matrix of the overdetermined LGS
-    for (unsigned i = 0; i < ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        unsigned ulIdx = 0;
-
-        // Pre-calculation of the values of the base functions
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j, fU);
+// The normal equations M^T*M*x = M^T*b of the overdetermined system. At a point only the basis
+// functions of its knot span differ from zero. With the control points numbered row by row a
+// point therefore only adds to a band around the diagonal, only its upper half is stored.
+class NormalEquations
+{
+public:
+    NormalEquations(int dim, int bandWidth)
+        : dim(dim)
+        , bandWidth(bandWidth)
+        , band(static_cast<std::size_t>(dim) * (bandWidth + 1), 0.0)
+        , rhs(static_cast<std::size_t>(dim) * 3, 0.0)
+    {}
+
+    /// Adds the point with the non-vanishing basis functions in ascending order of the columns
+    void addPoint(const int* columns, const double* values, int count, const gp_Pnt& pnt)
+    {
+        for (int i = 0; i < count; i++) {
+            double* row = &band[static_cast<std::size_t>(columns[i]) * (bandWidth + 1)];
+            for (int j = i; j < count; j++) {
+                row[columns[j] - columns[i]] += values[i] * values[j];
+            }
+            double* col = &rhs[static_cast<std::size_t>(columns[i]) * 3];
+            col[0] += values[i] * pnt.X();
+            col[1] += values[i] * pnt.Y();
+            col[2] += values[i] * pnt.Z();
         }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k, fV);
+    }
+
+    void add(const NormalEquations& other)
+    {
+        std::transform(band.begin(), band.end(), other.band.begin(), band.begin(), std::plus<>());
+        std::transform(rhs.begin(), rhs.end(), other.rhs.begin(), rhs.begin(), std::plus<>());
+    }
+
+    /// Solves the system with a banded Cholesky decomposition, fails if \a smooth isn't banded
+    bool solveBanded(const math_Matrix* smooth,
+                     double weight,
+                     math_Vector& x,
+                     math_Vector& y,
+                     math_Vector& z) const
+    {
+        std::vector<double> factor(band);
+        if (smooth && weight != 0.0) {
+            for (int i = 0; i < dim; i++) {
+                for (int j = i; j < dim; j++) {
+                    double value = (*smooth)(i, j);
+                    if (j - i > bandWidth) {
+                        if (value != 0.0) {
+                            return false;
+                        }
+                    }
+                    else {
+                        at(factor, i, j) += weight * value;
+                    }
+                }
+            }
         }
 
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = 0.0;
-                    ulIdx++;
+        // A = U^T * U, the rows of U are computed in place
+        for (int i = 0; i < dim; i++) {
+            double diagonal = at(factor, i, i);
+            int last = std::min(dim - 1, i + bandWidth);
+            for (int j = i; j <= last; j++) {
+                double sum = at(factor, i, j);
+                for (int k = std::max(0, j - bandWidth); k < i; k++) {
+                    sum -= at(factor, k, i) * at(factor, k, j);
+                }
+                if (j == i) {
+                    // not positive definite, e.g. a control point without any points nearby
+                    if (sum <= diagonal * 1e-12) {
+                        return false;
+                    }
+                    at(factor, i, i) = std::sqrt(sum);
+                }
+                else {
+                    at(factor, i, j) = sum / at(factor, i, i);
                 }
             }
-            else {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = valueU * basisV[k];
-                    ulIdx++;
+        }
+
+        // U^T * w = b and U * x = w
+        std::vector<double> sol(rhs);
+        for (int i = 0; i < dim; i++) {
+            for (int k = std::max(0, i - bandWidth); k < i; k++) {
+                for (int c = 0; c < 3; c++) {
+                    sol[i * 3 + c] -= at(factor, k, i) * sol[k * 3 + c];
                 }
             }
+            for (int c = 0; c < 3; c++) {
+                sol[i * 3 + c] /= at(factor, i, i);
+            }
+        }
+        for (int i = dim - 1; i >= 0; i--) {
+            int last = std::min(dim - 1, i + bandWidth);
+            for (int j = i + 1; j <= last; j++) {
+                for (int c = 0; c < 3; c++) {
+                    sol[i * 3 + c] -= at(factor, i, j) * sol[j * 3 + c];
+                }
+            }
+            for (int c = 0; c < 3; c++) {
+                sol[i * 3 + c] /= at(factor, i, i);
+            }
+            x(i) = sol[i * 3];
+            y(i) = sol[i * 3 + 1];
+            z(i) = sol[i * 3 + 2];
         }
-    }
 
-    // Determine the right side
-    for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X();
-        by(ii) = pnt.Y();
-        bz(ii) = pnt.Z();
+        return true;
     }
 
-    // Solve the over-determined LGS with Householder-Transformation
-    math_Householder hhX(M, bx);
-    math_Householder hhY(M, by);
-    math_Householder hhZ(M, bz);
-
-    if (!(hhX.IsDone() && hhY.IsDone() && hhZ.IsDone())) {
-        // LGS could not be solved
-        return false;
-    }
-    Xx = hhX.AllValues();
-    Xy = hhY.AllValues();
-    Xz = hhZ.AllValues();
+    /// Solves the full system with the LU decomposition
+    bool solveDense(const math_Matrix* smooth,
+                    double weight,
+                    math_Vector& x,
+                    math_Vector& y,
+                    math_Vector& z) const
+    {
+        math_Matrix MTM(0, dim - 1, 0, dim - 1, 0.0);
+        math_Vector Mbx(0, dim - 1);
+        math_Vector Mby(0, dim - 1);
+        math_Vector Mbz(0, dim - 1);
+        for (int i = 0; i < dim; i++) {
+            int last = std::min(dim - 1, i + bandWidth);
+            for (int j = i; j <= last; j++) {
+                MTM(i, j) = MTM(j, i) = at(band, i, j);
+            }
+            Mbx(i) = rhs[i * 3];
+            Mby(i) = rhs[i * 3 + 1];
+            Mbz(i) = rhs[i * 3 + 2];
+        }
+        if (smooth) {
+            MTM += weight * (*smooth);
+        }
 
-    unsigned ulIdx = 0;
-    for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            _vCtrlPntsOfSurf(j, k) = gp_Pnt(Xx(ulIdx, 0), Xy(ulIdx, 0), Xz(ulIdx, 0));
-            ulIdx++;
+        // the decomposition is the same for all three coordinates
+        math_Gauss mgGauss(MTM);
+        if (!mgGauss.IsDone()) {
+            return false;
         }
+        mgGauss.Solve(Mbx, x);
+        mgGauss.Solve(Mby, y);
+        mgGauss.Solve(Mbz, z);
+        return true;
     }
 
-    return true;
-}
-
-namespace Reen
-{
-class ScalarProduct
-{
-public:
-    explicit ScalarProduct(const math_Matrix& mat)
-        : mat(mat)
-    {}
-    std::vector<double> multiply(int col) const
+private:
+    double& at(std::vector<double>& values, int row, int col) const
     {
-        math_Vector vec = mat.Col(col);
-        std::vector<double> out(mat.ColNumber());
-        for (int n = mat.LowerCol(); n <= mat.UpperCol(); n++) {
-            out[n] = vec * mat.Col(n);
-        }
-        return out;
+        return values[static_cast<std::size_t>(row) * (bandWidth + 1) + (col - row)];
+    }
+    double at(const std::vector<double>& values, int row, int col) const
+    {
+        return values[static_cast<std::size_t>(row) * (bandWidth + 1) + (col - row)];
     }
 
 private:
-    const math_Matrix& mat;
+    int dim;
+    int bandWidth;
+    std::vector<double> band;
+    std::vector<double> rhs;
 };
 }  // namespace Reen
 
+bool BSplineParameterCorrection::SolveWithoutSmoothing()
+{
+    return SolveNormalEquations(nullptr, 0.0);
+}
+
 bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim = _usUCtrlpoints * _usVCtrlpoints;
-    math_Matrix M(0, ulSize - 1, 0, ulDim - 1);
-    math_Vector Xx(0, ulDim - 1);
-    math_Vector Xy(0, ulDim - 1);
-    math_Vector Xz(0, ulDim - 1);
-    math_Vector bx(0, ulSize - 1);
-    math_Vector by(0, ulSize - 1);
-    math_Vector bz(0, ulSize - 1);
-    math_Vector Mbx(0, ulDim - 1);
-    math_Vector Mby(0, ulDim - 1);
-    math_Vector Mbz(0, ulDim - 1);
-
-    // Determining the coefficient matrix of the overdetermined LGS
-    for (unsigned i = 0; i < ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        int ulIdx = 0;
-
-        // Pre-calculation of the values of the basis functions
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j, fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k, fV);
-        }
+    return SolveNormalEquations(&_clSmoothMatrix, fWeight);
+}
 
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = 0.0;
-                    ulIdx++;
-                }
+bool BSplineParameterCorrection::SolveNormalEquations(const math_Matrix* pclSmooth,
+                                                      double fWeight)
+{
+    int iUOrder = static_cast<int>(_usUOrder);
+    int iVOrder = static_cast<int>(_usVOrder);
+    int iVCtrlpoints = static_cast<int>(_usVCtrlpoints);
+    int iDim = static_cast<int>(_usUCtrlpoints) * iVCtrlpoints;
+    int iBandWidth = std::min(iDim - 1, (iUOrder - 1) * iVCtrlpoints + iVOrder - 1);
+
+    // Every thread accumulates the normal equations of its points on its own
+    int iPoints = _pvcPoints->Length();
+    int iParts = std::max(1, std::min(QThread::idealThreadCount(), (iPoints + 4095) / 4096));
+    std::vector<std::pair<int, int>> chunks =
+        makeChunks(_pvcPoints->Lower(), _pvcPoints->Upper(), (iPoints + iParts - 1) / iParts);
+    std::vector<NormalEquations> parts(chunks.size(), NormalEquations(iDim, iBandWidth));
+    std::vector<int> indices(chunks.size());
+    std::generate(indices.begin(), indices.end(), Base::iotaGen<int>(0));
+
+    QtConcurrent::blockingMap(indices, [&](int index) {
+        TColStd_Array1OfReal basisU(0, iUOrder - 1);
+        TColStd_Array1OfReal basisV(0, iVOrder - 1);
+        std::vector<int> columns(iUOrder * iVOrder);
+        std::vector<double> values(iUOrder * iVOrder);
+        for (int ii = chunks[index].first; ii <= chunks[index].second; ii++) {
+            const gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
+            double fU = uvValue.X();
+            double fV = uvValue.Y();
+            // all basis functions vanish outside of the knot vectors
+            if (fU < 0.0 || fU > 1.0 || fV < 0.0 || fV > 1.0) {
+                continue;
             }
-            else {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = valueU * basisV[k];
-                    ulIdx++;
+
+            // the first basis function of the span and the values of all that don't vanish
+            int iFirstU = _clUSpline.FindSpan(fU) - (iUOrder - 1);
+            int iFirstV = _clVSpline.FindSpan(fV) - (iVOrder - 1);
+            _clUSpline.AllBasisFunctions(fU, basisU);
+            _clVSpline.AllBasisFunctions(fV, basisV);
+
+            int count = 0;
+            for (int j = 0; j < iUOrder; j++) {
+                for (int k = 0; k < iVOrder; k++) {
+                    columns[count] = (iFirstU + j) * iVCtrlpoints + iFirstV + k;
+                    values[count] = basisU(j) * basisV(k);
+                    count++;
                 }
             }
+            parts[index].addPoint(columns.data(), values.data(), count, (*_pvcPoints)(ii));
         }
-    }
+    });
 
-    // The product of its transform and itself results in the quadratic
-    // system matrix (slowly)
-#if 0
-    math_Matrix MTM = M.TMultiply(M);
-#elif 0
-    math_Matrix MTM(0, ulDim - 1, 0, ulDim - 1);
-    for (unsigned m = 0; m < ulDim; m++) {
-        math_Vector Mm = M.Col(m);
-        for (unsigned n = m; n < ulDim; n++) {
-            MTM(m, n) = MTM(n, m) = Mm * M.Col(n);
-        }
-    }
-#else  // multi-threaded
-    std::vector<int> columns(ulDim);
-    std::generate(columns.begin(), columns.end(), Base::iotaGen<int>(0));
-    ScalarProduct scalar(M);
-    // NOLINTBEGIN
-    QFuture<std::vector<double>> future =
-        QtConcurrent::mapped(columns, std::bind(&ScalarProduct::multiply, &scalar, sp::_1));
-    // NOLINTEND
-    QFutureWatcher<std::vector<double>> watcher;
-    watcher.setFuture(future);
-    watcher.waitForFinished();
-
-    math_Matrix MTM(0, ulDim - 1, 0, ulDim - 1);
-    int rowIndex = 0;
-    for (const auto& it : future) {
-        int colIndex = 0;
-        for (std::vector<double>::const_iterator jt = it.begin(); jt != it.end();
-             ++jt, colIndex++) {
-            MTM(rowIndex, colIndex) = *jt;
-        }
-        rowIndex++;
+    NormalEquations& equations = parts.front();
+    for (std::size_t i = 1; i < parts.size(); i++) {
+        equations.add(parts[i]);
     }
-#endif
 
-    // Determine the right side
-    for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X();
-        by(ii) = pnt.Y();
-        bz(ii) = pnt.Z();
-    }
-    for (unsigned i = 0; i < ulDim; i++) {
-        math_Vector Mi = M.Col(i);
-        Mbx(i) = Mi * bx;
-        Mby(i) = Mi * by;
-        Mbz(i) = Mi * bz;
-    }
-
-    // Solve the LGS with the LU decomposition
-    math_Gauss mgGaussX(MTM + fWeight * _clSmoothMatrix);
-    math_Gauss mgGaussY(MTM + fWeight * _clSmoothMatrix);
-    math_Gauss mgGaussZ(MTM + fWeight * _clSmoothMatrix);
-
-    mgGaussX.Solve(Mbx, Xx);
-    if (!mgGaussX.IsDone()) {
-        return false;
-    }
-
-    mgGaussY.Solve(Mby, Xy);
-    if (!mgGaussY.IsDone()) {
-        return false;
-    }
-
-    mgGaussZ.Solve(Mbz, Xz);
-    if (!mgGaussZ.IsDone()) {
+    math_Vector Xx(0, iDim - 1);
+    math_Vector Xy(0, iDim - 1);
+    math_Vector Xz(0, iDim - 1);
+    if (!equations.solveBanded(pclSmooth, fWeight, Xx, Xy, Xz)
+        && !equations.solveDense(pclSmooth, fWeight, Xx, Xy, Xz)) {
+        // LGS could not be solved
         return false;
     }
 
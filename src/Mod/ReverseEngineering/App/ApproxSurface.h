@@ -404,16 +404,23 @@ protected:
     void DoParameterCorrection(int iIter) override;
 
     /**
-     * Solve an overdetermined LGS with the help of the Householder-Tansformation
+     * Solve an overdetermined LGS by its normal equations
      */
     bool SolveWithoutSmoothing() override;
 
     /**
-     * Solve a regular system of equations by LU decomposition. Depending on the weighting,
+     * Solve the normal equations of the overdetermined LGS. Depending on the weighting,
      * smoothing terms are included
      */
     bool SolveWithSmoothing(double fWeight) override;
 
+    /**
+     * Builds up the normal equations on several threads and solves them with a banded
+     * Cholesky decomposition, or by LU decomposition if the smoothing terms are not banded
+     * or the system isn't positive definite. The smoothing matrix may be null.
+     */
+    bool SolveNormalEquations(const math_Matrix* pclSmooth, double fWeight);
+
 public:
     /**
      * Setting the knot vector
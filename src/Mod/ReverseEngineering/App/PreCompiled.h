@@ -33,21 +33,32 @@
 #ifdef _PreComp_
 
 // standard
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <queue>
+#include <random>
 
 // boost
 #include <boost/math/special_functions/fpclassify.hpp>
 
 // OpenCasCade
 #include <Geom_BSplineSurface.hxx>
+#include <Geom_CylindricalSurface.hxx>
+#include <Geom_Plane.hxx>
+#include <Geom_SphericalSurface.hxx>
 #include <Precision.hxx>
 #include <TColgp_Array1OfPnt.hxx>
+#include <gp_Ax3.hxx>
 #include <math_Gauss.hxx>
 #include <math_Householder.hxx>
 
 // Qt
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QThread>
 #include <QtConcurrentMap>
 
 #endif  // _PreComp_
@@ -0,0 +1,557 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <random>
+#endif
+
+#include <Base/Converter.h>
+#include <Base/Exception.h>
+#include <Mod/Mesh/App/Core/Approximation.h>
+#include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsOctree.h>
+
+#include "PrimitiveDetection.h"
+
+
+using namespace Reen;
+
+namespace
+{
+
+constexpr std::size_t chunkSize = 16384;
+// the number of candidates that are generated and scored at once
+constexpr std::size_t batchSize = 64;
+// the maximum number of points the candidates are scored on
+constexpr std::size_t subsetSize = 4096;
+// the maximum number of inliers for the least-squares fit
+constexpr std::size_t fitSize = 20000;
+// the neighbourhoods of the samples have 16, 64, 256 or 1024 points
+constexpr int sampleLevels = 4;
+// give up the search for a primitive after so many candidates
+constexpr std::size_t maxCandidates = 100000;
+
+// Runs func(first, last) on chunks of chunkSize of the range [0, size) on several threads
+template<typename Func>
+void forEachChunk(std::size_t size, Func&& func)
+{
+    std::vector<std::size_t> chunks;
+    for (std::size_t i = 0; i < size; i += chunkSize) {
+        chunks.push_back(i);
+    }
+    QtConcurrent::blockingMap(chunks, [&func, size](std::size_t first) {
+        func(first, std::min(first + chunkSize, size));
+    });
+}
+
+struct Shape
+{
+    PrimitiveDetection::Type type = PrimitiveDetection::Plane;
+    Base::Vector3f center;
+    Base::Vector3f axis;
+    float radius = 0.0F;
+
+    // Returns the distance of the point to the shape and the normal of the shape next to it
+    float distance(const Base::Vector3f& pnt, Base::Vector3f& normal) const
+    {
+        switch (type) {
+            case PrimitiveDetection::Plane:
+                normal = axis;
+                return std::fabs((pnt - center) * axis);
+            case PrimitiveDetection::Sphere:
+                normal = pnt - center;
+                break;
+            case PrimitiveDetection::Cylinder:
+                normal = pnt - center;
+                normal = normal - axis * (normal * axis);
+                break;
+        }
+
+        float len = normal.Length();
+        normal.Normalize();
+        return std::fabs(len - radius);
+    }
+};
+
+struct Candidate
+{
+    std::size_t id = 0;
+    Shape shape;
+    bool valid = false;
+    // the size of the minimal sample
+    int samples = 0;
+    // the number of inliers estimated from the subset
+    double support = 0.0;
+};
+
+struct Context
+{
+    const std::vector<Base::Vector3f>& points;
+    const std::vector<Base::Vector3f>& normals;
+    const std::vector<char>& used;
+    const Points::PointsOctree& octree;
+    float epsilon;
+    float cosAngle;
+    float maxRadius;
+
+    bool isInlier(const Shape& shape, unsigned long index, float& dist) const
+    {
+        Base::Vector3f normal;
+        dist = shape.distance(points[index], normal);
+        if (dist > epsilon) {
+            return false;
+        }
+        return normals.empty() || std::fabs(normals[index] * normal) >= cosAngle;
+    }
+};
+
+// The points of the lines p1 + t*d1 and p2 + s*d2 that are closest to each other
+bool closestPoints(const Base::Vector3f& p1,
+                   const Base::Vector3f& d1,
+                   const Base::Vector3f& p2,
+                   const Base::Vector3f& d2,
+                   Base::Vector3f& c1,
+                   Base::Vector3f& c2)
+{
+    Base::Vector3f w = p1 - p2;
+    float a = d1 * d1;
+    float b = d1 * d2;
+    float c = d2 * d2;
+    float d = d1 * w;
+    float e = d2 * w;
+    float den = a * c - b * b;
+    // the lines are (almost) parallel
+    if (den <= 1e-6F * a * c) {
+        return false;
+    }
+    float t = (b * e - c * d) / den;
+    float s = (a * e - b * d) / den;
+    c1 = p1 + d1 * t;
+    c2 = p2 + d2 * s;
+    return true;
+}
+
+// Computes a shape from a minimal sample in the neighbourhood of a random remaining point
+bool makeShape(const Context& ctx,
+               const std::vector<unsigned long>& remaining,
+               PrimitiveDetection::Type type,
+               std::mt19937& rng,
+               Shape& shape)
+{
+    std::uniform_int_distribution<std::size_t> pick(0, remaining.size() - 1);
+    unsigned long first = remaining[pick(rng)];
+    int level = std::uniform_int_distribution<int>(0, sampleLevels - 1)(rng);
+
+    std::vector<unsigned long> neighbours;
+    ctx.octree.NearestPoints(ctx.points[first], 16UL << (2 * level), neighbours);
+    neighbours.erase(std::remove_if(neighbours.begin(),
+                                    neighbours.end(),
+                                    [&ctx, first](unsigned long index) {
+                                        return ctx.used[index] != 0 || index == first;
+                                    }),
+                     neighbours.end());
+
+    std::size_t count = type == PrimitiveDetection::Plane ? 2 : 1;
+    if (neighbours.size() < count) {
+        return false;
+    }
+    std::vector<unsigned long> sample {first};
+    for (std::size_t i = 0; i < count; i++) {
+        std::uniform_int_distribution<std::size_t> next(i, neighbours.size() - 1);
+        std::swap(neighbours[i], neighbours[next(rng)]);
+        sample.push_back(neighbours[i]);
+    }
+
+    const Base::Vector3f& p1 = ctx.points[sample[0]];
+    const Base::Vector3f& p2 = ctx.points[sample[1]];
+    shape.type = type;
+    switch (type) {
+        case PrimitiveDetection::Plane: {
+            const Base::Vector3f& p3 = ctx.points[sample[2]];
+            Base::Vector3f u = p2 - p1;
+            Base::Vector3f v = p3 - p1;
+            Base::Vector3f normal = u % v;
+            if (normal.Length() <= 1e-6F * u.Length() * v.Length()) {
+                return false;
+            }
+            shape.center = p1;
+            shape.axis = normal.Normalize();
+        } break;
+        case PrimitiveDetection::Sphere: {
+            Base::Vector3f c1, c2;
+            if (!closestPoints(p1, ctx.normals[sample[0]], p2, ctx.normals[sample[1]], c1, c2)) {
+                return false;
+            }
+            shape.center = (c1 + c2) * 0.5F;
+            shape.radius = 0.5F * (Base::Distance(p1, shape.center)
+                                   + Base::Distance(p2, shape.center));
+        } break;
+        case PrimitiveDetection::Cylinder: {
+            const Base::Vector3f& n1 = ctx.normals[sample[0]];
+            const Base::Vector3f& n2 = ctx.normals[sample[1]];
+            Base::Vector3f axis = n1 % n2;
+            if (axis.Length() < 1e-3F) {
+                return false;
+            }
+            axis.Normalize();
+            // the normals of a cylinder meet at its axis in the plane perpendicular to it
+            Base::Vector3f q2 = p2 - axis * ((p2 - p1) * axis);
+            Base::Vector3f c1, c2;
+            if (!closestPoints(p1, n1, q2, n2, c1, c2)) {
+                return false;
+            }
+            shape.center = (c1 + c2) * 0.5F;
+            shape.axis = axis;
+            shape.radius = 0.5F * (Base::Distance(p1, shape.center)
+                                   + Base::Distance(q2, shape.center));
+        } break;
+    }
+
+    if (type != PrimitiveDetection::Plane && shape.radius > ctx.maxRadius) {
+        return false;
+    }
+
+    // the shape must fit to the normals of the sample
+    float dist {};
+    return std::all_of(sample.begin(), sample.end(), [&ctx, &shape, &dist](unsigned long index) {
+        return ctx.isInlier(shape, index, dist);
+    });
+}
+
+// The probability to draw a minimal sample of k points of a primitive with n of the N points
+double drawProbability(double n, std::size_t N, int k)
+{
+    return n / (double(N) * sampleLevels * double(1 << (k - 1)));
+}
+
+std::vector<unsigned long> collectInliers(const Context& ctx,
+                                          const std::vector<unsigned long>& remaining,
+                                          const Shape& shape)
+{
+    std::vector<std::vector<unsigned long>> parts((remaining.size() + chunkSize - 1) / chunkSize);
+    forEachChunk(remaining.size(), [&](std::size_t first, std::size_t last) {
+        std::vector<unsigned long>& part = parts[first / chunkSize];
+        float dist {};
+        for (std::size_t i = first; i < last; i++) {
+            if (ctx.isInlier(shape, remaining[i], dist)) {
+                part.push_back(remaining[i]);
+            }
+        }
+    });
+
+    std::vector<unsigned long> inliers;
+    for (const auto& part : parts) {
+        inliers.insert(inliers.end(), part.begin(), part.end());
+    }
+    return inliers;
+}
+
+// Least-squares fit of the shape to at most fitSize of the inliers
+bool fitShape(const Context& ctx, const std::vector<unsigned long>& inliers, Shape& shape)
+{
+    std::vector<Base::Vector3f> points;
+    std::size_t step = std::max<std::size_t>(1, inliers.size() / fitSize);
+    for (std::size_t i = 0; i < inliers.size(); i += step) {
+        points.push_back(ctx.points[inliers[i]]);
+    }
+
+    const float failed = std::numeric_limits<float>::max();
+    switch (shape.type) {
+        case PrimitiveDetection::Plane: {
+            MeshCore::PlaneFit fit;
+            fit.AddPoints(points);
+            if (fit.Fit() == failed) {
+                return false;
+            }
+            shape.center = fit.GetBase();
+            shape.axis = fit.GetNormal();
+        } break;
+        case PrimitiveDetection::Sphere: {
+            MeshCore::SphereFit fit;
+            fit.AddPoints(points);
+            if (fit.Fit() == failed) {
+                return false;
+            }
+            shape.center = fit.GetCenter();
+            shape.radius = fit.GetRadius();
+        } break;
+        case PrimitiveDetection::Cylinder: {
+            MeshCore::CylinderFit fit;
+            fit.AddPoints(points);
+            fit.SetInitialValues(shape.center, shape.axis);
+            if (fit.Fit() == failed) {
+                return false;
+            }
+            shape.center = fit.GetBase();
+            shape.axis = fit.GetAxis();
+            shape.radius = fit.GetRadius();
+        } break;
+    }
+
+    return std::isfinite(shape.center.x) && std::isfinite(shape.axis.x)
+        && std::isfinite(shape.radius) && shape.radius <= ctx.maxRadius;
+}
+
+// Returns the biggest part of the inliers whose points are closer than epsilon to each other
+std::vector<unsigned long>
+largestComponent(const Context& ctx, const std::vector<unsigned long>& inliers, float epsilon)
+{
+    // 0: no inlier, 1: not yet visited, 2: visited
+    std::vector<char> state(ctx.points.size(), 0);
+    for (unsigned long index : inliers) {
+        state[index] = 1;
+    }
+
+    std::vector<unsigned long> largest;
+    std::vector<unsigned long> neighbours;
+    for (unsigned long start : inliers) {
+        if (state[start] != 1) {
+            continue;
+        }
+
+        std::vector<unsigned long> component;
+        std::queue<unsigned long> front;
+        front.push(start);
+        state[start] = 2;
+        while (!front.empty()) {
+            unsigned long index = front.front();
+            front.pop();
+            component.push_back(index);
+            ctx.octree.InSphere(ctx.points[index], epsilon, neighbours);
+            for (unsigned long next : neighbours) {
+                if (state[next] == 1) {
+                    state[next] = 2;
+                    front.push(next);
+                }
+            }
+        }
+
+        if (component.size() > largest.size()) {
+            largest.swap(component);
+        }
+    }
+
+    std::sort(largest.begin(), largest.end());
+    return largest;
+}
+
+// Collects the inliers of the shape, refines it and computes the statistics of the fit
+bool makePrimitive(const Context& ctx,
+                   const std::vector<unsigned long>& remaining,
+                   const PrimitiveDetection::Parameters& params,
+                   Shape shape,
+                   PrimitiveDetection::Primitive& primitive)
+{
+    std::vector<unsigned long> inliers = collectInliers(ctx, remaining, shape);
+
+    // a better fit usually finds more inliers, stop as soon as it doesn't
+    for (int iter = 0; iter < 3 && inliers.size() >= params.minSupport; iter++) {
+        Shape fitted = shape;
+        if (!fitShape(ctx, inliers, fitted)) {
+            break;
+        }
+        std::vector<unsigned long> refined = collectInliers(ctx, remaining, fitted);
+        if (refined.size() <= inliers.size()) {
+            break;
+        }
+        shape = fitted;
+        inliers.swap(refined);
+    }
+
+    if (params.clusterEpsilon > 0.0F && inliers.size() >= params.minSupport) {
+        inliers = largestComponent(ctx, inliers, params.clusterEpsilon);
+    }
+    if (inliers.size() < params.minSupport) {
+        return false;
+    }
+
+    primitive.type = shape.type;
+    primitive.center = Base::convertTo<Base::Vector3d>(shape.center);
+    primitive.axis = Base::convertTo<Base::Vector3d>(shape.axis);
+    primitive.radius = shape.radius;
+    primitive.inliers.assign(inliers.begin(), inliers.end());
+
+    double sum = 0.0;
+    double max = 0.0;
+    Base::Vector3f normal;
+    for (unsigned long index : inliers) {
+        double dist = shape.distance(ctx.points[index], normal);
+        sum += dist * dist;
+        max = std::max(max, dist);
+    }
+    primitive.rmsError = std::sqrt(sum / double(inliers.size()));
+    primitive.maxError = max;
+    return true;
+}
+
+}  // namespace
+
+PrimitiveDetection::PrimitiveDetection(const Points::PointKernel& pts,
+                                       const std::vector<Base::Vector3f>& normals)
+    : myPoints(pts)
+    , myNormals(normals)
+{}
+
+std::vector<PrimitiveDetection::Primitive>
+PrimitiveDetection::perform(const Parameters& params) const
+{
+    std::vector<Primitive> primitives;
+    std::size_t size = myPoints.size();
+    if (!myNormals.empty() && myNormals.size() != size) {
+        throw Base::ValueError("Number of normals doesn't match the number of points");
+    }
+
+    // spheres and cylinders are computed from the normals
+    std::vector<Type> types;
+    std::copy_if(params.types.begin(),
+                 params.types.end(),
+                 std::back_inserter(types),
+                 [this](Type type) {
+                     return type == Plane || !myNormals.empty();
+                 });
+    if (types.empty() || size == 0) {
+        return primitives;
+    }
+
+    std::vector<Base::Vector3f> points(size);
+    std::vector<Base::Vector3f> normals(myNormals);
+    std::vector<char> used(size, 0);
+    Base::BoundBox3f box;
+    for (std::size_t i = 0; i < size; i++) {
+        points[i] = Base::convertTo<Base::Vector3f>(myPoints.getPoint(int(i)));
+        if (std::isnan(points[i].x) || std::isnan(points[i].y) || std::isnan(points[i].z)) {
+            used[i] = 1;
+        }
+        else {
+            box.Add(points[i]);
+        }
+    }
+    for (auto& normal : normals) {
+        normal.Normalize();
+    }
+
+    Points::PointsOctree octree(myPoints);
+    Context ctx {points,
+                 normals,
+                 used,
+                 octree,
+                 params.epsilon,
+                 std::cos(params.maxAngle),
+                 box.IsValid() ? box.CalcDiagonalLength() : 0.0F};
+
+    std::mt19937 rng(params.seed);
+    std::size_t nextId = 0;
+    while (params.maxPrimitives == 0 || primitives.size() < params.maxPrimitives) {
+        std::vector<unsigned long> remaining;
+        for (std::size_t i = 0; i < size; i++) {
+            if (used[i] == 0) {
+                remaining.push_back(i);
+            }
+        }
+        if (remaining.size() < std::max<unsigned long>(params.minSupport, 3)) {
+            break;
+        }
+
+        // the candidates are scored on a random subset and their support is extrapolated
+        std::vector<unsigned long> subset;
+        std::sample(remaining.begin(),
+                    remaining.end(),
+                    std::back_inserter(subset),
+                    subsetSize,
+                    rng);
+        double scale = double(remaining.size()) / double(subset.size());
+
+        std::vector<Candidate> pool;
+        std::size_t tries = 0;
+        bool found = false;
+        Primitive primitive;
+        while (!found && tries < maxCandidates) {
+            std::vector<Candidate> batch(batchSize);
+            for (auto& it : batch) {
+                it.id = nextId++;
+            }
+            QtConcurrent::blockingMap(batch, [&](Candidate& cand) {
+                // every candidate has its own random numbers to be independent of the threads
+                std::seed_seq seq {params.seed, static_cast<unsigned int>(cand.id)};
+                std::mt19937 gen(seq);
+                Type type = types[cand.id % types.size()];
+                if (!makeShape(ctx, remaining, type, gen, cand.shape)) {
+                    return;
+                }
+                cand.valid = true;
+                cand.samples = type == Plane ? 3 : 2;
+                float dist {};
+                auto count = std::count_if(subset.begin(), subset.end(), [&](unsigned long index) {
+                    return ctx.isInlier(cand.shape, index, dist);
+                });
+                cand.support = double(count) * scale;
+            });
+            tries += batch.size();
+            std::copy_if(batch.begin(), batch.end(), std::back_inserter(pool), [](const auto& it) {
+                return it.valid;
+            });
+            if (pool.empty()) {
+                continue;
+            }
+
+            auto best = std::max_element(pool.begin(), pool.end(), [](const auto& a, const auto& b) {
+                return a.support < b.support;
+            });
+            // the probability that a bigger primitive, or one with the minimum support, hasn't
+            // been sampled yet
+            double support = std::max(best->support, double(params.minSupport));
+            double failure =
+                std::pow(1.0 - drawProbability(support, remaining.size(), best->samples),
+                         double(tries));
+            if (failure > 1.0 - params.probability) {
+                continue;
+            }
+            // there is no primitive with enough points left
+            if (best->support < double(params.minSupport)) {
+                break;
+            }
+            if (makePrimitive(ctx, remaining, params, best->shape, primitive)) {
+                found = true;
+            }
+            else {
+                pool.erase(best);
+            }
+        }
+
+        if (!found) {
+            break;
+        }
+        for (int index : primitive.inliers) {
+            used[index] = 1;
+        }
+        primitives.push_back(std::move(primitive));
+    }
+
+    return primitives;
+}
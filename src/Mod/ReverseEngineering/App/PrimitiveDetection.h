@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef REEN_PRIMITIVEDETECTION_H
+#define REEN_PRIMITIVEDETECTION_H
+
+#include <vector>
+
+#include <Base/Vector3D.h>
+#include <Mod/ReverseEngineering/ReverseEngineeringGlobal.h>
+
+
+namespace Points
+{
+class PointKernel;
+}
+
+namespace Reen
+{
+
+/**
+ * The PrimitiveDetection class extracts planes, spheres and cylinders from a point cloud with the
+ * efficient RANSAC method of Schnabel, Wahl and Klein. Unlike SampleConsensus it doesn't need PCL
+ * and finds all primitives of the cloud one after another.
+ *
+ * The minimal samples of a candidate are taken from a neighbourhood of a random point in an octree,
+ * so that they likely belong to the same primitive. The candidates are generated and scored on a
+ * random subset of the points in batches on several threads. The search for a primitive stops as
+ * soon as the probability that a bigger one was missed is low enough. The inliers of the best
+ * candidate are then collected on several threads and the primitive is refined by a least-squares
+ * fit to them.
+ *
+ * Spheres and cylinders are computed from the normals of the samples, without normals only
+ * planes are detected.
+ */
+class ReenExport PrimitiveDetection
+{
+public:
+    enum Type
+    {
+        Plane,
+        Sphere,
+        Cylinder,
+    };
+
+    struct Parameters
+    {
+        /// the types of primitives to search for
+        std::vector<Type> types {Plane, Sphere, Cylinder};
+        /// the maximum distance of an inlier to the primitive
+        float epsilon = 0.01F;
+        /// the maximum angle in radians between the normal of an inlier and the primitive
+        float maxAngle = 0.35F;
+        /// the minimum number of inliers of a primitive
+        unsigned long minSupport = 100;
+        /**
+         * the maximum distance between neighbouring inliers, if greater than zero only the biggest
+         * connected part of a primitive is kept
+         */
+        float clusterEpsilon = 0.0F;
+        /// the probability to not miss a primitive that is bigger than the found one
+        float probability = 0.99F;
+        /// the maximum number of primitives, 0 means no limit
+        unsigned long maxPrimitives = 0;
+        /// the seed of the random numbers, the result doesn't depend on the number of threads
+        unsigned int seed = 0;
+    };
+
+    struct Primitive
+    {
+        Type type = Plane;
+        /// a point on the plane, the center of the sphere or a point on the axis of the cylinder
+        Base::Vector3d center;
+        /// the normal of the plane or the axis of the cylinder
+        Base::Vector3d axis;
+        /// the radius of the sphere or the cylinder
+        double radius = 0.0;
+        /// the indices of the inliers in the point kernel
+        std::vector<int> inliers;
+        /// the root mean square and the maximum of the distances of the inliers
+        double rmsError = 0.0;
+        double maxError = 0.0;
+    };
+
+    /**
+     * The normals are optional, if given there must be one for each point of the kernel.
+     */
+    PrimitiveDetection(const Points::PointKernel&, const std::vector<Base::Vector3f>& normals);
+    /**
+     * Returns the primitives sorted by the order they were found in, every point belongs to at
+     * most one of them.
+     */
+    std::vector<Primitive> perform(const Parameters&) const;
+
+private:
+    const Points::PointKernel& myPoints;
+    const std::vector<Base::Vector3f>& myNormals;
+};
+
+}  // namespace Reen
+
+#endif  // REEN_PRIMITIVEDETECTION_H
@@ -21,8 +21,18 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#ifndef _PreComp_
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <Eigen/Eigenvalues>
+#endif
 
+#include <Base/Converter.h>
+#include <Base/Exception.h>
 #include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsOctree.h>
 
 #include "Segmentation.h"
 
@@ -160,56 +170,229 @@ void Segmentation::perform(int ksearch)
 
 // ----------------------------------------------------------------------------
 
-#if defined(HAVE_PCL_FILTERS)
+namespace
+{
+
+constexpr std::size_t chunkSize = 4096;
+
+// Runs func(first, last) on chunks of chunkSize of the range [0, size), in parallel for big ranges
+template<typename Func>
+void forEachChunk(std::size_t size, Func&& func)
+{
+    if (size <= chunkSize) {
+        func(std::size_t(0), size);
+        return;
+    }
+
+    std::vector<std::size_t> chunks;
+    for (std::size_t i = 0; i < size; i += chunkSize) {
+        chunks.push_back(i);
+    }
+    QtConcurrent::blockingMap(chunks, [&func, size](std::size_t first) {
+        func(first, std::min(first + chunkSize, size));
+    });
+}
+
+}  // namespace
+
 NormalEstimation::NormalEstimation(const Points::PointKernel& pts)
     : myPoints(pts)
     , kSearch(0)
     , searchRadius(0)
+    , orient(true)
 {}
 
-void NormalEstimation::perform(std::vector<Base::Vector3d>& normals)
+std::shared_ptr<const NeighbourGraph> NormalEstimation::searchNeighbours() const
 {
-    // Copy the points
-    pcl::PointCloud<PointXYZ>::Ptr cloud(new pcl::PointCloud<PointXYZ>);
-    cloud->reserve(myPoints.size());
-    for (Points::PointKernel::const_iterator it = myPoints.begin(); it != myPoints.end(); ++it) {
-        cloud->push_back(pcl::PointXYZ(it->x, it->y, it->z));
+    if (kSearch <= 0 && searchRadius <= 0) {
+        throw Base::ValueError("Neither the number of neighbours nor the search radius is set");
     }
 
-    cloud->width = int(cloud->points.size());
-    cloud->height = 1;
-
-#if 0
-    // Build a passthrough filter to remove spurious NaNs
-    pcl::PointCloud<PointXYZ>::Ptr cloud_filtered (new pcl::PointCloud<PointXYZ>);
-    pcl::PassThrough<PointXYZ> pass;
-    pass.setInputCloud (cloud);
-    pass.setFilterFieldName ("z");
-    pass.setFilterLimits (0, 1.5);
-    pass.filter (*cloud_filtered);
-#endif
+    Points::PointsOctree octree(myPoints);
+    std::size_t size = myPoints.size();
+    std::vector<std::vector<unsigned long>> parts((size + chunkSize - 1) / chunkSize);
+    std::vector<std::size_t> counts(size, 0);
+    forEachChunk(size, [&](std::size_t first, std::size_t last) {
+        std::vector<unsigned long>& part = parts[first / chunkSize];
+        std::vector<unsigned long> found;
+        std::vector<std::pair<float, unsigned long>> sorted;
+        for (std::size_t i = first; i < last; i++) {
+            Base::Vector3f pnt = Base::convertTo<Base::Vector3f>(myPoints.getPoint(int(i)));
+            if (std::isnan(pnt.x) || std::isnan(pnt.y) || std::isnan(pnt.z)) {
+                continue;
+            }
+
+            if (kSearch > 0) {
+                float maxDist = searchRadius > 0 ? float(searchRadius)
+                                                 : std::numeric_limits<float>::max();
+                octree.NearestPoints(pnt, kSearch, found, maxDist);
+            }
+            else {
+                octree.InSphere(pnt, float(searchRadius), found);
+                sorted.clear();
+                for (unsigned long index : found) {
+                    auto other = Base::convertTo<Base::Vector3f>(myPoints.getPoint(int(index)));
+                    sorted.emplace_back(Base::DistanceP2(pnt, other), index);
+                }
+                std::sort(sorted.begin(), sorted.end());
+                for (std::size_t j = 0; j < sorted.size(); j++) {
+                    found[j] = sorted[j].second;
+                }
+            }
+
+            counts[i] = found.size();
+            part.insert(part.end(), found.begin(), found.end());
+        }
+    });
+
+    auto graph = std::make_shared<NeighbourGraph>();
+    graph->offsets.resize(size + 1, 0);
+    for (std::size_t i = 0; i < size; i++) {
+        graph->offsets[i + 1] = graph->offsets[i] + counts[i];
+    }
+    graph->indices.reserve(graph->offsets.back());
+    for (const auto& part : parts) {
+        graph->indices.insert(graph->indices.end(), part.begin(), part.end());
+    }
+    return graph;
+}
 
-    // Estimate point normals
-    pcl::PointCloud<pcl::Normal>::Ptr cloud_normals(new pcl::PointCloud<pcl::Normal>);
-    pcl::search::KdTree<PointXYZ>::Ptr tree(new pcl::search::KdTree<PointXYZ>());
-    pcl::NormalEstimation<PointXYZ, pcl::Normal> ne;
-    ne.setSearchMethod(tree);
-    // ne.setInputCloud (cloud_filtered);
-    ne.setInputCloud(cloud);
-    if (kSearch > 0) {
-        ne.setKSearch(kSearch);
+void NormalEstimation::perform(std::vector<Base::Vector3d>& normals)
+{
+    if (!neighbours || neighbours->size() != myPoints.size()) {
+        neighbours = searchNeighbours();
     }
-    if (searchRadius > 0) {
-        ne.setRadiusSearch(searchRadius);
+    const NeighbourGraph& graph = *neighbours;
+
+    std::size_t size = myPoints.size();
+    std::vector<Base::Vector3d> points(size);
+    for (std::size_t i = 0; i < size; i++) {
+        points[i] = myPoints.getPoint(int(i));
     }
-    ne.compute(*cloud_normals);
 
-    normals.reserve(cloud_normals->size());
-    for (pcl::PointCloud<pcl::Normal>::const_iterator it = cloud_normals->begin();
-         it != cloud_normals->end();
-         ++it) {
-        normals.push_back(Base::Vector3d(it->normal_x, it->normal_y, it->normal_z));
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    normals.assign(size, Base::Vector3d(nan, nan, nan));
+    forEachChunk(size, [&](std::size_t first, std::size_t last) {
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+        for (std::size_t i = first; i < last; i++) {
+            std::size_t begin = graph.offsets[i];
+            std::size_t end = graph.offsets[i + 1];
+            if (end - begin < 3) {
+                continue;
+            }
+
+            // The covariance of the neighbours around their centroid
+            Base::Vector3d mean;
+            for (std::size_t j = begin; j < end; j++) {
+                mean += points[graph.indices[j]];
+            }
+            mean /= double(end - begin);
+
+            double xx = 0.0, xy = 0.0, xz = 0.0, yy = 0.0, yz = 0.0, zz = 0.0;
+            for (std::size_t j = begin; j < end; j++) {
+                Base::Vector3d d = points[graph.indices[j]] - mean;
+                xx += d.x * d.x;
+                xy += d.x * d.y;
+                xz += d.x * d.z;
+                yy += d.y * d.y;
+                yz += d.y * d.z;
+                zz += d.z * d.z;
+            }
+            if (xx + yy + zz <= 0.0) {
+                continue;
+            }
+
+            Eigen::Matrix3d cov;
+            cov << xx, xy, xz, xy, yy, yz, xz, yz, zz;
+            // the closed-form solution, the eigenvalues are in increasing order
+            solver.computeDirect(cov);
+            Eigen::Vector3d normal = solver.eigenvectors().col(0);
+            normals[i].Set(normal.x(), normal.y(), normal.z());
+        }
+    });
+
+    if (orient) {
+        orientNormals(graph, points, normals);
     }
 }
 
-#endif  // HAVE_PCL_FILTERS
+void NormalEstimation::orientNormals(const NeighbourGraph& graph,
+                                     const std::vector<Base::Vector3d>& points,
+                                     std::vector<Base::Vector3d>& normals) const
+{
+    // The orientation spreads from the top of each connected part in waves through the
+    // neighbourhoods. A point takes the orientation of the point of the previous wave whose
+    // normal is most parallel to its own, which mostly follows the edges a minimum spanning tree
+    // would use but processes each wave in parallel.
+    std::size_t size = normals.size();
+    std::vector<char> done(size, 0);
+    std::vector<unsigned long> order;
+    for (std::size_t i = 0; i < size; i++) {
+        if (std::isnan(normals[i].x)) {
+            done[i] = 1;
+        }
+        else {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&points](unsigned long a, unsigned long b) {
+        return points[a].z > points[b].z;
+    });
+
+    std::vector<double> weight(size, -1.0);
+    std::vector<unsigned long> parent(size, 0);
+    std::vector<unsigned long> front;
+    std::vector<unsigned long> next;
+    for (unsigned long seed : order) {
+        if (done[seed] != 0) {
+            continue;
+        }
+
+        // the topmost point of a part is assumed to be seen from above
+        if (normals[seed].z < 0.0) {
+            normals[seed] = -normals[seed];
+        }
+        done[seed] = 1;
+        front.assign(1, seed);
+        while (!front.empty()) {
+            std::vector<std::vector<std::pair<unsigned long, unsigned long>>> parts(
+                (front.size() + chunkSize - 1) / chunkSize);
+            forEachChunk(front.size(), [&](std::size_t first, std::size_t last) {
+                auto& part = parts[first / chunkSize];
+                for (std::size_t i = first; i < last; i++) {
+                    unsigned long index = front[i];
+                    for (std::size_t j = graph.offsets[index]; j < graph.offsets[index + 1]; j++) {
+                        if (done[graph.indices[j]] == 0) {
+                            part.emplace_back(graph.indices[j], index);
+                        }
+                    }
+                }
+            });
+
+            next.clear();
+            for (const auto& part : parts) {
+                for (const auto& it : part) {
+                    double value = std::fabs(normals[it.first] * normals[it.second]);
+                    if (weight[it.first] < 0.0) {
+                        next.push_back(it.first);
+                    }
+                    if (value > weight[it.first]) {
+                        weight[it.first] = value;
+                        parent[it.first] = it.second;
+                    }
+                }
+            }
+
+            forEachChunk(next.size(), [&](std::size_t first, std::size_t last) {
+                for (std::size_t i = first; i < last; i++) {
+                    unsigned long index = next[i];
+                    if (normals[index] * normals[parent[index]] < 0.0) {
+                        normals[index] = -normals[index];
+                    }
+                    done[index] = 1;
+                }
+            });
+            front.swap(next);
+        }
+    }
+}
@@ -24,6 +24,7 @@
 #define REEN_SEGMENTATION_H
 
 #include <list>
+#include <memory>
 #include <vector>
 
 #include <Base/Vector3D.h>
@@ -51,6 +52,29 @@ private:
     std::list<std::vector<int>>& myClusters;
 };
 
+/**
+ * The neighbours of all points of a point kernel in compressed rows: the neighbours of the point
+ * \a i are indices[offsets[i]] to indices[offsets[i + 1] - 1] sorted by their distance, a point
+ * is a neighbour of itself. It can be kept to run further steps on the same neighbourhoods without
+ * searching them again.
+ */
+struct NeighbourGraph
+{
+    std::vector<std::size_t> offsets;
+    std::vector<unsigned long> indices;
+
+    std::size_t size() const
+    {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+};
+
+/**
+ * Estimates the normals of a point cloud by the covariance of the neighbours of each point. The
+ * neighbours are searched in a PointsOctree and the normals are computed on several threads.
+ * Afterwards they are oriented consistently by propagating the orientation through the
+ * neighbour graph.
+ */
 class NormalEstimation
 {
 public:
@@ -72,15 +96,46 @@ public:
         searchRadius = radius;
     }
 
-    /** \brief Perform the normal estimation.
+    /** \brief Set whether the normals are oriented consistently, enabled by default.
+     */
+    inline void setOrientNormals(bool on)
+    {
+        orient = on;
+    }
+
+    /** \brief Use the given neighbours instead of searching them, e.g. the graph of an earlier run.
+     * \param[in] graph the neighbours of all points of the kernel
+     */
+    inline void setNeighbours(const std::shared_ptr<const NeighbourGraph>& graph)
+    {
+        neighbours = graph;
+    }
+
+    /** \brief Returns the neighbours that were used by the last estimation.
+     */
+    inline const std::shared_ptr<const NeighbourGraph>& getNeighbours() const
+    {
+        return neighbours;
+    }
+
+    /** \brief Perform the normal estimation. Points with less than three neighbours get a NaN
+     * normal.
      * \param[out] the estimated normals
      */
     void perform(std::vector<Base::Vector3d>& normals);
 
+private:
+    std::shared_ptr<const NeighbourGraph> searchNeighbours() const;
+    void orientNormals(const NeighbourGraph&,
+                       const std::vector<Base::Vector3d>& points,
+                       std::vector<Base::Vector3d>& normals) const;
+
 private:
     const Points::PointKernel& myPoints;
+    std::shared_ptr<const NeighbourGraph> neighbours;
     int kSearch;
     double searchRadius;
+    bool orient;
 };
 
 }  // namespace Reen
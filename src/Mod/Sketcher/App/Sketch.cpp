@@ -72,6 +72,7 @@ Sketch::Sketch()
     , ConstraintsCounter(0)
     , isInitMove(false)
     , isFine(true)
+    , fastDragging(false)
     , moveStep(0)
     , defaultSolver(GCS::DogLeg)
     , defaultSolverRedundant(GCS::DogLeg)
@@ -1709,6 +1710,53 @@ std::vector<Part::Geometry*> Sketch::extractGeometry(bool withConstructionElemen
     return temp;
 }
 
+bool Sketch::matchesGeometry(const std::vector<Part::Geometry*>& geoList) const
+{
+    std::size_t i = 0;
+    for (const auto& geom : Geoms) {
+        if (geom.external) {
+            break;
+        }
+        if (i >= geoList.size() || geoList[i]->getTypeId() != geom.geo->getTypeId()) {
+            return false;
+        }
+        ++i;
+    }
+    return i == geoList.size();
+}
+
+bool Sketch::isGeometryChanged(const std::vector<Part::Geometry*>& geoList) const
+{
+    for (std::size_t i = 0; i < geoList.size(); i++) {
+        if (!Geoms[i].geo->isSame(*geoList[i], Precision::Confusion(), Precision::Angular())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Sketch::updateGeometry(const std::vector<Part::Geometry*>& geoList)
+{
+    for (std::size_t i = 0; i < geoList.size(); i++) {
+        if (Geoms[i].geo->isSame(*geoList[i], Precision::Confusion(), Precision::Angular())) {
+            continue;
+        }
+        // the update functions write the solver parameters into the geometry of the definition
+        GeoDef def = Geoms[i];
+        def.geo = geoList[i];
+        try {
+            updateGeometry(def);
+        }
+        catch (Base::Exception& e) {
+            Base::Console().error("Updating geometry: Error build geometry(%d): %s\n",
+                                  int(i),
+                                  e.what());
+            return false;
+        }
+    }
+    return true;
+}
+
 GeoListFacade Sketch::extractGeoListFacade() const
 {
     std::vector<GeometryFacadeUniquePtr> temp;
@@ -4601,7 +4649,7 @@ int Sketch::internalSolve(std::string& solvername, int level)
 
     if (isInitMove) {
         solvername = "DogLeg";  // DogLeg is used for dragging (same as before)
-        ret = GCSsys.solve(isFine, GCS::DogLeg);
+        ret = fastDragging ? GCSsys.solveDrag(isFine) : GCSsys.solve(isFine, GCS::DogLeg);
     }
     else {
         switch (defaultSolver) {
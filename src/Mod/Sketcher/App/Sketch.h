@@ -94,6 +94,15 @@ public:
     /// returns the actual geometry
     std::vector<Part::Geometry*> extractGeometry(bool withConstructionElements = true,
                                                  bool withExternalElements = false) const;
+    /// whether \a geoList has the types of the internal geometries of the sketch in the same
+    /// order, so that the solved geometry can be written into it
+    bool matchesGeometry(const std::vector<Part::Geometry*>& geoList) const;
+    /// whether the solved geometry differs from \a geoList, which must match the sketch
+    bool isGeometryChanged(const std::vector<Part::Geometry*>& geoList) const;
+    /** writes the solved geometry directly into the changed geometries of \a geoList instead of
+     *  cloning it, \a geoList must match the sketch. The geometries keep their extensions.
+     */
+    bool updateGeometry(const std::vector<Part::Geometry*>& geoList);
 
     GeoListFacade extractGeoListFacade() const;
 
@@ -136,6 +145,10 @@ public:
     {
         return SolveTime;
     }
+    inline GCS::System::SolveStatistics getSolveStatistics() const
+    {
+        return GCSsys.getSolveStatistics();
+    }
 
     inline bool hasMalformedConstraints() const
     {
@@ -597,6 +610,7 @@ private:
 
     bool isInitMove;
     bool isFine;
+    bool fastDragging;
     Base::Vector3d initToPoint;
     double moveStep;
 
@@ -648,6 +662,19 @@ public:
     {
         return GCSsys.qrAlgorithm;
     }
+    inline void setIncrementalDiagnosis(bool on)
+    {
+        GCSsys.incrementalDiagnosis = on;
+    }
+    /// if true the moves use GCS::System::solveDrag() within the per move time budget in seconds
+    inline void setFastDragging(bool on)
+    {
+        fastDragging = on;
+    }
+    inline void setDragTimeBudget(double seconds)
+    {
+        GCSsys.dragTimeBudget = seconds;
+    }
     inline void setQRPivotThreshold(double val)
     {
         GCSsys.qrpivotThreshold = val;
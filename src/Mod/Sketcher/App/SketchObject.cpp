@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <numeric>
 #include <vector>
 
 #include <BRepAdaptor_Curve.hxx>
@@ -321,14 +322,174 @@ static bool inline checkSmallEdge(const Part::TopoShape &s) {
 }
 
 // clang-format on
+class SketchObject::ShapeCache
+{
+public:
+    // marks all edges as unused, the edges that aren't used until endBuild() are removed
+    void beginBuild()
+    {
+        for (auto& entry : edges) {
+            entry.second.used = false;
+        }
+    }
+
+    void endBuild()
+    {
+        for (auto it = edges.begin(); it != edges.end();) {
+            if (it->second.used) {
+                ++it;
+            }
+            else {
+                it = edges.erase(it);
+            }
+        }
+    }
+
+    // the edge of the geometry, which is only built again if the geometry changed
+    const Part::TopoShape&
+    getEdge(const SketchObject& sketch, const Part::Geometry* geo, const std::string& name)
+    {
+        Edge& edge = edges[name];
+        edge.used = true;
+        edge.changed = !edge.geometry || edge.geometry->getTypeId() != geo->getTypeId()
+            || !edge.geometry->isSame(*geo, 0.0, 0.0);
+        if (edge.changed) {
+            edge.shape = sketch.getEdge(geo, name.c_str());
+            edge.geometry.reset(geo->clone());
+        }
+        return edge.shape;
+    }
+
+    // joins the edges with the names to wires like TopoShape::makeElementWires() does, but only
+    // the wires of changed edges are built again
+    std::vector<Part::TopoShape> makeWires(const std::vector<Part::TopoShape>& shapes,
+                                           const std::vector<std::string>& names,
+                                           const App::StringHasherRef& hasher)
+    {
+        if (static_cast<App::StringHasher*>(hasher) != wireHasher) {
+            wires.clear();
+            wireHasher = static_cast<App::StringHasher*>(hasher);
+        }
+
+        // makeElementWires() connects the next free edge in the order of the edges to all
+        // edges it touches, so the wire of a group of connected edges is the same as the one
+        // of all edges
+        std::map<std::vector<std::string>, Part::TopoShape> newWires;
+        std::vector<Part::TopoShape> result;
+        for (const auto& group : connectedEdges(shapes)) {
+            std::vector<std::string> key;
+            bool changed = false;
+            for (int index : group) {
+                key.push_back(names[index]);
+                changed = changed || edges[names[index]].changed;
+            }
+            auto it = changed ? wires.end() : wires.find(key);
+            if (it != wires.end()) {
+                result.push_back(it->second);
+            }
+            else {
+                std::vector<Part::TopoShape> groupShapes;
+                for (int index : group) {
+                    groupShapes.push_back(shapes[index]);
+                }
+                auto wire =
+                    Part::TopoShape(0, hasher).makeElementWires(groupShapes, Part::OpCodes::Sketch);
+                if (wire.shapeType() != TopAbs_WIRE) {
+                    // the grouping joined edges that aren't connected for the wire maker, so
+                    // the wires are made of all edges
+                    wires.clear();
+                    return Part::TopoShape(0, hasher)
+                        .makeElementWires(shapes, Part::OpCodes::Sketch)
+                        .getSubTopoShapes(TopAbs_WIRE);
+                }
+                result.push_back(wire);
+            }
+            newWires.emplace(std::move(key), result.back());
+        }
+        wires = std::move(newWires);
+        return result;
+    }
+
+private:
+    // the groups of the edges that touch each other, in the order of their first edge
+    static std::vector<std::vector<int>> connectedEdges(const std::vector<Part::TopoShape>& shapes)
+    {
+        // larger than the vertex tolerance of the wire maker, so that a group never splits a wire
+        const double tol = 10 * Precision::Confusion();
+
+        std::vector<std::pair<gp_Pnt, int>> points;
+        for (int i = 0; i < int(shapes.size()); i++) {
+            for (TopExp_Explorer xp(shapes[i].getShape(), TopAbs_VERTEX); xp.More(); xp.Next()) {
+                points.emplace_back(BRep_Tool::Pnt(TopoDS::Vertex(xp.Current())), i);
+            }
+        }
+        std::sort(points.begin(), points.end(), [](const auto& a, const auto& b) {
+            return a.first.X() < b.first.X();
+        });
+
+        std::vector<int> parent(shapes.size());
+        std::iota(parent.begin(), parent.end(), 0);
+        auto find = [&parent](int i) {
+            while (parent[i] != i) {
+                parent[i] = parent[parent[i]];
+                i = parent[i];
+            }
+            return i;
+        };
+        for (std::size_t i = 0; i < points.size(); i++) {
+            for (std::size_t j = i + 1;
+                 j < points.size() && points[j].first.X() - points[i].first.X() <= tol;
+                 j++) {
+                if (points[i].first.SquareDistance(points[j].first) <= tol * tol) {
+                    int a = find(points[i].second);
+                    int b = find(points[j].second);
+                    parent[std::max(a, b)] = std::min(a, b);
+                }
+            }
+        }
+
+        std::vector<std::vector<int>> groups;
+        std::vector<int> groupOf(shapes.size(), -1);
+        for (int i = 0; i < int(shapes.size()); i++) {
+            int root = find(i);
+            if (groupOf[root] < 0) {
+                groupOf[root] = int(groups.size());
+                groups.emplace_back();
+            }
+            groups[groupOf[root]].push_back(i);
+        }
+        return groups;
+    }
+
+    struct Edge
+    {
+        std::unique_ptr<Part::Geometry> geometry;
+        Part::TopoShape shape;
+        bool used = false;
+        bool changed = true;
+    };
+
+    // by the name of the edge
+    std::map<std::string, Edge> edges;
+    // by the names of their edges
+    std::map<std::vector<std::string>, Part::TopoShape> wires;
+    const App::StringHasher* wireHasher = nullptr;
+};
+
 void SketchObject::buildShape()
 {
     // We use the following instead to map element names
 
     std::vector<Part::TopoShape> shapes;
+    std::vector<std::string> edgeNames;
     std::vector<Part::TopoShape> vertices;
     int geoId = 0;
 
+    if (!shapeCache) {
+        shapeCache = std::make_unique<ShapeCache>();
+    }
+    shapeCache->beginBuild();
+
     auto addVertex = [&vertices](auto vertex, auto name) {
         if (!vertex.hasElementMap()) {
             vertex.resetElementMap(std::make_shared<Data::ElementMap>());
@@ -340,16 +501,16 @@ void SketchObject::buildShape()
         vertices.back().copyElementMap(vertex, Part::OpCodes::Sketch);
     };
 
-    auto addEdge = [this, &shapes](auto geo, auto indexedName) {
-        shapes.push_back(getEdge(geo, convertSubName(indexedName, false).c_str()));
+    auto addEdge = [this, &shapes, &edgeNames](auto geo, auto indexedName) {
+        edgeNames.push_back(convertSubName(indexedName, false));
+        shapes.push_back(shapeCache->getEdge(*this, geo, edgeNames.back()));
         if (checkSmallEdge(shapes.back())) {
             FC_WARN("Edge too small: " << indexedName);
         }
     };
 
-    // get the geometry after running the solver
-    auto geometries = solvedSketch.extractGeometry();
-    for (auto geo : geometries) {
+    // the geometry after running the solver, which solve() has set
+    for (auto geo : getInternalGeometry()) {
         ++geoId;
         if (GeometryFacade::getConstruction(geo)) {
             continue;
@@ -365,10 +526,6 @@ void SketchObject::buildShape()
         }
     }
 
-    for (auto geo : geometries) {
-        delete geo;
-    }
-
     for (int i = 2; i < ExternalGeo.getSize(); ++i) {
         auto geo = ExternalGeo[i];
         auto egf = ExternalGeometryFacade::getFacade(geo);
@@ -388,6 +545,7 @@ void SketchObject::buildShape()
     }
 
     internalElementMap.clear();
+    shapeCache->endBuild();
 
     if (shapes.empty() && vertices.empty()) {
         InternalShape.setValue(Part::TopoShape());
@@ -397,7 +555,9 @@ void SketchObject::buildShape()
     Part::TopoShape result(0, getDocument()->getStringHasher());
     if (vertices.empty()) {
         // Notice here we supply op code Part::OpCodes::Sketch to makEWires().
-        result.makeElementWires(shapes, Part::OpCodes::Sketch);
+        result.makeElementCompound(shapeCache->makeWires(shapes, edgeNames, result.Hasher),
+                                   nullptr,
+                                   Part::TopoShape::SingleShapeCompoundCreationPolicy::returnShape);
     }
     else {
         std::vector<Part::TopoShape> results;
@@ -407,10 +567,8 @@ void SketchObject::buildShape()
             // SketchObject::getElementName() relies on this op code to
             // differentiate geometries that are exposed with those in edit
             // mode.
-            auto wires = Part::TopoShape().makeElementWires(shapes, Part::OpCodes::Sketch);
-            for (const auto& wire : wires.getSubTopoShapes(TopAbs_WIRE)) {
-                results.push_back(wire);
-            }
+            auto wires = shapeCache->makeWires(shapes, edgeNames, App::StringHasherRef());
+            results.insert(results.end(), wires.begin(), wires.end());
         }
         results.insert(results.end(), vertices.begin(), vertices.end());
         result.makeElementCompound(results);
@@ -520,6 +678,29 @@ void SketchObject::retrieveSolverDiagnostics()
     lastMalformedConstraints = solvedSketch.getMalformedConstraints();
 }
 
+void SketchObject::setSolvedGeometry(bool onlyIfChanged)
+{
+    const std::vector<Part::Geometry*>& geometries = Geometry.getValues();
+    if (solvedSketch.matchesGeometry(geometries)) {
+        // write the solved geometry into the existing geometries, which avoids cloning all of
+        // them and comparing the clones to the property
+        if (!onlyIfChanged || solvedSketch.isGeometryChanged(geometries)) {
+            Geometry.modifyValues([this](const std::vector<Part::Geometry*>& values) {
+                solvedSketch.updateGeometry(values);
+            });
+        }
+        return;
+    }
+
+    std::vector<Part::Geometry*> geomlist = solvedSketch.extractGeometry();
+    Part::PropertyGeometryList tmp;
+    tmp.setValues(std::move(geomlist));
+    // Only set values if there is actual changes
+    if (!onlyIfChanged || !Geometry.isSame(tmp)) {
+        Geometry.moveValues(std::move(tmp));
+    }
+}
+
 int SketchObject::solve(bool updateGeoAfterSolving /*=true*/)
 {
     // no need to check input data validity as this is an sketchobject managed operation.
@@ -603,13 +784,7 @@ int SketchObject::solve(bool updateGeoAfterSolving /*=true*/)
         FullyConstrained.setValue(lastDoF == 0);
         if (updateGeoAfterSolving) {
             // set the newly solved geometry
-            std::vector<Part::Geometry*> geomlist = solvedSketch.extractGeometry();
-            Part::PropertyGeometryList tmp;
-            tmp.setValues(std::move(geomlist));
-            // Only set values if there is actual changes
-            if (Constraints.isTouched() || !Geometry.isSame(tmp)) {
-                Geometry.moveValues(std::move(tmp));
-            }
+            setSolvedGeometry(!Constraints.isTouched());
         }
     }
 
@@ -1472,13 +1647,7 @@ int SketchObject::moveGeometries(const std::vector<GeoElementId>& geoEltIds, con
     // or a redundancy that we did not have before, or a change of DoF
 
     if (lastSolverStatus == 0) {
-        std::vector<Part::Geometry*> geomlist = solvedSketch.extractGeometry();
-        Geometry.setValues(geomlist);
-        for (auto* geo :  geomlist) {
-            if (geo){
-                delete geo;
-            }
-        }
+        setSolvedGeometry(false);
     }
 
     solvedSketch.resetInitMove();// reset solver point moving mechanism
@@ -8758,6 +8927,85 @@ void processFace (const Rotation& invRot,
 
 }
 
+class SketchObject::ExternalCache
+{
+public:
+    // marks all projections as unused, the ones that aren't used until endBuild() are removed
+    void beginBuild()
+    {
+        for (auto& entry : projections) {
+            entry.second.used = false;
+        }
+    }
+
+    void endBuild()
+    {
+        for (auto it = projections.begin(); it != projections.end();) {
+            if (it->second.used) {
+                ++it;
+            }
+            else {
+                it = projections.erase(it);
+            }
+        }
+    }
+
+    // the geometries of the reference key, if they were made from the same sub-shape, which
+    // holds the same TShape and location, with the same settings
+    const std::vector<std::unique_ptr<Part::Geometry>>* find(const std::string& key,
+                                                             const TopoDS_Shape& shape,
+                                                             const Base::Placement& placement,
+                                                             long type,
+                                                             double arcFitTolerance)
+    {
+        auto it = projections.find(key);
+        if (it == projections.end()) {
+            return nullptr;
+        }
+        Projection& projection = it->second;
+        projection.used = true;
+        if (!projection.shape.IsEqual(shape) || projection.placement != placement
+            || projection.type != type || projection.arcFitTolerance != arcFitTolerance) {
+            return nullptr;
+        }
+        return &projection.geos;
+    }
+
+    void insert(const std::string& key,
+                const TopoDS_Shape& shape,
+                const Base::Placement& placement,
+                long type,
+                double arcFitTolerance,
+                const std::vector<std::unique_ptr<Part::Geometry>>& geos)
+    {
+        // the cached shape keeps its TShape alive, so that no other shape can get its address
+        Projection& projection = projections[key];
+        projection.shape = shape;
+        projection.placement = placement;
+        projection.type = type;
+        projection.arcFitTolerance = arcFitTolerance;
+        projection.geos.clear();
+        for (const auto& geo : geos) {
+            projection.geos.emplace_back(geo->clone());
+        }
+        projection.used = true;
+    }
+
+private:
+    struct Projection
+    {
+        TopoDS_Shape shape;
+        Base::Placement placement;
+        long type = 0;
+        double arcFitTolerance = 0.0;
+        std::vector<std::unique_ptr<Part::Geometry>> geos;
+        bool used = false;
+    };
+
+    // by the reference key
+    std::map<std::string, Projection> projections;
+};
+
 void SketchObject::rebuildExternalGeometry(std::optional<ExternalToAdd> extToAdd)
 {
     Base::StateLocker lock(managedoperation, true); // no need to check input data validity as this is an sketchobject managed operation.
@@ -8830,6 +9078,11 @@ void SketchObject::rebuildExternalGeometry(std::optional<ExternalToAdd> extToAdd
 
     Types.resize(Objects.size(), static_cast<long>(ExtType::Projection));
 
+    if (!externalCache) {
+        externalCache = std::make_unique<ExternalCache>();
+    }
+    externalCache->beginBuild();
+
     std::set<std::string> refSet;
     // We use a vector here to keep the order (roughly) the same as ExternalGeometry
     std::vector<std::vector<std::unique_ptr<Part::Geometry> > > newGeos;
@@ -8946,6 +9199,19 @@ void SketchObject::rebuildExternalGeometry(std::optional<ExternalToAdd> extToAdd
                     "Datum feature type is not yet supported as external geometry for a sketch");
             }
 
+            // the geometries of a new reference get their flags below, so they aren't cached
+            if (!beingCreated) {
+                if (auto cached = externalCache->find(
+                        key, refSubShape, Plm, Types[i], ArcFitTolerance.getValue())) {
+                    for (const auto& geo : *cached) {
+                        geos.emplace_back(geo->clone());
+                    }
+                    projection = false;
+                    intersection = false;
+                }
+            }
+            bool cacheResult = !beingCreated && geos.empty() && !refSubShape.IsNull();
+
             if (projection && !refSubShape.IsNull()) {
                 switch (refSubShape.ShapeType()) {
                 case TopAbs_FACE: {
@@ -9016,6 +9282,11 @@ void SketchObject::rebuildExternalGeometry(std::optional<ExternalToAdd> extToAdd
                 }
             }
 
+            if (cacheResult) {
+                externalCache->insert(
+                    key, refSubShape, Plm, Types[i], ArcFitTolerance.getValue(), geos);
+            }
+
         } catch (Base::Exception &e) {
             FC_ERR("Failed to project external geometry in "
                    << getFullName() << ": " << key << std::endl << e.what());
@@ -9047,6 +9318,7 @@ void SketchObject::rebuildExternalGeometry(std::optional<ExternalToAdd> extToAdd
         }
         newGeos.push_back(std::move(geos));
     }
+    externalCache->endBuild();
 
     // allocate unique geometry id
     for(auto &geos : newGeos) {
@@ -1009,6 +1009,9 @@ protected:
     // retrieves redundant, conflicting and malformed constraint information from the solver
     void retrieveSolverDiagnostics();
 
+    // sets the Geometry property to the geometry of the solver, if possible in place
+    void setSolvedGeometry(bool onlyIfChanged);
+
     // retrieves whether a geometry blocked state corresponds to this constraint
     // returns true of the constraint is of Block type, false otherwise
     bool getBlockedState(const Constraint* cstr, bool& blockedstate) const;
@@ -1136,6 +1139,14 @@ private:
     class GeoHistory;
     std::unique_ptr<GeoHistory> geoHistory;
 
+    // the edges and wires of the last buildShape() to build only the changed ones again
+    class ShapeCache;
+    std::unique_ptr<ShapeCache> shapeCache;
+
+    // the projections of the last rebuildExternalGeometry() to project only the changed ones again
+    class ExternalCache;
+    std::unique_ptr<ExternalCache> externalCache;
+
     mutable std::map<std::string, std::string> internalElementMap;
 };
 
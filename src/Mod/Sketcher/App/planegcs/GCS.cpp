@@ -47,10 +47,16 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <future>
 #include <iostream>
 #include <limits>
 #include <numbers>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "GCS.h"
 #include "qp_eq.h"
@@ -471,6 +477,8 @@ System::System()
     , hasDiagnosis(false)
     , isInit(false)
     , emptyDiagnoseMatrix(true)
+    , diagnosedRows(0)
+    , diagnosedCols(0)
     , maxIter(100)
     , maxIterRedundant(100)
     , sketchSizeMultiplier(false)
@@ -478,6 +486,9 @@ System::System()
     , convergence(1e-10)
     , convergenceRedundant(1e-10)
     , qrAlgorithm(EigenSparseQR)
+    , incrementalDiagnosis(false)
+    , parallelSolveParams(64)
+    , dragTimeBudget(0.025)
     , dogLegGaussStep(FullPivLU)
     , qrpivotThreshold(1E-13)
     , debugMode(Minimal)
@@ -1974,25 +1985,71 @@ int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
         return Failed;
     }
 
-    bool isReset = false;
-    // return success by default in order to permit coincidence constraints to be applied
-    // even if no other system has to be solved
-    int res = Success;
+    std::vector<int> clusters;
+    std::size_t paramsNum = 0;
     for (int cid = 0; cid < int(subSystems.size()); cid++) {
-        if ((subSystems[cid] || subSystemsAux[cid]) && !isReset) {
-            resetToReference();
-            isReset = true;
+        if (subSystems[cid] || subSystemsAux[cid]) {
+            clusters.push_back(cid);
+            paramsNum += plists[cid].size();
         }
-        if (subSystems[cid] && subSystemsAux[cid]) {
-            res = std::max(res,
-                           solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving));
-        }
-        else if (subSystems[cid]) {
-            res = std::max(res, solve(subSystems[cid], isFine, alg, isRedundantsolving));
+    }
+    if (!clusters.empty()) {
+        resetToReference();
+    }
+
+    // The clusters don't share any parameters and their subsystems work on their own copies of the
+    // parameters until the solution is applied, so they are solved in parallel. The results don't
+    // depend on the order as they are combined afterwards.
+    std::vector<int> results(clusters.size(), Success);
+    std::vector<std::exception_ptr> errors(clusters.size());
+    std::atomic<std::size_t> next {0};
+    auto work = [&]() {
+        for (std::size_t i = next++; i < clusters.size(); i = next++) {
+            int cid = clusters[i];
+            try {
+                if (subSystems[cid] && subSystemsAux[cid]) {
+                    results[i] =
+                        solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving);
+                }
+                else if (subSystems[cid]) {
+                    results[i] = solve(subSystems[cid], isFine, alg, isRedundantsolving);
+                }
+                else {
+                    results[i] = solve(subSystemsAux[cid], isFine, alg, isRedundantsolving);
+                }
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+            }
         }
-        else if (subSystemsAux[cid]) {
-            res = std::max(res, solve(subSystemsAux[cid], isFine, alg, isRedundantsolving));
+    };
+
+    std::size_t threads = 1;
+#ifndef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
+    // the iteration log uses Base::Console, which isn't thread-safe
+    if (parallelSolveParams > 0 && debugMode != IterationLevel) {
+        threads = std::min({std::size_t(std::max(std::thread::hardware_concurrency(), 1U)),
+                            clusters.size(),
+                            paramsNum / std::size_t(parallelSolveParams)});
+    }
+#endif
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < threads; i++) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // return success by default in order to permit coincidence constraints to be applied
+    // even if no other system has to be solved
+    int res = Success;
+    for (std::size_t i = 0; i < clusters.size(); i++) {
+        if (errors[i]) {
+            std::rethrow_exception(errors[i]);
         }
+        res = std::max(res, results[i]);
     }
     if (res == Success) {
         for (std::set<Constraint*>::const_iterator constr = redundant.begin();
@@ -2082,7 +2139,8 @@ int System::solve_BFGS(SubSystem* subsys, bool /*isFine*/, bool isRedundantsolvi
     double divergingLim = 1e6 * err + 1e12;
     double h_norm {};
 
-    for (int iter = 1; iter < maxIterNumber; ++iter) {
+    int iter = 1;
+    for (; iter < maxIterNumber; ++iter) {
         h_norm = h.norm();
         if (h_norm <= convCriterion || err <= smallF) {
             if (debugMode == IterationLevel) {
@@ -2144,6 +2202,7 @@ int System::solve_BFGS(SubSystem* subsys, bool /*isFine*/, bool isRedundantsolvi
         }
     }
 
+    subsys->iterations = iter;
     subsys->revertParams();
 
     if (err <= smallF) {
@@ -2330,6 +2389,7 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         stop = 5;
     }
 
+    subsys->iterations = iter;
     subsys->revertParams();
 
     return (stop == 1) ? Success : Failed;
@@ -2539,6 +2599,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
         iter++;
     }
 
+    subsys->iterations = iter;
     subsys->revertParams();
 
     if (debugMode == IterationLevel) {
@@ -4606,29 +4667,32 @@ void System::extractSubsystem(SubSystem* subsys, bool isRedundantsolving)
 
 // The following solver variant solves a system compound of two subsystems
 // treating the first of them as of higher priority than the second
-int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool /*isFine*/, bool isRedundantsolving)
+namespace
 {
-    int xsizeA = subsysA->pSize();
-    int xsizeB = subsysB->pSize();
-    int csizeA = subsysA->cSize();
 
-    VEC_pD plistAB(xsizeA + xsizeB);
-    {
-        VEC_pD plistA, plistB;
-        subsysA->getParamList(plistA);
-        subsysB->getParamList(plistB);
+VEC_pD unitedParamList(SubSystem* subsysA, SubSystem* subsysB)
+{
+    VEC_pD plistAB(subsysA->pSize() + subsysB->pSize());
+    VEC_pD plistA, plistB;
+    subsysA->getParamList(plistA);
+    subsysB->getParamList(plistB);
 
-        std::sort(plistA.begin(), plistA.end());
-        std::sort(plistB.begin(), plistB.end());
+    std::sort(plistA.begin(), plistA.end());
+    std::sort(plistB.begin(), plistB.end());
 
-        VEC_pD::const_iterator it;
-        it = std::set_union(plistA.begin(),
-                            plistA.end(),
-                            plistB.begin(),
-                            plistB.end(),
-                            plistAB.begin());
-        plistAB.resize(it - plistAB.begin());
-    }
+    VEC_pD::const_iterator it;
+    it = std::set_union(plistA.begin(), plistA.end(), plistB.begin(), plistB.end(), plistAB.begin());
+    plistAB.resize(it - plistAB.begin());
+    return plistAB;
+}
+
+}  // namespace
+
+int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool /*isFine*/, bool isRedundantsolving)
+{
+    int csizeA = subsysA->cSize();
+
+    VEC_pD plistAB = unitedParamList(subsysA, subsysB);
     int xsize = plistAB.size();
 
     Eigen::MatrixXd B = Eigen::MatrixXd::Identity(xsize, xsize);
@@ -4665,7 +4729,8 @@ int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool /*isFine*/, bool
 
     double mu = 0;
     lambda.setZero();
-    for (int iter = 1; iter < maxIterNumber; iter++) {
+    int iter = 1;
+    for (; iter < maxIterNumber; iter++) {
         int status = qp_eq(B, grad, JA, resA, xdir, Y, Z);
         if (status) {
             break;
@@ -4771,11 +4836,293 @@ int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool /*isFine*/, bool
         ret = Failed;
     }
 
+    subsysA->iterations = iter;
+    subsysB->iterations = 0;
+    subsysA->revertParams();
+    subsysB->revertParams();
+    return ret;
+}
+
+int System::solveDrag(bool isFine)
+{
+    if (!isInit) {
+        return Failed;
+    }
+
+    auto deadline = std::chrono::steady_clock::time_point::max();
+    if (dragTimeBudget > 0) {
+        deadline = std::chrono::steady_clock::now()
+            + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                       std::chrono::duration<double>(dragTimeBudget));
+    }
+
+    dragStates.resize(subSystems.size());
+    int res = Success;
+    for (int cid = 0; cid < int(subSystems.size()); cid++) {
+        if (subSystems[cid] && subSystemsAux[cid]) {
+            DragState& state = dragStates[cid];
+            int ret = solveDrag(subSystems[cid], subSystemsAux[cid], state, deadline);
+            if (ret != Success && !state.hasIterate) {
+                // fall back to the regular solve from the reference of the cluster
+                state = DragState();
+                if (reference.size() == plist.size()) {
+                    for (const auto param : plists[cid]) {
+                        *param = reference[pIndex[param]];
+                    }
+                }
+                ret = solve(subSystems[cid], subSystemsAux[cid], isFine);
+            }
+            res = std::max(res, ret);
+        }
+        else if (subSystems[cid]) {
+            res = std::max(res, solve(subSystems[cid], isFine, DogLeg));
+        }
+        else if (subSystemsAux[cid]) {
+            res = std::max(res, solve(subSystemsAux[cid], isFine, DogLeg));
+        }
+    }
+    if (res == Success) {
+        for (const auto constr : redundant) {
+            double err = constr->error();
+            if (err * err > convergence) {
+                return Converged;
+            }
+        }
+    }
+    return res;
+}
+
+// The variant of solve(subsysA, subsysB) for dragging, it keeps the buffers, the approximation of
+// the Hessian and the factorization of the Jacobian of subsysA in the state
+int System::solveDrag(SubSystem* subsysA,
+                      SubSystem* subsysB,
+                      DragState& state,
+                      std::chrono::steady_clock::time_point deadline)
+{
+    if (state.plistAB.empty()) {
+        state.plistAB = unitedParamList(subsysA, subsysB);
+        int xsize = int(state.plistAB.size());
+        int csizeA = subsysA->cSize();
+        state.B = Eigen::MatrixXd::Identity(xsize, xsize);
+        state.JA.resize(csizeA, xsize);
+        for (auto vec : {&state.resA, &state.lambda, &state.lambda0, &state.lambdadir}) {
+            vec->resize(csizeA);
+        }
+        for (auto vec : {&state.x,
+                         &state.x0,
+                         &state.xdir,
+                         &state.xdir1,
+                         &state.grad,
+                         &state.h,
+                         &state.y,
+                         &state.Bh}) {
+            vec->resize(xsize);
+        }
+        state.isFactorized = false;
+        state.hasIterate = false;
+    }
+
+    VEC_pD& plistAB = state.plistAB;
+    Eigen::MatrixXd& B = state.B;
+    Eigen::MatrixXd& JA = state.JA;
+    Eigen::VectorXd& resA = state.resA;
+    Eigen::VectorXd& lambda = state.lambda;
+    Eigen::VectorXd& x = state.x;
+    Eigen::VectorXd& xdir = state.xdir;
+    Eigen::VectorXd& grad = state.grad;
+    Eigen::VectorXd& h = state.h;
+    int xsize = int(plistAB.size());
+
+    // We assume that there are no common constraints in subsysA and subsysB
+    subsysA->redirectParams();
+    subsysB->redirectParams();
+
+    if (state.hasIterate) {
+        subsysA->setParams(plistAB, x);
+    }
+    else {
+        subsysB->getParams(plistAB, x);
+        subsysA->getParams(plistAB, x);
+    }
+    subsysB->setParams(plistAB, x);  // just to ensure that A and B are synchronized
+    state.hasIterate = false;
+
+    subsysB->calcGrad(plistAB, grad);
+    subsysA->calcJacobi(plistAB, JA);
+    subsysA->calcResidual(resA);
+
+    bool isFresh = false;  // if the factorization is of the Jacobian at x
+    if (!state.isFactorized) {
+        if (qp_eq_factorize(JA, state.Y, state.Z)) {
+            subsysA->revertParams();
+            subsysB->revertParams();
+            return Failed;
+        }
+        state.isFactorized = true;
+        isFresh = true;
+    }
+
+    int maxIterNumber = (sketchSizeMultiplier ? maxIter * xsize : maxIter);
+
+    double divergingLim = 1e6 * subsysA->error() + 1e12;
+
+    double mu = 0;
+    lambda.setZero();
+    h.setZero();
+    int iter = 1;
+    for (; iter < maxIterNumber; iter++) {
+        bool isFreshStep = isFresh;
+        qp_eq_solve(B, grad, resA, state.Y, state.Z, xdir);
+
+        state.x0 = x;
+        state.lambda0 = lambda;
+        lambda = state.Y.transpose() * (B * xdir + grad);
+        state.lambdadir = lambda - state.lambda0;
+        double resNorm = resA.norm();
+
+        // line search, the same as in solve(subsysA, subsysB)
+        double alpha = 1;
+        {
+            double eta = 0.25;
+            double tau = 0.5;
+            double rho = 0.5;
+            alpha = std::min(alpha, subsysA->maxStep(plistAB, xdir));
+
+            // Eq. 18.36
+            mu = std::max(mu,
+                          (grad.dot(xdir) + std::max(0., 0.5 * xdir.dot(B * xdir)))
+                              / ((1. - rho) * resA.lpNorm<1>()));
+
+            // Eq. 18.27
+            double f0 = subsysB->error() + mu * resA.lpNorm<1>();
+
+            // Eq. 18.29
+            double deriv = grad.dot(xdir) - mu * resA.lpNorm<1>();
+
+            x = state.x0 + alpha * xdir;
+            subsysA->setParams(plistAB, x);
+            subsysB->setParams(plistAB, x);
+            subsysA->calcResidual(resA);
+            double f = subsysB->error() + mu * resA.lpNorm<1>();
+
+            // line search, Eq. 18.28
+            bool first = true;
+            while (f > f0 + eta * alpha * deriv) {
+                if (first) {
+                    state.xdir1 = -state.Y * resA;
+                    x += state.xdir1;  // = x0 + alpha * xdir + xdir1
+                    subsysA->setParams(plistAB, x);
+                    subsysB->setParams(plistAB, x);
+                    subsysA->calcResidual(resA);
+                    f = subsysB->error() + mu * resA.lpNorm<1>();
+                    if (f < f0 + eta * alpha * deriv) {
+                        break;
+                    }
+                }
+                alpha = tau * alpha;
+                if (alpha < 1e-8) {  // let the linesearch fail
+                    alpha = 0.;
+                }
+                x = state.x0 + alpha * xdir;
+                subsysA->setParams(plistAB, x);
+                subsysB->setParams(plistAB, x);
+                subsysA->calcResidual(resA);
+                f = subsysB->error() + mu * resA.lpNorm<1>();
+                if (alpha < 1e-8) {  // let the linesearch fail
+                    break;
+                }
+            }
+            lambda = state.lambda0 + alpha * state.lambdadir;
+        }
+        h = x - state.x0;
+
+        state.y = grad - JA.transpose() * lambda;
+        {
+            subsysB->calcGrad(plistAB, grad);
+            subsysA->calcJacobi(plistAB, JA);
+            subsysA->calcResidual(resA);
+        }
+        isFresh = false;
+        state.y = grad - JA.transpose() * lambda - state.y;  // Eq. 18.13
+
+        if (iter > 1) {
+            double yTh = state.y.dot(h);
+            if (yTh != 0) {
+                state.Bh = B * h;
+                // Now calculate the BFGS update on B
+                B += 1. / yTh * state.y * state.y.transpose();
+                B -= 1. / h.dot(state.Bh) * (state.Bh * state.Bh.transpose());
+            }
+        }
+
+        double err = subsysA->error();
+        bool converged = h.norm() <= convergence && err <= smallF;
+        if (converged && isFreshStep) {
+            break;
+        }
+        if (err > divergingLim || err != err) {  // check for diverging and NaN
+            break;
+        }
+
+        // A step of the factorization of an older Jacobian may stall the line search, so the
+        // convergence is only accepted after a step with a fresh one. It is also refreshed as soon
+        // as it doesn't halve the errors of the constraints anymore.
+        if (converged || alpha == 0. || (err > smallF && resA.norm() > 0.5 * resNorm)) {
+            if (qp_eq_factorize(JA, state.Y, state.Z)) {
+                state.isFactorized = false;
+                break;
+            }
+            isFresh = true;
+        }
+
+        if (std::chrono::steady_clock::now() > deadline) {
+            state.hasIterate = true;
+            break;
+        }
+    }
+
+    int ret;
+    if (subsysA->error() <= smallF) {
+        ret = Success;
+        state.hasIterate = false;
+    }
+    else if (h.norm() <= convergence) {
+        ret = Converged;
+    }
+    else {
+        ret = Failed;
+    }
+
+    subsysA->iterations = iter;
+    subsysB->iterations = 0;
     subsysA->revertParams();
     subsysB->revertParams();
     return ret;
 }
 
+System::SolveStatistics System::getSolveStatistics() const
+{
+    SolveStatistics statistics;
+    statistics.diagnosedRows = diagnosedRows;
+    statistics.diagnosedCols = diagnosedCols;
+    for (std::size_t cid = 0; cid < subSystems.size(); cid++) {
+        if (!subSystems[cid] && !subSystemsAux[cid]) {
+            continue;
+        }
+        statistics.clusters++;
+        int params = int(plists[cid].size());
+        for (SubSystem* subsys : {subSystems[cid], subSystemsAux[cid]}) {
+            if (subsys) {
+                statistics.constraints += subsys->cSize();
+                statistics.iterations += subsys->iterations;
+            }
+        }
+        statistics.params += params;
+        statistics.maxParams = std::max(statistics.maxParams, params);
+    }
+    return statistics;
+}
+
 void System::applySolution()
 {
     for (int cid = 0; cid < int(subSystems.size()); cid++) {
@@ -4798,32 +5145,80 @@ void System::undoSolution()
     resetToReference();
 }
 
-void System::makeReducedJacobian(Eigen::MatrixXd& J,
-                                 std::map<int, int>& jacobianconstraintmap,
-                                 GCS::VEC_pD& pdiagnoselist,
-                                 std::map<int, int>& tagmultiplicity)
+namespace
 {
-    // construct specific parameter list for diagonose ignoring driven constraint parameters
-    for (int j = 0; j < int(plist.size()); j++) {
-        auto result1 = std::ranges::find(pdrivenlist, plist[j]);
 
-        if (result1 == std::end(pdrivenlist)) {
-            pdiagnoselist.push_back(plist[j]);
-        }
+Eigen::MatrixXd makeDenseJacobian(const std::vector<Eigen::Triplet<double>>& triplets,
+                                  int rows,
+                                  int cols)
+{
+    Eigen::MatrixXd J = Eigen::MatrixXd::Zero(rows, cols);
+    for (const auto& triplet : triplets) {
+        J(triplet.row(), triplet.col()) = triplet.value();
     }
+    return J;
+}
 
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+// the sparse matrix is assembled directly, so that a sketch with thousands of constraints does not
+// need a dense matrix of the size of constraints times parameters
+Eigen::SparseMatrix<double> makeSparseJacobian(const std::vector<Eigen::Triplet<double>>& triplets,
+                                               int rows,
+                                               int cols)
+{
+    Eigen::SparseMatrix<double> J(rows, cols);
+    J.setFromTriplets(triplets.begin(), triplets.end());
+    J.makeCompressed();
+    return J;
+}
+#endif
 
-    J = Eigen::MatrixXd::Zero(clist.size(), pdiagnoselist.size());
+// the degrees of freedom, unless the system is over-constrained
+int diagnosedDofs(int paramsNum, int constrNum, int rank, int nonredundantconstrNum)
+{
+    if (constrNum > rank && paramsNum == rank && nonredundantconstrNum > rank) {
+        return paramsNum - nonredundantconstrNum;
+    }
+    return paramsNum - rank;
+}
+
+}  // namespace
+
+int System::makeReducedJacobianTriplets(std::vector<Eigen::Triplet<double>>& triplets,
+                                        std::map<int, int>& jacobianconstraintmap,
+                                        GCS::VEC_pD& pdiagnoselist,
+                                        std::map<int, int>& tagmultiplicity)
+{
+    // construct specific parameter list for diagonose ignoring driven constraint parameters
+    std::unordered_set<double*> drivenparams(pdrivenlist.begin(), pdrivenlist.end());
+    std::unordered_map<double*, int> columns;
+    for (auto param : plist) {
+        if (!drivenparams.contains(param)) {
+            columns.emplace(param, int(pdiagnoselist.size()));
+            pdiagnoselist.push_back(param);
+        }
+    }
 
     int jacobianconstraintcount = 0;
     int allcount = 0;
+    VEC_I rowcolumns;
     for (auto& constr : clist) {
         constr->revertParams();
         ++allcount;
         if (constr->getTag() >= 0 && constr->isDriving()) {
             jacobianconstraintcount++;
-            for (int j = 0; j < int(pdiagnoselist.size()); j++) {
-                J(jacobianconstraintcount - 1, j) = constr->grad(pdiagnoselist[j]);
+            // the gradient is zero for the parameters the constraint does not depend on
+            rowcolumns.clear();
+            for (auto param : c2p[constr]) {
+                auto it = columns.find(param);
+                if (it != columns.end() && std::ranges::find(rowcolumns, it->second)
+                                               == rowcolumns.end()) {
+                    rowcolumns.push_back(it->second);
+                    double value = constr->grad(param);
+                    if (value != 0.0) {
+                        triplets.emplace_back(jacobianconstraintcount - 1, it->second, value);
+                    }
+                }
             }
 
             // parallel processing: create tag multiplicity map
@@ -4838,9 +5233,7 @@ void System::makeReducedJacobian(Eigen::MatrixXd& J,
         }
     }
 
-    if (jacobianconstraintcount == 0) {  // only driven constraints
-        J.resize(0, 0);
-    }
+    return jacobianconstraintcount;
 }
 
 int System::diagnose(Algorithm alg)
@@ -4856,6 +5249,8 @@ int System::diagnose(Algorithm alg)
     //         two high priority constraints. For this reason, tagging
     //         constraints with 0 should be used carefully.
     hasDiagnosis = false;
+    diagnosedRows = 0;
+    diagnosedCols = 0;
     if (!hasUnknowns) {
         dofs = -1;
         return dofs;
@@ -4892,9 +5287,10 @@ int System::diagnose(Algorithm alg)
     //
     // reduced Jacobian matrix
     // The Jacobian has been reduced to:
-    // 1. only contain driving constraints, but keep a full size (zero padded).
+    // 1. only contain driving constraints.
     // 2. remove the parameters of the values of driven constraints.
-    Eigen::MatrixXd J;
+    // It is assembled from its non-zero entries
+    std::vector<Eigen::Triplet<double>> triplets;
 
     // maps the index of the rows of the reduced jacobian matrix (solver constraints) to
     // the index those constraints would have in a full size Jacobian matrix
@@ -4909,7 +5305,17 @@ int System::diagnose(Algorithm alg)
     // like 0 and -1.
     std::map<int, int> tagmultiplicity;
 
-    makeReducedJacobian(J, jacobianconstraintmap, pdiagnoselist, tagmultiplicity);
+#ifndef EIGEN_SPARSEQR_COMPATIBLE
+    if (qrAlgorithm == EigenSparseQR) {
+        Base::Console().warning("SparseQR not supported by you current version of Eigen. It "
+                                "requires Eigen 3.2.2 or higher. Falling back to Dense QR\n");
+        qrAlgorithm = EigenDenseQR;
+    }
+#endif
+
+    makeReducedJacobianTriplets(triplets, jacobianconstraintmap, pdiagnoselist, tagmultiplicity);
+    diagnosedRows = int(jacobianconstraintmap.size());
+    diagnosedCols = int(pdiagnoselist.size());
 
     // this function will exit with a diagnosis and, unless overridden by functions below, with full
     // DoFs
@@ -4962,167 +5368,445 @@ int System::diagnose(Algorithm alg)
 
     // QR decomposition method selection: SparseQR vs DenseQR
 
-#ifndef EIGEN_SPARSEQR_COMPATIBLE
-    if (qrAlgorithm == EigenSparseQR) {
-        Base::Console().warning("SparseQR not supported by you current version of Eigen. It "
-                                "requires Eigen 3.2.2 or higher. Falling back to Dense QR\n");
-        qrAlgorithm = EigenDenseQR;
+    if (jacobianconstraintmap.empty()) {
+        return dofs;
     }
-#endif
 
-    if (J.rows() == 0) {
+    // From here on, presuming there is at least one driving constraint.
+    emptyDiagnoseMatrix = false;
+
+    // The components of the constraint graph are independent, so the incremental diagnosis only
+    // decomposes the ones that changed
+    if (incrementalDiagnosis
+        && diagnoseComponents(alg, triplets, jacobianconstraintmap, tagmultiplicity, pdiagnoselist)) {
         return dofs;
     }
 
-    // From here on, presuming `J.rows() > 0`.
-    emptyDiagnoseMatrix = false;
+    int paramsNum = int(pdiagnoselist.size());
+    int constrNum = int(jacobianconstraintmap.size());
+    int rank = 0;
+    int nonredundantconstrNum = constrNum;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    if (qrAlgorithm == EigenSparseQR) {
+        diagnoseJacobian(alg,
+                         makeSparseJacobian(triplets, constrNum, paramsNum),
+                         jacobianconstraintmap,
+                         tagmultiplicity,
+                         pdiagnoselist,
+                         rank,
+                         nonredundantconstrNum);
+    }
+    else
+#endif
+    {
+        diagnoseJacobian(alg,
+                         makeDenseJacobian(triplets, constrNum, paramsNum),
+                         jacobianconstraintmap,
+                         tagmultiplicity,
+                         pdiagnoselist,
+                         rank,
+                         nonredundantconstrNum);
+    }
+
+    dofs = diagnosedDofs(paramsNum, constrNum, rank, nonredundantconstrNum);
+    return dofs;
+}
 
-    if (qrAlgorithm == EigenDenseQR) {
+void System::diagnoseJacobian(Algorithm alg,
+                              const Eigen::MatrixXd& J,
+                              const std::map<int, int>& jacobianconstraintmap,
+                              const std::map<int, int>& tagmultiplicity,
+                              GCS::VEC_pD& pdiagnoselist,
+                              int& rank,
+                              int& nonredundantconstrNum)
+{
 #ifdef PROFILE_DIAGNOSE
-        Base::TimeElapsed DenseQR_start_time;
+    Base::TimeElapsed DenseQR_start_time;
 #endif
 
-        int rank = 0;  // rank is not cheap to retrieve from qrJT in DenseQR
-        Eigen::MatrixXd R;
-        Eigen::FullPivHouseholderQR<Eigen::MatrixXd> qrJT;
-        // Here we give the system the possibility to run the two QR decompositions in parallel,
-        // depending on the load of the system so we are using the default std::launch::async |
-        // std::launch::deferred policy, as nobody better than the system nows if it can run the
-        // task in parallel or is oversubscribed and should deferred it. Care to wait() for the
-        // future before any prospective detection of conflicting/redundant, because the
-        // redundant solve modifies pdiagnoselist and it would NOT be thread-safe. Care to call
-        // the thread with silent=true, unless the present thread does not use Base::Console, or
-        // the launch policy is set to std::launch::deferred policy, as it is not thread-safe to
-        // use them in both at the same time.
-        //
-        // identifyDependentParametersDenseQR(J, jacobianconstraintmap, pdiagnoselist, true)
-        //
-        auto fut = std::async(&System::identifyDependentParametersDenseQR,
-                              this,
-                              J,
-                              jacobianconstraintmap,
-                              pdiagnoselist,
-                              true);
-
-        makeDenseQRDecomposition(J, jacobianconstraintmap, qrJT, rank, R);
-
-        int paramsNum = qrJT.rows();
-        int constrNum = qrJT.cols();
-
-        // This function is legacy code that was used to obtain partial geometry dependency
-        // information from a SINGLE Dense QR decomposition. I am reluctant to remove it from
-        // here until everything new is well tested.
-        // identifyDependentGeometryParametersInTransposedJacobianDenseQRDecomposition( qrJT,
-        // pdiagnoselist, paramsNum, rank);
-
-        fut.wait();  // wait for the execution of identifyDependentParametersSparseQR to finish
-
-        dofs = paramsNum - rank;  // unless overconstraint, which will be overridden below
-
-        // Detecting conflicting or redundant constraints
-        if (constrNum > rank) {
-            // conflicting or redundant constraints
-            int nonredundantconstrNum;
-            identifyConflictingRedundantConstraints(alg,
-                                                    qrJT,
-                                                    jacobianconstraintmap,
-                                                    tagmultiplicity,
-                                                    pdiagnoselist,
-                                                    R,
-                                                    constrNum,
-                                                    rank,
-                                                    nonredundantconstrNum);
-            if (paramsNum == rank && nonredundantconstrNum > rank) {  // over-constrained
-                dofs = paramsNum - nonredundantconstrNum;
-            }
-        }
+    Eigen::MatrixXd R;
+    Eigen::FullPivHouseholderQR<Eigen::MatrixXd> qrJT;
+    // Here we give the system the possibility to run the two QR decompositions in parallel,
+    // depending on the load of the system so we are using the default std::launch::async |
+    // std::launch::deferred policy, as nobody better than the system nows if it can run the
+    // task in parallel or is oversubscribed and should deferred it. Care to wait() for the
+    // future before any prospective detection of conflicting/redundant, because the
+    // redundant solve modifies pdiagnoselist and it would NOT be thread-safe. Care to call
+    // the thread with silent=true, unless the present thread does not use Base::Console, or
+    // the launch policy is set to std::launch::deferred policy, as it is not thread-safe to
+    // use them in both at the same time.
+    //
+    // identifyDependentParametersDenseQR(J, jacobianconstraintmap, pdiagnoselist, true)
+    //
+    auto fut = std::async(&System::identifyDependentParametersDenseQR,
+                          this,
+                          J,
+                          jacobianconstraintmap,
+                          pdiagnoselist,
+                          true);
+
+    // rank is not cheap to retrieve from qrJT in DenseQR
+    makeDenseQRDecomposition(J, jacobianconstraintmap, qrJT, rank, R);
+
+    int constrNum = qrJT.cols();
+
+    // This function is legacy code that was used to obtain partial geometry dependency
+    // information from a SINGLE Dense QR decomposition. I am reluctant to remove it from
+    // here until everything new is well tested.
+    // identifyDependentGeometryParametersInTransposedJacobianDenseQRDecomposition( qrJT,
+    // pdiagnoselist, paramsNum, rank);
+
+    fut.wait();  // wait for the execution of identifyDependentParametersSparseQR to finish
+
+    // Detecting conflicting or redundant constraints
+    if (constrNum > rank) {
+        // conflicting or redundant constraints
+        identifyConflictingRedundantConstraints(alg,
+                                                qrJT,
+                                                jacobianconstraintmap,
+                                                tagmultiplicity,
+                                                pdiagnoselist,
+                                                R,
+                                                constrNum,
+                                                rank,
+                                                nonredundantconstrNum);
+    }
 
 #ifdef PROFILE_DIAGNOSE
-        Base::TimeElapsed DenseQR_end_time;
+    Base::TimeElapsed DenseQR_end_time;
 
-        auto SolveTime = Base::TimeElapsed::diffTimeF(DenseQR_start_time, DenseQR_end_time);
+    auto SolveTime = Base::TimeElapsed::diffTimeF(DenseQR_start_time, DenseQR_end_time);
 
-        Base::Console().log("\nDenseQR - Lapsed Time: %f seconds\n", SolveTime);
+    Base::Console().log("\nDenseQR - Lapsed Time: %f seconds\n", SolveTime);
 #endif
-    }
+}
 
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
-    else if (qrAlgorithm == EigenSparseQR) {
+void System::diagnoseJacobian(Algorithm alg,
+                              const Eigen::SparseMatrix<double>& SJ,
+                              const std::map<int, int>& jacobianconstraintmap,
+                              const std::map<int, int>& tagmultiplicity,
+                              GCS::VEC_pD& pdiagnoselist,
+                              int& rank,
+                              int& nonredundantconstrNum)
+{
 #ifdef PROFILE_DIAGNOSE
-        Base::TimeElapsed SparseQR_start_time;
+    Base::TimeElapsed SparseQR_start_time;
 #endif
-        int rank = 0;
-        Eigen::MatrixXd R;
-        Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> SqrJT;
-        // Here we give the system the possibility to run the two QR decompositions in parallel,
-        // depending on the load of the system so we are using the default std::launch::async |
-        // std::launch::deferred policy, as nobody better than the system nows if it can run the
-        // task in parallel or is oversubscribed and should deferred it. Care to wait() for the
-        // future before any prospective detection of conflicting/redundant, because the
-        // redundant solve modifies pdiagnoselist and it would NOT be thread-safe. Care to call
-        // the thread with silent=true, unless the present thread does not use Base::Console, or
-        // the launch policy is set to std::launch::deferred policy, as it is not thread-safe to
-        // use them in both at the same time.
-        //
-        // identifyDependentParametersSparseQR(J, jacobianconstraintmap, pdiagnoselist, true)
-        //
-        // Debug:
-        // auto fut =
-        // std::async(std::launch::deferred,&System::identifyDependentParametersSparseQR, this,
-        // J, jacobianconstraintmap, pdiagnoselist, false);
-        auto fut = std::async(&System::identifyDependentParametersSparseQR,
-                              this,
-                              J,
+    Eigen::MatrixXd R;
+    Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> SqrJT;
+    // Here we give the system the possibility to run the two QR decompositions in parallel,
+    // depending on the load of the system so we are using the default std::launch::async |
+    // std::launch::deferred policy, as nobody better than the system nows if it can run the
+    // task in parallel or is oversubscribed and should deferred it. Care to wait() for the
+    // future before any prospective detection of conflicting/redundant, because the
+    // redundant solve modifies pdiagnoselist and it would NOT be thread-safe. Care to call
+    // the thread with silent=true, unless the present thread does not use Base::Console, or
+    // the launch policy is set to std::launch::deferred policy, as it is not thread-safe to
+    // use them in both at the same time.
+    //
+    // identifyDependentParametersSparseQR(J, jacobianconstraintmap, pdiagnoselist, true)
+    //
+    // Debug:
+    // auto fut =
+    // std::async(std::launch::deferred,&System::identifyDependentParametersSparseQR, this,
+    // SJ, jacobianconstraintmap, pdiagnoselist, false);
+    auto fut = std::async(&System::identifyDependentParametersSparseQR,
+                          this,
+                          SJ,
+                          jacobianconstraintmap,
+                          pdiagnoselist,
+                          /*silent=*/true);
+
+    makeSparseQRDecomposition(SJ,
                               jacobianconstraintmap,
-                              pdiagnoselist,
-                              /*silent=*/true);
-
-        makeSparseQRDecomposition(J,
-                                  jacobianconstraintmap,
-                                  SqrJT,
-                                  rank,
-                                  R,
-                                  /*transposed=*/true,
-                                  /*silent=*/false);
-
-        int paramsNum = SqrJT.rows();
-        int constrNum = SqrJT.cols();
-
-        fut.wait();  // wait for the execution of identifyDependentParametersSparseQR to finish
-
-        dofs = paramsNum - rank;  // unless overconstraint, which will be overridden below
-
-        // Detecting conflicting or redundant constraints
-        if (constrNum > rank) {
-            int nonredundantconstrNum;
-
-            identifyConflictingRedundantConstraints(alg,
-                                                    SqrJT,
-                                                    jacobianconstraintmap,
-                                                    tagmultiplicity,
-                                                    pdiagnoselist,
-                                                    R,
-                                                    constrNum,
-                                                    rank,
-                                                    nonredundantconstrNum);
-
-            if (paramsNum == rank && nonredundantconstrNum > rank) {
-                // over-constrained
-                dofs = paramsNum - nonredundantconstrNum;
-            }
-        }
+                              SqrJT,
+                              rank,
+                              R,
+                              /*transposed=*/true,
+                              /*silent=*/false);
+
+    int constrNum = SqrJT.cols();
+
+    fut.wait();  // wait for the execution of identifyDependentParametersSparseQR to finish
+
+    // Detecting conflicting or redundant constraints
+    if (constrNum > rank) {
+        identifyConflictingRedundantConstraints(alg,
+                                                SqrJT,
+                                                jacobianconstraintmap,
+                                                tagmultiplicity,
+                                                pdiagnoselist,
+                                                R,
+                                                constrNum,
+                                                rank,
+                                                nonredundantconstrNum);
+    }
 
 #ifdef PROFILE_DIAGNOSE
-        Base::TimeElapsed SparseQR_end_time;
+    Base::TimeElapsed SparseQR_end_time;
 
-        auto SolveTime = Base::TimeElapsed::diffTimeF(SparseQR_start_time, SparseQR_end_time);
+    auto SolveTime = Base::TimeElapsed::diffTimeF(SparseQR_start_time, SparseQR_end_time);
 
-        Base::Console().log("\nSparseQR - Lapsed Time: %f seconds\n", SolveTime);
+    Base::Console().log("\nSparseQR - Lapsed Time: %f seconds\n", SolveTime);
+#endif
+}
 #endif
+
+bool System::diagnoseComponents(Algorithm alg,
+                                const std::vector<Eigen::Triplet<double>>& triplets,
+                                const std::map<int, int>& jacobianconstraintmap,
+                                const std::map<int, int>& tagmultiplicity,
+                                const GCS::VEC_pD& pdiagnoselist)
+{
+    const int paramsNum = int(pdiagnoselist.size());
+    std::unordered_map<double*, int> columns;
+    for (int j = 0; j < paramsNum; j++) {
+        columns.emplace(pdiagnoselist[j], j);
     }
+
+    // the connected components of the parameters joined by the driving constraints, which also
+    // includes the negatively tagged ones as they take part in the redundant solving
+    std::vector<int> parent(paramsNum);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto findRoot = [&parent](int j) {
+        while (parent[j] != j) {
+            parent[j] = parent[parent[j]];
+            j = parent[j];
+        }
+        return j;
+    };
+    std::vector<int> constrcolumn(clist.size(), -1);
+    for (std::size_t i = 0; i < clist.size(); i++) {
+        if (!clist[i]->isDriving()) {
+            continue;
+        }
+        for (auto param : c2p[clist[i]]) {
+            auto it = columns.find(param);
+            if (it == columns.end()) {
+                continue;
+            }
+            if (constrcolumn[i] < 0) {
+                constrcolumn[i] = it->second;
+            }
+            else {
+                parent[findRoot(it->second)] = findRoot(constrcolumn[i]);
+            }
+        }
+    }
+
+    // a constraint without any diagnosed parameter is a dependent row of its own, which is only
+    // handled by the diagnosis of the whole system
+    std::vector<int> constrrow(clist.size(), -1);
+    for (const auto& [row, index] : jacobianconstraintmap) {
+        if (constrcolumn[index] < 0) {
+            return false;
+        }
+        constrrow[index] = row;
+    }
+
+    struct Component
+    {
+        std::vector<int> constraints;  // indices in clist
+        VEC_I params;                  // indices in pdiagnoselist
+    };
+    std::vector<Component> components;
+    std::vector<int> componentIndex(paramsNum, -1);
+    for (int j = 0; j < paramsNum; j++) {
+        int root = findRoot(j);
+        if (componentIndex[root] < 0) {
+            componentIndex[root] = int(components.size());
+            components.emplace_back();
+        }
+        components[componentIndex[root]].params.push_back(j);
+    }
+    for (std::size_t i = 0; i < clist.size(); i++) {
+        if (constrcolumn[i] >= 0) {
+            components[componentIndex[findRoot(constrcolumn[i])]].constraints.push_back(int(i));
+        }
+    }
+
+    // the triplets are in the order of the rows
+    std::vector<std::size_t> rowstart(jacobianconstraintmap.size() + 1, triplets.size());
+    for (std::size_t k = triplets.size(); k-- > 0;) {
+        rowstart[triplets[k].row()] = k;
+    }
+    for (std::size_t row = jacobianconstraintmap.size(); row-- > 0;) {
+        rowstart[row] = std::min(rowstart[row], rowstart[row + 1]);
+    }
+
+    std::map<std::string, ComponentDiagnosis> cache;
+    std::set<Constraint*> allredundant;
+    SET_I conflictingTagsSet;
+    GCS::VEC_pD dependentParameters;
+    std::vector<std::vector<double*>> dependentParametersGroups;
+    int rank = 0;
+    int constrNum = 0;
+    int nonredundantconstrNum = 0;
+    std::vector<int> localparam(paramsNum, -1);
+
+    for (const auto& component : components) {
+        for (std::size_t j = 0; j < component.params.size(); j++) {
+            localparam[component.params[j]] = int(j);
+        }
+
+        // the key is the content of the constraints, the parameter pointers change whenever the
+        // sketch is set up again
+        std::string key;
+        auto add = [&key](const auto& value) {
+            key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        };
+        add(alg);
+        add(qrAlgorithm);
+        add(qrpivotThreshold);
+        add(maxIterRedundant);
+        add(sketchSizeMultiplierRedundant);
+        add(convergenceRedundant);
+        add(LM_epsRedundant);
+        add(LM_eps1Redundant);
+        add(LM_tauRedundant);
+        add(DL_tolgRedundant);
+        add(DL_tolxRedundant);
+        add(DL_tolfRedundant);
+        add(dogLegGaussStep);
+        add(component.params.size());
+        for (int index : component.constraints) {
+            Constraint* constr = clist[index];
+            int row = constrrow[index];
+            add(constr->getTypeId());
+            add(constr->getTag());
+            add(constr->isInternalAlignment());
+            add(row >= 0 ? tagmultiplicity.at(constr->getTag()) : -1);
+            add(constr->error());
+            for (auto param : c2p[constr]) {
+                auto it = columns.find(param);
+                add(it != columns.end() ? localparam[it->second] : -1);
+                add(*param);
+            }
+            if (row >= 0) {
+                for (std::size_t k = rowstart[row]; k < rowstart[row + 1]; k++) {
+                    add(localparam[triplets[k].col()]);
+                    add(triplets[k].value());
+                }
+            }
+        }
+
+        auto it = diagnosisCache.find(key);
+        ComponentDiagnosis result;
+        if (it != diagnosisCache.end()) {
+            result = it->second;
+        }
+        else if (component.constraints.empty()) {
+            // free parameters
+            for (std::size_t j = 0; j < component.params.size(); j++) {
+                result.dependentGroups.push_back({int(j)});
+            }
+        }
+        else {
+            // the diagnosis of the component on its own, using its constraints as the system
+            std::vector<Constraint*> localclist;
+            std::map<int, int> localconstraintmap;
+            std::vector<Eigen::Triplet<double>> localtriplets;
+            for (int index : component.constraints) {
+                int row = constrrow[index];
+                if (row >= 0) {
+                    int localrow = int(localconstraintmap.size());
+                    localconstraintmap[localrow] = int(localclist.size());
+                    for (std::size_t k = rowstart[row]; k < rowstart[row + 1]; k++) {
+                        localtriplets.emplace_back(localrow,
+                                                   localparam[triplets[k].col()],
+                                                   triplets[k].value());
+                    }
+                }
+                localclist.push_back(clist[index]);
+            }
+            GCS::VEC_pD localpdiagnoselist;
+            for (int j : component.params) {
+                localpdiagnoselist.push_back(pdiagnoselist[j]);
+            }
+
+            std::swap(clist, localclist);
+            redundant.clear();
+            conflictingTags.clear();
+            pDependentParameters.clear();
+            pDependentParametersGroups.clear();
+            result.constrNum = int(localconstraintmap.size());
+            result.nonredundantconstrNum = result.constrNum;
+            int localparamsNum = int(localpdiagnoselist.size());
+            try {
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+                if (qrAlgorithm == EigenSparseQR) {
+                    diagnoseJacobian(
+                        alg,
+                        makeSparseJacobian(localtriplets, result.constrNum, localparamsNum),
+                        localconstraintmap,
+                        tagmultiplicity,
+                        localpdiagnoselist,
+                        result.rank,
+                        result.nonredundantconstrNum);
+                }
+                else
 #endif
+                {
+                    diagnoseJacobian(
+                        alg,
+                        makeDenseJacobian(localtriplets, result.constrNum, localparamsNum),
+                        localconstraintmap,
+                        tagmultiplicity,
+                        localpdiagnoselist,
+                        result.rank,
+                        result.nonredundantconstrNum);
+                }
+            }
+            catch (...) {
+                std::swap(clist, localclist);
+                throw;
+            }
+            std::swap(clist, localclist);
 
-    return dofs;
+            result.conflictingTags = conflictingTags;
+            for (std::size_t k = 0; k < localclist.size(); k++) {
+                if (redundant.count(localclist[k]) != 0) {
+                    result.redundant.push_back(int(k));
+                }
+            }
+            for (const auto& group : pDependentParametersGroups) {
+                VEC_I localgroup;
+                for (auto param : group) {
+                    localgroup.push_back(localparam[columns.at(param)]);
+                }
+                result.dependentGroups.push_back(std::move(localgroup));
+            }
+        }
+
+        rank += result.rank;
+        constrNum += result.constrNum;
+        nonredundantconstrNum += result.nonredundantconstrNum;
+        conflictingTagsSet.insert(result.conflictingTags.begin(), result.conflictingTags.end());
+        for (int k : result.redundant) {
+            allredundant.insert(clist[component.constraints[k]]);
+        }
+        for (const auto& group : result.dependentGroups) {
+            auto& paramgroup = dependentParametersGroups.emplace_back();
+            for (int j : group) {
+                paramgroup.push_back(pdiagnoselist[component.params[j]]);
+                dependentParameters.push_back(pdiagnoselist[component.params[j]]);
+            }
+        }
+        cache.emplace(std::move(key), std::move(result));
+    }
+
+    // only the components of this diagnosis are kept
+    diagnosisCache.swap(cache);
+
+    redundant = std::move(allredundant);
+    pDependentParameters = std::move(dependentParameters);
+    pDependentParametersGroups = std::move(dependentParametersGroups);
+    conflictingTags.assign(conflictingTagsSet.begin(), conflictingTagsSet.end());
+    makeRedundantTags();
+
+    dofs = diagnosedDofs(paramsNum, constrNum, rank, nonredundantconstrNum);
+    return true;
 }
 
 void System::makeDenseQRDecomposition(const Eigen::MatrixXd& J,
@@ -5205,7 +5889,7 @@ void System::makeDenseQRDecomposition(const Eigen::MatrixXd& J,
 
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
 void System::makeSparseQRDecomposition(
-    const Eigen::MatrixXd& J,
+    const Eigen::SparseMatrix<double>& SJ,
     const std::map<int, int>& jacobianconstraintmap,
     Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>>& SqrJT,
     int& rank,
@@ -5214,17 +5898,9 @@ void System::makeSparseQRDecomposition(
     bool silent)
 {
 
-    Eigen::SparseMatrix<double> SJ;
-
-    // this creation is not optimized (done using triplets)
-    // however the time this takes is negligible compared to the
-    // time the QR decomposition itself takes
-    SJ = J.sparseView();
-    SJ.makeCompressed();
-
 #ifdef _GCS_DEBUG
     if (!silent) {
-        SolverReportingManager::Manager().LogMatrix("J", J);
+        SolverReportingManager::Manager().LogMatrix("J", Eigen::MatrixXd(SJ));
     }
 #endif
 
@@ -5285,7 +5961,7 @@ void System::makeSparseQRDecomposition(
     }
 
 #ifdef _GCS_DEBUG_SOLVER_JACOBIAN_QR_DECOMPOSITION_TRIANGULAR_MATRIX
-    if (J.rows() > 0 && !silent) {
+    if (SJ.rows() > 0 && !silent) {
 
         SolverReportingManager::Manager().LogMatrix("R", R);
 
@@ -5315,7 +5991,7 @@ void System::identifyDependentParametersDenseQR(const Eigen::MatrixXd& J,
 }
 
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
-void System::identifyDependentParametersSparseQR(const Eigen::MatrixXd& J,
+void System::identifyDependentParametersSparseQR(const Eigen::SparseMatrix<double>& J,
                                                  const std::map<int, int>& jacobianconstraintmap,
                                                  const GCS::VEC_pD& pdiagnoselist,
                                                  bool silent)
@@ -5705,6 +6381,13 @@ void System::identifyConflictingRedundantConstraints(
     conflictingTags.resize(conflictingTagsSet.size());
     std::ranges::copy(conflictingTagsSet, conflictingTags.begin());
 
+    makeRedundantTags();
+
+    nonredundantconstrNum = constrNum;
+}
+
+void System::makeRedundantTags()
+{
     // output of redundant tags
     SET_I redundantTagsSet, partiallyRedundantTagsSet;
     for (const auto& constr : redundant) {
@@ -5728,8 +6411,6 @@ void System::identifyConflictingRedundantConstraints(
 
     partiallyRedundantTags.resize(partiallyRedundantTagsSet.size());
     std::ranges::copy(partiallyRedundantTagsSet, partiallyRedundantTags.begin());
-
-    nonredundantconstrNum = constrNum;
 }
 
 void System::clearSubSystems()
@@ -5739,6 +6420,7 @@ void System::clearSubSystems()
     deleteAllContent(subSystemsAux);
     subSystems.clear();
     subSystemsAux.clear();
+    dragStates.clear();
 }
 
 double lineSearch(SubSystem* subsys, Eigen::VectorXd& xdir)
@@ -23,7 +23,11 @@
 #ifndef PLANEGCS_GCS_H
 #define PLANEGCS_GCS_H
 
+#include <chrono>
+#include <string>
+
 #include <Eigen/QR>
+#include <Eigen/SparseCore>
 
 #include "../../SketcherGlobal.h"
 #include "SubSystem.h"
@@ -124,6 +128,19 @@ private:
     std::vector<SubSystem*> subSystems, subSystemsAux;
     void clearSubSystems();
 
+    // The state of the drag solve of a cluster that is kept from one solveDrag() to the next and
+    // its preallocated work buffers
+    struct DragState
+    {
+        VEC_pD plistAB;
+        Eigen::MatrixXd B, JA, Y, Z;
+        Eigen::VectorXd resA, lambda, lambda0, lambdadir;
+        Eigen::VectorXd x, x0, xdir, xdir1, grad, h, y, Bh;
+        bool isFactorized = false;  // if Y and Z are of a previous JA
+        bool hasIterate = false;    // if x is the last iterate of a solve that ran out of time
+    };
+    std::vector<DragState> dragStates;  // per cluster, reset by initSolution()
+
     VEC_D reference;
     void setReference();      // copies the current parameter values to reference
     void resetToReference();  // reverts all parameter values to the stored reference
@@ -142,15 +159,68 @@ private:
     bool isInit;        // if plists, clists, reductionmaps are up to date
 
     bool emptyDiagnoseMatrix;  // false only if there is at least one driving constraint.
+    int diagnosedRows, diagnosedCols;  // the size of the Jacobian of the last diagnosis
 
     int solve_BFGS(SubSystem* subsys, bool isFine = true, bool isRedundantsolving = false);
     int solve_LM(SubSystem* subsys, bool isRedundantsolving = false);
     int solve_DL(SubSystem* subsys, bool isRedundantsolving = false);
+    int solveDrag(SubSystem* subsysA,
+                  SubSystem* subsysB,
+                  DragState& state,
+                  std::chrono::steady_clock::time_point deadline);
+
+    // The non-zero entries of the reduced Jacobian in the order of the rows, a constraint only
+    // depends on the parameters of its adjacency list in c2p
+    int makeReducedJacobianTriplets(std::vector<Eigen::Triplet<double>>& triplets,
+                                    std::map<int, int>& jacobianconstraintmap,
+                                    GCS::VEC_pD& pdiagnoselist,
+                                    std::map<int, int>& tagmultiplicity);
+
+    // The QR diagnosis of the reduced Jacobian, the conflicting and redundant constraints are
+    // only identified if there are more constraints than the rank
+    void diagnoseJacobian(Algorithm alg,
+                          const Eigen::MatrixXd& J,
+                          const std::map<int, int>& jacobianconstraintmap,
+                          const std::map<int, int>& tagmultiplicity,
+                          GCS::VEC_pD& pdiagnoselist,
+                          int& rank,
+                          int& nonredundantconstrNum);
+
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    void diagnoseJacobian(Algorithm alg,
+                          const Eigen::SparseMatrix<double>& J,
+                          const std::map<int, int>& jacobianconstraintmap,
+                          const std::map<int, int>& tagmultiplicity,
+                          GCS::VEC_pD& pdiagnoselist,
+                          int& rank,
+                          int& nonredundantconstrNum);
+#endif
 
-    void makeReducedJacobian(Eigen::MatrixXd& J,
-                             std::map<int, int>& jacobianconstraintmap,
-                             GCS::VEC_pD& pdiagnoselist,
-                             std::map<int, int>& tagmultiplicity);
+    // The diagnosis of a connected component of the constraint graph by the indices of its
+    // constraints in clist and of its parameters in pdiagnoselist
+    struct ComponentDiagnosis
+    {
+        int rank = 0;
+        int constrNum = 0;
+        int nonredundantconstrNum = 0;
+        VEC_I conflictingTags;
+        VEC_I redundant;                     // indices in the constraints of the component
+        std::vector<VEC_I> dependentGroups;  // indices in the parameters of the component
+    };
+    // The components of the last incremental diagnosis by the content of their constraints, they
+    // are kept when the system is cleared, as a sketch sets up its system again on every change
+    std::map<std::string, ComponentDiagnosis> diagnosisCache;
+
+    // Diagnoses the connected components one by one and takes the ones that didn't change since
+    // the last diagnosis from the cache, returns false if it can't be used for the system
+    bool diagnoseComponents(Algorithm alg,
+                            const std::vector<Eigen::Triplet<double>>& triplets,
+                            const std::map<int, int>& jacobianconstraintmap,
+                            const std::map<int, int>& tagmultiplicity,
+                            const GCS::VEC_pD& pdiagnoselist);
+
+    // Sets redundantTags and partiallyRedundantTags from the redundant constraints
+    void makeRedundantTags();
 
     void makeDenseQRDecomposition(const Eigen::MatrixXd& J,
                                   const std::map<int, int>& jacobianconstraintmap,
@@ -162,7 +232,7 @@ private:
 
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
     void makeSparseQRDecomposition(
-        const Eigen::MatrixXd& J,
+        const Eigen::SparseMatrix<double>& J,
         const std::map<int, int>& jacobianconstraintmap,
         Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>>& SqrJT,
         int& rank,
@@ -193,7 +263,7 @@ private:
     void eliminateNonZerosOverPivotInUpperTriangularMatrix(Eigen::MatrixXd& R, int rank);
 
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
-    void identifyDependentParametersSparseQR(const Eigen::MatrixXd& J,
+    void identifyDependentParametersSparseQR(const Eigen::SparseMatrix<double>& J,
                                              const std::map<int, int>& jacobianconstraintmap,
                                              const GCS::VEC_pD& pdiagnoselist,
                                              bool silent = true);
@@ -223,6 +293,14 @@ public:
     double convergence;
     double convergenceRedundant;
     QRAlgorithm qrAlgorithm;
+    // if true the diagnosis is done per connected component of the constraint graph and only
+    // the components that changed since the last diagnosis are decomposed again
+    bool incrementalDiagnosis;
+    // the minimum number of parameters per thread when the clusters are solved in parallel, the
+    // clusters of smaller sketches are solved in the calling thread, 0 always solves them there
+    int parallelSolveParams;
+    // the time in seconds a solveDrag() may take, 0 for no limit
+    double dragTimeBudget;
     DogLegGaussStep dogLegGaussStep;
     double qrpivotThreshold;
     DebugMode debugMode;
@@ -557,6 +635,25 @@ public:
               bool isFine = true,
               bool isRedundantsolving = false);
 
+    // Solves the system for a step of a drag, starting from the last solution instead of the
+    // reference. The clusters with temporary constraints reuse the factorization of the Jacobian
+    // of their previous steps until it no longer reduces the errors fast enough. If the time
+    // budget runs out, Failed is returned and the next call continues from the last iterate.
+    int solveDrag(bool isFine = true);
+
+    // The sizes and iterations of the last diagnose() and solve() for performance measurements
+    struct SolveStatistics
+    {
+        int diagnosedRows = 0;  // the size of the reduced Jacobian of the diagnosis
+        int diagnosedCols = 0;
+        int clusters = 0;     // the clusters with constraints
+        int constraints = 0;  // the constraints of the clusters, the rows of their Jacobians
+        int params = 0;       // the parameters of the clusters, the columns of their Jacobians
+        int maxParams = 0;    // the parameters of the largest cluster
+        int iterations = 0;   // the sum of the iterations of the clusters
+    };
+    SolveStatistics getSolveStatistics() const;
+
     void applySolution();
     void undoSolution();
     // FIXME: looks like XconvergenceFine is not the solver precision, at least in DogLeg
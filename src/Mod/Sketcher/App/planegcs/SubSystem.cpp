@@ -261,11 +261,24 @@ void SubSystem::calcResidual(Eigen::VectorXd& r, double& err)
 void SubSystem::calcJacobi(VEC_pD& params, Eigen::MatrixXd& jacobi)
 {
     jacobi.setZero(csize, params.size());
+    // the columns of the redirected parameters in pvals, several of the original parameters may
+    // be reduced to the same one
+    std::vector<VEC_I> columns(pvals.size());
     for (int j = 0; j < int(params.size()); j++) {
         MAP_pD_pD::const_iterator pmapfind = pmap.find(params[j]);
         if (pmapfind != pmap.end()) {
-            for (int i = 0; i < csize; i++) {
-                jacobi(i, j) = clist[i]->grad(pmapfind->second);
+            columns[pmapfind->second - pvals.data()].push_back(j);
+        }
+    }
+    // only the parameters in the adjacency list of a constraint have a non-zero gradient
+    for (int i = 0; i < csize; i++) {
+        for (double* param : c2p[clist[i]]) {
+            const VEC_I& cols = columns[param - pvals.data()];
+            if (!cols.empty()) {
+                double value = clist[i]->grad(param);
+                for (int j : cols) {
+                    jacobi(i, j) = value;
+                }
             }
         }
     }
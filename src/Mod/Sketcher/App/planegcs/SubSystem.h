@@ -51,6 +51,8 @@ public:
     SubSystem(std::vector<Constraint*>& clist_, VEC_pD& params, MAP_pD_pD& reductionmap);
     ~SubSystem();
 
+    int iterations = 0;  // the iterations of the last solve of this subsystem
+
     int pSize()
     {
         return psize;
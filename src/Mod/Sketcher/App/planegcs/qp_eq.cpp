@@ -29,9 +29,8 @@
 
 using namespace Eigen;
 
-// minimizes ( 0.5 * x^T * H * x + g^T * x ) under the condition ( A*x + c = 0 )
-// it returns the solution in x, the row-space of A in Y, and the null space of A in Z
-int qp_eq(MatrixXd& H, VectorXd& g, MatrixXd& A, VectorXd& c, VectorXd& x, MatrixXd& Y, MatrixXd& Z)
+// computes the row-space Y and the null space Z of the constraint matrix A of qp_eq
+int qp_eq_factorize(MatrixXd& A, MatrixXd& Y, MatrixXd& Z)
 {
     FullPivHouseholderQR<MatrixXd> qrAT(A.transpose());
     MatrixXd Q = qrAT.matrixQ();
@@ -54,12 +53,18 @@ int qp_eq(MatrixXd& H, VectorXd& g, MatrixXd& A, VectorXd& c, VectorXd& x, Matri
             .transpose()
             .solve<OnTheRight>(Q.leftCols(rank))
         * qrAT.colsPermutation().transpose();
-    if (params_num == rank) {
+    Z = Q.rightCols(params_num - rank);
+
+    return 0;
+}
+
+// solves qp_eq with the Y and Z of qp_eq_factorize, which may be of a previous A
+void qp_eq_solve(MatrixXd& H, VectorXd& g, VectorXd& c, MatrixXd& Y, MatrixXd& Z, VectorXd& x)
+{
+    if (Z.cols() == 0) {
         x = -Y * c;
     }
     else {
-        Z = Q.rightCols(params_num - rank);
-
         MatrixXd ZTHZ = Z.transpose() * H * Z;
         VectorXd rhs = Z.transpose() * (H * Y * c - g);
 
@@ -67,6 +72,16 @@ int qp_eq(MatrixXd& H, VectorXd& g, MatrixXd& A, VectorXd& c, VectorXd& x, Matri
 
         x = -Y * c + Z * y;
     }
+}
+
+// minimizes ( 0.5 * x^T * H * x + g^T * x ) under the condition ( A*x + c = 0 )
+// it returns the solution in x, the row-space of A in Y, and the null space of A in Z
+int qp_eq(MatrixXd& H, VectorXd& g, MatrixXd& A, VectorXd& c, VectorXd& x, MatrixXd& Y, MatrixXd& Z)
+{
+    if (qp_eq_factorize(A, Y, Z)) {
+        return -1;
+    }
+    qp_eq_solve(H, g, c, Y, Z, x);
 
     return 0;
 }
@@ -21,6 +21,15 @@
  ***************************************************************************/
 #include <Eigen/Dense>
 
+int qp_eq_factorize(Eigen::MatrixXd& A, Eigen::MatrixXd& Y, Eigen::MatrixXd& Z);
+
+void qp_eq_solve(Eigen::MatrixXd& H,
+                 Eigen::VectorXd& g,
+                 Eigen::VectorXd& c,
+                 Eigen::MatrixXd& Y,
+                 Eigen::MatrixXd& Z,
+                 Eigen::VectorXd& x);
+
 int qp_eq(Eigen::MatrixXd& H,
           Eigen::VectorXd& g,
           Eigen::MatrixXd& A,
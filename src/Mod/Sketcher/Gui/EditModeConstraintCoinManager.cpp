@@ -1926,6 +1926,7 @@ void EditModeConstraintCoinManager::rebuildConstraintNodes(const GeoListFacade&
     Gui::coinRemoveAllChildren(editModeScenegraphNodes.constrGroup);
 
     vConstrType.clear();
+    sentConstrIcons.clear();
 
     // Get sketch normal
     Base::Vector3d RN(0, 0, 1);
@@ -2699,6 +2700,52 @@ QImage EditModeConstraintCoinManager::renderConstrIcon(const QString& type,
                                                        double iconRotation,
                                                        std::vector<QRect>* boundingBoxes,
                                                        int* vPad)
+{
+    QString key = type + QStringLiteral("|")
+        + QString::number(drawingParameters.constraintIconSize) + QStringLiteral("|")
+        + QString::number(iconRotation) + QStringLiteral("|")
+        + iconColor.name(QColor::HexArgb);
+    for (const auto& color : labelColors) {
+        key += QStringLiteral("|") + color.name(QColor::HexArgb);
+    }
+    key += QStringLiteral("|") + labels.join(QChar(0));
+
+    auto it = renderedConstrIcons.find(key);
+    if (it == renderedConstrIcons.end()) {
+        // the icons of constraints that were deleted or changed are dropped now and then
+        const std::size_t maxRenderedIcons = 10000;
+        if (renderedConstrIcons.size() >= maxRenderedIcons) {
+            renderedConstrIcons.clear();
+        }
+        RenderedConstrIcon rendered;
+        rendered.image = paintConstrIcon(type,
+                                         iconColor,
+                                         labels,
+                                         labelColors,
+                                         iconRotation,
+                                         &rendered.boundingBoxes,
+                                         &rendered.vPad);
+        it = renderedConstrIcons.emplace(key, std::move(rendered)).first;
+    }
+
+    if (boundingBoxes) {
+        boundingBoxes->insert(boundingBoxes->end(),
+                              it->second.boundingBoxes.begin(),
+                              it->second.boundingBoxes.end());
+    }
+    if (vPad) {
+        *vPad = it->second.vPad;
+    }
+    return it->second.image;
+}
+
+QImage EditModeConstraintCoinManager::paintConstrIcon(const QString& type,
+                                                      const QColor& iconColor,
+                                                      const QStringList& labels,
+                                                      const QList<QColor>& labelColors,
+                                                      double iconRotation,
+                                                      std::vector<QRect>* boundingBoxes,
+                                                      int* vPad)
 {
     // Constants to help create constraint icons
     QString joinStr = QStringLiteral(", ");
@@ -2843,6 +2890,13 @@ QString EditModeConstraintCoinManager::iconTypeFromConstraint(Constraint* constr
 void EditModeConstraintCoinManager::sendConstraintIconToCoin(const QImage& icon,
                                                              SoImage* soImagePtr)
 {
+    // a rendered icon is shared by the updates, so its cache key stays the same
+    auto& sent = sentConstrIcons[soImagePtr];
+    if (sent && sent == icon.cacheKey()) {
+        return;
+    }
+    sent = icon.cacheKey();
+
     SoSFImage icondata = SoSFImage();
 
     Gui::BitmapFactory().convert(icon, icondata);
@@ -2859,7 +2913,12 @@ void EditModeConstraintCoinManager::sendConstraintIconToCoin(const QImage& icon,
 
 void EditModeConstraintCoinManager::clearCoinImage(SoImage* soImagePtr)
 {
+    auto it = sentConstrIcons.find(soImagePtr);
+    if (it != sentConstrIcons.end() && it->second == 0) {
+        return;
+    }
     soImagePtr->setToDefaults();
+    sentConstrIcons[soImagePtr] = 0;
 }
 
 QColor EditModeConstraintCoinManager::constrColor(int constraintId)
@@ -191,6 +191,22 @@ private:
 
     std::map<QString, ConstrIconBBVec> combinedConstrBoxes;
 
+    /// A constraint icon rendered before, kept for the next updates of the icons
+    struct RenderedConstrIcon
+    {
+        QImage image;
+        std::vector<QRect> boundingBoxes;
+        int vPad;
+    };
+
+    /// The icons rendered so far, by their type, colors, labels, rotation and size. Dragging
+    /// only moves most icons, so they don't need to be painted again.
+    std::map<QString, RenderedConstrIcon> renderedConstrIcons;
+
+    /// The cache key of the image each icon node shows, 0 for a blank node. A node showing
+    /// the same image is left untouched, so that Coin has nothing to update.
+    std::map<SoImage*, qint64> sentConstrIcons;
+
 
     /// Internal type used for drawing constraint icons
     struct constrIconQueueItem
@@ -244,6 +260,15 @@ private:
                             //! that the text extends below the icon base.
                             int* vPad = nullptr);
 
+    /// Paints the icon returned by renderConstrIcon if it isn't rendered already
+    QImage paintConstrIcon(const QString& type,
+                           const QColor& iconColor,
+                           const QStringList& labels,
+                           const QList<QColor>& labelColors,
+                           double iconRotation,
+                           std::vector<QRect>* boundingBoxes,
+                           int* vPad);
+
     /// Copies a QImage constraint icon into a SoImage*
     /*! Used by drawTypicalConstraintIcon() and drawMergedConstraintIcons() */
     void sendConstraintIconToCoin(const QImage& icon, SoImage* soImagePtr);
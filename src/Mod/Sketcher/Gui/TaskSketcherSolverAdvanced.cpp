@@ -73,6 +73,8 @@ TaskSketcherSolverAdvanced::TaskSketcherSolverAdvanced(ViewProviderSketch* sketc
     ui->lineEditConvergence->onRestore();
     ui->comboBoxQRMethod->onRestore();
     ui->lineEditQRPivotThreshold->onRestore();
+    ui->checkBoxIncrementalDiagnosis->onRestore();
+    ui->checkBoxFastDragging->onRestore();
     ui->comboBoxRedundantDefaultSolver->onRestore();
     ui->spinBoxRedundantSolverMaxIterations->onRestore();
     ui->checkBoxRedundantSketchSizeMultiplier->onRestore();
@@ -122,6 +124,25 @@ void TaskSketcherSolverAdvanced::setupConnections()
             &QLineEdit::editingFinished,
             this,
             &TaskSketcherSolverAdvanced::onLineEditQRPivotThresholdEditingFinished);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 7, 0)
+    connect(ui->checkBoxIncrementalDiagnosis,
+            &QCheckBox::checkStateChanged,
+            this,
+            &TaskSketcherSolverAdvanced::onCheckBoxIncrementalDiagnosisStateChanged);
+    connect(ui->checkBoxFastDragging,
+            &QCheckBox::checkStateChanged,
+            this,
+            &TaskSketcherSolverAdvanced::onCheckBoxFastDraggingStateChanged);
+#else
+    connect(ui->checkBoxIncrementalDiagnosis,
+            &QCheckBox::stateChanged,
+            this,
+            &TaskSketcherSolverAdvanced::onCheckBoxIncrementalDiagnosisStateChanged);
+    connect(ui->checkBoxFastDragging,
+            &QCheckBox::stateChanged,
+            this,
+            &TaskSketcherSolverAdvanced::onCheckBoxFastDraggingStateChanged);
+#endif
     connect(ui->comboBoxRedundantDefaultSolver,
             qOverload<int>(&QComboBox::currentIndexChanged),
             this,
@@ -620,6 +641,20 @@ void TaskSketcherSolverAdvanced::onComboBoxQRMethodCurrentIndexChanged(int index
     ui->comboBoxQRMethod->onSave();
 }
 
+void TaskSketcherSolverAdvanced::onCheckBoxIncrementalDiagnosisStateChanged(int state)
+{
+    ui->checkBoxIncrementalDiagnosis->onSave();
+    const_cast<Sketcher::Sketch&>(sketchView->getSketchObject()->getSolvedSketch())
+        .setIncrementalDiagnosis(state == Qt::Checked);
+}
+
+void TaskSketcherSolverAdvanced::onCheckBoxFastDraggingStateChanged(int state)
+{
+    ui->checkBoxFastDragging->onSave();
+    const_cast<Sketcher::Sketch&>(sketchView->getSketchObject()->getSolvedSketch())
+        .setFastDragging(state == Qt::Checked);
+}
+
 void TaskSketcherSolverAdvanced::onComboBoxRedundantDefaultSolverCurrentIndexChanged(int index)
 {
     ui->comboBoxRedundantDefaultSolver->onSave();
@@ -693,6 +728,8 @@ void TaskSketcherSolverAdvanced::onPushButtonDefaultsClicked(bool checked /* = f
     hGrp->SetASCII("RedundantConvergence", QString::number(CONVERGENCE).toUtf8());
     hGrp->SetInt("QRMethod", DEFAULT_QRSOLVER);
     hGrp->SetASCII("QRPivotThreshold", QString::number(QR_PIVOT_THRESHOLD).toUtf8());
+    hGrp->SetBool("IncrementalDiagnosis", false);
+    hGrp->SetBool("FastDragging", false);
     hGrp->SetInt("DebugMode", DEFAULT_SOLVER_DEBUG);
 
     ui->comboBoxDefaultSolver->onRestore();
@@ -702,6 +739,8 @@ void TaskSketcherSolverAdvanced::onPushButtonDefaultsClicked(bool checked /* = f
     ui->lineEditConvergence->onRestore();
     ui->comboBoxQRMethod->onRestore();
     ui->lineEditQRPivotThreshold->onRestore();
+    ui->checkBoxIncrementalDiagnosis->onRestore();
+    ui->checkBoxFastDragging->onRestore();
     ui->comboBoxRedundantDefaultSolver->onRestore();
     ui->spinBoxRedundantSolverMaxIterations->onRestore();
     ui->checkBoxRedundantSketchSizeMultiplier->onRestore();
@@ -726,6 +765,10 @@ void TaskSketcherSolverAdvanced::updateSketchObject()
         .setQRAlgorithm((GCS::QRAlgorithm)ui->comboBoxQRMethod->currentIndex());
     const_cast<Sketcher::Sketch&>(sketchView->getSketchObject()->getSolvedSketch())
         .setQRPivotThreshold(ui->lineEditQRPivotThreshold->text().toDouble());
+    const_cast<Sketcher::Sketch&>(sketchView->getSketchObject()->getSolvedSketch())
+        .setIncrementalDiagnosis(ui->checkBoxIncrementalDiagnosis->isChecked());
+    const_cast<Sketcher::Sketch&>(sketchView->getSketchObject()->getSolvedSketch())
+        .setFastDragging(ui->checkBoxFastDragging->isChecked());
     const_cast<Sketcher::Sketch&>(sketchView->getSketchObject()->getSolvedSketch())
         .setConvergenceRedundant(ui->lineEditRedundantConvergence->text().toDouble());
     const_cast<Sketcher::Sketch&>(sketchView->getSketchObject()->getSolvedSketch())
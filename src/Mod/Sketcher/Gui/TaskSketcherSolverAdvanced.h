@@ -55,6 +55,8 @@ private:
     void onLineEditConvergenceEditingFinished();
     void onComboBoxQRMethodCurrentIndexChanged(int index);
     void onLineEditQRPivotThresholdEditingFinished();
+    void onCheckBoxIncrementalDiagnosisStateChanged(int state);
+    void onCheckBoxFastDraggingStateChanged(int state);
     void onComboBoxRedundantDefaultSolverCurrentIndexChanged(int index);
     void onLineEditRedundantConvergenceEditingFinished();
     void onSpinBoxRedundantSolverMaxIterationsValueChanged(int i);
@@ -209,6 +209,7 @@ void Cell::setExpression(App::ExpressionPtr&& expr)
     }
 
     expression = std::move(expr);
+    program.reset();
     setUsed(EXPRESSION_SET, !!expression);
 
     /* Update dependencies */
@@ -236,6 +237,22 @@ const App::Expression* Cell::getExpression(bool withFormat) const
     return expression.get();
 }
 
+/**
+ * Get the compiled form of the expression, or nullptr if there is no expression.
+ *
+ */
+
+const App::ExpressionProgram* Cell::getProgram() const
+{
+    if (!expression) {
+        return nullptr;
+    }
+    if (!program || !program->isUpToDate()) {
+        program = std::make_unique<App::ExpressionProgram>(expression.get());
+    }
+    return program.get();
+}
+
 /**
  * Get string content.
  *
@@ -291,6 +308,7 @@ void Cell::setContent(const char* value)
                 return;
             }
             expression = std::make_unique<App::StringExpression>(sheet, value);
+            program.reset();
             setUsed(EXPRESSION_SET, true);
             return;
         }
@@ -394,6 +412,47 @@ void Cell::setContent(const char* value)
     signaller.tryInvoke();
 }
 
+/**
+ * Set the content of the cell from a plain value, as read from a file. Numbers and text are
+ * recognized without the expression parser, like setContent() does for them. Formulas and
+ * values that start with a number followed by a single word, which may be a quantity like
+ * "12mm" or "1/2", are left to setContent(). Any other value is text.
+ *
+ */
+
+void Cell::setLiteralContent(const char* value)
+{
+    if (!value || *value == '\0' || *value == '=' || *value == '\'') {
+        setContent(value);
+        return;
+    }
+
+    char* end;
+    errno = 0;
+    const double float_value = strtod(value, &end);
+    ExpressionPtr newExpr;
+    if (end == value) {
+        newExpr = std::make_unique<App::StringExpression>(owner->sheet(), value);
+    }
+    else {
+        const char* rest = end + strspn(end, " \t\n\r");
+        const char* gap = rest + strcspn(rest, " \t\n\r");
+        if (errno == 0 && *rest == '\0') {
+            newExpr = std::make_unique<App::NumberExpression>(owner->sheet(), Quantity(float_value));
+        }
+        else if (errno != 0 || gap[strspn(gap, " \t\n\r")] == '\0') {
+            setContent(value);
+            return;
+        }
+        else {
+            newExpr = std::make_unique<App::StringExpression>(owner->sheet(), value);
+        }
+    }
+
+    clearException();
+    setExpression(std::move(newExpr));
+}
+
 /**
  * Set alignment of this cell. Alignment is the or'ed value of
  * vertical and horizontal alignment, given by the constants
@@ -911,6 +970,8 @@ void Cell::visit(App::ExpressionVisitor& v)
 {
     if (expression) {
         expression->visit(v);
+        // the visitor may have changed the expression
+        program.reset();
     }
 }
 
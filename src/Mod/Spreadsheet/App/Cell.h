@@ -23,6 +23,7 @@
 #ifndef CELL_H
 #define CELL_H
 
+#include <memory>
 #include <set>
 #include <string>
 
@@ -64,10 +65,15 @@ public:
 
     const App::Expression* getExpression(bool withFormat = false) const;
 
+    /// The compiled form of the expression, compiled again when it is outdated
+    const App::ExpressionProgram* getProgram() const;
+
     bool getStringContent(std::string& s, bool persistent = false) const;
 
     void setContent(const char* value);
 
+    void setLiteralContent(const char* value);
+
     void setAlignment(int _alignment);
     bool getAlignment(int& _alignment) const;
 
@@ -199,6 +205,7 @@ private:
 
     int used;
     mutable App::ExpressionPtr expression;
+    mutable std::unique_ptr<App::ExpressionProgram> program;
     int alignment;
     std::set<std::string> style;
     Base::Color foregroundColor;
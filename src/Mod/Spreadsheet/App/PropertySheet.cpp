@@ -70,6 +70,8 @@ void PropertySheet::clear()
     cellToPropertyNameMap.clear();
     documentObjectToCellMap.clear();
     cellToDocumentObjectMap.clear();
+    cellToDependentCellMap.clear();
+    cellToPrecedentCellMap.clear();
     aliasProp.clear();
     revAliasProp.clear();
 
@@ -286,6 +288,8 @@ PropertySheet::PropertySheet(const PropertySheet& other)
     , cellToPropertyNameMap(other.cellToPropertyNameMap)
     , documentObjectToCellMap(other.documentObjectToCellMap)
     , cellToDocumentObjectMap(other.cellToDocumentObjectMap)
+    , cellToDependentCellMap(other.cellToDependentCellMap)
+    , cellToPrecedentCellMap(other.cellToPrecedentCellMap)
     , aliasProp(other.aliasProp)
     , revAliasProp(other.revAliasProp)
     , updateCount(other.updateCount)
@@ -700,6 +704,13 @@ void PropertySheet::setContent(CellAddress address, const char* value)
     cell->setContent(value);
 }
 
+void PropertySheet::setLiteralContent(CellAddress address, const char* value)
+{
+    Cell* cell = nonNullCellAt(address);
+    assert(cell);
+    cell->setLiteralContent(value);
+}
+
 void PropertySheet::setAlignment(CellAddress address, int _alignment)
 {
     Cell* cell = nonNullCellAt(address);
@@ -1380,6 +1391,15 @@ void PropertySheet::addDependencies(CellAddress key)
                 propertyNameToCellMap[propName].insert(key);
                 cellToPropertyNameMap[key].insert(propName);
 
+                // A cell of this sheet?
+                if (docObj == owner && !name.empty()) {
+                    CellAddress addr = stringToAddress(name.c_str(), true);
+                    if (addr.isValid() && addr.toString() == name) {
+                        cellToDependentCellMap[addr].insert(key);
+                        cellToPrecedentCellMap[key].insert(addr);
+                    }
+                }
+
                 // Also an alias?
                 if (!name.empty() && docObj->isDerivedFrom<Sheet>()) {
                     auto other = static_cast<Sheet*>(docObj);
@@ -1392,6 +1412,11 @@ void PropertySheet::addDependencies(CellAddress key)
                         // Insert into maps
                         propertyNameToCellMap[propName].insert(key);
                         cellToPropertyNameMap[key].insert(std::move(propName));
+
+                        if (docObj == owner) {
+                            cellToDependentCellMap[j->second].insert(key);
+                            cellToPrecedentCellMap[key].insert(j->second);
+                        }
                     }
                 }
             }
@@ -1430,6 +1455,26 @@ void PropertySheet::removeDependencies(CellAddress key)
         cellToPropertyNameMap.erase(i1);
     }
 
+    /* Remove from Cell <-> Key maps */
+
+    auto i3 = cellToPrecedentCellMap.find(key);
+
+    if (i3 != cellToPrecedentCellMap.end()) {
+        for (const auto& precedent : i3->second) {
+            auto k = cellToDependentCellMap.find(precedent);
+
+            if (k != cellToDependentCellMap.end()) {
+                k->second.erase(key);
+
+                if (k->second.empty()) {
+                    cellToDependentCellMap.erase(k);
+                }
+            }
+        }
+
+        cellToPrecedentCellMap.erase(i3);
+    }
+
     /* Remove from DocumentObject <-> Key maps */
 
     std::map<CellAddress, std::set<std::string>>::iterator i2 = cellToDocumentObjectMap.find(key);
@@ -1649,6 +1694,19 @@ const std::set<std::string>& PropertySheet::getDeps(CellAddress pos) const
     }
 }
 
+const std::set<CellAddress>& PropertySheet::getDependentCells(CellAddress pos) const
+{
+    static std::set<CellAddress> empty;
+    auto i = cellToDependentCellMap.find(pos);
+
+    if (i != cellToDependentCellMap.end()) {
+        return i->second;
+    }
+    else {
+        return empty;
+    }
+}
+
 void PropertySheet::recomputeDependencies(CellAddress key)
 {
     AtomicPropertyChange signaller(*this);
@@ -103,6 +103,8 @@ public:
 
     void setContent(App::CellAddress address, const char* value);
 
+    void setLiteralContent(App::CellAddress address, const char* value);
+
     void setAlignment(App::CellAddress address, int _alignment);
 
     void setStyle(App::CellAddress address, const std::set<std::string>& _style);
@@ -209,6 +211,9 @@ public:
 
     const std::set<std::string>& getDeps(App::CellAddress pos) const;
 
+    /// The cells of this sheet that have to be recomputed when the cell at \a pos changes
+    const std::set<App::CellAddress>& getDependentCells(App::CellAddress pos) const;
+
     void recomputeDependencies(App::CellAddress key);
 
     PyObject* getPyObject() override;
@@ -331,6 +336,15 @@ private:
     /*! DocumentObject this cell depends on */
     std::map<App::CellAddress, std::set<std::string>> cellToDocumentObjectMap;
 
+    /*! Cell dependencies within this sheet, i.e. when the cell given in key changes, the set of
+      addresses needs to be recomputed. Same as propertyNameToCellMap for the cells of this
+      sheet, without building and comparing their full names.
+      */
+    std::map<App::CellAddress, std::set<App::CellAddress>> cellToDependentCellMap;
+
+    /*! Cells of this sheet this cell depends on */
+    std::map<App::CellAddress, std::set<App::CellAddress>> cellToPrecedentCellMap;
+
     /*! Mapping of cell position to alias property */
     std::map<App::CellAddress, std::string> aliasProp;
 
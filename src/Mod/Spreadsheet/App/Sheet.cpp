@@ -242,7 +242,7 @@ bool Sheet::importFromFile(const std::string& filename,
                      i != tok.end();
                      ++i) {
                     if (!i->empty()) {
-                        setCell(CellAddress(row, col), (*i).c_str());
+                        cells.setLiteralContent(CellAddress(row, col), (*i).c_str());
                     }
                     col++;
                 }
@@ -768,8 +768,15 @@ void Sheet::updateProperty(CellAddress key)
         const Expression* input = cell->getExpression();
 
         if (input) {
-            CurrentAddressLock lock(currentRow, currentCol, key);
-            output.reset(input->eval());
+            // Arithmetic on numbers and cell references runs from the compiled expression
+            App::any value;
+            if (cell->getProgram()->eval(value)) {
+                output = std::make_unique<NumberExpression>(this, anyToQuantity(value));
+            }
+            else {
+                CurrentAddressLock lock(currentRow, currentCol, key);
+                output.reset(input->eval());
+            }
         }
         else {
             std::string s;
@@ -851,6 +858,16 @@ Property* Sheet::getPropertyByName(const char* name) const
     }
 }
 
+bool Sheet::getCellProperties(const App::Range& range, std::vector<Property*>& props) const
+{
+    App::Range r(range);
+    props.reserve(props.size() + r.size());
+    do {
+        props.push_back(getProperty(*r));
+    } while (r.next());
+    return true;
+}
+
 Property* Sheet::getDynamicPropertyByName(const char* name) const
 {
     CellAddress addr = getCellAddress(name, true);
@@ -1043,6 +1060,9 @@ void Sheet::updateBindings()
 
 DocumentObjectExecReturn* Sheet::execute()
 {
+    // Recomputing many cells changes many cell properties, notify once per property
+    App::ChangeSignalBatch signalBatch;
+
     updateBindings();
 
     // Get dirty cells that we have to recompute
@@ -1054,9 +1074,11 @@ DocumentObjectExecReturn* Sheet::execute()
         dirtyCells.insert(cellError);
     }
 
+    // Only the dirty cells and the cells downstream of them are in the graph. The vertices are
+    // numbered in the order they are added, so VertexIndexList maps them back to their cells.
     DependencyList graph;
     std::map<CellAddress, Vertex> VertexList;
-    std::map<Vertex, CellAddress> VertexIndexList;
+    std::vector<CellAddress> VertexIndexList;
     std::deque<CellAddress> workQueue(dirtyCells.begin(), dirtyCells.end());
     while (!workQueue.empty()) {
         CellAddress currPos = workQueue.front();
@@ -1066,7 +1088,7 @@ DocumentObjectExecReturn* Sheet::execute()
         auto res = VertexList.emplace(currPos, Vertex());
         if (res.second) {
             res.first->second = add_vertex(graph);
-            VertexIndexList[res.first->second] = currPos;
+            VertexIndexList.push_back(currPos);
         }
 
         // Process cells that depend on the current cell
@@ -1074,7 +1096,7 @@ DocumentObjectExecReturn* Sheet::execute()
             auto resDep = VertexList.emplace(dep, Vertex());
             if (resDep.second) {
                 resDep.first->second = add_vertex(graph);
-                VertexIndexList[resDep.first->second] = dep;
+                VertexIndexList.push_back(dep);
                 if (dirtyCells.insert(dep).second) {
                     workQueue.push_back(dep);
                 }
@@ -1638,9 +1660,9 @@ void Sheet::providesTo(CellAddress address, std::set<std::string>& result) const
  * @param result Set of links.
  */
 
-std::set<CellAddress> Sheet::providesTo(CellAddress address) const
+const std::set<CellAddress>& Sheet::providesTo(CellAddress address) const
 {
-    return cells.getDeps(getFullName() + "." + address.toString());
+    return cells.getDependentCells(address);
 }
 
 void Sheet::onDocumentRestored()
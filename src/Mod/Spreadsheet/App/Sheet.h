@@ -192,6 +192,9 @@ public:
 
     App::Property* getDynamicPropertyByName(const char* name) const override;
 
+    bool getCellProperties(const App::Range& range,
+                           std::vector<App::Property*>& props) const override;
+
     void
     getPropertyNamedList(std::vector<std::pair<const char*, App::Property*>>& List) const override;
 
@@ -246,7 +249,7 @@ protected:
 
     void updateColumnsOrRows(bool horizontal, int section, int count);
 
-    std::set<App::CellAddress> providesTo(App::CellAddress address) const;
+    const std::set<App::CellAddress>& providesTo(App::CellAddress address) const;
 
     void onDocumentRestored() override;
 
@@ -2016,3 +2016,54 @@ class SpreadsheetCases(unittest.TestCase):
         self.assertEqual(sheet.get("G8"), 10)
         self.assertEqual(sheet.get("G9"), 20)
         self.assertEqual(sheet.get("G10"), 10)
+
+    def testIncrementalRecompute(self):
+        """Testing the recompute of the cells downstream of a changed cell"""
+        sheet = self.doc.addObject("Spreadsheet::Sheet", "Spreadsheet")
+        sheet.set("A1", "1")
+        for row in range(2, 101):
+            sheet.set("A{}".format(row), "=A{} + 1".format(row - 1))
+        sheet.set("B1", "=A100 * 2 mm")
+        sheet.set("B2", "=A1 / 4")
+        sheet.setAlias("A50", "middle")
+        sheet.set("B3", "=middle - A1")
+        self.doc.recompute()
+        self.assertEqual(sheet.A100, 100)
+        self.assertEqual(sheet.B1, FreeCAD.Units.Quantity("200 mm"))
+        self.assertEqual(sheet.B2, 0.25)
+        self.assertEqual(sheet.B3, 49)
+
+        sheet.set("A1", "2.5")
+        self.doc.recompute()
+        self.assertEqual(sheet.A100, 101.5)
+        self.assertEqual(sheet.B1, FreeCAD.Units.Quantity("203 mm"))
+        self.assertEqual(sheet.B2, 0.625)
+        self.assertEqual(sheet.B3, 49)
+
+        # a referenced cell that turns into text makes its dependents fail
+        sheet.set("A99", "text")
+        self.doc.recompute()
+        self.assertTrue(sheet.A100.startswith("ERR:"))
+        sheet.set("A99", "=A98 + 1")
+        self.doc.recompute()
+        self.assertEqual(sheet.A100, 101.5)
+
+    def testImportFileAndAggregates(self):
+        """Testing the values of an imported file and aggregates over its ranges"""
+        sheet = self.doc.addObject("Spreadsheet::Sheet", "Spreadsheet")
+        fileName = os.path.join(self.TempPath, "testImportFile.csv")
+        with open(fileName, "w") as f:
+            f.write("Part,Count,Length\n")
+            for row in range(1, 101):
+                f.write("10x M{} screw,{},{} mm\n".format(row, row, row / 2))
+            f.write("=sum(B2:B101),=average(C2:C101),=max(B2:B101)\n")
+        self.assertTrue(sheet.importFile(fileName, ","))
+        os.remove(fileName)
+        self.doc.recompute()
+        self.assertEqual(sheet.A1, "Part")
+        self.assertEqual(sheet.A2, "10x M1 screw")
+        self.assertEqual(sheet.B3, 2)
+        self.assertEqual(sheet.C3, FreeCAD.Units.Quantity("1 mm"))
+        self.assertEqual(sheet.A102, 5050)
+        self.assertEqual(sheet.B102, FreeCAD.Units.Quantity("25.25 mm"))
+        self.assertEqual(sheet.C102, 100)
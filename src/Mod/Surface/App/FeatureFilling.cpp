@@ -143,7 +143,7 @@ void Filling::addConstraints(BRepFill_Filling& builder,
 
             if (obj && obj->isDerivedFrom<Part::Feature>()) {
                 // get the sub-edge of the part's shape
-                const Part::TopoShape& shape = static_cast<Part::Feature*>(obj)->Shape.getShape();
+                Part::TopoShape shape(static_cast<Part::Feature*>(obj)->Shape.getValue());
                 TopoDS_Shape edge = shape.getSubShape(sub.c_str());
                 if (!edge.IsNull() && edge.ShapeType() == TopAbs_EDGE) {
                     GeomAbs_Shape cont = static_cast<GeomAbs_Shape>(contvals[index]);
@@ -218,7 +218,7 @@ void Filling::addConstraints(BRepFill_Filling& builder,
             App::DocumentObject* obj = face_obj[index];
             const std::string& sub = face_sub[index];
             if (obj && obj->isDerivedFrom<Part::Feature>()) {
-                const Part::TopoShape& shape = static_cast<Part::Feature*>(obj)->Shape.getShape();
+                Part::TopoShape shape(static_cast<Part::Feature*>(obj)->Shape.getValue());
                 TopoDS_Shape face = shape.getSubShape(sub.c_str());
                 if (!face.IsNull() && face.ShapeType() == TopAbs_FACE) {
                     GeomAbs_Shape cont = static_cast<GeomAbs_Shape>(contvals[index]);
@@ -242,7 +242,7 @@ void Filling::addConstraints(BRepFill_Filling& builder, const App::PropertyLinkS
         App::DocumentObject* obj = it.first;
         std::vector<std::string> sub = it.second;
         if (obj && obj->isDerivedFrom<Part::Feature>()) {
-            const Part::TopoShape& shape = static_cast<Part::Feature*>(obj)->Shape.getShape();
+            Part::TopoShape shape(static_cast<Part::Feature*>(obj)->Shape.getValue());
             for (const auto& jt : sub) {
                 TopoDS_Shape subShape = shape.getSubShape(jt.c_str());
                 if (!subShape.IsNull() && subShape.ShapeType() == TopAbs_VERTEX) {
@@ -288,7 +288,7 @@ App::DocumentObjectExecReturn* Filling::execute()
         // Load the initial surface if set
         App::DocumentObject* initFace = InitialFace.getValue();
         if (initFace && initFace->isDerivedFrom<Part::Feature>()) {
-            const Part::TopoShape& shape = static_cast<Part::Feature*>(initFace)->Shape.getShape();
+            Part::TopoShape shape(static_cast<Part::Feature*>(initFace)->Shape.getValue());
             std::vector<std::string> subNames = InitialFace.getSubValues();
             for (const auto& it : subNames) {
                 TopoDS_Shape subShape = shape.getSubShape(it.c_str());
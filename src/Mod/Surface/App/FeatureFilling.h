@@ -69,6 +69,11 @@ public:
     // recalculate the feature
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
+    /// reads its inputs through copies of their shapes, so several can be built at once
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     /// returns the type name of the view provider
     const char* getViewProviderName() const override
     {
@@ -216,9 +216,8 @@ bool GeomFillSurface::getWire(TopoDS_Wire& aWire)
     ShapeValidator validator;
     for (const auto& set : boundary) {
         if (set.first->isDerivedFrom<Part::Feature>()) {
+            Part::TopoShape ts(static_cast<Part::Feature*>(set.first)->Shape.getValue());
             for (const auto& jt : set.second) {
-                const Part::TopoShape& ts =
-                    static_cast<Part::Feature*>(set.first)->Shape.getShape();
                 validator.checkAndAdd(ts, jt.c_str(), &aWD);
             }
         }
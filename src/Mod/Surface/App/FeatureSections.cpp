@@ -58,7 +58,7 @@ App::DocumentObjectExecReturn* Sections::execute()
             const std::string& sub = edge_sub[index];
             if (obj && obj->isDerivedFrom<Part::Feature>()) {
                 // get the sub-edge of the part's shape
-                const Part::TopoShape& shape = static_cast<Part::Feature*>(obj)->Shape.getShape();
+                Part::TopoShape shape(static_cast<Part::Feature*>(obj)->Shape.getValue());
                 TopoDS_Shape edge = shape.getSubShape(sub.c_str());
                 if (!edge.IsNull() && edge.ShapeType() == TopAbs_EDGE) {
                     BRepAdaptor_Curve curve_adapt(TopoDS::Edge(edge));
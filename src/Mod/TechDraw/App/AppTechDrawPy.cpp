@@ -69,6 +69,7 @@
 #include "Geometry.h"
 #include "GeometryObject.h"
 #include "ProjectionAlgos.h"
+#include "SVGPageWriter.h"
 #include "TechDrawExport.h"
 #include "DrawLeaderLinePy.h"
 
@@ -144,6 +145,12 @@ public:
         add_varargs_method("writeDXFPage", &Module::writeDXFPage,
             "writeDXFPage(page, filename): Exports a DrawPage to a DXF file."
         );
+        add_varargs_method("writeSVGPage", &Module::writeSVGPage,
+            "writeSVGPage(page, filename): Exports a DrawPage to an SVG file from the geometry of its views."
+        );
+        add_varargs_method("writeSVGPages", &Module::writeSVGPages,
+            "writeSVGPages([(page, filename), ...]): Exports DrawPages to SVG files, several pages at a time."
+        );
         add_varargs_method("findCentroid", &Module::findCentroid,
             "vector = findCentroid(shape, direction): finds geometric centroid of shape looking in direction."
         );
@@ -828,6 +835,63 @@ private:
         return Py::None();
     }
 
+    Py::Object writeSVGPage(const Py::Tuple& args)
+    {
+        PyObject *pageObj(nullptr);
+        char* name(nullptr);
+        if (!PyArg_ParseTuple(args.ptr(), "O!et", &(TechDraw::DrawPagePy::Type), &pageObj,
+                              "utf-8", &name)) {
+            throw Py::TypeError("expected (page, path");
+        }
+
+        std::string filePath = std::string(name);
+        PyMem_Free(name);
+
+        try {
+            auto* dPage = static_cast<TechDraw::DrawPage*>(
+                static_cast<App::DocumentObjectPy*>(pageObj)->getDocumentObjectPtr());
+            TechDraw::SVGPageWriter(dPage).write(filePath);
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        return Py::None();
+    }
+
+    Py::Object writeSVGPages(const Py::Tuple& args)
+    {
+        PyObject *pagesObj(nullptr);
+        if (!PyArg_ParseTuple(args.ptr(), "O", &pagesObj) || !PySequence_Check(pagesObj)) {
+            throw Py::TypeError("expected ([(page, path), ...])");
+        }
+
+        std::vector<std::pair<TechDraw::DrawPage*, std::string>> pages;
+        Py::Sequence items(pagesObj);
+        for (const auto& item : items) {
+            PyObject* pageObj(nullptr);
+            char* name(nullptr);
+            if (!PyTuple_Check(item.ptr())
+                || !PyArg_ParseTuple(item.ptr(), "O!et", &(TechDraw::DrawPagePy::Type), &pageObj,
+                                     "utf-8", &name)) {
+                throw Py::TypeError("expected ([(page, path), ...])");
+            }
+            auto* dPage = static_cast<TechDraw::DrawPage*>(
+                static_cast<App::DocumentObjectPy*>(pageObj)->getDocumentObjectPtr());
+            pages.emplace_back(dPage, std::string(name));
+            PyMem_Free(name);
+        }
+
+        try {
+            TechDraw::SVGPageWriter::writePages(pages);
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        return Py::None();
+    }
+
     Py::Object findCentroid(const Py::Tuple& args)
     {
         PyObject *pcObjShape(nullptr);
@@ -35,6 +35,20 @@ using namespace TechDraw;
 using namespace std;
 using DU = DrawUtil;
 
+namespace {
+//! the position of the geometry made for the cosmetic with the given tag, or -1 if there is none
+template<typename GeomPtr>
+int findCosmeticGeometry(const std::vector<GeomPtr>& geoms, const std::string& tag)
+{
+    for (size_t i = 0; i < geoms.size(); i++) {
+        if (geoms[i]->getCosmeticTag() == tag) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+}
+
 EXTENSION_PROPERTY_SOURCE(TechDraw::CosmeticExtension, App::DocumentObjectExtension)
 
 CosmeticExtension::CosmeticExtension()
@@ -133,6 +147,12 @@ int CosmeticExtension::add1CVToGV(const std::string& tag)
         Base::Console().message("CE::add1CVToGV - cv %s not found\n", tag.c_str());
         return 0;
     }
+    //the view adds a new cosmetic to its geometry as soon as the property changes
+    int iExisting = findCosmeticGeometry(getOwner()->getVertexGeometry(), tag);
+    if (iExisting >= 0) {
+        cv->linkGeom = iExisting;
+        return iExisting;
+    }
     double scale = getOwner()->getScale();
     double rotDegrees = getOwner()->Rotation.getValue();
     Base::Vector3d cvPosition = cv->rotatedAndScaled(scale, rotDegrees);
@@ -313,6 +333,10 @@ int CosmeticExtension::add1CEToGE(const std::string& tag)
         Base::Console().message("CEx::add1CEToGE 2 - ce %s not found\n", tag.c_str());
         return -1;
     }
+    int iExisting = findCosmeticGeometry(getOwner()->getEdgeGeometry(), tag);
+    if (iExisting >= 0) {
+        return iExisting;
+    }
     double scale = getOwner()->getScale();
     double rotDegrees = getOwner()->Rotation.getValue();
     TechDraw::BaseGeomPtr scaledGeom = ce->scaledAndRotatedGeometry(scale, rotDegrees);
@@ -336,7 +360,7 @@ void CosmeticExtension::refreshCEGeoms()
     addCosmeticEdgesToGeom();
 }
 
-/// adds a new cosmetic edge to the list property.  does not add to display geometry until dvp executes.
+/// adds a new cosmetic edge to the list property.  the view adds it to its display geometry.
 /// returns unique CE id
 std::string CosmeticExtension::addCosmeticEdge(Base::Vector3d start,
                                                Base::Vector3d end)
@@ -349,7 +373,7 @@ std::string CosmeticExtension::addCosmeticEdge(Base::Vector3d start,
     return ce->getTagAsString();
 }
 
-/// adds a new cosmetic edge to the list property.  does not add to display geometry until dvp executes.
+/// adds a new cosmetic edge to the list property.  the view adds it to its display geometry.
 /// returns unique CE id
 std::string CosmeticExtension::addCosmeticEdge(TechDraw::BaseGeomPtr bg)
 {
@@ -454,6 +478,10 @@ int CosmeticExtension::add1CLToGE(const std::string& tag)
 //        Base::Console().message("CEx::add1CLToGE 2 - cl %s not found\n", tag.c_str());
         return -1;
     }
+    int iExisting = findCosmeticGeometry(getOwner()->getEdgeGeometry(), tag);
+    if (iExisting >= 0) {
+        return iExisting;
+    }
     TechDraw::BaseGeomPtr scaledGeom = cl->scaledAndRotatedGeometry(getOwner());
     int iGE = getOwner()->getGeometryObject()->addCenterLine(scaledGeom, tag);
 
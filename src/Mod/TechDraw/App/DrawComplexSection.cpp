@@ -81,6 +81,7 @@
 #include <HLRAlgo_Projector.hxx>
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QtConcurrentMap>
 #include <QtConcurrentRun>
 #include <ShapeExtend_WireData.hxx>
 #include <TopExp.hxx>
@@ -102,6 +103,7 @@
 #include <GeomLib_IsPlanarSurface.hxx>
 
 #include <cmath>
+#include <exception>
 
 #include <sstream>
 
@@ -336,8 +338,18 @@ void DrawComplexSection::makeAlignedPieces(const TopoDS_Shape& rawShape)
     std::vector<std::pair<int, Base::Vector3d>> faceNormals = getSegmentViewDirections(profileWire, uSectionNormal);
 
     // faceNormals are not in the same order as the faces(sometimes??).
+    struct Segment
+    {
+        TopoDS_Face face;
+        int segmentIndex;
+        Base::Vector3d segmentNormal;
+        double pieceVertical{0};
+        Base::Vector3d pieceSize;
+        TopoDS_Shape pieceOnPlane;
+    };
+    std::vector<Segment> segments;
     TopExp_Explorer expFaces(m_toolFaceShape, TopAbs_FACE);
-    for (int iPiece = 0; expFaces.More(); expFaces.Next(), iPiece++) {
+    for (; expFaces.More(); expFaces.Next()) {
         TopoDS_Face face = TopoDS::Face(expFaces.Current());
         if (!isFacePlanar(face)) {
             // TODO: continue blocks curved profile segments (which doesn't work right).
@@ -355,36 +367,57 @@ void DrawComplexSection::makeAlignedPieces(const TopoDS_Shape& rawShape)
         if (!showSegment(segmentNormal)) {
             continue;
         }
+        segments.push_back({face, segmentIndex, segmentNormal});
+    }
+
+    // the pieces of the segments are cut from the shape concurrently. The boolean operations
+    // don't modify the shape.
+    std::vector<std::exception_ptr> errors(segments.size());
+    QtConcurrent::blockingMap(segments, [&](Segment& segment) {
+        try {
+            int segmentIndex = segment.segmentIndex;
+            TopoDS_Shape rotatedPiece = cutAndRotatePiece(rawShape, segment.face, segmentIndex,
+                                                          segment.segmentNormal,
+                                                          segment.pieceVertical);
+            if (debugSection()) {
+                stringstream ss;
+                ss << "DCSmakeAlignedPieces_cutAndRotatedPiece" << segmentIndex << ".brep";
+                BRepTools::Write(rotatedPiece, ss.str().c_str());//debug
+            }
 
-        double pieceVertical{0};
-        TopoDS_Shape rotatedPiece = cutAndRotatePiece(rawShape, face, segmentIndex, segmentNormal, pieceVertical);
-        if (debugSection()) {
-            stringstream ss;
-            ss << "DCSmakeAlignedPieces_cutAndRotatedPiece" << segmentIndex << ".brep";
-            BRepTools::Write(rotatedPiece, ss.str().c_str());//debug
-        }
+            AlignedSizeResponse sizeResponse = getAlignedSize(rotatedPiece, segmentIndex);
+            segment.pieceSize = sizeResponse.pieceSize;    // size in ProjectionCS.
 
-        AlignedSizeResponse sizeResponse = getAlignedSize(rotatedPiece, segmentIndex);
-        Base::Vector3d pieceSize = sizeResponse.pieceSize;
-        pieceXSizeAll.at(segmentIndex) = pieceSize.x;    // size in ProjectionCS.
-        pieceYSizeAll.at(segmentIndex) = pieceSize.y;
-        pieceZSizeAll.at(segmentIndex) = pieceSize.z;
-        pieceVerticalAll.at(segmentIndex) = pieceVertical;
+            if (debugSection()) {
+                stringstream ss;
+                ss << "DCSAlignedPiece" << segmentIndex << ".brep";
+                BRepTools::Write(sizeResponse.alignedPiece, ss.str().c_str());//debug
+            }
 
-        if (debugSection()) {
-            stringstream ss;
-            ss << "DCSAlignedPiece" << segmentIndex << ".brep";
-            BRepTools::Write(sizeResponse.alignedPiece, ss.str().c_str());//debug
+            segment.pieceOnPlane = movePieceToPaperPlane(sizeResponse.alignedPiece, sizeResponse.zMax);
+            if (debugSection()) {
+                stringstream ss;
+                ss << "DCSpieceOnPlane" << segmentIndex << ".brep";
+                BRepTools::Write(segment.pieceOnPlane, ss.str().c_str());//debug
+            }
         }
-
-        auto pieceOnPlane = movePieceToPaperPlane(sizeResponse.alignedPiece, sizeResponse.zMax);
-        if (debugSection()) {
-            stringstream ss;
-            ss << "DCSpieceOnPlane" << segmentIndex << ".brep";
-            BRepTools::Write(pieceOnPlane, ss.str().c_str());//debug
+        catch (...) {
+            errors[&segment - segments.data()] = std::current_exception();
+        }
+    });
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
         }
+    }
+
+    for (auto& segment : segments) {
+        pieceXSizeAll.at(segment.segmentIndex) = segment.pieceSize.x;
+        pieceYSizeAll.at(segment.segmentIndex) = segment.pieceSize.y;
+        pieceZSizeAll.at(segment.segmentIndex) = segment.pieceSize.z;
+        pieceVerticalAll.at(segment.segmentIndex) = segment.pieceVertical;
         // pieceOnPlane is on the paper plane, with piece centroid at the origin
-        pieces.at(segmentIndex) = pieceOnPlane;
+        pieces.at(segment.segmentIndex) = segment.pieceOnPlane;
     }
 
     if (pieces.empty()) {
@@ -21,8 +21,10 @@
  ***************************************************************************/
 
 
+# include <exception>
 # include <iomanip>
 # include <limits>
+# include <numeric>
 # include <sstream>
 
 #include <Bnd_Box.hxx>
@@ -44,6 +46,8 @@
 #include <TopoDS_Compound.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
 
+#include <QtConcurrentMap>
+
 #include <App/Application.h>
 #include <App/Document.h>
 #include <Base/Console.h>
@@ -66,6 +70,33 @@
 using namespace TechDraw;
 using DU = DrawUtil;
 
+namespace {
+//! trim the hatch lines to each of the faces. The common operations of the faces with the pattern
+//! grid are independent of each other, so the faces are trimmed concurrently.
+template<typename Trim>
+std::vector<std::vector<LineSet>> trimFaces(const std::vector<TopoDS_Face>& faces, Trim trim)
+{
+    std::vector<std::vector<LineSet>> result(faces.size());
+    std::vector<std::exception_ptr> errors(faces.size());
+    std::vector<size_t> indices(faces.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    QtConcurrent::blockingMap(indices, [&](size_t i) {
+        try {
+            result[i] = trim(faces[i]);
+        }
+        catch (...) {
+            errors[i] = std::current_exception();
+        }
+    });
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return result;
+}
+}
+
 App::PropertyFloatConstraint::Constraints DrawGeomHatch::scaleRange = {
     Precision::Confusion(), std::numeric_limits<double>::max(), (0.1)}; // increment by 0.1
 
@@ -247,6 +278,53 @@ std::vector<LineSet>  DrawGeomHatch::getTrimmedLines(int iFace)   //get the trim
                            PatternRotation.getValue(), PatternOffset.getValue());
 }
 
+//! get the trimmed hatch lines for each of the faces
+std::vector<std::vector<LineSet>> DrawGeomHatch::getTrimmedLines(const std::vector<int>& faceIndexes)
+{
+    if (m_lineSets.empty()) {
+        makeLineSets();
+    }
+
+    DrawViewPart* source = getSourceView();
+    if (!source ||
+        !source->hasGeometry()) {
+        return std::vector<std::vector<LineSet>>(faceIndexes.size());
+    }
+    std::vector<TopoDS_Face> faces;
+    faces.reserve(faceIndexes.size());
+    for (int iFace : faceIndexes) {
+        faces.push_back(extractFace(source, iFace));
+    }
+    return getTrimmedLines(source, m_lineSets, faces, ScalePattern.getValue(),
+                           PatternRotation.getValue(), PatternOffset.getValue());
+}
+
+/* static */
+std::vector<std::vector<LineSet>> DrawGeomHatch::getTrimmedLines(DrawViewPart* source,
+                                                                 const std::vector<LineSet>& lineSets,
+                                                                 const std::vector<TopoDS_Face>& faces,
+                                                                 double scale,
+                                                                 double hatchRotation,
+                                                                 Base::Vector3d hatchOffset)
+{
+    return trimFaces(faces, [&](const TopoDS_Face& face) {
+        return getTrimmedLines(source, lineSets, face, scale, hatchRotation, hatchOffset);
+    });
+}
+
+/* static */
+std::vector<std::vector<LineSet>> DrawGeomHatch::getTrimmedLinesSection(DrawViewSection* source,
+                                                                        const std::vector<LineSet>& lineSets,
+                                                                        const std::vector<TopoDS_Face>& faces,
+                                                                        double scale,
+                                                                        double hatchRotation,
+                                                                        Base::Vector3d hatchOffset)
+{
+    return trimFaces(faces, [&](const TopoDS_Face& face) {
+        return getTrimmedLinesSection(source, lineSets, face, scale, hatchRotation, hatchOffset);
+    });
+}
+
 /* static */
 std::vector<LineSet>  DrawGeomHatch::getTrimmedLinesSection(DrawViewSection* source,
                                                             std::vector<LineSet> lineSets,
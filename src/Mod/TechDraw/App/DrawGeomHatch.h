@@ -92,6 +92,18 @@ public:
                                                                 TopoDS_Face face,
                                                                 double scale , double hatchRotation = 0.0,
                                                                 Base::Vector3d hatchOffset = Base::Vector3d(0.0, 0.0, 0.0));
+    //! the multiple face variants trim the faces concurrently
+    std::vector<std::vector<LineSet>> getTrimmedLines(const std::vector<int>& faceIndexes);
+    static std::vector<std::vector<LineSet>> getTrimmedLines(DrawViewPart* source,
+                                                             const std::vector<LineSet>& lineSets,
+                                                             const std::vector<TopoDS_Face>& faces,
+                                                             double scale, double hatchRotation,
+                                                             Base::Vector3d hatchOffset);
+    static std::vector<std::vector<LineSet>> getTrimmedLinesSection(DrawViewSection* source,
+                                                                    const std::vector<LineSet>& lineSets,
+                                                                    const std::vector<TopoDS_Face>& faces,
+                                                                    double scale, double hatchRotation,
+                                                                    Base::Vector3d hatchOffset);
 
     static std::vector<TopoDS_Edge> makeEdgeOverlay(PATLineSpec hatchLine, Bnd_Box bBox,
                                     double scale, double rotation);
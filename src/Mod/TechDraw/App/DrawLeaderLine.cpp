@@ -351,7 +351,8 @@ DrawLeaderLine* DrawLeaderLine::makeLeader(DrawViewPart* parent, std::vector<Bas
     leaderFeature->StartSymbol.setValue(iStartSymbol);
     leaderFeature->EndSymbol.setValue(iEndSymbol);
 
-    parent->touch();
+    // only for the tree, the leader doesn't change the geometry of its parent
+    parent->touch(true);
 
     return leaderFeature;
 }
@@ -112,6 +112,7 @@ App::DocumentObjectExecReturn *DrawProjGroupItem::execute()
     }
 
     if (waitingForHlr()) {
+        hlrOutdated(true);
         return DrawView::execute();
     }
 
@@ -24,7 +24,9 @@
 # include <algorithm>
 # include <limits>
 # include <sstream>
+#include <Bnd_BoundSortBox.hxx>
 #include <Bnd_Box.hxx>
+#include <Bnd_HArray1OfBox.hxx>
 #include <BRep_Tool.hxx>
 #include <BRepAdaptor_Curve.hxx>
 #include <Mod/Part/App/FCBRepAlgoAPI_Common.h>
@@ -591,15 +593,16 @@ std::vector<TopoDS_Edge> DrawProjectSplit::removeOverlapEdges(const std::vector<
     std::vector<TopoDS_Edge> outEdges;
     std::vector<TopoDS_Edge> overlapEdges;
     std::vector<bool> skipThisEdge(inEdges.size(), false);
+    //only the edges whose boxes intersect can overlap
+    std::vector<std::vector<int>> nearby = nearbyEdges(inEdges);
     int edgeCount = inEdges.size();
     int ie0 = 0;
     for (; ie0 < edgeCount; ie0++) {
         if (skipThisEdge.at(ie0)) {
             continue;
         }
-        int ie1 = ie0 + 1;
-        for (; ie1 < edgeCount; ie1++) {
-            if (skipThisEdge.at(ie1)) {
+        for (int ie1 : nearby.at(ie0)) {
+            if (ie1 <= ie0 || skipThisEdge.at(ie1)) {
                 continue;
             }
             int rc = isSubset(inEdges.at(ie0), inEdges.at(ie1));
@@ -715,6 +718,50 @@ bool DrawProjectSplit::boxesIntersect(const TopoDS_Edge &edge0, const TopoDS_Edg
     return true;
 }
 
+//for each edge, the ascending indices of the other edges whose boxes intersect its box, as tested
+//by boxesIntersect. The boxes are sorted once instead of being compared pairwise.
+std::vector<std::vector<int>> DrawProjectSplit::nearbyEdges(const std::vector<TopoDS_Edge>& edges,
+                                                            bool optimalBoxes)
+{
+    std::vector<std::vector<int>> result(edges.size());
+    if (edges.empty()) {
+        return result;
+    }
+    Handle(Bnd_HArray1OfBox) boxes = new Bnd_HArray1OfBox(1, int(edges.size()));
+    Bnd_Box complete;
+    for (std::size_t i = 0; i < edges.size(); i++) {
+        Bnd_Box box;
+        if (optimalBoxes) {
+            BRepBndLib::AddOptimal(edges[i], box);
+        }
+        else {
+            BRepBndLib::Add(edges[i], box);
+        }
+        box.SetGap(0.1);           //generous
+        boxes->SetValue(int(i) + 1, box);
+        complete.Add(box);
+    }
+    if (complete.IsVoid()) {
+        return result;
+    }
+
+    Bnd_BoundSortBox tree;
+    tree.Initialize(complete, boxes);
+    for (std::size_t i = 0; i < edges.size(); i++) {
+        const Bnd_Box& box = boxes->Value(int(i) + 1);
+        if (box.IsVoid()) {
+            continue;
+        }
+        for (int index : tree.Compare(box)) {
+            if (std::size_t(index - 1) != i && !box.IsOut(boxes->Value(index))) {
+                result[i].push_back(index - 1);
+            }
+        }
+        std::sort(result[i].begin(), result[i].end());
+    }
+    return result;
+}
+
 //this is an aid to debugging and isn't used in normal processing.
 void DrawProjectSplit::dumpVertexMap(vertexMap verts)
 {
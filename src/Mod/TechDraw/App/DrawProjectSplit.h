@@ -130,6 +130,8 @@ public:
                                               const TopoDS_Edge& e1);
     static bool                     boxesIntersect(const TopoDS_Edge& e0,
                                                    const TopoDS_Edge& e1);
+    static std::vector<std::vector<int>> nearbyEdges(const std::vector<TopoDS_Edge>& edges,
+                                                     bool optimalBoxes = false);
     static void dumpVertexMap(vertexMap verts);
 
 };
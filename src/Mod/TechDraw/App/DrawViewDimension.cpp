@@ -562,6 +562,12 @@ bool DrawViewDimension::okToProceed()
         return false;
     }
 
+    if (getViewPart()->showingHlrPreview()) {
+        // the preview geometry would break the references, the dimension is updated once the
+        // exact geometry is available
+        return false;
+    }
+
     // is this check still relevant or is it replaced by the autocorrect and
     // validate methods?
     if (References3D.getValues().empty() && !checkReferences2D()) {
@@ -46,6 +46,9 @@
 #include <BRep_Tool.hxx>
 #include <Bnd_Box.hxx>
 #include <HLRAlgo_Projector.hxx>
+#include <Precision.hxx>
+#include <QThreadPool>
+#include <QtConcurrentMap>
 #include <QtConcurrentRun>
 #include <ShapeAnalysis.hxx>
 #include <TopExp.hxx>
@@ -60,6 +63,7 @@
 #include <gp_Dir.hxx>
 #include <gp_Pln.hxx>
 #include <gp_Pnt.hxx>
+#include <numeric>
 #include <sstream>
 
 
@@ -102,7 +106,9 @@ DrawViewPart::DrawViewPart()
       m_handleFaces(false),
       nowUnsetting(false),
       m_waitingForFaces(false),
-      m_waitingForHlr(false)
+      m_waitingForHlr(false),
+      m_hlrOutdated(false),
+      m_showingHlrPreview(false)
 {
     static const char* group = "Projection";
     static const char* sgroup = "HLR Parameters";
@@ -231,6 +237,7 @@ App::DocumentObjectExecReturn* DrawViewPart::execute()
     }
 
     if (waitingForHlr()) {
+        hlrOutdated(true);
         return DrawView::execute();
     }
 
@@ -262,8 +269,7 @@ short DrawViewPart::mustExecute() const
         || Perspective.isTouched() || Focus.isTouched() || Rotation.isTouched()
         || SmoothVisible.isTouched() || SeamVisible.isTouched() || IsoVisible.isTouched()
         || HardHidden.isTouched() || SmoothHidden.isTouched() || SeamHidden.isTouched()
-        || IsoHidden.isTouched() || IsoCount.isTouched() || CoarseView.isTouched()
-        || CosmeticVertexes.isTouched() || CosmeticEdges.isTouched() || CenterLines.isTouched()) {
+        || IsoHidden.isTouched() || IsoCount.isTouched() || CoarseView.isTouched()) {
         return 1;
     }
 
@@ -285,23 +291,106 @@ void DrawViewPart::onChanged(const App::Property* prop)
         XDirection.setValue(Base::Vector3d(1.0, 0.0, 0.0));
     }
 
+    if (!isRestoring()
+        && (prop == &CosmeticVertexes || prop == &CosmeticEdges || prop == &CenterLines)) {
+        updateCosmeticGeometry(prop);
+    }
+
     DrawView::onChanged(prop);
 }
 
+//! cosmetic vertices, edges and center lines are added on top of the projected geometry, so a
+//! change to them only replaces them in the geometry and repaints the view. The view is not
+//! projected again. While hlr or face finding is running, the cosmetics are added when they finish.
+void DrawViewPart::updateCosmeticGeometry(const App::Property* prop)
+{
+    if (!geometryObject || waitingForResult()) {
+        return;
+    }
+
+    if (prop == &CosmeticVertexes) {
+        refreshCVGeoms();
+    }
+    else if (prop == &CosmeticEdges) {
+        refreshCEGeoms();
+    }
+    else if (prop == &CenterLines) {
+        refreshCLGeoms();
+    }
+
+    //the geometry indices of the cosmetics may have changed, so the dimensions have to find their
+    //references again. They are recomputed with the document, the view itself is not.
+    for (auto& dim : getDimensions()) {
+        dim->touch();
+    }
+    requestPaint();
+}
+
 void DrawViewPart::partExec(TopoDS_Shape& shape)
 {
     if (waitingForHlr()) {
         //finish what we are already doing before starting a new cycle
+        hlrOutdated(true);
         return;
     }
 
     //we need to keep using the old geometryObject until the new one is fully populated
     m_tempGeometryObject = makeGeometryForShape(shape);
-    if (CoarseView.getValue() ||
-        !DU::isGuiUp()) {
-        onHlrFinished();//poly algo and console mode do not run in separate thread, so we need to invoke
-                        //the post hlr processing manually
+    if (!waitingForHlr()) {
+        onHlrFinished();//poly algo, console mode and cached results do not run in separate thread,
+                        //so we need to invoke the post hlr processing manually
+    }
+}
+
+//! the inputs of a hlr run which is reused as long as they don't change. The source shape is
+//! compared by its geometry, since the objects of a view can be recomputed without any change.
+struct DrawViewPart::HlrCache
+{
+    std::vector<double> shapeSignature;
+    gp_Ax2 viewAxis;
+    double rotation;
+    int isoCount;
+    bool perspective;
+    double focus;
+    double scale;
+    HlrResult result;
+
+    bool matches(const HlrCache& other) const
+    {
+        double angularTolerance = Precision::Angular();
+        double linearTolerance = Precision::Confusion();
+        // the orthographic projection of a scaled shape is the scaled projection of the shape,
+        // so only a perspective projection has to be done again for a new scale
+        return shapeSignature == other.shapeSignature
+            && viewAxis.Location().IsEqual(other.viewAxis.Location(), linearTolerance)
+            && viewAxis.Direction().IsEqual(other.viewAxis.Direction(), angularTolerance)
+            && viewAxis.XDirection().IsEqual(other.viewAxis.XDirection(), angularTolerance)
+            && rotation == other.rotation && isoCount == other.isoCount
+            && perspective == other.perspective && focus == other.focus
+            && (!perspective || scale == other.scale);
+    }
+};
+
+//! describe the hlr run for a source shape with the current properties, returns nullptr if the
+//! result can not be reused
+std::unique_ptr<DrawViewPart::HlrCache> DrawViewPart::makeHlrCache(const TopoDS_Shape& shape) const
+{
+    if (CoarseView.getValue()) {
+        //the polygon algo is fast enough to be run every time
+        return nullptr;
     }
+    auto cache = std::make_unique<HlrCache>();
+    cache->shapeSignature = ShapeUtils::shapeSignature(shape);
+    if (cache->shapeSignature.empty()) {
+        return nullptr;
+    }
+    cache->viewAxis = getProjectionCS();
+    cache->rotation = Rotation.getValue();
+    cache->isoCount = IsoCount.getValue();
+    cache->perspective = Perspective.getValue();
+    cache->focus = Focus.getValue();
+    cache->scale = getScale();
+    return cache;
 }
 
 //! prepare the shape for HLR processing by centering, scaling and rotating it
@@ -319,6 +408,21 @@ GeometryObjectPtr DrawViewPart::makeGeometryForShape(TopoDS_Shape& shape)
     m_saveCentroid = Base::convertTo<Base::Vector3d>(gCentroid);
     m_saveShape = centerScaleRotate(this, localShape, m_saveCentroid);
 
+    std::unique_ptr<HlrCache> hlrInputs = makeHlrCache(shape);
+    if (hlrInputs && m_hlrCache && m_hlrCache->matches(*hlrInputs)) {
+        m_hlrPending = nullptr;
+        TechDraw::GeometryObjectPtr go(
+            std::make_shared<TechDraw::GeometryObject>(getNameInDocument(), this));
+        go->setIsoCount(IsoCount.getValue());
+        go->isPerspective(Perspective.getValue());
+        go->setFocus(Focus.getValue());
+        go->usePolygonHLR(CoarseView.getValue());
+        go->setScrubCount(ScrubCount.getValue());
+        go->setHlrResult(m_hlrCache->result, getScale() / m_hlrCache->scale);
+        return go;
+    }
+
+    m_hlrPending = std::move(hlrInputs);
     return buildGeometryObject(localShape, getProjectionCS());
 }
 
@@ -366,6 +470,11 @@ TechDraw::GeometryObjectPtr DrawViewPart::buildGeometryObject(TopoDS_Shape& shap
         return go;
     }
 
+    if (Preferences::previewHlr()) {
+        //this has to happen before the hlr thread starts, since the polygon algo meshes the shape
+        showHlrPreview(shape, viewAxis);
+    }
+
     //projectShape (the HLR process) runs in a separate thread since it can take a long time
     //note that &m_hlrWatcher in the third parameter is not strictly required, but using the
     //4 parameter signature instead of the 3 parameter signature prevents clazy warning:
@@ -377,21 +486,71 @@ TechDraw::GeometryObjectPtr DrawViewPart::buildGeometryObject(TopoDS_Shape& shap
     // This is important because those variables might be local to the calling
     // function and might get destructed before the parallel processing finishes.
     auto lambda = [go, shape, viewAxis]{go->projectShape(shape, viewAxis);};
-    m_hlrFuture = QtConcurrent::run(std::move(lambda));
+    m_hlrFuture = QtConcurrent::run(hlrThreadPool(), std::move(lambda));
     m_hlrWatcher.setFuture(m_hlrFuture);
     waitingForHlr(true);
 
     return go;
 }
 
+//! show the quick result of the polygon hlr algo until the exact result is available. The
+//! geometry of the preview doesn't match the exact one, so dimensions are not updated from it and
+//! the post hlr tasks only run for the exact result.
+void DrawViewPart::showHlrPreview(const TopoDS_Shape& shape, const gp_Ax2& viewAxis)
+{
+    TechDraw::GeometryObjectPtr preview(
+        std::make_shared<TechDraw::GeometryObject>(getNameInDocument(), this));
+    preview->setIsoCount(IsoCount.getValue());
+    preview->isPerspective(Perspective.getValue());
+    preview->setFocus(Focus.getValue());
+    preview->usePolygonHLR(true);
+    preview->setScrubCount(ScrubCount.getValue());
+    try {
+        preview->projectShapeWithPolygonAlgo(shape, viewAxis);
+    }
+    catch (const Base::Exception& e) {
+        //the exact result will show up anyway
+        Base::Console().log("DVP::showHlrPreview - %s - %s\n", getNameInDocument(), e.what());
+        return;
+    }
+
+    geometryObject = preview;
+    m_showingHlrPreview = true;
+    bbox = geometryObject->calcBoundingBox();
+    requestPaint();
+}
+
+//! the hlr runs of all views share a pool of their own, so that the views of a page are projected
+//! concurrently while the shorter tasks that follow hlr (like face finding) don't have to queue
+//! behind the hlr runs of all the other views. The pool is bounded by the number of cores.
+QThreadPool* DrawViewPart::hlrThreadPool()
+{
+    static QThreadPool pool;
+    return &pool;
+}
+
 //! continue processing after hlr thread completes
 void DrawViewPart::onHlrFinished()
 {
+    if (m_hlrOutdated) {
+        //the view was changed while hlr was running, so the result is stale already. OCC hlr
+        //can't be interrupted, but at least nothing is done with the result.
+        m_hlrOutdated = false;
+        m_showingHlrPreview = false;
+        m_tempGeometryObject = nullptr;
+        m_hlrPending = nullptr;
+        waitingForHlr(false);
+        QObject::disconnect(connectHlrWatcher);
+        recomputeFeature();
+        return;
+    }
+
     //now that the new GeometryObject is fully populated, we can replace the old one
     if (m_tempGeometryObject) {
         geometryObject = m_tempGeometryObject;//replace with new
         m_tempGeometryObject = nullptr;       //superfluous?
     }
+    m_showingHlrPreview = false;
     if (!geometryObject) {
         throw Base::RuntimeError("DrawViewPart has lost its geometry object");
     }
@@ -400,6 +559,11 @@ void DrawViewPart::onHlrFinished()
         Base::Console().error("TechDraw did not retrieve any geometry for %s/%s\n",
                               getNameInDocument(), Label.getValue());
     }
+    else if (m_hlrPending) {
+        m_hlrPending->result = geometryObject->getHlrResult();
+        m_hlrCache = std::move(m_hlrPending);
+    }
+    m_hlrPending = nullptr;
 
     //the last hlr related task is to make a bbox of the results
     bbox = geometryObject->calcBoundingBox();
@@ -606,61 +770,49 @@ void DrawViewPart::findFacesOld(const std::vector<BaseGeomPtr> &goEdges)
     }
 
     //HLR algo does not provide all edge intersections for edge endpoints.
-    //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = nonZero.begin();
-    int iOuter = 0;
-    for (; itOuter != nonZero.end(); ++itOuter, iOuter++) {//*** itOuter != nonZero.end() - 1
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::AddOptimal(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            continue;                   //skip zero length edges. shouldn't happen ;)
+    //need to split long edges touched by Vertex of another edge. Only the edges whose boxes
+    //intersect are tested, and the edges are tested in parallel.
+    std::vector<std::vector<int>> nearby = DrawProjectSplit::nearbyEdges(nonZero, true);
+    std::vector<std::vector<splitPoint>> outerSplits(nonZero.size());
+    std::vector<int> outerIndices(nonZero.size());
+    std::iota(outerIndices.begin(), outerIndices.end(), 0);
+    QtConcurrent::blockingMap(outerIndices, [&](int iOuter) {
+        const TopoDS_Edge& outer = nonZero.at(iOuter);
+        if (DrawUtil::isZeroEdge(outer)) {
+            return;                   //skip zero length edges. shouldn't happen ;)
         }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = nonZero.begin();//***sb itOuter + 1;
-        for (; itInner != nonZero.end(); ++itInner, iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
+        TopoDS_Vertex v1 = TopExp::FirstVertex(outer);
+        TopoDS_Vertex v2 = TopExp::LastVertex(outer);
+        for (int iInner : nearby.at(iOuter)) {
+            const TopoDS_Edge& inner = nonZero.at(iInner);
+            if (DrawUtil::isZeroEdge(inner)) {
                 continue;//skip zero length edges. shouldn't happen ;)
             }
 
-            Bnd_Box sInner;
-            BRepBndLib::AddOptimal(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {//bboxes of edges don't intersect, don't bother
-                continue;
-            }
-
             double param = -1;
-            if (DrawProjectSplit::isOnEdge((*itInner), v1, param, false)) {
+            if (DrawProjectSplit::isOnEdge(inner, v1, param, false)) {
                 gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
                 splitPoint s1;
                 s1.i = iInner;
                 s1.v = Base::Vector3d(pnt1.X(), pnt1.Y(), pnt1.Z());
                 s1.param = param;
-                splits.push_back(s1);
+                outerSplits[iOuter].push_back(s1);
             }
-            if (DrawProjectSplit::isOnEdge((*itInner), v2, param, false)) {
+            if (DrawProjectSplit::isOnEdge(inner, v2, param, false)) {
                 gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
                 splitPoint s2;
                 s2.i = iInner;
                 s2.v = Base::Vector3d(pnt2.X(), pnt2.Y(), pnt2.Z());
                 s2.param = param;
-                splits.push_back(s2);
+                outerSplits[iOuter].push_back(s2);
             }
         }//inner loop
-    }    //outer loop
+    });    //outer loop
+
+    std::vector<splitPoint> splits;
+    for (auto& edgeSplits : outerSplits) {
+        splits.insert(splits.end(), edgeSplits.begin(), edgeSplits.end());
+    }
 
     std::vector<splitPoint> sorted = DrawProjectSplit::sortSplits(splits, true);
     auto last = std::unique(sorted.begin(), sorted.end(),
@@ -25,6 +25,8 @@
 #ifndef DrawViewPart_h_
 #define DrawViewPart_h_
 
+#include <memory>
+
 #include <QFuture>
 #include <QFutureWatcher>
 
@@ -45,6 +47,7 @@ class gp_Pnt;
 class gp_Pln;
 class gp_Ax2;
 class TopoDS_Shape;
+class QThreadPool;
 
 namespace App
 {
@@ -236,6 +239,10 @@ public:
     void waitingForFaces(bool s) { m_waitingForFaces = s; }
     bool waitingForHlr() const { return m_waitingForHlr; }
     void waitingForHlr(bool s) { m_waitingForHlr = s; }
+    //! the inputs changed while hlr was running, so it is run again once it has finished
+    void hlrOutdated(bool s) { m_hlrOutdated = s; }
+    //! the geometry is the polygon hlr preview of the exact hlr which is still running
+    bool showingHlrPreview() const { return m_showingHlrPreview; }
     virtual bool waitingForResult() const;
     void progressValueChanged(int v);
 
@@ -259,10 +266,13 @@ protected:
 
     void onChanged(const App::Property* prop) override;
     void unsetupObject() override;
+    void updateCosmeticGeometry(const App::Property* prop);
 
     virtual TechDraw::GeometryObjectPtr buildGeometryObject(TopoDS_Shape& shape,
                                                             const gp_Ax2& viewAxis);
     virtual TechDraw::GeometryObjectPtr makeGeometryForShape(TopoDS_Shape& shape);//const??
+    static QThreadPool* hlrThreadPool();
+    void showHlrPreview(const TopoDS_Shape& shape, const gp_Ax2& viewAxis);
     void partExec(TopoDS_Shape& shape);
     virtual void addPoints(void);
 
@@ -280,9 +290,17 @@ protected:
     std::vector<TechDraw::VertexPtr> m_referenceVerts;
 
 private:
+    struct HlrCache;
+    std::unique_ptr<HlrCache> makeHlrCache(const TopoDS_Shape& shape) const;
+
     bool nowUnsetting;
     bool m_waitingForFaces;
     bool m_waitingForHlr;
+    bool m_hlrOutdated;
+    bool m_showingHlrPreview;
+
+    std::unique_ptr<HlrCache> m_hlrCache;   //result of the last hlr run and its inputs
+    std::unique_ptr<HlrCache> m_hlrPending; //inputs of the hlr run in progress
 
     QMetaObject::Connection connectHlrWatcher;
     QFutureWatcher<void> m_hlrWatcher;
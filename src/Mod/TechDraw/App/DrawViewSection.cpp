@@ -54,6 +54,7 @@
 #include <BRepTools.hxx>
 #include <BRep_Builder.hxx>
 #include <Bnd_Box.hxx>
+#include <QtConcurrentMap>
 #include <QtConcurrentRun>
 #include <ShapeAnalysis.hxx>
 #include <ShapeFix_Shape.hxx>
@@ -69,7 +70,9 @@
 #include <gp_Dir.hxx>
 #include <gp_Pln.hxx>
 #include <gp_Pnt.hxx>
+#include <exception>
 #include <limits>
+#include <numeric>
 #include <sstream>
 
 
@@ -498,10 +501,41 @@ void DrawViewSection::sectionExec(TopoDS_Shape& baseShape)
     }
 }
 
+//! the inputs of a section cut which is reused as long as they don't change. As for the hlr of a
+//! view, the source shape is compared by its geometry. The cutting tool stands for the section
+//! plane, or for the profile of a complex section.
+struct DrawViewSection::SectionCutCache
+{
+    std::vector<double> shapeSignature;
+    std::vector<double> toolSignature;
+    bool trimAfterCut;
+    TopoDS_Shape cutPieces;
+
+    bool matches(const SectionCutCache& other) const
+    {
+        return shapeSignature == other.shapeSignature && toolSignature == other.toolSignature
+            && trimAfterCut == other.trimAfterCut;
+    }
+};
+
 void DrawViewSection::makeSectionCut(const TopoDS_Shape& baseShape)
 {
     showProgressMessage(getNameInDocument(), "is making section cut");
 
+    auto cutInputs = std::make_unique<SectionCutCache>();
+    cutInputs->shapeSignature = ShapeUtils::shapeSignature(baseShape);
+    cutInputs->toolSignature = ShapeUtils::shapeSignature(m_cuttingTool);
+    cutInputs->trimAfterCut = trimAfterCut();
+    if (cutInputs->shapeSignature.empty() || cutInputs->toolSignature.empty()) {
+        cutInputs = nullptr;
+    }
+    else if (m_cutCache && m_cutCache->matches(*cutInputs)) {
+        m_saveShape = baseShape;
+        m_cutPieces = m_cutCache->cutPieces;
+        waitingForCut(false);
+        return;
+    }
+
     // We need to copy the shape to not modify the BRepstructure
     BRepBuilderAPI_Copy BuilderCopy(baseShape);
     TopoDS_Shape myShape = BuilderCopy.Shape();
@@ -516,19 +550,36 @@ void DrawViewSection::makeSectionCut(const TopoDS_Shape& baseShape)
     }
 
     // perform the cut. We cut each solid in myShape individually to avoid issues
-    // where a compound BaseShape does not cut correctly.
+    // where a compound BaseShape does not cut correctly. The boolean operations don't modify
+    // their arguments, so the solids are cut concurrently with the same tool.
+    std::vector<TopoDS_Shape> solids;
+    for (TopExp_Explorer expl(myShape, TopAbs_SOLID); expl.More(); expl.Next()) {
+        solids.push_back(expl.Current());
+    }
+    std::vector<TopoDS_Shape> solidCuts(solids.size());
+    std::vector<size_t> solidIndices(solids.size());
+    std::iota(solidIndices.begin(), solidIndices.end(), 0);
+    QtConcurrent::blockingMap(solidIndices, [&](size_t iSolid) {
+        try {
+            FCBRepAlgoAPI_Cut mkCut(solids[iSolid], m_cuttingTool);
+            if (mkCut.IsDone()) {
+                solidCuts[iSolid] = mkCut.Shape();
+            }
+        }
+        catch (const Standard_Failure&) {
+            // reported below like a cut that is not done
+        }
+    });
+
     BRep_Builder builder;
     TopoDS_Compound cutPieces;
     builder.MakeCompound(cutPieces);
-    TopExp_Explorer expl(myShape, TopAbs_SOLID);
-    for (; expl.More(); expl.Next()) {
-        const TopoDS_Solid& s = TopoDS::Solid(expl.Current());
-        FCBRepAlgoAPI_Cut mkCut(s, m_cuttingTool);
-        if (!mkCut.IsDone()) {
+    for (auto& solidCut : solidCuts) {
+        if (solidCut.IsNull()) {
             Base::Console().warning("DVS: Section cut has failed in %s\n", getNameInDocument());
             continue;
         }
-        builder.Add(cutPieces, mkCut.Shape());
+        builder.Add(cutPieces, solidCut);
     }
 
     // cutPieces contains result of cutting each subshape in baseShape with tool
@@ -560,6 +611,10 @@ void DrawViewSection::makeSectionCut(const TopoDS_Shape& baseShape)
         return;
     }
 
+    if (cutInputs) {
+        cutInputs->cutPieces = m_cutPieces;
+        m_cutCache = std::move(cutInputs);
+    }
     waitingForCut(false);
 }
 
@@ -1176,6 +1231,25 @@ std::vector<LineSet> DrawViewSection::getDrawableLines(int i)
                                                  HatchOffset.getValue());
 }
 
+//! the drawable lines of all the section faces, in the order of the faces. The hatch lines of the
+//! faces are trimmed concurrently
+std::vector<std::vector<LineSet>> DrawViewSection::getAllDrawableLines()
+{
+    if (m_lineSets.empty()) {
+        makeLineSets();
+    }
+    std::vector<TopoDS_Face> faces;
+    for (TopExp_Explorer expl(m_sectionTopoDSFaces, TopAbs_FACE); expl.More(); expl.Next()) {
+        faces.push_back(TopoDS::Face(expl.Current()));
+    }
+    return DrawGeomHatch::getTrimmedLinesSection(this,
+                                                 m_lineSets,
+                                                 faces,
+                                                 HatchScale.getValue(),
+                                                 HatchRotation.getValue(),
+                                                 HatchOffset.getValue());
+}
+
 TopoDS_Face DrawViewSection::getSectionTopoDSFace(int i)
 {
     TopExp_Explorer expl(m_sectionTopoDSFaces, TopAbs_FACE);
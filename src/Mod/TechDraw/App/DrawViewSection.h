@@ -158,6 +158,7 @@ public:
 
     void makeLineSets();
     std::vector<LineSet> getDrawableLines(int i = 0);
+    std::vector<std::vector<LineSet>> getAllDrawableLines();
     std::vector<PATLineSpec> getDecodedSpecsFromFile(std::string fileSpec, std::string myPattern);
 
     TopoDS_Shape getCutShape() const { return m_cutShape; }
@@ -216,6 +217,9 @@ protected:
 
     static App::PropertyFloatConstraint::Constraints stretchRange;
 
+private:
+    struct SectionCutCache;
+    std::unique_ptr<SectionCutCache> m_cutCache;   //result of the last section cut and its inputs
 };
 
 using DrawViewSectionPython = App::FeaturePythonT<DrawViewSection>;
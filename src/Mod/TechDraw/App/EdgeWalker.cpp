@@ -27,8 +27,11 @@
 
 
 # include <cmath>
+# include <cstdint>
 # include <limits>
+# include <set>
 # include <sstream>
+# include <unordered_map>
 # include <BRep_Tool.hxx>
 # include <BRepBuilderAPI_MakeWire.hxx>
 # include <ShapeAnalysis.hxx>
@@ -48,6 +51,82 @@
 using namespace TechDraw;
 using namespace boost;
 
+namespace {
+
+//! finds the first of a list of points which is within EWTOLERANCE of a given point. The points are
+//! hashed into a grid of cells as big as the tolerance, so only the neighbouring cells are searched.
+class PointGrid
+{
+public:
+    void add(const Base::Vector3d& point)
+    {
+        m_cells[cellOf(point)].push_back(m_points.size());
+        m_points.push_back(point);
+    }
+
+    std::size_t find(const Base::Vector3d& point) const
+    {
+        std::size_t result = std::numeric_limits<std::size_t>::max();
+        Cell cell = cellOf(point);
+        for (std::int64_t dx = -1; dx <= 1; dx++) {
+            for (std::int64_t dy = -1; dy <= 1; dy++) {
+                for (std::int64_t dz = -1; dz <= 1; dz++) {
+                    auto it = m_cells.find({cell.x + dx, cell.y + dy, cell.z + dz});
+                    if (it == m_cells.end()) {
+                        continue;
+                    }
+                    for (std::size_t idx : it->second) {
+                        if (idx < result && m_points[idx].IsEqual(point, EWTOLERANCE)) {
+                            result = idx;
+                        }
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+private:
+    struct Cell
+    {
+        std::int64_t x, y, z;
+        bool operator==(const Cell& other) const
+        {
+            return x == other.x && y == other.y && z == other.z;
+        }
+    };
+    struct CellHash
+    {
+        std::size_t operator()(const Cell& cell) const
+        {
+            std::size_t hash = std::hash<std::int64_t>()(cell.x);
+            hash = hash * 31 + std::hash<std::int64_t>()(cell.y);
+            return hash * 31 + std::hash<std::int64_t>()(cell.z);
+        }
+    };
+
+    static Cell cellOf(const Base::Vector3d& point)
+    {
+        return {static_cast<std::int64_t>(std::floor(point.x / EWTOLERANCE)),
+                static_cast<std::int64_t>(std::floor(point.y / EWTOLERANCE)),
+                static_cast<std::int64_t>(std::floor(point.z / EWTOLERANCE))};
+    }
+
+    std::unordered_map<Cell, std::vector<std::size_t>, CellHash> m_cells;
+    std::vector<Base::Vector3d> m_points;
+};
+
+PointGrid makeGrid(const std::vector<TopoDS_Vertex>& verts)
+{
+    PointGrid grid;
+    for (const auto& v : verts) {
+        grid.add(DrawUtil::vertex2Vector(v));
+    }
+    return grid;
+}
+
+}  // namespace
+
 //*******************************************************
 //* edgeVisior methods
 //*******************************************************
@@ -269,26 +348,21 @@ std::vector<TopoDS_Vertex> EdgeWalker:: makeUniqueVList(std::vector<TopoDS_Edge>
 {
 //    Base::Console().message("TRACE - EW::makeUniqueVList() - edgesIn: %d\n", edges.size());
     std::vector<TopoDS_Vertex> uniqueVert;
+    PointGrid grid;
+    constexpr std::size_t notFound = std::numeric_limits<std::size_t>::max();
     for(auto& e:edges) {
         Base::Vector3d v1 = DrawUtil::vertex2Vector(TopExp::FirstVertex(e));
         Base::Vector3d v2 = DrawUtil::vertex2Vector(TopExp::LastVertex(e));
-        bool addv1 = true;
-        bool addv2 = true;
         //check if we've already added this vertex
-        for (const auto& v: uniqueVert) {
-            Base::Vector3d v3d = DrawUtil::vertex2Vector(v);
-            if (v3d.IsEqual(v1, EWTOLERANCE)) {
-                addv1 = false;
-            }
-            if (v3d.IsEqual(v2, EWTOLERANCE)) {
-                addv2 = false;
-            }
-        }
+        bool addv1 = grid.find(v1) == notFound;
+        bool addv2 = grid.find(v2) == notFound;
         if (addv1) {
             uniqueVert.push_back(TopExp::FirstVertex(e));
+            grid.add(v1);
         }
         if (addv2) {
             uniqueVert.push_back(TopExp::LastVertex(e));
+            grid.add(v2);
         }
     }
 //    Base::Console().message("EW::makeUniqueVList - verts out: %d\n", uniqueVert.size());
@@ -302,14 +376,13 @@ std::vector<WalkerEdge> EdgeWalker::makeWalkerEdges(std::vector<TopoDS_Edge> edg
 //    Base::Console().message("TRACE - EW::makeWalkerEdges() - edges: %d  verts: %d\n", edges.size(), verts.size());
     m_saveInEdges = edges;
     std::vector<WalkerEdge> walkerEdges;
+    PointGrid grid = makeGrid(verts);
     for (const auto& e:edges) {
-        TopoDS_Vertex edgeVertex1 = TopExp::FirstVertex(e);
-        TopoDS_Vertex edgeVertex2 = TopExp::LastVertex(e);
-        std::size_t vertex1Index = findUniqueVert(edgeVertex1, verts);
+        std::size_t vertex1Index = grid.find(DrawUtil::vertex2Vector(TopExp::FirstVertex(e)));
         if (vertex1Index == std::numeric_limits<std::size_t>::max()) {
             continue;
         }
-        std::size_t vertex2Index = findUniqueVert(edgeVertex2, verts);
+        std::size_t vertex2Index = grid.find(DrawUtil::vertex2Vector(TopExp::LastVertex(e)));
         if (vertex2Index == std::numeric_limits<std::size_t>::max()) {
             continue;
         }
@@ -365,10 +438,22 @@ std::vector<TopoDS_Wire> EdgeWalker::sortStrip(std::vector<TopoDS_Wire> fw, bool
 std::vector<TopoDS_Wire> EdgeWalker::sortWiresBySize(std::vector<TopoDS_Wire>& w, bool ascend)
 {
     //Base::Console().message("TRACE - EW::sortWiresBySize()\n");
-    std::vector<TopoDS_Wire> wires = w;
-    std::sort(wires.begin(), wires.end(), EdgeWalker::wireCompare);
+    //the areas are computed once instead of in every comparison
+    std::vector<std::pair<double, std::size_t>> areas;
+    areas.reserve(w.size());
+    for (std::size_t i = 0; i < w.size(); i++) {
+        areas.emplace_back(ShapeAnalysis::ContourArea(w[i]), i);
+    }
+    std::sort(areas.begin(), areas.end(), [](const auto& a1, const auto& a2) {
+        return a1.first > a2.first;
+    });
     if (ascend) {
-        std::reverse(wires.begin(), wires.end());
+        std::reverse(areas.begin(), areas.end());
+    }
+    std::vector<TopoDS_Wire> wires;
+    wires.reserve(w.size());
+    for (const auto& area : areas) {
+        wires.push_back(w[area.second]);
     }
     return wires;
 }
@@ -386,36 +471,34 @@ std::vector<embedItem> EdgeWalker::makeEmbedding(const std::vector<TopoDS_Edge>
 {
 //    Base::Console().message("TRACE - EW::makeEmbedding(edges: %d, verts: %d)\n",
 //                            edges.size(), uniqueVList.size());
-    std::vector<embedItem> result;
-
-    std::size_t iVert = 0;
-    //make an embedItem for each vertex in uniqueVList
-    //for each vertex v
-    //  find all the edges that have v as first or last vertex
-    for (auto& v: uniqueVList) {
-        TopoDS_Vertex cv = v;               //v is const but we need non-const for vertexEqual
-        std::size_t iEdge = 0;
-        std::vector<incidenceItem> iiList;
-        for (auto& e: edges) {
-            double angle = 0;
-            TopoDS_Vertex edgeVertex1 = TopExp::FirstVertex(e);
-            TopoDS_Vertex edgeVertex2 = TopExp::LastVertex(e);
-            if (DrawUtil::vertexEqual(cv, edgeVertex1)) {
-                angle = DrawUtil::incidenceAngleAtVertex(e,v,EWTOLERANCE);
-                incidenceItem ii(iEdge, angle, m_saveWalkerEdges[iEdge].ed);
-                iiList.push_back(ii);
-            } else if (DrawUtil::vertexEqual(cv, edgeVertex2)) {
-                angle = DrawUtil::incidenceAngleAtVertex(e,v,EWTOLERANCE);
-                incidenceItem ii(iEdge, angle, m_saveWalkerEdges[iEdge].ed);
-                iiList.push_back(ii);
+    //each edge is added to the incidence lists of the unique vertices at its ends, so the
+    //embedding is made in one pass over the edges instead of one pass per vertex
+    std::vector<std::vector<incidenceItem>> iiLists(uniqueVList.size());
+    constexpr std::size_t notFound = std::numeric_limits<std::size_t>::max();
+    PointGrid grid = makeGrid(uniqueVList);
+    std::size_t iEdge = 0;
+    for (auto& e: edges) {
+        std::size_t iVert1 = grid.find(DrawUtil::vertex2Vector(TopExp::FirstVertex(e)));
+        std::size_t iVert2 = grid.find(DrawUtil::vertex2Vector(TopExp::LastVertex(e)));
+        if (iVert2 == iVert1) {
+            //a closed edge is listed once at its vertex
+            iVert2 = notFound;
+        }
+        for (std::size_t iVert : {iVert1, iVert2}) {
+            if (iVert == notFound) {
+                continue;
             }
-            iEdge++;
-       }
-       //sort incidenceList by angle
-       iiList = embedItem::sortIncidenceList(iiList,  false);
-       embedItem embed(iVert, iiList);
-       result.push_back(embed);
-       iVert++;
+            double angle = DrawUtil::incidenceAngleAtVertex(e, uniqueVList[iVert], EWTOLERANCE);
+            iiLists[iVert].emplace_back(iEdge, angle, m_saveWalkerEdges[iEdge].ed);
+        }
+        iEdge++;
+    }
+
+    std::vector<embedItem> result;
+    result.reserve(uniqueVList.size());
+    for (std::size_t iVert = 0; iVert < uniqueVList.size(); iVert++) {
+        //sort incidenceList by angle
+        result.emplace_back(iVert, embedItem::sortIncidenceList(iiLists[iVert], false));
     }
     return result;
 }
@@ -515,21 +598,17 @@ std::size_t ewWire::size(void)
 ewWireList ewWireList::removeDuplicateWires()
 {
     ewWireList result;
-    if (wires.empty()) {
-        return result;
-    }
-    result.push_back(*(wires.begin()));                //save the first ewWire
-    std::vector<ewWire>::iterator iWire = (wires.begin()) + 1;    //starting with second
-    for (; iWire != wires.end(); iWire++) {
-        bool addToResult = true;
-        for (auto& w:result.wires) {
-            if ((*iWire).isEqual(w))  {             //already in result?
-                addToResult = false;
-                break;
-            }
+    //a wire is identified by the sorted indices of its edges
+    std::set<std::vector<std::size_t>> found;
+    for (auto& wire : wires) {
+        std::vector<std::size_t> key;
+        key.reserve(wire.wedges.size());
+        for (auto& we : wire.wedges) {
+            key.push_back(we.idx);
         }
-        if (addToResult) {
-            result.push_back((*iWire));
+        std::sort(key.begin(), key.end());
+        if (found.insert(std::move(key)).second) {     //not in result yet?
+            result.push_back(wire);
         }
     }
     return result;
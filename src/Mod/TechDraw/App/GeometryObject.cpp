@@ -244,6 +244,36 @@ void GeometryObject::projectShape(const TopoDS_Shape& inShape, const gp_Ax2& vie
     makeTDGeometry();
 }
 
+void GeometryObject::setHlrResult(const HlrResult& result, double scale)
+{
+    clear();
+
+    auto scaled = [scale](const TopoDS_Shape& shape) {
+        if (shape.IsNull() || DrawUtil::fpCompare(scale, 1.0)) {
+            return shape;
+        }
+        return ShapeUtils::scaleShape(shape, scale);
+    };
+    visHard = scaled(result.visHard);
+    visOutline = scaled(result.visOutline);
+    visSmooth = scaled(result.visSmooth);
+    visSeam = scaled(result.visSeam);
+    visIso = scaled(result.visIso);
+    hidHard = scaled(result.hidHard);
+    hidOutline = scaled(result.hidOutline);
+    hidSmooth = scaled(result.hidSmooth);
+    hidSeam = scaled(result.hidSeam);
+    hidIso = scaled(result.hidIso);
+
+    makeTDGeometry();
+}
+
+HlrResult GeometryObject::getHlrResult() const
+{
+    return {visHard, visOutline, visSmooth, visSeam, visIso,
+            hidHard, hidOutline, hidSmooth, hidSeam, hidIso};
+}
+
 //convert the hlr output into TD Geometry
 void GeometryObject::makeTDGeometry()
 {
@@ -60,6 +60,21 @@ class Vector;
 class Face;
 class Vertex;
 
+//! the edge compounds produced by HLR, before they are converted to TD geometry
+struct HlrResult
+{
+    TopoDS_Shape visHard;
+    TopoDS_Shape visOutline;
+    TopoDS_Shape visSmooth;
+    TopoDS_Shape visSeam;
+    TopoDS_Shape visIso;
+    TopoDS_Shape hidHard;
+    TopoDS_Shape hidOutline;
+    TopoDS_Shape hidSmooth;
+    TopoDS_Shape hidSeam;
+    TopoDS_Shape hidIso;
+};
+
 class TechDrawExport GeometryObject
 {
 public:
@@ -82,6 +97,10 @@ public:
 
     void projectShape(const TopoDS_Shape& input, const gp_Ax2& viewAxis);
     void projectShapeWithPolygonAlgo(const TopoDS_Shape& input, const gp_Ax2& viewAxis);
+    //! use the result of an earlier projection instead of projecting a shape, scaled about the
+    //! origin of the projection by the given factor
+    void setHlrResult(const HlrResult& result, double scale = 1.0);
+    HlrResult getHlrResult() const;
     static TopoDS_Shape projectSimpleShape(const TopoDS_Shape& shape, const gp_Ax2& CS, bool invertYRequired = true);
     static TopoDS_Shape simpleProjection(const TopoDS_Shape& shape, const gp_Ax2& projCS);
     static TopoDS_Shape projectFace(const TopoDS_Shape& face, const gp_Ax2& CS);
@@ -438,6 +438,12 @@ int Preferences::scrubCount()
     return getPreferenceGroup("General")->GetInt("ScrubCount", 1);
 }
 
+//! show the result of the polygon HLR algo while the exact HLR is running
+bool Preferences::previewHlr()
+{
+    return getPreferenceGroup("General")->GetBool("PreviewHLR", false);
+}
+
 //! Returns the factor for the overlap of svg tiles when hatching faces
 double Preferences::svgHatchFactor()
 {
@@ -110,6 +110,7 @@ public:
 
     static bool autoCorrectDimRefs();
     static int scrubCount();
+    static bool previewHlr();
 
     static double svgHatchFactor();
     static bool SectionUsePreviousCut();
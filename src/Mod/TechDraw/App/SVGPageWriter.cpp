@@ -0,0 +1,351 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include <algorithm>
+#include <sstream>
+#include <tuple>
+
+#include <QDomDocument>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <QtConcurrentMap>
+#include <Standard_Failure.hxx>
+
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+
+#include "DrawPage.h"
+#include "DrawProjGroup.h"
+#include "DrawProjGroupItem.h"
+#include "DrawSVGTemplate.h"
+#include "DrawUtil.h"
+#include "DrawViewAnnotation.h"
+#include "DrawViewPart.h"
+#include "DrawViewSymbol.h"
+#include "Geometry.h"
+#include "GeometryObject.h"
+#include "SVGPageWriter.h"
+#include "TechDrawExport.h"
+
+using namespace TechDraw;
+
+namespace
+{
+
+//! a length from an SVG width or height attribute in mm. Lengths without a unit are pixels.
+double toMillimetres(const QString& length)
+{
+    static const QRegularExpression lengthExpression(
+        QStringLiteral("^\\s*([-+]?[0-9]*\\.?[0-9]+(?:[eE][-+]?[0-9]+)?)\\s*([a-z]*)"));
+    QRegularExpressionMatch match = lengthExpression.match(length);
+    if (!match.hasMatch()) {
+        return 0.0;
+    }
+    double value = match.captured(1).toDouble();
+    QString unit = match.captured(2);
+    if (unit == QStringLiteral("mm")) {
+        return value;
+    }
+    if (unit == QStringLiteral("cm")) {
+        return value * 10.0;
+    }
+    if (unit == QStringLiteral("in")) {
+        return value * 25.4;
+    }
+    if (unit == QStringLiteral("pt")) {
+        return value * 25.4 / 72.0;
+    }
+    return value * 25.4 / 96.0;
+}
+
+//! the root element of an SVG document sized to width x height user units, as text to embed
+std::string embeddableSvg(QDomDocument& document, double width, double height)
+{
+    QDomElement root = document.documentElement();
+    root.setAttribute(QStringLiteral("x"), 0);
+    root.setAttribute(QStringLiteral("y"), 0);
+    root.setAttribute(QStringLiteral("width"), width);
+    root.setAttribute(QStringLiteral("height"), height);
+    QString text;
+    QTextStream stream(&text);
+    root.save(stream, 0);
+    return text.toStdString();
+}
+
+}  // namespace
+
+SVGPageWriter::SVGPageWriter(DrawPage* page)
+    : m_width(page->getPageWidth())
+    , m_height(page->getPageHeight())
+{
+    auto* svgTemplate = freecad_cast<DrawSVGTemplate*>(page->Template.getValue());
+    if (svgTemplate) {
+        QDomDocument document;
+        if (document.setContent(svgTemplate->processTemplate())) {
+            m_template = embeddableSvg(document, m_width, m_height);
+        }
+    }
+
+    for (auto* obj : page->getAllViews()) {
+        auto* view = freecad_cast<DrawView*>(obj);
+        if (!view || !view->Visibility.getValue()) {
+            continue;
+        }
+        if (auto* part = freecad_cast<DrawViewPart*>(view)) {
+            addPartView(part);
+        }
+        else if (auto* symbol = freecad_cast<DrawViewSymbol*>(view)) {
+            addSymbolView(symbol);
+        }
+        else if (auto* annotation = freecad_cast<DrawViewAnnotation*>(view)) {
+            addTextView(annotation);
+        }
+    }
+}
+
+std::pair<double, double> SVGPageWriter::svgPosition(double x, double y) const
+{
+    return {x, m_height - y};
+}
+
+void SVGPageWriter::addPartView(DrawViewPart* view)
+{
+    GeometryObjectPtr geometry = view->getGeometryObject();
+    if (!geometry || !view->hasGeometry()) {
+        return;
+    }
+    double x = view->X.getValue();
+    double y = view->Y.getValue();
+    if (auto* item = freecad_cast<DrawProjGroupItem*>(view)) {
+        if (DrawProjGroup* group = item->getPGroup()) {
+            x += group->X.getValue();
+            y += group->Y.getValue();
+        }
+    }
+
+    // the same line groups as TechDraw.viewPartAsSvg
+    PartView partView;
+    partView.name = view->getNameInDocument();
+    std::tie(partView.x, partView.y) = svgPosition(x, y);
+
+    Layer visible {DrawUtil::getDefaultLineWeight("Thick"), false, {}};
+    visible.shapes.push_back(geometry->getVisHard());
+    visible.shapes.push_back(geometry->getVisOutline());
+    if (view->SmoothVisible.getValue()) {
+        visible.shapes.push_back(geometry->getVisSmooth());
+    }
+    if (view->SeamVisible.getValue()) {
+        visible.shapes.push_back(geometry->getVisSeam());
+    }
+    partView.layers.push_back(visible);
+
+    Layer hidden {DrawUtil::getDefaultLineWeight("Thin"), true, {}};
+    if (view->HardHidden.getValue()) {
+        hidden.shapes.push_back(geometry->getHidHard());
+        hidden.shapes.push_back(geometry->getHidOutline());
+    }
+    if (view->SmoothHidden.getValue()) {
+        hidden.shapes.push_back(geometry->getHidSmooth());
+    }
+    if (view->SeamHidden.getValue()) {
+        hidden.shapes.push_back(geometry->getHidSeam());
+    }
+    if (!hidden.shapes.empty()) {
+        partView.layers.push_back(hidden);
+    }
+
+    // cosmetic edges and center lines, which are in the geometry of the view but not in the
+    // shapes from the HLR
+    std::vector<TopoDS_Edge> cosmeticEdges;
+    for (auto& geom : view->getEdgeGeometry()) {
+        if (geom->getHlrVisible() && geom->getCosmetic()) {
+            cosmeticEdges.push_back(geom->getOCCEdge());
+        }
+    }
+    if (!cosmeticEdges.empty()) {
+        Layer cosmetic {DrawUtil::getDefaultLineWeight("Thin"), false, {}};
+        cosmetic.shapes.push_back(DrawUtil::vectorToCompound(cosmeticEdges));
+        partView.layers.push_back(cosmetic);
+    }
+
+    m_partViews.push_back(partView);
+}
+
+void SVGPageWriter::addSymbolView(DrawViewSymbol* view)
+{
+    std::string symbol = view->Symbol.getValue();
+    QDomDocument document;
+    if (symbol.empty() || !document.setContent(QString::fromStdString(symbol))) {
+        return;
+    }
+
+    SymbolView symbolView;
+    symbolView.name = view->getNameInDocument();
+    std::tie(symbolView.x, symbolView.y) = svgPosition(view->X.getValue(), view->Y.getValue());
+    symbolView.rotation = view->Rotation.getValue();
+    symbolView.scale = view->getScale();
+    QDomElement root = document.documentElement();
+    symbolView.width = toMillimetres(root.attribute(QStringLiteral("width")));
+    symbolView.height = toMillimetres(root.attribute(QStringLiteral("height")));
+
+    // symbols used more than once are defined once
+    std::string definition = embeddableSvg(document, symbolView.width, symbolView.height);
+    auto found = std::ranges::find(m_symbolDefinitions, definition);
+    symbolView.definition = found - m_symbolDefinitions.begin();
+    if (found == m_symbolDefinitions.end()) {
+        m_symbolDefinitions.push_back(definition);
+    }
+    m_symbolViews.push_back(symbolView);
+}
+
+void SVGPageWriter::addTextView(DrawViewAnnotation* view)
+{
+    TextView textView;
+    textView.name = view->getNameInDocument();
+    std::tie(textView.x, textView.y) = svgPosition(view->X.getValue(), view->Y.getValue());
+    textView.size = view->TextSize.getValue();
+    textView.lineSpacing = view->LineSpace.getValue() / 100.0;
+    textView.font = view->Font.getValue();
+    textView.color = view->TextColor.getValue().asHexString();
+    textView.lines = view->Text.getValues();
+    for (auto& line : textView.lines) {
+        DrawUtil::encodeXmlSpecialChars(line);
+    }
+    DrawUtil::encodeXmlSpecialChars(textView.font);
+    m_textViews.push_back(textView);
+}
+
+std::string SVGPageWriter::svg() const
+{
+    std::stringstream out;
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n";
+    out << "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\" "
+        << "version=\"1.1\" width=\"" << m_width << "mm\" height=\"" << m_height << "mm\" "
+        << "viewBox=\"0 0 " << m_width << " " << m_height << "\">\n";
+
+    if (!m_symbolDefinitions.empty()) {
+        out << "<defs>\n";
+        for (std::size_t i = 0; i < m_symbolDefinitions.size(); i++) {
+            out << "<g id=\"symbol" << i << "\">\n" << m_symbolDefinitions[i] << "</g>\n";
+        }
+        out << "</defs>\n";
+    }
+
+    if (!m_template.empty()) {
+        out << "<g id=\"Template\">\n" << m_template << "</g>\n";
+    }
+
+    SVGOutput svgOut;
+    for (auto& view : m_partViews) {
+        out << "<g id=\"" << view.name << "\" transform=\"translate(" << view.x << " " << view.y
+            << ")\" fill=\"none\" stroke=\"#000000\" stroke-linecap=\"round\" "
+            << "stroke-linejoin=\"round\">\n";
+        for (auto& layer : view.layers) {
+            std::string data;
+            for (auto& shape : layer.shapes) {
+                if (!shape.IsNull()) {
+                    data += svgOut.exportPathData(shape);
+                }
+            }
+            if (data.empty()) {
+                continue;
+            }
+            out << "<path stroke-width=\"" << layer.width << "\"";
+            if (layer.dashed) {
+                // dashed line of ISO 128: dashes of 12 and gaps of 3 line widths
+                out << " stroke-dasharray=\"" << 12.0 * layer.width << " " << 3.0 * layer.width
+                    << "\"";
+            }
+            out << " d=\"" << data << "\" />\n";
+        }
+        out << "</g>\n";
+    }
+
+    for (auto& view : m_symbolViews) {
+        out << "<use id=\"" << view.name << "\" xlink:href=\"#symbol" << view.definition
+            << "\" transform=\"translate(" << view.x << " " << view.y << ") rotate("
+            << -view.rotation << ") scale(" << view.scale << ") translate("
+            << -view.width / 2.0 << " " << -view.height / 2.0 << ")\" />\n";
+    }
+
+    for (auto& view : m_textViews) {
+        double step = view.size * view.lineSpacing;
+        double top = view.y - step * (view.lines.size() - 1) / 2.0;
+        out << "<text id=\"" << view.name << "\" font-family=\"" << view.font
+            << "\" font-size=\"" << view.size << "\" fill=\"" << view.color
+            << "\" text-anchor=\"middle\" dominant-baseline=\"middle\">\n";
+        for (std::size_t i = 0; i < view.lines.size(); i++) {
+            out << "<tspan x=\"" << view.x << "\" y=\"" << top + step * i << "\">"
+                << view.lines[i] << "</tspan>\n";
+        }
+        out << "</text>\n";
+    }
+
+    out << "</svg>\n";
+    return out.str();
+}
+
+void SVGPageWriter::write(const std::string& fileName) const
+{
+    std::string text = svg();
+    Base::FileInfo fi(fileName);
+    Base::ofstream outfile(fi);
+    outfile.write(text.c_str(), text.size());
+    outfile.close();
+    if (!outfile.good()) {
+        throw Base::FileException("Cannot write", fi);
+    }
+}
+
+void SVGPageWriter::writePages(const std::vector<std::pair<DrawPage*, std::string>>& pages)
+{
+    // reading the document has to be done here, the geometry can be written in parallel
+    std::vector<std::pair<SVGPageWriter, std::string>> writers;
+    writers.reserve(pages.size());
+    for (auto& page : pages) {
+        writers.emplace_back(SVGPageWriter(page.first), page.second);
+    }
+
+    std::vector<std::string> errors(writers.size());
+    std::vector<std::size_t> indices(writers.size());
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        indices[i] = i;
+    }
+    QtConcurrent::blockingMap(indices, [&writers, &errors](std::size_t i) {
+        try {
+            writers[i].first.write(writers[i].second);
+        }
+        catch (const Base::Exception& e) {
+            errors[i] = e.what();
+        }
+        catch (Standard_Failure& e) {
+            errors[i] = e.GetMessageString();
+        }
+    });
+
+    for (auto& error : errors) {
+        if (!error.empty()) {
+            throw Base::RuntimeError(error);
+        }
+    }
+}
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef TECHDRAW_SVGPAGEWRITER_H
+#define TECHDRAW_SVGPAGEWRITER_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <TopoDS_Shape.hxx>
+
+#include <Mod/TechDraw/TechDrawGlobal.h>
+
+
+namespace TechDraw
+{
+class DrawPage;
+class DrawViewAnnotation;
+class DrawViewPart;
+class DrawViewSymbol;
+
+//! Writes a page as SVG straight from the geometry of its views, without rendering the page
+//! scene, so pages can be exported in FreeCADCmd. The edges of a view are written as one path
+//! per line style, and symbols that appear more than once are defined once and reused.
+//! The page data is read when the writer is made, so svg() and write() can run in other threads.
+class TechDrawExport SVGPageWriter
+{
+public:
+    explicit SVGPageWriter(DrawPage* page);
+
+    std::string svg() const;
+    void write(const std::string& fileName) const;
+
+    //! write each page to its file, several pages at a time
+    static void writePages(const std::vector<std::pair<DrawPage*, std::string>>& pages);
+
+private:
+    struct Layer
+    {
+        double width;
+        bool dashed;
+        std::vector<TopoDS_Shape> shapes;
+    };
+    struct PartView
+    {
+        std::string name;
+        double x;
+        double y;
+        std::vector<Layer> layers;
+    };
+    struct SymbolView
+    {
+        std::string name;
+        double x;
+        double y;
+        double rotation;
+        double scale;
+        double width;
+        double height;
+        std::size_t definition;
+    };
+    struct TextView
+    {
+        std::string name;
+        double x;
+        double y;
+        double size;
+        double lineSpacing;
+        std::string font;
+        std::string color;
+        std::vector<std::string> lines;
+    };
+
+    void addPartView(DrawViewPart* view);
+    void addSymbolView(DrawViewSymbol* view);
+    void addTextView(DrawViewAnnotation* view);
+    //! the position of a view in the coordinates of the SVG, which run down from the top
+    std::pair<double, double> svgPosition(double x, double y) const;
+
+    double m_width;
+    double m_height;
+    std::string m_template;
+    std::vector<std::string> m_symbolDefinitions;
+    std::vector<PartView> m_partViews;
+    std::vector<SymbolView> m_symbolViews;
+    std::vector<TextView> m_textViews;
+};
+
+}  // namespace TechDraw
+
+#endif  // TECHDRAW_SVGPAGEWRITER_H
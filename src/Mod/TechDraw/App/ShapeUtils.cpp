@@ -25,6 +25,8 @@
 
 #include <limits>
 
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepAdaptor_Surface.hxx>
 #include <BRepAlgo_NormalProjection.hxx>
 #include <BRepBndLib.hxx>
 #include <BRepBuilderAPI_Copy.hxx>
@@ -409,6 +411,56 @@ bool  ShapeUtils::isShapeReallyNull(TopoDS_Shape shape)
     return shape.IsNull() || !TopoDS_Iterator(shape).More();
 }
 
+std::vector<double> ShapeUtils::shapeSignature(const TopoDS_Shape& shape)
+{
+    std::vector<double> signature;
+    auto addPoint = [&signature](const gp_Pnt& point) {
+        signature.push_back(point.X());
+        signature.push_back(point.Y());
+        signature.push_back(point.Z());
+    };
+
+    try {
+        for (TopExp_Explorer expl(shape, TopAbs_VERTEX); expl.More(); expl.Next()) {
+            addPoint(BRep_Tool::Pnt(TopoDS::Vertex(expl.Current())));
+        }
+        // the inner points of edges and faces catch changes of their geometry that keep the
+        // vertices in place
+        for (TopExp_Explorer expl(shape, TopAbs_EDGE); expl.More(); expl.Next()) {
+            const TopoDS_Edge& edge = TopoDS::Edge(expl.Current());
+            signature.push_back(static_cast<double>(edge.Orientation()));
+            if (BRep_Tool::Degenerated(edge)) {
+                continue;
+            }
+            BRepAdaptor_Curve curve(edge);
+            signature.push_back(static_cast<double>(curve.GetType()));
+            double first = curve.FirstParameter();
+            double last = curve.LastParameter();
+            addPoint(curve.Value(first + (last - first) / 3.0));
+            addPoint(curve.Value(first + (last - first) * 2.0 / 3.0));
+        }
+        for (TopExp_Explorer expl(shape, TopAbs_FACE); expl.More(); expl.Next()) {
+            const TopoDS_Face& face = TopoDS::Face(expl.Current());
+            signature.push_back(static_cast<double>(face.Orientation()));
+            BRepAdaptor_Surface surface(face);
+            signature.push_back(static_cast<double>(surface.GetType()));
+            double u0 = surface.FirstUParameter();
+            double u1 = surface.LastUParameter();
+            double v0 = surface.FirstVParameter();
+            double v1 = surface.LastVParameter();
+            for (double u : {0.25, 0.5, 0.75}) {
+                for (double v : {0.25, 0.5, 0.75}) {
+                    addPoint(surface.Value(u0 + u * (u1 - u0), v0 + v * (v1 - v0)));
+                }
+            }
+        }
+    }
+    catch (const Standard_Failure&) {
+        return {};
+    }
+    return signature;
+}
+
 bool ShapeUtils::edgesAreParallel(TopoDS_Edge edge0, TopoDS_Edge edge1)
 {
     std::pair<Base::Vector3d, Base::Vector3d> ends0 = getEdgeEnds(edge0);
@@ -111,6 +111,11 @@ public:
 
     static bool isShapeReallyNull(TopoDS_Shape shape);
 
+//! a list of numbers that changes with the geometry and topology of a shape. Two shapes with the
+//! same signature are taken to be equal, even if they don't share their underlying TShapes.
+//! Returns an empty list if the shape has no valid signature.
+    static std::vector<double> shapeSignature(const TopoDS_Shape& shape);
+
     static bool edgesAreParallel(TopoDS_Edge edge0, TopoDS_Edge edge1);
 
     static TopoDS_Shape fromQt(const TopoDS_Shape& inShape);
@@ -23,13 +23,17 @@
 //migrated to TechDraw workbench 2022-01-26 by Wandererfan
 
 
+# include <algorithm>
 # include <cmath>
+# include <map>
 # include <sstream>
+# include <vector>
 # include <Approx_Curve3d.hxx>
 # include <BRep_Tool.hxx>
 # include <BRepAdaptor_Curve.hxx>
 # include <BRepBuilderAPI_MakeEdge.hxx>
 # include <BRepLProp_CLProps.hxx>
+# include <GCPnts_QuasiUniformDeflection.hxx>
 # include <Geom_BezierCurve.hxx>
 # include <Geom_BSplineCurve.hxx>
 # include <GeomConvert_BSplineCurveKnotSplitting.hxx>
@@ -192,6 +196,187 @@ std::string SVGOutput::exportEdges(const TopoDS_Shape& input)
     return result.str();
 }
 
+std::string SVGOutput::exportPathData(const TopoDS_Shape& input)
+{
+    struct Item
+    {
+        TopoDS_Edge edge;
+        gp_Pnt start;
+        gp_Pnt end;
+        bool used;
+    };
+    std::vector<Item> items;
+    for (TopExp_Explorer edges(input, TopAbs_EDGE); edges.More(); edges.Next()) {
+        const TopoDS_Edge& edge = TopoDS::Edge(edges.Current());
+        BRepAdaptor_Curve adapt(edge);
+        items.push_back({edge, adapt.Value(adapt.FirstParameter()),
+                         adapt.Value(adapt.LastParameter()), false});
+    }
+
+    // the edges by the points where they start or end, to find the next edge of a subpath
+    const double grid = 1.0e-4;
+    auto keyOf = [grid](const gp_Pnt& p) {
+        return std::make_pair(std::llround(p.X() / grid), std::llround(p.Y() / grid));
+    };
+    std::map<std::pair<long long, long long>, std::vector<std::size_t>> ends;
+    for (std::size_t i = 0; i < items.size(); i++) {
+        ends[keyOf(items[i].start)].push_back(i);
+        ends[keyOf(items[i].end)].push_back(i);
+    }
+
+    std::stringstream result;
+    for (std::size_t first = 0; first < items.size(); first++) {
+        if (items[first].used) {
+            continue;
+        }
+        result << "M" << items[first].start.X() << " " << items[first].start.Y();
+        std::size_t current = first;
+        bool reversed = false;
+        while (true) {
+            Item& item = items[current];
+            item.used = true;
+            printSegment(BRepAdaptor_Curve(item.edge), reversed, result);
+            gp_Pnt end = reversed ? item.start : item.end;
+
+            // continue with an unused edge that starts or ends where this one ends
+            bool found = false;
+            for (std::size_t next : ends[keyOf(end)]) {
+                if (items[next].used) {
+                    continue;
+                }
+                if (items[next].start.SquareDistance(end) < grid * grid) {
+                    current = next;
+                    reversed = false;
+                    found = true;
+                    break;
+                }
+                if (items[next].end.SquareDistance(end) < grid * grid) {
+                    current = next;
+                    reversed = true;
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                break;
+            }
+        }
+    }
+
+    return result.str();
+}
+
+// the commands for one edge, from the point the path is at. A reversed edge is drawn from its
+// end to its start.
+void SVGOutput::printSegment(const BRepAdaptor_Curve& c, bool reversed, std::ostream& out)
+{
+    double f = c.FirstParameter();
+    double l = c.LastParameter();
+    gp_Pnt s = c.Value(f);
+    gp_Pnt m = c.Value((l + f) / 2.0);
+    gp_Pnt e = c.Value(l);
+    if (reversed) {
+        std::swap(s, e);
+    }
+
+    if (c.GetType() == GeomAbs_Line) {
+        out << " L" << e.X() << " " << e.Y();
+        return;
+    }
+
+    if (c.GetType() == GeomAbs_Circle || c.GetType() == GeomAbs_Ellipse) {
+        double r1 = 0.0;
+        double r2 = 0.0;
+        double angle = 0.0;
+        bool ccw = true;
+        if (c.GetType() == GeomAbs_Circle) {
+            gp_Circ circ = c.Circle();
+            r1 = r2 = circ.Radius();
+            ccw = circ.Axis().Direction().Z() > 0.0;
+        }
+        else {
+            gp_Elips ellp = c.Ellipse();
+            r1 = ellp.MajorRadius();
+            r2 = ellp.MinorRadius();
+            gp_Dir xaxis = ellp.XAxis().Direction();
+            angle = Base::toDegrees<double>(std::atan2(xaxis.Y(), xaxis.X()));
+            ccw = ellp.Axis().Direction().Z() > 0.0;
+        }
+        // a very flat ellipse degenerates to a line and is drawn as a polyline below
+        if (std::min(r1, r2) / std::max(r1, r2) >= 0.001) {
+            // two arcs through the middle, so neither is large and full circles work too
+            char swp = (ccw != reversed) ? '1' : '0';
+            out << " A" << r1 << " " << r2 << " " << angle << " 0 " << swp << " "
+                << m.X() << " " << m.Y();
+            out << " A" << r1 << " " << r2 << " " << angle << " 0 " << swp << " "
+                << e.X() << " " << e.Y();
+            return;
+        }
+    }
+    else {
+        try {
+            // approximate the curve with Bezier arcs
+            Handle(BRepAdaptor_HCurve) hCurve = new BRepAdaptor_HCurve(c);
+            Approx_Curve3d approx(hCurve, 0.001, GeomAbs_C0, 100, 3);
+            if (approx.IsDone() && approx.HasResult()) {
+                GeomConvert_BSplineCurveToBezierCurve crt(approx.Curve());
+                std::vector<std::vector<gp_Pnt>> arcs;
+                for (Standard_Integer i = 1; i <= crt.NbArcs(); i++) {
+                    Handle(Geom_BezierCurve) bezier = crt.Arc(i);
+                    if (bezier->Degree() > 3 || bezier->IsRational()) {
+                        Standard_Failure::Raise("do it the generic way");
+                    }
+                    std::vector<gp_Pnt> poles;
+                    for (Standard_Integer j = 1; j <= bezier->NbPoles(); j++) {
+                        poles.push_back(bezier->Pole(j));
+                    }
+                    arcs.push_back(poles);
+                }
+                if (reversed) {
+                    std::reverse(arcs.begin(), arcs.end());
+                    for (auto& poles : arcs) {
+                        std::reverse(poles.begin(), poles.end());
+                    }
+                }
+                for (auto& poles : arcs) {
+                    const char* command = " L";
+                    if (poles.size() == 4) {
+                        command = " C";
+                    }
+                    else if (poles.size() == 3) {
+                        command = " Q";
+                    }
+                    for (std::size_t j = 1; j < poles.size(); j++) {
+                        out << (j == 1 ? command : " ") << poles[j].X() << " " << poles[j].Y();
+                    }
+                }
+                return;
+            }
+        }
+        catch (Standard_Failure&) {
+            // fall through to the polyline
+        }
+    }
+
+    // a polyline through points of the curve
+    std::vector<gp_Pnt> points;
+    GCPnts_QuasiUniformDeflection discretizer(c, 0.01);
+    if (discretizer.IsDone() && discretizer.NbPoints() > 1) {
+        for (int i = 1; i <= discretizer.NbPoints(); i++) {
+            points.push_back(discretizer.Value(i));
+        }
+        if (reversed) {
+            std::reverse(points.begin(), points.end());
+        }
+    }
+    else {
+        points = {s, e};
+    }
+    for (std::size_t i = 1; i < points.size(); i++) {
+        out << " L" << points[i].X() << " " << points[i].Y();
+    }
+}
+
 void SVGOutput::printCircle(const BRepAdaptor_Curve& c, std::ostream& out)
 {
     gp_Circ circ = c.Circle();
@@ -51,8 +51,12 @@ class TechDrawExport SVGOutput : public TechDrawOutput
 public:
     SVGOutput();
     std::string exportEdges(const TopoDS_Shape&);
+    // The edges as the data of a single path element. Edges that meet end to end are
+    // joined into one subpath.
+    std::string exportPathData(const TopoDS_Shape&);
 
 private:
+    void printSegment(const BRepAdaptor_Curve&, bool reversed, std::ostream&);
     void printCircle(const BRepAdaptor_Curve&, std::ostream&);
     void printEllipse(const BRepAdaptor_Curve&, int id, std::ostream&);
     void printBSpline(const BRepAdaptor_Curve&, int id, std::ostream&);
@@ -2397,8 +2397,9 @@ namespace TechDrawGui {
         dim->References2D.setValues(objs, subs);
         Gui::Command::doCommand(Gui::Command::Doc, "App.activeDocument().%s.addView(App.activeDocument().%s)", PageName.c_str(), FeatName.c_str());
 
-        // Touch the parent feature so the dimension in tree view appears as a child
-        objFeat->touch();
+        // Touch the parent feature so the dimension in tree view appears as a child, but don't
+        // recompute it: the dimension doesn't change its geometry
+        objFeat->touch(true);
         dim->recomputeFeature();
         return dim;
     }
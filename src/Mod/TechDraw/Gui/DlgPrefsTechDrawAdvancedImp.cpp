@@ -57,10 +57,12 @@ void DlgPrefsTechDrawAdvancedImp::saveSettings()
     ui->pdsbMarkFuzz->onSave();
     ui->sbMaxTiles->onSave();
     ui->sbMaxPat->onSave();
+    ui->sbEdgeBatch->onSave();
     ui->cbReportProgress->onSave();
     ui->cbAutoCorrectRefs->onSave();
     ui->cbNewFaceFinder->onSave();
     ui->sbScrubCount->onSave();
+    ui->cbPreviewHlr->onSave();
 
     ui->cbDebugBadShape->onSave();
     ui->cbValidateShapes->onSave();
@@ -112,10 +114,12 @@ void DlgPrefsTechDrawAdvancedImp::loadSettings()
     ui->pdsbMarkFuzz->onRestore();
     ui->sbMaxTiles->onRestore();
     ui->sbMaxPat->onRestore();
+    ui->sbEdgeBatch->onRestore();
     ui->cbReportProgress->onRestore();
     ui->cbAutoCorrectRefs->onRestore();
     ui->cbNewFaceFinder->onRestore();
     ui->sbScrubCount->onRestore();
+    ui->cbPreviewHlr->onRestore();
 
     ui->cbDebugBadShape->onRestore();
     ui->cbValidateShapes->onRestore();
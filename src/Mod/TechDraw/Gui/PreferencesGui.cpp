@@ -172,6 +172,12 @@ double PreferencesGui::edgeFuzz()
     return Preferences::getPreferenceGroup("General")->GetFloat("EdgeFuzz", 10.0);
 }
 
+//! the number of edges from which the plain edges of a view are drawn in batches
+int PreferencesGui::edgeBatchThreshold()
+{
+    return Preferences::getPreferenceGroup("General")->GetInt("EdgeBatchThreshold", 20000);
+}
+
 QString PreferencesGui::weldingDirectory()
 {
     std::string defaultDir = App::Application::getResourceDir() + "Mod/TechDraw/Symbols/Welding/AWS/";
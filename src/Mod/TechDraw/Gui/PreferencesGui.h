@@ -76,6 +76,7 @@ static TechDraw::ArrowType dimArrowStyle();
 static double      dimArrowSize();
 
 static double      edgeFuzz();
+static int         edgeBatchThreshold();
 
 static QString     weldingDirectory();
 
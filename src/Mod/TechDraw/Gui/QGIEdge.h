@@ -60,14 +60,14 @@ public:
     void setSource(TechDraw::SourceType source) { m_source = source; }
     TechDraw::SourceType getSource() const { return m_source;}
 
+    static QColor getHiddenColor();
+
 protected:
 
     void mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event) override;
 
     bool multiselectEligible() override { return true; }
 
-    QColor getHiddenColor();
-
 private:
     int projIndex;                                                     //index of edge in Projection. must exist.
 
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include <QPainter>
+#include <QPainterPathStroker>
+#include <QStyleOptionGraphicsItem>
+
+#include "QGIEdgeBatch.h"
+
+using namespace TechDrawGui;
+
+namespace
+{
+// the average number of edges in a tile, and the largest number of tiles along a side
+constexpr double edgesPerTile = 32.0;
+constexpr int maxTiles = 256;
+}  // namespace
+
+QGIEdgeBatch::QGIEdgeBatch()
+{
+    setCacheMode(QGraphicsItem::NoCache);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+    setAcceptedMouseButtons(Qt::NoButton);
+    setAcceptHoverEvents(false);
+}
+
+void QGIEdgeBatch::addEdge(int projIndex, const QPainterPath& path)
+{
+    m_edges.push_back({projIndex, path, path.controlPointRect()});
+}
+
+void QGIEdgeBatch::buildTiles()
+{
+    prepareGeometryChange();
+    m_tiles.clear();
+    m_rect = QRectF();
+    for (auto& edge : m_edges) {
+        m_rect = m_rect.united(edge.rect);
+    }
+
+    int side = static_cast<int>(std::ceil(std::sqrt(m_edges.size() / edgesPerTile)));
+    m_columns = std::clamp(side, 1, maxTiles);
+    m_rows = m_columns;
+    m_tileWidth = std::max(m_rect.width() / m_columns, 1e-6);
+    m_tileHeight = std::max(m_rect.height() / m_rows, 1e-6);
+    m_tiles.resize(m_columns * m_rows);
+
+    for (std::size_t i = 0; i < m_edges.size(); i++) {
+        const Edge& edge = m_edges[i];
+        Tile& home = m_tiles[tileIndex(tileColumn(edge.rect.center().x()),
+                                       tileRow(edge.rect.center().y()))];
+        home.path.addPath(edge.path);
+        home.paintRect = home.paintRect.united(edge.rect);
+        for (int row = tileRow(edge.rect.top()); row <= tileRow(edge.rect.bottom()); row++) {
+            for (int column = tileColumn(edge.rect.left()); column <= tileColumn(edge.rect.right());
+                 column++) {
+                m_tiles[tileIndex(column, row)].edges.push_back(static_cast<int>(i));
+            }
+        }
+    }
+    update();
+}
+
+int QGIEdgeBatch::tileColumn(double x) const
+{
+    return std::clamp(static_cast<int>((x - m_rect.left()) / m_tileWidth), 0, m_columns - 1);
+}
+
+int QGIEdgeBatch::tileRow(double y) const
+{
+    return std::clamp(static_cast<int>((y - m_rect.top()) / m_tileHeight), 0, m_rows - 1);
+}
+
+int QGIEdgeBatch::edgeAt(const QPointF& pos, double fuzz) const
+{
+    if (m_tiles.empty()) {
+        return -1;
+    }
+    QRectF probe(pos.x() - fuzz / 2.0, pos.y() - fuzz / 2.0, fuzz, fuzz);
+    if (!probe.intersects(m_rect.adjusted(-fuzz, -fuzz, fuzz, fuzz))) {
+        return -1;
+    }
+
+    QPainterPathStroker stroker;
+    stroker.setWidth(fuzz);
+    for (int row = tileRow(probe.top()); row <= tileRow(probe.bottom()); row++) {
+        for (int column = tileColumn(probe.left()); column <= tileColumn(probe.right());
+             column++) {
+            for (int i : m_tiles[tileIndex(column, row)].edges) {
+                const Edge& edge = m_edges[i];
+                if (!probe.intersects(edge.rect.adjusted(-fuzz, -fuzz, fuzz, fuzz))) {
+                    continue;
+                }
+                if (stroker.createStroke(edge.path).contains(pos)) {
+                    return edge.projIndex;
+                }
+            }
+        }
+    }
+    return -1;
+}
+
+QRectF QGIEdgeBatch::boundingRect() const
+{
+    double margin = std::max(m_pen.widthF() / 2.0, 1.0);
+    return m_rect.adjusted(-margin, -margin, margin, margin);
+}
+
+void QGIEdgeBatch::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                         QWidget* widget)
+{
+    Q_UNUSED(widget)
+    painter->setPen(m_pen);
+    painter->setBrush(Qt::NoBrush);
+    // a tile of straight edges can be a line, which never intersects anything
+    double margin = std::max(m_pen.widthF() / 2.0, 1.0);
+    for (auto& tile : m_tiles) {
+        if (tile.path.isEmpty()) {
+            continue;
+        }
+        QRectF paintRect = tile.paintRect.adjusted(-margin, -margin, margin, margin);
+        if (!option->exposedRect.intersects(paintRect)) {
+            continue;
+        }
+        painter->drawPath(tile.path);
+    }
+}
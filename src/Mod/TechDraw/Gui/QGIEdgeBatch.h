@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef TECHDRAWGUI_QGIEDGEBATCH_H
+#define TECHDRAWGUI_QGIEDGEBATCH_H
+
+#include <Mod/TechDraw/TechDrawGlobal.h>
+
+#include <vector>
+
+#include <QGraphicsItem>
+#include <QPainterPath>
+#include <QPen>
+
+#include "QGIUserTypes.h"
+
+namespace TechDrawGui
+{
+
+//! Draws many edges of a view that share one pen, in place of one QGIEdge per edge. The edges
+//! are kept in a grid of tiles, so only the tiles in the exposed area are painted, and the grid
+//! resolves a scene position to the edge under it. The batch does not take mouse events itself;
+//! the view turns the edge under the mouse into a QGIEdge when it needs one for selection.
+class TechDrawGuiExport QGIEdgeBatch : public QGraphicsItem
+{
+public:
+    QGIEdgeBatch();
+    ~QGIEdgeBatch() override = default;
+
+    enum {Type = UserType::QGIEdgeBatch};
+    int type() const override { return Type;}
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+               QWidget* widget = nullptr) override;
+
+    void setLinePen(const QPen& pen) { m_pen = pen; }
+    QPen getLinePen() const { return m_pen; }
+
+    void addEdge(int projIndex, const QPainterPath& path);
+    //! sorts the edges into tiles. Call after all the edges are added.
+    void buildTiles();
+    //! the projection index of the edge within fuzz of pos (in item coordinates), or -1
+    int edgeAt(const QPointF& pos, double fuzz) const;
+    int edgeCount() const { return static_cast<int>(m_edges.size()); }
+
+private:
+    struct Edge
+    {
+        int projIndex;
+        QPainterPath path;
+        QRectF rect;
+    };
+    struct Tile
+    {
+        QPainterPath path;          // the edges whose centre is in the tile
+        QRectF paintRect;           // the extent of those edges
+        std::vector<int> edges;     // the edges that cross the tile, for hit testing
+    };
+
+    int tileIndex(int column, int row) const { return row * m_columns + column; }
+    int tileColumn(double x) const;
+    int tileRow(double y) const;
+
+    QPen m_pen;
+    std::vector<Edge> m_edges;
+    std::vector<Tile> m_tiles;
+    QRectF m_rect;
+    int m_columns{0};
+    int m_rows{0};
+    double m_tileWidth{1.0};
+    double m_tileHeight{1.0};
+};
+
+}  // namespace TechDrawGui
+
+#endif  // TECHDRAWGUI_QGIEDGEBATCH_H
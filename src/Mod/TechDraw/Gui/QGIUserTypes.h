@@ -84,7 +84,8 @@ enum : int {
     QGMarker,
     QGMText,
     QGTracker,
-    TemplateTextField
+    TemplateTextField,
+    QGIEdgeBatch
 };
 };
 }
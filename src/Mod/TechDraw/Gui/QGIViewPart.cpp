@@ -21,6 +21,7 @@
  ***************************************************************************/
 
 #include <QPainterPath>
+#include <QGraphicsSceneHoverEvent>
 #include <QKeyEvent>
 #include <cstdio>
 #include <qmath.h>
@@ -50,6 +51,7 @@
 #include "QGICMark.h"
 #include "QGICenterLine.h"
 #include "QGIEdge.h"
+#include "QGIEdgeBatch.h"
 #include "QGIFace.h"
 #include "QGIHighlight.h"
 #include "QGIMatting.h"
@@ -120,6 +122,11 @@ QVariant QGIViewPart::itemChange(GraphicsItemChange change, const QVariant& valu
 
 bool QGIViewPart::sceneEventFilter(QGraphicsItem *watched, QEvent *event)
 {
+    if (event->type() == QEvent::GraphicsSceneHoverMove && !m_edgeBatches.empty()) {
+        // a batched edge is made into a QGIEdge when the mouse reaches it
+        auto* hoverEvent = static_cast<QGraphicsSceneHoverEvent*>(event);
+        promoteEdgeAt(mapFromScene(hoverEvent->scenePos()));
+    }
     if (event->type() == QEvent::ShortcutOverride) {
         // if we accept this event, we should get a regular keystroke event next
         // which will be processed by QGVPage/QGVNavStyle keypress logic, but not forwarded to
@@ -276,6 +283,22 @@ void QGIViewPart::drawAllFaces(void)
     std::vector<TechDraw::DrawHatch*> regularHatches = dvp->getHatches();
     std::vector<TechDraw::DrawGeomHatch*> geomHatches = dvp->getGeomHatches();
     const std::vector<TechDraw::FacePtr>& faceGeoms = dvp->getFaceGeometry();
+
+    // the hatch lines of all the faces of a geometric hatch are trimmed at once, concurrently
+    std::map<int, std::vector<LineSet>> geomHatchLines;
+    for (auto& geomHatch : geomHatches) {
+        std::vector<int> hatchedFaces;
+        for (int iHatched = 0; iHatched < static_cast<int>(faceGeoms.size()); iHatched++) {
+            if (faceIsGeomHatched(iHatched, geomHatches) == geomHatch) {
+                hatchedFaces.push_back(iHatched);
+            }
+        }
+        std::vector<std::vector<LineSet>> faceLines = geomHatch->getTrimmedLines(hatchedFaces);
+        for (size_t i = 0; i < hatchedFaces.size(); i++) {
+            geomHatchLines[hatchedFaces[i]] = std::move(faceLines[i]);
+        }
+    }
+
     int iFace(0);
     for (auto& face : faceGeoms) {
         QGIFace* newFace = drawFace(face, iFace);
@@ -290,12 +313,9 @@ void QGIViewPart::drawAllFaces(void)
             // geometric hatch (from PAT hatch specification)
             newFace->isHatched(true);
             newFace->setFillMode(FillMode::GeomHatchFill);
-            std::vector<LineSet> lineSets = fGeom->getTrimmedLines(iFace);
-            if (!lineSets.empty()) {
-                // this face has geometric hatch lines
-                for (auto& ls : lineSets) {
-                    newFace->addLineSet(ls);
-                }
+            // this face has geometric hatch lines
+            for (auto& ls : geomHatchLines[iFace]) {
+                newFace->addLineSet(ls);
             }
             double hatchScale = fGeom->ScalePattern.getValue();
             if (hatchScale > 0.0) {
@@ -347,90 +367,221 @@ void QGIViewPart::drawAllFaces(void)
 
 void QGIViewPart::drawAllEdges()
 {
-    // dvp and vp already validated
+    // dvp already validated
     auto dvp(static_cast<TechDraw::DrawViewPart*>(getViewObject()));
-    auto vp = static_cast<ViewProviderViewPart*>(getViewProvider(getViewObject()));
 
     const TechDraw::BaseGeomPtrVector& geoms = dvp->getEdgeGeometry();
+    int batchThreshold = PreferencesGui::edgeBatchThreshold();
+    bool batching = batchThreshold > 0 && static_cast<int>(geoms.size()) >= batchThreshold;
     TechDraw::BaseGeomPtrVector::const_iterator itGeom = geoms.begin();
-    QGIEdge* item;
     for (int iEdge = 0; itGeom != geoms.end(); itGeom++, iEdge++) {
-        bool showItem = true;
         if (!showThisEdge(*itGeom)) {
             continue;
         }
+        if (batching && !(*itGeom)->getCosmetic() && !dvp->getGeomFormatBySelection(iEdge)) {
+            // plain edges of dense views are drawn in batches
+            getEdgeBatch(*itGeom)->addEdge(iEdge, drawPainterPath(*itGeom));
+            m_batchedEdges.insert(iEdge);
+            continue;
+        }
+        drawEdge(*itGeom, iEdge);
 
-        item = new QGIEdge(iEdge);
-        addToGroup(item);      //item is created at scene(0, 0), not group(0, 0)
-        item->setPath(drawPainterPath(*itGeom));
-        item->setSource((*itGeom)->source());
-
-        item->setNormalColor(PreferencesGui::getAccessibleQColor(PreferencesGui::normalQColor()));
-        if ((*itGeom)->getCosmetic()) {
-            // cosmetic edge - format appropriately
-            TechDraw::SourceType source = (*itGeom)->source();
-            if (source == TechDraw::SourceType::COSMETICEDGE) {
-                std::string cTag = (*itGeom)->getCosmeticTag();
-                showItem = formatGeomFromCosmetic(cTag, item);
-            }
-            else if (source == TechDraw::SourceType::CENTERLINE) {
-                std::string cTag = (*itGeom)->getCosmeticTag();
-                showItem = formatGeomFromCenterLine(cTag, item);
-            }
-            else {
-                Base::Console().message("QGIVP::drawVP - cosmetic edge: %d is confused - source: %d\n",
-                                        iEdge, static_cast<int>(source));
-            }
+        //debug a path
+        //            QPainterPath edgePath=drawPainterPath(*itGeom);
+        //            std::stringstream edgeId;
+        //            edgeId << "QGIVP.edgePath" << i;
+        //            dumpPath(edgeId.str().c_str(), edgePath);
+    }
+
+    if (m_edgeBatches.empty()) {
+        return;
+    }
+    for (auto& batch : m_edgeBatches) {
+        batch.second->buildTiles();
+    }
+    // the faces cover the view, so we watch their hover events to find the batched edge under
+    // the mouse
+    for (auto& child : childItems()) {
+        if (child->type() == UserType::QGIFace) {
+            child->installSceneEventFilter(this);
+        }
+    }
+}
+
+//! make the graphics item for one edge
+QGIEdge* QGIViewPart::drawEdge(const TechDraw::BaseGeomPtr& geom, int iEdge)
+{
+    // dvp and vp already validated
+    auto dvp(static_cast<TechDraw::DrawViewPart*>(getViewObject()));
+    auto vp = static_cast<ViewProviderViewPart*>(getViewProvider(getViewObject()));
+
+    bool showItem = true;
+    auto item = new QGIEdge(iEdge);
+    addToGroup(item);      //item is created at scene(0, 0), not group(0, 0)
+    item->setPath(drawPainterPath(geom));
+    item->setSource(geom->source());
+
+    item->setNormalColor(PreferencesGui::getAccessibleQColor(PreferencesGui::normalQColor()));
+    if (geom->getCosmetic()) {
+        // cosmetic edge - format appropriately
+        TechDraw::SourceType source = geom->source();
+        if (source == TechDraw::SourceType::COSMETICEDGE) {
+            std::string cTag = geom->getCosmeticTag();
+            showItem = formatGeomFromCosmetic(cTag, item);
+        }
+        else if (source == TechDraw::SourceType::CENTERLINE) {
+            std::string cTag = geom->getCosmeticTag();
+            showItem = formatGeomFromCenterLine(cTag, item);
+        }
+        else {
+            Base::Console().message("QGIVP::drawVP - cosmetic edge: %d is confused - source: %d\n",
+                                    iEdge, static_cast<int>(source));
+        }
+    } else {
+        // geometry edge - apply format if applicable
+        TechDraw::GeomFormat* gf = dvp->getGeomFormatBySelection(iEdge);
+        if (gf) {
+            Base::Color  color = Preferences::getAccessibleColor(gf->m_format.getColor());
+            item->setNormalColor(color.asValue<QColor>());
+            int lineNumber = gf->m_format.getLineNumber();
+            int qtStyle = gf->m_format.getStyle();
+            item->setLinePen(m_dashedLineGenerator->getBestPen(lineNumber, (Qt::PenStyle)qtStyle,
+                                                 gf->m_format.getWidth()));
+            // but we need to actually draw the lines in QGScene coords (0.1 mm).
+            item->setWidth(Rez::guiX(gf->m_format.getWidth()));
+            showItem = gf->m_format.getVisible();
         } else {
-            // geometry edge - apply format if applicable
-            TechDraw::GeomFormat* gf = dvp->getGeomFormatBySelection(iEdge);
-            if (gf) {
-                Base::Color  color = Preferences::getAccessibleColor(gf->m_format.getColor());
-                item->setNormalColor(color.asValue<QColor>());
-                int lineNumber = gf->m_format.getLineNumber();
-                int qtStyle = gf->m_format.getStyle();
-                item->setLinePen(m_dashedLineGenerator->getBestPen(lineNumber, (Qt::PenStyle)qtStyle,
-                                                     gf->m_format.getWidth()));
-                // but we need to actually draw the lines in QGScene coords (0.1 mm).
-                item->setWidth(Rez::guiX(gf->m_format.getWidth()));
-                showItem = gf->m_format.getVisible();
+            if (!geom->getHlrVisible()) {
+                // hidden line without a format
+                item->setLinePen(m_dashedLineGenerator->getLinePen(Preferences::HiddenLineStyle(),
+                                                                   vp->LineWidth.getValue()));
+                item->setHiddenEdge(true);
+                item->setWidth(Rez::guiX(vp->HiddenWidth.getValue()));   //thin
+                item->setZValue(ZVALUE::HIDEDGE);
             } else {
-                if (!(*itGeom)->getHlrVisible()) {
-                    // hidden line without a format
-                    item->setLinePen(m_dashedLineGenerator->getLinePen(Preferences::HiddenLineStyle(),
-                                                                       vp->LineWidth.getValue()));
-                    item->setHiddenEdge(true);
-                    item->setWidth(Rez::guiX(vp->HiddenWidth.getValue()));   //thin
-                    item->setZValue(ZVALUE::HIDEDGE);
-                } else {
-                    // unformatted visible line, draw as continuous line
-                    item->setLinePen(m_dashedLineGenerator->getLinePen(1, vp->LineWidth.getValue()));
-                    item->setWidth(Rez::guiX(vp->LineWidth.getValue()));
-                }
+                // unformatted visible line, draw as continuous line
+                item->setLinePen(m_dashedLineGenerator->getLinePen(1, vp->LineWidth.getValue()));
+                item->setWidth(Rez::guiX(vp->LineWidth.getValue()));
             }
         }
+    }
 
-        if ((*itGeom)->getClassOfEdge() == EdgeClass::UVISO) {
-            // we don't have a style option for iso-parametric lines so draw continuous
-            item->setLinePen(m_dashedLineGenerator->getLinePen(1, vp->IsoWidth.getValue()));
-            item->setWidth(Rez::guiX(vp->IsoWidth.getValue()));   //graphic
-        }
+    if (geom->getClassOfEdge() == EdgeClass::UVISO) {
+        // we don't have a style option for iso-parametric lines so draw continuous
+        item->setLinePen(m_dashedLineGenerator->getLinePen(1, vp->IsoWidth.getValue()));
+        item->setWidth(Rez::guiX(vp->IsoWidth.getValue()));   //graphic
+    }
 
-        item->setPos(0.0, 0.0);//now at group(0, 0)
-        item->setZValue(ZVALUE::EDGE);
-        item->setPrettyNormal();
+    item->setPos(0.0, 0.0);//now at group(0, 0)
+    item->setZValue(ZVALUE::EDGE);
+    item->setPrettyNormal();
 
-        if (!vp->ShowAllEdges.getValue() && !showItem) {
-             //view level "show" status  && individual edge "show" status
-             item->hide();
+    if (!vp->ShowAllEdges.getValue() && !showItem) {
+         //view level "show" status  && individual edge "show" status
+         item->hide();
+    }
+    return item;
+}
+
+//! the batch that draws the plain edges with the style of geom
+QGIEdgeBatch* QGIViewPart::getEdgeBatch(const TechDraw::BaseGeomPtr& geom)
+{
+    bool hidden = !geom->getHlrVisible();
+    bool iso = geom->getClassOfEdge() == EdgeClass::UVISO;
+    int key = (hidden ? 1 : 0) + (iso ? 2 : 0);
+    auto it = m_edgeBatches.find(key);
+    if (it != m_edgeBatches.end()) {
+        return it->second;
+    }
+
+    // the same pens as drawEdge uses for unformatted edges
+    auto vp = static_cast<ViewProviderViewPart*>(getViewProvider(getViewObject()));
+    QPen pen;
+    if (iso) {
+        pen = m_dashedLineGenerator->getLinePen(1, vp->IsoWidth.getValue());
+        pen.setWidthF(Rez::guiX(vp->IsoWidth.getValue()));
+    }
+    else if (hidden) {
+        pen = m_dashedLineGenerator->getLinePen(Preferences::HiddenLineStyle(),
+                                                vp->LineWidth.getValue());
+        pen.setWidthF(Rez::guiX(vp->HiddenWidth.getValue()));
+    }
+    else {
+        pen = m_dashedLineGenerator->getLinePen(1, vp->LineWidth.getValue());
+        pen.setWidthF(Rez::guiX(vp->LineWidth.getValue()));
+    }
+    pen.setColor(hidden ? QGIEdge::getHiddenColor()
+                        : PreferencesGui::getAccessibleQColor(PreferencesGui::normalQColor()));
+
+    auto batch = new QGIEdgeBatch();
+    addToGroup(batch);
+    batch->setLinePen(pen);
+    batch->setPos(0.0, 0.0);
+    batch->setZValue(ZVALUE::EDGE);
+    m_edgeBatches[key] = batch;
+    return batch;
+}
+
+//! make a graphics item for a batched edge, so it can be hovered and selected like the others
+QGIEdge* QGIViewPart::promoteEdge(int iEdge)
+{
+    auto found = m_promotedEdges.find(iEdge);
+    if (found != m_promotedEdges.end()) {
+        return found->second;
+    }
+    auto dvp(dynamic_cast<TechDraw::DrawViewPart*>(getViewObject()));
+    if (!dvp || !m_batchedEdges.contains(iEdge)) {
+        return nullptr;
+    }
+    const TechDraw::BaseGeomPtrVector& geoms = dvp->getEdgeGeometry();
+    if (iEdge < 0 || iEdge >= static_cast<int>(geoms.size())) {
+        return nullptr;
+    }
+    QGIEdge* item = drawEdge(geoms.at(iEdge), iEdge);
+    m_promotedEdges[iEdge] = item;
+    return item;
+}
+
+QGIEdge* QGIViewPart::promoteEdgeByName(const std::string& subName)
+{
+    try {
+        if (DrawUtil::getGeomTypeFromName(subName) == "Edge") {
+            return promoteEdge(DrawUtil::getIndexFromName(subName));
         }
+    }
+    catch (Base::ValueError&) {
+        // No action
+    }
+    return nullptr;
+}
 
-        //debug a path
-        //            QPainterPath edgePath=drawPainterPath(*itGeom);
-        //            std::stringstream edgeId;
-        //            edgeId << "QGIVP.edgePath" << i;
-        //            dumpPath(edgeId.str().c_str(), edgePath);
+//! promote the batched edge under pos, and drop the edge promoted for the previous hover
+void QGIViewPart::promoteEdgeAt(const QPointF& pos)
+{
+    if (m_edgeBatches.empty()) {
+        return;
+    }
+    int iEdge = -1;
+    for (auto& batch : m_edgeBatches) {
+        iEdge = batch.second->edgeAt(pos, PreferencesGui::edgeFuzz());
+        if (iEdge >= 0) {
+            break;
+        }
+    }
+    if (iEdge < 0) {
+        return;
     }
+    QGIEdge* item = promoteEdge(iEdge);
+    if (!item || item == m_hoverEdge) {
+        return;
+    }
+    if (m_hoverEdge && !m_hoverEdge->isSelected() && !m_hoverEdge->isUnderMouse()) {
+        m_promotedEdges.erase(m_hoverEdge->getProjIndex());
+        m_hoverEdge->hide();
+        scene()->removeItem(m_hoverEdge);
+        delete m_hoverEdge;
+    }
+    m_hoverEdge = item;
 }
 
 void QGIViewPart::drawAllVertexes()
@@ -620,7 +771,7 @@ QGIFace* QGIViewPart::drawFace(TechDraw::FacePtr f, int idx)
     return gFace;
 }
 
-//! Remove all existing QGIPrimPath items(Vertex, Edge, Face)
+//! Remove all existing QGIPrimPath items(Vertex, Edge, Face) and edge batches
 //note this triggers scene selectionChanged signal if vertex/edge/face is selected
 void QGIViewPart::removePrimitives()
 {
@@ -636,7 +787,16 @@ void QGIViewPart::removePrimitives()
             scene()->removeItem(prim);
             delete prim;
         }
+        else if (c->type() == UserType::QGIEdgeBatch) {
+            c->hide();
+            scene()->removeItem(c);
+            delete c;
+        }
     }
+    m_edgeBatches.clear();
+    m_batchedEdges.clear();
+    m_promotedEdges.clear();
+    m_hoverEdge = nullptr;
     if (mdi) {
         getMDIViewPage()->blockSceneSelection(false);
     }
@@ -1280,6 +1440,10 @@ void QGIViewPart::setGroupSelection(bool isSelected, const std::vector<std::stri
         }
 
         QGraphicsItem *subItem = getQGISubItemByName(subName);
+        if (!subItem && isSelected && !m_batchedEdges.empty()) {
+            // the edge may be drawn in a batch
+            subItem = promoteEdgeByName(subName);
+        }
         if (subItem) {
             subItem->setSelected(isSelected);
         }
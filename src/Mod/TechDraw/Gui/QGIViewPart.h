@@ -28,6 +28,9 @@
 #include <Mod/TechDraw/App/Geometry.h>
 #include <Mod/TechDraw/App/LineGenerator.h>
 
+#include <map>
+#include <set>
+
 #include <QPainter>
 #include <QStyleOptionGraphicsItem>
 
@@ -54,6 +57,7 @@ namespace TechDrawGui
 {
 class QGIFace;
 class QGIEdge;
+class QGIEdgeBatch;
 class QGIHighlight;
 class PathBuilder;
 
@@ -131,6 +135,11 @@ protected:
     QPainterPath drawPainterPath(TechDraw::BaseGeomPtr baseGeom) const;
     void drawViewPart();
     QGIFace* drawFace(TechDraw::FacePtr f, int idx);
+    QGIEdge* drawEdge(const TechDraw::BaseGeomPtr& geom, int iEdge);
+    QGIEdgeBatch* getEdgeBatch(const TechDraw::BaseGeomPtr& geom);
+    QGIEdge* promoteEdge(int iEdge);
+    QGIEdge* promoteEdgeByName(const std::string& subName);
+    void promoteEdgeAt(const QPointF& pos);
 
     QVariant itemChange(GraphicsItemChange change, const QVariant &value) override;
     void hoverEnterEvent(QGraphicsSceneHoverEvent* event) override;
@@ -157,6 +166,11 @@ private:
     TechDraw::LineGenerator* m_dashedLineGenerator;
     QMetaObject::Connection m_selectionChangedConnection;
 
+    std::map<int, QGIEdgeBatch*> m_edgeBatches;     // by edge style
+    std::set<int> m_batchedEdges;
+    std::map<int, QGIEdge*> m_promotedEdges;
+    QGIEdge* m_hoverEdge{nullptr};
+
 };
 
 } // namespace
@@ -67,6 +67,11 @@ void QGIViewSection::drawSectionFace()
 
     float lineWidth    = sectionVp->LineWidth.getValue();
 
+    std::vector<std::vector<TechDraw::LineSet>> faceLineSets;
+    if (section->CutSurfaceDisplay.isValue("PatHatch")) {
+        faceLineSets = section->getAllDrawableLines();
+    }
+
     std::vector<TechDraw::FacePtr>::iterator fit = sectionFaces.begin();
     int i = 0;
     for(; fit != sectionFaces.end(); fit++, i++) {
@@ -107,9 +112,8 @@ void QGIViewSection::drawSectionFace()
             newFace->setHatchRotation(section->HatchRotation.getValue());
             newFace->setHatchOffset(section->HatchOffset.getValue());
             newFace->setLineWeight(sectionVp->WeightPattern.getValue());
-            std::vector<TechDraw::LineSet> lineSets = section->getDrawableLines(i);
-            if (!lineSets.empty()) {
-                for (auto& ls: lineSets) {
+            if (i < static_cast<int>(faceLineSets.size())) {
+                for (auto& ls: faceLineSets.at(i)) {
                     newFace->addLineSet(ls);
                 }
             }
@@ -263,7 +263,7 @@ void TaskCenterLine::onOrientationChanged()
     if (m_type == Type::EDGE)
         updateOrientation();
     else
-        m_partFeat->recomputeFeature();
+        m_partFeat->CenterLines.touch();
 }
 
 void TaskCenterLine::onShiftHorizChanged()
@@ -273,7 +273,7 @@ void TaskCenterLine::onShiftHorizChanged()
     }
 
     m_cl->m_hShift = ui->qsbHorizShift->rawValue();
-    m_partFeat->recomputeFeature();
+    m_partFeat->CenterLines.touch();
 }
 
 void TaskCenterLine::onShiftVertChanged()
@@ -283,7 +283,7 @@ void TaskCenterLine::onShiftVertChanged()
     }
 
     m_cl->m_vShift = ui->qsbVertShift->rawValue();
-    m_partFeat->recomputeFeature();
+    m_partFeat->CenterLines.touch();
 }
 
 void TaskCenterLine::onRotationChanged()
@@ -293,7 +293,7 @@ void TaskCenterLine::onRotationChanged()
     }
 
     m_cl->m_rotate = ui->qsbRotate->rawValue();
-    m_partFeat->recomputeFeature();
+    m_partFeat->CenterLines.touch();
 }
 
 void TaskCenterLine::onExtendChanged()
@@ -303,7 +303,7 @@ void TaskCenterLine::onExtendChanged()
     }
 
     m_cl->m_extendBy = ui->qsbExtend->rawValue();
-    m_partFeat->recomputeFeature();
+    m_partFeat->CenterLines.touch();
 }
 
 void TaskCenterLine::onColorChanged()
@@ -314,7 +314,7 @@ void TaskCenterLine::onColorChanged()
 
     Base::Color color = Base::Color::fromValue<QColor>(ui->cpLineColor->color());
     m_cl->m_format.setColor(color);
-    m_partFeat->recomputeFeature();
+    m_partFeat->CenterLines.touch();
 }
 
 void TaskCenterLine::onWeightChanged()
@@ -324,7 +324,7 @@ void TaskCenterLine::onWeightChanged()
     }
 
     m_cl->m_format.setWidth(ui->dsbWeight->value().getValue());
-    m_partFeat->recomputeFeature();
+    m_partFeat->CenterLines.touch();
 }
 
 void TaskCenterLine::onStyleChanged()
@@ -334,7 +334,7 @@ void TaskCenterLine::onStyleChanged()
     }
 
     m_cl->m_format.setLineNumber(ui->cboxStyle->currentIndex() + 1);
-    m_partFeat->recomputeFeature();
+    m_partFeat->CenterLines.touch();
 }
 
 // check that we are not trying to create an impossible centerline (ex a vertical centerline
@@ -432,7 +432,6 @@ void TaskCenterLine::createCenterLine()
     cl->m_format.setVisible(true);
     m_partFeat->addCenterLine(cl);
 
-    m_partFeat->recomputeFeature();
     Gui::Command::updateActive();
     Gui::Command::commitCommand();
 
@@ -469,7 +468,7 @@ void TaskCenterLine::updateOrientation()
 
     setUiOrientation(orientation);
 
-    m_partFeat->recomputeFeature();
+    m_partFeat->CenterLines.touch();
 }
 
 void TaskCenterLine::setUiOrientation(Mode orientation)
@@ -563,7 +562,7 @@ bool TaskCenterLine::reject()
     }
 
     if (m_partFeat)
-        m_partFeat->recomputeFeature();
+        m_partFeat->CenterLines.touch();
     Gui::Command::doCommand(Gui::Command::Gui, "App.activeDocument().recompute()");
     doc->resetEdit();
 
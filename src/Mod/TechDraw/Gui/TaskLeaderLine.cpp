@@ -404,9 +404,10 @@ void TaskLeaderLine::createLeaderFeature(std::vector<Base::Vector3d> sceneDeltas
     Gui::Command::updateActive();
     Gui::Command::commitCommand();
 
-    //trigger claimChildren in tree
+    //trigger claimChildren in tree. the leader doesn't change the geometry of the base view, so
+    //the base view is not recomputed
     if (m_baseFeat) {
-        m_baseFeat->touch();
+        m_baseFeat->touch(true);
     }
 
     m_basePage->touch();
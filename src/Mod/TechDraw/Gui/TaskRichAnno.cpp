@@ -331,9 +331,10 @@ void TaskRichAnno::createAnnoFeature()
     Gui::Command::commitCommand();
     Gui::Command::updateActive();
 
-    //trigger claimChildren in tree
+    //trigger claimChildren in tree. the annotation doesn't change the geometry of the base view,
+    //so the base view is not recomputed
     if (m_baseFeat) {
-        m_baseFeat->touch();
+        m_baseFeat->touch(true);
     }
 
     m_basePage->touch();
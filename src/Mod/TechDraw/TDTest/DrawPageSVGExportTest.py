@@ -0,0 +1,69 @@
+import FreeCAD
+import codecs
+import os
+import tempfile
+import unittest
+import xml.etree.ElementTree as ET
+from .TechDrawTestUtilities import createPageWithSVGTemplate
+
+import TechDraw
+
+SVG = "{http://www.w3.org/2000/svg}"
+
+
+class DrawPageSVGExportTest(unittest.TestCase):
+    def setUp(self):
+        """Creates a page with an annotation and the same symbol twice"""
+        FreeCAD.newDocument("TDSVGExport")
+        FreeCAD.setActiveDocument("TDSVGExport")
+        FreeCAD.ActiveDocument = FreeCAD.getDocument("TDSVGExport")
+        self.page = createPageWithSVGTemplate()
+
+        path = os.path.dirname(os.path.abspath(__file__))
+        f = codecs.open(path + "/TestSymbol.svg", "r", encoding="utf-8")
+        svg = f.read()
+        f.close()
+        for name, x in (("Symbol1", 100.0), ("Symbol2", 200.0)):
+            sym = FreeCAD.ActiveDocument.addObject("TechDraw::DrawViewSymbol", name)
+            sym.Symbol = svg
+            self.page.addView(sym)
+            sym.X = x
+            sym.Y = 150.0
+
+        anno = FreeCAD.ActiveDocument.addObject("TechDraw::DrawViewAnnotation", "Anno")
+        anno.Text = ["first line", "a < b"]
+        self.page.addView(anno)
+        FreeCAD.ActiveDocument.recompute()
+        self.dir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        FreeCAD.closeDocument("TDSVGExport")
+
+    def checkPage(self, fileName):
+        root = ET.parse(fileName).getroot()
+        self.assertEqual(root.tag, SVG + "svg")
+        groups = {g.get("id"): g for g in root.iter(SVG + "g")}
+        self.assertIn("Template", groups)
+        # the symbol is defined once and used twice
+        self.assertIn("symbol0", groups)
+        self.assertNotIn("symbol1", groups)
+        self.assertEqual(len(list(root.iter(SVG + "use"))), 2)
+        lines = [t.text for t in root.iter(SVG + "tspan") if t.text in ("first line", "a < b")]
+        self.assertEqual(lines, ["first line", "a < b"])
+
+    def testWriteSVGPage(self):
+        """Tests exporting a page to SVG without the Gui"""
+        fileName = os.path.join(self.dir, "page.svg")
+        TechDraw.writeSVGPage(self.page, fileName)
+        self.checkPage(fileName)
+
+    def testWriteSVGPages(self):
+        """Tests exporting several pages at once"""
+        fileNames = [os.path.join(self.dir, "page{}.svg".format(i)) for i in range(3)]
+        TechDraw.writeSVGPages([(self.page, fileName) for fileName in fileNames])
+        for fileName in fileNames:
+            self.checkPage(fileName)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -28,9 +28,7 @@ class DrawViewPartTest(unittest.TestCase):
         print("DrawViewPart test finished")
         FreeCAD.closeDocument("TDPart")
 
-    def testMakeDrawViewPart(self):
-        """Tests if a view can be added to page"""
-        print("testing DrawViewPart")
+    def makeView(self):
         view = FreeCAD.ActiveDocument.addObject("TechDraw::DrawViewPart", "View")
         self.page.addView(view)
         FreeCAD.ActiveDocument.View.Source = [FreeCAD.ActiveDocument.Box]
@@ -45,10 +43,35 @@ class DrawViewPartTest(unittest.TestCase):
 
         timer.start(2000)   #2 second delay
         loop.exec_()
+        return view
+
+    def edgeCount(self, view):
+        count = 0
+        while True:
+            try:
+                view.getEdgeBySelection("Edge{}".format(count))
+            except ValueError:
+                return count
+            count += 1
+
+    def testMakeDrawViewPart(self):
+        """Tests if a view can be added to page"""
+        print("testing DrawViewPart")
+        view = self.makeView()
 
         edges = view.getVisibleEdges()
         self.assertEqual(len(edges), 4, "DrawViewPart has wrong number of edges")
         self.assertTrue("Up-to-date" in view.State, "DrawViewPart is not Up-to-date")
 
+    def testCosmeticEdgeKeepsProjection(self):
+        """Tests that a cosmetic edge is added to the geometry without projecting the view again"""
+        view = self.makeView()
+        count = self.edgeCount(view)
+
+        view.makeCosmeticLine(FreeCAD.Vector(0, 0, 0), FreeCAD.Vector(5, 5, 0))
+        self.assertEqual(self.edgeCount(view), count + 1, "Cosmetic edge is not in the geometry")
+        self.assertEqual(FreeCAD.ActiveDocument.recompute(), 0, "Cosmetic edge recomputed the view")
+        self.assertEqual(self.edgeCount(view), count + 1, "Cosmetic edge was lost")
+
 if __name__ == "__main__":
     unittest.main()
@@ -70,6 +70,45 @@ class DrawViewSectionTest(unittest.TestCase):
         self.assertEqual(len(edges), 4, "DrawViewSection has wrong number of edges")
         self.assertTrue("Up-to-date" in section.State)
 
+    def testSectionOfSeveralSolids(self):
+        """Tests the section of a compound of solids, which are cut one by one"""
+        box2 = FreeCAD.ActiveDocument.addObject("Part::Box", "Box2")
+        box2.Placement.Base = FreeCAD.Vector(20.0, 0.0, 0.0)
+        compound = FreeCAD.ActiveDocument.addObject("Part::Compound", "Compound")
+        compound.Links = [self.box, box2]
+        section = FreeCAD.ActiveDocument.addObject(
+            "TechDraw::DrawViewSection", "Section"
+        )
+        self.page.addView(section)
+        section.Source = [compound]
+        section.BaseView = self.view
+        section.Direction = (0.0, 1.0, 0.0)
+        section.SectionNormal = (0.0, 1.0, 0.0)
+        section.SectionOrigin = (5.0, 5.0, 5.0)
+        FreeCAD.ActiveDocument.recompute()
+        self.waitForThreads()
+
+        self.assertEqual(len(section.getVisibleEdges()), 8, "DrawViewSection has wrong number of edges")
+
+        # a new scale reuses the cut of the solids
+        section.ScaleType = "Custom"
+        section.Scale = 2.0
+        FreeCAD.ActiveDocument.recompute()
+        self.waitForThreads()
+
+        self.assertEqual(len(section.getVisibleEdges()), 8, "Reused section cut has wrong number of edges")
+        self.assertTrue("Up-to-date" in section.State)
+
+    def waitForThreads(self):
+        loop = QtCore.QEventLoop()
+
+        timer = QtCore.QTimer()
+        timer.setSingleShot(True)
+        timer.timeout.connect(loop.quit)
+
+        timer.start(2000)   #2 second delay
+        loop.exec_()
+
 
 if __name__ == "__main__":
     unittest.main()
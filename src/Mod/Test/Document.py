@@ -2054,6 +2054,55 @@ class DocumentObserverCases(unittest.TestCase):
         self.assertEqual(self.Obs.parameter2.pop(), self.Doc1.FileName)
         FreeCAD.closeDocument(self.Doc1.Name)
 
+    def testFilteredObserver(self):
+        class FilteredObserver:
+            ObservedTypes = ["App::FeatureTest"]
+            ObservedProperties = ["Integer"]
+
+            def __init__(self):
+                self.changed = []
+                self.batches = []
+
+            def slotChangedObject(self, obj, prop):
+                self.changed.append((obj.Name, prop))
+
+            def slotChangedObjects(self, changes):
+                self.batches.append([(obj.Name, prop) for obj, prop in changes])
+
+        obs = FilteredObserver()
+        FreeCAD.addDocumentObserver(obs)
+        self.Doc1 = FreeCAD.newDocument("Observer1")
+        test1 = self.Doc1.addObject("App::FeatureTest", "test1")
+        test2 = self.Doc1.addObject("App::FeatureTest", "test2")
+        group = self.Doc1.addObject("App::DocumentObjectGroup", "group")
+        test2.setExpression("Integer", "test1.Integer + 1")
+        obs.changed.clear()
+        obs.batches.clear()
+
+        # other objects and properties are filtered, changes outside a recompute come at once
+        test1.Integer = 5
+        test1.Float = 1.0
+        group.Label = "Other"
+        self.assertEqual(obs.changed, [("test1", "Integer")])
+        self.assertEqual(obs.batches, [[("test1", "Integer")]])
+
+        # the changes of a recompute come in one batch after it
+        obs.changed.clear()
+        obs.batches.clear()
+        self.Doc1.recompute()
+        self.assertEqual(obs.changed, [("test2", "Integer")])
+        self.assertEqual(obs.batches, [[("test2", "Integer")]])
+        self.assertEqual(test2.Integer, 6)
+
+        FreeCAD.removeDocumentObserver(obs)
+        FreeCAD.closeDocument(self.Doc1.Name)
+
+        class UnknownTypeObserver:
+            ObservedTypes = ["App::NoSuchType"]
+
+        with self.assertRaises(ValueError):
+            FreeCAD.addDocumentObserver(UnknownTypeObserver())
+
     def testDocument(self):
         # in case another document already exists then the tests cannot
         # be done reliably
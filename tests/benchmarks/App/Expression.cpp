@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <memory>
+
+#include "SyntheticDocument.h"
+
+using benchmarks::SyntheticDocument;
+
+// Parsing and resolving a cross object path as used by expressions and Python
+static void BM_ObjectIdentifierResolve(benchmark::State& state)
+{
+    auto& doc = SyntheticDocument::get(static_cast<int>(state.range(0)));
+    auto owner = doc.objects.front();
+    std::string path = std::string(doc.objects.back()->getNameInDocument()) + ".Value";
+    for (auto _ : state) {
+        auto id = App::ObjectIdentifier::parse(owner, path);
+        benchmark::DoNotOptimize(id.getProperty());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ObjectIdentifierResolve)->SYNTHETIC_DOCUMENT_SIZES;
+
+static void BM_ExpressionParse(benchmark::State& state)
+{
+    auto& doc = SyntheticDocument::get(static_cast<int>(state.range(0)));
+    auto owner = doc.objects.front();
+    std::string text = std::string(doc.objects.back()->getNameInDocument())
+        + ".Value * 2 + sin(30 deg) * 10 mm / 1 mm";
+    for (auto _ : state) {
+        std::unique_ptr<App::Expression> expr(App::Expression::parse(owner, text));
+        benchmark::DoNotOptimize(expr.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExpressionParse)->SYNTHETIC_DOCUMENT_SIZES;
+
+static void BM_ExpressionEval(benchmark::State& state)
+{
+    auto& doc = SyntheticDocument::get(static_cast<int>(state.range(0)));
+    auto owner = doc.objects.front();
+    std::string text = std::string(doc.objects.back()->getNameInDocument())
+        + ".Value * 2 + sin(30 deg) * 10 mm / 1 mm";
+    std::unique_ptr<App::Expression> expr(App::Expression::parse(owner, text));
+    for (auto _ : state) {
+        std::unique_ptr<App::Expression> result(expr->eval());
+        benchmark::DoNotOptimize(result.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExpressionEval)->SYNTHETIC_DOCUMENT_SIZES;
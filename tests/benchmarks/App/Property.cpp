@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "SyntheticDocument.h"
+
+using benchmarks::SyntheticDocument;
+
+// Setting a property value, i.e. aboutToSetValue(), touch() and the change signals
+static void BM_PropertyIntegerSetValue(benchmark::State& state)
+{
+    auto& doc = SyntheticDocument::get(static_cast<int>(state.range(0)));
+    std::size_t index = 0;
+    long value = 0;
+    for (auto _ : state) {
+        doc.value(index)->setValue(++value);
+        if (++index == doc.objects.size()) {
+            index = 0;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PropertyIntegerSetValue)->SYNTHETIC_DOCUMENT_SIZES;
+
+// Lookup of a static property, found in the property data of the class
+static void BM_GetPropertyByNameStatic(benchmark::State& state)
+{
+    auto& doc = SyntheticDocument::get(static_cast<int>(state.range(0)));
+    std::size_t index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(doc.objects[index]->getPropertyByName("ExpressionEngine"));
+        if (++index == doc.objects.size()) {
+            index = 0;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetPropertyByNameStatic)->SYNTHETIC_DOCUMENT_SIZES;
+
+// Lookup of a dynamic property
+static void BM_GetPropertyByNameDynamic(benchmark::State& state)
+{
+    auto& doc = SyntheticDocument::get(static_cast<int>(state.range(0)));
+    std::size_t index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(doc.objects[index]->getPropertyByName("Source"));
+        if (++index == doc.objects.size()) {
+            index = 0;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetPropertyByNameDynamic)->SYNTHETIC_DOCUMENT_SIZES;
+
+// Lookup of an object by its name in the document
+static void BM_DocumentGetObject(benchmark::State& state)
+{
+    auto& doc = SyntheticDocument::get(static_cast<int>(state.range(0)));
+    std::vector<std::string> names;
+    names.reserve(doc.objects.size());
+    for (auto obj : doc.objects) {
+        names.emplace_back(obj->getNameInDocument());
+    }
+    std::size_t index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(doc.document->getObject(names[index].c_str()));
+        if (++index == names.size()) {
+            index = 0;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DocumentGetObject)->SYNTHETIC_DOCUMENT_SIZES;
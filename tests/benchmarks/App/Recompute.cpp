@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "SyntheticDocument.h"
+
+using benchmarks::SyntheticDocument;
+
+// Collecting the dependents of the first object, i.e. the whole chain
+static void BM_InListRecursive(benchmark::State& state)
+{
+    auto& doc = SyntheticDocument::get(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(doc.objects.front()->getInListRecursive());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InListRecursive)->SYNTHETIC_DOCUMENT_SIZES->Unit(benchmark::kMillisecond);
+
+// Touching the first object and recomputing the whole chain
+static void BM_TouchPropagation(benchmark::State& state)
+{
+    auto& doc = SyntheticDocument::get(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        doc.objects.front()->touch();
+        doc.document->recompute();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TouchPropagation)->SYNTHETIC_DOCUMENT_SIZES->Unit(benchmark::kMillisecond);
+
+// Changing the head of a chain of expressions and recomputing all of them
+static void BM_ExpressionChainRecompute(benchmark::State& state)
+{
+    auto& doc = SyntheticDocument::get(static_cast<int>(state.range(0)), true);
+    long value = 0;
+    for (auto _ : state) {
+        doc.value(0)->setValue(++value);
+        doc.document->recompute();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ExpressionChainRecompute)->SYNTHETIC_DOCUMENT_SIZES->Unit(benchmark::kMillisecond);
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef BENCHMARKS_APP_SYNTHETICDOCUMENT_H
+#define BENCHMARKS_APP_SYNTHETICDOCUMENT_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <App/DocumentObject.h>
+#include <App/Expression.h>
+#include <App/ObjectIdentifier.h>
+#include <App/PropertyLinks.h>
+#include <App/PropertyStandard.h>
+
+#include "src/App/InitApplication.h"
+
+namespace benchmarks
+{
+
+/*!
+ * \brief The SyntheticDocument class
+ * A document with a chain of \a size VarSet objects. Each object has an integer
+ * property \c Value and a link property \c Source pointing to its predecessor.
+ * Optionally \c Value is bound to the expression <tt>Predecessor.Value + 1</tt>.
+ *
+ * Creating 100k objects takes a while, so the documents are cached for the
+ * lifetime of the benchmark process and shared by all benchmarks.
+ */
+class SyntheticDocument
+{
+public:
+    static SyntheticDocument& get(int size, bool withExpressions = false)
+    {
+        static std::map<std::pair<int, bool>, SyntheticDocument> documents;
+        auto it = documents.find({size, withExpressions});
+        if (it == documents.end()) {
+            it = documents.emplace(std::make_pair(size, withExpressions), SyntheticDocument()).first;
+            it->second.create(size, withExpressions);
+        }
+        return it->second;
+    }
+
+    App::Document* document {};
+    std::vector<App::DocumentObject*> objects;
+
+    App::PropertyInteger* value(std::size_t index) const
+    {
+        return static_cast<App::PropertyInteger*>(objects[index]->getPropertyByName("Value"));
+    }
+
+private:
+    void create(int size, bool withExpressions)
+    {
+        tests::initApplication();
+        auto& app = App::GetApplication();
+        std::string name = app.getUniqueDocumentName("Benchmark");
+        document = app.newDocument(name.c_str(), name.c_str(), {.createView = false, .temporary = true});
+        document->setUndoMode(0);
+
+        objects.reserve(size);
+        App::DocumentObject* previous = nullptr;
+        for (int i = 0; i < size; ++i) {
+            auto obj = document->addObject("App::VarSet", "Object");
+            obj->addDynamicProperty("App::PropertyInteger", "Value");
+            auto link = static_cast<App::PropertyLink*>(
+                obj->addDynamicProperty("App::PropertyLink", "Source"));
+            link->setValue(previous);
+            if (withExpressions && previous) {
+                std::shared_ptr<App::Expression> expr(App::Expression::parse(
+                    obj,
+                    std::string(previous->getNameInDocument()) + ".Value + 1"));
+                obj->setExpression(App::ObjectIdentifier(*obj->getPropertyByName("Value")), expr);
+            }
+            objects.push_back(obj);
+            previous = obj;
+        }
+        document->recompute();
+    }
+};
+
+}  // namespace benchmarks
+
+/// The synthetic document sizes used by all benchmarks
+#define SYNTHETIC_DOCUMENT_SIZES Arg(1000)->Arg(10000)->Arg(100000)
+
+#endif  // BENCHMARKS_APP_SYNTHETICDOCUMENT_H
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <Mod/Mesh/App/Core/Curvature.h>
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/SetOperations.h>
+#include <Mod/Mesh/App/Core/Smoothing.h>
+
+#include "SyntheticMesh.h"
+
+using benchmarks::SyntheticMesh;
+
+// Ten steps of Laplace smoothing, the mesh is copied before each run
+static void BM_MeshLaplaceSmoothing(benchmark::State& state)
+{
+    const auto& source = SyntheticMesh::get(SyntheticMesh::Torus, state.range(0));
+    benchmarks::ThreadCount threads(static_cast<int>(state.range(1)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        MeshCore::MeshKernel kernel = source;
+        state.ResumeTiming();
+        MeshCore::LaplaceSmoothing(kernel).Smooth(10);
+    }
+    state.SetItemsProcessed(state.iterations() * long(source.CountPoints()));
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_MeshLaplaceSmoothing)->SYNTHETIC_MESH_ARGUMENTS;
+
+// Decimation to a tenth of the facets with the serial quadric simplification
+static void BM_MeshSimplify(benchmark::State& state)
+{
+    const auto& source = SyntheticMesh::get(SyntheticMesh::Torus, state.range(0));
+    benchmarks::ThreadCount threads(static_cast<int>(state.range(1)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        MeshCore::MeshKernel kernel = source;
+        state.ResumeTiming();
+        MeshCore::MeshSimplify(kernel).simplify(static_cast<int>(source.CountFacets() / 10));
+    }
+    state.SetItemsProcessed(state.iterations() * long(source.CountFacets()));
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_MeshSimplify)->SYNTHETIC_MESH_ARGUMENTS;
+
+// Decimation to a tenth of the facets with one part per thread
+static void BM_MeshSimplifyPartitioned(benchmark::State& state)
+{
+    const auto& source = SyntheticMesh::get(SyntheticMesh::Torus, state.range(0));
+    benchmarks::ThreadCount threads(static_cast<int>(state.range(1)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        MeshCore::MeshKernel kernel = source;
+        state.ResumeTiming();
+        MeshCore::MeshSimplify(kernel).simplifyPartitioned(
+            static_cast<int>(source.CountFacets() / 10));
+    }
+    state.SetItemsProcessed(state.iterations() * long(source.CountFacets()));
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_MeshSimplifyPartitioned)->SYNTHETIC_MESH_ARGUMENTS;
+
+// The union of the sphere and the torus, each with half of the facets
+static void BM_MeshSetOperations(benchmark::State& state)
+{
+    MeshCore::MeshKernel sphere = SyntheticMesh::get(SyntheticMesh::Sphere, state.range(0) / 2);
+    const auto& torus = SyntheticMesh::get(SyntheticMesh::Torus, state.range(0) / 2);
+    benchmarks::ThreadCount threads(static_cast<int>(state.range(1)));
+    for (auto _ : state) {
+        MeshCore::MeshKernel result;
+        MeshCore::SetOperations(sphere, torus, result, MeshCore::SetOperations::Union, 1.0e-5F)
+            .Do();
+        benchmark::DoNotOptimize(result.CountFacets());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_MeshSetOperations)->SYNTHETIC_MESH_ARGUMENTS;
+
+// The principal curvatures at all vertices
+static void BM_MeshCurvaturePerVertex(benchmark::State& state)
+{
+    const auto& kernel = SyntheticMesh::get(SyntheticMesh::Torus, state.range(0));
+    benchmarks::ThreadCount threads(static_cast<int>(state.range(1)));
+    for (auto _ : state) {
+        MeshCore::MeshCurvature curvature(kernel);
+        curvature.ComputePerVertex();
+        benchmark::DoNotOptimize(curvature.GetCurvature().data());
+    }
+    state.SetItemsProcessed(state.iterations() * long(kernel.CountPoints()));
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_MeshCurvaturePerVertex)->SYNTHETIC_MESH_ARGUMENTS;
+
+// The principal curvatures of all facets from a local surface fit
+static void BM_MeshCurvaturePerFace(benchmark::State& state)
+{
+    const auto& kernel = SyntheticMesh::get(SyntheticMesh::Torus, state.range(0));
+    benchmarks::ThreadCount threads(static_cast<int>(state.range(1)));
+    for (auto _ : state) {
+        MeshCore::MeshCurvature curvature(kernel);
+        curvature.ComputePerFace(true);
+        benchmark::DoNotOptimize(curvature.GetCurvature().data());
+    }
+    state.SetItemsProcessed(state.iterations() * long(kernel.CountFacets()));
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_MeshCurvaturePerFace)->SYNTHETIC_MESH_ARGUMENTS;
@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef BENCHMARKS_MESH_SYNTHETICMESH_H
+#define BENCHMARKS_MESH_SYNTHETICMESH_H
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numbers>
+#include <thread>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <Mod/Mesh/App/Core/Definitions.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+namespace benchmarks
+{
+
+/*!
+ * \brief The SyntheticMesh class
+ * Closed meshes of a UV sphere of radius 1 and a torus with the radii 1 and 0.4 around the
+ * origin with about \a size facets. Both are closed and 2-manifold and the torus crosses the
+ * sphere, so they can be used for the set operations.
+ *
+ * A mesh with 50M facets needs several GB, so only the mesh used last is cached.
+ */
+class SyntheticMesh
+{
+public:
+    enum Shape
+    {
+        Sphere,
+        Torus,
+    };
+
+    static const MeshCore::MeshKernel& get(Shape shape, long size)
+    {
+        static Shape cachedShape {};
+        static long cachedSize {};
+        static std::unique_ptr<MeshCore::MeshKernel> cached;
+        if (!cached || cachedShape != shape || cachedSize != size) {
+            cached.reset();
+            cached = std::make_unique<MeshCore::MeshKernel>();
+            if (shape == Sphere) {
+                createSphere(*cached, size);
+            }
+            else {
+                createTorus(*cached, size);
+            }
+            cachedShape = shape;
+            cachedSize = size;
+        }
+        return *cached;
+    }
+
+private:
+    // 'rings' latitudes and 2 * rings longitudes give 4 * rings * (rings - 1) facets
+    static void createSphere(MeshCore::MeshKernel& kernel, long size)
+    {
+        const auto rings = std::max<unsigned long>(std::lround(std::sqrt(size / 4.0)) + 1, 3);
+        const unsigned long segments = 2 * rings;
+        MeshCore::MeshPointArray points;
+        points.reserve(segments * (rings - 1) + 2);
+        points.emplace_back(0.0F, 0.0F, 1.0F);
+        for (unsigned long i = 1; i < rings; i++) {
+            double theta = std::numbers::pi * double(i) / double(rings);
+            for (unsigned long j = 0; j < segments; j++) {
+                double phi = 2.0 * std::numbers::pi * double(j) / double(segments);
+                points.emplace_back(float(std::sin(theta) * std::cos(phi)),
+                                    float(std::sin(theta) * std::sin(phi)),
+                                    float(std::cos(theta)));
+            }
+        }
+        const unsigned long south = points.size();
+        points.emplace_back(0.0F, 0.0F, -1.0F);
+
+        auto index = [segments](unsigned long ring, unsigned long seg) {
+            return 1 + (ring - 1) * segments + seg % segments;
+        };
+        MeshCore::MeshFacetArray facets;
+        facets.reserve(2 * segments * (rings - 1));
+        for (unsigned long j = 0; j < segments; j++) {
+            facets.emplace_back(0, index(1, j), index(1, j + 1));
+        }
+        for (unsigned long i = 1; i + 1 < rings; i++) {
+            for (unsigned long j = 0; j < segments; j++) {
+                facets.emplace_back(index(i, j), index(i + 1, j), index(i + 1, j + 1));
+                facets.emplace_back(index(i, j), index(i + 1, j + 1), index(i, j + 1));
+            }
+        }
+        for (unsigned long j = 0; j < segments; j++) {
+            facets.emplace_back(south, index(rings - 1, j + 1), index(rings - 1, j));
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    // 'rings' tubes with 2 * rings vertices each give 4 * rings * rings facets
+    static void createTorus(MeshCore::MeshKernel& kernel, long size)
+    {
+        const auto rings = std::max<unsigned long>(std::lround(std::sqrt(size / 4.0)), 3);
+        const unsigned long segments = 2 * rings;
+        const double radius1 = 1.0;
+        const double radius2 = 0.4;
+        MeshCore::MeshPointArray points;
+        points.reserve(rings * segments);
+        for (unsigned long i = 0; i < segments; i++) {
+            double phi = 2.0 * std::numbers::pi * double(i) / double(segments);
+            for (unsigned long j = 0; j < rings; j++) {
+                double theta = 2.0 * std::numbers::pi * double(j) / double(rings);
+                double dist = radius1 + radius2 * std::cos(theta);
+                points.emplace_back(float(dist * std::cos(phi)),
+                                    float(dist * std::sin(phi)),
+                                    float(radius2 * std::sin(theta)));
+            }
+        }
+
+        auto index = [rings, segments](unsigned long seg, unsigned long ring) {
+            return (seg % segments) * rings + ring % rings;
+        };
+        MeshCore::MeshFacetArray facets;
+        facets.reserve(2 * rings * segments);
+        for (unsigned long i = 0; i < segments; i++) {
+            for (unsigned long j = 0; j < rings; j++) {
+                facets.emplace_back(index(i, j), index(i + 1, j), index(i + 1, j + 1));
+                facets.emplace_back(index(i, j), index(i + 1, j + 1), index(i, j + 1));
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+};
+
+/*!
+ * \brief The ThreadCount class
+ * Limits the threads of the mesh algorithms to \a count while it exists.
+ */
+class ThreadCount
+{
+public:
+    explicit ThreadCount(int count)
+    {
+        MeshCore::MeshDefinitions::SetMaxThreadCount(count);
+    }
+    ~ThreadCount()
+    {
+        MeshCore::MeshDefinitions::SetMaxThreadCount(0);
+    }
+    ThreadCount(const ThreadCount&) = delete;
+    ThreadCount& operator=(const ThreadCount&) = delete;
+};
+
+/// Sets the peak resident set size of the process in MB, it only grows over all benchmarks
+inline void setPeakMemory(benchmark::State& state)
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters {};
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    double peak = double(counters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+#else
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    double peak = double(usage.ru_maxrss) / (1024.0 * 1024.0);
+#else
+    double peak = double(usage.ru_maxrss) / 1024.0;
+#endif
+#endif
+    state.counters["PeakRSS_MB"] = peak;
+}
+
+/// The mesh sizes in facets and the thread counts 1, 2, 4, ... up to the number of cores
+inline void meshArguments(benchmark::internal::Benchmark* bench)
+{
+    const int cores = std::max(int(std::thread::hardware_concurrency()), 1);
+    bench->ArgNames({"facets", "threads"});
+    for (long size : {1000000L, 10000000L, 50000000L}) {
+        for (int threads = 1; threads < cores; threads *= 2) {
+            bench->Args({size, threads});
+        }
+        bench->Args({size, cores});
+    }
+}
+
+}  // namespace benchmarks
+
+/// The mesh sizes and thread counts used by all benchmarks, the wall time is measured
+#define SYNTHETIC_MESH_ARGUMENTS                                                                   \
+    Apply(benchmarks::meshArguments)->UseRealTime()->Unit(benchmark::kMillisecond)
+
+#endif  // BENCHMARKS_MESH_SYNTHETICMESH_H
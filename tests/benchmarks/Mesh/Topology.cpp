@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <sstream>
+
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+
+#include "SyntheticMesh.h"
+
+using benchmarks::SyntheticMesh;
+
+// Computing the neighbourhood of all facets from the point indices
+static void BM_MeshRebuildNeighbours(benchmark::State& state)
+{
+    MeshCore::MeshKernel kernel = SyntheticMesh::get(SyntheticMesh::Sphere, state.range(0));
+    benchmarks::ThreadCount threads(static_cast<int>(state.range(1)));
+    for (auto _ : state) {
+        kernel.RebuildNeighbours();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * long(kernel.CountFacets()));
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_MeshRebuildNeighbours)->SYNTHETIC_MESH_ARGUMENTS;
+
+// Reading a binary STL file from memory, including welding the points and the neighbourhood
+static void BM_MeshLoadSTL(benchmark::State& state)
+{
+    std::stringstream str;
+    {
+        const auto& kernel = SyntheticMesh::get(SyntheticMesh::Sphere, state.range(0));
+        MeshCore::MeshOutput(kernel).SaveBinarySTL(str);
+    }
+    benchmarks::ThreadCount threads(static_cast<int>(state.range(1)));
+    std::size_t facets = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::istringstream input(str.str());
+        MeshCore::MeshKernel kernel;
+        state.ResumeTiming();
+        MeshCore::MeshInput(kernel).LoadSTL(input);
+        facets = kernel.CountFacets();
+    }
+    state.SetItemsProcessed(state.iterations() * long(facets));
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_MeshLoadSTL)->SYNTHETIC_MESH_ARGUMENTS;
+
+// Searching for self-intersections, the torus has none so every facet pair gets tested
+static void BM_MeshEvalSelfIntersection(benchmark::State& state)
+{
+    const auto& kernel = SyntheticMesh::get(SyntheticMesh::Torus, state.range(0));
+    benchmarks::ThreadCount threads(static_cast<int>(state.range(1)));
+    for (auto _ : state) {
+        MeshCore::MeshEvalSelfIntersection eval(kernel);
+        benchmark::DoNotOptimize(eval.Evaluate());
+    }
+    state.SetItemsProcessed(state.iterations() * long(kernel.CountFacets()));
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_MeshEvalSelfIntersection)->SYNTHETIC_MESH_ARGUMENTS;
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef BENCHMARKS_PART_SYNTHETICSHAPE_H
+#define BENCHMARKS_PART_SYNTHETICSHAPE_H
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepAlgoAPI_Cut.hxx>
+#include <BRepAlgoAPI_Fuse.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopTools_ListOfShape.hxx>
+#include <TopoDS.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Pnt.hxx>
+
+#include <App/StringHasher.h>
+#include <Mod/Part/App/TopoShape.h>
+#include <Mod/Part/App/TopoShapeOpCode.h>
+
+#include "src/App/InitApplication.h"
+
+namespace benchmarks
+{
+
+/*!
+ * \brief The SyntheticShape class
+ * The generated models of the Part benchmarks, each of them both as plain OCC shapes and as
+ * TopoShapes with element maps, so the cost of the topological naming can be told apart:
+ * \li A square plate with \a size holes on a grid, given as the plate and the cylinders to
+ * cut, and as the cut plate whose hole edges are filleted.
+ * \li A patterned body of \a size boxes in a row that touch each other, fused without
+ * refinement, so the side faces are split at every box and can be refined.
+ *
+ * The shapes are cached for the lifetime of the benchmark process.
+ */
+class SyntheticShape
+{
+public:
+    static SyntheticShape& get(int size)
+    {
+        static std::map<int, SyntheticShape> shapes;
+        auto it = shapes.find(size);
+        if (it == shapes.end()) {
+            it = shapes.emplace(size, SyntheticShape()).first;
+            it->second.create(size);
+        }
+        return it->second;
+    }
+
+    App::StringHasherRef hasher;
+
+    TopoDS_Shape plate;
+    TopTools_ListOfShape holes;
+    /// The plate and the holes with their own tags, the plate first
+    std::vector<Part::TopoShape> plateSources;
+    /// The cut plate, made with element maps
+    Part::TopoShape cut;
+    /// The circular edges of the cut plate, as indexes, plain edges and mapped edges
+    std::vector<int> circleEdges;
+    std::vector<TopoDS_Edge> circleEdgeShapes;
+    std::vector<Part::TopoShape> circleEdgeTopoShapes;
+
+    /// The fused boxes, made with element maps
+    Part::TopoShape boxes;
+
+private:
+    static constexpr double pitch = 10.0;
+
+    void create(int size)
+    {
+        tests::initApplication();
+        hasher = App::StringHasherRef(new App::StringHasher);
+        const int columns = std::max(static_cast<int>(std::lround(std::sqrt(size))), 1);
+        const int rows = (size + columns - 1) / columns;
+
+        plate = BRepPrimAPI_MakeBox(pitch * columns, pitch * rows, 2.0).Shape();
+        plateSources.emplace_back(plate, 1L, hasher);
+        for (int i = 0; i < size; ++i) {
+            gp_Pnt center(pitch * (i % columns + 0.5), pitch * (i / columns + 0.5), -1.0);
+            TopoDS_Shape hole =
+                BRepPrimAPI_MakeCylinder(gp_Ax2(center, gp::DZ()), 2.0, 4.0).Shape();
+            holes.Append(hole);
+            plateSources.emplace_back(hole, static_cast<long>(i + 2), hasher);
+        }
+        cut = Part::TopoShape(0, hasher).makeElementBoolean(Part::OpCodes::Cut, plateSources);
+
+        TopTools_IndexedMapOfShape edges;
+        TopExp::MapShapes(cut.getShape(), TopAbs_EDGE, edges);
+        for (int i = 1; i <= edges.Extent(); ++i) {
+            const TopoDS_Edge& edge = TopoDS::Edge(edges(i));
+            if (BRepAdaptor_Curve(edge).GetType() == GeomAbs_Circle) {
+                circleEdges.push_back(i);
+                circleEdgeShapes.push_back(edge);
+                circleEdgeTopoShapes.push_back(cut.getSubTopoShape(TopAbs_EDGE, i));
+            }
+        }
+
+        std::vector<Part::TopoShape> boxSources;
+        for (int i = 0; i < size; ++i) {
+            TopoDS_Shape box = BRepPrimAPI_MakeBox(gp_Pnt(pitch * i, 0.0, 0.0), pitch, pitch, pitch)
+                                   .Shape();
+            boxSources.emplace_back(box, static_cast<long>(i + 1), hasher);
+        }
+        boxes = Part::TopoShape(0, hasher).makeElementBoolean(Part::OpCodes::Fuse, boxSources);
+    }
+};
+
+/// Sets the peak resident set size of the process in MB, it only grows over all benchmarks
+inline void setPeakMemory(benchmark::State& state)
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters {};
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    double peak = double(counters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+#else
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    double peak = double(usage.ru_maxrss) / (1024.0 * 1024.0);
+#else
+    double peak = double(usage.ru_maxrss) / 1024.0;
+#endif
+#endif
+    state.counters["PeakRSS_MB"] = peak;
+}
+
+}  // namespace benchmarks
+
+/// The model sizes used by all benchmarks, with the plain OCC operation (maps:0) and the
+/// TopoShape operation that also builds the element maps (maps:1)
+#define SYNTHETIC_SHAPE_ARGUMENTS                                                                  \
+    ArgNames({"size", "maps"})                                                                     \
+        ->ArgsProduct({{16, 64, 256}, {0, 1}})                                                     \
+        ->Unit(benchmark::kMillisecond)
+
+#endif  // BENCHMARKS_PART_SYNTHETICSHAPE_H
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <sstream>
+
+#include <BRepFilletAPI_MakeFillet.hxx>
+
+#include <App/IndexedName.h>
+#include <App/MappedName.h>
+#include <Base/Reader.h>
+#include <Base/Writer.h>
+#include <Mod/Part/App/modelRefine.h>
+
+#include "SyntheticShape.h"
+
+using benchmarks::SyntheticShape;
+
+namespace
+{
+
+const SyntheticShape& shapeOf(const benchmark::State& state)
+{
+    return SyntheticShape::get(static_cast<int>(state.range(0)));
+}
+
+bool withMaps(const benchmark::State& state)
+{
+    return state.range(1) != 0;
+}
+
+void setElements(benchmark::State& state, const Part::TopoShape& shape)
+{
+    state.counters["Faces"] = static_cast<double>(shape.countSubShapes(TopAbs_FACE));
+    state.counters["Elements"] = static_cast<double>(shape.getElementMapSize());
+}
+
+}  // namespace
+
+// Cutting the holes out of the plate in one boolean operation
+static void BM_PartBooleanCut(benchmark::State& state)
+{
+    const auto& shape = shapeOf(state);
+    Part::TopoShape result;
+    for (auto _ : state) {
+        if (withMaps(state)) {
+            result = Part::TopoShape(0, shape.hasher)
+                         .makeElementBoolean(Part::OpCodes::Cut, shape.plateSources);
+        }
+        else {
+            BRepAlgoAPI_Cut cut;
+            TopTools_ListOfShape arguments;
+            arguments.Append(shape.plate);
+            cut.SetArguments(arguments);
+            cut.SetTools(shape.holes);
+            cut.Build();
+            result = Part::TopoShape(cut.Shape());
+        }
+    }
+    setElements(state, result);
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_PartBooleanCut)->SYNTHETIC_SHAPE_ARGUMENTS;
+
+// Filleting all circular edges of the cut plate
+static void BM_PartFillet(benchmark::State& state)
+{
+    const auto& shape = shapeOf(state);
+    Part::TopoShape result;
+    for (auto _ : state) {
+        if (withMaps(state)) {
+            result = Part::TopoShape(0, shape.hasher)
+                         .makeElementFillet(shape.cut, shape.circleEdgeTopoShapes, 0.5, 0.5);
+        }
+        else {
+            BRepFilletAPI_MakeFillet fillet(shape.cut.getShape());
+            for (const TopoDS_Edge& edge : shape.circleEdgeShapes) {
+                fillet.Add(0.5, edge);
+            }
+            fillet.Build();
+            result = Part::TopoShape(fillet.Shape());
+        }
+    }
+    setElements(state, result);
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_PartFillet)->SYNTHETIC_SHAPE_ARGUMENTS;
+
+// Merging the split faces of the fused boxes
+static void BM_PartRefine(benchmark::State& state)
+{
+    const auto& shape = shapeOf(state);
+    Part::TopoShape result;
+    for (auto _ : state) {
+        if (withMaps(state)) {
+            result = Part::TopoShape(0, shape.hasher).makeElementRefine(shape.boxes);
+        }
+        else {
+            Part::BRepBuilderAPI_RefineModel refine(shape.boxes.getShape());
+            result = Part::TopoShape(refine.Shape());
+        }
+    }
+    setElements(state, result);
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_PartRefine)->SYNTHETIC_SHAPE_ARGUMENTS;
+
+// Looking up every face of the cut plate, by index or by its mapped name as a link does
+static void BM_PartFaceLookup(benchmark::State& state)
+{
+    const auto& shape = shapeOf(state);
+    const Part::TopoShape plain(shape.cut.getShape());
+    const int faces = shape.cut.countSubShapes(TopAbs_FACE);
+    std::vector<Data::MappedName> names;
+    for (int i = 1; i <= faces; ++i) {
+        names.push_back(shape.cut.getMappedName(Data::IndexedName::fromConst("Face", i)));
+    }
+    for (auto _ : state) {
+        for (int i = 1; i <= faces; ++i) {
+            if (withMaps(state)) {
+                benchmark::DoNotOptimize(
+                    shape.cut.getSubShape(shape.cut.getIndexedName(names[i - 1]), true));
+            }
+            else {
+                benchmark::DoNotOptimize(plain.getSubShape(TopAbs_FACE, i, true));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * faces);
+    setElements(state, shape.cut);
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_PartFaceLookup)->SYNTHETIC_SHAPE_ARGUMENTS;
+
+// Writing and reading the cut plate as a document does, the binary BRep and the element map
+static void BM_PartShapePersistence(benchmark::State& state)
+{
+    const auto& shape = shapeOf(state);
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        std::stringstream brep;
+        shape.cut.exportBinary(brep);
+        Part::TopoShape restored(0, shape.hasher);
+        restored.importBinary(brep);
+        bytes = brep.str().size();
+
+        if (withMaps(state)) {
+            shape.cut.beforeSave();
+            Base::StringWriter writer;
+            shape.cut.SaveDocFile(writer);
+            std::stringstream map(writer.getString());
+            Base::Reader reader(map, "Shape.Map", 1);
+            restored.RestoreDocFile(reader);
+            bytes += writer.getString().size();
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    setElements(state, shape.cut);
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_PartShapePersistence)->SYNTHETIC_SHAPE_ARGUMENTS;
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "SyntheticSketch.h"
+
+using benchmarks::SyntheticSketch;
+
+namespace
+{
+
+const SyntheticSketch& sketchOf(const benchmark::State& state)
+{
+    return SyntheticSketch::get(static_cast<SyntheticSketch::Kind>(state.range(0)),
+                                static_cast<int>(state.range(1)));
+}
+
+void configure(Sketcher::Sketch& sketch, const benchmark::State& state)
+{
+    sketch.setDebugMode(GCS::NoDebug);
+    sketch.setQRAlgorithm(static_cast<GCS::QRAlgorithm>(state.range(2)));
+}
+
+}  // namespace
+
+// Setting up the solver system of a sketch including its diagnosis
+static void BM_SketchSetUp(benchmark::State& state)
+{
+    const auto& source = sketchOf(state);
+    Sketcher::Sketch sketch;
+    configure(sketch, state);
+    int dofs = 0;
+    for (auto _ : state) {
+        dofs = sketch.setUpSketch(source.geometries, source.constraints);
+    }
+    state.counters["DoFs"] = dofs;
+    benchmarks::setSketchCounters(state, sketch);
+}
+BENCHMARK(BM_SketchSetUp)->SYNTHETIC_SKETCH_ARGUMENTS;
+
+// The diagnosis alone, as it runs after each change of the constraints
+static void BM_SketchDiagnose(benchmark::State& state)
+{
+    const auto& source = sketchOf(state);
+    Sketcher::Sketch sketch;
+    configure(sketch, state);
+    int dofs = sketch.setUpSketch(source.geometries, source.constraints);
+    for (auto _ : state) {
+        dofs = sketch.resetSolver();
+    }
+    state.counters["DoFs"] = dofs;
+    benchmarks::setSketchCounters(state, sketch);
+}
+BENCHMARK(BM_SketchDiagnose)->SYNTHETIC_SKETCH_ARGUMENTS;
+
+// Solving the perturbed sketch, the set up is done again before each run
+static void BM_SketchSolve(benchmark::State& state)
+{
+    const auto& source = sketchOf(state);
+    Sketcher::Sketch sketch;
+    configure(sketch, state);
+    sketch.defaultSolver = static_cast<GCS::Algorithm>(state.range(3));
+    int result = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        sketch.setUpSketch(source.geometries, source.constraints);
+        state.ResumeTiming();
+        result = sketch.solve();
+    }
+    state.counters["Success"] = result == GCS::Success ? 1 : 0;
+    benchmarks::setSketchCounters(state, sketch);
+}
+BENCHMARK(BM_SketchSolve)->SYNTHETIC_SKETCH_SOLVER_ARGUMENTS;
@@ -0,0 +1,394 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef BENCHMARKS_SKETCHER_SYNTHETICSKETCH_H
+#define BENCHMARKS_SKETCHER_SYNTHETICSKETCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <numbers>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <Base/Interpreter.h>
+#include <Mod/Part/App/Geometry.h>
+#include <Mod/Sketcher/App/Constraint.h>
+#include <Mod/Sketcher/App/GeoEnum.h>
+#include <Mod/Sketcher/App/Sketch.h>
+
+#include "src/App/InitApplication.h"
+
+namespace benchmarks
+{
+
+/*!
+ * \brief The SyntheticSketch class
+ * Generated sketches of the kinds the solver meets in practice, all of them slightly off
+ * their constraints so that the solver has to move every element:
+ * \li Grid: a fully constrained grid of \a size x \a size cells of line segments, which is a
+ * single cluster with horizontal, vertical, distance and many coincident constraints.
+ * \li Profiles: \a size rounded rectangles that are only held together by coincident
+ * constraints, like the profiles of an imported DXF file, so there are many small clusters.
+ * \li Mechanism: a fully constrained chain of \a size links with joint circles, where every
+ * second joint angle is held by an angle constraint and the others by a brace.
+ *
+ * The sketches are cached for the lifetime of the benchmark process.
+ */
+class SyntheticSketch
+{
+public:
+    enum Kind
+    {
+        Grid,
+        Profiles,
+        Mechanism,
+    };
+
+    static const SyntheticSketch& get(Kind kind, int size)
+    {
+        static std::map<std::pair<Kind, int>, SyntheticSketch> sketches;
+        auto it = sketches.find({kind, size});
+        if (it == sketches.end()) {
+            it = sketches.emplace(std::make_pair(kind, size), SyntheticSketch()).first;
+            it->second.create(kind, size);
+        }
+        return it->second;
+    }
+
+    /// The lists as passed to Sketcher::Sketch::setUpSketch()
+    std::vector<Part::Geometry*> geometries;
+    std::vector<Sketcher::Constraint*> constraints;
+
+private:
+    using PointPos = Sketcher::PointPos;
+
+    void create(Kind kind, int size)
+    {
+        tests::initApplication();
+        Base::Interpreter().runString("import Sketcher");
+        switch (kind) {
+            case Grid:
+                createGrid(size);
+                break;
+            case Profiles:
+                createProfiles(size);
+                break;
+            case Mechanism:
+                createMechanism(size);
+                break;
+        }
+    }
+
+    // a deterministic offset of up to 0.2 from the constrained position
+    static Base::Vector3d noise(int& seed)
+    {
+        ++seed;
+        return {0.2 * std::sin(1.7 * seed), 0.2 * std::cos(2.3 * seed), 0.0};
+    }
+
+    int add(std::unique_ptr<Part::Geometry> geometry)
+    {
+        geometries.push_back(geometry.get());
+        ownedGeometries.push_back(std::move(geometry));
+        return int(geometries.size()) - 1;
+    }
+
+    int addLine(const Base::Vector3d& start, const Base::Vector3d& end)
+    {
+        auto line = std::make_unique<Part::GeomLineSegment>();
+        line->setPoints(start, end);
+        return add(std::move(line));
+    }
+
+    int addCircle(const Base::Vector3d& center, double radius)
+    {
+        auto circle = std::make_unique<Part::GeomCircle>();
+        circle->setCenter(center);
+        circle->setRadius(radius);
+        return add(std::move(circle));
+    }
+
+    int addArc(const Base::Vector3d& center, double radius, double first, double last)
+    {
+        auto arc = std::make_unique<Part::GeomArcOfCircle>();
+        arc->setCenter(center);
+        arc->setRadius(radius);
+        arc->setRange(first, last, true);
+        return add(std::move(arc));
+    }
+
+    void constrain(Sketcher::ConstraintType type,
+                   int first,
+                   PointPos firstPos,
+                   int second = Sketcher::GeoEnum::GeoUndef,
+                   PointPos secondPos = PointPos::none,
+                   double value = 0.0)
+    {
+        auto constraint = std::make_unique<Sketcher::Constraint>();
+        constraint->Type = type;
+        constraint->First = first;
+        constraint->FirstPos = firstPos;
+        constraint->Second = second;
+        constraint->SecondPos = secondPos;
+        constraint->setValue(value);
+        constraints.push_back(constraint.get());
+        ownedConstraints.push_back(std::move(constraint));
+    }
+
+    void createGrid(int size)
+    {
+        const double cell = 10.0;
+        int seed = 0;
+        auto node = [&](int i, int j) {
+            return Base::Vector3d(cell * i, cell * j, 0.0) + noise(seed);
+        };
+        // the line segments ending at each node, the first one is the reference of the others
+        std::vector<std::vector<std::pair<int, PointPos>>> nodes((size + 1) * (size + 1));
+        auto index = [size](int i, int j) {
+            return j * (size + 1) + i;
+        };
+        for (int j = 0; j <= size; j++) {
+            for (int i = 0; i < size; i++) {
+                int line = addLine(node(i, j), node(i + 1, j));
+                constrain(Sketcher::Horizontal, line, PointPos::none);
+                if (j == 0) {
+                    constrain(Sketcher::Distance,
+                              line,
+                              PointPos::none,
+                              Sketcher::GeoEnum::GeoUndef,
+                              PointPos::none,
+                              cell);
+                }
+                nodes[index(i, j)].emplace_back(line, PointPos::start);
+                nodes[index(i + 1, j)].emplace_back(line, PointPos::end);
+            }
+        }
+        for (int i = 0; i <= size; i++) {
+            for (int j = 0; j < size; j++) {
+                int line = addLine(node(i, j), node(i, j + 1));
+                constrain(Sketcher::Vertical, line, PointPos::none);
+                if (i == 0) {
+                    constrain(Sketcher::Distance,
+                              line,
+                              PointPos::none,
+                              Sketcher::GeoEnum::GeoUndef,
+                              PointPos::none,
+                              cell);
+                }
+                nodes[index(i, j)].emplace_back(line, PointPos::start);
+                nodes[index(i, j + 1)].emplace_back(line, PointPos::end);
+            }
+        }
+        for (const auto& ends : nodes) {
+            for (std::size_t k = 1; k < ends.size(); k++) {
+                constrain(Sketcher::Coincident,
+                          ends.front().first,
+                          ends.front().second,
+                          ends[k].first,
+                          ends[k].second);
+            }
+        }
+        const auto& origin = nodes.front().front();
+        constrain(Sketcher::DistanceX,
+                  origin.first,
+                  origin.second,
+                  Sketcher::GeoEnum::GeoUndef,
+                  PointPos::none,
+                  0.0);
+        constrain(Sketcher::DistanceY,
+                  origin.first,
+                  origin.second,
+                  Sketcher::GeoEnum::GeoUndef,
+                  PointPos::none,
+                  0.0);
+    }
+
+    void createProfiles(int size)
+    {
+        const double width = 20.0;
+        const double height = 10.0;
+        const double radius = 2.0;
+        const double pi = std::numbers::pi;
+        const int columns = std::max(int(std::sqrt(double(size))), 1);
+        int seed = 0;
+        for (int k = 0; k < size; k++) {
+            Base::Vector3d base(30.0 * (k % columns), 20.0 * (k / columns), 0.0);
+            auto at = [&](double x, double y) {
+                return base + Base::Vector3d(x, y, 0.0) + noise(seed);
+            };
+            int bottom = addLine(at(radius, 0.0), at(width - radius, 0.0));
+            int corner1 = addArc(at(width - radius, radius), radius, -pi / 2, 0.0);
+            int right = addLine(at(width, radius), at(width, height - radius));
+            int corner2 = addArc(at(width - radius, height - radius), radius, 0.0, pi / 2);
+            int top = addLine(at(width - radius, height), at(radius, height));
+            int corner3 = addArc(at(radius, height - radius), radius, pi / 2, pi);
+            int left = addLine(at(0.0, height - radius), at(0.0, radius));
+            int corner4 = addArc(at(radius, radius), radius, pi, 3 * pi / 2);
+            for (auto [first, second] : {std::pair {bottom, corner1},
+                                         std::pair {corner1, right},
+                                         std::pair {right, corner2},
+                                         std::pair {corner2, top},
+                                         std::pair {top, corner3},
+                                         std::pair {corner3, left},
+                                         std::pair {left, corner4},
+                                         std::pair {corner4, bottom}}) {
+                constrain(Sketcher::Coincident, first, PointPos::end, second, PointPos::start);
+            }
+        }
+    }
+
+    void createMechanism(int size)
+    {
+        int seed = 0;
+        std::vector<Base::Vector3d> joints {Base::Vector3d()};
+        std::vector<double> angles;
+        for (int k = 0; k < size; k++) {
+            double length = 10.0 + k % 3;
+            angles.push_back(0.5 * std::sin(0.7 * k));
+            joints.push_back(joints.back()
+                             + Base::Vector3d(std::cos(angles.back()), std::sin(angles.back()), 0.0)
+                                 * length);
+        }
+
+        std::vector<int> links;
+        for (int k = 0; k < size; k++) {
+            int link = addLine(joints[k] + noise(seed), joints[k + 1] + noise(seed));
+            constrain(Sketcher::Distance,
+                      link,
+                      PointPos::none,
+                      Sketcher::GeoEnum::GeoUndef,
+                      PointPos::none,
+                      (joints[k + 1] - joints[k]).Length());
+            if (k == 0) {
+                constrain(Sketcher::DistanceX,
+                          link,
+                          PointPos::start,
+                          Sketcher::GeoEnum::GeoUndef,
+                          PointPos::none,
+                          0.0);
+                constrain(Sketcher::DistanceY,
+                          link,
+                          PointPos::start,
+                          Sketcher::GeoEnum::GeoUndef,
+                          PointPos::none,
+                          0.0);
+                constrain(Sketcher::Angle,
+                          link,
+                          PointPos::none,
+                          Sketcher::GeoEnum::GeoUndef,
+                          PointPos::none,
+                          angles[0]);
+            }
+            else {
+                int previous = links.back();
+                constrain(Sketcher::Coincident, previous, PointPos::end, link, PointPos::start);
+                if (k % 2 == 0) {
+                    constrain(Sketcher::Angle,
+                              previous,
+                              PointPos::none,
+                              link,
+                              PointPos::none,
+                              angles[k] - angles[k - 1]);
+                }
+                else {
+                    int brace = addLine(joints[k - 1] + noise(seed), joints[k + 1] + noise(seed));
+                    constrain(Sketcher::Coincident,
+                              brace,
+                              PointPos::start,
+                              previous,
+                              PointPos::start);
+                    constrain(Sketcher::Coincident, brace, PointPos::end, link, PointPos::end);
+                    constrain(Sketcher::Distance,
+                              brace,
+                              PointPos::none,
+                              Sketcher::GeoEnum::GeoUndef,
+                              PointPos::none,
+                              (joints[k + 1] - joints[k - 1]).Length());
+                }
+
+                // the joint, all of the same size
+                int circle = addCircle(joints[k] + noise(seed), 1.0);
+                constrain(Sketcher::Coincident, circle, PointPos::mid, link, PointPos::start);
+                if (k == 1) {
+                    constrain(Sketcher::Radius,
+                              circle,
+                              PointPos::none,
+                              Sketcher::GeoEnum::GeoUndef,
+                              PointPos::none,
+                              1.0);
+                    firstJoint = circle;
+                }
+                else {
+                    constrain(Sketcher::Equal, firstJoint, PointPos::none, circle, PointPos::none);
+                }
+            }
+            links.push_back(link);
+        }
+    }
+
+    std::vector<std::unique_ptr<Part::Geometry>> ownedGeometries;
+    std::vector<std::unique_ptr<Sketcher::Constraint>> ownedConstraints;
+    int firstJoint = Sketcher::GeoEnum::GeoUndef;
+};
+
+// The sketch kinds and sizes, the dense QR decomposition is only used for the small sketches
+inline void addSketchArguments(benchmark::internal::Benchmark* bench, bool withSolvers)
+{
+    const std::map<SyntheticSketch::Kind, std::vector<int>> sizes {
+        {SyntheticSketch::Grid, {5, 20}},
+        {SyntheticSketch::Profiles, {50, 500}},
+        {SyntheticSketch::Mechanism, {20, 200}},
+    };
+    for (const auto& [kind, kindSizes] : sizes) {
+        for (std::size_t k = 0; k < kindSizes.size(); k++) {
+            for (int qr : {GCS::EigenDenseQR, GCS::EigenSparseQR}) {
+                if (qr == GCS::EigenDenseQR && k > 0) {
+                    continue;
+                }
+                if (!withSolvers) {
+                    bench->Args({kind, kindSizes[k], qr});
+                    continue;
+                }
+                for (int solver : {GCS::BFGS, GCS::LevenbergMarquardt, GCS::DogLeg}) {
+                    bench->Args({kind, kindSizes[k], qr, solver});
+                }
+            }
+        }
+    }
+}
+
+inline void sketchArguments(benchmark::internal::Benchmark* bench)
+{
+    bench->ArgNames({"sketch", "size", "qr"});
+    addSketchArguments(bench, false);
+}
+
+inline void sketchSolverArguments(benchmark::internal::Benchmark* bench)
+{
+    bench->ArgNames({"sketch", "size", "qr", "solver"});
+    addSketchArguments(bench, true);
+}
+
+/// The counters of the sizes of the sketch and of the work of its last solve
+inline void setSketchCounters(benchmark::State& state, const Sketcher::Sketch& sketch)
+{
+    const auto statistics = sketch.getSolveStatistics();
+    state.counters["DiagnosedRows"] = statistics.diagnosedRows;
+    state.counters["DiagnosedCols"] = statistics.diagnosedCols;
+    state.counters["Clusters"] = statistics.clusters;
+    state.counters["Constraints"] = statistics.constraints;
+    state.counters["Params"] = statistics.params;
+    state.counters["MaxClusterParams"] = statistics.maxParams;
+    state.counters["Iterations"] = statistics.iterations;
+}
+
+}  // namespace benchmarks
+
+#define SYNTHETIC_SKETCH_ARGUMENTS                                                                 \
+    Apply(benchmarks::sketchArguments)->Unit(benchmark::kMillisecond)
+#define SYNTHETIC_SKETCH_SOLVER_ARGUMENTS                                                          \
+    Apply(benchmarks::sketchSolverArguments)->Unit(benchmark::kMillisecond)
+
+#endif  // BENCHMARKS_SKETCHER_SYNTHETICSKETCH_H
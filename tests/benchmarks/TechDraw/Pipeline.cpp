@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <BRepBuilderAPI_Copy.hxx>
+
+#include <Base/Converter.h>
+
+#include <Mod/TechDraw/App/DrawProjectSplit.h>
+#include <Mod/TechDraw/App/EdgeWalker.h>
+#include <Mod/TechDraw/App/GeometryObject.h>
+#include <Mod/TechDraw/App/SVGPageWriter.h>
+#include <Mod/TechDraw/App/ShapeUtils.h>
+
+#include "SyntheticDrawing.h"
+
+using benchmarks::SyntheticDrawing;
+
+namespace
+{
+
+const SyntheticDrawing& drawingOf(const benchmark::State& state)
+{
+    return SyntheticDrawing::get(static_cast<int>(state.range(0)));
+}
+
+// The visible face edges of the top view after scrubbing, as the face finding uses them
+std::vector<TopoDS_Edge> scrubbedEdges(const SyntheticDrawing& drawing)
+{
+    std::vector<TopoDS_Edge> closedEdges;
+    return TechDraw::DrawProjectSplit::scrubEdges(
+        drawing.top->getGeometryObject()->getVisibleFaceEdges(false, false),
+        closedEdges);
+}
+
+}  // namespace
+
+// The hidden line removal of the isometric view, without the cache of the view
+static void BM_ProjectShape(benchmark::State& state)
+{
+    const auto& drawing = drawingOf(state);
+    auto view = drawing.iso;
+    TopoDS_Shape shape = BRepBuilderAPI_Copy(view->getSourceShape()).Shape();
+    gp_Pnt centroid = TechDraw::ShapeUtils::findCentroid(shape, view->getProjectionCS());
+    TopoDS_Shape centered = TechDraw::DrawViewPart::centerScaleRotate(
+        view, shape, Base::convertTo<Base::Vector3d>(centroid));
+    std::size_t edges = 0;
+    for (auto _ : state) {
+        TechDraw::GeometryObject geometry(view->getNameInDocument(), view);
+        geometry.projectShape(centered, view->getProjectionCS());
+        edges = geometry.getEdgeGeometry().size();
+    }
+    state.counters["Edges"] = static_cast<double>(edges);
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_ProjectShape)->SYNTHETIC_DRAWING_SIZES;
+
+// The first step of the face finding, splitting the projected edges at their intersections
+static void BM_ScrubEdges(benchmark::State& state)
+{
+    const auto& drawing = drawingOf(state);
+    std::size_t edges = 0;
+    for (auto _ : state) {
+        edges = scrubbedEdges(drawing).size();
+    }
+    state.counters["Edges"] = static_cast<double>(edges);
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_ScrubEdges)->SYNTHETIC_DRAWING_SIZES;
+
+// The second step of the face finding, walking the scrubbed edges to closed wires
+static void BM_EdgeWalker(benchmark::State& state)
+{
+    const auto& drawing = drawingOf(state);
+    const std::vector<TopoDS_Edge> edges = scrubbedEdges(drawing);
+    std::size_t wires = 0;
+    for (auto _ : state) {
+        TechDraw::EdgeWalker walker;
+        wires = walker.execute(edges, true).size();
+    }
+    state.counters["Wires"] = static_cast<double>(wires);
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_EdgeWalker)->SYNTHETIC_DRAWING_SIZES;
+
+// A recompute of the top view that has to project again, including the face finding
+static void BM_ViewRecompute(benchmark::State& state)
+{
+    const auto& drawing = drawingOf(state);
+    auto view = drawing.top;
+    bool rotated = false;
+    for (auto _ : state) {
+        rotated = !rotated;
+        view->Rotation.setValue(rotated ? 90.0 : 0.0);
+        view->recomputeFeature();
+    }
+    view->Rotation.setValue(0.0);
+    view->recomputeFeature();
+    state.counters["Faces"] = static_cast<double>(view->getFaceGeometry().size());
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_ViewRecompute)->SYNTHETIC_DRAWING_SIZES;
+
+// A recompute of the top view for a new scale, which reuses the projection
+static void BM_ViewRescale(benchmark::State& state)
+{
+    const auto& drawing = drawingOf(state);
+    auto view = drawing.top;
+    bool scaled = false;
+    for (auto _ : state) {
+        scaled = !scaled;
+        view->Scale.setValue(scaled ? 1.0 : 0.5);
+        view->recomputeFeature();
+    }
+    view->Scale.setValue(0.5);
+    view->recomputeFeature();
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_ViewRescale)->SYNTHETIC_DRAWING_SIZES;
+
+// A recompute of the section for a moved section plane, so the parts are cut again
+static void BM_SectionCut(benchmark::State& state)
+{
+    const auto& drawing = drawingOf(state);
+    auto section = drawing.section;
+    const Base::Vector3d origin = section->SectionOrigin.getValue();
+    bool moved = false;
+    for (auto _ : state) {
+        moved = !moved;
+        section->SectionOrigin.setValue(origin + Base::Vector3d(0.0, moved ? 1.0 : 0.0, 0.0));
+        section->recomputeFeature();
+    }
+    section->SectionOrigin.setValue(origin);
+    section->recomputeFeature();
+    state.counters["Faces"] = static_cast<double>(section->getFaceGeometry().size());
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_SectionCut)->SYNTHETIC_DRAWING_SIZES;
+
+// A recompute of the section for a new scale, which reuses the cut of the parts
+static void BM_SectionRescale(benchmark::State& state)
+{
+    const auto& drawing = drawingOf(state);
+    auto section = drawing.section;
+    bool scaled = false;
+    for (auto _ : state) {
+        scaled = !scaled;
+        section->Scale.setValue(scaled ? 1.0 : 0.5);
+        section->recomputeFeature();
+    }
+    section->Scale.setValue(0.5);
+    section->recomputeFeature();
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_SectionRescale)->SYNTHETIC_DRAWING_SIZES;
+
+// The pattern hatch of all cut faces of the section, trimmed to the faces
+static void BM_SectionHatch(benchmark::State& state)
+{
+    const auto& drawing = drawingOf(state);
+    std::size_t faces = 0;
+    for (auto _ : state) {
+        faces = drawing.section->getAllDrawableLines().size();
+    }
+    state.counters["Faces"] = static_cast<double>(faces);
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_SectionHatch)->SYNTHETIC_DRAWING_SIZES;
+
+// The geometric hatch of all faces of the top view, trimmed to the faces
+static void BM_GeomHatch(benchmark::State& state)
+{
+    const auto& drawing = drawingOf(state);
+    const std::vector<int> faces = drawing.topFaces();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(drawing.hatch->getTrimmedLines(faces));
+    }
+    state.counters["Faces"] = static_cast<double>(faces.size());
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_GeomHatch)->SYNTHETIC_DRAWING_SIZES;
+
+// The export of the whole page as SVG
+static void BM_PageExport(benchmark::State& state)
+{
+    const auto& drawing = drawingOf(state);
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        TechDraw::SVGPageWriter writer(drawing.page);
+        bytes = writer.svg().size();
+    }
+    state.counters["KB"] = static_cast<double>(bytes) / 1024.0;
+    benchmarks::setPeakMemory(state);
+}
+BENCHMARK(BM_PageExport)->SYNTHETIC_DRAWING_SIZES;
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef BENCHMARKS_TECHDRAW_SYNTHETICDRAWING_H
+#define BENCHMARKS_TECHDRAW_SYNTHETICDRAWING_H
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <BRepAlgoAPI_Cut.hxx>
+#include <BRepAlgoAPI_Fuse.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Pnt.hxx>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/Interpreter.h>
+#include <Mod/Part/App/PartFeature.h>
+#include <Mod/TechDraw/App/DrawGeomHatch.h>
+#include <Mod/TechDraw/App/DrawPage.h>
+#include <Mod/TechDraw/App/DrawViewPart.h>
+#include <Mod/TechDraw/App/DrawViewSection.h>
+
+#include "src/App/InitApplication.h"
+
+namespace benchmarks
+{
+
+/*!
+ * \brief The SyntheticDrawing class
+ * A drawing page of a generated assembly of \a size parts on a square grid. Each part is a
+ * plate with a boss and a hole through both, so the views have circles, hidden lines and
+ * faces with holes. The page has a top, a front and an isometric view of all parts, a
+ * section of the top view through the middle row of the grid with a pattern hatch of the cut
+ * faces, and a geometric hatch of all faces of the top view.
+ *
+ * The views are recomputed without Gui, so the projection and the face finding run in the
+ * calling thread. The drawings are cached for the lifetime of the benchmark process.
+ */
+class SyntheticDrawing
+{
+public:
+    static SyntheticDrawing& get(int size)
+    {
+        static std::map<int, SyntheticDrawing> drawings;
+        auto it = drawings.find(size);
+        if (it == drawings.end()) {
+            it = drawings.emplace(size, SyntheticDrawing()).first;
+            it->second.create(size);
+        }
+        return it->second;
+    }
+
+    App::Document* document {};
+    std::vector<Part::Feature*> parts;
+    TechDraw::DrawPage* page {};
+    TechDraw::DrawViewPart* top {};
+    TechDraw::DrawViewPart* front {};
+    TechDraw::DrawViewPart* iso {};
+    TechDraw::DrawViewSection* section {};
+    TechDraw::DrawGeomHatch* hatch {};
+
+    /// The indexes of all faces of the top view
+    std::vector<int> topFaces() const
+    {
+        std::vector<int> faces(top->getFaceGeometry().size());
+        for (std::size_t i = 0; i < faces.size(); ++i) {
+            faces[i] = static_cast<int>(i);
+        }
+        return faces;
+    }
+
+private:
+    static constexpr double pitch = 60.0;
+
+    static TopoDS_Shape makePart(double x, double y)
+    {
+        TopoDS_Shape plate = BRepPrimAPI_MakeBox(gp_Pnt(x, y, 0.0), 40.0, 30.0, 10.0).Shape();
+        TopoDS_Shape boss =
+            BRepPrimAPI_MakeCylinder(gp_Ax2(gp_Pnt(x + 20.0, y + 15.0, 10.0), gp::DZ()), 10.0, 8.0)
+                .Shape();
+        TopoDS_Shape hole =
+            BRepPrimAPI_MakeCylinder(gp_Ax2(gp_Pnt(x + 20.0, y + 15.0, -1.0), gp::DZ()), 5.0, 20.0)
+                .Shape();
+        TopoDS_Shape body = BRepAlgoAPI_Fuse(plate, boss).Shape();
+        return BRepAlgoAPI_Cut(body, hole).Shape();
+    }
+
+    static TechDraw::DrawViewPart* addView(TechDraw::DrawPage* page,
+                                           const char* type,
+                                           const std::vector<App::DocumentObject*>& sources,
+                                           const Base::Vector3d& direction)
+    {
+        auto view = static_cast<TechDraw::DrawViewPart*>(page->getDocument()->addObject(type));
+        page->addView(view);
+        view->ScaleType.setValue("Custom");
+        view->Scale.setValue(0.5);
+        view->Source.setValues(sources);
+        view->Direction.setValue(direction);
+        return view;
+    }
+
+    void create(int size)
+    {
+        tests::initApplication();
+        Base::Interpreter().runString("import TechDraw");
+        auto& app = App::GetApplication();
+        std::string name = app.getUniqueDocumentName("Benchmark");
+        document = app.newDocument(name.c_str(), name.c_str(), {.createView = false, .temporary = true});
+        document->setUndoMode(0);
+
+        const int columns = std::max(static_cast<int>(std::lround(std::sqrt(size))), 1);
+        std::vector<App::DocumentObject*> sources;
+        for (int i = 0; i < size; ++i) {
+            auto part = static_cast<Part::Feature*>(document->addObject("Part::Feature", "Part"));
+            part->Shape.setValue(makePart(pitch * (i % columns), pitch * (i / columns)));
+            parts.push_back(part);
+            sources.push_back(part);
+        }
+
+        page = static_cast<TechDraw::DrawPage*>(document->addObject("TechDraw::DrawPage", "Page"));
+        top = addView(page, "TechDraw::DrawViewPart", sources, Base::Vector3d(0.0, 0.0, 1.0));
+        front = addView(page, "TechDraw::DrawViewPart", sources, Base::Vector3d(0.0, -1.0, 0.0));
+        iso = addView(page, "TechDraw::DrawViewPart", sources, Base::Vector3d(1.0, -1.0, 1.0));
+
+        section = static_cast<TechDraw::DrawViewSection*>(
+            addView(page, "TechDraw::DrawViewSection", sources, Base::Vector3d(0.0, 1.0, 0.0)));
+        section->BaseView.setValue(top);
+        section->SectionNormal.setValue(Base::Vector3d(0.0, 1.0, 0.0));
+        const double middle = pitch * ((size - 1) / columns / 2) + 15.0;
+        section->SectionOrigin.setValue(Base::Vector3d(0.0, middle, 5.0));
+        section->CutSurfaceDisplay.setValue("PatHatch");
+        document->recompute();
+
+        hatch = static_cast<TechDraw::DrawGeomHatch*>(
+            document->addObject("TechDraw::DrawGeomHatch", "Hatch"));
+        std::vector<std::string> faceNames;
+        for (int face : topFaces()) {
+            faceNames.push_back("Face" + std::to_string(face));
+        }
+        hatch->Source.setValue(top, faceNames);
+        document->recompute();
+    }
+};
+
+/// Sets the peak resident set size of the process in MB, it only grows over all benchmarks
+inline void setPeakMemory(benchmark::State& state)
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters {};
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    double peak = double(counters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+#else
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    double peak = double(usage.ru_maxrss) / (1024.0 * 1024.0);
+#else
+    double peak = double(usage.ru_maxrss) / 1024.0;
+#endif
+#endif
+    state.counters["PeakRSS_MB"] = peak;
+}
+
+}  // namespace benchmarks
+
+/// The assembly sizes in parts used by all benchmarks, the wall time is measured since the
+/// stages run on several threads
+#define SYNTHETIC_DRAWING_SIZES                                                                    \
+    ArgName("parts")->Arg(4)->Arg(16)->Arg(64)->UseRealTime()->Unit(benchmark::kMillisecond)
+
+#endif  // BENCHMARKS_TECHDRAW_SYNTHETICDRAWING_H
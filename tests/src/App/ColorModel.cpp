@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "App/ColorModel.h"
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+namespace
+{
+
+// the colors of the table may differ by one step from the interpolated color
+void expectSameColors(const App::ColorGradient& gradient, const std::vector<float>& values)
+{
+    std::vector<uint32_t> colors(values.size());
+    gradient.getPackedColors(values.data(), values.size(), colors.data());
+    for (std::size_t i = 0; i < values.size(); i++) {
+        uint32_t expected = gradient.getColor(values[i]).getPackedValue();
+        for (int shift = 0; shift < 32; shift += 8) {
+            int channel = static_cast<int>((colors[i] >> shift) & 0xff);
+            int expectedChannel = static_cast<int>((expected >> shift) & 0xff);
+            EXPECT_LE(std::abs(channel - expectedChannel), 1) << "value " << values[i];
+        }
+    }
+}
+
+std::vector<float> makeValues(float fMin, float fMax)
+{
+    std::vector<float> values;
+    for (int i = -100; i <= 1100; i++) {
+        values.push_back(fMin + (fMax - fMin) * float(i) / 1000.0F);
+    }
+    return values;
+}
+
+}  // namespace
+
+TEST(ColorGradient, packedColorsFlow)
+{
+    App::ColorGradient gradient(-2.0F, 5.0F, 13, App::ColorBarStyle::FLOW);
+    expectSameColors(gradient, makeValues(-2.0F, 5.0F));
+}
+
+TEST(ColorGradient, packedColorsZeroBased)
+{
+    App::ColorGradient gradient(-2.0F, 5.0F, 13, App::ColorBarStyle::ZERO_BASED);
+    expectSameColors(gradient, makeValues(-2.0F, 5.0F));
+
+    gradient.setRange(1.0F, 5.0F);
+    expectSameColors(gradient, makeValues(1.0F, 5.0F));
+}
+
+TEST(ColorGradient, packedColorsOutside)
+{
+    App::ColorGradient gradient(0.0F, 1.0F, 13, App::ColorBarStyle::FLOW);
+    gradient.setOutsideGrayed(true);
+    gradient.setOutsideInvisible(true);
+    expectSameColors(gradient, makeValues(0.0F, 1.0F));
+}
+
+// NOLINTEND(readability-magic-numbers)
@@ -5,12 +5,17 @@
 
 #include "App/Application.h"
 #include "App/Document.h"
+#include "App/FeatureTest.h"
+#include "App/PropertyStandard.h"
 #include "App/StringHasher.h"
+#include "App/VarSet.h"
 #include "Base/Writer.h"
 #include <src/App/InitApplication.h>
 
 using ::testing::Eq;
+using ::testing::HasSubstr;
 using ::testing::Ne;
+using ::testing::Not;
 
 // NOLINTBEGIN(readability-magic-numbers)
 
@@ -94,4 +99,210 @@ TEST_F(DocumentTest, getStringHasherGivesExpectedHasher)
     EXPECT_EQ(hasher, foundHasher);
 }
 
+TEST_F(DocumentTest, recomputeProfileListsRecomputedObjects)
+{
+    // Arrange
+    doc()->addObject("App::FeatureTest", "Profiled");
+    doc()->setStatus(App::Document::ProfileRecompute, true);
+
+    // Act
+    doc()->recompute();
+    doc()->setStatus(App::Document::ProfileRecompute, false);
+    auto profile = doc()->getRecomputeProfile();
+
+    // Assert
+    EXPECT_THAT(profile, HasSubstr(R"("name": "Profiled")"));
+    EXPECT_THAT(profile, HasSubstr(R"("changedProperties": )"));
+}
+
+TEST_F(DocumentTest, recomputeProfileIsEmptyWithoutProfiling)
+{
+    // Arrange
+    doc()->addObject("App::FeatureTest", "NotProfiled");
+
+    // Act
+    doc()->recompute();
+    auto profile = doc()->getRecomputeProfile();
+
+    // Assert
+    EXPECT_THAT(profile, Not(HasSubstr("NotProfiled")));
+}
+
+TEST_F(DocumentTest, memoryReportListsObjectsAndProperties)
+{
+    // Arrange
+    auto varSet = doc()->addObject("App::VarSet", "Measured");
+    auto prop = freecad_cast<App::PropertyFloatList*>(
+        varSet->addDynamicProperty("App::PropertyFloatList", "Values", "Variables"));
+    prop->setValues(std::vector<double>(1000, 1.0));
+
+    // Act
+    auto report = doc()->getMemoryReport();
+
+    // Assert
+    EXPECT_THAT(report, HasSubstr(R"("name":"Measured")"));
+    EXPECT_THAT(report, HasSubstr(R"({"name":"Values","size":8000})"));
+    EXPECT_THAT(report, HasSubstr(R"("undo":)"));
+}
+
+TEST_F(DocumentTest, undoLimitDropsOldestTransactions)
+{
+    // Arrange
+    auto varSet = freecad_cast<App::VarSet*>(doc()->addObject("App::VarSet", "VarSet"));
+    auto prop = freecad_cast<App::PropertyFloatList*>(
+        varSet->addDynamicProperty("App::PropertyFloatList", "List", "Variables"));
+    prop->setValues(std::vector<double>(1000, 0.0));
+    doc()->setUndoMode(1);
+    doc()->setUndoLimit(10000);  // room for a single copy of the list
+
+    // Act
+    for (int i = 1; i <= 3; ++i) {
+        doc()->openTransaction("Change List");
+        prop->setValues(std::vector<double>(1000, i));
+        doc()->commitTransaction();
+    }
+
+    // Assert
+    EXPECT_EQ(doc()->getAvailableUndos(), 1);
+    EXPECT_LE(doc()->getUndoMemSize(), doc()->getUndoLimit());
+    EXPECT_TRUE(doc()->undo());
+    EXPECT_EQ(prop->getValues(), std::vector<double>(1000, 2.0));
+}
+
+TEST_F(DocumentTest, changeSignalBatchCoalescesChanges)
+{
+    // Arrange
+    auto varSet = freecad_cast<App::VarSet*>(doc()->addObject("App::VarSet", "VarSet"));
+    auto prop = freecad_cast<App::PropertyFloat*>(
+        varSet->addDynamicProperty("App::PropertyFloat", "Value", "Variables"));
+    int changed = 0;
+    std::vector<std::vector<const App::Property*>> batches;
+    boost::signals2::scoped_connection conn1 = doc()->signalChangedObject.connect(
+        [&](const App::DocumentObject&, const App::Property& p) {
+            if (&p == prop) {
+                ++changed;
+            }
+        });
+    boost::signals2::scoped_connection conn2 = doc()->signalBatchChangedObject.connect(
+        [&](const App::DocumentObject&, const std::vector<const App::Property*>& props) {
+            batches.push_back(props);
+        });
+
+    // Act
+    {
+        App::ChangeSignalBatch batch;
+        EXPECT_TRUE(App::ChangeSignalBatch::isActive());
+        for (int i = 1; i <= 10; ++i) {
+            prop->setValue(i);
+        }
+        EXPECT_EQ(changed, 0);
+    }
+
+    // Assert
+    EXPECT_FALSE(App::ChangeSignalBatch::isActive());
+    EXPECT_EQ(changed, 1);
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches[0], std::vector<const App::Property*> {prop});
+}
+
+TEST_F(DocumentTest, changeSignalBatchDropsDeletedObjects)
+{
+    // Arrange
+    auto varSet = freecad_cast<App::VarSet*>(doc()->addObject("App::VarSet", "VarSet"));
+    auto prop = freecad_cast<App::PropertyFloat*>(
+        varSet->addDynamicProperty("App::PropertyFloat", "Value", "Variables"));
+    int batches = 0;
+    boost::signals2::scoped_connection conn = doc()->signalBatchChangedObject.connect(
+        [&](const App::DocumentObject&, const std::vector<const App::Property*>&) {
+            ++batches;
+        });
+
+    // Act
+    {
+        App::ChangeSignalBatch batch;
+        prop->setValue(1.0);
+        doc()->removeObject(varSet->getNameInDocument());
+    }
+
+    // Assert
+    EXPECT_EQ(batches, 0);
+}
+
+TEST_F(DocumentTest, getObjectsByLabelFollowsRelabel)
+{
+    // Arrange
+    auto first = doc()->addObject("App::FeatureTest", "First");
+    doc()->addObject("App::FeatureTest", "Second");
+
+    // Act
+    first->Label.setValue("Renamed");
+
+    // Assert
+    EXPECT_EQ(doc()->getObjectsByLabel("Renamed"), std::vector<App::DocumentObject*> {first});
+    EXPECT_TRUE(doc()->getObjectsByLabel("First").empty());
+    EXPECT_EQ(doc()->getObjectsByLabel("Second").size(), 1);
+    doc()->removeObject(first->getNameInDocument());
+    EXPECT_TRUE(doc()->getObjectsByLabel("Renamed").empty());
+}
+
+TEST_F(DocumentTest, getObjectsOfTypeKeepsCreationOrder)
+{
+    // Arrange
+    auto feature1 = doc()->addObject("App::FeatureTest", "Feature");
+    auto varSet = doc()->addObject("App::VarSet", "VarSet");
+    auto feature2 = doc()->addObject("App::FeatureTest", "Feature");
+
+    // Act
+    auto features = doc()->getObjectsOfType(Base::Type::fromName("App::FeatureTest"));
+    auto all = doc()->getObjectsOfType(App::DocumentObject::getClassTypeId());
+
+    // Assert
+    EXPECT_EQ(features, (std::vector<App::DocumentObject*> {feature1, feature2}));
+    EXPECT_EQ(all, (std::vector<App::DocumentObject*> {feature1, varSet, feature2}));
+    EXPECT_EQ(doc()->countObjectsOfType("App::FeatureTest"), 2);
+    EXPECT_EQ(doc()->countObjectsOfType<App::VarSet>(), 1);
+}
+
+TEST_F(DocumentTest, addObjectsCreatesAllTypes)
+{
+    // Arrange
+    std::vector<std::string> types {"App::FeatureTest", "App::VarSet"};
+    std::vector<std::string> names {"Feature", "VarSet"};
+
+    // Act
+    auto objects = doc()->addObjects(types, names);
+
+    // Assert
+    ASSERT_EQ(objects.size(), 2);
+    EXPECT_TRUE(objects[0]->is<App::FeatureTest>());
+    EXPECT_TRUE(objects[1]->is<App::VarSet>());
+    EXPECT_EQ(doc()->getActiveObject(), objects[1]);
+    EXPECT_THROW(doc()->addObjects(types, {"Single"}), Base::ValueError);
+}
+
+TEST_F(DocumentTest, cancelRecomputeStopsBeforeNextObject)
+{
+    // Arrange
+    auto feature1 = doc()->addObject("App::FeatureTest", "Feature1");
+    auto feature2 = doc()->addObject("App::FeatureTest", "Feature2");
+    std::vector<std::size_t> progress;
+    boost::signals2::scoped_connection conn = doc()->signalRecomputeProgress.connect(
+        [&](const App::DocumentObject&, std::size_t done, std::size_t total) {
+            progress.push_back(done);
+            EXPECT_EQ(total, 2);
+            doc()->cancelRecompute();
+            EXPECT_TRUE(App::Document::isAnyRecomputeCanceled());
+        });
+
+    // Act
+    int count = doc()->recompute();
+
+    // Assert
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(progress, std::vector<std::size_t> {1});
+    EXPECT_NE(feature1->isTouched(), feature2->isTouched());
+    EXPECT_FALSE(doc()->isRecomputeCanceled());
+    EXPECT_FALSE(App::Document::isAnyRecomputeCanceled());
+}
+
 // NOLINTEND(readability-magic-numbers)
@@ -8,7 +8,10 @@
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObject.h>
+#include <App/GeoFeature.h>
 #include <App/GeoFeatureGroupExtension.h>
+#include <App/PropertyGeo.h>
+#include <App/PropertyLinks.h>
 #include <Base/Interpreter.h>
 
 using namespace App;
@@ -155,4 +158,104 @@ TEST_F(DocumentObjectTest, getSubObjectList)
     EXPECT_EQ(sizesFlatten[1], strlen(fuseName) + strlen(boxName) + 2);
 }
 
+TEST_F(DocumentObjectTest, inListKeepsLinksFromSeveralProperties)
+{
+    // Arrange
+    auto target = _doc->addObject("App::VarSet", "Target");
+    auto source = _doc->addObject("App::VarSet", "Source");
+    auto link1 = freecad_cast<App::PropertyLink*>(
+        source->addDynamicProperty("App::PropertyLink", "Link1"));
+    auto link2 = freecad_cast<App::PropertyLink*>(
+        source->addDynamicProperty("App::PropertyLink", "Link2"));
+
+    // Act
+    link1->setValue(target);
+    link2->setValue(target);
+    link1->setValue(nullptr);
+
+    // Assert
+    EXPECT_EQ(target->getInList(), std::vector<App::DocumentObject*> {source});
+    EXPECT_TRUE(target->isInInList(source));
+
+    // Act
+    link2->setValue(nullptr);
+
+    // Assert
+    EXPECT_TRUE(target->getInList().empty());
+    EXPECT_FALSE(target->isInInList(source));
+}
+
+TEST_F(DocumentObjectTest, cachedDependencyListFollowsLinkChanges)
+{
+    // Arrange
+    auto target = _doc->addObject("App::VarSet", "Target");
+    auto source = _doc->addObject("App::VarSet", "Source");
+    auto link = freecad_cast<App::PropertyLink*>(
+        source->addDynamicProperty("App::PropertyLink", "Link"));
+    auto before = _doc->getCachedDependencyList(App::Document::DepSort);
+
+    // Act
+    link->setValue(target);
+    auto after = _doc->getCachedDependencyList(App::Document::DepSort);
+
+    // Assert
+    EXPECT_EQ(before.size(), 2);
+    EXPECT_EQ(after, App::Document::getDependencyList(_doc->getObjects(), App::Document::DepSort));
+    EXPECT_EQ(after, _doc->getCachedDependencyList(App::Document::DepSort));
+}
+
+TEST_F(DocumentObjectTest, getSubObjectFollowsPlacementChanges)
+{
+    // Arrange
+    auto outer = _doc->addObject("App::Part", "Outer");
+    auto inner = _doc->addObject("App::Part", "Inner");
+    outer->getExtensionByType<App::GeoFeatureGroupExtension>()->addObject(inner);
+    auto placement = freecad_cast<App::PropertyPlacement*>(outer->getPropertyByName("Placement"));
+    placement->setValue(Base::Placement(Base::Vector3d(1, 0, 0), Base::Rotation()));
+    Base::Matrix4D first;
+    Base::Matrix4D second;
+    Base::Matrix4D moved;
+
+    // Act
+    auto resolved = outer->getSubObject("Inner.", nullptr, &first);
+    outer->getSubObject("Inner.", nullptr, &second);
+    placement->setValue(Base::Placement(Base::Vector3d(0, 2, 0), Base::Rotation()));
+    outer->getSubObject("Inner.", nullptr, &moved);
+
+    // Assert
+    EXPECT_EQ(resolved, inner);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first.getCol(3), Base::Vector3d(1, 0, 0));
+    EXPECT_EQ(moved.getCol(3), Base::Vector3d(0, 2, 0));
+    EXPECT_EQ(outer->getSubObject("Missing."), nullptr);
+}
+
+TEST_F(DocumentObjectTest, globalPlacementsFollowGroupChanges)
+{
+    // Arrange
+    auto outer = _doc->addObject("App::Part", "Outer");
+    auto inner = _doc->addObject("App::Part", "Inner");
+    auto leaf = _doc->addObject("App::Part", "Leaf");
+    outer->getExtensionByType<App::GeoFeatureGroupExtension>()->addObject(inner);
+    inner->getExtensionByType<App::GeoFeatureGroupExtension>()->addObject(leaf);
+    auto placement = freecad_cast<App::PropertyPlacement*>(outer->getPropertyByName("Placement"));
+    placement->setValue(Base::Placement(Base::Vector3d(1, 0, 0), Base::Rotation()));
+    freecad_cast<App::PropertyPlacement*>(inner->getPropertyByName("Placement"))
+        ->setValue(Base::Placement(Base::Vector3d(0, 1, 0), Base::Rotation()));
+
+    // Act
+    auto before = App::GeoFeature::getGlobalPlacements({inner, leaf});
+    placement->setValue(Base::Placement(Base::Vector3d(0, 0, 1), Base::Rotation()));
+    auto moved = App::GeoFeature::getGlobalPlacements({inner, leaf});
+    outer->getExtensionByType<App::GeoFeatureGroupExtension>()->removeObject(inner);
+    auto removed = App::GeoFeature::getGlobalPlacements({leaf});
+
+    // Assert
+    ASSERT_EQ(before.size(), 2);
+    EXPECT_EQ(before[0].getPosition(), Base::Vector3d(1, 1, 0));
+    EXPECT_EQ(before[1].getPosition(), Base::Vector3d(1, 1, 0));
+    EXPECT_EQ(moved[1].getPosition(), Base::Vector3d(0, 1, 1));
+    EXPECT_EQ(removed[0].getPosition(), Base::Vector3d(0, 1, 0));
+}
+
 // NOLINTEND(readability-magic-numbers, cppcoreguidelines-avoid-magic-numbers)
@@ -266,6 +266,25 @@ TEST_F(ElementMapTest, findMappedName)
     EXPECT_EQ(findResult2, element2);
 }
 
+TEST_F(ElementMapTest, findMappedNameWithDifferentPostfixSplit)
+{
+    // Arrange
+    // The same bytes stored as data only and looked up as data plus postfix must still match
+    Data::ElementMap elementMap;
+    Data::IndexedName element("Edge", 1);
+    Data::MappedName mappedName("TEST;POSTFIX");
+    elementMap.setElementName(element, mappedName, 0);
+    Data::MappedName splitName("TEST");
+    splitName += ";POSTFIX";
+
+    // Act
+    auto findResult = elementMap.find(splitName);
+
+    // Assert
+    EXPECT_EQ(splitName, mappedName);
+    EXPECT_EQ(findResult, element);
+}
+
 TEST_F(ElementMapTest, findIndexedName)
 {
     // Arrange
@@ -30,6 +30,7 @@
 #include "App/Expression.h"
 #include "App/ExpressionParser.h"
 #include "App/ExpressionTokenizer.h"
+#include "App/PropertyUnits.h"
 
 // +------------------------------------------------+
 // | Note: For more expression related tests, see:  |
@@ -412,4 +413,45 @@ TEST_F(Evaluate, test_simplify_refer_to_var)
     EXPECT_EQ(e->toString(), "sqrt(2 + Var)");
     EXPECT_EQ(simplified->toString(), "sqrt(2 + Var)");
 }
+
+TEST_F(Evaluate, test_program_same_as_evaluate)
+{
+    auto* var = freecad_cast<App::PropertyFloat*>(this_obj()->addDynamicProperty("App::PropertyFloat", "Var"));
+    var->setValue(2.5);
+    auto* count = freecad_cast<App::PropertyInteger*>(this_obj()->addDynamicProperty("App::PropertyInteger", "Count"));
+    count->setValue(3);
+    auto* length = freecad_cast<App::PropertyLength*>(this_obj()->addDynamicProperty("App::PropertyLength", "Len"));
+    length->setValue(10.0);
+
+    for (const char* text : {"1 + 2", "Count * 2 - 1", "Count / 2", "-Count + Var", "Len * 2 + 3 mm",
+                             "Len / Len", "-Len / (Count * 2)", "2 * pi"}) {
+        std::unique_ptr<App::Expression> e(App::ExpressionParser::parse(this_obj(), text));
+        App::ExpressionProgram program(e.get());
+        App::any value;
+        ASSERT_TRUE(program.eval(value)) << text;
+        EXPECT_TRUE(App::isAnyEqual(value, e->getValueAsAny())) << text;
+        EXPECT_EQ(value.type(), e->getValueAsAny().type()) << text;
+    }
+
+    // Not compiled, or evaluated by the generic code to report the error
+    for (const char* text : {"sqrt(Count)", "Count / 0", "Len + 1", "Placement.Base.x", "True + 1"}) {
+        std::unique_ptr<App::Expression> e(App::ExpressionParser::parse(this_obj(), text));
+        App::ExpressionProgram program(e.get());
+        App::any value;
+        EXPECT_FALSE(program.eval(value)) << text;
+    }
+}
+
+TEST_F(Evaluate, test_program_invalidated)
+{
+    auto* var = freecad_cast<App::PropertyFloat*>(this_obj()->addDynamicProperty("App::PropertyFloat", "Var"));
+    var->setValue(2.0);
+    std::unique_ptr<App::Expression> e(App::ExpressionParser::parse(this_obj(), "Var + 1"));
+    App::ExpressionProgram program(e.get());
+    EXPECT_TRUE(program.isUpToDate());
+
+    this_obj()->removeDynamicProperty("Var");
+
+    EXPECT_FALSE(program.isUpToDate());
+}
 // clang-format on
@@ -166,6 +166,48 @@ TEST_F(IndexedNameTest, nameAndTypeListConstructionReusedMemoryCheck)
     EXPECT_EQ(indexedName1.getType(), indexedName2.getType());
 }
 
+// The common element types share their storage without being in the allowedTypes list
+TEST_F(IndexedNameTest, commonTypeConstruction)
+{
+    // Act
+    auto face1 = Data::IndexedName("Face12");
+    auto face2 = Data::IndexedName(QByteArray("Face"));
+    auto vertex = Data::IndexedName("Vertex3", allowedTypes, true);
+
+    // Assert
+    EXPECT_STREQ(face1.getType(), "Face");
+    EXPECT_EQ(face1.getIndex(), 12);
+    EXPECT_EQ(face1.getType(), face2.getType());
+    EXPECT_EQ(face2.getIndex(), 0);
+    EXPECT_STREQ(vertex.getType(), "Vertex");
+    EXPECT_EQ(vertex.getIndex(), 3);
+}
+
+TEST_F(IndexedNameTest, commonTypeConstructionWithoutAllowOthers)
+{
+    // Act
+    auto indexedName = Data::IndexedName("Face12", allowedTypes, false);
+
+    // Assert
+    EXPECT_STREQ(indexedName.getType(), "");
+    EXPECT_EQ(indexedName.getIndex(), 12);
+}
+
+// Names of the same length or starting like a common type are not taken for one
+TEST_F(IndexedNameTest, commonTypeConstructionSimilarNames)
+{
+    // Act
+    auto faces = Data::IndexedName("Faces2");
+    auto fact = Data::IndexedName("Fact2");
+    auto edgy = Data::IndexedName("Edgy");
+
+    // Assert
+    EXPECT_STREQ(faces.getType(), "Faces");
+    EXPECT_EQ(faces.getIndex(), 2);
+    EXPECT_STREQ(fact.getType(), "Fact");
+    EXPECT_STREQ(edgy.getType(), "Edgy");
+}
+
 TEST_F(IndexedNameTest, byteArrayConstruction)
 {
     // Arrange
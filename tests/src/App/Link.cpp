@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <App/FeatureTest.h>
+#include <App/Link.h>
+#include <src/App/InitApplication.h>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+class LinkTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        _docName = App::GetApplication().getUniqueDocumentName("test");
+        _doc = App::GetApplication().newDocument(_docName.c_str(), "testUser");
+    }
+
+    void TearDown() override
+    {
+        App::LinkParams::removeMaxShownElements();
+        App::GetApplication().closeDocument(_docName.c_str());
+    }
+
+    App::Document* doc()
+    {
+        return _doc;
+    }
+
+private:
+    std::string _docName;
+    App::Document* _doc {};
+};
+
+TEST_F(LinkTest, smallArrayShowsElements)
+{
+    // Arrange
+    App::LinkParams::setMaxShownElements(10);
+    auto feature = doc()->addObject<App::FeatureTest>("Feature");
+    auto link = doc()->addObject<App::Link>("Link");
+    link->LinkedObject.setValue(feature);
+
+    // Act
+    link->ElementCount.setValue(5);
+
+    // Assert
+    EXPECT_TRUE(link->ShowElement.getValue());
+    EXPECT_EQ(link->ElementList.getSize(), 5);
+}
+
+TEST_F(LinkTest, largeArrayKeepsElementsInLists)
+{
+    // Arrange
+    App::LinkParams::setMaxShownElements(10);
+    auto feature = doc()->addObject<App::FeatureTest>("Feature");
+    auto link = doc()->addObject<App::Link>("Link");
+    link->LinkedObject.setValue(feature);
+    link->ElementCount.setValue(5);
+
+    // Act
+    link->ElementCount.setValue(20);
+
+    // Assert
+    EXPECT_FALSE(link->ShowElement.getValue());
+    EXPECT_EQ(link->ElementList.getSize(), 0);
+    EXPECT_EQ(doc()->getObjects().size(), 2);
+    EXPECT_NE(link->getSubObject("15."), nullptr);
+}
+
+// NOLINTEND(readability-magic-numbers)
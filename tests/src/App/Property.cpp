@@ -56,6 +56,60 @@ TEST(PropertyLink, TestSetValues)
     EXPECT_EQ(sub[1], "Sub2");
 }
 
+TEST(PropertyFloatList, getChangesRestoresChangedElements)
+{
+    App::PropertyFloatList prop;
+    std::vector<double> values(10, 1.0);
+    prop.setValues(values);
+    std::unique_ptr<App::Property> saved(prop.Copy());
+
+    prop.set1Value(3, 2.0);
+    prop.set1Value(-1, 3.0);
+    auto changes = prop.getChanges(*saved);
+    ASSERT_TRUE(changes);
+    changes->restore(prop);
+
+    EXPECT_EQ(prop.getValues(), values);
+}
+
+TEST(PropertyFloatList, getChangesOfMostElements)
+{
+    App::PropertyFloatList prop;
+    prop.setValues(std::vector<double>(10, 1.0));
+    std::unique_ptr<App::Property> saved(prop.Copy());
+
+    prop.setValues(std::vector<double>(10, 2.0));
+
+    EXPECT_FALSE(prop.getChanges(*saved));  // The full copy is smaller
+}
+
+TEST(PropertyFloatList, undoRedoChangedElements)
+{
+    tests::initApplication();
+    std::string docName = App::GetApplication().getUniqueDocumentName("test");
+    auto doc = App::GetApplication().newDocument(docName.c_str(), "testUser");
+    auto varSet = freecad_cast<App::VarSet*>(doc->addObject("App::VarSet", "VarSet"));
+    auto prop = freecad_cast<App::PropertyFloatList*>(
+        varSet->addDynamicProperty("App::PropertyFloatList", "List", "Variables"));
+    std::vector<double> values(100, 1.0);
+    prop->setValues(values);
+    doc->setUndoMode(1);
+
+    {
+        App::AutoTransaction transaction("Change List");
+        prop->set1Value(10, 2.0);
+        prop->set1Value(-1, 3.0);
+    }
+    std::vector<double> changed = prop->getValues();
+
+    EXPECT_TRUE(doc->undo());
+    EXPECT_EQ(prop->getValues(), values);
+    EXPECT_TRUE(doc->redo());
+    EXPECT_EQ(prop->getValues(), changed);
+
+    App::GetApplication().closeDocument(docName.c_str());
+}
+
 class PropertyFloatTest: public ::testing::Test
 {
 protected:
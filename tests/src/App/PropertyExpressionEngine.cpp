@@ -8,6 +8,7 @@
 #include "App/Expression.h"
 #include "App/ObjectIdentifier.h"
 #include "App/PropertyExpressionEngine.h"
+#include "App/PropertyStandard.h"
 
 #include "src/App/InitApplication.h"
 
@@ -90,4 +91,40 @@ TEST_F(PropertyExpressionEngineTest, executeCrossPropertyReference)
     ;
 }
 
+TEST_F(PropertyExpressionEngineTest, executeOnlyChangedBindings)
+{
+    auto obj = this_doc()->addObject("App::VarSet");
+    auto input = freecad_cast<App::PropertyInteger*>(obj->addDynamicProperty("App::PropertyInteger", "Input"));
+    auto other = freecad_cast<App::PropertyInteger*>(obj->addDynamicProperty("App::PropertyInteger", "Other"));
+    auto target1 = freecad_cast<App::PropertyInteger*>(obj->addDynamicProperty("App::PropertyInteger", "Target1"));
+    auto target2 = freecad_cast<App::PropertyInteger*>(obj->addDynamicProperty("App::PropertyInteger", "Target2"));
+    obj->setExpression(App::ObjectIdentifier(*target1),
+                       std::shared_ptr<App::Expression>(App::Expression::parse(obj, "Input + 1")));
+    obj->setExpression(App::ObjectIdentifier(*target2),
+                       std::shared_ptr<App::Expression>(App::Expression::parse(obj, "Other * 2")));
+    input->setValue(1);
+    other->setValue(2);
+    obj->ExpressionEngine.execute();
+    EXPECT_EQ(target1->getValue(), 2);
+    EXPECT_EQ(target2->getValue(), 4);
+
+    // A changed input re-evaluates its binding
+    input->setValue(5);
+    obj->ExpressionEngine.execute();
+    EXPECT_EQ(target1->getValue(), 6);
+    EXPECT_EQ(target2->getValue(), 4);
+
+    // A bound property set directly gets the value of the expression again
+    target2->setValue(0);
+    obj->ExpressionEngine.execute();
+    EXPECT_EQ(target1->getValue(), 6);
+    EXPECT_EQ(target2->getValue(), 4);
+
+    // A changed expression is evaluated
+    obj->setExpression(App::ObjectIdentifier(*target1),
+                       std::shared_ptr<App::Expression>(App::Expression::parse(obj, "Input + Other")));
+    obj->ExpressionEngine.execute();
+    EXPECT_EQ(target1->getValue(), 7);
+}
+
 // clang-format on
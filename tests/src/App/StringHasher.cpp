@@ -9,6 +9,7 @@
 
 #include <QCryptographicHash>
 #include <array>
+#include <thread>
 
 class StringIDTest: public ::testing::Test
 {
@@ -1202,6 +1203,48 @@ TEST_F(StringHasherTest, getIDFromQByteArrayShort)  // NOLINT
     EXPECT_EQ(2, id.getRefCount());
 }
 
+TEST_F(StringHasherTest, getIDsFromQByteArrays)  // NOLINT
+{
+    // Arrange
+    std::vector<QByteArray> data {"first", "second", "first"};
+
+    // Act
+    auto ids = Hasher()->getIDs(data, App::StringHasher::Option::None);
+
+    // Assert
+    ASSERT_EQ(3, ids.size());
+    EXPECT_EQ(ids[0], ids[2]);
+    EXPECT_NE(ids[0], ids[1]);
+    EXPECT_EQ(2, Hasher()->size());
+}
+
+TEST_F(StringHasherTest, getIDFromMultipleThreads)  // NOLINT
+{
+    // Arrange
+    const int threadCount {4};
+    const int stringCount {500};
+    std::vector<std::vector<App::StringIDRef>> results(threadCount);
+
+    // Act
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([this, &results, t]() {
+            for (int i = 0; i < stringCount; ++i) {
+                results[t].push_back(Hasher()->getID(QByteArray::number(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Assert
+    EXPECT_EQ(stringCount, Hasher()->size());
+    for (int t = 1; t < threadCount; ++t) {
+        EXPECT_EQ(results[0], results[t]);
+    }
+}
+
 TEST_F(StringHasherTest, getIDFromQByteArrayLongHashable)  // NOLINT
 {
     // Arrange
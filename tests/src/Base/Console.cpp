@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Base/Console.h>
+
+namespace
+{
+
+class CollectingLogger: public Base::ILogger
+{
+public:
+    void sendLog(const std::string& notifiername,
+                 const std::string& msg,
+                 Base::LogStyle level,
+                 Base::IntendedRecipient recipient,
+                 Base::ContentType content) override
+    {
+        (void)notifiername;
+        (void)recipient;
+        (void)content;
+        if (level == Base::LogStyle::Message) {
+            messages.push_back(msg);
+        }
+    }
+
+    std::vector<std::string> messages;
+};
+
+class ConsoleAsyncTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Base::Console().attachObserver(&logger);
+        Base::Console().setConnectionMode(Base::ConsoleSingleton::Async);
+    }
+
+    void TearDown() override
+    {
+        Base::Console().setConnectionMode(Base::ConsoleSingleton::Direct);
+        Base::Console().detachObserver(&logger);
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-non-private-member-variables-in-classes)
+    CollectingLogger logger;
+};
+
+}  // namespace
+
+TEST_F(ConsoleAsyncTest, keepsOrderPerThread)
+{
+    // Arrange
+    constexpr int count = 1000;
+    auto sender = [](const char* prefix) {
+        for (int i = 0; i < count; ++i) {
+            Base::Console().message("%s%d\n", prefix, i);
+        }
+    };
+
+    // Act
+    std::thread first(sender, "a");
+    std::thread second(sender, "b");
+    first.join();
+    second.join();
+    Base::Console().flush();
+
+    // Assert
+    int nextA = 0;
+    int nextB = 0;
+    for (const auto& msg : logger.messages) {
+        int& next = msg[0] == 'a' ? nextA : nextB;
+        EXPECT_EQ(msg.substr(1), std::to_string(next) + "\n");
+        ++next;
+    }
+    EXPECT_EQ(nextA, count);
+    EXPECT_EQ(nextB, count);
+}
+
+TEST_F(ConsoleAsyncTest, coalescesRepeatedMessages)
+{
+    // Act
+    for (int i = 0; i < 5; ++i) {
+        Base::Console().message("same\n");
+    }
+    Base::Console().flush();
+
+    // Assert
+    ASSERT_FALSE(logger.messages.empty());
+    EXPECT_EQ(logger.messages.front(), "same\n");
+    std::size_t same = 0;
+    std::size_t repeated = 0;
+    for (const auto& msg : logger.messages) {
+        if (msg == "same\n") {
+            ++same;
+        }
+        else {
+            EXPECT_EQ(msg.rfind("(last message repeated ", 0), 0);
+            repeated += std::stoul(msg.substr(23));
+        }
+    }
+    EXPECT_EQ(same + repeated, 5);
+}
@@ -573,5 +573,28 @@ TEST(Matrix, TestToAndFromString)
 
     EXPECT_EQ(mat, inp);
 }
+
+TEST(Matrix, TestMultVecArray)
+{
+    Base::Matrix4D mat{1.0, 2.0, 3.0, 4.0,
+                       0.0, 1.0, 0.0, 5.0,
+                       0.0, 0.0, 2.0, 6.0,
+                       0.0, 0.0, 0.0, 1.0};
+
+    std::vector<Base::Vector3d> pnts{{1, 2, 3}, {-1, 0, 2}, {0.5, 0.25, -4}};
+    std::vector<Base::Vector3d> out(pnts.size());
+    mat.multVec(pnts.data(), out.data(), pnts.size());
+    for (std::size_t i = 0; i < pnts.size(); i++) {
+        EXPECT_EQ(out[i], mat * pnts[i]);
+    }
+
+    std::vector<Base::Vector3f> pntsf{{1, 2, 3}, {-1, 0, 2}, {0.5F, 0.25F, -4}};
+    std::vector<Base::Vector3f> expected;
+    for (const auto& pnt : pntsf) {
+        expected.push_back(mat * pnt);
+    }
+    mat.multVec(pntsf.data(), pntsf.data(), pntsf.size());
+    EXPECT_EQ(pntsf, expected);
+}
 // clang-format on
 // NOLINTEND(cppcoreguidelines-*,readability-magic-numbers)
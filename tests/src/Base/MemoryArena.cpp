@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+
+#include <Base/MemoryArena.h>
+
+TEST(MemoryArena, containersUseTheArena)
+{
+    // Arrange
+    Base::MemoryArena<256> arena;
+    std::pmr::set<int> values(arena.resource());
+    std::pmr::map<int, int> degrees(arena.resource());
+
+    // Act
+    for (int i = 0; i < 1000; ++i) {
+        values.insert(i % 100);
+        ++degrees[i % 10];
+    }
+
+    // Assert
+    EXPECT_EQ(values.size(), 100);
+    EXPECT_EQ(degrees.size(), 10);
+    EXPECT_EQ(degrees[3], 100);
+    EXPECT_EQ(values.get_allocator().resource(), arena.resource());
+}
+
+TEST(MemoryArena, releaseKeepsTheArenaUsable)
+{
+    // Arrange
+    Base::MemoryArena<> arena;
+    {
+        std::pmr::set<int> values({1, 2, 3}, arena.resource());
+    }
+
+    // Act
+    arena.release();
+    std::pmr::set<int> values({4, 5}, arena.resource());
+
+    // Assert
+    EXPECT_EQ(values.size(), 2);
+    EXPECT_EQ(*values.begin(), 4);
+}
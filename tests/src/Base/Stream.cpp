@@ -125,3 +125,28 @@ TEST_F(TextStreamIntegrationTest, OutputThenInputMultiLineWithCarriageReturns)
     // Assert
     EXPECT_EQ(multiLineStringResult, result);
 }
+
+TEST(BinaryStreamTest, writeStringThenReadString)
+{
+    // Arrange
+    std::string first("First");
+    std::string empty;
+    std::string withNull("a\0b", 3);
+
+    // Act
+    std::ostringstream ssO;
+    Base::OutputStream os(ssO);
+    os.writeString(first).writeString(empty).writeString(withNull);
+    std::istringstream ssI(ssO.str());
+    Base::InputStream is(ssI);
+    std::string result1;
+    std::string result2 {"not empty"};
+    std::string result3;
+    is.readString(result1).readString(result2).readString(result3);
+
+    // Assert
+    EXPECT_EQ(first, result1);
+    EXPECT_EQ(empty, result2);
+    EXPECT_EQ(withNull, result3);
+    EXPECT_TRUE(static_cast<bool>(is));
+}
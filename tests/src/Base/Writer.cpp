@@ -2,7 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <iterator>
+#include <sstream>
+#include <zipios++/zipinputstream.h>
+
 #include "Base/Exception.h"
+#include "Base/Persistence.h"
 #include "Base/Writer.h"
 
 // Writer is designed to be a base class, so for testing we actually instantiate a StringWriter,
@@ -129,3 +134,76 @@ TEST_F(WriterTest, charStreamBase64Encoded)
     // Conversion done using https://www.base64encode.org for testing purposes
     EXPECT_EQ(std::string("RnJlZUNBRCByb2NrcyEg8J+qqPCfqqjwn6qo\n"), _writer.getString());
 }
+
+namespace
+{
+
+// Writes its content to an additional file of the writer
+class DocFile: public Base::Persistence
+{
+public:
+    explicit DocFile(std::string content)
+        : content(std::move(content))
+    {}
+    unsigned int getMemSize() const override
+    {
+        return static_cast<unsigned int>(content.size());
+    }
+    void Save(Base::Writer& /*writer*/) const override
+    {}
+    void Restore(Base::XMLReader& /*reader*/) override
+    {}
+    void SaveDocFile(Base::Writer& writer) const override
+    {
+        writer.Stream() << content;
+    }
+
+private:
+    std::string content;
+};
+
+std::vector<std::string> writeZip(int level, unsigned int threads, const std::vector<DocFile>& files)
+{
+    std::stringstream str;
+    {
+        Base::ZipWriter writer(str);
+        writer.setLevel(level);
+        writer.setThreads(threads);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        for (const auto& file : files) {
+            writer.addFile("File", &file);
+        }
+        writer.writeFiles();
+    }
+
+    std::vector<std::string> entries;
+    zipios::ZipInputStream zip(str);
+    for (std::size_t i = 0; i <= files.size(); ++i) {
+        zipios::ConstEntryPointer entry = zip.getNextEntry();
+        std::string data((std::istreambuf_iterator<char>(zip)), std::istreambuf_iterator<char>());
+        entries.push_back(entry->getName() + ":" + data);
+    }
+    return entries;
+}
+
+}  // namespace
+
+TEST(ZipWriterTest, writeFilesConcurrentlyKeepsOrder)
+{
+    // Arrange
+    std::vector<DocFile> files;
+    for (int i = 0; i < 20; ++i) {
+        files.emplace_back(std::string(1000 * i, static_cast<char>('a' + i)));
+    }
+
+    // Act
+    auto serial = writeZip(6, 1, files);
+    auto deflated = writeZip(6, 4, files);
+    auto stored = writeZip(0, 4, files);
+
+    // Assert
+    EXPECT_EQ(serial.size(), files.size() + 1);
+    EXPECT_EQ(serial, deflated);
+    EXPECT_EQ(serial, stored);
+}
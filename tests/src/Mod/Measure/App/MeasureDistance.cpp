@@ -3,6 +3,7 @@
 #include <Mod/Measure/App/MeasureDistance.h>
 #include <Mod/Part/App/PartFeature.h>
 #include <gtest/gtest.h>
+#include <cmath>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <gp_Circ.hxx>
 #include <TopoDS_Edge.hxx>
@@ -66,4 +67,35 @@ TEST_F(MeasureDistance, testCircleCircle)
     EXPECT_EQ(md->Position1.getValue(), Base::Vector3d(0.0, 0.0, 0.0));
     EXPECT_EQ(md->Position2.getValue(), Base::Vector3d(3.0, 4.0, 0.0));
 }
+
+TEST_F(MeasureDistance, testChangedElements)
+{
+    App::Document* doc = getDocument();
+    auto p1 = doc->addObject<Part::Feature>("Shape1");
+    p1->Shape.setValue(makeCircle(gp_Pnt(0.0, 0.0, 0.0)));
+    auto p2 = doc->addObject<Part::Feature>("Shape2");
+    p2->Shape.setValue(makeCircle(gp_Pnt(3.0, 4.0, 0.0)));
+
+    auto md = doc->addObject<Measure::MeasureDistance>("Distance");
+    md->Element1.setValue(p1, {"Edge1"});
+    md->Element2.setValue(p2, {"Edge1"});
+    auto other = doc->addObject<Measure::MeasureDistance>("OtherDistance");
+    other->Element1.setValue(p2, {"Edge1"});
+    other->Element2.setValue(p1, {"Edge1"});
+    doc->recompute();
+    EXPECT_DOUBLE_EQ(md->Distance.getValue(), 5.0);
+    EXPECT_DOUBLE_EQ(other->Distance.getValue(), 5.0);
+
+    // the measurements must follow a moved and a replaced element
+    p2->Placement.setValue(Base::Placement(Base::Vector3d(3.0, 0.0, 0.0), Base::Rotation()));
+    doc->recompute();
+    EXPECT_DOUBLE_EQ(md->Distance.getValue(), std::sqrt(52.0));
+    EXPECT_DOUBLE_EQ(other->Distance.getValue(), std::sqrt(52.0));
+
+    p1->Shape.setValue(makeCircle(gp_Pnt(0.0, 4.0, 0.0)));
+    doc->recompute();
+    EXPECT_DOUBLE_EQ(md->Distance.getValue(), 6.0);
+    EXPECT_DOUBLE_EQ(other->Distance.getValue(), 6.0);
+    EXPECT_EQ(md->Position1.getValue(), Base::Vector3d(0.0, 4.0, 0.0));
+}
 // NOLINTEND
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Adjacency.h>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class AdjacencyTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a planar grid, big enough to build the adjacency on several threads
+        const unsigned long size = 150;
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (unsigned long i = 0; i <= size; i++) {
+            for (unsigned long j = 0; j <= size; j++) {
+                points.push_back(MeshCore::MeshPoint(float(i), float(j), 0.F));
+            }
+        }
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                unsigned long p0 = i * (size + 1) + j;
+                unsigned long p1 = p0 + size + 1;
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    template<class Range, class Set>
+    static bool isEqual(const Range& range, const Set& set)
+    {
+        return range.size() == set.size() && std::equal(range.begin(), range.end(), set.begin());
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(AdjacencyTest, TestEmpty)
+{
+    MeshCore::MeshKernel empty;
+    MeshCore::MeshCompactPointToFacets pf(empty);
+    MeshCore::MeshCompactPointToPoints pp(empty);
+    MeshCore::MeshCompactFacetToFacets ff(empty);
+    EXPECT_EQ(pf.size(), 0);
+    EXPECT_EQ(pp.size(), 0);
+    EXPECT_EQ(ff.size(), 0);
+}
+
+TEST_F(AdjacencyTest, TestPointToFacets)
+{
+    MeshCore::MeshRefPointToFacets ref(kernel);
+    MeshCore::MeshCompactPointToFacets adj(kernel);
+    ASSERT_EQ(adj.size(), kernel.CountPoints());
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        EXPECT_TRUE(isEqual(adj[i], ref[i]));
+        EXPECT_TRUE(isEqual(adj.NeighbourPoints(i), ref.NeighbourPoints(i)));
+    }
+
+    const MeshCore::MeshFacet& face = kernel.GetFacets()[100];
+    EXPECT_EQ(adj.GetIndices(face._aulPoints[0], face._aulPoints[1]),
+              ref.GetIndices(face._aulPoints[0], face._aulPoints[1]));
+    std::vector<MeshCore::FacetIndex> self {100};
+    EXPECT_EQ(adj.GetIndices(face._aulPoints[0], face._aulPoints[1], face._aulPoints[2]), self);
+}
+
+TEST_F(AdjacencyTest, TestFacetToFacets)
+{
+    MeshCore::MeshRefFacetToFacets ref(kernel);
+    MeshCore::MeshCompactFacetToFacets adj(kernel);
+    ASSERT_EQ(adj.size(), kernel.CountFacets());
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        EXPECT_TRUE(isEqual(adj[i], ref[i]));
+        EXPECT_EQ(adj[i].count(i), 1);
+    }
+}
+
+TEST_F(AdjacencyTest, TestPointToPoints)
+{
+    MeshCore::MeshRefPointToPoints ref(kernel);
+    MeshCore::MeshCompactPointToPoints adj(kernel);
+    ASSERT_EQ(adj.size(), kernel.CountPoints());
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        EXPECT_TRUE(isEqual(adj[i], ref[i]));
+        EXPECT_EQ(adj[i].find(i), adj[i].end());
+    }
+    EXPECT_FLOAT_EQ(adj.GetAverageEdgeLength(0), ref.GetAverageEdgeLength(0));
+}
+
+TEST_F(AdjacencyTest, TestNeighbours)
+{
+    MeshCore::MeshRefPointToFacets ref(kernel);
+    MeshCore::MeshCompactPointToFacets adj(kernel);
+
+    std::vector<MeshCore::FacetIndex> refFacets;
+    std::vector<MeshCore::FacetIndex> adjFacets;
+    MeshCore::FacetCollector refCollect(refFacets);
+    MeshCore::FacetCollector adjCollect(adjFacets);
+    ref.Neighbours(20000, 5.0F, refCollect);
+    adj.Neighbours(20000, 5.0F, adjCollect);
+    std::sort(refFacets.begin(), refFacets.end());
+    std::sort(adjFacets.begin(), adjFacets.end());
+    EXPECT_FALSE(adjFacets.empty());
+    EXPECT_EQ(adjFacets, refFacets);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
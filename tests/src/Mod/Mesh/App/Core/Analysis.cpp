@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Analysis.h>
+#include <Mod/Mesh/App/Core/Degeneration.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class AnalysisTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a planar grid of 50 x 50 squares
+        const unsigned long size = 50;
+        for (unsigned long i = 0; i <= size; i++) {
+            for (unsigned long j = 0; j <= size; j++) {
+                points.push_back(MeshCore::MeshPoint(float(i), float(j), 0.F));
+            }
+        }
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                unsigned long p0 = i * (size + 1) + j;
+                unsigned long p1 = p0 + size + 1;
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+    }
+
+    static std::vector<MeshCore::ElementIndex>
+    toIndices(const std::vector<MeshCore::FacetIndex>& indices)
+    {
+        std::vector<MeshCore::ElementIndex> result(indices.begin(), indices.end());
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(AnalysisTest, TestValidMesh)
+{
+    kernel.Adopt(points, facets, true);
+    MeshCore::MeshAnalysis eval(kernel);
+    EXPECT_TRUE(eval.Evaluate());
+}
+
+TEST_F(AnalysisTest, TestRangePoint)
+{
+    facets[7]._aulPoints[1] = points.size() + 3;
+    kernel.Adopt(points, facets, false);
+
+    MeshCore::MeshAnalysis eval(kernel);
+    EXPECT_FALSE(eval.Evaluate());
+    EXPECT_EQ(eval.GetIndices(MeshCore::MeshAnalysis::RangePoint),
+              std::vector<MeshCore::ElementIndex> {7});
+    EXPECT_FALSE(eval.HasDefects(MeshCore::MeshAnalysis::InvalidNeighbourhood));
+}
+
+TEST_F(AnalysisTest, TestOrientation)
+{
+    std::swap(facets[100]._aulPoints[0], facets[100]._aulPoints[1]);
+    kernel.Adopt(points, facets, true);
+
+    MeshCore::MeshAnalysis eval(kernel);
+    EXPECT_FALSE(eval.Evaluate());
+
+    MeshCore::MeshEvalOrientation ref(kernel);
+    EXPECT_EQ(eval.GetIndices(MeshCore::MeshAnalysis::Orientation), toIndices(ref.GetIndices()));
+    EXPECT_EQ(eval.GetIndices(MeshCore::MeshAnalysis::Orientation),
+              std::vector<MeshCore::ElementIndex> {100});
+    EXPECT_FALSE(eval.HasDefects(MeshCore::MeshAnalysis::InvalidNeighbourhood));
+    EXPECT_FALSE(eval.HasDefects(MeshCore::MeshAnalysis::NonManifoldEdges));
+}
+
+TEST_F(AnalysisTest, TestDuplicates)
+{
+    // a duplicated point that is not used and a duplicated facet with a different start point
+    points.push_back(points[20]);
+    MeshCore::MeshFacet copy = facets[30];
+    facets.push_back(MeshCore::MeshFacet(copy._aulPoints[1], copy._aulPoints[2], copy._aulPoints[0]));
+    kernel.Adopt(points, facets, true);
+
+    MeshCore::MeshAnalysis eval(kernel);
+    EXPECT_FALSE(eval.Evaluate());
+
+    // the element with the lowest index is kept
+    MeshCore::MeshEvalDuplicatePoints refPoints(kernel);
+    MeshCore::MeshEvalDuplicateFacets refFacets(kernel);
+    EXPECT_EQ(eval.GetIndices(MeshCore::MeshAnalysis::DuplicatedPoints),
+              std::vector<MeshCore::ElementIndex> {kernel.CountPoints() - 1});
+    EXPECT_EQ(eval.GetIndices(MeshCore::MeshAnalysis::DuplicatedFacets),
+              std::vector<MeshCore::ElementIndex> {kernel.CountFacets() - 1});
+    EXPECT_EQ(refPoints.GetIndices().size(), 1);
+    EXPECT_EQ(refFacets.GetIndices().size(), 1);
+    EXPECT_TRUE(eval.HasDefects(MeshCore::MeshAnalysis::NonManifoldEdges));
+}
+
+TEST_F(AnalysisTest, TestSelfIntersection)
+{
+    // a vertical triangle piercing the grid
+    MeshCore::PointIndex index = points.size();
+    points.push_back(MeshCore::MeshPoint(10.2F, 10.3F, -1.F));
+    points.push_back(MeshCore::MeshPoint(10.8F, 10.3F, -1.F));
+    points.push_back(MeshCore::MeshPoint(10.5F, 10.3F, 1.F));
+    facets.push_back(MeshCore::MeshFacet(index, index + 1, index + 2));
+    kernel.Adopt(points, facets, true);
+
+    MeshCore::MeshAnalysis eval(kernel, MeshCore::MeshAnalysis::SelfIntersections);
+    EXPECT_FALSE(eval.Evaluate());
+
+    std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>> ref;
+    MeshCore::MeshEvalSelfIntersection refEval(kernel);
+    refEval.GetIntersections(ref);
+    std::sort(ref.begin(), ref.end());
+    ref.erase(std::unique(ref.begin(), ref.end()), ref.end());
+    EXPECT_FALSE(ref.empty());
+    EXPECT_EQ(eval.GetSelfIntersections(), ref);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
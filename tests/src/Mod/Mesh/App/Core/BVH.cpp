@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class BVHTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a wavy grid with very different facet sizes in both directions
+        const unsigned long size = 40;
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (unsigned long i = 0; i <= size; i++) {
+            for (unsigned long j = 0; j <= size; j++) {
+                float x = float(i * i) * 0.05F;
+                float y = float(j);
+                points.push_back(MeshCore::MeshPoint(x, y, std::sin(x) * std::cos(y)));
+            }
+        }
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                unsigned long p0 = i * (size + 1) + j;
+                unsigned long p1 = p0 + size + 1;
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+
+        // a big triangle piercing the grid
+        MeshCore::PointIndex index = points.size();
+        points.push_back(MeshCore::MeshPoint(1.0F, 20.5F, -5.F));
+        points.push_back(MeshCore::MeshPoint(70.0F, 20.5F, -5.F));
+        points.push_back(MeshCore::MeshPoint(35.0F, 20.5F, 5.F));
+        facets.push_back(MeshCore::MeshFacet(index, index + 1, index + 2));
+        kernel.Adopt(points, facets, true);
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(BVHTest, TestEmpty)
+{
+    MeshCore::MeshKernel empty;
+    MeshCore::MeshFacetBVH bvh(empty);
+    std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>> pairs;
+    bvh.GetOverlappingPairs(pairs);
+    EXPECT_TRUE(pairs.empty());
+
+    Base::Vector3f res;
+    MeshCore::FacetIndex facet {};
+    EXPECT_FALSE(bvh.NearestFacetOnRay(Base::Vector3f(), Base::Vector3f(0, 0, 1), 4.F, res, facet));
+}
+
+TEST_F(BVHTest, TestOverlappingPairs)
+{
+    MeshCore::MeshFacetBVH bvh(kernel, 2);
+    std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>> pairs;
+    bvh.GetOverlappingPairs(pairs);
+
+    std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>> ref;
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        for (MeshCore::FacetIndex j = i + 1; j < kernel.CountFacets(); j++) {
+            if (bvh.GetBoundBox(i) && bvh.GetBoundBox(j)) {
+                ref.emplace_back(i, j);
+            }
+        }
+    }
+    EXPECT_EQ(pairs, ref);
+}
+
+TEST_F(BVHTest, TestOverlappingMeshes)
+{
+    MeshCore::MeshKernel other = kernel;
+    Base::Matrix4D mat;
+    mat.move(Base::Vector3f(0.3F, 0.4F, 0.2F));
+    other.Transform(mat);
+
+    MeshCore::MeshFacetBVH bvh1(kernel);
+    MeshCore::MeshFacetBVH bvh2(other);
+    std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>> pairs;
+    bvh1.GetOverlappingPairs(bvh2, pairs);
+
+    std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>> ref;
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        for (MeshCore::FacetIndex j = 0; j < other.CountFacets(); j++) {
+            if (bvh1.GetBoundBox(i) && bvh2.GetBoundBox(j)) {
+                ref.emplace_back(i, j);
+            }
+        }
+    }
+    EXPECT_EQ(pairs, ref);
+}
+
+TEST_F(BVHTest, TestInside)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    Base::BoundBox3f box(10.F, 5.F, -1.F, 20.F, 8.F, 1.F);
+    std::vector<MeshCore::FacetIndex> facets;
+    bvh.Inside(box, facets);
+    std::sort(facets.begin(), facets.end());
+
+    std::vector<MeshCore::FacetIndex> ref;
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        if (bvh.GetBoundBox(i) && box) {
+            ref.push_back(i);
+        }
+    }
+    EXPECT_EQ(facets, ref);
+}
+
+TEST_F(BVHTest, TestNearestFacetOnRay)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    MeshCore::MeshAlgorithm alg(kernel);
+    for (int i = 0; i < 20; i++) {
+        Base::Vector3f pnt(float(i) * 3.7F, float(i) * 1.9F, 10.F);
+        Base::Vector3f dir(0.1F, -0.05F, -1.F);
+        Base::Vector3f res1, res2;
+        MeshCore::FacetIndex facet1 {}, facet2 {};
+        bool found1 = alg.NearestFacetOnRay(pnt, dir, res1, facet1);
+        bool found2 = alg.NearestFacetOnRay(pnt, dir, bvh, res2, facet2);
+        ASSERT_EQ(found1, found2);
+        if (found1) {
+            EXPECT_EQ(facet1, facet2);
+            EXPECT_FLOAT_EQ((res1 - res2).Length(), 0.F);
+        }
+    }
+}
+
+TEST_F(BVHTest, TestNearestFacetsOnRays)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    std::vector<MeshCore::MeshFacetBVH::Ray> rays;
+    for (int i = 0; i < 20; i++) {
+        rays.emplace_back(Base::Vector3f(float(i) * 3.7F, float(i) * 1.9F, 10.F),
+                          Base::Vector3f(0.1F, -0.05F, -1.F));
+    }
+    std::vector<MeshCore::MeshFacetBVH::RayHit> hits = bvh.NearestFacetsOnRays(rays, 4.F);
+    ASSERT_EQ(hits.size(), rays.size());
+    for (std::size_t i = 0; i < rays.size(); i++) {
+        Base::Vector3f res;
+        MeshCore::FacetIndex facet = MeshCore::FACET_INDEX_MAX;
+        bvh.NearestFacetOnRay(rays[i].first, rays[i].second, 4.F, res, facet);
+        EXPECT_EQ(hits[i].first, facet);
+    }
+}
+
+TEST_F(BVHTest, TestNearestFacetToPoint)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    MeshCore::MeshAlgorithm alg(kernel);
+    for (int i = 0; i < 20; i++) {
+        Base::Vector3f pnt(float(i) * 3.3F - 2.F, float(i) * 1.7F, float(i % 5) - 2.F);
+        Base::Vector3f res1, res2;
+        MeshCore::FacetIndex facet1 {}, facet2 {};
+        ASSERT_TRUE(alg.NearestPointFromPoint(pnt, facet1, res1));
+        ASSERT_TRUE(alg.NearestPointFromPoint(pnt, bvh, facet2, res2));
+        EXPECT_FLOAT_EQ(kernel.GetFacet(facet1).DistanceToPoint(pnt),
+                        kernel.GetFacet(facet2).DistanceToPoint(pnt));
+    }
+
+    // nothing in reach
+    Base::Vector3f res;
+    MeshCore::FacetIndex facet {};
+    EXPECT_FALSE(bvh.NearestFacetToPoint(Base::Vector3f(0.F, -100.F, 0.F), 10.F, facet, res));
+}
+
+TEST_F(BVHTest, TestSelfIntersection)
+{
+    MeshCore::MeshEvalSelfIntersection eval(kernel);
+    EXPECT_FALSE(eval.Evaluate());
+
+    std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>> pairs;
+    eval.GetIntersections(pairs);
+    ASSERT_FALSE(pairs.empty());
+    const MeshCore::FacetIndex big = kernel.CountFacets() - 1;
+    for (const auto& it : pairs) {
+        EXPECT_EQ(it.second, big);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
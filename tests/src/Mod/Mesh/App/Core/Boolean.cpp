@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <Base/Matrix.h>
+#include <Mod/Mesh/App/Core/Boolean.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class BooleanTest: public ::testing::Test
+{
+protected:
+    static MeshCore::MeshKernel cube(const Base::Vector3f& origin, float size)
+    {
+        MeshCore::MeshPointArray points;
+        for (int i = 0; i < 8; i++) {
+            points.push_back(MeshCore::MeshPoint(origin.x + ((i & 1) ? size : 0.F),
+                                                 origin.y + ((i & 2) ? size : 0.F),
+                                                 origin.z + ((i & 4) ? size : 0.F)));
+        }
+        // outward oriented
+        const int faces[12][3] = {{0, 2, 3}, {0, 3, 1}, {4, 5, 7}, {4, 7, 6}, {0, 1, 5}, {0, 5, 4},
+                                  {2, 6, 7}, {2, 7, 3}, {0, 4, 6}, {0, 6, 2}, {1, 3, 7}, {1, 7, 5}};
+        MeshCore::MeshFacetArray facets;
+        for (const auto& face : faces) {
+            facets.push_back(MeshCore::MeshFacet(face[0], face[1], face[2]));
+        }
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
+
+    static MeshCore::MeshKernel apply(const MeshCore::MeshKernel& mesh1,
+                                      const MeshCore::MeshKernel& mesh2,
+                                      MeshCore::SetOperations::OperationType type)
+    {
+        MeshCore::MeshKernel result;
+        MeshCore::MeshBoolean boolean(mesh1, mesh2, result, type);
+        EXPECT_TRUE(boolean.Do());
+        return result;
+    }
+
+    static bool isSolid(const MeshCore::MeshKernel& mesh)
+    {
+        MeshCore::MeshEvalSolid solid(mesh);
+        MeshCore::MeshEvalOrientation orientation(mesh);
+        return solid.Evaluate() && orientation.Evaluate();
+    }
+};
+
+TEST_F(BooleanTest, TestOverlappingCubes)
+{
+    MeshCore::MeshKernel mesh1 = cube(Base::Vector3f(0, 0, 0), 1.F);
+    MeshCore::MeshKernel mesh2 = cube(Base::Vector3f(0.5F, 0.3F, 0.2F), 1.F);
+    const float overlap = 0.5F * 0.7F * 0.8F;
+
+    MeshCore::MeshKernel result = apply(mesh1, mesh2, MeshCore::SetOperations::Union);
+    EXPECT_TRUE(isSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 2.F - overlap, 1e-5F);
+
+    result = apply(mesh1, mesh2, MeshCore::SetOperations::Intersect);
+    EXPECT_TRUE(isSolid(result));
+    EXPECT_NEAR(result.GetVolume(), overlap, 1e-5F);
+
+    result = apply(mesh1, mesh2, MeshCore::SetOperations::Difference);
+    EXPECT_TRUE(isSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 1.F - overlap, 1e-5F);
+}
+
+TEST_F(BooleanTest, TestRotatedCube)
+{
+    MeshCore::MeshKernel mesh1 = cube(Base::Vector3f(0, 0, 0), 1.F);
+    MeshCore::MeshKernel mesh2 = cube(Base::Vector3f(-0.5F, -0.5F, -0.5F), 1.F);
+    Base::Matrix4D mat;
+    mat.rotX(0.3);
+    mat.rotY(0.5);
+    mat.rotZ(0.7);
+    mat.move(Base::Vector3d(0.6, 0.4, 0.5));
+    mesh2.Transform(mat);
+
+    MeshCore::MeshKernel unite = apply(mesh1, mesh2, MeshCore::SetOperations::Union);
+    MeshCore::MeshKernel common = apply(mesh1, mesh2, MeshCore::SetOperations::Intersect);
+    MeshCore::MeshKernel cut = apply(mesh1, mesh2, MeshCore::SetOperations::Difference);
+    EXPECT_TRUE(isSolid(unite));
+    EXPECT_TRUE(isSolid(common));
+    EXPECT_TRUE(isSolid(cut));
+    EXPECT_GT(common.GetVolume(), 0.F);
+    EXPECT_NEAR(unite.GetVolume(), 2.F - common.GetVolume(), 1e-4F);
+    EXPECT_NEAR(cut.GetVolume(), 1.F - common.GetVolume(), 1e-4F);
+}
+
+TEST_F(BooleanTest, TestNoIntersection)
+{
+    MeshCore::MeshKernel mesh1 = cube(Base::Vector3f(0, 0, 0), 2.F);
+    MeshCore::MeshKernel inner = cube(Base::Vector3f(0.5F, 0.5F, 0.5F), 1.F);
+    MeshCore::MeshKernel apart = cube(Base::Vector3f(3.F, 0, 0), 1.F);
+
+    MeshCore::MeshKernel result = apply(mesh1, inner, MeshCore::SetOperations::Union);
+    EXPECT_EQ(result.CountFacets(), 12);
+    EXPECT_NEAR(result.GetVolume(), 8.F, 1e-5F);
+
+    result = apply(mesh1, inner, MeshCore::SetOperations::Difference);
+    EXPECT_EQ(result.CountFacets(), 24);
+    EXPECT_NEAR(result.GetVolume(), 7.F, 1e-5F);
+
+    result = apply(mesh1, apart, MeshCore::SetOperations::Union);
+    EXPECT_NEAR(result.GetVolume(), 9.F, 1e-5F);
+
+    result = apply(mesh1, apart, MeshCore::SetOperations::Intersect);
+    EXPECT_EQ(result.CountFacets(), 0);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
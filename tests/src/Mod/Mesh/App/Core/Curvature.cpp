@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <Mod/Mesh/App/Core/Curvature.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4MeshCurvature.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class CurvatureTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a wavy grid, big enough to compute it on several threads
+        const unsigned long size = 80;
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (unsigned long i = 0; i <= size; i++) {
+            for (unsigned long j = 0; j <= size; j++) {
+                float x = float(i) * 0.1F;
+                float y = float(j) * 0.1F;
+                points.push_back(MeshCore::MeshPoint(x, y, std::sin(x) * std::cos(y)));
+            }
+        }
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                unsigned long p0 = i * (size + 1) + j;
+                unsigned long p1 = p0 + size + 1;
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(CurvatureTest, TestPerVertex)
+{
+    MeshCore::MeshCurvature curv(kernel);
+    curv.ComputePerVertex();
+    const std::vector<MeshCore::CurvatureInfo>& info = curv.GetCurvature();
+    ASSERT_EQ(info.size(), kernel.CountPoints());
+
+    std::vector<Wm4::Vector3<double>> points;
+    for (const auto& pnt : kernel.GetPoints()) {
+        points.emplace_back(pnt.x, pnt.y, pnt.z);
+    }
+    std::vector<int> indices;
+    for (const auto& facet : kernel.GetFacets()) {
+        for (auto index : facet._aulPoints) {
+            indices.push_back(int(index));
+        }
+    }
+    Wm4::MeshCurvature<double> reference(int(points.size()),
+                                         points.data(),
+                                         int(kernel.CountFacets()),
+                                         indices.data());
+    for (std::size_t i = 0; i < info.size(); i++) {
+        EXPECT_EQ(info[i].fMaxCurvature, float(reference.GetMaxCurvatures()[i]));
+        EXPECT_EQ(info[i].fMinCurvature, float(reference.GetMinCurvatures()[i]));
+        EXPECT_EQ(info[i].cMaxCurvDir.x, float(reference.GetMaxDirections()[i].X()));
+        EXPECT_EQ(info[i].cMinCurvDir.z, float(reference.GetMinDirections()[i].Z()));
+    }
+}
+
+TEST_F(CurvatureTest, TestPerFaceParallel)
+{
+    MeshCore::MeshCurvature serial(kernel);
+    serial.SetRadius(0.3F);
+    serial.ComputePerFace(false);
+
+    MeshCore::MeshCurvature parallel(kernel);
+    parallel.SetRadius(0.3F);
+    parallel.ComputePerFace(true);
+
+    const std::vector<MeshCore::CurvatureInfo>& info1 = serial.GetCurvature();
+    const std::vector<MeshCore::CurvatureInfo>& info2 = parallel.GetCurvature();
+    ASSERT_EQ(info1.size(), kernel.CountFacets());
+    ASSERT_EQ(info2.size(), kernel.CountFacets());
+    for (std::size_t i = 0; i < info1.size(); i++) {
+        EXPECT_EQ(info1[i].fMaxCurvature, info2[i].fMaxCurvature);
+        EXPECT_EQ(info1[i].fMinCurvature, info2[i].fMinCurvature);
+        EXPECT_EQ(info1[i].cMaxCurvDir, info2[i].cMaxCurvDir);
+    }
+
+    // the surface z = sin(x) * cos(y) is curved almost everywhere
+    EXPECT_LT(info1[100].fMinCurvature, info1[100].fMaxCurvature);
+    EXPECT_LT(info1[100].fMaxCurvature, 10.F);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <Mod/Mesh/App/Core/BVH.h>
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/Degeneration.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class DecimationTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a smooth wavy grid, big enough to be split into several parts
+        const unsigned long size = 150;
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (unsigned long i = 0; i <= size; i++) {
+            for (unsigned long j = 0; j <= size; j++) {
+                float x = float(i);
+                float y = float(j);
+                points.push_back(
+                    MeshCore::MeshPoint(x, y, 5.F * std::sin(x / 20.F) * std::cos(y / 20.F)));
+            }
+        }
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                unsigned long p0 = i * (size + 1) + j;
+                unsigned long p1 = p0 + size + 1;
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(DecimationTest, TestPartitioned)
+{
+    const unsigned long numFacets = kernel.CountFacets();
+    const int target = int(numFacets / 10);
+
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.simplifyPartitioned(target, std::numeric_limits<float>::max(), 4);
+
+    EXPECT_LE(kernel.CountFacets(), unsigned(target));
+    EXPECT_GT(kernel.CountFacets(), unsigned(target) * 9 / 10);
+
+    MeshCore::MeshEvalTopology topology(kernel);
+    EXPECT_TRUE(topology.Evaluate());
+    MeshCore::MeshEvalRangeFacet range(kernel);
+    EXPECT_TRUE(range.Evaluate());
+}
+
+TEST_F(DecimationTest, TestHausdorff)
+{
+    MeshCore::MeshKernel original = kernel;
+    MeshCore::MeshSimplify simplify(kernel);
+    float hausdorff = simplify.simplifyPartitioned(5000, std::numeric_limits<float>::max(), 4);
+
+    auto distance = [](const MeshCore::MeshKernel& mesh1, const MeshCore::MeshKernel& mesh2) {
+        MeshCore::MeshFacetBVH bvh(mesh2);
+        float dist = 0.F;
+        for (const auto& pnt : mesh1.GetPoints()) {
+            MeshCore::FacetIndex facet {};
+            Base::Vector3f res;
+            bvh.NearestFacetToPoint(pnt, std::numeric_limits<float>::max(), facet, res);
+            dist = std::max(dist, Base::Distance(pnt, res));
+        }
+        return dist;
+    };
+
+    EXPECT_GT(hausdorff, 0.F);
+    EXPECT_FLOAT_EQ(hausdorff,
+                    std::max(distance(original, kernel), distance(kernel, original)));
+}
+
+TEST_F(DecimationTest, TestTolerance)
+{
+    // a plane can be decimated without any quadric error
+    MeshCore::MeshPointArray points = kernel.GetPoints();
+    for (MeshCore::PointIndex i = 0; i < points.size(); i++) {
+        kernel.SetPoint(i, points[i].x, points[i].y, 0.F);
+    }
+
+    const unsigned long numFacets = kernel.CountFacets();
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.simplifyPartitioned(100, 1.0e-6F, 4);
+    EXPECT_LT(kernel.CountFacets(), numFacets / 10);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
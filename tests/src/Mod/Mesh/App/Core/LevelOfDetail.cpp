@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <Mod/Mesh/App/Core/LevelOfDetail.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class LevelOfDetailTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a wavy grid that is split into many clusters
+        const unsigned long size = 200;
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (unsigned long i = 0; i <= size; i++) {
+            for (unsigned long j = 0; j <= size; j++) {
+                float x = float(i);
+                float y = float(j);
+                points.push_back(
+                    MeshCore::MeshPoint(x, y, 5.F * std::sin(x / 20.F) * std::cos(y / 20.F)));
+            }
+        }
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                unsigned long p0 = i * (size + 1) + j;
+                unsigned long p1 = p0 + size + 1;
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(LevelOfDetailTest, TestLevels)
+{
+    MeshCore::MeshLevelOfDetail lod(kernel, 1000);
+    EXPECT_FALSE(lod.IsReady());
+    lod.Build();
+    ASSERT_TRUE(lod.IsReady());
+    ASSERT_GT(lod.CountLevels(), 3U);
+    EXPECT_GE(lod.CountClusters(), 80U);
+
+    // level 0 is the original mesh
+    EXPECT_EQ(lod.GetIndices(0).size(), 3 * kernel.CountFacets());
+    EXPECT_EQ(lod.GetPoints(0).size(), kernel.CountPoints());
+
+    for (unsigned int level = 1; level < lod.CountLevels(); level++) {
+        EXPECT_LT(lod.GetIndices(level).size(), lod.GetIndices(level - 1).size());
+        EXPECT_EQ(lod.GetNormals(level).size(), lod.GetPoints(level).size());
+        for (std::size_t c = 0; c < lod.CountClusters(); c++) {
+            EXPECT_GE(lod.GetRange(c, level).error, lod.GetRange(c, level - 1).error);
+        }
+    }
+
+    for (std::size_t c = 0; c < lod.CountClusters(); c++) {
+        const auto& range = lod.GetRange(c, 0);
+        EXPECT_EQ(range.error, 0.F);
+        const auto& indices = lod.GetIndices(0);
+        for (std::size_t i = 3 * range.first; i < 3 * (range.first + range.count); i++) {
+            EXPECT_TRUE(lod.GetBoundBox(c).IsInBox(lod.GetPoints(0)[indices[i]]));
+        }
+    }
+}
+
+TEST_F(LevelOfDetailTest, TestSelectLevel)
+{
+    MeshCore::MeshLevelOfDetail lod(kernel, 1000);
+    lod.Build();
+
+    const unsigned int coarsest = lod.CountLevels() - 1;
+    for (std::size_t c = 0; c < lod.CountClusters(); c++) {
+        EXPECT_EQ(lod.SelectLevel(c, 0.F), 0U);
+        EXPECT_EQ(lod.SelectLevel(c, std::numeric_limits<float>::max()), coarsest);
+
+        unsigned int level = lod.SelectLevel(c, 2.F);
+        EXPECT_LE(lod.GetRange(c, level).error, 2.F);
+        if (level < coarsest) {
+            EXPECT_GT(lod.GetRange(c, level + 1).error, 2.F);
+        }
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
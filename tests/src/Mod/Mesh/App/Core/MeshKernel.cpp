@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <sstream>
+#include <Base/Exception.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshKernelTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a wavy grid with open edges at its border
+        const unsigned long size = 100;
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (unsigned long i = 0; i <= size; i++) {
+            for (unsigned long j = 0; j <= size; j++) {
+                float x = float(i) * 0.1F;
+                float y = float(j) * 0.1F;
+                points.push_back(MeshCore::MeshPoint(x, y, std::sin(x) * std::cos(y)));
+            }
+        }
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                unsigned long p0 = i * (size + 1) + j;
+                unsigned long p1 = p0 + size + 1;
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    void compare(const MeshCore::MeshKernel& mesh) const
+    {
+        ASSERT_EQ(mesh.CountPoints(), kernel.CountPoints());
+        ASSERT_EQ(mesh.CountFacets(), kernel.CountFacets());
+        for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+            EXPECT_EQ(mesh.GetPoint(i), kernel.GetPoint(i));
+        }
+        const MeshCore::MeshFacetArray& facets1 = kernel.GetFacets();
+        const MeshCore::MeshFacetArray& facets2 = mesh.GetFacets();
+        for (MeshCore::FacetIndex i = 0; i < facets1.size(); i++) {
+            for (int j = 0; j < 3; j++) {
+                EXPECT_EQ(facets1[i]._aulPoints[j], facets2[i]._aulPoints[j]);
+                EXPECT_EQ(facets1[i]._aulNeighbours[j], facets2[i]._aulNeighbours[j]);
+            }
+        }
+        EXPECT_EQ(mesh.GetBoundBox().MinX, kernel.GetBoundBox().MinX);
+        EXPECT_EQ(mesh.GetBoundBox().MaxZ, kernel.GetBoundBox().MaxZ);
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(MeshKernelTest, TestReadWrite)
+{
+    std::stringstream str;
+    kernel.Write(str);
+
+    MeshCore::MeshKernel mesh;
+    EXPECT_TRUE(mesh.Read(str));
+    compare(mesh);
+}
+
+TEST_F(MeshKernelTest, TestReadWriteCompressed)
+{
+    std::stringstream raw;
+    kernel.Write(raw);
+    std::stringstream str;
+    kernel.Write(str, true);
+    EXPECT_LT(str.str().size(), raw.str().size() * 2 / 3);
+
+    MeshCore::MeshKernel mesh;
+    EXPECT_TRUE(mesh.Read(str));
+    compare(mesh);
+}
+
+TEST_F(MeshKernelTest, TestInconsistentNeighbours)
+{
+    MeshCore::MeshFacetArray facets = kernel.GetFacets();
+    facets[10]._aulNeighbours[0] = 500;
+    MeshCore::MeshPointArray points = kernel.GetPoints();
+    kernel.Adopt(points, facets, false);
+
+    std::stringstream str;
+    kernel.Write(str, true);
+
+    MeshCore::MeshKernel mesh;
+    EXPECT_FALSE(mesh.Read(str));
+    MeshCore::MeshEvalNeighbourhood eval(mesh);
+    EXPECT_FALSE(eval.Evaluate());
+}
+
+TEST_F(MeshKernelTest, TestTruncated)
+{
+    std::stringstream str;
+    kernel.Write(str, true);
+    std::string data = str.str();
+    std::stringstream cut(data.substr(0, data.size() / 2));
+
+    MeshCore::MeshKernel mesh;
+    EXPECT_THROW(mesh.Read(cut), Base::BadFormatError);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
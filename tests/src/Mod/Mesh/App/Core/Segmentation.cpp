@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <Mod/Mesh/App/Core/Approximation.h>
+#include <Mod/Mesh/App/Core/Curvature.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Segmentation.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+namespace
+{
+// the same surface type but segmented with the serial flood fill
+class SerialPlanarSegment: public MeshCore::MeshCurvaturePlanarSegment
+{
+public:
+    using MeshCore::MeshCurvaturePlanarSegment::MeshCurvaturePlanarSegment;
+    bool IsStateless() const override
+    {
+        return false;
+    }
+};
+
+std::vector<MeshCore::MeshSegment> sorted(std::vector<MeshCore::MeshSegment> segments)
+{
+    for (auto& it : segments) {
+        std::sort(it.begin(), it.end());
+    }
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+}  // namespace
+
+class SegmentationTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // flat areas separated by bumps
+        const unsigned long size = 120;
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (unsigned long i = 0; i <= size; i++) {
+            for (unsigned long j = 0; j <= size; j++) {
+                float x = float(i) * 0.1F;
+                float y = float(j) * 0.1F;
+                float z = std::max(0.F, std::sin(x * 1.3F) * std::sin(y * 0.7F) - 0.3F);
+                points.push_back(MeshCore::MeshPoint(x, y, z));
+            }
+        }
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                unsigned long p0 = i * (size + 1) + j;
+                unsigned long p1 = p0 + size + 1;
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(SegmentationTest, TestStatelessSegments)
+{
+    MeshCore::MeshCurvature curv(kernel);
+    curv.ComputePerVertex();
+    const std::vector<MeshCore::CurvatureInfo>& info = curv.GetCurvature();
+
+    std::vector<MeshCore::MeshSurfaceSegmentPtr> parallel;
+    parallel.emplace_back(std::make_shared<MeshCore::MeshCurvaturePlanarSegment>(info, 10, 0.5F));
+    MeshCore::MeshSegmentAlgorithm(kernel).FindSegments(parallel);
+
+    std::vector<MeshCore::MeshSurfaceSegmentPtr> serial;
+    serial.emplace_back(std::make_shared<SerialPlanarSegment>(info, 10, 0.5F));
+    MeshCore::MeshSegmentAlgorithm(kernel).FindSegments(serial);
+
+    const auto& segments = parallel.front()->GetSegments();
+    EXPECT_GT(segments.size(), 1);
+    EXPECT_EQ(sorted(segments), sorted(serial.front()->GetSegments()));
+}
+
+TEST_F(SegmentationTest, TestPlaneMoments)
+{
+    MeshCore::PlaneFit fit1;
+    MeshCore::PlaneFit fit2;
+    MeshCore::PlaneFit::Moments moments;
+    for (const auto& pnt : kernel.GetPoints()) {
+        fit1.AddPoint(pnt);
+        moments.Add(pnt);
+    }
+
+    EXPECT_EQ(fit1.Fit(), fit2.Fit(moments));
+    EXPECT_EQ(fit1.GetNormal(), fit2.GetNormal());
+    EXPECT_EQ(fit1.GetBase(), fit2.GetBase());
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <Mod/Mesh/App/Core/Adjacency.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Smoothing.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SmoothingTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a noisy grid, big enough to smooth it on several threads
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (unsigned long i = 0; i <= size; i++) {
+            for (unsigned long j = 0; j <= size; j++) {
+                float z = std::sin(float(i * 7 + j * 13)) * 0.2F;
+                points.push_back(MeshCore::MeshPoint(float(i), float(j), z));
+            }
+        }
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                unsigned long p0 = i * (size + 1) + j;
+                unsigned long p1 = p0 + size + 1;
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    // one Laplace step that computes all points from the previous positions
+    static MeshCore::MeshPointArray laplace(const MeshCore::MeshKernel& mesh, double lambda)
+    {
+        MeshCore::MeshCompactPointToPoints vv(mesh);
+        MeshCore::MeshCompactPointToFacets vf(mesh);
+        const MeshCore::MeshPointArray& points = mesh.GetPoints();
+        MeshCore::MeshPointArray result = points;
+        for (MeshCore::PointIndex i = 0; i < points.size(); i++) {
+            auto cv = vv[i];
+            if (cv.size() < 3 || cv.size() != vf[i].size()) {
+                continue;
+            }
+            double x = 0, y = 0, z = 0;
+            for (auto index : cv) {
+                x += double(points[index].x - points[i].x);
+                y += double(points[index].y - points[i].y);
+                z += double(points[index].z - points[i].z);
+            }
+            double w = lambda / double(cv.size());
+            result[i].Set(float(double(points[i].x) + w * x),
+                          float(double(points[i].y) + w * y),
+                          float(double(points[i].z) + w * z));
+        }
+        return result;
+    }
+
+    const unsigned long size = 120;
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(SmoothingTest, TestLaplace)
+{
+    MeshCore::MeshKernel reference = kernel;
+    for (int i = 0; i < 3; i++) {
+        MeshCore::MeshPointArray points = laplace(reference, 0.6307);
+        for (MeshCore::PointIndex j = 0; j < points.size(); j++) {
+            reference.SetPoint(j, points[j]);
+        }
+    }
+
+    MeshCore::LaplaceSmoothing smooth(kernel);
+    smooth.Smooth(3);
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        EXPECT_EQ(kernel.GetPoint(i), reference.GetPoint(i));
+    }
+}
+
+TEST_F(SmoothingTest, TestTaubinPoints)
+{
+    MeshCore::MeshKernel original = kernel;
+    std::vector<MeshCore::PointIndex> indices;
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i += 3) {
+        indices.push_back(i);
+    }
+
+    MeshCore::TaubinSmoothing smooth(kernel);
+    smooth.SmoothPoints(4, indices);
+
+    bool moved = false;
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        if (i % 3 != 0) {
+            // not in the list
+            EXPECT_EQ(kernel.GetPoint(i), original.GetPoint(i));
+        }
+        else if (kernel.GetPoint(i) != original.GetPoint(i)) {
+            moved = true;
+        }
+    }
+    EXPECT_TRUE(moved);
+
+    // the border stays fixed
+    EXPECT_EQ(kernel.GetPoint(0), original.GetPoint(0));
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
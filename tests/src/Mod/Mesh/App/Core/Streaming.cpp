@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <Mod/Mesh/App/Core/Streaming.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class StreamingTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a planar grid of 20 x 20 squares
+        const int size = 20;
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                Base::Vector3f p0(float(i), float(j), 0.F);
+                Base::Vector3f p1(float(i + 1), float(j), 0.F);
+                Base::Vector3f p2(float(i + 1), float(j + 1), 0.F);
+                Base::Vector3f p3(float(i), float(j + 1), 0.F);
+                facets.emplace_back(p0, p1, p2);
+                facets.emplace_back(p0, p2, p3);
+            }
+        }
+
+        MeshCore::MeshStreamWriter writer(input);
+        writer.Begin();
+        writer.Write(facets);
+        writer.Finish();
+    }
+
+    std::vector<MeshCore::MeshGeomFacet> facets;
+    std::stringstream input;
+};
+
+TEST_F(StreamingTest, TestReadChunks)
+{
+    MeshCore::MeshStreamReader reader(input);
+    ASSERT_TRUE(reader.Open());
+    EXPECT_TRUE(reader.IsBinary());
+
+    std::vector<MeshCore::MeshGeomFacet> chunk;
+    std::vector<MeshCore::MeshGeomFacet> result;
+    while (reader.Read(chunk, 7)) {
+        EXPECT_LE(chunk.size(), 7);
+        result.insert(result.end(), chunk.begin(), chunk.end());
+    }
+
+    ASSERT_EQ(result.size(), facets.size());
+    for (std::size_t i = 0; i < facets.size(); i++) {
+        EXPECT_EQ(result[i]._aclPoints[0], facets[i]._aclPoints[0]);
+        EXPECT_EQ(result[i]._aclPoints[1], facets[i]._aclPoints[1]);
+        EXPECT_EQ(result[i]._aclPoints[2], facets[i]._aclPoints[2]);
+    }
+
+    ASSERT_TRUE(reader.Rewind());
+    EXPECT_TRUE(reader.Read(chunk, facets.size()));
+    EXPECT_EQ(chunk.size(), facets.size());
+}
+
+TEST_F(StreamingTest, TestReadAscii)
+{
+    std::stringstream str;
+    str << "solid grid\n";
+    for (const auto& facet : facets) {
+        str << "  facet normal 0 0 1\n    outer loop\n";
+        for (const auto& pnt : facet._aclPoints) {
+            str << "      vertex " << pnt.x << " " << pnt.y << " " << pnt.z << "\n";
+        }
+        str << "    endloop\n  endfacet\n";
+    }
+    str << "endsolid grid\n";
+
+    MeshCore::MeshStreamReader reader(str);
+    ASSERT_TRUE(reader.Open());
+    EXPECT_FALSE(reader.IsBinary());
+
+    std::size_t count = 0;
+    std::vector<MeshCore::MeshGeomFacet> chunk;
+    while (reader.Read(chunk, 100)) {
+        count += chunk.size();
+    }
+    EXPECT_EQ(count, facets.size());
+}
+
+TEST_F(StreamingTest, TestTransform)
+{
+    Base::Matrix4D mat;
+    mat.move(Base::Vector3f(0.F, 0.F, 5.F));
+
+    std::stringstream output;
+    MeshCore::MeshStreamProcessor proc;
+    proc.SetTransform(mat);
+    proc.SetChunkSize(50);
+    ASSERT_TRUE(proc.Process(input, output));
+    EXPECT_EQ(proc.CountFacets(), facets.size());
+
+    MeshCore::MeshStreamReader reader(output);
+    ASSERT_TRUE(reader.Open());
+    std::vector<MeshCore::MeshGeomFacet> chunk;
+    while (reader.Read(chunk, 100)) {
+        for (const auto& facet : chunk) {
+            EXPECT_FLOAT_EQ(facet._aclPoints[0].z, 5.F);
+        }
+    }
+}
+
+TEST_F(StreamingTest, TestTrim)
+{
+    std::stringstream output;
+    MeshCore::MeshStreamProcessor proc;
+    proc.SetTrimPlane(Base::Vector3f(10.5F, 0.F, 0.F), Base::Vector3f(1.F, 0.F, 0.F));
+    proc.SetChunkSize(50);
+    ASSERT_TRUE(proc.Process(input, output));
+
+    // 10 full columns and a half column that is cut into three triangles per square
+    EXPECT_EQ(proc.CountFacets(), 20 * 20 + 20 * 3);
+
+    MeshCore::MeshStreamReader reader(output);
+    ASSERT_TRUE(reader.Open());
+    std::vector<MeshCore::MeshGeomFacet> chunk;
+    while (reader.Read(chunk, 100)) {
+        for (const auto& facet : chunk) {
+            for (const auto& pnt : facet._aclPoints) {
+                EXPECT_LE(pnt.x, 10.5F);
+            }
+        }
+    }
+}
+
+TEST_F(StreamingTest, TestDecimate)
+{
+    std::stringstream output;
+    MeshCore::MeshStreamProcessor proc;
+    proc.SetClusterSize(2.F);
+    proc.SetChunkSize(50);
+    ASSERT_TRUE(proc.Process(input, output));
+
+    // a grid of 10 x 10 cells is left
+    EXPECT_GT(proc.CountFacets(), 0);
+    EXPECT_LE(proc.CountFacets(), 2 * 10 * 10);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/TrimByPlane.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class TrimByPlaneTest: public ::testing::Test
+{
+protected:
+    // a square of size x size in the xy plane with two triangles per cell
+    static MeshCore::MeshKernel grid(unsigned long size)
+    {
+        MeshCore::MeshPointArray points;
+        for (unsigned long i = 0; i <= size; i++) {
+            for (unsigned long j = 0; j <= size; j++) {
+                points.push_back(MeshCore::MeshPoint(float(i), float(j), 0.F));
+            }
+        }
+        MeshCore::MeshFacetArray facets;
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                unsigned long p0 = i * (size + 1) + j;
+                unsigned long p1 = p0 + size + 1;
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
+
+    static MeshCore::MeshKernel cube()
+    {
+        MeshCore::MeshPointArray points;
+        for (int i = 0; i < 8; i++) {
+            points.push_back(MeshCore::MeshPoint((i & 1) ? 1.F : 0.F,
+                                                 (i & 2) ? 1.F : 0.F,
+                                                 (i & 4) ? 1.F : 0.F));
+        }
+        const int faces[12][3] = {{0, 2, 3}, {0, 3, 1}, {4, 5, 7}, {4, 7, 6}, {0, 1, 5}, {0, 5, 4},
+                                  {2, 6, 7}, {2, 7, 3}, {0, 4, 6}, {0, 6, 2}, {1, 3, 7}, {1, 7, 5}};
+        MeshCore::MeshFacetArray facets;
+        for (const auto& face : faces) {
+            facets.push_back(MeshCore::MeshFacet(face[0], face[1], face[2]));
+        }
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
+
+    // the incrementally updated neighbourhood must be the same as a rebuilt one
+    static void checkNeighbours(const MeshCore::MeshKernel& kernel)
+    {
+        MeshCore::MeshKernel copy(kernel);
+        copy.RebuildNeighbours();
+        for (std::size_t i = 0; i < kernel.CountFacets(); i++) {
+            for (int j = 0; j < 3; j++) {
+                EXPECT_EQ(kernel.GetFacets()[i]._aulNeighbours[j],
+                          copy.GetFacets()[i]._aulNeighbours[j]);
+            }
+        }
+    }
+};
+
+TEST_F(TrimByPlaneTest, TestGrid)
+{
+    MeshCore::MeshKernel kernel = grid(10);
+    Base::Vector3f base(3.3F, 0.F, 0.F);
+    Base::Vector3f normal(1.F, 0.F, 0.F);
+    std::vector<MeshCore::FacetIndex> removed;
+    MeshCore::MeshTrimByPlane(kernel).Trim(base, normal, removed);
+
+    EXPECT_NEAR(kernel.GetSurface(), 33.F, 1e-4F);
+    EXPECT_EQ(removed.size(), 140);
+    EXPECT_TRUE(std::is_sorted(removed.begin(), removed.end()));
+    // the kept cells and two or one facets for each split triangle
+    EXPECT_EQ(kernel.CountFacets(), 60 + 30);
+    // the points of the columns 0 to 3 and one for each of the 21 crossing edges
+    EXPECT_EQ(kernel.CountPoints(), 44 + 21);
+    for (const auto& pnt : kernel.GetPoints()) {
+        EXPECT_LE(pnt.x, 3.3F + 1e-6F);
+    }
+    checkNeighbours(kernel);
+}
+
+TEST_F(TrimByPlaneTest, TestPlaneThroughPoints)
+{
+    MeshCore::MeshKernel kernel = grid(10);
+    Base::Vector3f base(3.F, 0.F, 0.F);
+    Base::Vector3f normal(1.F, 0.F, 0.F);
+    std::vector<MeshCore::FacetIndex> removed;
+    MeshCore::MeshTrimByPlane(kernel).Trim(base, normal, removed);
+
+    // no facet is split and no point is added
+    EXPECT_EQ(kernel.CountFacets(), 60);
+    EXPECT_EQ(kernel.CountPoints(), 44);
+    EXPECT_FLOAT_EQ(kernel.GetSurface(), 30.F);
+    checkNeighbours(kernel);
+}
+
+TEST_F(TrimByPlaneTest, TestCube)
+{
+    MeshCore::MeshKernel kernel = cube();
+    Base::Vector3f base(0.5F, 0.4F, 0.6F);
+    Base::Vector3f normal(0.3F, -0.5F, 0.8F);
+    normal.Normalize();
+    std::vector<MeshCore::FacetIndex> removed;
+    MeshCore::MeshTrimByPlane(kernel).Trim(base, normal, removed);
+
+    checkNeighbours(kernel);
+    // the only open edges are the ones of the cut and they lie in the plane
+    int open = 0;
+    for (const auto& facet : kernel.GetFacets()) {
+        for (int j = 0; j < 3; j++) {
+            if (facet._aulNeighbours[j] == MeshCore::FACET_INDEX_MAX) {
+                open++;
+                const auto& p = kernel.GetPoints()[facet._aulPoints[j]];
+                const auto& q = kernel.GetPoints()[facet._aulPoints[(j + 1) % 3]];
+                EXPECT_NEAR(p.DistanceToPlane(base, normal), 0.F, 1e-6F);
+                EXPECT_NEAR(q.DistanceToPlane(base, normal), 0.F, 1e-6F);
+            }
+        }
+    }
+    EXPECT_GT(open, 0);
+    for (const auto& pnt : kernel.GetPoints()) {
+        EXPECT_LE(pnt.DistanceToPlane(base, normal), 1e-6F);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
+#include <set>
+#include <sstream>
 #include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
 #include <Mod/Mesh/App/Core/IO/Reader3MF.h>
 #include <Mod/Mesh/App/Core/IO/ReaderOBJ.h>
+#include <Mod/Mesh/App/Core/IO/ReaderPLY.h>
+#include <Mod/Mesh/App/Core/IO/Writer3MF.h>
 #include <xercesc/util/PlatformUtils.hpp>
 #include <zipios++/fcoll.h>
 
@@ -39,6 +45,41 @@ TEST_F(ImporterTest, Test3MF)
     EXPECT_EQ(mesh2.CountFacets(), 1300);
 }
 
+TEST_F(ImporterTest, Test3MFInstances)
+{
+    std::string file(DATADIR);
+    file.append("/tests/mesh.obj");
+
+    MeshCore::MeshKernel kernel;
+    MeshCore::ReaderOBJ reader(kernel, nullptr);
+    EXPECT_EQ(reader.Load(file), true);
+
+    // the same mesh placed twice is written as one object with two build items
+    Base::Matrix4D mat1;
+    Base::Matrix4D mat2;
+    mat2.move(Base::Vector3d(10, 0, 0));
+    std::stringstream str;
+    {
+        MeshCore::Writer3MF writer(str);
+        EXPECT_EQ(writer.AddMesh(kernel, mat1), true);
+        EXPECT_EQ(writer.AddMesh(kernel, mat2), true);
+        EXPECT_EQ(writer.Save(), true);
+    }
+
+    MeshCore::Reader3MF reader3mf(str);
+    EXPECT_EQ(reader3mf.Load(), true);
+
+    std::vector<int> ids = reader3mf.GetMeshIds();
+    std::sort(ids.begin(), ids.end());
+    ASSERT_EQ(ids.size(), 2);
+
+    EXPECT_EQ(reader3mf.GetMesh(ids[0]).CountPoints(), 8);
+    EXPECT_EQ(reader3mf.GetMesh(ids[1]).CountPoints(), 8);
+    EXPECT_EQ(reader3mf.GetMesh(ids[1]).CountFacets(), 12);
+    EXPECT_EQ(reader3mf.GetTransform(ids[0]), mat1);
+    EXPECT_EQ(reader3mf.GetTransform(ids[1]), mat2);
+}
+
 TEST_F(ImporterTest, TestOBJ)
 {
     std::string file(DATADIR);
@@ -51,4 +92,125 @@ TEST_F(ImporterTest, TestOBJ)
     EXPECT_EQ(kernel.CountPoints(), 8);
     EXPECT_EQ(kernel.CountFacets(), 12);
 }
+
+TEST_F(ImporterTest, TestBinarySTL)
+{
+    std::string file(DATADIR);
+    file.append("/tests/mesh.obj");
+
+    MeshCore::MeshKernel kernel;
+    MeshCore::ReaderOBJ reader(kernel, nullptr);
+    EXPECT_EQ(reader.Load(file), true);
+
+    Base::FileInfo fi(Base::FileInfo::getTempFileName("mesh.stl"));
+    {
+        Base::ofstream str(fi, std::ios::out | std::ios::binary);
+        MeshCore::MeshOutput output(kernel);
+        EXPECT_EQ(output.SaveBinarySTL(str), true);
+    }
+
+    // the file is read through a memory mapping
+    MeshCore::MeshKernel mapped;
+    MeshCore::MeshInput input(mapped);
+    EXPECT_EQ(input.LoadAny(fi.filePath().c_str()), true);
+    fi.deleteFile();
+
+    EXPECT_EQ(mapped.CountPoints(), 8);
+    EXPECT_EQ(mapped.CountEdges(), 18);
+    EXPECT_EQ(mapped.CountFacets(), 12);
+    EXPECT_EQ(mapped.GetBoundBox().GetCenter(), kernel.GetBoundBox().GetCenter());
+}
+
+TEST_F(ImporterTest, TestOBJBlocks)
+{
+    // big enough to be parsed in several blocks
+    const int size = 300;
+    const int num = (size + 1) * (size + 1);
+    std::stringstream str;
+    str << "mtllib grid.mtl\n";
+    for (int i = 0; i <= size; i++) {
+        for (int j = 0; j <= size; j++) {
+            str << "v " << i << " " << j << " 0\n";
+        }
+    }
+    str << "usemtl first\n";
+    for (int i = 0; i < size; i++) {
+        if (i == size / 2) {
+            str << "g second\nusemtl second\n";
+        }
+        for (int j = 0; j < size; j++) {
+            int p0 = i * (size + 1) + j + 1;
+            int p1 = p0 + size + 1;
+            if (i < size / 2) {
+                str << "f " << p0 << " " << p1 << " " << p1 + 1 << " " << p0 + 1 << "\n";
+            }
+            else {
+                // relative indices with normals
+                str << "f " << p0 - num - 1 << "//1 " << p1 - num - 1 << "//1 " << p1 - num
+                    << "//1\n";
+            }
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    MeshCore::Material mat;
+    MeshCore::ReaderOBJ reader(kernel, &mat);
+    EXPECT_EQ(reader.Load(str), true);
+
+    EXPECT_EQ(kernel.CountPoints(), num);
+    EXPECT_EQ(kernel.CountFacets(), size * size * 3 / 2);
+    EXPECT_EQ(mat.library, "grid.mtl");
+    EXPECT_EQ(mat.binding, MeshCore::MeshIO::PER_FACE);
+    EXPECT_EQ(mat.diffuseColor.size(), kernel.CountFacets());
+
+    std::set<unsigned long> segments;
+    for (const auto& it : kernel.GetFacets()) {
+        segments.insert(it._ulProp);
+    }
+    EXPECT_EQ(segments.size(), 2);
+
+    const MeshCore::MeshFacet& face = kernel.GetFacets().back();
+    EXPECT_EQ(face._aulPoints[0], num - size - 3);
+    EXPECT_EQ(face._aulPoints[1], num - 2);
+    EXPECT_EQ(face._aulPoints[2], num - 1);
+}
+
+TEST_F(ImporterTest, TestAsciiPLY)
+{
+    const int size = 300;
+    const int num = (size + 1) * (size + 1);
+    std::stringstream str;
+    str << "ply\nformat ascii 1.0\n"
+        << "element vertex " << num << "\n"
+        << "property float x\nproperty float y\nproperty float z\n"
+        << "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+        << "element face " << 2 * size * size << "\n"
+        << "property list uchar int vertex_indices\nend_header\n";
+    for (int i = 0; i <= size; i++) {
+        for (int j = 0; j <= size; j++) {
+            str << i << " " << j << " 0.5 255 0 0\n";
+        }
+    }
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            int p0 = i * (size + 1) + j;
+            int p1 = p0 + size + 1;
+            str << "3 " << p0 << " " << p1 << " " << p1 + 1 << "\n";
+            str << "3 " << p0 << " " << p1 + 1 << " " << p0 + 1 << "\n";
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    MeshCore::Material mat;
+    MeshCore::ReaderPLY reader(kernel, &mat);
+    EXPECT_EQ(reader.Load(str), true);
+
+    EXPECT_EQ(kernel.CountPoints(), num);
+    EXPECT_EQ(kernel.CountFacets(), 2 * size * size);
+    EXPECT_EQ(mat.binding, MeshCore::MeshIO::PER_VERTEX);
+    ASSERT_EQ(mat.diffuseColor.size(), num);
+    EXPECT_EQ(mat.diffuseColor.back(), Base::Color(1.0F, 0.0F, 0.0F));
+    Base::Vector3f pnt = kernel.GetPoint(num - 1);
+    EXPECT_EQ(pnt, Base::Vector3f(float(size), float(size), 0.5F));
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,11 +1,15 @@
 #include <gtest/gtest.h>
+#include <memory>
 #include <BRepPrimAPI_MakeBox.hxx>
 #include <TopoDS_Solid.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TopAbs_ShapeEnum.hxx>
+#include <gp_Trsf.hxx>
 #include <QObject>
 
 #include <src/App/InitApplication.h>
+#include <Mod/Mesh/App/Mesh.h>
+#include <Mod/MeshPart/App/Mesher.h>
 
 
 QT_WARNING_PUSH
@@ -111,4 +115,36 @@ TEST_F(SMesh, testStdMeshers)
     delete mesh;
     delete gen;
 }
+
+TEST_F(SMesh, testBatchMesher)
+{
+    TopoDS_Solid box = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Solid();
+
+    MeshPart::Mesher single(box);
+    single.setMethod(MeshPart::Mesher::Standard);
+    single.setDeflection(0.1);
+    std::unique_ptr<Mesh::MeshObject> one(single.createMesh());
+
+    // a moved and a mirrored instance of the same box share its mesh
+    gp_Trsf trsf;
+    trsf.SetTranslation(gp_Vec(20.0, 0.0, 0.0));
+    std::vector<MeshPart::Mesher::Instance> instances(3);
+    instances[0].shape = box;
+    instances[1].shape = box.Moved(TopLoc_Location(trsf));
+    instances[2].shape = box;
+    instances[2].placement.scale(-1.0, 1.0, 1.0);
+
+    MeshPart::Mesher batch;
+    batch.setMethod(MeshPart::Mesher::Standard);
+    batch.setDeflection(0.1);
+    batch.setSegments(true);
+    std::unique_ptr<Mesh::MeshObject> all(batch.createMesh(instances));
+
+    EXPECT_EQ(all->countPoints(), 3 * one->countPoints());
+    EXPECT_EQ(all->countFacets(), 3 * one->countFacets());
+    EXPECT_EQ(all->countSegments(), 18);
+    EXPECT_DOUBLE_EQ(all->getBoundBox().MinX, -10.0);
+    EXPECT_DOUBLE_EQ(all->getBoundBox().MaxX, 30.0);
+    EXPECT_NEAR(all->getVolume(), 3000.0, 1e-3);
+}
 // NOLINTEND
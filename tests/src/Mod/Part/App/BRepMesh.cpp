@@ -173,4 +173,38 @@ TEST_F(BRepMeshTest, testUnconnectedDomains)
     EXPECT_EQ(points.size(), 6);
     EXPECT_EQ(faces.size(), 4);
 }
+// A grid of quads with a domain per row, large enough to be merged in several threads. The
+// points of the rows are duplicated and each row has a collapsed facet.
+TEST_F(BRepMeshTest, testManyDomains)
+{
+    const int size = 120;
+    std::vector<Part::BRepMesh::Domain> domains;
+    for (int row = 0; row < size; row++) {
+        Part::BRepMesh::Domain domain;
+        for (int col = 0; col <= size; col++) {
+            domain.points.emplace_back(col, row, 0);
+            domain.points.emplace_back(col + 1.0e-10, row + 1, 0);
+        }
+        for (uint32_t col = 0; col < size; col++) {
+            domain.facets.push_back({2 * col, 2 * col + 2, 2 * col + 3});
+            domain.facets.push_back({2 * col, 2 * col + 3, 2 * col + 1});
+        }
+        domain.facets.push_back({0, 0, 1});
+        domains.push_back(domain);
+    }
+
+    std::vector<Base::Vector3d> points;
+    std::vector<Part::BRepMesh::Facet> faces;
+    Part::BRepMesh brepMesh;
+    brepMesh.getFacesFromDomains(domains, points, faces);
+    auto segments = brepMesh.createSegments();
+
+    EXPECT_EQ(points.size(), (size + 1) * (size + 1));
+    EXPECT_EQ(faces.size(), 2 * size * size);
+    EXPECT_EQ(segments.size(), size);
+    EXPECT_EQ(segments.back().size(), 2 * size);
+    EXPECT_EQ(segments.back().back(), faces.size() - 1);
+    // the second row starts with the upper points of the first one
+    EXPECT_EQ(faces[2 * size].I1, faces[1].I3);
+}
 // NOLINTEND
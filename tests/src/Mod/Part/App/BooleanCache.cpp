@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include "Mod/Part/App/BooleanCache.h"
+#include "Mod/Part/App/FeaturePartCut.h"
+#include "Mod/Part/App/TopoShapeOpCode.h"
+#include <src/App/InitApplication.h>
+#include <BRepBuilderAPI_Copy.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+
+#include "PartTestHelpers.h"
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+class BooleanCacheTest: public ::testing::Test, public PartTestHelpers::PartTestHelperClass
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        createTestDoc();
+        _maxMemory = Part::BooleanCache::getMaxMemory();
+        Part::BooleanCache::setMaxMemory(64 * 1024 * 1024);
+        Part::BooleanCache::clear();
+    }
+
+    void TearDown() override
+    {
+        Part::BooleanCache::clear();
+        Part::BooleanCache::setMaxMemory(_maxMemory);
+    }
+
+    static Part::TopoShape box(double x)
+    {
+        return {BRepPrimAPI_MakeBox(gp_Pnt(x, 0.0, 0.0), 1.0, 2.0, 3.0).Shape(), 1L};
+    }
+
+    std::size_t _maxMemory = 0;  // NOLINT Can't be private in a test framework
+};
+
+TEST_F(BooleanCacheTest, testKey)
+{
+    Part::TopoShape result(0);
+    auto key = Part::BooleanCache::makeKey(Part::OpCodes::Cut, {box(0.0), box(0.5)}, 0.0, result);
+
+    // the key depends on the content of the operands and not on the instances
+    Part::TopoShape copy(BRepBuilderAPI_Copy(box(0.0).getShape()).Shape(), 1L);
+    EXPECT_EQ(Part::BooleanCache::makeKey(Part::OpCodes::Cut, {copy, box(0.5)}, 0.0, result), key);
+
+    EXPECT_NE(Part::BooleanCache::makeKey(Part::OpCodes::Fuse, {box(0.0), box(0.5)}, 0.0, result),
+              key);
+    EXPECT_NE(Part::BooleanCache::makeKey(Part::OpCodes::Cut, {box(0.0), box(0.6)}, 0.0, result),
+              key);
+    EXPECT_NE(Part::BooleanCache::makeKey(Part::OpCodes::Cut, {box(0.0), box(0.5)}, 0.1, result),
+              key);
+    EXPECT_NE(Part::BooleanCache::makeKey(Part::OpCodes::Cut,
+                                          {box(0.0), box(0.5)},
+                                          0.0,
+                                          Part::TopoShape(2L)),
+              key);
+}
+
+TEST_F(BooleanCacheTest, testMakeElementBoolean)
+{
+    // Act
+    Part::TopoShape first(0);
+    first.makeElementBoolean(Part::OpCodes::Cut, {box(0.0), box(0.5)});
+    Part::TopoShape second(0);
+    second.makeElementBoolean(Part::OpCodes::Cut, {box(0.0), box(0.5)});
+
+    // Assert
+    EXPECT_EQ(Part::BooleanCache::size(), 1);
+    EXPECT_GT(Part::BooleanCache::memSize(), 0);
+    EXPECT_TRUE(second.getShape().IsSame(first.getShape()));
+    EXPECT_EQ(PartTestHelpers::elementMap(second), PartTestHelpers::elementMap(first));
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(second.getShape()), 3.0);
+}
+
+TEST_F(BooleanCacheTest, testDisabled)
+{
+    // Arrange
+    Part::BooleanCache::setMaxMemory(0);
+
+    // Act
+    Part::TopoShape first(0);
+    first.makeElementBoolean(Part::OpCodes::Cut, {box(0.0), box(0.5)});
+    Part::TopoShape second(0);
+    second.makeElementBoolean(Part::OpCodes::Cut, {box(0.0), box(0.5)});
+
+    // Assert
+    EXPECT_EQ(Part::BooleanCache::size(), 0);
+    EXPECT_FALSE(second.getShape().IsSame(first.getShape()));
+}
+
+TEST_F(BooleanCacheTest, testLimit)
+{
+    // Arrange
+    Part::TopoShape first(0);
+    first.makeElementBoolean(Part::OpCodes::Cut, {box(0.0), box(0.5)});
+    std::size_t memSize = Part::BooleanCache::memSize();
+    Part::BooleanCache::setMaxMemory(memSize + memSize / 2);
+
+    // Act
+    Part::TopoShape second(0);
+    second.makeElementBoolean(Part::OpCodes::Cut, {box(0.0), box(0.6)});
+
+    // Assert, the least recently used result was removed
+    EXPECT_EQ(Part::BooleanCache::size(), 1);
+    Part::TopoShape third(0);
+    third.makeElementBoolean(Part::OpCodes::Cut, {box(0.0), box(0.6)});
+    EXPECT_TRUE(third.getShape().IsSame(second.getShape()));
+}
+
+TEST_F(BooleanCacheTest, testFeature)
+{
+    // Arrange
+    auto cut = _doc->addObject<Part::Cut>();
+    cut->Base.setValue(_boxes[0]);
+    cut->Tool.setValue(_boxes[1]);
+
+    // Act
+    cut->execute();
+    TopoDS_Shape first = cut->Shape.getValue();
+    cut->execute();
+
+    // Assert
+    EXPECT_EQ(Part::BooleanCache::size(), 1);
+    EXPECT_TRUE(cut->Shape.getValue().IsSame(first));
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(cut->Shape.getValue()), 3.0);
+}
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
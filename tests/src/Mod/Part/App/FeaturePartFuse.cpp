@@ -269,4 +269,31 @@ TEST_F(FeaturePartFuseTest, testRefine)
     EXPECT_EQ(_fuse->Shape.getShape().getElementMapSize(), 26);
 }
 
+TEST_F(FeaturePartFuseTest, testParallelFuse)
+{
+    // Arrange, three overlapping boxes and a disjoint one
+    auto box = _doc->addObject<Part::Box>();
+    box->Length.setValue(1);
+    box->Width.setValue(2);
+    box->Height.setValue(3);
+    box->Placement.setValue(
+        Base::Placement(Base::Vector3d(10, 0, 0), Base::Rotation(), Base::Vector3d()));
+    _multiFuse->Shapes.setValues({_boxes[0], _boxes[1], _boxes[3], box});
+    _multiFuse->execute();
+    Part::TopoShape serial = _multiFuse->Shape.getValue();
+
+    // Act
+    _multiFuse->ParallelFuse.setValue(true);
+    _multiFuse->execute();
+    Part::TopoShape parallel = _multiFuse->Shape.getValue();
+
+    // Assert
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(parallel.getShape()), 18.0);
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(parallel.getShape()),
+                     PartTestHelpers::getVolume(serial.getShape()));
+    EXPECT_EQ(parallel.countSubShapes(TopAbs_SOLID), 2);
+    EXPECT_GT(parallel.getElementMapSize(), 0);
+    EXPECT_EQ(_multiFuse->History.getSize(), 4);
+}
+
 // See FeaturePartCommon.cpp for a history test.  It would be exactly the same and redundant here.
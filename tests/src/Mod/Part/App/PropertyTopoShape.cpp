@@ -8,6 +8,8 @@
 #include <src/App/InitApplication.h>
 #include "PartTestHelpers.h"
 #include "Mod/Part/App/TopoShapeCompoundPy.h"
+#include <Base/Reader.h>
+#include <Base/Writer.h>
 
 using namespace Part;
 using namespace PartTestHelpers;
@@ -269,3 +271,38 @@ TEST_F(PropertyTopoShapeTest, testRestore)
     EXPECT_TRUE(reader.isValid());
     EXPECT_TRUE(reader.isEndOfElement());
 }
+
+TEST_F(PropertyTopoShapeTest, testLazyRestore)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/General");
+    hGrp->SetBool("LazyRestore", true);
+    Part::PropertyPartShape prop;
+    prop.setValue(BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape());
+    Base::StringWriter writer;
+    prop.Save(writer);
+    Base::StringWriter docFile;
+    prop.SaveDocFile(docFile);
+
+    // Act
+    std::stringstream xml;
+    xml << "<?xml version='1.0' encoding='utf-8'?>\n<Document>" << writer.getString()
+        << "</Document>\n";
+    Base::XMLReader reader("Document.xml", xml);
+    Part::PropertyPartShape restored;
+    restored.Restore(reader);
+    std::stringstream brep(docFile.getString());
+    Base::Reader docReader(brep, "Shape.brp", 1);
+    restored.RestoreDocFile(docReader);
+    hGrp->RemoveBool("LazyRestore");
+
+    // Assert
+    EXPECT_FALSE(restored.isLoaded());
+    EXPECT_EQ(restored.countSubShapes(TopAbs_FACE), 6);
+    EXPECT_EQ(restored.countSubShapes(TopAbs_VERTEX), 8);
+    EXPECT_NEAR(restored.getBoundingBox().LengthZ(), 3.0, 1e-6);
+    EXPECT_FALSE(restored.isLoaded());
+    EXPECT_EQ(restored.getShape().countSubShapes(TopAbs_EDGE), 12);
+    EXPECT_TRUE(restored.isLoaded());
+}
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include "Mod/Part/App/ShapeFileCache.h"
+#include "Mod/Part/App/TopoShape.h"
+#include <src/App/InitApplication.h>
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/FileInfo.h>
+#include <Base/Parameter.h>
+#include <BRepPrimAPI_MakeBox.hxx>
+
+#include "PartTestHelpers.h"
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+class ShapeFileCacheTest: public ::testing::Test, public PartTestHelpers::PartTestHelperClass
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        createTestDoc();
+        _hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Part/General");
+        _enabled = _hGrp->GetBool("SharedLinkCache", false);
+        _hGrp->SetBool("SharedLinkCache", true);
+        _file = Base::FileInfo::getTempFileName() + ".FCStd";
+        _doc->saveAs(_file.c_str());
+    }
+
+    void TearDown() override
+    {
+        std::string dir = Part::ShapeFileCache::getDirectory(_doc);
+        if (!dir.empty()) {
+            Base::FileInfo(dir).deleteDirectoryRecursive();
+        }
+        _doc->setStatus(App::Document::PartialDoc, false);
+        _hGrp->SetBool("SharedLinkCache", _enabled);
+        Base::FileInfo(_file).deleteFile();
+    }
+
+    ParameterGrp::handle _hGrp;  // NOLINT Can't be private in a test framework
+    bool _enabled = false;       // NOLINT
+    std::string _file;           // NOLINT
+};
+
+TEST_F(ShapeFileCacheTest, testOnlyPartialDocuments)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+
+    // Act
+    Part::ShapeFileCache::add(_doc, "PartShape1.bin", box);
+    Part::ShapeFileCache::write(*_doc);
+
+    // Assert
+    Part::TopoShape shape;
+    EXPECT_FALSE(Part::ShapeFileCache::isEnabled(_doc));
+    EXPECT_FALSE(Part::ShapeFileCache::read(_doc, "PartShape1.bin", shape));
+    EXPECT_TRUE(shape.isNull());
+}
+
+TEST_F(ShapeFileCacheTest, testWriteAndRead)
+{
+    // Arrange
+    _doc->setStatus(App::Document::PartialDoc, true);
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    Part::TopoShape shape;
+    EXPECT_FALSE(Part::ShapeFileCache::read(_doc, "PartShape1.bin", shape));
+
+    // Act, as when the document is closed
+    Part::ShapeFileCache::add(_doc, "PartShape1.brp", box);
+    Part::ShapeFileCache::write(*_doc);
+
+    // Assert, the shapes are cached in the binary format whatever the format of the document
+    EXPECT_TRUE(Part::ShapeFileCache::read(_doc, "PartShape1.bin", shape));
+    EXPECT_EQ(shape.countSubShapes(TopAbs_FACE), 6);
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(shape.getShape()), 6.0);
+    EXPECT_FALSE(Part::ShapeFileCache::read(_doc, "PartShape2.bin", shape));
+}
+
+TEST_F(ShapeFileCacheTest, testSavedDocument)
+{
+    // Arrange
+    _doc->setStatus(App::Document::PartialDoc, true);
+    std::string dir = Part::ShapeFileCache::getDirectory(_doc);
+    Part::ShapeFileCache::add(_doc, "PartShape1.bin", BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape());
+    Part::ShapeFileCache::write(*_doc);
+
+    // Act
+    _doc->setStatus(App::Document::PartialDoc, false);
+    _doc->addObject("Part::Feature", "Shape");
+    _doc->saveAs(_file.c_str());
+    _doc->setStatus(App::Document::PartialDoc, true);
+
+    // Assert, another saved state of the document has its own files
+    Part::TopoShape shape;
+    EXPECT_FALSE(dir.empty());
+    EXPECT_NE(Part::ShapeFileCache::getDirectory(_doc), dir);
+    EXPECT_FALSE(Part::ShapeFileCache::read(_doc, "PartShape1.bin", shape));
+    Base::FileInfo(dir).deleteDirectoryRecursive();
+}
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
@@ -10,8 +10,10 @@
 #include <BRep_TVertex.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepAlgoAPI_Fuse.hxx>
+#include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepPrimAPI_MakeBox.hxx>
 #include <TopoDS_Edge.hxx>
+#include <TopExp_Explorer.hxx>
 
 // NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
 
@@ -290,4 +292,69 @@ TEST_F(TopoShapeCacheTest, FindAncestor)
     EXPECT_FALSE(ancestorResultCompound.IsNull());
 }
 
+TEST_F(TopoShapeCacheTest, ShareTopology)
+{
+    // Arrange
+    auto shape = std::get<0>(CreateFusedCubes());
+    auto face = TopExp_Explorer(shape, TopAbs_FACE).Current();
+    std::size_t count = Part::TopoShapeCache::Topology::count();
+    gp_Trsf transform;
+    transform.SetTranslation(gp_Vec(1.0, 2.0, 3.0));
+    TopLoc_Location location(transform);
+    auto moved = shape.Moved(location);
+
+    {
+        auto cache1 = std::make_unique<Part::TopoShapeCache>(shape);
+        Part::TopoShapeCache cache2(moved);
+        Part::TopoShapeCache cache3(shape.Reversed());
+
+        // Act
+        int faces = cache1->countShape(TopAbs_FACE);
+        auto solid = cache1->findAncestor(shape, face, TopAbs_SOLID);
+        cache2.countShape(TopAbs_FACE);
+        cache3.countShape(TopAbs_FACE);
+
+        // Assert - equal shapes at other locations share the maps, reversed ones don't
+        EXPECT_EQ(cache1->topology, cache2.topology);
+        EXPECT_NE(cache1->topology, cache3.topology);
+        EXPECT_EQ(Part::TopoShapeCache::Topology::count(), count + 2);
+
+        // the maps outlive the cache that built them
+        cache1.reset();
+        EXPECT_EQ(cache2.getAncestry(TopAbs_FACE).count(), faces);
+        ASSERT_FALSE(solid.IsNull());
+        EXPECT_TRUE(cache2.findAncestor(moved, face.Moved(location), TopAbs_SOLID)
+                        .IsEqual(solid.Moved(location)));
+    }
+
+    // the registry drops the maps when no cache uses them anymore
+    EXPECT_EQ(Part::TopoShapeCache::Topology::count(), count);
+}
+
+TEST_F(TopoShapeCacheTest, FindClosestElements)
+{
+    // Arrange
+    Part::TopoShape box1(BRepPrimAPI_MakeBox(gp_Pnt(0.0, 0.0, 0.0), 1.0, 1.0, 1.0).Shape());
+    Part::TopoShape box2(BRepPrimAPI_MakeBox(gp_Pnt(0.0, 0.0, 0.0), 2.0, 2.0, 2.0).Shape());
+    gp_Trsf transform;
+    transform.SetTranslation(gp_Vec(3.0, 0.5, 0.0));
+    box2.setShape(box2.getShape().Moved(TopLoc_Location(transform)), false);
+
+    // Act
+    TopoDS_Shape elements1;
+    TopoDS_Shape elements2;
+    double dist = box1.findClosestElements(box2, 1e-7, elements1, elements2);
+    BRepExtrema_DistShapeShape extss(box1.getShape(), box2.getShape());
+
+    // Assert - the faces that touch the facing sides are returned, not the far ones
+    EXPECT_NEAR(dist, 2.0, 1e-7);
+    EXPECT_NEAR(dist, extss.Value(), 1e-7);
+    ASSERT_FALSE(elements1.IsNull());
+    ASSERT_FALSE(elements2.IsNull());
+    EXPECT_EQ(Part::TopoShape(elements1).countSubShapes(TopAbs_FACE), 4);
+    EXPECT_EQ(Part::TopoShape(elements2).countSubShapes(TopAbs_FACE), 3);
+    EXPECT_GE(box1.findShape(TopExp_Explorer(elements1, TopAbs_FACE).Current()), 1);
+    EXPECT_GE(box2.findShape(TopExp_Explorer(elements2, TopAbs_FACE).Current()), 1);
+}
+
 // NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
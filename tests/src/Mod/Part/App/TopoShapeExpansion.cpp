@@ -920,6 +920,26 @@ TEST_F(TopoShapeExpansionTest, getSubTopoShapeByEnum)
     EXPECT_THROW(cube1TS.getSubTopoShape(TopAbs_FACE, 7), Base::IndexError);  // Out of range
 }
 
+TEST_F(TopoShapeExpansionTest, getSubTopoShapeByIndexedName)
+{
+    // Arrange
+    auto [cube1, cube2] = CreateTwoCubes();
+    TopoShape cube1TS {cube1, 1L};
+
+    // Act
+    auto subShape = cube1TS.getSubTopoShape(Data::IndexedName::fromConst("Face", 2));
+    auto noshape1 = cube1TS.getSubTopoShape(Data::IndexedName("Face7"), true);
+    auto noshape2 = cube1TS.getSubTopoShape(Data::IndexedName("Face"), true);
+
+    // Assert
+    EXPECT_TRUE(subShape.getShape().IsSame(cube1TS.getSubShape(TopAbs_FACE, 2)));
+    EXPECT_TRUE(cube1TS.getSubShape(Data::IndexedName("Edge3")).IsSame(
+        cube1TS.getSubShape(TopAbs_EDGE, 3)));
+    EXPECT_TRUE(noshape1.isNull());
+    EXPECT_TRUE(noshape2.isNull());
+    EXPECT_THROW(cube1TS.getSubTopoShape(Data::IndexedName("Face")), Base::ValueError);
+}
+
 TEST_F(TopoShapeExpansionTest, getSubTopoShapeByStringDefaults)
 {
     // Arrange
@@ -983,6 +1003,33 @@ TEST_F(TopoShapeExpansionTest, mapSubElementInvalidParm)
     EXPECT_EQ(cube2TS.getElementMap().size(), 0);  // Invalid, the face is not in Cube2
 }
 
+TEST_F(TopoShapeExpansionTest, mapSubElementSharesUnchangedMap)
+{
+    // Arrange
+    auto [cube1, cube2] = CreateTwoCubes();
+    TopoShape cube1TS {cube1, 1L};
+    TopoShape face1 = cube1TS.getSubTopoShapes(TopAbs_FACE).front();
+    face1.Tag = 3;
+    cube1TS.mapSubElement(face1);
+    auto faceName = Data::IndexedName::fromConst("Face", 1);
+    TopoShape copy {cube1, 1L};
+
+    // Act
+    copy.mapSubElement(cube1TS);
+    auto sharedName = copy.getMappedName(faceName);
+    auto sharedSize = copy.getElementMap().size();
+    copy.setElementName(Data::IndexedName::fromConst("Face", 2),
+                        Data::MappedName("TEST"),
+                        copy.Tag);
+
+    // Assert
+    EXPECT_EQ(sharedName, cube1TS.getMappedName(faceName));
+    EXPECT_EQ(sharedSize, cube1TS.getElementMap().size());
+    EXPECT_EQ(copy.getMappedName(faceName), sharedName);
+    EXPECT_EQ(copy.getElementMap().size(), sharedSize + 1);
+    EXPECT_EQ(cube1TS.getElementMap().size(), sharedSize);  // The original map is unchanged
+}
+
 TEST_F(TopoShapeExpansionTest, mapSubElementFindShapeByNames)
 {
     // Arrange
@@ -2410,6 +2457,22 @@ TEST_F(TopoShapeExpansionTest, makeElementSlices)
                                                     // again after importing other TopoNaming logics
 }
 
+TEST_F(TopoShapeExpansionTest, makeElementSlicesOutsideShape)
+{
+    // Arrange
+    auto [cube1, cube2] = CreateTwoCubes();
+    TopoShape cube1TS {cube1, 1L};
+    TopoShape slicer;
+    Base::Vector3d direction {1.0, 0.0, 0.0};
+    // Act, the planes that miss the cube are skipped
+    auto& result = slicer.makeElementSlices(cube1TS, direction, {-1.0, 0.5, 2.0});
+    // Assert
+    EXPECT_EQ(result.countSubElements("Wire"), 1);
+    EXPECT_FLOAT_EQ(getLength(result.getShape()), 4);
+    // the wire is named after the index of its plane
+    EXPECT_NE(elementMap(result).begin()->second.toString().find("SLC_2"), std::string::npos);
+}
+
 TEST_F(TopoShapeExpansionTest, makeElementMirror)
 {
     // Arrange
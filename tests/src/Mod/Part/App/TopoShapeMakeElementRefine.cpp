@@ -53,3 +53,24 @@ TEST_F(FeaturePartMakeElementRefineTest, makeElementRefineBoxes)
     // TODO: Refine doesn't work on compounds, so we're going to need a binary operation or the
     // like, and those don't exist yet.  Once they do, this test can be expanded
 }
+
+TEST_F(FeaturePartMakeElementRefineTest, makeElementRefineTouchedFaces)
+{
+    // Arrange
+    auto _doc = App::GetApplication().getActiveDocument();
+    auto _fuse = _doc->addObject<Part::Fuse>();
+    _fuse->Base.setValue(_boxes[0]);
+    _fuse->Tool.setValue(_boxes[3]);
+    _fuse->execute();
+    Part::TopoShape ts = _fuse->Shape.getShape();
+    Part::TopoShape box = _boxes[0]->Shape.getShape();
+    // Act
+    Part::TopoShape untouched;
+    untouched.makeElementRefine(ts, nullptr, Part::RefineFail::throwException, &ts);
+    Part::TopoShape touched;
+    touched.makeElementRefine(ts, nullptr, Part::RefineFail::throwException, &box);
+    // Assert
+    EXPECT_EQ(untouched.countSubElements("Face"), 10);  // All faces are in the base
+    EXPECT_EQ(touched.countSubElements("Face"), 6);     // The faces of the fuse aren't in the box
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(touched.getShape()), 12.0);
+}
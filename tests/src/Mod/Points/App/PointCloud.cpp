@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <Base/Exception.h>
+#include <Mod/Points/App/PointCloud.h>
+#include <Mod/Points/App/Points.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PointCloudTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // big enough to be processed in several chunks
+        for (int i = 0; i < 100000; i++) {
+            float t = float(i) * 0.001F;
+            points.emplace_back(std::cos(t) * t, std::sin(t) * t, t);
+            intensity.push_back(float(i % 256) / 255.0F);
+            colors.emplace_back(float(i % 2), float(i % 3 == 0), float(i % 5 == 0));
+            normals.emplace_back(0.0F, 0.0F, 1.0F);
+        }
+    }
+
+    std::vector<Base::Vector3f> points;
+    std::vector<float> intensity;
+    std::vector<Base::Color> colors;
+    std::vector<Base::Vector3f> normals;
+};
+
+TEST_F(PointCloudTest, TestChannels)
+{
+    Points::PointCloud cloud;
+    cloud.setPoints(points);
+    EXPECT_FALSE(cloud.hasChannel(Points::PointCloud::Intensity));
+    EXPECT_TRUE(cloud.getIntensityChannel().empty());
+
+    cloud.setIntensities(intensity);
+    cloud.setColors(colors);
+    cloud.addChannel(Points::PointCloud::Normal);
+    EXPECT_TRUE(cloud.hasChannel(Points::PointCloud::Intensity));
+    EXPECT_TRUE(cloud.hasChannel(Points::PointCloud::Color));
+    EXPECT_TRUE(cloud.hasChannel(Points::PointCloud::Normal));
+    EXPECT_EQ(cloud.getNormalZ().size(), points.size());
+
+    EXPECT_EQ(cloud.getPoints(), points);
+    EXPECT_EQ(cloud.getIntensities(), intensity);
+    EXPECT_EQ(cloud.getColors(), colors);
+
+    cloud.resize(10);
+    EXPECT_EQ(cloud.getColorChannel().size(), 10);
+    cloud.removeChannel(Points::PointCloud::Color);
+    EXPECT_FALSE(cloud.hasChannel(Points::PointCloud::Color));
+
+    EXPECT_THROW(cloud.setNormals(normals), Base::ValueError);
+}
+
+TEST_F(PointCloudTest, TestTransform)
+{
+    Points::PointCloud cloud;
+    cloud.setPoints(points);
+    cloud.setNormals(normals);
+
+    Base::Matrix4D mat;
+    mat.rotX(0.5);
+    mat.scale(2.0, 2.0, 2.0);
+    mat.move(Base::Vector3d(1.0, 2.0, 3.0));
+    cloud.transform(mat);
+
+    std::vector<Base::Vector3f> result = cloud.getPoints();
+    for (std::size_t i = 0; i < points.size(); i++) {
+        EXPECT_EQ(result[i], mat * points[i]);
+    }
+
+    // the normals are only rotated
+    Base::Vector3f normal = cloud.getNormals().back();
+    EXPECT_FLOAT_EQ(normal.Length(), 1.0F);
+    EXPECT_FLOAT_EQ(normal.z, float(std::cos(0.5)));
+
+    cloud.move(Base::Vector3f(-1.0F, -2.0F, -3.0F));
+    EXPECT_FLOAT_EQ(cloud.getX()[0], 0.0F);
+}
+
+TEST_F(PointCloudTest, TestKernel)
+{
+    Points::PointKernel kernel;
+    kernel.setBasicPoints(points);
+    Base::Matrix4D mat;
+    mat.move(Base::Vector3d(1.0, 0.0, 0.0));
+    kernel.setTransform(mat);
+
+    Points::PointCloud cloud(kernel);
+    EXPECT_FLOAT_EQ(cloud.getX()[0], 1.0F);
+
+    Points::PointKernel copy;
+    cloud.toKernel(copy);
+    EXPECT_EQ(copy.size(), kernel.size());
+    EXPECT_EQ(copy.getPoint(0), kernel.getPoint(0));
+}
+
+TEST_F(PointCloudTest, TestBoundBox)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    points[50000].Set(nan, 1000.0F, 1000.0F);
+
+    Points::PointCloud cloud;
+    cloud.setPoints(points);
+
+    Base::BoundBox3f box;
+    for (const auto& pnt : points) {
+        if (!std::isnan(pnt.x)) {
+            box.Add(pnt);
+        }
+    }
+
+    Base::BoundBox3f bnd = cloud.getBoundBox();
+    EXPECT_EQ(bnd.MinX, box.MinX);
+    EXPECT_EQ(bnd.MinY, box.MinY);
+    EXPECT_EQ(bnd.MinZ, box.MinZ);
+    EXPECT_EQ(bnd.MaxX, box.MaxX);
+    EXPECT_EQ(bnd.MaxY, box.MaxY);
+    EXPECT_EQ(bnd.MaxZ, box.MaxZ);
+    EXPECT_LT(bnd.MaxY, 1000.0F);
+}
+
+TEST_F(PointCloudTest, TestFilter)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    points[1].Set(nan, nan, nan);
+    points[3].z = nan;
+
+    Points::PointCloud cloud;
+    cloud.setPoints(points);
+    cloud.setIntensities(intensity);
+    cloud.removeInvalid();
+
+    EXPECT_EQ(cloud.size(), points.size() - 2);
+    EXPECT_EQ(cloud.getIntensityChannel().size(), cloud.size());
+    EXPECT_EQ(cloud.getIntensityChannel()[1], intensity[2]);
+    EXPECT_EQ(cloud.getIntensityChannel()[2], intensity[4]);
+
+    std::vector<bool> keep(cloud.size());
+    for (std::size_t i = 0; i < keep.size(); i += 2) {
+        keep[i] = true;
+    }
+    cloud.filter(keep);
+    EXPECT_EQ(cloud.size(), (points.size() - 1) / 2);
+    EXPECT_EQ(cloud.getZ()[1], points[4].z);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
 #include <Base/FileInfo.h>
 #include <Mod/Points/App/Points.h>
 #include <Mod/Points/App/PointsAlgos.h>
@@ -238,4 +240,86 @@ TEST_F(PointsTest, TestPCDStructured)
     EXPECT_EQ(reader.getWidth(), 4);
     EXPECT_EQ(reader.getHeight(), 2);
 }
+
+TEST_F(PointsTest, TestPCDCropFilter)
+{
+    std::string name = getFileName();
+    Points::PcdWriter writer(getKernel());
+    writer.setNormals(getNormals());
+    writer.setWidth(4);
+    writer.setHeight(2);
+    writer.write(name);
+
+    Points::ReaderFilter filter;
+    Base::Matrix4D mat;
+    mat.rotX(0.5);
+    filter.setTransform(mat);
+    filter.setCropBox(Base::BoundBox3d(-0.5, -10, -10, 0.5, 10, 10));
+
+    Points::PcdReader reader;
+    reader.setFilter(filter);
+    reader.read(name);
+
+    EXPECT_EQ(reader.getPoints().size(), 4);
+    EXPECT_EQ(reader.getNormals().size(), 4);
+    EXPECT_FALSE(reader.isStructured());
+    EXPECT_EQ(reader.getWidth(), 4);
+    EXPECT_FLOAT_EQ(reader.getNormals()[0].z, float(std::cos(0.5)));
+}
+
+TEST_F(PointsTest, TestPLYVoxelFilter)
+{
+    std::string name = getFileName();
+    Points::PlyWriter writer(getKernel());
+    writer.setIntensities(getIntensity());
+    writer.write(name);
+
+    Points::ReaderFilter filter;
+    filter.setVoxelSize(1.5);
+
+    Points::PlyReader reader;
+    reader.setFilter(filter);
+    reader.read(name);
+
+    // all corners of the unit cube fall into the same voxel, the first one is kept
+    EXPECT_EQ(reader.getPoints().size(), 1);
+    EXPECT_EQ(reader.getIntensities().size(), 1);
+    EXPECT_FLOAT_EQ(reader.getIntensities()[0], 0.1F);
+    EXPECT_EQ(reader.getWidth(), 1);
+}
+
+TEST_F(PointsTest, TestReaderFilter)
+{
+    // a line of points, two per voxel and split into blocks
+    std::vector<Base::Vector3d> points;
+    for (int i = 0; i < 100000; i++) {
+        points.emplace_back(double(i) * 0.5, 0.0, 0.0);
+    }
+
+    Points::ReaderFilter filter;
+    filter.setVoxelSize(1.0);
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < points.size(); i += 30000) {
+        std::vector<Base::Vector3d> block(points.begin() + i,
+                                          points.begin() + std::min(i + 30000, points.size()));
+        std::vector<char> keep(block.size(), 1);
+        filter.apply(block, keep);
+        count += std::count(keep.begin(), keep.end(), 1);
+    }
+    EXPECT_EQ(count, points.size() / 2);
+
+    // the random sampling only depends on the running number of the points
+    filter.reset();
+    filter.setVoxelSize(0.0);
+    filter.setSampleRatio(0.25);
+    std::vector<char> keep1(points.size(), 1);
+    filter.apply(points, keep1);
+    filter.reset();
+    std::vector<char> keep2(points.size(), 1);
+    filter.apply(points, keep2);
+    EXPECT_EQ(keep1, keep2);
+    double ratio = double(std::count(keep1.begin(), keep1.end(), 1)) / double(points.size());
+    EXPECT_NEAR(ratio, 0.25, 0.01);
+}
+
 // NOLINTEND(cppcoreguidelines-*,readability-*)
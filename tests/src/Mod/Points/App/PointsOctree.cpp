@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsOctree.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PointsOctreeTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // an irregular cloud with a dense cluster around the origin
+        std::vector<Base::Vector3f> points;
+        unsigned int seed = 1;
+        auto random = [&seed]() {
+            seed = seed * 1103515245U + 12345U;
+            return float((seed >> 8) & 0xffff) / 65535.0F;
+        };
+        for (int i = 0; i < 50000; i++) {
+            points.emplace_back(random() * 100.0F, random() * 50.0F, random() * 10.0F);
+        }
+        for (int i = 0; i < 50000; i++) {
+            points.emplace_back(random(), random(), random());
+        }
+        points[7].x = std::numeric_limits<float>::quiet_NaN();
+        kernel.setBasicPoints(points);
+
+        Base::Matrix4D mat;
+        mat.rotZ(0.3);
+        mat.move(Base::Vector3d(5.0, -2.0, 1.0));
+        kernel.setTransform(mat);
+    }
+
+    std::vector<std::pair<float, unsigned long>> bruteForce(const Base::Vector3f& pnt) const
+    {
+        std::vector<std::pair<float, unsigned long>> dists;
+        for (unsigned long i = 0; i < kernel.size(); i++) {
+            Base::Vector3f pt = kernel.getBasicPoints()[i];
+            if (std::isnan(pt.x)) {
+                continue;
+            }
+            dists.emplace_back(Base::DistanceP2(kernel.getTransform() * pt, pnt), i);
+        }
+        std::sort(dists.begin(), dists.end());
+        return dists;
+    }
+
+    Points::PointKernel kernel;
+};
+
+TEST_F(PointsOctreeTest, TestNearest)
+{
+    Points::PointsOctree octree(kernel);
+    EXPECT_EQ(octree.Size(), kernel.size() - 1);
+
+    std::vector<Base::Vector3f> queries;
+    queries.emplace_back(5.5F, -1.5F, 1.5F);
+    queries.emplace_back(60.0F, 30.0F, 5.0F);
+    queries.emplace_back(-50.0F, 0.0F, 3.0F);
+    for (const auto& pnt : queries) {
+        auto dists = bruteForce(pnt);
+
+        unsigned long index {};
+        float dist {};
+        ASSERT_TRUE(octree.NearestPoint(pnt, std::numeric_limits<float>::max(), index, dist));
+        EXPECT_EQ(index, dists.front().second);
+        EXPECT_FLOAT_EQ(dist * dist, dists.front().first);
+
+        std::vector<unsigned long> indices;
+        EXPECT_EQ(octree.NearestPoints(pnt, 20, indices), 20);
+        for (std::size_t i = 0; i < indices.size(); i++) {
+            EXPECT_EQ(indices[i], dists[i].second);
+        }
+    }
+
+    unsigned long index {};
+    float dist {};
+    EXPECT_FALSE(octree.NearestPoint(Base::Vector3f(-50, 0, 3), 1.0F, index, dist));
+}
+
+TEST_F(PointsOctreeTest, TestRadius)
+{
+    Points::PointsOctree octree(kernel);
+    Base::Vector3f center(5.5F, -1.5F, 1.5F);
+    std::vector<unsigned long> indices;
+    octree.InSphere(center, 0.3F, indices);
+    std::sort(indices.begin(), indices.end());
+
+    std::vector<unsigned long> expected;
+    for (const auto& it : bruteForce(center)) {
+        if (it.first <= 0.09F) {
+            expected.push_back(it.second);
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(indices, expected);
+}
+
+TEST_F(PointsOctreeTest, TestFrustum)
+{
+    Points::PointsOctree octree(kernel);
+
+    // the half-spaces x >= 20 and x <= 40 of the transformed cloud
+    std::vector<Points::PointsOctree::Plane> planes;
+    planes.emplace_back(Base::Vector3f(20, 0, 0), Base::Vector3f(1, 0, 0));
+    planes.emplace_back(Base::Vector3f(40, 0, 0), Base::Vector3f(-1, 0, 0));
+    std::vector<unsigned long> indices;
+    octree.InFrustum(planes, indices);
+    std::sort(indices.begin(), indices.end());
+
+    std::vector<unsigned long> expected;
+    Base::BoundBox3f box(20, -1000, -1000, 40, 1000, 1000);
+    for (unsigned long i = 0; i < kernel.size(); i++) {
+        Base::Vector3f pt = kernel.getTransform() * kernel.getBasicPoints()[i];
+        if (pt.x >= 20.0F && pt.x <= 40.0F) {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(indices, expected);
+
+    std::vector<unsigned long> inside;
+    octree.InSide(box, inside);
+    std::sort(inside.begin(), inside.end());
+    EXPECT_EQ(inside, expected);
+}
+
+TEST_F(PointsOctreeTest, TestLevelOfDetail)
+{
+    Points::PointsOctree octree(kernel);
+    std::vector<unsigned long> order;
+    std::vector<std::size_t> levels;
+    octree.LevelOfDetail(order, levels);
+
+    ASSERT_EQ(order.size(), octree.Size());
+    EXPECT_EQ(levels.front(), 1);
+    EXPECT_EQ(levels.back(), order.size());
+    EXPECT_TRUE(std::is_sorted(levels.begin(), levels.end()));
+
+    std::vector<unsigned long> sorted(order);
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(std::adjacent_find(sorted.begin(), sorted.end()), sorted.end());
+    EXPECT_EQ(std::find(sorted.begin(), sorted.end(), 7), sorted.end());
+
+    // the coarse levels sample the space and not the points, so the dense cluster only gets a
+    // small share of them
+    auto level = std::find_if(levels.begin(), levels.end(), [](std::size_t end) {
+        return end >= 1000;
+    });
+    ASSERT_NE(level, levels.end());
+    auto dense = std::count_if(order.begin(), order.begin() + *level, [](unsigned long index) {
+        return index >= 50000;
+    });
+    EXPECT_LT(double(dense) / double(*level), 0.1);
+}
+
+TEST_F(PointsOctreeTest, TestEmpty)
+{
+    Points::PointKernel empty;
+    Points::PointsOctree octree(empty);
+    EXPECT_EQ(octree.Size(), 0);
+    EXPECT_FALSE(octree.GetBoundBox().IsValid());
+
+    std::vector<unsigned long> indices;
+    EXPECT_EQ(octree.NearestPoints(Base::Vector3f(), 3, indices), 0);
+    EXPECT_EQ(octree.InSphere(Base::Vector3f(), 1.0F, indices), 0);
+
+    std::vector<std::size_t> levels;
+    octree.LevelOfDetail(indices, levels);
+    EXPECT_TRUE(indices.empty());
+    EXPECT_TRUE(levels.empty());
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
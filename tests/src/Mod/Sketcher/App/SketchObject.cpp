@@ -1,11 +1,14 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
+#include <algorithm>
+
 #include <FCConfig.h>
 
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/Expression.h>
 #include <App/ObjectIdentifier.h>
+#include <Mod/Part/App/FeaturePartBox.h>
 #include <Mod/Sketcher/App/GeoEnum.h>
 #include <Mod/Sketcher/App/SketchObject.h>
 #include "SketcherTestHelpers.h"
@@ -860,3 +863,110 @@ TEST_F(SketchObjectTest, testGetElementName)
     EXPECT_STREQ(reverse_export_name.newName.c_str(), (";" + tagName + "v1;SKT.Vertex1").c_str());
     EXPECT_STREQ(reverse_export_name.oldName.c_str(), "Vertex1");
 }
+
+TEST_F(SketchObjectTest, testSolveUpdatesGeometryInPlace)
+{
+    // Arrange
+    Part::GeomLineSegment lineSeg;
+    setupLineSegment(lineSeg);
+    int geoId = getObject()->addGeometry(&lineSeg);
+    auto constr = new Sketcher::Constraint();  // Ownership will be transferred to the sketch
+    constr->Type = Sketcher::ConstraintType::Horizontal;
+    constr->First = geoId;
+    getObject()->addConstraint(constr);
+    const Part::Geometry* geometry = getObject()->getGeometry(geoId);
+    auto tag = geometry->getTag();
+
+    // Act
+    int result = getObject()->solve();
+
+    // Assert, the solved geometry was written into the existing geometry
+    EXPECT_EQ(result, 0);
+    EXPECT_EQ(getObject()->getGeometry(geoId), geometry);
+    EXPECT_EQ(geometry->getTag(), tag);
+    auto line = getObject()->getGeometry<Part::GeomLineSegment>(geoId);
+    EXPECT_NEAR(line->getStartPoint().y, line->getEndPoint().y, 1e-7);
+
+    // Act
+    result = getObject()->moveGeometry(geoId, Sketcher::PointPos::end, Base::Vector3d(5, 7, 0));
+
+    // Assert
+    EXPECT_EQ(result, 0);
+    EXPECT_EQ(getObject()->getGeometry(geoId), geometry);
+    EXPECT_NEAR(line->getStartPoint().y, line->getEndPoint().y, 1e-7);
+}
+
+TEST_F(SketchObjectTest, testBuildShapeAfterChanges)
+{
+    // Arrange, a wire of two lines and a separate line
+    Part::GeomLineSegment line1;
+    line1.setPoints(Base::Vector3d(0, 0, 0), Base::Vector3d(1, 0, 0));
+    Part::GeomLineSegment line2;
+    line2.setPoints(Base::Vector3d(1, 0, 0), Base::Vector3d(1, 1, 0));
+    Part::GeomLineSegment line3;
+    line3.setPoints(Base::Vector3d(5, 5, 0), Base::Vector3d(6, 5, 0));
+    getObject()->addGeometry(&line1);
+    getObject()->addGeometry(&line2);
+    int geoId = getObject()->addGeometry(&line3);
+    getObject()->recomputeFeature();
+    EXPECT_EQ(getObject()->Shape.getShape().countSubShapes(TopAbs_WIRE), 2);
+    EXPECT_EQ(getObject()->Shape.getShape().countSubShapes(TopAbs_EDGE), 3);
+
+    // Act, a line that joins the wires
+    Part::GeomLineSegment line4;
+    line4.setPoints(Base::Vector3d(1, 1, 0), Base::Vector3d(5, 5, 0));
+    getObject()->addGeometry(&line4);
+    getObject()->recomputeFeature();
+
+    // Assert
+    EXPECT_EQ(getObject()->Shape.getShape().countSubShapes(TopAbs_WIRE), 1);
+    EXPECT_EQ(getObject()->Shape.getShape().countSubShapes(TopAbs_EDGE), 4);
+
+    // Act, the separate line is moved away again
+    auto line = std::make_unique<Part::GeomLineSegment>();
+    line->setPoints(Base::Vector3d(7, 5, 0), Base::Vector3d(8, 5, 0));
+    getObject()->Geometry.set1Value(geoId, std::move(line));
+    getObject()->recomputeFeature();
+
+    // Assert
+    EXPECT_EQ(getObject()->Shape.getShape().countSubShapes(TopAbs_WIRE), 2);
+    EXPECT_EQ(getObject()->Shape.getShape().countSubShapes(TopAbs_EDGE), 4);
+    EXPECT_NEAR(getObject()->Shape.getShape().getBoundBox().MaxX, 8.0, 1e-7);
+}
+
+TEST_F(SketchObjectTest, testExternalGeometryFollowsReference)
+{
+    // Arrange, the bottom face of a box projected onto the sketch
+    auto box = getObject()->getDocument()->addObject<Part::Box>();
+    box->Length.setValue(2.0);
+    box->recomputeFeature();
+    getObject()->addExternal(box, "Face5");
+    getObject()->recomputeFeature();
+    auto maxX = [this]() {
+        double x = 0.0;
+        for (auto geo : getObject()->getExternalGeometry()) {
+            if (auto line = freecad_cast<Part::GeomLineSegment*>(geo)) {
+                x = std::max({x, line->getStartPoint().x, line->getEndPoint().x});
+            }
+        }
+        return x;
+    };
+    EXPECT_EQ(getObject()->getExternalGeometryCount(), 2 + 4);
+    EXPECT_DOUBLE_EQ(maxX(), 2.0);
+
+    // Act, an unchanged reference
+    getObject()->recomputeFeature();
+
+    // Assert
+    EXPECT_EQ(getObject()->getExternalGeometryCount(), 2 + 4);
+    EXPECT_DOUBLE_EQ(maxX(), 2.0);
+
+    // Act, a changed reference
+    box->Length.setValue(3.0);
+    box->recomputeFeature();
+    getObject()->recomputeFeature();
+
+    // Assert
+    EXPECT_EQ(getObject()->getExternalGeometryCount(), 2 + 4);
+    EXPECT_DOUBLE_EQ(maxX(), 3.0);
+}
@@ -50,3 +50,209 @@ TEST_F(GCSTest, clearConstraints)  // NOLINT
     // Assert
     EXPECT_EQ(0, System()->getNumberOfConstraints());
 }
+
+TEST_F(GCSTest, diagnoseSparseAndDenseQR)  // NOLINT
+{
+    // Arrange - two points on a horizontal line, the second horizontal constraint is redundant
+    auto diagnose = [](GCS::QRAlgorithm algorithm, GCS::VEC_I& redundant, int& dependent) {
+        double x0 = 1.0, y0 = 2.0, x1 = 4.0, y1 = 2.5;
+        double fixedX = 1.0, fixedY = 2.0;
+        GCS::Point p0, p1;
+        p0.x = &x0;
+        p0.y = &y0;
+        p1.x = &x1;
+        p1.y = &y1;
+        GCS::VEC_pD params {&x0, &y0, &x1, &y1};
+        SystemTest system;
+        system.qrAlgorithm = algorithm;
+        system.addConstraintCoordinateX(p0, &fixedX, 1);
+        system.addConstraintCoordinateY(p0, &fixedY, 2);
+        system.addConstraintHorizontal(p0, p1, 3);
+        system.addConstraintHorizontal(p1, p0, 4);
+        system.declareUnknowns(params);
+        system.initSolution();
+        system.getRedundant(redundant);
+        std::vector<double*> dependentParams;
+        system.getDependentParams(dependentParams);
+        dependent = int(dependentParams.size());
+        return system.dofsNumber();
+    };
+
+    // Act
+    GCS::VEC_I redundantDense, redundantSparse;
+    int dependentDense = 0, dependentSparse = 0;
+    int dofsDense = diagnose(GCS::EigenDenseQR, redundantDense, dependentDense);
+    int dofsSparse = diagnose(GCS::EigenSparseQR, redundantSparse, dependentSparse);
+
+    // Assert - only the x coordinate of the second point is free
+    EXPECT_EQ(dofsDense, 1);
+    EXPECT_EQ(dofsSparse, 1);
+    EXPECT_FALSE(redundantSparse.empty());
+    EXPECT_EQ(redundantSparse, redundantDense);
+    EXPECT_EQ(dependentSparse, dependentDense);
+}
+
+TEST_F(GCSTest, diagnoseIncrementally)  // NOLINT
+{
+    // Arrange - two independent groups of constraints, a redundant one in the first group and
+    // two conflicting ones in the second group
+    double values[8] {0.0, 0.0, 3.0, 0.5, 10.0, 0.0, 12.0, 1.0};
+    double fixed[4] {0.0, 0.0, 10.0, 0.0};
+    double distance = 2.0, yValue1 = 0.0, yValue2 = 1.0;
+    GCS::Point points[4];
+    GCS::VEC_pD params;
+    for (int i = 0; i < 4; ++i) {
+        points[i].x = &values[2 * i];
+        points[i].y = &values[2 * i + 1];
+        params.push_back(points[i].x);
+        params.push_back(points[i].y);
+    }
+    auto diagnose = [&](SystemTest& system, bool incremental) {
+        system.clear();
+        system.incrementalDiagnosis = incremental;
+        system.addConstraintCoordinateX(points[0], &fixed[0], 1);
+        system.addConstraintCoordinateY(points[0], &fixed[1], 2);
+        system.addConstraintHorizontal(points[0], points[1], 3);
+        system.addConstraintHorizontal(points[1], points[0], 4);
+        system.addConstraintCoordinateX(points[2], &fixed[2], 5);
+        system.addConstraintCoordinateY(points[2], &fixed[3], 6);
+        system.addConstraintP2PDistance(points[2], points[3], &distance, 7);
+        system.addConstraintCoordinateY(points[3], &yValue1, 8);
+        system.addConstraintCoordinateY(points[3], &yValue2, 9);
+        system.declareUnknowns(params);
+        system.initSolution();
+    };
+    auto expectEqual = [](SystemTest& system1, SystemTest& system2) {
+        GCS::VEC_I tags1, tags2;
+        EXPECT_EQ(system1.dofsNumber(), system2.dofsNumber());
+        system1.getConflicting(tags1);
+        system2.getConflicting(tags2);
+        EXPECT_EQ(tags1, tags2);
+        system1.getRedundant(tags1);
+        system2.getRedundant(tags2);
+        EXPECT_EQ(tags1, tags2);
+        GCS::VEC_pD dependent1, dependent2;
+        system1.getDependentParams(dependent1);
+        system2.getDependentParams(dependent2);
+        EXPECT_EQ(GCS::SET_pD(dependent1.begin(), dependent1.end()),
+                  GCS::SET_pD(dependent2.begin(), dependent2.end()));
+    };
+
+    // Act
+    SystemTest full;
+    SystemTest incremental;
+    diagnose(full, false);
+    diagnose(incremental, true);
+
+    // Assert
+    GCS::VEC_I redundant, conflicting;
+    incremental.getRedundant(redundant);
+    incremental.getConflicting(conflicting);
+    EXPECT_FALSE(redundant.empty());
+    EXPECT_FALSE(conflicting.empty());
+    expectEqual(full, incremental);
+
+    // the second group changes, the first one is taken from the cache
+    yValue2 = 0.0;
+    diagnose(full, false);
+    diagnose(incremental, true);
+    incremental.getConflicting(conflicting);
+    EXPECT_TRUE(conflicting.empty());
+    expectEqual(full, incremental);
+}
+
+TEST_F(GCSTest, solveClustersInParallel)  // NOLINT
+{
+    // Arrange - many independent line segments of a fixed length with a fixed start point
+    constexpr int clusters = 50;
+    double distance = 2.0;
+    std::vector<double> fixed(2 * clusters);
+    std::vector<GCS::Point> points(2 * clusters);
+    auto solve = [&](int parallelSolveParams, std::vector<double>& values) {
+        values.resize(4 * clusters);
+        SystemTest system;
+        system.parallelSolveParams = parallelSolveParams;
+        GCS::VEC_pD params;
+        for (int i = 0; i < clusters; ++i) {
+            fixed[2 * i] = 3.0 * i;
+            fixed[2 * i + 1] = 0.5 * i;
+            values[4 * i] = 3.0 * i + 0.1;
+            values[4 * i + 1] = 0.5 * i - 0.2;
+            values[4 * i + 2] = 3.0 * i + 1.0 + 0.01 * i;
+            values[4 * i + 3] = 0.5 * i + 0.5;
+            for (int j = 0; j < 2; ++j) {
+                points[2 * i + j].x = &values[4 * i + 2 * j];
+                points[2 * i + j].y = &values[4 * i + 2 * j + 1];
+            }
+            system.addConstraintCoordinateX(points[2 * i], &fixed[2 * i], 3 * i + 1);
+            system.addConstraintCoordinateY(points[2 * i], &fixed[2 * i + 1], 3 * i + 2);
+            system.addConstraintP2PDistance(points[2 * i], points[2 * i + 1], &distance, 3 * i + 3);
+        }
+        for (auto& value : values) {
+            params.push_back(&value);
+        }
+        int result = system.solve(params, true, GCS::DogLeg);
+        system.applySolution();
+        return result;
+    };
+
+    // Act
+    std::vector<double> serial, parallel;
+    int serialResult = solve(0, serial);
+    int parallelResult = solve(1, parallel);
+
+    // Assert - the same solution as if the clusters are solved one after the other
+    EXPECT_EQ(serialResult, GCS::Success);
+    EXPECT_EQ(parallelResult, GCS::Success);
+    EXPECT_EQ(serial, parallel);
+    for (int i = 0; i < clusters; ++i) {
+        EXPECT_NEAR(std::hypot(serial[4 * i + 2] - serial[4 * i],
+                               serial[4 * i + 3] - serial[4 * i + 1]),
+                    distance,
+                    1e-6);
+    }
+}
+
+TEST_F(GCSTest, solveDrag)  // NOLINT
+{
+    // Arrange - a line segment of a fixed length around a fixed start point, dragged at its end
+    double values[4] {0.0, 0.0, 2.0, 0.0};
+    double fixed[2] {0.0, 0.0};
+    double distance = 2.0;
+    double target[2] {2.0, 0.0};
+    GCS::Point start {&values[0], &values[1]};
+    GCS::Point end {&values[2], &values[3]};
+    GCS::Point mouse {&target[0], &target[1]};
+    GCS::VEC_pD params {&values[0], &values[1], &values[2], &values[3]};
+    System()->addConstraintCoordinateX(start, &fixed[0], 1);
+    System()->addConstraintCoordinateY(start, &fixed[1], 2);
+    System()->addConstraintP2PDistance(start, end, &distance, 3);
+    System()->addConstraintP2PCoincident(mouse, end, GCS::DefaultTemporaryConstraint);
+    System()->declareUnknowns(params);
+    System()->initSolution();
+    auto expectOnCircle = [&]() {
+        double angle = std::atan2(target[1], target[0]);
+        EXPECT_NEAR(values[2], distance * std::cos(angle), 1e-6);
+        EXPECT_NEAR(values[3], distance * std::sin(angle), 1e-6);
+    };
+
+    // Act and Assert - the steps of the drag
+    for (int step = 1; step <= 10; ++step) {
+        target[0] = 3.0 * std::cos(0.1 * step);
+        target[1] = 3.0 * std::sin(0.1 * step);
+        ASSERT_EQ(System()->solveDrag(), GCS::Success);
+        System()->applySolution();
+        expectOnCircle();
+    }
+
+    // the steps that run out of time continue where the previous one stopped
+    System()->dragTimeBudget = 1e-12;
+    target[0] = -3.0;
+    target[1] = 0.5;
+    for (int step = 0; step < 100; ++step) {
+        if (System()->solveDrag() == GCS::Success) {
+            System()->applySolution();
+        }
+    }
+    expectOnCircle();
+}